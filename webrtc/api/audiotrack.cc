@@ -42,7 +42,6 @@ AudioTrack::~AudioTrack() {
 }
 
 std::string AudioTrack::kind() const {
-  RTC_DCHECK(thread_checker_.CalledOnValidThread());
   return kAudioKind;
 }
 
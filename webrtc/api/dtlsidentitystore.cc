@@ -152,6 +152,8 @@ DtlsIdentityStoreImpl::DtlsIdentityStoreImpl(rtc::Thread* signaling_thread,
       worker_thread_(worker_thread),
       request_info_() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
+  // RSA generation is slow enough to be worth doing ahead of time.
+  request_info_[rtc::KT_RSA].pool_size_ = 1;
 }
 
 DtlsIdentityStoreImpl::~DtlsIdentityStoreImpl() {
@@ -184,10 +186,26 @@ void DtlsIdentityStoreImpl::OnMessage(rtc::Message* msg) {
   }
 }
 
+void DtlsIdentityStoreImpl::SetFreeIdentityPoolSize(rtc::KeyType key_type,
+                                                    size_t size) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  RequestInfo& info = request_info_[key_type];
+  info.pool_size_ = size;
+  while (info.free_identities_.size() > size)
+    info.free_identities_.pop();
+  FillFreeIdentityPool(key_type);
+}
+
 bool DtlsIdentityStoreImpl::HasFreeIdentityForTesting(
     rtc::KeyType key_type) const {
   RTC_DCHECK(signaling_thread_->IsCurrent());
-  return request_info_[key_type].free_identity_.get() != nullptr;
+  return !request_info_[key_type].free_identities_.empty();
+}
+
+size_t DtlsIdentityStoreImpl::NumFreeIdentitiesForTesting(
+    rtc::KeyType key_type) const {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  return request_info_[key_type].free_identities_.size();
 }
 
 void DtlsIdentityStoreImpl::GenerateIdentity(
@@ -200,19 +218,21 @@ void DtlsIdentityStoreImpl::GenerateIdentity(
     request_info_[key_type].request_observers_.push(observer);
 
     // Already have a free identity generated?
-    if (request_info_[key_type].free_identity_.get()) {
+    if (!request_info_[key_type].free_identities_.empty()) {
       // Return identity async - post even though we are on |signaling_thread_|.
       LOG(LS_VERBOSE) << "Using a free DTLS identity.";
       ++request_info_[key_type].gen_in_progress_counts_;
       IdentityResultMessageData* msg =
           new IdentityResultMessageData(new IdentityResult(
-              key_type, std::move(request_info_[key_type].free_identity_)));
+              key_type,
+              std::move(request_info_[key_type].free_identities_.front())));
+      request_info_[key_type].free_identities_.pop();
       signaling_thread_->Post(this, MSG_GENERATE_IDENTITY_RESULT, msg);
       return;
     }
 
     // Free identity in the process of being generated?
-    if (request_info_[key_type].gen_in_progress_counts_ ==
+    if (request_info_[key_type].gen_in_progress_counts_ >=
             request_info_[key_type].request_observers_.size()) {
       // No need to do anything, the free identity will be returned to the
       // observer in a MSG_GENERATE_IDENTITY_RESULT.
@@ -245,12 +265,12 @@ void DtlsIdentityStoreImpl::OnIdentityGenerated(
 
   if (observer.get() == nullptr) {
     // No observer - store result in |free_identities_|.
-    RTC_DCHECK(!request_info_[key_type].free_identity_.get());
-    request_info_[key_type].free_identity_.swap(identity);
-    if (request_info_[key_type].free_identity_.get())
+    if (identity.get()) {
+      request_info_[key_type].free_identities_.push(std::move(identity));
       LOG(LS_VERBOSE) << "A free DTLS identity was saved.";
-    else
+    } else {
       LOG(LS_WARNING) << "Failed to generate DTLS identity (preemptively).";
+    }
   } else {
     // Return the result to the observer.
     if (identity.get()) {
@@ -261,17 +281,26 @@ void DtlsIdentityStoreImpl::OnIdentityGenerated(
       observer->OnFailure(0);
     }
 
-    // Preemptively generate another identity of the same type?
-    if (worker_thread_ != signaling_thread_ && // Only do in background thread.
-        key_type == rtc::KT_RSA &&             // Only necessary for RSA.
-        !request_info_[key_type].free_identity_.get() &&
-        request_info_[key_type].request_observers_.size() ==
-            request_info_[key_type].gen_in_progress_counts_) {
-      GenerateIdentity(key_type, nullptr);
-    }
+    // Preemptively replace the identity that was used.
+    FillFreeIdentityPool(key_type);
   }
 }
 
+void DtlsIdentityStoreImpl::FillFreeIdentityPool(rtc::KeyType key_type) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  // Only do in background thread.
+  if (worker_thread_ == signaling_thread_)
+    return;
+
+  RequestInfo& info = request_info_[key_type];
+  RTC_DCHECK_GE(info.gen_in_progress_counts_, info.request_observers_.size());
+  // Generations that no observer is waiting for will end up in the pool.
+  size_t pooled = info.free_identities_.size() + info.gen_in_progress_counts_ -
+                  info.request_observers_.size();
+  for (; pooled < info.pool_size_; ++pooled)
+    GenerateIdentity(key_type, nullptr);
+}
+
 RTCCertificateGeneratorStoreWrapper::RTCCertificateGeneratorStoreWrapper(
     std::unique_ptr<DtlsIdentityStoreInterface> store)
     : store_(std::move(store)) {
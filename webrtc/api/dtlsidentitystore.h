@@ -84,13 +84,24 @@ class DtlsIdentityStoreImpl : public DtlsIdentityStoreInterface,
   // rtc::MessageHandler override;
   void OnMessage(rtc::Message* msg) override;
 
-  // Returns true if there is a free RSA identity, used for unit tests.
+  // Keeps up to |size| identities of |key_type| generated ahead of requests,
+  // so that they can be answered without waiting for key generation. Starts
+  // filling the pool right away. Identities are only generated ahead of time
+  // if the worker thread is not the signaling thread. By default one RSA
+  // identity is kept once the first RSA request has been answered.
+  void SetFreeIdentityPoolSize(rtc::KeyType key_type, size_t size);
+
+  // Returns true if there is a free identity, used for unit tests.
   bool HasFreeIdentityForTesting(rtc::KeyType key_type) const;
+  size_t NumFreeIdentitiesForTesting(rtc::KeyType key_type) const;
 
  private:
   void GenerateIdentity(
       rtc::KeyType key_type,
       const rtc::scoped_refptr<DtlsIdentityRequestObserver>& observer);
+  // Starts generating identities until the free ones, and those in progress
+  // that no observer is waiting for, fill the pool.
+  void FillFreeIdentityPool(rtc::KeyType key_type);
   void OnIdentityGenerated(rtc::KeyType key_type,
                            std::unique_ptr<rtc::SSLIdentity> identity);
 
@@ -120,12 +131,16 @@ class DtlsIdentityStoreImpl : public DtlsIdentityStoreInterface,
 
   struct RequestInfo {
     RequestInfo()
-        : request_observers_(), gen_in_progress_counts_(0), free_identity_() {}
+        : request_observers_(),
+          gen_in_progress_counts_(0),
+          free_identities_(),
+          pool_size_(0) {}
 
     std::queue<rtc::scoped_refptr<DtlsIdentityRequestObserver>>
         request_observers_;
     size_t gen_in_progress_counts_;
-    std::unique_ptr<rtc::SSLIdentity> free_identity_;
+    std::queue<std::unique_ptr<rtc::SSLIdentity>> free_identities_;
+    size_t pool_size_;
   };
 
   // One RequestInfo per KeyType. Only touch on the |signaling_thread_|.
@@ -121,6 +121,24 @@ TEST_F(DtlsIdentityStoreTest, RequestIdentitySuccessECDSA) {
   EXPECT_TRUE_WAIT(observer_->LastRequestSucceeded(), kTimeoutMs);
 }
 
+TEST_F(DtlsIdentityStoreTest, PrewarmedPoolIsRefilled) {
+  store_->SetFreeIdentityPoolSize(rtc::KT_ECDSA, 2);
+  EXPECT_EQ_WAIT(2u, store_->NumFreeIdentitiesForTesting(rtc::KT_ECDSA),
+                 kTimeoutMs);
+
+  store_->RequestIdentity(rtc::KeyParams(rtc::KT_ECDSA),
+                          rtc::Optional<uint64_t>(),
+                          observer_.get());
+  EXPECT_EQ(1u, store_->NumFreeIdentitiesForTesting(rtc::KT_ECDSA));
+  EXPECT_FALSE(observer_->call_back_called());
+  EXPECT_TRUE_WAIT(observer_->LastRequestSucceeded(), kTimeoutMs);
+  EXPECT_EQ_WAIT(2u, store_->NumFreeIdentitiesForTesting(rtc::KT_ECDSA),
+                 kTimeoutMs);
+
+  store_->SetFreeIdentityPoolSize(rtc::KT_ECDSA, 0);
+  EXPECT_FALSE(store_->HasFreeIdentityForTesting(rtc::KT_ECDSA));
+}
+
 TEST_F(DtlsIdentityStoreTest, DeleteStoreEarlyNoCrashRSA) {
   EXPECT_FALSE(store_->HasFreeIdentityForTesting(rtc::KT_RSA));
 
@@ -217,6 +217,9 @@ class MediaCodecVideoEncoder : public webrtc::VideoEncoder,
   int frames_received_;  // Number of frames received by encoder.
   int frames_encoded_;  // Number of frames encoded by encoder.
   int frames_dropped_media_encoder_;  // Number of frames dropped by encoder.
+  // Number of frames copied into codec input buffers on the CPU, rather than
+  // rendered into the input surface.
+  int frames_converted_;
   // Number of dropped frames caused by full queue.
   int consecutive_full_queue_frame_drops_;
   int64_t stat_start_time_ms_;  // Start time for statistics.
@@ -523,6 +526,7 @@ int32_t MediaCodecVideoEncoder::InitEncodeOnCodecThread(
   frames_received_ = 0;
   frames_encoded_ = 0;
   frames_dropped_media_encoder_ = 0;
+  frames_converted_ = 0;
   consecutive_full_queue_frame_drops_ = 0;
   current_timestamp_us_ = 0;
   stat_start_time_ms_ = rtc::TimeMillis();
@@ -807,6 +811,7 @@ bool MediaCodecVideoEncoder::EncodeByteBufferOnCodecThread(JNIEnv* jni,
       frame.video_frame_buffer()->StrideV(),
       yuv_buffer, width_, width_, height_, encoder_fourcc_))
       << "ConvertFromI420 failed";
+  ++frames_converted_;
 
   bool encode_status = jni->CallBooleanMethod(*j_media_codec_video_encoder_,
                                               j_encode_buffer_method_,
@@ -852,7 +857,9 @@ int32_t MediaCodecVideoEncoder::ReleaseOnCodecThread() {
   JNIEnv* jni = AttachCurrentThreadIfNeeded();
   ALOGD << "EncoderReleaseOnCodecThread: Frames received: " <<
       frames_received_ << ". Encoded: " << frames_encoded_ <<
-      ". Dropped: " << frames_dropped_media_encoder_;
+      ". Dropped: " << frames_dropped_media_encoder_ <<
+      ". CPU conversions: " << frames_converted_ << ", texture readbacks: " <<
+      AndroidTextureBuffer::num_texture_to_i420_conversions();
   ScopedLocalRefFrame local_ref_frame(jni);
   for (size_t i = 0; i < input_buffers_.size(); ++i)
     jni->DeleteGlobalRef(input_buffers_[i]);
@@ -1127,6 +1134,7 @@ void MediaCodecVideoEncoder::LogStatistics(bool force_log) {
     int current_fps =
         (current_frames_ * 1000 + statistic_time_ms / 2) / statistic_time_ms;
     ALOGD << "Encoded frames: " << frames_encoded_ <<
+        ", CPU conversions: " << frames_converted_ <<
         ". Bitrate: " << current_bitrate <<
         ", target: " << last_set_bitrate_kbps_ << " kbps" <<
         ", fps: " << current_fps <<
@@ -13,6 +13,7 @@
 #include <memory>
 
 #include "webrtc/api/java/jni/jni_helpers.h"
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/bind.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/keep_ref_until_done.h"
@@ -107,6 +108,8 @@ void Matrix::Crop(float xFraction,
 // Aligning pointer to 64 bytes for improved performance, e.g. use SIMD.
 static const int kBufferAlignment = 64;
 
+static volatile int g_num_texture_to_i420_conversions = 0;
+
 NativeHandleImpl::NativeHandleImpl(int id, const Matrix& matrix)
     : oes_texture_id(id), sampling_matrix(matrix) {}
 
@@ -121,10 +124,12 @@ AndroidTextureBuffer::AndroidTextureBuffer(
     int height,
     const NativeHandleImpl& native_handle,
     jobject surface_texture_helper,
+    jmethodID j_texture_to_yuv_method,
     const rtc::Callback0<void>& no_longer_used)
     : webrtc::NativeHandleBuffer(&native_handle_, width, height),
       native_handle_(native_handle),
       surface_texture_helper_(surface_texture_helper),
+      j_texture_to_yuv_method_(j_texture_to_yuv_method),
       no_longer_used_cb_(no_longer_used) {}
 
 AndroidTextureBuffer::~AndroidTextureBuffer() {
@@ -132,7 +137,10 @@ AndroidTextureBuffer::~AndroidTextureBuffer() {
 }
 
 rtc::scoped_refptr<webrtc::VideoFrameBuffer>
-AndroidTextureBuffer::NativeToI420Buffer() {
+AndroidTextureBuffer::ConvertToI420() {
+  if (rtc::AtomicOps::Increment(&g_num_texture_to_i420_conversions) == 1) {
+    LOG(LS_INFO) << "Reading back texture frames to I420 on the CPU.";
+  }
   int uv_width = (width()+7) / 8;
   int stride = 8 * uv_width;
   int uv_height = (height()+1)/2;
@@ -160,17 +168,11 @@ AndroidTextureBuffer::NativeToI420Buffer() {
   JNIEnv* jni = AttachCurrentThreadIfNeeded();
   ScopedLocalRefFrame local_ref_frame(jni);
 
-  jmethodID transform_mid = GetMethodID(
-      jni,
-      GetObjectClass(jni, surface_texture_helper_),
-      "textureToYUV",
-      "(Ljava/nio/ByteBuffer;IIII[F)V");
-
   jobject byte_buffer = jni->NewDirectByteBuffer(y_data, size);
 
   jfloatArray sampling_matrix = native_handle_.sampling_matrix.ToJava(jni);
   jni->CallVoidMethod(surface_texture_helper_,
-                      transform_mid,
+                      j_texture_to_yuv_method_,
                       byte_buffer, width(), height(), stride,
                       native_handle_.oes_texture_id, sampling_matrix);
   CHECK_EXCEPTION(jni) << "textureToYUV throwed an exception";
@@ -178,6 +180,10 @@ AndroidTextureBuffer::NativeToI420Buffer() {
   return copy;
 }
 
+int AndroidTextureBuffer::num_texture_to_i420_conversions() {
+  return rtc::AtomicOps::AcquireLoad(&g_num_texture_to_i420_conversions);
+}
+
 rtc::scoped_refptr<AndroidTextureBuffer>
 AndroidTextureBuffer::CropScaleAndRotate(int cropped_width,
                                          int cropped_height,
@@ -199,7 +205,8 @@ AndroidTextureBuffer::CropScaleAndRotate(int cropped_width,
   rtc::scoped_refptr<AndroidTextureBuffer> buffer(
       new rtc::RefCountedObject<AndroidTextureBuffer>(
           rotated_width, rotated_height, native_handle_,
-          surface_texture_helper_, rtc::KeepRefUntilDone(this)));
+          surface_texture_helper_, j_texture_to_yuv_method_,
+          rtc::KeepRefUntilDone(this)));
 
   if (cropped_width != width() || cropped_height != height()) {
     buffer->native_handle_.sampling_matrix.Crop(
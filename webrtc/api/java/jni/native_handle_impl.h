@@ -57,9 +57,13 @@ class AndroidTextureBuffer : public webrtc::NativeHandleBuffer {
                        int height,
                        const NativeHandleImpl& native_handle,
                        jobject surface_texture_helper,
+                       jmethodID j_texture_to_yuv_method,
                        const rtc::Callback0<void>& no_longer_used);
   ~AndroidTextureBuffer();
-  rtc::scoped_refptr<VideoFrameBuffer> NativeToI420Buffer() override;
+
+  // Number of textures read back into CPU memory by all texture buffers in
+  // the process, to tell whether frames really stay on the GPU.
+  static int num_texture_to_i420_conversions();
 
   // First crop, then scale to dst resolution, and then rotate.
   rtc::scoped_refptr<AndroidTextureBuffer> CropScaleAndRotate(
@@ -71,6 +75,11 @@ class AndroidTextureBuffer : public webrtc::NativeHandleBuffer {
       int dst_height,
       webrtc::VideoRotation rotation);
 
+ protected:
+  // Reads the texture back into CPU memory. This is expensive, and only
+  // needed for consumers that can't handle textures, e.g. software encoders.
+  rtc::scoped_refptr<VideoFrameBuffer> ConvertToI420() override;
+
  private:
   NativeHandleImpl native_handle_;
   // Raw object pointer, relying on the caller, i.e.,
@@ -79,6 +88,9 @@ class AndroidTextureBuffer : public webrtc::NativeHandleBuffer {
   // SurfaceTextureHelper instead, but that requires some refactoring
   // of AndroidVideoCapturerJni.
   jobject surface_texture_helper_;
+  // SurfaceTextureHelper.textureToYUV(), looked up once by the C++
+  // SurfaceTextureHelper rather than for every converted frame.
+  const jmethodID j_texture_to_yuv_method_;
   rtc::Callback0<void> no_longer_used_cb_;
 };
 
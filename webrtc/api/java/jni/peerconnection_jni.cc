@@ -761,12 +761,11 @@ class JavaVideoRendererWrapper
 
   // Return a VideoRenderer.I420Frame referring to the data in |frame|.
   jobject CricketToJavaI420Frame(const cricket::VideoFrame* frame) {
+    const jint strides_array[] = {frame->video_frame_buffer()->StrideY(),
+                                  frame->video_frame_buffer()->StrideU(),
+                                  frame->video_frame_buffer()->StrideV()};
     jintArray strides = jni()->NewIntArray(3);
-    jint* strides_array = jni()->GetIntArrayElements(strides, NULL);
-    strides_array[0] = frame->video_frame_buffer()->StrideY();
-    strides_array[1] = frame->video_frame_buffer()->StrideU();
-    strides_array[2] = frame->video_frame_buffer()->StrideV();
-    jni()->ReleaseIntArrayElements(strides, strides_array, 0);
+    jni()->SetIntArrayRegion(strides, 0, 3, strides_array);
     jobjectArray planes = jni()->NewObjectArray(3, *j_byte_buffer_class_, NULL);
     jobject y_buffer = jni()->NewDirectByteBuffer(
         const_cast<uint8_t*>(frame->video_frame_buffer()->DataY()),
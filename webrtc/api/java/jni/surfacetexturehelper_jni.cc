@@ -43,7 +43,12 @@ SurfaceTextureHelper::SurfaceTextureHelper(JNIEnv* jni,
           GetMethodID(jni,
                       FindClass(jni, "org/webrtc/SurfaceTextureHelper"),
                       "returnTextureFrame",
-                      "()V")) {
+                      "()V")),
+      j_texture_to_yuv_method_(
+          GetMethodID(jni,
+                      FindClass(jni, "org/webrtc/SurfaceTextureHelper"),
+                      "textureToYUV",
+                      "(Ljava/nio/ByteBuffer;IIII[F)V")) {
   CHECK_EXCEPTION(jni) << "error during initialization of SurfaceTextureHelper";
 }
 
@@ -67,6 +72,7 @@ SurfaceTextureHelper::CreateTextureFrame(int width, int height,
     const NativeHandleImpl& native_handle) {
   return new rtc::RefCountedObject<AndroidTextureBuffer>(
       width, height, native_handle, *j_surface_texture_helper_,
+      j_texture_to_yuv_method_,
       rtc::Bind(&SurfaceTextureHelper::ReturnTextureFrame, this));
 }
 
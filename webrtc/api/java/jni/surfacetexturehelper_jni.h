@@ -59,6 +59,7 @@ class SurfaceTextureHelper : public rtc::RefCountInterface {
 
   const ScopedGlobalRef<jobject> j_surface_texture_helper_;
   const jmethodID j_return_texture_method_;
+  const jmethodID j_texture_to_yuv_method_;
 };
 
 }  // namespace webrtc_jni
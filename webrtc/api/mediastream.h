@@ -48,7 +48,7 @@ class MediaStream : public Notifier<MediaStreamInterface> {
   template <typename TrackVector>
   bool RemoveTrack(TrackVector* Tracks, MediaStreamTrackInterface* track);
 
-  std::string label_;
+  const std::string label_;
   AudioTrackVector audio_tracks_;
   VideoTrackVector video_tracks_;
 };
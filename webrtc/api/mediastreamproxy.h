@@ -17,7 +17,7 @@
 namespace webrtc {
 
 BEGIN_SIGNALING_PROXY_MAP(MediaStream)
-  PROXY_CONSTMETHOD0(std::string, label)
+  BYPASS_PROXY_CONSTMETHOD0(std::string, label)
   PROXY_METHOD0(AudioTrackVector, GetAudioTracks)
   PROXY_METHOD0(VideoTrackVector, GetVideoTracks)
   PROXY_METHOD1(rtc::scoped_refptr<AudioTrackInterface>,
@@ -20,8 +20,8 @@
 namespace webrtc {
 
 BEGIN_SIGNALING_PROXY_MAP(AudioTrack)
-  PROXY_CONSTMETHOD0(std::string, kind)
-  PROXY_CONSTMETHOD0(std::string, id)
+  BYPASS_PROXY_CONSTMETHOD0(std::string, kind)
+  BYPASS_PROXY_CONSTMETHOD0(std::string, id)
   PROXY_CONSTMETHOD0(TrackState, state)
   PROXY_CONSTMETHOD0(bool, enabled)
   PROXY_CONSTMETHOD0(AudioSourceInterface*, GetSource)
@@ -36,8 +36,8 @@ BEGIN_SIGNALING_PROXY_MAP(AudioTrack)
 END_SIGNALING_PROXY()
 
 BEGIN_PROXY_MAP(VideoTrack)
-  PROXY_CONSTMETHOD0(std::string, kind)
-  PROXY_CONSTMETHOD0(std::string, id)
+  BYPASS_PROXY_CONSTMETHOD0(std::string, kind)
+  BYPASS_PROXY_CONSTMETHOD0(std::string, id)
   PROXY_CONSTMETHOD0(TrackState, state)
   PROXY_CONSTMETHOD0(bool, enabled)
   PROXY_METHOD1(bool, set_enabled, bool)
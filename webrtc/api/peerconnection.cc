@@ -2121,6 +2121,9 @@ bool PeerConnection::InitializePortAllocator_n(
   port_allocator_->set_candidate_filter(
       ConvertIceTransportTypeToCandidateFilter(configuration.type));
 
+  port_allocator_->set_refill_candidate_pool(
+      configuration.refill_ice_candidate_pool);
+
   // Call this last since it may create pooled allocator sessions using the
   // properties set above.
   port_allocator_->SetConfiguration(stun_servers, turn_servers,
@@ -2137,6 +2140,8 @@ bool PeerConnection::ReconfigurePortAllocator_n(
   }
   port_allocator_->set_candidate_filter(
       ConvertIceTransportTypeToCandidateFilter(configuration.type));
+  port_allocator_->set_refill_candidate_pool(
+      configuration.refill_ice_candidate_pool);
   // Call this last since it may create pooled allocator sessions using the
   // candidate filter set above.
   port_allocator_->SetConfiguration(stun_servers, turn_servers,
@@ -25,6 +25,9 @@
 #include "webrtc/api/videosourceproxy.h"
 #include "webrtc/api/videotrack.h"
 #include "webrtc/base/bind.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/base/trace_event.h"
 #include "webrtc/media/engine/webrtcmediaengine.h"
 #include "webrtc/media/engine/webrtcvideodecoderfactory.h"
 #include "webrtc/media/engine/webrtcvideoencoderfactory.h"
@@ -156,6 +159,7 @@ PeerConnectionFactory::~PeerConnectionFactory() {
 }
 
 bool PeerConnectionFactory::Initialize() {
+  TRACE_EVENT0("webrtc", "PeerConnectionFactory::Initialize");
   RTC_DCHECK(signaling_thread_->IsCurrent());
   rtc::InitRandom(rtc::Time32());
 
@@ -170,19 +174,25 @@ bool PeerConnectionFactory::Initialize() {
     return false;
   }
 
+  int64_t start_ms = rtc::TimeMillis();
   // TODO:  Need to make sure only one VoE is created inside
   // WebRtcMediaEngine.
   cricket::MediaEngineInterface* media_engine =
       worker_thread_->Invoke<cricket::MediaEngineInterface*>(rtc::Bind(
       &PeerConnectionFactory::CreateMediaEngine_w, this));
+  int64_t media_engine_ms = rtc::TimeMillis();
 
   channel_manager_.reset(new cricket::ChannelManager(
       media_engine, worker_thread_, network_thread_));
 
   channel_manager_->SetVideoRtxEnabled(true);
+  channel_manager_->SetCryptoOptions(options_.crypto_options);
   if (!channel_manager_->Init()) {
     return false;
   }
+  LOG(LS_INFO) << "Media engine created in " << media_engine_ms - start_ms
+               << " ms, channel manager initialized in "
+               << rtc::TimeMillis() - media_engine_ms << " ms.";
 
   dtls_identity_store_ =
       new RefCountedDtlsIdentityStore(signaling_thread_, network_thread_);
@@ -190,6 +200,13 @@ bool PeerConnectionFactory::Initialize() {
   return true;
 }
 
+void PeerConnectionFactory::SetOptions(const Options& options) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  options_ = options;
+  if (channel_manager_)
+    channel_manager_->SetCryptoOptions(options.crypto_options);
+}
+
 rtc::scoped_refptr<AudioSourceInterface>
 PeerConnectionFactory::CreateAudioSource(
     const MediaConstraintsInterface* constraints) {
@@ -348,6 +365,7 @@ rtc::Thread* PeerConnectionFactory::network_thread() {
 }
 
 cricket::MediaEngineInterface* PeerConnectionFactory::CreateMediaEngine_w() {
+  TRACE_EVENT0("webrtc", "PeerConnectionFactory::CreateMediaEngine_w");
   ASSERT(worker_thread_ == rtc::Thread::Current());
   return cricket::WebRtcMediaEngineFactory::Create(
       default_adm_.get(), video_encoder_factory_.get(),
@@ -293,6 +293,9 @@ class PeerConnectionInterface : public rtc::RefCountInterface {
     rtc::Optional<bool> combined_audio_video_bwe;
     rtc::Optional<bool> enable_dtls_srtp;
     int ice_candidate_pool_size = 0;
+    // If true, pooled candidate sessions are replaced as they're used, so
+    // that ICE restarts can also reuse already gathered candidates.
+    bool refill_ice_candidate_pool = false;
   };
 
   struct RTCOfferAnswerOptions {
@@ -572,6 +575,9 @@ class PeerConnectionFactoryInterface : public rtc::RefCountInterface {
     // supported by both ends will be used for the connection, i.e. if one
     // party supports DTLS 1.0 and the other DTLS 1.2, DTLS 1.0 will be used.
     rtc::SSLProtocolVersion ssl_max_version;
+
+    // Sets crypto related options, e.g. enabled cipher suites.
+    rtc::CryptoOptions crypto_options;
   };
 
   virtual void SetOptions(const Options& options) = 0;
@@ -1049,7 +1049,9 @@ TEST_F(PeerConnectionInterfaceTest, CreatePeerConnectionWithPooledCandidates) {
   config.tcp_candidate_policy =
       PeerConnectionInterface::kTcpCandidatePolicyDisabled;
   config.ice_candidate_pool_size = 1;
+  config.refill_ice_candidate_pool = true;
   CreatePeerConnection(config, nullptr);
+  EXPECT_TRUE(port_allocator_->refill_candidate_pool());
 
   const cricket::FakePortAllocatorSession* session =
       static_cast<const cricket::FakePortAllocatorSession*>(
@@ -2581,6 +2583,7 @@ TEST_F(PeerConnectionMediaConfigTest, TestDefaults) {
 
   EXPECT_FALSE(media_config.enable_dscp);
   EXPECT_TRUE(media_config.video.enable_cpu_overuse_detection);
+  EXPECT_FALSE(media_config.deliver_packets_on_network_thread);
   EXPECT_FALSE(media_config.video.disable_prerenderer_smoothing);
   EXPECT_FALSE(media_config.video.suspend_below_min_bitrate);
 }
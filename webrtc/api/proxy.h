@@ -36,6 +36,10 @@
 // where the first two methods are invoked on the signaling thread,
 // and the third is invoked on the worker thread.
 //
+// BYPASS_PROXY_CONSTMETHOD0 calls straight into the object without a thread
+// hop, and may only be used for getters whose value never changes after
+// construction.
+//
 // The proxy can be created using
 //
 //   TestProxy::Create(Thread* signaling_thread, Thread* worker_thread,
@@ -394,6 +398,13 @@ class MethodCall5 : public rtc::Message,
     return call.Marshal(signaling_thread_);                                  \
   }
 
+// Define methods which return a value that is fixed at construction, and can
+// therefore be read on the calling thread.
+#define BYPASS_PROXY_CONSTMETHOD0(r, method) \
+  r method() const override {                \
+    return c_->method();                     \
+  }
+
 // Define methods which should be invoked on the worker thread.
 #define PROXY_WORKER_METHOD1(r, method, t1)               \
   r method(t1 a1) override {                              \
@@ -35,6 +35,7 @@ class FakeInterface : public rtc::RefCountInterface {
   virtual std::string Method1(std::string s) = 0;
   virtual std::string ConstMethod1(std::string s) const = 0;
   virtual std::string Method2(std::string s1, std::string s2) = 0;
+  virtual std::string BypassConstMethod0() const = 0;
 
  protected:
   ~FakeInterface() {}
@@ -55,6 +56,7 @@ class Fake : public FakeInterface {
   MOCK_CONST_METHOD1(ConstMethod1, std::string(std::string));
 
   MOCK_METHOD2(Method2, std::string(std::string, std::string));
+  MOCK_CONST_METHOD0(BypassConstMethod0, std::string());
 
  protected:
   Fake() {}
@@ -69,6 +71,7 @@ BEGIN_PROXY_MAP(Fake)
   PROXY_WORKER_METHOD1(std::string, Method1, std::string)
   PROXY_CONSTMETHOD1(std::string, ConstMethod1, std::string)
   PROXY_WORKER_METHOD2(std::string, Method2, std::string, std::string)
+  BYPASS_PROXY_CONSTMETHOD0(std::string, BypassConstMethod0)
 END_PROXY()
 
 // Preprocessor hack to get a proxy class a name different than FakeProxy.
@@ -80,6 +83,7 @@ BEGIN_SIGNALING_PROXY_MAP(Fake)
   PROXY_METHOD1(std::string, Method1, std::string)
   PROXY_CONSTMETHOD1(std::string, ConstMethod1, std::string)
   PROXY_METHOD2(std::string, Method2, std::string, std::string)
+  BYPASS_PROXY_CONSTMETHOD0(std::string, BypassConstMethod0)
 END_SIGNALING_PROXY()
 #undef FakeProxy
 
@@ -87,6 +91,7 @@ class SignalingProxyTest : public testing::Test {
  public:
   // Checks that the functions are called on the right thread.
   void CheckSignalingThread() { EXPECT_TRUE(signaling_thread_->IsCurrent()); }
+  void CheckCallingThread() { EXPECT_FALSE(signaling_thread_->IsCurrent()); }
 
  protected:
   void SetUp() override {
@@ -160,6 +165,15 @@ TEST_F(SignalingProxyTest, Method2) {
   EXPECT_EQ("Method2", fake_signaling_proxy_->Method2(arg1, arg2));
 }
 
+TEST_F(SignalingProxyTest, BypassConstMethod0) {
+  EXPECT_CALL(*fake_, BypassConstMethod0())
+      .Times(Exactly(1))
+      .WillOnce(DoAll(
+          InvokeWithoutArgs(this, &SignalingProxyTest::CheckCallingThread),
+          Return("BypassConstMethod0")));
+  EXPECT_EQ("BypassConstMethod0", fake_signaling_proxy_->BypassConstMethod0());
+}
+
 class ProxyTest : public SignalingProxyTest {
  public:
   // Checks that the functions are called on the right thread.
@@ -19,6 +19,10 @@
 
 namespace webrtc {
 
+// Same limit as for SCTP data channels. Send() fails once this much data is
+// queued, the application should wait for OnBufferedAmountChange().
+static const uint64_t kMaxQueuedSendDataBytes = 16 * 1024 * 1024;
+
 void WriteQuicDataChannelMessageHeader(int data_channel_id,
                                        uint64_t message_id,
                                        rtc::CopyOnWriteBuffer* header) {
@@ -98,7 +102,14 @@ bool QuicDataChannel::Send(const DataBuffer& buffer) {
 bool QuicDataChannel::Send_w(const DataBuffer& buffer) {
   RTC_DCHECK(worker_thread_->IsCurrent());
 
-  // Encode and send the header containing the data channel ID and message ID.
+  if (buffered_amount_ >= kMaxQueuedSendDataBytes) {
+    LOG(LS_WARNING) << "QUIC data channel " << id_
+                    << " can't buffer any more data. Buffered amount: "
+                    << buffered_amount_;
+    return false;
+  }
+
+  // Encode the header containing the data channel ID and message ID.
   rtc::CopyOnWriteBuffer header;
   WriteQuicDataChannelMessageHeader(id_, ++next_message_id_, &header);
   RTC_DCHECK(quic_transport_channel_);
@@ -106,30 +117,17 @@ bool QuicDataChannel::Send_w(const DataBuffer& buffer) {
       quic_transport_channel_->CreateQuicStream();
   RTC_DCHECK(stream);
 
-  // Send the header with a FIN if the message is empty.
-  bool header_fin = (buffer.size() == 0);
-  rtc::StreamResult header_result =
-      stream->Write(header.data<char>(), header.size(), header_fin);
-
-  if (header_result == rtc::SR_BLOCK) {
-    // The header is write blocked but we should try sending the message. Since
-    // the ReliableQuicStream queues data in order, if the header is write
-    // blocked then the message will be write blocked. Otherwise if the message
-    // is sent then the header is sent.
-    LOG(LS_INFO) << "Stream " << stream->id()
-                 << " header is write blocked for QUIC data channel " << id_;
-  } else if (header_result != rtc::SR_SUCCESS) {
-    LOG(LS_ERROR) << "Stream " << stream->id()
-                  << " failed to write header for QUIC data channel " << id_
-                  << ". Unexpected error " << header_result;
-    return false;
-  }
-
-  // If the message is not empty, then send the message with a FIN.
-  bool message_fin = true;
+  // Send the header and the message with a FIN in a single write. The
+  // message is handed to the QUIC stream as is; it is only copied if the
+  // stream is write blocked and has to queue it.
+  struct iovec iov[2];
+  iov[0].iov_base = header.data<char>();
+  iov[0].iov_len = header.size();
+  iov[1].iov_base = const_cast<char*>(buffer.data.cdata<char>());
+  iov[1].iov_len = buffer.size();
+  int iov_count = buffer.size() == 0 ? 1 : 2;
   rtc::StreamResult message_result =
-      header_fin ? header_result : stream->Write(buffer.data.data<char>(),
-                                                 buffer.size(), message_fin);
+      stream->Writev(iov, iov_count, true /* fin */);
 
   if (message_result == rtc::SR_SUCCESS) {
     // The message is sent and we don't need this QUIC stream.
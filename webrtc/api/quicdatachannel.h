@@ -158,7 +158,9 @@ class QuicDataChannel : public rtc::RefCountedObject<DataChannelInterface>,
   // Worker thread methods.
   // Sends the data buffer to the remote peer using an outgoing QUIC stream.
   // Returns true if the data buffer can be successfully sent, or if it is
-  // queued to be sent later.
+  // queued to be sent later. Returns false without sending if too much data
+  // is already queued, so the application can wait for the buffered amount to
+  // drop.
   bool Send_w(const DataBuffer& buffer);
   // Connects the |quic_transport_channel_| signals to this QuicDataChannel,
   // then returns the new QuicDataChannel state.
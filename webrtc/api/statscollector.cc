@@ -479,18 +479,38 @@ StatsCollector::UpdateStats(PeerConnectionInterface::StatsOutputLevel level) {
   // TODO(pthatcher): Merge PeerConnection and WebRtcSession so there is no
   // pc_->session().
   if (pc_->session()) {
-    // TODO(tommi): All of these hop over to the worker thread to fetch
-    // information.  We could use an AsyncInvoker to run all of these and post
-    // the information back to the signaling thread where we can create and
-    // update stats reports.  That would also clean up the threading story a bit
-    // since we'd be creating/updating the stats report objects consistently on
-    // the same thread (this class has no locks right now).
+    // Fetch the voice and video stats with a single hop to the worker thread.
+    // Calls to the channels' GetStats() on the worker thread don't hop again.
+    // TODO(tommi): Fetching the transport stats still hops over to the
+    // network thread.
+    cricket::VoiceChannel* voice_channel = pc_->session()->voice_channel();
+    cricket::VideoChannel* video_channel = pc_->session()->video_channel();
+    cricket::VoiceMediaInfo voice_info;
+    cricket::VideoMediaInfo video_info;
+    bool has_voice_info = false;
+    bool has_video_info = false;
+    if (voice_channel || video_channel) {
+      pc_->session()->worker_thread()->Invoke<void>([&] {
+        has_voice_info = voice_channel && voice_channel->GetStats(&voice_info);
+        has_video_info = video_channel && video_channel->GetStats(&video_info);
+      });
+    }
+    if (voice_channel && !has_voice_info)
+      LOG(LS_ERROR) << "Failed to get voice channel stats.";
+    if (video_channel && !has_video_info)
+      LOG(LS_ERROR) << "Failed to get video channel stats.";
+
     ExtractSessionInfo();
-    ExtractVoiceInfo();
-    ExtractVideoInfo(level);
+    if (has_voice_info)
+      ExtractVoiceInfo(voice_info);
+    if (has_video_info)
+      ExtractVideoInfo(video_info, level);
     ExtractSenderInfo();
     ExtractDataInfo();
     UpdateTrackReports();
+
+    // Drop the values of replaced reports that were not refreshed.
+    reports_.RemoveStaleValues();
   }
 }
 
@@ -774,20 +794,11 @@ void StatsCollector::ExtractSessionInfo() {
   }
 }
 
-void StatsCollector::ExtractVoiceInfo() {
+void StatsCollector::ExtractVoiceInfo(
+    const cricket::VoiceMediaInfo& voice_info) {
   RTC_DCHECK(pc_->session()->signaling_thread()->IsCurrent());
+  RTC_DCHECK(pc_->session()->voice_channel());
 
-  if (!pc_->session()->voice_channel()) {
-    return;
-  }
-  cricket::VoiceMediaInfo voice_info;
-  if (!pc_->session()->voice_channel()->GetStats(&voice_info)) {
-    LOG(LS_ERROR) << "Failed to get voice channel stats.";
-    return;
-  }
-
-  // TODO(tommi): The above code should run on the worker thread and post the
-  // results back to the signaling thread, where we can add data to the reports.
   rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
 
   StatsReport::Id transport_id(GetTransportIdFromProxy(
@@ -807,20 +818,11 @@ void StatsCollector::ExtractVoiceInfo() {
 }
 
 void StatsCollector::ExtractVideoInfo(
+    const cricket::VideoMediaInfo& video_info,
     PeerConnectionInterface::StatsOutputLevel level) {
   RTC_DCHECK(pc_->session()->signaling_thread()->IsCurrent());
+  RTC_DCHECK(pc_->session()->video_channel());
 
-  if (!pc_->session()->video_channel())
-    return;
-
-  cricket::VideoMediaInfo video_info;
-  if (!pc_->session()->video_channel()->GetStats(&video_info)) {
-    LOG(LS_ERROR) << "Failed to get video channel stats.";
-    return;
-  }
-
-  // TODO(tommi): The above code should run on the worker thread and post the
-  // results back to the signaling thread, where we can add data to the reports.
   rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
 
   StatsReport::Id transport_id(GetTransportIdFromProxy(
@@ -111,8 +111,9 @@ class StatsCollector {
 
   void ExtractDataInfo();
   void ExtractSessionInfo();
-  void ExtractVoiceInfo();
-  void ExtractVideoInfo(PeerConnectionInterface::StatsOutputLevel level);
+  void ExtractVoiceInfo(const cricket::VoiceMediaInfo& voice_info);
+  void ExtractVideoInfo(const cricket::VideoMediaInfo& video_info,
+                        PeerConnectionInterface::StatsOutputLevel level);
   void ExtractSenderInfo();
   void BuildSsrcToTransportId();
   webrtc::StatsReport* GetReport(const StatsReport::StatsType& type,
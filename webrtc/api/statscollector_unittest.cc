@@ -822,6 +822,29 @@ class StatsCollectorTest : public testing::Test {
   std::vector<rtc::scoped_refptr<DataChannel>> data_channels_;
 };
 
+// Verify that replacing a report reuses it, updates its values in place and
+// drops the values that were not added again.
+TEST_F(StatsCollectorTest, ReplacedReportKeepsOnlyRefreshedValues) {
+  StatsCollection reports;
+  StatsReport::Id id(StatsReport::NewTypedId(
+      StatsReport::kStatsReportTypeSession, "session"));
+  StatsReport* report = reports.ReplaceOrAddNew(id);
+  report->AddInt64(StatsReport::kStatsValueNameBytesSent, 1);
+  report->AddString(StatsReport::kStatsValueNameLabel, "label");
+  const StatsReport::Value* bytes_sent =
+      report->FindValue(StatsReport::kStatsValueNameBytesSent);
+
+  EXPECT_EQ(report, reports.ReplaceOrAddNew(id));
+  report->AddInt64(StatsReport::kStatsValueNameBytesSent, 2);
+  reports.RemoveStaleValues();
+
+  EXPECT_EQ(1u, reports.size());
+  EXPECT_EQ(bytes_sent,
+            report->FindValue(StatsReport::kStatsValueNameBytesSent));
+  EXPECT_EQ(2, bytes_sent->int64_val());
+  EXPECT_FALSE(report->FindValue(StatsReport::kStatsValueNameLabel));
+}
+
 TEST_F(StatsCollectorTest, FilterOutNegativeDataChannelId) {
   const std::string label = "hacks";
   // The data channel id is from the Config which is -1 initially.
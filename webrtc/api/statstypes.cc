@@ -213,33 +213,33 @@ bool StatsReport::IdBase::Equals(const IdBase& other) const {
 }
 
 StatsReport::Value::Value(StatsValueName name, int64_t value, Type int_type)
-    : name(name), type_(int_type) {
+    : name(name), type_(int_type), stale_(false) {
   RTC_DCHECK(type_ == kInt || type_ == kInt64);
   type_ == kInt ? value_.int_ = static_cast<int>(value) : value_.int64_ = value;
 }
 
 StatsReport::Value::Value(StatsValueName name, float f)
-    : name(name), type_(kFloat) {
+    : name(name), type_(kFloat), stale_(false) {
   value_.float_ = f;
 }
 
 StatsReport::Value::Value(StatsValueName name, const std::string& value)
-    : name(name), type_(kString) {
+    : name(name), type_(kString), stale_(false) {
   value_.string_ = new std::string(value);
 }
 
 StatsReport::Value::Value(StatsValueName name, const char* value)
-    : name(name), type_(kStaticString) {
+    : name(name), type_(kStaticString), stale_(false) {
   value_.static_string_ = value;
 }
 
 StatsReport::Value::Value(StatsValueName name, bool b)
-    : name(name), type_(kBool) {
+    : name(name), type_(kBool), stale_(false) {
   value_.bool_ = b;
 }
 
 StatsReport::Value::Value(StatsValueName name, const Id& value)
-    : name(name), type_(kId) {
+    : name(name), type_(kId), stale_(false) {
   value_.id_ = new Id(value);
 }
 
@@ -655,46 +655,60 @@ const char* StatsReport::TypeToString() const {
 
 void StatsReport::AddString(StatsReport::StatsValueName name,
                             const std::string& value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
+  Value* found = FindValueForUpdate(name, Value::kString);
+  if (found)
+    *found->value_.string_ = value;
+  else
     values_[name] = ValuePtr(new Value(name, value));
 }
 
 void StatsReport::AddString(StatsReport::StatsValueName name,
                             const char* value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
+  Value* found = FindValueForUpdate(name, Value::kStaticString);
+  if (found)
+    found->value_.static_string_ = value;
+  else
     values_[name] = ValuePtr(new Value(name, value));
 }
 
 void StatsReport::AddInt64(StatsReport::StatsValueName name, int64_t value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
+  Value* found = FindValueForUpdate(name, Value::kInt64);
+  if (found)
+    found->value_.int64_ = value;
+  else
     values_[name] = ValuePtr(new Value(name, value, Value::kInt64));
 }
 
 void StatsReport::AddInt(StatsReport::StatsValueName name, int value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == static_cast<int64_t>(value)))
+  Value* found = FindValueForUpdate(name, Value::kInt);
+  if (found)
+    found->value_.int_ = value;
+  else
     values_[name] = ValuePtr(new Value(name, value, Value::kInt));
 }
 
 void StatsReport::AddFloat(StatsReport::StatsValueName name, float value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
+  Value* found = FindValueForUpdate(name, Value::kFloat);
+  if (found)
+    found->value_.float_ = value;
+  else
     values_[name] = ValuePtr(new Value(name, value));
 }
 
 void StatsReport::AddBoolean(StatsReport::StatsValueName name, bool value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
+  Value* found = FindValueForUpdate(name, Value::kBool);
+  if (found)
+    found->value_.bool_ = value;
+  else
     values_[name] = ValuePtr(new Value(name, value));
 }
 
 void StatsReport::AddId(StatsReport::StatsValueName name,
                         const Id& value) {
-  const Value* found = FindValue(name);
-  if (!found || !(*found == value))
+  Value* found = FindValueForUpdate(name, Value::kId);
+  if (found)
+    *found->value_.id_ = value;
+  else
     values_[name] = ValuePtr(new Value(name, value));
 }
 
@@ -703,6 +717,30 @@ const StatsReport::Value* StatsReport::FindValue(StatsValueName name) const {
   return it == values_.end() ? nullptr : it->second.get();
 }
 
+void StatsReport::MarkValuesStale() {
+  for (auto& it : values_)
+    it.second->stale_ = true;
+}
+
+void StatsReport::RemoveStaleValues() {
+  Values::iterator it = values_.begin();
+  while (it != values_.end()) {
+    if (it->second->stale_)
+      it = values_.erase(it);
+    else
+      ++it;
+  }
+}
+
+StatsReport::Value* StatsReport::FindValueForUpdate(StatsValueName name,
+                                                    Value::Type type) {
+  Values::iterator it = values_.find(name);
+  if (it == values_.end() || it->second->type() != type)
+    return nullptr;
+  it->second->stale_ = false;
+  return it->second.get();
+}
+
 StatsCollection::StatsCollection() {
 }
 
@@ -747,14 +785,18 @@ StatsReport* StatsCollection::ReplaceOrAddNew(const StatsReport::Id& id) {
   Container::iterator it = std::find_if(list_.begin(), list_.end(),
       [&id](const StatsReport* r)->bool { return r->id()->Equals(id); });
   if (it != end()) {
-    StatsReport* report = new StatsReport((*it)->id());
-    delete *it;
-    *it = report;
-    return report;
+    (*it)->MarkValuesStale();
+    return *it;
   }
   return InsertNew(id);
 }
 
+void StatsCollection::RemoveStaleValues() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  for (auto* r : list_)
+    r->RemoveStaleValues();
+}
+
 // Looks for a report with the given |id|.  If one is not found, NULL
 // will be returned.
 StatsReport* StatsCollection::Find(const StatsReport::Id& id) {
@@ -294,7 +294,14 @@ class StatsReport {
     const StatsValueName name;
 
    private:
+    // StatsReport updates the value in place when it is added again with the
+    // same type.
+    friend class StatsReport;
+
     const Type type_;
+    // Set by StatsReport::MarkValuesStale() and cleared when the value is
+    // added again.
+    bool stale_;
     // TODO(tommi): Use C++ 11 union and make value_ const.
     union InternalType {
       int int_;
@@ -349,7 +356,17 @@ class StatsReport {
 
   const Value* FindValue(StatsValueName name) const;
 
+  // Marks all values as stale. Values that are not added again before the
+  // next call to RemoveStaleValues() are removed by it. This allows a report
+  // to be refilled without reallocating the values that are still present.
+  void MarkValuesStale();
+  void RemoveStaleValues();
+
  private:
+  // Returns the value for |name| if it exists and has type |type|, and marks
+  // it as fresh.
+  Value* FindValueForUpdate(StatsValueName name, Value::Type type);
+
   // The unique identifier for this object.
   // This is used as a key for this report in ordered containers,
   // so it must never be changed.
@@ -387,8 +404,14 @@ class StatsCollection {
   // exist in the list of reports.
   StatsReport* InsertNew(const StatsReport::Id& id);
   StatsReport* FindOrAddNew(const StatsReport::Id& id);
+  // Like FindOrAddNew(), but the values of an existing report are marked as
+  // stale. Values that are not added again are removed by the next call to
+  // RemoveStaleValues(), so the report ends up as if it had been recreated.
   StatsReport* ReplaceOrAddNew(const StatsReport::Id& id);
 
+  // Removes the values of replaced reports that were not added again.
+  void RemoveStaleValues();
+
   // Looks for a report with the given |id|.  If one is not found, NULL
   // will be returned.
   StatsReport* Find(const StatsReport::Id& id);
@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <sstream>
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/api/jsepsessiondescription.h"
+#include "webrtc/api/webrtcsdp.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+const int kNumIterations = 20;
+
+// Returns an offer with |num_media_sections| audio and as many video m-lines,
+// each with its own mid and track, all bundled on one transport. This is what
+// a large Unified Plan conference offer looks like.
+std::string CreateLargeOffer(int num_media_sections) {
+  std::ostringstream bundle;
+  std::ostringstream media;
+  for (int i = 0; i < num_media_sections; ++i) {
+    for (int video = 0; video < 2; ++video) {
+      const std::string mid = (video ? "video" : "audio") + rtc::ToString(i);
+      const int ssrc = 2 * i + video + 1;
+      bundle << " " << mid;
+      if (video) {
+        media << "m=video 9 UDP/TLS/RTP/SAVPF 100 101 116\r\n";
+      } else {
+        media << "m=audio 9 UDP/TLS/RTP/SAVPF 111 103 9 0 8 126\r\n";
+      }
+      media << "c=IN IP4 0.0.0.0\r\n"
+            << "a=rtcp:9 IN IP4 0.0.0.0\r\n"
+            << "a=ice-ufrag:ufrag\r\n"
+            << "a=ice-pwd:pwd_pwd_pwd_pwd_pwd_pwd\r\n"
+            << "a=fingerprint:sha-256 "
+               "8B:87:09:8A:5D:C2:F3:33:EF:C5:B1:F6:84:3A:3D:D6:A3:E2:9C:17:"
+               "4A:E7:46:3B:EE:9A:CB:B6:9A:E2:C0:D6\r\n"
+            << "a=setup:actpass\r\n"
+            << "a=mid:" << mid << "\r\n"
+            << "a=extmap:1 urn:ietf:params:rtp-hdrext:toffset\r\n"
+            << "a=extmap:3 http://www.webrtc.org/experiments/rtp-hdrext/"
+               "abs-send-time\r\n"
+            << "a=sendrecv\r\n"
+            << "a=rtcp-mux\r\n";
+      if (video) {
+        media << "a=rtpmap:100 VP8/90000\r\n"
+              << "a=rtcp-fb:100 ccm fir\r\n"
+              << "a=rtcp-fb:100 nack\r\n"
+              << "a=rtcp-fb:100 nack pli\r\n"
+              << "a=rtcp-fb:100 goog-remb\r\n"
+              << "a=rtpmap:101 VP9/90000\r\n"
+              << "a=rtcp-fb:101 nack\r\n"
+              << "a=rtpmap:116 red/90000\r\n";
+      } else {
+        media << "a=rtpmap:111 opus/48000/2\r\n"
+              << "a=fmtp:111 minptime=10;useinbandfec=1\r\n"
+              << "a=rtpmap:103 ISAC/16000\r\n"
+              << "a=rtpmap:9 G722/8000\r\n"
+              << "a=rtpmap:0 PCMU/8000\r\n"
+              << "a=rtpmap:8 PCMA/8000\r\n"
+              << "a=rtpmap:126 telephone-event/8000\r\n";
+      }
+      media << "a=ssrc:" << ssrc << " cname:cname\r\n"
+            << "a=ssrc:" << ssrc << " msid:stream" << i << " track_" << mid
+            << "\r\n"
+            << "a=ssrc:" << ssrc << " mslabel:stream" << i << "\r\n"
+            << "a=ssrc:" << ssrc << " label:track_" << mid << "\r\n";
+    }
+  }
+
+  std::ostringstream sdp;
+  sdp << "v=0\r\n"
+      << "o=- 18446744069414584320 18446462598732840960 IN IP4 127.0.0.1\r\n"
+      << "s=-\r\n"
+      << "t=0 0\r\n"
+      << "a=group:BUNDLE" << bundle.str() << "\r\n"
+      << "a=msid-semantic: WMS\r\n"
+      << media.str();
+  return sdp.str();
+}
+
+void MeasureOffer(int num_media_sections) {
+  const std::string sdp = CreateLargeOffer(num_media_sections);
+  std::string serialized;
+  int64_t deserialize_ns = 0;
+  int64_t serialize_ns = 0;
+  for (int i = 0; i < kNumIterations; ++i) {
+    JsepSessionDescription jdesc(JsepSessionDescription::kOffer);
+    SdpParseError error;
+    int64_t start_ns = rtc::TimeNanos();
+    ASSERT_TRUE(SdpDeserialize(sdp, &jdesc, &error)) << error.description;
+    deserialize_ns += rtc::TimeNanos() - start_ns;
+
+    start_ns = rtc::TimeNanos();
+    serialized = SdpSerialize(jdesc, true);
+    serialize_ns += rtc::TimeNanos() - start_ns;
+  }
+  EXPECT_FALSE(serialized.empty());
+
+  const std::string trace = rtc::ToString(2 * num_media_sections) + "_mlines";
+  test::PrintResult("sdp_deserialize", "", trace,
+                    static_cast<size_t>(deserialize_ns / kNumIterations / 1000),
+                    "us", true);
+  test::PrintResult("sdp_serialize", "", trace,
+                    static_cast<size_t>(serialize_ns / kNumIterations / 1000),
+                    "us", true);
+}
+}  // namespace
+
+TEST(WebRtcSdpPerformanceTest, LargeUnifiedPlanOffer) {
+  MeasureOffer(8);
+  MeasureOffer(64);
+}
+
+}  // namespace webrtc
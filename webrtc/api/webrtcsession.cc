@@ -516,6 +516,7 @@ bool WebRtcSession::Initialize(
     const PeerConnectionInterface::RTCConfiguration& rtc_configuration) {
   bundle_policy_ = rtc_configuration.bundle_policy;
   rtcp_mux_policy_ = rtc_configuration.rtcp_mux_policy;
+  crypto_options_ = options.crypto_options;
   transport_controller_->SetSslMaxProtocolVersion(options.ssl_max_version);
 
   // Obtain a certificate from RTCConfiguration if any were provided (optional).
@@ -643,13 +644,17 @@ void WebRtcSession::CreateOffer(
     CreateSessionDescriptionObserver* observer,
     const PeerConnectionInterface::RTCOfferAnswerOptions& options,
     const cricket::MediaSessionOptions& session_options) {
-  webrtc_session_desc_factory_->CreateOffer(observer, options, session_options);
+  cricket::MediaSessionOptions offer_options(session_options);
+  offer_options.crypto_options = crypto_options_;
+  webrtc_session_desc_factory_->CreateOffer(observer, options, offer_options);
 }
 
 void WebRtcSession::CreateAnswer(
     CreateSessionDescriptionObserver* observer,
     const cricket::MediaSessionOptions& session_options) {
-  webrtc_session_desc_factory_->CreateAnswer(observer, session_options);
+  cricket::MediaSessionOptions answer_options(session_options);
+  answer_options.crypto_options = crypto_options_;
+  webrtc_session_desc_factory_->CreateAnswer(observer, answer_options);
 }
 
 bool WebRtcSession::SetLocalDescription(SessionDescriptionInterface* desc,
@@ -528,6 +528,9 @@ class WebRtcSession : public AudioProviderInterface,
   // Declares the RTCP mux policy for the WebRTCSession.
   PeerConnectionInterface::RtcpMuxPolicy rtcp_mux_policy_;
 
+  // Crypto options of the offers and answers, from the factory options.
+  rtc::CryptoOptions crypto_options_;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(WebRtcSession);
 };
 }  // namespace webrtc
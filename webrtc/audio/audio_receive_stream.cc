@@ -230,9 +230,9 @@ bool AudioReceiveStream::DeliverRtp(const uint8_t* packet,
   // video and shouldn't be mixed.
   if (remote_bitrate_estimator_ &&
       header.extension.hasTransportSequenceNumber) {
-    int64_t arrival_time_ms = rtc::TimeMillis();
-    if (packet_time.timestamp >= 0)
-      arrival_time_ms = (packet_time.timestamp + 500) / 1000;
+    int64_t arrival_time_ms = packet_time.timestamp >= 0
+                                  ? (packet_time.timestamp + 500) / 1000
+                                  : rtc::TimeMillis();
     size_t payload_size = length - header.headerLength;
     remote_bitrate_estimator_->IncomingPacket(arrival_time_ms, payload_size,
                                               header, false);
@@ -25,15 +25,15 @@ namespace rtc {
 class AsyncInvoker;
 
 // Helper class for AsyncInvoker. Runs a task and triggers a callback
-// on the calling thread if necessary. Instances are ref-counted so their
-// lifetime can be independent of AsyncInvoker.
-class AsyncClosure : public RefCountInterface {
+// on the calling thread if necessary. Instances are posted as the data of
+// their message, so they are owned by the target thread's queue until they
+// run, and their lifetime can be independent of AsyncInvoker.
+class AsyncClosure : public MessageData {
  public:
+  ~AsyncClosure() override {}
   // Runs the asynchronous task, and triggers a callback to the calling
   // thread if needed. Should be called from the target thread.
   virtual void Execute() = 0;
- protected:
-  ~AsyncClosure() override {}
 };
 
 // Simple closure that doesn't trigger a callback for the calling thread.
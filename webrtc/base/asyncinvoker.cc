@@ -25,11 +25,9 @@ AsyncInvoker::~AsyncInvoker() {
 }
 
 void AsyncInvoker::OnMessage(Message* msg) {
-  // Get the AsyncClosure shared ptr from this message's data.
-  ScopedRefMessageData<AsyncClosure>* data =
-      static_cast<ScopedRefMessageData<AsyncClosure>*>(msg->pdata);
-  scoped_refptr<AsyncClosure> closure = data->data();
-  delete msg->pdata;
+  // Take ownership of the AsyncClosure posted as this message's data.
+  std::unique_ptr<AsyncClosure> closure(
+      static_cast<AsyncClosure*>(msg->pdata));
   msg->pdata = NULL;
 
   // Execute the closure and trigger the return message if needed.
@@ -56,25 +54,24 @@ void AsyncInvoker::Flush(Thread* thread, uint32_t id /*= MQID_ANY*/) {
 }
 
 void AsyncInvoker::DoInvoke(Thread* thread,
-                            const scoped_refptr<AsyncClosure>& closure,
+                            std::unique_ptr<AsyncClosure> closure,
                             uint32_t id) {
   if (destroying_) {
     LOG(LS_WARNING) << "Tried to invoke while destroying the invoker.";
     return;
   }
-  thread->Post(this, id, new ScopedRefMessageData<AsyncClosure>(closure));
+  thread->Post(this, id, closure.release());
 }
 
 void AsyncInvoker::DoInvokeDelayed(Thread* thread,
-                                   const scoped_refptr<AsyncClosure>& closure,
+                                   std::unique_ptr<AsyncClosure> closure,
                                    uint32_t delay_ms,
                                    uint32_t id) {
   if (destroying_) {
     LOG(LS_WARNING) << "Tried to invoke while destroying the invoker.";
     return;
   }
-  thread->PostDelayed(delay_ms, this, id,
-                      new ScopedRefMessageData<AsyncClosure>(closure));
+  thread->PostDelayed(delay_ms, this, id, closure.release());
 }
 
 GuardedAsyncInvoker::GuardedAsyncInvoker() : thread_(Thread::Current()) {
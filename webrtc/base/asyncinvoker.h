@@ -11,6 +11,9 @@
 #ifndef WEBRTC_BASE_ASYNCINVOKER_H_
 #define WEBRTC_BASE_ASYNCINVOKER_H_
 
+#include <memory>
+#include <utility>
+
 #include "webrtc/base/asyncinvoker-inl.h"
 #include "webrtc/base/bind.h"
 #include "webrtc/base/constructormagic.h"
@@ -76,9 +79,9 @@ class AsyncInvoker : public MessageHandler {
   // completion. Returns immediately.
   template <class ReturnT, class FunctorT>
   void AsyncInvoke(Thread* thread, const FunctorT& functor, uint32_t id = 0) {
-    scoped_refptr<AsyncClosure> closure(
-        new RefCountedObject<FireAndForgetAsyncClosure<FunctorT> >(functor));
-    DoInvoke(thread, closure, id);
+    std::unique_ptr<AsyncClosure> closure(
+        new FireAndForgetAsyncClosure<FunctorT>(functor));
+    DoInvoke(thread, std::move(closure), id);
   }
 
   // Call |functor| asynchronously on |thread| with |delay_ms|, with no callback
@@ -88,9 +91,9 @@ class AsyncInvoker : public MessageHandler {
                           const FunctorT& functor,
                           uint32_t delay_ms,
                           uint32_t id = 0) {
-    scoped_refptr<AsyncClosure> closure(
-        new RefCountedObject<FireAndForgetAsyncClosure<FunctorT> >(functor));
-    DoInvokeDelayed(thread, closure, delay_ms, id);
+    std::unique_ptr<AsyncClosure> closure(
+        new FireAndForgetAsyncClosure<FunctorT>(functor));
+    DoInvokeDelayed(thread, std::move(closure), delay_ms, id);
   }
 
   // Call |functor| asynchronously on |thread|, calling |callback| when done.
@@ -100,10 +103,10 @@ class AsyncInvoker : public MessageHandler {
                    void (HostT::*callback)(ReturnT),
                    HostT* callback_host,
                    uint32_t id = 0) {
-    scoped_refptr<AsyncClosure> closure(
-        new RefCountedObject<NotifyingAsyncClosure<ReturnT, FunctorT, HostT> >(
+    std::unique_ptr<AsyncClosure> closure(
+        new NotifyingAsyncClosure<ReturnT, FunctorT, HostT>(
             this, Thread::Current(), functor, callback, callback_host));
-    DoInvoke(thread, closure, id);
+    DoInvoke(thread, std::move(closure), id);
   }
 
   // Call |functor| asynchronously on |thread|, calling |callback| when done.
@@ -114,10 +117,10 @@ class AsyncInvoker : public MessageHandler {
                    void (HostT::*callback)(),
                    HostT* callback_host,
                    uint32_t id = 0) {
-    scoped_refptr<AsyncClosure> closure(
-        new RefCountedObject<NotifyingAsyncClosure<void, FunctorT, HostT> >(
+    std::unique_ptr<AsyncClosure> closure(
+        new NotifyingAsyncClosure<void, FunctorT, HostT>(
             this, Thread::Current(), functor, callback, callback_host));
-    DoInvoke(thread, closure, id);
+    DoInvoke(thread, std::move(closure), id);
   }
 
   // Synchronously execute on |thread| all outstanding calls we own
@@ -133,10 +136,10 @@ class AsyncInvoker : public MessageHandler {
  private:
   void OnMessage(Message* msg) override;
   void DoInvoke(Thread* thread,
-                const scoped_refptr<AsyncClosure>& closure,
+                std::unique_ptr<AsyncClosure> closure,
                 uint32_t id);
   void DoInvokeDelayed(Thread* thread,
-                       const scoped_refptr<AsyncClosure>& closure,
+                       std::unique_ptr<AsyncClosure> closure,
                        uint32_t delay_ms,
                        uint32_t id);
   bool destroying_;
@@ -14,6 +14,7 @@ namespace rtc {
 
 PacketTimeUpdateParams::PacketTimeUpdateParams()
     : rtp_sendtime_extension_id(-1),
+      rtp_sendtime_extension_offset(-1),
       srtp_auth_tag_len(-1),
       srtp_packet_index(-1) {
 }
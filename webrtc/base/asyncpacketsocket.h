@@ -27,6 +27,10 @@ struct PacketTimeUpdateParams {
   ~PacketTimeUpdateParams();
 
   int rtp_sendtime_extension_id;    // extension header id present in packet.
+  // Offset of the send time extension data in the RTP packet, if known when
+  // the packet was prepared, so that it needn't be looked up when sending.
+  // -1 if unknown.
+  int rtp_sendtime_extension_offset;
   std::vector<char> srtp_auth_key;  // Authentication key.
   int srtp_auth_tag_len;            // Authentication tag length.
   int64_t srtp_packet_index;        // Required for Rtp Packet authentication.
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "webrtc/base/asynctcpsocket.h"
 #include "webrtc/base/gunit.h"
@@ -36,12 +37,21 @@ class AsyncTCPSocketTest
     ready_to_send_ = true;
   }
 
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const rtc::PacketTime& packet_time) {
+    received_packets_.push_back(std::string(data, size));
+  }
+
  protected:
   std::unique_ptr<PhysicalSocketServer> pss_;
   std::unique_ptr<VirtualSocketServer> vss_;
   AsyncSocket* socket_;
   std::unique_ptr<AsyncTCPSocket> tcp_socket_;
   bool ready_to_send_;
+  std::vector<std::string> received_packets_;
 };
 
 TEST_F(AsyncTCPSocketTest, OnWriteEvent) {
@@ -50,4 +60,22 @@ TEST_F(AsyncTCPSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+TEST_F(AsyncTCPSocketTest, ProcessInputWithSeveralPackets) {
+  tcp_socket_->SignalReadPacket.connect(static_cast<AsyncTCPSocketTest*>(this),
+                                        &AsyncTCPSocketTest::OnReadPacket);
+  // Two complete packets followed by the first byte of a third.
+  char data[] = {0, 3, 'a', 'b', 'c', 0, 0, 0, 2, 'd', 'e', 0, 5, 'f'};
+  size_t len = sizeof(data);
+  tcp_socket_->ProcessInput(data, &len);
+
+  ASSERT_EQ(3u, received_packets_.size());
+  EXPECT_EQ("abc", received_packets_[0]);
+  EXPECT_EQ("", received_packets_[1]);
+  EXPECT_EQ("de", received_packets_[2]);
+  ASSERT_EQ(3u, len);
+  EXPECT_EQ(0, data[0]);
+  EXPECT_EQ(5, data[1]);
+  EXPECT_EQ('f', data[2]);
+}
+
 }  // namespace rtc
@@ -15,6 +15,8 @@ namespace rtc {
 
 static const int BUF_SIZE = 64 * 1024;
 
+const size_t AsyncUDPSocket::kMaxBatchedPacketSize;
+
 AsyncUDPSocket* AsyncUDPSocket::Create(
     AsyncSocket* socket,
     const SocketAddress& bind_address) {
@@ -36,7 +38,7 @@ AsyncUDPSocket* AsyncUDPSocket::Create(SocketFactory* factory,
 }
 
 AsyncUDPSocket::AsyncUDPSocket(AsyncSocket* socket)
-    : socket_(socket) {
+    : socket_(socket), batch_stopped_(nullptr) {
   size_ = BUF_SIZE;
   buf_ = new char[size_];
 
@@ -46,6 +48,7 @@ AsyncUDPSocket::AsyncUDPSocket(AsyncSocket* socket)
 }
 
 AsyncUDPSocket::~AsyncUDPSocket() {
+  StopBatch();
   delete [] buf_;
 }
 
@@ -75,6 +78,7 @@ int AsyncUDPSocket::SendTo(const void *pv, size_t cb,
 }
 
 int AsyncUDPSocket::Close() {
+  StopBatch();
   return socket_->Close();
 }
 
@@ -98,9 +102,66 @@ void AsyncUDPSocket::SetError(int error) {
   return socket_->SetError(error);
 }
 
+void AsyncUDPSocket::SetReceiveBatchSize(size_t max_packets) {
+  if (max_packets <= 1) {
+    batch_.clear();
+    batch_buf_.reset();
+    return;
+  }
+
+  batch_.resize(max_packets);
+  batch_buf_.reset(new char[(max_packets - 1) * kMaxBatchedPacketSize]);
+  batch_[0].data = buf_;
+  batch_[0].capacity = size_;
+  for (size_t i = 1; i < max_packets; ++i) {
+    batch_[i].data = &batch_buf_[(i - 1) * kMaxBatchedPacketSize];
+    batch_[i].capacity = kMaxBatchedPacketSize;
+  }
+}
+
+void AsyncUDPSocket::StopBatch() {
+  if (batch_stopped_) {
+    *batch_stopped_ = true;
+    batch_stopped_ = nullptr;
+  }
+}
+
 void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
   ASSERT(socket_.get() == socket);
 
+  if (!batch_.empty()) {
+    int count = socket_->RecvFromBatch(&batch_[0], batch_.size());
+    if (count < 0) {
+      // See below.
+      SocketAddress local_addr = socket_->GetLocalAddress();
+      LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                   << "] receive failed with error " << socket_->GetError();
+      return;
+    }
+
+    bool stopped = false;
+    batch_stopped_ = &stopped;
+    for (int i = 0; i < count; ++i) {
+      const ReceivedDatagram& datagram = batch_[i];
+      if (datagram.truncated) {
+        LOG(LS_WARNING) << "Dropping a datagram larger than "
+                        << datagram.capacity << " bytes from "
+                        << datagram.addr.ToSensitiveString();
+        continue;
+      }
+      SignalReadPacket(this, static_cast<const char*>(datagram.data),
+                       datagram.size, datagram.addr,
+                       (datagram.timestamp > -1
+                            ? PacketTime(datagram.timestamp, 0)
+                            : CreatePacketTime(0)));
+      // The handler closed or deleted the socket, so |this| can't be used.
+      if (stopped)
+        return;
+    }
+    batch_stopped_ = nullptr;
+    return;
+  }
+
   SocketAddress remote_addr;
   int64_t timestamp;
   int len = socket_->RecvFrom(buf_, size_, &remote_addr, &timestamp);
@@ -12,6 +12,7 @@
 #define WEBRTC_BASE_ASYNCUDPSOCKET_H_
 
 #include <memory>
+#include <vector>
 
 #include "webrtc/base/asyncpacketsocket.h"
 #include "webrtc/base/socketfactory.h"
@@ -51,7 +52,21 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int GetError() const override;
   void SetError(int error) override;
 
+  // Maximum size of the datagrams read after the first one of a batch.
+  static const size_t kMaxBatchedPacketSize = 2048;
+
+  // Reads up to |max_packets| datagrams per read event instead of one, if the
+  // underlying socket supports it (see Socket::RecvFromBatch), which saves a
+  // wakeup and a system call per packet under load. The datagrams are still
+  // delivered one by one through SignalReadPacket. Only the first datagram of
+  // a batch may be larger than kMaxBatchedPacketSize, later ones that are
+  // larger are dropped, so this should only be enabled for traffic bounded by
+  // the path MTU. Off by default.
+  void SetReceiveBatchSize(size_t max_packets);
+
  private:
+  // Drops the rest of the batch being delivered, if any.
+  void StopBatch();
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(AsyncSocket* socket);
   // Called when the underlying socket is ready to send.
@@ -60,6 +75,14 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   std::unique_ptr<AsyncSocket> socket_;
   char* buf_;
   size_t size_;
+  // Storage for the datagrams after the first one of a batch, which is read
+  // into |buf_|. Empty unless batched reads are enabled.
+  std::unique_ptr<char[]> batch_buf_;
+  std::vector<ReceivedDatagram> batch_;
+  // Points to a flag on the stack of OnReadEvent() while it delivers a batch.
+  // Close() and the destructor set it, so that the rest of the batch is
+  // dropped when a SignalReadPacket handler closes or deletes the socket.
+  bool* batch_stopped_;
 };
 
 }  // namespace rtc
@@ -14,6 +14,7 @@
 #include "webrtc/base/asyncudpsocket.h"
 #include "webrtc/base/gunit.h"
 #include "webrtc/base/physicalsocketserver.h"
+#include "webrtc/base/stringencode.h"
 #include "webrtc/base/virtualsocketserver.h"
 
 namespace rtc {
@@ -50,4 +51,84 @@ TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+class PacketCounter : public sigslot::has_slots<> {
+ public:
+  PacketCounter() : count_(0), close_(false) {}
+
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& remote_addr,
+                    const PacketTime& packet_time) {
+    EXPECT_EQ(std::string(data, size), "packet " + rtc::ToString(count_));
+    ++count_;
+    if (close_)
+      socket->Close();
+  }
+
+  int count() const { return count_; }
+  // Makes the handler close the socket after the first packet.
+  void set_close() { close_ = true; }
+
+ private:
+  int count_;
+  bool close_;
+};
+
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+class AsyncUdpSocketBatchTest : public AsyncUdpSocketTest {
+ protected:
+  void SetUp() override {
+    const SocketAddress kLoopback(IPAddress(INADDR_LOOPBACK), 0);
+    sender_.reset(AsyncUDPSocket::Create(pss_.get(), kLoopback));
+    receiver_.reset(AsyncUDPSocket::Create(pss_.get(), kLoopback));
+    ASSERT_TRUE(sender_);
+    ASSERT_TRUE(receiver_);
+    receiver_->SetReceiveBatchSize(8);
+    receiver_->SignalReadPacket.connect(&counter_,
+                                        &PacketCounter::OnReadPacket);
+  }
+
+  void Send(const std::string& packet) {
+    ASSERT_EQ(static_cast<int>(packet.size()),
+              sender_->SendTo(packet.data(), packet.size(),
+                              receiver_->GetLocalAddress(), PacketOptions()));
+  }
+
+  void SendPackets(int num_packets) {
+    for (int i = 0; i < num_packets; ++i)
+      Send("packet " + rtc::ToString(i));
+  }
+
+  std::unique_ptr<AsyncUDPSocket> sender_;
+  std::unique_ptr<AsyncUDPSocket> receiver_;
+  PacketCounter counter_;
+};
+
+// All pending datagrams should be delivered by a single read event.
+TEST_F(AsyncUdpSocketBatchTest, ReceiveBatch) {
+  const int kNumPackets = 5;
+  SendPackets(kNumPackets);
+  EXPECT_TRUE(pss_->Wait(0, true));
+  EXPECT_EQ(kNumPackets, counter_.count());
+}
+
+// A datagram which doesn't fit into its slot of the batch is dropped rather
+// than delivered truncated.
+TEST_F(AsyncUdpSocketBatchTest, DropsTruncatedDatagrams) {
+  Send("packet 0");
+  Send(std::string(AsyncUDPSocket::kMaxBatchedPacketSize + 1, 'x'));
+  Send("packet 1");
+  EXPECT_TRUE(pss_->Wait(0, true));
+  EXPECT_EQ(2, counter_.count());
+}
+
+TEST_F(AsyncUdpSocketBatchTest, StopsDeliveringWhenClosed) {
+  counter_.set_close();
+  SendPackets(5);
+  EXPECT_TRUE(pss_->Wait(0, true));
+  EXPECT_EQ(1, counter_.count());
+}
+#endif
+
 }  // namespace rtc
@@ -54,6 +54,8 @@
         'event_tracer.h',
         'exp_filter.cc',
         'exp_filter.h',
+        'fakeclock.cc',
+        'fakeclock.h',
         'md5.cc',
         'md5.h',
         'md5digest.cc',
@@ -139,23 +141,32 @@
             '<(DEPTH)/base/third_party/libevent/libevent.gyp:libevent',
           ],
         }],
-        ['enable_libevent==1', {
+        ['enable_task_queue_pool==1', {
           'sources': [
-            'task_queue_libevent.cc',
+            'task_queue_pool.cc',
             'task_queue_posix.cc',
           ],
         }, {
-          # If not libevent, fall back to the other task queues.
           'conditions': [
-            ['OS=="mac" or OS=="ios"', {
-             'sources': [
-               'task_queue_gcd.cc',
-               'task_queue_posix.cc',
-             ],
+            ['enable_libevent==1', {
+              'sources': [
+                'task_queue_libevent.cc',
+                'task_queue_posix.cc',
+              ],
+            }, {
+              # If not libevent, fall back to the other task queues.
+              'conditions': [
+                ['OS=="mac" or OS=="ios"', {
+                 'sources': [
+                   'task_queue_gcd.cc',
+                   'task_queue_posix.cc',
+                 ],
+                }],
+                ['OS=="win"', {
+                  'sources': [ 'task_queue_win.cc' ],
+                }]
+              ],
             }],
-            ['OS=="win"', {
-              'sources': [ 'task_queue_win.cc' ],
-            }]
           ],
         }],
       ],
@@ -527,6 +538,10 @@
           },
         }],
         ['OS=="linux"', {
+          'sources': [
+            'netlinknetworkmonitor.cc',
+            'netlinknetworkmonitor.h',
+          ],
           'link_settings': {
             'libraries': [
               '-ldl',
@@ -105,6 +105,16 @@ void Base64::EncodeFromArray(const void* data, size_t len,
   unsigned char c;
   size_t i = 0;
   size_t dest_ix = 0;
+  // Encode whole 3 byte groups without the end-of-input checks.
+  char* dest = &(*result)[0];
+  for (; i + 3 <= len; i += 3) {
+    uint32_t group = (byte_data[i] << 16) | (byte_data[i + 1] << 8) |
+                     byte_data[i + 2];
+    dest[dest_ix++] = Base64Table[(group >> 18) & 0x3f];
+    dest[dest_ix++] = Base64Table[(group >> 12) & 0x3f];
+    dest[dest_ix++] = Base64Table[(group >> 6) & 0x3f];
+    dest[dest_ix++] = Base64Table[group & 0x3f];
+  }
   while (i < len) {
     c = (byte_data[i] >> 2) & 0x3f;
     (*result)[dest_ix++] = Base64Table[c];
@@ -217,12 +227,31 @@ bool Base64::DecodeFromArrayTemplate(const char* data, size_t len,
   ASSERT(0 != term_flags);
 
   result->clear();
-  result->reserve(len);
+  result->reserve((len / 4 + 1) * 3);
 
   size_t dpos = 0;
   bool success = true, padded;
   unsigned char c, qbuf[4];
   while (dpos < len) {
+    // Decode runs of plain base64 characters directly; GetNextQuantum() is
+    // only needed around whitespace, padding and illegal characters.
+    while (dpos + 4 <= len) {
+      unsigned char c0 = DecodeTable[static_cast<unsigned char>(data[dpos])];
+      unsigned char c1 =
+          DecodeTable[static_cast<unsigned char>(data[dpos + 1])];
+      unsigned char c2 =
+          DecodeTable[static_cast<unsigned char>(data[dpos + 2])];
+      unsigned char c3 =
+          DecodeTable[static_cast<unsigned char>(data[dpos + 3])];
+      if ((c0 | c1 | c2 | c3) >= 64)
+        break;
+      result->push_back((c0 << 2) | (c1 >> 4));
+      result->push_back(((c1 << 4) & 0xf0) | (c2 >> 2));
+      result->push_back(((c2 << 6) & 0xc0) | c3);
+      dpos += 4;
+    }
+    if (dpos >= len)
+      break;
     size_t qlen = GetNextQuantum(parse_flags, (DO_PAD_NO == pad_flags),
                                  data, len, &dpos, qbuf, &padded);
     c = (qbuf[0] << 2) | ((qbuf[1] >> 4) & 0x3);
@@ -164,22 +164,30 @@ bool BitBuffer::ReadExponentialGolomb(uint32_t* val) {
   size_t original_byte_offset = byte_offset_;
   size_t original_bit_offset = bit_offset_;
 
-  // Count the number of leading 0 bits by peeking/consuming them one at a time.
+  // Count the number of leading 0 bits a byte at a time, starting with the
+  // unread bits of the current byte. Stop early once there are more zeros
+  // than can fit in a uint32_t value.
   size_t zero_bit_count = 0;
-  uint32_t peeked_bit;
-  while (PeekBits(&peeked_bit, 1) && peeked_bit == 0) {
-    zero_bit_count++;
-    ConsumeBits(1);
+  size_t byte_offset = byte_offset_;
+  size_t bits_in_byte = 8 - bit_offset_;
+  while (byte_offset < byte_count_ && zero_bit_count < 32 &&
+         LowestBits(bytes_[byte_offset], bits_in_byte) == 0) {
+    zero_bit_count += bits_in_byte;
+    ++byte_offset;
+    bits_in_byte = 8;
+  }
+  if (byte_offset < byte_count_ && zero_bit_count < 32) {
+    uint8_t byte = LowestBits(bytes_[byte_offset], bits_in_byte);
+    for (uint8_t mask = 1 << (bits_in_byte - 1); !(byte & mask); mask >>= 1)
+      ++zero_bit_count;
   }
-
-  // We should either be at the end of the stream, or the next bit should be 1.
-  RTC_DCHECK(!PeekBits(&peeked_bit, 1) || peeked_bit == 1);
 
   // The bit count of the value is the number of zeros + 1. Make sure that many
   // bits fits in a uint32_t and that we have enough bits left for it, and then
   // read the value.
   size_t value_bit_count = zero_bit_count + 1;
-  if (value_bit_count > 32 || !ReadBits(val, value_bit_count)) {
+  if (value_bit_count > 32 || !ConsumeBits(zero_bit_count) ||
+      !ReadBits(val, value_bit_count)) {
     RTC_CHECK(Seek(original_byte_offset, original_bit_offset));
     return false;
   }
@@ -10,8 +10,98 @@
 
 #include "webrtc/base/copyonwritebuffer.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "webrtc/base/arraysize.h"
+#include "webrtc/base/basictypes.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+
 namespace rtc {
 
+namespace {
+
+// Size classes of the pool. The larger one fits any RTP or RTCP packet
+// (cricket::kMaxRtpPacketLen), the smaller one most audio packets.
+const size_t kPoolCapacities[] = {256, 2048};
+// Bounds the memory held by the pool to about 300 kB.
+const size_t kMaxPooledBuffersPerCapacity = 128;
+
+class BufferPool {
+ public:
+  internal::PooledBuffer* Acquire(size_t size, size_t capacity) {
+    capacity = std::max(size, capacity);
+    const int index = CapacityIndex(capacity);
+    if (index >= 0) {
+      CritScope cs(&crit_);
+      std::vector<internal::PooledBuffer*>& free = free_[index];
+      if (!free.empty()) {
+        internal::PooledBuffer* buffer = free.back();
+        free.pop_back();
+        ++stats_.reuses;
+        --stats_.pooled;
+        buffer->SetSize(size);
+        return buffer;
+      }
+      ++stats_.allocations;
+    }
+    return new internal::PooledBuffer(size, capacity);
+  }
+
+  void Return(internal::PooledBuffer* buffer) {
+    const int index = CapacityIndex(buffer->capacity());
+    if (index >= 0) {
+      CritScope cs(&crit_);
+      std::vector<internal::PooledBuffer*>& free = free_[index];
+      if (free.size() < kMaxPooledBuffersPerCapacity) {
+        free.push_back(buffer);
+        ++stats_.pooled;
+        return;
+      }
+    }
+    delete buffer;
+  }
+
+  CopyOnWriteBuffer::PoolStats GetStats() {
+    CritScope cs(&crit_);
+    return stats_;
+  }
+
+ private:
+  static int CapacityIndex(size_t capacity) {
+    for (size_t i = 0; i < arraysize(kPoolCapacities); ++i) {
+      if (capacity == kPoolCapacities[i])
+        return static_cast<int>(i);
+    }
+    return -1;
+  }
+
+  CriticalSection crit_;
+  std::vector<internal::PooledBuffer*> free_[arraysize(kPoolCapacities)]
+      GUARDED_BY(crit_);
+  CopyOnWriteBuffer::PoolStats stats_ GUARDED_BY(crit_);
+};
+
+BufferPool* GetBufferPool() {
+  RTC_DEFINE_STATIC_LOCAL(BufferPool, pool, ());
+  return &pool;
+}
+
+}  // namespace
+
+namespace internal {
+
+int PooledBuffer::Release() const {
+  int count = AtomicOps::Decrement(&ref_count_);
+  if (!count) {
+    GetBufferPool()->Return(const_cast<PooledBuffer*>(this));
+  }
+  return count;
+}
+
+}  // namespace internal
+
 CopyOnWriteBuffer::CopyOnWriteBuffer() {
   RTC_DCHECK(IsConsistent());
 }
@@ -26,17 +116,37 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(CopyOnWriteBuffer&& buf) {
 }
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size)
-    : buffer_(size > 0 ? new RefCountedObject<Buffer>(size) : nullptr) {
+    : buffer_(size > 0 ? CreateBuffer(size, size) : nullptr) {
   RTC_DCHECK(IsConsistent());
 }
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size, size_t capacity)
     : buffer_(size > 0 || capacity > 0
-          ? new RefCountedObject<Buffer>(size, capacity)
+          ? CreateBuffer(size, capacity)
           : nullptr) {
   RTC_DCHECK(IsConsistent());
 }
 
 CopyOnWriteBuffer::~CopyOnWriteBuffer() = default;
 
+// static
+size_t CopyOnWriteBuffer::PooledCapacity(size_t size) {
+  for (size_t capacity : kPoolCapacities) {
+    if (size <= capacity)
+      return capacity;
+  }
+  return size;
+}
+
+// static
+CopyOnWriteBuffer::PoolStats CopyOnWriteBuffer::GetPoolStats() {
+  return GetBufferPool()->GetStats();
+}
+
+// static
+internal::PooledBuffer* CopyOnWriteBuffer::CreateBuffer(size_t size,
+                                                        size_t capacity) {
+  return GetBufferPool()->Acquire(size, capacity);
+}
+
 }  // namespace rtc
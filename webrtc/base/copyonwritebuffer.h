@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/buffer.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/refcount.h"
@@ -21,8 +22,43 @@
 
 namespace rtc {
 
+namespace internal {
+
+// Reference counted Buffer that is handed back to the CopyOnWriteBuffer pool
+// instead of being deleted when the last reference goes away.
+class PooledBuffer : public Buffer {
+ public:
+  PooledBuffer(size_t size, size_t capacity) : Buffer(size, capacity) {}
+
+  int AddRef() const { return AtomicOps::Increment(&ref_count_); }
+  int Release() const;
+  bool HasOneRef() const { return AtomicOps::AcquireLoad(&ref_count_) == 1; }
+
+ private:
+  mutable volatile int ref_count_ = 0;
+};
+
+}  // namespace internal
+
 class CopyOnWriteBuffer {
  public:
+  // Counters for the pool of released buffers. Only buffers whose capacity is
+  // exactly one of the pool size classes (see PooledCapacity()) are recycled.
+  struct PoolStats {
+    // Buffers of a pooled size class allocated from the heap.
+    size_t allocations = 0;
+    // Buffers taken from the pool instead of allocated.
+    size_t reuses = 0;
+    // Buffers currently held by the pool.
+    size_t pooled = 0;
+  };
+
+  // Returns the capacity to request for a buffer of |size| bytes so that its
+  // storage is drawn from and returned to the pool. Sizes larger than the
+  // largest size class are returned unchanged.
+  static size_t PooledCapacity(size_t size);
+  static PoolStats GetPoolStats();
+
   // An empty buffer.
   CopyOnWriteBuffer();
   // Copy size and contents of an existing buffer.
@@ -156,8 +192,10 @@ class CopyOnWriteBuffer {
   void SetData(const T* data, size_t size) {
     RTC_DCHECK(IsConsistent());
     if (!buffer_ || !buffer_->HasOneRef()) {
-      buffer_ = size > 0 ? new RefCountedObject<Buffer>(data, size)
-                         : nullptr;
+      buffer_ = size > 0 ? CreateBuffer(0, size) : nullptr;
+      if (buffer_) {
+        buffer_->SetData(data, size);
+      }
     } else {
       buffer_->SetData(data, size);
     }
@@ -187,7 +225,8 @@ class CopyOnWriteBuffer {
   void AppendData(const T* data, size_t size) {
     RTC_DCHECK(IsConsistent());
     if (!buffer_) {
-      buffer_ = new RefCountedObject<Buffer>(data, size);
+      buffer_ = CreateBuffer(0, size);
+      buffer_->SetData(data, size);
       RTC_DCHECK(IsConsistent());
       return;
     }
@@ -218,7 +257,7 @@ class CopyOnWriteBuffer {
     RTC_DCHECK(IsConsistent());
     if (!buffer_) {
       if (size > 0) {
-        buffer_ = new RefCountedObject<Buffer>(size);
+        buffer_ = CreateBuffer(size, size);
       }
       RTC_DCHECK(IsConsistent());
       return;
@@ -236,7 +275,7 @@ class CopyOnWriteBuffer {
     RTC_DCHECK(IsConsistent());
     if (!buffer_) {
       if (capacity > 0) {
-        buffer_ = new RefCountedObject<Buffer>(0, capacity);
+        buffer_ = CreateBuffer(0, capacity);
       }
       RTC_DCHECK(IsConsistent());
       return;
@@ -266,6 +305,10 @@ class CopyOnWriteBuffer {
   }
 
  private:
+  // Returns a buffer with the given size and at least the given capacity,
+  // taken from the pool when the capacity matches one of its size classes.
+  static internal::PooledBuffer* CreateBuffer(size_t size, size_t capacity);
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects.
   void CloneDataIfReferenced(size_t new_capacity) {
@@ -273,8 +316,9 @@ class CopyOnWriteBuffer {
       return;
     }
 
-    buffer_ = new RefCountedObject<Buffer>(buffer_->data(), buffer_->size(),
-        new_capacity);
+    internal::PooledBuffer* copy = CreateBuffer(0, new_capacity);
+    copy->SetData(buffer_->data(), buffer_->size());
+    buffer_ = copy;
     RTC_DCHECK(IsConsistent());
   }
 
@@ -284,7 +328,7 @@ class CopyOnWriteBuffer {
   }
 
   // buffer_ is either null, or points to an rtc::Buffer with capacity > 0.
-  scoped_refptr<RefCountedObject<Buffer>> buffer_;
+  scoped_refptr<internal::PooledBuffer> buffer_;
 };
 
 }  // namespace rtc
@@ -257,4 +257,38 @@ TEST(CopyOnWriteBufferTest, TestBacketWrite) {
   EXPECT_EQ(0, memcmp(buf2.cdata(), kTestData, 3));
 }
 
+TEST(CopyOnWriteBufferTest, TestReleasedBufferIsReused) {
+  const size_t capacity = CopyOnWriteBuffer::PooledCapacity(sizeof(kTestData));
+  EXPECT_GE(capacity, sizeof(kTestData));
+  const uint8_t* data;
+  {
+    CopyOnWriteBuffer buf(kTestData, sizeof(kTestData), capacity);
+    data = buf.cdata();
+  }
+  const CopyOnWriteBuffer::PoolStats before = CopyOnWriteBuffer::GetPoolStats();
+  EXPECT_GT(before.pooled, 0u);
+
+  CopyOnWriteBuffer buf(kTestData, 3, capacity);
+  EXPECT_EQ(data, buf.cdata());
+  EXPECT_EQ(3u, buf.size());
+  EXPECT_EQ(capacity, buf.capacity());
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 3));
+
+  const CopyOnWriteBuffer::PoolStats after = CopyOnWriteBuffer::GetPoolStats();
+  EXPECT_EQ(before.reuses + 1, after.reuses);
+  EXPECT_EQ(before.allocations, after.allocations);
+  EXPECT_EQ(before.pooled - 1, after.pooled);
+}
+
+TEST(CopyOnWriteBufferTest, TestOtherCapacitiesAreNotPooled) {
+  const CopyOnWriteBuffer::PoolStats before = CopyOnWriteBuffer::GetPoolStats();
+  {
+    CopyOnWriteBuffer buf(kTestData, 3, 10);
+    EXPECT_EQ(10u, buf.capacity());
+  }
+  const CopyOnWriteBuffer::PoolStats after = CopyOnWriteBuffer::GetPoolStats();
+  EXPECT_EQ(before.allocations, after.allocations);
+  EXPECT_EQ(before.pooled, after.pooled);
+}
+
 }  // namespace rtc
@@ -19,12 +19,15 @@ namespace rtc {
 // CRC32 polynomial, in reversed form.
 // See RFC 1952, or http://en.wikipedia.org/wiki/Cyclic_redundancy_check
 static const uint32_t kCrc32Polynomial = 0xEDB88320;
-static uint32_t kCrc32Table[256] = {0};
+// kCrc32Table[0] is the bytewise table from RFC 1952. kCrc32Table[k] gives
+// the CRC of a byte followed by k zero bytes, so that four bytes can be
+// folded in per iteration ("slicing-by-4").
+static uint32_t kCrc32Table[4][256] = {{0}};
 
 static void EnsureCrc32TableInited() {
-  if (kCrc32Table[arraysize(kCrc32Table) - 1])
+  if (kCrc32Table[3][arraysize(kCrc32Table[3]) - 1])
     return;  // already inited
-  for (uint32_t i = 0; i < arraysize(kCrc32Table); ++i) {
+  for (uint32_t i = 0; i < arraysize(kCrc32Table[0]); ++i) {
     uint32_t c = i;
     for (size_t j = 0; j < 8; ++j) {
       if (c & 1) {
@@ -33,7 +36,14 @@ static void EnsureCrc32TableInited() {
         c >>= 1;
       }
     }
-    kCrc32Table[i] = c;
+    kCrc32Table[0][i] = c;
+  }
+  // Fill the last table last, as its final entry marks the tables as ready.
+  for (size_t k = 1; k < arraysize(kCrc32Table); ++k) {
+    for (uint32_t i = 0; i < arraysize(kCrc32Table[k]); ++i) {
+      uint32_t c = kCrc32Table[k - 1][i];
+      kCrc32Table[k][i] = kCrc32Table[0][c & 0xFF] ^ (c >> 8);
+    }
   }
 }
 
@@ -42,8 +52,16 @@ uint32_t UpdateCrc32(uint32_t start, const void* buf, size_t len) {
 
   uint32_t c = start ^ 0xFFFFFFFF;
   const uint8_t* u = static_cast<const uint8_t*>(buf);
-  for (size_t i = 0; i < len; ++i) {
-    c = kCrc32Table[(c ^ u[i]) & 0xFF] ^ (c >> 8);
+  size_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    c ^= static_cast<uint32_t>(u[i]) | (static_cast<uint32_t>(u[i + 1]) << 8) |
+         (static_cast<uint32_t>(u[i + 2]) << 16) |
+         (static_cast<uint32_t>(u[i + 3]) << 24);
+    c = kCrc32Table[3][c & 0xFF] ^ kCrc32Table[2][(c >> 8) & 0xFF] ^
+        kCrc32Table[1][(c >> 16) & 0xFF] ^ kCrc32Table[0][c >> 24];
+  }
+  for (; i < len; ++i) {
+    c = kCrc32Table[0][(c ^ u[i]) & 0xFF] ^ (c >> 8);
   }
   return c ^ 0xFFFFFFFF;
 }
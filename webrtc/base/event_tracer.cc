@@ -10,7 +10,13 @@
 #include "webrtc/base/event_tracer.h"
 
 #include <inttypes.h>
+#include <string.h>
+#if defined(WEBRTC_POSIX)
+#include <pthread.h>
+#endif
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "webrtc/base/checks.h"
@@ -79,23 +85,164 @@ static bool EventTracingThreadFunc(void* params);
 // Atomic-int fast path for avoiding logging when disabled.
 static volatile int g_event_logging_active = 0;
 
+// Events each thread can have waiting for the logging thread. Events are
+// dropped when a thread's buffer is full.
+static const int kEventsPerThread = 2048;
+// Copied string arguments are truncated to fit this buffer.
+static const size_t kMaxCopiedStringLength = 48;
+
+struct TraceEvent {
+  const char* name;
+  const unsigned char* category_enabled;
+  char phase;
+  unsigned char flags;
+  uint64_t timestamp;
+  unsigned long long id;
+  int num_args;
+  const char* arg_names[2];
+  unsigned char arg_types[2];
+  unsigned long long arg_values[2];
+  // Holds the value of the first argument of type
+  // TRACE_VALUE_TYPE_COPY_STRING, which isn't valid after the event is added.
+  char copied_string[kMaxCopiedStringLength];
+};
+
+// Events added by one thread, waiting to be written by the logging thread.
+// A single-producer single-consumer ring buffer, so neither side takes a lock.
+// The indices run from 0 to 2 * kEventsPerThread, so that a full buffer can be
+// told apart from an empty one.
+class ThreadEventBuffer {
+ public:
+  explicit ThreadEventBuffer(rtc::PlatformThreadId thread_id)
+      : thread_id_(thread_id),
+        write_index_(0),
+        read_index_(0),
+        num_dropped_(0),
+        thread_exited_(0) {}
+
+  rtc::PlatformThreadId thread_id() const { return thread_id_; }
+
+  // Called on the owning thread.
+  void Add(const TraceEvent& event) {
+    int write_index = write_index_;
+    int read_index = rtc::AtomicOps::AcquireLoad(&read_index_);
+    if (Size(read_index, write_index) == kEventsPerThread) {
+      rtc::AtomicOps::Increment(&num_dropped_);
+      return;
+    }
+    events_[write_index % kEventsPerThread] = event;
+    rtc::AtomicOps::ReleaseStore(&write_index_,
+                                 (write_index + 1) % (2 * kEventsPerThread));
+  }
+
+  // Called on the logging thread. Appends the waiting events to |events|.
+  void Take(std::vector<TraceEvent>* events) {
+    int read_index = read_index_;
+    int write_index = rtc::AtomicOps::AcquireLoad(&write_index_);
+    for (; read_index != write_index;
+         read_index = (read_index + 1) % (2 * kEventsPerThread)) {
+      events->push_back(events_[read_index % kEventsPerThread]);
+    }
+    rtc::AtomicOps::ReleaseStore(&read_index_, read_index);
+  }
+
+  // Called while no events are taken, to discard the events of a previous
+  // logging session.
+  void Reset() {
+    rtc::AtomicOps::ReleaseStore(&read_index_,
+                                 rtc::AtomicOps::AcquireLoad(&write_index_));
+    rtc::AtomicOps::ReleaseStore(&num_dropped_, 0);
+  }
+
+  int num_dropped() const {
+    return rtc::AtomicOps::AcquireLoad(&num_dropped_);
+  }
+
+  void SetThreadExited() { rtc::AtomicOps::ReleaseStore(&thread_exited_, 1); }
+  bool thread_exited() const {
+    return rtc::AtomicOps::AcquireLoad(&thread_exited_) != 0;
+  }
+
+ private:
+  static int Size(int read_index, int write_index) {
+    return (write_index - read_index + 2 * kEventsPerThread) %
+           (2 * kEventsPerThread);
+  }
+
+  const rtc::PlatformThreadId thread_id_;
+  volatile int write_index_;
+  volatile int read_index_;
+  volatile int num_dropped_;
+  volatile int thread_exited_;
+  TraceEvent events_[kEventsPerThread];
+};
+
+#if defined(WEBRTC_POSIX)
+void OnThreadExit(void* buffer) {
+  static_cast<ThreadEventBuffer*>(buffer)->SetThreadExited();
+}
+#endif
+
+// Collects trace events into a ring buffer per thread, without taking locks
+// on the tracing threads, and writes them in the Chrome trace event format
+// from a background thread.
 // TODO(pbos): Log metadata for all threads, etc.
 class EventLogger final {
  public:
   EventLogger()
       : logging_thread_(EventTracingThreadFunc, this, "EventTracingThread"),
-        shutdown_event_(false, false) {}
-  ~EventLogger() { RTC_DCHECK(thread_checker_.CalledOnValidThread()); }
+        shutdown_event_(false, false) {
+#if defined(WEBRTC_WIN)
+    tls_index_ = TlsAlloc();
+    RTC_CHECK_NE(TLS_OUT_OF_INDEXES, tls_index_);
+#else
+    RTC_CHECK_EQ(0, pthread_key_create(&tls_key_, &OnThreadExit));
+#endif
+  }
+  ~EventLogger() {
+    RTC_DCHECK(thread_checker_.CalledOnValidThread());
+#if defined(WEBRTC_WIN)
+    TlsFree(tls_index_);
+#else
+    pthread_key_delete(tls_key_);
+#endif
+    for (ThreadEventBuffer* buffer : buffers_)
+      delete buffer;
+  }
 
   void AddTraceEvent(const char* name,
                      const unsigned char* category_enabled,
                      char phase,
-                     uint64_t timestamp,
-                     int pid,
-                     rtc::PlatformThreadId thread_id) {
-    rtc::CritScope lock(&crit_);
-    trace_events_.push_back(
-        {name, category_enabled, phase, timestamp, 1, thread_id});
+                     unsigned long long id,
+                     int num_args,
+                     const char** arg_names,
+                     const unsigned char* arg_types,
+                     const unsigned long long* arg_values,
+                     unsigned char flags,
+                     uint64_t timestamp) {
+    TraceEvent event;
+    event.name = name;
+    event.category_enabled = category_enabled;
+    event.phase = phase;
+    event.flags = flags;
+    event.timestamp = timestamp;
+    event.id = id;
+    event.num_args = std::min(num_args, 2);
+    event.copied_string[0] = '\0';
+    bool string_copied = false;
+    for (int i = 0; i < event.num_args; ++i) {
+      event.arg_names[i] = arg_names[i];
+      event.arg_types[i] = arg_types[i];
+      event.arg_values[i] = arg_values[i];
+      if (arg_types[i] == TRACE_VALUE_TYPE_COPY_STRING && !string_copied) {
+        strncpy(event.copied_string,
+                reinterpret_cast<const char*>(arg_values[i]),
+                kMaxCopiedStringLength - 1);
+        event.copied_string[kMaxCopiedStringLength - 1] = '\0';
+        string_copied = true;
+      }
+    }
+    GetThreadBuffer()->Add(event);
   }
 
 // The TraceEvent format is documented here:
@@ -105,30 +252,36 @@ class EventLogger final {
     static const int kLoggingIntervalMs = 100;
     fprintf(output_file_, "{ \"traceEvents\": [\n");
     bool has_logged_event = false;
+    std::vector<TraceEvent> events;
     while (true) {
       bool shutting_down = shutdown_event_.Wait(kLoggingIntervalMs);
-      std::vector<TraceEvent> events;
+      std::vector<std::pair<rtc::PlatformThreadId, size_t>> thread_events;
       {
-        rtc::CritScope lock(&crit_);
-        trace_events_.swap(events);
+        rtc::CritScope lock(&buffers_crit_);
+        for (auto it = buffers_.begin(); it != buffers_.end();) {
+          ThreadEventBuffer* buffer = *it;
+          // Check before taking the events, so that none are added after.
+          bool thread_exited = buffer->thread_exited();
+          buffer->Take(&events);
+          thread_events.push_back(
+              std::make_pair(buffer->thread_id(), events.size()));
+          if (thread_exited) {
+            num_dropped_events_ += buffer->num_dropped();
+            delete buffer;
+            it = buffers_.erase(it);
+          } else {
+            ++it;
+          }
+        }
       }
-      for (const TraceEvent& e : events) {
-        fprintf(output_file_,
-                "%s{ \"name\": \"%s\""
-                ", \"cat\": \"%s\""
-                ", \"ph\": \"%c\""
-                ", \"ts\": %" PRIu64
-                ", \"pid\": %d"
-#if defined(WEBRTC_WIN)
-                ", \"tid\": %lu"
-#else
-                ", \"tid\": %d"
-#endif  // defined(WEBRTC_WIN)
-                "}\n",
-                has_logged_event ? "," : " ", e.name, e.category_enabled,
-                e.phase, e.timestamp, e.pid, e.tid);
-        has_logged_event = true;
+      size_t i = 0;
+      for (const auto& thread : thread_events) {
+        for (; i < thread.second; ++i) {
+          WriteEvent(events[i], thread.first, has_logged_event);
+          has_logged_event = true;
+        }
       }
+      events.clear();
       if (shutting_down)
         break;
     }
@@ -145,12 +298,14 @@ class EventLogger final {
     output_file_ = file;
     output_file_owned_ = owned;
     {
-      rtc::CritScope lock(&crit_);
-      // Since the atomic fast-path for adding events to the queue can be
+      rtc::CritScope lock(&buffers_crit_);
+      // Since the atomic fast-path for adding events to the buffers can be
       // bypassed while the logging thread is shutting down there may be some
-      // stale events in the queue, hence the vector needs to be cleared to not
-      // log events from a previous logging session (which may be days old).
-      trace_events_.clear();
+      // stale events in them, hence they need to be cleared to not log events
+      // from a previous logging session (which may be days old).
+      for (ThreadEventBuffer* buffer : buffers_)
+        buffer->Reset();
+      num_dropped_events_ = 0;
     }
     // Enable event logging (fast-path). This should be disabled since starting
     // shouldn't be done twice.
@@ -173,20 +328,133 @@ class EventLogger final {
     shutdown_event_.Set();
     // Join the logging thread.
     logging_thread_.Stop();
+
+    rtc::CritScope lock(&buffers_crit_);
+    int num_dropped_events = num_dropped_events_;
+    for (ThreadEventBuffer* buffer : buffers_)
+      num_dropped_events += buffer->num_dropped();
+    if (num_dropped_events > 0) {
+      LOG(LS_WARNING) << "Dropped " << num_dropped_events
+                      << " trace events, the logging thread fell behind.";
+    }
   }
 
  private:
-  struct TraceEvent {
-    const char* name;
-    const unsigned char* category_enabled;
-    char phase;
-    uint64_t timestamp;
-    int pid;
-    rtc::PlatformThreadId tid;
-  };
-
-  rtc::CriticalSection crit_;
-  std::vector<TraceEvent> trace_events_ GUARDED_BY(crit_);
+  // Returns the buffer of the calling thread, creating it on first use.
+  ThreadEventBuffer* GetThreadBuffer() {
+#if defined(WEBRTC_WIN)
+    ThreadEventBuffer* buffer =
+        static_cast<ThreadEventBuffer*>(TlsGetValue(tls_index_));
+#else
+    ThreadEventBuffer* buffer =
+        static_cast<ThreadEventBuffer*>(pthread_getspecific(tls_key_));
+#endif
+    if (buffer)
+      return buffer;
+    buffer = new ThreadEventBuffer(rtc::CurrentThreadId());
+    {
+      rtc::CritScope lock(&buffers_crit_);
+      buffers_.push_back(buffer);
+    }
+    // There is no thread exit callback for TLS on Windows, so there the
+    // buffers of exited threads are only freed with the logger.
+#if defined(WEBRTC_WIN)
+    TlsSetValue(tls_index_, buffer);
+#else
+    pthread_setspecific(tls_key_, buffer);
+#endif
+    return buffer;
+  }
+
+  void WriteEvent(const TraceEvent& e,
+                  rtc::PlatformThreadId thread_id,
+                  bool has_logged_event) {
+    fprintf(output_file_,
+            "%s{ \"name\": \"%s\""
+            ", \"cat\": \"%s\""
+            ", \"ph\": \"%c\""
+            ", \"ts\": %" PRIu64
+            ", \"pid\": %d"
+#if defined(WEBRTC_WIN)
+            ", \"tid\": %lu",
+#else
+            ", \"tid\": %d",
+#endif  // defined(WEBRTC_WIN)
+            has_logged_event ? "," : " ", e.name, e.category_enabled, e.phase,
+            e.timestamp, 1, thread_id);
+    if (e.flags & TRACE_EVENT_FLAG_HAS_ID)
+      fprintf(output_file_, ", \"id\": \"0x%llx\"", e.id);
+    if (e.num_args > 0) {
+      fprintf(output_file_, ", \"args\": {");
+      for (int i = 0; i < e.num_args; ++i) {
+        fprintf(output_file_, "%s\"%s\": ", i > 0 ? ", " : "",
+                e.arg_names[i]);
+        WriteArgValue(e, i);
+      }
+      fprintf(output_file_, "}");
+    }
+    fprintf(output_file_, "}\n");
+  }
+
+  void WriteArgValue(const TraceEvent& e, int i) {
+    const unsigned long long value = e.arg_values[i];
+    switch (e.arg_types[i]) {
+      case TRACE_VALUE_TYPE_BOOL:
+        fputs(value ? "true" : "false", output_file_);
+        break;
+      case TRACE_VALUE_TYPE_UINT:
+        fprintf(output_file_, "%llu", value);
+        break;
+      case TRACE_VALUE_TYPE_INT:
+        fprintf(output_file_, "%lld", static_cast<long long>(value));
+        break;
+      case TRACE_VALUE_TYPE_DOUBLE: {
+        double double_value;
+        static_assert(sizeof(double_value) == sizeof(value),
+                      "Doubles are passed as 64 bit values.");
+        memcpy(&double_value, &value, sizeof(double_value));
+        fprintf(output_file_, "%f", double_value);
+        break;
+      }
+      case TRACE_VALUE_TYPE_POINTER:
+        fprintf(output_file_, "\"0x%llx\"", value);
+        break;
+      case TRACE_VALUE_TYPE_STRING:
+        WriteString(reinterpret_cast<const char*>(value));
+        break;
+      case TRACE_VALUE_TYPE_COPY_STRING:
+        // Only the first copied string is kept.
+        WriteString(i == 0 || e.arg_types[0] != TRACE_VALUE_TYPE_COPY_STRING
+                        ? e.copied_string
+                        : "");
+        break;
+      default:
+        fputs("null", output_file_);
+        break;
+    }
+  }
+
+  void WriteString(const char* str) {
+    fputc('"', output_file_);
+    for (; *str != '\0'; ++str) {
+      if (*str == '"' || *str == '\\')
+        fputc('\\', output_file_);
+      if (static_cast<unsigned char>(*str) >= 0x20)
+        fputc(*str, output_file_);
+    }
+    fputc('"', output_file_);
+  }
+
+  rtc::CriticalSection buffers_crit_;
+  // Only changed when a thread adds its first event, or has exited.
+  std::vector<ThreadEventBuffer*> buffers_ GUARDED_BY(buffers_crit_);
+  // Dropped events of threads that have exited.
+  int num_dropped_events_ GUARDED_BY(buffers_crit_) = 0;
+#if defined(WEBRTC_WIN)
+  DWORD tls_index_;
+#else
+  pthread_key_t tls_key_;
+#endif
   rtc::PlatformThread logging_thread_;
   rtc::Event shutdown_event_;
   rtc::ThreadChecker thread_checker_;
@@ -226,8 +494,9 @@ void InternalAddTraceEvent(char phase,
   if (rtc::AtomicOps::AcquireLoad(&g_event_logging_active) == 0)
     return;
 
-  g_event_logger->AddTraceEvent(name, category_enabled, phase,
-                                rtc::TimeMicros(), 1, rtc::CurrentThreadId());
+  g_event_logger->AddTraceEvent(name, category_enabled, phase, id, num_args,
+                                arg_names, arg_types, arg_values, flags,
+                                rtc::TimeMicros());
 }
 
 }  // namespace
@@ -10,7 +10,14 @@
 
 #include "webrtc/base/event_tracer.h"
 
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/base/trace_event.h"
 #include "webrtc/system_wrappers/include/static_instance.h"
 
@@ -79,4 +86,63 @@ TEST(EventTracerTest, ScopedTraceEvent) {
   TestStatistics::Get()->Reset();
 }
 
+namespace {
+const int kEventsPerTracingThread = 100;
+
+bool TraceEventsThread(void* obj) {
+  for (int i = 0; i < kEventsPerTracingThread; ++i) {
+    TRACE_EVENT_ASYNC_BEGIN1("webrtc", "InternalTracerEvent", i, "value",
+                             TRACE_STR_COPY("copied \"string\""));
+  }
+  return false;
+}
+
+std::string ReadFile(FILE* file) {
+  std::string contents;
+  rewind(file);
+  char buf[1024];
+  size_t read;
+  while ((read = fread(buf, 1, sizeof(buf), file)) > 0)
+    contents.append(buf, read);
+  return contents;
+}
+
+int CountOccurrences(const std::string& str, const std::string& substr) {
+  int count = 0;
+  for (size_t pos = str.find(substr); pos != std::string::npos;
+       pos = str.find(substr, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+}  // namespace
+
+TEST(EventTracerTest, InternalTracerWritesEventsOfAllThreads) {
+  const int kNumThreads = 4;
+  FILE* file = tmpfile();
+  ASSERT_TRUE(file != nullptr);
+  rtc::tracing::SetupInternalTracer();
+  rtc::tracing::StartInternalCaptureToFile(file);
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back(
+        new rtc::PlatformThread(&TraceEventsThread, nullptr, "TraceEvents"));
+    threads.back()->Start();
+  }
+  for (const auto& thread : threads)
+    thread->Stop();
+  rtc::tracing::StopInternalCapture();
+  rtc::tracing::ShutdownInternalTracer();
+
+  const std::string contents = ReadFile(file);
+  fclose(file);
+  EXPECT_EQ(0u, contents.find("{ \"traceEvents\": ["));
+  EXPECT_EQ(kNumThreads * kEventsPerTracingThread,
+            CountOccurrences(contents, "\"name\": \"InternalTracerEvent\""));
+  EXPECT_EQ(kNumThreads, CountOccurrences(contents, "\"id\": \"0x63\""));
+  EXPECT_EQ(kNumThreads * kEventsPerTracingThread,
+            CountOccurrences(contents,
+                             "\"args\": {\"value\": \"copied \\\"string\\\"\"}"));
+}
+
 }  // namespace webrtc
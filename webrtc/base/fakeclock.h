@@ -0,0 +1,58 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_BASE_FAKECLOCK_H_
+#define WEBRTC_BASE_FAKECLOCK_H_
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/timeutils.h"
+
+namespace rtc {
+
+// A clock whose time only changes when the test changes it. Time can only move
+// forward. Thread safe, so the test can advance it while other threads read
+// it.
+class FakeClock : public ClockInterface {
+ public:
+  FakeClock() {}
+  ~FakeClock() override {}
+
+  uint64_t TimeNanos() const override;
+
+  void SetTimeNanos(uint64_t nanos);
+  void AdvanceTimeNanos(uint64_t nanos);
+  void AdvanceTimeMicros(int64_t micros) {
+    AdvanceTimeNanos(micros * kNumNanosecsPerMicrosec);
+  }
+
+ private:
+  rtc::CriticalSection lock_;
+  uint64_t time_nanos_ GUARDED_BY(lock_) = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(FakeClock);
+};
+
+// Sets itself as the clock for the rtc time functions while in scope, and
+// restores the previous clock when destroyed.
+class ScopedFakeClock : public FakeClock {
+ public:
+  ScopedFakeClock();
+  ~ScopedFakeClock() override;
+
+ private:
+  ClockInterface* prev_clock_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ScopedFakeClock);
+};
+
+}  // namespace rtc
+
+#endif  // WEBRTC_BASE_FAKECLOCK_H_
@@ -36,10 +36,14 @@ static const char kLibjingle[] = "libjingle";
 
 #include <algorithm>
 #include <iomanip>
+#include <memory>
 #include <ostream>
+#include <utility>
 #include <vector>
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/platform_thread.h"
 #include "webrtc/base/stringencode.h"
@@ -116,6 +120,133 @@ LogMessage::StreamList LogMessage::streams_ GUARDED_BY(g_log_crit);
 // Boolean options default to false (0)
 bool LogMessage::thread_, LogMessage::timestamp_;
 
+/////////////////////////////////////////////////////////////////////////////
+// AsyncLogDispatcher
+/////////////////////////////////////////////////////////////////////////////
+
+// Queues formatted log messages and writes them out from a background thread.
+// The logging threads only hold |queue_crit_| for as long as it takes to
+// append a message; the writes happen on a second buffer that is swapped with
+// the queue.
+class AsyncLogDispatcher {
+ public:
+  AsyncLogDispatcher() : wake_up_(false, false), running_(false), dropped_(0) {}
+
+  void Start() {
+    CritScope cs(&control_crit_);
+    if (thread_)
+      return;
+    {
+      CritScope cs(&queue_crit_);
+      running_ = true;
+    }
+    thread_.reset(new PlatformThread(&Run, this, "LogDispatchThread"));
+    thread_->Start();
+  }
+
+  void Stop() {
+    CritScope cs(&control_crit_);
+    if (!thread_)
+      return;
+    {
+      CritScope cs(&queue_crit_);
+      running_ = false;
+    }
+    wake_up_.Set();
+    thread_->Stop();
+    thread_.reset();
+    Flush();
+  }
+
+  // Returns false, and leaves |str| untouched, if the message should be
+  // written out synchronously instead.
+  bool Enqueue(LoggingSeverity severity,
+               const std::string& tag,
+               std::string&& str) {
+    CritScope cs(&queue_crit_);
+    if (!running_)
+      return false;
+    if (queue_.size() >= kMaxQueuedMessages) {
+      ++dropped_;
+      return true;
+    }
+    queue_.push_back(Message());
+    Message& message = queue_.back();
+    message.severity = severity;
+    message.tag = tag;
+    message.str = std::move(str);
+    if (queue_.size() == kWakeUpQueueSize)
+      wake_up_.Set();
+    return true;
+  }
+
+  void Flush() {
+    // Only one thread at a time writes out messages, so that they stay in
+    // order.
+    CritScope cs(&dispatch_crit_);
+    size_t dropped;
+    {
+      CritScope cs(&queue_crit_);
+      dispatching_.swap(queue_);
+      dropped = dropped_;
+      dropped_ = 0;
+    }
+    for (const Message& message : dispatching_)
+      LogMessage::OutputToSinks(message.str, message.severity, message.tag);
+    dispatching_.clear();
+    if (dropped > 0) {
+      std::ostringstream str;
+      str << "Dropped " << dropped << " log messages." << std::endl;
+      LogMessage::OutputToSinks(str.str(), LS_WARNING, kLibjingle);
+    }
+  }
+
+ private:
+  struct Message {
+    LoggingSeverity severity;
+    std::string tag;
+    std::string str;
+  };
+
+  // The longest time a message waits in the queue, unless the queue fills up
+  // before.
+  static const int kMaxDispatchDelayMs = 100;
+  static const size_t kWakeUpQueueSize = 256;
+  static const size_t kMaxQueuedMessages = 10000;
+
+  static bool Run(void* obj) {
+    AsyncLogDispatcher* dispatcher = static_cast<AsyncLogDispatcher*>(obj);
+    dispatcher->wake_up_.Wait(kMaxDispatchDelayMs);
+    dispatcher->Flush();
+    return true;
+  }
+
+  // Serializes Start() and Stop().
+  CriticalSection control_crit_;
+  std::unique_ptr<PlatformThread> thread_ GUARDED_BY(control_crit_);
+  Event wake_up_;
+
+  CriticalSection dispatch_crit_;
+  std::vector<Message> dispatching_ GUARDED_BY(dispatch_crit_);
+
+  CriticalSection queue_crit_;
+  std::vector<Message> queue_ GUARDED_BY(queue_crit_);
+  bool running_ GUARDED_BY(queue_crit_);
+  size_t dropped_ GUARDED_BY(queue_crit_);
+};
+
+namespace {
+// Atomic-int fast path for the synchronous dispatch.
+volatile int g_async_dispatch = 0;
+
+// Like |streams_|, the dispatcher is never destroyed, as logging threads may
+// still be using it at program exit.
+AsyncLogDispatcher* GetAsyncLogDispatcher() {
+  static AsyncLogDispatcher* const dispatcher = new AsyncLogDispatcher();
+  return dispatcher;
+}
+}  // namespace
+
 LogMessage::LogMessage(const char* file,
                        int line,
                        LoggingSeverity sev,
@@ -196,17 +327,12 @@ LogMessage::~LogMessage() {
     print_stream_ << " : " << extra_;
   print_stream_ << std::endl;
 
-  const std::string& str = print_stream_.str();
-  if (severity_ >= dbg_sev_) {
-    OutputToDebug(str, severity_, tag_);
-  }
-
-  CritScope cs(&g_log_crit);
-  for (auto& kv : streams_) {
-    if (severity_ >= kv.second) {
-      kv.first->OnLogMessage(str);
-    }
+  std::string str = print_stream_.str();
+  if (AtomicOps::AcquireLoad(&g_async_dispatch) &&
+      GetAsyncLogDispatcher()->Enqueue(severity_, tag_, std::move(str))) {
+    return;
   }
+  OutputToSinks(str, severity_, tag_);
 }
 
 int64_t LogMessage::LogStartTime() {
@@ -265,6 +391,21 @@ void LogMessage::RemoveLogToStream(LogSink* stream) {
   UpdateMinLogSeverity();
 }
 
+void LogMessage::SetAsyncDispatch(bool async) {
+  AsyncLogDispatcher* dispatcher = GetAsyncLogDispatcher();
+  if (async) {
+    dispatcher->Start();
+    AtomicOps::ReleaseStore(&g_async_dispatch, 1);
+  } else {
+    AtomicOps::ReleaseStore(&g_async_dispatch, 0);
+    dispatcher->Stop();
+  }
+}
+
+void LogMessage::FlushAsyncDispatch() {
+  GetAsyncLogDispatcher()->Flush();
+}
+
 void LogMessage::ConfigureLogging(const char* params) {
   LoggingSeverity current_level = LS_VERBOSE;
   LoggingSeverity debug_level = GetLogToDebug();
@@ -281,6 +422,8 @@ void LogMessage::ConfigureLogging(const char* params) {
       LogTimestamps();
     } else if (token == "thread") {
       LogThreads();
+    } else if (token == "async") {
+      SetAsyncDispatch(true);
 
     // Logging levels
     } else if (token == "sensitive") {
@@ -330,11 +473,26 @@ void LogMessage::ConfigureLogging(const char* params) {
 void LogMessage::UpdateMinLogSeverity() EXCLUSIVE_LOCKS_REQUIRED(g_log_crit) {
   LoggingSeverity min_sev = dbg_sev_;
   for (auto& kv : streams_) {
-    min_sev = std::min(dbg_sev_, kv.second);
+    min_sev = std::min(min_sev, kv.second);
   }
   min_sev_ = min_sev;
 }
 
+void LogMessage::OutputToSinks(const std::string& str,
+                               LoggingSeverity severity,
+                               const std::string& tag) {
+  if (severity >= dbg_sev_) {
+    OutputToDebug(str, severity, tag);
+  }
+
+  CritScope cs(&g_log_crit);
+  for (auto& kv : streams_) {
+    if (severity >= kv.second) {
+      kv.first->OnLogMessage(str);
+    }
+  }
+}
+
 void LogMessage::OutputToDebug(const std::string& str,
                                LoggingSeverity severity,
                                const std::string& tag) {
@@ -137,6 +137,8 @@ class LogSink {
   virtual void OnLogMessage(const std::string& message) = 0;
 };
 
+class AsyncLogDispatcher;
+
 class LogMessage {
  public:
   LogMessage(const char* file, int line, LoggingSeverity sev,
@@ -189,6 +191,16 @@ class LogMessage {
   static void AddLogToStream(LogSink* stream, LoggingSeverity min_sev);
   static void RemoveLogToStream(LogSink* stream);
 
+  // Async dispatch: Hands formatted messages to a background thread, which
+  // writes them to the debug output and the streams, so that slow streams,
+  // such as files, don't block the logging threads. Messages keep their order
+  // but are delayed, and are dropped if the streams can't keep up. A removed
+  // stream misses the messages that were still queued when it was removed.
+  // Disabling async dispatch writes out the queued messages.
+  //   FlushAsyncDispatch blocks until the messages logged so far are written.
+  static void SetAsyncDispatch(bool async);
+  static void FlushAsyncDispatch();
+
   // Testing against MinLogSeverity allows code to avoid potentially expensive
   // logging operations by pre-checking the logging level.
   static int GetMinLogSeverity() { return min_sev_; }
@@ -201,10 +213,15 @@ class LogMessage {
   typedef std::pair<LogSink*, LoggingSeverity> StreamAndSeverity;
   typedef std::list<StreamAndSeverity> StreamList;
 
+  friend class AsyncLogDispatcher;
+
   // Updates min_sev_ appropriately when debug sinks change.
   static void UpdateMinLogSeverity();
 
   // These write out the actual log messages.
+  static void OutputToSinks(const std::string& msg,
+                            LoggingSeverity severity,
+                            const std::string& tag);
   static void OutputToDebug(const std::string& msg,
                             LoggingSeverity severity,
                             const std::string& tag);
@@ -84,6 +84,51 @@ TEST(LogTest, MultipleStreams) {
   EXPECT_EQ(sev, LogMessage::GetLogToStream(NULL));
 }
 
+// Test that the most verbose stream, and not the last one added, decides
+// which messages are logged.
+TEST(LogTest, MostVerboseStreamGetsMessages) {
+  std::string str1, str2;
+  LogSinkImpl<StringStream> stream1(&str1), stream2(&str2);
+  LogMessage::AddLogToStream(&stream1, LS_VERBOSE);
+  LogMessage::AddLogToStream(&stream2, LS_ERROR);
+
+  LOG(LS_VERBOSE) << "VERBOSE";
+
+  EXPECT_NE(std::string::npos, str1.find("VERBOSE"));
+  EXPECT_EQ(std::string::npos, str2.find("VERBOSE"));
+
+  LogMessage::RemoveLogToStream(&stream2);
+  LogMessage::RemoveLogToStream(&stream1);
+}
+
+// Test that async dispatch keeps messages in order and writes out the queued
+// messages when flushed or disabled.
+TEST(LogTest, AsyncDispatch) {
+  std::string str;
+  LogSinkImpl<StringStream> stream(&str);
+  LogMessage::AddLogToStream(&stream, LS_INFO);
+  LogMessage::SetAsyncDispatch(true);
+
+  LOG(LS_INFO) << "FIRST";
+  LOG(LS_INFO) << "SECOND";
+  LogMessage::FlushAsyncDispatch();
+  size_t first = str.find("FIRST");
+  size_t second = str.find("SECOND");
+  EXPECT_NE(std::string::npos, first);
+  EXPECT_NE(std::string::npos, second);
+  EXPECT_LT(first, second);
+
+  LOG(LS_INFO) << "THIRD";
+  LogMessage::SetAsyncDispatch(false);
+  EXPECT_NE(std::string::npos, str.find("THIRD"));
+
+  // Logs synchronously again.
+  LOG(LS_INFO) << "FOURTH";
+  EXPECT_NE(std::string::npos, str.find("FOURTH"));
+
+  LogMessage::RemoveLogToStream(&stream);
+}
+
 // Ensure we don't crash when adding/removing streams while threads are going.
 // We should restore the correct global state at the end.
 class LogThread : public Thread {
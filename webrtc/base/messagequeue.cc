@@ -19,6 +19,9 @@ namespace rtc {
 
 const int kMaxMsgLatency = 150;  // 150 ms
 
+// The number of unused nodes a MessageFifo keeps for reuse.
+const size_t kMaxFreeMessageNodes = 1024;
+
 //------------------------------------------------------------------
 // MessageQueueManager
 
@@ -103,6 +106,96 @@ void MessageQueueManager::ClearInternal(MessageHandler *handler) {
     (*iter)->Clear(handler);
 }
 
+//------------------------------------------------------------------
+// MessageQueue::MessageFifo
+
+MessageQueue::MessageFifo::MessageFifo()
+    : head_(nullptr),
+      tail_(nullptr),
+      size_(0),
+      free_list_(nullptr),
+      free_size_(0) {}
+
+MessageQueue::MessageFifo::~MessageFifo() {
+  while (head_) {
+    Node* next = head_->next;
+    delete head_;
+    head_ = next;
+  }
+  while (free_list_) {
+    Node* next = free_list_->next;
+    delete free_list_;
+    free_list_ = next;
+  }
+}
+
+void MessageQueue::MessageFifo::push_back(const Message& msg) {
+  Node* node;
+  if (free_list_) {
+    node = free_list_;
+    free_list_ = node->next;
+    --free_size_;
+  } else {
+    node = new Node();
+  }
+  node->msg = msg;
+  node->next = nullptr;
+  if (tail_)
+    tail_->next = node;
+  else
+    head_ = node;
+  tail_ = node;
+  ++size_;
+}
+
+void MessageQueue::MessageFifo::pop_front() {
+  ASSERT(head_ != nullptr);
+  Node* node = head_;
+  head_ = node->next;
+  if (!head_)
+    tail_ = nullptr;
+  --size_;
+  Recycle(node);
+}
+
+void MessageQueue::MessageFifo::RemoveMatching(MessageHandler* phandler,
+                                               uint32_t id,
+                                               MessageList* removed) {
+  Node* prev = nullptr;
+  Node* node = head_;
+  while (node) {
+    Node* next = node->next;
+    if (node->msg.Match(phandler, id)) {
+      if (removed) {
+        removed->push_back(node->msg);
+      } else {
+        delete node->msg.pdata;
+      }
+      if (prev)
+        prev->next = next;
+      else
+        head_ = next;
+      if (tail_ == node)
+        tail_ = prev;
+      --size_;
+      Recycle(node);
+    } else {
+      prev = node;
+    }
+    node = next;
+  }
+}
+
+void MessageQueue::MessageFifo::Recycle(Node* node) {
+  if (free_size_ >= kMaxFreeMessageNodes) {
+    delete node;
+    return;
+  }
+  node->next = free_list_;
+  free_list_ = node;
+  ++free_size_;
+}
+
 //------------------------------------------------------------------
 // MessageQueue
 MessageQueue::MessageQueue(SocketServer* ss, bool init_queue)
@@ -419,18 +512,7 @@ void MessageQueue::Clear(MessageHandler* phandler,
 
   // Remove from ordered message queue
 
-  for (MessageList::iterator it = msgq_.begin(); it != msgq_.end();) {
-    if (it->Match(phandler, id)) {
-      if (removed) {
-        removed->push_back(*it);
-      } else {
-        delete it->pdata;
-      }
-      it = msgq_.erase(it);
-    } else {
-      ++it;
-    }
-  }
+  msgq_.RemoveMatching(phandler, id, removed);
 
   // Remove from priority queue. Not directly iterable, so use this approach
 
@@ -251,6 +251,43 @@ class MessageQueue {
   sigslot::signal0<> SignalQueueDestroyed;
 
  protected:
+  // FIFO of messages in singly linked nodes. Popped nodes are kept on a free
+  // list and reused, so that posting doesn't allocate once the queue has
+  // reached its usual depth.
+  class MessageFifo {
+   public:
+    MessageFifo();
+    ~MessageFifo();
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    const Message& front() const { return head_->msg; }
+    void push_back(const Message& msg);
+    void pop_front();
+    // Removes the messages that match |phandler| and |id|. They're appended
+    // to |removed| if it's non-null, otherwise their data is deleted.
+    void RemoveMatching(MessageHandler* phandler,
+                        uint32_t id,
+                        MessageList* removed);
+
+   private:
+    struct Node {
+      Message msg;
+      Node* next;
+    };
+
+    // Puts |node| on the free list, or deletes it if the list is full.
+    void Recycle(Node* node);
+
+    Node* head_;
+    Node* tail_;
+    size_t size_;
+    Node* free_list_;
+    size_t free_size_;
+
+    RTC_DISALLOW_COPY_AND_ASSIGN(MessageFifo);
+  };
+
   class PriorityQueue : public std::priority_queue<DelayedMessage> {
    public:
     container_type& container() { return c; }
@@ -276,7 +313,7 @@ class MessageQueue {
   bool fStop_;
   bool fPeekKeep_;
   Message msgPeek_;
-  MessageList msgq_ GUARDED_BY(crit_);
+  MessageFifo msgq_ GUARDED_BY(crit_);
   PriorityQueue dmsgq_ GUARDED_BY(crit_);
   uint32_t dmsgq_next_num_ GUARDED_BY(crit_);
   CriticalSection crit_;
@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/messagequeue.h"
+#include "webrtc/base/nullsocketserver.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/test/testsupport/perf_timer.h"
+
+namespace rtc {
+namespace {
+const int kNumMessages = 1 << 18;
+
+// Posts and gets |batch| messages at a time on one thread, which is what a
+// busy thread posting to itself looks like. Returns messages per second.
+size_t MeasurePostAndGet(int batch) {
+  NullSocketServer ss;
+  MessageQueue queue(&ss, true);
+  Message msg;
+  int received = 0;
+  int out_of_order = 0;
+  const double batches_per_second = webrtc::test::MeasureCallsPerSecond(
+      kNumMessages / batch, [&queue, &msg, &received, &out_of_order, batch] {
+        for (int j = 0; j < batch; ++j)
+          queue.Post(nullptr, j);
+        for (uint32_t j = 0; queue.Get(&msg, 0); ++j) {
+          out_of_order += msg.message_id != j;
+          ++received;
+        }
+      });
+  // Each batch is received in the order it was posted.
+  EXPECT_EQ(kNumMessages, received);
+  EXPECT_EQ(0, out_of_order);
+  return static_cast<size_t>(batches_per_second * batch);
+}
+
+// Same as above, for messages posted with a delay that has already expired.
+size_t MeasurePostDelayedAndGet(int batch) {
+  NullSocketServer ss;
+  MessageQueue queue(&ss, true);
+  Message msg;
+  int received = 0;
+  uint64_t id_sum = 0;
+  const double batches_per_second = webrtc::test::MeasureCallsPerSecond(
+      kNumMessages / batch, [&queue, &msg, &received, &id_sum, batch] {
+        const int64_t now = TimeMillis();
+        for (int j = 0; j < batch; ++j)
+          queue.PostAt(now - j % 10, nullptr, j);
+        while (queue.Get(&msg, 0)) {
+          id_sum += msg.message_id;
+          ++received;
+        }
+      });
+  // Every message of every batch is received once, in whichever order their
+  // trigger times give.
+  EXPECT_EQ(kNumMessages, received);
+  EXPECT_EQ(static_cast<uint64_t>(kNumMessages / batch) * batch * (batch - 1) /
+                2,
+            id_sum);
+  return static_cast<size_t>(batches_per_second * batch);
+}
+
+struct ProducerContext {
+  MessageQueue* queue;
+  Event* done;
+};
+
+bool ProduceMessages(void* obj) {
+  ProducerContext* context = static_cast<ProducerContext*>(obj);
+  for (int i = 0; i < kNumMessages; ++i)
+    context->queue->Post(nullptr, i);
+  context->done->Set();
+  return false;
+}
+
+// Posts from another thread while this one gets the messages.
+size_t MeasureCrossThreadPost() {
+  NullSocketServer ss;
+  MessageQueue queue(&ss, true);
+  Event done(false, false);
+  ProducerContext context = {&queue, &done};
+  PlatformThread producer(&ProduceMessages, &context, "Producer");
+
+  Message msg;
+  int received = 0;
+  int out_of_order = 0;
+  const double runs_per_second = webrtc::test::MeasureCallsPerSecond(
+      1, [&producer, &queue, &msg, &received, &out_of_order] {
+        producer.Start();
+        while (received < kNumMessages) {
+          if (queue.Get(&msg, 10)) {
+            out_of_order += msg.message_id != static_cast<uint32_t>(received);
+            ++received;
+          }
+        }
+      });
+  done.Wait(Event::kForever);
+  producer.Stop();
+  EXPECT_EQ(0, out_of_order);
+  return static_cast<size_t>(runs_per_second * kNumMessages);
+}
+}  // namespace
+
+TEST(MessageQueuePerformanceTest, Post) {
+  const int kBatches[] = {1, 16, 256};
+  for (int batch : kBatches) {
+    webrtc::test::PrintResult("message_queue_post", "_" + ToString(batch),
+                              "throughput", MeasurePostAndGet(batch),
+                              "messages/s", true);
+  }
+}
+
+TEST(MessageQueuePerformanceTest, PostDelayed) {
+  const int kBatches[] = {1, 16, 256};
+  for (int batch : kBatches) {
+    webrtc::test::PrintResult("message_queue_post_delayed",
+                              "_" + ToString(batch), "throughput",
+                              MeasurePostDelayedAndGet(batch), "messages/s",
+                              true);
+  }
+}
+
+TEST(MessageQueuePerformanceTest, PostFromOtherThread) {
+  webrtc::test::PrintResult("message_queue_post_cross_thread", "",
+                            "throughput", MeasureCrossThreadPost(),
+                            "messages/s", true);
+}
+
+}  // namespace rtc
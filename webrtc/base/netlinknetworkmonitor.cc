@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/netlinknetworkmonitor.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/logging.h"
+
+namespace rtc {
+
+namespace {
+bool IsNetworkChange(const nlmsghdr* header) {
+  switch (header->nlmsg_type) {
+    case RTM_NEWLINK:
+    case RTM_DELLINK:
+    case RTM_NEWADDR:
+    case RTM_DELADDR:
+      return true;
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+NetlinkNetworkMonitor* NetlinkNetworkMonitor::Create() {
+  int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+  if (fd < 0) {
+    LOG_ERR(LS_WARNING) << "Failed to create netlink socket";
+    return nullptr;
+  }
+  sockaddr_nl addr = {};
+  addr.nl_family = AF_NETLINK;
+  addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+  if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+    LOG_ERR(LS_WARNING) << "Failed to bind netlink socket";
+    close(fd);
+    return nullptr;
+  }
+  int stop_fds[2];
+  if (pipe2(stop_fds, O_CLOEXEC | O_NONBLOCK) < 0) {
+    LOG_ERR(LS_WARNING) << "Failed to create netlink monitor stop pipe";
+    close(fd);
+    return nullptr;
+  }
+  return new NetlinkNetworkMonitor(fd, stop_fds[0], stop_fds[1]);
+}
+
+NetlinkNetworkMonitor::NetlinkNetworkMonitor(int fd,
+                                             int stop_read_fd,
+                                             int stop_write_fd)
+    : fd_(fd),
+      stop_read_fd_(stop_read_fd),
+      stop_write_fd_(stop_write_fd),
+      failed_(0),
+      thread_(&NetlinkNetworkMonitor::MonitorThread, this, "NetlinkMonitor") {}
+
+NetlinkNetworkMonitor::~NetlinkNetworkMonitor() {
+  Stop();
+  close(stop_write_fd_);
+  close(stop_read_fd_);
+  close(fd_);
+}
+
+void NetlinkNetworkMonitor::Start() {
+  if (thread_.IsRunning()) {
+    if (IsWatching())
+      return;
+    // The thread gave up after an error; reap it and try again.
+    thread_.Stop();
+  }
+  AtomicOps::ReleaseStore(&failed_, 0);
+  thread_.Start();
+}
+
+void NetlinkNetworkMonitor::Stop() {
+  if (!thread_.IsRunning())
+    return;
+  char byte = 0;
+  while (write(stop_write_fd_, &byte, 1) < 0 && errno == EINTR) {
+  }
+  thread_.Stop();
+  // Drain the pipe so that the next Start() doesn't return immediately.
+  char buffer[16];
+  while (read(stop_read_fd_, buffer, sizeof(buffer)) > 0 || errno == EINTR) {
+  }
+}
+
+bool NetlinkNetworkMonitor::IsWatching() const {
+  return AtomicOps::AcquireLoad(&failed_) == 0;
+}
+
+AdapterType NetlinkNetworkMonitor::GetAdapterType(
+    const std::string& interface_name) {
+  return ADAPTER_TYPE_UNKNOWN;
+}
+
+bool NetlinkNetworkMonitor::MonitorThread(void* obj) {
+  return static_cast<NetlinkNetworkMonitor*>(obj)->Process();
+}
+
+bool NetlinkNetworkMonitor::Process() {
+  pollfd pfds[2] = {{fd_, POLLIN, 0}, {stop_read_fd_, POLLIN, 0}};
+  int ret = poll(pfds, 2, -1);
+  if (ret < 0) {
+    if (errno == EINTR)
+      return true;
+    LOG_ERR(LS_ERROR) << "poll on netlink socket failed";
+    // Changes may be missed from now on, so let the owner refresh its
+    // networks and start polling for them.
+    AtomicOps::ReleaseStore(&failed_, 1);
+    OnNetworksChanged();
+    return false;
+  }
+  if (pfds[1].revents)
+    return false;
+
+  // Drain everything that's queued, so that a burst of changes, such as an
+  // interface going down with all its addresses, is reported only once.
+  bool changed = false;
+  bool failed = false;
+  char buffer[8192];
+  while (true) {
+    ssize_t len = recv(fd_, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (len < 0) {
+      if (errno == EINTR)
+        continue;
+      // The kernel drops messages when the socket buffer overflows, in which
+      // case something must have changed.
+      if (errno == ENOBUFS) {
+        changed = true;
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        break;
+      LOG_ERR(LS_ERROR) << "recv on netlink socket failed";
+      failed = true;
+      break;
+    }
+    if (len == 0)
+      break;
+    int remaining = static_cast<int>(len);
+    for (const nlmsghdr* header = reinterpret_cast<const nlmsghdr*>(buffer);
+         NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+      if (IsNetworkChange(header))
+        changed = true;
+    }
+  }
+  if (failed)
+    AtomicOps::ReleaseStore(&failed_, 1);
+  if (changed || failed)
+    OnNetworksChanged();
+  return !failed;
+}
+
+}  // namespace rtc
@@ -0,0 +1,62 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_BASE_NETLINKNETWORKMONITOR_H_
+#define WEBRTC_BASE_NETLINKNETWORKMONITOR_H_
+
+#include <string>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/networkmonitor.h"
+#include "webrtc/base/platform_thread.h"
+
+namespace rtc {
+
+// Listens to the kernel's routing netlink socket for links and addresses
+// coming and going, so that networks needn't be polled for changes. A burst
+// of netlink messages results in a single network change event, which is
+// delivered on the thread that created the monitor. If reading the socket
+// fails, the monitor reports a change one last time and IsWatching() returns
+// false, so that the owner can go back to polling.
+class NetlinkNetworkMonitor : public NetworkMonitorBase {
+ public:
+  // Returns null if the netlink socket can't be opened.
+  static NetlinkNetworkMonitor* Create();
+  ~NetlinkNetworkMonitor() override;
+
+  void Start() override;
+  void Stop() override;
+  AdapterType GetAdapterType(const std::string& interface_name) override;
+
+  // Returns false if the monitor has stopped watching for changes because of
+  // an error. Can be called from any thread.
+  bool IsWatching() const;
+
+ private:
+  NetlinkNetworkMonitor(int fd, int stop_read_fd, int stop_write_fd);
+
+  static bool MonitorThread(void* obj);
+  // Blocks until netlink messages arrive or Stop() is called, and reads all
+  // messages that arrived. Returns false when the thread should exit.
+  bool Process();
+
+  const int fd_;
+  // A pipe that Stop() writes to, to wake the monitor thread.
+  const int stop_read_fd_;
+  const int stop_write_fd_;
+  volatile int failed_;
+  PlatformThread thread_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(NetlinkNetworkMonitor);
+};
+
+}  // namespace rtc
+
+#endif  // WEBRTC_BASE_NETLINKNETWORKMONITOR_H_
@@ -36,6 +36,9 @@
 
 #include "webrtc/base/logging.h"
 #include "webrtc/base/networkmonitor.h"
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+#include "webrtc/base/netlinknetworkmonitor.h"
+#endif
 #include "webrtc/base/socket.h"  // includes something that makes windows happy
 #include "webrtc/base/stream.h"
 #include "webrtc/base/stringencode.h"
@@ -392,7 +395,8 @@ Network* NetworkManagerBase::GetNetworkFromAddress(
 
 BasicNetworkManager::BasicNetworkManager()
     : thread_(NULL), sent_first_update_(false), start_count_(0),
-      ignore_non_default_routes_(false) {
+      ignore_non_default_routes_(false), netlink_monitor_(nullptr),
+      polling_(false) {
 }
 
 BasicNetworkManager::~BasicNetworkManager() {
@@ -400,6 +404,11 @@ BasicNetworkManager::~BasicNetworkManager() {
 
 void BasicNetworkManager::OnNetworksChanged() {
   LOG(LS_INFO) << "Network change was observed";
+  if (!polling_ && NeedsPolling()) {
+    // The monitor stopped watching, so go back to polling.
+    UpdateNetworksContinually();
+    return;
+  }
   UpdateNetworksOnce();
 }
 
@@ -746,18 +755,26 @@ void BasicNetworkManager::StopUpdating() {
   --start_count_;
   if (!start_count_) {
     thread_->Clear(this);
+    polling_ = false;
     sent_first_update_ = false;
     StopNetworkMonitor();
   }
 }
 
 void BasicNetworkManager::StartNetworkMonitor() {
-  NetworkMonitorFactory* factory = NetworkMonitorFactory::GetFactory();
-  if (factory == nullptr) {
-    return;
-  }
   if (!network_monitor_) {
-    network_monitor_.reset(factory->CreateNetworkMonitor());
+    NetworkMonitorFactory* factory = NetworkMonitorFactory::GetFactory();
+    if (factory) {
+      network_monitor_.reset(factory->CreateNetworkMonitor());
+    }
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+    // Without a platform monitor, learn about changes from the kernel rather
+    // than polling for them.
+    if (!network_monitor_) {
+      netlink_monitor_ = NetlinkNetworkMonitor::Create();
+      network_monitor_.reset(netlink_monitor_);
+    }
+#endif
     if (!network_monitor_) {
       return;
     }
@@ -861,9 +878,24 @@ void BasicNetworkManager::UpdateNetworksOnce() {
   }
 }
 
+bool BasicNetworkManager::NeedsPolling() const {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // The netlink monitor hears about every change for as long as it's
+  // watching. Platform monitors may report only some kinds of change, so
+  // networks are still polled alongside them.
+  if (netlink_monitor_ && netlink_monitor_->IsWatching())
+    return false;
+#endif
+  return true;
+}
+
 void BasicNetworkManager::UpdateNetworksContinually() {
   UpdateNetworksOnce();
-  thread_->PostDelayed(kNetworksUpdateIntervalMs, this, kUpdateNetworksMessage);
+  polling_ = NeedsPolling();
+  if (polling_) {
+    thread_->PostDelayed(kNetworksUpdateIntervalMs, this,
+                         kUpdateNetworksMessage);
+  }
 }
 
 void BasicNetworkManager::DumpNetworks() {
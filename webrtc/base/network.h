@@ -33,6 +33,7 @@ extern const char kPublicIPv4Host[];
 extern const char kPublicIPv6Host[];
 
 class IfAddrsConverter;
+class NetlinkNetworkMonitor;
 class Network;
 class NetworkMonitorInterface;
 class Thread;
@@ -249,7 +250,10 @@ class BasicNetworkManager : public NetworkManagerBase,
   // Called when it receives updates from the network monitor.
   void OnNetworksChanged();
 
-  // Updates the networks and reschedules the next update.
+  // Returns true unless a network monitor is known to report every change.
+  bool NeedsPolling() const;
+  // Updates the networks and, if they need polling, reschedules the next
+  // update.
   void UpdateNetworksContinually();
   // Only updates the networks; does not reschedule the next update.
   void UpdateNetworksOnce();
@@ -262,6 +266,10 @@ class BasicNetworkManager : public NetworkManagerBase,
   std::vector<std::string> network_ignore_list_;
   bool ignore_non_default_routes_;
   std::unique_ptr<NetworkMonitorInterface> network_monitor_;
+  // Set when |network_monitor_| is a netlink monitor.
+  NetlinkNetworkMonitor* netlink_monitor_;
+  // Whether an update is scheduled by UpdateNetworksContinually().
+  bool polling_;
 };
 
 // Represents a Unix-type network interface, with a name and single address.
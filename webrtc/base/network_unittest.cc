@@ -19,6 +19,9 @@
 #include <net/if.h>
 #include "webrtc/base/ifaddrs_converter.h"
 #endif  // defined(WEBRTC_POSIX)
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+#include "webrtc/base/netlinknetworkmonitor.h"
+#endif
 #include "webrtc/base/gunit.h"
 #if defined(WEBRTC_WIN)
 #include "webrtc/base/logging.h"  // For LOG_GLE
@@ -1090,6 +1093,61 @@ TEST_F(NetworkTest, TestNetworkMonitoring) {
   NetworkMonitorFactory::ReleaseFactory(factory);
 }
 
+// A platform network monitor may not report every change, so networks are
+// still polled alongside it.
+TEST_F(NetworkTest, TestPollingWithNetworkMonitor) {
+  BasicNetworkManager manager;
+  manager.SignalNetworksChanged.connect(static_cast<NetworkTest*>(this),
+                                        &NetworkTest::OnNetworksChanged);
+  FakeNetworkMonitorFactory* factory = new FakeNetworkMonitorFactory();
+  NetworkMonitorFactory::SetFactory(factory);
+  manager.StartUpdating();
+  EXPECT_TRUE_WAIT(callback_called_, 1000);
+  EXPECT_FALSE(Thread::Current()->empty());
+
+  manager.StopUpdating();
+  NetworkMonitorFactory::ReleaseFactory(factory);
+}
+
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+// The netlink monitor reports every change, so nothing should be left queued
+// once the first update is done.
+TEST_F(NetworkTest, TestNoPollingWithNetlinkNetworkMonitor) {
+  std::unique_ptr<NetlinkNetworkMonitor> monitor(
+      NetlinkNetworkMonitor::Create());
+  // Netlink may not be available in sandboxed test environments.
+  if (!monitor)
+    return;
+  monitor.reset();
+
+  BasicNetworkManager manager;
+  manager.SignalNetworksChanged.connect(static_cast<NetworkTest*>(this),
+                                        &NetworkTest::OnNetworksChanged);
+  manager.StartUpdating();
+  EXPECT_TRUE_WAIT(callback_called_, 1000);
+  EXPECT_TRUE(Thread::Current()->empty());
+  manager.StopUpdating();
+}
+
+TEST_F(NetworkTest, TestNetlinkNetworkMonitorStartsAndStops) {
+  std::unique_ptr<NetlinkNetworkMonitor> monitor(
+      NetlinkNetworkMonitor::Create());
+  if (!monitor)
+    return;
+  monitor->Start();
+  monitor->Start();
+  EXPECT_TRUE(monitor->IsWatching());
+  // Stop() must not wait for a netlink message to arrive.
+  int64_t start = TimeMillis();
+  monitor->Stop();
+  EXPECT_LT(TimeMillis() - start, 1000);
+  monitor->Start();
+  EXPECT_TRUE(monitor->IsWatching());
+  monitor->Stop();
+  monitor->Stop();
+}
+#endif
+
 TEST_F(NetworkTest, DefaultLocalAddress) {
   IPAddress ip;
   TestBasicNetworkManager manager;
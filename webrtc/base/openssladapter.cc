@@ -349,6 +349,11 @@ OpenSSLAdapter::BeginSSL() {
   SSL_set_bio(ssl_, bio, bio);
   SSL_set_mode(ssl_, SSL_MODE_ENABLE_PARTIAL_WRITE |
                      SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+  // Let OpenSSL read whatever is available from the socket at once, instead of
+  // each record's header and body with a call each. Recv() drains what has
+  // been read ahead.
+  if (ssl_mode_ == SSL_MODE_TLS)
+    SSL_set_read_ahead(ssl_, 1);
 
   // the SSL object owns the bio now
   bio = NULL;
@@ -550,11 +555,27 @@ int OpenSSLAdapter::Recv(void* pv, size_t cb, int64_t* timestamp) {
 
   ssl_read_needs_write_ = false;
 
-  int code = SSL_read(ssl_, pv, checked_cast<int>(cb));
-  switch (SSL_get_error(ssl_, code)) {
-  case SSL_ERROR_NONE:
-    //LOG(LS_INFO) << " -- success";
-    return code;
+  // Records that were read ahead sit in OpenSSL's buffer, where no read event
+  // announces them, so read until |pv| is full or the socket is drained.
+  size_t received = 0;
+  int code;
+  while (true) {
+    code = SSL_read(ssl_, static_cast<char*>(pv) + received,
+                    checked_cast<int>(cb - received));
+    if (code <= 0)
+      break;
+    received += code;
+    if (received == cb)
+      return checked_cast<int>(received);
+  }
+  int ssl_error = SSL_get_error(ssl_, code);
+  if (received > 0) {
+    // Errors other than having to wait show up again on the next call.
+    if (ssl_error == SSL_ERROR_WANT_WRITE)
+      ssl_read_needs_write_ = true;
+    return checked_cast<int>(received);
+  }
+  switch (ssl_error) {
   case SSL_ERROR_WANT_READ:
     //LOG(LS_INFO) << " -- error want read";
     SetError(EWOULDBLOCK);
@@ -22,10 +22,12 @@
 #include <openssl/dtls1.h>
 #endif
 
+#include <map>
 #include <memory>
 #include <vector>
 
 #include "webrtc/base/common.h"
+#include "webrtc/base/criticalsection.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/safe_conversions.h"
 #include "webrtc/base/stream.h"
@@ -35,6 +37,7 @@
 #include "webrtc/base/opensslidentity.h"
 #include "webrtc/base/stringutils.h"
 #include "webrtc/base/thread.h"
+#include "webrtc/base/timeutils.h"
 
 namespace rtc {
 
@@ -55,6 +58,8 @@ struct SrtpCipherMapEntry {
 static SrtpCipherMapEntry SrtpCipherMap[] = {
     {"SRTP_AES128_CM_SHA1_80", SRTP_AES128_CM_SHA1_80},
     {"SRTP_AES128_CM_SHA1_32", SRTP_AES128_CM_SHA1_32},
+    {"SRTP_AEAD_AES_128_GCM", SRTP_AEAD_AES_128_GCM},
+    {"SRTP_AEAD_AES_256_GCM", SRTP_AEAD_AES_256_GCM},
     {nullptr, 0}};
 #endif
 
@@ -265,6 +270,124 @@ static long stream_ctrl(BIO* b, int cmd, long num, void* ptr) {
   }
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Session resumption
+/////////////////////////////////////////////////////////////////////////////
+
+// Sent by servers with SSL_VERIFY_PEER, which OpenSSL requires for resuming.
+static const unsigned char kSessionIdContext[] = "WebRTC";
+
+// How long a session can be resumed after it was established, and how long
+// servers issue tickets with the same key. Bounds how long master secrets and
+// ticket keys are kept in memory.
+static const int kSessionLifetimeSeconds = 10 * 60;
+static const int64_t kSessionLifetimeMs = kSessionLifetimeSeconds * 1000;
+
+// Sessions that clients may offer to resume, shared by every stream in the
+// process.
+class SessionCache {
+ public:
+  static SessionCache* Instance() {
+    RTC_DEFINE_STATIC_LOCAL(SessionCache, instance, ());
+    return &instance;
+  }
+
+  // Offers the session saved under |key|, if there is one that hasn't
+  // expired, on |ssl|.
+  bool Resume(const std::string& key, SSL* ssl) {
+    CritScope cs(&crit_);
+    RemoveExpiredSessions();
+    auto it = sessions_.find(key);
+    return it != sessions_.end() &&
+           SSL_set_session(ssl, it->second.session) == 1;
+  }
+
+  // Takes ownership of |session|.
+  void Save(const std::string& key, SSL_SESSION* session) {
+    CritScope cs(&crit_);
+    RemoveExpiredSessions();
+    auto it = sessions_.find(key);
+    if (it != sessions_.end()) {
+      SSL_SESSION_free(it->second.session);
+      sessions_.erase(it);
+    } else if (sessions_.size() >= kMaxSessions) {
+      // Make room by dropping the oldest session.
+      auto oldest = sessions_.begin();
+      for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
+        if (it->second.saved_ms < oldest->second.saved_ms)
+          oldest = it;
+      }
+      SSL_SESSION_free(oldest->second.session);
+      sessions_.erase(oldest);
+    }
+    sessions_[key] = Entry(session, TimeMillis());
+  }
+
+ private:
+  static const size_t kMaxSessions = 256;
+
+  struct Entry {
+    Entry() : session(NULL), saved_ms(0) {}
+    Entry(SSL_SESSION* session, int64_t saved_ms)
+        : session(session), saved_ms(saved_ms) {}
+
+    SSL_SESSION* session;
+    int64_t saved_ms;
+  };
+
+  void RemoveExpiredSessions() EXCLUSIVE_LOCKS_REQUIRED(crit_) {
+    const int64_t now = TimeMillis();
+    for (auto it = sessions_.begin(); it != sessions_.end();) {
+      if (now - it->second.saved_ms >= kSessionLifetimeMs) {
+        SSL_SESSION_free(it->second.session);
+        it = sessions_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  CriticalSection crit_;
+  std::map<std::string, Entry> sessions_ GUARDED_BY(crit_);
+};
+
+// Keys for the session tickets that servers issue. Every stream in the process
+// shares them so that any server can resume a session another one made, and
+// they never leave the process. They are replaced once they are older than a
+// session may be, after which tickets issued with the old ones are useless.
+class SessionTicketKeys {
+ public:
+  static const size_t kSize = 48;
+
+  static SessionTicketKeys* Instance() {
+    RTC_DEFINE_STATIC_LOCAL(SessionTicketKeys, instance, ());
+    return &instance;
+  }
+
+  SessionTicketKeys() : generated_ms_(-1) {}
+
+  // Copies the current keys to |keys|. Returns false if they couldn't be
+  // generated.
+  bool Get(unsigned char* keys) {
+    CritScope cs(&crit_);
+    const int64_t now = TimeMillis();
+    if (generated_ms_ < 0 || now - generated_ms_ >= kSessionLifetimeMs) {
+      if (RAND_bytes(keys_, sizeof(keys_)) != 1) {
+        generated_ms_ = -1;
+        return false;
+      }
+      generated_ms_ = now;
+    }
+    memcpy(keys, keys_, sizeof(keys_));
+    return true;
+  }
+
+ private:
+  CriticalSection crit_;
+  unsigned char keys_[kSize] GUARDED_BY(crit_);
+  int64_t generated_ms_ GUARDED_BY(crit_);
+};
+
 /////////////////////////////////////////////////////////////////////////////
 // OpenSSLStreamAdapter
 /////////////////////////////////////////////////////////////////////////////
@@ -279,7 +402,8 @@ OpenSSLStreamAdapter::OpenSSLStreamAdapter(StreamInterface* stream)
       ssl_ctx_(NULL),
       custom_verification_succeeded_(false),
       ssl_mode_(SSL_MODE_TLS),
-      ssl_max_version_(SSL_PROTOCOL_TLS_12) {}
+      ssl_max_version_(SSL_PROTOCOL_TLS_12),
+      session_resumption_enabled_(false) {}
 
 OpenSSLStreamAdapter::~OpenSSLStreamAdapter() {
   Cleanup();
@@ -483,6 +607,16 @@ void OpenSSLStreamAdapter::SetMaxProtocolVersion(SSLProtocolVersion version) {
   ssl_max_version_ = version;
 }
 
+bool OpenSSLStreamAdapter::SetSessionResumptionEnabled(bool enabled) {
+  ASSERT(ssl_ctx_ == NULL);
+  session_resumption_enabled_ = enabled;
+  return true;
+}
+
+bool OpenSSLStreamAdapter::IsResumedSession() {
+  return state_ == SSL_CONNECTED && SSL_session_reused(ssl_);
+}
+
 //
 // StreamInterface Implementation
 //
@@ -771,6 +905,13 @@ int OpenSSLStreamAdapter::BeginSSL() {
   SSL_set_app_data(ssl_, this);
 
   SSL_set_bio(ssl_, bio, bio);  // the SSL object owns the bio now.
+
+  if (session_resumption_enabled_ && role_ == SSL_CLIENT) {
+    std::string key = SessionCacheKey();
+    if (!key.empty() && SessionCache::Instance()->Resume(key, ssl_)) {
+      LOG(LS_INFO) << "Offering to resume a previous session";
+    }
+  }
 #ifndef OPENSSL_IS_BORINGSSL
   if (ssl_mode_ == SSL_MODE_DTLS) {
     // Enable read-ahead for DTLS so whole packets are read from internal BIO
@@ -818,6 +959,24 @@ int OpenSSLStreamAdapter::ContinueSSL() {
         return -1;
       }
 
+      if (SSL_session_reused(ssl_)) {
+        LOG(LS_INFO) << "Resumed a previous session";
+        if (ssl_server_name_.empty() && !VerifyResumedPeerCertificate()) {
+          LOG(LS_ERROR) << "Resumed session is for a different peer";
+          return -1;
+        }
+      }
+
+      if (session_resumption_enabled_ && role_ == SSL_CLIENT) {
+        std::string key = SessionCacheKey();
+        SSL_SESSION* session = SSL_get1_session(ssl_);
+        if (!key.empty() && session) {
+          SessionCache::Instance()->Save(key, session);
+        } else if (session) {
+          SSL_SESSION_free(session);
+        }
+      }
+
       state_ = SSL_CONNECTED;
       StreamAdapterInterface::OnEvent(stream(), SE_OPEN|SE_READ|SE_WRITE, 0);
       break;
@@ -1005,6 +1164,22 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
 
   SSL_CTX_set_verify(ctx, mode, SSLVerifyCallback);
   SSL_CTX_set_verify_depth(ctx, 4);
+
+  if (session_resumption_enabled_) {
+    unsigned char keys[SessionTicketKeys::kSize];
+    bool ok = SessionTicketKeys::Instance()->Get(keys) &&
+              SSL_CTX_set_tlsext_ticket_keys(ctx, keys, sizeof(keys)) &&
+              SSL_CTX_set_session_id_context(ctx, kSessionIdContext,
+                                             sizeof(kSessionIdContext));
+    OPENSSL_cleanse(keys, sizeof(keys));
+    if (!ok) {
+      SSL_CTX_free(ctx);
+      return NULL;
+    }
+    // Servers refuse to resume sessions older than this.
+    SSL_CTX_set_timeout(ctx, kSessionLifetimeSeconds);
+  }
+
   // Select list of available ciphers. Note that !SHA256 and !SHA384 only
   // remove HMAC-SHA256 and HMAC-SHA384 cipher suites, not GCM cipher suites
   // with SHA256 or SHA384 as the handshake hash.
@@ -1048,30 +1223,66 @@ int OpenSSLStreamAdapter::SSLVerifyCallback(int ok, X509_STORE_CTX* store) {
     return 1;
   }
 
+  // Ignore any verification error if the digest matches, since there is no
+  // value in checking the validity of a self-signed cert issued by untrusted
+  // sources.
+  return stream->VerifyPeerCertificate(cert) ? 1 : 0;
+}
+
+bool OpenSSLStreamAdapter::VerifyPeerCertificate(X509* cert) {
   unsigned char digest[EVP_MAX_MD_SIZE];
   size_t digest_length;
   if (!OpenSSLCertificate::ComputeDigest(
            cert,
-           stream->peer_certificate_digest_algorithm_,
+           peer_certificate_digest_algorithm_,
            digest, sizeof(digest),
            &digest_length)) {
     LOG(LS_WARNING) << "Failed to compute peer cert digest.";
-    return 0;
+    return false;
   }
 
   Buffer computed_digest(digest, digest_length);
-  if (computed_digest != stream->peer_certificate_digest_value_) {
+  if (computed_digest != peer_certificate_digest_value_) {
     LOG(LS_WARNING) << "Rejected peer certificate due to mismatched digest.";
-    return 0;
+    return false;
   }
-  // Ignore any verification error if the digest matches, since there is no
-  // value in checking the validity of a self-signed cert issued by untrusted
-  // sources.
   LOG(LS_INFO) << "Accepted peer certificate.";
 
   // Record the peer's certificate.
-  stream->peer_certificate_.reset(new OpenSSLCertificate(cert));
-  return 1;
+  peer_certificate_.reset(new OpenSSLCertificate(cert));
+  return true;
+}
+
+bool OpenSSLStreamAdapter::VerifyResumedPeerCertificate() {
+  if (peer_certificate_digest_algorithm_.empty()) {
+    return false;
+  }
+  X509* cert = SSL_get_peer_certificate(ssl_);
+  if (!cert) {
+    LOG(LS_WARNING) << "Resumed session has no peer certificate.";
+    return false;
+  }
+  bool ok = VerifyPeerCertificate(cert);
+  X509_free(cert);
+  return ok;
+}
+
+std::string OpenSSLStreamAdapter::SessionCacheKey() const {
+  if (peer_certificate_digest_algorithm_.empty() || !identity_) {
+    return std::string();
+  }
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  size_t digest_length;
+  if (!identity_->certificate().ComputeDigest(
+          peer_certificate_digest_algorithm_, digest, sizeof(digest),
+          &digest_length)) {
+    return std::string();
+  }
+  std::string key(peer_certificate_digest_algorithm_);
+  key.append(peer_certificate_digest_value_.data<char>(),
+             peer_certificate_digest_value_.size());
+  key.append(reinterpret_cast<const char*>(digest), digest_length);
+  return key;
 }
 
 // This code is taken from the "Network Security with OpenSSL"
@@ -22,6 +22,7 @@
 typedef struct ssl_st SSL;
 typedef struct ssl_ctx_st SSL_CTX;
 typedef struct ssl_cipher_st SSL_CIPHER;
+typedef struct x509_st X509;
 typedef struct x509_store_ctx_st X509_STORE_CTX;
 
 namespace rtc {
@@ -76,6 +77,7 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
   int StartSSLWithPeer() override;
   void SetMode(SSLMode mode) override;
   void SetMaxProtocolVersion(SSLProtocolVersion version) override;
+  bool SetSessionResumptionEnabled(bool enabled) override;
 
   StreamResult Read(void* data,
                     size_t data_len,
@@ -95,6 +97,8 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
 
   int GetSslVersion() const override;
 
+  bool IsResumedSession() override;
+
   // Key Extractor interface
   bool ExportKeyingMaterial(const std::string& label,
                             const uint8_t* context,
@@ -172,6 +176,14 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
   // the C style: zero means verification failure, non-zero means
   // passed.
   static int SSLVerifyCallback(int ok, X509_STORE_CTX* store);
+  // Checks |cert| against the expected digest and records it as the peer's.
+  bool VerifyPeerCertificate(X509* cert);
+  // Resumed sessions skip the verify callback, so this checks the certificate
+  // saved with the session instead.
+  bool VerifyResumedPeerCertificate();
+  // The session cache key for a client in peer-to-peer mode: the digests of
+  // the peer's and our own certificates. Empty if either is unknown.
+  std::string SessionCacheKey() const;
 
   SSLState state_;
   SSLRole role_;
@@ -208,6 +220,8 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
 
   // Max. allowed protocol version
   SSLProtocolVersion ssl_max_version_;
+
+  bool session_resumption_enabled_;
 };
 
 /////////////////////////////////////////////////////////////////////////////
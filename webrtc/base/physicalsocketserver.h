@@ -11,6 +11,11 @@
 #ifndef WEBRTC_BASE_PHYSICALSOCKETSERVER_H__
 #define WEBRTC_BASE_PHYSICALSOCKETSERVER_H__
 
+#if defined(WEBRTC_LINUX) && !defined(__native_client__)
+#include <sys/epoll.h>
+#define WEBRTC_USE_EPOLL 1
+#endif
+
 #include <memory>
 #include <vector>
 
@@ -77,6 +82,9 @@ class PhysicalSocketServer : public SocketServer {
 
   void Add(Dispatcher* dispatcher);
   void Remove(Dispatcher* dispatcher);
+  // Must be called by a registered dispatcher whenever the value returned by
+  // its GetRequestedEvents() changes.
+  void Update(Dispatcher* dispatcher);
 
 #if defined(WEBRTC_POSIX)
   AsyncFile* CreateFile(int fd);
@@ -102,9 +110,25 @@ class PhysicalSocketServer : public SocketServer {
   typedef std::vector<size_t*> IteratorList;
 
 #if defined(WEBRTC_POSIX)
+  bool WaitSelect(int cms, bool process_io);
   static bool InstallSignal(int signum, void (*handler)(int));
 
   std::unique_ptr<PosixSignalDispatcher> signal_dispatcher_;
+#endif
+#if defined(WEBRTC_USE_EPOLL)
+  void AddEpoll(Dispatcher* dispatcher);
+  void RemoveEpoll(Dispatcher* dispatcher);
+  void UpdateEpoll(Dispatcher* dispatcher);
+  bool WaitEpoll(int cms);
+  bool WaitPoll(int cms, Dispatcher* dispatcher);
+
+  int epoll_fd_;
+  std::vector<struct epoll_event> epoll_events_;
+  // Index of the event currently being processed by WaitEpoll() and the
+  // number of valid entries in |epoll_events_|. Used to invalidate pending
+  // events of dispatchers that are removed from within an event handler.
+  int epoll_event_index_;
+  int epoll_event_count_;
 #endif
   DispatcherList dispatchers_;
   IteratorList iterators_;
@@ -148,6 +172,9 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  int RecvFromBatch(ReceivedDatagram* datagrams, size_t count) override;
+#endif
 
   int Listen(int backlog) override;
   AsyncSocket* Accept(SocketAddress* out_addr) override;
@@ -161,6 +188,13 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
  protected:
   int DoConnect(const SocketAddress& connect_addr);
 
+  uint8_t enabled_events() const { return enabled_events_; }
+  // Virtual so a registered dispatcher can tell its socket server about
+  // changes of the requested events.
+  virtual void SetEnabledEvents(uint8_t events);
+  virtual void EnableEvents(uint8_t events);
+  virtual void DisableEvents(uint8_t events);
+
   // Make virtual so ::accept can be overwritten in tests.
   virtual SOCKET DoAccept(SOCKET socket, sockaddr* addr, socklen_t* addrlen);
 
@@ -180,16 +214,22 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
 
   PhysicalSocketServer* ss_;
   SOCKET s_;
-  uint8_t enabled_events_;
   bool udp_;
   CriticalSection crit_;
   int error_ GUARDED_BY(crit_);
   ConnState state_;
   AsyncResolver* resolver_;
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // Whether SO_TIMESTAMP has been enabled for RecvFromBatch().
+  bool recv_timestamps_enabled_;
+#endif
 
 #if !defined(NDEBUG)
   std::string dbg_addr_;
 #endif
+
+ private:
+  uint8_t enabled_events_;
 };
 
 class SocketDispatcher : public Dispatcher, public PhysicalSocket {
@@ -218,13 +258,31 @@ class SocketDispatcher : public Dispatcher, public PhysicalSocket {
 
   int Close() override;
 
-#if defined(WEBRTC_WIN)
+#if defined(WEBRTC_USE_EPOLL)
+ protected:
+  void SetEnabledEvents(uint8_t events) override;
+  void EnableEvents(uint8_t events) override;
+  void DisableEvents(uint8_t events) override;
+#endif
+
  private:
+#if defined(WEBRTC_WIN)
   static int next_id_;
   int id_;
   bool signal_close_;
   int signal_err_;
 #endif // WEBRTC_WIN
+#if defined(WEBRTC_USE_EPOLL)
+  // Changes of the enabled events done while an event is being dispatched are
+  // collected and reported to the socket server once the handlers returned.
+  // This avoids an epoll_ctl() call for the common case of a handler that
+  // re-enables the event it has just been notified about.
+  void StartBatchedEventUpdates();
+  void FinishBatchedEventUpdates();
+  void MaybeUpdateDispatcher(uint8_t old_events);
+
+  int saved_enabled_events_;
+#endif  // WEBRTC_USE_EPOLL
 };
 
 } // namespace rtc
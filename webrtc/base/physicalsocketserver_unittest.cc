@@ -11,6 +11,10 @@
 #include <memory>
 #include <signal.h>
 #include <stdarg.h>
+#if defined(WEBRTC_POSIX)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
 
 #include "webrtc/base/gunit.h"
 #include "webrtc/base/logging.h"
@@ -384,6 +388,79 @@ TEST_F(PhysicalSocketTest, TestGetSetOptionsIPv6) {
   SocketTest::TestGetSetOptionsIPv6();
 }
 
+#if defined(WEBRTC_USE_EPOLL)
+
+class ReadEventCounter : public sigslot::has_slots<> {
+ public:
+  ReadEventCounter() : count_(0) {}
+
+  void OnReadEvent(AsyncSocket* socket) { ++count_; }
+
+  int count() const { return count_; }
+
+ private:
+  int count_;
+};
+
+// Descriptors at or above FD_SETSIZE can't be waited for with "select", but
+// must still work if the socket server uses epoll.
+TEST_F(PhysicalSocketTest, TestUdpLargeDescriptorIPv4) {
+  struct rlimit limit;
+  ASSERT_EQ(0, getrlimit(RLIMIT_NOFILE, &limit));
+  const int large_fd = FD_SETSIZE + 10;
+  if (limit.rlim_cur <= static_cast<rlim_t>(large_fd)) {
+    LOG(LS_INFO) << "Descriptor limit too low... skipping";
+    return;
+  }
+
+  int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_NE(-1, fd);
+  ASSERT_EQ(large_fd, dup2(fd, large_fd));
+  ::close(fd);
+
+  std::unique_ptr<AsyncSocket> socket(server_->WrapSocket(large_fd));
+  ASSERT_TRUE(socket);
+  ReadEventCounter counter;
+  socket->SignalReadEvent.connect(&counter, &ReadEventCounter::OnReadEvent);
+  ASSERT_EQ(0, socket->Bind(SocketAddress(kIPv4Loopback, 0)));
+  SocketAddress address = socket->GetLocalAddress();
+
+  const char kData[] = "abc";
+  ASSERT_EQ(static_cast<int>(sizeof(kData)),
+            socket->SendTo(kData, sizeof(kData), address));
+  EXPECT_TRUE_WAIT(counter.count() == 1, kTimeout);
+
+  char buffer[sizeof(kData)];
+  EXPECT_EQ(static_cast<int>(sizeof(kData)),
+            socket->RecvFrom(buffer, sizeof(buffer), nullptr, nullptr));
+}
+
+#endif  // WEBRTC_USE_EPOLL
+
+#if defined(WEBRTC_LINUX) && defined(SO_REUSEPORT)
+// Two UDP sockets with OPT_REUSEPORT set may bind the same address and port.
+TEST_F(PhysicalSocketTest, TestUdpReusePortIPv4) {
+  std::unique_ptr<AsyncSocket> first(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_TRUE(first);
+  ASSERT_EQ(0, first->SetOption(Socket::OPT_REUSEPORT, 1));
+  ASSERT_EQ(0, first->Bind(SocketAddress(kIPv4Loopback, 0)));
+  SocketAddress address = first->GetLocalAddress();
+
+  std::unique_ptr<AsyncSocket> second(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_TRUE(second);
+  ASSERT_EQ(0, second->SetOption(Socket::OPT_REUSEPORT, 1));
+  EXPECT_EQ(0, second->Bind(address));
+
+  // Without the option the port is still taken.
+  std::unique_ptr<AsyncSocket> third(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_TRUE(third);
+  EXPECT_NE(0, third->Bind(address));
+}
+#endif  // WEBRTC_LINUX && SO_REUSEPORT
+
 #if defined(WEBRTC_POSIX)
 
 #if !defined(WEBRTC_MAC)
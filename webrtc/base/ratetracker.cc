@@ -148,7 +148,12 @@ void RateTracker::EnsureInitialized() {
 }
 
 size_t RateTracker::NextBucketIndex(size_t bucket_index) const {
-  return (bucket_index + 1u) % (bucket_count_ + 1u);
+  // Callers only step a valid index, or one at most bucket_count_ past it,
+  // so a compare and subtract replaces the division in a modulo.
+  ++bucket_index;
+  if (bucket_index > bucket_count_)
+    bucket_index -= bucket_count_ + 1u;
+  return bucket_index;
 }
 
 }  // namespace rtc
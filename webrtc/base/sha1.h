@@ -28,6 +28,6 @@ void SHA1Init(SHA1_CTX* context);
 void SHA1Update(SHA1_CTX* context, const uint8_t* data, size_t len);
 void SHA1Final(SHA1_CTX* context, uint8_t digest[SHA1_DIGEST_SIZE]);
 
-#endif  // WEBRTC_BASE_SHA1_H_
-
 }  // namespace rtc
+
+#endif  // WEBRTC_BASE_SHA1_H_
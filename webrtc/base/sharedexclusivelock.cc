@@ -10,35 +10,54 @@
 
 #include "webrtc/base/sharedexclusivelock.h"
 
+#include "webrtc/base/checks.h"
+
 namespace rtc {
 
-SharedExclusiveLock::SharedExclusiveLock()
-    : shared_count_is_zero_(true, true),
-      shared_count_(0) {
+SharedExclusiveLock::SharedExclusiveLock() {
+#if defined(WEBRTC_WIN)
+  InitializeSRWLock(&lock_);
+#else
+  RTC_CHECK_EQ(0, pthread_rwlock_init(&lock_, nullptr));
+#endif
+}
+
+SharedExclusiveLock::~SharedExclusiveLock() {
+#if !defined(WEBRTC_WIN)
+  pthread_rwlock_destroy(&lock_);
+#endif
 }
 
 void SharedExclusiveLock::LockExclusive() {
-  cs_exclusive_.Enter();
-  shared_count_is_zero_.Wait(Event::kForever);
+#if defined(WEBRTC_WIN)
+  AcquireSRWLockExclusive(&lock_);
+#else
+  pthread_rwlock_wrlock(&lock_);
+#endif
 }
 
 void SharedExclusiveLock::UnlockExclusive() {
-  cs_exclusive_.Leave();
+#if defined(WEBRTC_WIN)
+  ReleaseSRWLockExclusive(&lock_);
+#else
+  pthread_rwlock_unlock(&lock_);
+#endif
 }
 
 void SharedExclusiveLock::LockShared() {
-  CritScope exclusive_scope(&cs_exclusive_);
-  CritScope shared_scope(&cs_shared_);
-  if (++shared_count_ == 1) {
-    shared_count_is_zero_.Reset();
-  }
+#if defined(WEBRTC_WIN)
+  AcquireSRWLockShared(&lock_);
+#else
+  pthread_rwlock_rdlock(&lock_);
+#endif
 }
 
 void SharedExclusiveLock::UnlockShared() {
-  CritScope shared_scope(&cs_shared_);
-  if (--shared_count_ == 0) {
-    shared_count_is_zero_.Set();
-  }
+#if defined(WEBRTC_WIN)
+  ReleaseSRWLockShared(&lock_);
+#else
+  pthread_rwlock_unlock(&lock_);
+#endif
 }
 
 }  // namespace rtc
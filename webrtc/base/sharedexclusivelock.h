@@ -11,17 +11,30 @@
 #ifndef WEBRTC_BASE_SHAREDEXCLUSIVELOCK_H_
 #define WEBRTC_BASE_SHAREDEXCLUSIVELOCK_H_
 
+#if defined(WEBRTC_WIN)
+#include <winsock2.h>
+#include <windows.h>
+#endif
+
+#if defined(WEBRTC_POSIX)
+#include <pthread.h>
+#endif
+
 #include "webrtc/base/constructormagic.h"
-#include "webrtc/base/criticalsection.h"
-#include "webrtc/base/event.h"
+#include "webrtc/base/thread_annotations.h"
 
 namespace rtc {
 
 // This class provides shared-exclusive lock. It can be used in cases like
 // multiple-readers/single-writer model.
+// It wraps the platform's reader-writer lock, an SRWLOCK on Windows and a
+// pthread_rwlock_t elsewhere, so that shared locking is a single atomic
+// operation when there is no writer. The lock is not recursive: a thread that
+// holds it exclusively must not lock it again.
 class LOCKABLE SharedExclusiveLock {
  public:
   SharedExclusiveLock();
+  ~SharedExclusiveLock();
 
   // Locking/unlocking methods. It is encouraged to use SharedScope or
   // ExclusiveScope for protection.
@@ -31,10 +44,11 @@ class LOCKABLE SharedExclusiveLock {
   void UnlockShared();
 
  private:
-  rtc::CriticalSection cs_exclusive_;
-  rtc::CriticalSection cs_shared_;
-  rtc::Event shared_count_is_zero_;
-  int shared_count_;
+#if defined(WEBRTC_WIN)
+  SRWLOCK lock_;
+#else
+  pthread_rwlock_t lock_;
+#endif
 
   RTC_DISALLOW_COPY_AND_ASSIGN(SharedExclusiveLock);
 };
@@ -9,11 +9,15 @@
  */
 
 #include <memory>
+#include <vector>
 
 #include "webrtc/base/common.h"
+#include "webrtc/base/criticalsection.h"
 #include "webrtc/base/gunit.h"
+#include "webrtc/base/logging.h"
 #include "webrtc/base/messagehandler.h"
 #include "webrtc/base/messagequeue.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/base/sharedexclusivelock.h"
 #include "webrtc/base/thread.h"
 #include "webrtc/base/timeutils.h"
@@ -226,4 +230,60 @@ TEST_F(SharedExclusiveLockTest, MAYBE_TestExclusiveExclusive) {
   EXPECT_GE(writer.waiting_time_in_ms(), kWaitThresholdInMs);
 }
 
+// Locks a lock |kLocksPerThread| times on each of |kNumPerfThreads| threads.
+static const int kNumPerfThreads = 4;
+static const int kLocksPerThread = 1000000;
+
+template <typename Lock, typename Scope>
+class LockPerfTask {
+ public:
+  explicit LockPerfTask(Lock* lock) : lock_(lock), value_(0) {}
+
+  static bool Run(void* obj) {
+    LockPerfTask* task = static_cast<LockPerfTask*>(obj);
+    for (int i = 0; i < kLocksPerThread; ++i) {
+      Scope scope(task->lock_);
+      ++task->value_;
+    }
+    return false;
+  }
+
+ private:
+  Lock* const lock_;
+  int value_;
+};
+
+template <typename Lock, typename Scope>
+int64_t MeasureLockingMs() {
+  Lock lock;
+  std::vector<std::unique_ptr<LockPerfTask<Lock, Scope>>> tasks;
+  std::vector<std::unique_ptr<PlatformThread>> threads;
+  for (int i = 0; i < kNumPerfThreads; ++i) {
+    tasks.emplace_back(new LockPerfTask<Lock, Scope>(&lock));
+    threads.emplace_back(new PlatformThread(
+        &LockPerfTask<Lock, Scope>::Run, tasks.back().get(), "LockPerf"));
+  }
+  int64_t start = TimeMillis();
+  for (const auto& thread : threads)
+    thread->Start();
+  for (const auto& thread : threads)
+    thread->Stop();
+  return TimeDiff(TimeMillis(), start);
+}
+
+// Compares shared locking from several threads, the common case for the
+// read-mostly state this lock guards, with a critical section. Disabled
+// because it takes too long to run routinely. Use for performance
+// benchmarking when needed.
+TEST(SharedExclusiveLockPerfTest, DISABLED_SharedLocking) {
+  LOG(LS_INFO) << "Shared locking: "
+               << MeasureLockingMs<SharedExclusiveLock, SharedScope>()
+               << " ms";
+  LOG(LS_INFO) << "Exclusive locking: "
+               << MeasureLockingMs<SharedExclusiveLock, ExclusiveScope>()
+               << " ms";
+  LOG(LS_INFO) << "Critical section: "
+               << MeasureLockingMs<CriticalSection, CritScope>() << " ms";
+}
+
 }  // namespace rtc
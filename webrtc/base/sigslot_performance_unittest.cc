@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/sigslot.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace rtc {
+namespace {
+const int kNumPackets = 1 << 22;
+// An incoming RTP packet goes socket -> port -> P2PTransportChannel ->
+// DtlsTransportChannelWrapper -> BaseChannel, which is four emissions.
+const int kNumHops = 4;
+
+// Returns packets per second.
+size_t Throughput(int num_packets, int64_t elapsed_ns) {
+  return static_cast<size_t>(num_packets * kNumNanosecsPerSec /
+                             std::max<int64_t>(elapsed_ns, 1));
+}
+
+// One hop of the receive path, forwarding what it reads to the next hop the
+// way the transport classes do.
+class SignalHop : public sigslot::has_slots<> {
+ public:
+  void OnReadPacket(SignalHop* from,
+                    const char* data,
+                    size_t len,
+                    int64_t packet_time_us,
+                    int flags) {
+    bytes_ += len;
+    SignalReadPacket(this, data, len, packet_time_us, flags);
+  }
+
+  sigslot::signal5<SignalHop*, const char*, size_t, int64_t, int>
+      SignalReadPacket;
+  size_t bytes_ = 0;
+};
+
+// The same hop as a plain virtual call, which is the lower bound for any
+// callback mechanism that replaces the signals.
+class CallHop {
+ public:
+  explicit CallHop(CallHop* next) : next_(next) {}
+  virtual ~CallHop() {}
+
+  virtual void OnReadPacket(const char* data,
+                            size_t len,
+                            int64_t packet_time_us,
+                            int flags) {
+    bytes_ += len;
+    if (next_)
+      next_->OnReadPacket(data, len, packet_time_us, flags);
+  }
+
+  CallHop* const next_;
+  size_t bytes_ = 0;
+};
+
+// Delivers packets through |kNumHops| signals. |extra_slots| are connected to
+// every hop in addition to the next one, like test or monitoring code does.
+size_t MeasureSignalChain(int extra_slots) {
+  std::vector<std::unique_ptr<SignalHop>> hops;
+  std::vector<std::unique_ptr<SignalHop>> observers;
+  for (int i = 0; i <= kNumHops; ++i) {
+    hops.emplace_back(new SignalHop());
+    if (i > 0) {
+      hops[i - 1]->SignalReadPacket.connect(hops[i].get(),
+                                            &SignalHop::OnReadPacket);
+      for (int j = 0; j < extra_slots; ++j) {
+        observers.emplace_back(new SignalHop());
+        hops[i - 1]->SignalReadPacket.connect(observers.back().get(),
+                                              &SignalHop::OnReadPacket);
+      }
+    }
+  }
+
+  const char packet[200] = {0};
+  const int64_t start_ns = TimeNanos();
+  for (int i = 0; i < kNumPackets; ++i)
+    hops[0]->OnReadPacket(nullptr, packet, sizeof(packet), i, 0);
+  const int64_t elapsed_ns = TimeNanos() - start_ns;
+  EXPECT_EQ(kNumPackets * sizeof(packet), hops.back()->bytes_);
+  return Throughput(kNumPackets, elapsed_ns);
+}
+
+size_t MeasureCallChain() {
+  std::vector<std::unique_ptr<CallHop>> hops;
+  CallHop* next = nullptr;
+  for (int i = 0; i <= kNumHops; ++i) {
+    hops.emplace_back(new CallHop(next));
+    next = hops.back().get();
+  }
+
+  const char packet[200] = {0};
+  const int64_t start_ns = TimeNanos();
+  for (int i = 0; i < kNumPackets; ++i)
+    hops.back()->OnReadPacket(packet, sizeof(packet), i, 0);
+  const int64_t elapsed_ns = TimeNanos() - start_ns;
+  EXPECT_EQ(kNumPackets * sizeof(packet), hops.front()->bytes_);
+  return Throughput(kNumPackets, elapsed_ns);
+}
+}  // namespace
+
+TEST(SigslotPerformanceTest, ReceivePathSignalChain) {
+  const int kExtraSlots[] = {0, 1, 3};
+  for (int extra_slots : kExtraSlots) {
+    webrtc::test::PrintResult("sigslot_receive_path",
+                              "_" + ToString(extra_slots) + "_extra_slots",
+                              "throughput", MeasureSignalChain(extra_slots),
+                              "packets/s", true);
+  }
+  webrtc::test::PrintResult("sigslot_receive_path", "_direct_calls",
+                            "throughput", MeasureCallChain(), "packets/s",
+                            true);
+}
+
+}  // namespace rtc
@@ -133,6 +133,23 @@ struct SentPacket {
   int64_t send_time_ms;
 };
 
+// Storage for one datagram received by Socket::RecvFromBatch().
+struct ReceivedDatagram {
+  ReceivedDatagram()
+      : data(nullptr), capacity(0), size(0), timestamp(-1), truncated(false) {}
+
+  // Provided by the caller.
+  void* data;
+  size_t capacity;
+  // Filled in by the socket.
+  size_t size;
+  SocketAddress addr;
+  int64_t timestamp;  // Receive time in microseconds, or -1 if unknown.
+  // Whether the datagram was larger than |capacity|. Only |capacity| bytes
+  // of it are kept.
+  bool truncated;
+};
+
 // General interface for the socket implementations of various networks.  The
 // methods match those of normal UNIX sockets very closely.
 class Socket {
@@ -156,6 +173,23 @@ class Socket {
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+  // Receives up to |count| pending datagrams into |datagrams| with a single
+  // call. Returns the number of datagrams received, or SOCKET_ERROR if none
+  // could be read (GetError() tells why). Datagrams that don't fit into the
+  // provided storage are truncated, which is reported if the socket can tell.
+  // The default implementation reads a single datagram through RecvFrom().
+  virtual int RecvFromBatch(ReceivedDatagram* datagrams, size_t count) {
+    if (count == 0) {
+      return 0;
+    }
+    int len = RecvFrom(datagrams[0].data, datagrams[0].capacity,
+                       &datagrams[0].addr, &datagrams[0].timestamp);
+    if (len < 0) {
+      return SOCKET_ERROR;
+    }
+    datagrams[0].size = static_cast<size_t>(len);
+    return 1;
+  }
   virtual int Listen(int backlog) = 0;
   virtual Socket *Accept(SocketAddress *paddr) = 0;
   virtual int Close() = 0;
@@ -185,6 +219,10 @@ class Socket {
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
+    OPT_REUSEPORT,   // Lets several sockets bind the same address and port,
+                     // with the kernel spreading datagrams across them by a
+                     // hash of the 4-tuple. Must be set before Bind().
+                     // Linux only.
   };
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;
@@ -31,6 +31,12 @@ const int SRTP_AES128_CM_SHA1_80 = 0x0001;
 #ifndef SRTP_AES128_CM_SHA1_32
 const int SRTP_AES128_CM_SHA1_32 = 0x0002;
 #endif
+#ifndef SRTP_AEAD_AES_128_GCM
+const int SRTP_AEAD_AES_128_GCM = 0x0007;
+#endif
+#ifndef SRTP_AEAD_AES_256_GCM
+const int SRTP_AEAD_AES_256_GCM = 0x0008;
+#endif
 
 // Cipher suite to use for SRTP. Typically a 80-bit HMAC will be used, except
 // in applications (voice) where the additional bandwidth may be significant.
@@ -39,6 +45,10 @@ const int SRTP_AES128_CM_SHA1_32 = 0x0002;
 extern const char CS_AES_CM_128_HMAC_SHA1_80[];
 // 128-bit AES with 32-bit SHA-1 HMAC.
 extern const char CS_AES_CM_128_HMAC_SHA1_32[];
+// 128-bit AES in GCM mode with a 16 byte tag, from RFC 7714.
+extern const char CS_AEAD_AES_128_GCM[];
+// 256-bit AES in GCM mode with a 16 byte tag, from RFC 7714.
+extern const char CS_AEAD_AES_256_GCM[];
 
 // Given the DTLS-SRTP protection profile ID, as defined in
 // https://tools.ietf.org/html/rfc4568#section-6.2 , return the SRTP profile
@@ -48,6 +58,25 @@ std::string SrtpCryptoSuiteToName(int crypto_suite);
 // The reverse of above conversion.
 int SrtpCryptoSuiteFromName(const std::string& crypto_suite);
 
+// Get key length and salt length for given crypto suite. Returns true for
+// valid suites, otherwise false.
+bool GetSrtpKeyAndSaltLengths(int crypto_suite, int* key_length,
+                              int* salt_length);
+
+// Returns true if the given crypto suite id uses a GCM cipher.
+bool IsGcmCryptoSuite(int crypto_suite);
+
+// Returns true if the given crypto suite name uses a GCM cipher.
+bool IsGcmCryptoSuiteName(const std::string& crypto_suite);
+
+struct CryptoOptions {
+  CryptoOptions() : enable_gcm_crypto_suites(false) {}
+
+  // Enable GCM crypto suites from RFC 7714 for SRTP. GCM will only be used
+  // if both sides enable it, and requires a libsrtp built with GCM support.
+  bool enable_gcm_crypto_suites;
+};
+
 // SSLStreamAdapter : A StreamInterfaceAdapter that does SSL/TLS.
 // After SSL has been started, the stream will only open on successful
 // SSL verification of certificates, and the communication is
@@ -117,6 +146,14 @@ class SSLStreamAdapter : public StreamAdapterInterface {
   // next lower will be used.
   virtual void SetMaxProtocolVersion(SSLProtocolVersion version) = 0;
 
+  // Allow a later stream between the same identities to resume the session
+  // instead of doing a full handshake. In peer-to-peer mode a client only
+  // offers a session made with the same certificates on both ends, and the
+  // peer's certificate is checked against its digest either way. Must be set
+  // on both ends before the handshake starts. Returns false if resumption
+  // isn't supported.
+  virtual bool SetSessionResumptionEnabled(bool enabled);
+
   // The mode of operation is selected by calling either
   // StartSSLWithServer or StartSSLWithPeer.
   // Use of the stream prior to calling either of these functions will
@@ -168,6 +205,9 @@ class SSLStreamAdapter : public StreamAdapterInterface {
 
   virtual int GetSslVersion() const = 0;
 
+  // Whether the established session was resumed rather than fully negotiated.
+  virtual bool IsResumedSession();
+
   // Key Exporter interface from RFC 5705
   // Arguments are:
   // label               -- the exporter label.
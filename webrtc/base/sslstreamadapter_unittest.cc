@@ -495,6 +495,18 @@ class SSLStreamAdapterTestBase : public testing::Test,
       return server_ssl_->GetSslVersion();
   }
 
+  void SetSessionResumptionEnabled(bool enabled) {
+    client_ssl_->SetSessionResumptionEnabled(enabled);
+    server_ssl_->SetSessionResumptionEnabled(enabled);
+  }
+
+  bool IsResumedSession(bool client) {
+    if (client)
+      return client_ssl_->IsResumedSession();
+    else
+      return server_ssl_->IsResumedSession();
+  }
+
   bool ExportKeyingMaterial(const char *label,
                             const unsigned char *context,
                             size_t context_len,
@@ -775,6 +787,37 @@ class SSLStreamAdapterTestDTLS
     }
   };
 
+  // Replaces both ends with new streams, as for a second call. With
+  // |same_identities| they keep their identities, as repeat peers would.
+  void RecreateStreams(bool same_identities) {
+    rtc::SSLIdentity* client_identity;
+    rtc::SSLIdentity* server_identity;
+    if (same_identities) {
+      client_identity = client_identity_->GetReference();
+      server_identity = server_identity_->GetReference();
+    } else {
+      client_identity = rtc::SSLIdentity::Generate("client", client_key_type_);
+      server_identity = rtc::SSLIdentity::Generate("server", server_key_type_);
+    }
+    client_ssl_.reset(nullptr);
+    server_ssl_.reset(nullptr);
+    client_buffer_.Clear();
+    server_buffer_.Clear();
+
+    CreateStreams();
+    client_ssl_.reset(rtc::SSLStreamAdapter::Create(client_stream_));
+    server_ssl_.reset(rtc::SSLStreamAdapter::Create(server_stream_));
+    SSLStreamAdapterTestBase* base = this;
+    client_ssl_->SignalEvent.connect(base, &SSLStreamAdapterTestBase::OnEvent);
+    server_ssl_->SignalEvent.connect(base, &SSLStreamAdapterTestBase::OnEvent);
+
+    client_identity_ = client_identity;
+    server_identity_ = server_identity;
+    client_ssl_->SetIdentity(client_identity_);
+    server_ssl_->SetIdentity(server_identity_);
+    identities_set_ = false;
+  }
+
  private:
   BufferQueueStream client_buffer_;
   BufferQueueStream server_buffer_;
@@ -862,6 +905,49 @@ TEST_P(SSLStreamAdapterTestDTLS, TestDTLSConnect) {
   TestHandshake();
 };
 
+// Test that a second handshake between the same identities resumes the
+// session of the first, and still learns the peer's certificate.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSessionResumption) {
+  MAYBE_SKIP_TEST(HaveDtls);
+  SetSessionResumptionEnabled(true);
+  TestHandshake();
+  EXPECT_FALSE(IsResumedSession(true));
+
+  RecreateStreams(true);
+  SetSessionResumptionEnabled(true);
+  TestHandshake();
+  EXPECT_TRUE(IsResumedSession(true));
+  EXPECT_TRUE(IsResumedSession(false));
+  EXPECT_TRUE(GetPeerCertificate(true));
+  EXPECT_TRUE(GetPeerCertificate(false));
+  TestTransfer(100);
+}
+
+// Test that a session isn't offered to a peer with a different certificate.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSessionNotResumedWithNewPeer) {
+  MAYBE_SKIP_TEST(HaveDtls);
+  SetSessionResumptionEnabled(true);
+  TestHandshake();
+
+  RecreateStreams(false);
+  SetSessionResumptionEnabled(true);
+  TestHandshake();
+  EXPECT_FALSE(IsResumedSession(true));
+  EXPECT_FALSE(IsResumedSession(false));
+}
+
+// Test that sessions are only resumed if both ends ask for it.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSessionNotResumedByDefault) {
+  MAYBE_SKIP_TEST(HaveDtls);
+  SetSessionResumptionEnabled(true);
+  TestHandshake();
+
+  RecreateStreams(true);
+  TestHandshake();
+  EXPECT_FALSE(IsResumedSession(true));
+  EXPECT_FALSE(IsResumedSession(false));
+}
+
 // Test that we can make a handshake work if the first packet in
 // each direction is lost. This gives us predictable loss
 // rather than having to tune random
@@ -984,6 +1070,68 @@ TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSrtpMixed) {
   ASSERT_EQ(client_cipher, rtc::SRTP_AES128_CM_SHA1_80);
 };
 
+// Test DTLS-SRTP with all GCM-128 ciphers.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSrtpGCM128) {
+  MAYBE_SKIP_TEST(HaveDtlsSrtp);
+  std::vector<int> gcm128;
+  gcm128.push_back(rtc::SRTP_AEAD_AES_128_GCM);
+  SetDtlsSrtpCryptoSuites(gcm128, true);
+  SetDtlsSrtpCryptoSuites(gcm128, false);
+  TestHandshake();
+
+  int client_cipher;
+  ASSERT_TRUE(GetDtlsSrtpCryptoSuite(true, &client_cipher));
+  int server_cipher;
+  ASSERT_TRUE(GetDtlsSrtpCryptoSuite(false, &server_cipher));
+
+  ASSERT_EQ(client_cipher, server_cipher);
+  ASSERT_EQ(client_cipher, rtc::SRTP_AEAD_AES_128_GCM);
+};
+
+// Test DTLS-SRTP with a GCM/CM mismatch -- should not converge.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSrtpGCMMismatch) {
+  MAYBE_SKIP_TEST(HaveDtlsSrtp);
+  std::vector<int> gcm256;
+  gcm256.push_back(rtc::SRTP_AEAD_AES_256_GCM);
+  std::vector<int> cm;
+  cm.push_back(rtc::SRTP_AES128_CM_SHA1_80);
+  SetDtlsSrtpCryptoSuites(gcm256, true);
+  SetDtlsSrtpCryptoSuites(cm, false);
+  TestHandshake();
+
+  int client_cipher;
+  ASSERT_FALSE(GetDtlsSrtpCryptoSuite(true, &client_cipher));
+  int server_cipher;
+  ASSERT_FALSE(GetDtlsSrtpCryptoSuite(false, &server_cipher));
+};
+
+// Test the key and salt lengths of the SRTP crypto suites.
+TEST(SrtpCryptoSuiteTest, KeyAndSaltLengths) {
+  int key_len;
+  int salt_len;
+  ASSERT_TRUE(rtc::GetSrtpKeyAndSaltLengths(rtc::SRTP_AES128_CM_SHA1_80,
+                                            &key_len, &salt_len));
+  EXPECT_EQ(16, key_len);
+  EXPECT_EQ(14, salt_len);
+  ASSERT_TRUE(rtc::GetSrtpKeyAndSaltLengths(rtc::SRTP_AEAD_AES_128_GCM,
+                                            &key_len, &salt_len));
+  EXPECT_EQ(16, key_len);
+  EXPECT_EQ(12, salt_len);
+  ASSERT_TRUE(rtc::GetSrtpKeyAndSaltLengths(rtc::SRTP_AEAD_AES_256_GCM,
+                                            &key_len, &salt_len));
+  EXPECT_EQ(32, key_len);
+  EXPECT_EQ(12, salt_len);
+  EXPECT_FALSE(rtc::GetSrtpKeyAndSaltLengths(rtc::SRTP_INVALID_CRYPTO_SUITE,
+                                             &key_len, &salt_len));
+
+  EXPECT_TRUE(rtc::IsGcmCryptoSuite(rtc::SRTP_AEAD_AES_256_GCM));
+  EXPECT_FALSE(rtc::IsGcmCryptoSuite(rtc::SRTP_AES128_CM_SHA1_80));
+  EXPECT_TRUE(rtc::IsGcmCryptoSuiteName(rtc::CS_AEAD_AES_128_GCM));
+  EXPECT_EQ(rtc::SRTP_AEAD_AES_128_GCM,
+            rtc::SrtpCryptoSuiteFromName(
+                rtc::SrtpCryptoSuiteToName(rtc::SRTP_AEAD_AES_128_GCM)));
+}
+
 // Test an exporter
 TEST_P(SSLStreamAdapterTestDTLS, TestDTLSExporter) {
   MAYBE_SKIP_TEST(HaveExporter);
@@ -15,6 +15,7 @@
 #include <utility>
 #include <vector>
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/criticalsection.h"
@@ -206,6 +207,144 @@ class SwapQueue {
   RTC_DISALLOW_COPY_AND_ASSIGN(SwapQueue);
 };
 
+// Same as SwapQueue, but without a lock. At most one thread at a time may call
+// Insert() and at most one thread at a time may call Remove(); callers that
+// insert or remove from several threads must serialize those calls
+// themselves. Neither call ever waits for the other side, which avoids the
+// producer and consumer stalling each other on priority inverted or heavily
+// loaded devices.
+template <typename T, typename QueueItemVerifier = SwapQueueItemVerifier<T>>
+class SpscSwapQueue {
+ public:
+  // Creates a queue of size size and fills it with default constructed Ts.
+  explicit SpscSwapQueue(size_t size) : queue_(size + 1) {
+    RTC_DCHECK(VerifyQueueSlots());
+  }
+
+  // Same as above and accepts an item verification functor.
+  SpscSwapQueue(size_t size, const QueueItemVerifier& queue_item_verifier)
+      : queue_item_verifier_(queue_item_verifier), queue_(size + 1) {
+    RTC_DCHECK(VerifyQueueSlots());
+  }
+
+  // Creates a queue of size size and fills it with copies of prototype.
+  SpscSwapQueue(size_t size, const T& prototype)
+      : queue_(size + 1, prototype) {
+    RTC_DCHECK(VerifyQueueSlots());
+  }
+
+  // Same as above and accepts an item verification functor.
+  SpscSwapQueue(size_t size,
+                const T& prototype,
+                const QueueItemVerifier& queue_item_verifier)
+      : queue_item_verifier_(queue_item_verifier),
+        queue_(size + 1, prototype) {
+    RTC_DCHECK(VerifyQueueSlots());
+  }
+
+  // Resets the queue to have zero content wile maintaining the queue size.
+  // Must not be called concurrently with Insert() or Remove().
+  void Clear() {
+    producer_.cached_other_index = 0;
+    consumer_.cached_other_index = 0;
+    rtc::AtomicOps::ReleaseStore(&producer_.index, 0);
+    rtc::AtomicOps::ReleaseStore(&consumer_.index, 0);
+  }
+
+  // Inserts a "full" T at the back of the queue by swapping *input with an
+  // "empty" T from the queue.
+  // Returns true if the item was inserted or false if not (the queue was full).
+  // When specified, the T given in *input must pass the ItemVerifier() test.
+  // The contents of *input after the call are then also guaranteed to pass the
+  // ItemVerifier() test.
+  bool Insert(T* input) WARN_UNUSED_RESULT {
+    RTC_DCHECK(input);
+    RTC_DCHECK(queue_item_verifier_(*input));
+
+    // The write index is only modified by the producer.
+    const int write_index = producer_.index;
+    const int next_write_index = NextIndex(write_index);
+    if (next_write_index == producer_.cached_other_index) {
+      producer_.cached_other_index =
+          rtc::AtomicOps::AcquireLoad(&consumer_.index);
+      if (next_write_index == producer_.cached_other_index) {
+        return false;
+      }
+    }
+
+    using std::swap;
+    swap(*input, queue_[write_index]);
+
+    // Publishes the inserted item to the consumer.
+    rtc::AtomicOps::ReleaseStore(&producer_.index, next_write_index);
+    return true;
+  }
+
+  // Removes the frontmost "full" T from the queue by swapping it with
+  // the "empty" T in *output.
+  // Returns true if an item could be removed or false if not (the queue was
+  // empty). When specified, The T given in *output must pass the ItemVerifier()
+  // test and the contents of *output after the call are then also guaranteed to
+  // pass the ItemVerifier() test.
+  bool Remove(T* output) WARN_UNUSED_RESULT {
+    RTC_DCHECK(output);
+    RTC_DCHECK(queue_item_verifier_(*output));
+
+    // The read index is only modified by the consumer.
+    const int read_index = consumer_.index;
+    if (read_index == consumer_.cached_other_index) {
+      consumer_.cached_other_index =
+          rtc::AtomicOps::AcquireLoad(&producer_.index);
+      if (read_index == consumer_.cached_other_index) {
+        return false;
+      }
+    }
+
+    using std::swap;
+    swap(*output, queue_[read_index]);
+
+    // Hands the swapped in "empty" T back to the producer.
+    rtc::AtomicOps::ReleaseStore(&consumer_.index, NextIndex(read_index));
+    return true;
+  }
+
+ private:
+  // The index owned by one side of the queue, and that side's last seen value
+  // of the other side's index. The leading padding keeps the producer's and
+  // the consumer's indices on separate cache lines.
+  struct PaddedIndex {
+    static const size_t kCacheLineSize = 64;
+    char padding[kCacheLineSize];
+    volatile int index = 0;
+    int cached_other_index = 0;
+  };
+
+  int NextIndex(int index) const {
+    return static_cast<size_t>(index + 1) == queue_.size() ? 0 : index + 1;
+  }
+
+  // Verify that the queue slots complies with the ItemVerifier test.
+  bool VerifyQueueSlots() {
+    for (const auto& v : queue_) {
+      RTC_DCHECK(queue_item_verifier_(v));
+    }
+    return true;
+  }
+
+  QueueItemVerifier queue_item_verifier_;
+
+  // One slot more than the queue size, so that a full queue can be told apart
+  // from an empty one: the queue is empty when the read index equals the write
+  // index, and full when the write index is just behind the read index.
+  // queue_.size() is constant.
+  std::vector<T> queue_;
+
+  PaddedIndex producer_;
+  PaddedIndex consumer_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(SpscSwapQueue);
+};
+
 }  // namespace webrtc
 
 #endif  // WEBRTC_BASE_SWAP_QUEUE_H_
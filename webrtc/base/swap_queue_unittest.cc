@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/platform_thread.h"
 
 namespace webrtc {
 
@@ -39,6 +40,32 @@ class LengthVerifierFunctor {
   size_t length_;
 };
 
+// Inserts kNumItems consecutive values into an SpscSwapQueue, one per call
+// from the thread loop, retrying while the queue is full.
+class SpscProducer {
+ public:
+  static const int kNumItems = 10000;
+
+  explicit SpscProducer(SpscSwapQueue<std::vector<int>>* queue)
+      : queue_(queue), item_(kChunkSize) {}
+
+  static bool Run(void* obj) {
+    return static_cast<SpscProducer*>(obj)->InsertNext();
+  }
+
+ private:
+  bool InsertNext() {
+    item_.assign(kChunkSize, next_value_);
+    if (queue_->Insert(&item_))
+      ++next_value_;
+    return next_value_ < kNumItems;
+  }
+
+  SpscSwapQueue<std::vector<int>>* const queue_;
+  std::vector<int> item_;
+  int next_value_ = 0;
+};
+
 }  // anonymous namespace
 
 TEST(SwapQueueTest, BasicOperation) {
@@ -222,4 +249,116 @@ TEST(SwapQueueTest, OneSlotQueue) {
   EXPECT_FALSE(queue.Remove(&i));
 }
 
+TEST(SpscSwapQueueTest, BasicOperation) {
+  std::vector<int> i(kChunkSize, 0);
+  SpscSwapQueue<std::vector<int>> queue(2, i);
+
+  EXPECT_TRUE(queue.Insert(&i));
+  EXPECT_EQ(i.size(), kChunkSize);
+  EXPECT_TRUE(queue.Insert(&i));
+  EXPECT_EQ(i.size(), kChunkSize);
+  EXPECT_TRUE(queue.Remove(&i));
+  EXPECT_EQ(i.size(), kChunkSize);
+  EXPECT_TRUE(queue.Remove(&i));
+  EXPECT_EQ(i.size(), kChunkSize);
+}
+
+TEST(SpscSwapQueueTest, FullQueue) {
+  SpscSwapQueue<int> queue(2);
+
+  // Fill the queue.
+  int i = 0;
+  EXPECT_TRUE(queue.Insert(&i));
+  i = 1;
+  EXPECT_TRUE(queue.Insert(&i));
+
+  // Ensure that the value is not swapped when doing an Insert
+  // on a full queue.
+  i = 2;
+  EXPECT_FALSE(queue.Insert(&i));
+  EXPECT_EQ(i, 2);
+
+  // Ensure that the Insert didn't overwrite anything in the queue.
+  EXPECT_TRUE(queue.Remove(&i));
+  EXPECT_EQ(i, 0);
+  EXPECT_TRUE(queue.Remove(&i));
+  EXPECT_EQ(i, 1);
+  EXPECT_FALSE(queue.Remove(&i));
+}
+
+TEST(SpscSwapQueueTest, Clear) {
+  SpscSwapQueue<int> queue(2);
+  int i = 0;
+
+  // Fill the queue.
+  EXPECT_TRUE(queue.Insert(&i));
+  EXPECT_TRUE(queue.Insert(&i));
+
+  // Ensure full queue.
+  EXPECT_FALSE(queue.Insert(&i));
+
+  // Empty the queue.
+  queue.Clear();
+
+  // Ensure that the queue is empty
+  EXPECT_FALSE(queue.Remove(&i));
+
+  // Ensure that the queue is no longer full.
+  EXPECT_TRUE(queue.Insert(&i));
+  EXPECT_TRUE(queue.Insert(&i));
+  EXPECT_FALSE(queue.Insert(&i));
+}
+
+TEST(SpscSwapQueueTest, SuccessfulItemVerifyFunctor) {
+  std::vector<int> template_element(kChunkSize);
+  LengthVerifierFunctor verifier(kChunkSize);
+  SpscSwapQueue<std::vector<int>, LengthVerifierFunctor> queue(
+      2, template_element, verifier);
+  std::vector<int> valid_chunk(kChunkSize, 0);
+
+  EXPECT_TRUE(queue.Insert(&valid_chunk));
+  EXPECT_EQ(valid_chunk.size(), kChunkSize);
+  EXPECT_TRUE(queue.Remove(&valid_chunk));
+  EXPECT_EQ(valid_chunk.size(), kChunkSize);
+}
+
+TEST(SpscSwapQueueTest, ZeroSlotQueue) {
+  SpscSwapQueue<int> queue(0);
+  int i = 42;
+  EXPECT_FALSE(queue.Insert(&i));
+  EXPECT_FALSE(queue.Remove(&i));
+  EXPECT_EQ(i, 42);
+}
+
+TEST(SpscSwapQueueTest, OneSlotQueue) {
+  SpscSwapQueue<int> queue(1);
+  int i = 42;
+  EXPECT_TRUE(queue.Insert(&i));
+  i = 43;
+  EXPECT_FALSE(queue.Insert(&i));
+  EXPECT_EQ(i, 43);
+  EXPECT_TRUE(queue.Remove(&i));
+  EXPECT_EQ(i, 42);
+  EXPECT_FALSE(queue.Remove(&i));
+}
+
+// Verifies that items inserted on one thread are removed in order, and
+// unmodified, on another.
+TEST(SpscSwapQueueTest, ConcurrentInsertAndRemove) {
+  SpscSwapQueue<std::vector<int>> queue(4, std::vector<int>(kChunkSize));
+  SpscProducer producer(&queue);
+  rtc::PlatformThread thread(&SpscProducer::Run, &producer, "SpscProducer");
+  thread.Start();
+
+  std::vector<int> item(kChunkSize);
+  for (int i = 0; i < SpscProducer::kNumItems; ++i) {
+    while (!queue.Remove(&item)) {
+    }
+    ASSERT_EQ(std::vector<int>(kChunkSize, i), item);
+  }
+  thread.Stop();
+
+  EXPECT_FALSE(queue.Remove(&item));
+}
+
 }  // namespace webrtc
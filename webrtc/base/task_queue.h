@@ -14,13 +14,18 @@
 #include <list>
 #include <memory>
 
-#if defined(WEBRTC_MAC) && !defined(WEBRTC_BUILD_LIBEVENT)
+#if defined(WEBRTC_MAC) && !defined(WEBRTC_BUILD_LIBEVENT) && \
+    !defined(WEBRTC_BUILD_TASK_QUEUE_POOL)
 #include <dispatch/dispatch.h>
 #endif
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/criticalsection.h"
 
+#if defined(WEBRTC_BUILD_TASK_QUEUE_POOL)
+#include "webrtc/base/scoped_ref_ptr.h"
+#endif
+
 #if defined(WEBRTC_WIN) || defined(WEBRTC_BUILD_LIBEVENT)
 #include "webrtc/base/platform_thread.h"
 #endif
@@ -155,6 +160,15 @@ static std::unique_ptr<QueuedTask> NewClosure(const Closure& closure,
 // TaskQueue itself has been deleted or it may happen synchronously while the
 // TaskQueue instance is being deleted.  This may vary from one OS to the next
 // so assumptions about lifetimes of pending tasks should not be made.
+//
+// A note on threads:
+//
+// By default every TaskQueue runs on a dedicated thread.  When built with
+// WEBRTC_BUILD_TASK_QUEUE_POOL, all TaskQueues in the process instead share a
+// fixed-size pool of worker threads, one per CPU core.  A queue then only
+// occupies a worker while it has tasks to run, and may move between workers
+// from one task to the next, so tasks must not rely on thread identity or
+// thread-local state beyond Current() and IsCurrent().
 class LOCKABLE TaskQueue {
  public:
   explicit TaskQueue(const char* queue_name);
@@ -224,7 +238,15 @@ class LOCKABLE TaskQueue {
   }
 
  private:
-#if defined(WEBRTC_BUILD_LIBEVENT)
+#if defined(WEBRTC_BUILD_TASK_QUEUE_POOL)
+  class Core;
+  class Pool;
+  class PostAndReplyTask;
+
+  // Referenced by the timers and replies that target this queue, so that they
+  // can outlive it.
+  const scoped_refptr<Core> core_;
+#elif defined(WEBRTC_BUILD_LIBEVENT)
   static bool ThreadMain(void* context);
   static void OnWakeup(int socket, short flags, void* context);  // NOLINT
   static void RunTask(int fd, short flags, void* context);       // NOLINT
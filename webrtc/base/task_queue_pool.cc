@@ -0,0 +1,509 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/task_queue.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/refcount.h"
+#include "webrtc/base/task_queue_posix.h"
+#include "webrtc/base/timeutils.h"
+
+namespace rtc {
+using internal::GetQueuePtrTls;
+
+namespace {
+// The number of tasks a queue may run in a row before it yields its worker
+// to other queues.
+const int kMaxTasksPerSlice = 16;
+const size_t kMinWorkers = 2;
+
+size_t NumberOfWorkers() {
+  const long cores = sysconf(_SC_NPROCESSORS_ONLN);  // NOLINT
+  return std::max(kMinWorkers, cores > 0 ? static_cast<size_t>(cores) : 0);
+}
+}  // namespace
+
+// The tasks of one TaskQueue. At most one worker runs the tasks of a queue at
+// any time, which keeps them sequential and in FIFO order.
+class TaskQueue::Core : public RefCountInterface {
+ public:
+  Core(TaskQueue* queue, const char* name, Pool* pool)
+      : queue_(queue),
+        name_(name),
+        pool_(pool),
+        task_done_(false, false),
+        scheduled_(false),
+        running_(false),
+        stopped_(false),
+        worker_index_(0) {}
+
+  TaskQueue* queue() const { return queue_; }
+  const std::string& name() const { return name_; }
+  Pool* pool() const { return pool_; }
+  // The worker running the current task. Only valid on that worker.
+  size_t worker_index() const { return worker_index_; }
+
+  // Drops |task| if the queue has been stopped.
+  void PostTask(std::unique_ptr<QueuedTask> task);
+
+  // Runs the pending tasks, at most kMaxTasksPerSlice of them, on worker
+  // |worker_index|. Returns true if the queue still has tasks and must be
+  // scheduled again.
+  bool RunTasks(size_t worker_index);
+
+  // Stops accepting and running tasks, and returns once no task of the queue
+  // is running. The pending tasks are moved to |pending|.
+  void Stop(std::list<std::unique_ptr<QueuedTask>>* pending);
+
+ protected:
+  ~Core() override {}
+
+ private:
+  TaskQueue* const queue_;
+  const std::string name_;
+  Pool* const pool_;
+  Event task_done_;
+  CriticalSection lock_;
+  std::list<std::unique_ptr<QueuedTask>> pending_ GUARDED_BY(lock_);
+  // True from when the queue is handed to the pool until RunTasks() finds no
+  // more work.
+  bool scheduled_ GUARDED_BY(lock_);
+  bool running_ GUARDED_BY(lock_);
+  bool stopped_ GUARDED_BY(lock_);
+  size_t worker_index_;
+};
+
+// The worker threads shared by all TaskQueues. Each worker has a deque of the
+// queues it's responsible for. A worker serves its own deque in FIFO order
+// and, when that's empty, steals from the back of the other workers' deques
+// before going idle. Delayed tasks are held by a timer thread until they're
+// due.
+class TaskQueue::Pool {
+ public:
+  // Returns the pool, creating it for the first queue.
+  static Pool* Acquire();
+  // Destroys the pool when the last queue releases it.
+  static void Release();
+
+  // Hands |core|, which has tasks to run, to a worker.
+  void Schedule(const scoped_refptr<Core>& core);
+  void PostDelayedTask(const scoped_refptr<Core>& core,
+                       std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds);
+  // Moves the delayed tasks of |core| to |tasks|.
+  void CancelDelayedTasks(const Core* core,
+                          std::vector<std::unique_ptr<QueuedTask>>* tasks);
+
+ private:
+  struct Worker {
+    Worker(Pool* pool, size_t index)
+        : pool(pool),
+          index(index),
+          wakeup(false, false),
+          thread(&Pool::WorkerMain, this, "TaskQueuePool") {}
+
+    Pool* const pool;
+    const size_t index;
+    Event wakeup;
+    CriticalSection lock;
+    std::deque<scoped_refptr<Core>> queues GUARDED_BY(lock);
+    PlatformThread thread;
+  };
+
+  struct DelayedTask {
+    scoped_refptr<Core> core;
+    std::unique_ptr<QueuedTask> task;
+  };
+
+  explicit Pool(size_t num_workers);
+  ~Pool();
+
+  static bool WorkerMain(void* context);
+  static bool TimerMain(void* context);
+
+  void RunWorker(size_t index);
+  bool RunTimer();
+  void PushWork(size_t index, const scoped_refptr<Core>& core);
+  scoped_refptr<Core> TakeWork(size_t index);
+
+  static GlobalLockPod instance_lock_;
+  static Pool* instance_;
+  static int num_users_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  volatile int next_worker_;
+
+  CriticalSection lock_;
+  // The number of queues in the deques. Briefly negative when a worker takes
+  // a queue before it has been counted.
+  int num_ready_ GUARDED_BY(lock_);
+  std::vector<size_t> idle_workers_ GUARDED_BY(lock_);
+  bool quit_ GUARDED_BY(lock_);
+
+  CriticalSection timer_lock_;
+  // Ordered by due time. Tasks due at the same time keep their posting order.
+  std::multimap<int64_t, DelayedTask> delayed_tasks_ GUARDED_BY(timer_lock_);
+  bool timer_quit_ GUARDED_BY(timer_lock_);
+  Event timer_wakeup_;
+  PlatformThread timer_thread_;
+};
+
+class TaskQueue::PostAndReplyTask : public QueuedTask {
+ public:
+  PostAndReplyTask(std::unique_ptr<QueuedTask> task,
+                   std::unique_ptr<QueuedTask> reply,
+                   const scoped_refptr<Core>& reply_core)
+      : task_(std::move(task)),
+        reply_(std::move(reply)),
+        reply_core_(reply_core) {}
+
+ private:
+  bool Run() override {
+    if (!task_->Run())
+      task_.release();
+    // Dropped if the reply queue is gone.
+    reply_core_->PostTask(std::move(reply_));
+    return true;
+  }
+
+  std::unique_ptr<QueuedTask> task_;
+  std::unique_ptr<QueuedTask> reply_;
+  const scoped_refptr<Core> reply_core_;
+};
+
+void TaskQueue::Core::PostTask(std::unique_ptr<QueuedTask> task) {
+  {
+    CritScope lock(&lock_);
+    if (stopped_)
+      return;
+    pending_.push_back(std::move(task));
+    if (scheduled_)
+      return;
+    scheduled_ = true;
+  }
+  pool_->Schedule(scoped_refptr<Core>(this));
+}
+
+bool TaskQueue::Core::RunTasks(size_t worker_index) {
+  for (int i = 0; i < kMaxTasksPerSlice; ++i) {
+    std::unique_ptr<QueuedTask> task;
+    {
+      CritScope lock(&lock_);
+      if (stopped_ || pending_.empty()) {
+        scheduled_ = false;
+        return false;
+      }
+      task = std::move(pending_.front());
+      pending_.pop_front();
+      running_ = true;
+      worker_index_ = worker_index;
+    }
+
+    pthread_setspecific(GetQueuePtrTls(), this);
+    if (!task->Run())
+      task.release();
+    task.reset();
+    pthread_setspecific(GetQueuePtrTls(), nullptr);
+
+    CritScope lock(&lock_);
+    running_ = false;
+    if (stopped_)
+      task_done_.Set();
+  }
+  return true;
+}
+
+void TaskQueue::Core::Stop(std::list<std::unique_ptr<QueuedTask>>* pending) {
+  bool wait_for_task;
+  {
+    CritScope lock(&lock_);
+    stopped_ = true;
+    pending->swap(pending_);
+    wait_for_task = running_;
+  }
+  if (wait_for_task)
+    task_done_.Wait(Event::kForever);
+}
+
+GlobalLockPod TaskQueue::Pool::instance_lock_;
+TaskQueue::Pool* TaskQueue::Pool::instance_ = nullptr;
+int TaskQueue::Pool::num_users_ = 0;
+
+// static
+TaskQueue::Pool* TaskQueue::Pool::Acquire() {
+  GlobalLockScope lock(&instance_lock_);
+  if (!instance_)
+    instance_ = new Pool(NumberOfWorkers());
+  ++num_users_;
+  return instance_;
+}
+
+// static
+void TaskQueue::Pool::Release() {
+  GlobalLockScope lock(&instance_lock_);
+  RTC_DCHECK_GT(num_users_, 0);
+  if (--num_users_ == 0) {
+    delete instance_;
+    instance_ = nullptr;
+  }
+}
+
+TaskQueue::Pool::Pool(size_t num_workers)
+    : next_worker_(0),
+      num_ready_(0),
+      quit_(false),
+      timer_quit_(false),
+      timer_wakeup_(false, false),
+      timer_thread_(&Pool::TimerMain, this, "TaskQueuePoolTimer") {
+  for (size_t i = 0; i < num_workers; ++i)
+    workers_.push_back(std::unique_ptr<Worker>(new Worker(this, i)));
+  for (const auto& worker : workers_)
+    worker->thread.Start();
+  timer_thread_.Start();
+}
+
+TaskQueue::Pool::~Pool() {
+  {
+    CritScope lock(&timer_lock_);
+    RTC_DCHECK(delayed_tasks_.empty());
+    timer_quit_ = true;
+  }
+  timer_wakeup_.Set();
+  timer_thread_.Stop();
+
+  {
+    CritScope lock(&lock_);
+    quit_ = true;
+  }
+  for (const auto& worker : workers_)
+    worker->wakeup.Set();
+  for (const auto& worker : workers_)
+    worker->thread.Stop();
+}
+
+void TaskQueue::Pool::Schedule(const scoped_refptr<Core>& core) {
+  // Queues posted to from a task stay on the current worker, where the
+  // caches are warm, unless an idle worker steals them.
+  Core* current = static_cast<Core*>(pthread_getspecific(GetQueuePtrTls()));
+  size_t index;
+  if (current && current->pool() == this) {
+    index = current->worker_index();
+  } else {
+    index = static_cast<unsigned int>(AtomicOps::Increment(&next_worker_)) %
+            workers_.size();
+  }
+  PushWork(index, core);
+}
+
+void TaskQueue::Pool::PostDelayedTask(const scoped_refptr<Core>& core,
+                                      std::unique_ptr<QueuedTask> task,
+                                      uint32_t milliseconds) {
+  const int64_t due_time = TimeMillis() + milliseconds;
+  DelayedTask delayed = {core, std::move(task)};
+  bool is_next = false;
+  {
+    CritScope lock(&timer_lock_);
+    auto it = delayed_tasks_.insert(std::make_pair(due_time, std::move(delayed)));
+    is_next = it == delayed_tasks_.begin();
+  }
+  if (is_next)
+    timer_wakeup_.Set();
+}
+
+void TaskQueue::Pool::CancelDelayedTasks(
+    const Core* core,
+    std::vector<std::unique_ptr<QueuedTask>>* tasks) {
+  CritScope lock(&timer_lock_);
+  for (auto it = delayed_tasks_.begin(); it != delayed_tasks_.end();) {
+    if (it->second.core.get() == core) {
+      tasks->push_back(std::move(it->second.task));
+      it = delayed_tasks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+// static
+bool TaskQueue::Pool::WorkerMain(void* context) {
+  Worker* worker = static_cast<Worker*>(context);
+  worker->pool->RunWorker(worker->index);
+  return false;
+}
+
+// static
+bool TaskQueue::Pool::TimerMain(void* context) {
+  return static_cast<Pool*>(context)->RunTimer();
+}
+
+void TaskQueue::Pool::RunWorker(size_t index) {
+  Worker* worker = workers_[index].get();
+  while (true) {
+    scoped_refptr<Core> core = TakeWork(index);
+    if (core) {
+      if (core->RunTasks(index))
+        PushWork(index, core);
+      continue;
+    }
+
+    {
+      CritScope lock(&lock_);
+      if (quit_)
+        return;
+      // A queue is being pushed or taken; look again.
+      if (num_ready_ > 0)
+        continue;
+      idle_workers_.push_back(index);
+    }
+    worker->wakeup.Wait(Event::kForever);
+  }
+}
+
+bool TaskQueue::Pool::RunTimer() {
+  std::vector<DelayedTask> due_tasks;
+  int wait_ms = Event::kForever;
+  {
+    CritScope lock(&timer_lock_);
+    if (timer_quit_)
+      return false;
+    const int64_t now = TimeMillis();
+    auto it = delayed_tasks_.begin();
+    for (; it != delayed_tasks_.end() && it->first <= now; ++it)
+      due_tasks.push_back(std::move(it->second));
+    delayed_tasks_.erase(delayed_tasks_.begin(), it);
+    if (!delayed_tasks_.empty())
+      wait_ms = static_cast<int>(delayed_tasks_.begin()->first - now);
+  }
+
+  // Tasks whose queue has been deleted in the meantime are dropped here.
+  for (DelayedTask& delayed : due_tasks)
+    delayed.core->PostTask(std::move(delayed.task));
+  if (due_tasks.empty())
+    timer_wakeup_.Wait(wait_ms);
+  return true;
+}
+
+void TaskQueue::Pool::PushWork(size_t index,
+                               const scoped_refptr<Core>& core) {
+  {
+    Worker* worker = workers_[index].get();
+    CritScope lock(&worker->lock);
+    worker->queues.push_back(core);
+  }
+
+  CritScope lock(&lock_);
+  ++num_ready_;
+  if (idle_workers_.empty())
+    return;
+  // Prefer the worker that was handed the queue, otherwise any idle worker
+  // will steal it.
+  auto it = std::find(idle_workers_.begin(), idle_workers_.end(), index);
+  if (it == idle_workers_.end())
+    it = idle_workers_.end() - 1;
+  workers_[*it]->wakeup.Set();
+  idle_workers_.erase(it);
+}
+
+scoped_refptr<TaskQueue::Core> TaskQueue::Pool::TakeWork(
+    size_t index) {
+  scoped_refptr<Core> core;
+  for (size_t i = 0; i < workers_.size() && !core; ++i) {
+    Worker* worker = workers_[(index + i) % workers_.size()].get();
+    CritScope lock(&worker->lock);
+    if (worker->queues.empty())
+      continue;
+    if (i == 0) {
+      core = worker->queues.front();
+      worker->queues.pop_front();
+    } else {
+      core = worker->queues.back();
+      worker->queues.pop_back();
+    }
+  }
+  if (core) {
+    CritScope lock(&lock_);
+    --num_ready_;
+  }
+  return core;
+}
+
+TaskQueue::TaskQueue(const char* queue_name)
+    : core_(new RefCountedObject<Core>(this, queue_name, Pool::Acquire())) {
+  RTC_DCHECK(queue_name);
+}
+
+TaskQueue::~TaskQueue() {
+  RTC_DCHECK(!IsCurrent());
+  std::list<std::unique_ptr<QueuedTask>> pending;
+  core_->Stop(&pending);
+  std::vector<std::unique_ptr<QueuedTask>> delayed;
+  core_->pool()->CancelDelayedTasks(core_.get(), &delayed);
+  // The tasks may post to other queues when deleted, so delete them while the
+  // pool is still around.
+  pending.clear();
+  delayed.clear();
+  Pool::Release();
+}
+
+// static
+TaskQueue* TaskQueue::Current() {
+  Core* core = static_cast<Core*>(pthread_getspecific(GetQueuePtrTls()));
+  return core ? core->queue() : nullptr;
+}
+
+// static
+bool TaskQueue::IsCurrent(const char* queue_name) {
+  TaskQueue* current = Current();
+  return current && current->core_->name().compare(queue_name) == 0;
+}
+
+bool TaskQueue::IsCurrent() const {
+  return Current() == this;
+}
+
+void TaskQueue::PostTask(std::unique_ptr<QueuedTask> task) {
+  RTC_DCHECK(task.get());
+  core_->PostTask(std::move(task));
+}
+
+void TaskQueue::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                uint32_t milliseconds) {
+  if (milliseconds == 0) {
+    PostTask(std::move(task));
+    return;
+  }
+  core_->pool()->PostDelayedTask(core_, std::move(task), milliseconds);
+}
+
+void TaskQueue::PostTaskAndReply(std::unique_ptr<QueuedTask> task,
+                                 std::unique_ptr<QueuedTask> reply,
+                                 TaskQueue* reply_queue) {
+  RTC_DCHECK(reply_queue);
+  PostTask(std::unique_ptr<QueuedTask>(new PostAndReplyTask(
+      std::move(task), std::move(reply), reply_queue->core_)));
+}
+
+void TaskQueue::PostTaskAndReply(std::unique_ptr<QueuedTask> task,
+                                 std::unique_ptr<QueuedTask> reply) {
+  return PostTaskAndReply(std::move(task), std::move(reply), Current());
+}
+
+}  // namespace rtc
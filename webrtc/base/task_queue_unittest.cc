@@ -9,11 +9,13 @@
  */
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "webrtc/base/bind.h"
 #include "webrtc/base/event.h"
 #include "webrtc/base/gunit.h"
+#include "webrtc/base/stringencode.h"
 #include "webrtc/base/task_queue.h"
 #include "webrtc/base/timeutils.h"
 
@@ -258,4 +260,50 @@ TEST(TaskQueueTest, PostALot) {
             << ", tasks cleaned up: " << tasks_cleaned_up;
 }
 
+// Posts to many queues at once, which must each still run their tasks one at
+// a time, in order, and with the right current queue.
+TEST(TaskQueueTest, PostToManyQueues) {
+  static const size_t kNumQueues = 100;
+  static const int kTasksPerQueue = 100;
+
+  struct QueueState {
+    explicit QueueState(const std::string& name)
+        : name(name), queue(this->name.c_str()), done(false, false) {}
+    const std::string name;
+    TaskQueue queue;
+    std::vector<int> order;
+    bool running = false;
+    Event done;
+  };
+
+  std::vector<std::unique_ptr<QueueState>> states;
+  for (size_t i = 0; i < kNumQueues; ++i) {
+    states.push_back(std::unique_ptr<QueueState>(
+        new QueueState("PostToManyQueues" + ToString(i))));
+  }
+
+  for (int i = 0; i < kTasksPerQueue; ++i) {
+    for (const auto& state : states) {
+      QueueState* s = state.get();
+      s->queue.PostTask([s, i]() {
+        EXPECT_TRUE(s->queue.IsCurrent());
+        EXPECT_TRUE(TaskQueue::IsCurrent(s->name.c_str()));
+        EXPECT_FALSE(s->running);
+        s->running = true;
+        s->order.push_back(i);
+        s->running = false;
+        if (i == kTasksPerQueue - 1)
+          s->done.Set();
+      });
+    }
+  }
+
+  for (const auto& state : states) {
+    ASSERT_TRUE(state->done.Wait(10000));
+    ASSERT_EQ(static_cast<size_t>(kTasksPerQueue), state->order.size());
+    for (int i = 0; i < kTasksPerQueue; ++i)
+      EXPECT_EQ(i, state->order[i]);
+  }
+}
+
 }  // namespace rtc
@@ -31,6 +31,24 @@ static const int64_t kNumNanosecsPerMicrosec =
 
 // TODO(honghaiz): Define a type for the time value specifically.
 
+// A source of time for TimeNanos() and the functions built on it. Tests can
+// set one with SetClockForTesting() to run code that reads the time, e.g.
+// webrtc::Clock::GetRealTimeClock(), against simulated time.
+class ClockInterface {
+ public:
+  virtual ~ClockInterface() {}
+  virtual uint64_t TimeNanos() const = 0;
+};
+
+// Makes the time functions below read from |clock|, or from the system clock
+// again if |clock| is null. Returns the previously set clock. Not thread safe;
+// set the clock before starting threads that read the time.
+ClockInterface* SetClockForTesting(ClockInterface* clock);
+
+// Returns the system's monotonic time in nanoseconds, even if a clock has been
+// set for testing.
+uint64_t SystemTimeNanos();
+
 // Returns the current time in milliseconds in 32 bits.
 uint32_t Time32();
 
@@ -9,6 +9,7 @@
  */
 
 #include "webrtc/base/common.h"
+#include "webrtc/base/fakeclock.h"
 #include "webrtc/base/gunit.h"
 #include "webrtc/base/helpers.h"
 #include "webrtc/base/thread.h"
@@ -57,6 +58,31 @@ TEST(TimeTest, TestTimeDiff64) {
   EXPECT_EQ(-ts_diff, rtc::TimeDiff(ts_earlier, ts_later));
 }
 
+TEST(TimeTest, FakeClockReplacesSystemTime) {
+  const uint64_t system_nanos = SystemTimeNanos();
+  {
+    ScopedFakeClock clock;
+    EXPECT_EQ(0u, TimeNanos());
+    clock.AdvanceTimeMicros(3600 * kNumMicrosecsPerSec);
+    EXPECT_EQ(3600 * kNumMillisecsPerSec, TimeMillis());
+    EXPECT_EQ(static_cast<uint64_t>(3600 * kNumMicrosecsPerSec), TimeMicros());
+    clock.SetTimeNanos(3601 * kNumNanosecsPerSec);
+    EXPECT_EQ(3601u, Time32() / kNumMillisecsPerSec);
+  }
+  // The system clock is back.
+  EXPECT_GE(TimeNanos(), system_nanos);
+}
+
+TEST(TimeTest, NestedFakeClocksRestoreEachOther) {
+  ScopedFakeClock outer;
+  outer.AdvanceTimeMicros(1000);
+  {
+    ScopedFakeClock inner;
+    EXPECT_EQ(0, TimeMillis());
+  }
+  EXPECT_EQ(1, TimeMillis());
+}
+
 class TimestampWrapAroundHandlerTest : public testing::Test {
  public:
   TimestampWrapAroundHandlerTest() {}
@@ -88,6 +88,14 @@ class Call {
     // Audio Processing Module to be used in this call.
     // TODO(solenberg): Change this to a shared_ptr once we can use C++11.
     AudioProcessing* audio_processing = nullptr;
+
+    // If positive, the video receive streams decode on a pool of this many
+    // threads shared by the call, instead of on a thread per stream.
+    int num_decode_threads = 0;
+
+    // The RTP/RTCP modules and other periodic work of the call are processed
+    // on this many threads. Each module stays on one of them.
+    int num_module_process_threads = 1;
   };
 
   struct Stats {
@@ -26,6 +26,9 @@ const int kDefaultBitrateBps = 300000;
 
 BitrateAllocator::BitrateAllocator()
     : bitrate_observer_configs_(),
+      sum_min_bitrates_bps_(0),
+      allocation_valid_(false),
+      allocated_for_bitrate_bps_(0),
       enforce_min_bitrate_(true),
       last_bitrate_bps_(kDefaultBitrateBps),
       last_non_zero_bitrate_bps_(kDefaultBitrateBps),
@@ -43,10 +46,11 @@ uint32_t BitrateAllocator::OnNetworkChanged(uint32_t bitrate,
   last_rtt_ = rtt;
 
   uint32_t allocated_bitrate_bps = 0;
-  ObserverAllocation allocation = AllocateBitrates(bitrate);
-  for (const auto& kv : allocation) {
-    kv.first->OnBitrateUpdated(kv.second, last_fraction_loss_, last_rtt_);
-    allocated_bitrate_bps += kv.second;
+  AllocateBitrates(bitrate);
+  for (const auto& config : bitrate_observer_configs_) {
+    config.observer->OnBitrateUpdated(config.allocated_bitrate_bps,
+                                      last_fraction_loss_, last_rtt_);
+    allocated_bitrate_bps += config.allocated_bitrate_bps;
   }
   return allocated_bitrate_bps;
 }
@@ -75,24 +79,26 @@ int BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
     bitrate_observer_configs_.push_back(ObserverConfig(
         observer, min_bitrate_bps, max_bitrate_bps, enforce_min_bitrate));
   }
+  OnObserversChanged();
 
   int new_observer_bitrate_bps = 0;
   if (last_bitrate_bps_ > 0) {  // We have a bitrate to allocate.
-    ObserverAllocation allocation = AllocateBitrates(last_bitrate_bps_);
-    for (auto& kv : allocation) {
+    AllocateBitrates(last_bitrate_bps_);
+    for (const auto& config : bitrate_observer_configs_) {
       // Update all observers with the new allocation.
-      kv.first->OnBitrateUpdated(kv.second, last_fraction_loss_, last_rtt_);
-      if (kv.first == observer)
-        new_observer_bitrate_bps = kv.second;
+      config.observer->OnBitrateUpdated(config.allocated_bitrate_bps,
+                                        last_fraction_loss_, last_rtt_);
+      if (config.observer == observer)
+        new_observer_bitrate_bps = config.allocated_bitrate_bps;
     }
   } else {
     // Currently, an encoder is not allowed to produce frames.
     // But we still have to return the initial config bitrate + let the
     // observer know that it can not produce frames.
-    ObserverAllocation allocation =
-        AllocateBitrates(last_non_zero_bitrate_bps_);
+    AllocateBitrates(last_non_zero_bitrate_bps_);
     observer->OnBitrateUpdated(0, last_fraction_loss_, last_rtt_);
-    new_observer_bitrate_bps = allocation[observer];
+    new_observer_bitrate_bps =
+        FindObserverConfig(observer)->allocated_bitrate_bps;
   }
   return new_observer_bitrate_bps;
 }
@@ -102,14 +108,17 @@ void BitrateAllocator::RemoveObserver(BitrateAllocatorObserver* observer) {
   auto it = FindObserverConfig(observer);
   if (it != bitrate_observer_configs_.end()) {
     bitrate_observer_configs_.erase(it);
+    OnObserversChanged();
   }
 }
 
 void BitrateAllocator::EnforceMinBitrate(bool enforce_min_bitrate) {
+  if (enforce_min_bitrate_ != enforce_min_bitrate)
+    allocation_valid_ = false;
   enforce_min_bitrate_ = enforce_min_bitrate;
 }
 
-BitrateAllocator::ObserverConfigList::iterator
+BitrateAllocator::ObserverConfigs::iterator
 BitrateAllocator::FindObserverConfig(
     const BitrateAllocatorObserver* observer) {
   for (auto it = bitrate_observer_configs_.begin();
@@ -120,88 +129,88 @@ BitrateAllocator::FindObserverConfig(
   return bitrate_observer_configs_.end();
 }
 
-BitrateAllocator::ObserverAllocation BitrateAllocator::AllocateBitrates(
-    uint32_t bitrate) {
-  if (bitrate_observer_configs_.empty())
-    return ObserverAllocation();
+void BitrateAllocator::OnObserversChanged() {
+  sum_min_bitrates_bps_ = 0;
+  observers_by_max_bitrate_.clear();
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    sum_min_bitrates_bps_ += bitrate_observer_configs_[i].min_bitrate_bps;
+    observers_by_max_bitrate_.push_back(i);
+  }
+  const ObserverConfigs& configs = bitrate_observer_configs_;
+  std::stable_sort(observers_by_max_bitrate_.begin(),
+                   observers_by_max_bitrate_.end(),
+                   [&configs](size_t a, size_t b) {
+                     return configs[a].max_bitrate_bps <
+                            configs[b].max_bitrate_bps;
+                   });
+  allocation_valid_ = false;
+}
 
-  if (bitrate == 0)
-    return ZeroRateAllocation();
+void BitrateAllocator::AllocateBitrates(uint32_t bitrate) {
+  if (allocation_valid_ && allocated_for_bitrate_bps_ == bitrate)
+    return;
+  allocation_valid_ = true;
+  allocated_for_bitrate_bps_ = bitrate;
 
-  uint32_t sum_min_bitrates = 0;
-  for (const auto& observer_config : bitrate_observer_configs_)
-    sum_min_bitrates += observer_config.min_bitrate_bps;
-  if (bitrate <= sum_min_bitrates)
-    return LowRateAllocation(bitrate);
+  if (bitrate_observer_configs_.empty())
+    return;
 
-  return NormalRateAllocation(bitrate, sum_min_bitrates);
+  if (bitrate == 0) {
+    ZeroRateAllocation();
+  } else if (bitrate <= sum_min_bitrates_bps_) {
+    LowRateAllocation(bitrate);
+  } else {
+    NormalRateAllocation(bitrate);
+  }
 }
 
-BitrateAllocator::ObserverAllocation BitrateAllocator::NormalRateAllocation(
-    uint32_t bitrate,
-    uint32_t sum_min_bitrates) {
+void BitrateAllocator::NormalRateAllocation(uint32_t bitrate) {
   uint32_t num_remaining_observers =
-      static_cast<uint32_t>(bitrate_observer_configs_.size());
+      static_cast<uint32_t>(observers_by_max_bitrate_.size());
   RTC_DCHECK_GT(num_remaining_observers, 0u);
 
   uint32_t bitrate_per_observer =
-      (bitrate - sum_min_bitrates) / num_remaining_observers;
-  // Use map to sort list based on max bitrate.
-  ObserverSortingMap list_max_bitrates;
-  for (const auto& config : bitrate_observer_configs_) {
-    list_max_bitrates.insert(std::pair<uint32_t, const ObserverConfig*>(
-        config.max_bitrate_bps, &config));
-  }
-
-  ObserverAllocation allocation;
-  ObserverSortingMap::iterator max_it = list_max_bitrates.begin();
-  while (max_it != list_max_bitrates.end()) {
+      (bitrate - sum_min_bitrates_bps_) / num_remaining_observers;
+  // Visit the observers in order of increasing max bitrate, so that bitrate
+  // which an observer with a low max can't use is shared by the rest.
+  for (size_t index : observers_by_max_bitrate_) {
+    ObserverConfig& config = bitrate_observer_configs_[index];
     num_remaining_observers--;
-    uint32_t observer_allowance =
-        max_it->second->min_bitrate_bps + bitrate_per_observer;
-    if (max_it->first < observer_allowance) {
+    uint32_t observer_allowance = config.min_bitrate_bps + bitrate_per_observer;
+    if (config.max_bitrate_bps < observer_allowance) {
       // We have more than enough for this observer.
       // Carry the remainder forward.
-      uint32_t remainder = observer_allowance - max_it->first;
+      uint32_t remainder = observer_allowance - config.max_bitrate_bps;
       if (num_remaining_observers != 0)
         bitrate_per_observer += remainder / num_remaining_observers;
-      allocation[max_it->second->observer] = max_it->first;
+      config.allocated_bitrate_bps = config.max_bitrate_bps;
     } else {
-      allocation[max_it->second->observer] = observer_allowance;
+      config.allocated_bitrate_bps = observer_allowance;
     }
-    list_max_bitrates.erase(max_it);
-    // Prepare next iteration.
-    max_it = list_max_bitrates.begin();
   }
-  return allocation;
 }
 
-BitrateAllocator::ObserverAllocation BitrateAllocator::ZeroRateAllocation() {
-  ObserverAllocation allocation;
+void BitrateAllocator::ZeroRateAllocation() {
   // Zero bitrate to all observers.
-  for (const auto& observer_config : bitrate_observer_configs_)
-    allocation[observer_config.observer] = 0;
-  return allocation;
+  for (auto& observer_config : bitrate_observer_configs_)
+    observer_config.allocated_bitrate_bps = 0;
 }
 
-BitrateAllocator::ObserverAllocation BitrateAllocator::LowRateAllocation(
-    uint32_t bitrate) {
-  ObserverAllocation allocation;
+void BitrateAllocator::LowRateAllocation(uint32_t bitrate) {
   if (enforce_min_bitrate_) {
     // Min bitrate to all observers.
-    for (const auto& observer_config : bitrate_observer_configs_)
-      allocation[observer_config.observer] = observer_config.min_bitrate_bps;
+    for (auto& observer_config : bitrate_observer_configs_)
+      observer_config.allocated_bitrate_bps = observer_config.min_bitrate_bps;
   } else {
     // Allocate up to |min_bitrate_bps| to one observer at a time, until
     // |bitrate| is depleted.
     uint32_t remainder = bitrate;
-    for (const auto& observer_config : bitrate_observer_configs_) {
+    for (auto& observer_config : bitrate_observer_configs_) {
       uint32_t allocated_bitrate =
           std::min(remainder, observer_config.min_bitrate_bps);
-      allocation[observer_config.observer] = allocated_bitrate;
+      observer_config.allocated_bitrate_bps = allocated_bitrate;
       remainder -= allocated_bitrate;
     }
   }
-  return allocation;
 }
 }  // namespace webrtc
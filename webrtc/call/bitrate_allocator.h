@@ -13,9 +13,7 @@
 
 #include <stdint.h>
 
-#include <list>
-#include <map>
-#include <utility>
+#include <vector>
 
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_annotations.h"
@@ -77,11 +75,14 @@ class BitrateAllocator {
         : observer(observer),
           min_bitrate_bps(min_bitrate_bps),
           max_bitrate_bps(max_bitrate_bps),
-          enforce_min_bitrate(enforce_min_bitrate) {}
-    BitrateAllocatorObserver* const observer;
+          enforce_min_bitrate(enforce_min_bitrate),
+          allocated_bitrate_bps(0) {}
+    BitrateAllocatorObserver* observer;
     uint32_t min_bitrate_bps;
     uint32_t max_bitrate_bps;
     bool enforce_min_bitrate;
+    // Result of the latest allocation.
+    uint32_t allocated_bitrate_bps;
   };
 
   // This method controls the behavior when the available bitrate is lower than
@@ -92,27 +93,36 @@ class BitrateAllocator {
   void EnforceMinBitrate(bool enforce_min_bitrate)
       EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
-  typedef std::list<ObserverConfig> ObserverConfigList;
-  ObserverConfigList::iterator FindObserverConfig(
+  typedef std::vector<ObserverConfig> ObserverConfigs;
+  ObserverConfigs::iterator FindObserverConfig(
       const BitrateAllocatorObserver* observer)
       EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
-  typedef std::multimap<uint32_t, const ObserverConfig*> ObserverSortingMap;
-  typedef std::map<BitrateAllocatorObserver*, int> ObserverAllocation;
+  // Recomputes the state derived from the observer configurations, and
+  // invalidates the current allocation. Must be called whenever an observer
+  // is added, removed or reconfigured.
+  void OnObserversChanged() EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
-  ObserverAllocation AllocateBitrates(uint32_t bitrate)
-      EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
-  ObserverAllocation NormalRateAllocation(uint32_t bitrate,
-                                          uint32_t sum_min_bitrates)
-      EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
-
-  ObserverAllocation ZeroRateAllocation() EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
-  ObserverAllocation LowRateAllocation(uint32_t bitrate)
+  // Sets |allocated_bitrate_bps| of every observer config for |bitrate|.
+  // Does nothing if neither |bitrate| nor the observers have changed since
+  // the last call.
+  void AllocateBitrates(uint32_t bitrate) EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+  void NormalRateAllocation(uint32_t bitrate)
       EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+  void ZeroRateAllocation() EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+  void LowRateAllocation(uint32_t bitrate) EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
   rtc::CriticalSection crit_sect_;
-  // Stored in a list to keep track of the insertion order.
-  ObserverConfigList bitrate_observer_configs_ GUARDED_BY(crit_sect_);
+  // Stored in insertion order.
+  ObserverConfigs bitrate_observer_configs_ GUARDED_BY(crit_sect_);
+  // Indices into |bitrate_observer_configs_|, sorted by max bitrate with ties
+  // in insertion order.
+  std::vector<size_t> observers_by_max_bitrate_ GUARDED_BY(crit_sect_);
+  uint32_t sum_min_bitrates_bps_ GUARDED_BY(crit_sect_);
+  // True if |allocated_bitrate_bps| of the observer configs holds the
+  // allocation of |allocated_for_bitrate_bps_|.
+  bool allocation_valid_ GUARDED_BY(crit_sect_);
+  uint32_t allocated_for_bitrate_bps_ GUARDED_BY(crit_sect_);
   bool enforce_min_bitrate_ GUARDED_BY(crit_sect_);
   uint32_t last_bitrate_bps_ GUARDED_BY(crit_sect_);
   uint32_t last_non_zero_bitrate_bps_ GUARDED_BY(crit_sect_);
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/call/bitrate_allocator.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+const int kNumObservers = 128;
+const int kNumUpdates = 20000;
+
+class NullObserver : public BitrateAllocatorObserver {
+ public:
+  void OnBitrateUpdated(uint32_t bitrate_bps,
+                        uint8_t fraction_loss,
+                        int64_t rtt) override {}
+};
+
+// Returns the average time in nanoseconds spent in OnNetworkChanged() with
+// kNumObservers observers of differing max bitrates. If |vary_bitrate| is
+// false, the same estimate is reported every time, as when the bandwidth
+// estimate is stable and only loss and rtt are updated.
+size_t MeasureNsPerUpdate(bool vary_bitrate) {
+  BitrateAllocator allocator;
+  std::vector<NullObserver> observers(kNumObservers);
+  for (int i = 0; i < kNumObservers; ++i) {
+    allocator.AddObserver(&observers[i], 30000, 100000 + 10000 * (i % 50),
+                          true);
+  }
+  uint64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumUpdates; ++i) {
+    uint32_t bitrate_bps = 20000000;
+    if (vary_bitrate)
+      bitrate_bps += 1000 * (i % 100);
+    allocator.OnNetworkChanged(bitrate_bps, 0, 50);
+  }
+  uint64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  return static_cast<size_t>(elapsed_ns / kNumUpdates);
+}
+}  // namespace
+
+TEST(BitrateAllocatorPerformanceTest, OnNetworkChanged) {
+  test::PrintResult("bitrate_allocator_on_network_changed", "",
+                    "varying_bitrate", MeasureNsPerUpdate(true), "ns", true);
+  test::PrintResult("bitrate_allocator_on_network_changed", "",
+                    "constant_bitrate", MeasureNsPerUpdate(false), "ns", true);
+}
+
+}  // namespace webrtc
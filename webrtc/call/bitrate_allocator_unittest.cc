@@ -250,4 +250,33 @@ TEST_F(BitrateAllocatorTest, AddObserverWhileNetworkDown) {
   EXPECT_EQ(750000u, bitrate_observer_2.last_bitrate_);
 }
 
+TEST_F(BitrateAllocatorTest, ReallocatesAfterObserverChanges) {
+  TestBitrateObserver bitrate_observer_1;
+  TestBitrateObserver bitrate_observer_2;
+  allocator_->AddObserver(&bitrate_observer_1, 100000, 400000, true);
+  allocator_->AddObserver(&bitrate_observer_2, 100000, 400000, true);
+
+  allocator_->OnNetworkChanged(600000, 0, 50);
+  EXPECT_EQ(300000u, bitrate_observer_1.last_bitrate_);
+  EXPECT_EQ(300000u, bitrate_observer_2.last_bitrate_);
+
+  // An unchanged bitrate still notifies all observers.
+  bitrate_observer_1.last_bitrate_ = 0;
+  bitrate_observer_2.last_bitrate_ = 0;
+  EXPECT_EQ(600000u, allocator_->OnNetworkChanged(600000, 0, 60));
+  EXPECT_EQ(300000u, bitrate_observer_1.last_bitrate_);
+  EXPECT_EQ(300000u, bitrate_observer_2.last_bitrate_);
+  EXPECT_EQ(60, bitrate_observer_1.last_rtt_);
+
+  // The same bitrate is reallocated once an observer has been removed.
+  allocator_->RemoveObserver(&bitrate_observer_2);
+  EXPECT_EQ(600000u, allocator_->OnNetworkChanged(600000, 0, 50));
+  EXPECT_EQ(600000u, bitrate_observer_1.last_bitrate_);
+
+  // Or reconfigured.
+  allocator_->AddObserver(&bitrate_observer_1, 100000, 200000, true);
+  EXPECT_EQ(400000u, allocator_->OnNetworkChanged(600000, 0, 50));
+  EXPECT_EQ(400000u, bitrate_observer_1.last_bitrate_);
+}
+
 }  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -40,6 +41,8 @@
 #include "webrtc/system_wrappers/include/rw_lock_wrapper.h"
 #include "webrtc/system_wrappers/include/trace.h"
 #include "webrtc/video/call_stats.h"
+#include "webrtc/video/decode_thread_pool.h"
+#include "webrtc/video/encoded_frame_recorder.h"
 #include "webrtc/video/send_delay_stats.h"
 #include "webrtc/video/video_receive_stream.h"
 #include "webrtc/video/video_send_stream.h"
@@ -50,6 +53,12 @@ namespace webrtc {
 
 const int Call::Config::kDefaultStartBitrateBps = 300000;
 
+namespace {
+// Frames waiting to be written by the EncodedFrameRecorder, for all recording
+// streams together, before frames are dropped.
+const size_t kMaxQueuedRecordingBytes = 32 * 1024 * 1024;
+}  // namespace
+
 namespace internal {
 
 class Call : public webrtc::Call,
@@ -131,6 +140,10 @@ class Call : public webrtc::Call,
   const std::unique_ptr<ProcessThread> pacer_thread_;
   const std::unique_ptr<CallStats> call_stats_;
   const std::unique_ptr<BitrateAllocator> bitrate_allocator_;
+  // Set if the video receive streams share decode threads.
+  const std::unique_ptr<DecodeThreadPool> decode_thread_pool_;
+  // Created for the first video receive stream that records.
+  std::unique_ptr<EncodedFrameRecorder> frame_recorder_;
   Call::Config config_;
   rtc::ThreadChecker configuration_thread_checker_;
 
@@ -158,14 +171,18 @@ class Call : public webrtc::Call,
 
   RtcEventLog* event_log_ = nullptr;
 
+  // Packets may be delivered on both the network and the worker thread, see
+  // cricket::MediaConfig::deliver_packets_on_network_thread.
+  rtc::CriticalSection received_stats_crit_;
+  int64_t received_video_bytes_ GUARDED_BY(&received_stats_crit_);
+  int64_t received_audio_bytes_ GUARDED_BY(&received_stats_crit_);
+  int64_t received_rtcp_bytes_ GUARDED_BY(&received_stats_crit_);
+  int64_t first_rtp_packet_received_ms_ GUARDED_BY(&received_stats_crit_);
+  int64_t last_rtp_packet_received_ms_ GUARDED_BY(&received_stats_crit_);
+
   // The following members are only accessed (exclusively) from one thread and
   // from the destructor, and therefore doesn't need any explicit
   // synchronization.
-  int64_t received_video_bytes_;
-  int64_t received_audio_bytes_;
-  int64_t received_rtcp_bytes_;
-  int64_t first_rtp_packet_received_ms_;
-  int64_t last_rtp_packet_received_ms_;
   int64_t first_packet_sent_ms_;
 
   // TODO(holmer): Remove this lock once BitrateController no longer calls
@@ -194,10 +211,17 @@ namespace internal {
 Call::Call(const Call::Config& config)
     : clock_(Clock::GetRealTimeClock()),
       num_cpu_cores_(CpuInfo::DetectNumberOfCores()),
-      module_process_thread_(ProcessThread::Create("ModuleProcessThread")),
+      module_process_thread_(ProcessThread::Create(
+          "ModuleProcessThread",
+          static_cast<size_t>(
+              std::max(config.num_module_process_threads, 1)))),
       pacer_thread_(ProcessThread::Create("PacerThread")),
       call_stats_(new CallStats(clock_)),
       bitrate_allocator_(new BitrateAllocator()),
+      decode_thread_pool_(config.num_decode_threads > 0
+                              ? new DecodeThreadPool(
+                                    static_cast<size_t>(config.num_decode_threads))
+                              : nullptr),
       config_(config),
       audio_network_state_(kNetworkUp),
       video_network_state_(kNetworkUp),
@@ -290,6 +314,7 @@ void Call::UpdateSendHistograms() {
 }
 
 void Call::UpdateReceiveHistograms() {
+  rtc::CritScope lock(&received_stats_crit_);
   if (first_rtp_packet_received_ms_ == -1)
     return;
   int64_t elapsed_sec =
@@ -421,6 +446,12 @@ webrtc::VideoSendStream* Call::CreateVideoSendStream(
       RTC_DCHECK(video_send_ssrcs_.find(ssrc) == video_send_ssrcs_.end());
       video_send_ssrcs_[ssrc] = send_stream;
     }
+    for (const auto& fan_out : config.fan_out) {
+      for (uint32_t ssrc : fan_out.ssrcs) {
+        RTC_DCHECK(video_send_ssrcs_.find(ssrc) == video_send_ssrcs_.end());
+        video_send_ssrcs_[ssrc] = send_stream;
+      }
+    }
     video_send_streams_.insert(send_stream);
   }
   send_stream->SignalNetworkState(video_network_state_);
@@ -469,9 +500,12 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
     const webrtc::VideoReceiveStream::Config& config) {
   TRACE_EVENT0("webrtc", "Call::CreateVideoReceiveStream");
   RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
+  if (!config.recording_file_name.empty() && !frame_recorder_)
+    frame_recorder_.reset(new EncodedFrameRecorder(kMaxQueuedRecordingBytes));
   VideoReceiveStream* receive_stream = new VideoReceiveStream(
       num_cpu_cores_, congestion_controller_.get(), config, voice_engine(),
-      module_process_thread_.get(), call_stats_.get(), &remb_);
+      module_process_thread_.get(), call_stats_.get(), &remb_,
+      decode_thread_pool_.get(), frame_recorder_.get());
   {
     WriteLockScoped write_lock(*receive_crit_);
     RTC_DCHECK(video_receive_ssrcs_.find(config.rtp.remote_ssrc) ==
@@ -759,7 +793,10 @@ PacketReceiver::DeliveryStatus Call::DeliverRtcp(MediaType media_type,
   // TODO(pbos): Make sure it's a valid packet.
   //             Return DELIVERY_UNKNOWN_SSRC if it can be determined that
   //             there's no receiver of the packet.
-  received_rtcp_bytes_ += length;
+  {
+    rtc::CritScope lock(&received_stats_crit_);
+    received_rtcp_bytes_ += length;
+  }
   bool rtcp_delivered = false;
   if (media_type == MediaType::ANY || media_type == MediaType::VIDEO) {
     ReadLockScoped read_lock(*receive_crit_);
@@ -805,17 +842,28 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
   if (length < 12)
     return DELIVERY_PACKET_ERROR;
 
-  last_rtp_packet_received_ms_ = clock_->TimeInMilliseconds();
-  if (first_rtp_packet_received_ms_ == -1)
-    first_rtp_packet_received_ms_ = last_rtp_packet_received_ms_;
+  // Read the clock once per packet, here or in the socket, and pass the
+  // arrival time down to the receive streams instead of them reading it again.
+  PacketTime arrival_time = packet_time;
+  if (arrival_time.timestamp == -1)
+    arrival_time.timestamp = clock_->TimeInMicroseconds();
+  {
+    rtc::CritScope lock(&received_stats_crit_);
+    last_rtp_packet_received_ms_ = (arrival_time.timestamp + 500) / 1000;
+    if (first_rtp_packet_received_ms_ == -1)
+      first_rtp_packet_received_ms_ = last_rtp_packet_received_ms_;
+  }
 
   uint32_t ssrc = ByteReader<uint32_t>::ReadBigEndian(&packet[8]);
   ReadLockScoped read_lock(*receive_crit_);
   if (media_type == MediaType::ANY || media_type == MediaType::AUDIO) {
     auto it = audio_receive_ssrcs_.find(ssrc);
     if (it != audio_receive_ssrcs_.end()) {
-      received_audio_bytes_ += length;
-      auto status = it->second->DeliverRtp(packet, length, packet_time)
+      {
+        rtc::CritScope lock(&received_stats_crit_);
+        received_audio_bytes_ += length;
+      }
+      auto status = it->second->DeliverRtp(packet, length, arrival_time)
                         ? DELIVERY_OK
                         : DELIVERY_PACKET_ERROR;
       if (status == DELIVERY_OK && event_log_)
@@ -826,8 +874,11 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
   if (media_type == MediaType::ANY || media_type == MediaType::VIDEO) {
     auto it = video_receive_ssrcs_.find(ssrc);
     if (it != video_receive_ssrcs_.end()) {
-      received_video_bytes_ += length;
-      auto status = it->second->DeliverRtp(packet, length, packet_time)
+      {
+        rtc::CritScope lock(&received_stats_crit_);
+        received_video_bytes_ += length;
+      }
+      auto status = it->second->DeliverRtp(packet, length, arrival_time)
                         ? DELIVERY_OK
                         : DELIVERY_PACKET_ERROR;
       if (status == DELIVERY_OK && event_log_)
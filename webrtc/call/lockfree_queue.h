@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+#ifndef WEBRTC_CALL_LOCKFREE_QUEUE_H_
+#define WEBRTC_CALL_LOCKFREE_QUEUE_H_
+
+#include <memory>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/constructormagic.h"
+
+namespace webrtc {
+
+// A fixed size FIFO queue which any number of threads can insert into
+// without taking a lock, and which a single thread removes from. Elements
+// are copied into preallocated slots, so inserting never allocates memory,
+// and an insert into a full queue fails instead of blocking or overwriting.
+//
+// Each slot carries a sequence number which tells the producers and the
+// consumer whose turn it is to use the slot, so the only contended write is
+// the compare-and-swap that claims the next insert position.
+template <typename T>
+class LockFreeQueue {
+ public:
+  // Creates a queue with space for |capacity| elements, which must be a
+  // power of two.
+  explicit LockFreeQueue(size_t capacity)
+      : slots_(new Slot[capacity]),
+        mask_(capacity - 1),
+        insert_pos_(0),
+        remove_pos_(0) {
+    RTC_DCHECK(capacity > 0);
+    RTC_DCHECK_EQ(0u, capacity & (capacity - 1));
+    RTC_DCHECK_LE(capacity, 1u << 30);
+    for (size_t i = 0; i < capacity; ++i) {
+      slots_[i].sequence = static_cast<int>(i);
+    }
+  }
+
+  // Copies |elem| to the back of the queue. Returns false, dropping the
+  // element, if the queue is full. May be called on any thread.
+  bool Insert(const T& elem) {
+    int pos = rtc::AtomicOps::AcquireLoad(&insert_pos_);
+    while (true) {
+      Slot* slot = &slots_[static_cast<unsigned>(pos) & mask_];
+      int diff =
+          Distance(pos, rtc::AtomicOps::AcquireLoad(&slot->sequence));
+      if (diff == 0) {
+        // The slot is free; try to claim it.
+        int old_pos =
+            rtc::AtomicOps::CompareAndSwap(&insert_pos_, pos, Advance(pos, 1));
+        if (old_pos == pos) {
+          slot->elem = elem;
+          rtc::AtomicOps::ReleaseStore(&slot->sequence, Advance(pos, 1));
+          return true;
+        }
+        pos = old_pos;
+      } else if (diff < 0) {
+        // The slot still holds the element from the previous lap.
+        return false;
+      } else {
+        // Another producer claimed |pos| since we read it.
+        pos = rtc::AtomicOps::AcquireLoad(&insert_pos_);
+      }
+    }
+  }
+
+  // Returns the element at the front of the queue, or nullptr if the queue
+  // is empty. The element stays valid until PopFront(). Must only be called
+  // on the consumer thread.
+  const T* Front() const {
+    const Slot* slot = &slots_[static_cast<unsigned>(remove_pos_) & mask_];
+    if (rtc::AtomicOps::AcquireLoad(&slot->sequence) !=
+        Advance(remove_pos_, 1)) {
+      return nullptr;
+    }
+    return &slot->elem;
+  }
+
+  // Removes the element at the front of the queue, making its slot available
+  // to the producers again. Must only be called on the consumer thread.
+  void PopFront() {
+    RTC_DCHECK(Front());
+    Slot* slot = &slots_[static_cast<unsigned>(remove_pos_) & mask_];
+    rtc::AtomicOps::ReleaseStore(&slot->sequence,
+                                 Advance(remove_pos_, mask_ + 1));
+    remove_pos_ = Advance(remove_pos_, 1);
+  }
+
+ private:
+  struct Slot {
+    volatile int sequence;
+    T elem;
+  };
+
+  // Positions increase forever and are allowed to wrap around, so all
+  // arithmetic on them is done modulo 2^32.
+  static int Advance(int pos, size_t n) {
+    return static_cast<int>(static_cast<unsigned>(pos) +
+                            static_cast<unsigned>(n));
+  }
+  static int Distance(int from, int to) {
+    return static_cast<int>(static_cast<unsigned>(to) -
+                            static_cast<unsigned>(from));
+  }
+
+  std::unique_ptr<Slot[]> slots_;
+  const size_t mask_;
+  volatile int insert_pos_;
+  // Only accessed on the consumer thread.
+  int remove_pos_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(LockFreeQueue);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_CALL_LOCKFREE_QUEUE_H_
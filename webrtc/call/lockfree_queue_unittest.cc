@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/thread.h"
+#include "webrtc/call/lockfree_queue.h"
+
+namespace {
+struct Element {
+  int producer;
+  int value;
+};
+
+const int kProducers = 4;
+const int kElementsPerProducer = 10000;
+
+struct Producer {
+  webrtc::LockFreeQueue<Element>* queue;
+  int id;
+};
+
+bool ProduceElements(void* obj) {
+  Producer* producer = static_cast<Producer*>(obj);
+  for (int i = 0; i < kElementsPerProducer; ++i) {
+    Element elem = {producer->id, i};
+    while (!producer->queue->Insert(elem)) {
+      // Wait for the consumer to make room.
+      rtc::Thread::SleepMs(1);
+    }
+  }
+  return false;
+}
+}  // namespace
+
+namespace webrtc {
+
+// Verify that the queue works as a simple FIFO queue.
+TEST(LockFreeQueueTest, SimpleQueue) {
+  size_t capacity = 128;
+  LockFreeQueue<size_t> q(capacity);
+  EXPECT_TRUE(q.Front() == nullptr);
+  for (size_t i = 0; i < capacity; i++) {
+    EXPECT_TRUE(q.Insert(i));
+  }
+
+  for (size_t i = 0; i < capacity; i++) {
+    ASSERT_TRUE(q.Front() != nullptr);
+    EXPECT_EQ(i, *q.Front());
+    q.PopFront();
+  }
+  EXPECT_TRUE(q.Front() == nullptr);
+}
+
+// Test that inserting into a full queue fails without overwriting anything,
+// and that slots are reused after the positions wrap around the buffer.
+TEST(LockFreeQueueTest, RejectsWhenFull) {
+  size_t capacity = 16;
+  LockFreeQueue<size_t> q(capacity);
+  size_t next_insert = 0;
+  size_t next_remove = 0;
+  for (int lap = 0; lap < 10; lap++) {
+    while (q.Insert(next_insert)) {
+      ++next_insert;
+    }
+    EXPECT_EQ(capacity, next_insert - next_remove);
+    for (size_t i = 0; i < capacity / 2; i++) {
+      ASSERT_TRUE(q.Front() != nullptr);
+      EXPECT_EQ(next_remove, *q.Front());
+      q.PopFront();
+      ++next_remove;
+    }
+  }
+  while (q.Front()) {
+    EXPECT_EQ(next_remove, *q.Front());
+    q.PopFront();
+    ++next_remove;
+  }
+  EXPECT_EQ(next_insert, next_remove);
+}
+
+// Test that elements inserted concurrently by several threads all arrive,
+// in the order each thread inserted them.
+TEST(LockFreeQueueTest, ConcurrentProducers) {
+  LockFreeQueue<Element> q(64);
+  std::vector<Producer> producers(kProducers);
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < kProducers; i++) {
+    producers[i].queue = &q;
+    producers[i].id = i;
+    threads.emplace_back(
+        new rtc::PlatformThread(&ProduceElements, &producers[i], "Producer"));
+    threads.back()->Start();
+  }
+
+  std::vector<int> next_value(kProducers, 0);
+  int remaining = kProducers * kElementsPerProducer;
+  while (remaining > 0) {
+    const Element* elem = q.Front();
+    if (!elem) {
+      rtc::Thread::SleepMs(1);
+      continue;
+    }
+    ASSERT_GE(elem->producer, 0);
+    ASSERT_LT(elem->producer, kProducers);
+    EXPECT_EQ(next_value[elem->producer], elem->value);
+    next_value[elem->producer] = elem->value + 1;
+    q.PopFront();
+    --remaining;
+  }
+  EXPECT_TRUE(q.Front() == nullptr);
+
+  for (auto& thread : threads) {
+    thread->Stop();
+  }
+}
+
+}  // namespace webrtc
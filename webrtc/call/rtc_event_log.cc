@@ -10,6 +10,8 @@
 
 #include "webrtc/call/rtc_event_log.h"
 
+#include <string.h>
+
 #include <limits>
 #include <vector>
 
@@ -19,6 +21,7 @@
 #include "webrtc/base/swap_queue.h"
 #include "webrtc/base/thread_checker.h"
 #include "webrtc/call.h"
+#include "webrtc/call/lockfree_queue.h"
 #include "webrtc/call/rtc_event_log_helper_thread.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/modules/rtp_rtcp/source/byte_io.h"
@@ -105,6 +108,10 @@ class RtcEventLogImpl final : public RtcEventLog {
   // Message queue for passing events to the logging thread.
   SwapQueue<std::unique_ptr<rtclog::Event> > event_queue_;
 
+  // Lock-free queue for passing RTP and RTCP packets to the logging thread,
+  // since they are logged far more often than anything else.
+  LockFreeQueue<RtcEventLogHelperThread::PacketRecord> packet_queue_;
+
   rtc::Event wake_up_;
   rtc::Event stopped_;
 
@@ -154,6 +161,8 @@ rtclog::MediaType ConvertMediaType(MediaType media_type) {
 // sent packets because they also contain received packets.
 static const int kEventsPerSecond = 1000;
 static const int kControlMessagesPerSecond = 10;
+// Must be a power of two.
+static const size_t kPacketsPerSecond = 2048;
 }  // namespace
 
 // RtcEventLogImpl member functions.
@@ -161,11 +170,13 @@ RtcEventLogImpl::RtcEventLogImpl(const Clock* clock)
     // Allocate buffers for roughly one second of history.
     : message_queue_(kControlMessagesPerSecond),
       event_queue_(kEventsPerSecond),
+      packet_queue_(kPacketsPerSecond),
       wake_up_(false, false),
       stopped_(false, false),
       clock_(clock),
       helper_thread_(&message_queue_,
                      &event_queue_,
+                     &packet_queue_,
                      &wake_up_,
                      &stopped_,
                      clock),
@@ -334,6 +345,22 @@ void RtcEventLogImpl::LogRtpHeader(PacketDirection direction,
     header_length += (x_len + 1) * 4;
   }
 
+  RtcEventLogHelperThread::PacketRecord record;
+  if (header_length <= sizeof(record.data)) {
+    record.timestamp_us = clock_->TimeInMicroseconds();
+    record.rtcp = false;
+    record.incoming = direction == kIncomingPacket;
+    record.media_type = ConvertMediaType(media_type);
+    record.packet_length = packet_length;
+    record.data_length = header_length;
+    memcpy(record.data, header, header_length);
+    if (!packet_queue_.Insert(record)) {
+      LOG(LS_WARNING) << "RTP queue full. Not logging RTP packet.";
+    }
+    return;
+  }
+
+  // Headers with unusually large extensions don't fit in a record.
   std::unique_ptr<rtclog::Event> rtp_event(new rtclog::Event());
   rtp_event->set_timestamp_us(clock_->TimeInMicroseconds());
   rtp_event->set_type(rtclog::Event::RTP_EVENT);
@@ -350,11 +377,7 @@ void RtcEventLogImpl::LogRtcpPacket(PacketDirection direction,
                                     MediaType media_type,
                                     const uint8_t* packet,
                                     size_t length) {
-  std::unique_ptr<rtclog::Event> rtcp_event(new rtclog::Event());
-  rtcp_event->set_timestamp_us(clock_->TimeInMicroseconds());
-  rtcp_event->set_type(rtclog::Event::RTCP_EVENT);
-  rtcp_event->mutable_rtcp_packet()->set_incoming(direction == kIncomingPacket);
-  rtcp_event->mutable_rtcp_packet()->set_type(ConvertMediaType(media_type));
+  int64_t timestamp_us = clock_->TimeInMicroseconds();
 
   RTCPUtility::RtcpCommonHeader header;
   const uint8_t* block_begin = packet;
@@ -400,6 +423,28 @@ void RtcEventLogImpl::LogRtcpPacket(PacketDirection direction,
 
     block_begin += block_size;
   }
+
+  RtcEventLogHelperThread::PacketRecord record;
+  if (buffer_length <= sizeof(record.data)) {
+    record.timestamp_us = timestamp_us;
+    record.rtcp = true;
+    record.incoming = direction == kIncomingPacket;
+    record.media_type = ConvertMediaType(media_type);
+    record.packet_length = 0;
+    record.data_length = buffer_length;
+    memcpy(record.data, buffer, buffer_length);
+    if (!packet_queue_.Insert(record)) {
+      LOG(LS_WARNING) << "RTCP queue full. Not logging RTCP packet.";
+    }
+    return;
+  }
+
+  // Large compound packets don't fit in a record.
+  std::unique_ptr<rtclog::Event> rtcp_event(new rtclog::Event());
+  rtcp_event->set_timestamp_us(timestamp_us);
+  rtcp_event->set_type(rtclog::Event::RTCP_EVENT);
+  rtcp_event->mutable_rtcp_packet()->set_incoming(direction == kIncomingPacket);
+  rtcp_event->mutable_rtcp_packet()->set_type(ConvertMediaType(media_type));
   rtcp_event->mutable_rtcp_packet()->set_packet_data(buffer, buffer_length);
   if (!event_queue_.Insert(&rtcp_event)) {
     LOG(LS_WARNING) << "RTCP queue full. Not logging RTCP packet.";
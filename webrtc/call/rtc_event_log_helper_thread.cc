@@ -21,6 +21,9 @@ namespace webrtc {
 
 namespace {
 const int kEventsInHistory = 10000;
+// Serialized events are written to the file in chunks of about this size, so
+// that logging the whole history at once doesn't need a large buffer.
+const size_t kOutputChunkBytes = 64 * 1024;
 
 bool IsConfigEvent(const rtclog::Event& event) {
   rtclog::Event_EventType event_type = event.type();
@@ -29,17 +32,40 @@ bool IsConfigEvent(const rtclog::Event& event) {
          event_type == rtclog::Event::AUDIO_RECEIVER_CONFIG_EVENT ||
          event_type == rtclog::Event::AUDIO_SENDER_CONFIG_EVENT;
 }
+
+void PacketRecordToEvent(const RtcEventLogHelperThread::PacketRecord& record,
+                         rtclog::Event* event) {
+  // Clear() keeps the allocated fields around for the next packet.
+  event->Clear();
+  event->set_timestamp_us(record.timestamp_us);
+  if (record.rtcp) {
+    event->set_type(rtclog::Event::RTCP_EVENT);
+    rtclog::RtcpPacket* rtcp_packet = event->mutable_rtcp_packet();
+    rtcp_packet->set_incoming(record.incoming);
+    rtcp_packet->set_type(record.media_type);
+    rtcp_packet->set_packet_data(record.data, record.data_length);
+  } else {
+    event->set_type(rtclog::Event::RTP_EVENT);
+    rtclog::RtpPacket* rtp_packet = event->mutable_rtp_packet();
+    rtp_packet->set_incoming(record.incoming);
+    rtp_packet->set_type(record.media_type);
+    rtp_packet->set_packet_length(record.packet_length);
+    rtp_packet->set_header(record.data, record.data_length);
+  }
+}
 }  // namespace
 
 // RtcEventLogImpl member functions.
 RtcEventLogHelperThread::RtcEventLogHelperThread(
     SwapQueue<ControlMessage>* message_queue,
     SwapQueue<std::unique_ptr<rtclog::Event>>* event_queue,
+    LockFreeQueue<PacketRecord>* packet_queue,
     rtc::Event* wake_up,
     rtc::Event* stopped,
     const Clock* const clock)
     : message_queue_(message_queue),
       event_queue_(event_queue),
+      packet_queue_(packet_queue),
       history_(kEventsInHistory),
       config_history_(),
       file_(FileWrapper::Create()),
@@ -50,12 +76,17 @@ RtcEventLogHelperThread::RtcEventLogHelperThread(
       stop_time_(std::numeric_limits<int64_t>::max()),
       has_recent_event_(false),
       most_recent_event_(),
+      has_recent_packet_(false),
+      packet_event_(),
+      event_stream_(),
       output_string_(),
       wake_up_(wake_up),
       stopped_(stopped),
       clock_(clock) {
   RTC_DCHECK(message_queue_);
   RTC_DCHECK(event_queue_);
+  RTC_DCHECK(packet_queue_);
+  event_stream_.add_stream();
   RTC_DCHECK(wake_up_);
   RTC_DCHECK(stopped_);
   RTC_DCHECK(clock_);
@@ -80,41 +111,100 @@ RtcEventLogHelperThread::~RtcEventLogHelperThread() {
 }
 
 bool RtcEventLogHelperThread::AppendEventToString(rtclog::Event* event) {
-  rtclog::EventStream event_stream;
-  event_stream.add_stream();
-  event_stream.mutable_stream(0)->Swap(event);
-  // We create a new event stream per event but because of the way protobufs
-  // are encoded, events can be merged by concatenating them. Therefore,
-  // it will look like a single stream when we read it back from file.
+  event_stream_.mutable_stream(0)->Swap(event);
+  // We serialize a stream with a single event each time, but because of the
+  // way protobufs are encoded, events can be merged by concatenating them.
+  // Therefore, it will look like a single stream when we read it back from
+  // file.
   bool stop = true;
-  if (written_bytes_ + static_cast<int64_t>(output_string_.size()) +
-          event_stream.ByteSize() <=
+  int size = event_stream_.ByteSize();
+  if (written_bytes_ + static_cast<int64_t>(output_string_.size()) + size <=
       max_size_bytes_) {
-    event_stream.AppendToString(&output_string_);
+    // ByteSize() has cached the sizes, so serialize directly into the output
+    // instead of letting AppendToString() compute them again.
+    size_t offset = output_string_.size();
+    output_string_.resize(offset + size);
+    event_stream_.SerializeWithCachedSizesToArray(
+        reinterpret_cast<uint8_t*>(&output_string_[offset]));
     stop = false;
   }
   // Swap the event back so that we don't mix event types in the queues.
-  event_stream.mutable_stream(0)->Swap(event);
+  event_stream_.mutable_stream(0)->Swap(event);
   return stop;
 }
 
+bool RtcEventLogHelperThread::WriteOutputToFile() {
+  if (!file_->Write(output_string_.data(), output_string_.size())) {
+    LOG(LS_ERROR) << "FileWrapper failed to write WebRtcEventLog file.";
+    // The current FileWrapper implementation closes the file on error.
+    RTC_DCHECK(!file_->Open());
+    return false;
+  }
+  written_bytes_ += output_string_.size();
+  output_string_.clear();
+  return true;
+}
+
+bool RtcEventLogHelperThread::PacketIsNext() const {
+  return has_recent_packet_ &&
+         (!has_recent_event_ ||
+          packet_event_.timestamp_us() < most_recent_event_->timestamp_us());
+}
+
+// Returns the earliest event at the front of either queue, or nullptr if both
+// are empty. The event stays at the front until PopEvent() is called.
+rtclog::Event* RtcEventLogHelperThread::PeekEvent() {
+  if (!has_recent_event_) {
+    has_recent_event_ = event_queue_->Remove(&most_recent_event_);
+  }
+  if (!has_recent_packet_) {
+    const PacketRecord* record = packet_queue_->Front();
+    if (record) {
+      PacketRecordToEvent(*record, &packet_event_);
+      packet_queue_->PopFront();
+      has_recent_packet_ = true;
+    }
+  }
+  if (PacketIsNext()) {
+    return &packet_event_;
+  }
+  return has_recent_event_ ? most_recent_event_.get() : nullptr;
+}
+
+// Removes the event returned by PeekEvent(), handing it over to |event| if
+// that is non-null.
+void RtcEventLogHelperThread::PopEvent(std::unique_ptr<rtclog::Event>* event) {
+  if (PacketIsNext()) {
+    if (event) {
+      event->reset(new rtclog::Event());
+      (*event)->Swap(&packet_event_);
+    }
+    has_recent_packet_ = false;
+  } else {
+    RTC_DCHECK(has_recent_event_);
+    if (event) {
+      *event = std::move(most_recent_event_);
+    }
+    has_recent_event_ = false;
+  }
+}
+
 void RtcEventLogHelperThread::LogToMemory() {
   RTC_DCHECK(!file_->Open());
 
   // Process each event earlier than the current time and append it to the
   // appropriate history_.
   int64_t current_time = clock_->TimeInMicroseconds();
-  if (!has_recent_event_) {
-    has_recent_event_ = event_queue_->Remove(&most_recent_event_);
-  }
-  while (has_recent_event_ &&
-         most_recent_event_->timestamp_us() <= current_time) {
-    if (IsConfigEvent(*most_recent_event_)) {
-      config_history_.push_back(std::move(most_recent_event_));
+  rtclog::Event* next_event;
+  while ((next_event = PeekEvent()) &&
+         next_event->timestamp_us() <= current_time) {
+    std::unique_ptr<rtclog::Event> event;
+    PopEvent(&event);
+    if (IsConfigEvent(*event)) {
+      config_history_.push_back(std::move(event));
     } else {
-      history_.push_back(std::move(most_recent_event_));
+      history_.push_back(std::move(event));
     }
-    has_recent_event_ = event_queue_->Remove(&most_recent_event_);
   }
 }
 
@@ -132,6 +222,9 @@ void RtcEventLogHelperThread::StartLogFile() {
   // Serialize the config information for all old streams.
   for (auto& event : config_history_) {
     AppendEventToString(event.get());
+    if (output_string_.size() >= kOutputChunkBytes && !WriteOutputToFile()) {
+      return;
+    }
   }
 
   // Serialize the events in the event queue.
@@ -140,21 +233,15 @@ void RtcEventLogHelperThread::StartLogFile() {
     if (!stop) {
       history_.pop_front();
     }
+    if (output_string_.size() >= kOutputChunkBytes && !WriteOutputToFile()) {
+      return;
+    }
   }
 
-  // Write to file.
-  if (!file_->Write(output_string_.data(), output_string_.size())) {
-    LOG(LS_ERROR) << "FileWrapper failed to write WebRtcEventLog file.";
-    // The current FileWrapper implementation closes the file on error.
-    RTC_DCHECK(!file_->Open());
+  // Write the rest to file.
+  if (!WriteOutputToFile()) {
     return;
   }
-  written_bytes_ += output_string_.size();
-
-  // Free the allocated memory since we probably won't need this amount of
-  // space again.
-  output_string_.clear();
-  output_string_.shrink_to_fit();
 
   if (stop) {
     RTC_DCHECK(file_->Open());
@@ -170,36 +257,36 @@ void RtcEventLogHelperThread::LogToFile() {
   // to the output_string_.
   int64_t current_time = clock_->TimeInMicroseconds();
   int64_t time_limit = std::min(current_time, stop_time_);
-  if (!has_recent_event_) {
-    has_recent_event_ = event_queue_->Remove(&most_recent_event_);
-  }
   bool stop = false;
-  while (!stop && has_recent_event_ &&
-         most_recent_event_->timestamp_us() <= time_limit) {
-    stop = AppendEventToString(most_recent_event_.get());
+  rtclog::Event* next_event;
+  while (!stop && (next_event = PeekEvent()) &&
+         next_event->timestamp_us() <= time_limit) {
+    stop = AppendEventToString(next_event);
     if (!stop) {
-      if (IsConfigEvent(*most_recent_event_)) {
-        config_history_.push_back(std::move(most_recent_event_));
+      if (IsConfigEvent(*next_event)) {
+        std::unique_ptr<rtclog::Event> event;
+        PopEvent(&event);
+        config_history_.push_back(std::move(event));
+      } else {
+        PopEvent(nullptr);
       }
-      has_recent_event_ = event_queue_->Remove(&most_recent_event_);
+    }
+    if (output_string_.size() >= kOutputChunkBytes && !WriteOutputToFile()) {
+      return;
     }
   }
 
-  // Write string to file.
-  if (!file_->Write(output_string_.data(), output_string_.size())) {
-    LOG(LS_ERROR) << "FileWrapper failed to write WebRtcEventLog file.";
-    // The current FileWrapper implementation closes the file on error.
-    RTC_DCHECK(!file_->Open());
+  // Write the rest to file.
+  if (!WriteOutputToFile()) {
     return;
   }
-  written_bytes_ += output_string_.size();
 
   // We want to stop logging if we have reached the file size limit. We also
   // want to stop logging if the remaining events are more recent than the
   // time limit, or in other words if we have terminated the loop despite
-  // having more events in the queue.
-  if ((has_recent_event_ && most_recent_event_->timestamp_us() > stop_time_) ||
-      stop) {
+  // having more events in the queues.
+  next_event = PeekEvent();
+  if ((next_event && next_event->timestamp_us() > stop_time_) || stop) {
     RTC_DCHECK(file_->Open());
     StopLogFile();
   }
@@ -216,12 +303,7 @@ void RtcEventLogHelperThread::StopLogFile() {
 
   if (written_bytes_ + static_cast<int64_t>(output_string_.size()) <=
       max_size_bytes_) {
-    if (!file_->Write(output_string_.data(), output_string_.size())) {
-      LOG(LS_ERROR) << "FileWrapper failed to write WebRtcEventLog file.";
-      // The current FileWrapper implementation closes the file on error.
-      RTC_DCHECK(!file_->Open());
-    }
-    written_bytes_ += output_string_.size();
+    WriteOutputToFile();
   }
 
   max_size_bytes_ = std::numeric_limits<int64_t>::max();
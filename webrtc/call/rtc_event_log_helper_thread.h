@@ -21,6 +21,7 @@
 #include "webrtc/base/event.h"
 #include "webrtc/base/platform_thread.h"
 #include "webrtc/base/swap_queue.h"
+#include "webrtc/call/lockfree_queue.h"
 #include "webrtc/call/ringbuffer.h"
 #include "webrtc/system_wrappers/include/clock.h"
 #include "webrtc/system_wrappers/include/file_wrapper.h"
@@ -64,9 +65,25 @@ class RtcEventLogHelperThread final {
     }
   };
 
+  // An RTP header or a filtered RTCP packet, copied as-is by the thread
+  // that logs it so that the protobuf is only built on the helper thread.
+  // Packets that don't fit are logged as ordinary events instead.
+  struct PacketRecord {
+    enum { kMaxDataLength = 256 };
+
+    int64_t timestamp_us;
+    bool rtcp;
+    bool incoming;
+    rtclog::MediaType media_type;
+    uint32_t packet_length;  // Length of the whole RTP packet.
+    uint16_t data_length;
+    uint8_t data[kMaxDataLength];
+  };
+
   RtcEventLogHelperThread(
       SwapQueue<ControlMessage>* message_queue,
       SwapQueue<std::unique_ptr<rtclog::Event>>* event_queue,
+      LockFreeQueue<PacketRecord>* packet_queue,
       rtc::Event* wake_up,
       rtc::Event* file_finished,
       const Clock* const clock);
@@ -77,6 +94,10 @@ class RtcEventLogHelperThread final {
 
   void TerminateThread();
   bool AppendEventToString(rtclog::Event* event);
+  bool WriteOutputToFile();
+  bool PacketIsNext() const;
+  rtclog::Event* PeekEvent();
+  void PopEvent(std::unique_ptr<rtclog::Event>* event);
   void AppendEventToHistory(const rtclog::Event& event);
   void LogToMemory();
   void StartLogFile();
@@ -87,6 +108,7 @@ class RtcEventLogHelperThread final {
   // Message queues for passing events to the logging thread.
   SwapQueue<ControlMessage>* message_queue_;
   SwapQueue<std::unique_ptr<rtclog::Event>>* event_queue_;
+  LockFreeQueue<PacketRecord>* packet_queue_;
 
   // History containing the most recent events (~ 10 s).
   RingBuffer<std::unique_ptr<rtclog::Event>> history_;
@@ -105,7 +127,16 @@ class RtcEventLogHelperThread final {
   bool has_recent_event_;
   std::unique_ptr<rtclog::Event> most_recent_event_;
 
-  // Temporary space for serializing profobuf data.
+  // The packet record at the front of |packet_queue_|, converted to an event.
+  // The same event is reused for every packet.
+  bool has_recent_packet_;
+  rtclog::Event packet_event_;
+
+  // Reused to serialize each event without building a new stream.
+  rtclog::EventStream event_stream_;
+
+  // Temporary space for serializing profobuf data. Written to the file
+  // whenever it grows past a small limit.
   std::string output_string_;
 
   rtc::Event* wake_up_;
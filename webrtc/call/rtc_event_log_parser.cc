@@ -19,6 +19,7 @@
 #include "webrtc/call.h"
 #include "webrtc/call/rtc_event_log.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
 #include "webrtc/system_wrappers/include/file_wrapper.h"
 
 namespace webrtc {
@@ -99,61 +100,156 @@ bool ParseVarInt(std::FILE* file, uint64_t* varint, size_t* bytes_read) {
   return false;
 }
 
+const size_t kMaxEventSize = (1u << 16) - 1;
+// Logs can be hours long, so read them in large chunks.
+const size_t kFileBufferSize = 1 << 16;
+
 }  // namespace
 
-bool ParsedRtcEventLog::ParseFile(const std::string& filename) {
-  stream_.clear();
-  const size_t kMaxEventSize = (1u << 16) - 1;
-  char tmp_buffer[kMaxEventSize];
+RtcEventLogReader::RtcEventLogReader()
+    : file_(nullptr), buffer_(kMaxEventSize), error_(false) {}
+
+RtcEventLogReader::~RtcEventLogReader() {
+  if (file_) {
+    fclose(file_);
+  }
+}
 
-  std::FILE* file = fopen(filename.c_str(), "rb");
-  if (!file) {
+bool RtcEventLogReader::Open(const std::string& file_name) {
+  RTC_DCHECK(!file_);
+  file_ = fopen(file_name.c_str(), "rb");
+  if (!file_) {
     LOG(LS_WARNING) << "Could not open file for reading.";
     return false;
   }
+  setvbuf(file_, nullptr, _IOFBF, kFileBufferSize);
+  error_ = false;
+  return true;
+}
 
-  while (1) {
-    // Peek at the next message tag. The tag number is defined as
-    // (fieldnumber << 3) | wire_type. In our case, the field number is
-    // supposed to be 1 and the wire type for an length-delimited field is 2.
-    const uint64_t kExpectedTag = (1 << 3) | 2;
-    uint64_t tag;
-    size_t bytes_read;
-    if (!ParseVarInt(file, &tag, &bytes_read) || tag != kExpectedTag) {
-      fclose(file);
-      if (bytes_read == 0) {
-        return true;  // Reached end of file.
-      }
-      LOG(LS_WARNING) << "Missing field tag from beginning of protobuf event.";
-      return false;
-    }
+bool RtcEventLogReader::ReadNextEvent(rtclog::Event* event) {
+  RTC_DCHECK(file_);
+  if (error_) {
+    return false;
+  }
+  error_ = true;
 
-    // Peek at the length field.
-    uint64_t message_length;
-    if (!ParseVarInt(file, &message_length, &bytes_read)) {
-      LOG(LS_WARNING) << "Missing message length after protobuf field tag.";
-      fclose(file);
-      return false;
-    } else if (message_length > kMaxEventSize) {
-      LOG(LS_WARNING) << "Protobuf message length is too large.";
-      fclose(file);
-      return false;
+  // Peek at the next message tag. The tag number is defined as
+  // (fieldnumber << 3) | wire_type. In our case, the field number is
+  // supposed to be 1 and the wire type for an length-delimited field is 2.
+  const uint64_t kExpectedTag = (1 << 3) | 2;
+  uint64_t tag;
+  size_t bytes_read;
+  if (!ParseVarInt(file_, &tag, &bytes_read) || tag != kExpectedTag) {
+    if (bytes_read == 0) {
+      error_ = false;
+      return false;  // Reached end of file.
     }
+    LOG(LS_WARNING) << "Missing field tag from beginning of protobuf event.";
+    return false;
+  }
 
-    if (fread(tmp_buffer, 1, message_length, file) != message_length) {
-      LOG(LS_WARNING) << "Failed to read protobuf message from file.";
-      fclose(file);
-      return false;
-    }
+  // Peek at the length field.
+  uint64_t message_length;
+  if (!ParseVarInt(file_, &message_length, &bytes_read)) {
+    LOG(LS_WARNING) << "Missing message length after protobuf field tag.";
+    return false;
+  } else if (message_length > kMaxEventSize) {
+    LOG(LS_WARNING) << "Protobuf message length is too large.";
+    return false;
+  }
+
+  if (fread(buffer_.data(), 1, message_length, file_) != message_length) {
+    LOG(LS_WARNING) << "Failed to read protobuf message from file.";
+    return false;
+  }
+
+  if (!event->ParseFromArray(buffer_.data(), message_length)) {
+    LOG(LS_WARNING) << "Failed to parse protobuf message.";
+    return false;
+  }
+  error_ = false;
+  return true;
+}
 
-    rtclog::Event event;
-    if (!event.ParseFromArray(tmp_buffer, message_length)) {
-      LOG(LS_WARNING) << "Failed to parse protobuf message.";
-      fclose(file);
-      return false;
+bool RtcEventLogColumns::ParseFile(const std::string& file_name) {
+  *this = RtcEventLogColumns();
+  RtcEventLogReader reader;
+  if (!reader.Open(file_name)) {
+    return false;
+  }
+
+  rtclog::Event event;
+  while (reader.ReadNextEvent(&event)) {
+    switch (event.type()) {
+      case rtclog::Event::RTP_EVENT: {
+        const rtclog::RtpPacket& packet = event.rtp_packet();
+        const std::string& header = packet.header();
+        const size_t kMinRtpHeaderSize = 12;
+        if (!event.has_timestamp_us() || !packet.has_incoming() ||
+            !packet.has_packet_length() ||
+            header.size() < kMinRtpHeaderSize) {
+          LOG(LS_WARNING) << "Malformed RTP event.";
+          return false;
+        }
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(header.data());
+        rtp.timestamp_us.push_back(event.timestamp_us());
+        rtp.incoming.push_back(packet.incoming());
+        rtp.ssrc.push_back(ByteReader<uint32_t>::ReadBigEndian(data + 8));
+        rtp.sequence_number.push_back(
+            ByteReader<uint16_t>::ReadBigEndian(data + 2));
+        rtp.rtp_timestamp.push_back(
+            ByteReader<uint32_t>::ReadBigEndian(data + 4));
+        rtp.header_length.push_back(static_cast<uint16_t>(header.size()));
+        rtp.packet_length.push_back(packet.packet_length());
+        break;
+      }
+      case rtclog::Event::RTCP_EVENT: {
+        const rtclog::RtcpPacket& packet = event.rtcp_packet();
+        if (!event.has_timestamp_us() || !packet.has_incoming() ||
+            !packet.has_packet_data()) {
+          LOG(LS_WARNING) << "Malformed RTCP event.";
+          return false;
+        }
+        rtcp.timestamp_us.push_back(event.timestamp_us());
+        rtcp.incoming.push_back(packet.incoming());
+        rtcp.length.push_back(packet.packet_data().size());
+        break;
+      }
+      case rtclog::Event::BWE_PACKET_LOSS_EVENT: {
+        const rtclog::BwePacketLossEvent& loss_event =
+            event.bwe_packet_loss_event();
+        if (!event.has_timestamp_us() || !loss_event.has_bitrate() ||
+            !loss_event.has_fraction_loss() ||
+            !loss_event.has_total_packets()) {
+          LOG(LS_WARNING) << "Malformed BWE loss event.";
+          return false;
+        }
+        bwe_loss.timestamp_us.push_back(event.timestamp_us());
+        bwe_loss.bitrate.push_back(loss_event.bitrate());
+        bwe_loss.fraction_loss.push_back(loss_event.fraction_loss());
+        bwe_loss.total_packets.push_back(loss_event.total_packets());
+        break;
+      }
+      default:
+        break;
     }
+  }
+  return !reader.error();
+}
+
+bool ParsedRtcEventLog::ParseFile(const std::string& filename) {
+  stream_.clear();
+  RtcEventLogReader reader;
+  if (!reader.Open(filename)) {
+    return false;
+  }
+
+  rtclog::Event event;
+  while (reader.ReadNextEvent(&event)) {
     stream_.push_back(event);
   }
+  return !reader.error();
 }
 
 size_t ParsedRtcEventLog::GetNumberOfEvents() const {
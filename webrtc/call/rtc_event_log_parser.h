@@ -10,9 +10,12 @@
 #ifndef WEBRTC_CALL_RTC_EVENT_LOG_PARSER_H_
 #define WEBRTC_CALL_RTC_EVENT_LOG_PARSER_H_
 
+#include <stdio.h>
+
 #include <string>
 #include <vector>
 
+#include "webrtc/base/constructormagic.h"
 #include "webrtc/call/rtc_event_log.h"
 #include "webrtc/video_receive_stream.h"
 #include "webrtc/video_send_stream.h"
@@ -28,6 +31,66 @@ namespace webrtc {
 
 enum class MediaType;
 
+// Reads the events of an RtcEventLog file one at a time, so that only the
+// current event needs to be held in memory.
+class RtcEventLogReader {
+ public:
+  RtcEventLogReader();
+  ~RtcEventLogReader();
+
+  // Opens an RtcEventLog file and returns true if successful.
+  bool Open(const std::string& file_name);
+
+  // Decodes the next event into |event|, reusing its memory. Returns false
+  // at the end of the file or if the file is malformed, in which case
+  // error() is set.
+  bool ReadNextEvent(rtclog::Event* event);
+
+  bool error() const { return error_; }
+
+ private:
+  std::FILE* file_;
+  std::vector<char> buffer_;
+  bool error_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RtcEventLogReader);
+};
+
+// The RTP packets, RTCP packets and loss based bandwidth estimates of an
+// RtcEventLog file as one array per field, for bulk analysis of long logs.
+// Element i of every array in a group belongs to the same event. Other
+// events are skipped.
+struct RtcEventLogColumns {
+  struct Rtp {
+    std::vector<int64_t> timestamp_us;
+    std::vector<bool> incoming;
+    std::vector<uint32_t> ssrc;
+    std::vector<uint16_t> sequence_number;
+    std::vector<uint32_t> rtp_timestamp;
+    std::vector<uint16_t> header_length;
+    std::vector<uint32_t> packet_length;
+  };
+  struct Rtcp {
+    std::vector<int64_t> timestamp_us;
+    std::vector<bool> incoming;
+    std::vector<uint32_t> length;
+  };
+  struct BweLoss {
+    std::vector<int64_t> timestamp_us;
+    std::vector<int32_t> bitrate;
+    std::vector<uint8_t> fraction_loss;
+    std::vector<int32_t> total_packets;
+  };
+
+  // Reads an RtcEventLog file and returns true if parsing was successful.
+  // Unlike ParsedRtcEventLog, only the extracted fields are kept in memory.
+  bool ParseFile(const std::string& file_name);
+
+  Rtp rtp;
+  Rtcp rtcp;
+  BweLoss bwe_loss;
+};
+
 class ParsedRtcEventLog {
   friend class RtcEventLogTestHelper;
 
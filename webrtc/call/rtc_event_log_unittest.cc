@@ -24,6 +24,7 @@
 #include "webrtc/call/rtc_event_log.h"
 #include "webrtc/call/rtc_event_log_parser.h"
 #include "webrtc/call/rtc_event_log_unittest_helper.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_sender.h"
@@ -98,6 +99,74 @@ void PrintExpectedEvents(size_t rtp_count,
   }
   printf("end \n");
 }
+
+// Checks that the columns hold the same RTP, RTCP and BWE loss events as
+// the fully parsed log.
+void VerifyColumns(const ParsedRtcEventLog& parsed_log,
+                   const RtcEventLogColumns& columns) {
+  size_t rtp_index = 0;
+  size_t rtcp_index = 0;
+  size_t bwe_loss_index = 0;
+  uint8_t data[IP_PACKET_SIZE];
+  for (size_t i = 0; i < parsed_log.GetNumberOfEvents(); i++) {
+    PacketDirection direction;
+    size_t length;
+    switch (parsed_log.GetEventType(i)) {
+      case ParsedRtcEventLog::RTP_EVENT: {
+        size_t header_length;
+        ASSERT_LT(rtp_index, columns.rtp.timestamp_us.size());
+        parsed_log.GetRtpHeader(i, &direction, nullptr, data, &header_length,
+                                &length);
+        EXPECT_EQ(parsed_log.GetTimestamp(i),
+                  columns.rtp.timestamp_us[rtp_index]);
+        EXPECT_EQ(direction == kIncomingPacket,
+                  columns.rtp.incoming[rtp_index]);
+        EXPECT_EQ(ByteReader<uint32_t>::ReadBigEndian(data + 8),
+                  columns.rtp.ssrc[rtp_index]);
+        EXPECT_EQ(ByteReader<uint16_t>::ReadBigEndian(data + 2),
+                  columns.rtp.sequence_number[rtp_index]);
+        EXPECT_EQ(ByteReader<uint32_t>::ReadBigEndian(data + 4),
+                  columns.rtp.rtp_timestamp[rtp_index]);
+        EXPECT_EQ(header_length, columns.rtp.header_length[rtp_index]);
+        EXPECT_EQ(length, columns.rtp.packet_length[rtp_index]);
+        rtp_index++;
+        break;
+      }
+      case ParsedRtcEventLog::RTCP_EVENT:
+        ASSERT_LT(rtcp_index, columns.rtcp.timestamp_us.size());
+        parsed_log.GetRtcpPacket(i, &direction, nullptr, nullptr, &length);
+        EXPECT_EQ(parsed_log.GetTimestamp(i),
+                  columns.rtcp.timestamp_us[rtcp_index]);
+        EXPECT_EQ(direction == kIncomingPacket,
+                  columns.rtcp.incoming[rtcp_index]);
+        EXPECT_EQ(length, columns.rtcp.length[rtcp_index]);
+        rtcp_index++;
+        break;
+      case ParsedRtcEventLog::BWE_PACKET_LOSS_EVENT: {
+        int32_t bitrate;
+        uint8_t fraction_loss;
+        int32_t total_packets;
+        ASSERT_LT(bwe_loss_index, columns.bwe_loss.timestamp_us.size());
+        parsed_log.GetBwePacketLossEvent(i, &bitrate, &fraction_loss,
+                                         &total_packets);
+        EXPECT_EQ(parsed_log.GetTimestamp(i),
+                  columns.bwe_loss.timestamp_us[bwe_loss_index]);
+        EXPECT_EQ(bitrate, columns.bwe_loss.bitrate[bwe_loss_index]);
+        EXPECT_EQ(fraction_loss,
+                  columns.bwe_loss.fraction_loss[bwe_loss_index]);
+        EXPECT_EQ(total_packets,
+                  columns.bwe_loss.total_packets[bwe_loss_index]);
+        bwe_loss_index++;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  EXPECT_EQ(rtp_index, columns.rtp.timestamp_us.size());
+  EXPECT_EQ(rtcp_index, columns.rtcp.timestamp_us.size());
+  EXPECT_EQ(bwe_loss_index, columns.bwe_loss.timestamp_us.size());
+}
 }  // namespace
 
 /*
@@ -383,6 +452,11 @@ void LogSessionAndReadBack(size_t rtp_count,
     }
   }
 
+  // The streaming columnar parser must agree with the full parser.
+  RtcEventLogColumns columns;
+  ASSERT_TRUE(columns.ParseFile(temp_filename));
+  VerifyColumns(parsed_log, columns);
+
   // Clean up temporary file - can be pretty slow.
   remove(temp_filename.c_str());
 }
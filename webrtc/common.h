@@ -34,7 +34,9 @@ enum class ConfigOptionID {
   kBeamforming,
   kIntelligibility,
   kEchoCanceller3,
-  kAecRefinedAdaptiveFilter
+  kAecRefinedAdaptiveFilter,
+  kParallelPlayoutMixing,
+  kSharedSendEncoding
 };
 
 // Class Config is designed to ease passing a set of options across webrtc code.
@@ -10,8 +10,13 @@
 
 #include "webrtc/common_audio/include/audio_util.h"
 
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/typedefs.h"
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "webrtc/common_audio/audio_util_sse2.h"
+#endif
+
 namespace webrtc {
 
 void FloatToS16(const float* src, size_t size, int16_t* dest) {
@@ -25,8 +30,24 @@ void S16ToFloat(const int16_t* src, size_t size, float* dest) {
 }
 
 void FloatS16ToS16(const float* src, size_t size, int16_t* dest) {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  FloatS16ToS16_SSE2(src, size, dest);
+#else
+  // x86 CPU detection required.
+  static const bool has_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
+  if (has_sse2) {
+    FloatS16ToS16_SSE2(src, size, dest);
+  } else {
+    for (size_t i = 0; i < size; ++i)
+      dest[i] = FloatS16ToS16(src[i]);
+  }
+#endif
+#else
   for (size_t i = 0; i < size; ++i)
     dest[i] = FloatS16ToS16(src[i]);
+#endif
 }
 
 void FloatToFloatS16(const float* src, size_t size, float* dest) {
@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/audio_util_sse2.h"
+
+#include <emmintrin.h>
+
+#include "webrtc/common_audio/include/audio_util.h"
+
+namespace webrtc {
+
+// Clamps to the int16_t range before rounding half away from zero, which
+// gives the same result as the scalar version's saturation thresholds.
+void FloatS16ToS16_SSE2(const float* src, size_t size, int16_t* dest) {
+  const __m128 kMin = _mm_set1_ps(limits_int16::min());
+  const __m128 kMax = _mm_set1_ps(limits_int16::max());
+  const __m128 kHalf = _mm_set1_ps(0.5f);
+  const __m128 kSignMask = _mm_set1_ps(-0.f);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m128 lo = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&src[i]), kMin), kMax);
+    __m128 hi = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&src[i + 4]), kMin), kMax);
+    lo = _mm_add_ps(lo, _mm_or_ps(kHalf, _mm_and_ps(lo, kSignMask)));
+    hi = _mm_add_ps(hi, _mm_or_ps(kHalf, _mm_and_ps(hi, kSignMask)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[i]),
+                     _mm_packs_epi32(_mm_cvttps_epi32(lo),
+                                     _mm_cvttps_epi32(hi)));
+  }
+  for (; i < size; ++i)
+    dest[i] = FloatS16ToS16(src[i]);
+}
+
+}  // namespace webrtc
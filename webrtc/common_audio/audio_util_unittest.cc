@@ -68,6 +68,22 @@ TEST(AudioUtilTest, FloatS16ToS16) {
   ExpectArraysEq(kReference, output, kSize);
 }
 
+TEST(AudioUtilTest, FloatS16ToS16MatchesScalarConversion) {
+  // Long enough to exercise vectorized implementations, with values around
+  // every rounding and saturation threshold.
+  const size_t kSize = 19;
+  const float kInput[kSize] = {0.f,      -0.f,      1e-20f,    -1e-20f,
+                               0.49f,    0.5f,      -0.49f,    -0.5f,
+                               1.5f,     -1.5f,     32766.4f,  32766.5f,
+                               32767.f,  32768.f,   -32767.4f, -32767.5f,
+                               -32768.f, -32769.f,  1e10f};
+  int16_t output[kSize];
+  FloatS16ToS16(kInput, kSize, output);
+  for (size_t i = 0; i < kSize; ++i) {
+    EXPECT_EQ(FloatS16ToS16(kInput[i]), output[i]) << kInput[i];
+  }
+}
+
 TEST(AudioUtilTest, FloatToFloatS16) {
   const size_t kSize = 9;
   const float kInput[kSize] = {0.f,
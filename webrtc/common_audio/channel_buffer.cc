@@ -34,6 +34,18 @@ ChannelBuffer<float>* IFChannelBuffer::fbuf() {
   return &fbuf_;
 }
 
+ChannelBuffer<int16_t>* IFChannelBuffer::ibuf_overwrite() {
+  ivalid_ = true;
+  fvalid_ = false;
+  return &ibuf_;
+}
+
+ChannelBuffer<float>* IFChannelBuffer::fbuf_overwrite() {
+  fvalid_ = true;
+  ivalid_ = false;
+  return &fbuf_;
+}
+
 const ChannelBuffer<int16_t>* IFChannelBuffer::ibuf_const() const {
   RefreshI();
   return &ibuf_;
@@ -141,12 +141,18 @@ class ChannelBuffer {
 // therefore safe to use the return value of ibuf_const() and fbuf_const()
 // until the next call to ibuf() or fbuf(), and the return value of ibuf() and
 // fbuf() until the next call to any of the other functions.
+//
+// Writers that overwrite all of the data should use ibuf_overwrite() and
+// fbuf_overwrite() instead, which skip bringing the outdated ChannelBuffer in
+// sync before handing it out.
 class IFChannelBuffer {
  public:
   IFChannelBuffer(size_t num_frames, size_t num_channels, size_t num_bands = 1);
 
   ChannelBuffer<int16_t>* ibuf();
   ChannelBuffer<float>* fbuf();
+  ChannelBuffer<int16_t>* ibuf_overwrite();
+  ChannelBuffer<float>* fbuf_overwrite();
   const ChannelBuffer<int16_t>* ibuf_const() const;
   const ChannelBuffer<float>* fbuf_const() const;
 
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/common_audio/channel_buffer.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kNumFrames = 160;
+const size_t kNumChannels = 2;
+
+void FillInt(int16_t value, ChannelBuffer<int16_t>* buf) {
+  for (size_t i = 0; i < buf->num_channels(); ++i) {
+    for (size_t j = 0; j < buf->num_frames(); ++j) {
+      buf->channels()[i][j] = value;
+    }
+  }
+}
+
+void FillFloat(float value, ChannelBuffer<float>* buf) {
+  for (size_t i = 0; i < buf->num_channels(); ++i) {
+    for (size_t j = 0; j < buf->num_frames(); ++j) {
+      buf->channels()[i][j] = value;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(IFChannelBufferTest, SyncsAfterWriteAccess) {
+  IFChannelBuffer buf(kNumFrames, kNumChannels);
+  FillInt(100, buf.ibuf());
+  EXPECT_FLOAT_EQ(100.f, buf.fbuf_const()->channels()[1][kNumFrames - 1]);
+
+  FillFloat(-200.4f, buf.fbuf());
+  EXPECT_EQ(-200, buf.ibuf_const()->channels()[1][kNumFrames - 1]);
+}
+
+TEST(IFChannelBufferTest, OverwriteDiscardsOutdatedData) {
+  IFChannelBuffer buf(kNumFrames, kNumChannels);
+  FillFloat(300.f, buf.fbuf());
+  FillInt(-50, buf.ibuf_overwrite());
+  EXPECT_FLOAT_EQ(-50.f, buf.fbuf_const()->channels()[0][0]);
+  EXPECT_EQ(-50, buf.ibuf_const()->channels()[0][0]);
+
+  FillFloat(25.f, buf.fbuf_overwrite());
+  EXPECT_EQ(25, buf.ibuf_const()->channels()[1][kNumFrames - 1]);
+  EXPECT_FLOAT_EQ(25.f, buf.fbuf_const()->channels()[1][kNumFrames - 1]);
+}
+
+}  // namespace webrtc
@@ -34,6 +34,7 @@
         'audio_ring_buffer.cc',
         'audio_ring_buffer.h',
         'audio_util.cc',
+        'audio_util_sse2.h',
         'blocker.cc',
         'blocker.h',
         'channel_buffer.cc',
@@ -51,6 +52,7 @@
         'real_fourier.h',
         'real_fourier_ooura.cc',
         'real_fourier_ooura.h',
+        'real_fourier_sse.h',
         'resampler/include/push_resampler.h',
         'resampler/include/resampler.h',
         'resampler/push_resampler.cc',
@@ -134,7 +136,10 @@
           ],
         }],
         ['target_arch=="ia32" or target_arch=="x64"', {
-          'dependencies': ['common_audio_sse2',],
+          'dependencies': [
+            'common_audio_avx2',
+            'common_audio_sse2',
+          ],
         }],
         ['build_with_neon==1', {
           'dependencies': ['common_audio_neon',],
@@ -197,8 +202,14 @@
           'target_name': 'common_audio_sse2',
           'type': 'static_library',
           'sources': [
+            'audio_util_sse2.cc',
             'fir_filter_sse.cc',
+            'real_fourier_sse.cc',
             'resampler/sinc_resampler_sse.cc',
+            'signal_processing/cross_correlation_sse2.c',
+            'signal_processing/downsample_fast_sse2.c',
+            'signal_processing/min_max_operations_sse2.c',
+            'sparse_fir_filter_sse.cc',
           ],
           'conditions': [
             ['os_posix==1', {
@@ -209,6 +220,21 @@
             }],
           ],
         },
+        {
+          'target_name': 'common_audio_avx2',
+          'type': 'static_library',
+          'sources': [
+            'resampler/sinc_resampler_avx2.cc',
+          ],
+          'conditions': [
+            ['os_posix==1', {
+              'cflags': [ '-mavx2', ],
+              'xcode_settings': {
+                'OTHER_CFLAGS': [ '-mavx2', ],
+              },
+            }],
+          ],
+        },
       ],  # targets
     }],
     ['build_with_neon==1', {
@@ -223,6 +249,7 @@
             'signal_processing/cross_correlation_neon.c',
             'signal_processing/downsample_fast_neon.c',
             'signal_processing/min_max_operations_neon.c',
+            'sparse_fir_filter_neon.cc',
           ],
         },
       ],  # targets
@@ -243,6 +270,7 @@
             'audio_ring_buffer_unittest.cc',
             'audio_util_unittest.cc',
             'blocker_unittest.cc',
+            'channel_buffer_unittest.cc',
             'fir_filter_unittest.cc',
             'lapped_transform_unittest.cc',
             'real_fourier_unittest.cc',
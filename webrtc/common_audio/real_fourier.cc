@@ -13,7 +13,9 @@
 #include "webrtc/base/checks.h"
 #include "webrtc/common_audio/real_fourier_ooura.h"
 #include "webrtc/common_audio/real_fourier_openmax.h"
+#include "webrtc/common_audio/real_fourier_sse.h"
 #include "webrtc/common_audio/signal_processing/include/spl_inl.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 
@@ -25,6 +27,18 @@ std::unique_ptr<RealFourier> RealFourier::Create(int fft_order) {
 #if defined(RTC_USE_OPENMAX_DL)
   return std::unique_ptr<RealFourier>(new RealFourierOpenmax(fft_order));
 #else
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // Smaller transforms are too short to vectorize.
+  if (fft_order >= RealFourierSSE2::kMinOrder) {
+#if defined(__SSE2__)
+    return std::unique_ptr<RealFourier>(new RealFourierSSE2(fft_order));
+#else
+    // x86 CPU detection required.
+    if (WebRtc_GetCPUInfo(kSSE2))
+      return std::unique_ptr<RealFourier>(new RealFourierSSE2(fft_order));
+#endif
+  }
+#endif
   return std::unique_ptr<RealFourier>(new RealFourierOoura(fft_order));
 #endif
 }
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/common_audio/real_fourier.h"
+#include "webrtc/common_audio/real_fourier_ooura.h"
+#include "webrtc/common_audio/real_fourier_sse.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+namespace {
+const int kNumTransforms = 20000;
+
+// Times a forward and an inverse transform, which is what LappedTransform
+// does for every block, and reports the average in nanoseconds.
+void MeasureTransform(const RealFourier& fft, const std::string& name) {
+  const int length = 1 << fft.order();
+  RealFourier::fft_real_scoper real = RealFourier::AllocRealBuffer(length);
+  RealFourier::fft_cplx_scoper cplx =
+      RealFourier::AllocCplxBuffer(length / 2 + 1);
+  Random random(42);
+  for (int i = 0; i < length; ++i)
+    real[i] = static_cast<float>(random.Gaussian(0, 1));
+
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumTransforms; ++i) {
+    fft.Forward(real.get(), cplx.get());
+    fft.Inverse(cplx.get(), real.get());
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+
+  test::PrintResult("real_fourier_order_" + std::to_string(fft.order()), "",
+                    name, static_cast<size_t>(elapsed_ns / kNumTransforms),
+                    "ns", true);
+}
+}  // namespace
+
+// The orders used by LappedTransform in the beamformer and the
+// intelligibility enhancer: 128 to 512 samples per block, depending on the
+// sample rate.
+TEST(RealFourierPerformanceTest, LappedTransformOrders) {
+  for (int order = 7; order <= 9; ++order) {
+    MeasureTransform(RealFourierOoura(order), "ooura");
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (WebRtc_GetCPUInfo(kSSE2))
+      MeasureTransform(RealFourierSSE2(order), "sse2");
+#endif
+  }
+}
+
+}  // namespace webrtc
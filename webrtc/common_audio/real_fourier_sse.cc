@@ -0,0 +1,277 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/real_fourier_sse.h"
+
+#include <emmintrin.h>
+#include <math.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+
+using std::complex;
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+float* AllocFloats(size_t count) {
+  return static_cast<float*>(AlignedMalloc(sizeof(float) * count, 16));
+}
+
+// Reverses the order of the four elements.
+__m128 Reverse(__m128 v) {
+  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+}  // namespace
+
+RealFourierSSE2::RealFourierSSE2(int fft_order)
+    : order_(fft_order),
+      length_(FftLength(order_)),
+      half_length_(length_ / 2),
+      fft_twiddle_re_(AllocFloats(half_length_ / 2)),
+      fft_twiddle_im_(AllocFloats(half_length_ / 2)),
+      split_twiddle_re_(AllocFloats(half_length_)),
+      split_twiddle_im_(AllocFloats(half_length_)),
+      data_re_(AllocFloats(half_length_)),
+      data_im_(AllocFloats(half_length_)),
+      work_re_(AllocFloats(half_length_)),
+      work_im_(AllocFloats(half_length_)) {
+  RTC_CHECK_GE(fft_order, kMinOrder);
+  for (size_t j = 0; j < half_length_ / 2; ++j) {
+    const double phase = -2.0 * kPi * j / half_length_;
+    fft_twiddle_re_[j] = static_cast<float>(cos(phase));
+    fft_twiddle_im_[j] = static_cast<float>(sin(phase));
+  }
+  for (size_t k = 0; k < half_length_; ++k) {
+    const double phase = -2.0 * kPi * k / length_;
+    split_twiddle_re_[k] = static_cast<float>(cos(phase));
+    split_twiddle_im_[k] = static_cast<float>(sin(phase));
+  }
+}
+
+void RealFourierSSE2::ComplexFft(float* re, float* im) const {
+  const size_t n = half_length_;
+  const float* const twiddle_re = fft_twiddle_re_.get();
+  const float* const twiddle_im = fft_twiddle_im_.get();
+  float* x_re = re;
+  float* x_im = im;
+  float* y_re = work_re_.get();
+  float* y_im = work_im_.get();
+
+  // Each stage combines the two halves of the current sub-transforms, which
+  // are |half| elements apart, and interleaves the results so that the
+  // output ends up in natural order.
+  for (size_t stride = 1, half = n / 2; stride < n; stride *= 2, half /= 2) {
+    if (stride == 1) {
+      for (size_t p = 0; p < half; p += 4) {
+        const __m128 a_re = _mm_load_ps(&x_re[p]);
+        const __m128 a_im = _mm_load_ps(&x_im[p]);
+        const __m128 b_re = _mm_load_ps(&x_re[p + half]);
+        const __m128 b_im = _mm_load_ps(&x_im[p + half]);
+        const __m128 w_re = _mm_load_ps(&twiddle_re[p]);
+        const __m128 w_im = _mm_load_ps(&twiddle_im[p]);
+        const __m128 sum_re = _mm_add_ps(a_re, b_re);
+        const __m128 sum_im = _mm_add_ps(a_im, b_im);
+        const __m128 d_re = _mm_sub_ps(a_re, b_re);
+        const __m128 d_im = _mm_sub_ps(a_im, b_im);
+        const __m128 prod_re =
+            _mm_sub_ps(_mm_mul_ps(d_re, w_re), _mm_mul_ps(d_im, w_im));
+        const __m128 prod_im =
+            _mm_add_ps(_mm_mul_ps(d_re, w_im), _mm_mul_ps(d_im, w_re));
+        _mm_store_ps(&y_re[2 * p], _mm_unpacklo_ps(sum_re, prod_re));
+        _mm_store_ps(&y_re[2 * p + 4], _mm_unpackhi_ps(sum_re, prod_re));
+        _mm_store_ps(&y_im[2 * p], _mm_unpacklo_ps(sum_im, prod_im));
+        _mm_store_ps(&y_im[2 * p + 4], _mm_unpackhi_ps(sum_im, prod_im));
+      }
+    } else if (stride == 2) {
+      // Two sub-transforms at a time, with their twiddle factors duplicated.
+      for (size_t p = 0; p < half; p += 2) {
+        const __m128 a_re = _mm_load_ps(&x_re[2 * p]);
+        const __m128 a_im = _mm_load_ps(&x_im[2 * p]);
+        const __m128 b_re = _mm_load_ps(&x_re[2 * (p + half)]);
+        const __m128 b_im = _mm_load_ps(&x_im[2 * (p + half)]);
+        const __m128 t_re = _mm_load_ps(&twiddle_re[2 * p]);
+        const __m128 t_im = _mm_load_ps(&twiddle_im[2 * p]);
+        const __m128 w_re =
+            _mm_shuffle_ps(t_re, t_re, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 w_im =
+            _mm_shuffle_ps(t_im, t_im, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 sum_re = _mm_add_ps(a_re, b_re);
+        const __m128 sum_im = _mm_add_ps(a_im, b_im);
+        const __m128 d_re = _mm_sub_ps(a_re, b_re);
+        const __m128 d_im = _mm_sub_ps(a_im, b_im);
+        const __m128 prod_re =
+            _mm_sub_ps(_mm_mul_ps(d_re, w_re), _mm_mul_ps(d_im, w_im));
+        const __m128 prod_im =
+            _mm_add_ps(_mm_mul_ps(d_re, w_im), _mm_mul_ps(d_im, w_re));
+        _mm_store_ps(&y_re[4 * p], _mm_movelh_ps(sum_re, prod_re));
+        _mm_store_ps(&y_re[4 * p + 4], _mm_movehl_ps(prod_re, sum_re));
+        _mm_store_ps(&y_im[4 * p], _mm_movelh_ps(sum_im, prod_im));
+        _mm_store_ps(&y_im[4 * p + 4], _mm_movehl_ps(prod_im, sum_im));
+      }
+    } else {
+      for (size_t p = 0; p < half; ++p) {
+        const __m128 w_re = _mm_set1_ps(twiddle_re[p * stride]);
+        const __m128 w_im = _mm_set1_ps(twiddle_im[p * stride]);
+        const size_t a = stride * p;
+        const size_t b = stride * (p + half);
+        const size_t sum = stride * 2 * p;
+        const size_t prod = stride * (2 * p + 1);
+        for (size_t q = 0; q < stride; q += 4) {
+          const __m128 a_re = _mm_load_ps(&x_re[a + q]);
+          const __m128 a_im = _mm_load_ps(&x_im[a + q]);
+          const __m128 b_re = _mm_load_ps(&x_re[b + q]);
+          const __m128 b_im = _mm_load_ps(&x_im[b + q]);
+          const __m128 d_re = _mm_sub_ps(a_re, b_re);
+          const __m128 d_im = _mm_sub_ps(a_im, b_im);
+          _mm_store_ps(&y_re[sum + q], _mm_add_ps(a_re, b_re));
+          _mm_store_ps(&y_im[sum + q], _mm_add_ps(a_im, b_im));
+          _mm_store_ps(&y_re[prod + q], _mm_sub_ps(_mm_mul_ps(d_re, w_re),
+                                                   _mm_mul_ps(d_im, w_im)));
+          _mm_store_ps(&y_im[prod + q], _mm_add_ps(_mm_mul_ps(d_re, w_im),
+                                                   _mm_mul_ps(d_im, w_re)));
+        }
+      }
+    }
+    std::swap(x_re, y_re);
+    std::swap(x_im, y_im);
+  }
+
+  if (x_re != re) {
+    std::copy(x_re, x_re + n, re);
+    std::copy(x_im, x_im + n, im);
+  }
+}
+
+void RealFourierSSE2::Forward(const float* src, complex<float>* dest) const {
+  const size_t n = half_length_;
+  float* const re = data_re_.get();
+  float* const im = data_im_.get();
+  const float* const t_re = split_twiddle_re_.get();
+  const float* const t_im = split_twiddle_im_.get();
+
+  // Pack the even samples into the real part and the odd samples into the
+  // imaginary part of a complex signal of half the length.
+  for (size_t i = 0; i < n; i += 4) {
+    const __m128 a = _mm_loadu_ps(&src[2 * i]);
+    const __m128 b = _mm_loadu_ps(&src[2 * i + 4]);
+    _mm_store_ps(&re[i], _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_store_ps(&im[i], _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+
+  ComplexFft(re, im);
+
+  // Split Z into the spectra E of the even and O of the odd samples, and
+  // combine them as X[k] = E[k] + exp(-2 pi i k / length) O[k].
+  dest[0] = complex<float>(re[0] + im[0], 0.f);
+  dest[n] = complex<float>(re[0] - im[0], 0.f);
+  const __m128 kHalf = _mm_set1_ps(0.5f);
+  float* const dest_float = reinterpret_cast<float*>(dest);
+  size_t k = 1;
+  for (; k + 4 <= n; k += 4) {
+    const __m128 a_re = _mm_loadu_ps(&re[k]);
+    const __m128 a_im = _mm_loadu_ps(&im[k]);
+    const __m128 b_re = Reverse(_mm_loadu_ps(&re[n - k - 3]));
+    const __m128 b_im = Reverse(_mm_loadu_ps(&im[n - k - 3]));
+    const __m128 w_re = _mm_loadu_ps(&t_re[k]);
+    const __m128 w_im = _mm_loadu_ps(&t_im[k]);
+    const __m128 e_re = _mm_mul_ps(kHalf, _mm_add_ps(a_re, b_re));
+    const __m128 e_im = _mm_mul_ps(kHalf, _mm_sub_ps(a_im, b_im));
+    const __m128 o_re = _mm_mul_ps(kHalf, _mm_add_ps(a_im, b_im));
+    const __m128 o_im = _mm_mul_ps(kHalf, _mm_sub_ps(b_re, a_re));
+    const __m128 x_re = _mm_add_ps(
+        e_re, _mm_sub_ps(_mm_mul_ps(w_re, o_re), _mm_mul_ps(w_im, o_im)));
+    const __m128 x_im = _mm_add_ps(
+        e_im, _mm_add_ps(_mm_mul_ps(w_re, o_im), _mm_mul_ps(w_im, o_re)));
+    _mm_storeu_ps(&dest_float[2 * k], _mm_unpacklo_ps(x_re, x_im));
+    _mm_storeu_ps(&dest_float[2 * k + 4], _mm_unpackhi_ps(x_re, x_im));
+  }
+  for (; k < n; ++k) {
+    const float e_re = 0.5f * (re[k] + re[n - k]);
+    const float e_im = 0.5f * (im[k] - im[n - k]);
+    const float o_re = 0.5f * (im[k] + im[n - k]);
+    const float o_im = 0.5f * (re[n - k] - re[k]);
+    dest[k] = complex<float>(e_re + t_re[k] * o_re - t_im[k] * o_im,
+                             e_im + t_re[k] * o_im + t_im[k] * o_re);
+  }
+}
+
+void RealFourierSSE2::Inverse(const complex<float>* src, float* dest) const {
+  const size_t n = half_length_;
+  float* const re = data_re_.get();
+  float* const im = data_im_.get();
+  const float* const t_re = split_twiddle_re_.get();
+  const float* const t_im = split_twiddle_im_.get();
+  const float scale = 1.f / length_;
+
+  // Undo the split: Z[k] = E[k] + i O[k], with the 1 / length scaling of the
+  // inverse transform folded in. As for Ooura, the imaginary parts of X[0]
+  // and X[n] are ignored.
+  re[0] = scale * (src[0].real() + src[n].real());
+  im[0] = scale * (src[0].real() - src[n].real());
+  const __m128 kScale = _mm_set1_ps(scale);
+  const float* const src_float = reinterpret_cast<const float*>(src);
+  size_t k = 1;
+  for (; k + 4 <= n; k += 4) {
+    const __m128 a_lo = _mm_loadu_ps(&src_float[2 * k]);
+    const __m128 a_hi = _mm_loadu_ps(&src_float[2 * k + 4]);
+    const __m128 b_lo = _mm_loadu_ps(&src_float[2 * (n - k - 3)]);
+    const __m128 b_hi = _mm_loadu_ps(&src_float[2 * (n - k - 3) + 4]);
+    const __m128 a_re = _mm_shuffle_ps(a_lo, a_hi, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 a_im = _mm_shuffle_ps(a_lo, a_hi, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m128 b_re =
+        Reverse(_mm_shuffle_ps(b_lo, b_hi, _MM_SHUFFLE(2, 0, 2, 0)));
+    const __m128 b_im =
+        Reverse(_mm_shuffle_ps(b_lo, b_hi, _MM_SHUFFLE(3, 1, 3, 1)));
+    const __m128 w_re = _mm_loadu_ps(&t_re[k]);
+    const __m128 w_im = _mm_loadu_ps(&t_im[k]);
+    const __m128 e_re = _mm_add_ps(a_re, b_re);
+    const __m128 e_im = _mm_sub_ps(a_im, b_im);
+    const __m128 d_re = _mm_sub_ps(a_re, b_re);
+    const __m128 d_im = _mm_add_ps(a_im, b_im);
+    const __m128 o_re =
+        _mm_add_ps(_mm_mul_ps(d_re, w_re), _mm_mul_ps(d_im, w_im));
+    const __m128 o_im =
+        _mm_sub_ps(_mm_mul_ps(d_im, w_re), _mm_mul_ps(d_re, w_im));
+    _mm_storeu_ps(&re[k], _mm_mul_ps(kScale, _mm_sub_ps(e_re, o_im)));
+    _mm_storeu_ps(&im[k], _mm_mul_ps(kScale, _mm_add_ps(e_im, o_re)));
+  }
+  for (; k < n; ++k) {
+    const complex<float> a = src[k];
+    const complex<float> b = src[n - k];
+    const float e_re = a.real() + b.real();
+    const float e_im = a.imag() - b.imag();
+    const float d_re = a.real() - b.real();
+    const float d_im = a.imag() + b.imag();
+    const float o_re = d_re * t_re[k] + d_im * t_im[k];
+    const float o_im = d_im * t_re[k] - d_re * t_im[k];
+    re[k] = scale * (e_re - o_im);
+    im[k] = scale * (e_im + o_re);
+  }
+
+  // The inverse FFT is the forward FFT with the real and imaginary parts
+  // swapped on input and output.
+  ComplexFft(im, re);
+
+  for (size_t i = 0; i < n; i += 4) {
+    const __m128 z_re = _mm_load_ps(&re[i]);
+    const __m128 z_im = _mm_load_ps(&im[i]);
+    _mm_storeu_ps(&dest[2 * i], _mm_unpacklo_ps(z_re, z_im));
+    _mm_storeu_ps(&dest[2 * i + 4], _mm_unpackhi_ps(z_re, z_im));
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_COMMON_AUDIO_REAL_FOURIER_SSE_H_
+#define WEBRTC_COMMON_AUDIO_REAL_FOURIER_SSE_H_
+
+#include <complex>
+#include <memory>
+
+#include "webrtc/common_audio/real_fourier.h"
+#include "webrtc/system_wrappers/include/aligned_malloc.h"
+
+namespace webrtc {
+
+// Real DFT using SSE2. The 2^order real samples are transformed as a complex
+// FFT of half the length, computed with a radix-2 Stockham FFT on separate
+// real and imaginary arrays so that every butterfly stage works on four bins
+// at a time, followed by the usual split into the real spectrum.
+class RealFourierSSE2 : public RealFourier {
+ public:
+  // The smallest order for which every stage can be vectorized. Create()
+  // falls back to Ooura for smaller orders.
+  static const int kMinOrder = 4;
+
+  explicit RealFourierSSE2(int fft_order);
+
+  void Forward(const float* src, std::complex<float>* dest) const override;
+  void Inverse(const std::complex<float>* src, float* dest) const override;
+
+  int order() const override { return order_; }
+
+ private:
+  typedef std::unique_ptr<float[], AlignedFreeDeleter> AlignedFloats;
+
+  // Forward complex FFT of length |half_length_| on |re| and |im|. Uses the
+  // work arrays and leaves the result in |re| and |im|.
+  void ComplexFft(float* re, float* im) const;
+
+  const int order_;
+  const size_t length_;
+  const size_t half_length_;
+  // exp(-2 pi i j / half_length_) for j < half_length_ / 2, used by the
+  // complex FFT.
+  const AlignedFloats fft_twiddle_re_;
+  const AlignedFloats fft_twiddle_im_;
+  // exp(-2 pi i k / length_) for k < half_length_, used to split the complex
+  // spectrum into the real one.
+  const AlignedFloats split_twiddle_re_;
+  const AlignedFloats split_twiddle_im_;
+  // Work arrays, written by the const transforms.
+  const AlignedFloats data_re_;
+  const AlignedFloats data_im_;
+  const AlignedFloats work_re_;
+  const AlignedFloats work_im_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_COMMON_AUDIO_REAL_FOURIER_SSE_H_
@@ -13,8 +13,12 @@
 #include <stdlib.h>
 
 #include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
 #include "webrtc/common_audio/real_fourier_openmax.h"
 #include "webrtc/common_audio/real_fourier_ooura.h"
+#include "webrtc/common_audio/real_fourier_sse.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#include "webrtc/typedefs.h"
 
 namespace webrtc {
 
@@ -105,5 +109,59 @@ TYPED_TEST(RealFourierTest, SimpleBackwardTransform) {
   EXPECT_NEAR(this->real_buffer_[3], 4.0f, 1e-8f);
 }
 
+TEST(RealFourierCreateTest, RoundTrip) {
+  Random random(42);
+  for (int order = 1; order <= 10; ++order) {
+    SCOPED_TRACE(order);
+    std::unique_ptr<RealFourier> fft = RealFourier::Create(order);
+    ASSERT_EQ(order, fft->order());
+    const int length = 1 << order;
+    RealFourier::fft_real_scoper real = RealFourier::AllocRealBuffer(length);
+    RealFourier::fft_real_scoper inverse = RealFourier::AllocRealBuffer(length);
+    RealFourier::fft_cplx_scoper cplx =
+        RealFourier::AllocCplxBuffer(length / 2 + 1);
+    for (int i = 0; i < length; ++i)
+      real[i] = static_cast<float>(random.Gaussian(0, 1));
+    fft->Forward(real.get(), cplx.get());
+    fft->Inverse(cplx.get(), inverse.get());
+    for (int i = 0; i < length; ++i)
+      EXPECT_NEAR(real[i], inverse[i], 1e-5f);
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(RealFourierSSE2Test, MatchesOoura) {
+  if (!WebRtc_GetCPUInfo(kSSE2))
+    return;
+  Random random(42);
+  for (int order = RealFourierSSE2::kMinOrder; order <= 10; ++order) {
+    SCOPED_TRACE(order);
+    RealFourierSSE2 sse2(order);
+    RealFourierOoura ooura(order);
+    const int length = 1 << order;
+    const int complex_length = length / 2 + 1;
+    RealFourier::fft_real_scoper real = RealFourier::AllocRealBuffer(length);
+    RealFourier::fft_cplx_scoper cplx_sse2 =
+        RealFourier::AllocCplxBuffer(complex_length);
+    RealFourier::fft_cplx_scoper cplx_ooura =
+        RealFourier::AllocCplxBuffer(complex_length);
+    for (int i = 0; i < length; ++i)
+      real[i] = static_cast<float>(random.Gaussian(0, 1));
+
+    sse2.Forward(real.get(), cplx_sse2.get());
+    ooura.Forward(real.get(), cplx_ooura.get());
+    for (int i = 0; i < complex_length; ++i) {
+      EXPECT_NEAR(cplx_ooura[i].real(), cplx_sse2[i].real(), 1e-4f);
+      EXPECT_NEAR(cplx_ooura[i].imag(), cplx_sse2[i].imag(), 1e-4f);
+    }
+
+    RealFourier::fft_real_scoper inverse = RealFourier::AllocRealBuffer(length);
+    sse2.Inverse(cplx_sse2.get(), inverse.get());
+    for (int i = 0; i < length; ++i)
+      EXPECT_NEAR(real[i], inverse[i], 1e-5f);
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
 }  // namespace webrtc
 
@@ -12,6 +12,7 @@
 #define WEBRTC_COMMON_AUDIO_RESAMPLER_INCLUDE_PUSH_RESAMPLER_H_
 
 #include <memory>
+#include <vector>
 
 #include "webrtc/typedefs.h"
 
@@ -19,8 +20,9 @@ namespace webrtc {
 
 class PushSincResampler;
 
-// Wraps PushSincResampler to provide stereo support.
-// TODO(ajm): add support for an arbitrary number of channels.
+// Wraps PushSincResampler to provide support for interleaved audio with any
+// number of channels. All buffers are allocated by InitializeIfNeeded(), so
+// Resample() does not allocate.
 template <typename T>
 class PushResampler {
  public:
@@ -37,15 +39,17 @@ class PushResampler {
   int Resample(const T* src, size_t src_length, T* dst, size_t dst_capacity);
 
  private:
-  std::unique_ptr<PushSincResampler> sinc_resampler_;
-  std::unique_ptr<PushSincResampler> sinc_resampler_right_;
+  // One resampler per channel.
+  std::vector<std::unique_ptr<PushSincResampler>> sinc_resamplers_;
   int src_sample_rate_hz_;
   int dst_sample_rate_hz_;
   size_t num_channels_;
-  std::unique_ptr<T[]> src_left_;
-  std::unique_ptr<T[]> src_right_;
-  std::unique_ptr<T[]> dst_left_;
-  std::unique_ptr<T[]> dst_right_;
+  // Deinterleaved source and destination audio, with 10 ms of each channel
+  // stored back-to-back. Only used for more than one channel.
+  std::unique_ptr<T[]> src_deinterleaved_;
+  std::unique_ptr<T[]> dst_deinterleaved_;
+  std::vector<T*> src_channels_;
+  std::vector<T*> dst_channels_;
 };
 
 }  // namespace webrtc
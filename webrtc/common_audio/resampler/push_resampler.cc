@@ -39,8 +39,7 @@ int PushResampler<T>::InitializeIfNeeded(int src_sample_rate_hz,
     // No-op if settings haven't changed.
     return 0;
 
-  if (src_sample_rate_hz <= 0 || dst_sample_rate_hz <= 0 ||
-      num_channels <= 0 || num_channels > 2)
+  if (src_sample_rate_hz <= 0 || dst_sample_rate_hz <= 0 || num_channels <= 0)
     return -1;
 
   src_sample_rate_hz_ = src_sample_rate_hz;
@@ -51,15 +50,24 @@ int PushResampler<T>::InitializeIfNeeded(int src_sample_rate_hz,
       static_cast<size_t>(src_sample_rate_hz / 100);
   const size_t dst_size_10ms_mono =
       static_cast<size_t>(dst_sample_rate_hz / 100);
-  sinc_resampler_.reset(new PushSincResampler(src_size_10ms_mono,
-                                              dst_size_10ms_mono));
-  if (num_channels_ == 2) {
-    src_left_.reset(new T[src_size_10ms_mono]);
-    src_right_.reset(new T[src_size_10ms_mono]);
-    dst_left_.reset(new T[dst_size_10ms_mono]);
-    dst_right_.reset(new T[dst_size_10ms_mono]);
-    sinc_resampler_right_.reset(new PushSincResampler(src_size_10ms_mono,
-                                                      dst_size_10ms_mono));
+  sinc_resamplers_.clear();
+  for (size_t i = 0; i < num_channels_; ++i) {
+    sinc_resamplers_.push_back(std::unique_ptr<PushSincResampler>(
+        new PushSincResampler(src_size_10ms_mono, dst_size_10ms_mono)));
+  }
+
+  src_channels_.clear();
+  dst_channels_.clear();
+  if (num_channels_ > 1) {
+    src_deinterleaved_.reset(new T[src_size_10ms_mono * num_channels_]);
+    dst_deinterleaved_.reset(new T[dst_size_10ms_mono * num_channels_]);
+    for (size_t i = 0; i < num_channels_; ++i) {
+      src_channels_.push_back(&src_deinterleaved_[i * src_size_10ms_mono]);
+      dst_channels_.push_back(&dst_deinterleaved_[i * dst_size_10ms_mono]);
+    }
+  } else {
+    src_deinterleaved_.reset();
+    dst_deinterleaved_.reset();
   }
 
   return 0;
@@ -79,26 +87,24 @@ int PushResampler<T>::Resample(const T* src, size_t src_length, T* dst,
     memcpy(dst, src, src_length * sizeof(T));
     return static_cast<int>(src_length);
   }
-  if (num_channels_ == 2) {
-    const size_t src_length_mono = src_length / num_channels_;
-    const size_t dst_capacity_mono = dst_capacity / num_channels_;
-    T* deinterleaved[] = {src_left_.get(), src_right_.get()};
-    Deinterleave(src, src_length_mono, num_channels_, deinterleaved);
-
-    size_t dst_length_mono =
-        sinc_resampler_->Resample(src_left_.get(), src_length_mono,
-                                  dst_left_.get(), dst_capacity_mono);
-    sinc_resampler_right_->Resample(src_right_.get(), src_length_mono,
-                                    dst_right_.get(), dst_capacity_mono);
-
-    deinterleaved[0] = dst_left_.get();
-    deinterleaved[1] = dst_right_.get();
-    Interleave(deinterleaved, dst_length_mono, num_channels_, dst);
-    return static_cast<int>(dst_length_mono * num_channels_);
-  } else {
+  if (num_channels_ == 1) {
     return static_cast<int>(
-        sinc_resampler_->Resample(src, src_length, dst, dst_capacity));
+        sinc_resamplers_[0]->Resample(src, src_length, dst, dst_capacity));
   }
+
+  const size_t src_length_mono = src_length / num_channels_;
+  const size_t dst_capacity_mono = dst_size_10ms / num_channels_;
+  Deinterleave(src, src_length_mono, num_channels_, src_channels_.data());
+
+  size_t dst_length_mono = 0;
+  for (size_t i = 0; i < num_channels_; ++i) {
+    dst_length_mono = sinc_resamplers_[i]->Resample(
+        src_channels_[i], src_length_mono, dst_channels_[i],
+        dst_capacity_mono);
+  }
+
+  Interleave(dst_channels_.data(), dst_length_mono, num_channels_, dst);
+  return static_cast<int>(dst_length_mono * num_channels_);
 }
 
 // Explictly generate required instantiations.
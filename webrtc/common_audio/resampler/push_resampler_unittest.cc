@@ -8,6 +8,10 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <math.h>
+
+#include <vector>
+
 #include "testing/gtest/include/gtest/gtest.h"
 #include "webrtc/common_audio/resampler/include/push_resampler.h"
 
@@ -20,9 +24,51 @@ TEST(PushResamplerTest, VerifiesInputParameters) {
   EXPECT_EQ(-1, resampler.InitializeIfNeeded(-1, 16000, 1));
   EXPECT_EQ(-1, resampler.InitializeIfNeeded(16000, -1, 1));
   EXPECT_EQ(-1, resampler.InitializeIfNeeded(16000, 16000, 0));
-  EXPECT_EQ(-1, resampler.InitializeIfNeeded(16000, 16000, 3));
   EXPECT_EQ(0, resampler.InitializeIfNeeded(16000, 16000, 1));
   EXPECT_EQ(0, resampler.InitializeIfNeeded(16000, 16000, 2));
+  EXPECT_EQ(0, resampler.InitializeIfNeeded(16000, 16000, 6));
+}
+
+// Each channel of an interleaved multi-channel signal must come out exactly as
+// if it had been resampled on its own.
+TEST(PushResamplerTest, MultiChannelMatchesMono) {
+  const int kSrcRateHz = 48000;
+  const int kDstRateHz = 16000;
+  const size_t kNumChannels = 6;
+  const size_t kSrcLengthMono = kSrcRateHz / 100;
+  const size_t kDstLengthMono = kDstRateHz / 100;
+
+  PushResampler<float> multi;
+  ASSERT_EQ(0, multi.InitializeIfNeeded(kSrcRateHz, kDstRateHz, kNumChannels));
+  std::vector<PushResampler<float>> mono(kNumChannels);
+  for (auto& resampler : mono)
+    ASSERT_EQ(0, resampler.InitializeIfNeeded(kSrcRateHz, kDstRateHz, 1));
+
+  std::vector<float> src(kSrcLengthMono * kNumChannels);
+  std::vector<float> dst(kDstLengthMono * kNumChannels);
+  std::vector<float> src_mono(kSrcLengthMono);
+  std::vector<float> dst_mono(kDstLengthMono);
+  for (int frame = 0; frame < 5; ++frame) {
+    for (size_t i = 0; i < kSrcLengthMono; ++i) {
+      for (size_t ch = 0; ch < kNumChannels; ++ch) {
+        const float t = static_cast<float>(frame * kSrcLengthMono + i);
+        src[i * kNumChannels + ch] =
+            1000.f * (ch + 1) * sinf(0.01f * (ch + 1) * t);
+      }
+    }
+    ASSERT_EQ(static_cast<int>(dst.size()),
+              multi.Resample(src.data(), src.size(), dst.data(), dst.size()));
+
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      for (size_t i = 0; i < kSrcLengthMono; ++i)
+        src_mono[i] = src[i * kNumChannels + ch];
+      ASSERT_EQ(static_cast<int>(kDstLengthMono),
+                mono[ch].Resample(src_mono.data(), src_mono.size(),
+                                  dst_mono.data(), dst_mono.size()));
+      for (size_t i = 0; i < kDstLengthMono; ++i)
+        EXPECT_EQ(dst_mono[i], dst[i * kNumChannels + ch]);
+    }
+  }
 }
 
 }  // namespace webrtc
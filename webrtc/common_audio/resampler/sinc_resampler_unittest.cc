@@ -164,6 +164,34 @@ TEST(SincResamplerTest, Convolve) {
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(SincResamplerTest, ConvolveAvx2) {
+  if (!WebRtc_GetCPUInfo(kAVX2))
+    return;
+
+  // Initialize a dummy resampler.
+  MockSource mock_source;
+  SincResampler resampler(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                          &mock_source);
+
+  static const double kEpsilon = 0.00000005;
+
+  // Check every input alignment and a few kernel pairs.
+  const float* const kernels = resampler.kernel_storage_.get();
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t k = 0; k < SincResampler::kKernelOffsetCount; k += 7) {
+      const float* const k1 = kernels + k * SincResampler::kKernelSize;
+      const float* const k2 = k1 + SincResampler::kKernelSize;
+      const double result = resampler.Convolve_C(
+          kernels + offset, k1, k2, kKernelInterpolationFactor);
+      const double result2 = resampler.Convolve_AVX2(
+          kernels + offset, k1, k2, kKernelInterpolationFactor);
+      EXPECT_NEAR(result2, result, kEpsilon);
+    }
+  }
+}
+#endif
+
 // Benchmark for the various Convolve() methods.  Make sure to build with
 // branding=Chrome so that RTC_DCHECKs are compiled out when benchmarking.
 // Original benchmarks were run with --convolve-iterations=50000000.
@@ -351,7 +379,7 @@ INSTANTIATE_TEST_CASE_P(
         std::tr1::make_tuple(16000, 44100, kResamplingRMSError, -62.54),
         std::tr1::make_tuple(22050, 44100, kResamplingRMSError, -73.53),
         std::tr1::make_tuple(32000, 44100, kResamplingRMSError, -63.32),
-        std::tr1::make_tuple(44100, 44100, kResamplingRMSError, -73.53),
+        std::tr1::make_tuple(44100, 44100, kResamplingRMSError, -73.52),
         std::tr1::make_tuple(48000, 44100, -15.01, -64.04),
         std::tr1::make_tuple(96000, 44100, -18.49, -25.51),
         std::tr1::make_tuple(192000, 44100, -20.50, -13.31),
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+// Returns the sum of the four 32 bit elements of |sum|.
+static inline int32_t AddAcross(__m128i sum) {
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// Computes the dot product of |vector1| and |vector2| with every product
+// shifted right by |scaling| before it is accumulated, exactly like the C
+// version. Two lags are computed per call to share the loads of |vector1|.
+static inline void DotProductsWithScaleSSE2(const int16_t* vector1,
+                                            const int16_t* vector2_a,
+                                            const int16_t* vector2_b,
+                                            size_t length,
+                                            int scaling,
+                                            int32_t* result_a,
+                                            int32_t* result_b) {
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  __m128i sum_a = _mm_setzero_si128();
+  __m128i sum_b = _mm_setzero_si128();
+  size_t i = 0;
+
+  for (; i + 8 <= length; i += 8) {
+    const __m128i seq1 = _mm_loadu_si128((const __m128i*)(vector1 + i));
+    const __m128i seq2_a = _mm_loadu_si128((const __m128i*)(vector2_a + i));
+    const __m128i seq2_b = _mm_loadu_si128((const __m128i*)(vector2_b + i));
+    // Interleave the low and high halves of the 16 x 16 bit products to get
+    // the full 32 bit products.
+    __m128i lo = _mm_mullo_epi16(seq1, seq2_a);
+    __m128i hi = _mm_mulhi_epi16(seq1, seq2_a);
+    sum_a = _mm_add_epi32(sum_a,
+                          _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi), shift));
+    sum_a = _mm_add_epi32(sum_a,
+                          _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi), shift));
+    lo = _mm_mullo_epi16(seq1, seq2_b);
+    hi = _mm_mulhi_epi16(seq1, seq2_b);
+    sum_b = _mm_add_epi32(sum_b,
+                          _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi), shift));
+    sum_b = _mm_add_epi32(sum_b,
+                          _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi), shift));
+  }
+
+  // The C version lets the sums wrap around; do the same here.
+  uint32_t tail_a = (uint32_t)AddAcross(sum_a);
+  uint32_t tail_b = (uint32_t)AddAcross(sum_b);
+  for (; i < length; i++) {
+    tail_a += (uint32_t)((vector1[i] * vector2_a[i]) >> scaling);
+    tail_b += (uint32_t)((vector1[i] * vector2_b[i]) >> scaling);
+  }
+  *result_a = (int32_t)tail_a;
+  *result_b = (int32_t)tail_b;
+}
+
+/* SSE2 version of WebRtcSpl_CrossCorrelation() for x86 platforms. This
+ * version is bit-exact with WebRtcSpl_CrossCorrelationC(). */
+void WebRtcSpl_CrossCorrelationSSE2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  size_t i = 0;
+
+  for (; i + 2 <= dim_cross_correlation; i += 2) {
+    DotProductsWithScaleSSE2(seq1, seq2, seq2 + step_seq2, dim_seq,
+                             right_shifts, &cross_correlation[i],
+                             &cross_correlation[i + 1]);
+    seq2 += 2 * step_seq2;
+  }
+  if (i < dim_cross_correlation) {
+    int32_t unused;
+    DotProductsWithScaleSSE2(seq1, seq2, seq2, dim_seq, right_shifts,
+                             &cross_correlation[i], &unused);
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+// Returns the sum of the four 32 bit elements of |sum|.
+static inline int32_t AddAcross(__m128i sum) {
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// Reverses the order of the eight 16 bit elements of |v|.
+static inline __m128i Reverse(__m128i v) {
+  v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+  v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+  return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+/* SSE2 version of WebRtcSpl_DownsampleFast() for x86 platforms. The sums wrap
+ * around like those of the C version, so this version is bit-exact with
+ * WebRtcSpl_DownsampleFastC(). */
+int WebRtcSpl_DownsampleFastSSE2(const int16_t* data_in,
+                                 size_t data_in_length,
+                                 int16_t* data_out,
+                                 size_t data_out_length,
+                                 const int16_t* __restrict coefficients,
+                                 size_t coefficients_length,
+                                 int factor,
+                                 size_t delay) {
+  size_t i = 0;
+  size_t j = 0;
+  size_t endpos = delay + factor * (data_out_length - 1) + 1;
+
+  // Return error if any of the running conditions doesn't meet.
+  if (data_out_length == 0 || coefficients_length == 0
+                           || data_in_length < endpos) {
+    return -1;
+  }
+
+  for (i = delay; i < endpos; i += factor) {
+    __m128i sum = _mm_setzero_si128();
+    uint32_t out_u32;
+
+    // The input runs backwards relative to the coefficients, so reverse it
+    // eight samples at a time.
+    for (j = 0; j + 8 <= coefficients_length; j += 8) {
+      const __m128i coefs =
+          _mm_loadu_si128((const __m128i*)(coefficients + j));
+      const __m128i data = Reverse(
+          _mm_loadu_si128((const __m128i*)(data_in + i - j - 7)));
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(coefs, data));
+    }
+    out_u32 = 2048 + (uint32_t)AddAcross(sum);  // Round value, 0.5 in Q12.
+    for (; j < coefficients_length; j++) {
+      out_u32 += (uint32_t)(coefficients[j] * data_in[i - j]);  // Q12.
+    }
+
+    // Saturate and store the output.
+    *data_out++ = WebRtcSpl_SatW32ToW16((int32_t)out_u32 >> 12);  // Q0.
+  }
+
+  return 0;
+}
@@ -67,7 +67,8 @@ int32_t WebRtcSpl_MaxAbsValueW32C(const int32_t* vector, size_t length) {
   assert(length > 0);
 
   for (i = 0; i < length; i++) {
-    absolute = abs((int)vector[i]);
+    // abs() of 0x80000000 is undefined, so negate as unsigned instead.
+    absolute = vector[i] < 0 ? 0u - (uint32_t)vector[i] : (uint32_t)vector[i];
     if (absolute > maximum) {
       maximum = absolute;
     }
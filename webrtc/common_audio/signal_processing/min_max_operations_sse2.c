@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <emmintrin.h>
+#include <stdlib.h>
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+// SSE2 has no 32 bit min and max instructions, so select with a compare.
+static inline __m128i MaxW32(__m128i a, __m128i b) {
+  const __m128i a_greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(a_greater, a),
+                      _mm_andnot_si128(a_greater, b));
+}
+
+static inline __m128i MinW32(__m128i a, __m128i b) {
+  const __m128i a_greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(a_greater, b),
+                      _mm_andnot_si128(a_greater, a));
+}
+
+static inline int16_t MaxAcrossW16(__m128i v) {
+  v = _mm_max_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_max_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  v = _mm_max_epi16(v, _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return (int16_t)_mm_cvtsi128_si32(v);
+}
+
+static inline int16_t MinAcrossW16(__m128i v) {
+  v = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  v = _mm_min_epi16(v, _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return (int16_t)_mm_cvtsi128_si32(v);
+}
+
+static inline int32_t MaxAcrossW32(__m128i v) {
+  v = MaxW32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = MaxW32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(v);
+}
+
+static inline int32_t MinAcrossW32(__m128i v) {
+  v = MinW32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = MinW32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(v);
+}
+
+// Finds both extremes of a word16 vector in one pass, for the maximum absolute
+// value.
+static void MinMaxW16(const int16_t* vector,
+                      size_t length,
+                      int16_t* minimum,
+                      int16_t* maximum) {
+  int16_t min_value = WEBRTC_SPL_WORD16_MAX;
+  int16_t max_value = WEBRTC_SPL_WORD16_MIN;
+  size_t i = 0;
+
+  if (length >= 8) {
+    __m128i min_v = _mm_set1_epi16(WEBRTC_SPL_WORD16_MAX);
+    __m128i max_v = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+    for (; i + 8 <= length; i += 8) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)(vector + i));
+      min_v = _mm_min_epi16(min_v, v);
+      max_v = _mm_max_epi16(max_v, v);
+    }
+    min_value = MinAcrossW16(min_v);
+    max_value = MaxAcrossW16(max_v);
+  }
+  for (; i < length; i++) {
+    if (vector[i] < min_value)
+      min_value = vector[i];
+    if (vector[i] > max_value)
+      max_value = vector[i];
+  }
+  *minimum = min_value;
+  *maximum = max_value;
+}
+
+static void MinMaxW32(const int32_t* vector,
+                      size_t length,
+                      int32_t* minimum,
+                      int32_t* maximum) {
+  int32_t min_value = WEBRTC_SPL_WORD32_MAX;
+  int32_t max_value = WEBRTC_SPL_WORD32_MIN;
+  size_t i = 0;
+
+  if (length >= 4) {
+    __m128i min_v = _mm_set1_epi32(WEBRTC_SPL_WORD32_MAX);
+    __m128i max_v = _mm_set1_epi32(WEBRTC_SPL_WORD32_MIN);
+    for (; i + 4 <= length; i += 4) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)(vector + i));
+      min_v = MinW32(min_v, v);
+      max_v = MaxW32(max_v, v);
+    }
+    min_value = MinAcrossW32(min_v);
+    max_value = MaxAcrossW32(max_v);
+  }
+  for (; i < length; i++) {
+    if (vector[i] < min_value)
+      min_value = vector[i];
+    if (vector[i] > max_value)
+      max_value = vector[i];
+  }
+  *minimum = min_value;
+  *maximum = max_value;
+}
+
+// Maximum absolute value of word16 vector. SSE2 version for x86 platforms.
+int16_t WebRtcSpl_MaxAbsValueW16SSE2(const int16_t* vector, size_t length) {
+  int16_t minimum, maximum;
+  int absolute;
+
+  assert(length > 0);
+
+  MinMaxW16(vector, length, &minimum, &maximum);
+  absolute = WEBRTC_SPL_MAX(abs((int)minimum), abs((int)maximum));
+  // Guard the case for abs(-32768).
+  return (int16_t)WEBRTC_SPL_MIN(absolute, WEBRTC_SPL_WORD16_MAX);
+}
+
+// Maximum absolute value of word32 vector. SSE2 version for x86 platforms.
+int32_t WebRtcSpl_MaxAbsValueW32SSE2(const int32_t* vector, size_t length) {
+  int32_t minimum, maximum;
+  uint32_t absolute;
+
+  assert(length > 0);
+
+  MinMaxW32(vector, length, &minimum, &maximum);
+  // Like the C version, let the absolute value of 0x80000000 be 0x80000000 and
+  // then saturate.
+  absolute = (uint32_t)WEBRTC_SPL_MAX(maximum, 0);
+  if (minimum < 0)
+    absolute = WEBRTC_SPL_MAX(absolute, 0u - (uint32_t)minimum);
+  return (int32_t)WEBRTC_SPL_MIN(absolute, WEBRTC_SPL_WORD32_MAX);
+}
+
+// Maximum value of word16 vector. SSE2 version for x86 platforms.
+int16_t WebRtcSpl_MaxValueW16SSE2(const int16_t* vector, size_t length) {
+  int16_t maximum = WEBRTC_SPL_WORD16_MIN;
+  size_t i = 0;
+
+  assert(length > 0);
+
+  if (length >= 8) {
+    __m128i max_v = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+    for (; i + 8 <= length; i += 8) {
+      max_v = _mm_max_epi16(max_v,
+                            _mm_loadu_si128((const __m128i*)(vector + i)));
+    }
+    maximum = MaxAcrossW16(max_v);
+  }
+  for (; i < length; i++) {
+    if (vector[i] > maximum)
+      maximum = vector[i];
+  }
+  return maximum;
+}
+
+// Maximum value of word32 vector. SSE2 version for x86 platforms.
+int32_t WebRtcSpl_MaxValueW32SSE2(const int32_t* vector, size_t length) {
+  int32_t maximum = WEBRTC_SPL_WORD32_MIN;
+  size_t i = 0;
+
+  assert(length > 0);
+
+  if (length >= 4) {
+    __m128i max_v = _mm_set1_epi32(WEBRTC_SPL_WORD32_MIN);
+    for (; i + 4 <= length; i += 4)
+      max_v = MaxW32(max_v, _mm_loadu_si128((const __m128i*)(vector + i)));
+    maximum = MaxAcrossW32(max_v);
+  }
+  for (; i < length; i++) {
+    if (vector[i] > maximum)
+      maximum = vector[i];
+  }
+  return maximum;
+}
+
+// Minimum value of word16 vector. SSE2 version for x86 platforms.
+int16_t WebRtcSpl_MinValueW16SSE2(const int16_t* vector, size_t length) {
+  int16_t minimum = WEBRTC_SPL_WORD16_MAX;
+  size_t i = 0;
+
+  assert(length > 0);
+
+  if (length >= 8) {
+    __m128i min_v = _mm_set1_epi16(WEBRTC_SPL_WORD16_MAX);
+    for (; i + 8 <= length; i += 8) {
+      min_v = _mm_min_epi16(min_v,
+                            _mm_loadu_si128((const __m128i*)(vector + i)));
+    }
+    minimum = MinAcrossW16(min_v);
+  }
+  for (; i < length; i++) {
+    if (vector[i] < minimum)
+      minimum = vector[i];
+  }
+  return minimum;
+}
+
+// Minimum value of word32 vector. SSE2 version for x86 platforms.
+int32_t WebRtcSpl_MinValueW32SSE2(const int32_t* vector, size_t length) {
+  int32_t minimum = WEBRTC_SPL_WORD32_MAX;
+  size_t i = 0;
+
+  assert(length > 0);
+
+  if (length >= 4) {
+    __m128i min_v = _mm_set1_epi32(WEBRTC_SPL_WORD32_MAX);
+    for (; i + 4 <= length; i += 4)
+      min_v = MinW32(min_v, _mm_loadu_si128((const __m128i*)(vector + i)));
+    minimum = MinAcrossW32(min_v);
+  }
+  for (; i < length; i++) {
+    if (vector[i] < minimum)
+      minimum = vector[i];
+  }
+  return minimum;
+}
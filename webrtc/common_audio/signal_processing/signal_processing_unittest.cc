@@ -12,7 +12,9 @@
 #include <sstream>
 
 #include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
 #include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 
 static const size_t kVector16Size = 9;
 static const int16_t vector16[kVector16Size] = {1, -15511, 4323, 1963,
@@ -449,18 +451,129 @@ TEST_F(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] =
       {-266947903, -15579555, -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] =
       {-266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
-    expected = kExpectedNeon;
-  }
+  expected = kExpectedNeon;
 #endif
   for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
     EXPECT_EQ(expected[i], vector32[i]);
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST_F(SplTest, CrossCorrelationSSE2Test) {
+  if (!WebRtc_GetCPUInfo(kSSE2))
+    return;
+  const size_t kMaxSeqDimension = 50;
+  const size_t kMaxCrossCorrelationDimension = 9;
+  const int kMaxStep = 2;
+  const size_t kMaxShift = kMaxCrossCorrelationDimension * kMaxStep;
+  webrtc::Random random(0x5eed);
+  int16_t seq1[kMaxSeqDimension];
+  int16_t seq2[kMaxShift + kMaxSeqDimension + kMaxShift];
+  for (int16_t& sample : seq1)
+    sample = random.Rand<int16_t>();
+  for (int16_t& sample : seq2)
+    sample = random.Rand<int16_t>();
+
+  // Cover all tail lengths, both directions of the lag and both small and
+  // large enough shifts to make the sums wrap around.
+  for (size_t dim_seq = 0; dim_seq <= kMaxSeqDimension; ++dim_seq) {
+    for (size_t dim = 1; dim <= kMaxCrossCorrelationDimension; ++dim) {
+      for (int step = -kMaxStep; step <= kMaxStep; ++step) {
+        for (int shift = 0; shift <= 16; shift += 4) {
+          int32_t expected[kMaxCrossCorrelationDimension];
+          int32_t actual[kMaxCrossCorrelationDimension];
+          WebRtcSpl_CrossCorrelationC(expected, seq1, &seq2[kMaxShift],
+                                      dim_seq, dim, shift, step);
+          WebRtcSpl_CrossCorrelationSSE2(actual, seq1, &seq2[kMaxShift],
+                                         dim_seq, dim, shift, step);
+          for (size_t i = 0; i < dim; ++i) {
+            ASSERT_EQ(expected[i], actual[i]) << "dim_seq " << dim_seq
+                << ", lag " << i << ", step " << step << ", shift " << shift;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(SplTest, MinMaxOperationsSSE2Test) {
+  if (!WebRtc_GetCPUInfo(kSSE2))
+    return;
+  const size_t kMaxLength = 40;
+  webrtc::Random random(0x5eed);
+  int16_t vector16[kMaxLength];
+  int32_t vector32[kMaxLength];
+  for (size_t length = 1; length <= kMaxLength; ++length) {
+    // Random vectors, and vectors with the extreme values in every position.
+    for (size_t extreme = 0; extreme <= length; ++extreme) {
+      for (size_t i = 0; i < length; ++i) {
+        vector16[i] = random.Rand<int16_t>();
+        vector32[i] = random.Rand<int32_t>();
+      }
+      if (extreme < length) {
+        vector16[extreme] = extreme % 2 ? WEBRTC_SPL_WORD16_MIN
+                                        : WEBRTC_SPL_WORD16_MAX;
+        vector32[extreme] = extreme % 2 ? WEBRTC_SPL_WORD32_MIN
+                                        : WEBRTC_SPL_WORD32_MAX;
+      }
+      ASSERT_EQ(WebRtcSpl_MaxAbsValueW16C(vector16, length),
+                WebRtcSpl_MaxAbsValueW16SSE2(vector16, length));
+      ASSERT_EQ(WebRtcSpl_MaxAbsValueW32C(vector32, length),
+                WebRtcSpl_MaxAbsValueW32SSE2(vector32, length));
+      ASSERT_EQ(WebRtcSpl_MaxValueW16C(vector16, length),
+                WebRtcSpl_MaxValueW16SSE2(vector16, length));
+      ASSERT_EQ(WebRtcSpl_MaxValueW32C(vector32, length),
+                WebRtcSpl_MaxValueW32SSE2(vector32, length));
+      ASSERT_EQ(WebRtcSpl_MinValueW16C(vector16, length),
+                WebRtcSpl_MinValueW16SSE2(vector16, length));
+      ASSERT_EQ(WebRtcSpl_MinValueW32C(vector32, length),
+                WebRtcSpl_MinValueW32SSE2(vector32, length));
+    }
+  }
+}
+
+TEST_F(SplTest, DownsampleFastSSE2Test) {
+  if (!WebRtc_GetCPUInfo(kSSE2))
+    return;
+  const size_t kMaxCoefficients = 20;
+  const size_t kOutLength = 10;
+  const int kMaxFactor = 3;
+  webrtc::Random random(0x5eed);
+  int16_t data_in[kMaxCoefficients + kMaxFactor * kOutLength];
+  int16_t coefficients[kMaxCoefficients];
+  // Full scale input makes both the sums wrap around and the outputs
+  // saturate.
+  for (int16_t& sample : data_in)
+    sample = random.Rand<int16_t>();
+  for (int16_t& coefficient : coefficients)
+    coefficient = random.Rand<int16_t>();
+
+  for (size_t num_coefficients = 1; num_coefficients <= kMaxCoefficients;
+       ++num_coefficients) {
+    for (int factor = 1; factor <= kMaxFactor; ++factor) {
+      const size_t delay = num_coefficients - 1;
+      int16_t expected[kOutLength];
+      int16_t actual[kOutLength];
+      ASSERT_EQ(0, WebRtcSpl_DownsampleFastC(
+                       data_in, sizeof(data_in) / sizeof(data_in[0]), expected,
+                       kOutLength, coefficients, num_coefficients, factor,
+                       delay));
+      ASSERT_EQ(0, WebRtcSpl_DownsampleFastSSE2(
+                       data_in, sizeof(data_in) / sizeof(data_in[0]), actual,
+                       kOutLength, coefficients, num_coefficients, factor,
+                       delay));
+      for (size_t i = 0; i < kOutLength; ++i) {
+        ASSERT_EQ(expected[i], actual[i]) << "coefficients "
+            << num_coefficients << ", factor " << factor << ", output " << i;
+      }
+    }
+  }
+}
+#endif
+
 TEST_F(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
@@ -11,6 +11,7 @@
 #include "webrtc/common_audio/sparse_fir_filter.h"
 
 #include "webrtc/base/checks.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 
@@ -21,39 +22,55 @@ SparseFIRFilter::SparseFIRFilter(const float* nonzero_coeffs,
     : sparsity_(sparsity),
       offset_(offset),
       nonzero_coeffs_(nonzero_coeffs, nonzero_coeffs + num_nonzero_coeffs),
-      state_(sparsity_ * (num_nonzero_coeffs - 1) + offset_, 0.f) {
+      state_length_(sparsity_ * (num_nonzero_coeffs - 1) + offset_),
+      buffer_(state_length_, 0.f) {
   RTC_CHECK_GE(num_nonzero_coeffs, 1u);
   RTC_CHECK_GE(sparsity, 1u);
+
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  filter_block_ = FilterBlock_SSE2;
+#else
+  // x86 CPU detection required.
+  filter_block_ = WebRtc_GetCPUInfo(kSSE2) ? FilterBlock_SSE2 : FilterBlock_C;
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+  filter_block_ = FilterBlock_NEON;
+#else
+  filter_block_ = FilterBlock_C;
+#endif
 }
 
 void SparseFIRFilter::Filter(const float* in, size_t length, float* out) {
+  if (buffer_.size() < state_length_ + length)
+    buffer_.resize(state_length_ + length);
+  std::memcpy(buffer_.data() + state_length_, in, length * sizeof(*in));
+
   // Convolves the input signal |in| with the filter kernel |nonzero_coeffs_|
-  // taking into account the previous state.
-  for (size_t i = 0; i < length; ++i) {
-    out[i] = 0.f;
-    size_t j;
-    for (j = 0; i >= j * sparsity_ + offset_ &&
-                j < nonzero_coeffs_.size(); ++j) {
-      out[i] += in[i - j * sparsity_ - offset_] * nonzero_coeffs_[j];
-    }
-    for (; j < nonzero_coeffs_.size(); ++j) {
-      out[i] += state_[i + (nonzero_coeffs_.size() - j - 1) * sparsity_] *
-                nonzero_coeffs_[j];
-    }
-  }
+  // taking into account the previous state. The |offset_| delay is part of
+  // the history, so the oldest sample used by out[0] is buffer_[0].
+  filter_block_(&nonzero_coeffs_[0], nonzero_coeffs_.size(), sparsity_,
+                buffer_.data(), length, out);
 
   // Update current state.
-  if (state_.size() > 0u) {
-    if (length >= state_.size()) {
-      std::memcpy(&state_[0],
-                  &in[length - state_.size()],
-                  state_.size() * sizeof(*in));
-    } else {
-      std::memmove(&state_[0],
-                   &state_[length],
-                   (state_.size() - length) * sizeof(state_[0]));
-      std::memcpy(&state_[state_.size() - length], in, length * sizeof(*in));
-    }
+  if (state_length_ > 0u) {
+    std::memmove(buffer_.data(), buffer_.data() + length,
+                 state_length_ * sizeof(buffer_[0]));
+  }
+}
+
+void SparseFIRFilter::FilterBlock_C(const float* coeffs,
+                                    size_t num_coeffs,
+                                    size_t sparsity,
+                                    const float* in,
+                                    size_t length,
+                                    float* out) {
+  for (size_t i = 0; i < length; ++i) {
+    float sum = 0.f;
+    for (size_t j = 0; j < num_coeffs; ++j)
+      sum += in[i + (num_coeffs - 1 - j) * sparsity] * coeffs[j];
+    out[i] = sum;
   }
 }
 
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "webrtc/base/constructormagic.h"
+#include "webrtc/typedefs.h"
 
 namespace webrtc {
 
@@ -39,10 +40,46 @@ class SparseFIRFilter final {
   void Filter(const float* in, size_t length, float* out);
 
  private:
+  // Computes |length| output samples into |out|, where
+  //   out[i] = sum_j coeffs[j] * in[i + (num_coeffs - 1 - j) * sparsity],
+  // accumulated in increasing j. |in| holds the filter history followed by the
+  // input. All implementations sum the taps in this order.
+  typedef void (*FilterBlockProc)(const float* coeffs,
+                                  size_t num_coeffs,
+                                  size_t sparsity,
+                                  const float* in,
+                                  size_t length,
+                                  float* out);
+  static void FilterBlock_C(const float* coeffs,
+                            size_t num_coeffs,
+                            size_t sparsity,
+                            const float* in,
+                            size_t length,
+                            float* out);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  static void FilterBlock_SSE2(const float* coeffs,
+                               size_t num_coeffs,
+                               size_t sparsity,
+                               const float* in,
+                               size_t length,
+                               float* out);
+#elif defined(WEBRTC_HAS_NEON)
+  static void FilterBlock_NEON(const float* coeffs,
+                               size_t num_coeffs,
+                               size_t sparsity,
+                               const float* in,
+                               size_t length,
+                               float* out);
+#endif
+
   const size_t sparsity_;
   const size_t offset_;
   const std::vector<float> nonzero_coeffs_;
-  std::vector<float> state_;
+  const size_t state_length_;
+  // The last |state_length_| input samples, followed by room for the current
+  // input. Only grows when Filter() is called with a longer input.
+  std::vector<float> buffer_;
+  FilterBlockProc filter_block_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(SparseFIRFilter);
 };
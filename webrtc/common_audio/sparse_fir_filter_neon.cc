@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/sparse_fir_filter.h"
+
+#include <arm_neon.h>
+
+namespace webrtc {
+
+// Computes four consecutive output samples at a time, summing the taps in the
+// same order as FilterBlock_C().
+void SparseFIRFilter::FilterBlock_NEON(const float* coeffs,
+                                       size_t num_coeffs,
+                                       size_t sparsity,
+                                       const float* in,
+                                       size_t length,
+                                       float* out) {
+  size_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    float32x4_t sum = vdupq_n_f32(0.f);
+    for (size_t j = 0; j < num_coeffs; ++j) {
+      const float32x4_t x = vld1q_f32(&in[i + (num_coeffs - 1 - j) * sparsity]);
+      sum = vaddq_f32(sum, vmulq_n_f32(x, coeffs[j]));
+    }
+    vst1q_f32(&out[i], sum);
+  }
+  for (; i < length; ++i) {
+    float sum = 0.f;
+    for (size_t j = 0; j < num_coeffs; ++j)
+      sum += in[i + (num_coeffs - 1 - j) * sparsity] * coeffs[j];
+    out[i] = sum;
+  }
+}
+
+}  // namespace webrtc
@@ -9,11 +9,13 @@
  */
 
 #include <memory>
+#include <vector>
 
 #include "webrtc/common_audio/sparse_fir_filter.h"
 
 #include "testing/gtest/include/gtest/gtest.h"
 #include "webrtc/base/arraysize.h"
+#include "webrtc/base/random.h"
 #include "webrtc/common_audio/fir_filter.h"
 
 namespace webrtc {
@@ -228,4 +230,38 @@ TEST(SparseFIRFilterTest, SameOutputAsFIRFilterWhenSparsityOneAndOffsetZero) {
   }
 }
 
+// Filters a long random signal in blocks of varying length, including lengths
+// that are not a multiple of the SIMD width, and compares it to the direct
+// form convolution of the whole signal.
+TEST(SparseFIRFilterTest, BlockFilteringMatchesDirectConvolution) {
+  const size_t kSparsity = 4;
+  const size_t kOffset = 2;
+  const size_t kBlockLengths[] = {160, 1, 7, 160, 3, 64, 13, 160};
+  size_t total_length = 0;
+  for (size_t length : kBlockLengths)
+    total_length += length;
+
+  Random random(42);
+  std::vector<float> input(total_length);
+  for (float& sample : input)
+    sample = static_cast<float>(random.Gaussian(0, 1));
+
+  SparseFIRFilter filter(kCoeffs, arraysize(kCoeffs), kSparsity, kOffset);
+  std::vector<float> output(total_length);
+  size_t position = 0;
+  for (size_t length : kBlockLengths) {
+    filter.Filter(&input[position], length, &output[position]);
+    position += length;
+  }
+
+  for (size_t i = 0; i < total_length; ++i) {
+    float expected = 0.f;
+    for (size_t j = 0; j < arraysize(kCoeffs); ++j) {
+      if (i >= j * kSparsity + kOffset)
+        expected += input[i - j * kSparsity - kOffset] * kCoeffs[j];
+    }
+    EXPECT_FLOAT_EQ(expected, output[i]);
+  }
+}
+
 }  // namespace webrtc
@@ -70,6 +70,29 @@ int WebRtcVad_set_mode(VadInst* handle, int mode);
 int WebRtcVad_Process(VadInst* handle, int fs, const int16_t* audio_frame,
                       size_t frame_length);
 
+// Calculates VAD decisions for one frame of each of |num_streams| streams,
+// e.g. all the incoming streams of a conference, which share the same
+// sampling frequency and frame length. The arguments are checked once for the
+// whole batch, after which each stream is classified exactly like
+// WebRtcVad_Process() would.
+//
+// - handles      [i/o] : VAD instances, one per stream. Each needs to be
+//                        initialized by WebRtcVad_Init() before call.
+// - fs           [i]   : Sampling frequency (Hz): 8000, 16000, 32000 or 48000
+// - audio_frames [i]   : Audio frame buffers, one per stream.
+// - frame_length [i]   : Length of each audio frame buffer in number of
+//                        samples.
+// - num_streams  [i]   : Number of streams.
+// - decisions    [o]   : VAD decision for each stream: 1 - (Active Voice),
+//                        0 - (Non-active Voice).
+//
+// returns              : 0 - (OK),
+//                       -1 - (Error, in which case |decisions| are undefined)
+int WebRtcVad_ProcessBatch(VadInst* const* handles, int fs,
+                           const int16_t* const* audio_frames,
+                           size_t frame_length, size_t num_streams,
+                           int* decisions);
+
 // Checks for valid combinations of |rate| and |frame_length|. We support 10,
 // 20 and 30 ms frames and the rates 8000, 16000 and 32000 Hz.
 //
@@ -10,12 +10,16 @@
 
 #include "webrtc/common_audio/vad/vad_unittest.h"
 
+#include <stdio.h>
 #include <stdlib.h>
 
+#include <vector>
+
 #include "testing/gtest/include/gtest/gtest.h"
 
 #include "webrtc/base/arraysize.h"
 #include "webrtc/base/checks.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
 #include "webrtc/common_audio/vad/include/webrtc_vad.h"
 #include "webrtc/typedefs.h"
@@ -151,6 +155,111 @@ TEST_F(VadTest, ValidRatesFrameLengths) {
   }
 }
 
+// Fills |frames| with a different mix of noise and tone for each stream, so
+// that the streams' decisions vary.
+void CreateStreams(size_t frame_length, std::vector<int16_t>* frames) {
+  for (size_t i = 0; i < frames->size(); i++) {
+    const size_t stream = i / frame_length;
+    const int tone = (stream % 3 == 0) ? 0 : static_cast<int16_t>(i * i);
+    (*frames)[i] = static_cast<int16_t>(tone / 4 + (rand() % 2001) - 1000);
+  }
+}
+
+TEST_F(VadTest, ProcessBatchMatchesProcess) {
+  const size_t kNumStreams = 7;
+  const size_t kNumFrames = 20;
+  const int16_t* audio_frames[kNumStreams];
+  VadInst* batch_handles[kNumStreams];
+  VadInst* handles[kNumStreams];
+  int decisions[kNumStreams];
+
+  for (size_t i = 0; i < kNumStreams; i++) {
+    batch_handles[i] = WebRtcVad_Create();
+    handles[i] = WebRtcVad_Create();
+    ASSERT_EQ(0, WebRtcVad_Init(batch_handles[i]));
+    ASSERT_EQ(0, WebRtcVad_Init(handles[i]));
+  }
+
+  // Invalid arguments.
+  int16_t speech[kMaxFrameLength] = { 0 };
+  for (size_t i = 0; i < kNumStreams; i++)
+    audio_frames[i] = speech;
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(nullptr, kRates[0], audio_frames,
+                                       kFrameLengths[0], kNumStreams,
+                                       decisions));
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, 9999, audio_frames,
+                                       kFrameLengths[0], kNumStreams,
+                                       decisions));
+  audio_frames[kNumStreams - 1] = nullptr;
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kRates[0], audio_frames,
+                                       kFrameLengths[0], kNumStreams,
+                                       decisions));
+
+  for (size_t i = 0; i < kRatesSize; i++) {
+    for (size_t j = 0; j < kFrameLengthsSize; j++) {
+      if (!ValidRatesAndFrameLengths(kRates[i], kFrameLengths[j]))
+        continue;
+      std::vector<int16_t> frames(kNumStreams * kFrameLengths[j]);
+      for (size_t frame = 0; frame < kNumFrames; frame++) {
+        CreateStreams(kFrameLengths[j], &frames);
+        for (size_t k = 0; k < kNumStreams; k++)
+          audio_frames[k] = &frames[k * kFrameLengths[j]];
+        ASSERT_EQ(0, WebRtcVad_ProcessBatch(batch_handles, kRates[i],
+                                            audio_frames, kFrameLengths[j],
+                                            kNumStreams, decisions));
+        for (size_t k = 0; k < kNumStreams; k++) {
+          EXPECT_EQ(WebRtcVad_Process(handles[k], kRates[i], audio_frames[k],
+                                      kFrameLengths[j]),
+                    decisions[k]);
+        }
+      }
+    }
+  }
+
+  for (size_t i = 0; i < kNumStreams; i++) {
+    WebRtcVad_Free(batch_handles[i]);
+    WebRtcVad_Free(handles[i]);
+  }
+}
+
+// Disabled because it takes too long to run routinely. Use for performance
+// benchmarking when needed.
+TEST_F(VadTest, DISABLED_ProcessBatchBenchmark) {
+  const size_t kNumStreams = 1000;
+  const int kIterations = 100;
+  std::vector<VadInst*> handles(kNumStreams);
+  std::vector<const int16_t*> audio_frames(kNumStreams);
+  std::vector<int> decisions(kNumStreams);
+
+  for (size_t i = 0; i < kNumStreams; i++) {
+    handles[i] = WebRtcVad_Create();
+    ASSERT_EQ(0, WebRtcVad_Init(handles[i]));
+  }
+  for (size_t i = 0; i < kRatesSize; i++) {
+    // Benchmark 10 ms frames.
+    const size_t frame_length = static_cast<size_t>(kRates[i] / 100);
+    if (!ValidRatesAndFrameLengths(kRates[i], frame_length))
+      continue;
+    std::vector<int16_t> frames(kNumStreams * frame_length);
+    CreateStreams(frame_length, &frames);
+    for (size_t k = 0; k < kNumStreams; k++)
+      audio_frames[k] = &frames[k * frame_length];
+
+    int64_t start = rtc::TimeNanos();
+    for (int n = 0; n < kIterations; n++) {
+      ASSERT_EQ(0, WebRtcVad_ProcessBatch(&handles[0], kRates[i],
+                                          &audio_frames[0], frame_length,
+                                          kNumStreams, &decisions[0]));
+    }
+    double time_us = static_cast<double>(rtc::TimeNanos() - start) /
+                     rtc::kNumNanosecsPerMicrosec / kIterations;
+    printf("%d Hz: %.0f us per 10 ms frame of %d streams.\n", kRates[i],
+           time_us, static_cast<int>(kNumStreams));
+  }
+  for (size_t i = 0; i < kNumStreams; i++)
+    WebRtcVad_Free(handles[i]);
+}
+
 // TODO(bjornv): Add a process test, run on file.
 
 }  // namespace
@@ -55,9 +55,30 @@ int WebRtcVad_set_mode(VadInst* handle, int mode) {
   return WebRtcVad_set_mode_core(self, mode);
 }
 
+// Calculates a VAD decision for |audio_frame|, of which the arguments have
+// already been checked.
+static int CalcVad(VadInstT* self, int fs, const int16_t* audio_frame,
+                   size_t frame_length) {
+  int vad = -1;
+
+  if (fs == 48000) {
+    vad = WebRtcVad_CalcVad48khz(self, audio_frame, frame_length);
+  } else if (fs == 32000) {
+    vad = WebRtcVad_CalcVad32khz(self, audio_frame, frame_length);
+  } else if (fs == 16000) {
+    vad = WebRtcVad_CalcVad16khz(self, audio_frame, frame_length);
+  } else if (fs == 8000) {
+    vad = WebRtcVad_CalcVad8khz(self, audio_frame, frame_length);
+  }
+
+  if (vad > 0) {
+    vad = 1;
+  }
+  return vad;
+}
+
 int WebRtcVad_Process(VadInst* handle, int fs, const int16_t* audio_frame,
                       size_t frame_length) {
-  int vad = -1;
   VadInstT* self = (VadInstT*) handle;
 
   if (handle == NULL) {
@@ -74,20 +95,37 @@ int WebRtcVad_Process(VadInst* handle, int fs, const int16_t* audio_frame,
     return -1;
   }
 
-  if (fs == 48000) {
-      vad = WebRtcVad_CalcVad48khz(self, audio_frame, frame_length);
-  } else if (fs == 32000) {
-    vad = WebRtcVad_CalcVad32khz(self, audio_frame, frame_length);
-  } else if (fs == 16000) {
-    vad = WebRtcVad_CalcVad16khz(self, audio_frame, frame_length);
-  } else if (fs == 8000) {
-    vad = WebRtcVad_CalcVad8khz(self, audio_frame, frame_length);
+  return CalcVad(self, fs, audio_frame, frame_length);
+}
+
+int WebRtcVad_ProcessBatch(VadInst* const* handles, int fs,
+                           const int16_t* const* audio_frames,
+                           size_t frame_length, size_t num_streams,
+                           int* decisions) {
+  size_t i;
+
+  if (handles == NULL || audio_frames == NULL || decisions == NULL) {
+    return -1;
+  }
+  if (WebRtcVad_ValidRateAndFrameLength(fs, frame_length) != 0) {
+    return -1;
+  }
+  for (i = 0; i < num_streams; i++) {
+    const VadInstT* self = (const VadInstT*) handles[i];
+    if (self == NULL || self->init_flag != kInitCheck ||
+        audio_frames[i] == NULL) {
+      return -1;
+    }
   }
 
-  if (vad > 0) {
-    vad = 1;
+  for (i = 0; i < num_streams; i++) {
+    decisions[i] = CalcVad((VadInstT*) handles[i], fs, audio_frames[i],
+                           frame_length);
+    if (decisions[i] < 0) {
+      return -1;
+    }
   }
-  return vad;
+  return 0;
 }
 
 int WebRtcVad_ValidRateAndFrameLength(int rate, size_t frame_length) {
@@ -45,6 +45,7 @@
           'link_settings': {
             'xcode_settings': {
               'OTHER_LDFLAGS': [
+                '-framework Accelerate',
                 '-framework CoreVideo',
               ],
             },
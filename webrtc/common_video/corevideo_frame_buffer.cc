@@ -10,17 +10,41 @@
 
 #include "webrtc/common_video/include/corevideo_frame_buffer.h"
 
+#include <Accelerate/Accelerate.h>
+
 #include "libyuv/convert.h"
+#include "libyuv/scale.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 
 namespace webrtc {
 
 CoreVideoFrameBuffer::CoreVideoFrameBuffer(CVPixelBufferRef pixel_buffer)
-    : NativeHandleBuffer(pixel_buffer,
-                         CVPixelBufferGetWidth(pixel_buffer),
-                         CVPixelBufferGetHeight(pixel_buffer)),
-      pixel_buffer_(pixel_buffer) {
+    : CoreVideoFrameBuffer(pixel_buffer,
+                           CVPixelBufferGetWidth(pixel_buffer),
+                           CVPixelBufferGetHeight(pixel_buffer),
+                           CVPixelBufferGetWidth(pixel_buffer),
+                           CVPixelBufferGetHeight(pixel_buffer),
+                           0,
+                           0) {}
+
+CoreVideoFrameBuffer::CoreVideoFrameBuffer(CVPixelBufferRef pixel_buffer,
+                                           int adapted_width,
+                                           int adapted_height,
+                                           int crop_width,
+                                           int crop_height,
+                                           int crop_x,
+                                           int crop_y)
+    : NativeHandleBuffer(pixel_buffer, adapted_width, adapted_height),
+      pixel_buffer_(pixel_buffer),
+      buffer_width_(CVPixelBufferGetWidth(pixel_buffer)),
+      buffer_height_(CVPixelBufferGetHeight(pixel_buffer)),
+      crop_width_(crop_width),
+      crop_height_(crop_height),
+      crop_x_(crop_x & ~1),
+      crop_y_(crop_y & ~1) {
+  RTC_DCHECK_LE(crop_x_ + crop_width_, buffer_width_);
+  RTC_DCHECK_LE(crop_y_ + crop_height_, buffer_height_);
   CVBufferRetain(pixel_buffer_);
 }
 
@@ -29,33 +53,117 @@ CoreVideoFrameBuffer::~CoreVideoFrameBuffer() {
 }
 
 rtc::scoped_refptr<VideoFrameBuffer>
-CoreVideoFrameBuffer::NativeToI420Buffer() {
+CoreVideoFrameBuffer::ConvertToI420() {
   RTC_DCHECK(CVPixelBufferGetPixelFormatType(pixel_buffer_) ==
              kCVPixelFormatType_420YpCbCr8BiPlanarFullRange);
-  size_t width = CVPixelBufferGetWidthOfPlane(pixel_buffer_, 0);
-  size_t height = CVPixelBufferGetHeightOfPlane(pixel_buffer_, 0);
   // TODO(tkchin): Use a frame buffer pool.
   rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer =
-      new rtc::RefCountedObject<webrtc::I420Buffer>(width, height);
+      new rtc::RefCountedObject<webrtc::I420Buffer>(crop_width_, crop_height_);
   CVPixelBufferLockBaseAddress(pixel_buffer_, kCVPixelBufferLock_ReadOnly);
-  const uint8_t* src_y = static_cast<const uint8_t*>(
-      CVPixelBufferGetBaseAddressOfPlane(pixel_buffer_, 0));
   int src_y_stride = CVPixelBufferGetBytesPerRowOfPlane(pixel_buffer_, 0);
-  const uint8_t* src_uv = static_cast<const uint8_t*>(
-      CVPixelBufferGetBaseAddressOfPlane(pixel_buffer_, 1));
+  const uint8_t* src_y = static_cast<const uint8_t*>(
+      CVPixelBufferGetBaseAddressOfPlane(pixel_buffer_, 0)) +
+      crop_y_ * src_y_stride + crop_x_;
   int src_uv_stride = CVPixelBufferGetBytesPerRowOfPlane(pixel_buffer_, 1);
+  const uint8_t* src_uv = static_cast<const uint8_t*>(
+      CVPixelBufferGetBaseAddressOfPlane(pixel_buffer_, 1)) +
+      crop_y_ / 2 * src_uv_stride + crop_x_;
   int ret = libyuv::NV12ToI420(
       src_y, src_y_stride, src_uv, src_uv_stride,
       buffer->MutableData(webrtc::kYPlane), buffer->stride(webrtc::kYPlane),
       buffer->MutableData(webrtc::kUPlane), buffer->stride(webrtc::kUPlane),
       buffer->MutableData(webrtc::kVPlane), buffer->stride(webrtc::kVPlane),
-      width, height);
+      crop_width_, crop_height_);
   CVPixelBufferUnlockBaseAddress(pixel_buffer_, kCVPixelBufferLock_ReadOnly);
   if (ret) {
     LOG(LS_ERROR) << "Error converting NV12 to I420: " << ret;
     return nullptr;
   }
-  return buffer;
+  if (crop_width_ == width() && crop_height_ == height())
+    return buffer;
+
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> scaled =
+      new rtc::RefCountedObject<webrtc::I420Buffer>(width(), height());
+  ret = libyuv::I420Scale(
+      buffer->DataY(), buffer->StrideY(),
+      buffer->DataU(), buffer->StrideU(),
+      buffer->DataV(), buffer->StrideV(),
+      crop_width_, crop_height_,
+      scaled->MutableDataY(), scaled->StrideY(),
+      scaled->MutableDataU(), scaled->StrideU(),
+      scaled->MutableDataV(), scaled->StrideV(),
+      width(), height(), libyuv::kFilterBox);
+  if (ret) {
+    LOG(LS_ERROR) << "Error scaling I420: " << ret;
+    return nullptr;
+  }
+  return scaled;
+}
+
+bool CoreVideoFrameBuffer::RequiresCropping() const {
+  return crop_width_ != buffer_width_ || crop_height_ != buffer_height_ ||
+         width() != buffer_width_ || height() != buffer_height_;
+}
+
+bool CoreVideoFrameBuffer::CropAndScaleTo(
+    CVPixelBufferRef output_pixel_buffer) const {
+  RTC_DCHECK(CVPixelBufferGetPixelFormatType(pixel_buffer_) ==
+             kCVPixelFormatType_420YpCbCr8BiPlanarFullRange);
+  RTC_DCHECK(CVPixelBufferGetPixelFormatType(output_pixel_buffer) ==
+             kCVPixelFormatType_420YpCbCr8BiPlanarFullRange);
+  CVReturn cv_ret =
+      CVPixelBufferLockBaseAddress(pixel_buffer_, kCVPixelBufferLock_ReadOnly);
+  if (cv_ret != kCVReturnSuccess) {
+    LOG(LS_ERROR) << "Failed to lock base address: " << cv_ret;
+    return false;
+  }
+  cv_ret = CVPixelBufferLockBaseAddress(output_pixel_buffer, 0);
+  if (cv_ret != kCVReturnSuccess) {
+    LOG(LS_ERROR) << "Failed to lock base address: " << cv_ret;
+    CVPixelBufferUnlockBaseAddress(pixel_buffer_, kCVPixelBufferLock_ReadOnly);
+    return false;
+  }
+
+  const size_t src_y_stride =
+      CVPixelBufferGetBytesPerRowOfPlane(pixel_buffer_, 0);
+  const size_t src_uv_stride =
+      CVPixelBufferGetBytesPerRowOfPlane(pixel_buffer_, 1);
+  vImage_Buffer src_y = {
+      static_cast<uint8_t*>(
+          CVPixelBufferGetBaseAddressOfPlane(pixel_buffer_, 0)) +
+          crop_y_ * src_y_stride + crop_x_,
+      static_cast<vImagePixelCount>(crop_height_),
+      static_cast<vImagePixelCount>(crop_width_), src_y_stride};
+  // The chroma plane holds interleaved CbCr pairs at half resolution.
+  vImage_Buffer src_uv = {
+      static_cast<uint8_t*>(
+          CVPixelBufferGetBaseAddressOfPlane(pixel_buffer_, 1)) +
+          crop_y_ / 2 * src_uv_stride + crop_x_,
+      static_cast<vImagePixelCount>((crop_height_ + 1) / 2),
+      static_cast<vImagePixelCount>((crop_width_ + 1) / 2), src_uv_stride};
+  vImage_Buffer dst_y = {
+      CVPixelBufferGetBaseAddressOfPlane(output_pixel_buffer, 0),
+      CVPixelBufferGetHeightOfPlane(output_pixel_buffer, 0),
+      CVPixelBufferGetWidthOfPlane(output_pixel_buffer, 0),
+      CVPixelBufferGetBytesPerRowOfPlane(output_pixel_buffer, 0)};
+  vImage_Buffer dst_uv = {
+      CVPixelBufferGetBaseAddressOfPlane(output_pixel_buffer, 1),
+      CVPixelBufferGetHeightOfPlane(output_pixel_buffer, 1),
+      CVPixelBufferGetWidthOfPlane(output_pixel_buffer, 1),
+      CVPixelBufferGetBytesPerRowOfPlane(output_pixel_buffer, 1)};
+
+  vImage_Error error =
+      vImageScale_Planar8(&src_y, &dst_y, nullptr, kvImageNoFlags);
+  if (error == kvImageNoError)
+    error = vImageScale_CbCr8(&src_uv, &dst_uv, nullptr, kvImageNoFlags);
+
+  CVPixelBufferUnlockBaseAddress(output_pixel_buffer, 0);
+  CVPixelBufferUnlockBaseAddress(pixel_buffer_, kCVPixelBufferLock_ReadOnly);
+  if (error != kvImageNoError) {
+    LOG(LS_ERROR) << "Error cropping and scaling NV12: " << error;
+    return false;
+  }
+  return true;
 }
 
 }  // namespace webrtc
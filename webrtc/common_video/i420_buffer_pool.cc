@@ -10,6 +10,8 @@
 
 #include "webrtc/common_video/include/i420_buffer_pool.h"
 
+#include <algorithm>
+
 #include "webrtc/base/checks.h"
 
 namespace {
@@ -63,43 +65,102 @@ class PooledI420Buffer : public webrtc::VideoFrameBuffer {
 
 namespace webrtc {
 
+namespace {
+
+size_t BufferSize(const I420Buffer& buffer) {
+  const int chroma_height = (buffer.height() + 1) / 2;
+  return buffer.StrideY() * buffer.height() +
+         (buffer.StrideU() + buffer.StrideV()) * chroma_height;
+}
+
+}  // namespace
+
+// Enough for a few 1080p frames, or about a dozen 720p ones.
+const size_t I420BufferPool::kDefaultMaxBytes = 16 * 1024 * 1024;
+
 I420BufferPool::I420BufferPool(bool zero_initialize)
-    : zero_initialize_(zero_initialize) {
+    : I420BufferPool(zero_initialize, kDefaultMaxBytes) {}
+
+I420BufferPool::I420BufferPool(bool zero_initialize, size_t max_bytes)
+    : zero_initialize_(zero_initialize),
+      max_bytes_(max_bytes),
+      bytes_allocated_(0),
+      num_requests_(0),
+      num_hits_(0),
+      num_misses_(0) {
   Release();
 }
 
 void I420BufferPool::Release() {
   thread_checker_.DetachFromThread();
-  buffers_.clear();
+  sub_pools_.clear();
+  bytes_allocated_ = 0;
 }
 
 rtc::scoped_refptr<VideoFrameBuffer> I420BufferPool::CreateBuffer(int width,
                                                                   int height) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
-  // Release buffers with wrong resolution.
-  for (auto it = buffers_.begin(); it != buffers_.end();) {
-    if ((*it)->width() != width || (*it)->height() != height)
-      it = buffers_.erase(it);
-    else
-      ++it;
-  }
+  SubPool& sub_pool = sub_pools_[std::make_pair(width, height)];
+  sub_pool.last_request = ++num_requests_;
   // Look for a free buffer.
-  for (const rtc::scoped_refptr<I420Buffer>& buffer : buffers_) {
+  rtc::scoped_refptr<I420Buffer> buffer;
+  for (const rtc::scoped_refptr<I420Buffer>& pooled : sub_pool.buffers) {
     // If the buffer is in use, the ref count will be 2, one from the list we
     // are looping over and one from a PooledI420Buffer returned from
     // CreateBuffer that has not been released yet. If the ref count is 1
     // (HasOneRef), then the list we are looping over holds the only reference
     // and it's safe to reuse.
-    if (buffer->IsMutable())
-      return new rtc::RefCountedObject<PooledI420Buffer>(buffer);
+    if (pooled->IsMutable()) {
+      buffer = pooled;
+      break;
+    }
+  }
+  if (buffer) {
+    ++num_hits_;
+  } else {
+    // Allocate new buffer.
+    ++num_misses_;
+    buffer = new rtc::RefCountedObject<I420Buffer>(width, height);
+    if (zero_initialize_)
+      buffer->InitializeData();
+    bytes_allocated_ += BufferSize(*buffer);
+    sub_pool.buffers.push_back(buffer);
+  }
+  rtc::scoped_refptr<VideoFrameBuffer> pooled_buffer(
+      new rtc::RefCountedObject<PooledI420Buffer>(buffer));
+  // Now that |buffer| is in use, it won't be released along with the rest.
+  buffer = nullptr;
+  ReleaseUnusedBuffers();
+  return pooled_buffer;
+}
+
+void I420BufferPool::ReleaseUnusedBuffers() {
+  while (bytes_allocated_ > max_bytes_) {
+    // Pick the least recently requested resolution with a free buffer.
+    auto oldest = sub_pools_.end();
+    std::list<rtc::scoped_refptr<I420Buffer>>::iterator free_buffer;
+    for (auto it = sub_pools_.begin(); it != sub_pools_.end(); ++it) {
+      if (oldest != sub_pools_.end() &&
+          it->second.last_request >= oldest->second.last_request) {
+        continue;
+      }
+      auto buffer_it = std::find_if(
+          it->second.buffers.begin(), it->second.buffers.end(),
+          [](const rtc::scoped_refptr<I420Buffer>& buffer) {
+            return buffer->IsMutable();
+          });
+      if (buffer_it != it->second.buffers.end()) {
+        oldest = it;
+        free_buffer = buffer_it;
+      }
+    }
+    if (oldest == sub_pools_.end())
+      return;
+    bytes_allocated_ -= BufferSize(**free_buffer);
+    oldest->second.buffers.erase(free_buffer);
+    if (oldest->second.buffers.empty())
+      sub_pools_.erase(oldest);
   }
-  // Allocate new buffer.
-  rtc::scoped_refptr<I420Buffer> buffer = new rtc::RefCountedObject<I420Buffer>(
-      width, height);
-  if (zero_initialize_)
-    buffer->InitializeData();
-  buffers_.push_back(buffer);
-  return new rtc::RefCountedObject<PooledI420Buffer>(buffers_.back());
 }
 
 }  // namespace webrtc
@@ -51,6 +51,44 @@ TEST(TestI420BufferPool, FailToReuse) {
   EXPECT_NE(v_ptr, buffer->DataV());
 }
 
+TEST(TestI420BufferPool, ReuseAfterResolutionChange) {
+  I420BufferPool pool;
+  const uint8_t* y_ptr = pool.CreateBuffer(16, 16)->DataY();
+  // Switching to another resolution and back doesn't lose the buffer.
+  pool.CreateBuffer(32, 16);
+  EXPECT_EQ(y_ptr, pool.CreateBuffer(16, 16)->DataY());
+  EXPECT_EQ(1, pool.num_hits());
+  EXPECT_EQ(2, pool.num_misses());
+}
+
+TEST(TestI420BufferPool, ReleasesLeastRecentlyUsedResolutionFirst) {
+  // Room for two 16x16 buffers (384 bytes each), but not three.
+  I420BufferPool pool(false, 800);
+  const uint8_t* first_ptr = pool.CreateBuffer(16, 16)->DataY();
+  pool.CreateBuffer(16, 14);
+  EXPECT_EQ(384u + 336u, pool.bytes_allocated());
+  // Asking for the first resolution again makes the second one the oldest.
+  EXPECT_EQ(first_ptr, pool.CreateBuffer(16, 16)->DataY());
+  pool.CreateBuffer(16, 12);
+  EXPECT_EQ(384u + 288u, pool.bytes_allocated());
+  EXPECT_EQ(first_ptr, pool.CreateBuffer(16, 16)->DataY());
+  EXPECT_EQ(2, pool.num_hits());
+  EXPECT_EQ(3, pool.num_misses());
+}
+
+TEST(TestI420BufferPool, KeepsBuffersInUseOverCap) {
+  I420BufferPool pool(false, 0);
+  rtc::scoped_refptr<VideoFrameBuffer> buffer1 = pool.CreateBuffer(16, 16);
+  rtc::scoped_refptr<VideoFrameBuffer> buffer2 = pool.CreateBuffer(16, 16);
+  EXPECT_NE(buffer1->DataY(), buffer2->DataY());
+  EXPECT_EQ(2 * 384u, pool.bytes_allocated());
+  // Once they're returned, the next request releases all but one of them.
+  buffer1 = nullptr;
+  buffer2 = nullptr;
+  pool.CreateBuffer(16, 16);
+  EXPECT_EQ(384u, pool.bytes_allocated());
+}
+
 TEST(TestI420BufferPool, ExclusiveOwner) {
   // Check that created buffers are exclusive so that they can be written to.
   I420BufferPool pool;
@@ -243,6 +243,22 @@ TEST(TestVideoFrame, TextureInitialValues) {
   EXPECT_EQ(20, frame.render_time_ms());
 }
 
+TEST(TestVideoFrame, TextureIsConvertedToI420Once) {
+  test::FakeNativeHandle* handle = new test::FakeNativeHandle();
+  VideoFrame frame = test::FakeNativeHandle::CreateFrame(
+      handle, 640, 480, 100, 10, webrtc::kVideoRotation_0);
+  VideoFrame converted_frame1 = frame.ConvertNativeToI420Frame();
+  VideoFrame converted_frame2 = frame.ConvertNativeToI420Frame();
+  ASSERT_TRUE(converted_frame1.video_frame_buffer() != nullptr);
+  EXPECT_EQ(nullptr, converted_frame1.video_frame_buffer()->native_handle());
+  EXPECT_EQ(640, converted_frame1.width());
+  EXPECT_EQ(480, converted_frame1.height());
+  // Both consumers of the frame get the same buffer, which neither may modify.
+  EXPECT_EQ(converted_frame1.video_frame_buffer(),
+            converted_frame2.video_frame_buffer());
+  EXPECT_FALSE(converted_frame1.video_frame_buffer()->IsMutable());
+}
+
 TEST(TestI420FrameBuffer, Copy) {
   rtc::scoped_refptr<I420Buffer> buf1(
       new rtc::RefCountedObject<I420Buffer>(20, 10));
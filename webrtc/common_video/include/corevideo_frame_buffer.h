@@ -17,15 +17,46 @@
 
 namespace webrtc {
 
+// Wraps an NV12 CVPixelBuffer. The buffer can also describe a cropped and
+// scaled version of the pixel buffer, which lets a capturer adapt the
+// resolution without touching the pixels. The cropping and scaling is then
+// done by whoever needs the pixels, straight into their destination.
 class CoreVideoFrameBuffer : public NativeHandleBuffer {
  public:
   explicit CoreVideoFrameBuffer(CVPixelBufferRef pixel_buffer);
+  // The |crop_width| x |crop_height| rectangle at (|crop_x|, |crop_y|) of
+  // |pixel_buffer|, scaled to |adapted_width| x |adapted_height|.
+  CoreVideoFrameBuffer(CVPixelBufferRef pixel_buffer,
+                       int adapted_width,
+                       int adapted_height,
+                       int crop_width,
+                       int crop_height,
+                       int crop_x,
+                       int crop_y);
   ~CoreVideoFrameBuffer() override;
 
-  rtc::scoped_refptr<VideoFrameBuffer> NativeToI420Buffer() override;
+  // Returns true if the pixel buffer has to be cropped or scaled before it
+  // can be used as a frame of width() x height().
+  bool RequiresCropping() const;
+
+  // Crops and scales the pixel buffer into |output_pixel_buffer|, which must
+  // be an NV12 pixel buffer of any size. Uses vImage, so the planes are never
+  // converted to I420.
+  bool CropAndScaleTo(CVPixelBufferRef output_pixel_buffer) const;
+
+ protected:
+  rtc::scoped_refptr<VideoFrameBuffer> ConvertToI420() override;
 
  private:
   CVPixelBufferRef pixel_buffer_;
+  // Size of |pixel_buffer_|, and the part of it that makes up the frame.
+  const int buffer_width_;
+  const int buffer_height_;
+  const int crop_width_;
+  const int crop_height_;
+  // Even, since the chroma planes are subsampled.
+  const int crop_x_;
+  const int crop_y_;
 };
 
 }  // namespace webrtc
@@ -12,6 +12,8 @@
 #define WEBRTC_COMMON_VIDEO_INCLUDE_I420_BUFFER_POOL_H_
 
 #include <list>
+#include <map>
+#include <utility>
 
 #include "webrtc/base/thread_checker.h"
 #include "webrtc/common_video/include/video_frame_buffer.h"
@@ -21,29 +23,60 @@ namespace webrtc {
 // Simple buffer pool to avoid unnecessary allocations of I420Buffer objects.
 // The pool manages the memory of the I420Buffer returned from CreateBuffer.
 // When the I420Buffer is destructed, the memory is returned to the pool for use
-// by subsequent calls to CreateBuffer. If the resolution passed to CreateBuffer
-// changes, old buffers will be purged from the pool.
+// by subsequent calls to CreateBuffer.
+//
+// Buffers are kept in one sub-pool per resolution, so that a sender that
+// switches back and forth between resolutions (e.g. because of VideoAdapter or
+// QualityScaler) can keep reusing its buffers. Once the pool holds more than
+// its byte cap, free buffers are released, starting with the resolution that
+// was least recently asked for. Buffers in use are never released.
 class I420BufferPool {
  public:
+  static const size_t kDefaultMaxBytes;
+
   I420BufferPool() : I420BufferPool(false) {}
   explicit I420BufferPool(bool zero_initialize);
+  I420BufferPool(bool zero_initialize, size_t max_bytes);
 
   // Returns a buffer from the pool, or creates a new buffer if no suitable
   // buffer exists in the pool.
   rtc::scoped_refptr<VideoFrameBuffer> CreateBuffer(int width, int height);
-  // Clears buffers_ and detaches the thread checker so that it can be reused
-  // later from another thread.
+  // Clears all buffers and detaches the thread checker so that it can be
+  // reused later from another thread.
   void Release();
 
+  // The number of CreateBuffer() calls that reused a buffer, and that had to
+  // allocate a new one.
+  int num_hits() const { return num_hits_; }
+  int num_misses() const { return num_misses_; }
+  // The memory held by the pool, including the buffers in use.
+  size_t bytes_allocated() const { return bytes_allocated_; }
+
  private:
+  struct SubPool {
+    std::list<rtc::scoped_refptr<I420Buffer>> buffers;
+    // The value of |num_requests_| when this resolution was last asked for.
+    int64_t last_request = 0;
+  };
+
+  // Releases free buffers until the pool is within |max_bytes_| again, or only
+  // buffers in use are left.
+  void ReleaseUnusedBuffers();
+
   rtc::ThreadChecker thread_checker_;
-  std::list<rtc::scoped_refptr<I420Buffer>> buffers_;
+  // Sub-pools keyed by (width, height).
+  std::map<std::pair<int, int>, SubPool> sub_pools_;
   // If true, newly allocated buffers are zero-initialized. Note that recycled
   // buffers are not zero'd before reuse. This is required of buffers used by
   // FFmpeg according to http://crbug.com/390941, which only requires it for the
   // initial allocation (as shown by FFmpeg's own buffer allocation code). It
   // has to do with "Use-of-uninitialized-value" on "Linux_msan_chrome".
-  bool zero_initialize_;
+  const bool zero_initialize_;
+  const size_t max_bytes_;
+  size_t bytes_allocated_;
+  int64_t num_requests_;
+  int num_hits_;
+  int num_misses_;
 };
 
 }  // namespace webrtc
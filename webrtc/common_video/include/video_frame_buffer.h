@@ -16,6 +16,7 @@
 #include <memory>
 
 #include "webrtc/base/callback.h"
+#include "webrtc/base/criticalsection.h"
 #include "webrtc/base/refcount.h"
 #include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/system_wrappers/include/aligned_malloc.h"
@@ -154,10 +155,26 @@ class NativeHandleBuffer : public VideoFrameBuffer {
   void* native_handle() const override;
   bool IsMutable() override;
 
+  // Converts the native handle with ConvertToI420() on the first call, and
+  // returns the same buffer on later calls. A frame is often delivered to
+  // several consumers, e.g. by a VideoBroadcaster, which then share a single
+  // conversion. Since the returned buffer is shared, it is not mutable.
+  rtc::scoped_refptr<VideoFrameBuffer> NativeToI420Buffer() override;
+
  protected:
+  // Returns a new memory-backed frame buffer converted from the native handle.
+  // The default returns nullptr; it is only reached by subclasses which
+  // override neither this method nor NativeToI420Buffer().
+  virtual rtc::scoped_refptr<VideoFrameBuffer> ConvertToI420();
+
   void* native_handle_;
   const int width_;
   const int height_;
+
+ private:
+  rtc::CriticalSection i420_buffer_lock_;
+  rtc::scoped_refptr<VideoFrameBuffer> i420_buffer_
+      GUARDED_BY(i420_buffer_lock_);
 };
 
 class WrappedI420Buffer : public webrtc::VideoFrameBuffer {
@@ -258,6 +258,18 @@ void* NativeHandleBuffer::native_handle() const {
   return native_handle_;
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> NativeHandleBuffer::NativeToI420Buffer() {
+  rtc::CritScope cs(&i420_buffer_lock_);
+  if (!i420_buffer_)
+    i420_buffer_ = ConvertToI420();
+  return i420_buffer_;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> NativeHandleBuffer::ConvertToI420() {
+  RTC_NOTREACHED();  // Should be overridden.
+  return nullptr;
+}
+
 WrappedI420Buffer::WrappedI420Buffer(int width,
                                      int height,
                                      const uint8_t* y_plane,
@@ -148,6 +148,35 @@ struct VoicePacing {
   bool enabled;
 };
 
+// Makes the VoiceEngine playout mixer decode its channels in parallel, on
+// |num_threads| threads including the audio device's playout thread. Channels
+// that haven't decoded |deadline_ms| after the mixer started are played out as
+// silence for that 10 ms frame, and their audio is used in the next frame.
+struct ParallelPlayoutMixing {
+  ParallelPlayoutMixing() : num_threads(1), deadline_ms(0) {}
+  ParallelPlayoutMixing(size_t threads, int deadline)
+      : num_threads(threads), deadline_ms(deadline) {}
+  static const ConfigOptionID identifier =
+      ConfigOptionID::kParallelPlayoutMixing;
+  size_t num_threads;
+  int deadline_ms;
+};
+
+// Lets a VoiceEngine channel share its encoder output with other sending
+// channels that have the option set and an identical send codec, VAD, RED and
+// Opus configuration. Only one channel in such a group encodes each 10 ms
+// frame, and its packets are sent on all of them, each with its own RTP
+// header. A channel that mutes its input, plays a file as microphone or has
+// external media processing on its input encodes on its own, and so does one
+// whose encoder adapts to its own network, through codec FEC or a bitrate set
+// by bandwidth estimation.
+struct SharedSendEncoding {
+  SharedSendEncoding() : enabled(false) {}
+  explicit SharedSendEncoding(bool value) : enabled(value) {}
+  static const ConfigOptionID identifier = ConfigOptionID::kSharedSendEncoding;
+  bool enabled;
+};
+
 }  // namespace webrtc
 
 #endif  // WEBRTC_CONFIG_H_
@@ -11,6 +11,7 @@
 #include <iostream>  // NOLINT
 
 #include "webrtc/p2p/base/basicpacketsocketfactory.h"
+#include "webrtc/p2p/base/shardedturnserver.h"
 #include "webrtc/p2p/base/turnserver.h"
 #include "webrtc/base/asyncudpsocket.h"
 #include "webrtc/base/optionsfile.h"
@@ -42,8 +43,8 @@ class TurnFileAuth : public cricket::TurnAuthInterface {
 };
 
 int main(int argc, char **argv) {
-  if (argc != 5) {
-    std::cerr << "usage: turnserver int-addr ext-ip realm auth-file"
+  if (argc != 5 && argc != 6) {
+    std::cerr << "usage: turnserver int-addr ext-ip realm auth-file [threads]"
               << std::endl;
     return 1;
   }
@@ -60,7 +61,33 @@ int main(int argc, char **argv) {
     return 1;
   }
 
+  int num_threads = 1;
+  if (argc == 6 && (!rtc::FromString(argv[5], &num_threads) ||
+                    num_threads < 1)) {
+    std::cerr << "Invalid thread count: " << argv[5] << std::endl;
+    return 1;
+  }
+
   rtc::Thread* main = rtc::Thread::Current();
+  TurnFileAuth auth(argv[4]);
+  if (num_threads > 1) {
+    // Each thread serves the clients the kernel hashes to its socket.
+    cricket::ShardedTurnServer server(num_threads);
+    server.set_realm(argv[3]);
+    server.set_software(kSoftware);
+    server.set_auth_hook(&auth);
+    if (!server.Start(int_addr, ext_addr)) {
+      std::cerr << "Failed to start " << num_threads
+                << " TURN server threads at " << int_addr.ToString()
+                << std::endl;
+      return 1;
+    }
+    std::cout << "Listening internally at " << int_addr.ToString() << " on "
+              << num_threads << " threads" << std::endl;
+    main->Run();
+    return 0;
+  }
+
   rtc::AsyncUDPSocket* int_socket =
       rtc::AsyncUDPSocket::Create(main->socketserver(), int_addr);
   if (!int_socket) {
@@ -70,7 +97,6 @@ int main(int argc, char **argv) {
   }
 
   cricket::TurnServer server(main);
-  TurnFileAuth auth(argv[4]);
   server.set_realm(argv[3]);
   server.set_software(kSoftware);
   server.set_auth_hook(&auth);
@@ -21,7 +21,10 @@ namespace buzz {
 
 XmlnsStack::XmlnsStack() :
   pxmlnsStack_(new std::vector<std::string>),
-  pxmlnsDepthStack_(new std::vector<size_t>) {
+  pxmlnsDepthStack_(new std::vector<size_t>),
+  ns_xml_(NS_XML),
+  ns_xmlns_(NS_XMLNS),
+  ns_none_(STR_EMPTY) {
 }
 
 XmlnsStack::~XmlnsStack() {}
@@ -41,29 +44,36 @@ void XmlnsStack::PopFrame() {
 
 std::pair<std::string, bool> XmlnsStack::NsForPrefix(
     const std::string& prefix) {
+  const std::string* ns = LookupNs(prefix);
+  if (!ns)
+    return std::make_pair(ns_none_, false);
+  return std::make_pair(*ns, true);
+}
+
+const std::string* XmlnsStack::LookupNs(const std::string& prefix) {
   if (prefix.length() >= 3 &&
       (prefix[0] == 'x' || prefix[0] == 'X') &&
       (prefix[1] == 'm' || prefix[1] == 'M') &&
       (prefix[2] == 'l' || prefix[2] == 'L')) {
     if (prefix == "xml")
-      return std::make_pair(NS_XML, true);
+      return &ns_xml_;
     if (prefix == "xmlns")
-      return std::make_pair(NS_XMLNS, true);
+      return &ns_xmlns_;
     // Other names with xml prefix are illegal.
-    return std::make_pair(STR_EMPTY, false);
+    return NULL;
   }
 
   std::vector<std::string>::iterator pos;
   for (pos = pxmlnsStack_->end(); pos > pxmlnsStack_->begin(); ) {
     pos -= 2;
     if (*pos == prefix)
-      return std::make_pair(*(pos + 1), true);
+      return &*(pos + 1);
   }
 
-  if (prefix == STR_EMPTY)
-    return std::make_pair(STR_EMPTY, true);  // default namespace
+  if (prefix.empty())
+    return &ns_none_;  // default namespace
 
-  return std::make_pair(STR_EMPTY, false);  // none found
+  return NULL;  // none found
 }
 
 bool XmlnsStack::PrefixMatchesNs(const std::string& prefix,
@@ -30,6 +30,9 @@ public:
   void Reset();
 
   std::pair<std::string, bool> NsForPrefix(const std::string& prefix);
+  // Like NsForPrefix, but returns the bound namespace without copying it, or
+  // NULL if |prefix| is not bound. Valid until the stack is next modified.
+  const std::string* LookupNs(const std::string& prefix);
   bool PrefixMatchesNs(const std::string & prefix, const std::string & ns);
   std::pair<std::string, bool> PrefixForNs(const std::string& ns, bool isAttr);
   std::pair<std::string, bool> AddNewPrefix(const std::string& ns, bool isAttr);
@@ -39,6 +42,9 @@ private:
 
   std::unique_ptr<std::vector<std::string> > pxmlnsStack_;
   std::unique_ptr<std::vector<size_t> > pxmlnsDepthStack_;
+  const std::string ns_xml_;
+  const std::string ns_xmlns_;
+  const std::string ns_none_;
 };
 }
 
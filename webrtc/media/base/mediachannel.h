@@ -101,6 +101,12 @@ struct MediaConfig {
   // PeerConnection constraint 'googDscp'.
   bool enable_dscp = false;
 
+  // Deliver received RTP and RTCP packets to webrtc::Call on the network
+  // thread, instead of posting each of them to the worker thread first.
+  // Packets for unknown SSRCs still take the worker thread, where default
+  // receive streams are created.
+  bool deliver_packets_on_network_thread = false;
+
   // Video-specific config.
   struct Video {
     // Enable WebRTC CPU Overuse Detection. This flag comes from the
@@ -374,8 +380,14 @@ class MediaChannel : public sigslot::has_slots<> {
   };
 
   MediaChannel(const MediaConfig& config)
-      : enable_dscp_(config.enable_dscp), network_interface_(NULL) {}
-  MediaChannel() : enable_dscp_(false), network_interface_(NULL) {}
+      : enable_dscp_(config.enable_dscp),
+        deliver_packets_on_network_thread_(
+            config.deliver_packets_on_network_thread),
+        network_interface_(NULL) {}
+  MediaChannel()
+      : enable_dscp_(false),
+        deliver_packets_on_network_thread_(false),
+        network_interface_(NULL) {}
   virtual ~MediaChannel() {}
 
   // Sets the abstract interface class for sending RTP/RTCP data.
@@ -393,6 +405,16 @@ class MediaChannel : public sigslot::has_slots<> {
   // Called when a RTCP packet is received.
   virtual void OnRtcpReceived(rtc::CopyOnWriteBuffer* packet,
                               const rtc::PacketTime& packet_time) = 0;
+  // Called on the network thread when a RTP or RTCP packet is received, if
+  // MediaConfig::deliver_packets_on_network_thread is set. Returns false if
+  // the packet wasn't handled and must be passed to OnPacketReceived or
+  // OnRtcpReceived on the worker thread.
+  virtual bool OnPacketReceivedOnNetworkThread(
+      bool rtcp,
+      const rtc::CopyOnWriteBuffer& packet,
+      const rtc::PacketTime& packet_time) {
+    return false;
+  }
   // Called when the socket's ability to send has changed.
   virtual void OnReadyToSend(bool ready) = 0;
   // Called when the network route used for sending packets changed.
@@ -440,6 +462,11 @@ class MediaChannel : public sigslot::has_slots<> {
     return network_interface_->SetOption(type, opt, option);
   }
 
+ protected:
+  bool deliver_packets_on_network_thread() const {
+    return deliver_packets_on_network_thread_;
+  }
+
  private:
   // This method sets DSCP |value| on both RTP and RTCP channels.
   int SetDscp(rtc::DiffServCodePoint value) {
@@ -467,6 +494,7 @@ class MediaChannel : public sigslot::has_slots<> {
   }
 
   const bool enable_dscp_;
+  const bool deliver_packets_on_network_thread_;
   // |network_interface_| can be accessed from the worker_thread and
   // from any MediaEngine threads. This critical section is to protect accessing
   // of network_interface_ object.
@@ -827,6 +855,11 @@ struct DataMediaInfo {
 };
 
 struct RtcpParameters {
+  bool operator==(const RtcpParameters& o) const {
+    return reduced_size == o.reduced_size;
+  }
+  bool operator!=(const RtcpParameters& o) const { return !(*this == o); }
+
   bool reduced_size = false;
 };
 
@@ -841,6 +874,13 @@ struct RtpParameters {
     return ost.str();
   }
 
+  bool operator==(const RtpParameters<Codec>& o) const {
+    return codecs == o.codecs && extensions == o.extensions && rtcp == o.rtcp;
+  }
+  bool operator!=(const RtpParameters<Codec>& o) const {
+    return !(*this == o);
+  }
+
   std::vector<Codec> codecs;
   std::vector<RtpHeaderExtension> extensions;
   // TODO(pthatcher): Add streams.
@@ -862,6 +902,14 @@ struct RtpSendParameters : RtpParameters<Codec> {
     return ost.str();
   }
 
+  bool operator==(const RtpSendParameters<Codec>& o) const {
+    return RtpParameters<Codec>::operator==(o) &&
+           max_bandwidth_bps == o.max_bandwidth_bps;
+  }
+  bool operator!=(const RtpSendParameters<Codec>& o) const {
+    return !(*this == o);
+  }
+
   int max_bandwidth_bps = -1;
 };
 
@@ -877,6 +925,11 @@ struct AudioSendParameters : RtpSendParameters<AudioCodec> {
     return ost.str();
   }
 
+  bool operator==(const AudioSendParameters& o) const {
+    return RtpSendParameters<AudioCodec>::operator==(o) && options == o.options;
+  }
+  bool operator!=(const AudioSendParameters& o) const { return !(*this == o); }
+
   AudioOptions options;
 };
 
@@ -959,6 +1012,12 @@ class VoiceMediaChannel : public MediaChannel {
 // TODO(deadbeef): Rename to VideoSenderParameters, since they're intended to
 // encapsulate all the parameters needed for a video RtpSender.
 struct VideoSendParameters : RtpSendParameters<VideoCodec> {
+  bool operator==(const VideoSendParameters& o) const {
+    return RtpSendParameters<VideoCodec>::operator==(o) &&
+           conference_mode == o.conference_mode;
+  }
+  bool operator!=(const VideoSendParameters& o) const { return !(*this == o); }
+
   // Use conference mode? This flag comes from the remote
   // description's SDP line 'a=x-google-flag:conference', copied over
   // by VideoChannel::SetRemoteContent_w, and ultimately used by
@@ -28,6 +28,7 @@ static const size_t kRtpSsrcOffset = 8;
 static const size_t kRtcpPayloadTypeOffset = 1;
 static const size_t kRtpExtensionHeaderLen = 4;
 static const size_t kAbsSendTimeExtensionLen = 3;
+static const size_t kAudioLevelExtensionLen = 1;
 static const size_t kOneByteExtensionHeaderLen = 1;
 
 namespace {
@@ -331,12 +332,13 @@ bool ValidateRtpHeader(const uint8_t* rtp,
   return true;
 }
 
-// ValidateRtpHeader() must be called before this method to make sure, we have
-// a sane rtp packet.
-bool UpdateRtpAbsSendTimeExtension(uint8_t* rtp,
-                                   size_t length,
-                                   int extension_id,
-                                   uint64_t time_us) {
+// Finds the one-byte header extension with |extension_id|, which must carry
+// |data_length| bytes of data, and sets |offset| to the position of its data.
+static bool FindRtpOneByteExtension(const uint8_t* rtp,
+                                    size_t length,
+                                    int extension_id,
+                                    size_t data_length,
+                                    size_t* offset) {
   //  0                   1                   2                   3
   //  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
   // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -352,9 +354,10 @@ bool UpdateRtpAbsSendTimeExtension(uint8_t* rtp,
 
   // Return if extension bit is not set.
   if (!(rtp[0] & 0x10)) {
-    return true;
+    return false;
   }
 
+  const uint8_t* const packet_start = rtp;
   size_t cc_count = rtp[0] & 0x0F;
   size_t header_length_without_extension = kMinRtpPacketLen + 4 * cc_count;
 
@@ -368,7 +371,6 @@ bool UpdateRtpAbsSendTimeExtension(uint8_t* rtp,
 
   rtp += kRtpExtensionHeaderLen;  // Moving past extension header.
 
-  bool found = false;
   // WebRTC is using one byte header extension.
   // TODO(mallinath) - Handle two byte header extension.
   if (profile_id == 0xBEDE) {  // OneByte extension header
@@ -401,10 +403,10 @@ bool UpdateRtpAbsSendTimeExtension(uint8_t* rtp,
       // The 4-bit length is the number minus one of data bytes of this header
       // extension element following the one-byte header.
       if (id == extension_id) {
-        UpdateAbsSendTimeExtensionValue(rtp + kOneByteExtensionHeaderLen,
-                                        length, time_us);
-        found = true;
-        break;
+        if (length != data_length)
+          return false;
+        *offset = rtp + kOneByteExtensionHeaderLen - packet_start;
+        return true;
       }
       rtp += kOneByteExtensionHeaderLen + length;
       // Counting padding bytes.
@@ -413,7 +415,54 @@ bool UpdateRtpAbsSendTimeExtension(uint8_t* rtp,
       }
     }
   }
-  return found;
+  return false;
+}
+
+bool FindRtpAbsSendTimeExtension(const uint8_t* rtp,
+                                 size_t length,
+                                 int extension_id,
+                                 size_t* offset) {
+  return FindRtpOneByteExtension(rtp, length, extension_id,
+                                 kAbsSendTimeExtensionLen, offset);
+}
+
+bool GetRtpAudioLevel(const uint8_t* rtp,
+                      size_t length,
+                      int extension_id,
+                      int* level_dbov,
+                      bool* voice_activity) {
+  //  0                   1
+  //  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
+  // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  // |  ID   | len=0 |V|   level     |
+  // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  size_t offset;
+  if (!FindRtpOneByteExtension(rtp, length, extension_id,
+                               kAudioLevelExtensionLen, &offset)) {
+    return false;
+  }
+  *voice_activity = (rtp[offset] & 0x80) != 0;
+  *level_dbov = rtp[offset] & 0x7F;
+  return true;
+}
+
+// ValidateRtpHeader() must be called before this method to make sure, we have
+// a sane rtp packet.
+bool UpdateRtpAbsSendTimeExtension(uint8_t* rtp,
+                                   size_t length,
+                                   int extension_id,
+                                   uint64_t time_us) {
+  // Return if extension bit is not set.
+  if (!(rtp[0] & 0x10)) {
+    return true;
+  }
+
+  size_t offset;
+  if (!FindRtpAbsSendTimeExtension(rtp, length, extension_id, &offset))
+    return false;
+  UpdateAbsSendTimeExtensionValue(rtp + offset, kAbsSendTimeExtensionLen,
+                                  time_us);
+  return true;
 }
 
 bool ApplyPacketOptions(uint8_t* data,
@@ -449,9 +498,19 @@ bool ApplyPacketOptions(uint8_t* data,
 
   uint8_t* start = data + rtp_start_pos;
   // If packet option has non default value (-1) for sendtime extension id,
-  // then we should parse the rtp packet to update the timestamp. Otherwise
-  // just calculate HMAC and update packet with it.
-  if (packet_time_params.rtp_sendtime_extension_id != -1) {
+  // then we should update the timestamp, at the offset found when the packet
+  // was prepared or else by parsing the rtp packet. Otherwise just calculate
+  // HMAC and update packet with it.
+  if (packet_time_params.rtp_sendtime_extension_offset != -1) {
+    const size_t offset =
+        static_cast<size_t>(packet_time_params.rtp_sendtime_extension_offset);
+    if (offset + kAbsSendTimeExtensionLen > rtp_length) {
+      RTC_NOTREACHED();
+      return false;
+    }
+    UpdateAbsSendTimeExtensionValue(start + offset, kAbsSendTimeExtensionLen,
+                                    time_us);
+  } else if (packet_time_params.rtp_sendtime_extension_id != -1) {
     UpdateRtpAbsSendTimeExtension(start, rtp_length,
                                   packet_time_params.rtp_sendtime_extension_id,
                                   time_us);
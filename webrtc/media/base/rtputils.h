@@ -63,6 +63,25 @@ bool ValidateRtpHeader(const uint8_t* rtp,
                        size_t length,
                        size_t* header_length);
 
+// Finds the one-byte header absolute send time extension with |extension_id|
+// and sets |offset| to the position of its data in the packet.
+// ValidateRtpHeader() must have accepted the packet.
+bool FindRtpAbsSendTimeExtension(const uint8_t* rtp,
+                                 size_t length,
+                                 int extension_id,
+                                 size_t* offset);
+
+// Reads the RFC 6464 client-to-mixer audio level of a packet from the one-byte
+// header extension with |extension_id|. |level_dbov| is the level in -dBov,
+// from 0 (loudest) to 127 (silence), and |voice_activity| is the sender's
+// voice activity flag. Returns false if the packet doesn't carry the
+// extension. ValidateRtpHeader() must have accepted the packet.
+bool GetRtpAudioLevel(const uint8_t* rtp,
+                      size_t length,
+                      int extension_id,
+                      int* level_dbov,
+                      bool* voice_activity);
+
 // Helper method which updates the absolute send time extension if present.
 bool UpdateRtpAbsSendTimeExtension(uint8_t* rtp,
                                    size_t length,
@@ -70,7 +89,9 @@ bool UpdateRtpAbsSendTimeExtension(uint8_t* rtp,
                                    uint64_t time_us);
 
 // Applies specified |options| to the packet. It updates the absolute send time
-// extension header if it is present present then updates HMAC.
+// extension header if it is present present then updates HMAC. The extension
+// is written at |rtp_sendtime_extension_offset| if that is set, instead of
+// being looked up.
 bool ApplyPacketOptions(uint8_t* data,
                         size_t length,
                         const rtc::PacketTimeUpdateParams& packet_time_params,
@@ -85,6 +85,16 @@ static uint8_t kRtpMsgWithAbsSendTimeExtension[] = {
 // Index of AbsSendTimeExtn data in message |kRtpMsgWithAbsSendTimeExtension|.
 static const int kAstIndexInRtpMsg = 21;
 
+// RTP packet with single byte extension header of length 4 bytes.
+// Audio level extension id = 1, voice activity set and level -30 dBov.
+static uint8_t kRtpMsgWithAudioLevelExtension[] = {
+  0x90, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  0xBE, 0xDE, 0x00, 0x01,
+  0x10, 0x9E, 0x00, 0x00,
+};
+
 TEST(RtpUtilsTest, GetRtp) {
   EXPECT_TRUE(IsRtpPacket(kPcmuFrame, sizeof(kPcmuFrame)));
 
@@ -321,6 +331,36 @@ TEST(RtpUtilsTest, UpdateAbsSendTimeExtensionInRtpPacket) {
                       sizeof(kExpectedTimestamp)));
 }
 
+// Verify the offset of the AbsSendTime extension data is found.
+TEST(RtpUtilsTest, FindAbsSendTimeExtensionInRtpPacket) {
+  size_t offset = 0;
+  EXPECT_TRUE(FindRtpAbsSendTimeExtension(
+      kRtpMsgWithAbsSendTimeExtension, sizeof(kRtpMsgWithAbsSendTimeExtension),
+      3, &offset));
+  EXPECT_EQ(static_cast<size_t>(kAstIndexInRtpMsg), offset);
+  EXPECT_FALSE(FindRtpAbsSendTimeExtension(
+      kRtpMsgWithAbsSendTimeExtension, sizeof(kRtpMsgWithAbsSendTimeExtension),
+      4, &offset));
+}
+
+// Verify the audio level and voice activity flag are read.
+TEST(RtpUtilsTest, GetAudioLevelFromRtpPacket) {
+  int level_dbov = 0;
+  bool voice_activity = false;
+  EXPECT_TRUE(GetRtpAudioLevel(
+      kRtpMsgWithAudioLevelExtension, sizeof(kRtpMsgWithAudioLevelExtension),
+      1, &level_dbov, &voice_activity));
+  EXPECT_EQ(30, level_dbov);
+  EXPECT_TRUE(voice_activity);
+  EXPECT_FALSE(GetRtpAudioLevel(
+      kRtpMsgWithAudioLevelExtension, sizeof(kRtpMsgWithAudioLevelExtension),
+      2, &level_dbov, &voice_activity));
+  // The abs-send-time extension has the wrong length for an audio level.
+  EXPECT_FALSE(GetRtpAudioLevel(
+      kRtpMsgWithAbsSendTimeExtension, sizeof(kRtpMsgWithAbsSendTimeExtension),
+      3, &level_dbov, &voice_activity));
+}
+
 // Verify we update both AbsSendTime extension header and HMAC.
 TEST(RtpUtilsTest, ApplyPacketOptionsWithAuthParamsAndAbsSendTime) {
   rtc::PacketTimeUpdateParams packet_time_params;
@@ -348,4 +388,29 @@ TEST(RtpUtilsTest, ApplyPacketOptionsWithAuthParamsAndAbsSendTime) {
 }
 
 
+// Verify the AbsSendTime extension is written at a precomputed offset.
+TEST(RtpUtilsTest, ApplyPacketOptionsWithAbsSendTimeOffset) {
+  rtc::PacketTimeUpdateParams packet_time_params;
+  packet_time_params.srtp_auth_key.assign(kTestKey,
+                                          kTestKey + sizeof(kTestKey));
+  packet_time_params.srtp_auth_tag_len = 4;
+  packet_time_params.rtp_sendtime_extension_id = 3;
+  packet_time_params.rtp_sendtime_extension_offset = kAstIndexInRtpMsg;
+
+  std::vector<uint8_t> rtp_packet(kRtpMsgWithAbsSendTimeExtension,
+                                  kRtpMsgWithAbsSendTimeExtension +
+                                      sizeof(kRtpMsgWithAbsSendTimeExtension));
+  rtp_packet.insert(rtp_packet.end(), kFakeTag, kFakeTag + sizeof(kFakeTag));
+  EXPECT_TRUE(ApplyPacketOptions(&rtp_packet[0], rtp_packet.size(),
+                                 packet_time_params, 51183266));
+
+  // Same result as when the extension is looked up.
+  const uint8_t kExpectedTag[] = {0x81, 0xd1, 0x2c, 0x0e};
+  EXPECT_EQ(0, memcmp(&rtp_packet[sizeof(kRtpMsgWithAbsSendTimeExtension)],
+                      kExpectedTag, sizeof(kExpectedTag)));
+  const uint8_t kExpectedTimestamp[3] = {0xcc, 0xbb, 0xaa};
+  EXPECT_EQ(0, memcmp(&rtp_packet[kAstIndexInRtpMsg], kExpectedTimestamp,
+                      sizeof(kExpectedTimestamp)));
+}
+
 }  // namespace cricket
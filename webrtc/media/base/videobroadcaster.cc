@@ -13,6 +13,7 @@
 #include <limits>
 
 #include "webrtc/base/checks.h"
+#include "webrtc/base/timeutils.h"
 
 namespace rtc {
 
@@ -25,6 +26,8 @@ void VideoBroadcaster::AddOrUpdateSink(
     const VideoSinkWants& wants) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   RTC_DCHECK(sink != nullptr);
+  rtc::CritScope delivery_cs(&delivery_lock_);
+  UpdateSinkAdapter(sink, wants);
   rtc::CritScope cs(&sinks_and_wants_lock_);
   VideoSourceBase::AddOrUpdateSink(sink, wants);
   UpdateWants();
@@ -34,6 +37,8 @@ void VideoBroadcaster::RemoveSink(
     VideoSinkInterface<cricket::VideoFrame>* sink) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   RTC_DCHECK(sink != nullptr);
+  rtc::CritScope delivery_cs(&delivery_lock_);
+  sink_adapters_.erase(sink);
   rtc::CritScope cs(&sinks_and_wants_lock_);
   VideoSourceBase::RemoveSink(sink);
   UpdateWants();
@@ -51,14 +56,40 @@ VideoSinkWants VideoBroadcaster::wants() const {
 }
 
 void VideoBroadcaster::OnFrame(const cricket::VideoFrame& frame) {
-  rtc::CritScope cs(&sinks_and_wants_lock_);
+  // The sinks can't change without |delivery_lock_|, so they are read without
+  // |sinks_and_wants_lock_|.
+  rtc::CritScope cs(&delivery_lock_);
   for (auto& sink_pair : sink_pairs()) {
+    const cricket::VideoFrame* sink_frame = &frame;
+    auto adapter_it = sink_adapters_.find(sink_pair.sink);
+    if (adapter_it != sink_adapters_.end() && frame.video_frame_buffer()) {
+      int cropped_width;
+      int cropped_height;
+      int out_width;
+      int out_height;
+      if (!adapter_it->second->AdaptFrameResolution(
+              frame.width(), frame.height(),
+              frame.timestamp_us() * rtc::kNumNanosecsPerMicrosec,
+              &cropped_width, &cropped_height, &out_width, &out_height) ||
+          out_width == 0 || out_height == 0) {
+        // The sink wants no frames at all.
+        continue;
+      }
+      // Frames backed by a native handle can't be scaled here, and are left
+      // to the sink to scale.
+      if ((out_width != frame.width() || out_height != frame.height()) &&
+          !frame.video_frame_buffer()->native_handle()) {
+        sink_frame = &GetScaledFrame(frame, out_width, out_height);
+      }
+    }
     if (sink_pair.wants.black_frames) {
-      sink_pair.sink->OnFrame(GetBlackFrame(frame));
+      sink_pair.sink->OnFrame(GetBlackFrame(*sink_frame));
     } else {
-      sink_pair.sink->OnFrame(frame);
+      sink_pair.sink->OnFrame(*sink_frame);
     }
   }
+  // Sinks which keep a scaled frame hold a reference to its buffer.
+  scaled_frames_.clear();
 }
 
 void VideoBroadcaster::UpdateWants() {
@@ -66,25 +97,35 @@ void VideoBroadcaster::UpdateWants() {
 
   VideoSinkWants wants;
   wants.rotation_applied = false;
+  bool all_sinks_limit_pixels = true;
+  bool all_sinks_step_up = true;
   for (auto& sink : sink_pairs()) {
     // wants.rotation_applied == ANY(sink.wants.rotation_applied)
     if (sink.wants.rotation_applied) {
       wants.rotation_applied = true;
     }
-    // wants.max_pixel_count == MIN(sink.wants.max_pixel_count)
-    if (sink.wants.max_pixel_count &&
-        (!wants.max_pixel_count ||
-         (*sink.wants.max_pixel_count < *wants.max_pixel_count))) {
+    // wants.max_pixel_count == MAX(sink.wants.max_pixel_count), if all sinks
+    // have one.
+    if (!sink.wants.max_pixel_count) {
+      all_sinks_limit_pixels = false;
+    } else if (!wants.max_pixel_count ||
+               *sink.wants.max_pixel_count > *wants.max_pixel_count) {
       wants.max_pixel_count = sink.wants.max_pixel_count;
     }
-    // wants.max_pixel_count_step_up == MIN(sink.wants.max_pixel_count_step_up)
-    if (sink.wants.max_pixel_count_step_up &&
-        (!wants.max_pixel_count_step_up ||
-         (*sink.wants.max_pixel_count_step_up <
-          *wants.max_pixel_count_step_up))) {
+    // wants.max_pixel_count_step_up == MAX(sink.wants.max_pixel_count_step_up),
+    // if all sinks have one.
+    if (!sink.wants.max_pixel_count_step_up) {
+      all_sinks_step_up = false;
+    } else if (!wants.max_pixel_count_step_up ||
+               *sink.wants.max_pixel_count_step_up >
+                   *wants.max_pixel_count_step_up) {
       wants.max_pixel_count_step_up = sink.wants.max_pixel_count_step_up;
     }
   }
+  if (!all_sinks_limit_pixels)
+    wants.max_pixel_count = Optional<int>();
+  if (!all_sinks_step_up)
+    wants.max_pixel_count_step_up = Optional<int>();
 
   if (wants.max_pixel_count && wants.max_pixel_count_step_up &&
       *wants.max_pixel_count_step_up >= *wants.max_pixel_count) {
@@ -93,6 +134,33 @@ void VideoBroadcaster::UpdateWants() {
   current_wants_ = wants;
 }
 
+void VideoBroadcaster::UpdateSinkAdapter(
+    VideoSinkInterface<cricket::VideoFrame>* sink,
+    const VideoSinkWants& wants) {
+  if (!wants.max_pixel_count && !wants.max_pixel_count_step_up) {
+    sink_adapters_.erase(sink);
+    return;
+  }
+  std::unique_ptr<cricket::VideoAdapter>& adapter = sink_adapters_[sink];
+  if (!adapter)
+    adapter.reset(new cricket::VideoAdapter());
+  adapter->OnResolutionRequest(wants.max_pixel_count,
+                               wants.max_pixel_count_step_up);
+}
+
+const cricket::VideoFrame& VideoBroadcaster::GetScaledFrame(
+    const cricket::VideoFrame& frame,
+    int width,
+    int height) {
+  for (const auto& scaled_frame : scaled_frames_) {
+    if (scaled_frame->width() == width && scaled_frame->height() == height)
+      return *scaled_frame;
+  }
+  scaled_frames_.push_back(std::unique_ptr<cricket::VideoFrame>(
+      frame.Stretch(width, height, true /* interpolate */, true /* crop */)));
+  return *scaled_frames_.back();
+}
+
 const cricket::VideoFrame& VideoBroadcaster::GetBlackFrame(
     const cricket::VideoFrame& frame) {
   if (black_frame_ && black_frame_->width() == frame.width() &&
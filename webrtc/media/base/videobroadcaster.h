@@ -11,12 +11,14 @@
 #ifndef WEBRTC_MEDIA_BASE_VIDEOBROADCASTER_H_
 #define WEBRTC_MEDIA_BASE_VIDEOBROADCASTER_H_
 
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_checker.h"
+#include "webrtc/media/base/videoadapter.h"
 #include "webrtc/media/base/videoframe.h"
 #include "webrtc/media/base/videosinkinterface.h"
 #include "webrtc/media/base/videosourcebase.h"
@@ -30,6 +32,9 @@ namespace rtc {
 // Sinks must be added and removed on one and only one thread.
 // Video frames can be broadcasted on any thread. I.e VideoBroadcaster::OnFrame
 // can be called on any thread.
+// The source is asked for the largest resolution that any sink wants, and the
+// frames are scaled down for the sinks that want fewer pixels. Sinks that want
+// the same resolution share a single scaled frame.
 class VideoBroadcaster : public VideoSourceBase,
                          public VideoSinkInterface<cricket::VideoFrame> {
  public:
@@ -49,14 +54,35 @@ class VideoBroadcaster : public VideoSourceBase,
 
  protected:
   void UpdateWants() EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
+  void UpdateSinkAdapter(VideoSinkInterface<cricket::VideoFrame>* sink,
+                         const VideoSinkWants& wants)
+      EXCLUSIVE_LOCKS_REQUIRED(delivery_lock_);
+  const cricket::VideoFrame& GetScaledFrame(const cricket::VideoFrame& frame,
+                                            int width,
+                                            int height)
+      EXCLUSIVE_LOCKS_REQUIRED(delivery_lock_);
   const cricket::VideoFrame& GetBlackFrame(const cricket::VideoFrame& frame)
-      EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
+      EXCLUSIVE_LOCKS_REQUIRED(delivery_lock_);
 
   ThreadChecker thread_checker_;
+  // Held while frames are delivered and while sinks are added or removed, so
+  // that a sink is never called after it has been removed.
+  rtc::CriticalSection delivery_lock_ ACQUIRED_BEFORE(sinks_and_wants_lock_);
+  // Only held while the sinks or their wants are read or changed, so that
+  // frame_wanted() and wants() don't wait for the sinks.
   rtc::CriticalSection sinks_and_wants_lock_;
 
   VideoSinkWants current_wants_ GUARDED_BY(sinks_and_wants_lock_);
-  std::unique_ptr<cricket::WebRtcVideoFrame> black_frame_;
+  // Chooses the resolution of each sink that limits its number of pixels.
+  std::map<VideoSinkInterface<cricket::VideoFrame>*,
+           std::unique_ptr<cricket::VideoAdapter>>
+      sink_adapters_ GUARDED_BY(delivery_lock_);
+  // The frames scaled for the sinks during the current OnFrame() call, at most
+  // one per resolution.
+  std::vector<std::unique_ptr<cricket::VideoFrame>> scaled_frames_
+      GUARDED_BY(delivery_lock_);
+  std::unique_ptr<cricket::WebRtcVideoFrame> black_frame_
+      GUARDED_BY(delivery_lock_);
 };
 
 }  // namespace rtc
@@ -78,46 +78,119 @@ TEST(VideoBroadcasterTest, AppliesRotationIfAnySinkWantsRotationApplied) {
   EXPECT_FALSE(broadcaster.wants().rotation_applied);
 }
 
-TEST(VideoBroadcasterTest, AppliesMinOfSinkWantsMaxPixelCount) {
+TEST(VideoBroadcasterTest, AppliesMaxOfSinkWantsMaxPixelCount) {
   VideoBroadcaster broadcaster;
   EXPECT_TRUE(!broadcaster.wants().max_pixel_count);
 
   FakeVideoRenderer sink1;
   VideoSinkWants wants1;
-  wants1.max_pixel_count = rtc::Optional<int>(1280 * 720);
+  wants1.max_pixel_count = rtc::Optional<int>(640 * 360);
 
   broadcaster.AddOrUpdateSink(&sink1, wants1);
-  EXPECT_EQ(1280 * 720, *broadcaster.wants().max_pixel_count);
+  EXPECT_EQ(640 * 360, *broadcaster.wants().max_pixel_count);
 
   FakeVideoRenderer sink2;
   VideoSinkWants wants2;
-  wants2.max_pixel_count = rtc::Optional<int>(640 * 360);
+  wants2.max_pixel_count = rtc::Optional<int>(1280 * 720);
   broadcaster.AddOrUpdateSink(&sink2, wants2);
-  EXPECT_EQ(640 * 360, *broadcaster.wants().max_pixel_count);
+  EXPECT_EQ(1280 * 720, *broadcaster.wants().max_pixel_count);
 
-  broadcaster.RemoveSink(&sink2);
+  // A sink without a limit lifts the limit of the source.
+  FakeVideoRenderer sink3;
+  broadcaster.AddOrUpdateSink(&sink3, VideoSinkWants());
+  EXPECT_TRUE(!broadcaster.wants().max_pixel_count);
+
+  broadcaster.RemoveSink(&sink3);
   EXPECT_EQ(1280 * 720, *broadcaster.wants().max_pixel_count);
+  broadcaster.RemoveSink(&sink2);
+  EXPECT_EQ(640 * 360, *broadcaster.wants().max_pixel_count);
 }
 
-TEST(VideoBroadcasterTest, AppliesMinOfSinkWantsMaxPixelCountStepUp) {
+TEST(VideoBroadcasterTest, AppliesMaxOfSinkWantsMaxPixelCountStepUp) {
   VideoBroadcaster broadcaster;
   EXPECT_TRUE(!broadcaster.wants().max_pixel_count_step_up);
 
   FakeVideoRenderer sink1;
   VideoSinkWants wants1;
-  wants1.max_pixel_count_step_up = rtc::Optional<int>(1280 * 720);
+  wants1.max_pixel_count_step_up = rtc::Optional<int>(640 * 360);
 
   broadcaster.AddOrUpdateSink(&sink1, wants1);
-  EXPECT_EQ(1280 * 720, *broadcaster.wants().max_pixel_count_step_up);
+  EXPECT_EQ(640 * 360, *broadcaster.wants().max_pixel_count_step_up);
 
   FakeVideoRenderer sink2;
   VideoSinkWants wants2;
-  wants2.max_pixel_count_step_up = rtc::Optional<int>(640 * 360);
+  wants2.max_pixel_count_step_up = rtc::Optional<int>(1280 * 720);
   broadcaster.AddOrUpdateSink(&sink2, wants2);
-  EXPECT_EQ(640 * 360, *broadcaster.wants().max_pixel_count_step_up);
+  EXPECT_EQ(1280 * 720, *broadcaster.wants().max_pixel_count_step_up);
+
+  FakeVideoRenderer sink3;
+  broadcaster.AddOrUpdateSink(&sink3, VideoSinkWants());
+  EXPECT_TRUE(!broadcaster.wants().max_pixel_count_step_up);
 
+  broadcaster.RemoveSink(&sink3);
   broadcaster.RemoveSink(&sink2);
-  EXPECT_EQ(1280 * 720, *broadcaster.wants().max_pixel_count_step_up);
+  EXPECT_EQ(640 * 360, *broadcaster.wants().max_pixel_count_step_up);
+}
+
+namespace {
+// Keeps the last frame it receives.
+class FrameKeepingSink : public rtc::VideoSinkInterface<cricket::VideoFrame> {
+ public:
+  void OnFrame(const cricket::VideoFrame& frame) override {
+    frame_.reset(frame.Copy());
+  }
+  const cricket::VideoFrame* frame() const { return frame_.get(); }
+
+ private:
+  std::unique_ptr<cricket::VideoFrame> frame_;
+};
+}  // namespace
+
+TEST(VideoBroadcasterTest, ScalesFramesForSinksWhichWantFewerPixels) {
+  VideoBroadcaster broadcaster;
+  FrameKeepingSink full_sink;
+  broadcaster.AddOrUpdateSink(&full_sink, VideoSinkWants());
+  VideoSinkWants wants;
+  wants.max_pixel_count = rtc::Optional<int>(640 * 360);
+  FrameKeepingSink scaled_sink1;
+  broadcaster.AddOrUpdateSink(&scaled_sink1, wants);
+  FrameKeepingSink scaled_sink2;
+  broadcaster.AddOrUpdateSink(&scaled_sink2, wants);
+
+  WebRtcVideoFrame frame;
+  frame.InitToBlack(1280, 720, 10000 /*ts*/);
+  broadcaster.OnFrame(frame);
+
+  ASSERT_TRUE(full_sink.frame());
+  EXPECT_EQ(frame.video_frame_buffer(), full_sink.frame()->video_frame_buffer());
+  ASSERT_TRUE(scaled_sink1.frame());
+  EXPECT_EQ(640, scaled_sink1.frame()->width());
+  EXPECT_EQ(360, scaled_sink1.frame()->height());
+  EXPECT_EQ(frame.GetTimeStamp(), scaled_sink1.frame()->GetTimeStamp());
+  // The frame is only scaled once for both sinks.
+  ASSERT_TRUE(scaled_sink2.frame());
+  EXPECT_EQ(scaled_sink1.frame()->video_frame_buffer(),
+            scaled_sink2.frame()->video_frame_buffer());
+
+  // Frames which are small enough are not scaled.
+  WebRtcVideoFrame small_frame;
+  small_frame.InitToBlack(320, 180, 20000 /*ts*/);
+  broadcaster.OnFrame(small_frame);
+  EXPECT_EQ(small_frame.video_frame_buffer(),
+            scaled_sink1.frame()->video_frame_buffer());
+}
+
+TEST(VideoBroadcasterTest, DropsFramesForSinksWhichWantNoPixels) {
+  VideoBroadcaster broadcaster;
+  FakeVideoRenderer sink;
+  VideoSinkWants wants;
+  wants.max_pixel_count = rtc::Optional<int>(0);
+  broadcaster.AddOrUpdateSink(&sink, wants);
+
+  WebRtcVideoFrame frame;
+  frame.InitToBlack(1280, 720, 10000 /*ts*/);
+  broadcaster.OnFrame(frame);
+  EXPECT_EQ(0, sink.num_rendered_frames());
 }
 
 TEST(VideoBroadcasterTest, SinkWantsBlackFrames) {
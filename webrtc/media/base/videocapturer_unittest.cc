@@ -278,7 +278,8 @@ TEST_F(VideoCapturerTest, SinkWantsMaxPixelAndMaxPixelCountStepUp) {
   EXPECT_EQ(640, renderer_.width());
   EXPECT_EQ(360, renderer_.height());
 
-  // Adding a new renderer should not affect resolution.
+  // Adding a new renderer without wants should not affect the resolution of
+  // the first one, but the new renderer gets the full resolution.
   cricket::FakeVideoRenderer renderer2;
   capturer_->AddOrUpdateSink(&renderer2, rtc::VideoSinkWants());
   EXPECT_TRUE(capturer_->CaptureFrame());
@@ -286,8 +287,8 @@ TEST_F(VideoCapturerTest, SinkWantsMaxPixelAndMaxPixelCountStepUp) {
   EXPECT_EQ(640, renderer_.width());
   EXPECT_EQ(360, renderer_.height());
   EXPECT_EQ(1, renderer2.num_rendered_frames());
-  EXPECT_EQ(640, renderer2.width());
-  EXPECT_EQ(360, renderer2.height());
+  EXPECT_EQ(1280, renderer2.width());
+  EXPECT_EQ(720, renderer2.height());
 
   // Request higher resolution.
   wants.max_pixel_count_step_up = wants.max_pixel_count;
@@ -298,8 +299,8 @@ TEST_F(VideoCapturerTest, SinkWantsMaxPixelAndMaxPixelCountStepUp) {
   EXPECT_EQ(960, renderer_.width());
   EXPECT_EQ(540, renderer_.height());
   EXPECT_EQ(2, renderer2.num_rendered_frames());
-  EXPECT_EQ(960, renderer2.width());
-  EXPECT_EQ(540, renderer2.height());
+  EXPECT_EQ(1280, renderer2.width());
+  EXPECT_EQ(720, renderer2.height());
 
   // Updating with no wants should not affect resolution.
   capturer_->AddOrUpdateSink(&renderer2, rtc::VideoSinkWants());
@@ -308,8 +309,8 @@ TEST_F(VideoCapturerTest, SinkWantsMaxPixelAndMaxPixelCountStepUp) {
   EXPECT_EQ(960, renderer_.width());
   EXPECT_EQ(540, renderer_.height());
   EXPECT_EQ(3, renderer2.num_rendered_frames());
-  EXPECT_EQ(960, renderer2.width());
-  EXPECT_EQ(540, renderer2.height());
+  EXPECT_EQ(1280, renderer2.width());
+  EXPECT_EQ(720, renderer2.height());
 
   // But resetting the wants should reset the resolution to what the camera is
   // opened with.
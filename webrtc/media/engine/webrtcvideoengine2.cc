@@ -31,6 +31,7 @@
 #include "webrtc/modules/video_coding/codecs/vp8/simulcast_encoder_adapter.h"
 #include "webrtc/modules/video_coding/codecs/vp9/include/vp9.h"
 #include "webrtc/system_wrappers/include/field_trial.h"
+#include "webrtc/system_wrappers/include/metrics.h"
 #include "webrtc/video_decoder.h"
 #include "webrtc/video_encoder.h"
 
@@ -321,6 +322,34 @@ int GetDefaultVp9TemporalLayers() {
   }
   return 1;
 }
+
+// Returns true if the settings that SetCodec() writes into a send stream
+// config differ between |old_config| and |new_config| in a way that
+// webrtc::VideoSendStream only picks up when it is constructed.
+bool CodecChangeRequiresRecreation(
+    const webrtc::VideoSendStream::Config& old_config,
+    const webrtc::VideoSendStream::Config& new_config) {
+  const auto& old_encoder = old_config.encoder_settings;
+  const auto& new_encoder = new_config.encoder_settings;
+  if (old_encoder.encoder != new_encoder.encoder ||
+      old_encoder.payload_name != new_encoder.payload_name ||
+      old_encoder.payload_type != new_encoder.payload_type ||
+      old_encoder.internal_source != new_encoder.internal_source ||
+      old_encoder.full_overuse_time != new_encoder.full_overuse_time) {
+    return true;
+  }
+  const webrtc::FecConfig& old_fec = old_config.rtp.fec;
+  const webrtc::FecConfig& new_fec = new_config.rtp.fec;
+  if (old_fec.ulpfec_payload_type != new_fec.ulpfec_payload_type ||
+      old_fec.red_payload_type != new_fec.red_payload_type ||
+      old_fec.red_rtx_payload_type != new_fec.red_rtx_payload_type) {
+    return true;
+  }
+  return old_config.rtp.rtx.ssrcs != new_config.rtp.rtx.ssrcs ||
+         old_config.rtp.rtx.payload_type != new_config.rtp.rtx.payload_type ||
+         old_config.rtp.nack.rtp_history_ms !=
+             new_config.rtp.nack.rtp_history_ms;
+}
 }  // namespace
 
 // Constants defined in webrtc/media/engine/constants.h
@@ -1445,6 +1474,22 @@ void WebRtcVideoChannel2::OnRtcpReceived(
       webrtc_packet_time);
 }
 
+bool WebRtcVideoChannel2::OnPacketReceivedOnNetworkThread(
+    bool rtcp,
+    const rtc::CopyOnWriteBuffer& packet,
+    const rtc::PacketTime& packet_time) {
+  if (!deliver_packets_on_network_thread())
+    return false;
+  const webrtc::PacketTime webrtc_packet_time(packet_time.timestamp,
+                                              packet_time.not_before);
+  const webrtc::PacketReceiver::DeliveryStatus delivery_result =
+      call_->Receiver()->DeliverPacket(webrtc::MediaType::VIDEO, packet.cdata(),
+                                       packet.size(), webrtc_packet_time);
+  // Unsignalled SSRCs are handled on the worker thread, see OnPacketReceived.
+  return rtcp ||
+         delivery_result != webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC;
+}
+
 void WebRtcVideoChannel2::OnReadyToSend(bool ready) {
   LOG(LS_VERBOSE) << "OnReadyToSend: " << (ready ? "Ready." : "Not ready.");
   call_->SignalChannelNetworkState(
@@ -1552,6 +1597,7 @@ WebRtcVideoChannel2::WebRtcVideoSendStream::WebRtcVideoSendStream(
       parameters_(config, options, max_bitrate_bps, codec_settings),
       rtp_parameters_(CreateRtpParametersWithOneEncoding()),
       pending_encoder_reconfiguration_(false),
+      num_stream_recreations_avoided_(0),
       allocated_encoder_(nullptr, webrtc::kVideoCodecUnknown, false),
       sending_(false),
       last_frame_timestamp_ms_(0) {
@@ -1573,13 +1619,15 @@ WebRtcVideoChannel2::WebRtcVideoSendStream::WebRtcVideoSendStream(
       rtp_extensions, kRtpVideoRotationHeaderExtension);
 
   if (codec_settings) {
-    SetCodec(*codec_settings);
+    SetCodec(*codec_settings, true);
   }
 }
 
 WebRtcVideoChannel2::WebRtcVideoSendStream::~WebRtcVideoSendStream() {
   DisconnectSource();
   if (stream_ != NULL) {
+    RTC_HISTOGRAM_COUNTS_100("WebRTC.Video.SendStreamRecreationsAvoided",
+                             num_stream_recreations_avoided_);
     call_->DestroyVideoSendStream(stream_);
   }
   DestroyVideoEncoder(&allocated_encoder_);
@@ -1770,7 +1818,9 @@ void WebRtcVideoChannel2::WebRtcVideoSendStream::DestroyVideoEncoder(
 }
 
 void WebRtcVideoChannel2::WebRtcVideoSendStream::SetCodec(
-    const VideoCodecSettings& codec_settings) {
+    const VideoCodecSettings& codec_settings,
+    bool force_recreation) {
+  const webrtc::VideoSendStream::Config old_config = parameters_.config;
   parameters_.encoder_config =
       CreateVideoEncoderConfig(last_dimensions_, codec_settings.codec);
   RTC_DCHECK(!parameters_.encoder_config.streams.empty());
@@ -1804,8 +1854,22 @@ void WebRtcVideoChannel2::WebRtcVideoSendStream::SetCodec(
   parameters_.codec_settings =
       rtc::Optional<WebRtcVideoChannel2::VideoCodecSettings>(codec_settings);
 
-  LOG(LS_INFO) << "RecreateWebRtcStream (send) because of SetCodec.";
-  RecreateWebRtcStream();
+  if (stream_ != NULL && !force_recreation &&
+      !CodecChangeRequiresRecreation(old_config, parameters_.config)) {
+    // Only the encoder settings changed, e.g. codec parameters or conference
+    // mode. Reconfiguring the encoder keeps the stream, and avoids the
+    // keyframe that comes with a new one.
+    parameters_.encoder_config.encoder_specific_settings =
+        ConfigureVideoEncoderSettings(codec_settings.codec);
+    stream_->ReconfigureVideoEncoder(parameters_.encoder_config);
+    parameters_.encoder_config.encoder_specific_settings = NULL;
+    pending_encoder_reconfiguration_ = false;
+    ++num_stream_recreations_avoided_;
+    LOG(LS_INFO) << "Reconfigured encoder (send) in place because of SetCodec.";
+  } else {
+    LOG(LS_INFO) << "RecreateWebRtcStream (send) because of SetCodec.";
+    RecreateWebRtcStream();
+  }
   if (allocated_encoder_.encoder != new_encoder.encoder) {
     DestroyVideoEncoder(&allocated_encoder_);
     allocated_encoder_ = new_encoder;
@@ -1837,11 +1901,11 @@ void WebRtcVideoChannel2::WebRtcVideoSendStream::SetSendParameters(
 
     // Set codecs and options.
     if (params.codec) {
-      SetCodec(*params.codec);
-      recreate_stream = false;  // SetCodec has already recreated the stream.
+      SetCodec(*params.codec, recreate_stream);
+      recreate_stream = false;  // SetCodec has already updated the stream.
     } else if (params.conference_mode && parameters_.codec_settings) {
-      SetCodec(*parameters_.codec_settings);
-      recreate_stream = false;  // SetCodec has already recreated the stream.
+      SetCodec(*parameters_.codec_settings, recreate_stream);
+      recreate_stream = false;  // SetCodec has already updated the stream.
     }
     if (recreate_stream) {
       LOG(LS_INFO)
@@ -175,6 +175,10 @@ class WebRtcVideoChannel2 : public VideoMediaChannel, public webrtc::Transport {
                         const rtc::PacketTime& packet_time) override;
   void OnRtcpReceived(rtc::CopyOnWriteBuffer* packet,
                       const rtc::PacketTime& packet_time) override;
+  bool OnPacketReceivedOnNetworkThread(
+      bool rtcp,
+      const rtc::CopyOnWriteBuffer& packet,
+      const rtc::PacketTime& packet_time) override;
   void OnReadyToSend(bool ready) override;
   void OnNetworkRouteChanged(const std::string& transport_name,
                              const rtc::NetworkRoute& network_route) override;
@@ -348,7 +352,11 @@ class WebRtcVideoChannel2 : public VideoMediaChannel, public webrtc::Transport {
         EXCLUSIVE_LOCKS_REQUIRED(lock_);
     void DestroyVideoEncoder(AllocatedEncoder* encoder)
         EXCLUSIVE_LOCKS_REQUIRED(lock_);
-    void SetCodec(const VideoCodecSettings& codec)
+    // Applies |codec|. The underlying webrtc::VideoSendStream is only
+    // recreated if |force_recreation| is set or the codec changed settings
+    // that the stream reads at construction; otherwise only the encoder is
+    // reconfigured.
+    void SetCodec(const VideoCodecSettings& codec, bool force_recreation)
         EXCLUSIVE_LOCKS_REQUIRED(lock_);
     void RecreateWebRtcStream() EXCLUSIVE_LOCKS_REQUIRED(lock_);
     webrtc::VideoEncoderConfig CreateVideoEncoderConfig(
@@ -392,6 +400,9 @@ class WebRtcVideoChannel2 : public VideoMediaChannel, public webrtc::Transport {
     // one stream per MediaChannel.
     webrtc::RtpParameters rtp_parameters_ GUARDED_BY(lock_);
     bool pending_encoder_reconfiguration_ GUARDED_BY(lock_);
+    // Number of codec changes applied without recreating |stream_|, reported
+    // as a histogram when the stream is destroyed.
+    int num_stream_recreations_avoided_ GUARDED_BY(lock_);
     VideoEncoderSettings encoder_settings_ GUARDED_BY(lock_);
     AllocatedEncoder allocated_encoder_ GUARDED_BY(lock_);
     Dimensions last_dimensions_ GUARDED_BY(lock_);
@@ -2601,6 +2601,31 @@ TEST_F(WebRtcVideoChannel2Test,
   EXPECT_EQ(1, fake_call_->GetNumCreatedSendStreams());
 }
 
+// Test that a codec change that only affects encoder settings reconfigures the
+// encoder of the existing stream, while changing the payload type still
+// recreates the stream.
+TEST_F(WebRtcVideoChannel2Test,
+       SetSendCodecParametersReconfiguresEncoderInPlace) {
+  cricket::VideoSendParameters parameters;
+  parameters.codecs.push_back(kVp8Codec);
+  EXPECT_TRUE(channel_->SetSendParameters(parameters));
+
+  FakeVideoSendStream* stream = AddSendStream();
+  EXPECT_EQ(1, fake_call_->GetNumCreatedSendStreams());
+  const int reconfigurations = stream->num_encoder_reconfigurations();
+
+  parameters.codecs[0].params[kCodecParamMaxBitrate] = "500";
+  EXPECT_TRUE(channel_->SetSendParameters(parameters));
+  EXPECT_EQ(1, fake_call_->GetNumCreatedSendStreams());
+  ASSERT_EQ(stream, fake_call_->GetVideoSendStreams().front());
+  EXPECT_EQ(reconfigurations + 1, stream->num_encoder_reconfigurations());
+  EXPECT_EQ(500000, stream->GetVideoStreams().back().max_bitrate_bps);
+
+  parameters.codecs[0] = kVp9Codec;
+  EXPECT_TRUE(channel_->SetSendParameters(parameters));
+  EXPECT_EQ(2, fake_call_->GetNumCreatedSendStreams());
+}
+
 TEST_F(WebRtcVideoChannel2Test, SetRecvCodecsWithOnlyVp8) {
   cricket::VideoRecvParameters parameters;
   parameters.codecs.push_back(kVp8Codec);
@@ -3237,6 +3262,30 @@ TEST_F(WebRtcVideoChannel2Test, TranslatesSenderBitrateStatsCorrectly) {
       << "Bandwidth stats should take all streams into account.";
 }
 
+TEST_F(WebRtcVideoChannel2Test, DeliversPacketsOnNetworkThreadIfConfigured) {
+  const size_t kDataLength = 12;
+  uint8_t data[kDataLength];
+  memset(data, 0, sizeof(data));
+  rtc::SetBE32(&data[8], kSsrcs1[0]);
+  const rtc::CopyOnWriteBuffer packet(data, kDataLength);
+  const rtc::PacketTime packet_time;
+
+  EXPECT_TRUE(channel_->AddRecvStream(StreamParams::CreateLegacy(kSsrcs1[0])));
+  EXPECT_FALSE(
+      channel_->OnPacketReceivedOnNetworkThread(false, packet, packet_time));
+
+  MediaConfig media_config = MediaConfig();
+  media_config.deliver_packets_on_network_thread = true;
+  channel_.reset(
+      engine_.CreateChannel(fake_call_.get(), media_config, VideoOptions()));
+  // Unsignalled SSRCs are left to the worker thread.
+  EXPECT_FALSE(
+      channel_->OnPacketReceivedOnNetworkThread(false, packet, packet_time));
+  EXPECT_TRUE(channel_->AddRecvStream(StreamParams::CreateLegacy(kSsrcs1[0])));
+  EXPECT_TRUE(
+      channel_->OnPacketReceivedOnNetworkThread(false, packet, packet_time));
+}
+
 TEST_F(WebRtcVideoChannel2Test, DefaultReceiveStreamReconfiguresToUseRtx) {
   EXPECT_TRUE(channel_->SetSendParameters(send_parameters_));
 
@@ -2391,6 +2391,22 @@ void WebRtcVoiceMediaChannel::OnRtcpReceived(
       packet->cdata(), packet->size(), webrtc_packet_time);
 }
 
+bool WebRtcVoiceMediaChannel::OnPacketReceivedOnNetworkThread(
+    bool rtcp,
+    const rtc::CopyOnWriteBuffer& packet,
+    const rtc::PacketTime& packet_time) {
+  if (!deliver_packets_on_network_thread())
+    return false;
+  const webrtc::PacketTime webrtc_packet_time(packet_time.timestamp,
+                                              packet_time.not_before);
+  const webrtc::PacketReceiver::DeliveryStatus delivery_result =
+      call_->Receiver()->DeliverPacket(webrtc::MediaType::AUDIO, packet.cdata(),
+                                       packet.size(), webrtc_packet_time);
+  // Unsignalled SSRCs are handled on the worker thread, see OnPacketReceived.
+  return rtcp ||
+         delivery_result != webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC;
+}
+
 void WebRtcVoiceMediaChannel::OnNetworkRouteChanged(
     const std::string& transport_name,
     const rtc::NetworkRoute& network_route) {
@@ -187,6 +187,10 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
                         const rtc::PacketTime& packet_time) override;
   void OnRtcpReceived(rtc::CopyOnWriteBuffer* packet,
                       const rtc::PacketTime& packet_time) override;
+  bool OnPacketReceivedOnNetworkThread(
+      bool rtcp,
+      const rtc::CopyOnWriteBuffer& packet,
+      const rtc::PacketTime& packet_time) override;
   void OnNetworkRouteChanged(const std::string& transport_name,
                              const rtc::NetworkRoute& network_route) override;
   void OnReadyToSend(bool ready) override;
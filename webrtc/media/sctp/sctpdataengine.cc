@@ -198,8 +198,11 @@ int OnSctpOutboundPacket(void* addr,
                   << "; tos: " << std::hex << static_cast<int>(tos)
                   << "; set_df: " << std::hex << static_cast<int>(set_df);
 
-  VerboseLogPacket(addr, length, SCTP_DUMP_OUTBOUND);
+  VerboseLogPacket(data, length, SCTP_DUMP_OUTBOUND);
   // Note: We have to copy the data; the caller will delete it.
+  // Always post, even when called on the worker thread from within
+  // usrsctp_sendv or usrsctp_conninput: sending synchronously could feed a
+  // packet back into usrsctp while it is still in the middle of those calls.
   auto* msg = new OutboundPacketMessage(
       new rtc::CopyOnWriteBuffer(reinterpret_cast<uint8_t*>(data), length));
   channel->worker_thread()->Post(channel, MSG_SCTPOUTBOUNDPACKET, msg);
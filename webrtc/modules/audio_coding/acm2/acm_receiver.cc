@@ -53,7 +53,8 @@ AcmReceiver::AcmReceiver(const AudioCodingModule::Config& config)
       clock_(config.clock),
       resampled_last_output_frame_(true) {
   assert(clock_);
-  memset(last_audio_buffer_.get(), 0, AudioFrame::kMaxDataSizeSamples);
+  memset(last_audio_buffer_.get(), 0,
+         sizeof(int16_t) * AudioFrame::kMaxDataSizeSamples);
 }
 
 AcmReceiver::~AcmReceiver() {
@@ -135,9 +136,8 @@ int AcmReceiver::InsertPacket(const WebRtcRTPHeader& rtp_header,
 int AcmReceiver::GetAudio(int desired_freq_hz,
                           AudioFrame* audio_frame,
                           bool* muted) {
-  // Accessing members, take the lock.
-  rtc::CritScope lock(&crit_sect_);
-
+  // NetEq has its own lock, so only take ours once it is done, in the same
+  // way as InsertPacket() does.
   if (neteq_->GetAudio(audio_frame, muted) != NetEq::kOK) {
     LOG(LERROR) << "AcmReceiver::GetAudio - NetEq Failed.";
     return -1;
@@ -145,6 +145,8 @@ int AcmReceiver::GetAudio(int desired_freq_hz,
 
   const int current_sample_rate_hz = neteq_->last_output_sample_rate_hz();
 
+  rtc::CritScope lock(&crit_sect_);
+
   // Update if resampling is required.
   const bool need_resampling =
       (desired_freq_hz != -1) && (current_sample_rate_hz != desired_freq_hz);
@@ -184,12 +186,14 @@ int AcmReceiver::GetAudio(int desired_freq_hz,
   } else {
     resampled_last_output_frame_ = false;
     // We might end up here ONLY if codec is changed.
-  }
 
-  // Store current audio in |last_audio_buffer_| for next time.
-  memcpy(last_audio_buffer_.get(), audio_frame->data_,
-         sizeof(int16_t) * audio_frame->samples_per_channel_ *
-             audio_frame->num_channels_);
+    // Store current audio in |last_audio_buffer_| for next time. It is only
+    // used to prime the resampler after a frame that was not resampled, so
+    // there is no need to copy the frames that were.
+    memcpy(last_audio_buffer_.get(), audio_frame->data_,
+           sizeof(int16_t) * audio_frame->samples_per_channel_ *
+               audio_frame->num_channels_);
+  }
 
   call_stats_.DecodedByNetEq(audio_frame->speech_type_);
   return 0;
@@ -87,13 +87,14 @@ int UpMix(const AudioFrame& frame, size_t length_out_buff, int16_t* out_buff) {
   return 0;
 }
 
-void ConvertEncodedInfoToFragmentationHeader(
+// Returns false if |info| has no redundant encodings, in which case |frag| is
+// left untouched. |frag| only reallocates when it needs to grow, so reusing it
+// across packets avoids a heap allocation per packet once RED is running.
+bool ConvertEncodedInfoToFragmentationHeader(
     const AudioEncoder::EncodedInfo& info,
     RTPFragmentationHeader* frag) {
-  if (info.redundant.empty()) {
-    frag->fragmentationVectorSize = 0;
-    return;
-  }
+  if (info.redundant.empty())
+    return false;
 
   frag->VerifyAndAllocateFragmentationHeader(
       static_cast<uint16_t>(info.redundant.size()));
@@ -107,6 +108,7 @@ void ConvertEncodedInfoToFragmentationHeader(
         info.encoded_timestamp - info.redundant[i].encoded_timestamp);
     frag->fragmentationPlType[i] = info.redundant[i].payload_type;
   }
+  return true;
 }
 
 // Wraps a raw AudioEncoder pointer. The idea is that you can put one of these
@@ -259,8 +261,8 @@ int32_t AudioCodingModuleImpl::Encode(const InputData& input_data) {
     }
   }
 
-  RTPFragmentationHeader my_fragmentation;
-  ConvertEncodedInfoToFragmentationHeader(encoded_info, &my_fragmentation);
+  const bool has_fragmentation =
+      ConvertEncodedInfoToFragmentationHeader(encoded_info, &fragmentation_);
   FrameType frame_type;
   if (encode_buffer_.size() == 0 && encoded_info.send_even_if_empty) {
     frame_type = kEmptyFrame;
@@ -276,8 +278,7 @@ int32_t AudioCodingModuleImpl::Encode(const InputData& input_data) {
       packetization_callback_->SendData(
           frame_type, encoded_info.payload_type, encoded_info.encoded_timestamp,
           encode_buffer_.data(), encode_buffer_.size(),
-          my_fragmentation.fragmentationVectorSize > 0 ? &my_fragmentation
-                                                       : nullptr);
+          has_fragmentation ? &fragmentation_ : nullptr);
     }
 
     if (vad_callback_) {
@@ -24,6 +24,7 @@
 #include "webrtc/modules/audio_coding/acm2/acm_resampler.h"
 #include "webrtc/modules/audio_coding/acm2/codec_manager.h"
 #include "webrtc/modules/audio_coding/codecs/audio_encoder.h"
+#include "webrtc/modules/include/module_common_types.h"
 
 namespace webrtc {
 
@@ -258,6 +259,8 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
 
   rtc::CriticalSection acm_crit_sect_;
   rtc::Buffer encode_buffer_ GUARDED_BY(acm_crit_sect_);
+  // Reused for every packet that carries redundant encodings.
+  RTPFragmentationHeader fragmentation_ GUARDED_BY(acm_crit_sect_);
   int id_;  // TODO(henrik.lundin) Make const.
   uint32_t expected_codec_ts_ GUARDED_BY(acm_crit_sect_);
   uint32_t expected_in_ts_ GUARDED_BY(acm_crit_sect_);
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/audio_coding/include/audio_coding_module.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+const int kNumWarmupFrames = 100;
+const int kNumFrames = 10000;
+const uint8_t kPayloadType = 111;
+const size_t kMaxPayloadBytes = 1500;
+
+// Hands every encoded packet straight to the receiving side, through a
+// preallocated buffer so that the transport itself does not allocate.
+class LoopbackTransport : public AudioPacketizationCallback {
+ public:
+  explicit LoopbackTransport(AudioCodingModule* receiver)
+      : receiver_(receiver), sequence_number_(0) {}
+
+  int32_t SendData(FrameType frame_type,
+                   uint8_t payload_type,
+                   uint32_t timestamp,
+                   const uint8_t* payload_data,
+                   size_t payload_len_bytes,
+                   const RTPFragmentationHeader* fragmentation) override {
+    if (payload_len_bytes == 0 || payload_len_bytes > kMaxPayloadBytes)
+      return 0;
+    memcpy(payload_, payload_data, payload_len_bytes);
+    WebRtcRTPHeader rtp_header = {};
+    rtp_header.header.payloadType = payload_type;
+    rtp_header.header.sequenceNumber = sequence_number_++;
+    rtp_header.header.timestamp = timestamp;
+    rtp_header.header.ssrc = 0x1234;
+    rtp_header.type.Audio.channel = 1;
+    rtp_header.frameType = frame_type;
+    return receiver_->IncomingPacket(payload_, payload_len_bytes, rtp_header);
+  }
+
+ private:
+  AudioCodingModule* const receiver_;
+  uint16_t sequence_number_;
+  uint8_t payload_[kMaxPayloadBytes];
+};
+
+// Runs audio through a sending and a receiving AudioCodingModule, 10 ms at a
+// time, and reports the average time spent in Add10MsData() and in
+// PlayoutData10Ms() per call. Packets are inserted into the receiver from
+// within Add10MsData(), so that cost is counted on the send side. The device
+// rate is 48 kHz on both ends, so codecs running at other rates also exercise
+// the resamplers.
+void MeasureSendReceive(const char* payload_name,
+                        int codec_sample_rate_hz,
+                        const std::string& name) {
+  const int kDeviceSampleRateHz = 48000;
+  std::unique_ptr<AudioCodingModule> sender(AudioCodingModule::Create(0));
+  std::unique_ptr<AudioCodingModule> receiver(AudioCodingModule::Create(1));
+  CodecInst codec;
+  ASSERT_EQ(0, AudioCodingModule::Codec(payload_name, &codec,
+                                        codec_sample_rate_hz, 1));
+  codec.pltype = kPayloadType;
+  ASSERT_EQ(0, sender->RegisterSendCodec(codec));
+  ASSERT_EQ(0, receiver->RegisterReceiveCodec(codec));
+  LoopbackTransport transport(receiver.get());
+  ASSERT_EQ(0, sender->RegisterTransportCallback(&transport));
+
+  AudioFrame input;
+  input.sample_rate_hz_ = kDeviceSampleRateHz;
+  input.samples_per_channel_ = kDeviceSampleRateHz / 100;
+  input.num_channels_ = 1;
+  input.timestamp_ = 0;
+  AudioFrame output;
+  bool muted;
+
+  int64_t send_ns = 0;
+  int64_t receive_ns = 0;
+  for (int frame = 0; frame < kNumWarmupFrames + kNumFrames; ++frame) {
+    for (size_t i = 0; i < input.samples_per_channel_; ++i) {
+      const size_t n = input.timestamp_ + i;
+      input.data_[i] = static_cast<int16_t>(
+          8000 * sin(2 * M_PI * 440 * n / kDeviceSampleRateHz));
+    }
+
+    const int64_t start_ns = rtc::TimeNanos();
+    ASSERT_GE(sender->Add10MsData(input), 0);
+    const int64_t sent_ns = rtc::TimeNanos();
+    ASSERT_EQ(0, receiver->PlayoutData10Ms(kDeviceSampleRateHz, &output,
+                                           &muted));
+    const int64_t received_ns = rtc::TimeNanos();
+    input.timestamp_ += static_cast<uint32_t>(input.samples_per_channel_);
+
+    if (frame >= kNumWarmupFrames) {
+      send_ns += sent_ns - start_ns;
+      receive_ns += received_ns - sent_ns;
+    }
+  }
+
+  test::PrintResult("acm_add_10ms_data", "", name,
+                    static_cast<size_t>(send_ns / kNumFrames), "ns", true);
+  test::PrintResult("acm_playout_data_10ms", "", name,
+                    static_cast<size_t>(receive_ns / kNumFrames), "ns", true);
+}
+}  // namespace
+
+TEST(AudioCodingModulePerformanceTest, SendReceive10Ms) {
+  // The packet loop itself is close to free with PCM, which leaves the
+  // resampling and buffering in the ACM as the main cost.
+  MeasureSendReceive("L16", 16000, "l16_16_khz");
+  MeasureSendReceive("L16", 32000, "l16_32_khz");
+  MeasureSendReceive("PCMU", 8000, "pcmu");
+#ifdef WEBRTC_CODEC_OPUS
+  MeasureSendReceive("opus", 48000, "opus");
+#endif
+}
+
+}  // namespace webrtc
@@ -228,6 +228,19 @@ void WebRtcIsac_NormLatticeFilterAr(int orderCoef, float* stateF, float* stateG,
 
 void WebRtcIsac_Dir2Lat(double* a, int orderCoef, float* sth, float* cth);
 
-void WebRtcIsac_AutoCorr(double* r, const double* x, size_t N, size_t order);
+// Computes the autocorrelation of |x| for lags 0 to |order|.
+typedef void (*AutoCorr)(double* r, const double* x, size_t N, size_t order);
+extern AutoCorr WebRtcIsac_AutoCorr;
+
+void WebRtcIsac_AutoCorrC(double* r, const double* x, size_t N, size_t order);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcIsac_AutoCorrSSE2(double* r, const double* x, size_t N,
+                             size_t order);
+#endif
+
+// Selects the fastest implementations available on this CPU for the function
+// pointers above and in pitch_estimator.h.
+void WebRtcIsac_InitFunctionPointers(void);
 
 #endif /* WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_MAIN_SOURCE_CODEC_H_ */
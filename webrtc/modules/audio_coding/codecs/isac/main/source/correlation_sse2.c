@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <math.h>
+
+#include "webrtc/modules/audio_coding/codecs/isac/main/source/codec.h"
+#include "webrtc/modules/audio_coding/codecs/isac/main/source/pitch_estimator.h"
+
+// Computes out[j] = sum(x[n] * y[n + j]) over n < |length|, for j = 0..3.
+// Each lag is accumulated in its own lane, in the same order as the scalar
+// loops in the C versions, so the results are bit-exact with them.
+static void FourLagsSSE2(const double* x,
+                         const double* y,
+                         size_t length,
+                         double* out) {
+  __m128d sum01 = _mm_setzero_pd();
+  __m128d sum23 = _mm_setzero_pd();
+  size_t n;
+
+  for (n = 0; n < length; n++) {
+    const __m128d xn = _mm_load1_pd(&x[n]);
+    sum01 = _mm_add_pd(sum01, _mm_mul_pd(xn, _mm_loadu_pd(&y[n])));
+    sum23 = _mm_add_pd(sum23, _mm_mul_pd(xn, _mm_loadu_pd(&y[n + 2])));
+  }
+  _mm_storeu_pd(&out[0], sum01);
+  _mm_storeu_pd(&out[2], sum23);
+}
+
+void WebRtcIsac_AutoCorrSSE2(double* r, const double* x, size_t N,
+                             size_t order) {
+  size_t lag = 0;
+  size_t j, n;
+
+  for (; lag + 3 <= order && lag + 4 <= N; lag += 4) {
+    // The lags have N - lag - j terms each; the common part is done four lags
+    // at a time and the last few terms of the shorter lags are added after.
+    const size_t common_length = N - lag - 3;
+    FourLagsSSE2(x, &x[lag], common_length, &r[lag]);
+    for (j = 0; j < 3; j++) {
+      for (n = common_length; n < N - lag - j; n++) {
+        r[lag + j] += x[n] * x[lag + j + n];
+      }
+    }
+  }
+
+  for (; lag <= order; lag++) {
+    double sum = 0.0;
+    for (n = 0; n + lag < N; n++) {
+      sum += x[n] * x[lag + n];
+    }
+    r[lag] = sum;
+  }
+}
+
+void WebRtcIsac_PitchCorrSSE2(const double* in, double* outcorr) {
+  const double* x = in + PITCH_MAX_LAG / 2 + 2;
+  double sums[PITCH_LAG_SPAN2];
+  double ysum = 1e-13;
+  int k, n;
+
+  for (k = 0; k + 4 <= PITCH_LAG_SPAN2; k += 4) {
+    FourLagsSSE2(x, &in[k], PITCH_CORR_LEN2, &sums[k]);
+  }
+  for (; k < PITCH_LAG_SPAN2; k++) {
+    double sum = 0.0;
+    for (n = 0; n < PITCH_CORR_LEN2; n++) {
+      sum += x[n] * in[k + n];
+    }
+    sums[k] = sum;
+  }
+
+  for (n = 0; n < PITCH_CORR_LEN2; n++) {
+    ysum += in[n] * in[n];
+  }
+
+  // Output in reverse order, with the same running energy as the C version.
+  outcorr += PITCH_LAG_SPAN2 - 1;
+  *outcorr = sums[0] / sqrt(ysum);
+  for (k = 1; k < PITCH_LAG_SPAN2; k++) {
+    ysum -= in[k - 1] * in[k - 1];
+    ysum += in[PITCH_CORR_LEN2 + k - 1] * in[PITCH_CORR_LEN2 + k - 1];
+    outcorr--;
+    *outcorr = sums[k] / sqrt(ysum);
+  }
+}
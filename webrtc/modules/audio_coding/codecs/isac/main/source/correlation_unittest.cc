@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#include "webrtc/typedefs.h"
+
+extern "C" {
+#include "webrtc/modules/audio_coding/codecs/isac/main/source/codec.h"
+#include "webrtc/modules/audio_coding/codecs/isac/main/source/pitch_estimator.h"
+}
+
+namespace webrtc {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// The SSE2 versions accumulate every lag in the same order as the C versions,
+// so the results must be identical, not just close.
+TEST(IsacCorrelationTest, AutoCorrSSE2IsBitExact) {
+  if (!WebRtc_GetCPUInfo(kSSE2))
+    return;
+  Random random(42);
+  double x[WINLEN];
+  for (double& sample : x)
+    sample = random.Gaussian(0, 1000);
+
+  // The orders used by the lower band, the upper band and the pitch
+  // weighting filter LPC analysis, plus a few that leave a remainder.
+  const size_t kOrders[] = {ORDERLO + 1, ORDERHI, UB_LPC_ORDER + 1,
+                            PITCH_WLPCORDER, 0, 1, 3};
+  for (size_t order : kOrders) {
+    double r_c[WINLEN];
+    double r_sse2[WINLEN];
+    WebRtcIsac_AutoCorrC(r_c, x, WINLEN, order);
+    WebRtcIsac_AutoCorrSSE2(r_sse2, x, WINLEN, order);
+    for (size_t lag = 0; lag <= order; ++lag)
+      EXPECT_EQ(r_c[lag], r_sse2[lag]) << "order " << order << " lag " << lag;
+  }
+
+  // Short input, where the highest lags have only a couple of terms.
+  double r_c[8];
+  double r_sse2[8];
+  WebRtcIsac_AutoCorrC(r_c, x, 9, 7);
+  WebRtcIsac_AutoCorrSSE2(r_sse2, x, 9, 7);
+  for (size_t lag = 0; lag <= 7; ++lag)
+    EXPECT_EQ(r_c[lag], r_sse2[lag]) << "lag " << lag;
+}
+
+TEST(IsacCorrelationTest, PitchCorrSSE2IsBitExact) {
+  if (!WebRtc_GetCPUInfo(kSSE2))
+    return;
+  Random random(17);
+  double in[PITCH_CORR_LEN2 + PITCH_CORR_STEP2 + PITCH_MAX_LAG / 2 + 2];
+  for (double& sample : in)
+    sample = random.Gaussian(0, 1000);
+
+  double corr_c[PITCH_LAG_SPAN2];
+  double corr_sse2[PITCH_LAG_SPAN2];
+  WebRtcIsac_PitchCorrC(in, corr_c);
+  WebRtcIsac_PitchCorrSSE2(in, corr_sse2);
+  for (int k = 0; k < PITCH_LAG_SPAN2; ++k)
+    EXPECT_EQ(corr_c[k], corr_sse2[k]) << "k " << k;
+
+  WebRtcIsac_PitchCorrC(in + PITCH_CORR_STEP2, corr_c);
+  WebRtcIsac_PitchCorrSSE2(in + PITCH_CORR_STEP2, corr_sse2);
+  for (int k = 0; k < PITCH_LAG_SPAN2; ++k)
+    EXPECT_EQ(corr_c[k], corr_sse2[k]) << "k " << k;
+}
+#endif
+
+}  // namespace webrtc
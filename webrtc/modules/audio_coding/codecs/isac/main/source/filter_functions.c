@@ -95,7 +95,9 @@ void WebRtcIsac_ZeroPoleFilter(double* In,
 }
 
 
-void WebRtcIsac_AutoCorr(double* r, const double* x, size_t N, size_t order) {
+AutoCorr WebRtcIsac_AutoCorr = WebRtcIsac_AutoCorrC;
+
+void WebRtcIsac_AutoCorrC(double* r, const double* x, size_t N, size_t order) {
   size_t  lag, n;
   double sum, prod;
   const double *x_lag;
@@ -30,7 +30,9 @@
 #include "webrtc/modules/audio_coding/codecs/isac/main/source/entropy_coding.h"
 #include "webrtc/modules/audio_coding/codecs/isac/main/source/lpc_shape_swb16_tables.h"
 #include "webrtc/modules/audio_coding/codecs/isac/main/source/os_specific_inline.h"
+#include "webrtc/modules/audio_coding/codecs/isac/main/source/pitch_estimator.h"
 #include "webrtc/modules/audio_coding/codecs/isac/main/source/structs.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 
 #define BIT_MASK_DEC_INIT 0x0001
 #define BIT_MASK_ENC_INIT 0x0002
@@ -260,6 +262,18 @@ int16_t WebRtcIsac_Assign(ISACStruct** ISAC_main_inst,
 }
 
 
+void WebRtcIsac_InitFunctionPointers(void) {
+  WebRtcIsac_AutoCorr = WebRtcIsac_AutoCorrC;
+  WebRtcIsac_PitchCorr = WebRtcIsac_PitchCorrC;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    WebRtcIsac_AutoCorr = WebRtcIsac_AutoCorrSSE2;
+    WebRtcIsac_PitchCorr = WebRtcIsac_PitchCorrSSE2;
+  }
+#endif
+}
+
 /****************************************************************************
  * WebRtcIsac_Create(...)
  *
@@ -275,6 +289,8 @@ int16_t WebRtcIsac_Assign(ISACStruct** ISAC_main_inst,
 int16_t WebRtcIsac_Create(ISACStruct** ISAC_main_inst) {
   ISACMainStruct* instISAC;
 
+  WebRtcIsac_InitFunctionPointers();
+
   if (ISAC_main_inst != NULL) {
     instISAC = (ISACMainStruct*)malloc(sizeof(ISACMainStruct));
     *ISAC_main_inst = (ISACStruct*)instISAC;
@@ -46,6 +46,18 @@ void WebRtcIsac_PitchfilterPost(double *indat,
                                 double *lags,
                                 double *gains);
 
+// Computes the normalized correlation of the PITCH_CORR_LEN2 samples starting
+// at |in| + PITCH_MAX_LAG / 2 + 2 with the PITCH_LAG_SPAN2 segments of |in|
+// that start at |in|, |in| + 1, ..., stored in |outcorr| in reverse order.
+typedef void (*PitchCorr)(const double* in, double* outcorr);
+extern PitchCorr WebRtcIsac_PitchCorr;
+
+void WebRtcIsac_PitchCorrC(const double* in, double* outcorr);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcIsac_PitchCorrSSE2(const double* in, double* outcorr);
+#endif
+
 void WebRtcIsac_PitchfilterPre_la(double *indat,
                                   double *outdat,
                                   PitchFiltstr *pfp,
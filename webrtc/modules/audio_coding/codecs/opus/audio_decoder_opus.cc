@@ -16,7 +16,7 @@ namespace webrtc {
 
 AudioDecoderOpus::AudioDecoderOpus(size_t num_channels)
     : channels_(num_channels) {
-  RTC_DCHECK(num_channels == 1 || num_channels == 2);
+  RTC_DCHECK(num_channels >= 1 && num_channels <= 8);
   WebRtcOpus_DecoderCreate(&dec_state_, channels_);
   WebRtcOpus_DecoderInit(dec_state_);
 }
@@ -82,6 +82,10 @@ int AudioDecoderOpus::PacketDurationRedundant(const uint8_t* encoded,
 
 bool AudioDecoderOpus::PacketHasFec(const uint8_t* encoded,
                                     size_t encoded_len) const {
+  // WebRtcOpus_PacketHasFec() only parses single-stream packets. Multistream
+  // packets are always treated as plain RED packets.
+  if (channels_ > 2)
+    return false;
   int fec;
   fec = WebRtcOpus_PacketHasFec(encoded, encoded_len);
   return (fec == 1);
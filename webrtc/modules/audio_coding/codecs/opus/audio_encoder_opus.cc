@@ -14,6 +14,7 @@
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/safe_conversions.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/common_types.h"
 #include "webrtc/modules/audio_coding/codecs/opus/opus_interface.h"
 
@@ -24,6 +25,7 @@ namespace {
 const int kSampleRateHz = 48000;
 const int kMinBitrateBps = 500;
 const int kMaxBitrateBps = 512000;
+const size_t kMaxNumChannels = 8;
 
 AudioEncoderOpus::Config CreateConfig(const CodecInst& codec_inst) {
   AudioEncoderOpus::Config config;
@@ -76,6 +78,29 @@ double OptimizePacketLossRate(double new_loss_rate, double old_loss_rate) {
   }
 }
 
+OpusComplexityAdapter::Config CreateComplexityAdapterConfig(
+    const AudioEncoderOpus::Config& config) {
+  // Without adaptation the adapter only measures the encode usage.
+  OpusComplexityAdapter::Config adapter_config;
+  adapter_config.max_complexity = config.complexity;
+  adapter_config.min_complexity = config.complexity;
+  if (config.adaptive_complexity) {
+    adapter_config.min_complexity = config.min_complexity;
+    adapter_config.overuse_threshold = config.complexity_overuse_threshold;
+    adapter_config.underuse_threshold = config.complexity_underuse_threshold;
+  }
+  return adapter_config;
+}
+
+bool ComplexityAdaptationChanged(const AudioEncoderOpus::Config& a,
+                                 const AudioEncoderOpus::Config& b) {
+  return a.complexity != b.complexity ||
+         a.adaptive_complexity != b.adaptive_complexity ||
+         a.min_complexity != b.min_complexity ||
+         a.complexity_overuse_threshold != b.complexity_overuse_threshold ||
+         a.complexity_underuse_threshold != b.complexity_underuse_threshold;
+}
+
 }  // namespace
 
 AudioEncoderOpus::Config::Config() = default;
@@ -86,13 +111,18 @@ auto AudioEncoderOpus::Config::operator=(const Config&) -> Config& = default;
 bool AudioEncoderOpus::Config::IsOk() const {
   if (frame_size_ms <= 0 || frame_size_ms % 10 != 0)
     return false;
-  if (num_channels != 1 && num_channels != 2)
+  if (num_channels < 1 || num_channels > kMaxNumChannels)
     return false;
   if (bitrate_bps &&
       (*bitrate_bps < kMinBitrateBps || *bitrate_bps > kMaxBitrateBps))
     return false;
   if (complexity < 0 || complexity > 10)
     return false;
+  if (adaptive_complexity &&
+      (min_complexity < 0 || min_complexity > complexity ||
+       complexity_underuse_threshold <= 0.f ||
+       complexity_underuse_threshold >= complexity_overuse_threshold))
+    return false;
   return true;
 }
 
@@ -101,11 +131,15 @@ int AudioEncoderOpus::Config::GetBitrateBps() const {
   if (bitrate_bps)
     return *bitrate_bps;  // Explicitly set value.
   else
-    return num_channels == 1 ? 32000 : 64000;  // Default value.
+    // Default value: 32 kbps per channel.
+    return 32000 * static_cast<int>(num_channels);
 }
 
 AudioEncoderOpus::AudioEncoderOpus(const Config& config)
-    : packet_loss_rate_(0.0), inst_(nullptr) {
+    : packet_loss_rate_(0.0),
+      inst_(nullptr),
+      total_encode_time_us_(0),
+      num_encoded_packets_(0) {
   RTC_CHECK(RecreateEncoderInstance(config));
 }
 
@@ -205,6 +239,7 @@ AudioEncoder::EncodedInfo AudioEncoderOpus::EncodeImpl(
                Num10msFramesPerPacket() * SamplesPer10msFrame());
 
   const size_t max_encoded_bytes = SufficientOutputBufferSize();
+  const int64_t encode_start_ns = rtc::TimeNanos();
   EncodedInfo info;
   info.encoded_bytes =
       encoded->AppendData(
@@ -222,6 +257,15 @@ AudioEncoder::EncodedInfo AudioEncoderOpus::EncodeImpl(
           });
   input_buffer_.clear();
 
+  const int64_t encode_time_us =
+      (rtc::TimeNanos() - encode_start_ns) / rtc::kNumNanosecsPerMicrosec;
+  total_encode_time_us_ += encode_time_us;
+  ++num_encoded_packets_;
+  if (complexity_adapter_->Update(encode_time_us, config_.frame_size_ms)) {
+    RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(
+                        inst_, complexity_adapter_->complexity()));
+  }
+
   info.encoded_timestamp = first_timestamp_in_buffer_;
   info.payload_type = config_.payload_type;
   info.send_even_if_empty = true;  // Allows Opus to send empty packets.
@@ -268,7 +312,13 @@ bool AudioEncoderOpus::RecreateEncoderInstance(const Config& config) {
   }
   RTC_CHECK_EQ(
       0, WebRtcOpus_SetMaxPlaybackRate(inst_, config.max_playback_rate_hz));
-  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, config.complexity));
+  // Keep the adapted complexity unless its settings change.
+  if (!complexity_adapter_ || ComplexityAdaptationChanged(config, config_)) {
+    complexity_adapter_.reset(
+        new OpusComplexityAdapter(CreateComplexityAdapterConfig(config)));
+  }
+  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(
+                      inst_, complexity_adapter_->complexity()));
   if (config.dtx_enabled) {
     RTC_CHECK_EQ(0, WebRtcOpus_EnableDtx(inst_));
   } else {
@@ -11,10 +11,12 @@
 #ifndef WEBRTC_MODULES_AUDIO_CODING_CODECS_OPUS_AUDIO_ENCODER_OPUS_H_
 #define WEBRTC_MODULES_AUDIO_CODING_CODECS_OPUS_AUDIO_ENCODER_OPUS_H_
 
+#include <memory>
 #include <vector>
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/optional.h"
+#include "webrtc/modules/audio_coding/codecs/opus/opus_complexity_adapter.h"
 #include "webrtc/modules/audio_coding/codecs/opus/opus_interface.h"
 #include "webrtc/modules/audio_coding/codecs/audio_encoder.h"
 
@@ -39,6 +41,8 @@ class AudioEncoderOpus final : public AudioEncoder {
     int GetBitrateBps() const;
 
     int frame_size_ms = 20;
+    // 1 to 8. More than two channels are in Vorbis order, see
+    // WebRtcOpus_EncoderCreate().
     size_t num_channels = 1;
     int payload_type = 120;
     ApplicationMode application = kVoip;
@@ -47,6 +51,15 @@ class AudioEncoderOpus final : public AudioEncoder {
     int max_playback_rate_hz = 48000;
     int complexity = kDefaultComplexity;
     bool dtx_enabled = false;
+    // If set, the complexity is lowered towards |min_complexity| while the
+    // encode time, relative to the duration of the encoded audio, exceeds
+    // |complexity_overuse_threshold|, and raised back towards |complexity| when
+    // it has stayed below |complexity_underuse_threshold|. See
+    // OpusComplexityAdapter.
+    bool adaptive_complexity = false;
+    int min_complexity = 0;
+    float complexity_overuse_threshold = 0.05f;
+    float complexity_underuse_threshold = 0.02f;
 
    private:
 #if defined(WEBRTC_ANDROID) || defined(WEBRTC_IOS) || defined(WEBRTC_ARCH_ARM)
@@ -86,6 +99,14 @@ class AudioEncoderOpus final : public AudioEncoder {
   ApplicationMode application() const { return config_.application; }
   bool dtx_enabled() const { return config_.dtx_enabled; }
 
+  // Encode time statistics. The complexity in use is config().complexity
+  // unless adaptive complexity is enabled.
+  int complexity() const { return complexity_adapter_->complexity(); }
+  // Smoothed encode time as a fraction of the duration of the encoded audio.
+  float encode_usage() const { return complexity_adapter_->encode_usage(); }
+  int64_t total_encode_time_us() const { return total_encode_time_us_; }
+  size_t num_encoded_packets() const { return num_encoded_packets_; }
+
  protected:
   EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
                          rtc::ArrayView<const int16_t> audio,
@@ -102,6 +123,9 @@ class AudioEncoderOpus final : public AudioEncoder {
   std::vector<int16_t> input_buffer_;
   OpusEncInst* inst_;
   uint32_t first_timestamp_in_buffer_;
+  std::unique_ptr<OpusComplexityAdapter> complexity_adapter_;
+  int64_t total_encode_time_us_;
+  size_t num_encoded_packets_;
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioEncoderOpus);
 };
 
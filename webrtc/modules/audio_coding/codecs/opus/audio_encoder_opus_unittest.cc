@@ -150,4 +150,36 @@ TEST_F(AudioEncoderOpusTest, PacketLossRateOptimized) {
   // clang-format on
 }
 
+TEST_F(AudioEncoderOpusTest, AdaptiveComplexityConfig) {
+  AudioEncoderOpus::Config config;
+  config.complexity = 8;
+  config.adaptive_complexity = true;
+  config.min_complexity = 3;
+  EXPECT_TRUE(config.IsOk());
+  config.min_complexity = 9;
+  EXPECT_FALSE(config.IsOk());
+  config.min_complexity = 3;
+  config.complexity_underuse_threshold = config.complexity_overuse_threshold;
+  EXPECT_FALSE(config.IsOk());
+}
+
+TEST_F(AudioEncoderOpusTest, CountsEncodeTime) {
+  AudioEncoderOpus::Config config;
+  config.complexity = 7;
+  AudioEncoderOpus encoder(config);
+  EXPECT_EQ(7, encoder.complexity());
+
+  // Encode one second of silence in 10 ms frames.
+  const size_t kSamplesPer10Ms = 480;
+  const int16_t audio[kSamplesPer10Ms] = {0};
+  rtc::Buffer encoded;
+  for (int i = 0; i < 100; ++i)
+    encoder.Encode(i * kSamplesPer10Ms, audio, &encoded);
+  EXPECT_EQ(50u, encoder.num_encoded_packets());
+  EXPECT_LE(0, encoder.total_encode_time_us());
+  EXPECT_LE(0.f, encoder.encode_usage());
+  // Adaptation is off, so the complexity stays where it was configured.
+  EXPECT_EQ(7, encoder.complexity());
+}
+
 }  // namespace webrtc
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/codecs/opus/opus_complexity_adapter.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// Smoothing factor of the encode usage per 10 ms of audio, which gives a time
+// constant of about half a second.
+const float kUsageAlphaPer10Ms = 0.98f;
+// Audio to encode after a change before the complexity is lowered again. Also
+// keeps the first, cold-cache packets from triggering a decrease.
+const int kMinMsBetweenDecreases = 1000;
+const int kStandardRampUpDelayMs = 5000;
+const int kMaxRampUpDelayMs = 80000;
+
+}  // namespace
+
+OpusComplexityAdapter::OpusComplexityAdapter(const Config& config)
+    : config_(config), usage_filter_(kUsageAlphaPer10Ms) {
+  RTC_DCHECK_LE(0, config_.min_complexity);
+  RTC_DCHECK_LE(config_.min_complexity, config_.max_complexity);
+  RTC_DCHECK_GE(10, config_.max_complexity);
+  RTC_DCHECK_LT(0.f, config_.underuse_threshold);
+  RTC_DCHECK_LT(config_.underuse_threshold, config_.overuse_threshold);
+  Reset();
+}
+
+void OpusComplexityAdapter::Reset() {
+  usage_filter_.Reset(kUsageAlphaPer10Ms);
+  complexity_ = config_.max_complexity;
+  ms_since_change_ = 0;
+  ms_underused_ = 0;
+  ramp_up_delay_ms_ = kStandardRampUpDelayMs;
+  last_change_was_increase_ = false;
+}
+
+bool OpusComplexityAdapter::Update(int64_t encode_time_us,
+                                   int audio_duration_ms) {
+  RTC_DCHECK_LT(0, audio_duration_ms);
+  const float usage = static_cast<float>(encode_time_us) /
+                      (1000.f * audio_duration_ms);
+  usage_filter_.Apply(audio_duration_ms / 10.f, usage);
+  ms_since_change_ += audio_duration_ms;
+  if (encode_usage() > config_.underuse_threshold) {
+    ms_underused_ = 0;
+  } else {
+    ms_underused_ += audio_duration_ms;
+  }
+
+  if (encode_usage() > config_.overuse_threshold &&
+      complexity_ > config_.min_complexity &&
+      ms_since_change_ >= kMinMsBetweenDecreases) {
+    if (last_change_was_increase_ && ms_since_change_ < ramp_up_delay_ms_) {
+      // The last increase did not last; wait longer before the next one.
+      ramp_up_delay_ms_ = std::min(2 * ramp_up_delay_ms_, kMaxRampUpDelayMs);
+    }
+    --complexity_;
+    ms_since_change_ = 0;
+    last_change_was_increase_ = false;
+    return true;
+  }
+
+  if (ms_underused_ >= ramp_up_delay_ms_ &&
+      complexity_ < config_.max_complexity) {
+    ++complexity_;
+    ms_since_change_ = 0;
+    ms_underused_ = 0;
+    last_change_was_increase_ = true;
+    return true;
+  }
+  return false;
+}
+
+float OpusComplexityAdapter::encode_usage() const {
+  const float usage = usage_filter_.filtered();
+  return usage == rtc::ExpFilter::kValueUndefined ? 0.f : usage;
+}
+
+}  // namespace webrtc
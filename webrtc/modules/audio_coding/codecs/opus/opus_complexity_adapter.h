@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_COMPLEXITY_ADAPTER_H_
+#define WEBRTC_MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_COMPLEXITY_ADAPTER_H_
+
+#include <stdint.h>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/exp_filter.h"
+
+namespace webrtc {
+
+// Adapts the Opus encoder complexity to the CPU time spent encoding, in the
+// same spirit as OveruseFrameDetector does for video. The encode usage is the
+// time spent encoding a packet divided by the duration of the audio in it,
+// smoothed over time. Since it is measured in wall-clock time, it goes up both
+// when the encoder is expensive and when the host is loaded.
+//
+// While the usage is above the overuse threshold the complexity is lowered
+// one step at a time, giving the usage time to settle between the steps. Once
+// the usage has stayed below the underuse threshold for a while, the
+// complexity is raised again one step at a time. If raising it leads straight
+// back to overuse, the wait before the next attempt is doubled, so that an
+// encoder on a loaded host does not keep toggling between two settings.
+class OpusComplexityAdapter {
+ public:
+  struct Config {
+    int min_complexity = 0;
+    int max_complexity = 10;
+    // Encode usage, as a fraction of real time, above which the complexity is
+    // lowered.
+    float overuse_threshold = 0.05f;
+    // Encode usage below which the complexity may be raised again.
+    float underuse_threshold = 0.02f;
+  };
+
+  explicit OpusComplexityAdapter(const Config& config);
+
+  // Reports that encoding |audio_duration_ms| of audio took |encode_time_us|.
+  // Returns true if complexity() changed.
+  bool Update(int64_t encode_time_us, int audio_duration_ms);
+
+  // Starts over from |max_complexity| with no usage history.
+  void Reset();
+
+  int complexity() const { return complexity_; }
+  // The smoothed encode usage, as a fraction of real time.
+  float encode_usage() const;
+
+ private:
+  const Config config_;
+  rtc::ExpFilter usage_filter_;
+  int complexity_;
+  // Audio encoded since the last complexity change.
+  int ms_since_change_;
+  // Audio encoded since the usage last went above the underuse threshold.
+  int ms_underused_;
+  // How long the usage has to stay below the underuse threshold before the
+  // complexity is raised.
+  int ramp_up_delay_ms_;
+  bool last_change_was_increase_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(OpusComplexityAdapter);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_COMPLEXITY_ADAPTER_H_
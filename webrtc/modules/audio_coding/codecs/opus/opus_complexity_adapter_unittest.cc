@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/modules/audio_coding/codecs/opus/opus_complexity_adapter.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kPacketMs = 20;
+
+OpusComplexityAdapter::Config CreateConfig() {
+  OpusComplexityAdapter::Config config;
+  config.min_complexity = 2;
+  config.max_complexity = 9;
+  config.overuse_threshold = 0.05f;
+  config.underuse_threshold = 0.02f;
+  return config;
+}
+
+// Feeds |duration_ms| of packets that each took |usage| of real time to
+// encode and returns the number of complexity changes.
+int Feed(OpusComplexityAdapter* adapter, float usage, int duration_ms) {
+  const int64_t encode_time_us =
+      static_cast<int64_t>(usage * kPacketMs * 1000);
+  int changes = 0;
+  for (int ms = 0; ms < duration_ms; ms += kPacketMs) {
+    if (adapter->Update(encode_time_us, kPacketMs))
+      ++changes;
+  }
+  return changes;
+}
+
+// Feeds packets with |usage| until the complexity changes and returns how much
+// audio that took.
+int MsUntilChange(OpusComplexityAdapter* adapter, float usage) {
+  const int64_t encode_time_us =
+      static_cast<int64_t>(usage * kPacketMs * 1000);
+  int ms = 0;
+  while (ms < 600000) {
+    ms += kPacketMs;
+    if (adapter->Update(encode_time_us, kPacketMs))
+      break;
+  }
+  return ms;
+}
+
+}  // namespace
+
+TEST(OpusComplexityAdapterTest, StartsAtMaxComplexity) {
+  OpusComplexityAdapter adapter(CreateConfig());
+  EXPECT_EQ(9, adapter.complexity());
+  EXPECT_EQ(0.f, adapter.encode_usage());
+}
+
+TEST(OpusComplexityAdapterTest, KeepsComplexityWhenNotOverused) {
+  OpusComplexityAdapter adapter(CreateConfig());
+  EXPECT_EQ(0, Feed(&adapter, 0.03f, 60000));
+  EXPECT_EQ(9, adapter.complexity());
+  EXPECT_NEAR(0.03f, adapter.encode_usage(), 1e-3f);
+}
+
+TEST(OpusComplexityAdapterTest, LowersComplexityOneStepPerSecond) {
+  OpusComplexityAdapter adapter(CreateConfig());
+  EXPECT_EQ(0, Feed(&adapter, 0.1f, 980));
+  EXPECT_EQ(1, Feed(&adapter, 0.1f, 20));
+  EXPECT_EQ(8, adapter.complexity());
+  EXPECT_EQ(3, Feed(&adapter, 0.1f, 3000));
+  EXPECT_EQ(5, adapter.complexity());
+}
+
+TEST(OpusComplexityAdapterTest, NeverGoesBelowMinComplexity) {
+  OpusComplexityAdapter adapter(CreateConfig());
+  Feed(&adapter, 0.5f, 60000);
+  EXPECT_EQ(2, adapter.complexity());
+}
+
+TEST(OpusComplexityAdapterTest, RaisesComplexityWhenUnderused) {
+  OpusComplexityAdapter adapter(CreateConfig());
+  Feed(&adapter, 0.1f, 3000);
+  EXPECT_EQ(6, adapter.complexity());
+
+  // The usage first has to come down through the smoothing, then stay below
+  // the underuse threshold for five seconds.
+  Feed(&adapter, 0.01f, 5000);
+  EXPECT_EQ(6, adapter.complexity());
+  EXPECT_EQ(1, Feed(&adapter, 0.01f, 2000));
+  EXPECT_EQ(7, adapter.complexity());
+  Feed(&adapter, 0.01f, 60000);
+  EXPECT_EQ(9, adapter.complexity());
+}
+
+TEST(OpusComplexityAdapterTest, BacksOffWhenIncreaseCausesOveruse) {
+  OpusComplexityAdapter adapter(CreateConfig());
+  Feed(&adapter, 0.1f, 1000);
+  EXPECT_EQ(8, adapter.complexity());
+  const int first_ramp_up_ms = MsUntilChange(&adapter, 0.01f);
+  EXPECT_EQ(9, adapter.complexity());
+
+  // Overuse right after the increase doubles the delay before the next one.
+  MsUntilChange(&adapter, 0.1f);
+  EXPECT_EQ(8, adapter.complexity());
+  const int second_ramp_up_ms = MsUntilChange(&adapter, 0.01f);
+  EXPECT_EQ(9, adapter.complexity());
+  EXPECT_NEAR(first_ramp_up_ms + 5000, second_ramp_up_ms, 100);
+}
+
+TEST(OpusComplexityAdapterTest, ResetStartsOver) {
+  OpusComplexityAdapter adapter(CreateConfig());
+  Feed(&adapter, 0.1f, 3000);
+  EXPECT_GT(9, adapter.complexity());
+  adapter.Reset();
+  EXPECT_EQ(9, adapter.complexity());
+  EXPECT_EQ(0.f, adapter.encode_usage());
+}
+
+}  // namespace webrtc
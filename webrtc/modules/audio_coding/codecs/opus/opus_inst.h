@@ -14,15 +14,20 @@
 #include <stddef.h>
 
 #include "opus.h"
+#include "opus_multistream.h"
 
+// Mono and stereo use the plain Opus API. More channels use the multistream
+// API instead, in which case |encoder| and |decoder| are NULL.
 struct WebRtcOpusEncInst {
   OpusEncoder* encoder;
+  OpusMSEncoder* multistream_encoder;
   size_t channels;
   int in_dtx_mode;
 };
 
 struct WebRtcOpusDecInst {
   OpusDecoder* decoder;
+  OpusMSDecoder* multistream_decoder;
   int prev_decoded_samples;
   size_t channels;
   int in_dtx_mode;
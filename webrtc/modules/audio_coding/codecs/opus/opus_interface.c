@@ -30,13 +30,49 @@ enum {
 
   /* Default frame size, 20 ms @ 48 kHz, in samples (for one channel). */
   kWebRtcOpusDefaultFrameSize = 960,
+
+  /* Channel mapping family 1 (RFC 7845, section 5.1.1.2) covers up to eight
+   * channels in Vorbis order. */
+  kWebRtcOpusMaxChannels = 8,
+};
+
+/* Stream layout of channel mapping family 1, indexed by the channel count
+ * minus one. This is what
+ * opus_multistream_surround_encoder_create() produces, so the decoder can be
+ * set up from the channel count alone. */
+static const struct {
+  int streams;
+  int coupled_streams;
+  unsigned char mapping[kWebRtcOpusMaxChannels];
+} kVorbisMappings[kWebRtcOpusMaxChannels] = {
+  {1, 0, {0}},
+  {1, 1, {0, 1}},
+  {2, 1, {0, 2, 1}},
+  {2, 2, {0, 1, 2, 3}},
+  {3, 2, {0, 4, 1, 2, 3}},
+  {4, 2, {0, 4, 1, 2, 3, 5}},
+  {4, 3, {0, 4, 1, 2, 3, 5, 6}},
+  {5, 3, {0, 6, 1, 2, 3, 4, 5, 7}},
 };
 
+/* Applies a ctl request to whichever of the single and multistream states
+ * |inst| holds. */
+#define ENCODER_CTL(inst, ...)                                         \
+  ((inst)->encoder                                                     \
+       ? opus_encoder_ctl((inst)->encoder, __VA_ARGS__)                \
+       : opus_multistream_encoder_ctl((inst)->multistream_encoder,     \
+                                      __VA_ARGS__))
+#define DECODER_CTL(inst, ...)                                         \
+  ((inst)->decoder                                                     \
+       ? opus_decoder_ctl((inst)->decoder, __VA_ARGS__)                \
+       : opus_multistream_decoder_ctl((inst)->multistream_decoder,     \
+                                      __VA_ARGS__))
+
 int16_t WebRtcOpus_EncoderCreate(OpusEncInst** inst,
                                  size_t channels,
                                  int32_t application) {
   int opus_app;
-  if (!inst)
+  if (!inst || channels == 0 || channels > kWebRtcOpusMaxChannels)
     return -1;
 
   switch (application) {
@@ -54,9 +90,23 @@ int16_t WebRtcOpus_EncoderCreate(OpusEncInst** inst,
   assert(state);
 
   int error;
-  state->encoder = opus_encoder_create(48000, (int)channels, opus_app,
-                                       &error);
-  if (error != OPUS_OK || !state->encoder) {
+  if (channels <= 2) {
+    state->encoder = opus_encoder_create(48000, (int)channels, opus_app,
+                                         &error);
+  } else {
+    int streams;
+    int coupled_streams;
+    unsigned char mapping[kWebRtcOpusMaxChannels];
+    state->multistream_encoder = opus_multistream_surround_encoder_create(
+        48000, (int)channels, 1, &streams, &coupled_streams, mapping, opus_app,
+        &error);
+    assert(error != OPUS_OK ||
+           (streams == kVorbisMappings[channels - 1].streams &&
+            coupled_streams == kVorbisMappings[channels - 1].coupled_streams &&
+            memcmp(mapping, kVorbisMappings[channels - 1].mapping,
+                   channels) == 0));
+  }
+  if (error != OPUS_OK || (!state->encoder && !state->multistream_encoder)) {
     WebRtcOpus_EncoderFree(state);
     return -1;
   }
@@ -71,6 +121,7 @@ int16_t WebRtcOpus_EncoderCreate(OpusEncInst** inst,
 int16_t WebRtcOpus_EncoderFree(OpusEncInst* inst) {
   if (inst) {
     opus_encoder_destroy(inst->encoder);
+    opus_multistream_encoder_destroy(inst->multistream_encoder);
     free(inst);
     return 0;
   } else {
@@ -89,11 +140,19 @@ int WebRtcOpus_Encode(OpusEncInst* inst,
     return -1;
   }
 
-  res = opus_encode(inst->encoder,
-                    (const opus_int16*)audio_in,
-                    (int)samples,
-                    encoded,
-                    (opus_int32)length_encoded_buffer);
+  if (inst->encoder) {
+    res = opus_encode(inst->encoder,
+                      (const opus_int16*)audio_in,
+                      (int)samples,
+                      encoded,
+                      (opus_int32)length_encoded_buffer);
+  } else {
+    res = opus_multistream_encode(inst->multistream_encoder,
+                                  (const opus_int16*)audio_in,
+                                  (int)samples,
+                                  encoded,
+                                  (opus_int32)length_encoded_buffer);
+  }
 
   if (res == 1) {
     // Indicates DTX since the packet has nothing but a header. In principle,
@@ -115,7 +174,7 @@ int WebRtcOpus_Encode(OpusEncInst* inst,
 
 int16_t WebRtcOpus_SetBitRate(OpusEncInst* inst, int32_t rate) {
   if (inst) {
-    return opus_encoder_ctl(inst->encoder, OPUS_SET_BITRATE(rate));
+    return ENCODER_CTL(inst, OPUS_SET_BITRATE(rate));
   } else {
     return -1;
   }
@@ -123,8 +182,7 @@ int16_t WebRtcOpus_SetBitRate(OpusEncInst* inst, int32_t rate) {
 
 int16_t WebRtcOpus_SetPacketLossRate(OpusEncInst* inst, int32_t loss_rate) {
   if (inst) {
-    return opus_encoder_ctl(inst->encoder,
-                            OPUS_SET_PACKET_LOSS_PERC(loss_rate));
+    return ENCODER_CTL(inst, OPUS_SET_PACKET_LOSS_PERC(loss_rate));
   } else {
     return -1;
   }
@@ -147,13 +205,12 @@ int16_t WebRtcOpus_SetMaxPlaybackRate(OpusEncInst* inst, int32_t frequency_hz) {
   } else {
     set_bandwidth = OPUS_BANDWIDTH_FULLBAND;
   }
-  return opus_encoder_ctl(inst->encoder,
-                          OPUS_SET_MAX_BANDWIDTH(set_bandwidth));
+  return ENCODER_CTL(inst, OPUS_SET_MAX_BANDWIDTH(set_bandwidth));
 }
 
 int16_t WebRtcOpus_EnableFec(OpusEncInst* inst) {
   if (inst) {
-    return opus_encoder_ctl(inst->encoder, OPUS_SET_INBAND_FEC(1));
+    return ENCODER_CTL(inst, OPUS_SET_INBAND_FEC(1));
   } else {
     return -1;
   }
@@ -161,7 +218,7 @@ int16_t WebRtcOpus_EnableFec(OpusEncInst* inst) {
 
 int16_t WebRtcOpus_DisableFec(OpusEncInst* inst) {
   if (inst) {
-    return opus_encoder_ctl(inst->encoder, OPUS_SET_INBAND_FEC(0));
+    return ENCODER_CTL(inst, OPUS_SET_INBAND_FEC(0));
   } else {
     return -1;
   }
@@ -177,21 +234,19 @@ int16_t WebRtcOpus_EnableDtx(OpusEncInst* inst) {
   // last long during a pure silence, if the signal type is not forced.
   // TODO(minyue): Remove the signal type forcing when Opus DTX works properly
   // without it.
-  int ret = opus_encoder_ctl(inst->encoder,
-                             OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE));
+  int ret = ENCODER_CTL(inst, OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE));
   if (ret != OPUS_OK)
     return ret;
 
-  return opus_encoder_ctl(inst->encoder, OPUS_SET_DTX(1));
+  return ENCODER_CTL(inst, OPUS_SET_DTX(1));
 }
 
 int16_t WebRtcOpus_DisableDtx(OpusEncInst* inst) {
   if (inst) {
-    int ret = opus_encoder_ctl(inst->encoder,
-                               OPUS_SET_SIGNAL(OPUS_AUTO));
+    int ret = ENCODER_CTL(inst, OPUS_SET_SIGNAL(OPUS_AUTO));
     if (ret != OPUS_OK)
       return ret;
-    return opus_encoder_ctl(inst->encoder, OPUS_SET_DTX(0));
+    return ENCODER_CTL(inst, OPUS_SET_DTX(0));
   } else {
     return -1;
   }
@@ -199,7 +254,7 @@ int16_t WebRtcOpus_DisableDtx(OpusEncInst* inst) {
 
 int16_t WebRtcOpus_SetComplexity(OpusEncInst* inst, int32_t complexity) {
   if (inst) {
-    return opus_encoder_ctl(inst->encoder, OPUS_SET_COMPLEXITY(complexity));
+    return ENCODER_CTL(inst, OPUS_SET_COMPLEXITY(complexity));
   } else {
     return -1;
   }
@@ -209,7 +264,7 @@ int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst, size_t channels) {
   int error;
   OpusDecInst* state;
 
-  if (inst != NULL) {
+  if (inst != NULL && channels > 0 && channels <= kWebRtcOpusMaxChannels) {
     /* Create Opus decoder state. */
     state = (OpusDecInst*) calloc(1, sizeof(OpusDecInst));
     if (state == NULL) {
@@ -217,8 +272,16 @@ int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst, size_t channels) {
     }
 
     /* Create new memory, always at 48000 Hz. */
-    state->decoder = opus_decoder_create(48000, (int)channels, &error);
-    if (error == OPUS_OK && state->decoder != NULL) {
+    if (channels <= 2) {
+      state->decoder = opus_decoder_create(48000, (int)channels, &error);
+    } else {
+      state->multistream_decoder = opus_multistream_decoder_create(
+          48000, (int)channels, kVorbisMappings[channels - 1].streams,
+          kVorbisMappings[channels - 1].coupled_streams,
+          kVorbisMappings[channels - 1].mapping, &error);
+    }
+    if (error == OPUS_OK &&
+        (state->decoder != NULL || state->multistream_decoder != NULL)) {
       /* Creation of memory all ok. */
       state->channels = channels;
       state->prev_decoded_samples = kWebRtcOpusDefaultFrameSize;
@@ -231,6 +294,9 @@ int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst, size_t channels) {
     if (state->decoder) {
       opus_decoder_destroy(state->decoder);
     }
+    if (state->multistream_decoder) {
+      opus_multistream_decoder_destroy(state->multistream_decoder);
+    }
     free(state);
   }
   return -1;
@@ -239,6 +305,7 @@ int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst, size_t channels) {
 int16_t WebRtcOpus_DecoderFree(OpusDecInst* inst) {
   if (inst) {
     opus_decoder_destroy(inst->decoder);
+    opus_multistream_decoder_destroy(inst->multistream_decoder);
     free(inst);
     return 0;
   } else {
@@ -251,7 +318,7 @@ size_t WebRtcOpus_DecoderChannels(OpusDecInst* inst) {
 }
 
 void WebRtcOpus_DecoderInit(OpusDecInst* inst) {
-  opus_decoder_ctl(inst->decoder, OPUS_RESET_STATE);
+  DECODER_CTL(inst, OPUS_RESET_STATE);
   inst->in_dtx_mode = 0;
 }
 
@@ -276,8 +343,16 @@ static int16_t DetermineAudioType(OpusDecInst* inst, size_t encoded_bytes) {
 static int DecodeNative(OpusDecInst* inst, const uint8_t* encoded,
                         size_t encoded_bytes, int frame_size,
                         int16_t* decoded, int16_t* audio_type, int decode_fec) {
-  int res = opus_decode(inst->decoder, encoded, (opus_int32)encoded_bytes,
-                        (opus_int16*)decoded, frame_size, decode_fec);
+  int res;
+  if (inst->decoder) {
+    res = opus_decode(inst->decoder, encoded, (opus_int32)encoded_bytes,
+                      (opus_int16*)decoded, frame_size, decode_fec);
+  } else {
+    res = opus_multistream_decode(inst->multistream_decoder, encoded,
+                                  (opus_int32)encoded_bytes,
+                                  (opus_int16*)decoded, frame_size,
+                                  decode_fec);
+  }
 
   if (res <= 0)
     return -1;
@@ -341,7 +416,9 @@ int WebRtcOpus_DecodeFec(OpusDecInst* inst, const uint8_t* encoded,
   int decoded_samples;
   int fec_samples;
 
-  if (WebRtcOpus_PacketHasFec(encoded, encoded_bytes) != 1) {
+  /* FEC is only looked for in single-stream packets. */
+  if (!inst->decoder ||
+      WebRtcOpus_PacketHasFec(encoded, encoded_bytes) != 1) {
     return 0;
   }
 
@@ -29,7 +29,10 @@ typedef struct WebRtcOpusDecInst OpusDecInst;
  * This function create an Opus encoder.
  *
  * Input:
- *      - channels           : number of channels.
+ *      - channels           : number of channels, 1 to 8. More than two
+ *                             channels are coded as an Opus multistream
+ *                             with channel mapping family 1, i.e. the
+ *                             channels are in Vorbis order (RFC 7845).
  *      - application        : 0 - VOIP applications.
  *                                 Favor speech intelligibility.
  *                             1 - Audio applications.
@@ -195,6 +198,7 @@ int16_t WebRtcOpus_DisableDtx(OpusEncInst* inst);
  */
 int16_t WebRtcOpus_SetComplexity(OpusEncInst* inst, int32_t complexity);
 
+// |channels| follows the same rules as for WebRtcOpus_EncoderCreate().
 int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst, size_t channels);
 int16_t WebRtcOpus_DecoderFree(OpusDecInst* inst);
 
@@ -331,7 +335,7 @@ int WebRtcOpus_FecDurationEst(const uint8_t* payload,
 /****************************************************************************
  * WebRtcOpus_PacketHasFec(...)
  *
- * This function detects if an opus packet has FEC.
+ * This function detects if a single-stream opus packet has FEC.
  * Input:
  *        - payload              : Encoded data pointer
  *        - payload_length_bytes : Bytes of encoded data
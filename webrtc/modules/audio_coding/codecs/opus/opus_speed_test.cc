@@ -103,6 +103,24 @@ ADD_TEST(2);
 ADD_TEST(1);
 ADD_TEST(0);
 
+// Encodes the same audio at every complexity and prints the resulting
+// complexity vs. CPU curve, as the encoding time in percent of real time.
+TEST_P(OpusSpeedTest, OpusComplexityCpuCurve) {
+  const size_t kDurationSec = 20;
+  const int kMaxComplexity = 10;
+  float encoding_percent[kMaxComplexity + 1];
+  for (int complexity = kMaxComplexity; complexity >= 0; --complexity) {
+    EXPECT_EQ(0, WebRtcOpus_SetComplexity(opus_encoder_, complexity));
+    encoding_time_ms_ = 0;
+    decoding_time_ms_ = 0;
+    EncodeDecode(kDurationSec);
+    encoding_percent[complexity] = encoding_time_ms_ / kDurationSec / 10;
+  }
+  printf("Complexity vs. encoding time in %% of real time:\n");
+  for (int complexity = 0; complexity <= kMaxComplexity; ++complexity)
+    printf("%2d: %.2f%%\n", complexity, encoding_percent[complexity]);
+}
+
 // List all test cases: (channel, bit rat, filename, extension).
 const coding_param param_set[] =
     {::std::tr1::make_tuple(1, 64000,
@@ -113,7 +131,12 @@ const coding_param param_set[] =
                             string("pcm"), true),
      ::std::tr1::make_tuple(2, 64000,
                             string("audio_coding/music_stereo_48kHz"),
-                            string("pcm"), true)};
+                            string("pcm"), true),
+     // 5.1 surround through the multistream encoder. There is no six-channel
+     // resource, so the stereo music is read as if it had six channels.
+     ::std::tr1::make_tuple(6, 192000,
+                            string("audio_coding/music_stereo_48kHz"),
+                            string("pcm"), false)};
 
 INSTANTIATE_TEST_CASE_P(AllTest, OpusSpeedTest,
                         ::testing::ValuesIn(param_set));
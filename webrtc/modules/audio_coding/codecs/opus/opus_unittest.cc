@@ -8,8 +8,11 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <math.h>
+
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "testing/gtest/include/gtest/gtest.h"
 #include "webrtc/base/checks.h"
@@ -308,13 +311,15 @@ TEST(OpusTest, OpusCreateFail) {
   // Test to see that an invalid pointer is caught.
   EXPECT_EQ(-1, WebRtcOpus_EncoderCreate(NULL, 1, 0));
   // Invalid channel number.
-  EXPECT_EQ(-1, WebRtcOpus_EncoderCreate(&opus_encoder, 3, 0));
+  EXPECT_EQ(-1, WebRtcOpus_EncoderCreate(&opus_encoder, 0, 0));
+  EXPECT_EQ(-1, WebRtcOpus_EncoderCreate(&opus_encoder, 9, 0));
   // Invalid applciation mode.
   EXPECT_EQ(-1, WebRtcOpus_EncoderCreate(&opus_encoder, 1, 2));
 
   EXPECT_EQ(-1, WebRtcOpus_DecoderCreate(NULL, 1));
   // Invalid channel number.
-  EXPECT_EQ(-1, WebRtcOpus_DecoderCreate(&opus_decoder, 3));
+  EXPECT_EQ(-1, WebRtcOpus_DecoderCreate(&opus_decoder, 0));
+  EXPECT_EQ(-1, WebRtcOpus_DecoderCreate(&opus_decoder, 9));
 }
 
 // Test failing Free.
@@ -673,6 +678,62 @@ TEST_P(OpusTest, OpusDecodeRepacketized) {
   EXPECT_EQ(0, WebRtcOpus_DecoderFree(opus_decoder_));
 }
 
+// Feeds a tone into one channel at a time of a multistream encoder and checks
+// that the decoder puts it back in the same channel, i.e. that the encoder and
+// the decoder agree on the channel mapping.
+TEST(OpusTest, OpusMultistreamChannelMapping) {
+  const int kNumFrames = 25;
+  for (size_t channels = 3; channels <= 8; ++channels) {
+    for (size_t active = 0; active < channels; ++active) {
+      WebRtcOpusEncInst* encoder;
+      WebRtcOpusDecInst* decoder;
+      ASSERT_EQ(0, WebRtcOpus_EncoderCreate(&encoder, channels, 1));
+      ASSERT_EQ(0, WebRtcOpus_DecoderCreate(&decoder, channels));
+      EXPECT_TRUE(encoder->encoder == NULL);
+      EXPECT_TRUE(encoder->multistream_encoder != NULL);
+      EXPECT_EQ(channels, WebRtcOpus_DecoderChannels(decoder));
+      EXPECT_EQ(0, WebRtcOpus_SetBitRate(encoder,
+                                         32000 * static_cast<int>(channels)));
+
+      // A low tone, so that it also passes through an LFE channel.
+      std::vector<int16_t> input(kOpus20msFrameSamples * channels, 0);
+      std::vector<int16_t> output(kOpus20msFrameSamples * channels);
+      std::vector<double> energy(channels, 0.0);
+      for (int frame = 0; frame < kNumFrames; ++frame) {
+        for (size_t i = 0; i < kOpus20msFrameSamples; ++i) {
+          const size_t n = frame * kOpus20msFrameSamples + i;
+          input[i * channels + active] = static_cast<int16_t>(
+              8000 * sin(2 * M_PI * 80 * n / (kOpusRateKhz * 1000)));
+        }
+        uint8_t bitstream[kMaxBytes];
+        int encoded_bytes = WebRtcOpus_Encode(
+            encoder, input.data(), kOpus20msFrameSamples, kMaxBytes, bitstream);
+        ASSERT_GT(encoded_bytes, 0);
+        int16_t audio_type;
+        ASSERT_EQ(static_cast<int>(kOpus20msFrameSamples),
+                  WebRtcOpus_Decode(decoder, bitstream,
+                                    static_cast<size_t>(encoded_bytes),
+                                    output.data(), &audio_type));
+        // Skip the start-up of the codec.
+        if (frame < kNumFrames / 2)
+          continue;
+        for (size_t i = 0; i < kOpus20msFrameSamples; ++i) {
+          for (size_t c = 0; c < channels; ++c)
+            energy[c] += output[i * channels + c] * output[i * channels + c];
+        }
+      }
+
+      for (size_t c = 0; c < channels; ++c) {
+        if (c != active)
+          EXPECT_LT(energy[c], 0.01 * energy[active])
+              << channels << " channels, tone in channel " << active;
+      }
+      EXPECT_EQ(0, WebRtcOpus_EncoderFree(encoder));
+      EXPECT_EQ(0, WebRtcOpus_DecoderFree(decoder));
+    }
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(VariousMode,
                         OpusTest,
                         Combine(Values(1, 2), Values(0, 1)));
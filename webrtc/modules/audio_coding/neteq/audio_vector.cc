@@ -16,6 +16,7 @@
 #include <memory>
 
 #include "webrtc/base/checks.h"
+#include "webrtc/modules/audio_coding/neteq/cross_fade.h"
 #include "webrtc/typedefs.h"
 
 namespace webrtc {
@@ -254,20 +255,29 @@ void AudioVector::CrossFade(const AudioVector& append_this,
   assert(fade_length <= append_this.Size());
   fade_length = std::min(fade_length, Size());
   fade_length = std::min(fade_length, append_this.Size());
-  size_t position = Size() - fade_length + begin_index_;
-  // Cross fade the overlapping regions.
+  // Cross fade the overlapping regions, one chunk at a time. A chunk ends
+  // where either vector wraps around the end of its array.
   // |alpha| is the mixing factor in Q14.
   // TODO(hlundin): Consider skipping +1 in the denominator to produce a
   // smoother cross-fade, in particular at the end of the fade.
-  int alpha_step = 16384 / (static_cast<int>(fade_length) + 1);
-  int alpha = 16384;
-  for (size_t i = 0; i < fade_length; ++i) {
-    alpha -= alpha_step;
-    array_[(position + i) % capacity_] =
-        (alpha * array_[(position + i) % capacity_] +
-            (16384 - alpha) * append_this[i] + 8192) >> 14;
+  const int alpha_step = 16384 / (static_cast<int>(fade_length) + 1);
+  int alpha = 16384 - alpha_step;
+  const CrossFadeFunction cross_fade = GetCrossFadeFunction();
+  const size_t position = Size() - fade_length;
+  for (size_t i = 0; i < fade_length;) {
+    const size_t index = (begin_index_ + position + i) % capacity_;
+    const size_t append_index =
+        (append_this.begin_index_ + i) % append_this.capacity_;
+    const size_t chunk_length =
+        std::min(fade_length - i, std::min(capacity_ - index,
+                                           append_this.capacity_ -
+                                               append_index));
+    cross_fade(&array_[index], &append_this.array_[append_index],
+               chunk_length, alpha, alpha_step, &array_[index]);
+    alpha -= static_cast<int>(chunk_length) * alpha_step;
+    i += chunk_length;
   }
-  assert(alpha >= 0);  // Verify that the slope was correct.
+  assert(alpha + alpha_step >= 0);  // Verify that the slope was correct.
   // Append what is left of |append_this|.
   size_t samples_to_push_back = append_this.Size() - fade_length;
   if (samples_to_push_back > 0)
@@ -284,6 +294,11 @@ bool AudioVector::Empty() const {
   return begin_index_ == end_index_;
 }
 
+size_t AudioVector::Capacity() const {
+  // One sample of the array is always unused; see Reserve().
+  return capacity_ - 1;
+}
+
 const int16_t& AudioVector::operator[](size_t index) const {
   return array_[(begin_index_ + index) % capacity_];
 }
@@ -296,6 +311,9 @@ void AudioVector::Reserve(size_t n) {
   if (capacity_ > n)
     return;
   const size_t length = Size();
+  // Grow by at least 50%, so that a vector that grows in small steps, e.g. by
+  // repeated PushBack() calls, is reallocated a logarithmic number of times.
+  n = std::max(n, capacity_ + capacity_ / 2);
   // Reserve one more sample to remove the ambiguity between empty vector and
   // full vector. Therefore |begin_index_| == |end_index_| indicates empty
   // vector, and |begin_index_| == (|end_index_| + 1) % capacity indicates
@@ -109,6 +109,10 @@ class AudioVector {
   // Returns true if this AudioVector is empty.
   virtual bool Empty() const;
 
+  // Returns the number of elements this AudioVector can hold without
+  // reallocating.
+  virtual size_t Capacity() const;
+
   // Accesses and modifies an element of AudioVector.
   const int16_t& operator[](size_t index) const;
   int16_t& operator[](size_t index);
@@ -14,8 +14,10 @@
 #include <stdlib.h>
 
 #include <string>
+#include <vector>
 
 #include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/modules/audio_coding/neteq/cross_fade.h"
 #include "webrtc/typedefs.h"
 
 namespace webrtc {
@@ -383,4 +385,43 @@ TEST_F(AudioVectorTest, CrossFade) {
   }
 }
 
+// Cross-fades vectors whose contents wrap around the end of their arrays, so
+// that the fade region is split into several pieces.
+TEST_F(AudioVectorTest, CrossFadeWrappedVectors) {
+  static const size_t kLength = 40;
+  static const size_t kFadeLength = 24;
+  for (size_t shift = 0; shift < kLength; shift += 7) {
+    AudioVector vec1(kLength);
+    AudioVector vec2(kLength);
+    std::vector<int16_t> samples1(kLength);
+    std::vector<int16_t> samples2(kLength);
+    // Rotate the start of the vectors to different positions in their arrays,
+    // without changing their capacity.
+    for (size_t i = 0; i < shift; ++i) {
+      vec1.PopFront(1);
+      vec1.PushBack(&samples1[0], 1);
+    }
+    for (size_t i = 0; i < 2 * shift; ++i) {
+      vec2.PopFront(1);
+      vec2.PushBack(&samples2[0], 1);
+    }
+    for (size_t i = 0; i < kLength; ++i) {
+      samples1[i] = vec1[i] = static_cast<int16_t>(1000 * i);
+      samples2[i] = vec2[i] = static_cast<int16_t>(-500 * i);
+    }
+    vec1.CrossFade(vec2, kFadeLength);
+
+    std::vector<int16_t> expected(samples1);
+    const int alpha_step = 16384 / (kFadeLength + 1);
+    CrossFadeC(&samples1[kLength - kFadeLength], &samples2[0], kFadeLength,
+               16384 - alpha_step, alpha_step,
+               &expected[kLength - kFadeLength]);
+    expected.insert(expected.end(), samples2.begin() + kFadeLength,
+                    samples2.end());
+    ASSERT_EQ(expected.size(), vec1.Size());
+    for (size_t i = 0; i < expected.size(); ++i)
+      EXPECT_EQ(expected[i], vec1[i]) << "shift " << shift << ", index " << i;
+  }
+}
+
 }  // namespace webrtc
@@ -29,7 +29,6 @@ int ComfortNoise::UpdateParameters(Packet* packet) {
   // Get comfort noise decoder.
   if (decoder_database_->SetActiveCngDecoder(packet->header.payloadType)
       != kOK) {
-    delete [] packet->payload;
     delete packet;
     return kUnknownPayloadType;
   }
@@ -37,7 +36,6 @@ int ComfortNoise::UpdateParameters(Packet* packet) {
   RTC_DCHECK(cng_decoder);
   cng_decoder->UpdateSid(rtc::ArrayView<const uint8_t>(
       packet->payload, packet->payload_length));
-  delete [] packet->payload;
   delete packet;
   return kOK;
 }
@@ -0,0 +1,44 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/cross_fade.h"
+
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+
+void CrossFadeC(const int16_t* input1, const int16_t* input2, size_t length,
+                int factor, int factor_decrement, int16_t* output) {
+  for (size_t i = 0; i < length; ++i) {
+    output[i] = (factor * input1[i] + (16384 - factor) * input2[i] + 8192) >>
+                14;
+    factor -= factor_decrement;
+  }
+}
+
+CrossFadeFunction GetCrossFadeFunction() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  return CrossFadeSSE2;
+#else
+  // x86 CPU detection required. Only done once, since the cross-fade is used
+  // for every merge and time-stretch operation.
+  static const bool has_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
+  return has_sse2 ? CrossFadeSSE2 : CrossFadeC;
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+  return CrossFadeNEON;
+#else
+  return CrossFadeC;
+#endif
+}
+
+}  // namespace webrtc
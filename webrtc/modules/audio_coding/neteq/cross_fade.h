@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_CROSS_FADE_H_
+#define WEBRTC_MODULES_AUDIO_CODING_NETEQ_CROSS_FADE_H_
+
+#include <stddef.h>
+
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+// Mixes |length| samples of |input1| and |input2| with a linear ramp, and
+// writes the result to |output|:
+//   output[i] = (f * input1[i] + (16384 - f) * input2[i] + 8192) >> 14,
+// where f = |factor| - i * |factor_decrement| is the gain in Q14. The gains
+// must stay within [0, 16384] for all |length| samples. |output| may be equal
+// to |input1| or |input2|. The buffers don't need to be aligned. The output of
+// all implementations is bit-exact with CrossFadeC().
+typedef void (*CrossFadeFunction)(const int16_t* input1,
+                                  const int16_t* input2,
+                                  size_t length,
+                                  int factor,
+                                  int factor_decrement,
+                                  int16_t* output);
+
+void CrossFadeC(const int16_t* input1, const int16_t* input2, size_t length,
+                int factor, int factor_decrement, int16_t* output);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void CrossFadeSSE2(const int16_t* input1, const int16_t* input2, size_t length,
+                   int factor, int factor_decrement, int16_t* output);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void CrossFadeNEON(const int16_t* input1, const int16_t* input2, size_t length,
+                   int factor, int factor_decrement, int16_t* output);
+#endif
+
+// Returns the fastest implementation supported by the CPU.
+CrossFadeFunction GetCrossFadeFunction();
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ_CROSS_FADE_H_
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/cross_fade.h"
+
+#include <arm_neon.h>
+
+namespace webrtc {
+
+void CrossFadeNEON(const int16_t* input1, const int16_t* input2, size_t length,
+                   int factor, int factor_decrement, int16_t* output) {
+  // The gains of the next eight samples. Since all gains are within
+  // [0, 16384], they and their complements fit in 16 bits.
+  const int16_t initial_gains[8] = {
+      static_cast<int16_t>(factor),
+      static_cast<int16_t>(factor - factor_decrement),
+      static_cast<int16_t>(factor - 2 * factor_decrement),
+      static_cast<int16_t>(factor - 3 * factor_decrement),
+      static_cast<int16_t>(factor - 4 * factor_decrement),
+      static_cast<int16_t>(factor - 5 * factor_decrement),
+      static_cast<int16_t>(factor - 6 * factor_decrement),
+      static_cast<int16_t>(factor - 7 * factor_decrement)};
+  int16x8_t gains = vld1q_s16(initial_gains);
+  const int16x8_t gain_step =
+      vdupq_n_s16(static_cast<int16_t>(8 * factor_decrement));
+  const int16x8_t unity = vdupq_n_s16(16384);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const int16x8_t a = vld1q_s16(input1 + i);
+    const int16x8_t b = vld1q_s16(input2 + i);
+    const int16x8_t complements = vsubq_s16(unity, gains);
+    int32x4_t lo = vmull_s16(vget_low_s16(gains), vget_low_s16(a));
+    int32x4_t hi = vmull_s16(vget_high_s16(gains), vget_high_s16(a));
+    lo = vmlal_s16(lo, vget_low_s16(complements), vget_low_s16(b));
+    hi = vmlal_s16(hi, vget_high_s16(complements), vget_high_s16(b));
+    // vrshrn adds 8192 before shifting, like the C version. A weighted mean of
+    // two int16_t samples always fits in 16 bits.
+    vst1q_s16(output + i,
+              vcombine_s16(vrshrn_n_s32(lo, 14), vrshrn_n_s32(hi, 14)));
+    gains = vsubq_s16(gains, gain_step);
+  }
+  CrossFadeC(input1 + i, input2 + i, length - i,
+             factor - static_cast<int>(i) * factor_decrement, factor_decrement,
+             output + i);
+}
+
+}  // namespace webrtc
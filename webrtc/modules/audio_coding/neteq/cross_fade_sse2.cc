@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/cross_fade.h"
+
+#include <emmintrin.h>
+
+namespace webrtc {
+
+void CrossFadeSSE2(const int16_t* input1, const int16_t* input2, size_t length,
+                   int factor, int factor_decrement, int16_t* output) {
+  // The gains of the next eight samples, and their complements. Since all
+  // gains are within [0, 16384], both fit in 16 bits.
+  __m128i gains = _mm_setr_epi16(
+      factor, factor - factor_decrement, factor - 2 * factor_decrement,
+      factor - 3 * factor_decrement, factor - 4 * factor_decrement,
+      factor - 5 * factor_decrement, factor - 6 * factor_decrement,
+      factor - 7 * factor_decrement);
+  const __m128i gain_step = _mm_set1_epi16(8 * factor_decrement);
+  const __m128i unity = _mm_set1_epi16(16384);
+  const __m128i rounding = _mm_set1_epi32(8192);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m128i a = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(input1 + i));
+    const __m128i b = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(input2 + i));
+    const __m128i complements = _mm_sub_epi16(unity, gains);
+    // Interleaving the samples with their gains lets madd compute
+    // f * a + (16384 - f) * b exactly in 32 bits. The sum is at most 2^29.
+    __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(a, b),
+                                _mm_unpacklo_epi16(gains, complements));
+    __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(a, b),
+                                _mm_unpackhi_epi16(gains, complements));
+    lo = _mm_srai_epi32(_mm_add_epi32(lo, rounding), 14);
+    hi = _mm_srai_epi32(_mm_add_epi32(hi, rounding), 14);
+    // A weighted mean of two int16_t samples, so packing never saturates.
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                     _mm_packs_epi32(lo, hi));
+    gains = _mm_sub_epi16(gains, gain_step);
+  }
+  CrossFadeC(input1 + i, input2 + i, length - i,
+             factor - static_cast<int>(i) * factor_decrement, factor_decrement,
+             output + i);
+}
+
+}  // namespace webrtc
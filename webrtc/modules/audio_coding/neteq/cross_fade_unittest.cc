@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/cross_fade.h"
+
+#include <limits>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+
+namespace webrtc {
+namespace {
+const size_t kMaxLength = 100;
+const size_t kMaxOffset = 8;
+
+// Random samples, a fifth of them at the limits of the range.
+void FillSamples(Random* random, std::vector<int16_t>* samples) {
+  for (int16_t& sample : *samples) {
+    switch (random->Rand(0, 9)) {
+      case 0:
+        sample = std::numeric_limits<int16_t>::min();
+        break;
+      case 1:
+        sample = std::numeric_limits<int16_t>::max();
+        break;
+      default:
+        sample = random->Rand<int16_t>();
+    }
+  }
+}
+
+void VerifyCrossFade(CrossFadeFunction cross_fade) {
+  Random random(0x5eed);
+  std::vector<int16_t> input1(kMaxLength + kMaxOffset);
+  std::vector<int16_t> input2(input1.size());
+  std::vector<int16_t> output(input1.size());
+  std::vector<int16_t> expected(input1.size());
+  // Cover all tail lengths and misalignments.
+  for (size_t length = 1; length <= kMaxLength; ++length) {
+    for (size_t offset = 0; offset < kMaxOffset; ++offset) {
+      // A full fade-out of |input1|, as AudioVector::CrossFade() does, and a
+      // random partial fade.
+      const int full_step = 16384 / (static_cast<int>(length) + 1);
+      const int first_factor = random.Rand(0, 16384);
+      const int partial_step =
+          length > 1 ? random.Rand(0, first_factor /
+                                          static_cast<int>(length - 1))
+                     : 0;
+      const int kFactors[][2] = {{16384 - full_step, full_step},
+                                 {first_factor, partial_step}};
+      for (const auto& factor : kFactors) {
+        FillSamples(&random, &input1);
+        FillSamples(&random, &input2);
+        expected = output;
+        CrossFadeC(&input1[offset], &input2[0], length, factor[0], factor[1],
+                   &expected[0]);
+        cross_fade(&input1[offset], &input2[0], length, factor[0], factor[1],
+                   &output[0]);
+        ASSERT_EQ(expected, output) << "length " << length << ", offset "
+                                    << offset << ", factor " << factor[0]
+                                    << ", decrement " << factor[1];
+
+        // In place.
+        expected = input1;
+        CrossFadeC(&expected[offset], &input2[0], length, factor[0],
+                   factor[1], &expected[offset]);
+        cross_fade(&input1[offset], &input2[0], length, factor[0], factor[1],
+                   &input1[offset]);
+        ASSERT_EQ(expected, input1) << "in place, length " << length;
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST(CrossFadeTest, ReferenceValues) {
+  const int16_t input1[] = {1000, 1000, 1000, -1000};
+  const int16_t input2[] = {0, 2000, -2000, 1000};
+  int16_t output[4];
+  // Gains 1.0, 0.75, 0.5 and 0.25 in Q14.
+  CrossFadeC(input1, input2, 4, 16384, 4096, output);
+  EXPECT_EQ(1000, output[0]);
+  EXPECT_EQ(1250, output[1]);
+  EXPECT_EQ(-500, output[2]);
+  EXPECT_EQ(500, output[3]);
+}
+
+TEST(CrossFadeTest, BitExactWithC) {
+  VerifyCrossFade(GetCrossFadeFunction());
+}
+
+}  // namespace webrtc
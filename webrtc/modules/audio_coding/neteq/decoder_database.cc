@@ -42,6 +42,7 @@ DecoderDatabase::DecoderInfo::~DecoderInfo() = default;
 
 AudioDecoder* DecoderDatabase::DecoderInfo::GetDecoder(
     AudioDecoderFactory* factory) {
+  used_ = true;
   if (external_decoder) {
     RTC_DCHECK(!decoder_);
     return external_decoder;
@@ -266,6 +267,31 @@ ComfortNoiseDecoder* DecoderDatabase::GetActiveCngDecoder() {
   return active_cng_decoder_.get();
 }
 
+int DecoderDatabase::DropUnusedDecoders() {
+  int num_dropped = 0;
+  for (auto& it : decoders_) {
+    DecoderInfo& info = it.second;
+    if (!info.used() && info.HasOwnedDecoder() &&
+        it.first != active_decoder_type_) {
+      info.DropDecoder();
+      ++num_dropped;
+    }
+    info.ClearUsed();
+  }
+  return num_dropped;
+}
+
+int DecoderDatabase::NumDecoderInstances() const {
+  int num_instances = 0;
+  for (const auto& it : decoders_) {
+    if (it.second.HasOwnedDecoder())
+      ++num_instances;
+  }
+  if (active_cng_decoder_)
+    ++num_instances;
+  return num_instances;
+}
+
 int DecoderDatabase::CheckPayloadTypes(const PacketList& packet_list) const {
   PacketList::const_iterator it;
   for (it = packet_list.begin(); it != packet_list.end(); ++it) {
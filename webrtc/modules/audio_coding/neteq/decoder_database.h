@@ -55,6 +55,15 @@ class DecoderDatabase {
     // always recreate it later if we need it.)
     void DropDecoder() { decoder_.reset(); }
 
+    // Returns true if the AudioDecoder object is currently allocated, and was
+    // created by the database rather than inserted with InsertExternal().
+    bool HasOwnedDecoder() const { return decoder_ != nullptr; }
+
+    // Returns true if GetDecoder() has been called since the last call to
+    // ClearUsed().
+    bool used() const { return used_; }
+    void ClearUsed() { used_ = false; }
+
     const NetEqDecoder codec_type;
     const std::string name;
     const int fs_hz;
@@ -63,6 +72,7 @@ class DecoderDatabase {
    private:
     const rtc::Optional<SdpAudioFormat> audio_format_;
     std::unique_ptr<AudioDecoder> decoder_;
+    bool used_ = false;
   };
 
   // Maximum value for 8 bits, and an invalid RTP payload type (since it is
@@ -150,6 +160,16 @@ class DecoderDatabase {
   // comfort noise decoder exists.
   virtual ComfortNoiseDecoder* GetActiveCngDecoder();
 
+  // Deletes the AudioDecoder objects that have not been used since the
+  // previous call, except for the active decoder and external decoders. The
+  // objects are recreated if they are needed again. Returns the number of
+  // decoders deleted.
+  virtual int DropUnusedDecoders();
+
+  // Returns the number of AudioDecoder objects currently allocated by the
+  // database. External decoders are not counted.
+  virtual int NumDecoderInstances() const;
+
   // Returns kOK if all packets in |packet_list| carry payload types that are
   // registered in the database. Otherwise, returns kDecoderNotFound.
   virtual int CheckPayloadTypes(const PacketList& packet_list) const;
@@ -87,6 +87,40 @@ TEST(DecoderDatabase, GetDecoder) {
   ASSERT_TRUE(dec != NULL);
 }
 
+// Test that decoders which are not used between two sweeps are deleted, and
+// that the active decoder is kept.
+TEST(DecoderDatabase, DropUnusedDecoders) {
+  DecoderDatabase db(CreateBuiltinAudioDecoderFactory());
+  ASSERT_EQ(DecoderDatabase::kOK,
+            db.RegisterPayload(0, NetEqDecoder::kDecoderPCMu, "pcmu"));
+  ASSERT_EQ(DecoderDatabase::kOK,
+            db.RegisterPayload(8, NetEqDecoder::kDecoderPCMa, "pcma"));
+  EXPECT_EQ(0, db.NumDecoderInstances());
+
+  ASSERT_TRUE(db.GetDecoder(0) != NULL);
+  ASSERT_TRUE(db.GetDecoder(8) != NULL);
+  EXPECT_EQ(2, db.NumDecoderInstances());
+  bool changed;
+  EXPECT_EQ(DecoderDatabase::kOK, db.SetActiveDecoder(0, &changed));
+
+  // Both decoders were used since the database was created.
+  EXPECT_EQ(0, db.DropUnusedDecoders());
+  EXPECT_EQ(2, db.NumDecoderInstances());
+
+  // Only the active decoder is used before the next sweep.
+  ASSERT_TRUE(db.GetActiveDecoder() != NULL);
+  EXPECT_EQ(1, db.DropUnusedDecoders());
+  EXPECT_EQ(1, db.NumDecoderInstances());
+
+  // The active decoder is kept even when it has not been used.
+  EXPECT_EQ(0, db.DropUnusedDecoders());
+  EXPECT_EQ(1, db.NumDecoderInstances());
+
+  // A dropped decoder is recreated on demand.
+  ASSERT_TRUE(db.GetDecoder(8) != NULL);
+  EXPECT_EQ(2, db.NumDecoderInstances());
+}
+
 TEST(DecoderDatabase, TypeTests) {
   DecoderDatabase db(new rtc::RefCountedObject<MockAudioDecoderFactory>);
   const uint8_t kPayloadTypePcmU = 0;
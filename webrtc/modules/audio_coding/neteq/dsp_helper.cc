@@ -15,7 +15,9 @@
 
 #include <algorithm>  // Access to min, max.
 
+#include "webrtc/base/checks.h"
 #include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+#include "webrtc/modules/audio_coding/neteq/cross_fade.h"
 
 namespace webrtc {
 
@@ -276,15 +278,16 @@ size_t DspHelper::MinDistortion(const int16_t* signal, size_t min_lag,
 void DspHelper::CrossFade(const int16_t* input1, const int16_t* input2,
                           size_t length, int16_t* mix_factor,
                           int16_t factor_decrement, int16_t* output) {
-  int16_t factor = *mix_factor;
-  int16_t complement_factor = 16384 - factor;
-  for (size_t i = 0; i < length; i++) {
-    output[i] =
-        (factor * input1[i] + complement_factor * input2[i] + 8192) >> 14;
-    factor -= factor_decrement;
-    complement_factor += factor_decrement;
-  }
-  *mix_factor = factor;
+  if (length == 0)
+    return;
+  const int factor = *mix_factor;
+  const int last_factor =
+      factor - static_cast<int>(length - 1) * factor_decrement;
+  RTC_DCHECK(factor >= 0 && factor <= 16384);
+  RTC_DCHECK(last_factor >= 0 && last_factor <= 16384);
+  GetCrossFadeFunction()(input1, input2, length, factor, factor_decrement,
+                         output);
+  *mix_factor = static_cast<int16_t>(last_factor - factor_decrement);
 }
 
 void DspHelper::UnmuteSignal(const int16_t* input, size_t length,
@@ -55,6 +55,13 @@ struct NetEqNetworkStatistics {
   int median_waiting_time_ms;
   int min_waiting_time_ms;
   int max_waiting_time_ms;
+  // Number of decoder instances currently allocated by NetEq, not counting
+  // external decoders.
+  int decoder_instances;
+  // Number of bytes allocated for the sync buffer and the other audio buffers
+  // of the instance. They are sized for the current sample rate and number of
+  // channels.
+  size_t audio_buffer_bytes;
 };
 
 enum NetEqPlayoutMode {
@@ -96,6 +103,10 @@ class NetEq {
     NetEqPlayoutMode playout_mode;
     bool enable_fast_accelerate;
     bool enable_muted_state = false;
+    // Decoders for payload types that have not been used for this long are
+    // deleted, and recreated if the payload type shows up again. The decoder
+    // for the active payload type is always kept. 0 disables the eviction.
+    int decoder_idle_timeout_ms = 0;
   };
 
   enum ReturnCodes {
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_INCLUDE_NETEQ_BATCH_H_
+#define WEBRTC_MODULES_AUDIO_CODING_NETEQ_INCLUDE_NETEQ_BATCH_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+
+namespace webrtc {
+
+// Forward declarations.
+class AudioFrame;
+class NetEq;
+
+// Pulls 10 ms of audio from a set of NetEq instances in one pass, for servers
+// that decode a large number of streams, e.g. for recording or transcoding.
+//
+// The NetEq instances are split into one shard per thread. An instance is put
+// in the smallest shard when it's added and stays there, so that each instance
+// is always decoded on the same thread and its decoder state stays in that
+// thread's caches. GetAudio() decodes all shards in parallel, one on the
+// calling thread and the rest on worker threads owned by the batch.
+//
+// The NetEq instances of a batch must not be used for anything else while
+// GetAudio() is running. Packets can be inserted from other threads in
+// between, as usual.
+class NetEqBatch {
+ public:
+  // Decodes on |num_threads| threads in total: the thread calling GetAudio(),
+  // and |num_threads| - 1 worker threads.
+  explicit NetEqBatch(size_t num_threads);
+  ~NetEqBatch();
+
+  // Adds |neteq| to the batch. GetAudio() writes its audio to |audio_frame|
+  // and its muted state to |muted|. None of them are owned by the batch, and
+  // they must stay valid until |neteq| is removed from the batch.
+  void AddNetEq(NetEq* neteq, AudioFrame* audio_frame, bool* muted);
+  // Removes |neteq| from the batch. Returns false if it isn't in the batch.
+  bool RemoveNetEq(NetEq* neteq);
+  size_t NumNetEqs() const;
+
+  // Calls NetEq::GetAudio() for every NetEq in the batch and returns once they
+  // have all delivered 10 ms of audio. Returns the number of instances that
+  // returned an error; see NetEq::GetAudio() for what their output then is.
+  int GetAudio();
+
+ private:
+  class Worker;
+
+  struct Stream {
+    NetEq* neteq;
+    AudioFrame* audio_frame;
+    bool* muted;
+  };
+
+  // Calls GetAudio() for the streams of |shard|. Called on the thread calling
+  // GetAudio() for shard 0 and on a worker for the others.
+  void DecodeShard(size_t shard);
+
+  // Held for the duration of GetAudio(). Besides the GetAudio() thread only
+  // the workers access the state below, while GetAudio() waits for them.
+  rtc::CriticalSection crit_;
+  std::vector<std::vector<Stream>> shards_;
+  // The number of errors in each shard in the last GetAudio() call.
+  std::vector<int> shard_errors_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  volatile int pending_workers_;
+  rtc::Event workers_done_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(NetEqBatch);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ_INCLUDE_NETEQ_BATCH_H_
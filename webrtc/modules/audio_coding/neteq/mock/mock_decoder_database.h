@@ -61,6 +61,10 @@ class MockDecoderDatabase : public DecoderDatabase {
       int(uint8_t rtp_payload_type));
   MOCK_METHOD0(GetActiveCngDecoder,
       ComfortNoiseDecoder*());
+  MOCK_METHOD0(DropUnusedDecoders,
+      int());
+  MOCK_CONST_METHOD0(NumDecoderInstances,
+      int());
   MOCK_CONST_METHOD1(CheckPayloadTypes,
       int(const PacketList& packet_list));
 };
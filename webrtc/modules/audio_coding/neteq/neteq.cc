@@ -28,7 +28,8 @@ std::string NetEq::Config::ToString() const {
      << ", playout_mode=" << playout_mode
      << ", enable_fast_accelerate="
      << (enable_fast_accelerate ? " true": "false")
-     << ", enable_muted_state=" << (enable_muted_state ? " true": "false");
+     << ", enable_muted_state=" << (enable_muted_state ? " true": "false")
+     << ", decoder_idle_timeout_ms=" << decoder_idle_timeout_ms;
   return ss.str();
 }
 
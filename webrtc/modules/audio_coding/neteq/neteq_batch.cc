@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/include/neteq_batch.h"
+
+#include <algorithm>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/modules/audio_coding/neteq/include/neteq.h"
+
+namespace webrtc {
+
+// Waits for GetAudio() to start, decodes its shard, and signals the batch once
+// the last worker is done.
+class NetEqBatch::Worker {
+ public:
+  Worker(NetEqBatch* batch, size_t shard)
+      : batch_(batch),
+        shard_(shard),
+        start_(false, false),
+        quit_(0),
+        thread_(&Worker::Run, this, "NetEqBatchWorker") {
+    thread_.Start();
+    thread_.SetPriority(rtc::kHighPriority);
+  }
+
+  ~Worker() {
+    rtc::AtomicOps::ReleaseStore(&quit_, 1);
+    start_.Set();
+    thread_.Stop();
+  }
+
+  void Start() { start_.Set(); }
+
+ private:
+  static bool Run(void* obj) { return static_cast<Worker*>(obj)->RunOnce(); }
+
+  bool RunOnce() {
+    start_.Wait(rtc::Event::kForever);
+    if (rtc::AtomicOps::AcquireLoad(&quit_))
+      return false;
+    batch_->DecodeShard(shard_);
+    if (rtc::AtomicOps::Decrement(&batch_->pending_workers_) == 0)
+      batch_->workers_done_.Set();
+    return true;
+  }
+
+  NetEqBatch* const batch_;
+  const size_t shard_;
+  rtc::Event start_;
+  volatile int quit_;
+  rtc::PlatformThread thread_;
+};
+
+NetEqBatch::NetEqBatch(size_t num_threads)
+    : shards_(std::max<size_t>(num_threads, 1)),
+      shard_errors_(shards_.size(), 0),
+      pending_workers_(0),
+      workers_done_(false, false) {
+  for (size_t shard = 1; shard < shards_.size(); ++shard)
+    workers_.push_back(std::unique_ptr<Worker>(new Worker(this, shard)));
+}
+
+NetEqBatch::~NetEqBatch() {
+  // Join the workers before the state they use goes away.
+  workers_.clear();
+}
+
+void NetEqBatch::AddNetEq(NetEq* neteq,
+                          AudioFrame* audio_frame,
+                          bool* muted) {
+  RTC_DCHECK(neteq);
+  RTC_DCHECK(audio_frame);
+  RTC_DCHECK(muted);
+  rtc::CritScope cs(&crit_);
+  auto smallest = std::min_element(
+      shards_.begin(), shards_.end(),
+      [](const std::vector<Stream>& a, const std::vector<Stream>& b) {
+        return a.size() < b.size();
+      });
+  Stream stream = {neteq, audio_frame, muted};
+  smallest->push_back(stream);
+}
+
+bool NetEqBatch::RemoveNetEq(NetEq* neteq) {
+  rtc::CritScope cs(&crit_);
+  for (std::vector<Stream>& shard : shards_) {
+    auto it = std::find_if(
+        shard.begin(), shard.end(),
+        [neteq](const Stream& stream) { return stream.neteq == neteq; });
+    if (it != shard.end()) {
+      shard.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t NetEqBatch::NumNetEqs() const {
+  rtc::CritScope cs(&crit_);
+  size_t num_neteqs = 0;
+  for (const std::vector<Stream>& shard : shards_)
+    num_neteqs += shard.size();
+  return num_neteqs;
+}
+
+int NetEqBatch::GetAudio() {
+  rtc::CritScope cs(&crit_);
+  if (!workers_.empty()) {
+    rtc::AtomicOps::ReleaseStore(&pending_workers_,
+                                 static_cast<int>(workers_.size()));
+    for (const auto& worker : workers_)
+      worker->Start();
+  }
+  DecodeShard(0);
+  if (!workers_.empty())
+    workers_done_.Wait(rtc::Event::kForever);
+  int num_errors = 0;
+  for (int shard_errors : shard_errors_)
+    num_errors += shard_errors;
+  return num_errors;
+}
+
+void NetEqBatch::DecodeShard(size_t shard) {
+  int num_errors = 0;
+  for (const Stream& stream : shards_[shard]) {
+    if (stream.neteq->GetAudio(stream.audio_frame, stream.muted) !=
+        NetEq::kOK) {
+      ++num_errors;
+    }
+  }
+  shard_errors_[shard] = num_errors;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/include/neteq_batch.h"
+
+#include <memory>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/arraysize.h"
+#include "webrtc/base/refcount.h"
+#include "webrtc/modules/audio_coding/codecs/mock/mock_audio_decoder_factory.h"
+#include "webrtc/modules/audio_coding/neteq/include/neteq.h"
+#include "webrtc/modules/include/module_common_types.h"
+
+namespace webrtc {
+
+namespace {
+const int kSampleRatesHz[] = {8000, 16000, 32000, 48000};
+
+class NetEqBatchTest : public ::testing::TestWithParam<size_t> {
+ protected:
+  // Creates |num_neteqs| NetEq instances, with different sample rates.
+  void CreateNetEqs(size_t num_neteqs) {
+    rtc::scoped_refptr<AudioDecoderFactory> factory(
+        new rtc::RefCountedObject<MockAudioDecoderFactory>());
+    for (size_t i = 0; i < num_neteqs; ++i) {
+      NetEq::Config config;
+      config.sample_rate_hz = kSampleRatesHz[i % arraysize(kSampleRatesHz)];
+      neteqs_.push_back(std::unique_ptr<NetEq>(NetEq::Create(config, factory)));
+      frames_.push_back(std::unique_ptr<AudioFrame>(new AudioFrame()));
+    }
+    muted_.reset(new bool[num_neteqs]);
+    for (size_t i = 0; i < num_neteqs; ++i)
+      muted_[i] = true;
+  }
+
+  // Verifies that every frame holds 10 ms of audio at the rate of its NetEq.
+  void VerifyFrames(size_t num_neteqs) {
+    for (size_t i = 0; i < num_neteqs; ++i) {
+      const int sample_rate_hz = kSampleRatesHz[i % arraysize(kSampleRatesHz)];
+      EXPECT_EQ(sample_rate_hz, frames_[i]->sample_rate_hz_);
+      EXPECT_EQ(static_cast<size_t>(sample_rate_hz / 100),
+                frames_[i]->samples_per_channel_);
+      EXPECT_FALSE(muted_[i]);
+    }
+  }
+
+  std::vector<std::unique_ptr<NetEq>> neteqs_;
+  std::vector<std::unique_ptr<AudioFrame>> frames_;
+  std::unique_ptr<bool[]> muted_;
+};
+}  // namespace
+
+TEST_P(NetEqBatchTest, GetAudioFromAll) {
+  const size_t kNumNetEqs = 20;
+  CreateNetEqs(kNumNetEqs);
+  NetEqBatch batch(GetParam());
+  for (size_t i = 0; i < kNumNetEqs; ++i) {
+    batch.AddNetEq(neteqs_[i].get(), frames_[i].get(), &muted_[i]);
+  }
+  EXPECT_EQ(kNumNetEqs, batch.NumNetEqs());
+
+  for (int k = 0; k < 10; ++k) {
+    for (auto& frame : frames_)
+      frame->sample_rate_hz_ = 0;
+    EXPECT_EQ(0, batch.GetAudio());
+    VerifyFrames(kNumNetEqs);
+  }
+}
+
+TEST_P(NetEqBatchTest, AddAndRemove) {
+  const size_t kNumNetEqs = 8;
+  CreateNetEqs(kNumNetEqs);
+  NetEqBatch batch(GetParam());
+  EXPECT_EQ(0, batch.GetAudio());
+  EXPECT_FALSE(batch.RemoveNetEq(neteqs_[0].get()));
+
+  for (size_t i = 0; i < kNumNetEqs; ++i) {
+    batch.AddNetEq(neteqs_[i].get(), frames_[i].get(), &muted_[i]);
+  }
+  // Remove every other one; their frames must no longer be written.
+  for (size_t i = 0; i < kNumNetEqs; i += 2)
+    EXPECT_TRUE(batch.RemoveNetEq(neteqs_[i].get()));
+  EXPECT_FALSE(batch.RemoveNetEq(neteqs_[0].get()));
+  EXPECT_EQ(kNumNetEqs / 2, batch.NumNetEqs());
+
+  for (auto& frame : frames_)
+    frame->sample_rate_hz_ = 0;
+  EXPECT_EQ(0, batch.GetAudio());
+  for (size_t i = 0; i < kNumNetEqs; ++i) {
+    if (i % 2 == 0) {
+      EXPECT_EQ(0, frames_[i]->sample_rate_hz_);
+    } else {
+      EXPECT_EQ(kSampleRatesHz[i % arraysize(kSampleRatesHz)],
+                frames_[i]->sample_rate_hz_);
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(NumThreads, NetEqBatchTest,
+                        ::testing::Values(1, 2, 4));
+
+}  // namespace webrtc
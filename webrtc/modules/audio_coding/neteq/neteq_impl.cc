@@ -94,8 +94,7 @@ NetEqImpl::NetEqImpl(const NetEq::Config& config,
       accelerate_factory_(std::move(deps.accelerate_factory)),
       preemptive_expand_factory_(std::move(deps.preemptive_expand_factory)),
       last_mode_(kModeNormal),
-      decoded_buffer_length_(kMaxFrameSize),
-      decoded_buffer_(new int16_t[decoded_buffer_length_]),
+      decoded_buffer_length_(0),
       playout_timestamp_(0),
       new_codec_(false),
       timestamp_(0),
@@ -110,8 +109,18 @@ NetEqImpl::NetEqImpl(const NetEq::Config& config,
       playout_mode_(config.playout_mode),
       enable_fast_accelerate_(config.enable_fast_accelerate),
       nack_enabled_(false),
-      enable_muted_state_(config.enable_muted_state) {
+      enable_muted_state_(config.enable_muted_state),
+      decoder_sweep_ticks_(
+          config.decoder_idle_timeout_ms > 0
+              ? std::max<uint64_t>(config.decoder_idle_timeout_ms / 2 /
+                                       tick_timer_->ms_per_tick(),
+                                   1)
+              : 0) {
   LOG(LS_INFO) << "NetEq config: " << config.ToString();
+  if (decoder_sweep_ticks_ > 0) {
+    decoder_sweep_countdown_ =
+        tick_timer_->GetNewCountdown(decoder_sweep_ticks_);
+  }
   int fs = config.sample_rate_hz;
   if (fs != 8000 && fs != 16000 && fs != 32000 && fs != 48000) {
     LOG(LS_ERROR) << "Sample rate " << fs << " Hz not supported. " <<
@@ -205,6 +214,14 @@ void SetAudioFrameActivityAndType(bool vad_enabled,
     audio_frame->vad_activity_ = AudioFrame::kVadUnknown;
   }
 }
+
+// Returns the number of bytes allocated for the samples of |vector|.
+size_t AllocatedBytes(const AudioMultiVector& vector) {
+  size_t bytes = 0;
+  for (size_t channel = 0; channel < vector.Channels(); ++channel)
+    bytes += vector[channel].Capacity() * sizeof(int16_t);
+  return bytes;
+}
 }  // namespace
 
 int NetEqImpl::GetAudio(AudioFrame* audio_frame, bool* muted) {
@@ -388,6 +405,10 @@ int NetEqImpl::NetworkStatistics(NetEqNetworkStatistics* stats) {
   stats_.GetNetworkStatistics(fs_hz_, total_samples_in_buffers,
                               decoder_frame_length_, *delay_manager_.get(),
                               *decision_logic_.get(), stats);
+  stats->decoder_instances = decoder_database_->NumDecoderInstances();
+  stats->audio_buffer_bytes = AllocatedBytes(*sync_buffer_) +
+                              AllocatedBytes(*algorithm_buffer_) +
+                              decoded_buffer_length_ * sizeof(int16_t);
   return 0;
 }
 
@@ -551,17 +572,15 @@ int NetEqImpl::InsertPacketInternal(const WebRtcRTPHeader& rtp_header,
     packet->header.timestamp = rtp_header.header.timestamp;
     packet->header.ssrc = rtp_header.header.ssrc;
     packet->header.numCSRCs = 0;
-    packet->payload_length = payload.size();
     packet->primary = true;
     // Waiting time will be set upon inserting the packet in the buffer.
     RTC_DCHECK(!packet->waiting_time);
-    packet->payload = new uint8_t[packet->payload_length];
     packet->sync_packet = is_sync_packet;
-    if (!packet->payload) {
-      LOG_F(LS_ERROR) << "Payload pointer is NULL.";
-    }
     assert(!payload.empty());  // Already checked above.
-    memcpy(packet->payload, payload.data(), packet->payload_length);
+    // This is the only copy of the payload; packets split from this one share
+    // its memory.
+    memcpy(packet->AllocatePayload(payload.size()), payload.data(),
+           payload.size());
     // Insert packet in a packet list.
     packet_list.push_back(packet);
     // Save main payloads header for later.
@@ -649,8 +668,6 @@ int NetEqImpl::InsertPacketInternal(const WebRtcRTPHeader& rtp_header,
         PacketBuffer::DeleteAllPackets(&packet_list);
         return kDtmfInsertError;
       }
-      // TODO(hlundin): Let the destructor of Packet handle the payload.
-      delete [] current_packet->payload;
       delete current_packet;
       it = packet_list.erase(it);
     } else {
@@ -820,6 +837,12 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame, bool* muted) {
   tick_timer_->Increment();
   stats_.IncreaseCounter(output_size_samples_, fs_hz_);
 
+  if (decoder_sweep_countdown_ && decoder_sweep_countdown_->Finished()) {
+    decoder_database_->DropUnusedDecoders();
+    decoder_sweep_countdown_ =
+        tick_timer_->GetNewCountdown(decoder_sweep_ticks_);
+  }
+
   // Check for muted state.
   if (enable_muted_state_ && expand_->Muted() && packet_buffer_->Empty()) {
     RTC_DCHECK_EQ(last_mode_, kModeExpand);
@@ -1473,7 +1496,8 @@ int NetEqImpl::DecodeLoop(PacketList* packet_list, const Operations& operation,
     // The number of channels in the |sync_buffer_| should be the same as the
     // number decoder channels.
     assert(sync_buffer_->Channels() == decoder->Channels());
-    assert(decoded_buffer_length_ >= kMaxFrameSize * decoder->Channels());
+    assert(decoded_buffer_length_ >=
+           2 * kMaxFrameSize * fs_hz_ / 48000 * decoder->Channels());
     assert(operation == kNormal || operation == kAccelerate ||
            operation == kFastAccelerate || operation == kMerge ||
            operation == kPreemptiveExpand);
@@ -1482,6 +1506,15 @@ int NetEqImpl::DecodeLoop(PacketList* packet_list, const Operations& operation,
     int decode_length;
     if (packet->sync_packet) {
       // Decode to silence with the same frame size as the last decode.
+      if (static_cast<size_t>(*decoded_length) +
+              decoder_frame_length_ * decoder->Channels() >
+          decoded_buffer_length_) {
+        // Guard against overflow.
+        LOG(LS_WARNING) << "Decoded too much.";
+        delete packet;
+        PacketBuffer::DeleteAllPackets(packet_list);
+        return kDecodedTooMuch;
+      }
       memset(&decoded_buffer_[*decoded_length], 0,
              decoder_frame_length_ * decoder->Channels() *
                  sizeof(decoded_buffer_[0]));
@@ -1500,7 +1533,6 @@ int NetEqImpl::DecodeLoop(PacketList* packet_list, const Operations& operation,
               &decoded_buffer_[*decoded_length], speech_type);
     }
 
-    delete[] packet->payload;
     delete packet;
     packet = NULL;
     if (decode_length > 0) {
@@ -2133,10 +2165,14 @@ void NetEqImpl::SetSampleRateAndChannels(int fs_hz, size_t channels) {
   comfort_noise_.reset(new ComfortNoise(fs_hz, decoder_database_.get(),
                                         sync_buffer_.get()));
 
-  // Verify that |decoded_buffer_| is long enough.
-  if (decoded_buffer_length_ < kMaxFrameSize * channels) {
-    // Reallocate to larger size.
-    decoded_buffer_length_ = kMaxFrameSize * channels;
+  // Size |decoded_buffer_| for the new sample rate and number of channels,
+  // rather than for the highest rate. ExtractPackets() may hand over a second
+  // packet when the first one is too short, so leave room for two
+  // maximum-size frames.
+  const size_t decoded_buffer_length =
+      2 * kMaxFrameSize * fs_hz / 48000 * channels;
+  if (decoded_buffer_length_ != decoded_buffer_length) {
+    decoded_buffer_length_ = decoded_buffer_length;
     decoded_buffer_.reset(new int16_t[decoded_buffer_length_]);
   }
 
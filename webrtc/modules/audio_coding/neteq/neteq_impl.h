@@ -211,10 +211,11 @@ class NetEqImpl : public webrtc::NetEq {
  protected:
   static const int kOutputSizeMs = 10;
   static const size_t kMaxFrameSize = 5760;  // 120 ms @ 48 kHz.
-  // TODO(hlundin): Provide a better value for kSyncBufferSize.
-  // Current value is kMaxFrameSize + 60 ms * 48 kHz, which is enough for
-  // calculating correlations of current frame against history.
-  static const size_t kSyncBufferSize = kMaxFrameSize + 60 * 48;
+  // Length of the sync buffer in samples at 8 kHz; it is scaled with
+  // |fs_mult_|. 250 ms holds a maximum-size frame on top of the up to 30 ms
+  // which are left when NetEq decodes and what time stretching adds, and
+  // still leaves the history which expand and time stretching read.
+  static const size_t kSyncBufferSize = 250 * 8;
 
   // Inserts a new packet into NetEq. This is used by the InsertPacket method
   // above. Returns 0 on success, otherwise an error code.
@@ -412,6 +413,12 @@ class NetEqImpl : public webrtc::NetEq {
       AudioFrame::kVadPassive;
   std::unique_ptr<TickTimer::Stopwatch> generated_noise_stopwatch_
       GUARDED_BY(crit_sect_);
+  // Half of the decoder idle timeout, in ticks; 0 if eviction is disabled.
+  // Unused decoders are dropped every time |decoder_sweep_countdown_| expires,
+  // so a decoder is deleted after being idle for one to two sweep periods.
+  const uint64_t decoder_sweep_ticks_;
+  std::unique_ptr<TickTimer::Countdown> decoder_sweep_countdown_
+      GUARDED_BY(crit_sect_);
 
  private:
   RTC_DISALLOW_COPY_AND_ASSIGN(NetEqImpl);
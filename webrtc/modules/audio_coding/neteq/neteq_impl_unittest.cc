@@ -769,7 +769,7 @@ TEST_F(NetEqImplTest, CodecInternalCng) {
 TEST_F(NetEqImplTest, UnsupportedDecoder) {
   UseNoMocks();
   CreateInstance();
-  static const size_t kNetEqMaxFrameSize = 5760;  // 120 ms @ 48 kHz.
+  static const size_t kNetEqMaxFrameSize = 1920;  // 2 * 120 ms @ 8 kHz.
   static const size_t kChannels = 2;
 
   const uint8_t kPayloadType = 17;   // Just an arbitrary number.
@@ -904,6 +904,150 @@ TEST_F(NetEqImplTest, FloodBufferAndGetNetworkStats) {
   EXPECT_EQ(NetEq::kOK, neteq_->NetworkStatistics(&stats));
 }
 
+// The audio buffers of NetEq are sized for the sample rate of the decoder,
+// not for the highest sample rate.
+TEST_F(NetEqImplTest, AudioBufferBytesFollowSampleRate) {
+  UseNoMocks();
+  CreateInstance();  // 8 kHz.
+
+  NetEqNetworkStatistics stats;
+  EXPECT_EQ(NetEq::kOK, neteq_->NetworkStatistics(&stats));
+  const size_t bytes_8khz = stats.audio_buffer_bytes;
+  EXPECT_GT(bytes_8khz, 0u);
+
+  const size_t kPayloadLengthSamples = 160;  // 10 ms at 16 kHz.
+  const size_t kPayloadLengthBytes = 2 * kPayloadLengthSamples;
+  const uint8_t kPayloadType = 17;   // Just an arbitrary number.
+  const uint32_t kReceiveTime = 17;  // Value doesn't matter for this test.
+  uint8_t payload[kPayloadLengthBytes] = {0};
+  WebRtcRTPHeader rtp_header;
+  rtp_header.header.payloadType = kPayloadType;
+  rtp_header.header.sequenceNumber = 0x1234;
+  rtp_header.header.timestamp = 0x12345678;
+  rtp_header.header.ssrc = 0x87654321;
+  EXPECT_EQ(NetEq::kOK, neteq_->RegisterPayloadType(
+                            NetEqDecoder::kDecoderPCM16Bwb, "", kPayloadType));
+
+  AudioFrame output;
+  bool muted;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(NetEq::kOK,
+              neteq_->InsertPacket(rtp_header, payload, kReceiveTime));
+    rtp_header.header.timestamp +=
+        rtc::checked_cast<uint32_t>(kPayloadLengthSamples);
+    ++rtp_header.header.sequenceNumber;
+    EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+    ASSERT_EQ(kPayloadLengthSamples, output.samples_per_channel_);
+  }
+  EXPECT_EQ(NetEq::kOK, neteq_->NetworkStatistics(&stats));
+  const size_t bytes_16khz = stats.audio_buffer_bytes;
+  // Twice the sample rate takes about twice the memory.
+  EXPECT_GT(bytes_16khz, 3 * bytes_8khz / 2);
+  EXPECT_LT(bytes_16khz, 3 * bytes_8khz);
+}
+
+// When the first packet is too short for the operation, ExtractPackets() hands
+// over a second packet too. The decoded buffer must hold a short packet
+// followed by a 120 ms packet also at sample rates below 48 kHz.
+TEST_F(NetEqImplTest, DecodeShortPacketFollowedBy120msPacket) {
+  UseNoMocks();
+  use_mock_delay_manager_ = true;
+  CreateInstance();
+
+  const uint8_t kPayloadType = 17;   // Just an arbitrary number.
+  const uint32_t kReceiveTime = 17;  // Value doesn't matter for this test.
+  const int kSampleRateHz = 16000;
+  const size_t kShortPacketSamples = 10 * kSampleRateHz / 1000;
+  const size_t kLongPacketSamples = 120 * kSampleRateHz / 1000;
+  // The first payload byte tells the mock decoder the packet duration in ms.
+  const uint8_t kShortPayloadValue = 10;
+  const uint8_t kLongPayloadValue = 120;
+  const int kShortPackets = 6;
+  const size_t kPayloadLengthBytes = 1;
+  uint8_t payload[kPayloadLengthBytes] = {0};
+  WebRtcRTPHeader rtp_header;
+  rtp_header.header.payloadType = kPayloadType;
+  rtp_header.header.sequenceNumber = 0x1234;
+  rtp_header.header.timestamp = 0x12345678;
+  rtp_header.header.ssrc = 0x87654321;
+
+  MockAudioDecoder mock_decoder;
+  EXPECT_CALL(mock_decoder, Reset()).WillRepeatedly(Return());
+  EXPECT_CALL(mock_decoder, Channels()).WillRepeatedly(Return(1));
+  EXPECT_CALL(mock_decoder, IncomingPacket(_, kPayloadLengthBytes, _, _, _))
+      .WillRepeatedly(Return(0));
+  EXPECT_CALL(mock_decoder, PacketDuration(Pointee(kShortPayloadValue), _))
+      .WillRepeatedly(Return(kShortPacketSamples));
+  EXPECT_CALL(mock_decoder, PacketDuration(Pointee(kLongPayloadValue), _))
+      .WillRepeatedly(Return(kLongPacketSamples));
+  int16_t dummy_output[kLongPacketSamples] = {0};
+  EXPECT_CALL(mock_decoder, DecodeInternal(Pointee(kShortPayloadValue),
+                                           kPayloadLengthBytes, kSampleRateHz,
+                                           _, _))
+      .Times(kShortPackets + 1)
+      .WillRepeatedly(
+          DoAll(SetArrayArgument<3>(dummy_output,
+                                    dummy_output + kShortPacketSamples),
+                SetArgPointee<4>(AudioDecoder::kSpeech),
+                Return(kShortPacketSamples)));
+  EXPECT_CALL(mock_decoder, DecodeInternal(Pointee(kLongPayloadValue),
+                                           kPayloadLengthBytes, kSampleRateHz,
+                                           _, _))
+      .WillOnce(
+          DoAll(SetArrayArgument<3>(dummy_output,
+                                    dummy_output + kLongPacketSamples),
+                SetArgPointee<4>(AudioDecoder::kSpeech),
+                Return(kLongPacketSamples)));
+  EXPECT_EQ(NetEq::kOK, neteq_->RegisterExternalDecoder(
+                            &mock_decoder, NetEqDecoder::kDecoderPCM16Bwb,
+                            "dummy name", kPayloadType, kSampleRateHz));
+
+  // Buffer limits which neither accelerate nor preemptively expand.
+  EXPECT_CALL(*mock_delay_manager_, BufferLimits(_, _))
+      .WillRepeatedly(DoAll(SetArgPointee<0>(0), SetArgPointee<1>(1000)));
+
+  // Decode short packets one at a time until time stretching is allowed. Each
+  // leaves no decoded audio for the next call.
+  AudioFrame output;
+  bool muted;
+  payload[0] = kShortPayloadValue;
+  for (int i = 0; i < kShortPackets; ++i) {
+    EXPECT_EQ(NetEq::kOK,
+              neteq_->InsertPacket(rtp_header, payload, kReceiveTime));
+    EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+    ASSERT_EQ(kShortPacketSamples, output.samples_per_channel_);
+    ASSERT_EQ(kNormal, neteq_->last_operation_for_test());
+    ++rtp_header.header.sequenceNumber;
+    rtp_header.header.timestamp +=
+        rtc::checked_cast<uint32_t>(kShortPacketSamples);
+  }
+
+  // Insert a short packet followed by a 120 ms packet.
+  for (uint8_t payload_value : {kShortPayloadValue, kLongPayloadValue}) {
+    payload[0] = payload_value;
+    EXPECT_EQ(NetEq::kOK,
+              neteq_->InsertPacket(rtp_header, payload, kReceiveTime));
+    ++rtp_header.header.sequenceNumber;
+    rtp_header.header.timestamp +=
+        rtc::checked_cast<uint32_t>(kShortPacketSamples);
+  }
+
+  // Delay manager reports buffer limits which cause a PreemptiveExpand. It
+  // wants 20 ms of decoded audio, so both packets are decoded in one go.
+  EXPECT_CALL(*mock_delay_manager_, BufferLimits(_, _))
+      .Times(1)
+      .WillOnce(DoAll(SetArgPointee<0>(100), SetArgPointee<1>(100)));
+
+  EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+  EXPECT_EQ(kPreemptiveExpand, neteq_->last_operation_for_test());
+  EXPECT_EQ(kShortPacketSamples, output.samples_per_channel_);
+  EXPECT_EQ(AudioFrame::kNormalSpeech, output.speech_type_);
+  // All but 10 ms of the decoded audio is left in the sync buffer.
+  EXPECT_GE(neteq_->sync_buffer_for_test()->FutureLength(), kLongPacketSamples);
+
+  EXPECT_CALL(mock_decoder, Die());
+}
+
 TEST_F(NetEqImplTest, DecodedPayloadTooShort) {
   UseNoMocks();
   CreateInstance();
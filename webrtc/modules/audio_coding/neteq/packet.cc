@@ -10,10 +10,27 @@
 
 #include "webrtc/modules/audio_coding/neteq/packet.h"
 
+#include "webrtc/base/checks.h"
+
 namespace webrtc {
 
 Packet::Packet() = default;
 
 Packet::~Packet() = default;
 
+uint8_t* Packet::AllocatePayload(size_t length) {
+  payload_buffer_ = rtc::CopyOnWriteBuffer(length);
+  // The buffer is not shared yet, so writing to it does not need a copy.
+  payload = payload_buffer_.data();
+  payload_length = length;
+  return payload;
+}
+
+void Packet::SharePayload(const Packet& packet, size_t offset, size_t length) {
+  RTC_DCHECK_LE(offset + length, packet.payload_length);
+  payload_buffer_ = packet.payload_buffer_;
+  payload = packet.payload + offset;
+  payload_length = length;
+}
+
 }  // namespace webrtc
@@ -14,6 +14,7 @@
 #include <list>
 #include <memory>
 
+#include "webrtc/base/copyonwritebuffer.h"
 #include "webrtc/modules/audio_coding/neteq/tick_timer.h"
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/typedefs.h"
@@ -23,7 +24,9 @@ namespace webrtc {
 // Struct for holding RTP packets.
 struct Packet {
   RTPHeader header;
-  // Datagram excluding RTP header and header extension.
+  // Datagram excluding RTP header and header extension. The packets which are
+  // split from the same RTP packet point into the same reference counted
+  // buffer, which is released with the last of them.
   uint8_t* payload = nullptr;
   size_t payload_length = 0;
   bool primary = true;  // Primary, i.e., not redundant payload.
@@ -33,6 +36,13 @@ struct Packet {
   Packet();
   ~Packet();
 
+  // Allocates a payload of |length| bytes and returns a pointer to it.
+  uint8_t* AllocatePayload(size_t length);
+
+  // Lets |payload| point to the |length| bytes at |offset| in the payload of
+  // |packet|, without copying them.
+  void SharePayload(const Packet& packet, size_t offset, size_t length);
+
   // Comparison operators. Establish a packet ordering based on (1) timestamp,
   // (2) sequence number, (3) regular packet vs sync-packet and (4) redundancy.
   // Timestamp and sequence numbers are compared taking wrap-around into
@@ -76,6 +86,10 @@ struct Packet {
   bool operator>(const Packet& rhs) const { return rhs.operator<(*this); }
   bool operator<=(const Packet& rhs) const { return !operator>(rhs); }
   bool operator>=(const Packet& rhs) const { return !operator<(rhs); }
+
+ private:
+  // Owns the memory which |payload| points into.
+  rtc::CopyOnWriteBuffer payload_buffer_;
 };
 
 // A list of packets.
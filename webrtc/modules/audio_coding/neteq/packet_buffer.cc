@@ -8,13 +8,15 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-// This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// This is the implementation of the PacketBuffer class. It is based on a ring
+// buffer of packet pointers, which is kept sorted at all times so that the next
+// packet to decode is at the front.
 
 #include "webrtc/modules/audio_coding/neteq/packet_buffer.h"
 
-#include <algorithm>  // find_if()
+#include <assert.h>
+
+#include <algorithm>
 
 #include "webrtc/base/logging.h"
 #include "webrtc/modules/audio_coding/codecs/audio_decoder.h"
@@ -23,24 +25,16 @@
 
 namespace webrtc {
 
-// Predicate used when inserting packets in the buffer list.
-// Operator() returns true when |packet| goes before |new_packet|.
-class NewTimestampIsLarger {
- public:
-  explicit NewTimestampIsLarger(const Packet* new_packet)
-      : new_packet_(new_packet) {
-  }
-  bool operator()(Packet* packet) {
-    return (*new_packet_ >= *packet);
-  }
-
- private:
-  const Packet* new_packet_;
-};
-
 PacketBuffer::PacketBuffer(size_t max_number_of_packets,
                            const TickTimer* tick_timer)
-    : max_number_of_packets_(max_number_of_packets), tick_timer_(tick_timer) {}
+    : max_number_of_packets_(max_number_of_packets),
+      // Room for one packet even if |max_number_of_packets| is zero, since
+      // InsertPacket() always inserts the new packet after flushing.
+      capacity_(std::max<size_t>(max_number_of_packets, 1)),
+      slots_(new Packet*[capacity_]),
+      first_(0),
+      size_(0),
+      tick_timer_(tick_timer) {}
 
 // Destructor. All packets in the buffer will be destroyed.
 PacketBuffer::~PacketBuffer() {
@@ -49,11 +43,13 @@ PacketBuffer::~PacketBuffer() {
 
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush() {
-  DeleteAllPackets(&buffer_);
+  while (!Empty())
+    delete PopFront();
+  first_ = 0;
 }
 
 bool PacketBuffer::Empty() const {
-  return buffer_.empty();
+  return size_ == 0;
 }
 
 int PacketBuffer::InsertPacket(Packet* packet) {
@@ -69,41 +65,33 @@ int PacketBuffer::InsertPacket(Packet* packet) {
 
   packet->waiting_time = tick_timer_->GetNewStopwatch();
 
-  if (buffer_.size() >= max_number_of_packets_) {
+  if (size_ >= max_number_of_packets_) {
     // Buffer is full. Flush it.
     Flush();
     LOG(LS_WARNING) << "Packet buffer flushed";
     return_val = kFlushed;
   }
 
-  // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(),
-      NewTimestampIsLarger(packet));
-
-  // The new packet is to be inserted to the right of |rit|. If it has the same
-  // timestamp as |rit|, which has a higher priority, do not insert the new
-  // packet to list.
-  if (rit != buffer_.rend() &&
-      packet->header.timestamp == (*rit)->header.timestamp) {
-    delete [] packet->payload;
+  // The new packet is to be inserted right before the packet at |index|.
+  const size_t index = InsertionIndex(*packet);
+
+  // If the new packet has the same timestamp as the packet before it, which
+  // has a higher priority, do not insert the new packet.
+  if (index > 0 &&
+      packet->header.timestamp == PacketAt(index - 1)->header.timestamp) {
     delete packet;
     return return_val;
   }
 
-  // The new packet is to be inserted to the left of |it|. If it has the same
-  // timestamp as |it|, which has a lower priority, replace |it| with the new
-  // packet.
-  PacketList::iterator it = rit.base();
-  if (it != buffer_.end() &&
-      packet->header.timestamp == (*it)->header.timestamp) {
-    delete [] (*it)->payload;
-    delete *it;
-    it = buffer_.erase(it);
+  // If the new packet has the same timestamp as the packet at |index|, which
+  // has a lower priority, replace that packet with the new one.
+  if (index < size_ &&
+      packet->header.timestamp == PacketAt(index)->header.timestamp) {
+    delete PacketAt(index);
+    PacketAt(index) = packet;
+    return return_val;
   }
-  buffer_.insert(it, packet);  // Insert the packet at that position.
+  InsertAt(index, packet);
 
   return return_val;
 }
@@ -155,7 +143,7 @@ int PacketBuffer::NextTimestamp(uint32_t* next_timestamp) const {
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  *next_timestamp = buffer_.front()->header.timestamp;
+  *next_timestamp = PacketAt(0)->header.timestamp;
   return kOK;
 }
 
@@ -167,11 +155,11 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if ((*it)->header.timestamp >= timestamp) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet* packet = PacketAt(i);
+    if (packet->header.timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = (*it)->header.timestamp;
+      *next_timestamp = packet->header.timestamp;
       return kOK;
     }
   }
@@ -182,7 +170,7 @@ const RTPHeader* PacketBuffer::NextRtpHeader() const {
   if (Empty()) {
     return NULL;
   }
-  return const_cast<const RTPHeader*>(&(buffer_.front()->header));
+  return &PacketAt(0)->header;
 }
 
 Packet* PacketBuffer::GetNextPacket(size_t* discard_count) {
@@ -191,17 +179,16 @@ Packet* PacketBuffer::GetNextPacket(size_t* discard_count) {
     return NULL;
   }
 
-  Packet* packet = buffer_.front();
+  Packet* packet = PopFront();
   // Assert that the packet sanity checks in InsertPacket method works.
   assert(packet && packet->payload);
-  buffer_.pop_front();
 
   // Discard other packets with the same timestamp. These are duplicates or
   // redundant payloads that should not be used.
   size_t discards = 0;
 
   while (!Empty() &&
-      buffer_.front()->header.timestamp == packet->header.timestamp) {
+      PacketAt(0)->header.timestamp == packet->header.timestamp) {
     if (DiscardNextPacket() != kOK) {
       assert(false);  // Must be ok by design.
     }
@@ -221,16 +208,16 @@ int PacketBuffer::DiscardNextPacket() {
     return kBufferEmpty;
   }
   // Assert that the packet sanity checks in InsertPacket method works.
-  assert(buffer_.front());
-  assert(buffer_.front()->payload);
-  DeleteFirstPacket(&buffer_);
+  assert(PacketAt(0));
+  assert(PacketAt(0)->payload);
+  delete PopFront();
   return kOK;
 }
 
 int PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                     uint32_t horizon_samples) {
-  while (!Empty() && timestamp_limit != buffer_.front()->header.timestamp &&
-         IsObsoleteTimestamp(buffer_.front()->header.timestamp,
+  while (!Empty() && timestamp_limit != PacketAt(0)->header.timestamp &&
+         IsObsoleteTimestamp(PacketAt(0)->header.timestamp,
                              timestamp_limit,
                              horizon_samples)) {
     if (DiscardNextPacket() != kOK) {
@@ -245,16 +232,15 @@ int PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit) {
 }
 
 size_t PacketBuffer::NumPacketsInBuffer() const {
-  return buffer_.size();
+  return size_;
 }
 
 size_t PacketBuffer::NumSamplesInBuffer(DecoderDatabase* decoder_database,
                                         size_t last_decoded_length) const {
-  PacketList::const_iterator it;
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    Packet* packet = (*it);
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet* packet = PacketAt(i);
     AudioDecoder* decoder =
         decoder_database->GetDecoder(packet->header.payloadType);
     if (decoder && !packet->sync_packet) {
@@ -276,9 +262,7 @@ bool PacketBuffer::DeleteFirstPacket(PacketList* packet_list) {
   if (packet_list->empty()) {
     return false;
   }
-  Packet* first_packet = packet_list->front();
-  delete [] first_packet->payload;
-  delete first_packet;
+  delete packet_list->front();
   packet_list->pop_front();
   return true;
 }
@@ -290,8 +274,51 @@ void PacketBuffer::DeleteAllPackets(PacketList* packet_list) {
 }
 
 void PacketBuffer::BufferStat(int* num_packets, int* max_num_packets) const {
-  *num_packets = static_cast<int>(buffer_.size());
+  *num_packets = static_cast<int>(size_);
   *max_num_packets = static_cast<int>(max_number_of_packets_);
 }
 
+size_t PacketBuffer::InsertionIndex(const Packet& packet) const {
+  // The new packet goes after all packets that it is not earlier than. Most
+  // packets arrive in order, so check the back of the buffer first.
+  if (size_ == 0 || packet >= *PacketAt(size_ - 1))
+    return size_;
+  size_t low = 0;
+  size_t high = size_ - 1;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (packet >= *PacketAt(middle)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+void PacketBuffer::InsertAt(size_t index, Packet* packet) {
+  assert(size_ < capacity_);
+  assert(index <= size_);
+  if (index < size_ / 2) {
+    // Move the packets before |index| one step towards the front.
+    first_ = first_ == 0 ? capacity_ - 1 : first_ - 1;
+    for (size_t i = 0; i < index; ++i)
+      PacketAt(i) = PacketAt(i + 1);
+  } else {
+    // Move the packets from |index| one step towards the back.
+    for (size_t i = size_; i > index; --i)
+      PacketAt(i) = PacketAt(i - 1);
+  }
+  PacketAt(index) = packet;
+  ++size_;
+}
+
+Packet* PacketBuffer::PopFront() {
+  assert(size_ > 0);
+  Packet* packet = PacketAt(0);
+  first_ = Slot(1);
+  --size_;
+  return packet;
+}
+
 }  // namespace webrtc
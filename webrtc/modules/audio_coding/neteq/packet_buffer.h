@@ -11,6 +11,8 @@
 #ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <memory>
+
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/modules/audio_coding/neteq/packet.h"
 #include "webrtc/typedefs.h"
@@ -142,8 +144,30 @@ class PacketBuffer {
   }
 
  private:
+  // Returns the slot that holds the packet at |index|, counting from the
+  // front of the buffer.
+  size_t Slot(size_t index) const {
+    const size_t slot = first_ + index;
+    return slot < capacity_ ? slot : slot - capacity_;
+  }
+  Packet*& PacketAt(size_t index) { return slots_[Slot(index)]; }
+  Packet* PacketAt(size_t index) const { return slots_[Slot(index)]; }
+  // Returns the index of the first packet that |packet| goes before.
+  size_t InsertionIndex(const Packet& packet) const;
+  // Inserts |packet| at |index|, moving the packets on the shorter side of
+  // |index| one step out.
+  void InsertAt(size_t index, Packet* packet);
+  // Removes the first packet from the buffer, without deleting it.
+  Packet* PopFront();
+
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  // The packets, sorted so that the next packet to decode is at the front, in
+  // a ring buffer with room for all of them. The buffer is flushed before it
+  // would exceed |max_number_of_packets_|, so it is never reallocated.
+  const size_t capacity_;
+  std::unique_ptr<Packet*[]> slots_;
+  size_t first_;
+  size_t size_;
   const TickTimer* tick_timer_;
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
@@ -59,9 +59,8 @@ Packet* PacketGenerator::NextPacket(int payload_size_bytes) {
   packet->header.ssrc = 0x12345678;
   packet->header.numCSRCs = 0;
   packet->header.paddingLength = 0;
-  packet->payload_length = payload_size_bytes;
   packet->primary = true;
-  packet->payload = new uint8_t[payload_size_bytes];
+  packet->AllocatePayload(payload_size_bytes);
   ++seq_no_;
   ts_ += frame_size_;
   return packet;
@@ -290,7 +289,6 @@ TEST(PacketBuffer, ExtractOrderRedundancy) {
     Packet* packet = buffer.GetNextPacket(&drop_count);
     EXPECT_EQ(0u, drop_count);
     EXPECT_EQ(packet, expect_order[i]);  // Compare pointer addresses.
-    delete[] packet->payload;
     delete packet;
   }
   EXPECT_TRUE(buffer.Empty());
@@ -369,7 +367,6 @@ TEST(PacketBuffer, Reordering) {
     ASSERT_FALSE(packet == NULL);
     EXPECT_EQ(current_ts, packet->header.timestamp);
     current_ts += ts_increment;
-    delete [] packet->payload;
     delete packet;
   }
   EXPECT_TRUE(buffer.Empty());
@@ -377,6 +374,51 @@ TEST(PacketBuffer, Reordering) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+// Keeps a small buffer about half full while packets arrive out of order, so
+// that insertions land on both sides of the middle and the packets wrap around
+// the end of the buffer's storage many times.
+TEST(PacketBuffer, ReorderingWhileStreaming) {
+  TickTimer tick_timer;
+  const size_t kMaxPackets = 8;
+  PacketBuffer buffer(kMaxPackets, &tick_timer);
+  const uint32_t start_ts = 0xFFFFFF00;  // Wrap the timestamps too.
+  const uint32_t ts_increment = 10;
+  PacketGenerator gen(0xFFF0, start_ts, 0, ts_increment);
+  const int payload_len = 10;
+  const int kNumPackets = 200;
+
+  // Insert the packets in groups of four in the order 2, 0, 3, 1, and extract
+  // four packets after each group once the buffer is half full.
+  std::vector<Packet*> group;
+  uint32_t next_ts = start_ts;
+  for (int i = 0; i < kNumPackets; ++i) {
+    group.push_back(gen.NextPacket(payload_len));
+    if (group.size() < 4)
+      continue;
+    const int kOrder[] = {2, 0, 3, 1};
+    for (int index : kOrder)
+      EXPECT_EQ(PacketBuffer::kOK, buffer.InsertPacket(group[index]));
+    group.clear();
+    if (buffer.NumPacketsInBuffer() < kMaxPackets / 2)
+      continue;
+    for (int j = 0; j < 4; ++j) {
+      Packet* packet = buffer.GetNextPacket(NULL);
+      ASSERT_FALSE(packet == NULL);
+      EXPECT_EQ(next_ts, packet->header.timestamp);
+      next_ts += ts_increment;
+      delete packet;
+    }
+  }
+  // Drain the rest.
+  while (!buffer.Empty()) {
+    Packet* packet = buffer.GetNextPacket(NULL);
+    EXPECT_EQ(next_ts, packet->header.timestamp);
+    next_ts += ts_increment;
+    delete packet;
+  }
+  EXPECT_EQ(start_ts + kNumPackets * ts_increment, next_ts);
+}
+
 TEST(PacketBuffer, Failures) {
   const uint16_t start_seq_no = 17;
   const uint32_t start_ts = 4711;
@@ -389,7 +431,6 @@ TEST(PacketBuffer, Failures) {
   Packet* packet = NULL;
   EXPECT_EQ(PacketBuffer::kInvalidPacket, buffer->InsertPacket(packet));
   packet = gen.NextPacket(payload_len);
-  delete [] packet->payload;
   packet->payload = NULL;
   EXPECT_EQ(PacketBuffer::kInvalidPacket, buffer->InsertPacket(packet));
   // Packet is deleted by the PacketBuffer.
@@ -419,7 +460,6 @@ TEST(PacketBuffer, Failures) {
   PacketList list;
   list.push_back(gen.NextPacket(payload_len));  // Valid packet.
   packet = gen.NextPacket(payload_len);
-  delete [] packet->payload;
   packet->payload = NULL;  // Invalid.
   list.push_back(packet);
   list.push_back(gen.NextPacket(payload_len));  // Valid packet.
@@ -500,9 +540,7 @@ TEST(PacketBuffer, ComparePackets) {
   EXPECT_FALSE(*a <= *b);
   EXPECT_TRUE(*a >= *b);
 
-  delete [] a->payload;
   delete a;
-  delete [] b->payload;
   delete b;
 }
 
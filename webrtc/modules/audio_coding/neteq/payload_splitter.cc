@@ -80,7 +80,8 @@ int PayloadSplitter::SplitRed(PacketList* packet_list) {
       new_packets.push_back(new_packet);
     }
 
-    // Populate the new packets with payload data.
+    // Let the new packets point to their blocks of the RED payload, which they
+    // share rather than copy.
     // |payload_ptr| now points at the first payload byte.
     PacketList::iterator new_it;
     for (new_it = new_packets.begin(); new_it != new_packets.end(); ++new_it) {
@@ -92,7 +93,7 @@ int PayloadSplitter::SplitRed(PacketList* packet_list) {
         // payloads from this packet.
         LOG(LS_WARNING) << "SplitRed length mismatch";
         while (new_it != new_packets.end()) {
-          // Payload should not have been allocated yet.
+          // Payload should not have been assigned yet.
           assert(!(*new_it)->payload);
           delete (*new_it);
           new_it = new_packets.erase(new_it);
@@ -100,8 +101,8 @@ int PayloadSplitter::SplitRed(PacketList* packet_list) {
         ret = kRedLengthMismatch;
         break;
       }
-      (*new_it)->payload = new uint8_t[payload_length];
-      memcpy((*new_it)->payload, payload_ptr, payload_length);
+      (*new_it)->SharePayload(
+          *red_packet, payload_ptr - red_packet->payload, payload_length);
       payload_ptr += payload_length;
     }
     // Reverse the order of the new packets, so that the primary payload is
@@ -111,8 +112,7 @@ int PayloadSplitter::SplitRed(PacketList* packet_list) {
     // iterator |it|.
     packet_list->splice(it, new_packets, new_packets.begin(),
                         new_packets.end());
-    // Delete old packet payload.
-    delete [] (*it)->payload;
+    // Delete the old packet. Its payload lives on in the new packets.
     delete (*it);
     // Remove |it| from the packet list. This operation effectively moves the
     // iterator |it| to the next packet in the list. Thus, we do not have to
@@ -165,9 +165,9 @@ int PayloadSplitter::SplitFec(PacketList* packet_list,
         int duration = decoder->
             PacketDurationRedundant(packet->payload, packet->payload_length);
         new_packet->header.timestamp -= duration;
-        new_packet->payload = new uint8_t[packet->payload_length];
-        memcpy(new_packet->payload, packet->payload, packet->payload_length);
-        new_packet->payload_length = packet->payload_length;
+        // The FEC data is only extracted from the payload if the redundant
+        // packet is decoded, so both packets share the same payload.
+        new_packet->SharePayload(*packet, 0, packet->payload_length);
         new_packet->primary = false;
         new_packet->sync_packet = packet->sync_packet;
         // Waiting time should not be set here.
@@ -203,7 +203,6 @@ int PayloadSplitter::CheckRedPayloads(PacketList* packet_list,
         if (this_payload_type != main_payload_type) {
           // We do not allow redundant payloads of a different type.
           // Discard this payload.
-          delete [] (*it)->payload;
           delete (*it);
           // Remove |it| from the packet list. This operation effectively
           // moves the iterator |it| to the next packet in the list. Thus, we
@@ -347,8 +346,7 @@ int PayloadSplitter::SplitAudio(PacketList* packet_list,
     // iterator |it|.
     packet_list->splice(it, new_packets, new_packets.begin(),
                         new_packets.end());
-    // Delete old packet payload.
-    delete [] (*it)->payload;
+    // Delete the old packet. Its payload lives on in the new packets.
     delete (*it);
     // Remove |it| from the packet list. This operation effectively moves the
     // iterator |it| to the next packet in the list. Thus, we do not have to
@@ -379,30 +377,26 @@ void PayloadSplitter::SplitBySamples(const Packet* packet,
       split_size_bytes * timestamps_per_ms / bytes_per_ms);
   uint32_t timestamp = packet->header.timestamp;
 
-  uint8_t* payload_ptr = packet->payload;
+  size_t offset = 0;
   size_t len = packet->payload_length;
   while (len >= (2 * split_size_bytes)) {
     Packet* new_packet = new Packet;
-    new_packet->payload_length = split_size_bytes;
     new_packet->header = packet->header;
     new_packet->header.timestamp = timestamp;
     timestamp += timestamps_per_chunk;
     new_packet->primary = packet->primary;
-    new_packet->payload = new uint8_t[split_size_bytes];
-    memcpy(new_packet->payload, payload_ptr, split_size_bytes);
-    payload_ptr += split_size_bytes;
+    new_packet->SharePayload(*packet, offset, split_size_bytes);
+    offset += split_size_bytes;
     new_packets->push_back(new_packet);
     len -= split_size_bytes;
   }
 
   if (len > 0) {
     Packet* new_packet = new Packet;
-    new_packet->payload_length = len;
     new_packet->header = packet->header;
     new_packet->header.timestamp = timestamp;
     new_packet->primary = packet->primary;
-    new_packet->payload = new uint8_t[len];
-    memcpy(new_packet->payload, payload_ptr, len);
+    new_packet->SharePayload(*packet, offset, len);
     new_packets->push_back(new_packet);
   }
 }
@@ -422,19 +416,17 @@ int PayloadSplitter::SplitByFrames(const Packet* packet,
   }
 
   uint32_t timestamp = packet->header.timestamp;
-  uint8_t* payload_ptr = packet->payload;
+  size_t offset = 0;
   size_t len = packet->payload_length;
   while (len > 0) {
     assert(len >= bytes_per_frame);
     Packet* new_packet = new Packet;
-    new_packet->payload_length = bytes_per_frame;
     new_packet->header = packet->header;
     new_packet->header.timestamp = timestamp;
     timestamp += timestamps_per_frame;
     new_packet->primary = packet->primary;
-    new_packet->payload = new uint8_t[bytes_per_frame];
-    memcpy(new_packet->payload, payload_ptr, bytes_per_frame);
-    payload_ptr += bytes_per_frame;
+    new_packet->SharePayload(*packet, offset, bytes_per_frame);
+    offset += bytes_per_frame;
     new_packets->push_back(new_packet);
     len -= bytes_per_frame;
   }
@@ -82,10 +82,9 @@ Packet* CreateRedPayload(size_t num_payloads,
   packet->header.payloadType = kRedPayloadType;
   packet->header.timestamp = kBaseTimestamp;
   packet->header.sequenceNumber = kSequenceNumber;
-  packet->payload_length = (kPayloadLength + 1) +
-      (num_payloads - 1) * (kPayloadLength + kRedHeaderLength);
-  uint8_t* payload = new uint8_t[packet->payload_length];
-  uint8_t* payload_ptr = payload;
+  uint8_t* payload_ptr = packet->AllocatePayload(
+      (kPayloadLength + 1) +
+      (num_payloads - 1) * (kPayloadLength + kRedHeaderLength));
   for (size_t i = 0; i < num_payloads; ++i) {
     // Write the RED headers.
     if (i == num_payloads - 1) {
@@ -117,7 +116,6 @@ Packet* CreateRedPayload(size_t num_payloads,
     }
     payload_ptr += kPayloadLength;
   }
-  packet->payload = payload;
   return packet;
 }
 
@@ -128,12 +126,9 @@ Packet* CreatePacket(uint8_t payload_type, size_t payload_length,
   packet->header.payloadType = payload_type;
   packet->header.timestamp = kBaseTimestamp;
   packet->header.sequenceNumber = kSequenceNumber;
-  packet->payload_length = payload_length;
-  uint8_t* payload = new uint8_t[packet->payload_length];
-  packet->payload = payload;
+  uint8_t* payload = packet->AllocatePayload(payload_length);
   if (opus_fec) {
-    CreateOpusFecPayload(packet->payload, packet->payload_length,
-                         payload_value);
+    CreateOpusFecPayload(payload, payload_length, payload_value);
   } else {
     memset(payload, payload_value, payload_length);
   }
@@ -180,14 +175,41 @@ TEST(RedPayloadSplitter, OnePacketTwoPayloads) {
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[1], kSequenceNumber,
                kBaseTimestamp, 1, true);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
   // Check second packet.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber,
                kBaseTimestamp - kTimestampOffset, 0, false);
-  delete [] packet->payload;
+  delete packet;
+}
+
+// The split packets point into the payload of the RED packet, which stays
+// valid after the RED packet itself has been deleted.
+TEST(RedPayloadSplitter, SplitPacketsShareThePayload) {
+  uint8_t payload_types[] = {0, 0};
+  const int kTimestampOffset = 160;
+  Packet* packet = CreateRedPayload(2, payload_types, kTimestampOffset);
+  const uint8_t* red_payload = packet->payload;
+  const size_t red_payload_length = packet->payload_length;
+  PacketList packet_list;
+  packet_list.push_back(packet);
+  PayloadSplitter splitter;
+  EXPECT_EQ(PayloadSplitter::kOK, splitter.SplitRed(&packet_list));
+  ASSERT_EQ(2u, packet_list.size());
+  // Primary payload, after the redundant one.
+  packet = packet_list.front();
+  EXPECT_EQ(red_payload + red_payload_length - kPayloadLength,
+            packet->payload);
+  VerifyPacket(packet, kPayloadLength, payload_types[1], kSequenceNumber,
+               kBaseTimestamp, 1, true);
+  delete packet;
+  packet_list.pop_front();
+  // Redundant payload, after the two RED headers.
+  packet = packet_list.front();
+  EXPECT_EQ(red_payload + kRedHeaderLength + 1, packet->payload);
+  VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber,
+               kBaseTimestamp - kTimestampOffset, 0, false);
   delete packet;
 }
 
@@ -213,14 +235,12 @@ TEST(RedPayloadSplitter, TwoPacketsOnePayload) {
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber,
                kBaseTimestamp, 0, true);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
   // Check second packet.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber + 1,
                kBaseTimestamp + kTimestampOffset, 0, true);
-  delete [] packet->payload;
   delete packet;
 }
 
@@ -253,42 +273,36 @@ TEST(RedPayloadSplitter, TwoPacketsThreePayloads) {
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[2], kSequenceNumber,
                kBaseTimestamp, 2, true);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
   // Check second packet, A2.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[1], kSequenceNumber,
                kBaseTimestamp - kTimestampOffset, 1, false);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
   // Check third packet, A3.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber,
                kBaseTimestamp - 2 * kTimestampOffset, 0, false);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
   // Check fourth packet, B1.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[2], kSequenceNumber + 1,
                kBaseTimestamp + kTimestampOffset, 2, true);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
   // Check fifth packet, B2.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[1], kSequenceNumber + 1,
                kBaseTimestamp, 1, false);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
   // Check sixth packet, B3.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber + 1,
                kBaseTimestamp - kTimestampOffset, 0, false);
-  delete [] packet->payload;
   delete packet;
 }
 
@@ -327,7 +341,6 @@ TEST(RedPayloadSplitter, CheckRedPayloads) {
   for (int i = 0; i <= 2; ++i) {
     Packet* packet = packet_list.front();
     VerifyPacket(packet, 10, i, kSequenceNumber, kBaseTimestamp, 0, true);
-    delete [] packet->payload;
     delete packet;
     packet_list.pop_front();
   }
@@ -354,7 +367,6 @@ TEST(RedPayloadSplitter, WrongPayloadLength) {
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber,
                kBaseTimestamp - 2 * kTimestampOffset, 0, false);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
 }
@@ -416,7 +428,6 @@ TEST(AudioPayloadSplitter, NonSplittable) {
     VerifyPacket((*it), kPayloadLength, payload_type, kSequenceNumber,
                  kBaseTimestamp, 10 * payload_type);
     ++payload_type;
-    delete [] (*it)->payload;
     delete (*it);
     it = packet_list.erase(it);
   }
@@ -447,7 +458,6 @@ TEST(AudioPayloadSplitter, UnknownPayloadType) {
   // Delete the packets and payloads to avoid having the test leak memory.
   PacketList::iterator it = packet_list.begin();
   while (it != packet_list.end()) {
-    delete [] (*it)->payload;
     delete (*it);
     it = packet_list.erase(it);
   }
@@ -567,7 +577,6 @@ TEST_P(SplitBySamplesTest, PayloadSizes) {
         expected_timestamp_offset_ms[i] * samples_per_ms_;
     VerifyPacket((*it), length_bytes, kPayloadType, kSequenceNumber,
                  expected_timestamp, expected_payload_value[i]);
-    delete [] (*it)->payload;
     delete (*it);
     it = packet_list.erase(it);
     ++i;
@@ -651,7 +660,6 @@ TEST_P(SplitIlbcTest, NumFrames) {
       EXPECT_EQ(payload_value, packet->payload[i]);
       ++payload_value;
     }
-    delete [] (*it)->payload;
     delete (*it);
     it = packet_list.erase(it);
     ++frame_num;
@@ -703,7 +711,6 @@ TEST(IlbcPayloadSplitter, TooLargePayload) {
   // Delete the packets and payloads to avoid having the test leak memory.
   PacketList::iterator it = packet_list.begin();
   while (it != packet_list.end()) {
-    delete [] (*it)->payload;
     delete (*it);
     it = packet_list.erase(it);
   }
@@ -735,7 +742,6 @@ TEST(IlbcPayloadSplitter, UnevenPayload) {
   // Delete the packets and payloads to avoid having the test leak memory.
   PacketList::iterator it = packet_list.begin();
   while (it != packet_list.end()) {
-    delete [] (*it)->payload;
     delete (*it);
     it = packet_list.erase(it);
   }
@@ -771,7 +777,6 @@ TEST(FecPayloadSplitter, MixedPayload) {
   EXPECT_EQ(kBaseTimestamp - 20 * 48, packet->header.timestamp);
   EXPECT_EQ(10U, packet->payload_length);
   EXPECT_FALSE(packet->primary);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
 
@@ -781,21 +786,18 @@ TEST(FecPayloadSplitter, MixedPayload) {
   EXPECT_EQ(kBaseTimestamp, packet->header.timestamp);
   EXPECT_EQ(10U, packet->payload_length);
   EXPECT_TRUE(packet->primary);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
 
   // Check third packet.
   packet = packet_list.front();
   VerifyPacket(packet, 10, 0, kSequenceNumber, kBaseTimestamp, 0, true);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
 
   // Check fourth packet.
   packet = packet_list.front();
   VerifyPacket(packet, 10, 1, kSequenceNumber, kBaseTimestamp, 0, true);
-  delete [] packet->payload;
   delete packet;
 }
 
@@ -824,7 +826,6 @@ TEST(FecPayloadSplitter, EmbedFecInRed) {
   EXPECT_EQ(kPayloadLength, packet->payload_length);
   EXPECT_FALSE(packet->primary);
   EXPECT_EQ(packet->payload[3], 1);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
 
@@ -835,7 +836,6 @@ TEST(FecPayloadSplitter, EmbedFecInRed) {
   EXPECT_EQ(kPayloadLength, packet->payload_length);
   EXPECT_TRUE(packet->primary);
   EXPECT_EQ(packet->payload[3], 1);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
 
@@ -846,7 +846,6 @@ TEST(FecPayloadSplitter, EmbedFecInRed) {
   EXPECT_EQ(kPayloadLength, packet->payload_length);
   EXPECT_FALSE(packet->primary);
   EXPECT_EQ(packet->payload[3], 0);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
 
@@ -857,7 +856,6 @@ TEST(FecPayloadSplitter, EmbedFecInRed) {
   EXPECT_EQ(kPayloadLength, packet->payload_length);
   EXPECT_TRUE(packet->primary);
   EXPECT_EQ(packet->payload[3], 0);
-  delete [] packet->payload;
   delete packet;
   packet_list.pop_front();
 }
@@ -21,8 +21,16 @@ size_t SyncBuffer::FutureLength() const {
 
 void SyncBuffer::PushBack(const AudioMultiVector& append_this) {
   size_t samples_added = append_this.Size();
-  AudioMultiVector::PushBack(append_this);
-  AudioMultiVector::PopFront(samples_added);
+  // Remove the samples that are pushed out before appending, so that the
+  // buffer never holds more than its constant size and does not have to grow
+  // its capacity. If |append_this| is longer than the buffer, only its last
+  // samples are kept.
+  const size_t samples_to_remove = std::min(samples_added, Size());
+  if (samples_to_remove > 0) {
+    AudioMultiVector::PopFront(samples_to_remove);
+    AudioMultiVector::PushBackFromIndex(append_this,
+                                        samples_added - samples_to_remove);
+  }
   if (samples_added <= next_index_) {
     next_index_ -= samples_added;
   } else {
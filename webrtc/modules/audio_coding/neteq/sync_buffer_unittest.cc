@@ -87,6 +87,41 @@ TEST(SyncBuffer, PushBackAndFlush) {
   }
 }
 
+TEST(SyncBuffer, PushBackKeepsCapacity) {
+  static const size_t kLen = 100;
+  static const size_t kChannels = 2;
+  SyncBuffer sync_buffer(kChannels, kLen);
+  const size_t capacity = sync_buffer[0].Capacity();
+  AudioMultiVector new_data(kChannels, 10);
+  for (int i = 0; i < 20; ++i)
+    sync_buffer.PushBack(new_data);
+  // The buffer has a constant size, so it should never have to reallocate.
+  for (size_t channel = 0; channel < kChannels; ++channel)
+    EXPECT_EQ(capacity, sync_buffer[channel].Capacity());
+}
+
+TEST(SyncBuffer, PushBackLongerThanBuffer) {
+  static const size_t kLen = 10;
+  static const size_t kChannels = 2;
+  SyncBuffer sync_buffer(kChannels, kLen);
+  static const size_t kNewLen = 25;
+  AudioMultiVector new_data(kChannels, kNewLen);
+  for (size_t channel = 0; channel < kChannels; ++channel) {
+    for (size_t i = 0; i < kNewLen; ++i) {
+      new_data[channel][i] = i;
+    }
+  }
+  // Only the last |kLen| samples of |new_data| fit in the buffer.
+  sync_buffer.PushBack(new_data);
+  ASSERT_EQ(kLen, sync_buffer.Size());
+  EXPECT_EQ(0u, sync_buffer.next_index());
+  for (size_t channel = 0; channel < kChannels; ++channel) {
+    for (size_t i = 0; i < kLen; ++i) {
+      EXPECT_EQ(new_data[channel][kNewLen - kLen + i], sync_buffer[channel][i]);
+    }
+  }
+}
+
 TEST(SyncBuffer, PushFrontZeros) {
   // Create a SyncBuffer with two channels and 100 samples each.
   static const size_t kLen = 100;
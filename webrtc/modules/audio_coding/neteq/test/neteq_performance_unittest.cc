@@ -8,7 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string>
+#include <vector>
+
 #include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/modules/audio_coding/neteq/tools/neteq_codec_performance_test.h"
+#include "webrtc/modules/audio_coding/neteq/tools/neteq_operations_performance_test.h"
 #include "webrtc/modules/audio_coding/neteq/tools/neteq_performance_test.h"
 #include "webrtc/test/testsupport/perf_test.h"
 #include "webrtc/typedefs.h"
@@ -39,3 +45,102 @@ TEST(NetEqPerformanceTest, RunClean) {
   webrtc::test::PrintResult(
       "neteq_performance", "", "0_pl_0_drift", runtime, "ms", true);
 }
+
+namespace {
+void RunOperation(webrtc::test::NetEqOperationsPerformanceTest::Operation
+                      operation,
+                  const std::string& name) {
+  const int kSampleRatesHz[] = {8000, 16000, 32000, 48000};
+  const int kNumIterations = 2000;
+  for (int sample_rate_hz : kSampleRatesHz) {
+    int64_t runtime_ns = webrtc::test::NetEqOperationsPerformanceTest::Run(
+        operation, sample_rate_hz, kNumIterations);
+    ASSERT_GT(runtime_ns, 0);
+    webrtc::test::PrintResult(
+        "neteq_operation_" + name, "",
+        rtc::ToString(sample_rate_hz / 1000) + "_khz", runtime_ns, "ns", true);
+  }
+}
+}  // namespace
+
+// Measures each signal processing operation of NetEq on its own, to track the
+// cost of the correlation kernels that they share.
+TEST(NetEqPerformanceTest, Accelerate) {
+  RunOperation(webrtc::test::NetEqOperationsPerformanceTest::kAccelerate,
+               "accelerate");
+}
+
+TEST(NetEqPerformanceTest, PreemptiveExpand) {
+  RunOperation(webrtc::test::NetEqOperationsPerformanceTest::kPreemptiveExpand,
+               "preemptive_expand");
+}
+
+TEST(NetEqPerformanceTest, Expand) {
+  RunOperation(webrtc::test::NetEqOperationsPerformanceTest::kExpand,
+               "expand");
+}
+
+TEST(NetEqPerformanceTest, Merge) {
+  RunOperation(webrtc::test::NetEqOperationsPerformanceTest::kMerge, "merge");
+}
+
+namespace {
+// Runs |scenario| with each codec and returns the statistics of the runs, in
+// the order of the codecs.
+std::vector<webrtc::NetEqNetworkStatistics> RunCodecScenario(
+    webrtc::test::NetEqCodecPerformanceTest::Scenario scenario,
+    const std::string& name) {
+  using webrtc::test::NetEqCodecPerformanceTest;
+  const struct {
+    NetEqCodecPerformanceTest::Codec codec;
+    const char* name;
+  } kCodecs[] = {{NetEqCodecPerformanceTest::kPcm16b, "pcm16b"},
+                 {NetEqCodecPerformanceTest::kG722, "g722"},
+                 {NetEqCodecPerformanceTest::kIsac, "isac"},
+                 {NetEqCodecPerformanceTest::kOpus, "opus"}};
+  const int kSimulationTimeMs = 20000;
+  const int kNumRepetitions = 3;
+  std::vector<webrtc::NetEqNetworkStatistics> stats;
+  for (const auto& codec : kCodecs) {
+    NetEqCodecPerformanceTest::Result result = NetEqCodecPerformanceTest::Run(
+        codec.codec, scenario, kSimulationTimeMs, kNumRepetitions);
+    EXPECT_GT(result.ns_per_block, 0);
+    webrtc::test::PrintResult("neteq_codec_" + name, "",
+                              std::string(codec.name) + "_per_10ms",
+                              result.ns_per_block, "ns", true);
+    webrtc::test::PrintResult("neteq_codec_" + name, "",
+                              std::string(codec.name) + "_per_sample",
+                              rtc::ToString(result.ns_per_sample), "ns", true);
+    stats.push_back(result.stats);
+  }
+  return stats;
+}
+}  // namespace
+
+// Measures NetEq with real codecs, in one scenario per code path, to catch
+// regressions in each of them.
+TEST(NetEqCodecPerformanceTest, Decode) {
+  RunCodecScenario(webrtc::test::NetEqCodecPerformanceTest::kDecode, "decode");
+}
+
+TEST(NetEqCodecPerformanceTest, Expand) {
+  for (const auto& stats : RunCodecScenario(
+           webrtc::test::NetEqCodecPerformanceTest::kExpand, "expand"))
+    EXPECT_GT(stats.expand_rate, 0);
+}
+
+TEST(NetEqCodecPerformanceTest, Merge) {
+  for (const auto& stats : RunCodecScenario(
+           webrtc::test::NetEqCodecPerformanceTest::kMerge, "merge"))
+    EXPECT_GT(stats.expand_rate, 0);
+}
+
+TEST(NetEqCodecPerformanceTest, Accelerate) {
+  for (const auto& stats : RunCodecScenario(
+           webrtc::test::NetEqCodecPerformanceTest::kAccelerate, "accelerate"))
+    EXPECT_GT(stats.accelerate_rate, 0);
+}
+
+TEST(NetEqCodecPerformanceTest, Cng) {
+  RunCodecScenario(webrtc::test::NetEqCodecPerformanceTest::kCng, "cng");
+}
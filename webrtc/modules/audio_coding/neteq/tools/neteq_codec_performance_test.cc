@@ -0,0 +1,261 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/tools/neteq_codec_performance_test.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "webrtc/base/buffer.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/audio_coding/codecs/builtin_audio_decoder_factory.h"
+#include "webrtc/modules/audio_coding/codecs/cng/audio_encoder_cng.h"
+#include "webrtc/modules/audio_coding/codecs/g722/audio_encoder_g722.h"
+#include "webrtc/modules/audio_coding/codecs/isac/main/include/audio_encoder_isac.h"
+#include "webrtc/modules/audio_coding/codecs/opus/audio_encoder_opus.h"
+#include "webrtc/modules/audio_coding/codecs/pcm16b/audio_encoder_pcm16b.h"
+#include "webrtc/modules/audio_coding/neteq/tools/resample_input_audio_file.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/test/testsupport/fileutils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+const int kBlockSizeMs = 10;
+const uint32_t kSsrc = 0x12345678;
+// In the kExpand scenario, the first |kBurstLength| packets of every
+// |kBurstPeriod| are lost.
+const size_t kBurstLength = 5;
+const size_t kBurstPeriod = 25;
+// In the kMerge scenario, one packet of every |kLossPeriod| is lost.
+const size_t kLossPeriod = 5;
+// In the kAccelerate scenario, packets arrive this much faster than they are
+// played out.
+const double kDriftFactor = 0.05;
+// In the kCng scenario, only the first |kTalkSpurtMs| of every |kTalkPeriodMs|
+// are speech; the rest is silence.
+const int kTalkSpurtMs = 500;
+const int kTalkPeriodMs = 2000;
+
+struct CodecSettings {
+  int sample_rate_hz;
+  NetEqDecoder decoder;
+  const char* name;
+  int payload_type;
+  NetEqDecoder cng_decoder;
+  int cng_payload_type;
+};
+
+CodecSettings GetCodecSettings(NetEqCodecPerformanceTest::Codec codec) {
+  switch (codec) {
+    case NetEqCodecPerformanceTest::kPcm16b:
+      return {32000, NetEqDecoder::kDecoderPCM16Bswb32kHz, "pcm16-swb32", 95,
+              NetEqDecoder::kDecoderCNGswb32kHz, 99};
+    case NetEqCodecPerformanceTest::kG722:
+      return {16000, NetEqDecoder::kDecoderG722, "g722", 9,
+              NetEqDecoder::kDecoderCNGwb, 98};
+    case NetEqCodecPerformanceTest::kIsac:
+      return {16000, NetEqDecoder::kDecoderISAC, "isac", 103,
+              NetEqDecoder::kDecoderCNGwb, 98};
+    case NetEqCodecPerformanceTest::kOpus:
+      return {48000, NetEqDecoder::kDecoderOpus, "opus", 111,
+              NetEqDecoder::kDecoderCNGswb48kHz, 100};
+  }
+  RTC_NOTREACHED();
+  return {};
+}
+
+// Creates the encoder of |codec|. With |dtx|, Opus uses its internal DTX and
+// the other codecs are wrapped in an RFC 3389 comfort noise encoder.
+std::unique_ptr<AudioEncoder> CreateEncoder(
+    NetEqCodecPerformanceTest::Codec codec,
+    const CodecSettings& settings,
+    bool dtx) {
+  std::unique_ptr<AudioEncoder> encoder;
+  switch (codec) {
+    case NetEqCodecPerformanceTest::kPcm16b: {
+      AudioEncoderPcm16B::Config config;
+      config.sample_rate_hz = settings.sample_rate_hz;
+      config.payload_type = settings.payload_type;
+      encoder.reset(new AudioEncoderPcm16B(config));
+      break;
+    }
+    case NetEqCodecPerformanceTest::kG722: {
+      AudioEncoderG722::Config config;
+      config.payload_type = settings.payload_type;
+      encoder.reset(new AudioEncoderG722(config));
+      break;
+    }
+    case NetEqCodecPerformanceTest::kIsac: {
+      AudioEncoderIsac::Config config;
+      config.payload_type = settings.payload_type;
+      config.sample_rate_hz = settings.sample_rate_hz;
+      encoder.reset(new AudioEncoderIsac(config));
+      break;
+    }
+    case NetEqCodecPerformanceTest::kOpus: {
+      AudioEncoderOpus::Config config;
+      config.payload_type = settings.payload_type;
+      config.dtx_enabled = dtx;
+      return std::unique_ptr<AudioEncoder>(new AudioEncoderOpus(config));
+    }
+  }
+  if (!dtx)
+    return encoder;
+  AudioEncoderCng::Config config;
+  config.payload_type = settings.cng_payload_type;
+  config.speech_encoder = std::move(encoder);
+  return std::unique_ptr<AudioEncoder>(new AudioEncoderCng(std::move(config)));
+}
+
+struct Packet {
+  WebRtcRTPHeader header;
+  rtc::Buffer payload;
+  int64_t arrival_time_ms;
+};
+
+// Returns true if the packet with index |index| in the encoded stream is lost
+// in |scenario|.
+bool IsLost(NetEqCodecPerformanceTest::Scenario scenario, size_t index) {
+  switch (scenario) {
+    case NetEqCodecPerformanceTest::kExpand:
+      return index % kBurstPeriod < kBurstLength;
+    case NetEqCodecPerformanceTest::kMerge:
+      return index % kLossPeriod == kLossPeriod - 1;
+    default:
+      return false;
+  }
+}
+
+// Encodes |runtime_ms| of speech and returns the packets which |scenario|
+// delivers, in order of arrival.
+std::vector<Packet> CreatePackets(NetEqCodecPerformanceTest::Codec codec,
+                                  const CodecSettings& settings,
+                                  NetEqCodecPerformanceTest::Scenario scenario,
+                                  int runtime_ms) {
+  const bool dtx = scenario == NetEqCodecPerformanceTest::kCng;
+  std::unique_ptr<AudioEncoder> encoder =
+      CreateEncoder(codec, settings, dtx);
+  ResampleInputAudioFile input(
+      ResourcePath("audio_coding/testfile32kHz", "pcm"), 32000,
+      settings.sample_rate_hz);
+  const size_t block_length = settings.sample_rate_hz * kBlockSizeMs / 1000;
+  std::vector<int16_t> block(block_length);
+  const uint32_t timestamps_per_block =
+      encoder->RtpTimestampRateHz() * kBlockSizeMs / 1000;
+
+  std::vector<Packet> packets;
+  uint16_t sequence_number = 0;
+  size_t num_encoded_packets = 0;
+  uint32_t rtp_timestamp = 0;
+  for (int time_ms = 0; time_ms < runtime_ms; time_ms += kBlockSizeMs) {
+    RTC_CHECK(input.Read(block_length, block.data()));
+    if (dtx && time_ms % kTalkPeriodMs >= kTalkSpurtMs)
+      std::fill(block.begin(), block.end(), 0);
+    rtc::Buffer payload;
+    const AudioEncoder::EncodedInfo info =
+        encoder->Encode(rtp_timestamp, block, &payload);
+    rtp_timestamp += timestamps_per_block;
+    if (info.encoded_bytes == 0)
+      continue;
+    if (IsLost(scenario, num_encoded_packets++)) {
+      ++sequence_number;
+      continue;
+    }
+    Packet packet;
+    packet.header.header.sequenceNumber = sequence_number++;
+    packet.header.header.timestamp = info.encoded_timestamp;
+    packet.header.header.payloadType = static_cast<uint8_t>(info.payload_type);
+    packet.header.header.markerBit = false;
+    packet.header.header.ssrc = kSsrc;
+    packet.header.header.numCSRCs = 0;
+    packet.header.frameType =
+        info.speech ? kAudioFrameSpeech : kAudioFrameCN;
+    packet.payload = std::move(payload);
+    // The packet is sent when its last block has been encoded.
+    const int64_t send_time_ms = time_ms + kBlockSizeMs;
+    packet.arrival_time_ms =
+        scenario == NetEqCodecPerformanceTest::kAccelerate
+            ? static_cast<int64_t>(send_time_ms * (1.0 - kDriftFactor))
+            : send_time_ms;
+    packets.push_back(std::move(packet));
+  }
+  return packets;
+}
+}  // namespace
+
+NetEqCodecPerformanceTest::Result NetEqCodecPerformanceTest::Run(
+    Codec codec,
+    Scenario scenario,
+    int runtime_ms,
+    int num_repetitions) {
+  RTC_CHECK_GT(runtime_ms, 0);
+  RTC_CHECK_GT(num_repetitions, 0);
+  const CodecSettings settings = GetCodecSettings(codec);
+  const std::vector<Packet> packets =
+      CreatePackets(codec, settings, scenario, runtime_ms);
+  RTC_CHECK(!packets.empty());
+
+  Result result;
+  result.ns_per_block = std::numeric_limits<int64_t>::max();
+  result.ns_per_sample = 0;
+  for (int i = 0; i < num_repetitions; ++i) {
+    NetEq::Config config;
+    config.sample_rate_hz = settings.sample_rate_hz;
+    std::unique_ptr<NetEq> neteq(
+        NetEq::Create(config, CreateBuiltinAudioDecoderFactory()));
+    RTC_CHECK_EQ(NetEq::kOK,
+                 neteq->RegisterPayloadType(settings.decoder, settings.name,
+                                            settings.payload_type));
+    RTC_CHECK_EQ(NetEq::kOK, neteq->RegisterPayloadType(
+                                 settings.cng_decoder, "cng",
+                                 settings.cng_payload_type));
+
+    AudioFrame out_frame;
+    size_t next_packet = 0;
+    int num_blocks = 0;
+    size_t num_samples = 0;
+    const int64_t start_ns = rtc::TimeNanos();
+    for (int time_ms = 0; time_ms < runtime_ms; time_ms += kBlockSizeMs) {
+      for (; next_packet < packets.size() &&
+             packets[next_packet].arrival_time_ms <= time_ms;
+           ++next_packet) {
+        const Packet& packet = packets[next_packet];
+        RTC_CHECK_EQ(NetEq::kOK,
+                     neteq->InsertPacket(
+                         packet.header, packet.payload,
+                         static_cast<uint32_t>(packet.arrival_time_ms *
+                                               settings.sample_rate_hz /
+                                               1000)));
+      }
+      bool muted;
+      RTC_CHECK_EQ(NetEq::kOK, neteq->GetAudio(&out_frame, &muted));
+      RTC_CHECK(!muted);
+      ++num_blocks;
+      num_samples += out_frame.samples_per_channel_ * out_frame.num_channels_;
+    }
+    const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+
+    if (elapsed_ns / num_blocks < result.ns_per_block) {
+      result.ns_per_block = elapsed_ns / num_blocks;
+      result.ns_per_sample = static_cast<double>(elapsed_ns) / num_samples;
+    }
+    if (i == num_repetitions - 1)
+      neteq->NetworkStatistics(&result.stats);
+  }
+  return result;
+}
+
+}  // namespace test
+}  // namespace webrtc
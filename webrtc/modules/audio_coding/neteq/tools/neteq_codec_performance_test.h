@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_CODEC_PERFORMANCE_TEST_H_
+#define WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_CODEC_PERFORMANCE_TEST_H_
+
+#include "webrtc/modules/audio_coding/neteq/include/neteq.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+namespace test {
+
+// Measures NetEq as a whole, decoding packets from a real encoder, in network
+// scenarios which each make one of NetEq's code paths dominate.
+class NetEqCodecPerformanceTest {
+ public:
+  enum Codec {
+    kPcm16b,  // 32 kHz, 20 ms packets.
+    kG722,    // 20 ms packets.
+    kIsac,    // 16 kHz, 30 ms packets.
+    kOpus,    // 20 ms packets.
+  };
+
+  enum Scenario {
+    kDecode,      // Neither losses nor clock drift.
+    kExpand,      // Bursts of lost packets, concealed by long expansions.
+    kMerge,       // Single lost packets, each expanded and merged.
+    kAccelerate,  // A sender clock running fast, compensated by acceleration.
+    kCng,         // Discontinuous transmission with comfort noise.
+  };
+
+  struct Result {
+    // Average NetEq runtime (InsertPacket and GetAudio) per 10 ms of output.
+    int64_t ns_per_block;
+    double ns_per_sample;
+    // Statistics of the whole run, to tell how much the intended code path
+    // was used.
+    NetEqNetworkStatistics stats;
+  };
+
+  // Encodes |runtime_ms| of speech with |codec| and decodes the packets that
+  // |scenario| delivers with NetEq, |num_repetitions| times. Only the decoding
+  // is timed, and the fastest repetition is returned, since it is the least
+  // disturbed by other load on the machine.
+  static Result Run(Codec codec,
+                    Scenario scenario,
+                    int runtime_ms,
+                    int num_repetitions);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_CODEC_PERFORMANCE_TEST_H_
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/tools/neteq_operations_performance_test.h"
+
+#include <math.h>
+
+#include <vector>
+
+#include "webrtc/base/arraysize.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+#include "webrtc/modules/audio_coding/neteq/accelerate.h"
+#include "webrtc/modules/audio_coding/neteq/audio_multi_vector.h"
+#include "webrtc/modules/audio_coding/neteq/background_noise.h"
+#include "webrtc/modules/audio_coding/neteq/expand.h"
+#include "webrtc/modules/audio_coding/neteq/merge.h"
+#include "webrtc/modules/audio_coding/neteq/preemptive_expand.h"
+#include "webrtc/modules/audio_coding/neteq/random_vector.h"
+#include "webrtc/modules/audio_coding/neteq/statistics_calculator.h"
+#include "webrtc/modules/audio_coding/neteq/sync_buffer.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+const size_t kNumChannels = 1;
+// This is the same size that is given to the SyncBuffer object in NetEq.
+const size_t kSyncBufferLengthMs = 720;
+// The length of the decoded audio that is time-stretched or merged.
+const size_t kBlockLengthMs = 30;
+
+// Returns a vowel-like signal: a pitch of 200 Hz and its first harmonics, with
+// some noise on top.
+std::vector<int16_t> GenerateVoicedSignal(int sample_rate_hz, size_t length) {
+  const double kPi = 3.14159265358979323846;
+  const double kPitchHz = 200.0;
+  const double kAmplitudes[] = {6000.0, 4000.0, 2500.0, 1200.0};
+  Random random(0x5eed);
+  std::vector<int16_t> signal(length);
+  for (size_t i = 0; i < length; ++i) {
+    double sample = random.Rand(-300, 300);
+    for (size_t k = 0; k < arraysize(kAmplitudes); ++k) {
+      sample += kAmplitudes[k] *
+                sin(2 * kPi * kPitchHz * (k + 1) * i / sample_rate_hz);
+    }
+    signal[i] = static_cast<int16_t>(sample);
+  }
+  return signal;
+}
+}  // namespace
+
+int64_t NetEqOperationsPerformanceTest::Run(Operation operation,
+                                            int sample_rate_hz,
+                                            int num_iterations) {
+  RTC_CHECK(sample_rate_hz == 8000 || sample_rate_hz == 16000 ||
+            sample_rate_hz == 32000 || sample_rate_hz == 48000);
+  RTC_CHECK_GT(num_iterations, 0);
+  WebRtcSpl_Init();
+
+  const size_t sync_buffer_length = kSyncBufferLengthMs * sample_rate_hz / 1000;
+  const size_t block_length = kBlockLengthMs * sample_rate_hz / 1000;
+  const std::vector<int16_t> history =
+      GenerateVoicedSignal(sample_rate_hz, sync_buffer_length + block_length);
+  // The block that follows the history in the signal.
+  const int16_t* block = &history[sync_buffer_length];
+
+  BackgroundNoise background_noise(kNumChannels);
+  SyncBuffer sync_buffer(kNumChannels, sync_buffer_length);
+  sync_buffer.Channel(0).OverwriteAt(&history[0], sync_buffer_length, 0);
+  RandomVector random_vector;
+  StatisticsCalculator statistics;
+  Expand expand(&background_noise, &sync_buffer, &random_vector, &statistics,
+                sample_rate_hz, kNumChannels);
+  // Leave one overlap of samples that haven't been played out, as NetEq does
+  // before a merge.
+  sync_buffer.set_next_index(sync_buffer_length - expand.overlap_length());
+  Merge merge(sample_rate_hz, kNumChannels, &expand, &sync_buffer);
+  Accelerate accelerate(sample_rate_hz, kNumChannels, background_noise);
+  PreemptiveExpand preemptive_expand(sample_rate_hz, kNumChannels,
+                                     background_noise,
+                                     5 * sample_rate_hz / 8000);
+
+  std::vector<int16_t> input(block_length);
+  size_t total_output_length = 0;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_iterations; ++i) {
+    AudioMultiVector output(kNumChannels);
+    size_t length_change;
+    switch (operation) {
+      case kAccelerate:
+        accelerate.Process(block, block_length, false, &output,
+                           &length_change);
+        break;
+      case kPreemptiveExpand:
+        preemptive_expand.Process(block, block_length, 0, &output,
+                                  &length_change);
+        break;
+      case kExpand:
+        expand.Reset();
+        RTC_CHECK_EQ(0, expand.Process(&output));
+        break;
+      case kMerge: {
+        // Merge works on the input in place.
+        input.assign(block, block + block_length);
+        expand.Reset();
+        int16_t mute_factor = 16384;  // 1.0 in Q14.
+        merge.Process(&input[0], block_length, &mute_factor, &output);
+        break;
+      }
+    }
+    total_output_length += output.Size();
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  RTC_CHECK_GT(total_output_length, 0u);
+  return elapsed_ns / num_iterations;
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,43 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_OPERATIONS_PERFORMANCE_TEST_H_
+#define WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_OPERATIONS_PERFORMANCE_TEST_H_
+
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+namespace test {
+
+// Measures the signal processing operations of NetEq one at a time, without
+// the rest of NetEq around them.
+class NetEqOperationsPerformanceTest {
+ public:
+  enum Operation {
+    kAccelerate,
+    kPreemptiveExpand,
+    kExpand,
+    kMerge,
+  };
+
+  // Runs |operation| |num_iterations| times on a synthetic voiced signal
+  // sampled at |sample_rate_hz|, which must be 8000, 16000, 32000 or 48000.
+  // Every iteration starts from the same state, so that an Expand or Merge
+  // always includes the signal analysis that starts a concealment period.
+  // Returns the average runtime of one operation in nanoseconds.
+  static int64_t Run(Operation operation,
+                     int sample_rate_hz,
+                     int num_iterations);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_OPERATIONS_PERFORMANCE_TEST_H_
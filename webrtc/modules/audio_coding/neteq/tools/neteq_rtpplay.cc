@@ -18,14 +18,19 @@
 #include <stdlib.h>  // For strtoul.
 
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "gflags/gflags.h"
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/checks.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/base/safe_conversions.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/modules/audio_coding/codecs/builtin_audio_decoder_factory.h"
 #include "webrtc/modules/audio_coding/codecs/pcm16b/pcm16b.h"
 #include "webrtc/modules/audio_coding/neteq/include/neteq.h"
@@ -36,6 +41,7 @@
 #include "webrtc/modules/audio_coding/neteq/tools/rtc_event_log_source.h"
 #include "webrtc/modules/audio_coding/neteq/tools/rtp_file_source.h"
 #include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
 #include "webrtc/system_wrappers/include/trace.h"
 #include "webrtc/test/rtp_file_reader.h"
 #include "webrtc/test/testsupport/fileutils.h"
@@ -81,6 +87,13 @@ bool ValidateSsrcValue(const char* flagname, const std::string& str) {
   return ParseSsrc(str, &dummy_ssrc);
 }
 
+bool ValidatePositive(const char* flagname, int32_t value) {
+  if (value > 0)  // Value is ok.
+    return true;
+  printf("Invalid value for --%s: %d\n", flagname, static_cast<int>(value));
+  return false;
+}
+
 // Define command line flags.
 DEFINE_int32(pcmu, 0, "RTP payload type for PCM-u");
 const bool pcmu_dummy =
@@ -143,6 +156,30 @@ DEFINE_string(ssrc,
               "starting with 0x)");
 const bool hex_ssrc_dummy =
     google::RegisterFlagValidator(&FLAGS_ssrc, &ValidateSsrcValue);
+DEFINE_string(stats_file,
+              "",
+              "Writes the NetEq network statistics of the replay to this CSV "
+              "file, one line per --stats_interval_ms");
+DEFINE_int32(stats_interval_ms, 1000, "Interval of the network statistics");
+const bool stats_interval_ms_dummy =
+    google::RegisterFlagValidator(&FLAGS_stats_interval_ms,
+                                  &ValidatePositive);
+DEFINE_string(input_list,
+              "",
+              "File with one input filename per line, which are replayed in "
+              "parallel without writing any audio");
+DEFINE_int32(num_threads,
+             0,
+             "Number of files of --input_list to replay in parallel, or 0 for "
+             "one per core");
+
+const char kStatisticsHeader[] =
+    "# input,time_ms,current_buffer_size_ms,preferred_buffer_size_ms,"
+    "jitter_peaks_found,packet_loss_rate,packet_discard_rate,expand_rate,"
+    "speech_expand_rate,preemptive_rate,accelerate_rate,"
+    "secondary_decoded_rate,clockdrift_ppm,added_zero_samples,"
+    "mean_waiting_time_ms,median_waiting_time_ms,min_waiting_time_ms,"
+    "max_waiting_time_ms";
 
 // Maps a codec type to a printable name string.
 std::string CodecName(NetEqDecoder codec) {
@@ -368,44 +405,41 @@ size_t ReplacePayload(InputAudioFile* replacement_audio_file,
   return payload_len;
 }
 
-}  // namespace
 
-int main(int argc, char* argv[]) {
+// NetEq network statistics, sampled at |time_ms| after the start of the
+// replay.
+struct StatisticsSample {
+  int64_t time_ms;
+  NetEqNetworkStatistics stats;
+};
+
+// The outcome of the replay of one input file.
+struct ReplayResult {
+  int exit_code = 0;
+  int64_t produced_audio_ms = 0;
+  std::vector<StatisticsSample> stats;
+};
+
+// Replays |input_file_name| through NetEq. The output audio is written to
+// |output_file_name| unless it is empty. If |collect_stats| is true, the
+// network statistics are sampled every --stats_interval_ms of simulated time.
+// Since NetworkStatistics() resets the rates and waiting times, each sample
+// covers the interval since the previous one.
+ReplayResult Replay(const std::string& input_file_name,
+                    const std::string& output_file_name,
+                    bool collect_stats) {
   static const int kOutputBlockSizeMs = 10;
-
-  std::string program_name = argv[0];
-  std::string usage = "Tool for decoding an RTP dump file using NetEq.\n"
-      "Run " + program_name + " --helpshort for usage.\n"
-      "Example usage:\n" + program_name +
-      " input.rtp output.{pcm, wav}\n";
-  google::SetUsageMessage(usage);
-  google::ParseCommandLineFlags(&argc, &argv, true);
-
-  if (FLAGS_codec_map) {
-    PrintCodecMapping();
-  }
-
-  if (argc != 3) {
-    if (FLAGS_codec_map) {
-      // We have already printed the codec map. Just end the program.
-      return 0;
-    }
-    // Print usage information.
-    std::cout << google::ProgramUsage();
-    return 0;
-  }
-
-  printf("Input file: %s\n", argv[1]);
+  ReplayResult result;
 
   bool is_rtp_dump = false;
   std::unique_ptr<PacketSource> file_source;
   RtcEventLogSource* event_log_source = nullptr;
-  if (RtpFileSource::ValidRtpDump(argv[1]) ||
-      RtpFileSource::ValidPcap(argv[1])) {
+  if (RtpFileSource::ValidRtpDump(input_file_name) ||
+      RtpFileSource::ValidPcap(input_file_name)) {
     is_rtp_dump = true;
-    file_source.reset(RtpFileSource::Create(argv[1]));
+    file_source.reset(RtpFileSource::Create(input_file_name));
   } else {
-    event_log_source = RtcEventLogSource::Create(argv[1]);
+    event_log_source = RtcEventLogSource::Create(input_file_name);
     file_source.reset(event_log_source);
   }
 
@@ -433,31 +467,30 @@ int main(int argc, char* argv[]) {
     printf(
         "Warning: input file is empty, or the filters did not match any "
         "packets\n");
-    Trace::ReturnTrace();
-    return 0;
+    return result;
   }
   if (packet->payload_length_bytes() == 0 && !replace_payload) {
     std::cerr << "Warning: input file contains header-only packets, but no "
               << "replacement file is specified." << std::endl;
-    Trace::ReturnTrace();
-    return -1;
+    result.exit_code = -1;
+    return result;
   }
 
   // Check the sample rate.
   int sample_rate_hz = CodecSampleRate(packet->header().payloadType);
   if (sample_rate_hz <= 0) {
     printf("Warning: Invalid sample rate from RTP packet.\n");
-    Trace::ReturnTrace();
-    return 0;
+    return result;
   }
 
   // Open the output file now that we know the sample rate. (Rate is only needed
   // for wav files.)
   // Check output file type.
-  std::string output_file_name = argv[2];
   std::unique_ptr<AudioSink> output;
-  if (output_file_name.size() >= 4 &&
-      output_file_name.substr(output_file_name.size() - 4) == ".wav") {
+  if (output_file_name.empty()) {
+    // Only the statistics are of interest.
+  } else if (output_file_name.size() >= 4 &&
+             output_file_name.substr(output_file_name.size() - 4) == ".wav") {
     // Open a wav file.
     output.reset(new OutputWavFile(output_file_name, sample_rate_hz));
   } else {
@@ -465,19 +498,12 @@ int main(int argc, char* argv[]) {
     output.reset(new OutputAudioFile(output_file_name));
   }
 
-  std::cout << "Output file: " << argv[2] << std::endl;
-
-  // Enable tracing.
-  Trace::CreateTrace();
-  Trace::SetTraceFile((OutputPath() + "neteq_trace.txt").c_str());
-  Trace::set_level_filter(kTraceAll);
-
   // Initialize NetEq instance.
   NetEq::Config config;
   config.sample_rate_hz = sample_rate_hz;
-  NetEq* neteq =
-      NetEq::Create(config, CreateBuiltinAudioDecoderFactory());
-  RegisterPayloadTypes(neteq);
+  std::unique_ptr<NetEq> neteq(
+      NetEq::Create(config, CreateBuiltinAudioDecoderFactory()));
+  RegisterPayloadTypes(neteq.get());
 
 
   // Set up variables for audio replacement if needed.
@@ -522,6 +548,7 @@ int main(int argc, char* argv[]) {
     start_time_ms = time_now_ms =
         std::min(next_input_time_ms, next_output_time_ms);
   }
+  int64_t next_stats_time_ms = start_time_ms + FLAGS_stats_interval_ms;
   while (packet_available || output_event_available) {
     // Advance time to next event.
     time_now_ms = std::min(next_input_time_ms, next_output_time_ms);
@@ -605,13 +632,20 @@ int main(int argc, char* argv[]) {
       }
 
       // Write to file.
-      // TODO(hlundin): Make writing to file optional.
-      if (!output->WriteArray(out_frame.data_, out_frame.samples_per_channel_ *
+      if (output &&
+          !output->WriteArray(out_frame.data_, out_frame.samples_per_channel_ *
                                                    out_frame.num_channels_)) {
         std::cerr << "Error while writing to file" << std::endl;
         Trace::ReturnTrace();
         exit(1);
       }
+      if (collect_stats && time_now_ms >= next_stats_time_ms) {
+        StatisticsSample sample;
+        sample.time_ms = time_now_ms - start_time_ms;
+        neteq->NetworkStatistics(&sample.stats);
+        result.stats.push_back(sample);
+        next_stats_time_ms += FLAGS_stats_interval_ms;
+      }
       if (is_rtp_dump) {
         next_output_time_ms += kOutputBlockSizeMs;
         if (!packet_available)
@@ -623,14 +657,192 @@ int main(int argc, char* argv[]) {
       }
     }
   }
-  printf("Simulation done\n");
-  printf("Produced %i ms of audio\n",
-         static_cast<int>(time_now_ms - start_time_ms));
+  result.produced_audio_ms = time_now_ms - start_time_ms;
+  return result;
+}
+
+// Replays a list of input files on a number of threads, each of which takes
+// the next input which no thread has started on yet.
+class BatchReplay {
+ public:
+  explicit BatchReplay(const std::vector<std::string>& input_file_names)
+      : input_file_names_(input_file_names),
+        results_(input_file_names.size()),
+        next_input_(0) {}
+
+  void Run(int num_threads) {
+    std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(std::unique_ptr<rtc::PlatformThread>(
+          new rtc::PlatformThread(&BatchReplay::ReplayInputs, this,
+                                  "neteq_rtpplay")));
+      threads.back()->Start();
+    }
+    for (auto& thread : threads)
+      thread->Stop();
+  }
+
+  const std::vector<ReplayResult>& results() const { return results_; }
+
+ private:
+  // Replays inputs until none is left. Returns false to end the thread.
+  static bool ReplayInputs(void* obj) {
+    BatchReplay* batch = static_cast<BatchReplay*>(obj);
+    while (true) {
+      const size_t index = rtc::AtomicOps::Increment(&batch->next_input_) - 1;
+      if (index >= batch->results_.size())
+        return false;
+      batch->results_[index] =
+          Replay(batch->input_file_names_[index], "", !FLAGS_stats_file.empty());
+    }
+  }
 
-  delete neteq;
-  Trace::ReturnTrace();
-  return 0;
+  const std::vector<std::string> input_file_names_;
+  // Only written by the thread which replays the input.
+  std::vector<ReplayResult> results_;
+  volatile int next_input_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(BatchReplay);
+};
+
+std::vector<std::string> ReadInputList(const std::string& file_name) {
+  std::ifstream file(file_name);
+  RTC_CHECK(file.good()) << "Could not open " << file_name;
+  std::vector<std::string> input_file_names;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!line.empty() && line[0] != '#')
+      input_file_names.push_back(line);
+  }
+  return input_file_names;
+}
+
+// Writes one line per statistics sample, with the Q14 rates as fractions.
+void WriteStatistics(const std::string& input_file_name,
+                     const ReplayResult& result,
+                     std::ofstream* file) {
+  for (const StatisticsSample& sample : result.stats) {
+    const NetEqNetworkStatistics& stats = sample.stats;
+    *file << input_file_name << "," << sample.time_ms << ","
+          << stats.current_buffer_size_ms << ","
+          << stats.preferred_buffer_size_ms << "," << stats.jitter_peaks_found
+          << "," << stats.packet_loss_rate / 16384.f << ","
+          << stats.packet_discard_rate / 16384.f << ","
+          << stats.expand_rate / 16384.f << ","
+          << stats.speech_expand_rate / 16384.f << ","
+          << stats.preemptive_rate / 16384.f << ","
+          << stats.accelerate_rate / 16384.f << ","
+          << stats.secondary_decoded_rate / 16384.f << ","
+          << stats.clockdrift_ppm << "," << stats.added_zero_samples << ","
+          << stats.mean_waiting_time_ms << "," << stats.median_waiting_time_ms
+          << "," << stats.min_waiting_time_ms << ","
+          << stats.max_waiting_time_ms << std::endl;
+  }
+}
+
+std::unique_ptr<std::ofstream> OpenStatisticsFile() {
+  if (FLAGS_stats_file.empty())
+    return nullptr;
+  std::unique_ptr<std::ofstream> file(new std::ofstream(FLAGS_stats_file));
+  RTC_CHECK(file->good()) << "Could not open " << FLAGS_stats_file;
+  *file << kStatisticsHeader << std::endl;
+  return file;
+}
+
+int RunBatch() {
+  const std::vector<std::string> input_file_names =
+      ReadInputList(FLAGS_input_list);
+  const int num_threads = FLAGS_num_threads > 0
+                              ? FLAGS_num_threads
+                              : static_cast<int>(CpuInfo::DetectNumberOfCores());
+  BatchReplay batch(input_file_names);
+  const int64_t start_time_us = rtc::TimeMicros();
+  batch.Run(num_threads);
+  const int64_t wall_time_us = rtc::TimeMicros() - start_time_us;
+
+  std::unique_ptr<std::ofstream> stats_file = OpenStatisticsFile();
+  int64_t produced_audio_ms = 0;
+  int num_failed = 0;
+  for (size_t i = 0; i < input_file_names.size(); ++i) {
+    const ReplayResult& result = batch.results()[i];
+    produced_audio_ms += result.produced_audio_ms;
+    if (result.exit_code != 0) {
+      std::cerr << "Failed to replay " << input_file_names[i] << std::endl;
+      ++num_failed;
+    }
+    if (stats_file)
+      WriteStatistics(input_file_names[i], result, stats_file.get());
+  }
+  std::cout << "Replayed " << input_file_names.size() << " files, "
+            << produced_audio_ms / 1000 << " s of audio, in "
+            << wall_time_us * 1e-6 << " s on " << num_threads << " threads"
+            << std::endl;
+  return num_failed > 0 ? -1 : 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string program_name = argv[0];
+  std::string usage = "Tool for decoding an RTP dump file using NetEq.\n"
+      "Run " + program_name + " --helpshort for usage.\n"
+      "Example usage:\n" + program_name +
+      " input.rtp output.{pcm, wav}\n"
+      "Without an output file, only the network statistics of --stats_file "
+      "are produced. With --input_list, all listed files are replayed in "
+      "parallel in this way:\n" + program_name +
+      " --input_list=inputs.txt --stats_file=stats.csv\n";
+  google::SetUsageMessage(usage);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_codec_map) {
+    PrintCodecMapping();
+  }
+
+  if (!FLAGS_input_list.empty())
+    return RunBatch();
+
+  if (argc != 2 && argc != 3) {
+    if (FLAGS_codec_map) {
+      // We have already printed the codec map. Just end the program.
+      return 0;
+    }
+    // Print usage information.
+    std::cout << google::ProgramUsage();
+    return 0;
+  }
+
+  printf("Input file: %s\n", argv[1]);
+  std::string output_file_name;
+  if (argc == 3) {
+    output_file_name = argv[2];
+    std::cout << "Output file: " << argv[2] << std::endl;
+
+    // Enable tracing. This is left out when only the statistics are needed,
+    // since tracing everything slows down the replay considerably.
+    Trace::CreateTrace();
+    Trace::SetTraceFile((OutputPath() + "neteq_trace.txt").c_str());
+    Trace::set_level_filter(kTraceAll);
+  }
+
+  std::unique_ptr<std::ofstream> stats_file = OpenStatisticsFile();
+  ReplayResult result = Replay(argv[1], output_file_name, !!stats_file);
+  if (result.exit_code == 0) {
+    printf("Simulation done\n");
+    printf("Produced %i ms of audio\n",
+           static_cast<int>(result.produced_audio_ms));
+  }
+  if (stats_file)
+    WriteStatistics(argv[1], result, stats_file.get());
+
+  if (argc == 3)
+    Trace::ReturnTrace();
+  return result.exit_code;
 }
 
 }  // namespace test
 }  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  return webrtc::test::main(argc, argv);
+}
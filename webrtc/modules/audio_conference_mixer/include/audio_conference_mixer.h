@@ -36,6 +36,26 @@ public:
 
     // Factory method. Constructor disabled.
     static AudioConferenceMixer* Create(int id);
+    // Same as Create(), but fetches the participants' audio in parallel on
+    // |num_fetch_threads| threads: the thread calling Process() and
+    // |num_fetch_threads| - 1 threads owned by the mixer. Participants that
+    // haven't delivered |fetch_deadline_ms| after Process() started fetching
+    // are mixed as muted for that round. GetAudioFrameWithMuted() is called on
+    // the mixer's threads and must not call back into the mixer.
+    static AudioConferenceMixer* Create(int id,
+                                        size_t num_fetch_threads,
+                                        int fetch_deadline_ms);
+    // Creates a mixer for conference servers. It mixes all participants,
+    // not just kMaximumAmountOfMixedParticipants, fetching their audio on
+    // |num_threads| threads: the thread calling Process() and
+    // |num_threads| - 1 threads owned by the mixer. Besides the full mix,
+    // NewMixedAudio() gets one N-minus-one mix per participant in
+    // uniqueAudioFrames, holding everyone's audio but that participant's and
+    // having the id_ of that participant's audio frames.
+    // GetAudioFrameWithMuted() is called on the mixer's threads and must not
+    // call back into the mixer.
+    static AudioConferenceMixer* CreateMultiThreaded(int id,
+                                                     size_t num_threads);
     virtual ~AudioConferenceMixer() {}
 
     // Module functions
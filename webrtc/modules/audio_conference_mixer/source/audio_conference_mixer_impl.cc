@@ -11,6 +11,7 @@
 #include "webrtc/modules/audio_conference_mixer/include/audio_conference_mixer_defines.h"
 #include "webrtc/modules/audio_conference_mixer/source/audio_conference_mixer_impl.h"
 #include "webrtc/modules/audio_conference_mixer/source/audio_frame_manipulator.h"
+#include "webrtc/modules/audio_conference_mixer/source/multi_threaded_mixer_impl.h"
 #include "webrtc/modules/audio_processing/include/audio_processing.h"
 #include "webrtc/modules/utility/include/audio_frame_operations.h"
 #include "webrtc/system_wrappers/include/critical_section_wrapper.h"
@@ -49,7 +50,7 @@ void MixFrames(AudioFrame* mixed_frame, AudioFrame* frame, bool use_limiter) {
     AudioFrameOperations::MonoToStereo(frame);
   }
 
-  *mixed_frame += *frame;
+  AudioFrameOperations::Add(*frame, mixed_frame);
 }
 
 // Return the max number of channels from a |list| composed of AudioFrames.
@@ -112,13 +113,39 @@ AudioConferenceMixer* AudioConferenceMixer::Create(int id) {
     return mixer;
 }
 
+AudioConferenceMixer* AudioConferenceMixer::Create(int id,
+                                                   size_t num_fetch_threads,
+                                                   int fetch_deadline_ms) {
+    AudioConferenceMixerImpl* mixer =
+        new AudioConferenceMixerImpl(id, num_fetch_threads, fetch_deadline_ms);
+    if(!mixer->Init()) {
+        delete mixer;
+        return NULL;
+    }
+    return mixer;
+}
+
+AudioConferenceMixer* AudioConferenceMixer::CreateMultiThreaded(
+    int id, size_t num_threads) {
+    return new MultiThreadedMixerImpl(id, num_threads);
+}
+
 AudioConferenceMixerImpl::AudioConferenceMixerImpl(int id)
+    : AudioConferenceMixerImpl(id, 1, 0) {}
+
+AudioConferenceMixerImpl::AudioConferenceMixerImpl(int id,
+                                                   size_t num_fetch_threads,
+                                                   int fetch_deadline_ms)
     : _id(id),
       _minimumMixingFreq(kLowestPossible),
       _mixReceiver(NULL),
       _outputFrequency(kDefaultFrequency),
       _sampleSize(0),
       _audioFramePool(NULL),
+      _fetcher(num_fetch_threads > 1
+                   ? new ParticipantFetcher(id, num_fetch_threads,
+                                            fetch_deadline_ms)
+                   : NULL),
       _participantList(),
       _additionalParticipantList(),
       _numMixedParticipants(0),
@@ -257,6 +284,15 @@ void AudioConferenceMixerImpl::Process() {
             }
         }
 
+        if (_fetcher) {
+            std::vector<MixerParticipant*> participants(
+                _participantList.begin(), _participantList.end());
+            participants.insert(participants.end(),
+                                _additionalParticipantList.begin(),
+                                _additionalParticipantList.end());
+            _fetcher->Fetch(participants, _outputFrequency);
+        }
+
         UpdateToMix(&mixList, &rampOutList, &mixedParticipantsMap,
                     &remainingParticipantsAllowedToMix);
 
@@ -402,6 +438,10 @@ int32_t AudioConferenceMixerImpl::SetMixabilityStatus(
             assert(false);
             return -1;
         }
+        if (!mixable && _fetcher) {
+            // The participant may be destroyed once this call returns.
+            _fetcher->RemoveParticipant(participant);
+        }
 
         size_t numMixedNonAnonymous = _participantList.size();
         if (numMixedNonAnonymous > kMaximumAmountOfMixedParticipants) {
@@ -555,7 +595,7 @@ void AudioConferenceMixerImpl::UpdateToMix(
         }
         audioFrame->sample_rate_hz_ = _outputFrequency;
 
-        auto ret = (*participant)->GetAudioFrameWithMuted(_id, audioFrame);
+        auto ret = GetParticipantAudio(*participant, audioFrame);
         if (ret == MixerParticipant::AudioFrameInfo::kError) {
             WEBRTC_TRACE(kTraceWarning, kTraceAudioMixerServer, _id,
                          "failed to GetAudioFrameWithMuted() from participant");
@@ -717,6 +757,14 @@ void AudioConferenceMixerImpl::UpdateToMix(
     *maxAudioFrameCounter += mixListStartSize - mixList->size();
 }
 
+MixerParticipant::AudioFrameInfo AudioConferenceMixerImpl::GetParticipantAudio(
+    MixerParticipant* participant, AudioFrame* audioFrame) const {
+    if (_fetcher) {
+        return _fetcher->TakeFrame(participant, _outputFrequency, audioFrame);
+    }
+    return participant->GetAudioFrameWithMuted(_id, audioFrame);
+}
+
 void AudioConferenceMixerImpl::GetAdditionalAudio(
     AudioFrameList* additionalFramesList) const {
     WEBRTC_TRACE(kTraceStream, kTraceAudioMixerServer, _id,
@@ -742,7 +790,7 @@ void AudioConferenceMixerImpl::GetAdditionalAudio(
             return;
         }
         audioFrame->sample_rate_hz_ = _outputFrequency;
-        auto ret = (*participant)->GetAudioFrameWithMuted(_id, audioFrame);
+        auto ret = GetParticipantAudio(*participant, audioFrame);
         if (ret == MixerParticipant::AudioFrameInfo::kError) {
             WEBRTC_TRACE(kTraceWarning, kTraceAudioMixerServer, _id,
                          "failed to GetAudioFrameWithMuted() from participant");
@@ -922,7 +970,7 @@ bool AudioConferenceMixerImpl::LimitMixedAudio(AudioFrame* mixedAudio) const {
     //
     // Instead we double the frame (with addition since left-shifting a
     // negative value is undefined).
-    *mixedAudio += *mixedAudio;
+    AudioFrameOperations::Add(*mixedAudio, mixedAudio);
 
     if(error != _limiter->kNoError) {
         WEBRTC_TRACE(kTraceError, kTraceAudioMixerServer, _id,
@@ -18,6 +18,7 @@
 #include "webrtc/engine_configurations.h"
 #include "webrtc/modules/audio_conference_mixer/include/audio_conference_mixer.h"
 #include "webrtc/modules/audio_conference_mixer/source/memory_pool.h"
+#include "webrtc/modules/audio_conference_mixer/source/participant_fetcher.h"
 #include "webrtc/modules/audio_conference_mixer/source/time_scheduler.h"
 #include "webrtc/modules/include/module_common_types.h"
 
@@ -63,6 +64,11 @@ public:
     enum {kProcessPeriodicityInMs = 10};
 
     AudioConferenceMixerImpl(int id);
+    // Fetches the participants' audio in parallel if |num_fetch_threads| is
+    // larger than one. See AudioConferenceMixer::Create().
+    AudioConferenceMixerImpl(int id,
+                             size_t num_fetch_threads,
+                             int fetch_deadline_ms);
     ~AudioConferenceMixerImpl();
 
     // Must be called after ctor.
@@ -111,6 +117,11 @@ private:
     int32_t GetLowestMixingFrequencyFromList(
         const MixerParticipantList& mixList) const;
 
+    // Gets the audio of |participant| for this round, from |_fetcher| if the
+    // audio is fetched in parallel.
+    MixerParticipant::AudioFrameInfo GetParticipantAudio(
+        MixerParticipant* participant, AudioFrame* audioFrame) const;
+
     // Return the AudioFrames that should be mixed anonymously.
     void GetAdditionalAudio(AudioFrameList* additionalFramesList) const;
 
@@ -165,6 +176,10 @@ private:
     // Memory pool to avoid allocating/deallocating AudioFrames
     MemoryPool<AudioFrame>* _audioFramePool;
 
+    // Fetches the participants' audio in parallel; NULL if the audio is
+    // fetched serially on the thread calling Process().
+    std::unique_ptr<ParticipantFetcher> _fetcher;
+
     // List of all participants. Note all lists are disjunct
     MixerParticipantList _participantList;              // May be mixed.
     // Always mixed, anonomously.
@@ -8,8 +8,11 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
+
 #include "webrtc/modules/audio_conference_mixer/source/audio_frame_manipulator.h"
 #include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/modules/utility/include/audio_frame_operations.h"
 #include "webrtc/typedefs.h"
 
 namespace {
@@ -54,22 +57,15 @@ uint32_t CalculateEnergy(const AudioFrame& audioFrame)
 void RampIn(AudioFrame& audioFrame)
 {
     assert(rampSize <= audioFrame.samples_per_channel_);
-    for(size_t i = 0; i < rampSize; i++)
-    {
-        audioFrame.data_[i] = static_cast<int16_t>(rampArray[i] *
-                                                   audioFrame.data_[i]);
-    }
+    AudioFrameOperations::ApplyGains(rampArray, rampSize, audioFrame.data_);
 }
 
 void RampOut(AudioFrame& audioFrame)
 {
     assert(rampSize <= audioFrame.samples_per_channel_);
-    for(size_t i = 0; i < rampSize; i++)
-    {
-        const size_t rampPos = rampSize - 1 - i;
-        audioFrame.data_[i] = static_cast<int16_t>(rampArray[rampPos] *
-                                                   audioFrame.data_[i]);
-    }
+    float reversedRamp[rampSize];
+    std::reverse_copy(rampArray, rampArray + rampSize, reversedRamp);
+    AudioFrameOperations::ApplyGains(reversedRamp, rampSize, audioFrame.data_);
     memset(&audioFrame.data_[rampSize], 0,
            (audioFrame.samples_per_channel_ - rampSize) *
            sizeof(audioFrame.data_[0]));
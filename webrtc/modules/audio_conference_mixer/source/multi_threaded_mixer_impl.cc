@@ -0,0 +1,403 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_conference_mixer/source/multi_threaded_mixer_impl.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/modules/audio_conference_mixer/include/audio_conference_mixer_defines.h"
+#include "webrtc/modules/audio_conference_mixer/source/audio_conference_mixer_impl.h"
+#include "webrtc/modules/audio_conference_mixer/source/audio_frame_manipulator.h"
+
+namespace webrtc {
+namespace {
+
+// Copies everything but the samples from |format| to |frame|.
+void CopyFrameFormat(const AudioFrame& format, AudioFrame* frame) {
+  frame->timestamp_ = format.timestamp_;
+  frame->elapsed_time_ms_ = format.elapsed_time_ms_;
+  frame->ntp_time_ms_ = format.ntp_time_ms_;
+  frame->samples_per_channel_ = format.samples_per_channel_;
+  frame->sample_rate_hz_ = format.sample_rate_hz_;
+  frame->num_channels_ = format.num_channels_;
+  frame->speech_type_ = format.speech_type_;
+  frame->vad_activity_ = format.vad_activity_;
+}
+
+}  // namespace
+
+// Waits for its partition of each phase to be started, runs it, and signals
+// the mixer once the last worker is done.
+class MultiThreadedMixerImpl::Worker {
+ public:
+  Worker(MultiThreadedMixerImpl* mixer, size_t partition)
+      : mixer_(mixer),
+        partition_(partition),
+        start_(false, false),
+        quit_(0),
+        thread_(&Worker::Run, this, "AudioMixerWorker") {
+    thread_.Start();
+    thread_.SetPriority(rtc::kHighPriority);
+  }
+
+  ~Worker() {
+    rtc::AtomicOps::ReleaseStore(&quit_, 1);
+    start_.Set();
+    thread_.Stop();
+  }
+
+  void Start() { start_.Set(); }
+
+ private:
+  static bool Run(void* obj) { return static_cast<Worker*>(obj)->RunOnce(); }
+
+  bool RunOnce() {
+    start_.Wait(rtc::Event::kForever);
+    if (rtc::AtomicOps::AcquireLoad(&quit_))
+      return false;
+    mixer_->RunPartition(partition_);
+    if (rtc::AtomicOps::Decrement(&mixer_->pending_workers_) == 0)
+      mixer_->workers_done_.Set();
+    return true;
+  }
+
+  MultiThreadedMixerImpl* const mixer_;
+  const size_t partition_;
+  rtc::Event start_;
+  volatile int quit_;
+  rtc::PlatformThread thread_;
+};
+
+MultiThreadedMixerImpl::ParticipantState::ParticipantState(
+    MixerParticipant* participant)
+    : participant(participant),
+      anonymous(false),
+      contributes(false),
+      frame(new AudioFrame()),
+      n_minus_one_frame(new AudioFrame()) {}
+
+MultiThreadedMixerImpl::MultiThreadedMixerImpl(int id, size_t num_threads)
+    : id_(id),
+      time_scheduler_(kProcessPeriodicityInMs),
+      receiver_(nullptr),
+      minimum_mixing_frequency_(kLowestPossible),
+      timestamp_(0),
+      sample_rate_hz_(kDefaultFrequency),
+      samples_per_channel_(0),
+      num_channels_(1),
+      sums_((std::max<size_t>(num_threads, 1) + 1) *
+            AudioFrame::kMaxDataSizeSamples),
+      phase_(Phase::kFetch),
+      pending_workers_(0),
+      workers_done_(false, false) {
+  for (size_t partition = 1; partition < num_threads; ++partition)
+    workers_.push_back(std::unique_ptr<Worker>(new Worker(this, partition)));
+}
+
+MultiThreadedMixerImpl::~MultiThreadedMixerImpl() {
+  // Join the workers before the state they use goes away.
+  workers_.clear();
+}
+
+int64_t MultiThreadedMixerImpl::TimeUntilNextProcess() {
+  int64_t time_until_next_process = 0;
+  if (time_scheduler_.TimeToNextUpdate(time_until_next_process) != 0) {
+    LOG(LS_ERROR) << "Failed in TimeToNextUpdate() call.";
+    RTC_NOTREACHED();
+    return -1;
+  }
+  return time_until_next_process;
+}
+
+void MultiThreadedMixerImpl::Process() {
+  rtc::CritScope cs(&crit_);
+  time_scheduler_.UpdateScheduler();
+
+  sample_rate_hz_ = MixingFrequency();
+  samples_per_channel_ = static_cast<size_t>(
+      sample_rate_hz_ * kProcessPeriodicityInMs / 1000);
+  RunPhase(Phase::kFetch);
+
+  num_channels_ = 1;
+  bool active = false;
+  for (const ParticipantState& state : participants_) {
+    if (state.contributes) {
+      num_channels_ = std::max(num_channels_, state.frame->num_channels_);
+      active |= state.frame->vad_activity_ == AudioFrame::kVadActive;
+    }
+  }
+  RunPhase(Phase::kAccumulate);
+
+  // Add up the partition sums.
+  const size_t num_samples = samples_per_channel_ * num_channels_;
+  const size_t num_partitions = workers_.size() + 1;
+  int32_t* total = &sums_[num_partitions * AudioFrame::kMaxDataSizeSamples];
+  memcpy(total, &sums_[0], num_samples * sizeof(*total));
+  for (size_t partition = 1; partition < num_partitions; ++partition) {
+    const int32_t* sum = &sums_[partition * AudioFrame::kMaxDataSizeSamples];
+    for (size_t i = 0; i < num_samples; ++i)
+      total[i] += sum[i];
+  }
+
+  mixed_frame_.UpdateFrame(
+      -1, timestamp_, nullptr, samples_per_channel_, sample_rate_hz_,
+      AudioFrame::kNormalSpeech,
+      active ? AudioFrame::kVadActive : AudioFrame::kVadPassive,
+      num_channels_);
+  timestamp_ += static_cast<uint32_t>(samples_per_channel_);
+  for (size_t i = 0; i < num_samples; ++i)
+    mixed_frame_.data_[i] = ClampToInt16(total[i]);
+
+  RunPhase(Phase::kSubtract);
+
+  n_minus_one_frames_.clear();
+  for (const ParticipantState& state : participants_)
+    n_minus_one_frames_.push_back(state.n_minus_one_frame.get());
+
+  if (receiver_) {
+    receiver_->NewMixedAudio(
+        id_, mixed_frame_,
+        n_minus_one_frames_.empty() ? nullptr : &n_minus_one_frames_[0],
+        static_cast<uint32_t>(n_minus_one_frames_.size()));
+  }
+}
+
+void MultiThreadedMixerImpl::RunPhase(Phase phase) {
+  phase_ = phase;
+  if (workers_.empty()) {
+    RunPartition(0);
+    return;
+  }
+  rtc::AtomicOps::ReleaseStore(&pending_workers_,
+                               static_cast<int>(workers_.size()));
+  for (const auto& worker : workers_)
+    worker->Start();
+  RunPartition(0);
+  workers_done_.Wait(rtc::Event::kForever);
+}
+
+void MultiThreadedMixerImpl::RunPartition(size_t partition) {
+  const size_t num_partitions = workers_.size() + 1;
+  const size_t begin = partition * participants_.size() / num_partitions;
+  const size_t end = (partition + 1) * participants_.size() / num_partitions;
+  switch (phase_) {
+    case Phase::kFetch:
+      FetchAudio(begin, end);
+      break;
+    case Phase::kAccumulate:
+      Accumulate(begin, end,
+                 &sums_[partition * AudioFrame::kMaxDataSizeSamples]);
+      break;
+    case Phase::kSubtract:
+      Subtract(begin, end);
+      break;
+  }
+}
+
+void MultiThreadedMixerImpl::FetchAudio(size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    ParticipantState& state = participants_[i];
+    AudioFrame* frame = state.frame.get();
+    frame->sample_rate_hz_ = sample_rate_hz_;
+    const MixerParticipant::AudioFrameInfo info =
+        state.participant->GetAudioFrameWithMuted(id_, frame);
+    state.contributes =
+        info == MixerParticipant::AudioFrameInfo::kNormal &&
+        frame->samples_per_channel_ == samples_per_channel_ &&
+        (frame->num_channels_ == 1 || frame->num_channels_ == 2);
+    if (state.contributes && !state.participant->_mixHistory->WasMixed())
+      RampIn(*frame);
+    state.participant->_mixHistory->SetIsMixed(state.contributes);
+  }
+}
+
+void MultiThreadedMixerImpl::Accumulate(size_t begin,
+                                        size_t end,
+                                        int32_t* sum) const {
+  memset(sum, 0, samples_per_channel_ * num_channels_ * sizeof(*sum));
+  for (size_t i = begin; i < end; ++i) {
+    const ParticipantState& state = participants_[i];
+    if (!state.contributes)
+      continue;
+    const int16_t* data = state.frame->data_;
+    if (state.frame->num_channels_ == num_channels_) {
+      for (size_t j = 0; j < samples_per_channel_ * num_channels_; ++j)
+        sum[j] += data[j];
+    } else {
+      // Mono into a stereo mix.
+      for (size_t j = 0; j < samples_per_channel_; ++j) {
+        sum[2 * j] += data[j];
+        sum[2 * j + 1] += data[j];
+      }
+    }
+  }
+}
+
+void MultiThreadedMixerImpl::Subtract(size_t begin, size_t end) {
+  const size_t num_samples = samples_per_channel_ * num_channels_;
+  const int32_t* total =
+      &sums_[(workers_.size() + 1) * AudioFrame::kMaxDataSizeSamples];
+  for (size_t i = begin; i < end; ++i) {
+    const ParticipantState& state = participants_[i];
+    AudioFrame* n_minus_one_frame = state.n_minus_one_frame.get();
+    // Label the mix with the id of the participant it's meant for.
+    n_minus_one_frame->id_ = state.frame->id_;
+    CopyFrameFormat(mixed_frame_, n_minus_one_frame);
+    int16_t* out = n_minus_one_frame->data_;
+    const int16_t* data = state.frame->data_;
+    if (!state.contributes) {
+      memcpy(out, mixed_frame_.data_, num_samples * sizeof(*out));
+    } else if (state.frame->num_channels_ == num_channels_) {
+      for (size_t j = 0; j < num_samples; ++j)
+        out[j] = ClampToInt16(total[j] - data[j]);
+    } else {
+      for (size_t j = 0; j < samples_per_channel_; ++j) {
+        out[2 * j] = ClampToInt16(total[2 * j] - data[j]);
+        out[2 * j + 1] = ClampToInt16(total[2 * j + 1] - data[j]);
+      }
+    }
+  }
+}
+
+int32_t MultiThreadedMixerImpl::RegisterMixedStreamCallback(
+    AudioMixerOutputReceiver* receiver) {
+  rtc::CritScope cs(&crit_);
+  if (receiver_)
+    return -1;
+  receiver_ = receiver;
+  return 0;
+}
+
+int32_t MultiThreadedMixerImpl::UnRegisterMixedStreamCallback() {
+  rtc::CritScope cs(&crit_);
+  if (!receiver_)
+    return -1;
+  receiver_ = nullptr;
+  return 0;
+}
+
+int32_t MultiThreadedMixerImpl::SetMixabilityStatus(
+    MixerParticipant* participant,
+    bool mixable) {
+  rtc::CritScope cs(&crit_);
+  const int index = FindParticipant(*participant);
+  if (mixable) {
+    if (index >= 0 && !participants_[index].anonymous) {
+      LOG(LS_WARNING) << "Mixable is already on.";
+      return -1;
+    }
+    if (index >= 0) {
+      participants_[index].anonymous = false;
+    } else {
+      participants_.push_back(ParticipantState(participant));
+    }
+    participant->_mixHistory->ResetMixedStatus();
+    return 0;
+  }
+  if (index < 0) {
+    LOG(LS_WARNING) << "Mixable is already off.";
+    return -1;
+  }
+  RemoveParticipant(index);
+  return 0;
+}
+
+bool MultiThreadedMixerImpl::MixabilityStatus(
+    const MixerParticipant& participant) const {
+  rtc::CritScope cs(&crit_);
+  const int index = FindParticipant(participant);
+  return index >= 0 && !participants_[index].anonymous;
+}
+
+int32_t MultiThreadedMixerImpl::SetAnonymousMixabilityStatus(
+    MixerParticipant* participant,
+    bool anonymous) {
+  rtc::CritScope cs(&crit_);
+  const int index = FindParticipant(*participant);
+  if (index < 0) {
+    if (!anonymous)
+      return 0;
+    // Setting anonymous status is only possible if MixerParticipant is
+    // already registered.
+    LOG(LS_WARNING)
+        << "Participant must be registered before turning it into anonymous.";
+    return -1;
+  }
+  participants_[index].anonymous = anonymous;
+  return 0;
+}
+
+bool MultiThreadedMixerImpl::AnonymousMixabilityStatus(
+    const MixerParticipant& participant) const {
+  rtc::CritScope cs(&crit_);
+  const int index = FindParticipant(participant);
+  return index >= 0 && participants_[index].anonymous;
+}
+
+int32_t MultiThreadedMixerImpl::SetMinimumMixingFrequency(Frequency freq) {
+  // Make sure that only allowed sampling frequencies are used. Use closest
+  // higher sampling frequency to avoid losing information.
+  if (static_cast<int>(freq) == 12000) {
+    freq = kWbInHz;
+  } else if (static_cast<int>(freq) == 24000) {
+    freq = kSwbInHz;
+  }
+  if (freq != kNbInHz && freq != kWbInHz && freq != kSwbInHz &&
+      freq != kFbInHz && freq != kLowestPossible) {
+    LOG(LS_ERROR) << "SetMinimumMixingFrequency incorrect frequency: " << freq;
+    return -1;
+  }
+  rtc::CritScope cs(&crit_);
+  minimum_mixing_frequency_ = freq;
+  return 0;
+}
+
+int MultiThreadedMixerImpl::MixingFrequency() const {
+  int highest_frequency = std::max(static_cast<int>(kNbInHz),
+                                   static_cast<int>(minimum_mixing_frequency_));
+  for (const ParticipantState& state : participants_) {
+    highest_frequency =
+        std::max(highest_frequency, state.participant->NeededFrequency(id_));
+  }
+  // Round up to a supported frequency, so that no audio is downsampled.
+  if (highest_frequency <= kNbInHz)
+    return kNbInHz;
+  if (highest_frequency <= kWbInHz)
+    return kWbInHz;
+  if (highest_frequency <= kSwbInHz)
+    return kSwbInHz;
+  return kFbInHz;
+}
+
+int MultiThreadedMixerImpl::FindParticipant(
+    const MixerParticipant& participant) const {
+  for (size_t i = 0; i < participants_.size(); ++i) {
+    if (participants_[i].participant == &participant)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+void MultiThreadedMixerImpl::RemoveParticipant(size_t index) {
+  // Participant is no longer mixed, reset to default.
+  participants_[index].participant->_mixHistory->ResetMixedStatus();
+  // The order of the participants doesn't matter, so fill the gap with the
+  // last one.
+  std::swap(participants_[index], participants_.back());
+  participants_.pop_back();
+}
+
+}  // namespace webrtc
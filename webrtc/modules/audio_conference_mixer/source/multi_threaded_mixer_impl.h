@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CONFERENCE_MIXER_SOURCE_MULTI_THREADED_MIXER_IMPL_H_
+#define WEBRTC_MODULES_AUDIO_CONFERENCE_MIXER_SOURCE_MULTI_THREADED_MIXER_IMPL_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/modules/audio_conference_mixer/include/audio_conference_mixer.h"
+#include "webrtc/modules/audio_conference_mixer/source/time_scheduler.h"
+#include "webrtc/modules/include/module_common_types.h"
+
+namespace webrtc {
+
+// Mixer for conferences with many participants, created by
+// AudioConferenceMixer::CreateMultiThreaded().
+//
+// The participants are split into one contiguous range per thread. Each
+// Process() call fetches and sums the audio of every range in parallel, adds up
+// the per-range sums into the full mix, and then, again in parallel, derives
+// each participant's N-minus-one mix by subtracting that participant's own
+// audio from the full sum. All participants with audio are mixed; there is no
+// kMaximumAmountOfMixedParticipants limit, and since the mixes are only
+// saturated, not passed through a limiter, anonymous mixability doesn't change
+// how a participant is mixed.
+//
+// GetAudioFrameWithMuted() is called on the worker threads, concurrently for
+// different participants, and must not call back into the mixer.
+class MultiThreadedMixerImpl : public AudioConferenceMixer {
+ public:
+  // AudioFrames are 10 ms.
+  enum { kProcessPeriodicityInMs = 10 };
+
+  // Mixes on |num_threads| threads in total: the thread calling Process(),
+  // and |num_threads| - 1 worker threads owned by the mixer.
+  MultiThreadedMixerImpl(int id, size_t num_threads);
+  ~MultiThreadedMixerImpl() override;
+
+  // Module functions.
+  int64_t TimeUntilNextProcess() override;
+  void Process() override;
+
+  // AudioConferenceMixer functions.
+  int32_t RegisterMixedStreamCallback(
+      AudioMixerOutputReceiver* receiver) override;
+  int32_t UnRegisterMixedStreamCallback() override;
+  int32_t SetMixabilityStatus(MixerParticipant* participant,
+                              bool mixable) override;
+  bool MixabilityStatus(const MixerParticipant& participant) const override;
+  int32_t SetAnonymousMixabilityStatus(MixerParticipant* participant,
+                                       bool anonymous) override;
+  bool AnonymousMixabilityStatus(
+      const MixerParticipant& participant) const override;
+  int32_t SetMinimumMixingFrequency(Frequency freq) override;
+
+ private:
+  class Worker;
+
+  enum class Phase { kFetch, kAccumulate, kSubtract };
+
+  struct ParticipantState {
+    explicit ParticipantState(MixerParticipant* participant);
+
+    MixerParticipant* participant;
+    bool anonymous;
+    // True if |frame| holds audio that is part of the current mix.
+    bool contributes;
+    // The participant's audio, and the mix of everyone else's audio.
+    std::unique_ptr<AudioFrame> frame;
+    std::unique_ptr<AudioFrame> n_minus_one_frame;
+  };
+
+  // Runs |phase| for every partition, one on the calling thread and the rest
+  // on the worker threads, and returns once all partitions are done.
+  void RunPhase(Phase phase);
+  // Runs the current phase on the participants of |partition|. Called on the
+  // thread calling Process() for partition 0 and on a worker for the others.
+  void RunPartition(size_t partition);
+
+  void FetchAudio(size_t begin, size_t end);
+  void Accumulate(size_t begin, size_t end, int32_t* sum) const;
+  void Subtract(size_t begin, size_t end);
+
+  // Returns the sample rate needed by the participants, at least
+  // |minimum_mixing_frequency_|.
+  int MixingFrequency() const;
+  // Returns the index of |participant| in |participants_|, or -1.
+  int FindParticipant(const MixerParticipant& participant) const;
+  void RemoveParticipant(size_t index);
+
+  const int id_;
+  TimeScheduler time_scheduler_;
+
+  // Held for the duration of Process(). Besides the Process() thread only the
+  // workers access the state below, while Process() waits for them.
+  rtc::CriticalSection crit_;
+  AudioMixerOutputReceiver* receiver_;
+  Frequency minimum_mixing_frequency_;
+  uint32_t timestamp_;
+
+  std::vector<ParticipantState> participants_;
+
+  // The format of the current mix.
+  int sample_rate_hz_;
+  size_t samples_per_channel_;
+  size_t num_channels_;
+
+  // kMaxDataSizeSamples sums for each partition, followed by the full sum.
+  std::vector<int32_t> sums_;
+  AudioFrame mixed_frame_;
+  std::vector<const AudioFrame*> n_minus_one_frames_;
+
+  Phase phase_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  volatile int pending_workers_;
+  rtc::Event workers_done_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MultiThreadedMixerImpl);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_CONFERENCE_MIXER_SOURCE_MULTI_THREADED_MIXER_IMPL_H_
@@ -0,0 +1,195 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_conference_mixer/source/participant_fetcher.h"
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/timeutils.h"
+
+namespace webrtc {
+
+// Runs queued requests every time it is started, until the queue is empty.
+class ParticipantFetcher::Worker {
+ public:
+  explicit Worker(ParticipantFetcher* fetcher)
+      : fetcher_(fetcher),
+        start_(false, false),
+        quit_(0),
+        thread_(&Worker::Run, this, "AudioFetchWorker") {
+    thread_.Start();
+    thread_.SetPriority(rtc::kHighPriority);
+  }
+
+  ~Worker() {
+    rtc::AtomicOps::ReleaseStore(&quit_, 1);
+    start_.Set();
+    thread_.Stop();
+  }
+
+  void Start() { start_.Set(); }
+
+ private:
+  static bool Run(void* obj) { return static_cast<Worker*>(obj)->RunOnce(); }
+
+  bool RunOnce() {
+    start_.Wait(rtc::Event::kForever);
+    if (rtc::AtomicOps::AcquireLoad(&quit_))
+      return false;
+    while (fetcher_->RunOne()) {
+    }
+    return true;
+  }
+
+  ParticipantFetcher* const fetcher_;
+  rtc::Event start_;
+  volatile int quit_;
+  rtc::PlatformThread thread_;
+};
+
+ParticipantFetcher::Request::Request(MixerParticipant* participant)
+    : participant(participant),
+      state(State::kIdle),
+      info(MixerParticipant::AudioFrameInfo::kError),
+      last_id(-1) {}
+
+ParticipantFetcher::ParticipantFetcher(int id,
+                                       size_t num_threads,
+                                       int deadline_ms)
+    : id_(id),
+      deadline_ms_(deadline_ms),
+      num_running_(0),
+      request_done_(false, false) {
+  for (size_t i = 1; i < num_threads; ++i)
+    workers_.push_back(std::unique_ptr<Worker>(new Worker(this)));
+}
+
+ParticipantFetcher::~ParticipantFetcher() {
+  // Let the workers finish any late requests before the requests go away.
+  workers_.clear();
+}
+
+void ParticipantFetcher::Fetch(
+    const std::vector<MixerParticipant*>& participants,
+    int sample_rate_hz) {
+  const int64_t start_ms = rtc::TimeMillis();
+  {
+    rtc::CritScope cs(&crit_);
+    for (MixerParticipant* participant : participants) {
+      std::unique_ptr<Request>& request = requests_[participant];
+      if (!request)
+        request.reset(new Request(participant));
+      // A request still running or done from the previous round is left
+      // alone; its result is used for this round.
+      if (request->state == Request::State::kIdle) {
+        request->frame.sample_rate_hz_ = sample_rate_hz;
+        request->state = Request::State::kQueued;
+        queue_.push_back(request.get());
+      }
+    }
+  }
+  for (const auto& worker : workers_)
+    worker->Start();
+
+  while (rtc::TimeMillis() - start_ms < deadline_ms_ && RunOne()) {
+  }
+
+  while (true) {
+    {
+      rtc::CritScope cs(&crit_);
+      const int64_t remaining_ms = deadline_ms_ - (rtc::TimeMillis() - start_ms);
+      if (Finished() || remaining_ms <= 0) {
+        // Requests that were never started are dropped; the participant gets
+        // a muted frame and is asked again next round.
+        for (Request* request : queue_)
+          request->state = Request::State::kIdle;
+        queue_.clear();
+        return;
+      }
+    }
+    request_done_.Wait(static_cast<int>(
+        deadline_ms_ - (rtc::TimeMillis() - start_ms)));
+  }
+}
+
+MixerParticipant::AudioFrameInfo ParticipantFetcher::TakeFrame(
+    MixerParticipant* participant,
+    int sample_rate_hz,
+    AudioFrame* frame) {
+  rtc::CritScope cs(&crit_);
+  auto it = requests_.find(participant);
+  if (it == requests_.end())
+    return MixerParticipant::AudioFrameInfo::kError;
+  Request* request = it->second.get();
+  if (request->state == Request::State::kDone) {
+    request->state = Request::State::kIdle;
+    if (request->info != MixerParticipant::AudioFrameInfo::kError)
+      frame->CopyFrom(request->frame);
+    return request->info;
+  }
+  if (request->last_id < 0)
+    return MixerParticipant::AudioFrameInfo::kError;
+  frame->UpdateFrame(request->last_id, 0, nullptr,
+                     static_cast<size_t>(sample_rate_hz / 100),
+                     sample_rate_hz, AudioFrame::kNormalSpeech,
+                     AudioFrame::kVadPassive, 1);
+  return MixerParticipant::AudioFrameInfo::kMuted;
+}
+
+void ParticipantFetcher::RemoveParticipant(MixerParticipant* participant) {
+  while (true) {
+    {
+      rtc::CritScope cs(&crit_);
+      auto it = requests_.find(participant);
+      if (it == requests_.end())
+        return;
+      if (it->second->state != Request::State::kRunning) {
+        RTC_DCHECK(it->second->state != Request::State::kQueued);
+        requests_.erase(it);
+        return;
+      }
+    }
+    request_done_.Wait(rtc::Event::kForever);
+  }
+}
+
+bool ParticipantFetcher::RunOne() {
+  Request* request;
+  {
+    rtc::CritScope cs(&crit_);
+    if (queue_.empty())
+      return false;
+    request = queue_.front();
+    queue_.pop_front();
+    request->state = Request::State::kRunning;
+    ++num_running_;
+  }
+
+  const MixerParticipant::AudioFrameInfo info =
+      request->participant->GetAudioFrameWithMuted(id_, &request->frame);
+
+  {
+    rtc::CritScope cs(&crit_);
+    request->info = info;
+    if (info != MixerParticipant::AudioFrameInfo::kError)
+      request->last_id = request->frame.id_;
+    request->state = Request::State::kDone;
+    --num_running_;
+  }
+  request_done_.Set();
+  return true;
+}
+
+bool ParticipantFetcher::Finished() const {
+  return queue_.empty() && num_running_ == 0;
+}
+
+}  // namespace webrtc
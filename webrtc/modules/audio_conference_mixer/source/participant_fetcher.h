@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CONFERENCE_MIXER_SOURCE_PARTICIPANT_FETCHER_H_
+#define WEBRTC_MODULES_AUDIO_CONFERENCE_MIXER_SOURCE_PARTICIPANT_FETCHER_H_
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/modules/audio_conference_mixer/include/audio_conference_mixer_defines.h"
+#include "webrtc/modules/include/module_common_types.h"
+
+namespace webrtc {
+
+// Calls GetAudioFrameWithMuted() for a set of participants in parallel, on the
+// thread calling Fetch() and on a pool of worker threads, and gives up waiting
+// for the participants that haven't delivered when the deadline expires.
+//
+// A participant that misses the deadline gets a muted frame from
+// TakeFrame() instead. Its fetch keeps running, and the frame it eventually
+// delivers is used in the next round instead of fetching a new one, so the
+// participant's audio is delayed by a frame rather than losing one.
+//
+// Not thread-safe; the mixer serializes the calls.
+class ParticipantFetcher {
+ public:
+  // Uses the thread calling Fetch() and |num_threads| - 1 worker threads.
+  ParticipantFetcher(int id, size_t num_threads, int deadline_ms);
+  ~ParticipantFetcher();
+
+  // Fetches 10 ms of audio at |sample_rate_hz| from each of |participants|,
+  // and returns when all are done or after the deadline.
+  void Fetch(const std::vector<MixerParticipant*>& participants,
+             int sample_rate_hz);
+
+  // Moves the audio fetched from |participant| to |frame|. If it hasn't been
+  // delivered in time, |frame| is set to a muted frame with the id_ of the
+  // participant's earlier frames; if there are none, kError is returned.
+  MixerParticipant::AudioFrameInfo TakeFrame(MixerParticipant* participant,
+                                             int sample_rate_hz,
+                                             AudioFrame* frame);
+
+  // Waits for any fetch from |participant| to finish and forgets it. Must be
+  // called before a removed participant may be destroyed.
+  void RemoveParticipant(MixerParticipant* participant);
+
+ private:
+  class Worker;
+
+  struct Request {
+    enum class State { kIdle, kQueued, kRunning, kDone };
+
+    explicit Request(MixerParticipant* participant);
+
+    MixerParticipant* const participant;
+    State state;
+    AudioFrame frame;
+    MixerParticipant::AudioFrameInfo info;
+    // The id_ of the last frame the participant delivered, or -1.
+    int last_id;
+  };
+
+  // Runs one queued request, if any. Returns false if the queue was empty.
+  bool RunOne();
+  bool Finished() const EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  const int id_;
+  const int deadline_ms_;
+
+  rtc::CriticalSection crit_;
+  std::map<MixerParticipant*, std::unique_ptr<Request>> requests_
+      GUARDED_BY(crit_);
+  std::deque<Request*> queue_ GUARDED_BY(crit_);
+  int num_running_ GUARDED_BY(crit_);
+  // Signaled every time a request finishes.
+  rtc::Event request_done_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ParticipantFetcher);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_CONFERENCE_MIXER_SOURCE_PARTICIPANT_FETCHER_H_
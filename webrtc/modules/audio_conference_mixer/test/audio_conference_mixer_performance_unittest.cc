@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/audio_conference_mixer/include/audio_conference_mixer.h"
+#include "webrtc/modules/audio_conference_mixer/include/audio_conference_mixer_defines.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+const int kSampleRateHz = 48000;
+const size_t kSamplesPerChannel = kSampleRateHz / 100;
+const int kNumIterations = 50;
+
+// Participant that returns the same, random, frame on every call.
+class FixedFrameParticipant : public MixerParticipant {
+ public:
+  FixedFrameParticipant(int id, Random* random) {
+    frame_.UpdateFrame(id, 0, nullptr, kSamplesPerChannel, kSampleRateHz,
+                       AudioFrame::kNormalSpeech, AudioFrame::kVadActive);
+    for (size_t i = 0; i < kSamplesPerChannel; ++i)
+      frame_.data_[i] = static_cast<int16_t>(random->Rand(0, 2000)) - 1000;
+  }
+
+  AudioFrameInfo GetAudioFrameWithMuted(int32_t id,
+                                        AudioFrame* audio_frame) override {
+    audio_frame->CopyFrom(frame_);
+    return AudioFrameInfo::kNormal;
+  }
+
+  int32_t NeededFrequency(int32_t id) const override { return kSampleRateHz; }
+
+  const AudioFrame& frame() const { return frame_; }
+
+ private:
+  AudioFrame frame_;
+};
+
+class NullOutputReceiver : public AudioMixerOutputReceiver {
+ public:
+  void NewMixedAudio(const int32_t id,
+                     const AudioFrame& general_audio_frame,
+                     const AudioFrame** unique_audio_frames,
+                     const uint32_t size) override {}
+};
+
+// Returns the average Process() time in microseconds when mixing
+// |participants| on |num_threads| threads.
+size_t MeasureMixerUs(
+    const std::vector<std::unique_ptr<FixedFrameParticipant>>& participants,
+    size_t num_threads) {
+  std::unique_ptr<AudioConferenceMixer> mixer(
+      AudioConferenceMixer::CreateMultiThreaded(0, num_threads));
+  NullOutputReceiver receiver;
+  EXPECT_EQ(0, mixer->RegisterMixedStreamCallback(&receiver));
+  for (const auto& participant : participants)
+    EXPECT_EQ(0, mixer->SetMixabilityStatus(participant.get(), true));
+
+  // Warm up, so that the ramp in isn't measured.
+  mixer->Process();
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumIterations; ++i)
+    mixer->Process();
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+
+  for (const auto& participant : participants)
+    EXPECT_EQ(0, mixer->SetMixabilityStatus(participant.get(), false));
+  EXPECT_EQ(0, mixer->UnRegisterMixedStreamCallback());
+  return static_cast<size_t>(elapsed_ns / (1000 * kNumIterations));
+}
+
+// Returns the average time in microseconds to compute every N-minus-one mix by
+// summing all other participants for each listener, as a baseline.
+size_t MeasureRecomputedMixesUs(
+    const std::vector<std::unique_ptr<FixedFrameParticipant>>& participants) {
+  std::vector<int32_t> sum(kSamplesPerChannel);
+  std::vector<int16_t> mix(kSamplesPerChannel);
+  int64_t checksum = 0;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int k = 0; k < kNumIterations; ++k) {
+    for (size_t listener = 0; listener < participants.size(); ++listener) {
+      std::fill(sum.begin(), sum.end(), 0);
+      for (size_t i = 0; i < participants.size(); ++i) {
+        if (i == listener)
+          continue;
+        const int16_t* data = participants[i]->frame().data_;
+        for (size_t j = 0; j < kSamplesPerChannel; ++j)
+          sum[j] += data[j];
+      }
+      for (size_t j = 0; j < kSamplesPerChannel; ++j)
+        mix[j] = ClampToInt16(sum[j]);
+      checksum += mix[0];
+    }
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  // Use the result so the loops aren't optimized away.
+  EXPECT_NE(0, checksum + 1);
+  return static_cast<size_t>(elapsed_ns / (1000 * kNumIterations));
+}
+
+void RunBenchmark(size_t num_participants) {
+  Random random(0x1234);
+  std::vector<std::unique_ptr<FixedFrameParticipant>> participants;
+  for (size_t i = 0; i < num_participants; ++i) {
+    participants.push_back(std::unique_ptr<FixedFrameParticipant>(
+        new FixedFrameParticipant(static_cast<int>(i), &random)));
+  }
+
+  const std::string modifier = "_" + rtc::ToString(num_participants);
+  test::PrintResult("audio_mixer_process", modifier, "recomputed_mixes",
+                    MeasureRecomputedMixesUs(participants), "us", false);
+  const size_t kNumThreads[] = {1, 2, 4};
+  for (size_t num_threads : kNumThreads) {
+    test::PrintResult("audio_mixer_process", modifier,
+                      "threads_" + rtc::ToString(num_threads),
+                      MeasureMixerUs(participants, num_threads), "us", true);
+  }
+}
+}  // namespace
+
+TEST(AudioConferenceMixerPerformanceTest, Mix50Participants) {
+  RunBenchmark(50);
+}
+
+TEST(AudioConferenceMixerPerformanceTest, Mix100Participants) {
+  RunBenchmark(100);
+}
+
+TEST(AudioConferenceMixerPerformanceTest, Mix200Participants) {
+  RunBenchmark(200);
+}
+
+TEST(AudioConferenceMixerPerformanceTest, Mix500Participants) {
+  RunBenchmark(500);
+}
+
+}  // namespace webrtc
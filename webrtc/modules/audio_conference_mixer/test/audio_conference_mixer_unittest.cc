@@ -9,8 +9,11 @@
  */
 
 #include <memory>
+#include <vector>
 
 #include "testing/gmock/include/gmock/gmock.h"
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/event.h"
 #include "webrtc/modules/audio_conference_mixer/include/audio_conference_mixer.h"
 #include "webrtc/modules/audio_conference_mixer/include/audio_conference_mixer_defines.h"
 
@@ -21,6 +24,13 @@ using testing::AtLeast;
 using testing::Invoke;
 using testing::Return;
 
+namespace {
+// Index of the sample to check after mixing; the first 80 samples may be
+// modified by a ramped-in window.
+const size_t kCheckedSample = 80;
+const int kSampleRateHz = 32000;
+}  // namespace
+
 class MockAudioMixerOutputReceiver : public AudioMixerOutputReceiver {
  public:
   MOCK_METHOD4(NewMixedAudio, void(const int32_t id,
@@ -48,6 +58,88 @@ class MockMixerParticipant : public MixerParticipant {
   }
 };
 
+// Mixer participant that sends muted frames.
+class MutedMixerParticipant : public MockMixerParticipant {
+ public:
+  AudioFrameInfo GetAudioFrameWithMuted(int32_t id,
+                                        AudioFrame* audio_frame) override {
+    MockMixerParticipant::GetAudioFrameWithMuted(id, audio_frame);
+    return AudioFrameInfo::kMuted;
+  }
+};
+
+// Mixer participant whose GetAudioFrameWithMuted() blocks until released,
+// while blocking is enabled.
+class BlockingMixerParticipant : public MockMixerParticipant {
+ public:
+  BlockingMixerParticipant()
+      : block_(0), release_(false, false), done_(false, false) {}
+
+  AudioFrameInfo GetAudioFrameWithMuted(int32_t id,
+                                        AudioFrame* audio_frame) override {
+    const bool block = rtc::AtomicOps::AcquireLoad(&block_) != 0;
+    if (block)
+      release_.Wait(rtc::Event::kForever);
+    AudioFrameInfo info =
+        MockMixerParticipant::GetAudioFrameWithMuted(id, audio_frame);
+    if (block)
+      done_.Set();
+    return info;
+  }
+
+  void set_block(bool block) {
+    rtc::AtomicOps::ReleaseStore(&block_, block ? 1 : 0);
+  }
+  // Lets a blocked call return, and waits until it has.
+  void ReleaseAndWait() {
+    release_.Set();
+    done_.Wait(rtc::Event::kForever);
+  }
+
+ private:
+  volatile int block_;
+  rtc::Event release_;
+  rtc::Event done_;
+};
+
+// Stores the checked sample of the general and the unique mixed frames.
+class MixedSampleReceiver : public AudioMixerOutputReceiver {
+ public:
+  void NewMixedAudio(const int32_t id,
+                     const AudioFrame& general_audio_frame,
+                     const AudioFrame** unique_audio_frames,
+                     const uint32_t size) override {
+    num_channels = general_audio_frame.num_channels_;
+    general_sample = general_audio_frame.data_[kCheckedSample];
+    unique_ids.clear();
+    unique_samples.clear();
+    for (uint32_t i = 0; i < size; ++i) {
+      unique_ids.push_back(unique_audio_frames[i]->id_);
+      unique_samples.push_back(unique_audio_frames[i]->data_[kCheckedSample]);
+    }
+  }
+
+  size_t num_channels = 0;
+  int16_t general_sample = 0;
+  std::vector<int> unique_ids;
+  std::vector<int16_t> unique_samples;
+};
+
+void SetUpParticipant(int id,
+                      int16_t sample,
+                      MockMixerParticipant* participant) {
+  AudioFrame* frame = participant->fake_frame();
+  frame->id_ = id;
+  frame->sample_rate_hz_ = kSampleRateHz;
+  frame->speech_type_ = AudioFrame::kNormalSpeech;
+  frame->vad_activity_ = AudioFrame::kVadActive;
+  frame->num_channels_ = 1;
+  frame->samples_per_channel_ = kSampleRateHz / 100;
+  frame->data_[kCheckedSample] = sample;
+  EXPECT_CALL(*participant, NeededFrequency(_))
+      .WillRepeatedly(Return(kSampleRateHz));
+}
+
 TEST(AudioConferenceMixer, AnonymousAndNamed) {
   const int kId = 1;
   // Should not matter even if partipants are more than
@@ -163,4 +255,166 @@ TEST(AudioConferenceMixer, LargestEnergyVadActiveMixed) {
   EXPECT_EQ(0, mixer->UnRegisterMixedStreamCallback());
 }
 
+TEST(AudioConferenceMixer, ParallelFetchMixesLargestEnergyVadActive) {
+  const int kId = 1;
+  const int kParticipants =
+      AudioConferenceMixer::kMaximumAmountOfMixedParticipants + 3;
+
+  // The deadline is generous so that a loaded machine doesn't fail the test.
+  std::unique_ptr<AudioConferenceMixer> mixer(
+      AudioConferenceMixer::Create(kId, 3, 1000));
+  MockAudioMixerOutputReceiver output_receiver;
+  EXPECT_EQ(0, mixer->RegisterMixedStreamCallback(&output_receiver));
+
+  MockMixerParticipant participants[kParticipants];
+  for (int i = 0; i < kParticipants; ++i) {
+    SetUpParticipant(i, i, &participants[i]);
+    EXPECT_EQ(0, mixer->SetMixabilityStatus(&participants[i], true));
+    EXPECT_CALL(participants[i], GetAudioFrame(_, _)).Times(1);
+  }
+  participants[kParticipants - 1].fake_frame()->vad_activity_ =
+      AudioFrame::kVadPassive;
+  EXPECT_CALL(output_receiver, NewMixedAudio(_, _, _, _)).Times(1);
+
+  mixer->Process();
+
+  // Same selection as with serial fetching: the three active participants
+  // with the highest energy.
+  for (int i = 0; i < kParticipants; ++i) {
+    const bool expect_mixed =
+        i != kParticipants - 1 &&
+        i >= kParticipants - 1 -
+                 AudioConferenceMixer::kMaximumAmountOfMixedParticipants;
+    EXPECT_EQ(expect_mixed, participants[i].IsMixed()) << "Participant #" << i;
+  }
+
+  for (int i = 0; i < kParticipants; ++i)
+    EXPECT_EQ(0, mixer->SetMixabilityStatus(&participants[i], false));
+  EXPECT_EQ(0, mixer->UnRegisterMixedStreamCallback());
+}
+
+TEST(AudioConferenceMixer, ParallelFetchDoesNotWaitForLateParticipant) {
+  const int kId = 1;
+  std::unique_ptr<AudioConferenceMixer> mixer(
+      AudioConferenceMixer::Create(kId, 2, 5));
+  MockAudioMixerOutputReceiver output_receiver;
+  EXPECT_EQ(0, mixer->RegisterMixedStreamCallback(&output_receiver));
+  EXPECT_CALL(output_receiver, NewMixedAudio(_, _, _, _)).Times(5);
+
+  MockMixerParticipant fast;
+  BlockingMixerParticipant slow;
+  SetUpParticipant(0, 100, &fast);
+  SetUpParticipant(1, 200, &slow);
+  EXPECT_EQ(0, mixer->SetMixabilityStatus(&fast, true));
+  EXPECT_EQ(0, mixer->SetMixabilityStatus(&slow, true));
+
+  // The fast participant is asked for audio every round. The slow one is not
+  // asked again while its call is running, and the frame it delivers late is
+  // used for the following round instead of asking again.
+  EXPECT_CALL(fast, GetAudioFrame(_, _)).Times(5);
+  EXPECT_CALL(slow, GetAudioFrame(_, _)).Times(3);
+
+  mixer->Process();
+  EXPECT_TRUE(slow.IsMixed());
+
+  // The slow participant misses the deadline, twice. The mixer doesn't block,
+  // and mixes a muted frame in its place.
+  slow.set_block(true);
+  mixer->Process();
+  mixer->Process();
+  EXPECT_TRUE(slow.IsMixed());
+
+  slow.set_block(false);
+  slow.ReleaseAndWait();
+  mixer->Process();
+  mixer->Process();
+
+  EXPECT_EQ(0, mixer->SetMixabilityStatus(&fast, false));
+  EXPECT_EQ(0, mixer->SetMixabilityStatus(&slow, false));
+  EXPECT_EQ(0, mixer->UnRegisterMixedStreamCallback());
+}
+
+TEST(AudioConferenceMixer, MultiThreadedMixesAllParticipants) {
+  const int kId = 1;
+  const int kParticipants =
+      AudioConferenceMixer::kMaximumAmountOfMixedParticipants + 7;
+
+  std::unique_ptr<AudioConferenceMixer> mixer(
+      AudioConferenceMixer::CreateMultiThreaded(kId, 4));
+  MixedSampleReceiver output_receiver;
+  EXPECT_EQ(0, mixer->RegisterMixedStreamCallback(&output_receiver));
+
+  MockMixerParticipant participants[kParticipants];
+  int sum = 0;
+  for (int i = 0; i < kParticipants; ++i) {
+    SetUpParticipant(i, 10 * (i + 1), &participants[i]);
+    sum += 10 * (i + 1);
+    EXPECT_EQ(0, mixer->SetMixabilityStatus(&participants[i], true));
+    EXPECT_CALL(participants[i], GetAudioFrame(_, _)).Times(2);
+  }
+  // Passive VAD doesn't keep a participant out of the mix.
+  participants[0].fake_frame()->vad_activity_ = AudioFrame::kVadPassive;
+
+  for (int k = 0; k < 2; ++k) {
+    mixer->Process();
+
+    EXPECT_EQ(1u, output_receiver.num_channels);
+    EXPECT_EQ(sum, output_receiver.general_sample);
+    ASSERT_EQ(static_cast<size_t>(kParticipants),
+              output_receiver.unique_samples.size());
+    for (int i = 0; i < kParticipants; ++i) {
+      const int id = output_receiver.unique_ids[i];
+      ASSERT_GE(id, 0);
+      ASSERT_LT(id, kParticipants);
+      // Each participant gets everyone's audio but its own.
+      EXPECT_EQ(sum - 10 * (id + 1), output_receiver.unique_samples[i]);
+      EXPECT_TRUE(participants[i].IsMixed());
+    }
+  }
+
+  EXPECT_EQ(0, mixer->UnRegisterMixedStreamCallback());
+}
+
+TEST(AudioConferenceMixer, MultiThreadedMutedAndStereoParticipants) {
+  const int kId = 1;
+  std::unique_ptr<AudioConferenceMixer> mixer(
+      AudioConferenceMixer::CreateMultiThreaded(kId, 2));
+  MixedSampleReceiver output_receiver;
+  EXPECT_EQ(0, mixer->RegisterMixedStreamCallback(&output_receiver));
+
+  MockMixerParticipant mono;
+  MockMixerParticipant stereo;
+  MutedMixerParticipant muted;
+  SetUpParticipant(0, 100, &mono);
+  SetUpParticipant(1, 0, &stereo);
+  SetUpParticipant(2, 1000, &muted);
+  // Mono sample kCheckedSample ends up as the left channel of stereo sample
+  // kCheckedSample / 2.
+  stereo.fake_frame()->num_channels_ = 2;
+  stereo.fake_frame()->data_[kCheckedSample] = 20;
+  EXPECT_CALL(mono, GetAudioFrame(_, _)).Times(1);
+  EXPECT_CALL(stereo, GetAudioFrame(_, _)).Times(1);
+  EXPECT_CALL(muted, GetAudioFrame(_, _)).Times(1);
+  EXPECT_EQ(0, mixer->SetMixabilityStatus(&mono, true));
+  EXPECT_EQ(0, mixer->SetMixabilityStatus(&stereo, true));
+  EXPECT_EQ(0, mixer->SetMixabilityStatus(&muted, true));
+
+  mixer->Process();
+
+  // The mono participant's sample kCheckedSample / 2 is zero, so only the
+  // stereo participant is heard at the checked sample.
+  EXPECT_EQ(2u, output_receiver.num_channels);
+  EXPECT_EQ(20, output_receiver.general_sample);
+  ASSERT_EQ(3u, output_receiver.unique_samples.size());
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(output_receiver.unique_ids[i] == 1 ? 0 : 20,
+              output_receiver.unique_samples[i]);
+  }
+  EXPECT_TRUE(mono.IsMixed());
+  EXPECT_TRUE(stereo.IsMixed());
+  EXPECT_FALSE(muted.IsMixed());
+
+  EXPECT_EQ(0, mixer->UnRegisterMixedStreamCallback());
+}
+
 }  // namespace webrtc
@@ -11,12 +11,17 @@
 #include "webrtc/modules/audio_device/audio_device_buffer.h"
 
 #include <assert.h>
+#include <math.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include "webrtc/base/format_macros.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/modules/audio_device/audio_device_config.h"
 #include "webrtc/system_wrappers/include/critical_section_wrapper.h"
 #include "webrtc/system_wrappers/include/logging.h"
+#include "webrtc/system_wrappers/include/rw_lock_wrapper.h"
 #include "webrtc/system_wrappers/include/trace.h"
 
 namespace webrtc {
@@ -24,6 +29,94 @@ namespace webrtc {
 static const int kHighDelayThresholdMs = 300;
 static const int kLogHighDelayIntervalFrames = 500;  // 5 seconds.
 
+// ----------------------------------------------------------------------------
+//  AudioCallbackTimer
+// ----------------------------------------------------------------------------
+
+AudioCallbackTimer::AudioCallbackTimer()
+{
+    Reset();
+}
+
+void AudioCallbackTimer::AddCallback(int64_t start_us, int64_t end_us)
+{
+    if (_lastStartUs < 0)
+    {
+        _intervalStartUs = start_us;
+    }
+    else
+    {
+        const int64_t interval_us = start_us - _lastStartUs;
+        _sumIntervalUs += interval_us;
+        _sumSquaredIntervalUs += interval_us * interval_us;
+        _maxIntervalUs = std::max(_maxIntervalUs, interval_us);
+        ++_numIntervals;
+    }
+    _lastStartUs = start_us;
+
+    const int64_t callback_us = end_us - start_us;
+    _sumCallbackUs += callback_us;
+    _maxCallbackUs = std::max(_maxCallbackUs, callback_us);
+    ++_numCallbacks;
+
+    if (start_us - _intervalStartUs <
+        kStatsIntervalMs * rtc::kNumMicrosecsPerMillisec)
+    {
+        return;
+    }
+
+    AudioCallbackStats stats;
+    stats.num_callbacks = _numCallbacks;
+    stats.average_callback_us =
+        static_cast<int>(_sumCallbackUs / _numCallbacks);
+    stats.max_callback_us = static_cast<int>(_maxCallbackUs);
+    if (_numIntervals > 0)
+    {
+        const double mean = static_cast<double>(_sumIntervalUs) / _numIntervals;
+        const double variance =
+            static_cast<double>(_sumSquaredIntervalUs) / _numIntervals -
+            mean * mean;
+        stats.average_interval_us = static_cast<int>(mean + 0.5);
+        stats.max_interval_us = static_cast<int>(_maxIntervalUs);
+        stats.interval_jitter_us =
+            static_cast<int>(sqrt(std::max(variance, 0.0)) + 0.5);
+    }
+    {
+        rtc::CritScope lock(&_statsLock);
+        _stats = stats;
+    }
+
+    _intervalStartUs = start_us;
+    _numCallbacks = 0;
+    _numIntervals = 0;
+    _sumIntervalUs = 0;
+    _sumSquaredIntervalUs = 0;
+    _maxIntervalUs = 0;
+    _sumCallbackUs = 0;
+    _maxCallbackUs = 0;
+}
+
+void AudioCallbackTimer::Reset()
+{
+    _lastStartUs = -1;
+    _intervalStartUs = 0;
+    _numCallbacks = 0;
+    _numIntervals = 0;
+    _sumIntervalUs = 0;
+    _sumSquaredIntervalUs = 0;
+    _maxIntervalUs = 0;
+    _sumCallbackUs = 0;
+    _maxCallbackUs = 0;
+    rtc::CritScope lock(&_statsLock);
+    _stats = AudioCallbackStats();
+}
+
+void AudioCallbackTimer::GetStats(AudioCallbackStats* stats) const
+{
+    rtc::CritScope lock(&_statsLock);
+    *stats = _stats;
+}
+
 // ----------------------------------------------------------------------------
 //  ctor
 // ----------------------------------------------------------------------------
@@ -31,7 +124,7 @@ static const int kLogHighDelayIntervalFrames = 500;  // 5 seconds.
 AudioDeviceBuffer::AudioDeviceBuffer() :
     _id(-1),
     _critSect(*CriticalSectionWrapper::CreateCriticalSection()),
-    _critSectCb(*CriticalSectionWrapper::CreateCriticalSection()),
+    _cbLock(*RWLockWrapper::CreateRWLock()),
     _ptrCbAudioTransport(NULL),
     _recSampleRate(0),
     _playSampleRate(0),
@@ -80,7 +173,7 @@ AudioDeviceBuffer::~AudioDeviceBuffer()
     }
 
     delete &_critSect;
-    delete &_critSectCb;
+    delete &_cbLock;
 }
 
 // ----------------------------------------------------------------------------
@@ -99,7 +192,7 @@ void AudioDeviceBuffer::SetId(uint32_t id)
 
 int32_t AudioDeviceBuffer::RegisterAudioCallback(AudioTransport* audioCallback)
 {
-    CriticalSectionScoped lock(&_critSectCb);
+    WriteLockScoped lock(_cbLock);
     _ptrCbAudioTransport = audioCallback;
 
     return 0;
@@ -112,6 +205,7 @@ int32_t AudioDeviceBuffer::RegisterAudioCallback(AudioTransport* audioCallback)
 int32_t AudioDeviceBuffer::InitPlayout()
 {
     WEBRTC_TRACE(kTraceMemory, kTraceAudioDevice, _id, "%s", __FUNCTION__);
+    _playTimer.Reset();
     return 0;
 }
 
@@ -122,6 +216,7 @@ int32_t AudioDeviceBuffer::InitPlayout()
 int32_t AudioDeviceBuffer::InitRecording()
 {
     WEBRTC_TRACE(kTraceMemory, kTraceAudioDevice, _id, "%s", __FUNCTION__);
+    _recTimer.Reset();
     return 0;
 }
 
@@ -439,7 +534,7 @@ int32_t AudioDeviceBuffer::SetRecordedBuffer(const void* audioBuffer,
 
 int32_t AudioDeviceBuffer::DeliverRecordedData()
 {
-    CriticalSectionScoped lock(&_critSectCb);
+    ReadLockScoped lock(_cbLock);
 
     // Ensure that user has initialized all essential members
     if ((_recSampleRate == 0)     ||
@@ -461,6 +556,7 @@ int32_t AudioDeviceBuffer::DeliverRecordedData()
     uint32_t newMicLevel(0);
     uint32_t totalDelayMS = _playDelayMS +_recDelayMS;
 
+    const int64_t startUs = static_cast<int64_t>(rtc::TimeMicros());
     res = _ptrCbAudioTransport->RecordedDataIsAvailable(&_recBuffer[0],
                                                         _recSamples,
                                                         _recBytesPerSample,
@@ -471,6 +567,8 @@ int32_t AudioDeviceBuffer::DeliverRecordedData()
                                                         _currentMicLevel,
                                                         _typingStatus,
                                                         newMicLevel);
+    _recTimer.AddCallback(startUs,
+                          static_cast<int64_t>(rtc::TimeMicros()));
     if (res != -1)
     {
         _newMicLevel = newMicLevel;
@@ -523,7 +621,7 @@ int32_t AudioDeviceBuffer::RequestPlayoutData(size_t nSamples)
 
     size_t nSamplesOut(0);
 
-    CriticalSectionScoped lock(&_critSectCb);
+    ReadLockScoped lock(_cbLock);
 
     if (_ptrCbAudioTransport == NULL)
     {
@@ -536,6 +634,7 @@ int32_t AudioDeviceBuffer::RequestPlayoutData(size_t nSamples)
         uint32_t res(0);
         int64_t elapsed_time_ms = -1;
         int64_t ntp_time_ms = -1;
+        const int64_t startUs = static_cast<int64_t>(rtc::TimeMicros());
         res = _ptrCbAudioTransport->NeedMorePlayData(_playSamples,
                                                      playBytesPerSample,
                                                      playChannels,
@@ -544,6 +643,8 @@ int32_t AudioDeviceBuffer::RequestPlayoutData(size_t nSamples)
                                                      nSamplesOut,
                                                      &elapsed_time_ms,
                                                      &ntp_time_ms);
+        _playTimer.AddCallback(startUs,
+                               static_cast<int64_t>(rtc::TimeMicros()));
         if (res != 0)
         {
             WEBRTC_TRACE(kTraceError, kTraceAudioDevice, _id, "NeedMorePlayData() failed");
@@ -581,4 +682,24 @@ int32_t AudioDeviceBuffer::GetPlayoutData(void* audioBuffer)
     return static_cast<int32_t>(_playSamples);
 }
 
+// ----------------------------------------------------------------------------
+//  GetPlayoutCallbackStats
+// ----------------------------------------------------------------------------
+
+void AudioDeviceBuffer::GetPlayoutCallbackStats(
+    AudioCallbackStats* stats) const
+{
+    _playTimer.GetStats(stats);
+}
+
+// ----------------------------------------------------------------------------
+//  GetRecordCallbackStats
+// ----------------------------------------------------------------------------
+
+void AudioDeviceBuffer::GetRecordCallbackStats(
+    AudioCallbackStats* stats) const
+{
+    _recTimer.GetStats(stats);
+}
+
 }  // namespace webrtc
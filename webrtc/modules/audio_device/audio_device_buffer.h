@@ -11,18 +11,58 @@
 #ifndef WEBRTC_AUDIO_DEVICE_AUDIO_DEVICE_BUFFER_H
 #define WEBRTC_AUDIO_DEVICE_AUDIO_DEVICE_BUFFER_H
 
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
 #include "webrtc/modules/audio_device/include/audio_device.h"
 #include "webrtc/system_wrappers/include/file_wrapper.h"
 #include "webrtc/typedefs.h"
 
 namespace webrtc {
 class CriticalSectionWrapper;
+class RWLockWrapper;
 
 const uint32_t kPulsePeriodMs = 1000;
 const size_t kMaxBufferSizeBytes = 3840; // 10ms in stereo @ 96kHz
 
 class AudioDeviceObserver;
 
+// Measures the timing of the audio callbacks of one direction. AddCallback()
+// is called on the audio thread and only touches state owned by that thread,
+// except for publishing a snapshot once per |kStatsIntervalMs|, so that
+// readers on other threads rarely contend with the audio thread.
+class AudioCallbackTimer
+{
+public:
+    static const int kStatsIntervalMs = 1000;
+
+    AudioCallbackTimer();
+
+    // Reports a callback that ran from |start_us| to |end_us|.
+    void AddCallback(int64_t start_us, int64_t end_us);
+    // Starts over, e.g. when the stream is restarted. Must not be called
+    // while AddCallback() may run.
+    void Reset();
+
+    // Returns the statistics of the last complete interval.
+    void GetStats(AudioCallbackStats* stats) const;
+
+private:
+    // Start of the previous callback, or -1.
+    int64_t _lastStartUs;
+    // Start of the current statistics interval.
+    int64_t _intervalStartUs;
+    int _numCallbacks;
+    int _numIntervals;
+    int64_t _sumIntervalUs;
+    int64_t _sumSquaredIntervalUs;
+    int64_t _maxIntervalUs;
+    int64_t _sumCallbackUs;
+    int64_t _maxCallbackUs;
+
+    rtc::CriticalSection _statsLock;
+    AudioCallbackStats _stats GUARDED_BY(_statsLock);
+};
+
 class AudioDeviceBuffer
 {
 public:
@@ -70,10 +110,15 @@ public:
 
     int32_t SetTypingStatus(bool typingStatus);
 
+    void GetPlayoutCallbackStats(AudioCallbackStats* stats) const;
+    void GetRecordCallbackStats(AudioCallbackStats* stats) const;
+
 private:
     int32_t                   _id;
     CriticalSectionWrapper&         _critSect;
-    CriticalSectionWrapper&         _critSectCb;
+    // Protects |_ptrCbAudioTransport|. The recording and the playout threads
+    // only read it, so they take it shared and never wait for each other.
+    RWLockWrapper&                  _cbLock;
 
     AudioTransport*                 _ptrCbAudioTransport;
 
@@ -116,6 +161,9 @@ private:
     int _recDelayMS;
     int _clockDrift;
     int high_delay_counter_;
+
+    AudioCallbackTimer _recTimer;
+    AudioCallbackTimer _playTimer;
 };
 
 }  // namespace webrtc
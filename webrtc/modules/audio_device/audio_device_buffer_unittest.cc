@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_device/audio_device_buffer.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace webrtc {
+
+namespace {
+const int64_t kIntervalUs = AudioCallbackTimer::kStatsIntervalMs * 1000;
+}  // namespace
+
+TEST(AudioCallbackTimerTest, NoStatsBeforeFirstInterval) {
+  AudioCallbackTimer timer;
+  for (int64_t t = 0; t < kIntervalUs; t += 10000)
+    timer.AddCallback(t, t + 100);
+  AudioCallbackStats stats;
+  timer.GetStats(&stats);
+  EXPECT_EQ(0, stats.num_callbacks);
+}
+
+TEST(AudioCallbackTimerTest, RegularCallbacks) {
+  AudioCallbackTimer timer;
+  for (int64_t t = 0; t <= kIntervalUs; t += 10000)
+    timer.AddCallback(t, t + 300);
+  AudioCallbackStats stats;
+  timer.GetStats(&stats);
+  EXPECT_EQ(101, stats.num_callbacks);
+  EXPECT_EQ(10000, stats.average_interval_us);
+  EXPECT_EQ(10000, stats.max_interval_us);
+  EXPECT_EQ(0, stats.interval_jitter_us);
+  EXPECT_EQ(300, stats.average_callback_us);
+  EXPECT_EQ(300, stats.max_callback_us);
+}
+
+// A native buffer of 20 ms gives two 10 ms callbacks back to back every 20 ms.
+TEST(AudioCallbackTimerTest, BurstyCallbacks) {
+  AudioCallbackTimer timer;
+  for (int64_t t = 0; t <= kIntervalUs; t += 20000) {
+    timer.AddCallback(t, t + 100);
+    timer.AddCallback(t + 100, t + 200);
+  }
+  AudioCallbackStats stats;
+  timer.GetStats(&stats);
+  EXPECT_EQ(101, stats.num_callbacks);
+  EXPECT_EQ(10000, stats.average_interval_us);
+  EXPECT_EQ(19900, stats.max_interval_us);
+  EXPECT_EQ(9900, stats.interval_jitter_us);
+  EXPECT_EQ(100, stats.average_callback_us);
+
+  timer.Reset();
+  timer.GetStats(&stats);
+  EXPECT_EQ(0, stats.num_callbacks);
+}
+
+}  // namespace webrtc
@@ -1914,6 +1914,18 @@ int AudioDeviceModuleImpl::GetRecordAudioParameters(
   return _ptrAudioDevice->GetRecordAudioParameters(params);
 }
 
+int AudioDeviceModuleImpl::GetPlayoutCallbackStats(
+    AudioCallbackStats* stats) const {
+  _audioDeviceBuffer.GetPlayoutCallbackStats(stats);
+  return 0;
+}
+
+int AudioDeviceModuleImpl::GetRecordCallbackStats(
+    AudioCallbackStats* stats) const {
+  _audioDeviceBuffer.GetRecordCallbackStats(stats);
+  return 0;
+}
+
 // ============================================================================
 //                                 Private Methods
 // ============================================================================
@@ -188,6 +188,8 @@ class AudioDeviceModuleImpl : public AudioDeviceModule {
 
   int GetPlayoutAudioParameters(AudioParameters* params) const override;
   int GetRecordAudioParameters(AudioParameters* params) const override;
+  int GetPlayoutCallbackStats(AudioCallbackStats* stats) const override;
+  int GetRecordCallbackStats(AudioCallbackStats* stats) const override;
 
   int32_t Id() { return _id; }
 #if defined(WEBRTC_ANDROID)
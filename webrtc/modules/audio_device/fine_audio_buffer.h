@@ -64,12 +64,19 @@ class FineAudioBuffer {
   // Example: buffer size is 5ms => call #1 stores 5ms of data, call #2 stores
   // 5ms of data and sends a total of 10ms to WebRTC and clears the intenal
   // cache. Call #3 restarts the scheme above.
+  // Only the samples that straddle two calls are copied; whole 10ms chunks
+  // are handed to the ADB directly from |buffer|.
   void DeliverRecordedData(const int8_t* buffer,
                            size_t size_in_bytes,
                            int playout_delay_ms,
                            int record_delay_ms);
 
  private:
+  // Hands one 10ms chunk of recorded audio to the ADB.
+  void DeliverRecorded10Ms(const int8_t* buffer,
+                           int playout_delay_ms,
+                           int record_delay_ms);
+
   // Device buffer that works with 10ms chunks of data both for playout and
   // for recording. I.e., the WebRTC side will always be asked for audio to be
   // played out in 10ms chunks and recorded audio will be sent to WebRTC in
@@ -92,16 +99,13 @@ class FineAudioBuffer {
   size_t playout_cached_buffer_start_;
   // Number of bytes stored in output (contain samples to be played out) cache.
   size_t playout_cached_bytes_;
-  // Storage for input samples that are about to be delivered to the WebRTC
-  // ADB or remains from the last successful delivery of a 10ms audio buffer.
+  // Storage for the recorded samples that did not fill a complete 10ms chunk
+  // in the last DeliverRecordedData() call. Complete chunks are delivered to
+  // the ADB straight from the caller's buffer.
   std::unique_ptr<int8_t[]> record_cache_buffer_;
-  // Required (max) size in bytes of the |record_cache_buffer_|.
-  const size_t required_record_buffer_size_bytes_;
-  // Number of bytes in input (contains recorded samples) cache.
+  // Number of bytes in input (contains recorded samples) cache. Always less
+  // than |bytes_per_10_ms_| between calls.
   size_t record_cached_bytes_;
-  // Read and write pointers used in the buffering scheme on the recording side.
-  size_t record_read_pos_;
-  size_t record_write_pos_;
 };
 
 }  // namespace webrtc
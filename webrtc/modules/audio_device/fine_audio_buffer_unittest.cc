@@ -20,6 +20,7 @@
 using ::testing::_;
 using ::testing::AtLeast;
 using ::testing::InSequence;
+using ::testing::NiceMock;
 using ::testing::Return;
 
 namespace webrtc {
@@ -143,4 +144,39 @@ TEST(FineBufferTest, GreaterThan10ms) {
   RunFineBufferTest(kSampleRate, kFrameSizeSamples);
 }
 
+// Recorded buffers that hold whole 10ms chunks are handed to the device buffer
+// in place, while the samples that straddle two calls go through the cache.
+TEST(FineBufferTest, Complete10msChunksAreNotCopied) {
+  const int kSampleRate = 48000;
+  const size_t kBytesPer10Ms = kSampleRate / 100 * sizeof(int16_t);
+  NiceMock<MockAudioDeviceBuffer> audio_device_buffer;
+  FineAudioBuffer fine_buffer(&audio_device_buffer, 2 * kBytesPer10Ms,
+                              kSampleRate);
+  std::unique_ptr<int8_t[]> in_buffer(new int8_t[3 * kBytesPer10Ms]);
+  UpdateInputBuffer(in_buffer.get(), 0, 3 * kBytesPer10Ms);
+
+  {
+    InSequence s;
+    EXPECT_CALL(audio_device_buffer,
+                SetRecordedBuffer(in_buffer.get(), kSampleRate / 100));
+    EXPECT_CALL(audio_device_buffer,
+                SetRecordedBuffer(in_buffer.get() + kBytesPer10Ms,
+                                  kSampleRate / 100));
+  }
+  fine_buffer.DeliverRecordedData(in_buffer.get(), 2 * kBytesPer10Ms, 0, 0);
+  ::testing::Mock::VerifyAndClearExpectations(&audio_device_buffer);
+
+  // Half a chunk is cached, and is delivered from the cache once the next
+  // call completes it.
+  EXPECT_CALL(audio_device_buffer, SetRecordedBuffer(_, _)).Times(0);
+  fine_buffer.DeliverRecordedData(in_buffer.get() + 2 * kBytesPer10Ms,
+                                  kBytesPer10Ms / 2, 0, 0);
+  ::testing::Mock::VerifyAndClearExpectations(&audio_device_buffer);
+  EXPECT_CALL(audio_device_buffer, SetRecordedBuffer(_, kSampleRate / 100))
+      .WillOnce(VerifyInputBuffer(2, kSampleRate / 100));
+  fine_buffer.DeliverRecordedData(
+      in_buffer.get() + 2 * kBytesPer10Ms + kBytesPer10Ms / 2,
+      kBytesPer10Ms / 2, 0, 0);
+}
+
 }  // namespace webrtc
@@ -213,6 +213,15 @@ class AudioDeviceModule : public RefCountedModule {
     return -1;
   }
 
+  // Timing statistics for the audio callbacks, updated once per second.
+  // TODO(henrika): Make pure virtual after updating Chromium.
+  virtual int GetPlayoutCallbackStats(AudioCallbackStats* stats) const {
+    return -1;
+  }
+  virtual int GetRecordCallbackStats(AudioCallbackStats* stats) const {
+    return -1;
+  }
+
  protected:
   virtual ~AudioDeviceModule() {}
 };
@@ -135,6 +135,23 @@ class AudioTransport {
   virtual ~AudioTransport() {}
 };
 
+// Timing of the 10 ms callbacks from the audio device into the AudioTransport,
+// as measured by the AudioDeviceBuffer over the last second.
+struct AudioCallbackStats {
+  // Number of callbacks in the measurement interval.
+  int num_callbacks = 0;
+  // Time from the start of one callback to the start of the next one. This is
+  // nominally 10 ms; a large spread means that the native audio layer runs
+  // with buffers that are not a multiple of 10 ms, or that it is late.
+  int average_interval_us = 0;
+  int max_interval_us = 0;
+  // Standard deviation of the interval.
+  int interval_jitter_us = 0;
+  // Time spent in the AudioTransport callback.
+  int average_callback_us = 0;
+  int max_callback_us = 0;
+};
+
 // Helper class for storage of fundamental audio parameters such as sample rate,
 // number of channels, native buffer size etc.
 // Note that one audio frame can contain more than one channel sample and each
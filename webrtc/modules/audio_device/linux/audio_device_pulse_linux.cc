@@ -10,7 +10,10 @@
 
 #include <assert.h>
 
+#include <algorithm>
+
 #include "webrtc/base/checks.h"
+#include "webrtc/base/timeutils.h"
 
 #include "webrtc/modules/audio_device/audio_device_config.h"
 #include "webrtc/modules/audio_device/linux/audio_device_pulse_linux.h"
@@ -83,6 +86,12 @@ AudioDeviceLinuxPulse::AudioDeviceLinuxPulse(const int32_t id) :
     _tempSampleDataSize(0),
     _configuredLatencyPlay(0),
     _configuredLatencyRec(0),
+    _minLatencyPlay(0),
+    _latencyStepPlay(0),
+    _lastPlayLatencyChangeMs(0),
+    _playLatencyDecreaseIntervalMs(
+        WEBRTC_PA_PLAYBACK_LATENCY_DECREASE_INTERVAL_MSECS),
+    _lastPlayLatencyChangeWasDecrease(false),
     _paDeviceIndex(-1),
     _paStateChanged(false),
     _paMainloop(NULL),
@@ -1200,6 +1209,14 @@ int32_t AudioDeviceLinuxPulse::InitPlayout()
                                  _playBufferAttr.minreq;
 
         _configuredLatencyPlay = latency;
+        _minLatencyPlay = latency;
+        _latencyStepPlay = bytesPerSec *
+                           WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS /
+                           WEBRTC_PA_MSECS_PER_SEC;
+        _lastPlayLatencyChangeMs = rtc::TimeMillis();
+        _playLatencyDecreaseIntervalMs =
+            WEBRTC_PA_PLAYBACK_LATENCY_DECREASE_INTERVAL_MSECS;
+        _lastPlayLatencyChangeWasDecrease = false;
     }
 
     // num samples in bytes * num channels
@@ -2304,24 +2321,29 @@ void AudioDeviceLinuxPulse::PaStreamUnderflowCallbackHandler()
     }
 
     // Otherwise reconfigure the stream with a higher target latency.
-
-    const pa_sample_spec *spec = LATE(pa_stream_get_sample_spec)(_playStream);
-    if (!spec)
+    const int64_t nowMs = rtc::TimeMillis();
+    if (_lastPlayLatencyChangeWasDecrease &&
+        nowMs - _lastPlayLatencyChangeMs < _playLatencyDecreaseIntervalMs)
     {
-        WEBRTC_TRACE(kTraceError, kTraceAudioDevice, _id,
-                     "  pa_stream_get_sample_spec()");
-        return;
+        // The last decrease did not hold; wait longer before the next one.
+        _playLatencyDecreaseIntervalMs =
+            std::min(2 * _playLatencyDecreaseIntervalMs,
+                     WEBRTC_PA_PLAYBACK_LATENCY_MAX_DECREASE_INTERVAL_MSECS);
     }
 
-    size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
-    uint32_t newLatency = _configuredLatencyPlay + bytesPerSec *
-                          WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS /
-                          WEBRTC_PA_MSECS_PER_SEC;
+    if (SetPlayoutLatency(_configuredLatencyPlay + _latencyStepPlay))
+    {
+        _lastPlayLatencyChangeMs = nowMs;
+        _lastPlayLatencyChangeWasDecrease = false;
+    }
+}
 
+bool AudioDeviceLinuxPulse::SetPlayoutLatency(uint32_t latency)
+{
     // Set the play buffer attributes
-    _playBufferAttr.maxlength = newLatency;
-    _playBufferAttr.tlength = newLatency;
-    _playBufferAttr.minreq = newLatency / WEBRTC_PA_PLAYBACK_REQUEST_FACTOR;
+    _playBufferAttr.maxlength = latency;
+    _playBufferAttr.tlength = latency;
+    _playBufferAttr.minreq = latency / WEBRTC_PA_PLAYBACK_REQUEST_FACTOR;
     _playBufferAttr.prebuf = _playBufferAttr.tlength - _playBufferAttr.minreq;
 
     pa_operation *op = LATE(pa_stream_set_buffer_attr)(_playStream,
@@ -2331,14 +2353,53 @@ void AudioDeviceLinuxPulse::PaStreamUnderflowCallbackHandler()
     {
         WEBRTC_TRACE(kTraceError, kTraceAudioDevice, _id,
                      "  pa_stream_set_buffer_attr()");
-        return;
+        return false;
     }
 
     // Don't need to wait for this to complete.
     LATE(pa_operation_unref)(op);
 
     // Save the new latency in case we underflow again.
-    _configuredLatencyPlay = newLatency;
+    _configuredLatencyPlay = latency;
+    return true;
+}
+
+void AudioDeviceLinuxPulse::MaybeDecreasePlayoutLatency()
+{
+    PaLock();
+    if (_configuredLatencyPlay != WEBRTC_PA_NO_LATENCY_REQUIREMENTS &&
+        static_cast<uint32_t>(_configuredLatencyPlay) > _minLatencyPlay)
+    {
+        const int64_t nowMs = rtc::TimeMillis();
+        if (nowMs - _lastPlayLatencyChangeMs >= _playLatencyDecreaseIntervalMs)
+        {
+            const uint32_t configured = _configuredLatencyPlay;
+            const uint32_t latency =
+                configured - _minLatencyPlay > _latencyStepPlay ?
+                configured - _latencyStepPlay : _minLatencyPlay;
+            WEBRTC_TRACE(kTraceInfo, kTraceAudioDevice, _id,
+                         "  lowering playout latency to %u bytes", latency);
+            if (SetPlayoutLatency(latency))
+            {
+                _lastPlayLatencyChangeMs = nowMs;
+                _lastPlayLatencyChangeWasDecrease = true;
+            }
+        }
+    }
+    PaUnLock();
+}
+
+uint32_t AudioDeviceLinuxPulse::PlayoutDelayMs()
+{
+    uint32_t delayMs = (uint32_t) (LatencyUsecs(_playStream) / 1000);
+    if (_playbackBufferSize > 0)
+    {
+        // Audio that VoE has delivered but that has not been written to the
+        // stream yet.
+        delayMs += 10 * (_playbackBufferSize - _playbackBufferUnused) /
+                   _playbackBufferSize;
+    }
+    return delayMs;
 }
 
 void AudioDeviceLinuxPulse::EnableReadCallback()
@@ -2449,14 +2510,14 @@ int32_t AudioDeviceLinuxPulse::ReadRecordedData(
 
     // Account for the peeked data and the used data.
     uint32_t recDelay = (uint32_t) ((LatencyUsecs(_recStream)
-        / 1000) + 10 * ((size + _recordBufferUsed) / _recordBufferSize));
+        / 1000) + 10 * (size + _recordBufferUsed) / _recordBufferSize);
 
     _sndCardRecDelay = recDelay;
 
     if (_playStream)
     {
         // Get the playout delay.
-        _sndCardPlayDelay = (uint32_t) (LatencyUsecs(_playStream) / 1000);
+        _sndCardPlayDelay = PlayoutDelayMs();
     }
 
     if (_recordBufferUsed > 0)
@@ -2713,10 +2774,11 @@ bool AudioDeviceLinuxPulse::PlayThreadProcess()
         if (!_recording)
         {
             // Update the playout delay
-            _sndCardPlayDelay = (uint32_t) (LatencyUsecs(_playStream)
-                / 1000);
+            _sndCardPlayDelay = PlayoutDelayMs();
         }
 
+        MaybeDecreasePlayoutLatency();
+
         if (_playbackBufferUnused < _playbackBufferSize)
         {
 
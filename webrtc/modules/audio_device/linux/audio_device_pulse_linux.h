@@ -58,6 +58,14 @@ const uint32_t WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS = 20;
 // latency that is greater by this amount.
 const uint32_t WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS = 20;
 
+// Underflows are often caused by a temporary load spike, so the latency is
+// brought back down by the same step once the stream has played this long
+// without underflowing. If lowering the latency leads to an underflow within
+// the same time, the wait before the next attempt is doubled, up to the
+// maximum, so that a stream on a loaded system settles instead of toggling.
+const int64_t WEBRTC_PA_PLAYBACK_LATENCY_DECREASE_INTERVAL_MSECS = 10000;
+const int64_t WEBRTC_PA_PLAYBACK_LATENCY_MAX_DECREASE_INTERVAL_MSECS = 160000;
+
 // We also need to configure a suitable request size. Too small and we'd burn
 // CPU from the overhead of transfering small amounts of data at once. Too large
 // and the amount of data remaining in the buffer right before refilling it
@@ -251,6 +259,15 @@ private:
     void PaStreamWriteCallbackHandler(size_t buffer_space);
     static void PaStreamUnderflowCallback(pa_stream *unused, void *pThis);
     void PaStreamUnderflowCallbackHandler();
+    // Reconfigures the playback stream with target latency |latency| (bytes).
+    // Must be called with the PulseAudio lock held.
+    bool SetPlayoutLatency(uint32_t latency);
+    // Lowers the playback latency if the stream has not underflowed for a
+    // while. Called periodically from the play thread.
+    void MaybeDecreasePlayoutLatency();
+    // Latency of the playback stream including the audio that is still in
+    // |_playBuffer|, in milliseconds.
+    uint32_t PlayoutDelayMs();
     void EnableReadCallback();
     void DisableReadCallback();
     static void PaStreamReadCallback(pa_stream *unused1, size_t unused2,
@@ -353,6 +370,12 @@ private:
     size_t _tempSampleDataSize;
     int32_t _configuredLatencyPlay;
     int32_t _configuredLatencyRec;
+    // Playback latency adaptation, guarded by the PulseAudio lock.
+    uint32_t _minLatencyPlay;
+    uint32_t _latencyStepPlay;
+    int64_t _lastPlayLatencyChangeMs;
+    int64_t _playLatencyDecreaseIntervalMs;
+    bool _lastPlayLatencyChangeWasDecrease;
 
     // PulseAudio
     uint16_t _paDeviceIndex;
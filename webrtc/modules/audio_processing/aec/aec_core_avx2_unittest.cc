@@ -0,0 +1,142 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_processing/aec/aec_core.h"
+#include "webrtc/modules/audio_processing/aec/aec_core_optimized_methods.h"
+#include "webrtc/modules/audio_processing/aec/aec_rdft.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+
+const int kNumPartitions[] = {kNormalNumPartitions, kExtendedNumPartitions};
+const size_t kBufferLength = 2 * kExtendedNumPartitions * PART_LEN1;
+
+struct FilterKernels {
+  WebRtcAecFilterFar filter_far;
+  WebRtcAecScaleErrorSignal scale_error_signal;
+  WebRtcAecFilterAdaptation filter_adaptation;
+};
+
+FilterKernels GetKernels(void (*init)(void)) {
+  const FilterKernels saved = {WebRtcAec_FilterFar, WebRtcAec_ScaleErrorSignal,
+                               WebRtcAec_FilterAdaptation};
+  init();
+  const FilterKernels kernels = {WebRtcAec_FilterFar,
+                                 WebRtcAec_ScaleErrorSignal,
+                                 WebRtcAec_FilterAdaptation};
+  WebRtcAec_FilterFar = saved.filter_far;
+  WebRtcAec_ScaleErrorSignal = saved.scale_error_signal;
+  WebRtcAec_FilterAdaptation = saved.filter_adaptation;
+  return kernels;
+}
+
+void FillRandom(Random* random, float* data, size_t length) {
+  for (size_t i = 0; i < length; ++i)
+    data[i] = static_cast<float>(random->Gaussian(0, 1));
+}
+
+class AecCoreAvx2Test : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    aec_rdft_init();
+    sse2_ = GetKernels(WebRtcAec_InitAec_SSE2);
+    avx2_ = GetKernels(WebRtcAec_InitAec_AVX2);
+  }
+
+  FilterKernels sse2_;
+  FilterKernels avx2_;
+};
+
+}  // namespace
+
+// The AVX2 kernels do the same operations in the same order as the SSE2 ones,
+// only on twice as many bins at a time, so the results must be identical.
+TEST_F(AecCoreAvx2Test, FilterFarIsBitExact) {
+  if (!WebRtc_GetCPUInfo(kAVX2))
+    return;
+  Random random(42);
+  float x_fft_buf[2][kExtendedNumPartitions * PART_LEN1];
+  float h_fft_buf[2][kExtendedNumPartitions * PART_LEN1];
+  FillRandom(&random, &x_fft_buf[0][0], kBufferLength);
+  FillRandom(&random, &h_fft_buf[0][0], kBufferLength);
+  for (int num_partitions : kNumPartitions) {
+    for (int block_pos = 0; block_pos < num_partitions; block_pos += 5) {
+      float y_fft_sse2[2][PART_LEN1];
+      FillRandom(&random, &y_fft_sse2[0][0], 2 * PART_LEN1);
+      float y_fft_avx2[2][PART_LEN1];
+      memcpy(y_fft_avx2, y_fft_sse2, sizeof(y_fft_avx2));
+
+      sse2_.filter_far(num_partitions, block_pos, x_fft_buf, h_fft_buf,
+                       y_fft_sse2);
+      avx2_.filter_far(num_partitions, block_pos, x_fft_buf, h_fft_buf,
+                       y_fft_avx2);
+      EXPECT_EQ(0, memcmp(y_fft_sse2, y_fft_avx2, sizeof(y_fft_sse2)));
+    }
+  }
+}
+
+TEST_F(AecCoreAvx2Test, ScaleErrorSignalIsBitExact) {
+  if (!WebRtc_GetCPUInfo(kAVX2))
+    return;
+  Random random(42);
+  // A threshold of one limits roughly half of the bins, so both branches of
+  // the kernel are exercised.
+  const float kErrorThreshold = 1.f;
+  const float kMu = 0.5f;
+  for (int i = 0; i < 10; ++i) {
+    float x_pow[PART_LEN1];
+    for (float& x : x_pow)
+      x = random.Rand<float>() + 0.5f;
+    float ef_sse2[2][PART_LEN1];
+    FillRandom(&random, &ef_sse2[0][0], 2 * PART_LEN1);
+    float ef_avx2[2][PART_LEN1];
+    memcpy(ef_avx2, ef_sse2, sizeof(ef_avx2));
+
+    sse2_.scale_error_signal(kMu, kErrorThreshold, x_pow, ef_sse2);
+    avx2_.scale_error_signal(kMu, kErrorThreshold, x_pow, ef_avx2);
+    EXPECT_EQ(0, memcmp(ef_sse2, ef_avx2, sizeof(ef_sse2)));
+  }
+}
+
+TEST_F(AecCoreAvx2Test, FilterAdaptationIsBitExact) {
+  if (!WebRtc_GetCPUInfo(kAVX2))
+    return;
+  Random random(42);
+  float x_fft_buf[2][kExtendedNumPartitions * PART_LEN1];
+  float e_fft[2][PART_LEN1];
+  FillRandom(&random, &x_fft_buf[0][0], kBufferLength);
+  FillRandom(&random, &e_fft[0][0], 2 * PART_LEN1);
+  for (int num_partitions : kNumPartitions) {
+    for (int block_pos = 0; block_pos < num_partitions; block_pos += 5) {
+      float h_fft_buf_sse2[2][kExtendedNumPartitions * PART_LEN1];
+      FillRandom(&random, &h_fft_buf_sse2[0][0], kBufferLength);
+      float h_fft_buf_avx2[2][kExtendedNumPartitions * PART_LEN1];
+      memcpy(h_fft_buf_avx2, h_fft_buf_sse2, sizeof(h_fft_buf_avx2));
+
+      sse2_.filter_adaptation(num_partitions, block_pos, x_fft_buf, e_fft,
+                              h_fft_buf_sse2);
+      avx2_.filter_adaptation(num_partitions, block_pos, x_fft_buf, e_fft,
+                              h_fft_buf_avx2);
+      EXPECT_EQ(0,
+                memcmp(h_fft_buf_sse2, h_fft_buf_avx2, sizeof(h_fft_buf_sse2)));
+    }
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+}  // namespace webrtc
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/audio_processing/aec/aec_core.h"
+#include "webrtc/modules/audio_processing/aec/aec_core_optimized_methods.h"
+#include "webrtc/modules/audio_processing/aec/aec_rdft.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+// The filter runs on 64 sample blocks of the 16 kHz band.
+const int kBlocksPerSecond = 16000 / PART_LEN;
+const int kNumSeconds = 20;
+
+// Runs the per-block filter kernels of the extended filter, which is what a
+// server cancelling many channels uses, and reports the CPU time spent per
+// second of audio for a single channel.
+void MeasureFilterKernels(const std::string& name) {
+  Random random(42);
+  float x_fft_buf[2][kExtendedNumPartitions * PART_LEN1];
+  float h_fft_buf[2][kExtendedNumPartitions * PART_LEN1];
+  float* const buffers[] = {&x_fft_buf[0][0], &h_fft_buf[0][0]};
+  for (float* buffer : buffers) {
+    for (int i = 0; i < 2 * kExtendedNumPartitions * PART_LEN1; ++i)
+      buffer[i] = static_cast<float>(random.Gaussian(0, 1e-3));
+  }
+  float x_pow[PART_LEN1];
+  for (float& x : x_pow)
+    x = random.Rand<float>() + 0.5f;
+
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int block = 0; block < kNumSeconds * kBlocksPerSecond; ++block) {
+    const int block_pos = block % kExtendedNumPartitions;
+    float ef[2][PART_LEN1] = {{0}};
+    WebRtcAec_FilterFar(kExtendedNumPartitions, block_pos, x_fft_buf,
+                        h_fft_buf, ef);
+    WebRtcAec_ScaleErrorSignal(0.4f, 1.5e-6f, x_pow, ef);
+    WebRtcAec_FilterAdaptation(kExtendedNumPartitions, block_pos, x_fft_buf,
+                               ef, h_fft_buf);
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+
+  test::PrintResult("aec_filter_kernels", "", name,
+                    static_cast<size_t>(elapsed_ns / kNumSeconds /
+                                        rtc::kNumNanosecsPerMicrosec),
+                    "us/s", true);
+}
+}  // namespace
+
+TEST(AecCorePerformanceTest, ExtendedFilterKernels) {
+  aec_rdft_init();
+  WebRtcAec_InitAec_SSE2();
+  MeasureFilterKernels("sse2");
+  if (WebRtc_GetCPUInfo(kAVX2)) {
+    WebRtcAec_InitAec_AVX2();
+    MeasureFilterKernels("avx2");
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+}  // namespace webrtc
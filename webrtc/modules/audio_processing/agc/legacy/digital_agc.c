@@ -21,6 +21,10 @@
 #endif
 
 #include "webrtc/modules/audio_processing/agc/legacy/gain_control.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+
+AgcCalculateEnvelope WebRtcAgc_CalculateEnvelope;
+AgcApplyGains WebRtcAgc_ApplyGains;
 
 // To generate the gaintable, copy&paste the following lines to a Matlab window:
 // MaxGain = 6; MinGain = 0; CompRatio = 3; Knee = 1;
@@ -244,6 +248,49 @@ int32_t WebRtcAgc_CalculateGainTable(int32_t* gainTable,       // Q16
   return 0;
 }
 
+// Computes the maximum energy of each sub frame. See AgcCalculateEnvelope.
+static void CalculateEnvelope(const int16_t* in,
+                              size_t subframe_length,
+                              int32_t* env) {
+  int16_t k;
+  size_t n;
+
+  // iterate over sub frames
+  for (k = 0; k < 10; k++) {
+    // iterate over samples
+    int32_t max_nrg = 0;
+    for (n = 0; n < subframe_length; n++) {
+      int32_t nrg = in[k * subframe_length + n] * in[k * subframe_length + n];
+      if (nrg > max_nrg) {
+        max_nrg = nrg;
+      }
+    }
+    env[k] = max_nrg;
+  }
+}
+
+// Applies the interpolated gains to sub frames 1 to 9. See AgcApplyGains.
+static void ApplyGains(const int32_t* gains,
+                       int16_t subframe_shift,
+                       int16_t* out) {
+  const size_t L = (size_t)1 << subframe_shift;
+  int32_t gain32, delta, tmp32;
+  int16_t k;
+  size_t n;
+
+  // iterate over subframes
+  for (k = 1; k < 10; k++) {
+    delta = (gains[k + 1] - gains[k]) * (1 << (4 - subframe_shift));
+    gain32 = gains[k] * (1 << 4);
+    // iterate over samples
+    for (n = 0; n < L; n++) {
+      tmp32 = out[k * L + n] * (gain32 >> 4);
+      out[k * L + n] = (int16_t)(tmp32 >> 16);
+      gain32 += delta;
+    }
+  }
+}
+
 int32_t WebRtcAgc_InitDigital(DigitalAgc* stt, int16_t agcMode) {
   if (agcMode == kAgcModeFixedDigital) {
     // start at minimum to find correct gain faster
@@ -264,6 +311,15 @@ int32_t WebRtcAgc_InitDigital(DigitalAgc* stt, int16_t agcMode) {
   WebRtcAgc_InitVad(&stt->vadNearend);
   WebRtcAgc_InitVad(&stt->vadFarend);
 
+  WebRtcAgc_CalculateEnvelope = CalculateEnvelope;
+  WebRtcAgc_ApplyGains = ApplyGains;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    WebRtcAgc_CalculateEnvelope = WebRtcAgc_CalculateEnvelopeSse2;
+    WebRtcAgc_ApplyGains = WebRtcAgc_ApplyGainsSse2;
+  }
+#endif
+
   return 0;
 }
 
@@ -288,7 +344,6 @@ int32_t WebRtcAgc_ProcessDigital(DigitalAgc* stt,
 
   int32_t out_tmp, tmp32;
   int32_t env[10];
-  int32_t max_nrg;
   int32_t cur_level;
   int32_t gain32, delta;
   int16_t logratio;
@@ -366,18 +421,7 @@ int32_t WebRtcAgc_ProcessDigital(DigitalAgc* stt,
           logratio, decay, stt->vadNearend.stdLongTerm);
 #endif
   // Find max amplitude per sub frame
-  // iterate over sub frames
-  for (k = 0; k < 10; k++) {
-    // iterate over samples
-    max_nrg = 0;
-    for (n = 0; n < L; n++) {
-      int32_t nrg = out[0][k * L + n] * out[0][k * L + n];
-      if (nrg > max_nrg) {
-        max_nrg = nrg;
-      }
-    }
-    env[k] = max_nrg;
-  }
+  WebRtcAgc_CalculateEnvelope(out[0], L, env);
 
   // Calculate gain per sub frame
   gains[0] = stt->gain;
@@ -498,12 +542,12 @@ int32_t WebRtcAgc_ProcessDigital(DigitalAgc* stt,
   stt->gain = gains[10];
 
   // Apply gain
-  // handle first sub frame separately
-  delta = (gains[1] - gains[0]) * (1 << (4 - L2));
-  gain32 = gains[0] * (1 << 4);
-  // iterate over samples
-  for (n = 0; n < L; n++) {
-    for (i = 0; i < num_bands; ++i) {
+  for (i = 0; i < num_bands; ++i) {
+    // handle first sub frame separately
+    delta = (gains[1] - gains[0]) * (1 << (4 - L2));
+    gain32 = gains[0] * (1 << 4);
+    // iterate over samples
+    for (n = 0; n < L; n++) {
       tmp32 = out[i][n] * ((gain32 + 127) >> 7);
       out_tmp = tmp32 >> 16;
       if (out_tmp > 4095) {
@@ -514,23 +558,10 @@ int32_t WebRtcAgc_ProcessDigital(DigitalAgc* stt,
         tmp32 = out[i][n] * (gain32 >> 4);
         out[i][n] = (int16_t)(tmp32 >> 16);
       }
-    }
-    //
-
-    gain32 += delta;
-  }
-  // iterate over subframes
-  for (k = 1; k < 10; k++) {
-    delta = (gains[k + 1] - gains[k]) * (1 << (4 - L2));
-    gain32 = gains[k] * (1 << 4);
-    // iterate over samples
-    for (n = 0; n < L; n++) {
-      for (i = 0; i < num_bands; ++i) {
-        tmp32 = out[i][k * L + n] * (gain32 >> 4);
-        out[i][k * L + n] = (int16_t)(tmp32 >> 16);
-      }
       gain32 += delta;
     }
+    // iterate over subframes
+    WebRtcAgc_ApplyGains(gains, L2, out[i]);
   }
 
   return 0;
@@ -76,4 +76,32 @@ int32_t WebRtcAgc_CalculateGainTable(int32_t* gainTable,         // Q16
                                      uint8_t limiterEnable,
                                      int16_t analogTarget);
 
+// Function pointers for the per-sample loops of WebRtcAgc_ProcessDigital(),
+// which have SSE2 versions. They are set up by WebRtcAgc_InitDigital() and
+// give bit-exact results on all platforms.
+
+// Computes the maximum energy of each of the 10 sub frames of
+// |subframe_length| samples in |in|.
+typedef void (*AgcCalculateEnvelope)(const int16_t* in,
+                                     size_t subframe_length,
+                                     int32_t* env);
+extern AgcCalculateEnvelope WebRtcAgc_CalculateEnvelope;
+
+// Applies the gains (Q16) interpolated from |gains|[k] to |gains|[k + 1] to
+// sub frame k of |out|, for the sub frames 1 to 9 of 2^|subframe_shift|
+// samples each.
+typedef void (*AgcApplyGains)(const int32_t* gains,
+                              int16_t subframe_shift,
+                              int16_t* out);
+extern AgcApplyGains WebRtcAgc_ApplyGains;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcAgc_CalculateEnvelopeSse2(const int16_t* in,
+                                     size_t subframe_length,
+                                     int32_t* env);
+void WebRtcAgc_ApplyGainsSse2(const int32_t* gains,
+                              int16_t subframe_shift,
+                              int16_t* out);
+#endif
+
 #endif  // WEBRTC_MODULES_AUDIO_PROCESSING_AGC_LEGACY_DIGITAL_AGC_H_
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * SSE2 versions of the per-sample loops of the digital AGC, eight samples at
+ * a time. They are bit-exact with the C versions in digital_agc.c.
+ */
+
+#include <emmintrin.h>
+
+#include "webrtc/modules/audio_processing/agc/legacy/digital_agc.h"
+
+void WebRtcAgc_CalculateEnvelopeSse2(const int16_t* in,
+                                     size_t subframe_length,
+                                     int32_t* env) {
+  int16_t k;
+  size_t n;
+
+  // The maximum energy is the square of either the largest or the smallest
+  // sample, which avoids the 32 bit products.
+  for (k = 0; k < 10; k++) {
+    const int16_t* subframe = &in[k * subframe_length];
+    __m128i max_v = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+    __m128i min_v = _mm_set1_epi16(WEBRTC_SPL_WORD16_MAX);
+    int32_t max_value, min_value;
+    for (n = 0; n + 8 <= subframe_length; n += 8) {
+      const __m128i x = _mm_loadu_si128((const __m128i*)&subframe[n]);
+      max_v = _mm_max_epi16(max_v, x);
+      min_v = _mm_min_epi16(min_v, x);
+    }
+    max_v = _mm_max_epi16(max_v, _mm_shuffle_epi32(max_v, 0x4E));
+    min_v = _mm_min_epi16(min_v, _mm_shuffle_epi32(min_v, 0x4E));
+    max_v = _mm_max_epi16(max_v, _mm_shuffle_epi32(max_v, 0xB1));
+    min_v = _mm_min_epi16(min_v, _mm_shuffle_epi32(min_v, 0xB1));
+    max_v = _mm_max_epi16(max_v, _mm_shufflelo_epi16(max_v, 0xB1));
+    min_v = _mm_min_epi16(min_v, _mm_shufflelo_epi16(min_v, 0xB1));
+    max_value = (int16_t)_mm_cvtsi128_si32(max_v);
+    min_value = (int16_t)_mm_cvtsi128_si32(min_v);
+    // Samples left over when the sub frame isn't a multiple of eight.
+    for (; n < subframe_length; n++) {
+      max_value = WEBRTC_SPL_MAX(max_value, subframe[n]);
+      min_value = WEBRTC_SPL_MIN(min_value, subframe[n]);
+    }
+    env[k] = WEBRTC_SPL_MAX(max_value * max_value, min_value * min_value);
+  }
+}
+
+// Packs the low 16 bits of the 32 bit elements of |a| and |b|.
+static inline __m128i PackLow16(__m128i a, __m128i b) {
+  a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+  b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+  return _mm_packs_epi32(a, b);
+}
+
+void WebRtcAgc_ApplyGainsSse2(const int32_t* gains,
+                              int16_t subframe_shift,
+                              int16_t* out) {
+  const size_t L = (size_t)1 << subframe_shift;
+  int16_t k;
+  size_t n;
+
+  // With the gain g = (hi << 16) + lo, where lo is unsigned,
+  // (x * g) >> 16 == x * hi + ((x * lo) >> 16). Only the low 16 bits of the
+  // result are kept, so both terms can be computed with 16 bit multiplies, the
+  // second as an unsigned high multiply corrected for negative x.
+  for (k = 1; k < 10; k++) {
+    const int32_t delta =
+        (gains[k + 1] - gains[k]) * (1 << (4 - subframe_shift));
+    const __m128i delta8 = _mm_set1_epi32(8 * delta);
+    // The gains of samples n to n + 3 and n + 4 to n + 7, in Q20.
+    __m128i gain32_0 = _mm_add_epi32(_mm_set1_epi32(gains[k] * (1 << 4)),
+                                     _mm_set_epi32(3 * delta, 2 * delta, delta,
+                                                   0));
+    __m128i gain32_1 = _mm_add_epi32(gain32_0, _mm_set1_epi32(4 * delta));
+    for (n = 0; n < L; n += 8) {
+      int16_t* samples = &out[k * L + n];
+      const __m128i g0 = _mm_srai_epi32(gain32_0, 4);
+      const __m128i g1 = _mm_srai_epi32(gain32_1, 4);
+      const __m128i hi = _mm_packs_epi32(_mm_srai_epi32(g0, 16),
+                                         _mm_srai_epi32(g1, 16));
+      const __m128i lo = PackLow16(g0, g1);
+      const __m128i x = _mm_loadu_si128((const __m128i*)samples);
+      const __m128i negative_lo = _mm_and_si128(_mm_srai_epi16(x, 15), lo);
+      __m128i y = _mm_mullo_epi16(x, hi);
+      y = _mm_add_epi16(y, _mm_sub_epi16(_mm_mulhi_epu16(x, lo), negative_lo));
+      _mm_storeu_si128((__m128i*)samples, y);
+      gain32_0 = _mm_add_epi32(gain32_0, delta8);
+      gain32_1 = _mm_add_epi32(gain32_1, delta8);
+    }
+  }
+}
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+extern "C" {
+#include "webrtc/modules/audio_processing/agc/legacy/digital_agc.h"
+}
+#include "webrtc/modules/audio_processing/agc/legacy/gain_control.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+
+const int kNumIterations = 1000;
+// 10 ms at 16 kHz and above.
+const size_t kMaxFrameLength = 160;
+
+void FillRandom(Random* random, int16_t* data, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    // Include the extreme values now and then.
+    const int choice = random->Rand(0, 20);
+    if (choice == 0) {
+      data[i] = -32768;
+    } else if (choice == 1) {
+      data[i] = 32767;
+    } else {
+      data[i] = random->Rand(-32768, 32767);
+    }
+  }
+}
+
+class DigitalAgcSse2Test : public ::testing::Test {
+ protected:
+  // Initializes a digital AGC with the C kernels selected and keeps them, so
+  // that they can be compared against the SSE2 kernels.
+  void SetUp() override {
+    WebRtc_CPUInfo get_cpu_info = WebRtc_GetCPUInfo;
+    WebRtc_GetCPUInfo = WebRtc_GetCPUInfoNoASM;
+    DigitalAgc agc;
+    ASSERT_EQ(0, WebRtcAgc_InitDigital(&agc, kAgcModeAdaptiveDigital));
+    calculate_envelope_c_ = WebRtcAgc_CalculateEnvelope;
+    apply_gains_c_ = WebRtcAgc_ApplyGains;
+    WebRtc_GetCPUInfo = get_cpu_info;
+  }
+
+  AgcCalculateEnvelope calculate_envelope_c_;
+  AgcApplyGains apply_gains_c_;
+};
+
+}  // namespace
+
+TEST_F(DigitalAgcSse2Test, CalculateEnvelopeIsBitExact) {
+  Random random(42);
+  for (size_t subframe_length = 8; subframe_length <= 16;
+       subframe_length += 8) {
+    for (int i = 0; i < kNumIterations; ++i) {
+      int16_t in[kMaxFrameLength];
+      FillRandom(&random, in, 10 * subframe_length);
+      int32_t env_c[10];
+      int32_t env_sse2[10];
+      calculate_envelope_c_(in, subframe_length, env_c);
+      WebRtcAgc_CalculateEnvelopeSse2(in, subframe_length, env_sse2);
+      ASSERT_EQ(0, memcmp(env_c, env_sse2, sizeof(env_c)));
+    }
+  }
+}
+
+TEST_F(DigitalAgcSse2Test, ApplyGainsIsBitExact) {
+  Random random(42);
+  for (int16_t subframe_shift = 3; subframe_shift <= 4; ++subframe_shift) {
+    const size_t frame_length = 10u << subframe_shift;
+    for (int i = 0; i < kNumIterations; ++i) {
+      // Gains in Q16 from -40 dB to +40 dB.
+      int32_t gains[11];
+      for (int k = 0; k < 11; ++k)
+        gains[k] = random.Rand(655, 6553600);
+      int16_t out_c[kMaxFrameLength];
+      FillRandom(&random, out_c, frame_length);
+      int16_t out_sse2[kMaxFrameLength];
+      memcpy(out_sse2, out_c, sizeof(out_c));
+      apply_gains_c_(gains, subframe_shift, out_c);
+      WebRtcAgc_ApplyGainsSse2(gains, subframe_shift, out_sse2);
+      ASSERT_EQ(0, memcmp(out_c, out_sse2, frame_length * sizeof(out_c[0])));
+    }
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+}  // namespace webrtc
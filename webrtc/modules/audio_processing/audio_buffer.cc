@@ -122,7 +122,7 @@ void AudioBuffer::CopyFrom(const float* const* data,
   const float* const* data_ptr = data;
   if (need_to_downmix) {
     DownmixToMono<float, float>(data, input_num_frames_, num_input_channels_,
-                                input_buffer_->fbuf()->channels()[0]);
+                                input_buffer_->fbuf_overwrite()->channels()[0]);
     data_ptr = input_buffer_->fbuf_const()->channels();
   }
 
@@ -141,7 +141,7 @@ void AudioBuffer::CopyFrom(const float* const* data,
   for (size_t i = 0; i < num_proc_channels_; ++i) {
     FloatToFloatS16(data_ptr[i],
                     proc_num_frames_,
-                    data_->fbuf()->channels()[i]);
+                    data_->fbuf_overwrite()->channels()[i]);
   }
 }
 
@@ -157,7 +157,7 @@ void AudioBuffer::CopyTo(const StreamConfig& stream_config,
     data_ptr = process_buffer_->channels();
   }
   for (size_t i = 0; i < num_channels_; ++i) {
-    FloatS16ToFloat(data_->fbuf()->channels()[i],
+    FloatS16ToFloat(data_->fbuf_const()->channels()[i],
                     proc_num_frames_,
                     data_ptr[i]);
   }
@@ -378,9 +378,9 @@ void AudioBuffer::DeinterleaveFrom(AudioFrame* frame) {
 
   int16_t* const* deinterleaved;
   if (input_num_frames_ == proc_num_frames_) {
-    deinterleaved = data_->ibuf()->channels();
+    deinterleaved = data_->ibuf_overwrite()->channels();
   } else {
-    deinterleaved = input_buffer_->ibuf()->channels();
+    deinterleaved = input_buffer_->ibuf_overwrite()->channels();
   }
   if (num_proc_channels_ == 1) {
     // Downmix and deinterleave simultaneously.
@@ -399,7 +399,7 @@ void AudioBuffer::DeinterleaveFrom(AudioFrame* frame) {
     for (size_t i = 0; i < num_proc_channels_; ++i) {
       input_resamplers_[i]->Resample(input_buffer_->fbuf_const()->channels()[i],
                                      input_num_frames_,
-                                     data_->fbuf()->channels()[i],
+                                     data_->fbuf_overwrite()->channels()[i],
                                      proc_num_frames_);
     }
   }
@@ -423,17 +423,18 @@ void AudioBuffer::InterleaveTo(AudioFrame* frame, bool data_changed) {
     }
     for (size_t i = 0; i < num_channels_; ++i) {
       output_resamplers_[i]->Resample(
-          data_->fbuf()->channels()[i], proc_num_frames_,
-          output_buffer_->fbuf()->channels()[i], output_num_frames_);
+          data_->fbuf_const()->channels()[i], proc_num_frames_,
+          output_buffer_->fbuf_overwrite()->channels()[i], output_num_frames_);
     }
     data_ptr = output_buffer_.get();
   }
 
   if (frame->num_channels_ == num_channels_) {
-    Interleave(data_ptr->ibuf()->channels(), output_num_frames_, num_channels_,
-               frame->data_);
+    Interleave(data_ptr->ibuf_const()->channels(), output_num_frames_,
+               num_channels_, frame->data_);
   } else {
-    UpmixMonoToInterleaved(data_ptr->ibuf()->channels()[0], output_num_frames_,
+    UpmixMonoToInterleaved(data_ptr->ibuf_const()->channels()[0],
+                           output_num_frames_,
                            frame->num_channels_, frame->data_);
   }
 }
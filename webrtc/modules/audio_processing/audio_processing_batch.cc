@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_processing/audio_processing_batch.h"
+
+#if defined(WEBRTC_LINUX)
+#include <sched.h>
+#endif
+
+#include <utility>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+namespace {
+
+void PinCurrentThreadToCore(size_t core) {
+#if defined(WEBRTC_LINUX)
+  const uint32_t num_cores = CpuInfo::DetectNumberOfCores();
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(core % num_cores, &cpus);
+  // On Linux a pid of zero refers to the calling thread.
+  if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+    LOG(LS_WARNING) << "Failed to pin APM batch worker to core " << core;
+#endif
+}
+
+}  // namespace
+
+struct AudioProcessingBatch::Worker {
+  Worker(AudioProcessingBatch* batch, size_t shard)
+      : batch(batch),
+        shard(shard),
+        start(false, false),
+        thread(&AudioProcessingBatch::WorkerMain, this, "ApmBatchWorker") {}
+
+  AudioProcessingBatch* const batch;
+  const size_t shard;
+  rtc::Event start;
+  rtc::PlatformThread thread;
+};
+
+AudioProcessingBatch::AudioProcessingBatch(size_t num_workers)
+    : frames_(nullptr),
+      shard_results_(num_workers + 1, AudioProcessing::kNoError),
+      pending_workers_(0),
+      quit_(0),
+      done_(false, false) {
+  // Shard 0 is processed by the calling thread.
+  for (size_t i = 0; i < num_workers; ++i)
+    workers_.push_back(std::unique_ptr<Worker>(new Worker(this, i + 1)));
+  for (const auto& worker : workers_)
+    worker->thread.Start();
+}
+
+AudioProcessingBatch::~AudioProcessingBatch() {
+  rtc::AtomicOps::ReleaseStore(&quit_, 1);
+  for (const auto& worker : workers_)
+    worker->start.Set();
+  for (const auto& worker : workers_)
+    worker->thread.Stop();
+}
+
+size_t AudioProcessingBatch::AddStream(std::unique_ptr<AudioProcessing> apm) {
+  RTC_DCHECK(apm);
+  streams_.push_back(std::move(apm));
+  return streams_.size() - 1;
+}
+
+AudioProcessing* AudioProcessingBatch::stream(size_t index) const {
+  RTC_DCHECK_LT(index, streams_.size());
+  return streams_[index].get();
+}
+
+int AudioProcessingBatch::ProcessStreams(
+    const std::vector<AudioFrame*>& frames) {
+  RTC_DCHECK_EQ(streams_.size(), frames.size());
+  frames_ = &frames;
+  rtc::AtomicOps::ReleaseStore(&pending_workers_,
+                               static_cast<int>(workers_.size()));
+  for (const auto& worker : workers_)
+    worker->start.Set();
+  shard_results_[0] = ProcessShard(0);
+  if (!workers_.empty())
+    done_.Wait(rtc::Event::kForever);
+  frames_ = nullptr;
+
+  for (int result : shard_results_) {
+    if (result != AudioProcessing::kNoError)
+      return result;
+  }
+  return AudioProcessing::kNoError;
+}
+
+// static
+bool AudioProcessingBatch::WorkerMain(void* context) {
+  Worker* worker = static_cast<Worker*>(context);
+  AudioProcessingBatch* batch = worker->batch;
+  PinCurrentThreadToCore(worker->shard);
+  while (true) {
+    worker->start.Wait(rtc::Event::kForever);
+    if (rtc::AtomicOps::AcquireLoad(&batch->quit_))
+      return false;
+    batch->shard_results_[worker->shard] = batch->ProcessShard(worker->shard);
+    if (rtc::AtomicOps::Decrement(&batch->pending_workers_) == 0)
+      batch->done_.Set();
+  }
+}
+
+int AudioProcessingBatch::ProcessShard(size_t shard) {
+  const size_t num_shards = shard_results_.size();
+  const size_t begin = shard * streams_.size() / num_shards;
+  const size_t end = (shard + 1) * streams_.size() / num_shards;
+  int result = AudioProcessing::kNoError;
+  for (size_t i = begin; i < end; ++i) {
+    AudioFrame* frame = (*frames_)[i];
+    if (!frame)
+      continue;
+    const int error = streams_[i]->ProcessStream(frame);
+    if (error != AudioProcessing::kNoError &&
+        result == AudioProcessing::kNoError) {
+      result = error;
+    }
+  }
+  return result;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
+#define WEBRTC_MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/modules/audio_processing/include/audio_processing.h"
+
+namespace webrtc {
+
+class AudioFrame;
+
+// Runs the capture side of many independent AudioProcessing instances, one
+// per stream, on a fixed set of worker threads. This is meant for servers
+// that run noise suppression, AGC and VAD on hundreds of incoming streams.
+//
+// The streams are split into contiguous shards, one for the calling thread
+// and one per worker, and a stream always stays in the same shard. On Linux
+// every worker is pinned to its own core, so the state of a stream stays in
+// that core's cache from one frame to the next.
+//
+// All methods must be called from the same thread.
+class AudioProcessingBatch {
+ public:
+  // Creates a batch that runs on |num_workers| threads in addition to the
+  // thread calling ProcessStreams(). Pass CpuInfo::DetectNumberOfCores() - 1
+  // to use every core.
+  explicit AudioProcessingBatch(size_t num_workers);
+  ~AudioProcessingBatch();
+
+  // Adds a stream and returns its index. The batch takes ownership of |apm|,
+  // which may still be configured through stream() between calls to
+  // ProcessStreams().
+  size_t AddStream(std::unique_ptr<AudioProcessing> apm);
+  AudioProcessing* stream(size_t index) const;
+  size_t num_streams() const { return streams_.size(); }
+
+  // Calls AudioProcessing::ProcessStream() on every stream with its entry in
+  // |frames|, which must have num_streams() entries. Null entries are
+  // skipped. Returns when all streams are done, with kNoError or the first
+  // error a stream reported.
+  int ProcessStreams(const std::vector<AudioFrame*>& frames);
+
+ private:
+  struct Worker;
+
+  static bool WorkerMain(void* context);
+  int ProcessShard(size_t shard);
+
+  std::vector<std::unique_ptr<AudioProcessing>> streams_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Set while ProcessStreams() runs. The start and done events order the
+  // accesses from the workers.
+  const std::vector<AudioFrame*>* frames_;
+  // Written by each shard for its own index only.
+  std::vector<int> shard_results_;
+  volatile int pending_workers_;
+  volatile int quit_;
+  rtc::Event done_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AudioProcessingBatch);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_processing/audio_processing_batch.h"
+
+#include <memory>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/modules/include/module_common_types.h"
+
+namespace webrtc {
+namespace {
+
+const int kSampleRateHz = 16000;
+const size_t kSamplesPerChannel = kSampleRateHz / 100;
+const size_t kNumStreams = 10;
+const int kNumFrames = 50;
+
+std::unique_ptr<AudioProcessing> CreateApm() {
+  std::unique_ptr<AudioProcessing> apm(AudioProcessing::Create());
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->noise_suppression()->Enable(true));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->gain_control()->set_mode(GainControl::kAdaptiveDigital));
+  EXPECT_EQ(AudioProcessing::kNoError, apm->gain_control()->Enable(true));
+  EXPECT_EQ(AudioProcessing::kNoError, apm->voice_detection()->Enable(true));
+  return apm;
+}
+
+void FillFrame(Random* random, AudioFrame* frame) {
+  int16_t data[kSamplesPerChannel];
+  for (int16_t& sample : data)
+    sample = static_cast<int16_t>(random->Rand(-2000, 2000));
+  frame->UpdateFrame(0, 0, data, kSamplesPerChannel, kSampleRateHz,
+                     AudioFrame::kNormalSpeech, AudioFrame::kVadUnknown);
+}
+
+void RunBatchAndCompare(size_t num_workers) {
+  AudioProcessingBatch batch(num_workers);
+  std::vector<std::unique_ptr<AudioProcessing>> references;
+  for (size_t i = 0; i < kNumStreams; ++i) {
+    EXPECT_EQ(i, batch.AddStream(CreateApm()));
+    references.push_back(CreateApm());
+  }
+  ASSERT_EQ(kNumStreams, batch.num_streams());
+
+  Random random(42);
+  std::vector<AudioFrame> frames(kNumStreams);
+  std::vector<AudioFrame> reference_frames(kNumStreams);
+  std::vector<AudioFrame*> frame_ptrs;
+  for (AudioFrame& frame : frames)
+    frame_ptrs.push_back(&frame);
+
+  for (int i = 0; i < kNumFrames; ++i) {
+    for (size_t j = 0; j < kNumStreams; ++j) {
+      FillFrame(&random, &frames[j]);
+      reference_frames[j].CopyFrom(frames[j]);
+      ASSERT_EQ(AudioProcessing::kNoError,
+                references[j]->ProcessStream(&reference_frames[j]));
+    }
+    ASSERT_EQ(AudioProcessing::kNoError, batch.ProcessStreams(frame_ptrs));
+    for (size_t j = 0; j < kNumStreams; ++j) {
+      EXPECT_EQ(0, memcmp(reference_frames[j].data_, frames[j].data_,
+                          kSamplesPerChannel * sizeof(int16_t)));
+      EXPECT_EQ(reference_frames[j].vad_activity_, frames[j].vad_activity_);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(AudioProcessingBatchTest, MatchesSeparateInstancesOnCallingThread) {
+  RunBatchAndCompare(0);
+}
+
+TEST(AudioProcessingBatchTest, MatchesSeparateInstancesOnWorkers) {
+  RunBatchAndCompare(3);
+}
+
+TEST(AudioProcessingBatchTest, SkipsNullFramesAndReportsErrors) {
+  AudioProcessingBatch batch(1);
+  batch.AddStream(CreateApm());
+  batch.AddStream(CreateApm());
+
+  AudioFrame invalid;
+  invalid.samples_per_channel_ = kSamplesPerChannel;
+  invalid.sample_rate_hz_ = 12345;
+  invalid.num_channels_ = 1;
+  std::vector<AudioFrame*> frames = {nullptr, nullptr};
+  EXPECT_EQ(AudioProcessing::kNoError, batch.ProcessStreams(frames));
+  frames[1] = &invalid;
+  EXPECT_NE(AudioProcessing::kNoError, batch.ProcessStreams(frames));
+}
+
+}  // namespace webrtc
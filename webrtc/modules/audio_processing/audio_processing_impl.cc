@@ -12,6 +12,7 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <utility>
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/platform_file.h"
@@ -75,6 +76,20 @@ const int AudioProcessing::kMaxNativeSampleRateHz = AudioProcessing::
 
 namespace {
 
+// The intelligibility enhancer solves for new gains every block, except on
+// mobile platforms where it does so every fourth block to save complexity.
+#if defined(WEBRTC_ANDROID) || defined(WEBRTC_IOS)
+const size_t kIntelligibilityGainUpdateInterval = 4;
+#else
+const size_t kIntelligibilityGainUpdateInterval = 1;
+#endif
+
+#ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
+// Events which the debug dump writer may fall behind with before new ones are
+// dropped, about half a second of both streams.
+const size_t kMaxQueuedDebugDumpEvents = 100;
+#endif
+
 static bool LayoutHasKeyboard(AudioProcessing::ChannelLayout layout) {
   switch (layout) {
     case AudioProcessing::kMono:
@@ -211,9 +226,8 @@ AudioProcessingImpl::~AudioProcessingImpl() {
   public_submodules_->gain_control_for_experimental_agc.reset();
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_dump_.debug_file->Open()) {
-    debug_dump_.debug_file->CloseFile();
-  }
+  // Writes the events still queued and closes the file.
+  debug_dump_.writer.reset();
 #endif
 }
 
@@ -326,7 +340,7 @@ int AudioProcessingImpl::InitializeLocked() {
   InitializeVoiceDetection();
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_dump_.debug_file->Open()) {
+  if (debug_dump_.writing()) {
     int err = WriteInitMessage();
     if (err != kNoError) {
       return err;
@@ -537,7 +551,7 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
          formats_.api_format.input_stream().num_frames());
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_dump_.debug_file->Open()) {
+  if (debug_dump_.writing()) {
     RETURN_ON_ERR(WriteConfigMessage(false));
 
     debug_dump_.capture.event_msg->set_type(audioproc::Event::STREAM);
@@ -555,16 +569,17 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
   capture_.capture_audio->CopyTo(formats_.api_format.output_stream(), dest);
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_dump_.debug_file->Open()) {
+  // Completes the event started before processing even if writing has stopped
+  // since, so that the writer clears it.
+  if (debug_dump_.writer) {
     audioproc::Stream* msg = debug_dump_.capture.event_msg->mutable_stream();
     const size_t channel_size =
         sizeof(float) * formats_.api_format.output_stream().num_frames();
     for (size_t i = 0; i < formats_.api_format.output_stream().num_channels();
          ++i)
       msg->add_output_channel(dest[i], channel_size);
-    RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.debug_file.get(),
-                                          &debug_dump_.num_bytes_left_for_log_,
-                                          &crit_debug_, &debug_dump_.capture));
+    RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.writer.get(),
+                                          &debug_dump_.capture));
   }
 #endif
 
@@ -624,7 +639,7 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
   }
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_dump_.debug_file->Open()) {
+  if (debug_dump_.writing()) {
     debug_dump_.capture.event_msg->set_type(audioproc::Event::STREAM);
     audioproc::Stream* msg = debug_dump_.capture.event_msg->mutable_stream();
     const size_t data_size =
@@ -638,14 +653,13 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
   capture_.capture_audio->InterleaveTo(frame, output_copy_needed());
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_dump_.debug_file->Open()) {
+  if (debug_dump_.writer) {
     audioproc::Stream* msg = debug_dump_.capture.event_msg->mutable_stream();
     const size_t data_size =
         sizeof(int16_t) * frame->samples_per_channel_ * frame->num_channels_;
     msg->set_output_data(frame->data_, data_size);
-    RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.debug_file.get(),
-                                          &debug_dump_.num_bytes_left_for_log_,
-                                          &crit_debug_, &debug_dump_.capture));
+    RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.writer.get(),
+                                          &debug_dump_.capture));
   }
 #endif
 
@@ -660,7 +674,7 @@ int AudioProcessingImpl::ProcessStreamLocked() {
                public_submodules_->echo_control_mobile->is_enabled()));
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_dump_.debug_file->Open()) {
+  if (debug_dump_.writer) {
     audioproc::Stream* msg = debug_dump_.capture.event_msg->mutable_stream();
     msg->set_delay(capture_nonlocked_.stream_delay_ms);
     msg->set_drift(
@@ -828,7 +842,7 @@ int AudioProcessingImpl::AnalyzeReverseStreamLocked(
          formats_.api_format.reverse_input_stream().num_frames());
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_dump_.debug_file->Open()) {
+  if (debug_dump_.writing()) {
     debug_dump_.render.event_msg->set_type(audioproc::Event::REVERSE_STREAM);
     audioproc::ReverseStream* msg =
         debug_dump_.render.event_msg->mutable_reverse_stream();
@@ -837,9 +851,8 @@ int AudioProcessingImpl::AnalyzeReverseStreamLocked(
     for (size_t i = 0;
          i < formats_.api_format.reverse_input_stream().num_channels(); ++i)
       msg->add_channel(src[i], channel_size);
-    RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.debug_file.get(),
-                                          &debug_dump_.num_bytes_left_for_log_,
-                                          &crit_debug_, &debug_dump_.render));
+    RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.writer.get(),
+                                          &debug_dump_.render));
   }
 #endif
 
@@ -883,16 +896,15 @@ int AudioProcessingImpl::ProcessReverseStream(AudioFrame* frame) {
   }
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_dump_.debug_file->Open()) {
+  if (debug_dump_.writing()) {
     debug_dump_.render.event_msg->set_type(audioproc::Event::REVERSE_STREAM);
     audioproc::ReverseStream* msg =
         debug_dump_.render.event_msg->mutable_reverse_stream();
     const size_t data_size =
         sizeof(int16_t) * frame->samples_per_channel_ * frame->num_channels_;
     msg->set_data(frame->data_, data_size);
-    RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.debug_file.get(),
-                                          &debug_dump_.num_bytes_left_for_log_,
-                                          &crit_debug_, &debug_dump_.render));
+    RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.writer.get(),
+                                          &debug_dump_.render));
   }
 #endif
   render_.render_audio->DeinterleaveFrom(frame);
@@ -988,18 +1000,15 @@ int AudioProcessingImpl::StartDebugRecording(
   }
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  debug_dump_.num_bytes_left_for_log_ = max_log_size_bytes;
   // Stop any ongoing recording.
-  if (debug_dump_.debug_file->Open()) {
-    if (debug_dump_.debug_file->CloseFile() == -1) {
-      return kFileError;
-    }
-  }
+  debug_dump_.writer.reset();
 
-  if (debug_dump_.debug_file->OpenFile(filename, false) == -1) {
-    debug_dump_.debug_file->CloseFile();
+  std::unique_ptr<FileWrapper> debug_file(FileWrapper::Create());
+  if (debug_file->OpenFile(filename, false) == -1) {
     return kFileError;
   }
+  debug_dump_.writer.reset(new DebugDumpWriter(
+      std::move(debug_file), max_log_size_bytes, kMaxQueuedDebugDumpEvents));
 
   RETURN_ON_ERR(WriteConfigMessage(true));
   RETURN_ON_ERR(WriteInitMessage());
@@ -1020,18 +1029,15 @@ int AudioProcessingImpl::StartDebugRecording(FILE* handle,
   }
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  debug_dump_.num_bytes_left_for_log_ = max_log_size_bytes;
-
   // Stop any ongoing recording.
-  if (debug_dump_.debug_file->Open()) {
-    if (debug_dump_.debug_file->CloseFile() == -1) {
-      return kFileError;
-    }
-  }
+  debug_dump_.writer.reset();
 
-  if (debug_dump_.debug_file->OpenFromFileHandle(handle, true, false) == -1) {
+  std::unique_ptr<FileWrapper> debug_file(FileWrapper::Create());
+  if (debug_file->OpenFromFileHandle(handle, true, false) == -1) {
     return kFileError;
   }
+  debug_dump_.writer.reset(new DebugDumpWriter(
+      std::move(debug_file), max_log_size_bytes, kMaxQueuedDebugDumpEvents));
 
   RETURN_ON_ERR(WriteConfigMessage(true));
   RETURN_ON_ERR(WriteInitMessage());
@@ -1056,12 +1062,9 @@ int AudioProcessingImpl::StopDebugRecording() {
   rtc::CritScope cs_capture(&crit_capture_);
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  // We just return if recording hasn't started.
-  if (debug_dump_.debug_file->Open()) {
-    if (debug_dump_.debug_file->CloseFile() == -1) {
-      return kFileError;
-    }
-  }
+  // Writes the events still queued and closes the file. We just return if
+  // recording hasn't started.
+  debug_dump_.writer.reset();
   return kNoError;
 #else
   return kUnsupportedFunctionError;
@@ -1226,7 +1229,8 @@ void AudioProcessingImpl::InitializeIntelligibility() {
     public_submodules_->intelligibility_enhancer.reset(
         new IntelligibilityEnhancer(capture_nonlocked_.split_rate,
                                     render_.render_audio->num_channels(),
-                                    NoiseSuppressionImpl::num_noise_bins()));
+                                    NoiseSuppressionImpl::num_noise_bins(),
+                                    kIntelligibilityGainUpdateInterval));
   }
 }
 
@@ -1341,50 +1345,11 @@ void AudioProcessingImpl::UpdateHistogramsOnCallEnd() {
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
 int AudioProcessingImpl::WriteMessageToDebugFile(
-    FileWrapper* debug_file,
-    int64_t* filesize_limit_bytes,
-    rtc::CriticalSection* crit_debug,
+    DebugDumpWriter* writer,
     ApmDebugDumpThreadState* debug_state) {
-  int32_t size = debug_state->event_msg->ByteSize();
-  if (size <= 0) {
-    return kUnspecifiedError;
-  }
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-// TODO(ajm): Use little-endian "on the wire". For the moment, we can be
-//            pretty safe in assuming little-endian.
-#endif
-
-  if (!debug_state->event_msg->SerializeToString(&debug_state->event_str)) {
-    return kUnspecifiedError;
-  }
-
-  {
-    // Ensure atomic writes of the message.
-    rtc::CritScope cs_debug(crit_debug);
-
-    RTC_DCHECK(debug_file->Open());
-    // Update the byte counter.
-    if (*filesize_limit_bytes >= 0) {
-      *filesize_limit_bytes -=
-          (sizeof(int32_t) + debug_state->event_str.length());
-      if (*filesize_limit_bytes < 0) {
-        // Not enough bytes are left to write this message, so stop logging.
-        debug_file->CloseFile();
-        return kNoError;
-      }
-    }
-    // Write message preceded by its size.
-    if (!debug_file->Write(&size, sizeof(int32_t))) {
-      return kFileError;
-    }
-    if (!debug_file->Write(debug_state->event_str.data(),
-                           debug_state->event_str.length())) {
-      return kFileError;
-    }
-  }
-
-  debug_state->event_msg->Clear();
-
+  // The event is serialized and written on the thread of the writer. A full
+  // queue drops the event rather than blocking the audio thread.
+  writer->Enqueue(&debug_state->event_msg);
   return kNoError;
 }
 
@@ -1408,9 +1373,8 @@ int AudioProcessingImpl::WriteInitMessage() {
   msg->set_num_reverse_output_channels(
       formats_.api_format.reverse_output_stream().num_channels());
 
-  RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.debug_file.get(),
-                                        &debug_dump_.num_bytes_left_for_log_,
-                                        &crit_debug_, &debug_dump_.capture));
+  RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.writer.get(),
+                                          &debug_dump_.capture));
   return kNoError;
 }
 
@@ -1469,9 +1433,8 @@ int AudioProcessingImpl::WriteConfigMessage(bool forced) {
   debug_dump_.capture.event_msg->set_type(audioproc::Event::CONFIG);
   debug_dump_.capture.event_msg->mutable_config()->CopyFrom(config);
 
-  RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.debug_file.get(),
-                                        &debug_dump_.num_bytes_left_for_log_,
-                                        &crit_debug_, &debug_dump_.capture));
+  RETURN_ON_ERR(WriteMessageToDebugFile(debug_dump_.writer.get(),
+                                          &debug_dump_.capture));
   return kNoError;
 }
 #endif  // WEBRTC_AUDIOPROC_DEBUG_DUMP
@@ -23,12 +23,7 @@
 #include "webrtc/system_wrappers/include/file_wrapper.h"
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-// Files generated at build-time by the protobuf compiler.
-#ifdef WEBRTC_ANDROID_PLATFORM_BUILD
-#include "external/webrtc/webrtc/modules/audio_processing/debug.pb.h"
-#else
-#include "webrtc/modules/audio_processing/debug.pb.h"
-#endif
+#include "webrtc/modules/audio_processing/debug_dump_writer.h"
 #endif  // WEBRTC_AUDIOPROC_DEBUG_DUMP
 
 namespace webrtc {
@@ -136,18 +131,15 @@ class AudioProcessingImpl : public AudioProcessing {
   struct ApmDebugDumpThreadState {
     ApmDebugDumpThreadState() : event_msg(new audioproc::Event()) {}
     std::unique_ptr<audioproc::Event> event_msg;  // Protobuf message.
-    std::string event_str;  // Memory for protobuf serialization.
 
     // Serialized string of last saved APM configuration.
     std::string last_serialized_config;
   };
 
   struct ApmDebugDumpState {
-    ApmDebugDumpState() : debug_file(FileWrapper::Create()) {}
-    // Number of bytes that can still be written to the log before the maximum
-    // size is reached. A value of <= 0 indicates that no limit is used.
-    int64_t num_bytes_left_for_log_ = -1;
-    std::unique_ptr<FileWrapper> debug_file;
+    bool writing() const { return writer && writer->writing(); }
+    // Only exists while recording.
+    std::unique_ptr<DebugDumpWriter> writer;
     ApmDebugDumpThreadState render;
     ApmDebugDumpThreadState capture;
   };
@@ -229,9 +221,7 @@ class AudioProcessingImpl : public AudioProcessing {
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
   // TODO(andrew): make this more graceful. Ideally we would split this stuff
   // out into a separate class with an "enabled" and "disabled" implementation.
-  static int WriteMessageToDebugFile(FileWrapper* debug_file,
-                                     int64_t* filesize_limit_bytes,
-                                     rtc::CriticalSection* crit_debug,
+  static int WriteMessageToDebugFile(DebugDumpWriter* writer,
                                      ApmDebugDumpThreadState* debug_state);
   int WriteInitMessage() EXCLUSIVE_LOCKS_REQUIRED(crit_render_, crit_capture_);
 
@@ -241,9 +231,6 @@ class AudioProcessingImpl : public AudioProcessing {
   int WriteConfigMessage(bool forced) EXCLUSIVE_LOCKS_REQUIRED(crit_capture_)
       EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
 
-  // Critical section.
-  rtc::CriticalSection crit_debug_;
-
   // Debug dump state.
   ApmDebugDumpState debug_dump_;
 #endif
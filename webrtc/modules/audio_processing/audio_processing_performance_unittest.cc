@@ -18,9 +18,12 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "webrtc/base/array_view.h"
 #include "webrtc/base/atomicops.h"
+#include "webrtc/base/event.h"
 #include "webrtc/base/platform_thread.h"
 #include "webrtc/base/random.h"
 #include "webrtc/base/safe_conversions.h"
+#include "webrtc/base/swap_queue.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/config.h"
 #include "webrtc/modules/audio_processing/test/test_utils.h"
 #include "webrtc/modules/include/module_common_types.h"
@@ -702,6 +705,107 @@ bool TimedThreadApiProcessor::Process() {
 
 const float CallSimulator::kRenderInputFloatLevel = 0.5f;
 const float CallSimulator::kCaptureInputFloatLevel = 0.03125f;
+
+// Stress test for the queue that hands render data to the capture side
+// submodules. A render thread inserts frames while a capture thread removes
+// them, both at full speed, and the duration of every Insert() and Remove()
+// call is stored so that the latency jitter of different queues can be
+// compared.
+template <typename Queue>
+class RenderQueueStressTest {
+ public:
+  static const size_t kQueueSize = 100;
+  static const size_t kFrameSize = 160;
+  static const size_t kNumCalls = 20000;
+
+  RenderQueueStressTest()
+      : queue_(kQueueSize, std::vector<float>(kFrameSize)),
+        render_buffer_(kFrameSize),
+        capture_buffer_(kFrameSize),
+        render_done_(false, false),
+        capture_done_(false, false),
+        render_thread_(&RenderThreadFunc, this, "render"),
+        capture_thread_(&CaptureThreadFunc, this, "capture") {
+    insert_durations_ns_.reserve(kNumCalls);
+    remove_durations_ns_.reserve(kNumCalls);
+  }
+
+  void Run(const std::string& queue_name) {
+    render_thread_.Start();
+    render_thread_.SetPriority(rtc::kRealtimePriority);
+    capture_thread_.Start();
+    capture_thread_.SetPriority(rtc::kRealtimePriority);
+    render_done_.Wait(rtc::Event::kForever);
+    capture_done_.Wait(rtc::Event::kForever);
+    render_thread_.Stop();
+    capture_thread_.Stop();
+    EXPECT_LE(num_removed_, num_inserted_);
+
+    PrintDurationStatistics(queue_name + "_insert", insert_durations_ns_);
+    PrintDurationStatistics(queue_name + "_remove", remove_durations_ns_);
+  }
+
+ private:
+  static bool RenderThreadFunc(void* context) {
+    RenderQueueStressTest* test = static_cast<RenderQueueStressTest*>(context);
+    const int64_t start_time_ns = rtc::TimeNanos();
+    // A full queue is not an error here, the insert is timed regardless.
+    if (test->queue_.Insert(&test->render_buffer_))
+      ++test->num_inserted_;
+    test->insert_durations_ns_.push_back(rtc::TimeNanos() - start_time_ns);
+    if (test->insert_durations_ns_.size() < kNumCalls)
+      return true;
+    test->render_done_.Set();
+    return false;
+  }
+
+  static bool CaptureThreadFunc(void* context) {
+    RenderQueueStressTest* test = static_cast<RenderQueueStressTest*>(context);
+    const int64_t start_time_ns = rtc::TimeNanos();
+    if (test->queue_.Remove(&test->capture_buffer_))
+      ++test->num_removed_;
+    test->remove_durations_ns_.push_back(rtc::TimeNanos() - start_time_ns);
+    if (test->remove_durations_ns_.size() < kNumCalls)
+      return true;
+    test->capture_done_.Set();
+    return false;
+  }
+
+  static void PrintDurationStatistics(const std::string& trace,
+                                      const std::vector<int64_t>& durations) {
+    double sum = 0;
+    int64_t max_duration = 0;
+    for (int64_t duration : durations) {
+      sum += duration;
+      max_duration = std::max(max_duration, duration);
+    }
+    const double average = sum / durations.size();
+    double variance = 0;
+    for (int64_t duration : durations)
+      variance += (duration - average) * (duration - average);
+    const double standard_dev = sqrt(variance / durations.size());
+
+    webrtc::test::PrintResultMeanAndError(
+        "apm_render_queue", "", trace,
+        std::to_string(static_cast<int64_t>(average)) + ", " +
+            std::to_string(static_cast<int64_t>(standard_dev)),
+        "ns", false);
+    webrtc::test::PrintResult("apm_render_queue_max", "", trace,
+                              static_cast<size_t>(max_duration), "ns", false);
+  }
+
+  Queue queue_;
+  std::vector<float> render_buffer_;
+  std::vector<float> capture_buffer_;
+  std::vector<int64_t> insert_durations_ns_;
+  std::vector<int64_t> remove_durations_ns_;
+  size_t num_inserted_ = 0;
+  size_t num_removed_ = 0;
+  rtc::Event render_done_;
+  rtc::Event capture_done_;
+  rtc::PlatformThread render_thread_;
+  rtc::PlatformThread capture_thread_;
+};
 }  // anonymous namespace
 
 TEST_P(CallSimulator, ApiCallDurationTest) {
@@ -714,4 +818,9 @@ INSTANTIATE_TEST_CASE_P(
     CallSimulator,
     ::testing::ValuesIn(SimulationConfig::GenerateSimulationConfigs()));
 
+TEST(AudioProcessingPerformanceTest, RenderQueueCallDurationTest) {
+  RenderQueueStressTest<SwapQueue<std::vector<float>>>().Run("locked");
+  RenderQueueStressTest<SpscSwapQueue<std::vector<float>>>().Run("lock_free");
+}
+
 }  // namespace webrtc
@@ -134,19 +134,6 @@ float SumAbs(const ComplexMatrix<float>& mat) {
   return sum_abs;
 }
 
-// Calculates the sum of squares of a complex matrix.
-float SumSquares(const ComplexMatrix<float>& mat) {
-  float sum_squares = 0.f;
-  const complex<float>* const* mat_els = mat.elements();
-  for (size_t i = 0; i < mat.num_rows(); ++i) {
-    for (size_t j = 0; j < mat.num_columns(); ++j) {
-      float abs_value = std::abs(mat_els[i][j]);
-      sum_squares += abs_value * abs_value;
-    }
-  }
-  return sum_squares;
-}
-
 // Does |out| = |in|.' * conj(|in|) for row vector |in|.
 void TransposedConjugatedProduct(const ComplexMatrix<float>& in,
                                  ComplexMatrix<float>* out) {
@@ -366,6 +353,40 @@ void NonlinearBeamformer::NormalizeCovMats() {
   }
 }
 
+void NonlinearBeamformer::InitQuadraticForms() {
+  const size_t num_forms = 1 + interf_angles_radians_.size();
+  const size_t num_elements = num_input_channels_ * num_input_channels_;
+  quadratic_form_weights_.resize(2 * num_forms * num_elements * kNumFreqBins);
+  delay_sum_mask_re_.resize(num_input_channels_ * kNumFreqBins);
+  delay_sum_mask_im_.resize(num_input_channels_ * kNumFreqBins);
+  eig_re_.resize(num_input_channels_ * kNumFreqBins);
+  eig_im_.resize(num_input_channels_ * kNumFreqBins);
+  sum_re_.resize(kNumFreqBins);
+  sum_im_.resize(kNumFreqBins);
+  quadratic_forms_.resize((1 + num_forms) * kNumFreqBins);
+
+  for (size_t f = 0; f < kNumFreqBins; ++f) {
+    float* weights = &quadratic_form_weights_[f];
+    for (size_t k = 0; k < num_forms; ++k) {
+      const complex_f* const* mat_els =
+          k == 0 ? target_cov_mats_[f].elements()
+                 : interf_cov_mats_[f][k - 1]->elements();
+      for (size_t i = 0; i < num_input_channels_; ++i) {
+        for (size_t j = 0; j < num_input_channels_; ++j) {
+          weights[0] = mat_els[j][i].real();
+          weights[kNumFreqBins] = mat_els[j][i].imag();
+          weights += 2 * kNumFreqBins;
+        }
+      }
+    }
+    const complex_f* mask_els = delay_sum_masks_[f].elements()[0];
+    for (size_t c = 0; c < num_input_channels_; ++c) {
+      delay_sum_mask_re_[c * kNumFreqBins + f] = mask_els[c].real();
+      delay_sum_mask_im_[c * kNumFreqBins + f] = mask_els[c].imag();
+    }
+  }
+}
+
 void NonlinearBeamformer::ProcessChunk(const ChannelBuffer<float>& input,
                                        ChannelBuffer<float>* output) {
   RTC_DCHECK_EQ(input.num_channels(), num_input_channels_);
@@ -398,6 +419,7 @@ void NonlinearBeamformer::AimAt(const SphericalPointf& target_direction) {
   InitTargetCovMats();
   InitInterfCovMats();
   NormalizeCovMats();
+  InitQuadraticForms();
 }
 
 bool NonlinearBeamformer::IsInBeam(const SphericalPointf& spherical_point) {
@@ -418,33 +440,106 @@ void NonlinearBeamformer::ProcessAudioBlock(const complex_f* const* input,
 
   // Calculating the post-filter masks. Note that we need two for each
   // frequency bin to account for the positive and negative interferer
-  // angle.
-  for (size_t i = low_mean_start_bin_; i <= high_mean_end_bin_; ++i) {
-    eig_m_.CopyFromColumn(input, i, num_input_channels_);
-    float eig_m_norm_factor = std::sqrt(SumSquares(eig_m_));
-    if (eig_m_norm_factor != 0.f) {
-      eig_m_.Scale(1.f / eig_m_norm_factor);
+  // angle. The inner loops run over the bins, which are independent of each
+  // other, so that they can be vectorized. Per bin, the operations are the
+  // same as in Norm() and ConjugateDotProduct().
+  const size_t begin = low_mean_start_bin_;
+  const size_t end = high_mean_end_bin_ + 1;
+  const size_t num_forms = 1 + interf_angles_radians_.size();
+  float* const eig_re = &eig_re_[0];
+  float* const eig_im = &eig_im_[0];
+  float* const sum_re = &sum_re_[0];
+  float* const sum_im = &sum_im_[0];
+  float* const rmw = &quadratic_forms_[0];
+  float* const rxim = &quadratic_forms_[kNumFreqBins];
+
+  // Normalize the input of each bin over the microphones.
+  std::fill(sum_re + begin, sum_re + end, 0.f);
+  for (size_t c = 0; c < num_input_channels_; ++c) {
+    for (size_t f = begin; f < end; ++f) {
+      const float abs_value = std::abs(input[c][f]);
+      sum_re[f] += abs_value * abs_value;
+    }
+  }
+  for (size_t f = begin; f < end; ++f) {
+    const float norm_factor = std::sqrt(sum_re[f]);
+    sum_re[f] = norm_factor != 0.f ? 1.f / norm_factor : 1.f;
+  }
+  for (size_t c = 0; c < num_input_channels_; ++c) {
+    float* const re = &eig_re[c * kNumFreqBins];
+    float* const im = &eig_im[c * kNumFreqBins];
+    for (size_t f = begin; f < end; ++f) {
+      re[f] = input[c][f].real() * sum_re[f];
+      im[f] = input[c][f].imag() * sum_re[f];
     }
+  }
 
-    float rxim = Norm(target_cov_mats_[i], eig_m_);
-    float ratio_rxiw_rxim = 0.f;
-    if (rxim > 0.f) {
-      ratio_rxiw_rxim = rxiws_[i] / rxim;
+  // Norm() of the target and each interference covariance matrix with the
+  // normalized input.
+  const float* weights = &quadratic_form_weights_[0];
+  for (size_t k = 0; k < num_forms; ++k) {
+    float* const form = &rxim[k * kNumFreqBins];
+    std::fill(form + begin, form + end, 0.f);
+    for (size_t i = 0; i < num_input_channels_; ++i) {
+      std::fill(sum_re + begin, sum_re + end, 0.f);
+      std::fill(sum_im + begin, sum_im + end, 0.f);
+      for (size_t j = 0; j < num_input_channels_; ++j) {
+        const float* const re_j = &eig_re[j * kNumFreqBins];
+        const float* const im_j = &eig_im[j * kNumFreqBins];
+        const float* const mat_re = weights;
+        const float* const mat_im = weights + kNumFreqBins;
+        for (size_t f = begin; f < end; ++f) {
+          sum_re[f] += re_j[f] * mat_re[f] + im_j[f] * mat_im[f];
+          sum_im[f] += re_j[f] * mat_im[f] - im_j[f] * mat_re[f];
+        }
+        weights += 2 * kNumFreqBins;
+      }
+      const float* const re_i = &eig_re[i * kNumFreqBins];
+      const float* const im_i = &eig_im[i * kNumFreqBins];
+      for (size_t f = begin; f < end; ++f) {
+        form[f] += sum_re[f] * re_i[f] - sum_im[f] * im_i[f];
+      }
     }
+    for (size_t f = begin; f < end; ++f) {
+      form[f] = std::max(form[f], 0.f);
+    }
+  }
 
-    complex_f rmw = abs(ConjugateDotProduct(delay_sum_masks_[i], eig_m_));
-    rmw *= rmw;
-    float rmw_r = rmw.real();
+  // The squared magnitude of ConjugateDotProduct() of the delay-and-sum mask
+  // with the normalized input.
+  std::fill(sum_re + begin, sum_re + end, 0.f);
+  std::fill(sum_im + begin, sum_im + end, 0.f);
+  for (size_t c = 0; c < num_input_channels_; ++c) {
+    const float* const mask_re = &delay_sum_mask_re_[c * kNumFreqBins];
+    const float* const mask_im = &delay_sum_mask_im_[c * kNumFreqBins];
+    const float* const re = &eig_re[c * kNumFreqBins];
+    const float* const im = &eig_im[c * kNumFreqBins];
+    for (size_t f = begin; f < end; ++f) {
+      sum_re[f] += mask_re[f] * re[f] + mask_im[f] * im[f];
+      sum_im[f] += mask_re[f] * im[f] - mask_im[f] * re[f];
+    }
+  }
+  for (size_t f = begin; f < end; ++f) {
+    const float abs_value = std::abs(complex_f(sum_re[f], sum_im[f]));
+    rmw[f] = abs_value * abs_value;
+  }
 
-    new_mask_[i] = CalculatePostfilterMask(*interf_cov_mats_[i][0],
+  for (size_t i = begin; i < end; ++i) {
+    float ratio_rxiw_rxim = 0.f;
+    if (rxim[i] > 0.f) {
+      ratio_rxiw_rxim = rxiws_[i] / rxim[i];
+    }
+
+    new_mask_[i] = CalculatePostfilterMask(rxim[kNumFreqBins + i],
                                            rpsiws_[i][0],
                                            ratio_rxiw_rxim,
-                                           rmw_r);
+                                           rmw[i]);
     for (size_t j = 1; j < interf_angles_radians_.size(); ++j) {
-      float tmp_mask = CalculatePostfilterMask(*interf_cov_mats_[i][j],
-                                               rpsiws_[i][j],
-                                               ratio_rxiw_rxim,
-                                               rmw_r);
+      float tmp_mask =
+          CalculatePostfilterMask(rxim[(j + 1) * kNumFreqBins + i],
+                                  rpsiws_[i][j],
+                                  ratio_rxiw_rxim,
+                                  rmw[i]);
       if (tmp_mask < new_mask_[i]) {
         new_mask_[i] = tmp_mask;
       }
@@ -459,13 +554,10 @@ void NonlinearBeamformer::ProcessAudioBlock(const complex_f* const* input,
   ApplyMasks(input, output);
 }
 
-float NonlinearBeamformer::CalculatePostfilterMask(
-    const ComplexMatrixF& interf_cov_mat,
-    float rpsiw,
-    float ratio_rxiw_rxim,
-    float rmw_r) {
-  float rpsim = Norm(interf_cov_mat, eig_m_);
-
+float NonlinearBeamformer::CalculatePostfilterMask(float rpsim,
+                                                   float rpsiw,
+                                                   float ratio_rxiw_rxim,
+                                                   float rmw_r) {
   float ratio = 0.f;
   if (rpsim > 0.f) {
     ratio = rpsiw / rpsim;
@@ -89,10 +89,12 @@ class NonlinearBeamformer
   void InitDiffuseCovMats();
   void InitInterfCovMats();
   void NormalizeCovMats();
+  void InitQuadraticForms();
 
   // Calculates postfilter masks that minimize the mean squared error of our
-  // estimation of the desired signal.
-  float CalculatePostfilterMask(const ComplexMatrixF& interf_cov_mat,
+  // estimation of the desired signal. |rpsim| is the norm of the
+  // interference covariance matrix with the normalized input.
+  float CalculatePostfilterMask(float rpsim,
                                 float rpsiw,
                                 float ratio_rxiw_rxim,
                                 float rmxi_r);
@@ -181,8 +183,26 @@ class NonlinearBeamformer
   // The vector has a size equal to the number of interferer scenarios.
   std::vector<float> rpsiws_[kNumFreqBins];
 
-  // The microphone normalization factor.
-  ComplexMatrixF eig_m_;
+  // The covariance matrices and delay-and-sum masks rearranged for
+  // ProcessAudioBlock(), which computes the post-filter masks of all bins at
+  // once. Each row holds one value per bin, i.e. |kNumFreqBins| floats.
+  // |quadratic_form_weights_| holds the target covariance matrix followed by
+  // each interference covariance matrix, column by column, with a row for
+  // the real part and a row for the imaginary part of each element.
+  std::vector<float> quadratic_form_weights_;
+  // Real and imaginary parts of |delay_sum_masks_|, one row per channel.
+  std::vector<float> delay_sum_mask_re_;
+  std::vector<float> delay_sum_mask_im_;
+
+  // Preallocated for ProcessAudioBlock(), in the same layout. The normalized
+  // input, scratch rows for sums, and the squared magnitude of the product
+  // of the delay-and-sum mask with the normalized input followed by the
+  // norms of the covariance matrices.
+  std::vector<float> eig_re_;
+  std::vector<float> eig_im_;
+  std::vector<float> sum_re_;
+  std::vector<float> sum_im_;
+  std::vector<float> quadratic_forms_;
 
   // For processing the high-frequency input signal.
   float high_pass_postfilter_mask_;
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_processing/debug_dump_writer.h"
+
+#include <utility>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/system_wrappers/include/logging.h"
+
+namespace webrtc {
+
+DebugDumpWriter::DebugDumpWriter(std::unique_ptr<FileWrapper> file,
+                                 int64_t max_log_size_bytes,
+                                 size_t max_queued_events)
+    : file_(std::move(file)),
+      num_bytes_left_for_log_(max_log_size_bytes),
+      queue_(max_queued_events),
+      event_(new audioproc::Event()),
+      writing_(1),
+      num_dropped_events_(0),
+      quit_(0),
+      wake_up_(false, false),
+      thread_(&DebugDumpWriter::Run, this, "DebugDumpWriter") {
+  RTC_DCHECK(file_->Open());
+  thread_.Start();
+}
+
+DebugDumpWriter::~DebugDumpWriter() {
+  rtc::AtomicOps::ReleaseStore(&quit_, 1);
+  wake_up_.Set();
+  thread_.Stop();
+  // The events queued after the last write of the thread.
+  WriteQueuedEvents();
+  file_->CloseFile();
+  if (num_dropped_events_ > 0) {
+    LOG(LS_WARNING) << "Dropped " << num_dropped_events_
+                    << " debug dump events.";
+  }
+}
+
+bool DebugDumpWriter::Enqueue(std::unique_ptr<audioproc::Event>* event) {
+  RTC_DCHECK(*event);
+  if (!writing()) {
+    (*event)->Clear();
+    return false;
+  }
+  if (!queue_.Insert(event)) {
+    rtc::AtomicOps::Increment(&num_dropped_events_);
+    (*event)->Clear();
+    return false;
+  }
+  // The queue only holds empty slots until it has been filled once.
+  if (!*event)
+    event->reset(new audioproc::Event());
+  // Waking the writer right away keeps the queue short, also when the audio is
+  // processed faster than real time.
+  wake_up_.Set();
+  return true;
+}
+
+bool DebugDumpWriter::writing() const {
+  return rtc::AtomicOps::AcquireLoad(&writing_) != 0;
+}
+
+int DebugDumpWriter::num_dropped_events() const {
+  return rtc::AtomicOps::AcquireLoad(&num_dropped_events_);
+}
+
+bool DebugDumpWriter::Run(void* obj) {
+  DebugDumpWriter* writer = static_cast<DebugDumpWriter*>(obj);
+  writer->wake_up_.Wait(rtc::Event::kForever);
+  // The destructor writes what is left once the thread has stopped.
+  if (rtc::AtomicOps::AcquireLoad(&writer->quit_))
+    return false;
+  writer->WriteQueuedEvents();
+  return true;
+}
+
+void DebugDumpWriter::WriteQueuedEvents() {
+  // Removing swaps the cleared |event_| into the queue.
+  while (queue_.Remove(&event_)) {
+    if (writing() && !WriteEvent(*event_)) {
+      file_->CloseFile();
+      rtc::AtomicOps::ReleaseStore(&writing_, 0);
+    }
+    event_->Clear();
+  }
+}
+
+bool DebugDumpWriter::WriteEvent(const audioproc::Event& event) {
+  int32_t size = event.ByteSize();
+  if (size <= 0) {
+    return false;
+  }
+#if defined(WEBRTC_ARCH_BIG_ENDIAN)
+// TODO(ajm): Use little-endian "on the wire". For the moment, we can be
+//            pretty safe in assuming little-endian.
+#endif
+
+  if (!event.SerializeToString(&event_str_)) {
+    return false;
+  }
+
+  // Update the byte counter.
+  if (num_bytes_left_for_log_ >= 0) {
+    num_bytes_left_for_log_ -= (sizeof(int32_t) + event_str_.length());
+    if (num_bytes_left_for_log_ < 0) {
+      // Not enough bytes are left to write this message, so stop logging.
+      return false;
+    }
+  }
+  // Write message preceded by its size.
+  return file_->Write(&size, sizeof(int32_t)) &&
+         file_->Write(event_str_.data(), event_str_.length());
+}
+
+}  // namespace webrtc
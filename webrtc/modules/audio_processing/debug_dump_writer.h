@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_PROCESSING_DEBUG_DUMP_WRITER_H_
+#define WEBRTC_MODULES_AUDIO_PROCESSING_DEBUG_DUMP_WRITER_H_
+
+#include <memory>
+#include <string>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/swap_queue.h"
+#include "webrtc/system_wrappers/include/file_wrapper.h"
+
+// Files generated at build-time by the protobuf compiler.
+#ifdef WEBRTC_ANDROID_PLATFORM_BUILD
+#include "external/webrtc/webrtc/modules/audio_processing/debug.pb.h"
+#else
+#include "webrtc/modules/audio_processing/debug.pb.h"
+#endif
+
+namespace webrtc {
+
+// Writes the events of a debug dump (aecdump) from a thread of its own, so
+// that the audio threads only hand over their events and neither serialize
+// them nor wait for the file. The events are passed through a bounded queue;
+// when the writer falls behind, new events are dropped and counted instead of
+// blocking the audio threads. The writer must be created and destroyed on the
+// same thread.
+class DebugDumpWriter final {
+ public:
+  // Starts writing to |file|, which must be open. Writing stops once the next
+  // event doesn't fit in |max_log_size_bytes|, unless that is negative.
+  DebugDumpWriter(std::unique_ptr<FileWrapper> file,
+                  int64_t max_log_size_bytes,
+                  size_t max_queued_events);
+  // Writes the events which are still queued and closes the file.
+  ~DebugDumpWriter();
+
+  // Queues |*event| for writing and replaces it with a cleared event. Returns
+  // false if the event was dropped, either because the queue is full or
+  // because writing has stopped. Can be called from any thread.
+  bool Enqueue(std::unique_ptr<audioproc::Event>* event);
+
+  // Returns false once the size limit is reached or a write has failed, after
+  // which there is no point in creating new events.
+  bool writing() const;
+
+  // Number of events dropped because the queue was full.
+  int num_dropped_events() const;
+
+ private:
+  static bool Run(void* obj);
+  void WriteQueuedEvents();
+  bool WriteEvent(const audioproc::Event& event);
+
+  std::unique_ptr<FileWrapper> file_;
+  // Number of bytes that can still be written to the file before the maximum
+  // size is reached. A negative value indicates that no limit is used.
+  int64_t num_bytes_left_for_log_;
+  SwapQueue<std::unique_ptr<audioproc::Event>> queue_;
+  // Cleared event to swap into the queue for the next removed one.
+  std::unique_ptr<audioproc::Event> event_;
+  std::string event_str_;  // Memory for protobuf serialization.
+  volatile int writing_;
+  volatile int num_dropped_events_;
+  // Set by the destructor to make the thread return instead of waiting again.
+  volatile int quit_;
+  rtc::Event wake_up_;
+  rtc::PlatformThread thread_;
+
+  RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(DebugDumpWriter);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_PROCESSING_DEBUG_DUMP_WRITER_H_
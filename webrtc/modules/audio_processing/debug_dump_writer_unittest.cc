@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/modules/audio_processing/debug_dump_writer.h"
+#include "webrtc/modules/audio_processing/test/protobuf_utils.h"
+#include "webrtc/test/testsupport/fileutils.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kMaxQueuedEvents = 4;
+
+std::unique_ptr<DebugDumpWriter> CreateWriter(const std::string& filename,
+                                              int64_t max_log_size_bytes) {
+  std::unique_ptr<FileWrapper> file(FileWrapper::Create());
+  EXPECT_EQ(0, file->OpenFile(filename.c_str(), false));
+  return std::unique_ptr<DebugDumpWriter>(new DebugDumpWriter(
+      std::move(file), max_log_size_bytes, kMaxQueuedEvents));
+}
+
+// Enqueues reverse stream events with the sequence numbers |first| to
+// |first| + |num_events| - 1 as data and returns the number of events that
+// were queued.
+int EnqueueEvents(int first, int num_events, DebugDumpWriter* writer) {
+  std::unique_ptr<audioproc::Event> event(new audioproc::Event());
+  int num_queued = 0;
+  for (int i = first; i < first + num_events; ++i) {
+    event->set_type(audioproc::Event::REVERSE_STREAM);
+    event->mutable_reverse_stream()->set_data(&i, sizeof(i));
+    if (writer->Enqueue(&event))
+      ++num_queued;
+    EXPECT_TRUE(event);
+    EXPECT_FALSE(event->has_type());
+  }
+  return num_queued;
+}
+
+// Reads the events of a dump and returns their sequence numbers.
+std::vector<int> ReadEvents(const std::string& filename) {
+  std::vector<int> sequence_numbers;
+  FILE* file = fopen(filename.c_str(), "rb");
+  EXPECT_TRUE(file);
+  audioproc::Event event;
+  while (ReadMessageFromFile(file, &event)) {
+    EXPECT_EQ(audioproc::Event::REVERSE_STREAM, event.type());
+    int i;
+    EXPECT_EQ(sizeof(i), event.reverse_stream().data().size());
+    memcpy(&i, event.reverse_stream().data().data(), sizeof(i));
+    sequence_numbers.push_back(i);
+  }
+  fclose(file);
+  return sequence_numbers;
+}
+
+}  // namespace
+
+TEST(DebugDumpWriterTest, WritesEventsInOrder) {
+  const std::string filename =
+      test::TempFilename(test::OutputPath(), "debug_dump_writer");
+  std::unique_ptr<DebugDumpWriter> writer = CreateWriter(filename, -1);
+  int num_queued = 0;
+  for (int i = 0; i < 10; ++i)
+    num_queued += EnqueueEvents(i * kMaxQueuedEvents, kMaxQueuedEvents,
+                                writer.get());
+  const int num_dropped = writer->num_dropped_events();
+  EXPECT_TRUE(writer->writing());
+  writer.reset();
+
+  // Events are only dropped when the writer falls behind, but the ones
+  // written always keep their order.
+  const std::vector<int> written = ReadEvents(filename);
+  EXPECT_EQ(10 * static_cast<int>(kMaxQueuedEvents), num_queued + num_dropped);
+  ASSERT_EQ(static_cast<size_t>(num_queued), written.size());
+  for (size_t i = 1; i < written.size(); ++i)
+    EXPECT_LT(written[i - 1], written[i]);
+  remove(filename.c_str());
+}
+
+TEST(DebugDumpWriterTest, DropsEventsWhenQueueIsFull) {
+  const std::string filename =
+      test::TempFilename(test::OutputPath(), "debug_dump_writer");
+  std::unique_ptr<DebugDumpWriter> writer = CreateWriter(filename, -1);
+  // The writer can't remove more than a few events while these are queued.
+  const int kNumEvents = 1000;
+  const int num_queued = EnqueueEvents(0, kNumEvents, writer.get());
+  EXPECT_LT(num_queued, kNumEvents);
+  EXPECT_EQ(kNumEvents, num_queued + writer->num_dropped_events());
+  writer.reset();
+
+  EXPECT_EQ(static_cast<size_t>(num_queued), ReadEvents(filename).size());
+  remove(filename.c_str());
+}
+
+TEST(DebugDumpWriterTest, StopsWritingAtSizeLimit) {
+  const std::string filename =
+      test::TempFilename(test::OutputPath(), "debug_dump_writer");
+  audioproc::Event event;
+  event.set_type(audioproc::Event::REVERSE_STREAM);
+  int i = 0;
+  event.mutable_reverse_stream()->set_data(&i, sizeof(i));
+  const int64_t event_size = sizeof(int32_t) + event.ByteSize();
+
+  // Room for two events.
+  std::unique_ptr<DebugDumpWriter> writer =
+      CreateWriter(filename, 2 * event_size + 1);
+  EXPECT_EQ(3, EnqueueEvents(0, 3, writer.get()));
+  writer.reset();
+
+  EXPECT_EQ(2u, ReadEvents(filename).size());
+  remove(filename.c_str());
+}
+
+}  // namespace webrtc
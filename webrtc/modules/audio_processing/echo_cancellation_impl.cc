@@ -527,7 +527,7 @@ void EchoCancellationImpl::AllocateRenderQueue() {
     std::vector<float> template_queue_element(render_queue_element_max_size_);
 
     render_signal_queue_.reset(
-        new SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>(
+        new SpscSwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>(
             kMaxNumFramesToBuffer, template_queue_element,
             RenderQueueItemVerifier<float>(render_queue_element_max_size_)));
 
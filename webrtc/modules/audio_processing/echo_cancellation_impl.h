@@ -110,8 +110,10 @@ class EchoCancellationImpl : public EchoCancellation {
   std::vector<float> render_queue_buffer_ GUARDED_BY(crit_render_);
   std::vector<float> capture_queue_buffer_ GUARDED_BY(crit_capture_);
 
-  // Lock protection not needed.
-  std::unique_ptr<SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>>
+  // Lock protection not needed. Insertions are serialized by crit_render_ and
+  // removals by crit_capture_, which is what SpscSwapQueue requires.
+  std::unique_ptr<
+      SpscSwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>>
       render_signal_queue_;
 
   std::vector<std::unique_ptr<Canceller>> cancellers_;
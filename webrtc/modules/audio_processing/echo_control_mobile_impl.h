@@ -83,9 +83,10 @@ class EchoControlMobileImpl : public EchoControlMobile {
   std::vector<int16_t> render_queue_buffer_ GUARDED_BY(crit_render_);
   std::vector<int16_t> capture_queue_buffer_ GUARDED_BY(crit_capture_);
 
-  // Lock protection not needed.
+  // Lock protection not needed. Insertions are serialized by crit_render_ and
+  // removals by crit_capture_, which is what SpscSwapQueue requires.
   std::unique_ptr<
-      SwapQueue<std::vector<int16_t>, RenderQueueItemVerifier<int16_t>>>
+      SpscSwapQueue<std::vector<int16_t>, RenderQueueItemVerifier<int16_t>>>
       render_signal_queue_;
 
   std::vector<std::unique_ptr<Canceller>> cancellers_;
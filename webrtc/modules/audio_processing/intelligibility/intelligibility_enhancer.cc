@@ -51,14 +51,17 @@ float DotProduct(const float* a, const float* b, size_t length) {
 }
 
 // Computes the power across ERB bands from the power spectral density |pow|.
-// Stores it in |result|.
+// Stores it in |result|. Only the non-zero |ranges| of the filters are used.
 void MapToErbBands(const float* pow,
                    const std::vector<std::vector<float>>& filter_bank,
+                   const std::vector<std::pair<size_t, size_t>>& ranges,
                    float* result) {
   for (size_t i = 0; i < filter_bank.size(); ++i) {
     RTC_DCHECK_GT(filter_bank[i].size(), 0u);
+    const size_t first = ranges[i].first;
     result[i] = kPowerNormalizationFactor *
-                DotProduct(filter_bank[i].data(), pow, filter_bank[i].size());
+                DotProduct(filter_bank[i].data() + first, pow + first,
+                           ranges[i].second - first);
   }
 }
 
@@ -66,7 +69,8 @@ void MapToErbBands(const float* pow,
 
 IntelligibilityEnhancer::IntelligibilityEnhancer(int sample_rate_hz,
                                                  size_t num_render_channels,
-                                                 size_t num_noise_bins)
+                                                 size_t num_noise_bins,
+                                                 size_t gain_update_interval)
     : freqs_(RealFourier::ComplexLength(
           RealFourier::FftOrder(sample_rate_hz * kWindowSizeMs / 1000))),
       num_noise_bins_(num_noise_bins),
@@ -74,6 +78,7 @@ IntelligibilityEnhancer::IntelligibilityEnhancer(int sample_rate_hz,
       bank_size_(GetBankSize(sample_rate_hz, kErbResolution)),
       sample_rate_hz_(sample_rate_hz),
       num_render_channels_(num_render_channels),
+      gain_update_interval_(gain_update_interval),
       clear_power_estimator_(freqs_, kDecayRate),
       noise_power_estimator_(num_noise_bins, kDecayRate),
       filtered_clear_pow_(bank_size_, 0.f),
@@ -81,6 +86,9 @@ IntelligibilityEnhancer::IntelligibilityEnhancer(int sample_rate_hz,
       center_freqs_(bank_size_),
       capture_filter_bank_(CreateErbBank(num_noise_bins)),
       render_filter_bank_(CreateErbBank(freqs_)),
+      capture_filter_bank_ranges_(FindErbBankRanges(capture_filter_bank_)),
+      render_filter_bank_ranges_(FindErbBankRanges(render_filter_bank_)),
+      blocks_since_gain_update_(0),
       gains_eq_(bank_size_),
       gain_applier_(freqs_, kMaxRelativeGainChange),
       audio_s16_(chunk_length_),
@@ -93,6 +101,7 @@ IntelligibilityEnhancer::IntelligibilityEnhancer(int sample_rate_hz,
                               std::vector<float>(num_noise_bins),
                               RenderQueueItemVerifier<float>(num_noise_bins)) {
   RTC_DCHECK_LE(kRho, 1.f);
+  RTC_DCHECK_GT(gain_update_interval_, 0u);
 
   const size_t erb_index = static_cast<size_t>(
       ceilf(11.17f * logf((kClipFreqKhz + 0.312f) / (kClipFreqKhz + 14.6575f)) +
@@ -144,11 +153,12 @@ void IntelligibilityEnhancer::ProcessAudioBlock(
     clear_power_estimator_.Step(in_block[0]);
   }
   SnrBasedEffectActivation();
-  if (is_active_) {
+  if (is_active_ && ++blocks_since_gain_update_ >= gain_update_interval_) {
+    blocks_since_gain_update_ = 0;
     MapToErbBands(clear_power_estimator_.power().data(), render_filter_bank_,
-                  filtered_clear_pow_.data());
+                  render_filter_bank_ranges_, filtered_clear_pow_.data());
     MapToErbBands(noise_power_estimator_.power().data(), capture_filter_bank_,
-                  filtered_noise_pow_.data());
+                  capture_filter_bank_ranges_, filtered_noise_pow_.data());
     SolveForGainsGivenLambda(kLambdaTop, start_freq_, gains_eq_.data());
     const float power_target = std::accumulate(
         filtered_clear_pow_.data(),
@@ -222,8 +232,13 @@ void IntelligibilityEnhancer::UpdateErbGains() {
   float* gains = gain_applier_.target();
   for (size_t i = 0; i < freqs_; ++i) {
     gains[i] = 0.f;
-    for (size_t j = 0; j < bank_size_; ++j) {
-      gains[i] += render_filter_bank_[j][i] * gains_eq_[j];
+  }
+  // Accumulated filter by filter, over the frequencies each one covers.
+  for (size_t j = 0; j < bank_size_; ++j) {
+    const float* filter = render_filter_bank_[j].data();
+    for (size_t i = render_filter_bank_ranges_[j].first;
+         i < render_filter_bank_ranges_[j].second; ++i) {
+      gains[i] += filter[i] * gains_eq_[j];
     }
   }
 }
@@ -303,6 +318,25 @@ std::vector<std::vector<float>> IntelligibilityEnhancer::CreateErbBank(
   return filter_bank;
 }
 
+std::vector<std::pair<size_t, size_t>>
+IntelligibilityEnhancer::FindErbBankRanges(
+    const std::vector<std::vector<float>>& filter_bank) {
+  std::vector<std::pair<size_t, size_t>> ranges(filter_bank.size());
+  for (size_t i = 0; i < filter_bank.size(); ++i) {
+    const std::vector<float>& filter = filter_bank[i];
+    size_t first = 0;
+    size_t last = filter.size();
+    while (first < last && filter[first] == 0.f) {
+      ++first;
+    }
+    while (last > first && filter[last - 1] == 0.f) {
+      --last;
+    }
+    ranges[i] = std::make_pair(first, last);
+  }
+  return ranges;
+}
+
 void IntelligibilityEnhancer::SolveForGainsGivenLambda(float lambda,
                                                        size_t start_freq,
                                                        float* sols) {
@@ -13,6 +13,7 @@
 
 #include <complex>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "webrtc/base/swap_queue.h"
@@ -31,9 +32,13 @@ namespace webrtc {
 // http://ieeexplore.ieee.org/stamp/stamp.jsp?tp=&arnumber=6882788
 class IntelligibilityEnhancer : public LappedTransform::Callback {
  public:
+  // The optimal gains are solved for every |gain_update_interval| blocks, and
+  // the gains applied to the blocks in between move towards the last solution.
+  // An interval above 1 trades adaptation speed for complexity.
   IntelligibilityEnhancer(int sample_rate_hz,
                           size_t num_render_channels,
-                          size_t num_noise_bins);
+                          size_t num_noise_bins,
+                          size_t gain_update_interval);
 
   // Sets the capture noise magnitude spectrum estimate.
   void SetCaptureNoiseEstimate(std::vector<float> noise, int gain_db);
@@ -55,6 +60,7 @@ class IntelligibilityEnhancer : public LappedTransform::Callback {
 
  private:
   FRIEND_TEST_ALL_PREFIXES(IntelligibilityEnhancerTest, TestErbCreation);
+  FRIEND_TEST_ALL_PREFIXES(IntelligibilityEnhancerTest, TestErbBankRanges);
   FRIEND_TEST_ALL_PREFIXES(IntelligibilityEnhancerTest, TestSolveForGains);
   FRIEND_TEST_ALL_PREFIXES(IntelligibilityEnhancerTest,
                            TestNoiseGainHasExpectedResult);
@@ -75,6 +81,11 @@ class IntelligibilityEnhancer : public LappedTransform::Callback {
   // Initializes ERB filterbank.
   std::vector<std::vector<float>> CreateErbBank(size_t num_freqs);
 
+  // Returns the [first, last) range of non-zero taps of each ERB filter, as
+  // each filter only covers a few of the frequencies.
+  static std::vector<std::pair<size_t, size_t>> FindErbBankRanges(
+      const std::vector<std::vector<float>>& filter_bank);
+
   // Analytically solves quadratic for optimal gains given |lambda|.
   // Negative gains are set to 0. Stores the results in |sols|.
   void SolveForGainsGivenLambda(float lambda, size_t start_freq, float* sols);
@@ -90,6 +101,7 @@ class IntelligibilityEnhancer : public LappedTransform::Callback {
   const size_t bank_size_;     // Num ERB filters.
   const int sample_rate_hz_;
   const size_t num_render_channels_;
+  const size_t gain_update_interval_;
 
   intelligibility::PowerEstimator<std::complex<float>> clear_power_estimator_;
   intelligibility::PowerEstimator<float> noise_power_estimator_;
@@ -98,7 +110,10 @@ class IntelligibilityEnhancer : public LappedTransform::Callback {
   std::vector<float> center_freqs_;
   std::vector<std::vector<float>> capture_filter_bank_;
   std::vector<std::vector<float>> render_filter_bank_;
+  const std::vector<std::pair<size_t, size_t>> capture_filter_bank_ranges_;
+  const std::vector<std::pair<size_t, size_t>> render_filter_bank_ranges_;
   size_t start_freq_;
+  size_t blocks_since_gain_update_;
 
   std::vector<float> gains_eq_;  // Pre-filter modified gains.
   intelligibility::GainApplier gain_applier_;
@@ -207,6 +207,7 @@ const int kSampleRate = 4000;
 const int kNumChannels = 1;
 const int kFragmentSize = kSampleRate / 100;
 const size_t kNumNoiseBins = 129;
+const size_t kGainUpdateInterval = 1;
 
 // Number of frames to process in the bitexactness tests.
 const size_t kNumFramesToProcess = 1000;
@@ -276,7 +277,8 @@ void RunBitexactnessTest(int sample_rate_hz,
 
   IntelligibilityEnhancer intelligibility_enhancer(
       IntelligibilityEnhancerSampleRate(sample_rate_hz),
-      render_config.num_channels(), NoiseSuppressionImpl::num_noise_bins());
+      render_config.num_channels(), NoiseSuppressionImpl::num_noise_bins(),
+      kGainUpdateInterval);
 
   for (size_t frame_no = 0u; frame_no < kNumFramesToProcess; ++frame_no) {
     ReadFloatSamplesFromStereoFile(render_buffer.num_frames(),
@@ -322,13 +324,14 @@ class IntelligibilityEnhancerTest : public ::testing::Test {
   IntelligibilityEnhancerTest()
       : clear_data_(kSamples), noise_data_(kSamples), orig_data_(kSamples) {
     std::srand(1);
-    enh_.reset(
-        new IntelligibilityEnhancer(kSampleRate, kNumChannels, kNumNoiseBins));
+    enh_.reset(new IntelligibilityEnhancer(kSampleRate, kNumChannels,
+                                           kNumNoiseBins, kGainUpdateInterval));
   }
 
-  bool CheckUpdate() {
-    enh_.reset(
-        new IntelligibilityEnhancer(kSampleRate, kNumChannels, kNumNoiseBins));
+  bool CheckUpdate(size_t gain_update_interval) {
+    enh_.reset(new IntelligibilityEnhancer(kSampleRate, kNumChannels,
+                                           kNumNoiseBins,
+                                           gain_update_interval));
     float* clear_cursor = clear_data_.data();
     float* noise_cursor = noise_data_.data();
     for (int i = 0; i < kSamples; i += kFragmentSize) {
@@ -356,12 +359,41 @@ TEST_F(IntelligibilityEnhancerTest, TestRenderUpdate) {
   std::fill(noise_data_.begin(), noise_data_.end(), 0.f);
   std::fill(orig_data_.begin(), orig_data_.end(), 0.f);
   std::fill(clear_data_.begin(), clear_data_.end(), 0.f);
-  EXPECT_FALSE(CheckUpdate());
+  EXPECT_FALSE(CheckUpdate(kGainUpdateInterval));
   std::generate(noise_data_.begin(), noise_data_.end(), float_rand);
-  EXPECT_FALSE(CheckUpdate());
+  EXPECT_FALSE(CheckUpdate(kGainUpdateInterval));
   std::generate(clear_data_.begin(), clear_data_.end(), float_rand);
   orig_data_ = clear_data_;
-  EXPECT_TRUE(CheckUpdate());
+  EXPECT_TRUE(CheckUpdate(kGainUpdateInterval));
+}
+
+// Tests that the render stream is still updated when the gains are solved for
+// less often.
+TEST_F(IntelligibilityEnhancerTest, TestRenderUpdateWithLowerGainUpdateRate) {
+  const size_t kLowerGainUpdateInterval = 4;
+  std::fill(noise_data_.begin(), noise_data_.end(), 0.f);
+  std::fill(orig_data_.begin(), orig_data_.end(), 0.f);
+  std::fill(clear_data_.begin(), clear_data_.end(), 0.f);
+  EXPECT_FALSE(CheckUpdate(kLowerGainUpdateInterval));
+  std::generate(clear_data_.begin(), clear_data_.end(), float_rand);
+  orig_data_ = clear_data_;
+  EXPECT_TRUE(CheckUpdate(kLowerGainUpdateInterval));
+}
+
+// Tests that the non-zero ranges of the ERB filters cover all their taps.
+TEST_F(IntelligibilityEnhancerTest, TestErbBankRanges) {
+  ASSERT_EQ(enh_->bank_size_, enh_->render_filter_bank_ranges_.size());
+  for (size_t i = 0; i < enh_->bank_size_; ++i) {
+    const size_t first = enh_->render_filter_bank_ranges_[i].first;
+    const size_t last = enh_->render_filter_bank_ranges_[i].second;
+    ASSERT_LE(first, last);
+    ASSERT_LE(last, enh_->freqs_);
+    for (size_t j = 0; j < enh_->freqs_; ++j) {
+      if (j < first || j >= last) {
+        EXPECT_EQ(0.f, enh_->render_filter_bank_[i][j]);
+      }
+    }
+  }
 }
 
 // Tests ERB bank creation, comparing against matlab output.
@@ -18,6 +18,25 @@
 #include "webrtc/modules/audio_processing/ns/noise_suppression.h"
 #include "webrtc/modules/audio_processing/ns/ns_core.h"
 #include "webrtc/modules/audio_processing/ns/windows_private.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+
+NsSpectrumFromRdft WebRtcNs_SpectrumFromRdft;
+NsUpdateQuantile WebRtcNs_UpdateQuantile;
+NsComputeDdBasedWienerFilter WebRtcNs_ComputeDdBasedWienerFilter;
+
+static void SpectrumFromRdft(const float* time_data,
+                             size_t magnitude_length,
+                             float* real,
+                             float* imag,
+                             float* magn);
+static void UpdateQuantile(const float* lmagn,
+                           size_t magnitude_length,
+                           int counter,
+                           float* lquantile,
+                           float* density);
+static void ComputeDdBasedWienerFilter(const NoiseSuppressionC* self,
+                                       const float* magn,
+                                       float* theFilter);
 
 // Set Feature Extraction Parameters.
 static void set_feature_extraction_parameters(NoiseSuppressionC* self) {
@@ -209,16 +228,60 @@ int WebRtcNs_InitCore(NoiseSuppressionC* self, uint32_t fs) {
   // Default mode.
   WebRtcNs_set_policy_core(self, 0);
 
+  WebRtcNs_SpectrumFromRdft = SpectrumFromRdft;
+  WebRtcNs_UpdateQuantile = UpdateQuantile;
+  WebRtcNs_ComputeDdBasedWienerFilter = ComputeDdBasedWienerFilter;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    WebRtcNs_SpectrumFromRdft = WebRtcNs_SpectrumFromRdftSse2;
+    WebRtcNs_UpdateQuantile = WebRtcNs_UpdateQuantileSse2;
+    WebRtcNs_ComputeDdBasedWienerFilter =
+        WebRtcNs_ComputeDdBasedWienerFilterSse2;
+  }
+#endif
+
   self->initFlag = 1;
   return 0;
 }
 
+// Updates one of the simultaneous quantile estimates. See NsUpdateQuantile.
+static void UpdateQuantile(const float* lmagn,
+                           size_t magnitude_length,
+                           int counter,
+                           float* lquantile,
+                           float* density) {
+  size_t i;
+  float delta;
+
+  for (i = 0; i < magnitude_length; i++) {
+    // Compute delta.
+    if (density[i] > 1.0) {
+      delta = FACTOR * 1.f / density[i];
+    } else {
+      delta = FACTOR;
+    }
+
+    // Update log quantile estimate.
+    if (lmagn[i] > lquantile[i]) {
+      lquantile[i] += QUANTILE * delta / (float)(counter + 1);
+    } else {
+      lquantile[i] -= (1.f - QUANTILE) * delta / (float)(counter + 1);
+    }
+
+    // Update density estimate.
+    if (fabs(lmagn[i] - lquantile[i]) < WIDTH) {
+      density[i] = ((float)counter * density[i] + 1.f / (2.f * WIDTH)) /
+                   (float)(counter + 1);
+    }
+  }  // End loop over magnitude spectrum.
+}
+
 // Estimate noise.
 static void NoiseEstimation(NoiseSuppressionC* self,
                             float* magn,
                             float* noise) {
   size_t i, s, offset;
-  float lmagn[HALF_ANAL_BLOCKL], delta;
+  float lmagn[HALF_ANAL_BLOCKL];
 
   if (self->updates < END_STARTUP_LONG) {
     self->updates++;
@@ -233,31 +296,8 @@ static void NoiseEstimation(NoiseSuppressionC* self,
     offset = s * self->magnLen;
 
     // newquantest(...)
-    for (i = 0; i < self->magnLen; i++) {
-      // Compute delta.
-      if (self->density[offset + i] > 1.0) {
-        delta = FACTOR * 1.f / self->density[offset + i];
-      } else {
-        delta = FACTOR;
-      }
-
-      // Update log quantile estimate.
-      if (lmagn[i] > self->lquantile[offset + i]) {
-        self->lquantile[offset + i] +=
-            QUANTILE * delta / (float)(self->counter[s] + 1);
-      } else {
-        self->lquantile[offset + i] -=
-            (1.f - QUANTILE) * delta / (float)(self->counter[s] + 1);
-      }
-
-      // Update density estimate.
-      if (fabs(lmagn[i] - self->lquantile[offset + i]) < WIDTH) {
-        self->density[offset + i] =
-            ((float)self->counter[s] * self->density[offset + i] +
-             1.f / (2.f * WIDTH)) /
-            (float)(self->counter[s] + 1);
-      }
-    }  // End loop over magnitude spectrum.
+    WebRtcNs_UpdateQuantile(lmagn, self->magnLen, self->counter[s],
+                            &self->lquantile[offset], &self->density[offset]);
 
     if (self->counter[s] >= END_STARTUP_LONG) {
       self->counter[s] = 0;
@@ -891,8 +931,6 @@ static void FFT(NoiseSuppressionC* self,
                 float* real,
                 float* imag,
                 float* magn) {
-  size_t i;
-
   assert(magnitude_length == time_data_length / 2 + 1);
 
   WebRtc_rdft(time_data_length, 1, time_data, self->ip, self->wfft);
@@ -903,6 +941,17 @@ static void FFT(NoiseSuppressionC* self,
   imag[magnitude_length - 1] = 0;
   real[magnitude_length - 1] = time_data[1];
   magn[magnitude_length - 1] = fabsf(real[magnitude_length - 1]) + 1.f;
+  WebRtcNs_SpectrumFromRdft(time_data, magnitude_length, real, imag, magn);
+}
+
+// Splits the spectrum computed by FFT(). See NsSpectrumFromRdft.
+static void SpectrumFromRdft(const float* time_data,
+                             size_t magnitude_length,
+                             float* real,
+                             float* imag,
+                             float* magn) {
+  size_t i;
+
   for (i = 1; i < magnitude_length - 1; ++i) {
     real[i] = time_data[2 * i];
     imag[i] = time_data[2 * i + 1];
@@ -1272,7 +1321,7 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
     }
   }
 
-  ComputeDdBasedWienerFilter(self, magn, theFilter);
+  WebRtcNs_ComputeDdBasedWienerFilter(self, magn, theFilter);
 
   for (i = 0; i < self->magnLen; i++) {
     // Flooring bottom.
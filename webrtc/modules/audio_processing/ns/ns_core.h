@@ -12,6 +12,7 @@
 #define WEBRTC_MODULES_AUDIO_PROCESSING_NS_NS_CORE_H_
 
 #include "webrtc/modules/audio_processing/ns/defines.h"
+#include "webrtc/typedefs.h"
 
 typedef struct NSParaExtract_ {
   // Bin size of histogram.
@@ -184,6 +185,55 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
                           size_t num_bands,
                           float* const* outFrame);
 
+/****************************************************************************
+ * Function pointers for the per-bin spectral kernels, which have SSE2
+ * versions. They are set up by WebRtcNs_InitCore() and give bit-exact
+ * results on all platforms.
+ */
+
+// Splits the interleaved output of WebRtc_rdft() in |time_data| into |real|
+// and |imag|, and computes the magnitude spectrum plus one in |magn|, for the
+// bins 1 to |magnitude_length| - 2.
+typedef void (*NsSpectrumFromRdft)(const float* time_data,
+                                   size_t magnitude_length,
+                                   float* real,
+                                   float* imag,
+                                   float* magn);
+extern NsSpectrumFromRdft WebRtcNs_SpectrumFromRdft;
+
+// Updates one of the simultaneous log quantile and density estimates with the
+// log magnitude spectrum |lmagn|. |counter| is the number of updates of the
+// estimate so far.
+typedef void (*NsUpdateQuantile)(const float* lmagn,
+                                 size_t magnitude_length,
+                                 int counter,
+                                 float* lquantile,
+                                 float* density);
+extern NsUpdateQuantile WebRtcNs_UpdateQuantile;
+
+// Estimates the prior SNR decision-directed and computes the DD based Wiener
+// filter for the magnitude spectrum |magn|.
+typedef void (*NsComputeDdBasedWienerFilter)(const NoiseSuppressionC* self,
+                                             const float* magn,
+                                             float* theFilter);
+extern NsComputeDdBasedWienerFilter WebRtcNs_ComputeDdBasedWienerFilter;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcNs_SpectrumFromRdftSse2(const float* time_data,
+                                   size_t magnitude_length,
+                                   float* real,
+                                   float* imag,
+                                   float* magn);
+void WebRtcNs_UpdateQuantileSse2(const float* lmagn,
+                                 size_t magnitude_length,
+                                 int counter,
+                                 float* lquantile,
+                                 float* density);
+void WebRtcNs_ComputeDdBasedWienerFilterSse2(const NoiseSuppressionC* self,
+                                             const float* magn,
+                                             float* theFilter);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
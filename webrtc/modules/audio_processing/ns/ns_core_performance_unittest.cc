@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <math.h>
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/audio_processing/ns/noise_suppression.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+const uint32_t kSampleRateHz = 16000;
+const size_t kFrameLength = kSampleRateHz / 100;
+const int kFramesPerSecond = 100;
+const int kNumSeconds = 20;
+
+// Runs the float noise suppressor on a noisy tone at 16 kHz and reports the
+// CPU time spent per second of audio for a single channel. The kernels are
+// selected by WebRtcNs_Init() from WebRtc_GetCPUInfo().
+void MeasureNoiseSuppressor(const std::string& name) {
+  NsHandle* ns = WebRtcNs_Create();
+  ASSERT_TRUE(ns);
+  ASSERT_EQ(0, WebRtcNs_Init(ns, kSampleRateHz));
+  ASSERT_EQ(0, WebRtcNs_set_policy(ns, 2));
+
+  Random random(42);
+  float in[kFrameLength];
+  float out[kFrameLength];
+  const float* const in_bands[] = {in};
+  float* const out_bands[] = {out};
+
+  int64_t elapsed_ns = 0;
+  for (int frame = 0; frame < kNumSeconds * kFramesPerSecond; ++frame) {
+    for (size_t i = 0; i < kFrameLength; ++i) {
+      const float t = static_cast<float>(frame * kFrameLength + i);
+      in[i] = 3000.f * sinf(2.f * 3.14159265f * 440.f * t / kSampleRateHz) +
+              static_cast<float>(random.Gaussian(0, 1000));
+    }
+    const int64_t start_ns = rtc::TimeNanos();
+    WebRtcNs_Analyze(ns, in);
+    WebRtcNs_Process(ns, in_bands, 1, out_bands);
+    elapsed_ns += rtc::TimeNanos() - start_ns;
+  }
+  WebRtcNs_Free(ns);
+
+  test::PrintResult("ns_float", "", name,
+                    static_cast<size_t>(elapsed_ns / kNumSeconds /
+                                        rtc::kNumNanosecsPerMicrosec),
+                    "us/s", true);
+}
+}  // namespace
+
+TEST(NsCorePerformanceTest, FloatNoiseSuppressor) {
+  WebRtc_CPUInfo get_cpu_info = WebRtc_GetCPUInfo;
+  WebRtc_GetCPUInfo = WebRtc_GetCPUInfoNoASM;
+  MeasureNoiseSuppressor("c");
+  WebRtc_GetCPUInfo = get_cpu_info;
+  if (WebRtc_GetCPUInfo(kSSE2))
+    MeasureNoiseSuppressor("sse2");
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+}  // namespace webrtc
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * SSE2 versions of the per-bin kernels of the float noise suppressor. They
+ * do the same operations in the same order as the C versions in ns_core.c,
+ * four bins at a time, and are therefore bit-exact with them.
+ */
+
+#include <emmintrin.h>
+#include <math.h>
+
+#include "webrtc/modules/audio_processing/ns/ns_core.h"
+
+void WebRtcNs_SpectrumFromRdftSse2(const float* time_data,
+                                   size_t magnitude_length,
+                                   float* real,
+                                   float* imag,
+                                   float* magn) {
+  const __m128 kOne = _mm_set1_ps(1.f);
+  size_t i;
+
+  // vectorized code (four at once)
+  for (i = 1; i + 4 < magnitude_length; i += 4) {
+    const __m128 a = _mm_loadu_ps(&time_data[2 * i]);
+    const __m128 b = _mm_loadu_ps(&time_data[2 * i + 4]);
+    const __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m128 re2 = _mm_mul_ps(re, re);
+    const __m128 im2 = _mm_mul_ps(im, im);
+    const __m128 m = _mm_add_ps(_mm_sqrt_ps(_mm_add_ps(re2, im2)), kOne);
+    _mm_storeu_ps(&real[i], re);
+    _mm_storeu_ps(&imag[i], im);
+    _mm_storeu_ps(&magn[i], m);
+  }
+  // scalar code for the remaining items.
+  for (; i < magnitude_length - 1; ++i) {
+    real[i] = time_data[2 * i];
+    imag[i] = time_data[2 * i + 1];
+    magn[i] = sqrtf(real[i] * real[i] + imag[i] * imag[i]) + 1.f;
+  }
+}
+
+void WebRtcNs_UpdateQuantileSse2(const float* lmagn,
+                                 size_t magnitude_length,
+                                 int counter,
+                                 float* lquantile,
+                                 float* density) {
+  const float counter_plus_one = (float)(counter + 1);
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kFactor = _mm_set1_ps(FACTOR * 1.f);
+  const __m128 kQuantile = _mm_set1_ps(QUANTILE);
+  const __m128 kOneMinusQuantile = _mm_set1_ps(1.f - QUANTILE);
+  const __m128 kWidth = _mm_set1_ps(WIDTH);
+  const __m128 kDensityStep = _mm_set1_ps(1.f / (2.f * WIDTH));
+  const __m128 kAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  const __m128 counter_ps = _mm_set1_ps((float)counter);
+  const __m128 counter_plus_one_ps = _mm_set1_ps(counter_plus_one);
+  size_t i;
+
+  // vectorized code (four at once)
+  for (i = 0; i + 3 < magnitude_length; i += 4) {
+    const __m128 lmagn_ps = _mm_loadu_ps(&lmagn[i]);
+    __m128 lquantile_ps = _mm_loadu_ps(&lquantile[i]);
+    __m128 density_ps = _mm_loadu_ps(&density[i]);
+
+    // Compute delta.
+    const __m128 dense = _mm_cmpgt_ps(density_ps, kOne);
+    const __m128 delta =
+        _mm_or_ps(_mm_and_ps(dense, _mm_div_ps(kFactor, density_ps)),
+                  _mm_andnot_ps(dense, kFactor));
+
+    // Update log quantile estimate.
+    const __m128 above = _mm_cmpgt_ps(lmagn_ps, lquantile_ps);
+    const __m128 up = _mm_add_ps(
+        lquantile_ps,
+        _mm_div_ps(_mm_mul_ps(kQuantile, delta), counter_plus_one_ps));
+    const __m128 down = _mm_sub_ps(
+        lquantile_ps,
+        _mm_div_ps(_mm_mul_ps(kOneMinusQuantile, delta), counter_plus_one_ps));
+    lquantile_ps =
+        _mm_or_ps(_mm_and_ps(above, up), _mm_andnot_ps(above, down));
+
+    // Update density estimate.
+    const __m128 distance =
+        _mm_and_ps(_mm_sub_ps(lmagn_ps, lquantile_ps), kAbsMask);
+    const __m128 close = _mm_cmplt_ps(distance, kWidth);
+    const __m128 new_density = _mm_div_ps(
+        _mm_add_ps(_mm_mul_ps(counter_ps, density_ps), kDensityStep),
+        counter_plus_one_ps);
+    density_ps = _mm_or_ps(_mm_and_ps(close, new_density),
+                           _mm_andnot_ps(close, density_ps));
+
+    _mm_storeu_ps(&lquantile[i], lquantile_ps);
+    _mm_storeu_ps(&density[i], density_ps);
+  }
+  // scalar code for the remaining items.
+  for (; i < magnitude_length; i++) {
+    float delta;
+    if (density[i] > 1.0) {
+      delta = FACTOR * 1.f / density[i];
+    } else {
+      delta = FACTOR;
+    }
+    if (lmagn[i] > lquantile[i]) {
+      lquantile[i] += QUANTILE * delta / counter_plus_one;
+    } else {
+      lquantile[i] -= (1.f - QUANTILE) * delta / counter_plus_one;
+    }
+    if (fabs(lmagn[i] - lquantile[i]) < WIDTH) {
+      density[i] = ((float)counter * density[i] + 1.f / (2.f * WIDTH)) /
+                   counter_plus_one;
+    }
+  }
+}
+
+void WebRtcNs_ComputeDdBasedWienerFilterSse2(const NoiseSuppressionC* self,
+                                             const float* magn,
+                                             float* theFilter) {
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kZero = _mm_setzero_ps();
+  const __m128 kEpsilon = _mm_set1_ps(0.0001f);
+  const __m128 kDdPrSnr = _mm_set1_ps(DD_PR_SNR);
+  const __m128 kOneMinusDdPrSnr = _mm_set1_ps(1.f - DD_PR_SNR);
+  const __m128 overdrive = _mm_set1_ps(self->overdrive);
+  size_t i;
+
+  // vectorized code (four at once)
+  for (i = 0; i + 3 < self->magnLen; i += 4) {
+    const __m128 magn_ps = _mm_loadu_ps(&magn[i]);
+    const __m128 noise_ps = _mm_loadu_ps(&self->noise[i]);
+    // Previous estimate: based on previous frame with gain filter.
+    const __m128 previous_estimate = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&self->magnPrevProcess[i]),
+                   _mm_add_ps(_mm_loadu_ps(&self->noisePrev[i]), kEpsilon)),
+        _mm_loadu_ps(&self->smooth[i]));
+    // Post and prior SNR.
+    const __m128 above = _mm_cmpgt_ps(magn_ps, noise_ps);
+    const __m128 current_estimate = _mm_or_ps(
+        _mm_and_ps(above,
+                   _mm_sub_ps(_mm_div_ps(magn_ps,
+                                         _mm_add_ps(noise_ps, kEpsilon)),
+                              kOne)),
+        _mm_andnot_ps(above, kZero));
+    // Directed decision update of the prior SNR.
+    const __m128 snr_prior =
+        _mm_add_ps(_mm_mul_ps(kDdPrSnr, previous_estimate),
+                   _mm_mul_ps(kOneMinusDdPrSnr, current_estimate));
+    // Gain filter.
+    _mm_storeu_ps(&theFilter[i],
+                  _mm_div_ps(snr_prior, _mm_add_ps(overdrive, snr_prior)));
+  }
+  // scalar code for the remaining items.
+  for (; i < self->magnLen; i++) {
+    const float previous_estimate = self->magnPrevProcess[i] /
+                                    (self->noisePrev[i] + 0.0001f) *
+                                    self->smooth[i];
+    float current_estimate = 0.f;
+    float snr_prior;
+    if (magn[i] > self->noise[i]) {
+      current_estimate = magn[i] / (self->noise[i] + 0.0001f) - 1.f;
+    }
+    snr_prior = DD_PR_SNR * previous_estimate +
+                (1.f - DD_PR_SNR) * current_estimate;
+    theFilter[i] = snr_prior / (self->overdrive + snr_prior);
+  }
+}
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <memory>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_processing/ns/ns_core.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+
+const int kNumIterations = 100;
+
+void FillRandom(Random* random, float* data, size_t length, float min,
+                float max) {
+  for (size_t i = 0; i < length; ++i)
+    data[i] = min + (max - min) * random->Rand<float>();
+}
+
+class NsCoreSse2Test : public ::testing::Test {
+ protected:
+  // Initializes |self_| with the C kernels selected and keeps them, so that
+  // they can be compared against the SSE2 kernels.
+  void SetUp() override {
+    WebRtc_CPUInfo get_cpu_info = WebRtc_GetCPUInfo;
+    WebRtc_GetCPUInfo = WebRtc_GetCPUInfoNoASM;
+    self_.reset(new NoiseSuppressionC());
+    ASSERT_EQ(0, WebRtcNs_InitCore(self_.get(), 16000));
+    spectrum_from_rdft_c_ = WebRtcNs_SpectrumFromRdft;
+    update_quantile_c_ = WebRtcNs_UpdateQuantile;
+    wiener_filter_c_ = WebRtcNs_ComputeDdBasedWienerFilter;
+    WebRtc_GetCPUInfo = get_cpu_info;
+    ASSERT_EQ(129u, self_->magnLen);
+  }
+
+  std::unique_ptr<NoiseSuppressionC> self_;
+  NsSpectrumFromRdft spectrum_from_rdft_c_;
+  NsUpdateQuantile update_quantile_c_;
+  NsComputeDdBasedWienerFilter wiener_filter_c_;
+};
+
+}  // namespace
+
+TEST_F(NsCoreSse2Test, SpectrumFromRdftIsBitExact) {
+  Random random(42);
+  const size_t magn_len = self_->magnLen;
+  for (int i = 0; i < kNumIterations; ++i) {
+    float time_data[2 * HALF_ANAL_BLOCKL];
+    FillRandom(&random, time_data, 2 * magn_len, -1000.f, 1000.f);
+    float real_c[HALF_ANAL_BLOCKL] = {0};
+    float imag_c[HALF_ANAL_BLOCKL] = {0};
+    float magn_c[HALF_ANAL_BLOCKL] = {0};
+    float real_sse2[HALF_ANAL_BLOCKL] = {0};
+    float imag_sse2[HALF_ANAL_BLOCKL] = {0};
+    float magn_sse2[HALF_ANAL_BLOCKL] = {0};
+    spectrum_from_rdft_c_(time_data, magn_len, real_c, imag_c, magn_c);
+    WebRtcNs_SpectrumFromRdftSse2(time_data, magn_len, real_sse2, imag_sse2,
+                                  magn_sse2);
+    EXPECT_EQ(0, memcmp(real_c, real_sse2, sizeof(real_c)));
+    EXPECT_EQ(0, memcmp(imag_c, imag_sse2, sizeof(imag_c)));
+    EXPECT_EQ(0, memcmp(magn_c, magn_sse2, sizeof(magn_c)));
+  }
+}
+
+TEST_F(NsCoreSse2Test, UpdateQuantileIsBitExact) {
+  Random random(42);
+  const size_t magn_len = self_->magnLen;
+  float lquantile_c[HALF_ANAL_BLOCKL];
+  float density_c[HALF_ANAL_BLOCKL];
+  FillRandom(&random, lquantile_c, magn_len, 0.f, 8.f);
+  FillRandom(&random, density_c, magn_len, 0.f, 2.f);
+  float lquantile_sse2[HALF_ANAL_BLOCKL];
+  float density_sse2[HALF_ANAL_BLOCKL];
+  memcpy(lquantile_sse2, lquantile_c, sizeof(lquantile_c));
+  memcpy(density_sse2, density_c, sizeof(density_c));
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    float lmagn[HALF_ANAL_BLOCKL];
+    FillRandom(&random, lmagn, magn_len, 0.f, 8.f);
+    // Make some bins land within WIDTH of the estimate to exercise the
+    // density update.
+    for (size_t j = 0; j < magn_len; j += 3)
+      lmagn[j] = lquantile_c[j];
+    const int counter = i % END_STARTUP_LONG;
+    update_quantile_c_(lmagn, magn_len, counter, lquantile_c, density_c);
+    WebRtcNs_UpdateQuantileSse2(lmagn, magn_len, counter, lquantile_sse2,
+                                density_sse2);
+    ASSERT_EQ(0, memcmp(lquantile_c, lquantile_sse2,
+                        magn_len * sizeof(lquantile_c[0])));
+    ASSERT_EQ(0,
+              memcmp(density_c, density_sse2, magn_len * sizeof(density_c[0])));
+  }
+}
+
+TEST_F(NsCoreSse2Test, ComputeDdBasedWienerFilterIsBitExact) {
+  Random random(42);
+  const size_t magn_len = self_->magnLen;
+  for (int i = 0; i < kNumIterations; ++i) {
+    FillRandom(&random, self_->noise, magn_len, 0.f, 100.f);
+    FillRandom(&random, self_->noisePrev, magn_len, 0.f, 100.f);
+    FillRandom(&random, self_->magnPrevProcess, magn_len, 0.f, 100.f);
+    FillRandom(&random, self_->smooth, magn_len, 0.f, 1.f);
+    float magn[HALF_ANAL_BLOCKL];
+    FillRandom(&random, magn, magn_len, 0.f, 200.f);
+    float filter_c[HALF_ANAL_BLOCKL] = {0};
+    float filter_sse2[HALF_ANAL_BLOCKL] = {0};
+    wiener_filter_c_(self_.get(), magn, filter_c);
+    WebRtcNs_ComputeDdBasedWienerFilterSse2(self_.get(), magn, filter_sse2);
+    EXPECT_EQ(0, memcmp(filter_c, filter_sse2, sizeof(filter_c)));
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+}  // namespace webrtc
@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string.h>
+
 #include <iostream>
 
 #include "webrtc/modules/audio_processing/test/aec_dump_based_simulator.h"
@@ -25,35 +27,30 @@ namespace {
 // to use for checking the bitexactness in a soft manner.
 bool VerifyFixedBitExactness(const webrtc::audioproc::Stream& msg,
                              const AudioFrame& frame) {
-  if ((sizeof(int16_t) * frame.samples_per_channel_ * frame.num_channels_) !=
-      msg.output_data().size()) {
+  const size_t data_size =
+      sizeof(int16_t) * frame.samples_per_channel_ * frame.num_channels_;
+  if (data_size != msg.output_data().size()) {
     return false;
-  } else {
-    for (size_t k = 0; k < frame.num_channels_ * frame.samples_per_channel_;
-         ++k) {
-      if (msg.output_data().data()[k] != frame.data_[k]) {
-        return false;
-      }
-    }
   }
-  return true;
+  // The samples are stored as raw int16_t.
+  return memcmp(msg.output_data().data(), frame.data_, data_size) == 0;
 }
 
 // Verify output bitexactness for the float interface.
 bool VerifyFloatBitExactness(const webrtc::audioproc::Stream& msg,
                              const StreamConfig& out_config,
                              const ChannelBuffer<float>& out_buf) {
+  const size_t channel_size = sizeof(float) * out_config.num_frames();
   if (static_cast<size_t>(msg.output_channel_size()) !=
           out_config.num_channels() ||
-      msg.output_channel(0).size() != out_config.num_frames()) {
+      msg.output_channel(0).size() != channel_size) {
     return false;
   } else {
+    // The channels are stored as raw floats.
     for (int ch = 0; ch < msg.output_channel_size(); ++ch) {
-      for (size_t sample = 0; sample < out_config.num_frames(); ++sample) {
-        if (msg.output_channel(ch).data()[sample] !=
-            out_buf.channels()[ch][sample]) {
-          return false;
-        }
+      if (memcmp(msg.output_channel(ch).data(), out_buf.channels()[ch],
+                 channel_size) != 0) {
+        return false;
       }
     }
   }
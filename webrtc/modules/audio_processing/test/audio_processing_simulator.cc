@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 
+#include "webrtc/base/stringencode.h"
 #include "webrtc/base/stringutils.h"
 #include "webrtc/common_audio/include/audio_util.h"
 #include "webrtc/modules/audio_processing/include/audio_processing.h"
@@ -80,6 +81,11 @@ void AudioProcessingSimulator::ProcessStream(bool fixed_interface) {
     buffer_writer_->Write(*out_buf_);
   }
 
+  for (size_t ch = 0; ch < out_buf_->num_channels(); ++ch) {
+    output_checksum_.Update(out_buf_->channels()[ch],
+                            sizeof(float) * out_buf_->num_frames());
+  }
+
   ++num_process_stream_calls_;
 }
 
@@ -104,6 +110,12 @@ void AudioProcessingSimulator::ProcessReverseStream(bool fixed_interface) {
   ++num_reverse_process_stream_calls_;
 }
 
+std::string AudioProcessingSimulator::OutputChecksum() {
+  char checksum[rtc::Md5Digest::kSize];
+  output_checksum_.Finish(checksum, sizeof(checksum));
+  return rtc::hex_encode(checksum, sizeof(checksum));
+}
+
 void AudioProcessingSimulator::SetupBuffersConfigsOutputs(
     int input_sample_rate_hz,
     int output_sample_rate_hz,
@@ -18,6 +18,7 @@
 
 #include "webrtc/base/timeutils.h"
 #include "webrtc/base/constructormagic.h"
+#include "webrtc/base/md5digest.h"
 #include "webrtc/base/optional.h"
 #include "webrtc/common_audio/channel_buffer.h"
 #include "webrtc/modules/audio_processing/include/audio_processing.h"
@@ -77,7 +78,8 @@ struct SimulationSettings {
 
 // Holds a few statistics about a series of TickIntervals.
 struct TickIntervalStats {
-  TickIntervalStats() : min(std::numeric_limits<int64_t>::max()) {}
+  TickIntervalStats()
+      : sum(0), max(0), min(std::numeric_limits<int64_t>::max()) {}
   int64_t sum;
   int64_t max;
   int64_t min;
@@ -104,6 +106,11 @@ class AudioProcessingSimulator {
   // Reports whether the processed recording was bitexact.
   bool OutputWasBitexact() { return bitexact_output_; }
 
+  // Returns the MD5 checksum, in hex, of the forward stream output, which
+  // tells whether two simulations produced the same output. Can only be
+  // called once, after Process().
+  std::string OutputChecksum();
+
   size_t get_num_process_stream_calls() { return num_process_stream_calls_; }
   size_t get_num_reverse_process_stream_calls() {
     return num_reverse_process_stream_calls_;
@@ -165,6 +172,7 @@ class AudioProcessingSimulator {
   std::unique_ptr<ChannelBufferWavWriter> buffer_writer_;
   std::unique_ptr<ChannelBufferWavWriter> reverse_buffer_writer_;
   TickIntervalStats proc_time_;
+  rtc::Md5Digest output_checksum_;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(AudioProcessingSimulator);
 };
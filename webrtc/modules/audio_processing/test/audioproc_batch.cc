@@ -0,0 +1,292 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/audio_processing/test/aec_dump_based_simulator.h"
+#include "webrtc/modules/audio_processing/test/audio_processing_simulator.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+const char kUsageDescription[] =
+    "Usage: audioproc_batch [options] -dump_list <file>\n"
+    "\n\n"
+    "Command-line tool to simulate the audio processing module on many aec "
+    "dumps in parallel. It reports the execution time of each dump, whether "
+    "its output was bitexact with the output recorded in the dump and, given "
+    "the report of an earlier run, whether its output has changed since.";
+
+DEFINE_string(dump_list, "", "File with one aec dump filename per line");
+DEFINE_string(report, "", "Output filename of the per-dump report");
+DEFINE_string(reference_report,
+              "",
+              "Report of an earlier run to compare the output checksums to");
+DEFINE_int32(num_threads,
+             0,
+             "Number of dumps to process in parallel, or 0 for one per core. "
+             "More threads than cores make the execution times unreliable");
+DEFINE_bool(discard_settings_in_aecdump,
+            false,
+            "Discard any config settings specified in the aec dumps");
+
+const char kReportHeader[] =
+    "# dump,chunks,exec_time_us,max_chunk_time_us,bitexact,checksum";
+
+// The outcome of the simulation of one aec dump.
+struct DumpResult {
+  std::string dump_filename;
+  size_t num_chunks = 0;  // Forward stream chunks.
+  int64_t exec_time_us = 0;
+  int64_t max_chunk_time_us = 0;
+  bool bitexact = false;
+  std::string checksum;
+};
+
+// Simulates a list of aec dumps on a number of threads, each of which takes
+// the next dump which no thread has started on yet.
+class BatchRunner {
+ public:
+  BatchRunner(const SimulationSettings& settings,
+              const std::vector<std::string>& dump_filenames)
+      : settings_(settings), results_(dump_filenames.size()), next_dump_(0) {
+    for (size_t i = 0; i < dump_filenames.size(); ++i)
+      results_[i].dump_filename = dump_filenames[i];
+  }
+
+  void Run(int num_threads) {
+    std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(std::unique_ptr<rtc::PlatformThread>(
+          new rtc::PlatformThread(&BatchRunner::ProcessDumps, this,
+                                  "audioproc_batch")));
+      threads.back()->Start();
+    }
+    for (auto& thread : threads)
+      thread->Stop();
+  }
+
+  const std::vector<DumpResult>& results() const { return results_; }
+
+ private:
+  // Processes dumps until none is left. Returns false to end the thread.
+  static bool ProcessDumps(void* obj) {
+    BatchRunner* runner = static_cast<BatchRunner*>(obj);
+    while (true) {
+      const size_t index = rtc::AtomicOps::Increment(&runner->next_dump_) - 1;
+      if (index >= runner->results_.size())
+        return false;
+      runner->ProcessDump(&runner->results_[index]);
+    }
+  }
+
+  void ProcessDump(DumpResult* result) const {
+    SimulationSettings settings = settings_;
+    settings.aec_dump_input_filename =
+        rtc::Optional<std::string>(result->dump_filename);
+    AecDumpBasedSimulator simulator(settings);
+    simulator.Process();
+
+    result->num_chunks = simulator.get_num_process_stream_calls();
+    result->exec_time_us =
+        simulator.proc_time().sum / rtc::kNumNanosecsPerMicrosec;
+    result->max_chunk_time_us =
+        simulator.proc_time().max / rtc::kNumNanosecsPerMicrosec;
+    result->bitexact = simulator.OutputWasBitexact();
+    result->checksum = simulator.OutputChecksum();
+  }
+
+  const SimulationSettings settings_;
+  // Only written by the thread which processes the dump.
+  std::vector<DumpResult> results_;
+  volatile int next_dump_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(BatchRunner);
+};
+
+std::vector<std::string> ReadDumpList(const std::string& filename) {
+  std::ifstream file(filename);
+  RTC_CHECK(file.good()) << "Could not open " << filename;
+  std::vector<std::string> dump_filenames;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!line.empty() && line[0] != '#')
+      dump_filenames.push_back(line);
+  }
+  return dump_filenames;
+}
+
+void WriteReport(const std::vector<DumpResult>& results,
+                 const std::string& filename) {
+  std::ofstream file(filename);
+  RTC_CHECK(file.good()) << "Could not open " << filename;
+  file << kReportHeader << std::endl;
+  for (const DumpResult& result : results) {
+    file << result.dump_filename << "," << result.num_chunks << ","
+         << result.exec_time_us << "," << result.max_chunk_time_us << ","
+         << (result.bitexact ? 1 : 0) << "," << result.checksum << std::endl;
+  }
+}
+
+// Returns the output checksum of each dump in a report written by
+// WriteReport().
+std::map<std::string, std::string> ReadReferenceChecksums(
+    const std::string& filename) {
+  std::ifstream file(filename);
+  RTC_CHECK(file.good()) << "Could not open " << filename;
+  std::map<std::string, std::string> checksums;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#')
+      continue;
+    // The dump filename is the first field and the checksum the last.
+    const size_t first_comma = line.find(',');
+    const size_t last_comma = line.rfind(',');
+    RTC_CHECK_NE(std::string::npos, first_comma) << "Malformed report line: "
+                                                 << line;
+    checksums[line.substr(0, first_comma)] = line.substr(last_comma + 1);
+  }
+  return checksums;
+}
+
+// Prints the aggregated execution times and output comparisons. Returns the
+// number of dumps whose output differs from the reference.
+int PrintSummary(const std::vector<DumpResult>& results,
+                 const std::map<std::string, std::string>* reference,
+                 int64_t wall_time_us,
+                 int num_threads) {
+  size_t num_chunks = 0;
+  int64_t exec_time_us = 0;
+  int64_t max_chunk_time_us = 0;
+  int num_bitexact = 0;
+  for (const DumpResult& result : results) {
+    num_chunks += result.num_chunks;
+    exec_time_us += result.exec_time_us;
+    max_chunk_time_us = std::max(max_chunk_time_us, result.max_chunk_time_us);
+    if (result.bitexact)
+      ++num_bitexact;
+  }
+  const float file_time_s =
+      num_chunks * 1.f / AudioProcessingSimulator::kChunksPerSecond;
+
+  std::cout << "Dumps: " << results.size() << ", file time: " << file_time_s
+            << " s, execution time: " << exec_time_us * 1e-6 << " s, "
+            << "wall clock time on " << num_threads
+            << " threads: " << wall_time_us * 1e-6 << " s" << std::endl;
+  if (num_chunks > 0) {
+    std::cout << "Time per fwd stream chunk (mean, max): "
+              << exec_time_us * 1.f / num_chunks << " us, "
+              << max_chunk_time_us << " us" << std::endl;
+  }
+
+  // The dumps which are the most expensive to process are the first ones to
+  // look at for performance regressions.
+  std::vector<const DumpResult*> by_chunk_time;
+  for (const DumpResult& result : results) {
+    if (result.num_chunks > 0)
+      by_chunk_time.push_back(&result);
+  }
+  std::sort(by_chunk_time.begin(), by_chunk_time.end(),
+            [](const DumpResult* a, const DumpResult* b) {
+              return a->exec_time_us * b->num_chunks >
+                     b->exec_time_us * a->num_chunks;
+            });
+  const size_t kNumSlowestDumps = 5;
+  std::cout << "Slowest dumps per fwd stream chunk:" << std::endl;
+  for (size_t i = 0; i < std::min(kNumSlowestDumps, by_chunk_time.size());
+       ++i) {
+    std::cout << " " << by_chunk_time[i]->dump_filename << ": "
+              << by_chunk_time[i]->exec_time_us * 1.f /
+                     by_chunk_time[i]->num_chunks
+              << " us" << std::endl;
+  }
+
+  std::cout << "Bitexact with the recorded output: " << num_bitexact << " of "
+            << results.size() << std::endl;
+
+  if (!reference)
+    return 0;
+  int num_changed = 0;
+  int num_missing = 0;
+  for (const DumpResult& result : results) {
+    const auto it = reference->find(result.dump_filename);
+    if (it == reference->end()) {
+      ++num_missing;
+    } else if (it->second != result.checksum) {
+      if (num_changed == 0)
+        std::cout << "Output changed since the reference:" << std::endl;
+      std::cout << " " << result.dump_filename << std::endl;
+      ++num_changed;
+    }
+  }
+  std::cout << "Output unchanged since the reference: "
+            << results.size() - num_missing - num_changed << " of "
+            << results.size() - num_missing;
+  if (num_missing > 0)
+    std::cout << " (" << num_missing << " not in the reference)";
+  std::cout << std::endl;
+  return num_changed;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::SetUsageMessage(kUsageDescription);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_dump_list.empty()) {
+    std::cout << kUsageDescription << std::endl;
+    return 1;
+  }
+
+  SimulationSettings settings;
+  settings.report_bitexactness = true;
+  settings.discard_all_settings_in_aecdump = FLAGS_discard_settings_in_aecdump;
+
+  const int num_threads = FLAGS_num_threads > 0
+                              ? FLAGS_num_threads
+                              : static_cast<int>(CpuInfo::DetectNumberOfCores());
+  BatchRunner runner(settings, ReadDumpList(FLAGS_dump_list));
+  const int64_t start_time_us = rtc::TimeMicros();
+  runner.Run(num_threads);
+  const int64_t wall_time_us = rtc::TimeMicros() - start_time_us;
+
+  if (!FLAGS_report.empty())
+    WriteReport(runner.results(), FLAGS_report);
+
+  std::map<std::string, std::string> reference;
+  if (!FLAGS_reference_report.empty())
+    reference = ReadReferenceChecksums(FLAGS_reference_report);
+  const int num_changed = PrintSummary(
+      runner.results(), FLAGS_reference_report.empty() ? nullptr : &reference,
+      wall_time_us, num_threads);
+
+  // Lets scripts fail on output changes.
+  return num_changed > 0 ? 1 : 0;
+}
+
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  return webrtc::test::main(argc, argv);
+}
@@ -15,22 +15,52 @@
 #include <string.h>
 
 #include "webrtc/common_audio/fir_filter.h"
-#include "webrtc/modules/audio_processing/transient/dyadic_decimator.h"
 
 namespace webrtc {
 
+namespace {
+
+// Copies every other coefficient, starting at |first|, to |phase|. Returns the
+// number of coefficients copied.
+size_t PolyphaseCoefficients(const float* coefficients,
+                             size_t coefficients_length,
+                             size_t first,
+                             float* phase) {
+  size_t phase_length = 0;
+  for (size_t i = first; i < coefficients_length; i += 2) {
+    phase[phase_length++] = coefficients[i];
+  }
+  return phase_length;
+}
+
+}  // namespace
+
 WPDNode::WPDNode(size_t length,
                  const float* coefficients,
                  size_t coefficients_length)
-    : // The data buffer has parent data length to be able to contain and filter
-      // it.
-      data_(new float[2 * length + 1]),
+    : data_(new float[length]),
       length_(length),
-      filter_(FIRFilter::Create(coefficients,
-                                coefficients_length,
-                                2 * length + 1)) {
+      odd_samples_(new float[length]),
+      even_samples_(new float[length + 1]),
+      even_phase_output_(new float[length + 1]) {
   assert(length > 0 && coefficients && coefficients_length > 0);
-  memset(data_.get(), 0.f, (2 * length + 1) * sizeof(data_[0]));
+  memset(data_.get(), 0.f, length * sizeof(data_[0]));
+
+  // The i-th output sample is the (2 * i + 1)-th sample of the filtered parent
+  // data, in which the even coefficients only meet odd parent samples and the
+  // odd coefficients only meet even parent samples.
+  std::unique_ptr<float[]> phase_coefficients(
+      new float[(coefficients_length + 1) / 2]);
+  size_t phase_length = PolyphaseCoefficients(
+      coefficients, coefficients_length, 0, phase_coefficients.get());
+  odd_phase_filter_.reset(
+      FIRFilter::Create(phase_coefficients.get(), phase_length, length));
+  phase_length = PolyphaseCoefficients(
+      coefficients, coefficients_length, 1, phase_coefficients.get());
+  if (phase_length > 0) {
+    even_phase_filter_.reset(
+        FIRFilter::Create(phase_coefficients.get(), phase_length, length + 1));
+  }
 }
 
 WPDNode::~WPDNode() {}
@@ -40,15 +70,25 @@ int WPDNode::Update(const float* parent_data, size_t parent_data_length) {
     return -1;
   }
 
-  // Filter data.
-  filter_->Filter(parent_data, parent_data_length, data_.get());
+  // Deinterleave the parent data. The last sample of an odd length parent
+  // doesn't reach the output, but is kept in the filter state.
+  const size_t even_length = parent_data_length - length_;
+  for (size_t i = 0; i < length_; ++i) {
+    even_samples_[i] = parent_data[2 * i];
+    odd_samples_[i] = parent_data[2 * i + 1];
+  }
+  if (even_length > length_) {
+    even_samples_[length_] = parent_data[parent_data_length - 1];
+  }
 
-  // Decimate data.
-  const bool kOddSequence = true;
-  size_t output_samples = DyadicDecimate(
-      data_.get(), parent_data_length, kOddSequence, data_.get(), length_);
-  if (output_samples != length_) {
-    return -1;
+  // Filter and decimate data.
+  odd_phase_filter_->Filter(odd_samples_.get(), length_, data_.get());
+  if (even_phase_filter_) {
+    even_phase_filter_->Filter(even_samples_.get(), even_length,
+                               even_phase_output_.get());
+    for (size_t i = 0; i < length_; ++i) {
+      data_[i] += even_phase_output_[i];
+    }
   }
 
   // Get abs to all values.
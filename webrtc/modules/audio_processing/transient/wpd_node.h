@@ -20,6 +20,10 @@ namespace webrtc {
 class FIRFilter;
 
 // A single node of a Wavelet Packet Decomposition (WPD) tree.
+// Only the odd samples of the filtered parent data are kept, so the filter is
+// split into its two polyphase components, which run at the decimated rate on
+// the odd and even parent samples respectively. This halves the work of
+// filtering at the full rate and then throwing half of the output away.
 class WPDNode {
  public:
   // Creates a WPDNode. The data vector will contain zeros. The filter will have
@@ -39,7 +43,16 @@ class WPDNode {
  private:
   std::unique_ptr<float[]> data_;
   size_t length_;
-  std::unique_ptr<FIRFilter> filter_;
+  // Filters the odd parent samples with the even coefficients.
+  std::unique_ptr<FIRFilter> odd_phase_filter_;
+  // Filters the even parent samples with the odd coefficients. NULL if the
+  // filter has a single coefficient.
+  std::unique_ptr<FIRFilter> even_phase_filter_;
+  // Deinterleaved parent samples and the output of |even_phase_filter_|. The
+  // even buffers have room for the last sample of an odd length parent.
+  std::unique_ptr<float[]> odd_samples_;
+  std::unique_ptr<float[]> even_samples_;
+  std::unique_ptr<float[]> even_phase_output_;
 };
 
 }  // namespace webrtc
@@ -15,6 +15,8 @@
 #include <string.h>
 #include <algorithm>
 
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+
 // Number of right shifts for scaling is linearly depending on number of bits in
 // the far-end binary spectrum.
 static const int kShiftsAtZero = 13;  // Right shifts at zero binary spectrum.
@@ -60,10 +62,10 @@ static int BitCount(uint32_t u32) {
 //                            row the number of times the matrix row and the
 //                            input vector have the same value
 //
-static void BitCountComparison(uint32_t binary_vector,
-                               const uint32_t* binary_matrix,
-                               int matrix_size,
-                               int32_t* bit_counts) {
+static void BitCountComparisonC(uint32_t binary_vector,
+                                const uint32_t* binary_matrix,
+                                int matrix_size,
+                                int32_t* bit_counts) {
   int n = 0;
 
   // Compare |binary_vector| with all rows of the |binary_matrix|
@@ -72,6 +74,21 @@ static void BitCountComparison(uint32_t binary_vector,
   }
 }
 
+static BitCountComparison GetBitCountComparison() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  return WebRtc_BitCountComparisonSSE2;
+#else
+  // x86 CPU detection required.
+  return WebRtc_GetCPUInfo(kSSE2) ? WebRtc_BitCountComparisonSSE2
+                                  : BitCountComparisonC;
+#endif
+#else
+  return BitCountComparisonC;
+#endif
+}
+
 // Collects necessary statistics for the HistogramBasedValidation().  This
 // function has to be called prior to calling HistogramBasedValidation().  The
 // statistics updated and used by the HistogramBasedValidation() are:
@@ -419,6 +436,8 @@ BinaryDelayEstimator* WebRtc_CreateBinaryDelayEstimator(
   self->history_size = 0;
   self->robust_validation_enabled = 0;  // Disabled by default.
   self->allowed_offset = 0;
+  self->stable_search_interval = 1;  // Search every block by default.
+  self->bit_count_comparison = GetBitCountComparison();
 
   self->lookahead = max_lookahead;
 
@@ -501,6 +520,7 @@ void WebRtc_InitBinaryDelayEstimator(BinaryDelayEstimator* self) {
   self->compare_delay = self->history_size;
   self->candidate_hits = 0;
   self->last_delay_histogram = 0.f;
+  self->blocks_since_search = 0;
 }
 
 int WebRtc_SoftResetBinaryDelayEstimator(BinaryDelayEstimator* self,
@@ -542,9 +562,22 @@ int WebRtc_ProcessBinarySpectrum(BinaryDelayEstimator* self,
     binary_near_spectrum = self->binary_near_history[self->lookahead];
   }
 
+  // Once the last |kMinRequiredHits| searches have confirmed |last_delay|, the
+  // search is only done every |stable_search_interval| blocks. Any other
+  // candidate found by a search resets |candidate_hits|, which brings back the
+  // search of every block.
+  if ((self->stable_search_interval > 1) && (self->last_delay >= 0) &&
+      (self->last_candidate_delay == self->last_delay) &&
+      (self->candidate_hits >= kMinRequiredHits) &&
+      (++self->blocks_since_search < self->stable_search_interval)) {
+    return self->last_delay;
+  }
+  self->blocks_since_search = 0;
+
   // Compare with delayed spectra and store the |bit_counts| for each delay.
-  BitCountComparison(binary_near_spectrum, self->farend->binary_far_history,
-                     self->history_size, self->bit_counts);
+  self->bit_count_comparison(binary_near_spectrum,
+                             self->farend->binary_far_history,
+                             self->history_size, self->bit_counts);
 
   // Update |mean_bit_counts|, which is the smoothed version of |bit_counts|.
   for (i = 0; i < self->history_size; i++) {
@@ -18,6 +18,19 @@
 
 static const int32_t kMaxBitCountsQ9 = (32 << 9);  // 32 matching bits in Q9.
 
+// Compares |binary_vector| with all |matrix_size| rows of |binary_matrix| and
+// stores the number of differing bits per row in |bit_counts|.
+typedef void (*BitCountComparison)(uint32_t binary_vector,
+                                   const uint32_t* binary_matrix,
+                                   int matrix_size,
+                                   int32_t* bit_counts);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtc_BitCountComparisonSSE2(uint32_t binary_vector,
+                                   const uint32_t* binary_matrix,
+                                   int matrix_size,
+                                   int32_t* bit_counts);
+#endif
+
 typedef struct {
   // Pointer to bit counts.
   int* far_bit_counts;
@@ -57,6 +70,12 @@ typedef struct {
   // For dynamically changing the lookahead when using SoftReset...().
   int lookahead;
 
+  // Reduced search cadence while the delay is stable.
+  int stable_search_interval;
+  int blocks_since_search;
+
+  BitCountComparison bit_count_comparison;
+
   // Far-end binary spectrum history buffer etc.
   BinaryDelayEstimatorFarend* farend;
 } BinaryDelayEstimator;
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_processing/utility/delay_estimator.h"
+
+#include <emmintrin.h>
+
+// Counts the bits of each 32 bit element, by summing pairs, nibbles, bytes and
+// half words in parallel.
+static inline __m128i BitCount(__m128i x) {
+  const __m128i m1 = _mm_set1_epi32(0x55555555);
+  const __m128i m2 = _mm_set1_epi32(0x33333333);
+  const __m128i m4 = _mm_set1_epi32(0x0F0F0F0F);
+  x = _mm_sub_epi32(x, _mm_and_si128(_mm_srli_epi32(x, 1), m1));
+  x = _mm_add_epi32(_mm_and_si128(x, m2),
+                    _mm_and_si128(_mm_srli_epi32(x, 2), m2));
+  x = _mm_and_si128(_mm_add_epi32(x, _mm_srli_epi32(x, 4)), m4);
+  x = _mm_add_epi32(x, _mm_srli_epi32(x, 8));
+  x = _mm_add_epi32(x, _mm_srli_epi32(x, 16));
+  return _mm_and_si128(x, _mm_set1_epi32(0x3F));
+}
+
+void WebRtc_BitCountComparisonSSE2(uint32_t binary_vector,
+                                   const uint32_t* binary_matrix,
+                                   int matrix_size,
+                                   int32_t* bit_counts) {
+  const __m128i vector = _mm_set1_epi32(static_cast<int32_t>(binary_vector));
+  int n = 0;
+
+  for (; n + 8 <= matrix_size; n += 8) {
+    const __m128i rows_0 = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&binary_matrix[n]));
+    const __m128i rows_1 = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&binary_matrix[n + 4]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&bit_counts[n]),
+                     BitCount(_mm_xor_si128(vector, rows_0)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&bit_counts[n + 4]),
+                     BitCount(_mm_xor_si128(vector, rows_1)));
+  }
+  for (; n + 4 <= matrix_size; n += 4) {
+    const __m128i rows = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&binary_matrix[n]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&bit_counts[n]),
+                     BitCount(_mm_xor_si128(vector, rows)));
+  }
+  // Rows left over when |matrix_size| isn't a multiple of four.
+  for (; n < matrix_size; n++) {
+    const __m128i rows =
+        _mm_cvtsi32_si128(static_cast<int32_t>(binary_vector ^
+                                               binary_matrix[n]));
+    bit_counts[n] = _mm_cvtsi128_si32(BitCount(rows));
+  }
+}
@@ -13,6 +13,7 @@
 #include "webrtc/modules/audio_processing/utility/delay_estimator.h"
 #include "webrtc/modules/audio_processing/utility/delay_estimator_internal.h"
 #include "webrtc/modules/audio_processing/utility/delay_estimator_wrapper.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/typedefs.h"
 
 namespace {
@@ -379,6 +380,20 @@ TEST_F(DelayEstimatorTest, VerifyEnableRobustValidation) {
   }
 }
 
+TEST_F(DelayEstimatorTest, VerifyStableSearchInterval) {
+  // Searches every block by default.
+  EXPECT_EQ(1, WebRtc_stable_search_interval(handle_));
+  EXPECT_EQ(-1, WebRtc_set_stable_search_interval(handle_, 0));
+  EXPECT_EQ(-1, WebRtc_set_stable_search_interval(NULL, 2));
+  for (int i = 4; i >= 1; i--) {
+    EXPECT_EQ(0, WebRtc_set_stable_search_interval(handle_, i));
+    EXPECT_EQ(i, WebRtc_stable_search_interval(handle_));
+    Init();
+    // Unaffected over a reset.
+    EXPECT_EQ(i, WebRtc_stable_search_interval(handle_));
+  }
+}
+
 TEST_F(DelayEstimatorTest, InitializedSpectrumAfterProcess) {
   // In this test we verify that the mean spectra are initialized after first
   // time we call WebRtc_AddFarSpectrum() and Process() respectively. The test
@@ -577,6 +592,48 @@ TEST_F(DelayEstimatorTest, AllowedOffsetNoImpactWhenRobustValidationDisabled) {
   binary_->allowed_offset = 0;  // Reset reference.
 }
 
+TEST_F(DelayEstimatorTest, StableSearchIntervalKeepsExactDelayEstimate) {
+  // The same setup as in ExactDelayEstimateMultipleNearSameSpectrum with the
+  // difference that the reference binary delay estimator only searches every
+  // fourth block once its delay is stable. Both should still agree at all
+  // times.
+
+  binary_->stable_search_interval = 4;
+  for (size_t i = 0; i < kSizeEnable; ++i) {
+    RunBinarySpectraTest(0, 0, kEnable[i], kEnable[i]);
+  }
+  binary_->stable_search_interval = 1;  // Reset reference.
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST_F(DelayEstimatorTest, BitCountComparisonSSE2) {
+  if (!WebRtc_GetCPUInfo(kSSE2)) {
+    return;
+  }
+  // Covers all leftover sizes and bit patterns ranging from all zeros to all
+  // ones.
+  uint32_t binary_matrix[kHistorySize];
+  int32_t bit_counts[kHistorySize];
+  for (int i = 0; i < kHistorySize; ++i) {
+    binary_matrix[i] = binary_spectrum_[i] ^ (i % 3 == 0 ? 0xFFFFFFFF : 0);
+  }
+  binary_matrix[0] = 0;
+  for (int matrix_size = 1; matrix_size <= kHistorySize; ++matrix_size) {
+    const uint32_t binary_vector = binary_spectrum_[matrix_size];
+    WebRtc_BitCountComparisonSSE2(binary_vector, binary_matrix, matrix_size,
+                                  bit_counts);
+    for (int n = 0; n < matrix_size; ++n) {
+      int32_t expected_bit_count = 0;
+      for (uint32_t bits = binary_vector ^ binary_matrix[n]; bits != 0;
+           bits >>= 1) {
+        expected_bit_count += bits & 1;
+      }
+      ASSERT_EQ(expected_bit_count, bit_counts[n]);
+    }
+  }
+}
+#endif
+
 TEST_F(DelayEstimatorTest, VerifyLookaheadAtCreate) {
   void* farend_handle = WebRtc_CreateDelayEstimatorFarend(kSpectrumSize,
                                                           kMaxDelay);
@@ -412,6 +412,26 @@ int WebRtc_is_robust_validation_enabled(const void* handle) {
   return self->binary_handle->robust_validation_enabled;
 }
 
+int WebRtc_set_stable_search_interval(void* handle, int interval) {
+  DelayEstimator* self = (DelayEstimator*) handle;
+
+  if ((self == NULL) || (interval < 1)) {
+    return -1;
+  }
+  assert(self->binary_handle != NULL);
+  self->binary_handle->stable_search_interval = interval;
+  return 0;
+}
+
+int WebRtc_stable_search_interval(const void* handle) {
+  const DelayEstimator* self = (const DelayEstimator*) handle;
+
+  if (self == NULL) {
+    return -1;
+  }
+  return self->binary_handle->stable_search_interval;
+}
+
 int WebRtc_DelayEstimatorProcessFix(void* handle,
                                     const uint16_t* near_spectrum,
                                     int spectrum_size,
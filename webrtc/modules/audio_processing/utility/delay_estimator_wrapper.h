@@ -192,6 +192,20 @@ int WebRtc_enable_robust_validation(void* handle, int enable);
 // Returns 1 if robust validation is enabled and 0 if disabled.
 int WebRtc_is_robust_validation_enabled(const void* handle);
 
+// Sets how often, in blocks, the delay is searched for while the estimate is
+// stable, i.e., the last searches have found the same delay. A new delay
+// candidate brings back the search of every block. This saves complexity, but
+// slows down the adaptation of the search statistics. The default, used if not
+// set manually, is one, i.e., every block. The state is preserved over a
+// reset.
+// Inputs:
+//      - handle        : Pointer to the delay estimation instance.
+//      - interval      : Number of blocks between searches, from one.
+int WebRtc_set_stable_search_interval(void* handle, int interval);
+
+// Returns the search interval used while the delay is stable.
+int WebRtc_stable_search_interval(const void* handle);
+
 // Estimates and returns the delay between the far-end and near-end blocks. The
 // value will be offset by the lookahead (i.e. the lookahead should be
 // subtracted from the returned value).
@@ -135,6 +135,23 @@ class WrappingBitrateEstimator : public RemoteBitrateEstimator {
 
 }  // namespace
 
+// Lets |bitrate_controller_| push estimate changes to the pacer and the
+// observer right away, instead of them being picked up on the next Process().
+class CongestionController::EstimateObserver : public BitrateObserver {
+ public:
+  explicit EstimateObserver(CongestionController* controller)
+      : controller_(controller) {}
+
+  void OnNetworkChanged(uint32_t bitrate_bps,
+                        uint8_t fraction_loss,
+                        int64_t rtt_ms) override {
+    controller_->OnEstimateChanged(bitrate_bps, fraction_loss, rtt_ms);
+  }
+
+ private:
+  CongestionController* const controller_;
+};
+
 CongestionController::CongestionController(
     Clock* clock,
     BitrateObserver* bitrate_observer,
@@ -145,6 +162,10 @@ CongestionController::CongestionController(
       pacer_(new PacedSender(clock_, packet_router_.get())),
       remote_bitrate_estimator_(
           new WrappingBitrateEstimator(remote_bitrate_observer, clock_)),
+      estimated_bitrate_bps_(0),
+      estimated_fraction_loss_(0),
+      estimated_rtt_(0),
+      initialized_(false),
       bitrate_controller_(
           BitrateController::CreateBitrateController(clock_, bitrate_observer)),
       remote_estimator_proxy_(clock_, packet_router_.get()),
@@ -167,7 +188,14 @@ CongestionController::CongestionController(
       pacer_(new PacedSender(clock_, packet_router_.get())),
       remote_bitrate_estimator_(
           new WrappingBitrateEstimator(remote_bitrate_observer, clock_)),
-      bitrate_controller_(BitrateController::CreateBitrateController(clock_)),
+      estimated_bitrate_bps_(0),
+      estimated_fraction_loss_(0),
+      estimated_rtt_(0),
+      initialized_(false),
+      estimate_observer_(new EstimateObserver(this)),
+      bitrate_controller_(
+          BitrateController::CreateBitrateController(clock_,
+                                                     estimate_observer_.get())),
       remote_estimator_proxy_(clock_, packet_router_.get()),
       transport_feedback_adapter_(bitrate_controller_.get(), clock_),
       min_bitrate_bps_(RemoteBitrateEstimator::kDefaultMinBitrateBps),
@@ -190,9 +218,16 @@ CongestionController::CongestionController(
       pacer_(std::move(pacer)),
       remote_bitrate_estimator_(
           new WrappingBitrateEstimator(remote_bitrate_observer, clock_)),
+      estimated_bitrate_bps_(0),
+      estimated_fraction_loss_(0),
+      estimated_rtt_(0),
+      initialized_(false),
+      estimate_observer_(new EstimateObserver(this)),
       // Constructed last as this object calls the provided callback on
       // construction.
-      bitrate_controller_(BitrateController::CreateBitrateController(clock_)),
+      bitrate_controller_(
+          BitrateController::CreateBitrateController(clock_,
+                                                     estimate_observer_.get())),
       remote_estimator_proxy_(clock_, packet_router_.get()),
       transport_feedback_adapter_(bitrate_controller_.get(), clock_),
       min_bitrate_bps_(RemoteBitrateEstimator::kDefaultMinBitrateBps),
@@ -210,9 +245,10 @@ void CongestionController::Init() {
       new RemoteBitrateEstimatorAbsSendTime(&transport_feedback_adapter_));
   transport_feedback_adapter_.GetBitrateEstimator()->SetMinBitrate(
       min_bitrate_bps_);
+  rtc::CritScope cs(&critsect_);
+  initialized_ = true;
 }
 
-
 void CongestionController::SetBweBitrates(int min_bitrate_bps,
                                           int start_bitrate_bps,
                                           int max_bitrate_bps) {
@@ -295,11 +331,31 @@ int64_t CongestionController::TimeUntilNextProcess() {
 }
 
 void CongestionController::Process() {
+  // Estimate changes are reported as they happen, this picks up changes in
+  // the send queue and time based estimate updates.
   bitrate_controller_->Process();
   remote_bitrate_estimator_->Process();
   MaybeTriggerOnNetworkChanged();
 }
 
+void CongestionController::OnEstimateChanged(uint32_t bitrate_bps,
+                                             uint8_t fraction_loss,
+                                             int64_t rtt_ms) {
+  bool initialized;
+  {
+    rtc::CritScope cs(&critsect_);
+    estimated_bitrate_bps_ = bitrate_bps;
+    estimated_fraction_loss_ = fraction_loss;
+    estimated_rtt_ = rtt_ms;
+    initialized = initialized_;
+  }
+  pacer_->SetEstimatedBitrate(bitrate_bps);
+  // The initial estimate is reported from the constructor, before the
+  // observer can take it. It's reported once the bitrates are set instead.
+  if (initialized)
+    MaybeTriggerOnNetworkChanged();
+}
+
 void CongestionController::MaybeTriggerOnNetworkChanged() {
   // TODO(perkj): |observer_| can be nullptr if the ctor that accepts a
   // BitrateObserver is used. Remove this check once the ctor is removed.
@@ -309,10 +365,12 @@ void CongestionController::MaybeTriggerOnNetworkChanged() {
   uint32_t bitrate_bps;
   uint8_t fraction_loss;
   int64_t rtt;
-  bool estimate_changed = bitrate_controller_->GetNetworkParameters(
-      &bitrate_bps, &fraction_loss, &rtt);
-  if (estimate_changed)
-    pacer_->SetEstimatedBitrate(bitrate_bps);
+  {
+    rtc::CritScope cs(&critsect_);
+    bitrate_bps = estimated_bitrate_bps_;
+    fraction_loss = estimated_fraction_loss_;
+    rtt = estimated_rtt_;
+  }
 
   bitrate_bps = IsNetworkDown() || IsSendQueueFull() ? 0 : bitrate_bps;
 
@@ -74,6 +74,14 @@ TEST_F(CongestionControllerTest, OnNetworkChanged) {
   controller_->Process();
 }
 
+TEST_F(CongestionControllerTest, OnNetworkChangedWithoutProcess) {
+  // A lower receiver estimate caps the estimate right away, and reaches the
+  // observer and the pacer without waiting for the next Process().
+  EXPECT_CALL(observer_, OnNetworkChanged(kInitialBitrateBps / 2, _, _));
+  EXPECT_CALL(*pacer_, SetEstimatedBitrate(kInitialBitrateBps / 2));
+  bandwidth_observer_->OnReceivedEstimatedBitrate(kInitialBitrateBps / 2);
+}
+
 TEST_F(CongestionControllerTest, OnSendQueueFull) {
   EXPECT_CALL(*pacer_, ExpectedQueueTimeMs())
       .WillOnce(Return(PacedSender::kMaxQueueLengthMs + 1));
@@ -96,11 +104,11 @@ TEST_F(CongestionControllerTest, OnSendQueueFullAndEstimateChange) {
   controller_->Process();
 
   // Receive new estimate but let the queue still be full.
-  bandwidth_observer_->OnReceivedEstimatedBitrate(kInitialBitrateBps * 2);
   EXPECT_CALL(*pacer_, ExpectedQueueTimeMs())
-      .WillOnce(Return(PacedSender::kMaxQueueLengthMs + 1));
+      .WillRepeatedly(Return(PacedSender::kMaxQueueLengthMs + 1));
   //  The send pacer should get the new estimate though.
   EXPECT_CALL(*pacer_, SetEstimatedBitrate(kInitialBitrateBps * 2));
+  bandwidth_observer_->OnReceivedEstimatedBitrate(kInitialBitrateBps * 2);
   clock_.AdvanceTimeMilliseconds(25);
   controller_->Process();
 
@@ -92,7 +92,13 @@ class CongestionController : public CallStatsObserver, public Module {
   void Process() override;
 
  private:
+  class EstimateObserver;
+
   void Init();
+  // Called by |bitrate_controller_| as soon as its estimate changes.
+  void OnEstimateChanged(uint32_t bitrate_bps,
+                         uint8_t fraction_loss,
+                         int64_t rtt_ms);
   void MaybeTriggerOnNetworkChanged();
 
   bool IsSendQueueFull() const;
@@ -105,11 +111,18 @@ class CongestionController : public CallStatsObserver, public Module {
   const std::unique_ptr<PacketRouter> packet_router_;
   const std::unique_ptr<PacedSender> pacer_;
   const std::unique_ptr<RemoteBitrateEstimator> remote_bitrate_estimator_;
+  rtc::CriticalSection critsect_;
+  // The latest estimate from |bitrate_controller_|.
+  uint32_t estimated_bitrate_bps_ GUARDED_BY(critsect_);
+  uint8_t estimated_fraction_loss_ GUARDED_BY(critsect_);
+  int64_t estimated_rtt_ GUARDED_BY(critsect_);
+  bool initialized_ GUARDED_BY(critsect_);
+  // Null if a BitrateObserver was passed to the constructor.
+  const std::unique_ptr<EstimateObserver> estimate_observer_;
   const std::unique_ptr<BitrateController> bitrate_controller_;
   RemoteEstimatorProxy remote_estimator_proxy_;
   TransportFeedbackAdapter transport_feedback_adapter_;
   int min_bitrate_bps_;
-  rtc::CriticalSection critsect_;
   uint32_t last_reported_bitrate_bps_ GUARDED_BY(critsect_);
   uint8_t last_reported_fraction_loss_ GUARDED_BY(critsect_);
   int64_t last_reported_rtt_ GUARDED_BY(critsect_);
@@ -10,8 +10,6 @@
 
 #include "webrtc/modules/desktop_capture/desktop_and_cursor_composer.h"
 
-#include <string.h>
-
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/modules/desktop_capture/desktop_capturer.h"
 #include "webrtc/modules/desktop_capture/desktop_frame.h"
@@ -21,30 +19,42 @@ namespace webrtc {
 
 namespace {
 
+// Scales two 8-bit channels held in bits 0-7 and 16-23 of |channels| by
+// |alpha| / 255, rounding down exactly like a per-channel integer division.
+inline uint32_t ScaleChannelPair(uint32_t channels, uint32_t alpha) {
+  uint32_t products = channels * alpha;
+  return ((products + 0x00010001 + ((products >> 8) & 0x00ff00ff)) >> 8) &
+         0x00ff00ff;
+}
+
 // Helper function that blends one image into another. Source image must be
 // pre-multiplied with the alpha channel. Destination is assumed to be opaque.
+// Blue and red, and green on its own, are blended two channels per 32-bit
+// operation; the destination alpha is left untouched.
 void AlphaBlend(uint8_t* dest, int dest_stride,
                 const uint8_t* src, int src_stride,
                 const DesktopSize& size) {
   for (int y = 0; y < size.height(); ++y) {
+    uint32_t* dest_row = reinterpret_cast<uint32_t*>(dest);
+    const uint32_t* src_row = reinterpret_cast<const uint32_t*>(src);
     for (int x = 0; x < size.width(); ++x) {
-      uint32_t base_alpha = 255 - src[x * DesktopFrame::kBytesPerPixel + 3];
+      uint32_t src_pixel = src_row[x];
+      uint32_t base_alpha = 255 - (src_pixel >> 24);
       if (base_alpha == 255) {
         continue;
       } else if (base_alpha == 0) {
-        memcpy(dest + x * DesktopFrame::kBytesPerPixel,
-               src + x * DesktopFrame::kBytesPerPixel,
-               DesktopFrame::kBytesPerPixel);
+        dest_row[x] = src_pixel;
       } else {
-        dest[x * DesktopFrame::kBytesPerPixel] =
-            dest[x * DesktopFrame::kBytesPerPixel] * base_alpha / 255 +
-            src[x * DesktopFrame::kBytesPerPixel];
-        dest[x * DesktopFrame::kBytesPerPixel + 1] =
-            dest[x * DesktopFrame::kBytesPerPixel + 1] * base_alpha / 255 +
-            src[x * DesktopFrame::kBytesPerPixel + 1];
-        dest[x * DesktopFrame::kBytesPerPixel + 2] =
-            dest[x * DesktopFrame::kBytesPerPixel + 2] * base_alpha / 255 +
-            src[x * DesktopFrame::kBytesPerPixel + 2];
+        uint32_t dest_pixel = dest_row[x];
+        uint32_t blue_red =
+            (ScaleChannelPair(dest_pixel & 0x00ff00ff, base_alpha) +
+             (src_pixel & 0x00ff00ff)) &
+            0x00ff00ff;
+        uint32_t green =
+            (ScaleChannelPair((dest_pixel >> 8) & 0x000000ff, base_alpha) +
+             ((src_pixel >> 8) & 0x000000ff)) &
+            0x000000ff;
+        dest_row[x] = (dest_pixel & 0xff000000) | (green << 8) | blue_red;
       }
     }
     src += src_stride;
@@ -30,6 +30,7 @@ Differ::Differ(int width, int height, int bpp, int stride) {
   diff_info_height_ = ((height_ + kBlockSize - 1) / kBlockSize) + 1;
   diff_info_size_ = diff_info_width_ * diff_info_height_ * sizeof(bool);
   diff_info_.reset(new bool[diff_info_size_]);
+  check_info_.reset(new bool[diff_info_size_]);
 }
 
 Differ::~Differ() {}
@@ -45,8 +46,37 @@ void Differ::CalcDirtyRegion(const uint8_t* prev_buffer,
   MergeBlocks(region);
 }
 
+void Differ::CalcDirtyRegion(const uint8_t* prev_buffer,
+                             const uint8_t* curr_buffer,
+                             const DesktopRegion& hint,
+                             DesktopRegion* region) {
+  MarkBlocksToCheck(hint);
+  MarkDirtyBlocks(prev_buffer, curr_buffer, check_info_.get());
+  MergeBlocks(region);
+}
+
+void Differ::MarkBlocksToCheck(const DesktopRegion& hint) {
+  memset(check_info_.get(), 0, diff_info_size_);
+  int diff_info_stride = diff_info_width_ * sizeof(bool);
+  for (DesktopRegion::Iterator it(hint); !it.IsAtEnd(); it.Advance()) {
+    DesktopRect rect = it.rect();
+    rect.IntersectWith(DesktopRect::MakeWH(width_, height_));
+    if (rect.is_empty())
+      continue;
+    int left = rect.left() / kBlockSize;
+    int right = (rect.right() - 1) / kBlockSize;
+    int top = rect.top() / kBlockSize;
+    int bottom = (rect.bottom() - 1) / kBlockSize;
+    for (int y = top; y <= bottom; y++) {
+      memset(check_info_.get() + y * diff_info_stride + left, 1,
+             (right - left + 1) * sizeof(bool));
+    }
+  }
+}
+
 void Differ::MarkDirtyBlocks(const uint8_t* prev_buffer,
-                             const uint8_t* curr_buffer) {
+                             const uint8_t* curr_buffer,
+                             const bool* check_info) {
   memset(diff_info_.get(), 0, diff_info_size_);
 
   // Calc number of full blocks.
@@ -76,7 +106,8 @@ void Differ::MarkDirtyBlocks(const uint8_t* prev_buffer,
     for (int x = 0; x < x_full_blocks; x++) {
       // Mark this block as being modified so that it gets incorporated into
       // a dirty rect.
-      *diff_info = BlockDifference(prev_block, curr_block, bytes_per_row_);
+      if (!check_info || check_info[diff_info - diff_info_.get()])
+        *diff_info = BlockDifference(prev_block, curr_block, bytes_per_row_);
       prev_block += block_x_offset;
       curr_block += block_x_offset;
       diff_info += sizeof(bool);
@@ -84,10 +115,10 @@ void Differ::MarkDirtyBlocks(const uint8_t* prev_buffer,
 
     // If there is a partial column at the end, handle it.
     // This condition should rarely, if ever, occur.
-    if (partial_column_width != 0) {
+    if (partial_column_width != 0 &&
+        (!check_info || check_info[diff_info - diff_info_.get()])) {
       *diff_info = !PartialBlocksEqual(prev_block, curr_block, bytes_per_row_,
                                        partial_column_width, kBlockSize);
-      diff_info += sizeof(bool);
     }
 
     // Update pointers for next row.
@@ -104,18 +135,20 @@ void Differ::MarkDirtyBlocks(const uint8_t* prev_buffer,
     const uint8_t* curr_block = curr_block_row_start;
     bool* diff_info = diff_info_row_start;
     for (int x = 0; x < x_full_blocks; x++) {
-      *diff_info = !PartialBlocksEqual(prev_block, curr_block,
-                                       bytes_per_row_,
-                                       kBlockSize, partial_row_height);
+      if (!check_info || check_info[diff_info - diff_info_.get()]) {
+        *diff_info = !PartialBlocksEqual(prev_block, curr_block,
+                                         bytes_per_row_,
+                                         kBlockSize, partial_row_height);
+      }
       prev_block += block_x_offset;
       curr_block += block_x_offset;
       diff_info += sizeof(bool);
     }
-    if (partial_column_width != 0) {
+    if (partial_column_width != 0 &&
+        (!check_info || check_info[diff_info - diff_info_.get()])) {
       *diff_info = !PartialBlocksEqual(prev_block, curr_block, bytes_per_row_,
                                        partial_column_width,
                                        partial_row_height);
-      diff_info += sizeof(bool);
     }
   }
 }
@@ -42,12 +42,25 @@ class Differ {
   void CalcDirtyRegion(const uint8_t* prev_buffer, const uint8_t* curr_buffer,
                        DesktopRegion* region);
 
+  // Same as above, but only compares the blocks that intersect |hint|, e.g.
+  // the damage reported by the OS. The pixels outside |hint| must be the same
+  // in both buffers. The result is a subset of |hint| expanded to the blocks,
+  // so this can trim an OS-provided region that includes unchanged pixels.
+  void CalcDirtyRegion(const uint8_t* prev_buffer, const uint8_t* curr_buffer,
+                       const DesktopRegion& hint, DesktopRegion* region);
+
  private:
   // Allow tests to access our private parts.
   friend class DifferTest;
 
-  // Identify all of the blocks that contain changed pixels.
-  void MarkDirtyBlocks(const uint8_t* prev_buffer, const uint8_t* curr_buffer);
+  // Identify all of the blocks that contain changed pixels. If |check_info| is
+  // not null, only the blocks for which it's true are compared, and the others
+  // are marked as unchanged. It's laid out like |diff_info_|.
+  void MarkDirtyBlocks(const uint8_t* prev_buffer, const uint8_t* curr_buffer,
+                       const bool* check_info = nullptr);
+
+  // Sets |check_info_| to the blocks that intersect |hint|.
+  void MarkBlocksToCheck(const DesktopRegion& hint);
 
   // After the dirty blocks have been identified, this routine merges adjacent
   // blocks into a region.
@@ -77,6 +90,9 @@ class Differ {
   // Diff information for each block in the image.
   std::unique_ptr<bool[]> diff_info_;
 
+  // The blocks to compare, when CalcDirtyRegion() is given a hint.
+  std::unique_ptr<bool[]> check_info_;
+
   // Dimensions and total size of diff info array.
   int diff_info_width_;
   int diff_info_height_;
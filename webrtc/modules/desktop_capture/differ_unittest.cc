@@ -271,6 +271,40 @@ TEST_F(DifferTest, MarkDirtyBlocks_Sampling) {
   EXPECT_FALSE(GetDiffInfo(2, 2));
 }
 
+TEST_F(DifferTest, CalcDirtyRegion_Hint) {
+  InitDiffer(kScreenWidth, kScreenHeight);
+
+  WriteBlockPixel(curr_.get(), 1, 0, 10, 10, 0xff00ff);
+  WriteBlockPixel(curr_.get(), 0, 2, 10, 10, 0xff00ff);
+
+  // The hint covers part of the changed block (1, 0) and of the unchanged
+  // block (2, 2), but not the changed block (0, 2).
+  DesktopRegion hint;
+  hint.AddRect(DesktopRect::MakeXYWH(kBlockSize + 5, 5, 10, 10));
+  hint.AddRect(DesktopRect::MakeXYWH(2 * kBlockSize, 2 * kBlockSize, 1, 1));
+
+  DesktopRegion dirty;
+  differ_->CalcDirtyRegion(prev_.get(), curr_.get(), hint, &dirty);
+
+  ASSERT_EQ(1, RegionRectCount(dirty));
+  EXPECT_TRUE(CheckDirtyRegionContainsRect(dirty, 1, 0, 1, 1));
+
+  // Without the hint both changed blocks are found.
+  differ_->CalcDirtyRegion(prev_.get(), curr_.get(), &dirty);
+  ASSERT_EQ(2, RegionRectCount(dirty));
+  EXPECT_TRUE(CheckDirtyRegionContainsRect(dirty, 1, 0, 1, 1));
+  EXPECT_TRUE(CheckDirtyRegionContainsRect(dirty, 0, 2, 1, 1));
+}
+
+TEST_F(DifferTest, CalcDirtyRegion_EmptyHint) {
+  InitDiffer(kScreenWidth, kScreenHeight);
+  WriteBlockPixel(curr_.get(), 1, 1, 10, 10, 0xff00ff);
+
+  DesktopRegion dirty;
+  differ_->CalcDirtyRegion(prev_.get(), curr_.get(), DesktopRegion(), &dirty);
+  EXPECT_TRUE(dirty.is_empty());
+}
+
 TEST_F(DifferTest, DiffBlock) {
   InitDiffer(kScreenWidth, kScreenHeight);
 
@@ -369,6 +403,25 @@ TEST_F(DifferTest, Partial_BorderPixel) {
   }
 }
 
+TEST_F(DifferTest, Partial_Hint) {
+  InitDiffer(kPartialScreenWidth, kPartialScreenHeight);
+
+  WritePixel(curr_.get(), width_ - 1, height_ - 1, 0xff00ff);
+  WritePixel(curr_.get(), 0, height_ - 1, 0xff00ff);
+
+  // The hint extends past the screen, and covers only the bottom-right pixel.
+  DesktopRegion hint;
+  hint.AddRect(DesktopRect::MakeXYWH(width_ - 1, height_ - 1, 100, 100));
+
+  DesktopRegion dirty;
+  differ_->CalcDirtyRegion(prev_.get(), curr_.get(), hint, &dirty);
+
+  int partial_size = kPartialScreenWidth - 2 * kBlockSize;
+  DesktopRegion expected(DesktopRect::MakeXYWH(
+      2 * kBlockSize, 2 * kBlockSize, partial_size, partial_size));
+  EXPECT_TRUE(dirty.Equals(expected));
+}
+
 TEST_F(DifferTest, MergeBlocks_Empty) {
   InitDiffer(kScreenWidth, kScreenHeight);
 
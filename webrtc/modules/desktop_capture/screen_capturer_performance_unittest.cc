@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/desktop_capture/desktop_capture_options.h"
+#include "webrtc/modules/desktop_capture/desktop_frame.h"
+#include "webrtc/modules/desktop_capture/desktop_region.h"
+#include "webrtc/modules/desktop_capture/screen_capturer.h"
+#include "webrtc/system_wrappers/include/logging.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+const int kNumFrames = 100;
+
+class FrameCounter : public DesktopCapturer::Callback {
+ public:
+  void OnCaptureCompleted(DesktopFrame* frame) override {
+    if (frame)
+      ++num_frames_;
+    delete frame;
+  }
+
+  int num_frames() const { return num_frames_; }
+
+ private:
+  int num_frames_ = 0;
+};
+
+// Captures kNumFrames frames as fast as possible and reports the average time
+// per Capture() call. On a mostly idle screen this measures what a frame with
+// few or no changes costs, which is what most captured frames are.
+void RunBenchmark(const DesktopCaptureOptions& options,
+                  const std::string& modifier) {
+  std::unique_ptr<ScreenCapturer> capturer(ScreenCapturer::Create(options));
+  if (!capturer) {
+    LOG(LS_WARNING) << "No screen capturer available, skipping.";
+    return;
+  }
+  FrameCounter counter;
+  capturer->Start(&counter);
+  // The first frame is always captured entirely.
+  capturer->Capture(DesktopRegion());
+
+  int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumFrames; ++i)
+    capturer->Capture(DesktopRegion());
+  int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+
+  EXPECT_EQ(kNumFrames + 1, counter.num_frames());
+  test::PrintResult("screen_capture_latency", modifier, "capture",
+                    static_cast<double>(elapsed_ns) / kNumFrames /
+                        rtc::kNumNanosecsPerMicrosec,
+                    "us", true);
+}
+}  // namespace
+
+TEST(ScreenCapturerPerformanceTest, CaptureLatency) {
+  RunBenchmark(DesktopCaptureOptions::CreateDefault(), "");
+}
+
+TEST(ScreenCapturerPerformanceTest, CaptureLatencyWithUpdateNotifications) {
+  DesktopCaptureOptions options = DesktopCaptureOptions::CreateDefault();
+  options.set_use_update_notifications(true);
+  RunBenchmark(options, "_update_notifications");
+}
+
+}  // namespace webrtc
@@ -114,7 +114,8 @@ class ScreenCapturerLinux : public ScreenCapturer,
   // current with the last buffer used.
   DesktopRegion last_invalid_region_;
 
-  // |Differ| for use when polling for changes.
+  // |Differ| for use when polling for changes, and for narrowing down the
+  // damage region.
   std::unique_ptr<Differ> differ_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(ScreenCapturerLinux);
@@ -264,11 +265,10 @@ void ScreenCapturerLinux::Capture(const DesktopRegion& region) {
 
   // Refresh the Differ helper used by CaptureFrame(), if needed.
   DesktopFrame* frame = queue_.current_frame();
-  if (!use_damage_ && (
-      !differ_.get() ||
+  if (!differ_.get() ||
       (differ_->width() != frame->size().width()) ||
       (differ_->height() != frame->size().height()) ||
-      (differ_->bytes_per_row() != frame->stride()))) {
+      (differ_->bytes_per_row() != frame->stride())) {
     differ_.reset(new Differ(frame->size().width(), frame->size().height(),
                              DesktopFrame::kBytesPerPixel,
                              frame->stride()));
@@ -329,6 +329,14 @@ DesktopFrame* ScreenCapturerLinux::CaptureScreen() {
   DesktopRegion* updated_region = frame->mutable_updated_region();
 
   x_server_pixel_buffer_.Synchronize();
+  // The screen contents fetched by Synchronize(), if they have the layout of
+  // |frame|, which the Differ requires.
+  int synchronized_stride = 0;
+  const uint8_t* synchronized_data =
+      x_server_pixel_buffer_.GetSynchronizedData(&synchronized_stride);
+  if (synchronized_stride != frame->stride())
+    synchronized_data = NULL;
+
   if (use_damage_ && queue_.previous_frame()) {
     // Atomically fetch and clear the damage region.
     XDamageSubtract(display(), damage_handle_, None, damage_region_);
@@ -352,10 +360,26 @@ DesktopFrame* ScreenCapturerLinux::CaptureScreen() {
     updated_region->IntersectWith(
         DesktopRect::MakeSize(x_server_pixel_buffer_.window_size()));
 
-    for (DesktopRegion::Iterator it(*updated_region);
-         !it.IsAtEnd(); it.Advance()) {
-      x_server_pixel_buffer_.CaptureRect(it.rect(), frame);
-    }
+    x_server_pixel_buffer_.CaptureRegion(*updated_region, frame);
+
+    // XDamage reports whatever the X server repainted, which often includes
+    // pixels that didn't change, e.g. a whole window for a blinking cursor.
+    // Outside the damage the frame is the same as the previous one, so only
+    // the damaged blocks need to be compared to find the actual changes.
+    DesktopRegion damage_region;
+    damage_region.Swap(updated_region);
+    differ_->CalcDirtyRegion(queue_.previous_frame()->data(), frame->data(),
+                             damage_region, updated_region);
+  } else if (queue_.previous_frame() && synchronized_data) {
+    // Full-screen polling, with the screen contents already fetched into a
+    // buffer the previous frame can be compared with directly. Only the
+    // changed pixels need to be copied then, on top of the changes from the
+    // previous frame that this buffer hasn't seen yet.
+    RTC_DCHECK(differ_.get() != NULL);
+    differ_->CalcDirtyRegion(queue_.previous_frame()->data(),
+                             synchronized_data, updated_region);
+    SynchronizeFrame();
+    x_server_pixel_buffer_.CaptureRegion(*updated_region, frame);
   } else {
     // Doing full-screen polling, or this is the first capture after a
     // screen-resolution change.  In either case, need a full-screen capture.
@@ -99,20 +99,30 @@ class ScreenCapturerWinDirectx::Texture {
 
     // AcquireNextFrame returns a CPU inaccessible IDXGIResource, so we need to
     // make a copy.
-    if (!InitializeStage(texture.Get())) {
+    bool new_stage = false;
+    if (!InitializeStage(texture.Get(), &new_stage)) {
       return false;
     }
 
     updated_region_.Clear();
-    if (!DetectUpdatedRegion(frame_info, &updated_region_)) {
+    if (needs_full_copy_ ||
+        !DetectUpdatedRegion(frame_info, &updated_region_)) {
+      // Updates of frames that failed to be copied were never reported, so
+      // report everything.
       updated_region_.SetRect(DesktopRect::MakeSize(size()));
     }
-    // We need to copy changed area in both this frame and last frame, since
-    // currently this frame stores the bitmap of the one before last frame.
     copied_region_.Clear();
-    copied_region_.AddRegion(updated_region_);
-    copied_region_.AddRegion(last_updated_region);
-    copied_region_.IntersectWith(DesktopRect::MakeSize(size()));
+    if (new_stage || needs_full_copy_) {
+      // A new stage doesn't hold any earlier frame, and a stage that missed
+      // a frame holds stale pixels, so copy all of this one.
+      copied_region_.SetRect(DesktopRect::MakeSize(size()));
+    } else {
+      // We need to copy changed area in both this frame and last frame, since
+      // currently this frame stores the bitmap of the one before last frame.
+      copied_region_.AddRegion(updated_region_);
+      copied_region_.AddRegion(last_updated_region);
+      copied_region_.IntersectWith(DesktopRect::MakeSize(size()));
+    }
 
     for (DesktopRegion::Iterator it(copied_region_);
          !it.IsAtEnd();
@@ -140,6 +150,7 @@ class ScreenCapturerWinDirectx::Texture {
       return false;
     }
 
+    needs_full_copy_ = false;
     // surface_->Unmap() will be called next time we capture an image to avoid
     // memory copy without shared_memory.
     return true;
@@ -171,14 +182,25 @@ class ScreenCapturerWinDirectx::Texture {
     return copied_region_;
   }
 
+  // Makes the next successful CopyFrom() copy and report the whole texture.
+  // Called on every Texture after a frame failed to be copied, since the
+  // frame is released anyway and its updates are missing from all of them.
+  void RequireFullCopy() {
+    needs_full_copy_ = true;
+  }
+
+  bool needs_full_copy() const { return needs_full_copy_; }
+
  private:
   // Texture should only be deleted by Release function.
   ~Texture() = default;
 
   // Initializes stage_ from a CPU inaccessible IDXGIResource. Returns false
-  // if it fails to execute windows api.
-  bool InitializeStage(ID3D11Texture2D* texture) {
+  // if it fails to execute windows api. Sets |new_stage| to true if stage_ was
+  // (re)created and holds no earlier frame.
+  bool InitializeStage(ID3D11Texture2D* texture, bool* new_stage) {
     RTC_DCHECK(texture);
+    RTC_DCHECK(new_stage);
     D3D11_TEXTURE2D_DESC desc = {0};
     texture->GetDesc(&desc);
     desc.BindFlags = 0;
@@ -200,8 +222,10 @@ class ScreenCapturerWinDirectx::Texture {
         RTC_DCHECK(left.Get() == right.Get());
       }
 
-      // This buffer should be used already.
+      // This buffer should be used already. Forget the mapping, so that bits()
+      // doesn't point to unmapped memory if this frame fails to be copied.
       _com_error error = _com_error(surface_->Unmap());
+      rect_ = {0};
       if (error.Error() == S_OK) {
         D3D11_TEXTURE2D_DESC current_desc;
         stage_->GetDesc(&current_desc);
@@ -245,12 +269,13 @@ class ScreenCapturerWinDirectx::Texture {
     }
 
     size_.set(desc.Width, desc.Height);
+    *new_stage = true;
     return true;
   }
 
   ComPtr<ID3D11Texture2D> stage_;
   ComPtr<IDXGISurface> surface_;
-  DXGI_MAPPED_RECT rect_;
+  DXGI_MAPPED_RECT rect_ = {0};
   DesktopSize size_;
   Atomic32 ref_count_;
   // The updated region from Windows API.
@@ -259,6 +284,9 @@ class ScreenCapturerWinDirectx::Texture {
   DesktopRegion copied_region_;
   // The DPI of current frame.
   DesktopVector dpi_;
+  // Whether an earlier frame failed to be copied since this texture was last
+  // copied into successfully.
+  bool needs_full_copy_ = false;
 };
 
 // A DesktopFrame which does not own the data buffer, and also does not have
@@ -508,9 +536,9 @@ bool ScreenCapturerWinDirectx::DetectUpdatedRegion(
     return false;
   }
 
-  if (g_container->metadata.capacity() < frame_info.TotalMetadataBufferSize) {
+  if (g_container->metadata.size() < frame_info.TotalMetadataBufferSize) {
     g_container->metadata.clear();  // Avoid data copy
-    g_container->metadata.reserve(frame_info.TotalMetadataBufferSize);
+    g_container->metadata.resize(frame_info.TotalMetadataBufferSize);
   }
 
   UINT buff_size = 0;
@@ -518,7 +546,7 @@ bool ScreenCapturerWinDirectx::DetectUpdatedRegion(
       reinterpret_cast<DXGI_OUTDUPL_MOVE_RECT*>(g_container->metadata.data());
   size_t move_rects_count = 0;
   _com_error error = _com_error(g_container->duplication->GetFrameMoveRects(
-      static_cast<UINT>(g_container->metadata.capacity()),
+      static_cast<UINT>(g_container->metadata.size()),
       move_rects, &buff_size));
   if (!HandleDetectUpdatedRegionError(error, "move")) {
     return false;
@@ -529,7 +557,7 @@ bool ScreenCapturerWinDirectx::DetectUpdatedRegion(
       reinterpret_cast<RECT*>(g_container->metadata.data() + buff_size);
   size_t dirty_rects_count = 0;
   error = _com_error(g_container->duplication->GetFrameDirtyRects(
-      static_cast<UINT>(g_container->metadata.capacity()) - buff_size,
+      static_cast<UINT>(g_container->metadata.size()) - buff_size,
       dirty_rects, &buff_size));
   if (!HandleDetectUpdatedRegionError(error, "dirty")) {
     return false;
@@ -573,6 +601,8 @@ std::unique_ptr<DesktopFrame> ScreenCapturerWinDirectx::ProcessFrame(
   RTC_DCHECK(surfaces_.current_frame());
   if (!surfaces_.current_frame()->get()->CopyFrom(frame_info, resource,
           surfaces_.previous_frame()->get()->updated_region())) {
+    surfaces_.current_frame()->get()->RequireFullCopy();
+    surfaces_.previous_frame()->get()->RequireFullCopy();
     return std::unique_ptr<DesktopFrame>();
   }
 
@@ -580,6 +610,7 @@ std::unique_ptr<DesktopFrame> ScreenCapturerWinDirectx::ProcessFrame(
   if (shared_memory_factory_) {
     // When using shared memory, |frames_| is used to store a queue of
     // SharedMemoryDesktopFrame's.
+    bool new_frame_allocated = false;
     if (!frames_.current_frame() ||
         !frames_.current_frame()->size().equals(
             surfaces_.current_frame()->get()->size())) {
@@ -594,14 +625,19 @@ std::unique_ptr<DesktopFrame> ScreenCapturerWinDirectx::ProcessFrame(
       }
       frames_.ReplaceCurrentFrame(
           SharedDesktopFrame::Wrap(new_frame.release()));
+      new_frame_allocated = true;
     }
     result.reset(frames_.current_frame()->Share());
 
     std::unique_ptr<DesktopFrame> frame(
         new DxgiDesktopFrame(*surfaces_.current_frame()));
-    // Copy data into SharedMemory.
-    for (DesktopRegion::Iterator it(
-             surfaces_.current_frame()->get()->copied_region());
+    // Copy data into SharedMemory. A newly allocated frame doesn't hold the
+    // frame before the last one yet, so it needs all of the data.
+    DesktopRegion copied_region(
+        surfaces_.current_frame()->get()->copied_region());
+    if (new_frame_allocated)
+      copied_region.SetRect(DesktopRect::MakeSize(frame->size()));
+    for (DesktopRegion::Iterator it(copied_region);
          !it.IsAtEnd();
          it.Advance()) {
       result->CopyPixelsFrom(*frame, it.rect().top_left(), it.rect());
@@ -697,8 +733,10 @@ bool ScreenCapturerWinDirectx::SelectScreen(ScreenId id) {
 }
 
 void ScreenCapturerWinDirectx::EmitCurrentFrame() {
-  if (!surfaces_.current_frame()->get()->bits()) {
-    // At the very begining, we have not captured any frames.
+  if (!surfaces_.current_frame()->get()->bits() ||
+      surfaces_.current_frame()->get()->needs_full_copy()) {
+    // At the very begining, we have not captured any frames. Or the last
+    // frame failed to be copied, so what we have is stale.
     callback_->OnCaptureCompleted(nullptr);
     return;
   }
@@ -15,6 +15,9 @@
 #include <Cocoa/Cocoa.h>
 #include <CoreFoundation/CoreFoundation.h>
 
+#include <memory>
+
+#include "webrtc/base/checks.h"
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/macutils.h"
 #include "webrtc/base/scoped_ref_ptr.h"
@@ -23,6 +26,8 @@
 #include "webrtc/modules/desktop_capture/mac/desktop_configuration.h"
 #include "webrtc/modules/desktop_capture/mac/full_screen_chrome_window_detector.h"
 #include "webrtc/modules/desktop_capture/mac/window_list_utils.h"
+#include "webrtc/modules/desktop_capture/screen_capture_frame_queue.h"
+#include "webrtc/modules/desktop_capture/shared_desktop_frame.h"
 #include "webrtc/system_wrappers/include/logging.h"
 
 namespace webrtc {
@@ -66,6 +71,9 @@ class WindowCapturerMac : public WindowCapturer {
   rtc::scoped_refptr<FullScreenChromeWindowDetector>
       full_screen_chrome_window_detector_;
 
+  // Queue of the frames buffers.
+  ScreenCaptureFrameQueue<SharedDesktopFrame> queue_;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(WindowCapturerMac);
 };
 
@@ -215,8 +223,18 @@ void WindowCapturerMac::Capture(const DesktopRegion& region) {
   int height = CGImageGetHeight(window_image);
   CGDataProviderRef provider = CGImageGetDataProvider(window_image);
   CFDataRef cf_data = CGDataProviderCopyData(provider);
-  DesktopFrame* frame = new BasicDesktopFrame(
-      DesktopSize(width, height));
+
+  queue_.MoveToNextFrame();
+  RTC_DCHECK(!queue_.current_frame() || !queue_.current_frame()->IsShared());
+
+  // Reuse the frame captured two calls ago unless the window size changed.
+  if (!queue_.current_frame() ||
+      !queue_.current_frame()->size().equals(DesktopSize(width, height))) {
+    std::unique_ptr<DesktopFrame> frame(
+        new BasicDesktopFrame(DesktopSize(width, height)));
+    queue_.ReplaceCurrentFrame(SharedDesktopFrame::Wrap(frame.release()));
+  }
+  DesktopFrame* frame = queue_.current_frame()->Share();
 
   int src_stride = CGImageGetBytesPerRow(window_image);
   const uint8_t* src_data = CFDataGetBytePtr(cf_data);
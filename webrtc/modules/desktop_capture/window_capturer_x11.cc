@@ -18,11 +18,15 @@
 #include <X11/Xutil.h>
 
 #include <algorithm>
+#include <memory>
 
+#include "webrtc/base/checks.h"
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/modules/desktop_capture/desktop_capture_options.h"
 #include "webrtc/modules/desktop_capture/desktop_frame.h"
+#include "webrtc/modules/desktop_capture/screen_capture_frame_queue.h"
+#include "webrtc/modules/desktop_capture/shared_desktop_frame.h"
 #include "webrtc/modules/desktop_capture/x11/shared_x_display.h"
 #include "webrtc/modules/desktop_capture/x11/x_error_trap.h"
 #include "webrtc/modules/desktop_capture/x11/x_server_pixel_buffer.h"
@@ -129,6 +133,9 @@ class WindowCapturerLinux : public WindowCapturer,
   ::Window selected_window_;
   XServerPixelBuffer x_server_pixel_buffer_;
 
+  // Queue of the frames buffers.
+  ScreenCaptureFrameQueue<SharedDesktopFrame> queue_;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(WindowCapturerLinux);
 };
 
@@ -295,8 +302,19 @@ void WindowCapturerLinux::Capture(const DesktopRegion& region) {
     return;
   }
 
-  DesktopFrame* frame =
-      new BasicDesktopFrame(x_server_pixel_buffer_.window_size());
+  queue_.MoveToNextFrame();
+  RTC_DCHECK(!queue_.current_frame() || !queue_.current_frame()->IsShared());
+
+  // Reuse the frame captured two calls ago unless the window has been resized
+  // or another window selected since.
+  if (!queue_.current_frame() ||
+      !queue_.current_frame()->size().equals(
+          x_server_pixel_buffer_.window_size())) {
+    std::unique_ptr<DesktopFrame> frame(
+        new BasicDesktopFrame(x_server_pixel_buffer_.window_size()));
+    queue_.ReplaceCurrentFrame(SharedDesktopFrame::Wrap(frame.release()));
+  }
+  DesktopFrame* frame = queue_.current_frame()->Share();
 
   x_server_pixel_buffer_.Synchronize();
   x_server_pixel_buffer_.CaptureRect(DesktopRect::MakeSize(frame->size()),
@@ -233,20 +233,47 @@ void XServerPixelBuffer::Synchronize() {
   }
 }
 
+const uint8_t* XServerPixelBuffer::GetSynchronizedData(int* stride) const {
+  if (!shm_segment_info_ || shm_pixmap_ || !IsXImageRGBFormat(x_image_))
+    return NULL;
+  *stride = x_image_->bytes_per_line;
+  return reinterpret_cast<const uint8_t*>(x_image_->data);
+}
+
 void XServerPixelBuffer::CaptureRect(const DesktopRect& rect,
                                      DesktopFrame* frame) {
+  if (shm_pixmap_) {
+    XCopyArea(display_, window_, shm_pixmap_, shm_gc_,
+              rect.left(), rect.top(), rect.width(), rect.height(),
+              rect.left(), rect.top());
+    XSync(display_, False);
+  }
+  CopyRectToFrame(rect, frame);
+}
+
+void XServerPixelBuffer::CaptureRegion(const DesktopRegion& region,
+                                       DesktopFrame* frame) {
+  if (shm_pixmap_) {
+    for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+      const DesktopRect& rect = it.rect();
+      XCopyArea(display_, window_, shm_pixmap_, shm_gc_,
+                rect.left(), rect.top(), rect.width(), rect.height(),
+                rect.left(), rect.top());
+    }
+    XSync(display_, False);
+  }
+  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance())
+    CopyRectToFrame(it.rect(), frame);
+}
+
+void XServerPixelBuffer::CopyRectToFrame(const DesktopRect& rect,
+                                         DesktopFrame* frame) {
   assert(rect.right() <= window_size_.width());
   assert(rect.bottom() <= window_size_.height());
 
   uint8_t* data;
 
   if (shm_segment_info_) {
-    if (shm_pixmap_) {
-      XCopyArea(display_, window_, shm_pixmap_, shm_gc_,
-                rect.left(), rect.top(), rect.width(), rect.height(),
-                rect.left(), rect.top());
-      XSync(display_, False);
-    }
     data = reinterpret_cast<uint8_t*>(x_image_->data) +
         rect.top() * x_image_->bytes_per_line +
         rect.left() * x_image_->bits_per_pixel / 8;
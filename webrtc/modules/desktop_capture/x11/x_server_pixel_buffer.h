@@ -15,6 +15,7 @@
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/modules/desktop_capture/desktop_geometry.h"
+#include "webrtc/modules/desktop_capture/desktop_region.h"
 
 #include <X11/Xutil.h>
 #include <X11/extensions/XShm.h>
@@ -57,10 +58,25 @@ class XServerPixelBuffer {
   // that |rect| is not larger than window_size().
   void CaptureRect(const DesktopRect& rect, DesktopFrame* frame);
 
+  // Same as calling CaptureRect() for each rectangle of |region|, but waits
+  // for the X server only once when shared pixmaps are used.
+  void CaptureRegion(const DesktopRegion& region, DesktopFrame* frame);
+
+  // Returns the window contents fetched by Synchronize() if they are already
+  // laid out like a DesktopFrame, i.e. 32-bit RGB, with the row stride
+  // stored in |stride|. This allows them to be compared with the previous
+  // frame before anything is copied. Returns NULL if Synchronize() doesn't
+  // fetch the whole window or the image has another format.
+  const uint8_t* GetSynchronizedData(int* stride) const;
+
  private:
   void InitShm(const XWindowAttributes& attributes);
   bool InitPixmaps(int depth);
 
+  // Copies |rect| from the XImage to |frame|. With shared pixmaps, |rect| must
+  // have been copied into the pixmap already.
+  void CopyRectToFrame(const DesktopRect& rect, DesktopFrame* frame);
+
   // We expose two forms of blitting to handle variations in the pixel format.
   // In FastBlit(), the operation is effectively a memcpy.
   void FastBlit(uint8_t* image,
@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/media_file/buffered_file_streams.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
+
+namespace webrtc {
+
+AsyncFileWriter::AsyncFileWriter(std::unique_ptr<FileWrapper> file,
+                                 int flush_interval_ms,
+                                 size_t max_buffered_bytes)
+    : flush_interval_ms_(flush_interval_ms),
+      max_buffered_bytes_(max_buffered_bytes),
+      bytes_being_written_(0),
+      num_dropped_bytes_(0),
+      dropping_(false),
+      write_failed_(false),
+      quit_(false),
+      file_(std::move(file)),
+      wake_(false, false),
+      thread_(&AsyncFileWriter::WriterThread, this, "AsyncFileWriter") {
+  RTC_DCHECK(file_->Open());
+  RTC_DCHECK_GT(flush_interval_ms, 0);
+  // The buffers keep their capacity when swapped, so after this writes only
+  // allocate if more than half of the max is buffered at once.
+  buffer_.reserve(max_buffered_bytes_ / 2);
+  write_buffer_.reserve(max_buffered_bytes_ / 2);
+  thread_.Start();
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+  {
+    rtc::CritScope cs(&crit_);
+    quit_ = true;
+  }
+  wake_.Set();
+  thread_.Stop();
+  WriteBufferedData();
+  rtc::CritScope cs(&file_crit_);
+  file_->CloseFile();
+}
+
+bool AsyncFileWriter::Write(const void* buf, size_t len) {
+  if (buf == nullptr)
+    return false;
+  rtc::CritScope cs(&crit_);
+  if (write_failed_)
+    return false;
+  if (buffer_.size() + bytes_being_written_ + len > max_buffered_bytes_) {
+    if (!dropping_) {
+      LOG(LS_WARNING) << "Writing to file falls behind, dropping data.";
+      dropping_ = true;
+    }
+    num_dropped_bytes_ += len;
+    return true;
+  }
+  dropping_ = false;
+  const uint8_t* data = static_cast<const uint8_t*>(buf);
+  buffer_.insert(buffer_.end(), data, data + len);
+  if (buffer_.size() >= max_buffered_bytes_ / 2)
+    wake_.Set();
+  return true;
+}
+
+int AsyncFileWriter::Rewind() {
+  WriteBufferedData();
+  rtc::CritScope cs(&file_crit_);
+  return file_->Rewind();
+}
+
+size_t AsyncFileWriter::num_dropped_bytes() const {
+  rtc::CritScope cs(&crit_);
+  return num_dropped_bytes_;
+}
+
+bool AsyncFileWriter::WriterThread(void* obj) {
+  return static_cast<AsyncFileWriter*>(obj)->Process();
+}
+
+bool AsyncFileWriter::Process() {
+  wake_.Wait(flush_interval_ms_);
+  {
+    rtc::CritScope cs(&crit_);
+    // The destructor writes what's left.
+    if (quit_)
+      return false;
+  }
+  WriteBufferedData();
+  return true;
+}
+
+void AsyncFileWriter::WriteBufferedData() {
+  rtc::CritScope file_cs(&file_crit_);
+  {
+    rtc::CritScope cs(&crit_);
+    write_buffer_.swap(buffer_);
+    bytes_being_written_ = write_buffer_.size();
+  }
+  if (write_buffer_.empty())
+    return;
+
+  const bool written = file_->Write(write_buffer_.data(), write_buffer_.size());
+  file_->Flush();
+  write_buffer_.clear();
+
+  rtc::CritScope cs(&crit_);
+  bytes_being_written_ = 0;
+  if (!written)
+    write_failed_ = true;
+}
+
+std::unique_ptr<PreloadedFileReader> PreloadedFileReader::Create(
+    const char* file_name,
+    bool loop,
+    size_t max_bytes) {
+  FILE* file = fopen(file_name, "rb");
+  if (!file)
+    return nullptr;
+  long size = -1;
+  if (fseek(file, 0, SEEK_END) == 0) {
+    size = ftell(file);
+    rewind(file);
+  }
+  if (size < 0 || static_cast<size_t>(size) > max_bytes) {
+    fclose(file);
+    return nullptr;
+  }
+  std::vector<uint8_t> data(size);
+  const size_t bytes_read = fread(data.data(), 1, data.size(), file);
+  fclose(file);
+  if (bytes_read != data.size())
+    return nullptr;
+  return std::unique_ptr<PreloadedFileReader>(
+      new PreloadedFileReader(std::move(data), loop));
+}
+
+PreloadedFileReader::PreloadedFileReader(std::vector<uint8_t> data, bool loop)
+    : data_(std::move(data)), loop_(loop), position_(0), closed_(false) {}
+
+int PreloadedFileReader::Read(void* buf, size_t len) {
+  if (closed_)
+    return -1;
+  const size_t bytes_read = std::min(len, data_.size() - position_);
+  memcpy(buf, data_.data() + position_, bytes_read);
+  position_ += bytes_read;
+  if (bytes_read != len && !loop_)
+    closed_ = true;
+  return static_cast<int>(bytes_read);
+}
+
+int PreloadedFileReader::Rewind() {
+  if (!loop_)
+    return -1;
+  position_ = 0;
+  return 0;
+}
+
+}  // namespace webrtc
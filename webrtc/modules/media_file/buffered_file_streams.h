@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_MEDIA_FILE_BUFFERED_FILE_STREAMS_H_
+#define WEBRTC_MODULES_MEDIA_FILE_BUFFERED_FILE_STREAMS_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/common_types.h"
+#include "webrtc/system_wrappers/include/file_wrapper.h"
+
+namespace webrtc {
+
+// An OutStream that moves file writes off the calling thread, so that a
+// recording never blocks the audio thread on disk I/O. Write() only appends to
+// an in-memory buffer. A background thread swaps that buffer with a second
+// one every |flush_interval_ms|, or earlier once half of |max_buffered_bytes|
+// has been buffered, and writes and flushes it to the file.
+//
+// If the disk can't keep up and |max_buffered_bytes| are waiting to be
+// written, further writes are dropped. Whole writes are dropped, so a file of
+// fixed size samples stays aligned.
+class AsyncFileWriter : public OutStream {
+ public:
+  // |file| must be open for writing.
+  AsyncFileWriter(std::unique_ptr<FileWrapper> file,
+                  int flush_interval_ms,
+                  size_t max_buffered_bytes);
+  // Writes all buffered data and closes the file.
+  ~AsyncFileWriter() override;
+
+  // Returns false once writing to the file has failed, e.g. because the file
+  // reached its max size.
+  bool Write(const void* buf, size_t len) override;
+  // Blocks until all buffered data has been written, and then rewinds the
+  // file. Meant for rewriting a header when a recording stops.
+  int Rewind() override;
+
+  size_t num_dropped_bytes() const;
+
+ private:
+  static bool WriterThread(void* obj);
+  bool Process();
+  void WriteBufferedData();
+
+  const int flush_interval_ms_;
+  const size_t max_buffered_bytes_;
+
+  rtc::CriticalSection crit_;
+  // Filled by Write().
+  std::vector<uint8_t> buffer_ GUARDED_BY(crit_);
+  // Size of |write_buffer_| while it's being written.
+  size_t bytes_being_written_ GUARDED_BY(crit_);
+  size_t num_dropped_bytes_ GUARDED_BY(crit_);
+  bool dropping_ GUARDED_BY(crit_);
+  bool write_failed_ GUARDED_BY(crit_);
+  bool quit_ GUARDED_BY(crit_);
+
+  // Held while writing, so that Rewind() can write on the calling thread.
+  rtc::CriticalSection file_crit_;
+  std::unique_ptr<FileWrapper> file_ GUARDED_BY(file_crit_);
+  std::vector<uint8_t> write_buffer_ GUARDED_BY(file_crit_);
+
+  rtc::Event wake_;
+  rtc::PlatformThread thread_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AsyncFileWriter);
+};
+
+// An InStream that reads a whole file into memory up front, so that playing
+// it back doesn't touch the disk. Behaves like a FileWrapper opened for
+// reading: it can only be rewound if |loop| is set, and otherwise fails reads
+// after the end of the file has been reached.
+class PreloadedFileReader : public InStream {
+ public:
+  // Returns null if the file can't be read, or is larger than |max_bytes|.
+  static std::unique_ptr<PreloadedFileReader> Create(const char* file_name,
+                                                     bool loop,
+                                                     size_t max_bytes);
+
+  int Read(void* buf, size_t len) override;
+  int Rewind() override;
+
+ private:
+  PreloadedFileReader(std::vector<uint8_t> data, bool loop);
+
+  const std::vector<uint8_t> data_;
+  const bool loop_;
+  size_t position_;
+  bool closed_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PreloadedFileReader);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_MEDIA_FILE_BUFFERED_FILE_STREAMS_H_
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/media_file/buffered_file_streams.h"
+
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/test/testsupport/fileutils.h"
+
+namespace webrtc {
+namespace {
+const int kFlushIntervalMs = 10;
+const size_t kMaxBufferedBytes = 10;
+}  // namespace
+
+class BufferedFileStreamsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    file_name_ = test::TempFilename(test::OutputPath(), "buffered_streams");
+  }
+
+  void TearDown() override { remove(file_name_.c_str()); }
+
+  std::unique_ptr<AsyncFileWriter> CreateWriter(size_t max_file_size) {
+    std::unique_ptr<FileWrapper> file(FileWrapper::Create());
+    EXPECT_EQ(0, file->OpenFile(file_name_.c_str(), false));
+    file->SetMaxFileSize(max_file_size);
+    return std::unique_ptr<AsyncFileWriter>(new AsyncFileWriter(
+        std::move(file), kFlushIntervalMs, kMaxBufferedBytes));
+  }
+
+  std::string ReadFile() {
+    std::string contents;
+    FILE* file = fopen(file_name_.c_str(), "rb");
+    if (!file)
+      return contents;
+    char buf[64];
+    size_t read;
+    while ((read = fread(buf, 1, sizeof(buf), file)) > 0)
+      contents.append(buf, read);
+    fclose(file);
+    return contents;
+  }
+
+  std::string file_name_;
+};
+
+TEST_F(BufferedFileStreamsTest, WriterRewindsAfterWritingBufferedData) {
+  std::unique_ptr<AsyncFileWriter> writer = CreateWriter(0);
+  EXPECT_TRUE(writer->Write("abcd", 4));
+  EXPECT_TRUE(writer->Write("efgh", 4));
+  EXPECT_EQ(0, writer->Rewind());
+  // Overwrites the start of the file, like a WAV header update.
+  EXPECT_TRUE(writer->Write("AB", 2));
+  writer.reset();
+  EXPECT_EQ("ABcdefgh", ReadFile());
+}
+
+TEST_F(BufferedFileStreamsTest, WriterDropsWritesThatDoNotFit) {
+  std::unique_ptr<AsyncFileWriter> writer = CreateWriter(0);
+  EXPECT_TRUE(writer->Write("0123456789abcdef", 16));
+  EXPECT_TRUE(writer->Write("abcd", 4));
+  EXPECT_EQ(16u, writer->num_dropped_bytes());
+  writer.reset();
+  EXPECT_EQ("abcd", ReadFile());
+}
+
+TEST_F(BufferedFileStreamsTest, WriterFailsAfterFileWriteFailed) {
+  std::unique_ptr<AsyncFileWriter> writer = CreateWriter(4);
+  EXPECT_TRUE(writer->Write("abcdefgh", 8));
+  // Writes the buffered data, which doesn't fit in the file.
+  writer->Rewind();
+  EXPECT_FALSE(writer->Write("abcd", 4));
+}
+
+TEST_F(BufferedFileStreamsTest, ReaderReadsWholeFile) {
+  FILE* file = fopen(file_name_.c_str(), "wb");
+  ASSERT_TRUE(file != nullptr);
+  fwrite("abcdef", 1, 6, file);
+  fclose(file);
+
+  EXPECT_FALSE(PreloadedFileReader::Create(file_name_.c_str(), false, 5));
+
+  std::unique_ptr<PreloadedFileReader> reader =
+      PreloadedFileReader::Create(file_name_.c_str(), false, 6);
+  ASSERT_TRUE(reader);
+  char buf[4];
+  EXPECT_EQ(4, reader->Read(buf, 4));
+  EXPECT_EQ("abcd", std::string(buf, 4));
+  EXPECT_EQ(2, reader->Read(buf, 4));
+  EXPECT_EQ("ef", std::string(buf, 2));
+  // Like a FileWrapper that doesn't loop, reading past the end closes it.
+  EXPECT_EQ(-1, reader->Read(buf, 4));
+  EXPECT_EQ(-1, reader->Rewind());
+}
+
+TEST_F(BufferedFileStreamsTest, LoopingReaderCanBeRewound) {
+  FILE* file = fopen(file_name_.c_str(), "wb");
+  ASSERT_TRUE(file != nullptr);
+  fwrite("abcdef", 1, 6, file);
+  fclose(file);
+
+  std::unique_ptr<PreloadedFileReader> reader =
+      PreloadedFileReader::Create(file_name_.c_str(), true, 6);
+  ASSERT_TRUE(reader);
+  char buf[8];
+  EXPECT_EQ(6, reader->Read(buf, 8));
+  EXPECT_EQ(0, reader->Read(buf, 8));
+  EXPECT_EQ(0, reader->Rewind());
+  EXPECT_EQ(3, reader->Read(buf, 3));
+  EXPECT_EQ("abc", std::string(buf, 3));
+}
+
+}  // namespace webrtc
@@ -65,6 +65,8 @@ public:
     // stopPointMs ms.
     // Note: codecInst.channels should be set to 2 for stereo (and 1 for
     // mono). Stereo audio is only supported for WAV files.
+    // Note: files of up to 16 MB are read into memory here, so that playing
+    // them doesn't read from disk.
     virtual int32_t StartPlayingAudioFile(
         const char* fileName,
         const uint32_t notificationTimeMs = 0,
@@ -143,6 +145,15 @@ public:
         const CodecInst&     codecInst,
         const uint32_t notificationTimeMs = 0) = 0;
 
+    // Configures how StartRecordingAudioFile(..) writes to its file. The data
+    // is buffered in memory and written to disk by a background thread every
+    // flushIntervalMs ms. Audio is dropped while maxBufferedBytes are waiting
+    // to be written. If maxBufferedBytes is zero the file is written
+    // synchronously by the thread calling IncomingAudioData(..).
+    // Note: only affects recordings started after the call.
+    virtual void SetFileWriteBuffering(int flushIntervalMs,
+                                       size_t maxBufferedBytes) = 0;
+
     // Stop recording to file or stream.
     virtual int32_t StopRecording() = 0;
 
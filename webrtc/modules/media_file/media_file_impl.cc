@@ -10,13 +10,25 @@
 
 #include <assert.h>
 
+#include <memory>
+#include <utility>
+
 #include "webrtc/base/format_macros.h"
+#include "webrtc/modules/media_file/buffered_file_streams.h"
 #include "webrtc/modules/media_file/media_file_impl.h"
 #include "webrtc/system_wrappers/include/critical_section_wrapper.h"
 #include "webrtc/system_wrappers/include/file_wrapper.h"
 #include "webrtc/system_wrappers/include/trace.h"
 
 namespace webrtc {
+namespace {
+// Larger files are read from disk while playing.
+const size_t kMaxPreloadedFileBytes = 16 * 1024 * 1024;
+const int kDefaultFlushIntervalMs = 500;
+// Enough for 8 s of 32 kHz stereo PCM.
+const size_t kDefaultMaxBufferedBytes = 1024 * 1024;
+}  // namespace
+
 MediaFile* MediaFile::CreateMediaFile(const int32_t id)
 {
     return new MediaFileImpl(id);
@@ -43,6 +55,8 @@ MediaFileImpl::MediaFileImpl(const int32_t id)
       _recordingActive(false),
       _isStereo(false),
       _openFile(false),
+      _flushIntervalMs(kDefaultFlushIntervalMs),
+      _maxBufferedBytes(kDefaultMaxBufferedBytes),
       _fileName(),
       _ptrCallback(NULL)
 {
@@ -363,31 +377,29 @@ int32_t MediaFileImpl::StartPlayingAudioFile(
         return -1;
     }
 
-    FileWrapper* inputStream = FileWrapper::Create();
-    if(inputStream == NULL)
-    {
-       WEBRTC_TRACE(kTraceMemory, kTraceFile, _id,
-                    "Failed to allocate input stream for file %s", fileName);
-        return -1;
-    }
-
-    if(inputStream->OpenFile(fileName, true, loop) != 0)
+    std::unique_ptr<InStream> inputStream(
+        PreloadedFileReader::Create(fileName, loop, kMaxPreloadedFileBytes));
+    if(!inputStream)
     {
-        delete inputStream;
-        WEBRTC_TRACE(kTraceError, kTraceFile, _id,
-                     "Could not open input file %s", fileName);
-        return -1;
+        std::unique_ptr<FileWrapper> inputFile(FileWrapper::Create());
+        if(inputFile->OpenFile(fileName, true, loop) != 0)
+        {
+            WEBRTC_TRACE(kTraceError, kTraceFile, _id,
+                         "Could not open input file %s", fileName);
+            return -1;
+        }
+        inputStream = std::move(inputFile);
     }
 
     if(StartPlayingStream(*inputStream, loop, notificationTimeMs,
                           format, codecInst, startPointMs, stopPointMs) == -1)
     {
-        inputStream->CloseFile();
-        delete inputStream;
         return -1;
     }
 
     CriticalSectionScoped lock(_crit);
+    // Now owned by this object, see StopPlaying().
+    inputStream.release();
     _openFile = true;
     strncpy(_fileName, fileName, sizeof(_fileName));
     _fileName[sizeof(_fileName) - 1] = '\0';
@@ -762,15 +774,28 @@ int32_t MediaFileImpl::StartRecordingAudioFile(
         outputStream->SetMaxFileSize(maxSizeBytes);
     }
 
-    if(StartRecordingAudioStream(*outputStream, format, codecInst,
+    std::unique_ptr<OutStream> stream;
+    {
+        CriticalSectionScoped lock(_crit);
+        if(_maxBufferedBytes > 0)
+        {
+            stream.reset(new AsyncFileWriter(
+                std::unique_ptr<FileWrapper>(outputStream), _flushIntervalMs,
+                _maxBufferedBytes));
+        } else {
+            stream.reset(outputStream);
+        }
+    }
+
+    if(StartRecordingAudioStream(*stream, format, codecInst,
                                  notificationTimeMs) == -1)
     {
-        outputStream->CloseFile();
-        delete outputStream;
         return -1;
     }
 
     CriticalSectionScoped lock(_crit);
+    // Now owned by this object, see StopRecording().
+    stream.release();
     _openFile = true;
     strncpy(_fileName, fileName, sizeof(_fileName));
     _fileName[sizeof(_fileName) - 1] = '\0';
@@ -923,6 +948,14 @@ int32_t MediaFileImpl::StartRecordingAudioStream(
     return 0;
 }
 
+void MediaFileImpl::SetFileWriteBuffering(int flushIntervalMs,
+                                          size_t maxBufferedBytes)
+{
+    CriticalSectionScoped lock(_crit);
+    _flushIntervalMs = flushIntervalMs;
+    _maxBufferedBytes = maxBufferedBytes;
+}
+
 int32_t MediaFileImpl::StopRecording()
 {
 
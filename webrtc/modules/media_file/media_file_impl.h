@@ -75,6 +75,9 @@ public:
         const CodecInst& codecInst,
         const uint32_t notificationTimeMs = 0) override;
 
+    void SetFileWriteBuffering(int flushIntervalMs,
+                               size_t maxBufferedBytes) override;
+
     int32_t StopRecording() override;
 
     bool IsRecording() override;
@@ -139,6 +142,9 @@ private:
     bool _isStereo;
     bool _openFile;
 
+    int _flushIntervalMs;
+    size_t _maxBufferedBytes;
+
     char _fileName[512];
 
     FileCallback* _ptrCallback;
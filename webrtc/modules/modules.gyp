@@ -179,9 +179,11 @@
             'audio_coding/codecs/isac/fix/source/lpc_masking_model_unittest.cc',
             'audio_coding/codecs/isac/fix/source/transform_unittest.cc',
             'audio_coding/codecs/isac/main/source/audio_encoder_isac_unittest.cc',
+            'audio_coding/codecs/isac/main/source/correlation_unittest.cc',
             'audio_coding/codecs/isac/main/source/isac_unittest.cc',
             'audio_coding/codecs/isac/unittest.cc',
             'audio_coding/codecs/opus/audio_encoder_opus_unittest.cc',
+            'audio_coding/codecs/opus/opus_complexity_adapter_unittest.cc',
             'audio_coding/codecs/opus/opus_unittest.cc',
             'audio_coding/codecs/red/audio_encoder_copy_red_unittest.cc',
             'audio_coding/codecs/mock/mock_audio_encoder.cc',
@@ -191,6 +193,7 @@
             'audio_coding/neteq/background_noise_unittest.cc',
             'audio_coding/neteq/buffer_level_filter_unittest.cc',
             'audio_coding/neteq/comfort_noise_unittest.cc',
+            'audio_coding/neteq/cross_fade_unittest.cc',
             'audio_coding/neteq/decision_logic_unittest.cc',
             'audio_coding/neteq/decoder_database_unittest.cc',
             'audio_coding/neteq/delay_manager_unittest.cc',
@@ -202,6 +205,7 @@
             'audio_coding/neteq/merge_unittest.cc',
             'audio_coding/neteq/nack_unittest.cc',
             'audio_coding/neteq/neteq_external_decoder_unittest.cc',
+            'audio_coding/neteq/neteq_batch_unittest.cc',
             'audio_coding/neteq/neteq_impl_unittest.cc',
             'audio_coding/neteq/neteq_network_stats_unittest.cc',
             'audio_coding/neteq/neteq_stereo_unittest.cc',
@@ -230,14 +234,18 @@
             'audio_coding/neteq/tools/input_audio_file_unittest.cc',
             'audio_coding/neteq/tools/packet_unittest.cc',
             'audio_conference_mixer/test/audio_conference_mixer_unittest.cc',
+            'audio_device/audio_device_buffer_unittest.cc',
             'audio_device/fine_audio_buffer_unittest.cc',
+            'audio_processing/aec/aec_core_avx2_unittest.cc',
             'audio_processing/aec/echo_cancellation_unittest.cc',
             'audio_processing/aec/system_delay_unittest.cc',
             'audio_processing/agc/agc_manager_direct_unittest.cc',
             # TODO(ajm): Fix to match new interface.
             # 'audio_processing/agc/agc_unittest.cc',
             'audio_processing/agc/histogram_unittest.cc',
+            'audio_processing/agc/legacy/digital_agc_sse2_unittest.cc',
             'audio_processing/agc/mock_agc.h',
+            'audio_processing/audio_processing_batch_unittest.cc',
             'audio_processing/beamformer/array_util_unittest.cc',
             'audio_processing/beamformer/complex_matrix_unittest.cc',
             'audio_processing/beamformer/covariance_matrix_generator_unittest.cc',
@@ -247,6 +255,7 @@
             'audio_processing/echo_cancellation_impl_unittest.cc',
             'audio_processing/intelligibility/intelligibility_enhancer_unittest.cc',
             'audio_processing/intelligibility/intelligibility_utils_unittest.cc',
+            'audio_processing/ns/ns_core_sse2_unittest.cc',
             'audio_processing/splitting_filter_unittest.cc',
             'audio_processing/transient/dyadic_decimator_unittest.cc',
             'audio_processing/transient/file_utils.cc',
@@ -270,10 +279,12 @@
             'bitrate_controller/bitrate_controller_unittest.cc',
             'bitrate_controller/send_side_bandwidth_estimation_unittest.cc',
             'congestion_controller/congestion_controller_unittest.cc',
+            'media_file/buffered_file_streams_unittest.cc',
             'media_file/media_file_unittest.cc',
             'module_common_types_unittest.cc',
             'pacing/bitrate_prober_unittest.cc',
             'pacing/paced_sender_unittest.cc',
+            'pacing/packet_queue_unittest.cc',
             'pacing/packet_router_unittest.cc',
             'remote_bitrate_estimator/bwe_simulations.cc',
             'remote_bitrate_estimator/include/mock/mock_remote_bitrate_observer.h',
@@ -286,6 +297,7 @@
             'remote_bitrate_estimator/remote_bitrate_estimator_unittest_helper.h',
             'remote_bitrate_estimator/remote_estimator_proxy_unittest.cc',
             'remote_bitrate_estimator/send_time_history_unittest.cc',
+            'remote_bitrate_estimator/test/bwe_scenario_runner_unittest.cc',
             'remote_bitrate_estimator/test/bwe_test_framework_unittest.cc',
             'remote_bitrate_estimator/test/bwe_unittest.cc',
             'remote_bitrate_estimator/test/metric_recorder_unittest.cc',
@@ -296,6 +308,7 @@
             'rtp_rtcp/source/fec_receiver_unittest.cc',
             'rtp_rtcp/source/fec_test_helper.cc',
             'rtp_rtcp/source/fec_test_helper.h',
+            'rtp_rtcp/source/forward_error_correction_xor_unittest.cc',
             'rtp_rtcp/source/h264_sps_parser_unittest.cc',
             'rtp_rtcp/source/nack_rtx_unittest.cc',
             'rtp_rtcp/source/packet_loss_stats_unittest.cc',
@@ -349,9 +362,11 @@
             'rtp_rtcp/test/testAPI/test_api_audio.cc',
             'rtp_rtcp/test/testAPI/test_api_rtcp.cc',
             'rtp_rtcp/test/testAPI/test_api_video.cc',
+            'utility/source/audio_frame_kernels_unittest.cc',
             'utility/source/audio_frame_operations_unittest.cc',
             'utility/source/file_player_unittests.cc',
             'utility/source/process_thread_impl_unittest.cc',
+            'utility/source/process_thread_pool_unittest.cc',
             'video_coding/codecs/test/packet_manipulator_unittest.cc',
             'video_coding/codecs/test/stats_unittest.cc',
             'video_coding/codecs/test/videoprocessor_unittest.cc',
@@ -447,6 +462,7 @@
                 'audio_processing/audio_processing_impl_locking_unittest.cc',
                 'audio_processing/audio_processing_impl_unittest.cc',
                 'audio_processing/audio_processing_unittest.cc',
+                'audio_processing/debug_dump_writer_unittest.cc',
                 'audio_processing/echo_control_mobile_unittest.cc',
                 'audio_processing/echo_cancellation_unittest.cc',
                 'audio_processing/gain_control_unittest.cc',
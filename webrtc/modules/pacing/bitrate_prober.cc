@@ -22,6 +22,9 @@
 namespace webrtc {
 
 namespace {
+// Number of deltas measured per probe cluster.
+const int kPacketsPerProbe = 5;
+
 int ComputeDeltaFromBitrate(size_t packet_size, uint32_t bitrate_bps) {
   assert(bitrate_bps > 0);
   // Compute the time delta needed to send packet_size bytes at bitrate_bps
@@ -62,23 +65,22 @@ void BitrateProber::OnIncomingPacket(uint32_t bitrate_bps,
     return;
   if (probing_state_ != kAllowedToProbe)
     return;
-  // Max number of packets used for probing.
-  const int kMaxNumProbes = 2;
-  const int kPacketsPerProbe = 5;
-  const float kProbeBitrateMultipliers[kMaxNumProbes] = {3, 6};
+  // Unless clusters were requested with CreateProbeCluster(), this is the
+  // initial probing of the connection.
+  if (clusters_.empty()) {
+    // Max number of packets used for probing.
+    const int kMaxNumProbes = 2;
+    const float kProbeBitrateMultipliers[kMaxNumProbes] = {3, 6};
+    for (int i = 0; i < kMaxNumProbes; ++i)
+      AddCluster(kProbeBitrateMultipliers[i] * bitrate_bps);
+  }
   std::stringstream bitrate_log;
   bitrate_log << "Start probing for bandwidth, (bitrate:packets): ";
-  for (int i = 0; i < kMaxNumProbes; ++i) {
-    ProbeCluster cluster;
-    // We need one extra to get 5 deltas for the first probe, therefore (i == 0)
-    cluster.max_probe_packets = kPacketsPerProbe + (i == 0 ? 1 : 0);
-    cluster.probe_bitrate_bps = kProbeBitrateMultipliers[i] * bitrate_bps;
-    cluster.id = next_cluster_id_++;
-
-    bitrate_log << "(" << cluster.probe_bitrate_bps << ":"
-                << cluster.max_probe_packets << ") ";
-
-    clusters_.push(cluster);
+  std::queue<ProbeCluster> clusters = clusters_;
+  while (!clusters.empty()) {
+    bitrate_log << "(" << clusters.front().probe_bitrate_bps << ":"
+                << clusters.front().max_probe_packets << ") ";
+    clusters.pop();
   }
   LOG(LS_INFO) << bitrate_log.str().c_str();
   // Set last send time to current time so TimeUntilNextProbe doesn't short
@@ -87,6 +89,26 @@ void BitrateProber::OnIncomingPacket(uint32_t bitrate_bps,
   probing_state_ = kProbing;
 }
 
+void BitrateProber::CreateProbeCluster(int bitrate_bps) {
+  if (probing_state_ == kDisabled)
+    return;
+  if (probing_state_ == kWait) {
+    // Whatever is left of earlier clusters was given up on.
+    clusters_ = std::queue<ProbeCluster>();
+    probing_state_ = kAllowedToProbe;
+  }
+  AddCluster(bitrate_bps);
+}
+
+void BitrateProber::AddCluster(int bitrate_bps) {
+  ProbeCluster cluster;
+  // We need one extra packet to get all the deltas for the first cluster.
+  cluster.max_probe_packets = kPacketsPerProbe + (clusters_.empty() ? 1 : 0);
+  cluster.probe_bitrate_bps = bitrate_bps;
+  cluster.id = next_cluster_id_++;
+  clusters_.push(cluster);
+}
+
 int BitrateProber::TimeUntilNextProbe(int64_t now_ms) {
   if (probing_state_ != kDisabled && clusters_.empty()) {
     probing_state_ = kWait;
@@ -39,6 +39,12 @@ class BitrateProber {
                         size_t packet_size,
                         int64_t now_ms);
 
+  // Requests a probe at |bitrate_bps|, e.g. when more bitrate has been
+  // allocated than the current estimate, so that the estimate can ramp up to
+  // it without waiting for it to grow. The probe is sent once large enough
+  // packets are available.
+  void CreateProbeCluster(int bitrate_bps);
+
   // Returns the number of milliseconds until the next packet should be sent to
   // get accurate probing.
   int TimeUntilNextProbe(int64_t now_ms);
@@ -64,6 +70,8 @@ class BitrateProber {
     int id = -1;
   };
 
+  void AddCluster(int bitrate_bps);
+
   ProbingState probing_state_;
   // Probe bitrate per packet. These are used to compute the delta relative to
   // the previous probe packet based on the size and time when that packet was
@@ -91,4 +91,36 @@ TEST(BitrateProberTest, DoesntInitializeProbingForSmallPackets) {
   EXPECT_FALSE(prober.IsProbing());
 }
 
+TEST(BitrateProberTest, ProbesRequestedClusterAfterInitialProbing) {
+  BitrateProber prober;
+  int64_t now_ms = 0;
+  // Probes aren't requested before probing is enabled.
+  prober.CreateProbeCluster(900000);
+  prober.SetEnabled(true);
+  prober.OnIncomingPacket(300000, 1000, now_ms);
+  EXPECT_EQ(0, prober.TimeUntilNextProbe(now_ms));
+  prober.PacketSent(now_ms, 1000);
+  // Give up on the initial probing, as no packets arrive in time.
+  now_ms += 100;
+  EXPECT_EQ(0, prober.TimeUntilNextProbe(now_ms));
+  EXPECT_FALSE(prober.IsProbing());
+
+  prober.CreateProbeCluster(1000000);
+  EXPECT_FALSE(prober.IsProbing());
+  prober.OnIncomingPacket(300000, 1000, now_ms);
+  EXPECT_TRUE(prober.IsProbing());
+  EXPECT_EQ(2, prober.CurrentClusterId());
+
+  for (int i = 0; i < 6; ++i) {
+    // 1000 bytes at 1 Mbps.
+    EXPECT_EQ(8, prober.TimeUntilNextProbe(now_ms));
+    now_ms += 8;
+    EXPECT_EQ(0, prober.TimeUntilNextProbe(now_ms));
+    EXPECT_EQ(2, prober.CurrentClusterId());
+    prober.PacketSent(now_ms, 1000);
+  }
+  EXPECT_EQ(-1, prober.TimeUntilNextProbe(now_ms));
+  EXPECT_FALSE(prober.IsProbing());
+}
+
 }  // namespace webrtc
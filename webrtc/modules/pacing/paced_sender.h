@@ -93,7 +93,8 @@ class PacedSender : public Module, public RtpPacketSender {
   // |allocated_bitrate| might be higher that the estimated available network
   // bitrate and if so, the pacer will send with |allocated_bitrate|.
   // Padding packets will be utilized to reach |padding_bitrate| unless enough
-  // media packets are available.
+  // media packets are available. If probing is enabled, an increase beyond the
+  // estimate is probed for, so that the estimate can ramp up quickly.
   void SetAllocatedSendBitrate(int allocated_bitrate_bps,
                                int padding_bitrate_bps);
 
@@ -156,6 +157,8 @@ class PacedSender : public Module, public RtpPacketSender {
   // order to meet pace time constraint).
   uint32_t estimated_bitrate_bps_ GUARDED_BY(critsect_);
   uint32_t min_send_bitrate_kbps_ GUARDED_BY(critsect_);
+  // The larger of the allocated and padding bitrates last set.
+  int allocation_limit_bps_ GUARDED_BY(critsect_);
   uint32_t pacing_bitrate_kbps_ GUARDED_BY(critsect_);
 
   int64_t time_last_update_us_ GUARDED_BY(critsect_);
@@ -0,0 +1,270 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/pacing/packet_queue.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace paced_sender {
+namespace {
+const uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+// Number of packets stored per allocated block.
+const size_t kEntriesPerBlock = 256;
+
+// Minimum size of the duplicate index, must be a power of two.
+const size_t kMinDupeSetSize = 64;
+
+// Used by the heap to sort packets.
+bool HasLowerPriority(const Packet& first, const Packet& second) {
+  // Highest prio = 0.
+  if (first.priority != second.priority)
+    return first.priority > second.priority;
+
+  // Retransmissions go first.
+  if (second.retransmission && !first.retransmission)
+    return true;
+
+  // Older frames have higher prio.
+  if (first.capture_time_ms != second.capture_time_ms)
+    return first.capture_time_ms > second.capture_time_ms;
+
+  return first.enqueue_order > second.enqueue_order;
+}
+}  // namespace
+
+struct PacketQueue::Entry {
+  Entry()
+      : packet(RtpPacketSender::kNormalPriority, 0, 0, 0, 0, 0, false, 0),
+        prev(kInvalidIndex),
+        next(kInvalidIndex) {}
+
+  Packet packet;
+  // Neighbors in enqueue order, or the next free entry for unused entries.
+  uint32_t prev;
+  uint32_t next;
+};
+
+class PacketQueue::HeapComparator {
+ public:
+  explicit HeapComparator(const PacketQueue* queue) : queue_(queue) {}
+
+  bool operator()(uint32_t first, uint32_t second) const {
+    return HasLowerPriority(queue_->GetEntry(first).packet,
+                            queue_->GetEntry(second).packet);
+  }
+
+ private:
+  const PacketQueue* const queue_;
+};
+
+PacketQueue::PacketQueue(Clock* clock)
+    : free_head_(kInvalidIndex),
+      oldest_(kInvalidIndex),
+      newest_(kInvalidIndex),
+      size_(0),
+      bytes_(0),
+      clock_(clock),
+      queue_time_sum_(0),
+      time_last_updated_(clock_->TimeInMilliseconds()) {}
+
+PacketQueue::~PacketQueue() {}
+
+void PacketQueue::Push(const Packet& packet) {
+  if (2 * (size_ + 1) > dupe_set_.size())
+    RebuildDupeSet(2 * (size_ + 1));
+
+  uint32_t index = AllocateEntry();
+  Entry& entry = GetEntry(index);
+  entry.packet = packet;
+  entry.packet.index = index;
+  if (!AddToDupeSet(index)) {
+    FreeEntry(index);
+    return;
+  }
+
+  UpdateQueueTime(packet.enqueue_time_ms);
+
+  // Append to the enqueue order.
+  entry.prev = newest_;
+  entry.next = kInvalidIndex;
+  if (newest_ != kInvalidIndex) {
+    GetEntry(newest_).next = index;
+  } else {
+    oldest_ = index;
+  }
+  newest_ = index;
+  ++size_;
+
+  heap_.push_back(index);
+  std::push_heap(heap_.begin(), heap_.end(), HeapComparator(this));
+  bytes_ += packet.bytes;
+}
+
+const Packet& PacketQueue::BeginPop() {
+  RTC_DCHECK(!heap_.empty());
+  std::pop_heap(heap_.begin(), heap_.end(), HeapComparator(this));
+  uint32_t index = heap_.back();
+  heap_.pop_back();
+  return GetEntry(index).packet;
+}
+
+void PacketQueue::CancelPop(const Packet& packet) {
+  heap_.push_back(packet.index);
+  std::push_heap(heap_.begin(), heap_.end(), HeapComparator(this));
+}
+
+void PacketQueue::FinalizePop(const Packet& packet) {
+  uint32_t index = packet.index;
+  RemoveFromDupeSet(index);
+  bytes_ -= packet.bytes;
+  queue_time_sum_ -= (time_last_updated_ - packet.enqueue_time_ms);
+
+  // Unlink from the enqueue order.
+  Entry& entry = GetEntry(index);
+  if (entry.prev != kInvalidIndex) {
+    GetEntry(entry.prev).next = entry.next;
+  } else {
+    oldest_ = entry.next;
+  }
+  if (entry.next != kInvalidIndex) {
+    GetEntry(entry.next).prev = entry.prev;
+  } else {
+    newest_ = entry.prev;
+  }
+  --size_;
+  FreeEntry(index);
+
+  RTC_DCHECK_EQ(size_, heap_.size());
+  if (size_ == 0)
+    RTC_DCHECK_EQ(0u, queue_time_sum_);
+}
+
+int64_t PacketQueue::OldestEnqueueTimeMs() const {
+  if (oldest_ == kInvalidIndex)
+    return 0;
+  return GetEntry(oldest_).packet.enqueue_time_ms;
+}
+
+void PacketQueue::UpdateQueueTime(int64_t timestamp_ms) {
+  RTC_DCHECK_GE(timestamp_ms, time_last_updated_);
+  int64_t delta = timestamp_ms - time_last_updated_;
+  // Use size_, not heap_.size() here, as there might be an outstanding element
+  // popped from heap_ currently in the SendPacket() call, while size_ will
+  // always be correct.
+  queue_time_sum_ += delta * size_;
+  time_last_updated_ = timestamp_ms;
+}
+
+int64_t PacketQueue::AverageQueueTimeMs() const {
+  if (heap_.empty())
+    return 0;
+  return queue_time_sum_ / size_;
+}
+
+PacketQueue::Entry& PacketQueue::GetEntry(uint32_t index) {
+  return blocks_[index / kEntriesPerBlock][index % kEntriesPerBlock];
+}
+
+const PacketQueue::Entry& PacketQueue::GetEntry(uint32_t index) const {
+  return blocks_[index / kEntriesPerBlock][index % kEntriesPerBlock];
+}
+
+uint32_t PacketQueue::AllocateEntry() {
+  if (free_head_ == kInvalidIndex) {
+    // All entries are in use, add another block. Existing entries don't move.
+    uint32_t first = static_cast<uint32_t>(blocks_.size() * kEntriesPerBlock);
+    blocks_.push_back(std::unique_ptr<Entry[]>(new Entry[kEntriesPerBlock]));
+    for (size_t i = kEntriesPerBlock; i > 0; --i)
+      FreeEntry(first + static_cast<uint32_t>(i - 1));
+    heap_.reserve(blocks_.size() * kEntriesPerBlock);
+  }
+  uint32_t index = free_head_;
+  free_head_ = GetEntry(index).next;
+  return index;
+}
+
+void PacketQueue::FreeEntry(uint32_t index) {
+  Entry& entry = GetEntry(index);
+  entry.prev = kInvalidIndex;
+  entry.next = free_head_;
+  free_head_ = index;
+}
+
+size_t PacketQueue::DupeSlot(uint32_t ssrc, uint16_t sequence_number) const {
+  uint32_t hash = ssrc * 0x9E3779B1u + sequence_number;
+  hash ^= hash >> 15;
+  hash *= 0x85EBCA6Bu;
+  hash ^= hash >> 13;
+  return hash & (dupe_set_.size() - 1);
+}
+
+bool PacketQueue::AddToDupeSet(uint32_t index) {
+  RTC_DCHECK_LT(2 * size_, dupe_set_.size());
+  const Packet& packet = GetEntry(index).packet;
+  const size_t mask = dupe_set_.size() - 1;
+  size_t slot = DupeSlot(packet.ssrc, packet.sequence_number);
+  while (dupe_set_[slot] != kInvalidIndex) {
+    const Packet& other = GetEntry(dupe_set_[slot]).packet;
+    if (other.ssrc == packet.ssrc &&
+        other.sequence_number == packet.sequence_number) {
+      return false;
+    }
+    slot = (slot + 1) & mask;
+  }
+  dupe_set_[slot] = index;
+  return true;
+}
+
+void PacketQueue::RemoveFromDupeSet(uint32_t index) {
+  const Packet& packet = GetEntry(index).packet;
+  const size_t mask = dupe_set_.size() - 1;
+  size_t hole = DupeSlot(packet.ssrc, packet.sequence_number);
+  while (dupe_set_[hole] != index) {
+    RTC_DCHECK_NE(kInvalidIndex, dupe_set_[hole]);
+    hole = (hole + 1) & mask;
+  }
+
+  // Shift following entries of the probe sequence back into the hole, so that
+  // lookups don't need tombstones.
+  size_t slot = hole;
+  while (true) {
+    slot = (slot + 1) & mask;
+    if (dupe_set_[slot] == kInvalidIndex)
+      break;
+    const Packet& other = GetEntry(dupe_set_[slot]).packet;
+    size_t home = DupeSlot(other.ssrc, other.sequence_number);
+    if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+      dupe_set_[hole] = dupe_set_[slot];
+      hole = slot;
+    }
+  }
+  dupe_set_[hole] = kInvalidIndex;
+}
+
+void PacketQueue::RebuildDupeSet(size_t size) {
+  size_t new_size = std::max(kMinDupeSetSize, dupe_set_.size());
+  while (new_size < size)
+    new_size *= 2;
+  dupe_set_.assign(new_size, kInvalidIndex);
+  for (uint32_t index = oldest_; index != kInvalidIndex;
+       index = GetEntry(index).next) {
+    bool inserted = AddToDupeSet(index);
+    RTC_DCHECK(inserted);
+  }
+}
+
+}  // namespace paced_sender
+}  // namespace webrtc
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_PACING_PACKET_QUEUE_H_
+#define WEBRTC_MODULES_PACING_PACKET_QUEUE_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+class Clock;
+
+namespace paced_sender {
+
+struct Packet {
+  Packet(RtpPacketSender::Priority priority,
+         uint32_t ssrc,
+         uint16_t seq_number,
+         int64_t capture_time_ms,
+         int64_t enqueue_time_ms,
+         size_t length_in_bytes,
+         bool retransmission,
+         uint64_t enqueue_order)
+      : priority(priority),
+        ssrc(ssrc),
+        sequence_number(seq_number),
+        capture_time_ms(capture_time_ms),
+        enqueue_time_ms(enqueue_time_ms),
+        bytes(length_in_bytes),
+        retransmission(retransmission),
+        enqueue_order(enqueue_order),
+        index(0) {}
+
+  RtpPacketSender::Priority priority;
+  uint32_t ssrc;
+  uint16_t sequence_number;
+  int64_t capture_time_ms;
+  int64_t enqueue_time_ms;
+  size_t bytes;
+  bool retransmission;
+  uint64_t enqueue_order;
+  // Slot of the packet in the PacketQueue storage.
+  uint32_t index;
+};
+
+// Priority queue of the packets waiting to be sent by the PacedSender.
+// Packets are popped highest priority first, then retransmissions, then
+// oldest capture time, then in enqueue order, and duplicates (same ssrc and
+// sequence number) of queued packets are dropped.
+//
+// Packet storage, the heap, the enqueue order and the duplicate index all
+// live in flat arrays that are reused, so memory is only allocated when the
+// queue grows beyond its largest size so far. Storage is allocated in blocks,
+// so references to queued packets stay valid while packets are pushed.
+class PacketQueue {
+ public:
+  explicit PacketQueue(Clock* clock);
+  ~PacketQueue();
+
+  void Push(const Packet& packet);
+
+  // Removes the next packet from the heap while keeping it stored, so it can
+  // be reinserted with CancelPop() if it couldn't be sent. Only one packet may
+  // be popped at a time, and it must be passed to either CancelPop() or
+  // FinalizePop() before popping another packet.
+  const Packet& BeginPop();
+  void CancelPop(const Packet& packet);
+  void FinalizePop(const Packet& packet);
+
+  bool Empty() const { return heap_.empty(); }
+
+  size_t SizeInPackets() const { return heap_.size(); }
+
+  uint64_t SizeInBytes() const { return bytes_; }
+
+  int64_t OldestEnqueueTimeMs() const;
+
+  void UpdateQueueTime(int64_t timestamp_ms);
+
+  int64_t AverageQueueTimeMs() const;
+
+ private:
+  struct Entry;
+  class HeapComparator;
+
+  Entry& GetEntry(uint32_t index);
+  const Entry& GetEntry(uint32_t index) const;
+
+  uint32_t AllocateEntry();
+  void FreeEntry(uint32_t index);
+
+  // Try to add a packet to the set of ssrc/seqno identifiers currently in the
+  // queue. Return true if inserted, false if this is a duplicate.
+  bool AddToDupeSet(uint32_t index);
+  void RemoveFromDupeSet(uint32_t index);
+  void RebuildDupeSet(size_t size);
+  size_t DupeSlot(uint32_t ssrc, uint16_t sequence_number) const;
+
+  // Packet storage, in blocks of kEntriesPerBlock entries.
+  std::vector<std::unique_ptr<Entry[]>> blocks_;
+  // Head of the list of unused entries.
+  uint32_t free_head_;
+  // Oldest and newest stored packet, the stored packets are linked in the
+  // order they were enqueued.
+  uint32_t oldest_;
+  uint32_t newest_;
+  // Number of stored packets, including a packet currently being popped.
+  size_t size_;
+  // Binary heap of entry indices, sorted according to priority.
+  std::vector<uint32_t> heap_;
+  // Open addressing hash table of entry indices for checking duplicates,
+  // using linear probing. The size is a power of two.
+  std::vector<uint32_t> dupe_set_;
+  // Total number of bytes in the queue.
+  uint64_t bytes_;
+  Clock* const clock_;
+  int64_t queue_time_sum_;
+  int64_t time_last_updated_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PacketQueue);
+};
+
+}  // namespace paced_sender
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_PACING_PACKET_QUEUE_H_
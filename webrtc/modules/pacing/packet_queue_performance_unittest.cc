@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <list>
+#include <map>
+#include <queue>
+#include <set>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/pacing/packet_queue.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace paced_sender {
+namespace {
+const size_t kPacketSize = 1200;
+const int kNumStreams = 16;
+const int kNumRounds = 10;
+
+// The packet queue as implemented before PacketQueue was moved to flat
+// storage, kept as a baseline for the benchmark.
+class ReferencePacketQueue {
+ public:
+  void Push(const Packet& packet) {
+    if (!dupe_map_[packet.ssrc].insert(packet.sequence_number).second)
+      return;
+    packet_list_.push_front(packet);
+    prio_queue_.push(packet_list_.begin());
+  }
+
+  const Packet& BeginPop() {
+    popped_ = prio_queue_.top();
+    prio_queue_.pop();
+    return *popped_;
+  }
+
+  void FinalizePop(const Packet& packet) {
+    SsrcSeqNoMap::iterator it = dupe_map_.find(packet.ssrc);
+    it->second.erase(packet.sequence_number);
+    if (it->second.empty())
+      dupe_map_.erase(it);
+    packet_list_.erase(popped_);
+  }
+
+ private:
+  typedef std::list<Packet>::iterator PacketIterator;
+  struct Comparator {
+    bool operator()(PacketIterator first, PacketIterator second) const {
+      if (first->priority != second->priority)
+        return first->priority > second->priority;
+      if (second->retransmission && !first->retransmission)
+        return true;
+      if (first->capture_time_ms != second->capture_time_ms)
+        return first->capture_time_ms > second->capture_time_ms;
+      return first->enqueue_order > second->enqueue_order;
+    }
+  };
+  typedef std::map<uint32_t, std::set<uint16_t> > SsrcSeqNoMap;
+
+  std::list<Packet> packet_list_;
+  std::priority_queue<PacketIterator, std::vector<PacketIterator>, Comparator>
+      prio_queue_;
+  SsrcSeqNoMap dupe_map_;
+  PacketIterator popped_;
+};
+
+// Fills the queue with |queue_size| packets spread over kNumStreams streams
+// and then drains it, kNumRounds times. Returns the average time in
+// nanoseconds spent per enqueued and dequeued packet.
+template <typename Queue>
+size_t MeasureNsPerPacket(Queue* queue, int queue_size) {
+  const RtpPacketSender::Priority kPriorities[] = {
+      RtpPacketSender::kHighPriority, RtpPacketSender::kNormalPriority,
+      RtpPacketSender::kNormalPriority, RtpPacketSender::kLowPriority};
+  uint64_t enqueue_order = 0;
+  uint16_t sequence_number = 0;
+  uint64_t start_ns = rtc::TimeNanos();
+  for (int round = 0; round < kNumRounds; ++round) {
+    for (int i = 0; i < queue_size; ++i) {
+      queue->Push(Packet(kPriorities[i % 4], 1000 + i % kNumStreams,
+                         sequence_number++, i / kNumStreams, 0, kPacketSize,
+                         i % 10 == 0, enqueue_order++));
+    }
+    for (int i = 0; i < queue_size; ++i)
+      queue->FinalizePop(queue->BeginPop());
+  }
+  uint64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  return static_cast<size_t>(elapsed_ns / (kNumRounds * queue_size));
+}
+
+void RunBenchmark(int queue_size) {
+  SimulatedClock clock(0);
+  PacketQueue queue(&clock);
+  ReferencePacketQueue reference_queue;
+  std::string modifier = "_" + rtc::ToString(queue_size);
+  test::PrintResult("packet_queue_push_pop", modifier, "packet_queue",
+                    MeasureNsPerPacket(&queue, queue_size), "ns", true);
+  test::PrintResult("packet_queue_push_pop", modifier, "reference",
+                    MeasureNsPerPacket(&reference_queue, queue_size), "ns",
+                    false);
+}
+}  // namespace
+
+TEST(PacketQueuePerformanceTest, PushPop1000Packets) {
+  RunBenchmark(1000);
+}
+
+TEST(PacketQueuePerformanceTest, PushPop10000Packets) {
+  RunBenchmark(10000);
+}
+
+TEST(PacketQueuePerformanceTest, PushPop50000Packets) {
+  RunBenchmark(50000);
+}
+
+}  // namespace paced_sender
+}  // namespace webrtc
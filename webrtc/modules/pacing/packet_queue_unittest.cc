@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/modules/pacing/packet_queue.h"
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace paced_sender {
+namespace {
+const uint32_t kSsrc = 12345;
+const size_t kPacketSize = 250;
+}  // namespace
+
+class PacketQueueTest : public ::testing::Test {
+ protected:
+  PacketQueueTest() : clock_(123456), queue_(&clock_), enqueue_order_(0) {}
+
+  void Push(RtpPacketSender::Priority priority,
+            uint32_t ssrc,
+            uint16_t sequence_number,
+            int64_t capture_time_ms,
+            bool retransmission) {
+    queue_.Push(Packet(priority, ssrc, sequence_number, capture_time_ms,
+                       clock_.TimeInMilliseconds(), kPacketSize,
+                       retransmission, enqueue_order_++));
+  }
+
+  uint16_t PopSequenceNumber() {
+    const Packet& packet = queue_.BeginPop();
+    uint16_t sequence_number = packet.sequence_number;
+    queue_.FinalizePop(packet);
+    return sequence_number;
+  }
+
+  SimulatedClock clock_;
+  PacketQueue queue_;
+  uint64_t enqueue_order_;
+};
+
+TEST_F(PacketQueueTest, Empty) {
+  EXPECT_TRUE(queue_.Empty());
+  EXPECT_EQ(0u, queue_.SizeInPackets());
+  EXPECT_EQ(0u, queue_.SizeInBytes());
+  EXPECT_EQ(0, queue_.OldestEnqueueTimeMs());
+  EXPECT_EQ(0, queue_.AverageQueueTimeMs());
+}
+
+TEST_F(PacketQueueTest, DropsDuplicates) {
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 1, 0, false);
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 1, 0, false);
+  Push(RtpPacketSender::kNormalPriority, kSsrc + 1, 1, 0, false);
+  EXPECT_EQ(2u, queue_.SizeInPackets());
+  EXPECT_EQ(2 * kPacketSize, queue_.SizeInBytes());
+
+  // Once sent, the same sequence number may be queued again.
+  EXPECT_EQ(1, PopSequenceNumber());
+  EXPECT_EQ(1, PopSequenceNumber());
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 1, 0, false);
+  EXPECT_EQ(1u, queue_.SizeInPackets());
+}
+
+TEST_F(PacketQueueTest, DropsDuplicatesWhilePopped) {
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 1, 0, false);
+  const Packet& packet = queue_.BeginPop();
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 1, 0, false);
+  EXPECT_TRUE(queue_.Empty());
+  queue_.CancelPop(packet);
+  EXPECT_EQ(1u, queue_.SizeInPackets());
+}
+
+TEST_F(PacketQueueTest, PopsInPriorityOrder) {
+  Push(RtpPacketSender::kLowPriority, kSsrc, 1, 10, false);
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 2, 20, false);
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 3, 10, false);
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 4, 30, true);
+  Push(RtpPacketSender::kHighPriority, kSsrc, 5, 40, false);
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 6, 10, false);
+
+  EXPECT_EQ(5, PopSequenceNumber());
+  EXPECT_EQ(4, PopSequenceNumber());
+  EXPECT_EQ(3, PopSequenceNumber());
+  EXPECT_EQ(6, PopSequenceNumber());
+  EXPECT_EQ(2, PopSequenceNumber());
+  EXPECT_EQ(1, PopSequenceNumber());
+  EXPECT_TRUE(queue_.Empty());
+}
+
+TEST_F(PacketQueueTest, CancelPopRestoresOrder) {
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 1, 10, false);
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 2, 20, false);
+
+  const Packet& packet = queue_.BeginPop();
+  EXPECT_EQ(1, packet.sequence_number);
+  EXPECT_EQ(1u, queue_.SizeInPackets());
+  // Packets pushed while one is popped must not invalidate it.
+  for (uint16_t i = 0; i < 1000; ++i)
+    Push(RtpPacketSender::kLowPriority, kSsrc + 1, i, 30, false);
+  EXPECT_EQ(1, packet.sequence_number);
+  queue_.CancelPop(packet);
+
+  EXPECT_EQ(1, PopSequenceNumber());
+  EXPECT_EQ(2, PopSequenceNumber());
+  EXPECT_EQ(1000u, queue_.SizeInPackets());
+}
+
+TEST_F(PacketQueueTest, OldestEnqueueTime) {
+  int64_t first_enqueue_time_ms = clock_.TimeInMilliseconds();
+  Push(RtpPacketSender::kLowPriority, kSsrc, 1, 10, false);
+  clock_.AdvanceTimeMilliseconds(10);
+  Push(RtpPacketSender::kHighPriority, kSsrc, 2, 20, false);
+  EXPECT_EQ(first_enqueue_time_ms, queue_.OldestEnqueueTimeMs());
+
+  // The high priority packet is sent first, which leaves the oldest packet.
+  EXPECT_EQ(2, PopSequenceNumber());
+  EXPECT_EQ(first_enqueue_time_ms, queue_.OldestEnqueueTimeMs());
+  EXPECT_EQ(1, PopSequenceNumber());
+  EXPECT_EQ(0, queue_.OldestEnqueueTimeMs());
+}
+
+TEST_F(PacketQueueTest, AverageQueueTime) {
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 1, 10, false);
+  clock_.AdvanceTimeMilliseconds(10);
+  Push(RtpPacketSender::kNormalPriority, kSsrc, 2, 10, false);
+  clock_.AdvanceTimeMilliseconds(10);
+  queue_.UpdateQueueTime(clock_.TimeInMilliseconds());
+  // Queued for 20 ms and 10 ms.
+  EXPECT_EQ(15, queue_.AverageQueueTimeMs());
+
+  EXPECT_EQ(1, PopSequenceNumber());
+  EXPECT_EQ(10, queue_.AverageQueueTimeMs());
+  EXPECT_EQ(2, PopSequenceNumber());
+  EXPECT_EQ(0, queue_.AverageQueueTimeMs());
+}
+
+TEST_F(PacketQueueTest, ManyPackets) {
+  const uint16_t kNumPackets = 20000;
+  const uint32_t kNumStreams = 8;
+  for (int round = 0; round < 2; ++round) {
+    for (uint16_t i = 0; i < kNumPackets; ++i) {
+      Push(RtpPacketSender::kNormalPriority, kSsrc + i % kNumStreams, i, 10,
+           false);
+    }
+    EXPECT_EQ(kNumPackets, queue_.SizeInPackets());
+    EXPECT_EQ(kNumPackets * kPacketSize, queue_.SizeInBytes());
+    for (uint16_t i = 0; i < kNumPackets; ++i)
+      EXPECT_EQ(i, PopSequenceNumber());
+    EXPECT_TRUE(queue_.Empty());
+    EXPECT_EQ(0u, queue_.SizeInBytes());
+  }
+}
+
+}  // namespace paced_sender
+}  // namespace webrtc
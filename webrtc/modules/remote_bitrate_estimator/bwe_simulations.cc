@@ -13,6 +13,7 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
+#include "webrtc/modules/remote_bitrate_estimator/test/bwe_scenario_runner.h"
 #include "webrtc/modules/remote_bitrate_estimator/test/bwe_test.h"
 #include "webrtc/modules/remote_bitrate_estimator/test/packet_receiver.h"
 #include "webrtc/modules/remote_bitrate_estimator/test/packet_sender.h"
@@ -445,6 +446,58 @@ TEST_P(BweSimulation, GccComparisonChoke) {
   gcc_test.RunChoke(kFullSendSideEstimator, capacities_kbps);
 }
 
+// Runs every estimator over every network trace, one scenario per core, and
+// prints the metrics of each run and the average per estimator as CSV.
+TEST(BweSimulationSweep, AllTracesInParallel) {
+  const char* kTraces[] = {
+      "att-downlink",       "att-uplink",          "google-wifi-3mbps",
+      "sprint-downlink",    "sprint-uplink",       "synthetic-trace",
+      "tmobile-downlink",   "tmobile-uplink",      "verizon3g-downlink",
+      "verizon3g-uplink",   "verizon4g-downlink",  "verizon4g-uplink"};
+  const BandwidthEstimatorType kEstimators[] = {
+      kRembEstimator, kFullSendSideEstimator, kNadaEstimator};
+
+  BweScenarioRunner runner(0);
+  for (BandwidthEstimatorType estimator : kEstimators) {
+    for (const char* trace : kTraces) {
+      std::string trace_file = test::ResourcePath(trace, "rx");
+      runner.AddScenario(
+          bwe_names[estimator] + "_" + trace,
+          [estimator, trace_file](BweScenario* scenario,
+                                  BweScenarioResult* result) {
+            AdaptiveVideoSource source(0, 30, 300, 0, 0);
+            VideoSender sender(scenario->uplink(), &source, estimator);
+            TraceBasedDeliveryFilter filter(scenario->uplink(), 0,
+                                            "link_capacity");
+            filter.set_max_delay_ms(500);
+            RateCounterFilter counter(scenario->uplink(), 0, "Receiver",
+                                      bwe_names[estimator]);
+            PacketReceiver receiver(scenario->uplink(), 0, estimator, false,
+                                    false);
+            if (!filter.Init(trace_file))
+              return false;
+            scenario->RunFor(60 * 1000);
+            MeasureFlow(counter, &receiver, result);
+            return true;
+          });
+    }
+  }
+  std::vector<BweScenarioResult> results = runner.Run();
+  for (const BweScenarioResult& result : results)
+    EXPECT_TRUE(result.completed) << result.name;
+
+  std::vector<BweScenarioResult> aggregates;
+  const size_t kNumTraces = sizeof(kTraces) / sizeof(kTraces[0]);
+  for (size_t i = 0; i < results.size(); i += kNumTraces) {
+    std::vector<BweScenarioResult> per_estimator(
+        results.begin() + i, results.begin() + i + kNumTraces);
+    aggregates.push_back(BweScenarioRunner::Aggregate(
+        bwe_names[kEstimators[i / kNumTraces]] + "_all", per_estimator));
+  }
+  BweScenarioRunner::WriteCsv(results, stdout);
+  BweScenarioRunner::WriteCsv(aggregates, stdout);
+}
+
 #endif  // BWE_TEST_LOGGING_COMPILE_TIME_ENABLE
 }  // namespace bwe
 }  // namespace testing
@@ -11,10 +11,11 @@
 #ifndef WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_INCLUDE_SEND_TIME_HISTORY_H_
 #define WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_INCLUDE_SEND_TIME_HISTORY_H_
 
-#include <map>
+#include <deque>
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/basictypes.h"
+#include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
 
 namespace webrtc {
@@ -34,12 +35,20 @@ class SendTimeHistory {
 
  private:
   void EraseOld();
-  void UpdateOldestSequenceNumber();
+  // Returns the packet with |sequence_number|, or nullptr if it isn't in the
+  // history.
+  PacketInfo* Find(uint16_t sequence_number);
 
   Clock* const clock_;
   const int64_t packet_age_limit_;
-  uint16_t oldest_sequence_number_;  // Oldest may not be lowest.
-  std::map<uint16_t, PacketInfo> history_;
+  SequenceNumberUnwrapper seq_num_unwrapper_;
+  // The unwrapped sequence number of history_.front().
+  int64_t first_sequence_number_;
+  // One entry per sequence number from |first_sequence_number_| on, so that a
+  // packet is found by its offset rather than by a search. Removed packets and
+  // sequence numbers that weren't added are kept as empty entries until they
+  // reach the front.
+  std::deque<PacketInfo> history_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(SendTimeHistory);
 };
@@ -33,7 +33,9 @@ enum {
   kInitialProbingIntervalMs = 2000,
   kMinClusterSize = 4,
   kMaxProbePackets = 15,
-  kExpectedNumberOfProbes = 3
+  kExpectedNumberOfProbes = 3,
+  // Bounds the probes kept while clusters are being looked for.
+  kMaxBufferedProbes = 100
 };
 
 static const double kTimestampToMs = 1000.0 /
@@ -70,7 +72,7 @@ bool RemoteBitrateEstimatorAbsSendTime::IsWithinClusterBounds(
   }
 
   void RemoteBitrateEstimatorAbsSendTime::AddCluster(
-      std::list<Cluster>* clusters,
+      std::vector<Cluster>* clusters,
       Cluster* cluster) {
     cluster->send_mean_ms /= static_cast<float>(cluster->count);
     cluster->recv_mean_ms /= static_cast<float>(cluster->count);
@@ -94,43 +96,57 @@ bool RemoteBitrateEstimatorAbsSendTime::IsWithinClusterBounds(
     network_thread_.DetachFromThread();
 }
 
-void RemoteBitrateEstimatorAbsSendTime::ComputeClusters(
-    std::list<Cluster>* clusters) const {
-  Cluster current;
-  int64_t prev_send_time = -1;
-  int64_t prev_recv_time = -1;
-  for (std::list<Probe>::const_iterator it = probes_.begin();
-       it != probes_.end();
-       ++it) {
-    if (prev_send_time >= 0) {
-      int send_delta_ms = it->send_time_ms - prev_send_time;
-      int recv_delta_ms = it->recv_time_ms - prev_recv_time;
-      if (send_delta_ms >= 1 && recv_delta_ms >= 1) {
-        ++current.num_above_min_delta;
-      }
-      if (!IsWithinClusterBounds(send_delta_ms, current)) {
-        if (current.count >= kMinClusterSize)
-          AddCluster(clusters, &current);
-        current = Cluster();
-      }
-      current.send_mean_ms += send_delta_ms;
-      current.recv_mean_ms += recv_delta_ms;
-      current.mean_size += it->payload_size;
-      ++current.count;
-    }
-    prev_send_time = it->send_time_ms;
-    prev_recv_time = it->recv_time_ms;
+void RemoteBitrateEstimatorAbsSendTime::AddProbe(const Probe& probe) {
+  if (!probes_.empty())
+    AddProbeToClusters(probes_.back(), probe);
+  probes_.push_back(probe);
+  if (probes_.size() > kMaxBufferedProbes) {
+    probes_.pop_front();
+    RebuildClusters();
   }
-  if (current.count >= kMinClusterSize)
+}
+
+void RemoteBitrateEstimatorAbsSendTime::AddProbeToClusters(
+    const Probe& prev_probe,
+    const Probe& probe) {
+  int send_delta_ms = probe.send_time_ms - prev_probe.send_time_ms;
+  int recv_delta_ms = probe.recv_time_ms - prev_probe.recv_time_ms;
+  if (send_delta_ms >= 1 && recv_delta_ms >= 1) {
+    ++current_cluster_.num_above_min_delta;
+  }
+  if (!IsWithinClusterBounds(send_delta_ms, current_cluster_)) {
+    if (current_cluster_.count >= kMinClusterSize)
+      AddCluster(&clusters_, &current_cluster_);
+    current_cluster_ = Cluster();
+  }
+  current_cluster_.send_mean_ms += send_delta_ms;
+  current_cluster_.recv_mean_ms += recv_delta_ms;
+  current_cluster_.mean_size += probe.payload_size;
+  ++current_cluster_.count;
+}
+
+void RemoteBitrateEstimatorAbsSendTime::RebuildClusters() {
+  clusters_.clear();
+  current_cluster_ = Cluster();
+  for (size_t i = 1; i < probes_.size(); ++i)
+    AddProbeToClusters(probes_[i - 1], probes_[i]);
+}
+
+void RemoteBitrateEstimatorAbsSendTime::ComputeClusters(
+    std::vector<Cluster>* clusters) const {
+  *clusters = clusters_;
+  if (current_cluster_.count >= kMinClusterSize) {
+    Cluster current = current_cluster_;
     AddCluster(clusters, &current);
+  }
 }
 
-std::list<Cluster>::const_iterator
+std::vector<Cluster>::const_iterator
 RemoteBitrateEstimatorAbsSendTime::FindBestProbe(
-    const std::list<Cluster>& clusters) const {
+    const std::vector<Cluster>& clusters) const {
   int highest_probe_bitrate_bps = 0;
-  std::list<Cluster>::const_iterator best_it = clusters.end();
-  for (std::list<Cluster>::const_iterator it = clusters.begin();
+  std::vector<Cluster>::const_iterator best_it = clusters.end();
+  for (std::vector<Cluster>::const_iterator it = clusters.begin();
        it != clusters.end();
        ++it) {
     if (it->send_mean_ms == 0 || it->recv_mean_ms == 0)
@@ -160,17 +176,19 @@ RemoteBitrateEstimatorAbsSendTime::FindBestProbe(
 
 RemoteBitrateEstimatorAbsSendTime::ProbeResult
 RemoteBitrateEstimatorAbsSendTime::ProcessClusters(int64_t now_ms) {
-  std::list<Cluster> clusters;
+  std::vector<Cluster> clusters;
   ComputeClusters(&clusters);
   if (clusters.empty()) {
     // If we reach the max number of probe packets and still have no clusters,
     // we will remove the oldest one.
-    if (probes_.size() >= kMaxProbePackets)
+    if (probes_.size() >= kMaxProbePackets) {
       probes_.pop_front();
+      RebuildClusters();
+    }
     return ProbeResult::kNoUpdate;
   }
 
-  std::list<Cluster>::const_iterator best_it = FindBestProbe(clusters);
+  std::vector<Cluster>::const_iterator best_it = FindBestProbe(clusters);
   if (best_it != clusters.end()) {
     int probe_bitrate_bps =
         std::min(best_it->GetSendBitrateBps(), best_it->GetRecvBitrateBps());
@@ -190,8 +208,10 @@ RemoteBitrateEstimatorAbsSendTime::ProcessClusters(int64_t now_ms) {
 
   // Not probing and received non-probe packet, or finished with current set
   // of probes.
-  if (clusters.size() >= kExpectedNumberOfProbes)
+  if (clusters.size() >= kExpectedNumberOfProbes) {
     probes_.clear();
+    RebuildClusters();
+  }
   return ProbeResult::kNoUpdate;
 }
 
@@ -207,11 +227,26 @@ bool RemoteBitrateEstimatorAbsSendTime::IsBitrateImproving(
 void RemoteBitrateEstimatorAbsSendTime::IncomingPacketFeedbackVector(
     const std::vector<PacketInfo>& packet_feedback_vector) {
   RTC_DCHECK(network_thread_.CalledOnValidThread());
-  for (const auto& packet_info : packet_feedback_vector) {
-    IncomingPacketInfo(packet_info.arrival_time_ms,
-                       ConvertMsTo24Bits(packet_info.send_time_ms),
-                       packet_info.payload_size, 0, packet_info.was_paced);
+  // Take the lock once for the whole batch, and only report the estimate
+  // the batch ends up with.
+  bool update_estimate = false;
+  uint32_t target_bitrate_bps = 0;
+  std::vector<uint32_t> ssrcs;
+  {
+    rtc::CritScope lock(&crit_);
+    for (const auto& packet_info : packet_feedback_vector) {
+      if (IncomingPacketInfo(packet_info.arrival_time_ms,
+                             ConvertMsTo24Bits(packet_info.send_time_ms),
+                             packet_info.payload_size, 0,
+                             packet_info.was_paced, &target_bitrate_bps)) {
+        update_estimate = true;
+      }
+    }
+    if (update_estimate)
+      ssrcs = Keys(ssrcs_);
   }
+  if (update_estimate)
+    observer_->OnReceiveBitrateChanged(ssrcs, target_bitrate_bps);
 }
 
 void RemoteBitrateEstimatorAbsSendTime::IncomingPacket(int64_t arrival_time_ms,
@@ -224,16 +259,29 @@ void RemoteBitrateEstimatorAbsSendTime::IncomingPacket(int64_t arrival_time_ms,
                        "is missing absolute send time extension!";
     return;
   }
-  IncomingPacketInfo(arrival_time_ms, header.extension.absoluteSendTime,
-                     payload_size, header.ssrc, was_paced);
+  bool update_estimate;
+  uint32_t target_bitrate_bps = 0;
+  std::vector<uint32_t> ssrcs;
+  {
+    rtc::CritScope lock(&crit_);
+    update_estimate =
+        IncomingPacketInfo(arrival_time_ms, header.extension.absoluteSendTime,
+                           payload_size, header.ssrc, was_paced,
+                           &target_bitrate_bps);
+    if (update_estimate)
+      ssrcs = Keys(ssrcs_);
+  }
+  if (update_estimate)
+    observer_->OnReceiveBitrateChanged(ssrcs, target_bitrate_bps);
 }
 
-void RemoteBitrateEstimatorAbsSendTime::IncomingPacketInfo(
+bool RemoteBitrateEstimatorAbsSendTime::IncomingPacketInfo(
     int64_t arrival_time_ms,
     uint32_t send_time_24bits,
     size_t payload_size,
     uint32_t ssrc,
-    bool was_paced) {
+    bool was_paced,
+    uint32_t* target_bitrate_bps) {
   assert(send_time_24bits < (1ul << 24));
   // Shift up send time to use the full 32 bits that inter_arrival works with,
   // so wrapping works properly.
@@ -256,77 +304,70 @@ void RemoteBitrateEstimatorAbsSendTime::IncomingPacketInfo(
   // larger than 200 bytes are paced by the sender.
   was_paced = was_paced && payload_size > PacedSender::kMinProbePacketSize;
   bool update_estimate = false;
-  uint32_t target_bitrate_bps = 0;
-  std::vector<uint32_t> ssrcs;
-  {
-    rtc::CritScope lock(&crit_);
-
-    TimeoutStreams(now_ms);
-    RTC_DCHECK(inter_arrival_.get());
-    RTC_DCHECK(estimator_.get());
-    ssrcs_[ssrc] = now_ms;
-
-    if (was_paced &&
-        (!remote_rate_.ValidEstimate() ||
-         now_ms - first_packet_time_ms_ < kInitialProbingIntervalMs)) {
-      // TODO(holmer): Use a map instead to get correct order?
-      if (total_probes_received_ < kMaxProbePackets) {
-        int send_delta_ms = -1;
-        int recv_delta_ms = -1;
-        if (!probes_.empty()) {
-          send_delta_ms = send_time_ms - probes_.back().send_time_ms;
-          recv_delta_ms = arrival_time_ms - probes_.back().recv_time_ms;
-        }
-        LOG(LS_INFO) << "Probe packet received: send time=" << send_time_ms
-                     << " ms, recv time=" << arrival_time_ms
-                     << " ms, send delta=" << send_delta_ms
-                     << " ms, recv delta=" << recv_delta_ms << " ms.";
-      }
-      probes_.push_back(Probe(send_time_ms, arrival_time_ms, payload_size));
-      ++total_probes_received_;
-      // Make sure that a probe which updated the bitrate immediately has an
-      // effect by calling the OnReceiveBitrateChanged callback.
-      if (ProcessClusters(now_ms) == ProbeResult::kBitrateUpdated)
-        update_estimate = true;
-    }
-    if (inter_arrival_->ComputeDeltas(timestamp, arrival_time_ms, payload_size,
-                                      &ts_delta, &t_delta, &size_delta)) {
-      double ts_delta_ms = (1000.0 * ts_delta) / (1 << kInterArrivalShift);
-      estimator_->Update(t_delta, ts_delta_ms, size_delta, detector_.State());
-      detector_.Detect(estimator_->offset(), ts_delta_ms,
-                       estimator_->num_of_deltas(), arrival_time_ms);
-    }
 
-    if (!update_estimate) {
-      // Check if it's time for a periodic update or if we should update because
-      // of an over-use.
-      if (last_update_ms_ == -1 ||
-          now_ms - last_update_ms_ > remote_rate_.GetFeedbackInterval()) {
-        update_estimate = true;
-      } else if (detector_.State() == kBwOverusing &&
-                 remote_rate_.TimeToReduceFurther(
-                     now_ms, incoming_bitrate_.Rate(now_ms))) {
-        update_estimate = true;
+  TimeoutStreams(now_ms);
+  RTC_DCHECK(inter_arrival_.get());
+  RTC_DCHECK(estimator_.get());
+  ssrcs_[ssrc] = now_ms;
+
+  if (was_paced &&
+      (!remote_rate_.ValidEstimate() ||
+       now_ms - first_packet_time_ms_ < kInitialProbingIntervalMs)) {
+    // TODO(holmer): Use a map instead to get correct order?
+    if (total_probes_received_ < kMaxProbePackets) {
+      int send_delta_ms = -1;
+      int recv_delta_ms = -1;
+      if (!probes_.empty()) {
+        send_delta_ms = send_time_ms - probes_.back().send_time_ms;
+        recv_delta_ms = arrival_time_ms - probes_.back().recv_time_ms;
       }
+      LOG(LS_INFO) << "Probe packet received: send time=" << send_time_ms
+                   << " ms, recv time=" << arrival_time_ms
+                   << " ms, send delta=" << send_delta_ms
+                   << " ms, recv delta=" << recv_delta_ms << " ms.";
     }
+    AddProbe(Probe(send_time_ms, arrival_time_ms, payload_size));
+    ++total_probes_received_;
+    // Make sure that a probe which updated the bitrate immediately has an
+    // effect by calling the OnReceiveBitrateChanged callback.
+    if (ProcessClusters(now_ms) == ProbeResult::kBitrateUpdated)
+      update_estimate = true;
+  }
+  if (inter_arrival_->ComputeDeltas(timestamp, arrival_time_ms, payload_size,
+                                    &ts_delta, &t_delta, &size_delta)) {
+    double ts_delta_ms = (1000.0 * ts_delta) / (1 << kInterArrivalShift);
+    estimator_->Update(t_delta, ts_delta_ms, size_delta, detector_.State());
+    detector_.Detect(estimator_->offset(), ts_delta_ms,
+                     estimator_->num_of_deltas(), arrival_time_ms);
+  }
 
-    if (update_estimate) {
-      // The first overuse should immediately trigger a new estimate.
-      // We also have to update the estimate immediately if we are overusing
-      // and the target bitrate is too high compared to what we are receiving.
-      const RateControlInput input(detector_.State(),
-                                   incoming_bitrate_.Rate(now_ms),
-                                   estimator_->var_noise());
-      remote_rate_.Update(&input, now_ms);
-      target_bitrate_bps = remote_rate_.UpdateBandwidthEstimate(now_ms);
-      update_estimate = remote_rate_.ValidEstimate();
-      ssrcs = Keys(ssrcs_);
+  if (!update_estimate) {
+    // Check if it's time for a periodic update or if we should update because
+    // of an over-use.
+    if (last_update_ms_ == -1 ||
+        now_ms - last_update_ms_ > remote_rate_.GetFeedbackInterval()) {
+      update_estimate = true;
+    } else if (detector_.State() == kBwOverusing &&
+               remote_rate_.TimeToReduceFurther(
+                   now_ms, incoming_bitrate_.Rate(now_ms))) {
+      update_estimate = true;
     }
   }
+
   if (update_estimate) {
-    last_update_ms_ = now_ms;
-    observer_->OnReceiveBitrateChanged(ssrcs, target_bitrate_bps);
+    // The first overuse should immediately trigger a new estimate.
+    // We also have to update the estimate immediately if we are overusing
+    // and the target bitrate is too high compared to what we are receiving.
+    const RateControlInput input(detector_.State(),
+                                 incoming_bitrate_.Rate(now_ms),
+                                 estimator_->var_noise());
+    remote_rate_.Update(&input, now_ms);
+    *target_bitrate_bps = remote_rate_.UpdateBandwidthEstimate(now_ms);
+    update_estimate = remote_rate_.ValidEstimate();
   }
+  if (update_estimate)
+    last_update_ms_ = now_ms;
+  return update_estimate;
 }
 
 void RemoteBitrateEstimatorAbsSendTime::Process() {}
@@ -11,7 +11,7 @@
 #ifndef WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_BITRATE_ESTIMATOR_ABS_SEND_TIME_H_
 #define WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_BITRATE_ESTIMATOR_ABS_SEND_TIME_H_
 
-#include <list>
+#include <deque>
 #include <map>
 #include <memory>
 #include <vector>
@@ -97,18 +97,27 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
   static bool IsWithinClusterBounds(int send_delta_ms,
                                     const Cluster& cluster_aggregate);
 
-  static void AddCluster(std::list<Cluster>* clusters, Cluster* cluster);
+  static void AddCluster(std::vector<Cluster>* clusters, Cluster* cluster);
 
-  void IncomingPacketInfo(int64_t arrival_time_ms,
+  // Returns true if the observer should be told about a new estimate, which
+  // is then stored in |target_bitrate_bps|.
+  bool IncomingPacketInfo(int64_t arrival_time_ms,
                           uint32_t send_time_24bits,
                           size_t payload_size,
                           uint32_t ssrc,
-                          bool was_paced);
+                          bool was_paced,
+                          uint32_t* target_bitrate_bps)
+      EXCLUSIVE_LOCKS_REQUIRED(&crit_);
+
+  // Appends a probe and extends the clusters with it.
+  void AddProbe(const Probe& probe);
+  void AddProbeToClusters(const Probe& prev_probe, const Probe& probe);
+  void RebuildClusters();
 
-  void ComputeClusters(std::list<Cluster>* clusters) const;
+  void ComputeClusters(std::vector<Cluster>* clusters) const;
 
-  std::list<Cluster>::const_iterator FindBestProbe(
-      const std::list<Cluster>& clusters) const;
+  std::vector<Cluster>::const_iterator FindBestProbe(
+      const std::vector<Cluster>& clusters) const;
 
   // Returns true if a probe which changed the estimate was detected.
   ProbeResult ProcessClusters(int64_t now_ms) EXCLUSIVE_LOCKS_REQUIRED(&crit_);
@@ -126,7 +135,12 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
   RateStatistics incoming_bitrate_;
   std::vector<int> recent_propagation_delta_ms_;
   std::vector<int64_t> recent_update_time_ms_;
-  std::list<Probe> probes_;
+  std::deque<Probe> probes_;
+  // The complete clusters of |probes_|, and the sums of the cluster being
+  // built from the newest probes, so that a new probe doesn't require a
+  // pass over all of them.
+  std::vector<Cluster> clusters_;
+  Cluster current_cluster_;
   size_t total_probes_received_;
   int64_t first_packet_time_ms_;
   int64_t last_update_ms_;
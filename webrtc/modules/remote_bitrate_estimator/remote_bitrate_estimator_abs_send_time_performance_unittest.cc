@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/remote_bitrate_estimator/remote_bitrate_estimator_abs_send_time.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+const size_t kPayloadSize = 1200;
+const int kNumStreams = 16;
+const int kNumPackets = 100000;
+const int kPacketsPerMs = 2;
+const size_t kFeedbackBatchSize = 100;
+
+class NullObserver : public RemoteBitrateObserver {
+ public:
+  void OnReceiveBitrateChanged(const std::vector<uint32_t>& ssrcs,
+                               uint32_t bitrate) override {}
+};
+
+uint32_t AbsSendTime(int64_t time_ms) {
+  return static_cast<uint32_t>(((time_ms << 18) + 500) / 1000) & 0x00FFFFFF;
+}
+
+// Feeds kNumPackets packets spread over kNumStreams streams to the estimator
+// one at a time, as the RTP receive path does, and returns the average time
+// in nanoseconds spent per packet. Paced packets keep probe detection busy.
+size_t MeasureNsPerPacket(bool was_paced) {
+  NullObserver observer;
+  RemoteBitrateEstimatorAbsSendTime estimator(&observer);
+  RTPHeader header;
+  header.extension.hasAbsoluteSendTime = true;
+  uint64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumPackets; ++i) {
+    int64_t now_ms = i / kPacketsPerMs;
+    header.ssrc = 1000 + i % kNumStreams;
+    header.extension.absoluteSendTime = AbsSendTime(now_ms);
+    estimator.IncomingPacket(now_ms, kPayloadSize, header, was_paced);
+  }
+  uint64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  return static_cast<size_t>(elapsed_ns / kNumPackets);
+}
+
+// Same as above, but with the packets arriving in transport feedback batches
+// of kFeedbackBatchSize, as on the send side.
+size_t MeasureNsPerFeedbackPacket() {
+  NullObserver observer;
+  RemoteBitrateEstimatorAbsSendTime estimator(&observer);
+  std::vector<PacketInfo> batch;
+  batch.reserve(kFeedbackBatchSize);
+  uint64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumPackets; ++i) {
+    int64_t now_ms = i / kPacketsPerMs;
+    batch.push_back(PacketInfo(now_ms, now_ms, static_cast<uint16_t>(i),
+                               kPayloadSize, false));
+    if (batch.size() == kFeedbackBatchSize) {
+      estimator.IncomingPacketFeedbackVector(batch);
+      batch.clear();
+    }
+  }
+  uint64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  return static_cast<size_t>(elapsed_ns / kNumPackets);
+}
+}  // namespace
+
+TEST(RemoteBitrateEstimatorAbsSendTimePerformanceTest, IncomingPackets) {
+  test::PrintResult("abs_send_time_incoming_packet", "", "unpaced",
+                    MeasureNsPerPacket(false), "ns", true);
+  test::PrintResult("abs_send_time_incoming_packet", "", "paced",
+                    MeasureNsPerPacket(true), "ns", true);
+}
+
+TEST(RemoteBitrateEstimatorAbsSendTimePerformanceTest, FeedbackVectors) {
+  test::PrintResult("abs_send_time_incoming_packet", "", "feedback_batch",
+                    MeasureNsPerFeedbackPacket(), "ns", true);
+}
+
+}  // namespace webrtc
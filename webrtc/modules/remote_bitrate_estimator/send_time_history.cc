@@ -8,16 +8,23 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-#include <assert.h>
-
 #include "webrtc/modules/remote_bitrate_estimator/include/send_time_history.h"
 
 namespace webrtc {
 
+namespace {
+// The creation time of an empty history entry.
+const int64_t kEmptyEntry = -1;
+
+bool IsEmpty(const PacketInfo& packet) {
+  return packet.creation_time_ms == kEmptyEntry;
+}
+}  // namespace
+
 SendTimeHistory::SendTimeHistory(Clock* clock, int64_t packet_age_limit)
     : clock_(clock),
       packet_age_limit_(packet_age_limit),
-      oldest_sequence_number_(0) {}
+      first_sequence_number_(0) {}
 
 SendTimeHistory::~SendTimeHistory() {
 }
@@ -31,69 +38,69 @@ void SendTimeHistory::AddAndRemoveOld(uint16_t sequence_number,
                                       bool was_paced) {
   EraseOld();
 
+  const int64_t unwrapped = seq_num_unwrapper_.Unwrap(sequence_number);
+  const PacketInfo packet(clock_->TimeInMilliseconds(), 0, -1, sequence_number,
+                          length, was_paced);
+  const PacketInfo empty(kEmptyEntry, 0, -1, 0, 0, false);
   if (history_.empty())
-    oldest_sequence_number_ = sequence_number;
-
-  history_.insert(std::pair<uint16_t, PacketInfo>(
-      sequence_number, PacketInfo(clock_->TimeInMilliseconds(), 0, -1,
-                                  sequence_number, length, was_paced)));
+    first_sequence_number_ = unwrapped;
+  // Packets are normally added in order, but pad for gaps and for packets
+  // that are added late.
+  for (; first_sequence_number_ > unwrapped; --first_sequence_number_)
+    history_.push_front(empty);
+  const size_t index = static_cast<size_t>(unwrapped - first_sequence_number_);
+  if (index >= history_.size())
+    history_.resize(index + 1, empty);
+  history_[index] = packet;
 }
 
 bool SendTimeHistory::OnSentPacket(uint16_t sequence_number,
                                    int64_t send_time_ms) {
-  auto it = history_.find(sequence_number);
-  if (it == history_.end())
+  PacketInfo* packet = Find(sequence_number);
+  if (!packet)
     return false;
-  it->second.send_time_ms = send_time_ms;
+  packet->send_time_ms = send_time_ms;
   return true;
 }
 
 void SendTimeHistory::EraseOld() {
-  while (!history_.empty()) {
-    auto it = history_.find(oldest_sequence_number_);
-    assert(it != history_.end());
-
-    if (clock_->TimeInMilliseconds() - it->second.creation_time_ms <=
-        packet_age_limit_) {
-      return;  // Oldest packet within age limit, return.
-    }
-
+  // Remove from the front until the first packet is within the age limit.
+  // Packets that were added late may thus be kept beyond the limit.
+  const int64_t now_ms = clock_->TimeInMilliseconds();
+  while (!history_.empty() &&
+         (IsEmpty(history_.front()) ||
+          now_ms - history_.front().creation_time_ms > packet_age_limit_)) {
     // TODO(sprang): Warn if erasing (too many) old items?
-    history_.erase(it);
-    UpdateOldestSequenceNumber();
+    history_.pop_front();
+    ++first_sequence_number_;
   }
 }
 
-void SendTimeHistory::UpdateOldestSequenceNumber() {
-  // After removing an element from the map, update oldest_sequence_number_ to
-  // the element with the lowest sequence number higher than the previous
-  // value (there might be gaps).
+PacketInfo* SendTimeHistory::Find(uint16_t sequence_number) {
   if (history_.empty())
-    return;
-  auto it = history_.upper_bound(oldest_sequence_number_);
-  if (it == history_.end()) {
-    // No element with higher sequence number than oldest_sequence_number_
-    // found, check wrap around. Note that history_.upper_bound(0) will not
-    // find 0 even if it is there, need to explicitly check for 0.
-    it = history_.find(0);
-    if (it == history_.end())
-      it = history_.upper_bound(0);
-  }
-  assert(it != history_.end());
-  oldest_sequence_number_ = it->first;
+    return nullptr;
+  const int64_t index =
+      seq_num_unwrapper_.UnwrapWithoutUpdate(sequence_number) -
+      first_sequence_number_;
+  if (index < 0 || index >= static_cast<int64_t>(history_.size()))
+    return nullptr;
+  PacketInfo* packet = &history_[static_cast<size_t>(index)];
+  return IsEmpty(*packet) ? nullptr : packet;
 }
 
 bool SendTimeHistory::GetInfo(PacketInfo* packet, bool remove) {
-  auto it = history_.find(packet->sequence_number);
-  if (it == history_.end())
+  PacketInfo* entry = Find(packet->sequence_number);
+  if (!entry)
     return false;
   int64_t receive_time = packet->arrival_time_ms;
-  *packet = it->second;
+  *packet = *entry;
   packet->arrival_time_ms = receive_time;
   if (remove) {
-    history_.erase(it);
-    if (packet->sequence_number == oldest_sequence_number_)
-      UpdateOldestSequenceNumber();
+    entry->creation_time_ms = kEmptyEntry;
+    while (!history_.empty() && IsEmpty(history_.front())) {
+      history_.pop_front();
+      ++first_sequence_number_;
+    }
   }
   return true;
 }
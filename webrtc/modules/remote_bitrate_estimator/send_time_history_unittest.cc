@@ -230,5 +230,33 @@ TEST_F(SendTimeHistoryTest, InterlievedGetAndRemove) {
   EXPECT_EQ(packets[2], info3);
 }
 
+TEST_F(SendTimeHistoryTest, GapsAndLateAdds) {
+  AddPacketWithSendTime(10, 0, false, 10);
+  AddPacketWithSendTime(20, 0, false, 20);
+  for (uint16_t seq = 11; seq < 20; ++seq) {
+    PacketInfo info(0, seq);
+    EXPECT_FALSE(history_.GetInfo(&info, false));
+  }
+  // Add packets on both sides of the first one, out of order.
+  AddPacketWithSendTime(5, 0, false, 5);
+  AddPacketWithSendTime(15, 0, false, 15);
+  for (uint16_t seq : {5, 10, 15, 20}) {
+    PacketInfo info(0, seq);
+    EXPECT_TRUE(history_.GetInfo(&info, true));
+    EXPECT_EQ(seq, info.send_time_ms);
+  }
+  for (uint16_t seq : {5, 10, 15, 20}) {
+    PacketInfo info(0, seq);
+    EXPECT_FALSE(history_.GetInfo(&info, false));
+  }
+
+  // The history is empty, and continues from any sequence number.
+  const uint16_t kSeqNo = 40000;
+  AddPacketWithSendTime(kSeqNo, 0, false, 1);
+  PacketInfo info(0, kSeqNo);
+  EXPECT_TRUE(history_.GetInfo(&info, false));
+  EXPECT_FALSE(history_.OnSentPacket(kSeqNo + 1, 2));
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/remote_bitrate_estimator/test/bwe_scenario_runner.h"
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/remote_bitrate_estimator/test/bwe_test_framework.h"
+#include "webrtc/modules/remote_bitrate_estimator/test/bwe_test_logging.h"
+#include "webrtc/modules/remote_bitrate_estimator/test/packet_receiver.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace testing {
+namespace bwe {
+
+BweScenarioResult::BweScenarioResult()
+    : completed(false),
+      throughput_kbps(0.0),
+      delay_p50_ms(0.0),
+      delay_p95_ms(0.0),
+      delay_p99_ms(0.0),
+      loss_fraction(0.0),
+      elapsed_ms(0) {}
+
+void MeasureFlow(const RateCounterFilter& counter,
+                 PacketReceiver* receiver,
+                 BweScenarioResult* result) {
+  Stats<double> throughput_kbps = counter.GetBitrateStats();
+  Stats<double> delay_ms = receiver->GetDelayStats();
+  result->throughput_kbps = throughput_kbps.GetMean();
+  result->delay_p50_ms = delay_ms.GetPercentile(50);
+  result->delay_p95_ms = delay_ms.GetPercentile(95);
+  result->delay_p99_ms = delay_ms.GetPercentile(99);
+  result->loss_fraction = receiver->GlobalPacketLoss();
+}
+
+BweScenario::BweScenario() : BweTest(false) {}
+
+BweScenarioRunner::BweScenarioRunner(int num_threads)
+    : num_threads_(num_threads > 0 ? num_threads
+                                   : CpuInfo::DetectNumberOfCores()),
+      next_scenario_(0) {}
+
+BweScenarioRunner::~BweScenarioRunner() {}
+
+void BweScenarioRunner::AddScenario(const std::string& name,
+                                    const Scenario& scenario) {
+  scenarios_.push_back(std::make_pair(name, scenario));
+}
+
+std::vector<BweScenarioResult> BweScenarioRunner::Run() {
+  results_.clear();
+  results_.resize(scenarios_.size());
+  next_scenario_ = 0;
+  int num_threads =
+      std::min(num_threads_, static_cast<int>(scenarios_.size()));
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back(
+        new rtc::PlatformThread(&RunScenarios, this, "BweScenarioRunner"));
+    threads.back()->Start();
+  }
+  // Each thread keeps picking up scenarios until there are none left, so
+  // stopping the threads waits for all of them to finish.
+  for (auto& thread : threads) {
+    thread->Stop();
+  }
+  return results_;
+}
+
+bool BweScenarioRunner::RunScenarios(void* obj) {
+  BweScenarioRunner* runner = static_cast<BweScenarioRunner*>(obj);
+  while (true) {
+    size_t index = static_cast<size_t>(
+        rtc::AtomicOps::Increment(&runner->next_scenario_) - 1);
+    if (index >= runner->scenarios_.size())
+      break;
+    runner->RunScenario(index);
+  }
+  return false;
+}
+
+void BweScenarioRunner::RunScenario(size_t index) {
+  const std::string& name = scenarios_[index].first;
+  // Logging contexts are per thread; the plots of parallel runs would be
+  // interleaved, so they are disabled.
+  BWE_TEST_LOGGING_GLOBAL_CONTEXT(name);
+  BWE_TEST_LOGGING_GLOBAL_ENABLE(false);
+
+  BweScenarioResult* result = &results_[index];
+  result->name = name;
+  int64_t start_ms = rtc::TimeMillis();
+  BweScenario scenario;
+  result->completed = scenarios_[index].second(&scenario, result);
+  result->elapsed_ms = rtc::TimeMillis() - start_ms;
+}
+
+void BweScenarioRunner::WriteCsv(const std::vector<BweScenarioResult>& results,
+                                 FILE* file) {
+  fprintf(file,
+          "name,completed,throughput_kbps,delay_p50_ms,delay_p95_ms,"
+          "delay_p99_ms,loss_fraction,elapsed_ms\n");
+  for (const BweScenarioResult& result : results) {
+    fprintf(file, "%s,%d,%.1f,%.1f,%.1f,%.1f,%.4f,%" PRId64 "\n",
+            result.name.c_str(), result.completed ? 1 : 0,
+            result.throughput_kbps, result.delay_p50_ms, result.delay_p95_ms,
+            result.delay_p99_ms, result.loss_fraction, result.elapsed_ms);
+  }
+  fflush(file);
+}
+
+BweScenarioResult BweScenarioRunner::Aggregate(
+    const std::string& name,
+    const std::vector<BweScenarioResult>& results) {
+  BweScenarioResult aggregate;
+  aggregate.name = name;
+  int num_completed = 0;
+  for (const BweScenarioResult& result : results) {
+    aggregate.elapsed_ms += result.elapsed_ms;
+    if (!result.completed)
+      continue;
+    ++num_completed;
+    aggregate.throughput_kbps += result.throughput_kbps;
+    aggregate.delay_p50_ms += result.delay_p50_ms;
+    aggregate.delay_p95_ms += result.delay_p95_ms;
+    aggregate.delay_p99_ms += result.delay_p99_ms;
+    aggregate.loss_fraction += result.loss_fraction;
+  }
+  if (num_completed == 0)
+    return aggregate;
+  aggregate.completed = true;
+  aggregate.throughput_kbps /= num_completed;
+  aggregate.delay_p50_ms /= num_completed;
+  aggregate.delay_p95_ms /= num_completed;
+  aggregate.delay_p99_ms /= num_completed;
+  aggregate.loss_fraction /= num_completed;
+  return aggregate;
+}
+
+}  // namespace bwe
+}  // namespace testing
+}  // namespace webrtc
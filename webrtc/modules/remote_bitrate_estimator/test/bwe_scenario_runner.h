@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_TEST_BWE_SCENARIO_RUNNER_H_
+#define WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_TEST_BWE_SCENARIO_RUNNER_H_
+
+#include <stdio.h>
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/modules/remote_bitrate_estimator/test/bwe_test.h"
+
+namespace webrtc {
+namespace testing {
+namespace bwe {
+
+class PacketReceiver;
+class RateCounterFilter;
+
+// The metrics of one scenario run.
+struct BweScenarioResult {
+  BweScenarioResult();
+
+  std::string name;
+  // False if the scenario could not be set up, in which case the metrics
+  // are not valid.
+  bool completed;
+  double throughput_kbps;
+  double delay_p50_ms;
+  double delay_p95_ms;
+  double delay_p99_ms;
+  double loss_fraction;
+  // Wall clock time spent running the scenario.
+  int64_t elapsed_ms;
+};
+
+// Fills in the throughput, delay and loss of |result| from a flow's rate
+// counter and receiver, after the scenario has run.
+void MeasureFlow(const RateCounterFilter& counter,
+                 PacketReceiver* receiver,
+                 BweScenarioResult* result);
+
+// The links a scenario builds its flows on. Unlike BweTest, it doesn't
+// depend on the gtest fixture, so several can run at once on different
+// threads.
+class BweScenario : public BweTest {
+ public:
+  BweScenario();
+
+  Link* uplink() { return &uplink_; }
+  Link* downlink() { return &downlink_; }
+  using BweTest::RunFor;
+
+ private:
+  RTC_DISALLOW_COPY_AND_ASSIGN(BweScenario);
+};
+
+// Runs independent simulation scenarios in parallel, one per thread. A
+// scenario sets up its senders, filters and receivers on the BweScenario it
+// is given, runs it and records its metrics. Scenarios must not share state
+// with each other.
+class BweScenarioRunner {
+ public:
+  typedef std::function<bool(BweScenario*, BweScenarioResult*)> Scenario;
+
+  // Runs scenarios on |num_threads| threads, or one per core if zero.
+  explicit BweScenarioRunner(int num_threads);
+  ~BweScenarioRunner();
+
+  void AddScenario(const std::string& name, const Scenario& scenario);
+
+  // Runs all added scenarios and returns their results in the order they
+  // were added.
+  std::vector<BweScenarioResult> Run();
+
+  // Writes |results| to |file| as comma separated values, with a header.
+  static void WriteCsv(const std::vector<BweScenarioResult>& results,
+                       FILE* file);
+
+  // Returns the average of the metrics of the completed |results|.
+  static BweScenarioResult Aggregate(
+      const std::string& name,
+      const std::vector<BweScenarioResult>& results);
+
+ private:
+  static bool RunScenarios(void* obj);
+  void RunScenario(size_t index);
+
+  const int num_threads_;
+  std::vector<std::pair<std::string, Scenario>> scenarios_;
+  std::vector<BweScenarioResult> results_;
+  volatile int next_scenario_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(BweScenarioRunner);
+};
+
+}  // namespace bwe
+}  // namespace testing
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_TEST_BWE_SCENARIO_RUNNER_H_
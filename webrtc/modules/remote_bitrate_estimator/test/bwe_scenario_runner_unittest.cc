@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/remote_bitrate_estimator/test/bwe_scenario_runner.h"
+
+#include <sstream>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/modules/remote_bitrate_estimator/test/bwe_test_framework.h"
+#include "webrtc/modules/remote_bitrate_estimator/test/packet_receiver.h"
+#include "webrtc/modules/remote_bitrate_estimator/test/packet_sender.h"
+
+namespace webrtc {
+namespace testing {
+namespace bwe {
+namespace {
+const int kNumScenarios = 6;
+
+bool RunChokedFlow(uint32_t capacity_kbps,
+                   BweScenario* scenario,
+                   BweScenarioResult* result) {
+  AdaptiveVideoSource source(0, 30, 300, 0, 0);
+  VideoSender sender(scenario->uplink(), &source, kRembEstimator);
+  ChokeFilter choke(scenario->uplink(), 0);
+  choke.set_capacity_kbps(capacity_kbps);
+  choke.set_max_delay_ms(500);
+  RateCounterFilter counter(scenario->uplink(), 0, "Receiver", "");
+  PacketReceiver receiver(scenario->uplink(), 0, kRembEstimator, false, false);
+  scenario->RunFor(10 * 1000);
+  MeasureFlow(counter, &receiver, result);
+  return true;
+}
+
+std::vector<BweScenarioResult> RunChokedFlows(int num_threads) {
+  BweScenarioRunner runner(num_threads);
+  for (int i = 0; i < kNumScenarios; ++i) {
+    std::stringstream name;
+    name << "choke_" << i;
+    uint32_t capacity_kbps = 200 + 100 * i;
+    runner.AddScenario(name.str(),
+                       [capacity_kbps](BweScenario* scenario,
+                                       BweScenarioResult* result) {
+                         return RunChokedFlow(capacity_kbps, scenario, result);
+                       });
+  }
+  return runner.Run();
+}
+}  // namespace
+
+TEST(BweScenarioRunnerTest, ResultsInOrder) {
+  BweScenarioRunner runner(3);
+  for (int i = 0; i < 10; ++i) {
+    std::stringstream name;
+    name << i;
+    runner.AddScenario(name.str(),
+                       [i](BweScenario* scenario, BweScenarioResult* result) {
+                         result->throughput_kbps = i;
+                         return i % 2 == 0;
+                       });
+  }
+  std::vector<BweScenarioResult> results = runner.Run();
+  ASSERT_EQ(10u, results.size());
+  for (int i = 0; i < 10; ++i) {
+    std::stringstream name;
+    name << i;
+    EXPECT_EQ(name.str(), results[i].name);
+    EXPECT_EQ(i % 2 == 0, results[i].completed);
+    EXPECT_EQ(i, results[i].throughput_kbps);
+  }
+
+  BweScenarioResult aggregate = BweScenarioRunner::Aggregate("all", results);
+  EXPECT_EQ("all", aggregate.name);
+  EXPECT_TRUE(aggregate.completed);
+  // Only the completed scenarios, 0, 2, 4, 6 and 8, are averaged.
+  EXPECT_EQ(4, aggregate.throughput_kbps);
+}
+
+TEST(BweScenarioRunnerTest, AggregateWithoutCompletedResults) {
+  std::vector<BweScenarioResult> results(2);
+  BweScenarioResult aggregate = BweScenarioRunner::Aggregate("none", results);
+  EXPECT_FALSE(aggregate.completed);
+  EXPECT_EQ(0, aggregate.throughput_kbps);
+}
+
+// The simulations run on simulated time, so running them in parallel must
+// give exactly the same metrics as running them one at a time.
+TEST(BweScenarioRunnerTest, ParallelRunsMatchSerialRuns) {
+  std::vector<BweScenarioResult> serial = RunChokedFlows(1);
+  std::vector<BweScenarioResult> parallel = RunChokedFlows(4);
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (size_t i = 0; i < serial.size(); ++i) {
+    EXPECT_TRUE(parallel[i].completed);
+    EXPECT_EQ(serial[i].name, parallel[i].name);
+    EXPECT_EQ(serial[i].throughput_kbps, parallel[i].throughput_kbps);
+    EXPECT_EQ(serial[i].delay_p50_ms, parallel[i].delay_p50_ms);
+    EXPECT_EQ(serial[i].delay_p95_ms, parallel[i].delay_p95_ms);
+    EXPECT_EQ(serial[i].delay_p99_ms, parallel[i].delay_p99_ms);
+    EXPECT_EQ(serial[i].loss_fraction, parallel[i].loss_fraction);
+  }
+  // The flows can't exceed their bottleneck.
+  for (size_t i = 0; i < serial.size(); ++i) {
+    EXPECT_GT(serial[i].throughput_kbps, 0);
+    EXPECT_LT(serial[i].throughput_kbps, 200 + 100 * i + 50);
+  }
+}
+
+}  // namespace bwe
+}  // namespace testing
+}  // namespace webrtc
@@ -136,6 +136,19 @@ template<typename T> class Stats {
     RefreshMinMax();
     return max_;
   }
+  // Returns the sample below which |percentile| percent of the samples fall,
+  // using the nearest rank, or 0 if there are no samples.
+  T GetPercentile(double percentile) {
+    if (data_.empty()) {
+      return 0;
+    }
+    std::vector<T> sorted(data_);
+    size_t index = static_cast<size_t>(
+        percentile / 100.0 * (sorted.size() - 1) + 0.5);
+    index = std::min(index, sorted.size() - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+  }
 
   std::string AsString() {
     std::stringstream ss;
@@ -146,6 +146,19 @@ TEST(BweTestFramework_StatsTest, MinMax) {
   EXPECT_EQ(3, stats.GetMax());
 }
 
+TEST(BweTestFramework_StatsTest, Percentile) {
+  Stats<int32_t> stats;
+  EXPECT_EQ(0, stats.GetPercentile(50));
+
+  for (int32_t i = 100; i > 0; --i) {
+    stats.Push(i);
+  }
+  EXPECT_EQ(1, stats.GetPercentile(0));
+  EXPECT_EQ(51, stats.GetPercentile(50));
+  EXPECT_EQ(95, stats.GetPercentile(95));
+  EXPECT_EQ(100, stats.GetPercentile(100));
+}
+
 class BweTestFramework_RateCounterFilterTest : public ::testing::Test {
  public:
   BweTestFramework_RateCounterFilterTest()
@@ -85,7 +85,8 @@ ForwardErrorCorrection::RecoveredPacket::RecoveredPacket() {}
 ForwardErrorCorrection::RecoveredPacket::~RecoveredPacket() {}
 
 ForwardErrorCorrection::ForwardErrorCorrection()
-    : generated_fec_packets_(kMaxMediaPackets), fec_packet_received_(false) {}
+    : fec_packet_received_(false),
+      xor_function_(internal::GetXorFunction()) {}
 
 ForwardErrorCorrection::~ForwardErrorCorrection() {}
 
@@ -152,6 +153,11 @@ int32_t ForwardErrorCorrection::GenerateFEC(const PacketList& media_packet_list,
     return 0;
   }
 
+  // The FEC packets are only needed when sending, and are allocated the first
+  // time FEC is generated.
+  if (generated_fec_packets_.empty())
+    generated_fec_packets_.resize(kMaxMediaPackets);
+
   // Prepare FEC packets by setting them to 0.
   for (int i = 0; i < num_fec_packets; ++i) {
     memset(generated_fec_packets_[i].data, 0, IP_PACKET_SIZE);
@@ -263,10 +269,9 @@ void ForwardErrorCorrection::GenerateFecBitStrings(
           fec_packet->data[9] ^= media_payload_length[1];
 
           // XOR with RTP payload, leaving room for the ULP header.
-          for (int32_t j = kFecHeaderSize + ulp_header_size;
-               j < fec_packet_length; j++) {
-            fec_packet->data[j] ^= media_packet->data[j - fec_rtp_offset];
-          }
+          xor_function_(&media_packet->data[kRtpHeaderSize],
+                        media_packet->length - kRtpHeaderSize,
+                        &fec_packet->data[kFecHeaderSize + ulp_header_size]);
         }
         if (fec_packet_length > fec_packet->length) {
           fec_packet->length = fec_packet_length;
@@ -721,8 +726,10 @@ void ForwardErrorCorrection::XorPackets(const Packet* src_packet,
 
   // XOR with RTP payload.
   // TODO(marpan/ajm): Are we doing more XORs than required here?
-  for (size_t i = kRtpHeaderSize; i < src_packet->length; ++i) {
-    dst_packet->pkt->data[i] ^= src_packet->data[i];
+  if (src_packet->length > kRtpHeaderSize) {
+    xor_function_(&src_packet->data[kRtpHeaderSize],
+                  src_packet->length - kRtpHeaderSize,
+                  &dst_packet->pkt->data[kRtpHeaderSize]);
   }
 }
 
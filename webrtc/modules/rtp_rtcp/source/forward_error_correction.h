@@ -17,6 +17,7 @@
 #include "webrtc/base/refcount.h"
 #include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction_xor.h"
 #include "webrtc/typedefs.h"
 
 namespace webrtc {
@@ -284,7 +285,7 @@ class ForwardErrorCorrection {
 
   // Performs XOR between |src_packet| and |dst_packet| and stores the result
   // in |dst_packet|.
-  static void XorPackets(const Packet* src_packet, RecoveredPacket* dst_packet);
+  void XorPackets(const Packet* src_packet, RecoveredPacket* dst_packet);
 
   // Finish up the recovery of a packet.
   static bool FinishRecovery(RecoveredPacket* recovered);
@@ -306,6 +307,7 @@ class ForwardErrorCorrection {
   std::vector<Packet> generated_fec_packets_;
   FecPacketList fec_packet_list_;
   bool fec_packet_received_;
+  const internal::XorFunction xor_function_;
 };
 }  // namespace webrtc
 #endif  // WEBRTC_MODULES_RTP_RTCP_SOURCE_FORWARD_ERROR_CORRECTION_H_
@@ -0,0 +1,187 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <algorithm>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction.h"
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction_xor.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+const size_t kPacketSize = 1200;
+const uint32_t kSsrc = 0x12345678;
+const int kNumFrames = 2000;
+
+struct FecConfig {
+  FecMaskType mask_type;
+  int num_media_packets;
+  uint8_t protection_factor;
+};
+
+// Bursty masks are only defined up to 12 media packets, larger frames use the
+// random table.
+const FecConfig kFecConfigs[] = {
+    {kFecMaskRandom, 4, 64},   {kFecMaskRandom, 12, 64},
+    {kFecMaskRandom, 12, 255}, {kFecMaskRandom, 48, 64},
+    {kFecMaskBursty, 4, 64},   {kFecMaskBursty, 12, 64},
+    {kFecMaskBursty, 12, 255},
+};
+
+std::string ConfigName(const FecConfig& config) {
+  return std::string(config.mask_type == kFecMaskRandom ? "_random_"
+                                                        : "_bursty_") +
+         rtc::ToString(config.num_media_packets) + "_" +
+         rtc::ToString(static_cast<int>(config.protection_factor));
+}
+
+void CreateMediaPackets(int num_packets,
+                        Random* random,
+                        ForwardErrorCorrection::PacketList* packets) {
+  for (int i = 0; i < num_packets; ++i) {
+    ForwardErrorCorrection::Packet* packet =
+        new ForwardErrorCorrection::Packet();
+    packet->length = kPacketSize;
+    for (size_t j = 0; j < kPacketSize; ++j)
+      packet->data[j] = random->Rand<uint8_t>();
+    // Version 2, no padding, marker bit only on the last packet.
+    packet->data[0] = 0x80;
+    packet->data[1] = (i == num_packets - 1) ? 0x80 | 96 : 96;
+    ByteWriter<uint16_t>::WriteBigEndian(&packet->data[2], i);
+    ByteWriter<uint32_t>::WriteBigEndian(&packet->data[8], kSsrc);
+    packets->push_back(packet);
+  }
+}
+
+// Returns the encoded media throughput in megabits per second.
+size_t MeasureEncodeMbps(const FecConfig& config) {
+  Random random(0xfec);
+  ForwardErrorCorrection fec;
+  ForwardErrorCorrection::PacketList media_packets;
+  CreateMediaPackets(config.num_media_packets, &random, &media_packets);
+
+  uint64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumFrames; ++i) {
+    ForwardErrorCorrection::PacketList fec_packets;
+    EXPECT_EQ(0, fec.GenerateFEC(media_packets, config.protection_factor, 0,
+                                 false, config.mask_type, &fec_packets));
+  }
+  uint64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+
+  for (ForwardErrorCorrection::Packet* packet : media_packets)
+    delete packet;
+  uint64_t bits = 8ull * kPacketSize * config.num_media_packets * kNumFrames;
+  return static_cast<size_t>(bits * 1000 / std::max<uint64_t>(elapsed_ns, 1));
+}
+
+// Drops the first media packets, as many as there are FEC packets, and returns
+// the decoded media throughput in megabits per second.
+size_t MeasureDecodeMbps(const FecConfig& config) {
+  Random random(0xfec);
+  ForwardErrorCorrection fec;
+  ForwardErrorCorrection::PacketList media_packets;
+  CreateMediaPackets(config.num_media_packets, &random, &media_packets);
+  ForwardErrorCorrection::PacketList fec_packets;
+  EXPECT_EQ(0, fec.GenerateFEC(media_packets, config.protection_factor, 0,
+                               false, config.mask_type, &fec_packets));
+  const int num_lost = static_cast<int>(fec_packets.size());
+
+  ForwardErrorCorrection decoder;
+  uint64_t elapsed_ns = 0;
+  for (int i = 0; i < kNumFrames; ++i) {
+    ForwardErrorCorrection::ReceivedPacketList received_packets;
+    int index = 0;
+    for (ForwardErrorCorrection::Packet* packet : media_packets) {
+      if (index++ < num_lost)
+        continue;
+      ForwardErrorCorrection::ReceivedPacket* received =
+          new ForwardErrorCorrection::ReceivedPacket();
+      received->pkt = new ForwardErrorCorrection::Packet();
+      received->pkt->length = packet->length;
+      memcpy(received->pkt->data, packet->data, packet->length);
+      received->seq_num = ByteReader<uint16_t>::ReadBigEndian(&packet->data[2]);
+      received->is_fec = false;
+      received_packets.push_back(received);
+    }
+    uint16_t fec_seq_num = config.num_media_packets;
+    for (ForwardErrorCorrection::Packet* packet : fec_packets) {
+      ForwardErrorCorrection::ReceivedPacket* received =
+          new ForwardErrorCorrection::ReceivedPacket();
+      received->pkt = new ForwardErrorCorrection::Packet();
+      received->pkt->length = packet->length;
+      memcpy(received->pkt->data, packet->data, packet->length);
+      received->seq_num = fec_seq_num++;
+      received->ssrc = kSsrc;
+      received->is_fec = true;
+      received_packets.push_back(received);
+    }
+
+    ForwardErrorCorrection::RecoveredPacketList recovered_packets;
+    uint64_t start_ns = rtc::TimeNanos();
+    EXPECT_EQ(0, decoder.DecodeFEC(&received_packets, &recovered_packets));
+    elapsed_ns += rtc::TimeNanos() - start_ns;
+    decoder.ResetState(&recovered_packets);
+  }
+
+  for (ForwardErrorCorrection::Packet* packet : media_packets)
+    delete packet;
+  uint64_t bits = 8ull * kPacketSize * config.num_media_packets * kNumFrames;
+  return static_cast<size_t>(bits * 1000 / std::max<uint64_t>(elapsed_ns, 1));
+}
+
+// Returns the throughput of |xor_function| on packet sized buffers, in
+// megabytes per second.
+size_t MeasureXorMBps(internal::XorFunction xor_function) {
+  const int kIterations = 200000;
+  std::vector<uint8_t> src(kPacketSize, 0x5a);
+  std::vector<uint8_t> dst(kPacketSize, 0xa5);
+  uint64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kIterations; ++i)
+    xor_function(&src[0], kPacketSize, &dst[0]);
+  uint64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  // Use the result so the loop isn't optimized away.
+  EXPECT_EQ((kIterations % 2) ? (0x5a ^ 0xa5) : 0xa5, dst[0]);
+  uint64_t bytes = static_cast<uint64_t>(kPacketSize) * kIterations;
+  return static_cast<size_t>(bytes * 1000 / std::max<uint64_t>(elapsed_ns, 1));
+}
+}  // namespace
+
+TEST(ForwardErrorCorrectionPerformanceTest, Encode) {
+  for (const FecConfig& config : kFecConfigs) {
+    test::PrintResult("fec_encode", ConfigName(config), "throughput",
+                      MeasureEncodeMbps(config), "Mbps", true);
+  }
+}
+
+TEST(ForwardErrorCorrectionPerformanceTest, Decode) {
+  for (const FecConfig& config : kFecConfigs) {
+    test::PrintResult("fec_decode", ConfigName(config), "throughput",
+                      MeasureDecodeMbps(config), "Mbps", true);
+  }
+}
+
+TEST(ForwardErrorCorrectionPerformanceTest, XorKernels) {
+  test::PrintResult("fec_xor", "", "c", MeasureXorMBps(internal::XorC), "MB/s",
+                    false);
+  test::PrintResult("fec_xor", "", "selected",
+                    MeasureXorMBps(internal::GetXorFunction()), "MB/s", true);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction_xor.h"
+
+#include <string.h>
+
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace internal {
+
+void XorC(const uint8_t* src, size_t length, uint8_t* dst) {
+  // Work on whole words where possible. memcpy keeps unaligned accesses
+  // well-defined and compiles to plain loads and stores.
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t s;
+    uint64_t d;
+    memcpy(&s, src + i, sizeof(s));
+    memcpy(&d, dst + i, sizeof(d));
+    d ^= s;
+    memcpy(dst + i, &d, sizeof(d));
+  }
+  for (; i < length; ++i)
+    dst[i] ^= src[i];
+}
+
+XorFunction GetXorFunction() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  return XorSSE2;
+#else
+  // x86 CPU detection required.
+  if (WebRtc_GetCPUInfo(kSSE2))
+    return XorSSE2;
+  return XorC;
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+  return XorNEON;
+#else
+  return XorC;
+#endif
+}
+
+}  // namespace internal
+}  // namespace webrtc
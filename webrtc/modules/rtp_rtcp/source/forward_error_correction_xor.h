@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_FORWARD_ERROR_CORRECTION_XOR_H_
+#define WEBRTC_MODULES_RTP_RTCP_SOURCE_FORWARD_ERROR_CORRECTION_XOR_H_
+
+#include <stddef.h>
+
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+namespace internal {
+
+// XORs |length| bytes of |src| into |dst|. The buffers must not overlap, and
+// need not be aligned.
+typedef void (*XorFunction)(const uint8_t* src, size_t length, uint8_t* dst);
+
+void XorC(const uint8_t* src, size_t length, uint8_t* dst);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void XorSSE2(const uint8_t* src, size_t length, uint8_t* dst);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void XorNEON(const uint8_t* src, size_t length, uint8_t* dst);
+#endif
+
+// Returns the fastest XOR implementation supported by the CPU.
+XorFunction GetXorFunction();
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_RTP_RTCP_SOURCE_FORWARD_ERROR_CORRECTION_XOR_H_
@@ -0,0 +1,37 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction_xor.h"
+
+#include <arm_neon.h>
+
+namespace webrtc {
+namespace internal {
+
+void XorNEON(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  // Four registers per iteration to keep several loads in flight.
+  for (; i + 64 <= length; i += 64) {
+    uint8x16_t d0 = veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i));
+    uint8x16_t d1 = veorq_u8(vld1q_u8(dst + i + 16), vld1q_u8(src + i + 16));
+    uint8x16_t d2 = veorq_u8(vld1q_u8(dst + i + 32), vld1q_u8(src + i + 32));
+    uint8x16_t d3 = veorq_u8(vld1q_u8(dst + i + 48), vld1q_u8(src + i + 48));
+    vst1q_u8(dst + i, d0);
+    vst1q_u8(dst + i + 16, d1);
+    vst1q_u8(dst + i + 32, d2);
+    vst1q_u8(dst + i + 48, d3);
+  }
+  for (; i + 16 <= length; i += 16)
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+  XorC(src + i, length - i, dst + i);
+}
+
+}  // namespace internal
+}  // namespace webrtc
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction_xor.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+const size_t kBufferSize = 1600;
+
+void VerifyXorFunction(XorFunction xor_function) {
+  Random random(0x5eed);
+  std::vector<uint8_t> src(kBufferSize);
+  std::vector<uint8_t> dst(kBufferSize);
+  std::vector<uint8_t> expected(kBufferSize);
+  // Cover all tail lengths and source/destination misalignments.
+  for (size_t length = 0; length <= 200; ++length) {
+    for (size_t offset = 0; offset < 16; ++offset) {
+      for (size_t i = 0; i < kBufferSize; ++i) {
+        src[i] = random.Rand<uint8_t>();
+        dst[i] = random.Rand<uint8_t>();
+      }
+      expected = dst;
+      for (size_t i = 0; i < length; ++i)
+        expected[2 * offset + i] ^= src[offset + i];
+
+      xor_function(&src[offset], length, &dst[2 * offset]);
+      ASSERT_EQ(0, memcmp(&expected[0], &dst[0], kBufferSize))
+          << "length " << length << ", offset " << offset;
+    }
+  }
+  // A full size packet.
+  expected = dst;
+  for (size_t i = 0; i < kBufferSize; ++i)
+    expected[i] ^= src[i];
+  xor_function(&src[0], kBufferSize, &dst[0]);
+  EXPECT_EQ(0, memcmp(&expected[0], &dst[0], kBufferSize));
+}
+}  // namespace
+
+TEST(ForwardErrorCorrectionXorTest, C) {
+  VerifyXorFunction(XorC);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(ForwardErrorCorrectionXorTest, SSE2) {
+  VerifyXorFunction(XorSSE2);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+TEST(ForwardErrorCorrectionXorTest, NEON) {
+  VerifyXorFunction(XorNEON);
+}
+#endif
+
+TEST(ForwardErrorCorrectionXorTest, Selected) {
+  VerifyXorFunction(GetXorFunction());
+}
+
+}  // namespace internal
+}  // namespace webrtc
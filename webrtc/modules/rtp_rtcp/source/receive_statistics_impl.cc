@@ -14,6 +14,7 @@
 
 #include <cstdlib>
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/modules/rtp_rtcp/source/bitrate.h"
 #include "webrtc/modules/rtp_rtcp/source/time_util.h"
 
@@ -25,12 +26,13 @@ const int64_t kStatisticsProcessIntervalMs = 1000;
 StreamStatistician::~StreamStatistician() {}
 
 StreamStatisticianImpl::StreamStatisticianImpl(
+    uint32_t ssrc,
     Clock* clock,
     RtcpStatisticsCallback* rtcp_callback,
     StreamDataCountersCallback* rtp_callback)
-    : clock_(clock),
+    : ssrc_(ssrc),
+      clock_(clock),
       incoming_bitrate_(clock, NULL),
-      ssrc_(0),
       max_reordering_threshold_(kDefaultMaxReorderingThreshold),
       jitter_q4_(0),
       cumulative_loss_(0),
@@ -60,7 +62,6 @@ void StreamStatisticianImpl::UpdateCounters(const RTPHeader& header,
                                             bool retransmitted) {
   rtc::CritScope cs(&stream_lock_);
   bool in_order = InOrderPacketInternal(header.sequenceNumber);
-  ssrc_ = header.ssrc;
   incoming_bitrate_.Update(packet_length);
   receive_counters_.transmitted.AddPacket(packet_length, header);
   if (!in_order && retransmitted) {
@@ -147,13 +148,11 @@ void StreamStatisticianImpl::UpdateJitter(const RTPHeader& header,
 
 void StreamStatisticianImpl::NotifyRtpCallback() {
   StreamDataCounters data;
-  uint32_t ssrc;
   {
     rtc::CritScope cs(&stream_lock_);
     data = receive_counters_;
-    ssrc = ssrc_;
   }
-  rtp_callback_->DataCountersUpdated(data, ssrc);
+  rtp_callback_->DataCountersUpdated(data, ssrc_);
 }
 
 void StreamStatisticianImpl::NotifyRtcpCallback() {
@@ -377,6 +376,7 @@ ReceiveStatistics* ReceiveStatistics::Create(Clock* clock) {
 ReceiveStatisticsImpl::ReceiveStatisticsImpl(Clock* clock)
     : clock_(clock),
       last_rate_update_ms_(0),
+      last_statistician_(NULL),
       rtcp_stats_callback_(NULL),
       rtp_stats_callback_(NULL) {}
 
@@ -387,35 +387,49 @@ ReceiveStatisticsImpl::~ReceiveStatisticsImpl() {
   }
 }
 
-void ReceiveStatisticsImpl::IncomingPacket(const RTPHeader& header,
-                                           size_t packet_length,
-                                           bool retransmitted) {
+StreamStatisticianImpl* ReceiveStatisticsImpl::FindStatistician(
+    uint32_t ssrc,
+    bool create) {
+  StreamStatisticianImpl* last =
+      rtc::AtomicOps::AcquireLoadPtr(&last_statistician_);
+  if (last && last->ssrc() == ssrc)
+    return last;
+
   StreamStatisticianImpl* impl;
   {
     rtc::CritScope cs(&receive_statistics_lock_);
-    StatisticianImplMap::iterator it = statisticians_.find(header.ssrc);
+    StatisticianImplMap::iterator it = statisticians_.find(ssrc);
     if (it != statisticians_.end()) {
       impl = it->second;
+    } else if (create) {
+      impl = new StreamStatisticianImpl(ssrc, clock_, this, this);
+      statisticians_[ssrc] = impl;
     } else {
-      impl = new StreamStatisticianImpl(clock_, this, this);
-      statisticians_[header.ssrc] = impl;
+      return NULL;
     }
   }
+  // If another thread has replaced |last| meanwhile, keep its entry.
+  rtc::AtomicOps::CompareAndSwapPtr(&last_statistician_, last, impl);
+  return impl;
+}
+
+void ReceiveStatisticsImpl::IncomingPacket(const RTPHeader& header,
+                                           size_t packet_length,
+                                           bool retransmitted) {
   // StreamStatisticianImpl instance is created once and only destroyed when
   // this whole ReceiveStatisticsImpl is destroyed. StreamStatisticianImpl has
   // it's own locking so don't hold receive_statistics_lock_ (potential
   // deadlock).
-  impl->IncomingPacket(header, packet_length, retransmitted);
+  FindStatistician(header.ssrc, true)
+      ->IncomingPacket(header, packet_length, retransmitted);
 }
 
 void ReceiveStatisticsImpl::FecPacketReceived(const RTPHeader& header,
                                               size_t packet_length) {
-  rtc::CritScope cs(&receive_statistics_lock_);
-  StatisticianImplMap::iterator it = statisticians_.find(header.ssrc);
+  StreamStatisticianImpl* impl = FindStatistician(header.ssrc, false);
   // Ignore FEC if it is the first packet.
-  if (it != statisticians_.end()) {
-    it->second->FecPacketReceived(header, packet_length);
-  }
+  if (impl)
+    impl->FecPacketReceived(header, packet_length);
 }
 
 StatisticianMap ReceiveStatisticsImpl::GetActiveStatisticians() const {
@@ -471,7 +485,7 @@ int64_t ReceiveStatisticsImpl::TimeUntilNextProcess() {
 
 void ReceiveStatisticsImpl::RegisterRtcpStatisticsCallback(
     RtcpStatisticsCallback* callback) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (callback != NULL)
     assert(rtcp_stats_callback_ == NULL);
   rtcp_stats_callback_ = callback;
@@ -479,20 +493,20 @@ void ReceiveStatisticsImpl::RegisterRtcpStatisticsCallback(
 
 void ReceiveStatisticsImpl::StatisticsUpdated(const RtcpStatistics& statistics,
                                               uint32_t ssrc) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (rtcp_stats_callback_)
     rtcp_stats_callback_->StatisticsUpdated(statistics, ssrc);
 }
 
 void ReceiveStatisticsImpl::CNameChanged(const char* cname, uint32_t ssrc) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (rtcp_stats_callback_)
     rtcp_stats_callback_->CNameChanged(cname, ssrc);
 }
 
 void ReceiveStatisticsImpl::RegisterRtpStatisticsCallback(
     StreamDataCountersCallback* callback) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (callback != NULL)
     assert(rtp_stats_callback_ == NULL);
   rtp_stats_callback_ = callback;
@@ -500,7 +514,7 @@ void ReceiveStatisticsImpl::RegisterRtpStatisticsCallback(
 
 void ReceiveStatisticsImpl::DataCountersUpdated(const StreamDataCounters& stats,
                                                 uint32_t ssrc) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (rtp_stats_callback_) {
     rtp_stats_callback_->DataCountersUpdated(stats, ssrc);
   }
@@ -24,7 +24,8 @@ namespace webrtc {
 
 class StreamStatisticianImpl : public StreamStatistician {
  public:
-  StreamStatisticianImpl(Clock* clock,
+  StreamStatisticianImpl(uint32_t ssrc,
+                         Clock* clock,
                          RtcpStatisticsCallback* rtcp_callback,
                          StreamDataCountersCallback* rtp_callback);
   virtual ~StreamStatisticianImpl() {}
@@ -47,6 +48,8 @@ class StreamStatisticianImpl : public StreamStatistician {
   void ProcessBitrate();
   virtual void LastReceiveTimeNtp(uint32_t* secs, uint32_t* frac) const;
 
+  uint32_t ssrc() const { return ssrc_; }
+
  private:
   bool InOrderPacketInternal(uint16_t sequence_number) const;
   RtcpStatistics CalculateRtcpStatistics();
@@ -57,10 +60,10 @@ class StreamStatisticianImpl : public StreamStatistician {
   void NotifyRtpCallback() LOCKS_EXCLUDED(stream_lock_);
   void NotifyRtcpCallback() LOCKS_EXCLUDED(stream_lock_);
 
+  const uint32_t ssrc_;
   Clock* clock_;
   rtc::CriticalSection stream_lock_;
   Bitrate incoming_bitrate_;
-  uint32_t ssrc_;
   int max_reordering_threshold_;  // In number of packets or sequence numbers.
 
   // Stats on received RTP packets.
@@ -127,11 +130,23 @@ class ReceiveStatisticsImpl : public ReceiveStatistics,
 
   typedef std::map<uint32_t, StreamStatisticianImpl*> StatisticianImplMap;
 
+  // Returns the statistician for |ssrc|, or NULL if there is none and
+  // |create| is false.
+  StreamStatisticianImpl* FindStatistician(uint32_t ssrc, bool create);
+
   Clock* clock_;
   rtc::CriticalSection receive_statistics_lock_;
   int64_t last_rate_update_ms_;
   StatisticianImplMap statisticians_;
-
+  // The statistician of the last packet, read without taking
+  // |receive_statistics_lock_| so that consecutive packets of one SSRC don't
+  // contend with RTCP report generation. Statisticians are only deleted in
+  // the destructor, so a stale pointer is never dangling.
+  StreamStatisticianImpl* volatile last_statistician_;
+
+  // Separate from |receive_statistics_lock_|, since the callbacks are called
+  // for every packet.
+  rtc::CriticalSection callback_lock_;
   RtcpStatisticsCallback* rtcp_stats_callback_;
   StreamDataCountersCallback* rtp_stats_callback_;
 };
@@ -97,6 +97,55 @@ TEST_F(ReceiveStatisticsTest, TwoIncomingSsrcs) {
   EXPECT_EQ(3u, packets_received);
 }
 
+// Counts the times the time is read, to keep track of the clock reads per
+// received packet.
+class ReadCountingClock : public Clock {
+ public:
+  explicit ReadCountingClock(int64_t initial_time_us)
+      : clock_(initial_time_us), num_reads_(0) {}
+
+  int64_t TimeInMilliseconds() const override {
+    ++num_reads_;
+    return clock_.TimeInMilliseconds();
+  }
+  int64_t TimeInMicroseconds() const override {
+    ++num_reads_;
+    return clock_.TimeInMicroseconds();
+  }
+  void CurrentNtp(uint32_t& seconds, uint32_t& fractions) const override {
+    ++num_reads_;
+    clock_.CurrentNtp(seconds, fractions);
+  }
+  int64_t CurrentNtpInMilliseconds() const override {
+    ++num_reads_;
+    return clock_.CurrentNtpInMilliseconds();
+  }
+
+  int num_reads() const { return num_reads_; }
+
+ private:
+  SimulatedClock clock_;
+  mutable int num_reads_;
+};
+
+TEST_F(ReceiveStatisticsTest, ReadsClockTwicePerInOrderPacket) {
+  const int kNumPackets = 100;
+  ReadCountingClock clock(0);
+  std::unique_ptr<ReceiveStatistics> receive_statistics(
+      ReceiveStatistics::Create(&clock));
+  // The first packet creates the statistician.
+  receive_statistics->IncomingPacket(header1_, kPacketSize1, false);
+
+  const int num_reads_before = clock.num_reads();
+  for (int i = 0; i < kNumPackets; ++i) {
+    ++header1_.sequenceNumber;
+    header1_.timestamp += 3000;
+    receive_statistics->IncomingPacket(header1_, kPacketSize1, false);
+  }
+  // The arrival time, and the arrival time in NTP for the jitter.
+  EXPECT_EQ(2 * kNumPackets, clock.num_reads() - num_reads_before);
+}
+
 TEST_F(ReceiveStatisticsTest, ActiveStatisticians) {
   receive_statistics_->IncomingPacket(header1_, kPacketSize1, false);
   ++header1_.sequenceNumber;
@@ -379,4 +428,36 @@ TEST_F(ReceiveStatisticsTest, RtpCallbacksFecFirst) {
   expected.fec.packets = 1;
   callback.Matches(2, kSsrc1, expected);
 }
+
+TEST_F(ReceiveStatisticsTest, FecOfOtherSsrcDoesNotCountForLastSsrc) {
+  receive_statistics_->IncomingPacket(header1_, kPacketSize1, false);
+  ++header1_.sequenceNumber;
+  // No statistician is created for FEC of a new SSRC, nor is it counted for
+  // the SSRC of the last packet.
+  receive_statistics_->FecPacketReceived(header2_, kPacketSize2);
+  EXPECT_TRUE(receive_statistics_->GetStatistician(kSsrc2) == NULL);
+  StreamDataCounters counters;
+  receive_statistics_->GetStatistician(kSsrc1)->GetReceiveStreamDataCounters(
+      &counters);
+  EXPECT_EQ(0u, counters.fec.packets);
+
+  // Alternating SSRCs are each counted for their own statistician.
+  for (int i = 0; i < 3; ++i) {
+    receive_statistics_->IncomingPacket(header2_, kPacketSize2, false);
+    ++header2_.sequenceNumber;
+    receive_statistics_->IncomingPacket(header1_, kPacketSize1, false);
+    ++header1_.sequenceNumber;
+  }
+  receive_statistics_->FecPacketReceived(header2_, kPacketSize2);
+  size_t bytes_received = 0;
+  uint32_t packets_received = 0;
+  receive_statistics_->GetStatistician(kSsrc1)->GetDataCounters(
+      &bytes_received, &packets_received);
+  EXPECT_EQ(4 * kPacketSize1, bytes_received);
+  EXPECT_EQ(4u, packets_received);
+  receive_statistics_->GetStatistician(kSsrc2)->GetReceiveStreamDataCounters(
+      &counters);
+  EXPECT_EQ(3u, counters.transmitted.packets);
+  EXPECT_EQ(1u, counters.fec.packets);
+}
 }  // namespace webrtc
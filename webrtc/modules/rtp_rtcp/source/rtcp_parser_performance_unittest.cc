@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/buffer.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/remb.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_utility.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/test/testsupport/perf_timer.h"
+
+namespace webrtc {
+namespace {
+const int kNumIterations = 100000;
+const uint32_t kSenderSsrc = 0x12345678;
+const char kCName[] = "receiver@example.com";
+const uint16_t kNackList[] = {100, 101, 103, 110, 140, 141, 200};
+const uint32_t kRembBitrateBps = 1500000;
+
+// Builds the compound packet a video receiver sends: a receiver report with
+// report blocks for |num_streams| streams, its CNAME, a NACK and a REMB.
+rtc::Buffer BuildReceiverFeedback(size_t num_streams) {
+  rtcp::ReceiverReport rr;
+  rr.From(kSenderSsrc);
+  rtcp::Remb remb;
+  remb.From(kSenderSsrc);
+  remb.WithBitrateBps(kRembBitrateBps);
+  for (size_t i = 0; i < num_streams; ++i) {
+    rtcp::ReportBlock block;
+    block.To(static_cast<uint32_t>(i + 1));
+    block.WithFractionLost(10);
+    EXPECT_TRUE(block.WithCumulativeLost(100));
+    block.WithExtHighestSeqNum(5000);
+    block.WithJitter(30);
+    EXPECT_TRUE(rr.WithReportBlock(block));
+    EXPECT_TRUE(remb.AppliesTo(static_cast<uint32_t>(i + 1)));
+  }
+  rtcp::Sdes sdes;
+  EXPECT_TRUE(sdes.WithCName(kSenderSsrc, kCName));
+  rtcp::Nack nack;
+  nack.From(kSenderSsrc);
+  nack.To(1);
+  nack.WithList(kNackList, sizeof(kNackList) / sizeof(kNackList[0]));
+
+  rtcp::CompoundPacket compound;
+  compound.Append(&rr);
+  compound.Append(&sdes);
+  compound.Append(&nack);
+  compound.Append(&remb);
+  return compound.Build();
+}
+
+// Parses |packet| and checks it against what BuildReceiverFeedback() put into
+// it. Returns the number of items the parser iterated over.
+size_t VerifyReceiverFeedback(const rtc::Buffer& packet, size_t num_streams) {
+  RTCPUtility::RTCPParserV2 parser(packet.data(), packet.size(), true);
+  size_t num_items = 0;
+  size_t num_report_blocks = 0;
+  std::string cname;
+  std::vector<uint16_t> nacked;
+  uint32_t remb_bitrate_bps = 0;
+  size_t num_remb_ssrcs = 0;
+  for (RTCPUtility::RTCPPacketTypes type = parser.Begin();
+       type != RTCPUtility::RTCPPacketTypes::kInvalid;
+       type = parser.Iterate()) {
+    ++num_items;
+    const RTCPUtility::RTCPPacket& item = parser.Packet();
+    switch (type) {
+      case RTCPUtility::RTCPPacketTypes::kRr:
+        EXPECT_EQ(kSenderSsrc, item.RR.SenderSSRC);
+        EXPECT_EQ(num_streams, item.RR.NumberOfReportBlocks);
+        break;
+      case RTCPUtility::RTCPPacketTypes::kReportBlockItem:
+        ++num_report_blocks;
+        EXPECT_EQ(num_report_blocks, item.ReportBlockItem.SSRC);
+        EXPECT_EQ(10, item.ReportBlockItem.FractionLost);
+        EXPECT_EQ(100u, item.ReportBlockItem.CumulativeNumOfPacketsLost);
+        EXPECT_EQ(5000u, item.ReportBlockItem.ExtendedHighestSequenceNumber);
+        EXPECT_EQ(30u, item.ReportBlockItem.Jitter);
+        break;
+      case RTCPUtility::RTCPPacketTypes::kSdesChunk:
+        EXPECT_EQ(kSenderSsrc, item.CName.SenderSSRC);
+        cname = item.CName.CName;
+        break;
+      case RTCPUtility::RTCPPacketTypes::kRtpfbNackItem:
+        nacked.push_back(item.NACKItem.PacketID);
+        for (int i = 0; i < 16; ++i) {
+          if (item.NACKItem.BitMask & (1 << i))
+            nacked.push_back(item.NACKItem.PacketID + i + 1);
+        }
+        break;
+      case RTCPUtility::RTCPPacketTypes::kPsfbRembItem:
+        remb_bitrate_bps = item.REMBItem.BitRate;
+        num_remb_ssrcs = item.REMBItem.NumberOfSSRCs;
+        break;
+      default:
+        break;
+    }
+  }
+  EXPECT_TRUE(parser.IsValid());
+  EXPECT_EQ(num_streams, num_report_blocks);
+  EXPECT_EQ(kCName, cname);
+  EXPECT_EQ(std::vector<uint16_t>(std::begin(kNackList), std::end(kNackList)),
+            nacked);
+  EXPECT_EQ(kRembBitrateBps, remb_bitrate_bps);
+  EXPECT_EQ(num_streams, num_remb_ssrcs);
+  return num_items;
+}
+
+// Returns the number of megabytes of the receiver feedback for |num_streams|
+// streams parsed per second.
+size_t MeasureParsedMBPerSecond(size_t num_streams) {
+  const rtc::Buffer packet = BuildReceiverFeedback(num_streams);
+  const size_t items_per_packet = VerifyReceiverFeedback(packet, num_streams);
+  size_t num_items = 0;
+  int num_valid = 0;
+  const double packets_per_second = test::MeasureCallsPerSecond(
+      kNumIterations, [&packet, &num_items, &num_valid] {
+        RTCPUtility::RTCPParserV2 parser(packet.data(), packet.size(), true);
+        for (RTCPUtility::RTCPPacketTypes type = parser.Begin();
+             type != RTCPUtility::RTCPPacketTypes::kInvalid;
+             type = parser.Iterate()) {
+          ++num_items;
+        }
+        num_valid += parser.IsValid();
+      });
+  EXPECT_EQ(kNumIterations, num_valid);
+  EXPECT_EQ(items_per_packet * kNumIterations, num_items);
+  return static_cast<size_t>(packets_per_second * packet.size() / 1000000);
+}
+}  // namespace
+
+TEST(RtcpParserPerformanceTest, ParseReceiverFeedback) {
+  test::PrintResult("rtcp_parse", "", "one_stream",
+                    MeasureParsedMBPerSecond(1), "MB/s", false);
+  test::PrintResult("rtcp_parse", "", "many_streams",
+                    MeasureParsedMBPerSecond(31), "MB/s", true);
+}
+
+}  // namespace webrtc
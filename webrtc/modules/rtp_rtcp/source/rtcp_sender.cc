@@ -12,6 +12,7 @@
 
 #include <string.h>  // memcpy
 
+#include "webrtc/base/buffer.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/logging.h"
@@ -21,7 +22,6 @@
 #include "webrtc/common_types.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/app.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/bye.h"
-#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/fir.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/nack.h"
@@ -81,37 +81,58 @@ RTCPSender::FeedbackState::FeedbackState()
       has_last_xr_rr(false),
       module(nullptr) {}
 
-class PacketContainer : public rtcp::CompoundPacket,
-                        public rtcp::RtcpPacket::PacketReadyCallback {
+// Serializes the blocks of a compound packet into a buffer on the stack as
+// they are appended, so that the blocks themselves can be built on the stack
+// too. Packets are only sent by SendPackets(), after the sender lock has been
+// released; if the blocks don't fit in one packet, the full ones are copied
+// aside until then.
+class RTCPSender::PacketContainer
+    : public rtcp::RtcpPacket::PacketReadyCallback {
  public:
-  PacketContainer(Transport* transport, RtcEventLog* event_log)
-      : transport_(transport), event_log_(event_log), bytes_sent_(0) {}
-  virtual ~PacketContainer() {
-    for (RtcpPacket* packet : appended_packets_)
-      delete packet;
+  PacketContainer(Transport* transport,
+                  RtcEventLog* event_log,
+                  size_t max_payload_length)
+      : transport_(transport),
+        event_log_(event_log),
+        max_payload_length_(max_payload_length),
+        length_(0) {
+    RTC_DCHECK_LE(max_payload_length_, sizeof(buffer_));
+  }
+
+  void Append(const rtcp::RtcpPacket& packet) {
+    packet.Create(buffer_, &length_, max_payload_length_, this);
   }
 
   void OnPacketReady(uint8_t* data, size_t length) override {
-    if (transport_->SendRtcp(data, length)) {
-      bytes_sent_ += length;
-      if (event_log_) {
-        event_log_->LogRtcpPacket(kOutgoingPacket, MediaType::ANY, data,
-                                  length);
-      }
-    }
+    full_packets_.push_back(rtc::Buffer(data, length));
   }
 
-  size_t SendPackets(size_t max_payload_length) {
-    RTC_DCHECK_LE(max_payload_length, static_cast<size_t>(IP_PACKET_SIZE));
-    uint8_t buffer[IP_PACKET_SIZE];
-    BuildExternalBuffer(buffer, max_payload_length, this);
-    return bytes_sent_;
+  size_t SendPackets() {
+    size_t bytes_sent = 0;
+    for (const rtc::Buffer& packet : full_packets_)
+      bytes_sent += SendPacket(packet.data(), packet.size());
+    if (length_ > 0)
+      bytes_sent += SendPacket(buffer_, length_);
+    return bytes_sent;
   }
 
  private:
-  Transport* transport_;
+  size_t SendPacket(const uint8_t* data, size_t length) {
+    if (!transport_->SendRtcp(data, length))
+      return 0;
+    if (event_log_) {
+      event_log_->LogRtcpPacket(kOutgoingPacket, MediaType::ANY, data,
+                                length);
+    }
+    return length;
+  }
+
+  Transport* const transport_;
   RtcEventLog* const event_log_;
-  size_t bytes_sent_;
+  const size_t max_payload_length_;
+  uint8_t buffer_[IP_PACKET_SIZE];
+  size_t length_;
+  std::vector<rtc::Buffer> full_packets_;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(PacketContainer);
 };
@@ -434,7 +455,8 @@ bool RTCPSender::TimeToSendRTCPReport(bool sendKeyframeBeforeRTP) const {
   return false;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildSR(const RtcpContext& ctx) {
+bool RTCPSender::BuildSR(const RtcpContext& ctx,
+                         PacketContainer* container) {
   // The timestamp of this RTCP packet should be estimated as the timestamp of
   // the frame being captured at this moment. We are calculating that
   // timestamp as the last frame's timestamp + the time since the last frame
@@ -444,49 +466,54 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildSR(const RtcpContext& ctx) {
       (clock_->TimeInMilliseconds() - last_frame_capture_time_ms_) *
           (ctx.feedback_state_.frequency_hz / 1000);
 
-  rtcp::SenderReport* report = new rtcp::SenderReport();
-  report->From(ssrc_);
-  report->WithNtp(NtpTime(ctx.ntp_sec_, ctx.ntp_frac_));
-  report->WithRtpTimestamp(rtp_timestamp);
-  report->WithPacketCount(ctx.feedback_state_.packets_sent);
-  report->WithOctetCount(ctx.feedback_state_.media_bytes_sent);
+  rtcp::SenderReport report;
+  report.From(ssrc_);
+  report.WithNtp(NtpTime(ctx.ntp_sec_, ctx.ntp_frac_));
+  report.WithRtpTimestamp(rtp_timestamp);
+  report.WithPacketCount(ctx.feedback_state_.packets_sent);
+  report.WithOctetCount(ctx.feedback_state_.media_bytes_sent);
 
   for (auto it : report_blocks_)
-    report->WithReportBlock(it.second);
+    report.WithReportBlock(it.second);
 
   report_blocks_.clear();
 
-  return std::unique_ptr<rtcp::RtcpPacket>(report);
+  container->Append(report);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildSDES(
-    const RtcpContext& ctx) {
+bool RTCPSender::BuildSDES(const RtcpContext& ctx,
+                           PacketContainer* container) {
   size_t length_cname = cname_.length();
   RTC_CHECK_LT(length_cname, static_cast<size_t>(RTCP_CNAME_SIZE));
 
-  rtcp::Sdes* sdes = new rtcp::Sdes();
-  sdes->WithCName(ssrc_, cname_);
+  rtcp::Sdes sdes;
+  sdes.WithCName(ssrc_, cname_);
 
   for (const auto it : csrc_cnames_)
-    sdes->WithCName(it.first, it.second);
+    sdes.WithCName(it.first, it.second);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(sdes);
+  container->Append(sdes);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildRR(const RtcpContext& ctx) {
-  rtcp::ReceiverReport* report = new rtcp::ReceiverReport();
-  report->From(ssrc_);
+bool RTCPSender::BuildRR(const RtcpContext& ctx,
+                         PacketContainer* container) {
+  rtcp::ReceiverReport report;
+  report.From(ssrc_);
   for (auto it : report_blocks_)
-    report->WithReportBlock(it.second);
+    report.WithReportBlock(it.second);
 
   report_blocks_.clear();
-  return std::unique_ptr<rtcp::RtcpPacket>(report);
+  container->Append(report);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildPLI(const RtcpContext& ctx) {
-  rtcp::Pli* pli = new rtcp::Pli();
-  pli->From(ssrc_);
-  pli->To(remote_ssrc_);
+bool RTCPSender::BuildPLI(const RtcpContext& ctx,
+                          PacketContainer* container) {
+  rtcp::Pli pli;
+  pli.From(ssrc_);
+  pli.To(remote_ssrc_);
 
   TRACE_EVENT_INSTANT0(TRACE_DISABLED_BY_DEFAULT("webrtc_rtp"),
                        "RTCPSender::PLI");
@@ -494,16 +521,18 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildPLI(const RtcpContext& ctx) {
   TRACE_COUNTER_ID1(TRACE_DISABLED_BY_DEFAULT("webrtc_rtp"), "RTCP_PLICount",
                     ssrc_, packet_type_counter_.pli_packets);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(pli);
+  container->Append(pli);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildFIR(const RtcpContext& ctx) {
+bool RTCPSender::BuildFIR(const RtcpContext& ctx,
+                          PacketContainer* container) {
   if (!ctx.repeat_)
     ++sequence_number_fir_;  // Do not increase if repetition.
 
-  rtcp::Fir* fir = new rtcp::Fir();
-  fir->From(ssrc_);
-  fir->WithRequestTo(remote_ssrc_, sequence_number_fir_);
+  rtcp::Fir fir;
+  fir.From(ssrc_);
+  fir.WithRequestTo(remote_ssrc_, sequence_number_fir_);
 
   TRACE_EVENT_INSTANT0(TRACE_DISABLED_BY_DEFAULT("webrtc_rtp"),
                        "RTCPSender::FIR");
@@ -511,7 +540,8 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildFIR(const RtcpContext& ctx) {
   TRACE_COUNTER_ID1(TRACE_DISABLED_BY_DEFAULT("webrtc_rtp"), "RTCP_FIRCount",
                     ssrc_, packet_type_counter_.fir_packets);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(fir);
+  container->Append(fir);
+  return true;
 }
 
 /*
@@ -521,14 +551,16 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildFIR(const RtcpContext& ctx) {
    |            First        |        Number           | PictureID |
    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 */
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildSLI(const RtcpContext& ctx) {
-  rtcp::Sli* sli = new rtcp::Sli();
-  sli->From(ssrc_);
-  sli->To(remote_ssrc_);
+bool RTCPSender::BuildSLI(const RtcpContext& ctx,
+                          PacketContainer* container) {
+  rtcp::Sli sli;
+  sli.From(ssrc_);
+  sli.To(remote_ssrc_);
   // Crop picture id to 6 least significant bits.
-  sli->WithPictureId(ctx.picture_id_ & 0x3F);
+  sli.WithPictureId(ctx.picture_id_ & 0x3F);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(sli);
+  container->Append(sli);
+  return true;
 }
 
 /*
@@ -543,32 +575,34 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildSLI(const RtcpContext& ctx) {
 /*
 *    Note: not generic made for VP8
 */
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildRPSI(
-    const RtcpContext& ctx) {
+bool RTCPSender::BuildRPSI(const RtcpContext& ctx,
+                           PacketContainer* container) {
   if (ctx.feedback_state_.send_payload_type == 0xFF)
-    return nullptr;
+    return false;
 
-  rtcp::Rpsi* rpsi = new rtcp::Rpsi();
-  rpsi->From(ssrc_);
-  rpsi->To(remote_ssrc_);
-  rpsi->WithPayloadType(ctx.feedback_state_.send_payload_type);
-  rpsi->WithPictureId(ctx.picture_id_);
+  rtcp::Rpsi rpsi;
+  rpsi.From(ssrc_);
+  rpsi.To(remote_ssrc_);
+  rpsi.WithPayloadType(ctx.feedback_state_.send_payload_type);
+  rpsi.WithPictureId(ctx.picture_id_);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(rpsi);
+  container->Append(rpsi);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildREMB(
-    const RtcpContext& ctx) {
-  rtcp::Remb* remb = new rtcp::Remb();
-  remb->From(ssrc_);
+bool RTCPSender::BuildREMB(const RtcpContext& ctx,
+                           PacketContainer* container) {
+  rtcp::Remb remb;
+  remb.From(ssrc_);
   for (uint32_t ssrc : remb_ssrcs_)
-    remb->AppliesTo(ssrc);
-  remb->WithBitrateBps(remb_bitrate_);
+    remb.AppliesTo(ssrc);
+  remb.WithBitrateBps(remb_bitrate_);
 
   TRACE_EVENT_INSTANT0(TRACE_DISABLED_BY_DEFAULT("webrtc_rtp"),
                        "RTCPSender::REMB");
 
-  return std::unique_ptr<rtcp::RtcpPacket>(remb);
+  container->Append(remb);
+  return true;
 }
 
 void RTCPSender::SetTargetBitrate(unsigned int target_bitrate) {
@@ -576,10 +610,10 @@ void RTCPSender::SetTargetBitrate(unsigned int target_bitrate) {
   tmmbr_send_ = target_bitrate / 1000;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBR(
-    const RtcpContext& ctx) {
+bool RTCPSender::BuildTMMBR(const RtcpContext& ctx,
+                            PacketContainer* container) {
   if (ctx.feedback_state_.module == nullptr)
-    return nullptr;
+    return false;
   // Before sending the TMMBR check the received TMMBN, only an owner is
   // allowed to raise the bitrate:
   // * If the sender is an owner of the TMMBN -> send TMMBR
@@ -602,7 +636,7 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBR(
       if (candidateSet->Tmmbr(i) == tmmbr_send_ &&
           candidateSet->PacketOH(i) == packet_oh_send_) {
         // Do not send the same tuple.
-        return nullptr;
+        return false;
       }
     }
     if (!tmmbrOwner) {
@@ -619,54 +653,58 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBR(
         tmmbrOwner = tmmbr_help.IsOwner(ssrc_, numBoundingSet);
       if (!tmmbrOwner) {
         // Did not enter bounding set, no meaning to send this request.
-        return nullptr;
+        return false;
       }
     }
   }
 
   if (!tmmbr_send_)
-    return nullptr;
+    return false;
 
-  rtcp::Tmmbr* tmmbr = new rtcp::Tmmbr();
-  tmmbr->From(ssrc_);
+  rtcp::Tmmbr tmmbr;
+  tmmbr.From(ssrc_);
   rtcp::TmmbItem request;
   request.set_ssrc(remote_ssrc_);
   request.set_bitrate_bps(tmmbr_send_ * 1000);
   request.set_packet_overhead(packet_oh_send_);
-  tmmbr->WithTmmbr(request);
+  tmmbr.WithTmmbr(request);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(tmmbr);
+  container->Append(tmmbr);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBN(
-    const RtcpContext& ctx) {
-  rtcp::Tmmbn* tmmbn = new rtcp::Tmmbn();
-  tmmbn->From(ssrc_);
+bool RTCPSender::BuildTMMBN(const RtcpContext& ctx,
+                            PacketContainer* container) {
+  rtcp::Tmmbn tmmbn;
+  tmmbn.From(ssrc_);
   for (const rtcp::TmmbItem& tmmbr : tmmbn_to_send_) {
     if (tmmbr.bitrate_bps() > 0) {
-      tmmbn->WithTmmbr(tmmbr);
+      tmmbn.WithTmmbr(tmmbr);
     }
   }
 
-  return std::unique_ptr<rtcp::RtcpPacket>(tmmbn);
+  container->Append(tmmbn);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildAPP(const RtcpContext& ctx) {
-  rtcp::App* app = new rtcp::App();
-  app->From(ssrc_);
-  app->WithSubType(app_sub_type_);
-  app->WithName(app_name_);
-  app->WithData(app_data_.get(), app_length_);
+bool RTCPSender::BuildAPP(const RtcpContext& ctx,
+                          PacketContainer* container) {
+  rtcp::App app;
+  app.From(ssrc_);
+  app.WithSubType(app_sub_type_);
+  app.WithName(app_name_);
+  app.WithData(app_data_.get(), app_length_);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(app);
+  container->Append(app);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildNACK(
-    const RtcpContext& ctx) {
-  rtcp::Nack* nack = new rtcp::Nack();
-  nack->From(ssrc_);
-  nack->To(remote_ssrc_);
-  nack->WithList(ctx.nack_list_, ctx.nack_size_);
+bool RTCPSender::BuildNACK(const RtcpContext& ctx,
+                           PacketContainer* container) {
+  rtcp::Nack nack;
+  nack.From(ssrc_);
+  nack.To(remote_ssrc_);
+  nack.WithList(ctx.nack_list_, ctx.nack_size_);
 
   // Report stats.
   NACKStringBuilder stringBuilder;
@@ -684,61 +722,67 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildNACK(
   TRACE_COUNTER_ID1(TRACE_DISABLED_BY_DEFAULT("webrtc_rtp"), "RTCP_NACKCount",
                     ssrc_, packet_type_counter_.nack_packets);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(nack);
+  container->Append(nack);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildBYE(const RtcpContext& ctx) {
-  rtcp::Bye* bye = new rtcp::Bye();
-  bye->From(ssrc_);
+bool RTCPSender::BuildBYE(const RtcpContext& ctx,
+                          PacketContainer* container) {
+  rtcp::Bye bye;
+  bye.From(ssrc_);
   for (uint32_t csrc : csrcs_)
-    bye->WithCsrc(csrc);
+    bye.WithCsrc(csrc);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(bye);
+  container->Append(bye);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildReceiverReferenceTime(
-    const RtcpContext& ctx) {
+bool RTCPSender::BuildReceiverReferenceTime(const RtcpContext& ctx,
+                                            PacketContainer* container) {
 
-  rtcp::ExtendedReports* xr = new rtcp::ExtendedReports();
-  xr->From(ssrc_);
+  rtcp::ExtendedReports xr;
+  xr.From(ssrc_);
 
   rtcp::Rrtr rrtr;
   rrtr.WithNtp(NtpTime(ctx.ntp_sec_, ctx.ntp_frac_));
 
-  xr->WithRrtr(rrtr);
+  xr.WithRrtr(rrtr);
 
   // TODO(sprang): Merge XR report sending to contain all of RRTR, DLRR, VOIP?
 
-  return std::unique_ptr<rtcp::RtcpPacket>(xr);
+  container->Append(xr);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildDlrr(
-    const RtcpContext& ctx) {
-  rtcp::ExtendedReports* xr = new rtcp::ExtendedReports();
-  xr->From(ssrc_);
+bool RTCPSender::BuildDlrr(const RtcpContext& ctx,
+                           PacketContainer* container) {
+  rtcp::ExtendedReports xr;
+  xr.From(ssrc_);
 
   rtcp::Dlrr dlrr;
   const RtcpReceiveTimeInfo& info = ctx.feedback_state_.last_xr_rr;
   dlrr.WithDlrrItem(info.sourceSSRC, info.lastRR, info.delaySinceLastRR);
 
-  xr->WithDlrr(dlrr);
+  xr.WithDlrr(dlrr);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(xr);
+  container->Append(xr);
+  return true;
 }
 
 // TODO(sprang): Add a unit test for this, or remove if the code isn't used.
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildVoIPMetric(
-    const RtcpContext& context) {
-  rtcp::ExtendedReports* xr = new rtcp::ExtendedReports();
-  xr->From(ssrc_);
+bool RTCPSender::BuildVoIPMetric(const RtcpContext& context,
+                                 PacketContainer* container) {
+  rtcp::ExtendedReports xr;
+  xr.From(ssrc_);
 
   rtcp::VoipMetric voip;
   voip.To(remote_ssrc_);
   voip.WithVoipMetric(xr_voip_metric_);
 
-  xr->WithVoipMetric(voip);
+  xr.WithVoipMetric(voip);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(xr);
+  container->Append(xr);
+  return true;
 }
 
 int32_t RTCPSender::SendRTCP(const FeedbackState& feedback_state,
@@ -759,7 +803,7 @@ int32_t RTCPSender::SendCompoundRTCP(
     const uint16_t* nack_list,
     bool repeat,
     uint64_t pictureID) {
-  PacketContainer container(transport_, event_log_);
+  PacketContainer container(transport_, event_log_, max_payload_length_);
   {
     rtc::CritScope lock(&critical_section_rtcp_sender_);
     if (method_ == RtcpMode::kOff) {
@@ -776,7 +820,7 @@ int32_t RTCPSender::SendCompoundRTCP(
 
     PrepareReport(packet_types, feedback_state);
 
-    std::unique_ptr<rtcp::RtcpPacket> packet_bye;
+    bool send_bye = false;
 
     auto it = report_flags_.begin();
     while (it != report_flags_.end()) {
@@ -788,23 +832,19 @@ int32_t RTCPSender::SendCompoundRTCP(
         ++it;
       }
 
-      BuilderFunc func = builder_it->second;
-      std::unique_ptr<rtcp::RtcpPacket> packet = (this->*func)(context);
-      if (packet.get() == nullptr)
-        return -1;
-      // If there is a BYE, don't append now - save it and append it
-      // at the end later.
+      // If there is a BYE, don't append now - build it at the end.
       if (builder_it->first == kRtcpBye) {
-        packet_bye = std::move(packet);
-      } else {
-        container.Append(packet.release());
+        send_bye = true;
+        continue;
       }
+      BuilderFunc func = builder_it->second;
+      if (!(this->*func)(context, &container))
+        return -1;
     }
 
     // Append the BYE now at the end
-    if (packet_bye) {
-      container.Append(packet_bye.release());
-    }
+    if (send_bye && !BuildBYE(context, &container))
+      return -1;
 
     if (packet_type_counter_observer_ != nullptr) {
       packet_type_counter_observer_->RtcpPacketTypesCounterUpdated(
@@ -814,7 +854,7 @@ int32_t RTCPSender::SendCompoundRTCP(
     RTC_DCHECK(AllVolatileFlagsConsumed());
   }
 
-  size_t bytes_sent = container.SendPackets(max_payload_length_);
+  size_t bytes_sent = container.SendPackets();
   return bytes_sent == 0 ? -1 : 0;
 }
 
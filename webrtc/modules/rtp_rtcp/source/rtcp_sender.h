@@ -153,6 +153,7 @@ class RTCPSender {
   bool SendFeedbackPacket(const rtcp::TransportFeedback& packet);
 
  private:
+  class PacketContainer;
   class RtcpContext;
 
   // Determine which RTCP messages should be sent and setup flags.
@@ -165,38 +166,38 @@ class RTCPSender {
                       StreamStatistician* statistician)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
 
-  std::unique_ptr<rtcp::RtcpPacket> BuildSR(const RtcpContext& context)
+  bool BuildSR(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildRR(const RtcpContext& context)
+  bool BuildRR(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildSDES(const RtcpContext& context)
+  bool BuildSDES(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildPLI(const RtcpContext& context)
+  bool BuildPLI(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildREMB(const RtcpContext& context)
+  bool BuildREMB(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildTMMBR(const RtcpContext& context)
+  bool BuildTMMBR(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildTMMBN(const RtcpContext& context)
+  bool BuildTMMBN(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildAPP(const RtcpContext& context)
+  bool BuildAPP(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildVoIPMetric(const RtcpContext& context)
+  bool BuildVoIPMetric(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildBYE(const RtcpContext& context)
+  bool BuildBYE(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildFIR(const RtcpContext& context)
+  bool BuildFIR(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildSLI(const RtcpContext& context)
+  bool BuildSLI(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildRPSI(const RtcpContext& context)
+  bool BuildRPSI(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildNACK(const RtcpContext& context)
+  bool BuildNACK(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildReceiverReferenceTime(
-      const RtcpContext& context)
+  bool BuildReceiverReferenceTime(const RtcpContext& context,
+                                  PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildDlrr(const RtcpContext& context)
+  bool BuildDlrr(const RtcpContext& context, PacketContainer* container)
       EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
 
  private:
@@ -287,8 +288,8 @@ class RTCPSender {
 
   std::set<ReportFlag> report_flags_ GUARDED_BY(critical_section_rtcp_sender_);
 
-  typedef std::unique_ptr<rtcp::RtcpPacket> (RTCPSender::*BuilderFunc)(
-      const RtcpContext&);
+  typedef bool (RTCPSender::*BuilderFunc)(const RtcpContext&,
+                                          PacketContainer*);
   std::map<RTCPPacketType, BuilderFunc> builders_;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RTCPSender);
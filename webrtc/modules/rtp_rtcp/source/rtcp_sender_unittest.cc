@@ -492,6 +492,25 @@ TEST_F(RtcpSenderTest, SendNack) {
   EXPECT_THAT(parser()->nack_item()->last_nack_list(), ElementsAre(0, 1, 16));
 }
 
+TEST_F(RtcpSenderTest, SendLongNackInSeveralPackets) {
+  rtcp_sender_->SetRTCPStatus(RtcpMode::kCompound);
+  rtcp_sender_->SetMaxPayloadLength(100);
+  // Sequence numbers too far apart to share a NACK item.
+  std::vector<uint16_t> nack_list;
+  for (uint16_t i = 0; i < 60; ++i)
+    nack_list.push_back(i * 20);
+  EXPECT_EQ(0, rtcp_sender_->SendRTCP(feedback_state(), kRtcpNack,
+                                      static_cast<int32_t>(nack_list.size()),
+                                      &nack_list[0]));
+  // The receiver report goes out first, and the NACK is split up in packets
+  // of at most 100 bytes.
+  EXPECT_EQ(1, parser()->receiver_report()->num_packets());
+  EXPECT_GT(parser()->nack()->num_packets(), 2);
+  EXPECT_EQ(nack_list.size(),
+            static_cast<size_t>(parser()->nack_item()->num_packets()));
+  EXPECT_EQ(nack_list.back(), parser()->nack_item()->last_nack_list().back());
+}
+
 TEST_F(RtcpSenderTest, SendRemb) {
   const int kBitrate = 261011;
   std::vector<uint32_t> ssrcs;
@@ -154,7 +154,8 @@ RtpPacketizerH264::RtpPacketizerH264(FrameType frame_type,
                                      size_t max_payload_len)
     : payload_data_(NULL),
       payload_size_(0),
-      max_payload_len_(max_payload_len) {
+      max_payload_len_(max_payload_len),
+      next_packet_(0) {
 }
 
 RtpPacketizerH264::~RtpPacketizerH264() {
@@ -173,6 +174,9 @@ void RtpPacketizerH264::SetPayloadData(
 }
 
 void RtpPacketizerH264::GeneratePackets() {
+  // Enough for all NALUs to be fragmented into full FU-A packets.
+  packets_.reserve(payload_size_ / (max_payload_len_ - kFuAHeaderSize) +
+                   fragmentation_.fragmentationVectorSize);
   for (size_t i = 0; i < fragmentation_.fragmentationVectorSize;) {
     size_t fragment_offset = fragmentation_.fragmentationOffset[i];
     size_t fragment_length = fragmentation_.fragmentationLength[i];
@@ -200,12 +204,12 @@ void RtpPacketizerH264::PacketizeFuA(size_t fragment_offset,
     if (fragment_length < avg_size)
       packet_length = fragment_length;
     uint8_t header = payload_data_[fragment_offset];
-    packets_.push(Packet(offset,
-                         packet_length,
-                         offset - kNalHeaderSize == fragment_offset,
-                         fragment_length == packet_length,
-                         false,
-                         header));
+    packets_.push_back(Packet(offset,
+                              packet_length,
+                              offset - kNalHeaderSize == fragment_offset,
+                              fragment_length == packet_length,
+                              false,
+                              header));
     offset += packet_length;
     fragment_length -= packet_length;
   }
@@ -222,12 +226,12 @@ int RtpPacketizerH264::PacketizeStapA(size_t fragment_index,
   while (payload_size_left >= fragment_length + fragment_headers_length) {
     assert(fragment_length > 0);
     uint8_t header = payload_data_[fragment_offset];
-    packets_.push(Packet(fragment_offset,
-                         fragment_length,
-                         aggregated_fragments == 0,
-                         false,
-                         true,
-                         header));
+    packets_.push_back(Packet(fragment_offset,
+                              fragment_length,
+                              aggregated_fragments == 0,
+                              false,
+                              true,
+                              header));
     payload_size_left -= fragment_length;
     payload_size_left -= fragment_headers_length;
 
@@ -254,81 +258,77 @@ bool RtpPacketizerH264::NextPacket(uint8_t* buffer,
                                    size_t* bytes_to_send,
                                    bool* last_packet) {
   *bytes_to_send = 0;
-  if (packets_.empty()) {
+  if (next_packet_ == packets_.size()) {
     *bytes_to_send = 0;
     *last_packet = true;
     return false;
   }
 
-  Packet packet = packets_.front();
+  const Packet* packet = &packets_[next_packet_];
 
-  if (packet.first_fragment && packet.last_fragment) {
+  if (packet->first_fragment && packet->last_fragment) {
     // Single NAL unit packet.
-    *bytes_to_send = packet.size;
-    memcpy(buffer, &payload_data_[packet.offset], packet.size);
-    packets_.pop();
+    *bytes_to_send = packet->size;
+    memcpy(buffer, &payload_data_[packet->offset], packet->size);
+    ++next_packet_;
     assert(*bytes_to_send <= max_payload_len_);
-  } else if (packet.aggregated) {
+  } else if (packet->aggregated) {
     NextAggregatePacket(buffer, bytes_to_send);
     assert(*bytes_to_send <= max_payload_len_);
   } else {
     NextFragmentPacket(buffer, bytes_to_send);
     assert(*bytes_to_send <= max_payload_len_);
   }
-  *last_packet = packets_.empty();
+  *last_packet = next_packet_ == packets_.size();
   return true;
 }
 
 void RtpPacketizerH264::NextAggregatePacket(uint8_t* buffer,
                                             size_t* bytes_to_send) {
-  Packet packet = packets_.front();
-  assert(packet.first_fragment);
+  const Packet* packet = &packets_[next_packet_];
+  assert(packet->first_fragment);
   // STAP-A NALU header.
-  buffer[0] = (packet.header & (kFBit | kNriMask)) | kStapA;
+  buffer[0] = (packet->header & (kFBit | kNriMask)) | kStapA;
   int index = kNalHeaderSize;
   *bytes_to_send += kNalHeaderSize;
-  while (packet.aggregated) {
+  while (packet->aggregated) {
     // Add NAL unit length field.
-    ByteWriter<uint16_t>::WriteBigEndian(&buffer[index], packet.size);
+    ByteWriter<uint16_t>::WriteBigEndian(&buffer[index], packet->size);
     index += kLengthFieldSize;
     *bytes_to_send += kLengthFieldSize;
     // Add NAL unit.
-    memcpy(&buffer[index], &payload_data_[packet.offset], packet.size);
-    index += packet.size;
-    *bytes_to_send += packet.size;
-    packets_.pop();
-    if (packet.last_fragment)
+    memcpy(&buffer[index], &payload_data_[packet->offset], packet->size);
+    index += packet->size;
+    *bytes_to_send += packet->size;
+    ++next_packet_;
+    if (packet->last_fragment)
       break;
-    packet = packets_.front();
+    packet = &packets_[next_packet_];
   }
-  assert(packet.last_fragment);
+  assert(packet->last_fragment);
 }
 
 void RtpPacketizerH264::NextFragmentPacket(uint8_t* buffer,
                                            size_t* bytes_to_send) {
-  Packet packet = packets_.front();
+  const Packet* packet = &packets_[next_packet_];
   // NAL unit fragmented over multiple packets (FU-A).
   // We do not send original NALU header, so it will be replaced by the
   // FU indicator header of the first packet.
-  uint8_t fu_indicator = (packet.header & (kFBit | kNriMask)) | kFuA;
+  uint8_t fu_indicator = (packet->header & (kFBit | kNriMask)) | kFuA;
   uint8_t fu_header = 0;
 
   // S | E | R | 5 bit type.
-  fu_header |= (packet.first_fragment ? kSBit : 0);
-  fu_header |= (packet.last_fragment ? kEBit : 0);
-  uint8_t type = packet.header & kTypeMask;
+  fu_header |= (packet->first_fragment ? kSBit : 0);
+  fu_header |= (packet->last_fragment ? kEBit : 0);
+  uint8_t type = packet->header & kTypeMask;
   fu_header |= type;
   buffer[0] = fu_indicator;
   buffer[1] = fu_header;
 
-  if (packet.last_fragment) {
-    *bytes_to_send = packet.size + kFuAHeaderSize;
-    memcpy(buffer + kFuAHeaderSize, &payload_data_[packet.offset], packet.size);
-  } else {
-    *bytes_to_send = packet.size + kFuAHeaderSize;
-    memcpy(buffer + kFuAHeaderSize, &payload_data_[packet.offset], packet.size);
-  }
-  packets_.pop();
+  *bytes_to_send = packet->size + kFuAHeaderSize;
+  memcpy(buffer + kFuAHeaderSize, &payload_data_[packet->offset],
+         packet->size);
+  ++next_packet_;
 }
 
 ProtectionType RtpPacketizerH264::GetProtectionType() {
@@ -11,8 +11,8 @@
 #ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H264_H_
 #define WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H264_H_
 
-#include <queue>
 #include <string>
+#include <vector>
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_format.h"
@@ -70,8 +70,6 @@ class RtpPacketizerH264 : public RtpPacketizer {
     bool aggregated;
     uint8_t header;
   };
-  typedef std::queue<Packet> PacketQueue;
-
   void GeneratePackets();
   void PacketizeFuA(size_t fragment_offset, size_t fragment_length);
   int PacketizeStapA(size_t fragment_index,
@@ -84,7 +82,10 @@ class RtpPacketizerH264 : public RtpPacketizer {
   size_t payload_size_;
   const size_t max_payload_len_;
   RTPFragmentationHeader fragmentation_;
-  PacketQueue packets_;
+  // The layout of all packets of the frame, computed in SetPayloadData().
+  std::vector<Packet> packets_;
+  // Index in |packets_| of the next packet to write.
+  size_t next_packet_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtpPacketizerH264);
 };
@@ -72,6 +72,9 @@ class RtpHeaderExtensionMap {
  public:
   static constexpr RTPExtensionType kInvalidType = kRtpExtensionNone;
   static constexpr uint8_t kInvalidId = 0;
+  // One-byte header extension ids are in [kMinId, kMaxId]; 15 is reserved.
+  static constexpr uint8_t kMinId = 1;
+  static constexpr uint8_t kMaxId = 14;
   RtpHeaderExtensionMap();
   ~RtpHeaderExtensionMap();
 
@@ -91,8 +94,11 @@ class RtpHeaderExtensionMap {
   bool IsRegistered(RTPExtensionType type) const;
 
   int32_t GetType(const uint8_t id, RTPExtensionType* type) const;
-  // Return kInvalidType if not found.
-  RTPExtensionType GetType(uint8_t id) const;
+  // Return kInvalidType if not found. Inlined since it's called for every
+  // extension element of every parsed packet.
+  RTPExtensionType GetType(uint8_t id) const {
+    return id <= kMaxId ? types_[id] : kInvalidType;
+  }
 
   int32_t GetId(const RTPExtensionType type, uint8_t* id) const;
   // Return kInvalidId if not found.
@@ -117,6 +123,9 @@ class RtpHeaderExtensionMap {
  private:
   int32_t Register(const RTPExtensionType type, const uint8_t id, bool active);
   std::map<uint8_t, HeaderExtension*> extensionMap_;
+  // The type registered for each id, active or not, so that parsing doesn't
+  // have to search |extensionMap_|. kInvalidType for unregistered ids.
+  RTPExtensionType types_[kMaxId + 1];
 };
 }  // namespace webrtc
 
@@ -93,6 +93,20 @@ TEST_F(RtpHeaderExtensionTest, GetType) {
   EXPECT_EQ(kRtpExtensionTransmissionTimeOffset, typeOut);
 }
 
+TEST_F(RtpHeaderExtensionTest, GetTypeAfterDeregisterAndErase) {
+  EXPECT_EQ(kRtpExtensionNone, map_.GetType(kId));
+  EXPECT_EQ(kRtpExtensionNone, map_.GetType(15));
+
+  EXPECT_EQ(0, map_.RegisterInactive(kRtpExtensionAudioLevel, kId));
+  EXPECT_EQ(kRtpExtensionAudioLevel, map_.GetType(kId));
+  EXPECT_EQ(0, map_.Deregister(kRtpExtensionAudioLevel));
+  EXPECT_EQ(kRtpExtensionNone, map_.GetType(kId));
+
+  EXPECT_EQ(0, map_.Register(kRtpExtensionAbsoluteSendTime, kId));
+  map_.Erase();
+  EXPECT_EQ(kRtpExtensionNone, map_.GetType(kId));
+}
+
 TEST_F(RtpHeaderExtensionTest, GetId) {
   uint8_t idOut;
   EXPECT_EQ(-1, map_.GetId(kRtpExtensionTransmissionTimeOffset, &idOut));
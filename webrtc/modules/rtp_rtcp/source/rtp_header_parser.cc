@@ -50,13 +50,11 @@ bool RtpHeaderParserImpl::Parse(const uint8_t* packet,
   RtpUtility::RtpHeaderParser rtp_parser(packet, length);
   memset(header, 0, sizeof(*header));
 
-  RtpHeaderExtensionMap map;
-  {
-    rtc::CritScope cs(&critical_section_);
-    rtp_header_extension_map_.GetCopy(&map);
-  }
-
-  const bool valid_rtpheader = rtp_parser.Parse(header, &map);
+  // Parse with the lock held rather than on a copy of the map; copying
+  // allocates for each registered extension, on every packet.
+  rtc::CritScope cs(&critical_section_);
+  const bool valid_rtpheader =
+      rtp_parser.Parse(header, &rtp_header_extension_map_);
   if (!valid_rtpheader) {
     return false;
   }
@@ -0,0 +1,168 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_header_parser.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_header_extension.h"
+#include "webrtc/test/rtp_file_reader.h"
+#include "webrtc/test/testsupport/fileutils.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/test/testsupport/perf_timer.h"
+
+namespace webrtc {
+namespace {
+const int kNumIterations = 2000;
+
+enum {
+  kTransmissionTimeOffsetId = 1,
+  kAudioLevelId,
+  kAbsoluteSendTimeId,
+  kVideoRotationId,
+  kTransportSequenceNumberId,
+};
+
+typedef std::vector<uint8_t> Packet;
+
+std::vector<Packet> ReadPackets(const std::string& name) {
+  std::unique_ptr<test::RtpFileReader> reader(test::RtpFileReader::Create(
+      test::RtpFileReader::kRtpDump, test::ResourcePath(name, "rtp")));
+  std::vector<Packet> packets;
+  if (!reader)
+    return packets;
+  test::RtpPacket packet;
+  while (reader->NextPacket(&packet))
+    packets.push_back(Packet(packet.data, packet.data + packet.length));
+  return packets;
+}
+
+// Returns a copy of |packet| with a one-byte header extension block holding
+// all the extensions above. Packets that already have extensions are returned
+// as they are.
+Packet AddExtensions(const Packet& packet, uint16_t transport_sequence_number) {
+  const size_t kExtensionBlockSize = 20;
+  const size_t header_length = 12 + 4 * (packet[0] & 0x0f);
+  if (packet.size() < header_length || (packet[0] & 0x10))
+    return packet;
+  Packet extended(packet.begin(), packet.begin() + header_length);
+  extended[0] |= 0x10;
+  extended.resize(header_length + kExtensionBlockSize, 0);
+  uint8_t* block = &extended[header_length];
+  ByteWriter<uint16_t>::WriteBigEndian(&block[0], kRtpOneByteHeaderExtensionId);
+  ByteWriter<uint16_t>::WriteBigEndian(&block[2], kExtensionBlockSize / 4 - 1);
+  block[4] = (kTransmissionTimeOffsetId << 4) | 2;
+  ByteWriter<int32_t, 3>::WriteBigEndian(&block[5], 90);
+  block[8] = (kAudioLevelId << 4) | 0;
+  block[9] = 0x80 | 42;
+  block[10] = (kAbsoluteSendTimeId << 4) | 2;
+  ByteWriter<uint32_t, 3>::WriteBigEndian(&block[11], 0x123456);
+  block[14] = (kVideoRotationId << 4) | 0;
+  block[15] = 1;
+  block[16] = (kTransportSequenceNumberId << 4) | 1;
+  ByteWriter<uint16_t>::WriteBigEndian(&block[17],
+                                       transport_sequence_number);
+  // block[19] is padding.
+  extended.insert(extended.end(), packet.begin() + header_length,
+                  packet.end());
+  return extended;
+}
+
+// Checks |header|, parsed from |packet|. If |has_extensions|, |packet| holds
+// the extensions AddExtensions() writes.
+void VerifyHeader(const Packet& packet,
+                  bool has_extensions,
+                  uint16_t transport_sequence_number,
+                  const RTPHeader& header) {
+  EXPECT_EQ(packet[1] & 0x7f, header.payloadType);
+  EXPECT_EQ(ByteReader<uint16_t>::ReadBigEndian(&packet[2]),
+            header.sequenceNumber);
+  EXPECT_EQ(ByteReader<uint32_t>::ReadBigEndian(&packet[4]), header.timestamp);
+  EXPECT_EQ(ByteReader<uint32_t>::ReadBigEndian(&packet[8]), header.ssrc);
+  EXPECT_EQ(has_extensions, header.extension.hasTransmissionTimeOffset);
+  EXPECT_EQ(has_extensions, header.extension.hasAudioLevel);
+  EXPECT_EQ(has_extensions, header.extension.hasAbsoluteSendTime);
+  EXPECT_EQ(has_extensions, header.extension.hasVideoRotation);
+  EXPECT_EQ(has_extensions, header.extension.hasTransportSequenceNumber);
+  if (!has_extensions)
+    return;
+  EXPECT_EQ(90, header.extension.transmissionTimeOffset);
+  EXPECT_TRUE(header.extension.voiceActivity);
+  EXPECT_EQ(42, header.extension.audioLevel);
+  EXPECT_EQ(0x123456u, header.extension.absoluteSendTime);
+  EXPECT_EQ(1, header.extension.videoRotation);
+  EXPECT_EQ(transport_sequence_number,
+            header.extension.transportSequenceNumber);
+}
+
+// Returns the number of parsed packets per millisecond.
+size_t MeasureParsedPacketsPerMs(const std::vector<Packet>& packets,
+                                 bool register_extensions) {
+  std::unique_ptr<RtpHeaderParser> parser(RtpHeaderParser::Create());
+  if (register_extensions) {
+    parser->RegisterRtpHeaderExtension(kRtpExtensionTransmissionTimeOffset,
+                                       kTransmissionTimeOffsetId);
+    parser->RegisterRtpHeaderExtension(kRtpExtensionAudioLevel,
+                                       kAudioLevelId);
+    parser->RegisterRtpHeaderExtension(kRtpExtensionAbsoluteSendTime,
+                                       kAbsoluteSendTimeId);
+    parser->RegisterRtpHeaderExtension(kRtpExtensionVideoRotation,
+                                       kVideoRotationId);
+    parser->RegisterRtpHeaderExtension(kRtpExtensionTransportSequenceNumber,
+                                       kTransportSequenceNumberId);
+  }
+
+  uint64_t num_parsed = 0;
+  uint64_t num_with_extensions = 0;
+  const double passes_per_second = test::MeasureCallsPerSecond(
+      kNumIterations,
+      [&packets, &parser, &num_parsed, &num_with_extensions] {
+        for (const Packet& packet : packets) {
+          RTPHeader header;
+          num_parsed += parser->Parse(&packet[0], packet.size(), &header);
+          num_with_extensions += header.extension.hasTransportSequenceNumber;
+        }
+      });
+
+  const uint64_t num_packets = static_cast<uint64_t>(packets.size()) *
+                               kNumIterations;
+  EXPECT_EQ(num_packets, num_parsed);
+  EXPECT_EQ(register_extensions ? num_packets : 0u, num_with_extensions);
+  for (size_t i = 0; i < packets.size(); ++i) {
+    RTPHeader header;
+    EXPECT_TRUE(parser->Parse(&packets[i][0], packets[i].size(), &header));
+    VerifyHeader(packets[i], register_extensions, static_cast<uint16_t>(i),
+                 header);
+  }
+  return static_cast<size_t>(passes_per_second * packets.size() / 1000);
+}
+}  // namespace
+
+TEST(RtpHeaderParserPerformanceTest, ParseRtpDump) {
+  const std::vector<Packet> packets = ReadPackets("video_coding/pltype103");
+  ASSERT_FALSE(packets.empty());
+  std::vector<Packet> extended_packets;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    extended_packets.push_back(
+        AddExtensions(packets[i], static_cast<uint16_t>(i)));
+  }
+
+  test::PrintResult("rtp_header_parse", "", "no_extensions",
+                    MeasureParsedPacketsPerMs(packets, false), "packets/ms",
+                    false);
+  test::PrintResult("rtp_header_parse", "", "all_extensions",
+                    MeasureParsedPacketsPerMs(extended_packets, true),
+                    "packets/ms", true);
+}
+
+}  // namespace webrtc
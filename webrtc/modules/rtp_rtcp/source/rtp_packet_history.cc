@@ -26,10 +26,28 @@ namespace webrtc {
 
 static const int kMinPacketRequestBytes = 50;
 
+// Window for measuring the packet rate, and how often the history is resized
+// to match it.
+static const int64_t kPacketRateWindowMs = 1000;
+static const int64_t kResizeIntervalMs = 1000;
+
+// Packets are kept for at least this many round trip times, and at least
+// kMinHistoryDurationMs.
+static const int64_t kHistoryDurationRtts = 3;
+static const int64_t kMinHistoryDurationMs = 1000;
+
+static size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value)
+    result <<= 1;
+  return result;
+}
+
 RTPPacketHistory::RTPPacketHistory(Clock* clock)
     : clock_(clock),
       store_(false),
-      prev_index_(0) {}
+      rtt_ms_(0),
+      last_resize_time_ms_(0) {}
 
 RTPPacketHistory::~RTPPacketHistory() {
 }
@@ -53,7 +71,9 @@ void RTPPacketHistory::Allocate(size_t number_to_store) {
   assert(number_to_store > 0);
   assert(number_to_store <= kMaxHistoryCapacity);
   store_ = true;
-  stored_packets_.resize(number_to_store);
+  stored_packets_.resize(RoundUpToPowerOfTwo(number_to_store));
+  packet_rate_.reset(new RateStatistics(kPacketRateWindowMs, 1000));
+  last_resize_time_ms_ = clock_->TimeInMilliseconds();
 }
 
 void RTPPacketHistory::Free() {
@@ -62,9 +82,9 @@ void RTPPacketHistory::Free() {
   }
 
   stored_packets_.clear();
+  packet_rate_.reset();
 
   store_ = false;
-  prev_index_ = 0;
 }
 
 bool RTPPacketHistory::StorePackets() const {
@@ -72,6 +92,16 @@ bool RTPPacketHistory::StorePackets() const {
   return store_;
 }
 
+void RTPPacketHistory::SetRtt(int64_t rtt_ms) {
+  rtc::CritScope cs(&critsect_);
+  rtt_ms_ = rtt_ms;
+}
+
+size_t RTPPacketHistory::capacity() const {
+  rtc::CritScope cs(&critsect_);
+  return stored_packets_.size();
+}
+
 int32_t RTPPacketHistory::PutRTPPacket(const uint8_t* packet,
                                        size_t packet_length,
                                        int64_t capture_time_ms,
@@ -92,40 +122,81 @@ int32_t RTPPacketHistory::PutRTPPacket(const uint8_t* packet,
 
   const uint16_t seq_num = (packet[2] << 8) + packet[3];
 
-  // If index we're about to overwrite contains a packet that has not
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  packet_rate_->Update(1, now_ms);
+  MaybeResize(now_ms);
+
+  // If the entry we're about to overwrite contains a packet that has not
   // yet been sent (probably pending in paced sender), we need to expand
-  // the buffer.
-  if (stored_packets_[prev_index_].length > 0 &&
-      stored_packets_[prev_index_].send_time == 0) {
-    size_t current_size = static_cast<uint16_t>(stored_packets_.size());
-    if (current_size < kMaxHistoryCapacity) {
-      size_t expanded_size = std::max(current_size * 3 / 2, current_size + 1);
-      expanded_size = std::min(expanded_size, kMaxHistoryCapacity);
-      Allocate(expanded_size);
-      // Causes discontinuity, but that's OK-ish. FindSeqNum() will still work,
-      // but may be slower - at least until buffer has wrapped around once.
-      prev_index_ = current_size;
+  // the ring.
+  size_t index = seq_num & (stored_packets_.size() - 1);
+  while (stored_packets_[index].packet.size() > 0 &&
+         stored_packets_[index].send_time == 0 &&
+         stored_packets_[index].sequence_number != seq_num &&
+         stored_packets_.size() < kMaxHistoryCapacity) {
+    Resize(stored_packets_.size() * 2);
+    index = seq_num & (stored_packets_.size() - 1);
+  }
+
+  // Store packet. The entry's previous storage is reused unless it is still
+  // referenced by a packet being sent.
+  StoredPacket& stored_packet = stored_packets_[index];
+  stored_packet.packet.SetData(packet, packet_length);
+
+  stored_packet.sequence_number = seq_num;
+  stored_packet.time_ms =
+      (capture_time_ms > 0) ? capture_time_ms : now_ms;
+  stored_packet.send_time = 0;  // Packet not sent.
+  stored_packet.storage_type = type;
+  stored_packet.has_been_retransmitted = false;
+  return 0;
+}
+
+bool RTPPacketHistory::Resize(size_t capacity) {
+  RTC_DCHECK_EQ(0u, capacity & (capacity - 1));
+  bool shrinking = capacity < stored_packets_.size();
+  std::vector<StoredPacket> packets(capacity);
+  for (StoredPacket& stored_packet : stored_packets_) {
+    if (stored_packet.packet.size() == 0)
+      continue;
+    StoredPacket& slot =
+        packets[stored_packet.sequence_number & (capacity - 1)];
+    if (slot.packet.size() > 0) {
+      // Only possible when shrinking. Keep the newer packet, unless that would
+      // drop a packet that's still waiting to be sent.
+      RTC_DCHECK(shrinking);
+      if (slot.send_time == 0 || stored_packet.send_time == 0)
+        return false;
+      if (!IsNewerSequenceNumber(stored_packet.sequence_number,
+                                 slot.sequence_number)) {
+        continue;
+      }
     }
+    // Copying only shares the packet data.
+    slot = stored_packet;
   }
+  stored_packets_.swap(packets);
+  return true;
+}
 
-  // Store packet
-  // TODO(sprang): Overhaul this class and get rid of this copy step.
-  //               (Finally introduce the RtpPacket class?)
-  memcpy(stored_packets_[prev_index_].data, packet, packet_length);
-  stored_packets_[prev_index_].length = packet_length;
-
-  stored_packets_[prev_index_].sequence_number = seq_num;
-  stored_packets_[prev_index_].time_ms =
-      (capture_time_ms > 0) ? capture_time_ms : clock_->TimeInMilliseconds();
-  stored_packets_[prev_index_].send_time = 0;  // Packet not sent.
-  stored_packets_[prev_index_].storage_type = type;
-  stored_packets_[prev_index_].has_been_retransmitted = false;
-
-  ++prev_index_;
-  if (prev_index_ >= stored_packets_.size()) {
-    prev_index_ = 0;
+void RTPPacketHistory::MaybeResize(int64_t now_ms) {
+  if (now_ms - last_resize_time_ms_ < kResizeIntervalMs)
+    return;
+  last_resize_time_ms_ = now_ms;
+
+  int64_t duration_ms =
+      std::max(kMinHistoryDurationMs, kHistoryDurationRtts * rtt_ms_);
+  size_t needed = static_cast<size_t>(
+      packet_rate_->Rate(now_ms) * duration_ms / 1000);
+  size_t capacity = RoundUpToPowerOfTwo(needed);
+  capacity = std::min(std::max(capacity, kMinHistoryCapacity),
+                      kMaxHistoryCapacity);
+  // Only shrink once the needed size has dropped well below the current one,
+  // to avoid resizing back and forth.
+  if (capacity > stored_packets_.size() ||
+      capacity * 4 <= stored_packets_.size()) {
+    Resize(capacity);
   }
-  return 0;
 }
 
 bool RTPPacketHistory::HasRTPPacket(uint16_t sequence_number) const {
@@ -140,7 +211,7 @@ bool RTPPacketHistory::HasRTPPacket(uint16_t sequence_number) const {
     return false;
   }
 
-  if (stored_packets_[index].length == 0) {
+  if (stored_packets_[index].packet.size() == 0) {
     // Invalid length.
     return false;
   }
@@ -174,8 +245,23 @@ bool RTPPacketHistory::GetPacketAndSetSendTime(uint16_t sequence_number,
                                                uint8_t* packet,
                                                size_t* packet_length,
                                                int64_t* stored_time_ms) {
-  rtc::CritScope cs(&critsect_);
   RTC_CHECK_GE(*packet_length, static_cast<size_t>(IP_PACKET_SIZE));
+  rtc::CopyOnWriteBuffer stored_packet;
+  if (!GetPacketAndSetSendTime(sequence_number, min_elapsed_time_ms,
+                               retransmit, &stored_packet, stored_time_ms)) {
+    return false;
+  }
+  memcpy(packet, stored_packet.cdata(), stored_packet.size());
+  *packet_length = stored_packet.size();
+  return true;
+}
+
+bool RTPPacketHistory::GetPacketAndSetSendTime(uint16_t sequence_number,
+                                               int64_t min_elapsed_time_ms,
+                                               bool retransmit,
+                                               rtc::CopyOnWriteBuffer* packet,
+                                               int64_t* stored_time_ms) {
+  rtc::CritScope cs(&critsect_);
   if (!store_)
     return false;
 
@@ -186,7 +272,7 @@ bool RTPPacketHistory::GetPacketAndSetSendTime(uint16_t sequence_number,
     return false;
   }
 
-  size_t length = stored_packets_[index].length;
+  size_t length = stored_packets_[index].packet.size();
   assert(length <= IP_PACKET_SIZE);
   if (length == 0) {
     LOG(LS_WARNING) << "No match for getting seqNum " << sequence_number
@@ -212,67 +298,50 @@ bool RTPPacketHistory::GetPacketAndSetSendTime(uint16_t sequence_number,
     stored_packets_[index].has_been_retransmitted = true;
   }
   stored_packets_[index].send_time = clock_->TimeInMilliseconds();
-  GetPacket(index, packet, packet_length, stored_time_ms);
+  GetPacket(index, packet, stored_time_ms);
   return true;
 }
 
 void RTPPacketHistory::GetPacket(int index,
-                                 uint8_t* packet,
-                                 size_t* packet_length,
+                                 rtc::CopyOnWriteBuffer* packet,
                                  int64_t* stored_time_ms) const {
-  // Get packet.
-  size_t length = stored_packets_[index].length;
-  memcpy(packet, stored_packets_[index].data, length);
-  *packet_length = length;
+  // Share the stored data, it is only copied if either side modifies it.
+  *packet = stored_packets_[index].packet;
   *stored_time_ms = stored_packets_[index].time_ms;
 }
 
 bool RTPPacketHistory::GetBestFittingPacket(uint8_t* packet,
                                             size_t* packet_length,
                                             int64_t* stored_time_ms) {
+  rtc::CopyOnWriteBuffer stored_packet;
+  if (!GetBestFittingPacket(*packet_length, &stored_packet, stored_time_ms))
+    return false;
+  memcpy(packet, stored_packet.cdata(), stored_packet.size());
+  *packet_length = stored_packet.size();
+  return true;
+}
+
+bool RTPPacketHistory::GetBestFittingPacket(size_t packet_length,
+                                            rtc::CopyOnWriteBuffer* packet,
+                                            int64_t* stored_time_ms) {
   rtc::CritScope cs(&critsect_);
   if (!store_)
     return false;
-  int index = FindBestFittingPacket(*packet_length);
+  int index = FindBestFittingPacket(packet_length);
   if (index < 0)
     return false;
-  GetPacket(index, packet, packet_length, stored_time_ms);
+  GetPacket(index, packet, stored_time_ms);
   return true;
 }
 
 // private, lock should already be taken
 bool RTPPacketHistory::FindSeqNum(uint16_t sequence_number,
                                   int32_t* index) const {
-  uint16_t temp_sequence_number = 0;
-  if (prev_index_ > 0) {
-    *index = prev_index_ - 1;
-    temp_sequence_number = stored_packets_[*index].sequence_number;
-  } else {
-    *index = stored_packets_.size() - 1;
-    temp_sequence_number = stored_packets_[*index].sequence_number;  // wrap
-  }
-
-  int32_t idx = (prev_index_ - 1) - (temp_sequence_number - sequence_number);
-  if (idx >= 0 && idx < static_cast<int>(stored_packets_.size())) {
-    *index = idx;
-    temp_sequence_number = stored_packets_[*index].sequence_number;
-  }
-
-  if (temp_sequence_number != sequence_number) {
-    // We did not found a match, search all.
-    for (uint16_t m = 0; m < stored_packets_.size(); m++) {
-      if (stored_packets_[m].sequence_number == sequence_number) {
-        *index = m;
-        temp_sequence_number = stored_packets_[*index].sequence_number;
-        break;
-      }
-    }
-  }
-  if (temp_sequence_number == sequence_number) {
-    // We found a match.
-    return true;
-  }
-  return false;
+  if (stored_packets_.empty())
+    return false;
+  *index = sequence_number & (stored_packets_.size() - 1);
+  return stored_packets_[*index].packet.size() > 0 &&
+         stored_packets_[*index].sequence_number == sequence_number;
 }
 
 int RTPPacketHistory::FindBestFittingPacket(size_t size) const {
@@ -281,11 +350,10 @@ int RTPPacketHistory::FindBestFittingPacket(size_t size) const {
   size_t min_diff = std::numeric_limits<size_t>::max();
   int best_index = -1;  // Returned unchanged if we don't find anything.
   for (size_t i = 0; i < stored_packets_.size(); ++i) {
-    if (stored_packets_[i].length == 0)
+    size_t length = stored_packets_[i].packet.size();
+    if (length == 0)
       continue;
-    size_t diff = (stored_packets_[i].length > size)
-                      ? (stored_packets_[i].length - size)
-                      : (size - stored_packets_[i].length);
+    size_t diff = (length > size) ? (length - size) : (size - length);
     if (diff < min_diff) {
       min_diff = diff;
       best_index = static_cast<int>(i);
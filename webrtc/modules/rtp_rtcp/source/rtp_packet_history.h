@@ -13,9 +13,12 @@
 #ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
+#include <memory>
 #include <vector>
 
+#include "webrtc/base/copyonwritebuffer.h"
 #include "webrtc/base/criticalsection.h"
+#include "webrtc/base/rate_statistics.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
@@ -25,17 +28,32 @@ namespace webrtc {
 
 class Clock;
 
-static const size_t kMaxHistoryCapacity = 9600;
+// Bounds of the number of stored packets, both must be powers of two.
+static const size_t kMinHistoryCapacity = 128;
+static const size_t kMaxHistoryCapacity = 16384;
+
+// Packets are stored in a ring indexed by sequence number, so lookups are
+// constant time. The ring grows when a packet would overwrite one that hasn't
+// been sent yet, and is resized periodically to hold the packets sent during
+// the last few round trip times, so memory is released when the stream's
+// packet rate drops.
 
 class RTPPacketHistory {
  public:
   explicit RTPPacketHistory(Clock* clock);
   ~RTPPacketHistory();
 
+  // |number_to_store| is the initial capacity, rounded up to a power of two.
   void SetStorePacketsStatus(bool enable, uint16_t number_to_store);
 
   bool StorePackets() const;
 
+  // Used together with the measured packet rate to size the history.
+  void SetRtt(int64_t rtt_ms);
+
+  // Number of packets that can currently be stored.
+  size_t capacity() const;
+
   // Stores RTP packet.
   int32_t PutRTPPacket(const uint8_t* packet,
                        size_t packet_length,
@@ -59,23 +77,39 @@ class RTPPacketHistory {
                                size_t* packet_length,
                                int64_t* stored_time_ms);
 
+  // Same as above, but returns a reference to the stored packet in |packet|
+  // instead of copying it. The stored data is shared until either copy is
+  // modified.
+  bool GetPacketAndSetSendTime(uint16_t sequence_number,
+                               int64_t min_elapsed_time_ms,
+                               bool retransmit,
+                               rtc::CopyOnWriteBuffer* packet,
+                               int64_t* stored_time_ms);
+
   bool GetBestFittingPacket(uint8_t* packet, size_t* packet_length,
                             int64_t* stored_time_ms);
 
+  // Returns a reference to the stored packet with the length closest to
+  // |packet_length|.
+  bool GetBestFittingPacket(size_t packet_length,
+                            rtc::CopyOnWriteBuffer* packet,
+                            int64_t* stored_time_ms);
+
   bool HasRTPPacket(uint16_t sequence_number) const;
 
   bool SetSent(uint16_t sequence_number);
 
  private:
   void GetPacket(int index,
-                 uint8_t* packet,
-                 size_t* packet_length,
+                 rtc::CopyOnWriteBuffer* packet,
                  int64_t* stored_time_ms) const
       EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   void Allocate(size_t number_to_store) EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   void Free() EXCLUSIVE_LOCKS_REQUIRED(critsect_);
-  void VerifyAndAllocatePacketLength(size_t packet_length, uint32_t start_index)
-      EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  // Moves the stored packets to a ring of |capacity| entries. Returns false,
+  // leaving the ring unchanged, if shrinking would drop unsent packets.
+  bool Resize(size_t capacity) EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  void MaybeResize(int64_t now_ms) EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   bool FindSeqNum(uint16_t sequence_number, int32_t* index) const
       EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   int FindBestFittingPacket(size_t size) const
@@ -85,7 +119,10 @@ class RTPPacketHistory {
   Clock* clock_;
   rtc::CriticalSection critsect_;
   bool store_ GUARDED_BY(critsect_);
-  uint32_t prev_index_ GUARDED_BY(critsect_);
+  int64_t rtt_ms_ GUARDED_BY(critsect_);
+  // Only allocated while packets are stored.
+  std::unique_ptr<RateStatistics> packet_rate_ GUARDED_BY(critsect_);
+  int64_t last_resize_time_ms_ GUARDED_BY(critsect_);
 
   struct StoredPacket {
     StoredPacket();
@@ -95,9 +132,11 @@ class RTPPacketHistory {
     StorageType storage_type = kDontRetransmit;
     bool has_been_retransmitted = false;
 
-    uint8_t data[IP_PACKET_SIZE];
-    size_t length = 0;
+    // Only as large as the stored packet, and shared with the packets handed
+    // out by GetPacketAndSetSendTime() and GetBestFittingPacket().
+    rtc::CopyOnWriteBuffer packet;
   };
+  // Indexed by sequence number modulo the size, which is a power of two.
   std::vector<StoredPacket> stored_packets_ GUARDED_BY(critsect_);
 };
 }  // namespace webrtc
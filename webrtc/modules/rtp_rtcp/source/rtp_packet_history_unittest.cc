@@ -122,6 +122,35 @@ TEST_F(RtpPacketHistoryTest, GetRtpPacket) {
   }
 }
 
+TEST_F(RtpPacketHistoryTest, GetSharedRtpPacket) {
+  hist_->SetStorePacketsStatus(true, 10);
+  size_t len = 0;
+  int64_t capture_time_ms = 1;
+  CreateRtpPacket(kSeqNum, kSsrc, kPayload, kTimestamp, packet_, &len);
+  EXPECT_EQ(0, hist_->PutRTPPacket(packet_, len, capture_time_ms,
+                                   kAllowRetransmission));
+
+  rtc::CopyOnWriteBuffer first;
+  rtc::CopyOnWriteBuffer second;
+  int64_t time;
+  EXPECT_TRUE(hist_->GetPacketAndSetSendTime(kSeqNum, 0, false, &first,
+                                             &time));
+  EXPECT_EQ(capture_time_ms, time);
+  EXPECT_TRUE(hist_->GetPacketAndSetSendTime(kSeqNum, 0, false, &second,
+                                             &time));
+  ASSERT_EQ(len, first.size());
+  EXPECT_EQ(0, memcmp(packet_, first.cdata(), len));
+  // Both refer to the same stored data.
+  EXPECT_EQ(first.cdata(), second.cdata());
+
+  // Modifying a retrieved packet doesn't change the stored packet.
+  first.data()[1] = kPayload - 1;
+  EXPECT_NE(first.cdata(), second.cdata());
+  EXPECT_TRUE(hist_->GetPacketAndSetSendTime(kSeqNum, 0, false, &second,
+                                             &time));
+  EXPECT_EQ(kPayload, second.cdata()[1]);
+}
+
 TEST_F(RtpPacketHistoryTest, NoCaptureTime) {
   hist_->SetStorePacketsStatus(true, 10);
   size_t len = 0;
@@ -287,4 +316,99 @@ TEST_F(RtpPacketHistoryTest, FullExpansion) {
   }
 }
 
+TEST_F(RtpPacketHistoryTest, LookupAfterSequenceNumberWrap) {
+  hist_->SetStorePacketsStatus(true, 10);
+  size_t len;
+  int64_t capture_time_ms = fake_clock_.TimeInMilliseconds();
+  int64_t time;
+  const uint16_t kStartSeqNum = 0xFFF8;
+  for (uint16_t i = 0; i < 16; ++i) {
+    len = 0;
+    CreateRtpPacket(kStartSeqNum + i, kSsrc, kPayload, kTimestamp, packet_,
+                    &len);
+    EXPECT_EQ(0, hist_->PutRTPPacket(packet_, len, capture_time_ms,
+                                     kAllowRetransmission));
+  }
+  EXPECT_EQ(16u, hist_->capacity());
+  for (uint16_t i = 0; i < 16; ++i) {
+    len = kMaxPacketLength;
+    EXPECT_TRUE(hist_->GetPacketAndSetSendTime(kStartSeqNum + i, 0, false,
+                                               packet_, &len, &time));
+    EXPECT_EQ(static_cast<uint16_t>(kStartSeqNum + i),
+              (packet_[2] << 8) + packet_[3]);
+  }
+  EXPECT_FALSE(hist_->HasRTPPacket(static_cast<uint16_t>(kStartSeqNum - 1)));
+  EXPECT_FALSE(hist_->HasRTPPacket(static_cast<uint16_t>(kStartSeqNum + 16)));
+}
+
+TEST_F(RtpPacketHistoryTest, ShrinksWhenPacketRateDrops) {
+  hist_->SetStorePacketsStatus(true, 4096);
+  EXPECT_EQ(4096u, hist_->capacity());
+  size_t len;
+  int64_t time;
+
+  // Send 10 packets per second for two seconds.
+  for (int i = 0; i < 20; ++i) {
+    len = 0;
+    CreateRtpPacket(kSeqNum + i, kSsrc, kPayload, kTimestamp, packet_, &len);
+    EXPECT_EQ(0, hist_->PutRTPPacket(packet_, len, -1, kAllowRetransmission));
+    EXPECT_TRUE(hist_->SetSent(kSeqNum + i));
+    fake_clock_.AdvanceTimeMilliseconds(100);
+  }
+  EXPECT_EQ(kMinHistoryCapacity, hist_->capacity());
+
+  // Recent packets are kept.
+  for (int i = 0; i < 20; ++i) {
+    len = kMaxPacketLength;
+    EXPECT_TRUE(hist_->GetPacketAndSetSendTime(kSeqNum + i, 0, false, packet_,
+                                               &len, &time));
+  }
+}
+
+TEST_F(RtpPacketHistoryTest, DoesntShrinkOverUnsentPackets) {
+  hist_->SetStorePacketsStatus(true, 4096);
+  // Two packets pending in the pacer, which would collide in a smaller
+  // history.
+  size_t len = 0;
+  CreateRtpPacket(kSeqNum, kSsrc, kPayload, kTimestamp, packet_, &len);
+  EXPECT_EQ(0, hist_->PutRTPPacket(packet_, len, -1, kAllowRetransmission));
+  len = 0;
+  CreateRtpPacket(kSeqNum + kMinHistoryCapacity, kSsrc, kPayload, kTimestamp,
+                  packet_, &len);
+  EXPECT_EQ(0, hist_->PutRTPPacket(packet_, len, -1, kAllowRetransmission));
+
+  fake_clock_.AdvanceTimeMilliseconds(1000);
+  len = 0;
+  CreateRtpPacket(kSeqNum + 1, kSsrc, kPayload, kTimestamp, packet_, &len);
+  EXPECT_EQ(0, hist_->PutRTPPacket(packet_, len, -1, kAllowRetransmission));
+  EXPECT_EQ(4096u, hist_->capacity());
+  EXPECT_TRUE(hist_->HasRTPPacket(kSeqNum));
+  EXPECT_TRUE(hist_->HasRTPPacket(kSeqNum + kMinHistoryCapacity));
+  EXPECT_TRUE(hist_->HasRTPPacket(kSeqNum + 1));
+}
+
+TEST_F(RtpPacketHistoryTest, GrowsWithRttAndPacketRate) {
+  hist_->SetStorePacketsStatus(true, 600);
+  EXPECT_EQ(1024u, hist_->capacity());
+  hist_->SetRtt(1000);
+  size_t len;
+  int64_t time;
+
+  // Send 500 packets per second for two seconds. Three round trip times need
+  // 1500 packets to be stored.
+  for (int i = 0; i < 1000; ++i) {
+    len = 0;
+    CreateRtpPacket(kSeqNum + i, kSsrc, kPayload, kTimestamp, packet_, &len);
+    EXPECT_EQ(0, hist_->PutRTPPacket(packet_, len, -1, kAllowRetransmission));
+    EXPECT_TRUE(hist_->SetSent(kSeqNum + i));
+    fake_clock_.AdvanceTimeMilliseconds(2);
+  }
+  EXPECT_EQ(2048u, hist_->capacity());
+  for (int i = 0; i < 1000; ++i) {
+    len = kMaxPacketLength;
+    EXPECT_TRUE(hist_->GetPacketAndSetSendTime(kSeqNum + i, 0, false, packet_,
+                                               &len, &time));
+  }
+}
+
 }  // namespace webrtc
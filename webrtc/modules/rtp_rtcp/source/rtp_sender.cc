@@ -10,7 +10,8 @@
 
 #include "webrtc/modules/rtp_rtcp/source/rtp_sender.h"
 
-#include <stdlib.h>  // srand
+#include <string.h>
+
 #include <algorithm>
 #include <utility>
 
@@ -167,10 +168,6 @@ RTPSender::RTPSender(
       target_bitrate_(0) {
   memset(nack_byte_count_times_, 0, sizeof(nack_byte_count_times_));
   memset(nack_byte_count_, 0, sizeof(nack_byte_count_));
-  // We need to seed the random generator for BuildPaddingPacket() below.
-  // TODO(holmer,tommi): Note that TimeInMilliseconds might return 0 on Mac
-  // early on in the process.
-  srand(static_cast<uint32_t>(clock_->TimeInMilliseconds()));
   ssrc_ = ssrc_db_->CreateSSRC();
   RTC_DCHECK(ssrc_ != 0);
   ssrc_rtx_ = ssrc_db_->CreateSSRC();
@@ -552,21 +549,20 @@ size_t RTPSender::TrySendRedundantPayloads(size_t bytes_to_send) {
       return 0;
   }
 
-  uint8_t buffer[IP_PACKET_SIZE];
   int bytes_left = static_cast<int>(bytes_to_send);
   while (bytes_left > 0) {
-    size_t length = bytes_left;
+    rtc::CopyOnWriteBuffer packet;
     int64_t capture_time_ms;
-    if (!packet_history_.GetBestFittingPacket(buffer, &length,
+    if (!packet_history_.GetBestFittingPacket(bytes_left, &packet,
                                               &capture_time_ms)) {
       break;
     }
-    if (!PrepareAndSendPacket(buffer, length, capture_time_ms, true, false))
+    if (!PrepareAndSendPacket(packet, capture_time_ms, true, false))
       break;
-    RtpUtility::RtpHeaderParser rtp_parser(buffer, length);
+    RtpUtility::RtpHeaderParser rtp_parser(packet.cdata(), packet.size());
     RTPHeader rtp_header;
     rtp_parser.Parse(&rtp_header);
-    bytes_left -= static_cast<int>(length - rtp_header.headerLength);
+    bytes_left -= static_cast<int>(packet.size() - rtp_header.headerLength);
   }
   return bytes_to_send - bytes_left;
 }
@@ -575,12 +571,9 @@ void RTPSender::BuildPaddingPacket(uint8_t* packet,
                                    size_t header_length,
                                    size_t padding_length) {
   packet[0] |= 0x20;  // Set padding bit.
-  int32_t* data = reinterpret_cast<int32_t*>(&(packet[header_length]));
-
-  // Fill data buffer with random data.
-  for (size_t j = 0; j < (padding_length >> 2); ++j) {
-    data[j] = rand();  // NOLINT
-  }
+  // The padding content is ignored by the receiver, so zeros are as good as
+  // random data and much cheaper to produce.
+  memset(&packet[header_length], 0, padding_length - 1);
   // Set number of padding bytes in the last byte of the packet.
   packet[header_length + padding_length - 1] =
       static_cast<uint8_t>(padding_length);
@@ -699,20 +692,23 @@ bool RTPSender::StorePackets() const {
   return packet_history_.StorePackets();
 }
 
+void RTPSender::SetRtt(int64_t rtt_ms) {
+  packet_history_.SetRtt(rtt_ms);
+}
+
 int32_t RTPSender::ReSendPacket(uint16_t packet_id, int64_t min_resend_time) {
-  size_t length = IP_PACKET_SIZE;
-  uint8_t data_buffer[IP_PACKET_SIZE];
+  rtc::CopyOnWriteBuffer packet;
   int64_t capture_time_ms;
 
   if (!packet_history_.GetPacketAndSetSendTime(packet_id, min_resend_time, true,
-                                               data_buffer, &length,
-                                               &capture_time_ms)) {
+                                               &packet, &capture_time_ms)) {
     // Packet not found.
     return 0;
   }
+  size_t length = packet.size();
 
   if (paced_sender_) {
-    RtpUtility::RtpHeaderParser rtp_parser(data_buffer, length);
+    RtpUtility::RtpHeaderParser rtp_parser(packet.cdata(), length);
     RTPHeader header;
     if (!rtp_parser.Parse(&header)) {
       assert(false);
@@ -732,7 +728,7 @@ int32_t RTPSender::ReSendPacket(uint16_t packet_id, int64_t min_resend_time) {
     rtc::CritScope lock(&send_critsect_);
     rtx = rtx_;
   }
-  if (!PrepareAndSendPacket(data_buffer, length, capture_time_ms,
+  if (!PrepareAndSendPacket(packet, capture_time_ms,
                             (rtx & kRtxRetransmitted) > 0, true)) {
     return -1;
   }
@@ -870,15 +866,13 @@ void RTPSender::UpdateNACKBitRate(uint32_t bytes, int64_t now) {
 bool RTPSender::TimeToSendPacket(uint16_t sequence_number,
                                  int64_t capture_time_ms,
                                  bool retransmission) {
-  size_t length = IP_PACKET_SIZE;
-  uint8_t data_buffer[IP_PACKET_SIZE];
+  rtc::CopyOnWriteBuffer packet;
   int64_t stored_time_ms;
 
   if (!packet_history_.GetPacketAndSetSendTime(sequence_number,
                                                0,
                                                retransmission,
-                                               data_buffer,
-                                               &length,
+                                               &packet,
                                                &stored_time_ms)) {
     // Packet cannot be found. Allow sending to continue.
     return true;
@@ -889,21 +883,18 @@ bool RTPSender::TimeToSendPacket(uint16_t sequence_number,
     rtc::CritScope lock(&send_critsect_);
     rtx = rtx_;
   }
-  return PrepareAndSendPacket(data_buffer,
-                              length,
+  return PrepareAndSendPacket(packet,
                               capture_time_ms,
                               retransmission && (rtx & kRtxRetransmitted) > 0,
                               retransmission);
 }
 
-bool RTPSender::PrepareAndSendPacket(uint8_t* buffer,
-                                     size_t length,
+bool RTPSender::PrepareAndSendPacket(rtc::CopyOnWriteBuffer packet,
                                      int64_t capture_time_ms,
                                      bool send_over_rtx,
                                      bool is_retransmit) {
-  uint8_t* buffer_to_send_ptr = buffer;
-
-  RtpUtility::RtpHeaderParser rtp_parser(buffer, length);
+  size_t length = packet.size();
+  RtpUtility::RtpHeaderParser rtp_parser(packet.cdata(), length);
   RTPHeader rtp_header;
   rtp_parser.Parse(&rtp_header);
   if (!is_retransmit && rtp_header.markerBit) {
@@ -915,10 +906,15 @@ bool RTPSender::PrepareAndSendPacket(uint8_t* buffer,
       TRACE_DISABLED_BY_DEFAULT("webrtc_rtp"), "PrepareAndSendPacket",
       "timestamp", rtp_header.timestamp, "seqnum", rtp_header.sequenceNumber);
 
+  // The RTX packet is built directly from the shared data. Otherwise the data
+  // is copied here, if still shared, as the header extensions are rewritten.
   uint8_t data_buffer_rtx[IP_PACKET_SIZE];
+  uint8_t* buffer_to_send_ptr;
   if (send_over_rtx) {
-    BuildRtxPacket(buffer, &length, data_buffer_rtx);
+    BuildRtxPacket(packet.cdata(), rtp_header, &length, data_buffer_rtx);
     buffer_to_send_ptr = data_buffer_rtx;
+  } else {
+    buffer_to_send_ptr = packet.data();
   }
 
   int64_t now_ms = clock_->TimeInMilliseconds();
@@ -1818,17 +1814,12 @@ int32_t RTPSender::SetFecParameters(
   return 0;
 }
 
-void RTPSender::BuildRtxPacket(uint8_t* buffer, size_t* length,
+void RTPSender::BuildRtxPacket(const uint8_t* buffer,
+                               const RTPHeader& rtp_header,
+                               size_t* length,
                                uint8_t* buffer_rtx) {
   rtc::CritScope lock(&send_critsect_);
   uint8_t* data_buffer_rtx = buffer_rtx;
-  // Add RTX header.
-  RtpUtility::RtpHeaderParser rtp_parser(
-      reinterpret_cast<const uint8_t*>(buffer), *length);
-
-  RTPHeader rtp_header;
-  rtp_parser.Parse(&rtp_header);
-
   // Add original RTP header.
   memcpy(data_buffer_rtx, buffer, rtp_header.headerLength);
 
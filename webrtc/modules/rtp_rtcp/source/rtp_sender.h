@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "webrtc/base/constructormagic.h"
+#include "webrtc/base/copyonwritebuffer.h"
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/random.h"
 #include "webrtc/base/thread_annotations.h"
@@ -225,6 +226,9 @@ class RTPSender : public RTPSenderInterface {
 
   bool StorePackets() const;
 
+  // Used to size the packet history.
+  void SetRtt(int64_t rtt_ms);
+
   int32_t ReSendPacket(uint16_t packet_id, int64_t min_resend_time = 0);
 
   bool ProcessNACKBitRate(uint32_t now);
@@ -333,8 +337,9 @@ class RTPSender : public RTPSenderInterface {
 
   void UpdateNACKBitRate(uint32_t bytes, int64_t now);
 
-  bool PrepareAndSendPacket(uint8_t* buffer,
-                            size_t length,
+  // |packet| may share its data with the packet history, it is only copied
+  // when the header extensions are updated in place.
+  bool PrepareAndSendPacket(rtc::CopyOnWriteBuffer packet,
                             int64_t capture_time_ms,
                             bool send_over_rtx,
                             bool is_retransmit);
@@ -347,7 +352,11 @@ class RTPSender : public RTPSenderInterface {
                           size_t header_length,
                           size_t padding_length);
 
-  void BuildRtxPacket(uint8_t* buffer, size_t* length,
+  // Builds the RTX version of the RTP packet in |buffer| into |buffer_rtx|.
+  // |rtp_header| is the already parsed header of the original packet.
+  void BuildRtxPacket(const uint8_t* buffer,
+                      const RTPHeader& rtp_header,
+                      size_t* length,
                       uint8_t* buffer_rtx);
 
   bool SendPacketToNetwork(const uint8_t* packet,
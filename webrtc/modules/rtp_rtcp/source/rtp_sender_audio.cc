@@ -104,7 +104,6 @@ int32_t RTPSenderAudio::RegisterAudioPayload(
 }
 
 bool RTPSenderAudio::MarkerBit(FrameType frameType, int8_t payload_type) {
-  rtc::CritScope cs(&_sendAudioCritsect);
   // for audio true for first packet in a speech burst
   bool markerBit = false;
   if (_lastPayloadType != payload_type) {
@@ -248,7 +247,12 @@ int32_t RTPSenderAudio::SendAudio(FrameType frameType,
     return -1;
   }
   uint8_t dataBuffer[IP_PACKET_SIZE];
-  bool markerBit = MarkerBit(frameType, payloadType);
+  bool markerBit;
+  {
+    rtc::CritScope cs(&_sendAudioCritsect);
+    markerBit = MarkerBit(frameType, payloadType);
+    _lastPayloadType = payloadType;
+  }
 
   int32_t rtpHeaderLength = 0;
   uint16_t timestampOffset = 0;
@@ -334,10 +338,6 @@ int32_t RTPSenderAudio::SendAudio(FrameType frameType,
     }
   }
 
-  {
-    rtc::CritScope cs(&_sendAudioCritsect);
-    _lastPayloadType = payloadType;
-  }
   // Update audio level extension, if included.
   size_t packetSize = payloadSize + rtpHeaderLength;
   RtpUtility::RtpHeaderParser rtp_parser(dataBuffer, packetSize);
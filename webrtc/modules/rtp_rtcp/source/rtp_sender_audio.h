@@ -68,7 +68,8 @@ class RTPSenderAudio : public DTMFqueue {
       uint16_t duration,
       bool markerBit);  // set on first packet in talk burst
 
-  bool MarkerBit(const FrameType frameType, const int8_t payloadType);
+  bool MarkerBit(const FrameType frameType, const int8_t payloadType)
+      EXCLUSIVE_LOCKS_REQUIRED(_sendAudioCritsect);
 
  private:
   Clock* const _clock;
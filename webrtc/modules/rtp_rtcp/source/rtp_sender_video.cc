@@ -104,26 +104,31 @@ void RTPSenderVideo::SendVideoPacket(uint8_t* data_buffer,
   }
 }
 
-void RTPSenderVideo::SendVideoPacketAsRed(uint8_t* data_buffer,
-                                          const size_t payload_length,
-                                          const size_t rtp_header_length,
-                                          uint16_t media_seq_num,
-                                          const uint32_t capture_timestamp,
-                                          int64_t capture_time_ms,
-                                          StorageType media_packet_storage,
-                                          bool protect) {
-  std::unique_ptr<RedPacket> red_packet;
+void RTPSenderVideo::SendVideoPacketsAsRed(
+    uint8_t* packets,
+    const std::vector<size_t>& payload_lengths,
+    const size_t rtp_header_length,
+    const uint32_t capture_timestamp,
+    int64_t capture_time_ms,
+    StorageType media_packet_storage,
+    bool protect) {
+  std::vector<std::unique_ptr<RedPacket>> red_packets;
+  red_packets.reserve(payload_lengths.size());
   std::vector<RedPacket*> fec_packets;
   StorageType fec_storage = kDontRetransmit;
   uint16_t next_fec_sequence_number = 0;
   {
     // Only protect while creating RED and FEC packets, not when sending.
     rtc::CritScope cs(&crit_);
-    red_packet.reset(producer_fec_.BuildRedPacket(
-        data_buffer, payload_length, rtp_header_length, red_payload_type_));
-    if (protect) {
-      producer_fec_.AddRtpPacketAndGenerateFec(data_buffer, payload_length,
-                                               rtp_header_length);
+    for (size_t i = 0; i < payload_lengths.size(); ++i) {
+      uint8_t* data_buffer = packets + i * IP_PACKET_SIZE;
+      red_packets.push_back(std::unique_ptr<RedPacket>(
+          producer_fec_.BuildRedPacket(data_buffer, payload_lengths[i],
+                                       rtp_header_length, red_payload_type_)));
+      if (protect) {
+        producer_fec_.AddRtpPacketAndGenerateFec(
+            data_buffer, payload_lengths[i], rtp_header_length);
+      }
     }
     uint16_t num_fec_packets = producer_fec_.NumAvailableFecPackets();
     if (num_fec_packets > 0) {
@@ -137,16 +142,21 @@ void RTPSenderVideo::SendVideoPacketAsRed(uint8_t* data_buffer,
         fec_storage = kAllowRetransmission;
     }
   }
-  if (_rtpSender.SendToNetwork(
-          red_packet->data(), red_packet->length() - rtp_header_length,
-          rtp_header_length, capture_time_ms, media_packet_storage,
-          RtpPacketSender::kLowPriority) == 0) {
-    _videoBitrate.Update(red_packet->length());
-    TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("webrtc_rtp"),
-                         "Video::PacketRed", "timestamp", capture_timestamp,
-                         "seqnum", media_seq_num);
-  } else {
-    LOG(LS_WARNING) << "Failed to send RED packet " << media_seq_num;
+  for (size_t i = 0; i < red_packets.size(); ++i) {
+    const RedPacket& red_packet = *red_packets[i];
+    uint16_t media_seq_num = ByteReader<uint16_t>::ReadBigEndian(
+        packets + i * IP_PACKET_SIZE + 2);
+    if (_rtpSender.SendToNetwork(
+            red_packet.data(), red_packet.length() - rtp_header_length,
+            rtp_header_length, capture_time_ms, media_packet_storage,
+            RtpPacketSender::kLowPriority) == 0) {
+      _videoBitrate.Update(red_packet.length());
+      TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("webrtc_rtp"),
+                           "Video::PacketRed", "timestamp", capture_timestamp,
+                           "seqnum", media_seq_num);
+    } else {
+      LOG(LS_WARNING) << "Failed to send RED packet " << media_seq_num;
+    }
   }
   for (RedPacket* fec_packet : fec_packets) {
     if (_rtpSender.SendToNetwork(
@@ -260,16 +270,25 @@ int32_t RTPSenderVideo::SendVideo(const RtpVideoCodecTypes videoType,
 
   packetizer->SetPayloadData(data, payload_bytes_to_send, frag);
 
-  bool first = true;
+  // Packetize the whole frame into one buffer before sending any of it, so
+  // that the RED and FEC packets can be built for the frame at once.
+  std::vector<uint8_t> packets;
+  std::vector<size_t> payload_lengths;
+  const size_t max_payload_length = _rtpSender.MaxDataPayloadLength();
+  if (max_payload_length > 0) {
+    const size_t expected_num_packets = payloadSize / max_payload_length + 1;
+    packets.reserve(expected_num_packets * IP_PACKET_SIZE);
+    payload_lengths.reserve(expected_num_packets);
+  }
   bool last = false;
   while (!last) {
-    uint8_t dataBuffer[IP_PACKET_SIZE] = {0};
+    packets.resize(packets.size() + IP_PACKET_SIZE);
+    uint8_t* dataBuffer = &packets[packets.size() - IP_PACKET_SIZE];
     size_t payload_bytes_in_packet = 0;
     if (!packetizer->NextPacket(&dataBuffer[rtp_header_length],
                                 &payload_bytes_in_packet, &last)) {
       return -1;
     }
-
     // Write RTP header.
     // Set marker bit true if this is the last packet in frame.
     _rtpSender.BuildRTPheader(
@@ -294,35 +313,32 @@ int32_t RTPSenderVideo::SendVideo(const RtpVideoCodecTypes videoType,
       // TODO(guoweis): For now, all packets sent will carry the CVO such that
       // the RTP header length is consistent, although the receiver side will
       // only exam the packets with marker bit set.
-      size_t packetSize = payloadSize + rtp_header_length;
+      size_t packetSize = payload_bytes_in_packet + rtp_header_length;
       RtpUtility::RtpHeaderParser rtp_parser(dataBuffer, packetSize);
       RTPHeader rtp_header;
       rtp_parser.Parse(&rtp_header);
       _rtpSender.UpdateVideoRotation(dataBuffer, packetSize, rtp_header,
                                      video_header->rotation);
     }
-    if (fec_enabled) {
-      SendVideoPacketAsRed(dataBuffer, payload_bytes_in_packet,
-                           rtp_header_length, _rtpSender.SequenceNumber(),
-                           captureTimeStamp, capture_time_ms, storage,
-                           packetizer->GetProtectionType() == kProtectedPacket);
-    } else {
-      SendVideoPacket(dataBuffer, payload_bytes_in_packet, rtp_header_length,
-                      _rtpSender.SequenceNumber(), captureTimeStamp,
-                      capture_time_ms, storage);
-    }
+    payload_lengths.push_back(payload_bytes_in_packet);
+  }
 
-    if (first_frame) {
-      if (first) {
-        LOG(LS_INFO)
-            << "Sent first RTP packet of the first video frame (pre-pacer)";
-      }
-      if (last) {
-        LOG(LS_INFO)
-            << "Sent last RTP packet of the first video frame (pre-pacer)";
-      }
+  if (fec_enabled) {
+    SendVideoPacketsAsRed(&packets[0], payload_lengths, rtp_header_length,
+                          captureTimeStamp, capture_time_ms, storage,
+                          packetizer->GetProtectionType() == kProtectedPacket);
+  } else {
+    for (size_t i = 0; i < payload_lengths.size(); ++i) {
+      uint8_t* dataBuffer = &packets[i * IP_PACKET_SIZE];
+      SendVideoPacket(dataBuffer, payload_lengths[i], rtp_header_length,
+                      ByteReader<uint16_t>::ReadBigEndian(dataBuffer + 2),
+                      captureTimeStamp, capture_time_ms, storage);
     }
-    first = false;
+  }
+
+  if (first_frame) {
+    LOG(LS_INFO) << "Sent first RTP packet of the first video frame (pre-pacer)";
+    LOG(LS_INFO) << "Sent last RTP packet of the first video frame (pre-pacer)";
   }
 
   TRACE_EVENT_ASYNC_END1(
@@ -12,6 +12,7 @@
 #define WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_SENDER_VIDEO_H_
 
 #include <list>
+#include <vector>
 
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/onetimeevent.h"
@@ -85,14 +86,17 @@ class RTPSenderVideo {
                        int64_t capture_time_ms,
                        StorageType storage);
 
-  void SendVideoPacketAsRed(uint8_t* dataBuffer,
-                            const size_t payloadLength,
-                            const size_t rtpHeaderLength,
-                            uint16_t video_seq_num,
-                            const uint32_t capture_timestamp,
-                            int64_t capture_time_ms,
-                            StorageType media_packet_storage,
-                            bool protect);
+  // Sends the packets of a frame as RED, followed by the FEC packets
+  // protecting them. |packets| holds one packet every IP_PACKET_SIZE bytes,
+  // with the payload lengths in |payload_lengths|. The RED and FEC packets
+  // for the whole frame are built while holding |crit_| once.
+  void SendVideoPacketsAsRed(uint8_t* packets,
+                             const std::vector<size_t>& payload_lengths,
+                             const size_t rtpHeaderLength,
+                             const uint32_t capture_timestamp,
+                             int64_t capture_time_ms,
+                             StorageType media_packet_storage,
+                             bool protect);
 
   RTPSenderInterface& _rtpSender;
 
@@ -28,7 +28,9 @@ PartitionTreeNode::PartitionTreeNode(PartitionTreeNode* parent,
       num_partitions_(num_partitions),
       max_parent_size_(0),
       min_parent_size_(std::numeric_limits<int>::max()),
-      packet_start_(false) {
+      packet_start_(false),
+      // Any node but a "left" child starts a new packet; see CreateChildren().
+      num_packets_(parent ? parent->NumPackets() + 1 : 1) {
   // If |this_size_| > INT_MAX, Cost() and CreateChildren() won't work properly.
   assert(this_size_ <= static_cast<size_t>(std::numeric_limits<int>::max()));
   children_[kLeftChild] = NULL;
@@ -73,6 +75,7 @@ bool PartitionTreeNode::CreateChildren(size_t max_size) {
       children_[kLeftChild]->set_min_parent_size(min_parent_size_);
       // "Left" child is continuation of same packet.
       children_[kLeftChild]->set_packet_start(false);
+      children_[kLeftChild]->num_packets_ = num_packets_;
       children_created = true;
     }
     if (this_size_ > 0) {
@@ -91,20 +94,6 @@ bool PartitionTreeNode::CreateChildren(size_t max_size) {
   return children_created;
 }
 
-size_t PartitionTreeNode::NumPackets() {
-  if (parent_ == NULL) {
-    // Root node is a "right" child by definition.
-    return 1;
-  }
-  if (parent_->children_[kLeftChild] == this) {
-    // This is a "left" child.
-    return parent_->NumPackets();
-  } else {
-    // This is a "right" child.
-    return 1 + parent_->NumPackets();
-  }
-}
-
 PartitionTreeNode* PartitionTreeNode::GetOptimalNode(size_t max_size,
                                                      size_t penalty) {
   CreateChildren(max_size);
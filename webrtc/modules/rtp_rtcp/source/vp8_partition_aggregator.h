@@ -44,7 +44,7 @@ class PartitionTreeNode {
   bool CreateChildren(size_t max_size);
 
   // Get the number of packets for the configuration that this node represents.
-  size_t NumPackets();
+  size_t NumPackets() const { return num_packets_; }
 
   // Find the optimal solution given a maximum packet size and a per-packet
   // penalty. The method will be recursively called while the solver is
@@ -77,6 +77,9 @@ class PartitionTreeNode {
   int max_parent_size_;
   int min_parent_size_;
   bool packet_start_;
+  // Stored rather than counted along the path to the root, since Cost() needs
+  // it for every node the search compares.
+  size_t num_packets_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(PartitionTreeNode);
 };
@@ -10,7 +10,11 @@
 
 #include <stdlib.h>  // NULL
 
+#include <algorithm>
+#include <limits>
+
 #include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
 #include "webrtc/modules/rtp_rtcp/source/vp8_partition_aggregator.h"
 
 namespace webrtc {
@@ -196,6 +200,72 @@ TEST(Vp8PartitionAggregator, FindOptimalConfigSinglePartition) {
   delete aggregator;
 }
 
+// Returns the lowest cost of all aggregations of the partitions in
+// |fragmentation|, by trying each of them.
+static int ExhaustiveSearchCost(const RTPFragmentationHeader& fragmentation,
+                                int prior_min_size,
+                                int prior_max_size,
+                                size_t max_size,
+                                size_t penalty) {
+  const size_t num_partitions = fragmentation.fragmentationVectorSize;
+  int best_cost = std::numeric_limits<int>::max();
+  // Bit i of |packet_starts| is set if partition i + 1 starts a new packet.
+  for (uint32_t packet_starts = 0;
+       packet_starts < (1u << (num_partitions - 1)); ++packet_starts) {
+    int min_size = prior_min_size;
+    int max_size_found = prior_max_size;
+    size_t num_packets = 0;
+    size_t packet_size = 0;
+    bool too_large = false;
+    for (size_t i = 0; i < num_partitions; ++i) {
+      packet_size += fragmentation.fragmentationLength[i];
+      if (i == num_partitions - 1 || (packet_starts >> i) & 1) {
+        too_large |= packet_size > max_size;
+        min_size = std::min(min_size, static_cast<int>(packet_size));
+        max_size_found =
+            std::max(max_size_found, static_cast<int>(packet_size));
+        ++num_packets;
+        packet_size = 0;
+      }
+    }
+    if (!too_large) {
+      best_cost = std::min(
+          best_cost, max_size_found - min_size +
+                         static_cast<int>(num_packets * penalty));
+    }
+  }
+  return best_cost;
+}
+
+TEST(Vp8PartitionAggregator, FindOptimalConfigOfNinePartitions) {
+  // The first partition and eight token partitions, of sizes as for a 1080p
+  // frame.
+  const size_t kNumPartitions = 9;
+  const size_t kMaxSize = 1200;
+  const size_t kPenalty = 20;
+  Random random(0x12345678);
+  for (int i = 0; i < 100; ++i) {
+    RTPFragmentationHeader fragmentation;
+    fragmentation.VerifyAndAllocateFragmentationHeader(kNumPartitions);
+    for (size_t j = 0; j < kNumPartitions; ++j)
+      fragmentation.fragmentationLength[j] = random.Rand(50, 1200);
+    const int prior_min_size = random.Rand(500, 800);
+    const int prior_max_size = random.Rand(800, 1200);
+    Vp8PartitionAggregator aggregator(fragmentation, 0, kNumPartitions - 1);
+    aggregator.SetPriorMinMax(prior_min_size, prior_max_size);
+    Vp8PartitionAggregator::ConfigVec opt_config =
+        aggregator.FindOptimalConfiguration(kMaxSize, kPenalty);
+    int min_size = prior_min_size;
+    int max_size = prior_max_size;
+    aggregator.CalcMinMax(opt_config, &min_size, &max_size);
+    const int cost = max_size - min_size +
+                     static_cast<int>((opt_config.back() + 1) * kPenalty);
+    EXPECT_EQ(ExhaustiveSearchCost(fragmentation, prior_min_size,
+                                   prior_max_size, kMaxSize, kPenalty),
+              cost);
+  }
+}
+
 TEST(Vp8PartitionAggregator, TestCalcNumberOfFragments) {
   const int kMTU = 1500;
   EXPECT_EQ(2u,
@@ -41,6 +41,18 @@ class AudioFrameOperations {
   // |num_channels_| is stereo.
   static int StereoToMono(AudioFrame* frame);
 
+  // Adds |frame_to_add| to |result_frame|, sample by sample with saturation,
+  // and merges the VAD activity and speech type like AudioFrame::operator+=.
+  // If |result_frame| is empty, it takes the samples of |frame_to_add|.
+  // Fails silently if the frames have different numbers of channels, or both
+  // have samples and their lengths differ.
+  static void Add(const AudioFrame& frame_to_add, AudioFrame* result_frame);
+
+  // Multiplies the first |length| samples of |audio| by the corresponding
+  // entries of |gains|, e.g. for ramping the level in or out. The gains must
+  // be within [0, 1].
+  static void ApplyGains(const float* gains, size_t length, int16_t* audio);
+
   // Swap the left and right channels of |frame|. Fails silently if |frame| is
   // not stereo.
   static void SwapStereoChannels(AudioFrame* frame);
@@ -45,6 +45,14 @@ public:
         const CodecInst& codecInst,
         uint32_t notification) = 0;
 
+    // Recordings started with a file name are buffered in memory and written
+    // by a background thread every flushIntervalMs ms. Audio is dropped while
+    // maxBufferedBytes are waiting to be written. A maxBufferedBytes of zero
+    // writes the file on the thread calling RecordAudioToFile(..).
+    // Note: only affects recordings started after the call.
+    virtual void SetFileWriteBuffering(int flushIntervalMs,
+                                       size_t maxBufferedBytes) = 0;
+
     // Stop recording.
     // Note: this API is for both audio and video.
     virtual int32_t StopRecording() = 0;
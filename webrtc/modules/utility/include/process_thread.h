@@ -32,6 +32,12 @@ class ProcessThread {
 
   static std::unique_ptr<ProcessThread> Create(const char* thread_name);
 
+  // Creates a ProcessThread that runs its modules on |num_threads| worker
+  // threads. Each module is processed on one of them for as long as it is
+  // registered; tasks run in order on the first one.
+  static std::unique_ptr<ProcessThread> Create(const char* thread_name,
+                                               size_t num_threads);
+
   // Starts the worker thread.  Must be called from the construction thread.
   virtual void Start() = 0;
 
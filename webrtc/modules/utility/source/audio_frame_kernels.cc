@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/utility/source/audio_frame_kernels.h"
+
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+const AudioFrameKernels kKernelsC = {AddWithSaturationC, ApplyGainsC,
+                                     StereoToMonoC};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+const AudioFrameKernels kKernelsSSE2 = {AddWithSaturationSSE2, ApplyGainsSSE2,
+                                        StereoToMonoSSE2};
+#endif
+#if defined(WEBRTC_HAS_NEON)
+const AudioFrameKernels kKernelsNEON = {AddWithSaturationNEON, ApplyGainsNEON,
+                                        StereoToMonoNEON};
+#endif
+
+}  // namespace
+
+void AddWithSaturationC(const int16_t* src, size_t length, int16_t* dst) {
+  for (size_t i = 0; i < length; ++i) {
+    dst[i] = ClampToInt16(static_cast<int32_t>(dst[i]) +
+                          static_cast<int32_t>(src[i]));
+  }
+}
+
+void ApplyGainsC(const float* gains, size_t length, int16_t* audio) {
+  for (size_t i = 0; i < length; ++i)
+    audio[i] = static_cast<int16_t>(gains[i] * audio[i]);
+}
+
+void StereoToMonoC(const int16_t* src, size_t samples_per_channel,
+                   int16_t* dst) {
+  for (size_t i = 0; i < samples_per_channel; ++i)
+    dst[i] = (src[2 * i] + src[2 * i + 1]) >> 1;
+}
+
+const AudioFrameKernels& GetAudioFrameKernelsC() {
+  return kKernelsC;
+}
+
+const AudioFrameKernels& GetAudioFrameKernels() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  return kKernelsSSE2;
+#else
+  // x86 CPU detection required. Only done once, since the kernels are used
+  // for every frame.
+  static const bool has_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
+  return has_sse2 ? kKernelsSSE2 : kKernelsC;
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+  return kKernelsNEON;
+#else
+  return kKernelsC;
+#endif
+}
+
+}  // namespace internal
+}  // namespace webrtc
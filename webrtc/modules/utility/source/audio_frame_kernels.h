@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_UTILITY_SOURCE_AUDIO_FRAME_KERNELS_H_
+#define WEBRTC_MODULES_UTILITY_SOURCE_AUDIO_FRAME_KERNELS_H_
+
+#include <stddef.h>
+
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+namespace internal {
+
+// Sample kernels behind AudioFrameOperations. The output of every
+// implementation is bit-exact with the C version. None of the buffers need to
+// be aligned.
+struct AudioFrameKernels {
+  // Adds |length| samples of |src| to |dst|, saturating to the int16_t range.
+  void (*add_with_saturation)(const int16_t* src, size_t length, int16_t* dst);
+  // Multiplies each of the |length| samples of |audio| by the corresponding
+  // entry of |gains|, truncating towards zero. The gains must be within
+  // [0, 1].
+  void (*apply_gains)(const float* gains, size_t length, int16_t* audio);
+  // Writes the average of each interleaved stereo pair of |src| to |dst|,
+  // rounding towards minus infinity. |dst| may be equal to |src|.
+  void (*stereo_to_mono)(const int16_t* src,
+                         size_t samples_per_channel,
+                         int16_t* dst);
+};
+
+void AddWithSaturationC(const int16_t* src, size_t length, int16_t* dst);
+void ApplyGainsC(const float* gains, size_t length, int16_t* audio);
+void StereoToMonoC(const int16_t* src, size_t samples_per_channel,
+                   int16_t* dst);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void AddWithSaturationSSE2(const int16_t* src, size_t length, int16_t* dst);
+void ApplyGainsSSE2(const float* gains, size_t length, int16_t* audio);
+void StereoToMonoSSE2(const int16_t* src, size_t samples_per_channel,
+                      int16_t* dst);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void AddWithSaturationNEON(const int16_t* src, size_t length, int16_t* dst);
+void ApplyGainsNEON(const float* gains, size_t length, int16_t* audio);
+void StereoToMonoNEON(const int16_t* src, size_t samples_per_channel,
+                      int16_t* dst);
+#endif
+
+// The portable kernels.
+const AudioFrameKernels& GetAudioFrameKernelsC();
+// Returns the fastest kernels supported by the CPU.
+const AudioFrameKernels& GetAudioFrameKernels();
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_UTILITY_SOURCE_AUDIO_FRAME_KERNELS_H_
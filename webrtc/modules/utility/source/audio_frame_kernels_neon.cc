@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/utility/source/audio_frame_kernels.h"
+
+#include <arm_neon.h>
+
+namespace webrtc {
+namespace internal {
+
+void AddWithSaturationNEON(const int16_t* src, size_t length, int16_t* dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    int16x8_t d0 = vqaddq_s16(vld1q_s16(dst + i), vld1q_s16(src + i));
+    int16x8_t d1 = vqaddq_s16(vld1q_s16(dst + i + 8), vld1q_s16(src + i + 8));
+    vst1q_s16(dst + i, d0);
+    vst1q_s16(dst + i + 8, d1);
+  }
+  AddWithSaturationC(src + i, length - i, dst + i);
+}
+
+void ApplyGainsNEON(const float* gains, size_t length, int16_t* audio) {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const int16x8_t samples = vld1q_s16(audio + i);
+    const float32x4_t scaled_lo =
+        vmulq_f32(vld1q_f32(gains + i),
+                  vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))));
+    const float32x4_t scaled_hi =
+        vmulq_f32(vld1q_f32(gains + i + 4),
+                  vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples))));
+    // vcvtq_s32_f32 truncates towards zero, like the C version's cast.
+    vst1q_s16(audio + i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(scaled_lo)),
+                                      vqmovn_s32(vcvtq_s32_f32(scaled_hi))));
+  }
+  ApplyGainsC(gains + i, length - i, audio + i);
+}
+
+void StereoToMonoNEON(const int16_t* src, size_t samples_per_channel,
+                      int16_t* dst) {
+  size_t i = 0;
+  for (; i + 8 <= samples_per_channel; i += 8) {
+    // Deinterleave into left and right, and take the halving sum, which is
+    // computed without intermediate overflow.
+    const int16x8x2_t stereo = vld2q_s16(src + 2 * i);
+    vst1q_s16(dst + i, vhaddq_s16(stereo.val[0], stereo.val[1]));
+  }
+  StereoToMonoC(src + 2 * i, samples_per_channel - i, dst + i);
+}
+
+}  // namespace internal
+}  // namespace webrtc
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/utility/source/audio_frame_kernels.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+const size_t kSamplesPerChannel = 480;  // 10 ms at 48 kHz.
+const size_t kNumChannels = 2;
+const size_t kNumSamples = kSamplesPerChannel * kNumChannels;
+const size_t kRampSize = 80;
+const int kNumIterations = 2000;
+
+// Returns the average time in nanoseconds to ramp in and mix |frames| into a
+// stereo mix, and downmix the result to mono, with |kernels|.
+size_t MeasureMixNs(const AudioFrameKernels& kernels,
+                    const std::vector<std::vector<int16_t>>& frames) {
+  std::vector<float> ramp(kRampSize);
+  for (size_t i = 0; i < kRampSize; ++i)
+    ramp[i] = static_cast<float>(i) / (kRampSize - 1);
+  std::vector<int16_t> frame(kNumSamples);
+  std::vector<int16_t> mix(kNumSamples);
+  std::vector<int16_t> mono(kSamplesPerChannel);
+  int64_t checksum = 0;
+
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int k = 0; k < kNumIterations; ++k) {
+    std::fill(mix.begin(), mix.end(), 0);
+    for (size_t i = 0; i < frames.size(); ++i) {
+      const std::vector<int16_t>* source = &frames[i];
+      // Ramp in one of the frames, as the mixer does for new participants.
+      if (i == 0) {
+        frame = frames[i];
+        kernels.apply_gains(&ramp[0], kRampSize, &frame[0]);
+        source = &frame;
+      }
+      kernels.add_with_saturation(&(*source)[0], kNumSamples, &mix[0]);
+    }
+    kernels.stereo_to_mono(&mix[0], kSamplesPerChannel, &mono[0]);
+    checksum += mono[k % kSamplesPerChannel];
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  // Use the result so the loops aren't optimized away.
+  EXPECT_NE(0, checksum + 1);
+  return static_cast<size_t>(elapsed_ns / kNumIterations);
+}
+
+void RunBenchmark(size_t num_frames) {
+  Random random(0x1234);
+  std::vector<std::vector<int16_t>> frames(num_frames,
+                                           std::vector<int16_t>(kNumSamples));
+  for (auto& frame : frames) {
+    for (int16_t& sample : frame)
+      sample = random.Rand<int16_t>();
+  }
+
+  const std::string modifier = "_" + rtc::ToString(num_frames);
+  test::PrintResult("audio_frame_mix", modifier, "c",
+                    MeasureMixNs(GetAudioFrameKernelsC(), frames), "ns", false);
+  test::PrintResult("audio_frame_mix", modifier, "selected",
+                    MeasureMixNs(GetAudioFrameKernels(), frames), "ns", true);
+}
+}  // namespace
+
+TEST(AudioFrameKernelsPerformanceTest, Mix3Frames) {
+  RunBenchmark(3);
+}
+
+TEST(AudioFrameKernelsPerformanceTest, Mix10Frames) {
+  RunBenchmark(10);
+}
+
+TEST(AudioFrameKernelsPerformanceTest, Mix50Frames) {
+  RunBenchmark(50);
+}
+
+}  // namespace internal
+}  // namespace webrtc
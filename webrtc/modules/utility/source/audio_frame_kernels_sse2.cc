@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/utility/source/audio_frame_kernels.h"
+
+#include <emmintrin.h>
+
+namespace webrtc {
+namespace internal {
+
+void AddWithSaturationSSE2(const int16_t* src, size_t length, int16_t* dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i* s = reinterpret_cast<const __m128i*>(src + i);
+    __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+    __m128i d0 = _mm_adds_epi16(_mm_loadu_si128(d), _mm_loadu_si128(s));
+    __m128i d1 = _mm_adds_epi16(_mm_loadu_si128(d + 1), _mm_loadu_si128(s + 1));
+    _mm_storeu_si128(d, d0);
+    _mm_storeu_si128(d + 1, d1);
+  }
+  AddWithSaturationC(src + i, length - i, dst + i);
+}
+
+void ApplyGainsSSE2(const float* gains, size_t length, int16_t* audio) {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    __m128i* a = reinterpret_cast<__m128i*>(audio + i);
+    const __m128i samples = _mm_loadu_si128(a);
+    // Sign extend to 32 bits by placing each sample in the upper half.
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+    const __m128 scaled_lo =
+        _mm_mul_ps(_mm_loadu_ps(gains + i), _mm_cvtepi32_ps(lo));
+    const __m128 scaled_hi =
+        _mm_mul_ps(_mm_loadu_ps(gains + i + 4), _mm_cvtepi32_ps(hi));
+    // The gains are within [0, 1], so packing never actually saturates.
+    _mm_storeu_si128(a, _mm_packs_epi32(_mm_cvttps_epi32(scaled_lo),
+                                        _mm_cvttps_epi32(scaled_hi)));
+  }
+  ApplyGainsC(gains + i, length - i, audio + i);
+}
+
+void StereoToMonoSSE2(const int16_t* src, size_t samples_per_channel,
+                      int16_t* dst) {
+  const __m128i ones = _mm_set1_epi16(1);
+  size_t i = 0;
+  // Both input registers are read before the output is written, which keeps
+  // the in-place case (|dst| == |src|) correct.
+  for (; i + 8 <= samples_per_channel; i += 8) {
+    const __m128i* s = reinterpret_cast<const __m128i*>(src + 2 * i);
+    // Multiplying by one and adding adjacent pairs gives exact 32 bit sums.
+    const __m128i sum_lo = _mm_madd_epi16(_mm_loadu_si128(s), ones);
+    const __m128i sum_hi = _mm_madd_epi16(_mm_loadu_si128(s + 1), ones);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packs_epi32(_mm_srai_epi32(sum_lo, 1),
+                                     _mm_srai_epi32(sum_hi, 1)));
+  }
+  StereoToMonoC(src + 2 * i, samples_per_channel - i, dst + i);
+}
+
+}  // namespace internal
+}  // namespace webrtc
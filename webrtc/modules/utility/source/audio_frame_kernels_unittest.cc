@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <limits>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/modules/utility/source/audio_frame_kernels.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+const size_t kMaxLength = 100;
+const size_t kMaxOffset = 8;
+
+// Random samples, a fifth of them at the limits of the range to exercise
+// saturation.
+void FillSamples(Random* random, std::vector<int16_t>* samples) {
+  for (int16_t& sample : *samples) {
+    switch (random->Rand(0, 9)) {
+      case 0:
+        sample = std::numeric_limits<int16_t>::min();
+        break;
+      case 1:
+        sample = std::numeric_limits<int16_t>::max();
+        break;
+      default:
+        sample = random->Rand<int16_t>();
+    }
+  }
+}
+
+void VerifyKernels(const AudioFrameKernels& kernels) {
+  const AudioFrameKernels& reference = GetAudioFrameKernelsC();
+  Random random(0x5eed);
+  std::vector<int16_t> src(2 * (kMaxLength + kMaxOffset));
+  std::vector<int16_t> dst(src.size());
+  std::vector<int16_t> expected(src.size());
+  std::vector<float> gains(src.size());
+  // Cover all tail lengths and misalignments.
+  for (size_t length = 0; length <= kMaxLength; ++length) {
+    for (size_t offset = 0; offset < kMaxOffset; ++offset) {
+      FillSamples(&random, &src);
+      FillSamples(&random, &dst);
+      for (float& gain : gains)
+        gain = random.Rand<float>();
+
+      expected = dst;
+      reference.add_with_saturation(&src[offset], length, &expected[0]);
+      kernels.add_with_saturation(&src[offset], length, &dst[0]);
+      ASSERT_EQ(expected, dst) << "add, length " << length << ", offset "
+                               << offset;
+
+      expected = dst;
+      reference.apply_gains(&gains[offset], length, &expected[offset]);
+      kernels.apply_gains(&gains[offset], length, &dst[offset]);
+      ASSERT_EQ(expected, dst) << "gains, length " << length << ", offset "
+                               << offset;
+
+      expected = dst;
+      reference.stereo_to_mono(&src[offset], length, &expected[0]);
+      kernels.stereo_to_mono(&src[offset], length, &dst[0]);
+      ASSERT_EQ(expected, dst) << "downmix, length " << length << ", offset "
+                               << offset;
+
+      // In place.
+      expected = src;
+      reference.stereo_to_mono(&expected[0], length, &expected[0]);
+      kernels.stereo_to_mono(&src[0], length, &src[0]);
+      ASSERT_EQ(expected, src) << "in-place downmix, length " << length;
+    }
+  }
+}
+}  // namespace
+
+TEST(AudioFrameKernelsTest, C) {
+  const int16_t kMax = std::numeric_limits<int16_t>::max();
+  const int16_t kMin = std::numeric_limits<int16_t>::min();
+  const AudioFrameKernels& kernels = GetAudioFrameKernelsC();
+
+  int16_t src[] = {1, kMax, kMin, -5, 100};
+  int16_t dst[] = {2, 1, -1, 5, -200};
+  kernels.add_with_saturation(src, 5, dst);
+  const int16_t kExpectedSum[] = {3, kMax, kMin, 0, -100};
+  for (size_t i = 0; i < 5; ++i)
+    EXPECT_EQ(kExpectedSum[i], dst[i]);
+
+  const float kGains[] = {0.0f, 0.5f, 0.5f, 1.0f, 0.25f};
+  int16_t audio[] = {1000, 3, -3, kMin, 7};
+  kernels.apply_gains(kGains, 5, audio);
+  const int16_t kExpectedScaled[] = {0, 1, -1, kMin, 1};
+  for (size_t i = 0; i < 5; ++i)
+    EXPECT_EQ(kExpectedScaled[i], audio[i]);
+
+  int16_t stereo[] = {4, 2, -3, 0, kMin, kMin, kMax, kMax};
+  kernels.stereo_to_mono(stereo, 4, stereo);
+  const int16_t kExpectedMono[] = {3, -2, kMin, kMax};
+  for (size_t i = 0; i < 4; ++i)
+    EXPECT_EQ(kExpectedMono[i], stereo[i]);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(AudioFrameKernelsTest, SSE2) {
+  const AudioFrameKernels kKernels = {AddWithSaturationSSE2, ApplyGainsSSE2,
+                                      StereoToMonoSSE2};
+  VerifyKernels(kKernels);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+TEST(AudioFrameKernelsTest, NEON) {
+  const AudioFrameKernels kKernels = {AddWithSaturationNEON, ApplyGainsNEON,
+                                      StereoToMonoNEON};
+  VerifyKernels(kKernels);
+}
+#endif
+
+TEST(AudioFrameKernelsTest, Selected) {
+  VerifyKernels(GetAudioFrameKernels());
+}
+
+}  // namespace internal
+}  // namespace webrtc
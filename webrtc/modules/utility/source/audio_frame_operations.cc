@@ -10,6 +10,7 @@
 
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/modules/utility/include/audio_frame_operations.h"
+#include "webrtc/modules/utility/source/audio_frame_kernels.h"
 #include "webrtc/base/checks.h"
 
 namespace webrtc {
@@ -51,9 +52,8 @@ int AudioFrameOperations::MonoToStereo(AudioFrame* frame) {
 void AudioFrameOperations::StereoToMono(const int16_t* src_audio,
                                         size_t samples_per_channel,
                                         int16_t* dst_audio) {
-  for (size_t i = 0; i < samples_per_channel; i++) {
-    dst_audio[i] = (src_audio[2 * i] + src_audio[2 * i + 1]) >> 1;
-  }
+  internal::GetAudioFrameKernels().stereo_to_mono(
+      src_audio, samples_per_channel, dst_audio);
 }
 
 int AudioFrameOperations::StereoToMono(AudioFrame* frame) {
@@ -67,6 +67,55 @@ int AudioFrameOperations::StereoToMono(AudioFrame* frame) {
   return 0;
 }
 
+void AudioFrameOperations::Add(const AudioFrame& frame_to_add,
+                               AudioFrame* result_frame) {
+  RTC_DCHECK(result_frame);
+  RTC_DCHECK_GT(result_frame->num_channels_, 0u);
+  RTC_DCHECK_LT(result_frame->num_channels_, 3u);
+  if ((result_frame->num_channels_ > 2) || (result_frame->num_channels_ < 1))
+    return;
+  if (result_frame->num_channels_ != frame_to_add.num_channels_)
+    return;
+
+  bool no_previous_data = false;
+  if (result_frame->samples_per_channel_ != frame_to_add.samples_per_channel_) {
+    if (result_frame->samples_per_channel_ == 0) {
+      // Special case we have no data to start with.
+      result_frame->samples_per_channel_ = frame_to_add.samples_per_channel_;
+      no_previous_data = true;
+    } else {
+      return;
+    }
+  }
+
+  if (result_frame->vad_activity_ == AudioFrame::kVadActive ||
+      frame_to_add.vad_activity_ == AudioFrame::kVadActive) {
+    result_frame->vad_activity_ = AudioFrame::kVadActive;
+  } else if (result_frame->vad_activity_ == AudioFrame::kVadUnknown ||
+             frame_to_add.vad_activity_ == AudioFrame::kVadUnknown) {
+    result_frame->vad_activity_ = AudioFrame::kVadUnknown;
+  }
+
+  if (result_frame->speech_type_ != frame_to_add.speech_type_)
+    result_frame->speech_type_ = AudioFrame::kUndefined;
+
+  const size_t total_samples =
+      frame_to_add.samples_per_channel_ * frame_to_add.num_channels_;
+  if (no_previous_data) {
+    memcpy(result_frame->data_, frame_to_add.data_,
+           sizeof(int16_t) * total_samples);
+  } else {
+    internal::GetAudioFrameKernels().add_with_saturation(
+        frame_to_add.data_, total_samples, result_frame->data_);
+  }
+}
+
+void AudioFrameOperations::ApplyGains(const float* gains,
+                                      size_t length,
+                                      int16_t* audio) {
+  internal::GetAudioFrameKernels().apply_gains(gains, length, audio);
+}
+
 void AudioFrameOperations::SwapStereoChannels(AudioFrame* frame) {
   if (frame->num_channels_ != 2) return;
 
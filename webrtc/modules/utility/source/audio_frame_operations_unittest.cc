@@ -146,6 +146,71 @@ TEST_F(AudioFrameOperationsTest, StereoToMonoDoesNotWrapAround) {
   VerifyFramesAreEqual(mono_frame, frame_);
 }
 
+TEST_F(AudioFrameOperationsTest, AddingTwoFramesSaturates) {
+  SetFrameData(&frame_, 30000, -30000);
+  AudioFrame frame_to_add;
+  InitFrame(&frame_to_add, 2, 320, 10000, -10000);
+  AudioFrameOperations::Add(frame_to_add, &frame_);
+
+  AudioFrame sum_frame;
+  InitFrame(&sum_frame, 2, 320, 32767, -32768);
+  VerifyFramesAreEqual(sum_frame, frame_);
+
+  InitFrame(&frame_to_add, 2, 320, -1000, 1000);
+  AudioFrameOperations::Add(frame_to_add, &frame_);
+  InitFrame(&sum_frame, 2, 320, 31767, -31768);
+  VerifyFramesAreEqual(sum_frame, frame_);
+}
+
+TEST_F(AudioFrameOperationsTest, AddingToEmptyFrameCopies) {
+  AudioFrame frame_to_add;
+  InitFrame(&frame_to_add, 2, 320, 1000, -1000);
+  frame_.samples_per_channel_ = 0;
+  AudioFrameOperations::Add(frame_to_add, &frame_);
+  VerifyFramesAreEqual(frame_to_add, frame_);
+}
+
+TEST_F(AudioFrameOperationsTest, AddingFramesWithDifferentLayoutsFails) {
+  SetFrameData(&frame_, 1000, -1000);
+  AudioFrame orig_frame;
+  orig_frame.CopyFrom(frame_);
+
+  AudioFrame frame_to_add;
+  InitFrame(&frame_to_add, 1, 320, 1000, 0);
+  AudioFrameOperations::Add(frame_to_add, &frame_);
+  VerifyFramesAreEqual(orig_frame, frame_);
+
+  InitFrame(&frame_to_add, 2, 160, 1000, -1000);
+  AudioFrameOperations::Add(frame_to_add, &frame_);
+  VerifyFramesAreEqual(orig_frame, frame_);
+}
+
+TEST_F(AudioFrameOperationsTest, AddingMergesVadAndSpeechType) {
+  SetFrameData(&frame_, 0, 0);
+  frame_.vad_activity_ = AudioFrame::kVadPassive;
+  frame_.speech_type_ = AudioFrame::kNormalSpeech;
+  AudioFrame frame_to_add;
+  InitFrame(&frame_to_add, 2, 320, 0, 0);
+  frame_to_add.vad_activity_ = AudioFrame::kVadActive;
+  frame_to_add.speech_type_ = AudioFrame::kCNG;
+  AudioFrameOperations::Add(frame_to_add, &frame_);
+  EXPECT_EQ(AudioFrame::kVadActive, frame_.vad_activity_);
+  EXPECT_EQ(AudioFrame::kUndefined, frame_.speech_type_);
+}
+
+TEST_F(AudioFrameOperationsTest, ApplyGainsScalesEachSample) {
+  frame_.num_channels_ = 1;
+  SetFrameData(&frame_, 1000);
+  const float kGains[] = {0.0f, 0.25f, 0.5f, 1.0f};
+  AudioFrameOperations::ApplyGains(kGains, 4, frame_.data_);
+  EXPECT_EQ(0, frame_.data_[0]);
+  EXPECT_EQ(250, frame_.data_[1]);
+  EXPECT_EQ(500, frame_.data_[2]);
+  EXPECT_EQ(1000, frame_.data_[3]);
+  // Samples beyond the gains are left untouched.
+  EXPECT_EQ(1000, frame_.data_[4]);
+}
+
 TEST_F(AudioFrameOperationsTest, SwapStereoChannelsSucceedsOnStereo) {
   SetFrameData(&frame_, 0, 1);
 
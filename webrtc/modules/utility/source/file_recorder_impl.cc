@@ -118,6 +118,12 @@ int32_t FileRecorderImpl::StartRecordingAudioFile(
     return retVal;
 }
 
+void FileRecorderImpl::SetFileWriteBuffering(int flushIntervalMs,
+                                             size_t maxBufferedBytes)
+{
+    _moduleFile->SetFileWriteBuffering(flushIntervalMs, maxBufferedBytes);
+}
+
 int32_t FileRecorderImpl::StopRecording()
 {
     memset(&codec_info_, 0, sizeof(CodecInst));
@@ -54,6 +54,8 @@ public:
         OutStream& destStream,
         const CodecInst& codecInst,
         uint32_t notificationTimeMs) override;
+    void SetFileWriteBuffering(int flushIntervalMs,
+                               size_t maxBufferedBytes) override;
     int32_t StopRecording() override;
     bool IsRecording() const override;
     int32_t codec_info(CodecInst& codecInst) const override;
@@ -13,6 +13,7 @@
 #include "webrtc/base/checks.h"
 #include "webrtc/base/timeutils.h"
 #include "webrtc/modules/include/module.h"
+#include "webrtc/modules/utility/source/process_thread_pool.h"
 #include "webrtc/system_wrappers/include/logging.h"
 
 namespace webrtc {
@@ -41,6 +42,15 @@ std::unique_ptr<ProcessThread> ProcessThread::Create(
   return std::unique_ptr<ProcessThread>(new ProcessThreadImpl(thread_name));
 }
 
+// static
+std::unique_ptr<ProcessThread> ProcessThread::Create(const char* thread_name,
+                                                     size_t num_threads) {
+  if (num_threads <= 1)
+    return Create(thread_name);
+  return std::unique_ptr<ProcessThread>(
+      new ProcessThreadPool(thread_name, num_threads));
+}
+
 ProcessThreadImpl::ProcessThreadImpl(const char* thread_name)
     : wake_up_(EventWrapper::Create()),
       stop_(false),
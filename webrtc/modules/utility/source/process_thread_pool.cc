@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/utility/source/process_thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/modules/utility/source/process_thread_impl.h"
+
+namespace webrtc {
+
+ProcessThreadPool::ProcessThreadPool(const char* thread_name,
+                                     size_t num_threads)
+    : num_modules_(num_threads, 0) {
+  RTC_DCHECK_GT(num_threads, 0u);
+  for (size_t i = 0; i < num_threads; ++i)
+    thread_names_.push_back(thread_name + rtc::ToString(i));
+  for (const std::string& name : thread_names_)
+    workers_.emplace_back(new ProcessThreadImpl(name.c_str()));
+}
+
+ProcessThreadPool::~ProcessThreadPool() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+}
+
+void ProcessThreadPool::Start() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  for (const auto& worker : workers_)
+    worker->Start();
+}
+
+void ProcessThreadPool::Stop() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  for (const auto& worker : workers_)
+    worker->Stop();
+}
+
+void ProcessThreadPool::WakeUp(Module* module) {
+  // Allowed to be called on any thread.
+  size_t worker;
+  {
+    rtc::CritScope lock(&lock_);
+    auto it = module_workers_.find(module);
+    if (it == module_workers_.end())
+      return;
+    worker = it->second;
+  }
+  workers_[worker]->WakeUp(module);
+}
+
+void ProcessThreadPool::PostTask(std::unique_ptr<ProcessTask> task) {
+  // Allowed to be called on any thread.
+  workers_[0]->PostTask(std::move(task));
+}
+
+void ProcessThreadPool::RegisterModule(Module* module) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK(module);
+
+  size_t worker;
+  {
+    rtc::CritScope lock(&lock_);
+    RTC_DCHECK(module_workers_.find(module) == module_workers_.end());
+    worker = std::min_element(num_modules_.begin(), num_modules_.end()) -
+             num_modules_.begin();
+    ++num_modules_[worker];
+    module_workers_[module] = worker;
+  }
+  workers_[worker]->RegisterModule(module);
+}
+
+void ProcessThreadPool::DeRegisterModule(Module* module) {
+  // Allowed to be called on any thread, like
+  // ProcessThreadImpl::DeRegisterModule().
+  RTC_DCHECK(module);
+
+  size_t worker;
+  {
+    rtc::CritScope lock(&lock_);
+    auto it = module_workers_.find(module);
+    if (it == module_workers_.end())
+      return;
+    worker = it->second;
+    --num_modules_[worker];
+    module_workers_.erase(it);
+  }
+  workers_[worker]->DeRegisterModule(module);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_UTILITY_SOURCE_PROCESS_THREAD_POOL_H_
+#define WEBRTC_MODULES_UTILITY_SOURCE_PROCESS_THREAD_POOL_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/base/thread_checker.h"
+#include "webrtc/modules/utility/include/process_thread.h"
+
+namespace webrtc {
+
+class ProcessThreadImpl;
+
+// Runs modules on several worker threads, so that independent modules are
+// processed in parallel. A module stays on the worker it was registered on,
+// the one with the fewest modules at the time, since modules expect
+// TimeUntilNextProcess() and Process() to be called on one thread. Modules
+// are attached to their worker, so their own WakeUp() calls go to it directly.
+// Tasks all run on the first worker, in the order they were posted.
+class ProcessThreadPool : public ProcessThread {
+ public:
+  ProcessThreadPool(const char* thread_name, size_t num_threads);
+  ~ProcessThreadPool() override;
+
+  void Start() override;
+  void Stop() override;
+
+  void WakeUp(Module* module) override;
+  void PostTask(std::unique_ptr<ProcessTask> task) override;
+
+  void RegisterModule(Module* module) override;
+  void DeRegisterModule(Module* module) override;
+
+ private:
+  rtc::ThreadChecker thread_checker_;
+  // Kept alive for the workers, which don't copy their names.
+  std::vector<std::string> thread_names_;
+  std::vector<std::unique_ptr<ProcessThreadImpl>> workers_;
+
+  rtc::CriticalSection lock_;
+  // Maps a module to the index of its worker.
+  std::map<Module*, size_t> module_workers_ GUARDED_BY(lock_);
+  std::vector<size_t> num_modules_ GUARDED_BY(lock_);  // Per worker.
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ProcessThreadPool);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_UTILITY_SOURCE_PROCESS_THREAD_POOL_H_
@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <utility>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/modules/include/module.h"
+#include "webrtc/modules/utility/source/process_thread_pool.h"
+#include "webrtc/system_wrappers/include/event_wrapper.h"
+
+namespace webrtc {
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::NotNull;
+using ::testing::Return;
+
+namespace {
+class MockModule : public Module {
+ public:
+  MOCK_METHOD0(TimeUntilNextProcess, int64_t());
+  MOCK_METHOD0(Process, void());
+  MOCK_METHOD1(ProcessThreadAttached, void(ProcessThread*));
+};
+
+class RaiseEventTask : public ProcessTask {
+ public:
+  explicit RaiseEventTask(EventWrapper* event) : event_(event) {}
+  void Run() override { event_->Set(); }
+
+ private:
+  EventWrapper* event_;
+};
+
+ACTION_P(SetEvent, event) {
+  event->Set();
+}
+
+ACTION_P(SetThreadRef, ptr) {
+  *ptr = rtc::CurrentThreadRef();
+}
+}  // namespace
+
+TEST(ProcessThreadPool, StartStop) {
+  ProcessThreadPool pool("ProcessThread", 2);
+  pool.Start();
+  pool.Stop();
+}
+
+// Verifies that modules registered on a pool get processed on different
+// threads.
+TEST(ProcessThreadPool, ProcessesModulesOnDifferentThreads) {
+  ProcessThreadPool pool("ProcessThread", 2);
+  std::unique_ptr<EventWrapper> event1(EventWrapper::Create());
+  std::unique_ptr<EventWrapper> event2(EventWrapper::Create());
+  rtc::PlatformThreadRef thread1;
+  rtc::PlatformThreadRef thread2;
+
+  MockModule module1;
+  MockModule module2;
+  EXPECT_CALL(module1, TimeUntilNextProcess()).WillRepeatedly(Return(0));
+  EXPECT_CALL(module1, Process())
+      .WillOnce(DoAll(SetThreadRef(&thread1), SetEvent(event1.get())))
+      .WillRepeatedly(Return());
+  EXPECT_CALL(module2, TimeUntilNextProcess()).WillRepeatedly(Return(0));
+  EXPECT_CALL(module2, Process())
+      .WillOnce(DoAll(SetThreadRef(&thread2), SetEvent(event2.get())))
+      .WillRepeatedly(Return());
+
+  pool.RegisterModule(&module1);
+  pool.RegisterModule(&module2);
+
+  EXPECT_CALL(module1, ProcessThreadAttached(NotNull())).Times(1);
+  EXPECT_CALL(module2, ProcessThreadAttached(NotNull())).Times(1);
+  pool.Start();
+  EXPECT_EQ(kEventSignaled, event1->Wait(100));
+  EXPECT_EQ(kEventSignaled, event2->Wait(100));
+  EXPECT_FALSE(rtc::IsThreadRefEqual(thread1, thread2));
+
+  EXPECT_CALL(module1, ProcessThreadAttached(nullptr)).Times(1);
+  EXPECT_CALL(module2, ProcessThreadAttached(nullptr)).Times(1);
+  pool.Stop();
+}
+
+TEST(ProcessThreadPool, WakeUp) {
+  ProcessThreadPool pool("ProcessThread", 2);
+  pool.Start();
+
+  std::unique_ptr<EventWrapper> started(EventWrapper::Create());
+  std::unique_ptr<EventWrapper> called(EventWrapper::Create());
+
+  MockModule module;
+  EXPECT_CALL(module, TimeUntilNextProcess())
+      .WillOnce(DoAll(SetEvent(started.get()), Return(1000)))
+      .WillRepeatedly(Return(1000));
+  EXPECT_CALL(module, Process())
+      .WillOnce(SetEvent(called.get()))
+      .WillRepeatedly(Return());
+
+  EXPECT_CALL(module, ProcessThreadAttached(NotNull())).Times(1);
+  pool.RegisterModule(&module);
+
+  EXPECT_EQ(kEventSignaled, started->Wait(100));
+  pool.WakeUp(&module);
+  EXPECT_EQ(kEventSignaled, called->Wait(100));
+
+  EXPECT_CALL(module, ProcessThreadAttached(nullptr)).Times(1);
+  pool.Stop();
+}
+
+// After deregistration, a module is detached and not processed anymore.
+TEST(ProcessThreadPool, Deregister) {
+  ProcessThreadPool pool("ProcessThread", 2);
+  std::unique_ptr<EventWrapper> event(EventWrapper::Create());
+
+  MockModule module;
+  EXPECT_CALL(module, TimeUntilNextProcess()).WillRepeatedly(Return(0));
+  EXPECT_CALL(module, Process())
+      .WillOnce(SetEvent(event.get()))
+      .WillRepeatedly(Return());
+
+  EXPECT_CALL(module, ProcessThreadAttached(NotNull())).Times(1);
+  pool.RegisterModule(&module);
+  pool.Start();
+  EXPECT_EQ(kEventSignaled, event->Wait(100));
+
+  EXPECT_CALL(module, ProcessThreadAttached(nullptr)).Times(1);
+  pool.DeRegisterModule(&module);
+
+  EXPECT_CALL(module, TimeUntilNextProcess()).Times(0);
+  EXPECT_CALL(module, Process()).Times(0);
+  // Deregistering twice does nothing.
+  pool.DeRegisterModule(&module);
+  pool.Stop();
+}
+
+TEST(ProcessThreadPool, PostTask) {
+  ProcessThreadPool pool("ProcessThread", 2);
+  std::unique_ptr<EventWrapper> task_ran(EventWrapper::Create());
+  std::unique_ptr<RaiseEventTask> task(new RaiseEventTask(task_ran.get()));
+  pool.Start();
+  pool.PostTask(std::move(task));
+  EXPECT_EQ(kEventSignaled, task_ran->Wait(100));
+  pool.Stop();
+}
+
+}  // namespace webrtc
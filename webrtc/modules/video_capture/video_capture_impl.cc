@@ -21,6 +21,7 @@
 #include "webrtc/system_wrappers/include/clock.h"
 #include "webrtc/system_wrappers/include/critical_section_wrapper.h"
 #include "webrtc/system_wrappers/include/logging.h"
+#include "webrtc/system_wrappers/include/metrics.h"
 
 namespace webrtc {
 namespace videocapturemodule {
@@ -161,6 +162,7 @@ VideoCaptureImpl::VideoCaptureImpl(const int32_t id)
     _requestedCapability.rawType = kVideoI420;
     _requestedCapability.codecType = kVideoCodecUnknown;
     memset(_incomingFrameTimesNanos, 0, sizeof(_incomingFrameTimesNanos));
+    _bufferPoolThreadChecker.DetachFromThread();
 }
 
 VideoCaptureImpl::~VideoCaptureImpl()
@@ -255,8 +257,6 @@ int32_t VideoCaptureImpl::IncomingFrame(
             return -1;
         }
 
-        int stride_y = width;
-        int stride_uv = (width + 1) / 2;
         int target_width = width;
         int target_height = height;
 
@@ -272,15 +272,20 @@ int32_t VideoCaptureImpl::IncomingFrame(
           }
         }
 
-        // TODO(mikhal): Update correct aligned stride values.
-        //Calc16ByteAlignedStride(target_width, &stride_y, &stride_uv);
+        if (!_bufferPoolThreadChecker.CalledOnValidThread()) {
+          // Only happens in builds with DCHECKs, where the pool checks that
+          // it is used on one thread.
+          _bufferPool.Release();
+          _bufferPoolThreadChecker.DetachFromThread();
+          // Attaches the checker to the current thread.
+          _bufferPoolThreadChecker.CalledOnValidThread();
+        }
         // Setting absolute height (in case it was negative).
         // In Windows, the image starts bottom left, instead of top left.
         // Setting a negative source height, inverts the image (within LibYuv).
-        _captureFrame.CreateEmptyFrame(target_width,
-                                       abs(target_height),
-                                       stride_y,
-                                       stride_uv, stride_uv);
+        _captureFrame.set_video_frame_buffer(
+            _bufferPool.CreateBuffer(target_width, abs(target_height)));
+        const int64_t conversionStartUs = rtc::TimeMicros();
         const int conversionResult = ConvertToI420(
             commonVideoType, videoFrame, 0, 0,  // No cropping
             width, height, videoFrameLength,
@@ -291,6 +296,8 @@ int32_t VideoCaptureImpl::IncomingFrame(
                         << frameInfo.rawType << "to I420.";
             return -1;
         }
+        RTC_HISTOGRAM_COUNTS_100000("WebRTC.Video.CaptureConversionTimeInUs",
+                                    rtc::TimeMicros() - conversionStartUs);
 
         if (!apply_rotation) {
           _captureFrame.set_rotation(_rotateFrame);
@@ -16,6 +16,8 @@
  */
 
 #include "webrtc/base/scoped_ref_ptr.h"
+#include "webrtc/base/thread_checker.h"
+#include "webrtc/common_video/include/i420_buffer_pool.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/common_video/rotation.h"
 #include "webrtc/modules/video_capture/video_capture.h"
@@ -138,6 +140,14 @@ private:
                                  // capture module.
 
     VideoFrame _captureFrame;
+    // Buffers which IncomingFrame() converts the captured frames into, so
+    // that large frames don't have to be allocated while the previous ones are
+    // still in use downstream.
+    I420BufferPool _bufferPool;
+    // The pool must be used on one thread, but some platforms deliver frames
+    // on a new thread after a restart of the capture, or on any thread of a
+    // dispatch queue. The pool is restarted when the thread changes.
+    rtc::ThreadChecker _bufferPoolThreadChecker;
 
     // Indicate whether rotation should be applied before delivered externally.
     bool apply_rotation_;
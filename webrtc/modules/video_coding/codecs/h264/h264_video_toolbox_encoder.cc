@@ -23,6 +23,7 @@
 #include "libyuv/convert_from.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/common_video/include/corevideo_frame_buffer.h"
 #include "webrtc/modules/video_coding/codecs/h264/h264_video_toolbox_nalu.h"
 #include "webrtc/system_wrappers/include/clock.h"
 
@@ -247,13 +248,6 @@ int H264VideoToolboxEncoder::InitEncode(const VideoCodec* codec_settings,
   return ResetCompressionSession();
 }
 
-const VideoFrame& H264VideoToolboxEncoder::GetScaledFrameOnEncode(
-    const VideoFrame& frame) {
-  rtc::CritScope lock(&quality_scaler_crit_);
-  quality_scaler_.OnEncodeFrame(frame);
-  return quality_scaler_.GetScaledFrame(frame);
-}
-
 int H264VideoToolboxEncoder::Encode(
     const VideoFrame& frame,
     const CodecSpecificInfo* codec_specific_info,
@@ -270,17 +264,55 @@ int H264VideoToolboxEncoder::Encode(
   }
 #endif
   bool is_keyframe_required = false;
-  const VideoFrame& input_image = GetScaledFrameOnEncode(frame);
+  // CVPixelBuffers are handed to the compression session as they are, unless
+  // they have to be cropped or scaled, in which case they're scaled straight
+  // into a buffer from the pool without leaving NV12. Everything else is
+  // converted to I420 if needed and copied into a buffer from the pool.
+  // CVPixelBuffer native handles always come from a CoreVideoFrameBuffer.
+  CoreVideoFrameBuffer* core_video_buffer = nullptr;
+  void* native_handle = frame.video_frame_buffer()->native_handle();
+  if (native_handle &&
+      CFGetTypeID(native_handle) == CVPixelBufferGetTypeID()) {
+    core_video_buffer =
+        static_cast<CoreVideoFrameBuffer*>(frame.video_frame_buffer().get());
+  }
+  VideoFrame converted_frame;
+  const VideoFrame* input_image = &frame;
+  int encode_width;
+  int encode_height;
+  {
+    rtc::CritScope lock(&quality_scaler_crit_);
+    quality_scaler_.OnEncodeFrame(frame);
+    const QualityScaler::Resolution res =
+        quality_scaler_.GetScaledResolution();
+    if (core_video_buffer) {
+      encode_width = res.width;
+      encode_height = res.height;
+    } else {
+      if (native_handle) {
+        converted_frame = frame.ConvertNativeToI420Frame();
+        if (converted_frame.IsZeroSize()) {
+          LOG(LS_ERROR) << "Failed to convert native frame to I420.";
+          return WEBRTC_VIDEO_CODEC_ERROR;
+        }
+        input_image = &converted_frame;
+      }
+      input_image = &quality_scaler_.GetScaledFrame(*input_image);
+      encode_width = input_image->width();
+      encode_height = input_image->height();
+    }
+  }
 
-  if (input_image.width() != width_ || input_image.height() != height_) {
-    width_ = input_image.width();
-    height_ = input_image.height();
+  if (encode_width != width_ || encode_height != height_) {
+    width_ = encode_width;
+    height_ = encode_height;
     int ret = ResetCompressionSession();
     if (ret < 0)
       return ret;
   }
 
-  // Get a pixel buffer from the pool and copy frame data over.
+  // The pool is only needed for copying, but failing to get it also tells us
+  // that the session has been invalidated.
   CVPixelBufferPoolRef pixel_buffer_pool =
       VTCompressionSessionGetPixelBufferPool(compression_session_);
 #if defined(WEBRTC_IOS)
@@ -301,19 +333,31 @@ int H264VideoToolboxEncoder::Encode(
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
   CVPixelBufferRef pixel_buffer = nullptr;
-  CVReturn ret = CVPixelBufferPoolCreatePixelBuffer(nullptr, pixel_buffer_pool,
-                                                    &pixel_buffer);
-  if (ret != kCVReturnSuccess) {
-    LOG(LS_ERROR) << "Failed to create pixel buffer: " << ret;
-    // We probably want to drop frames here, since failure probably means
-    // that the pool is empty.
-    return WEBRTC_VIDEO_CODEC_ERROR;
-  }
-  RTC_DCHECK(pixel_buffer);
-  if (!internal::CopyVideoFrameToPixelBuffer(input_image, pixel_buffer)) {
-    LOG(LS_ERROR) << "Failed to copy frame data.";
-    CVBufferRelease(pixel_buffer);
-    return WEBRTC_VIDEO_CODEC_ERROR;
+  if (core_video_buffer && !core_video_buffer->RequiresCropping() &&
+      frame.width() == width_ && frame.height() == height_) {
+    pixel_buffer = static_cast<CVPixelBufferRef>(native_handle);
+    CVBufferRetain(pixel_buffer);
+  } else {
+    // Get a pixel buffer from the pool and copy frame data over.
+    CVReturn ret = CVPixelBufferPoolCreatePixelBuffer(
+        nullptr, pixel_buffer_pool, &pixel_buffer);
+    if (ret != kCVReturnSuccess) {
+      LOG(LS_ERROR) << "Failed to create pixel buffer: " << ret;
+      // We probably want to drop frames here, since failure probably means
+      // that the pool is empty.
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+    RTC_DCHECK(pixel_buffer);
+    const bool copied =
+        core_video_buffer
+            ? core_video_buffer->CropAndScaleTo(pixel_buffer)
+            : internal::CopyVideoFrameToPixelBuffer(*input_image,
+                                                    pixel_buffer);
+    if (!copied) {
+      LOG(LS_ERROR) << "Failed to copy frame data.";
+      CVBufferRelease(pixel_buffer);
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
   }
 
   // Check if we need a keyframe.
@@ -327,7 +371,7 @@ int H264VideoToolboxEncoder::Encode(
   }
 
   CMTime presentation_time_stamp =
-      CMTimeMake(input_image.render_time_ms(), 1000);
+      CMTimeMake(input_image->render_time_ms(), 1000);
   CFDictionaryRef frame_properties = nullptr;
   if (is_keyframe_required) {
     CFTypeRef keys[] = {kVTEncodeFrameOptionKey_ForceKeyFrame};
@@ -336,8 +380,8 @@ int H264VideoToolboxEncoder::Encode(
   }
   std::unique_ptr<internal::FrameEncodeParams> encode_params;
   encode_params.reset(new internal::FrameEncodeParams(
-      this, codec_specific_info, width_, height_, input_image.render_time_ms(),
-      input_image.timestamp(), input_image.rotation()));
+      this, codec_specific_info, width_, height_, input_image->render_time_ms(),
+      input_image->timestamp(), input_image->rotation()));
 
   // Update the bitrate if needed.
   SetBitrateBps(bitrate_adjuster_.GetAdjustedBitrateBps());
@@ -487,6 +531,10 @@ const char* H264VideoToolboxEncoder::ImplementationName() const {
   return "VideoToolbox";
 }
 
+bool H264VideoToolboxEncoder::SupportsNativeHandle() const {
+  return true;
+}
+
 void H264VideoToolboxEncoder::SetBitrateBps(uint32_t bitrate_bps) {
   if (encoder_bitrate_bps_ != bitrate_bps) {
     SetEncoderBitrateBps(bitrate_bps);
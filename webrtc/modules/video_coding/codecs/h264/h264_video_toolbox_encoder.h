@@ -56,6 +56,8 @@ class H264VideoToolboxEncoder : public H264Encoder {
 
   const char* ImplementationName() const override;
 
+  bool SupportsNativeHandle() const override;
+
   void OnEncodedFrame(OSStatus status,
                       VTEncodeInfoFlags info_flags,
                       CMSampleBufferRef sample_buffer,
@@ -70,7 +72,6 @@ class H264VideoToolboxEncoder : public H264Encoder {
   int ResetCompressionSession();
   void ConfigureCompressionSession();
   void DestroyCompressionSession();
-  const VideoFrame& GetScaledFrameOnEncode(const VideoFrame& frame);
   void SetBitrateBps(uint32_t bitrate_bps);
   void SetEncoderBitrateBps(uint32_t bitrate_bps);
 
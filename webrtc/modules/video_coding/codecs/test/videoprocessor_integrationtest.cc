@@ -10,6 +10,8 @@
 
 #include <math.h>
 
+#include <string>
+
 #include "testing/gtest/include/gtest/gtest.h"
 
 #include "webrtc/modules/video_coding/include/video_codec_interface.h"
@@ -25,6 +27,7 @@
 #include "webrtc/test/testsupport/frame_writer.h"
 #include "webrtc/test/testsupport/metrics/video_metrics.h"
 #include "webrtc/test/testsupport/packet_reader.h"
+#include "webrtc/test/testsupport/perf_test.h"
 #include "webrtc/typedefs.h"
 
 namespace webrtc {
@@ -46,6 +49,10 @@ struct CodecConfigPars {
   bool denoising_on;
   bool frame_dropper_on;
   bool spatial_resize_on;
+  // Only used for VP9.
+  int num_spatial_layers;
+  // Lets the encoder use all cores, at the cost of predictability.
+  bool use_multiple_cores;
 };
 
 // Quality metrics.
@@ -148,8 +155,16 @@ class VideoProcessorIntegrationTest : public testing::Test {
   bool denoising_on_;
   bool frame_dropper_on_;
   bool spatial_resize_on_;
+  int num_spatial_layers_;
+  bool use_multiple_cores_;
 
-  VideoProcessorIntegrationTest() {}
+  VideoProcessorIntegrationTest()
+      : encoder_(nullptr),
+        decoder_(nullptr),
+        frame_reader_(nullptr),
+        frame_writer_(nullptr),
+        packet_manipulator_(nullptr),
+        processor_(nullptr) {}
   virtual ~VideoProcessorIntegrationTest() {}
 
   void SetUpCodecConfig() {
@@ -177,8 +192,9 @@ class VideoProcessorIntegrationTest : public testing::Test {
     config_.frame_length_in_bytes =
         CalcBufferSize(kI420, kCIFWidth, kCIFHeight);
     config_.verbose = false;
-    // Only allow encoder/decoder to use single core, for predictability.
-    config_.use_single_core = true;
+    // Unless measuring encode time, only allow encoder/decoder to use single
+    // core, for predictability.
+    config_.use_single_core = !use_multiple_cores_;
     // Key frame interval and packet loss are set for each test.
     config_.keyframe_interval = key_frame_interval_;
     config_.networking_config.packet_loss_probability = packet_loss_;
@@ -220,6 +236,8 @@ class VideoProcessorIntegrationTest : public testing::Test {
             spatial_resize_on_;
         config_.codec_settings->codecSpecific.VP9.keyFrameInterval =
             kBaseKeyFrameInterval;
+        config_.codec_settings->codecSpecific.VP9.numberOfSpatialLayers =
+            num_spatial_layers_;
         break;
       default:
         assert(false);
@@ -418,13 +436,23 @@ class VideoProcessorIntegrationTest : public testing::Test {
     }
   }
 
-  void TearDown() {
+  void TearDown() { TearDownCodecConfig(); }
+
+  // Deletes what SetUpCodecConfig() created, so that it can be called again.
+  void TearDownCodecConfig() {
     delete processor_;
+    processor_ = nullptr;
     delete packet_manipulator_;
+    packet_manipulator_ = nullptr;
     delete frame_writer_;
+    frame_writer_ = nullptr;
     delete frame_reader_;
+    frame_reader_ = nullptr;
     delete decoder_;
+    decoder_ = nullptr;
     delete encoder_;
+    encoder_ = nullptr;
+    stats_.stats_.clear();
   }
 
   // Processes all frames in the clip and verifies the result.
@@ -442,6 +470,8 @@ class VideoProcessorIntegrationTest : public testing::Test {
     denoising_on_ = process.denoising_on;
     frame_dropper_on_ = process.frame_dropper_on;
     spatial_resize_on_ = process.spatial_resize_on;
+    num_spatial_layers_ = process.num_spatial_layers;
+    use_multiple_cores_ = process.use_multiple_cores;
     SetUpCodecConfig();
     // Update the layers and the codec with the initial rates.
     bit_rate_ = rate_profile.target_bit_rate[0];
@@ -529,6 +559,75 @@ class VideoProcessorIntegrationTest : public testing::Test {
       fprintf(stderr, "Failed to remove temporary file!");
     }
   }
+
+  // Processes |num_frames| of the clip at a fixed rate and reports the average
+  // encode and decode time per frame, the quality and how far the encoded
+  // bitrate is from the target, so that codec configurations can be compared.
+  void ProcessFramesAndReportPerformance(CodecConfigPars process,
+                                         int bit_rate,
+                                         int num_frames,
+                                         const std::string& trace_name) {
+    codec_type_ = process.codec_type;
+    start_bitrate_ = bit_rate;
+    packet_loss_ = process.packet_loss;
+    key_frame_interval_ = process.key_frame_interval;
+    num_temporal_layers_ = process.num_temporal_layers;
+    error_concealment_on_ = process.error_concealment_on;
+    denoising_on_ = process.denoising_on;
+    frame_dropper_on_ = process.frame_dropper_on;
+    spatial_resize_on_ = process.spatial_resize_on;
+    num_spatial_layers_ = process.num_spatial_layers;
+    use_multiple_cores_ = process.use_multiple_cores;
+    SetUpCodecConfig();
+    const int kFrameRate = 30;
+    processor_->SetRates(bit_rate, kFrameRate);
+    int frame_number = 0;
+    while (frame_number < num_frames && processor_->ProcessFrame(frame_number))
+      ++frame_number;
+    EXPECT_EQ(num_frames, frame_number);
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder_->Release());
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, decoder_->Release());
+    frame_reader_->Close();
+    frame_writer_->Close();
+
+    webrtc::test::QualityMetricsResult psnr_result, ssim_result;
+    EXPECT_EQ(
+        0, webrtc::test::I420MetricsFromFiles(
+               config_.input_filename.c_str(), config_.output_filename.c_str(),
+               config_.codec_settings->width, config_.codec_settings->height,
+               &psnr_result, &ssim_result));
+    remove(config_.output_filename.c_str());
+
+    int64_t total_encode_time_us = 0;
+    int64_t total_decode_time_us = 0;
+    size_t total_encoded_bytes = 0;
+    for (const auto& frame_stat : stats_.stats_) {
+      total_encode_time_us += frame_stat.encode_time_in_us;
+      total_decode_time_us += frame_stat.decode_time_in_us;
+      total_encoded_bytes += frame_stat.encoded_frame_length_in_bytes;
+    }
+    ASSERT_FALSE(stats_.stats_.empty());
+    ASSERT_GT(frame_number, 0);
+    double encoded_kbps =
+        8.0 * total_encoded_bytes * kFrameRate / frame_number / 1000;
+    webrtc::test::PrintResult(
+        "encode_time", "", trace_name,
+        static_cast<size_t>(total_encode_time_us / stats_.stats_.size()),
+        "us", false);
+    webrtc::test::PrintResult(
+        "decode_time", "", trace_name,
+        static_cast<size_t>(total_decode_time_us / stats_.stats_.size()),
+        "us", false);
+    webrtc::test::PrintResult("psnr", "", trace_name,
+                              std::to_string(psnr_result.average), "dB",
+                              false);
+    webrtc::test::PrintResult("ssim", "", trace_name,
+                              std::to_string(ssim_result.average), "", false);
+    webrtc::test::PrintResult(
+        "bitrate_mismatch", "", trace_name,
+        std::to_string(100 * fabs(encoded_kbps - bit_rate) / bit_rate), "%",
+        false);
+  }
 };
 
 void SetRateProfilePars(RateProfile* rate_profile,
@@ -558,6 +657,8 @@ void SetCodecParameters(CodecConfigPars* process_settings,
   process_settings->denoising_on = denoising_on;
   process_settings->frame_dropper_on = frame_dropper_on;
   process_settings->spatial_resize_on = spatial_resize_on;
+  process_settings->num_spatial_layers = 1;
+  process_settings->use_multiple_cores = false;
 }
 
 void SetQualityMetrics(QualityMetrics* quality_metrics,
@@ -781,8 +882,47 @@ TEST_F(VideoProcessorIntegrationTest, ProcessNoLossSpatialResizeFrameDropVP9) {
 // TODO(marpan): Add temporal layer test for VP9, once changes are in
 // vp9 wrapper for this.
 
+// VP9: Performance with two spatial layers, with the encoder limited to one
+// core and allowed to use all of them. Not verified, only reported.
+TEST_F(VideoProcessorIntegrationTest, EncodeTimeSpatialLayersVP9) {
+  CodecConfigPars process_settings;
+  SetCodecParameters(&process_settings, kVideoCodecVP9, 0.0f, -1, 1, false,
+                     false, false, false);
+  process_settings.num_spatial_layers = 2;
+  ProcessFramesAndReportPerformance(process_settings, 500, kNbrFramesShort,
+                                    "vp9_2sl_single_core");
+}
+
+TEST_F(VideoProcessorIntegrationTest, EncodeTimeSpatialLayersMultiCoreVP9) {
+  CodecConfigPars process_settings;
+  SetCodecParameters(&process_settings, kVideoCodecVP9, 0.0f, -1, 1, false,
+                     false, false, false);
+  process_settings.num_spatial_layers = 2;
+  process_settings.use_multiple_cores = true;
+  ProcessFramesAndReportPerformance(process_settings, 500, kNbrFramesShort,
+                                    "vp9_2sl_multi_core");
+}
 #endif  // !defined(RTC_DISABLE_VP9)
 
+// VP8: Performance across target bitrates, with the encoder limited to one
+// core and allowed to use all of them. Not verified, only reported.
+TEST_F(VideoProcessorIntegrationTest, PerformanceSweepVP8) {
+  const int kBitRates[] = {200, 500, 1000};
+  for (bool use_multiple_cores : {false, true}) {
+    for (int bit_rate : kBitRates) {
+      CodecConfigPars process_settings;
+      SetCodecParameters(&process_settings, kVideoCodecVP8, 0.0f, -1, 1, false,
+                         false, false, false);
+      process_settings.use_multiple_cores = use_multiple_cores;
+      ProcessFramesAndReportPerformance(
+          process_settings, bit_rate, kNbrFramesShort,
+          "vp8_" + std::to_string(bit_rate) + "kbps_" +
+              (use_multiple_cores ? "multi_core" : "single_core"));
+      TearDownCodecConfig();
+    }
+  }
+}
+
 // VP8: Run with no packet loss and fixed bitrate. Quality should be very high.
 // One key frame (first frame only) in sequence. Setting |key_frame_interval|
 // to -1 below means no periodic key frames in test.
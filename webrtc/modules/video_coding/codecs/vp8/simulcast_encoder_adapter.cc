@@ -15,9 +15,12 @@
 // NOTE(ajm): Path provided by gyp.
 #include "libyuv/scale.h"  // NOLINT
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/checks.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/modules/video_coding/codecs/vp8/screenshare_layers.h"
 #include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/system_wrappers/include/field_trial.h"
 
 namespace {
 
@@ -26,6 +29,11 @@ const unsigned int kDefaultMaxQp = 56;
 // Max qp for lowest spatial resolution when doing simulcast.
 const unsigned int kLowestResMaxQp = 45;
 
+bool ParallelEncodingEnabled() {
+  return webrtc::field_trial::FindFullName(
+             "WebRTC-ParallelSimulcastEncoding") == "Enabled";
+}
+
 uint32_t SumStreamTargetBitrate(int streams, const webrtc::VideoCodec& codec) {
   uint32_t bitrate_sum = 0;
   for (int i = 0; i < streams; ++i) {
@@ -137,10 +145,76 @@ class AdapterEncodedImageCallback : public webrtc::EncodedImageCallback {
 
 namespace webrtc {
 
+// Waits for EncodeInParallel() to start, encodes the streams of its thread
+// index, and signals the adapter once the last thread is done.
+class SimulcastEncoderAdapter::EncoderThread {
+ public:
+  EncoderThread(SimulcastEncoderAdapter* adapter, size_t thread_index)
+      : adapter_(adapter),
+        thread_index_(thread_index),
+        start_(false, false),
+        quit_(0),
+        thread_(&EncoderThread::Run, this, "SimulcastEncoder") {
+    thread_.Start();
+    thread_.SetPriority(rtc::kHighPriority);
+  }
+
+  ~EncoderThread() {
+    rtc::AtomicOps::ReleaseStore(&quit_, 1);
+    start_.Set();
+    thread_.Stop();
+  }
+
+  void Start() { start_.Set(); }
+
+ private:
+  static bool Run(void* obj) {
+    return static_cast<EncoderThread*>(obj)->RunOnce();
+  }
+
+  bool RunOnce() {
+    start_.Wait(rtc::Event::kForever);
+    if (rtc::AtomicOps::AcquireLoad(&quit_))
+      return false;
+    adapter_->EncodeThreadStreams(thread_index_);
+    if (rtc::AtomicOps::Decrement(&adapter_->pending_threads_) == 0)
+      adapter_->threads_done_.Set();
+    return true;
+  }
+
+  SimulcastEncoderAdapter* const adapter_;
+  const size_t thread_index_;
+  rtc::Event start_;
+  volatile int quit_;
+  rtc::PlatformThread thread_;
+};
+
+SimulcastEncoderAdapter::DeferredImage::DeferredImage(
+    const EncodedImage& encoded_image,
+    const CodecSpecificInfo& codec_specific_info,
+    const RTPFragmentationHeader* fragmentation)
+    : image(encoded_image), codec_specific_info(codec_specific_info) {
+  if (encoded_image._buffer) {
+    buffer.reset(new uint8_t[encoded_image._length]);
+    memcpy(buffer.get(), encoded_image._buffer, encoded_image._length);
+  }
+  image._buffer = buffer.get();
+  image._size = image._length;
+  if (fragmentation) {
+    this->fragmentation.reset(new RTPFragmentationHeader());
+    this->fragmentation->CopyFrom(*fragmentation);
+  }
+}
+
 SimulcastEncoderAdapter::SimulcastEncoderAdapter(VideoEncoderFactory* factory)
     : factory_(factory),
       encoded_complete_callback_(NULL),
-      implementation_name_("SimulcastEncoderAdapter") {
+      implementation_name_("SimulcastEncoderAdapter"),
+      pending_threads_(0),
+      threads_done_(false, false),
+      parallel_codec_specific_info_(nullptr),
+      parallel_send_key_frame_(false),
+      defer_encoded_images_(false) {
   memset(&codec_, 0, sizeof(webrtc::VideoCodec));
 }
 
@@ -154,6 +228,11 @@ int SimulcastEncoderAdapter::Release() {
   // resolutions doesn't require reallocation of the first encoder, but only
   // reinitialization, which makes sense. Then Destroy this instance instead in
   // ~SimulcastEncoderAdapter().
+  // Join the encoder threads before the encoders go away.
+  encoder_threads_.clear();
+  thread_streams_.clear();
+  stream_frames_.clear();
+  scale_buffer_pool_.Release();
   while (!streaminfos_.empty()) {
     VideoEncoder* encoder = streaminfos_.back().encoder;
     EncodedImageCallback* callback = streaminfos_.back().callback;
@@ -236,6 +315,29 @@ int SimulcastEncoderAdapter::InitEncode(const VideoCodec* inst,
   } else {
     implementation_name_ = implementation_name;
   }
+
+  const size_t num_threads =
+      std::min(static_cast<size_t>(number_of_streams),
+               static_cast<size_t>(number_of_cores));
+  if (num_threads > 1 && ParallelEncodingEnabled()) {
+    // Balance the number of pixels per thread, taking the streams from the
+    // highest resolution down.
+    thread_streams_.resize(num_threads);
+    std::vector<int> thread_pixels(num_threads, 0);
+    for (int i = number_of_streams - 1; i >= 0; --i) {
+      size_t thread_index =
+          std::min_element(thread_pixels.begin(), thread_pixels.end()) -
+          thread_pixels.begin();
+      thread_streams_[thread_index].push_back(i);
+      thread_pixels[thread_index] +=
+          streaminfos_[i].width * streaminfos_[i].height;
+    }
+    encode_results_.resize(number_of_streams);
+    for (size_t thread_index = 1; thread_index < num_threads; ++thread_index) {
+      encoder_threads_.push_back(std::unique_ptr<EncoderThread>(
+          new EncoderThread(this, thread_index)));
+    }
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -269,21 +371,43 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  int src_width = input_image.width();
-  int src_height = input_image.height();
+  ScaleStreams(input_image);
+  if (!thread_streams_.empty())
+    return EncodeInParallel(codec_specific_info, send_key_frame);
+
   for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
     // Don't encode frames in resolutions that we don't intend to send.
     if (!streaminfos_[stream_idx].send_stream)
       continue;
 
-    std::vector<FrameType> stream_frame_types;
-    if (send_key_frame) {
-      stream_frame_types.push_back(kVideoFrameKey);
-      streaminfos_[stream_idx].key_frame_request = false;
-    } else {
-      stream_frame_types.push_back(kVideoFrameDelta);
+    int ret = EncodeStream(stream_idx, codec_specific_info, send_key_frame);
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
     }
+  }
 
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+void SimulcastEncoderAdapter::ScaleStreams(const VideoFrame& input_image) {
+  // Return the buffers of the previous frame to the pool first.
+  stream_frames_.assign(streaminfos_.size(), VideoFrame());
+
+  std::vector<size_t> streams_by_size;
+  for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
+    // Don't scale frames to resolutions that we don't intend to send.
+    if (streaminfos_[stream_idx].send_stream)
+      streams_by_size.push_back(stream_idx);
+  }
+  std::sort(streams_by_size.begin(), streams_by_size.end(),
+            [this](size_t a, size_t b) {
+              return streaminfos_[a].width * streaminfos_[a].height >
+                     streaminfos_[b].width * streaminfos_[b].height;
+            });
+
+  // The smallest frame scaled so far.
+  const VideoFrame* src_frame = &input_image;
+  for (size_t stream_idx : streams_by_size) {
     int dst_width = streaminfos_[stream_idx].width;
     int dst_height = streaminfos_[stream_idx].height;
     // If scaling isn't required, because the input resolution
@@ -291,47 +415,102 @@ int SimulcastEncoderAdapter::Encode(
     // a keyframe request for encoders with internal camera
     // sources), pass the image on directly. Otherwise, we'll
     // scale it to match what the encoder expects (below).
-    if ((dst_width == src_width && dst_height == src_height) ||
+    if ((dst_width == input_image.width() &&
+         dst_height == input_image.height()) ||
         input_image.IsZeroSize()) {
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          input_image, codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
-    } else {
-      VideoFrame dst_frame;
-      // Making sure that destination frame is of sufficient size.
-      // Aligning stride values based on width.
-      dst_frame.CreateEmptyFrame(dst_width, dst_height, dst_width,
-                                 (dst_width + 1) / 2, (dst_width + 1) / 2);
-      libyuv::I420Scale(input_image.video_frame_buffer()->DataY(),
-                        input_image.video_frame_buffer()->StrideY(),
-                        input_image.video_frame_buffer()->DataU(),
-                        input_image.video_frame_buffer()->StrideU(),
-                        input_image.video_frame_buffer()->DataV(),
-                        input_image.video_frame_buffer()->StrideV(),
-                        src_width, src_height,
-                        dst_frame.video_frame_buffer()->MutableDataY(),
-                        dst_frame.video_frame_buffer()->StrideY(),
-                        dst_frame.video_frame_buffer()->MutableDataU(),
-                        dst_frame.video_frame_buffer()->StrideU(),
-                        dst_frame.video_frame_buffer()->MutableDataV(),
-                        dst_frame.video_frame_buffer()->StrideV(),
-                        dst_width, dst_height,
-                        libyuv::kFilterBilinear);
-      dst_frame.set_timestamp(input_image.timestamp());
-      dst_frame.set_render_time_ms(input_image.render_time_ms());
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          dst_frame, codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+      stream_frames_[stream_idx] = input_image;
+      continue;
     }
+    if (dst_width > src_frame->width() || dst_height > src_frame->height())
+      src_frame = &input_image;
+
+    rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
+        scale_buffer_pool_.CreateBuffer(dst_width, dst_height);
+    libyuv::I420Scale(src_frame->video_frame_buffer()->DataY(),
+                      src_frame->video_frame_buffer()->StrideY(),
+                      src_frame->video_frame_buffer()->DataU(),
+                      src_frame->video_frame_buffer()->StrideU(),
+                      src_frame->video_frame_buffer()->DataV(),
+                      src_frame->video_frame_buffer()->StrideV(),
+                      src_frame->width(), src_frame->height(),
+                      dst_buffer->MutableDataY(), dst_buffer->StrideY(),
+                      dst_buffer->MutableDataU(), dst_buffer->StrideU(),
+                      dst_buffer->MutableDataV(), dst_buffer->StrideV(),
+                      dst_width, dst_height, libyuv::kFilterBilinear);
+    VideoFrame& dst_frame = stream_frames_[stream_idx];
+    dst_frame.set_video_frame_buffer(dst_buffer);
+    dst_frame.set_timestamp(input_image.timestamp());
+    dst_frame.set_render_time_ms(input_image.render_time_ms());
+    src_frame = &dst_frame;
+  }
+}
+
+int SimulcastEncoderAdapter::EncodeStream(
+    size_t stream_idx,
+    const CodecSpecificInfo* codec_specific_info,
+    bool send_key_frame) {
+  std::vector<FrameType> stream_frame_types;
+  if (send_key_frame) {
+    stream_frame_types.push_back(kVideoFrameKey);
+    streaminfos_[stream_idx].key_frame_request = false;
+  } else {
+    stream_frame_types.push_back(kVideoFrameDelta);
   }
+  return streaminfos_[stream_idx].encoder->Encode(
+      stream_frames_[stream_idx], codec_specific_info, &stream_frame_types);
+}
 
+int SimulcastEncoderAdapter::EncodeInParallel(
+    const CodecSpecificInfo* codec_specific_info,
+    bool send_key_frame) {
+  parallel_codec_specific_info_ = codec_specific_info;
+  parallel_send_key_frame_ = send_key_frame;
+  {
+    rtc::CritScope cs(&deferred_images_crit_);
+    defer_encoded_images_ = true;
+    deferred_images_.resize(streaminfos_.size());
+  }
+
+  rtc::AtomicOps::ReleaseStore(&pending_threads_,
+                               static_cast<int>(encoder_threads_.size()));
+  for (const auto& encoder_thread : encoder_threads_)
+    encoder_thread->Start();
+  EncodeThreadStreams(0);
+  threads_done_.Wait(rtc::Event::kForever);
+
+  std::vector<std::vector<DeferredImage>> deferred_images;
+  {
+    rtc::CritScope cs(&deferred_images_crit_);
+    defer_encoded_images_ = false;
+    deferred_images.swap(deferred_images_);
+  }
+  parallel_codec_specific_info_ = nullptr;
+
+  // Deliver in stream order, and stop at the first stream that failed, like
+  // the sequential encoding does.
+  for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
+    if (encode_results_[stream_idx] != WEBRTC_VIDEO_CODEC_OK)
+      return encode_results_[stream_idx];
+    for (const DeferredImage& deferred : deferred_images[stream_idx]) {
+      encoded_complete_callback_->Encoded(deferred.image,
+                                          &deferred.codec_specific_info,
+                                          deferred.fragmentation.get());
+    }
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+void SimulcastEncoderAdapter::EncodeThreadStreams(size_t thread_index) {
+  for (size_t stream_idx : thread_streams_[thread_index]) {
+    // Don't encode frames in resolutions that we don't intend to send.
+    encode_results_[stream_idx] =
+        streaminfos_[stream_idx].send_stream
+            ? EncodeStream(stream_idx, parallel_codec_specific_info_,
+                           parallel_send_key_frame_)
+            : WEBRTC_VIDEO_CODEC_OK;
+  }
+}
+
 int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   encoded_complete_callback_ = callback;
@@ -407,6 +586,14 @@ int32_t SimulcastEncoderAdapter::Encoded(
   CodecSpecificInfoVP8* vp8Info = &(stream_codec_specific.codecSpecific.VP8);
   vp8Info->simulcastIdx = stream_idx;
 
+  {
+    rtc::CritScope cs(&deferred_images_crit_);
+    if (defer_encoded_images_) {
+      deferred_images_[stream_idx].push_back(
+          DeferredImage(encodedImage, stream_codec_specific, fragmentation));
+      return 0;
+    }
+  }
   return encoded_complete_callback_->Encoded(
       encodedImage, &stream_codec_specific, fragmentation);
 }
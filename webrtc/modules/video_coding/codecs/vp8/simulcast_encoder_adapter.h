@@ -16,6 +16,10 @@
 #include <string>
 #include <vector>
 
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/common_video/include/i420_buffer_pool.h"
+#include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/modules/video_coding/codecs/vp8/include/vp8.h"
 
 namespace webrtc {
@@ -31,6 +35,12 @@ class VideoEncoderFactory {
 // webrtc::VideoEncoder instances with the given VideoEncoderFactory.
 // All the public interfaces are expected to be called from the same thread,
 // e.g the encoder thread.
+//
+// With the field trial WebRTC-ParallelSimulcastEncoding enabled and more than
+// one core, the streams of a frame are encoded concurrently, on the encoder
+// thread and on a few threads owned by the adapter. Encoded images are then
+// held back until all streams are done, and delivered on the encoder thread
+// in stream order, as with sequential encoding.
 class SimulcastEncoderAdapter : public VP8Encoder {
  public:
   explicit SimulcastEncoderAdapter(VideoEncoderFactory* factory);
@@ -109,12 +119,71 @@ class SimulcastEncoderAdapter : public VP8Encoder {
 
   bool Initialized() const;
 
+  // Fills |stream_frames_| with |input_image| at the resolution of every
+  // stream that is sent. The streams are scaled from the highest resolution
+  // down, each from the previous one when it's large enough, so that the
+  // lower resolutions are produced as a pyramid instead of each from the full
+  // resolution.
+  void ScaleStreams(const VideoFrame& input_image);
+
+  // Encodes |stream_frames_[stream_idx]| with that stream's encoder.
+  int EncodeStream(size_t stream_idx,
+                   const CodecSpecificInfo* codec_specific_info,
+                   bool send_key_frame);
+
+  // Encodes all streams in parallel, and then delivers their encoded images.
+  int EncodeInParallel(const CodecSpecificInfo* codec_specific_info,
+                       bool send_key_frame);
+
+  // Encodes the streams assigned to |thread_index|, with the arguments of the
+  // ongoing EncodeInParallel() call. Thread 0 is the encoder thread.
+  void EncodeThreadStreams(size_t thread_index);
+
+  class EncoderThread;
+
+  // An encoded image that is held back until all streams of a parallel
+  // encode are done. Owns copies of the payload and fragmentation.
+  struct DeferredImage {
+    DeferredImage(const EncodedImage& encoded_image,
+                  const CodecSpecificInfo& codec_specific_info,
+                  const RTPFragmentationHeader* fragmentation);
+
+    EncodedImage image;
+    std::unique_ptr<uint8_t[]> buffer;
+    CodecSpecificInfo codec_specific_info;
+    std::unique_ptr<RTPFragmentationHeader> fragmentation;
+  };
+
   std::unique_ptr<VideoEncoderFactory> factory_;
   std::unique_ptr<TemporalLayersFactory> screensharing_tl_factory_;
   VideoCodec codec_;
   std::vector<StreamInfo> streaminfos_;
   EncodedImageCallback* encoded_complete_callback_;
   std::string implementation_name_;
+
+  // The input frame scaled for each stream, in buffers from
+  // |scale_buffer_pool_|. Only valid during Encode().
+  std::vector<VideoFrame> stream_frames_;
+  I420BufferPool scale_buffer_pool_;
+
+  // State for parallel encoding. |thread_streams_| lists the streams encoded
+  // by each thread, and is empty if the streams are encoded sequentially.
+  std::vector<std::vector<size_t>> thread_streams_;
+  std::vector<std::unique_ptr<EncoderThread>> encoder_threads_;
+  volatile int pending_threads_;
+  rtc::Event threads_done_;
+  // The arguments of the ongoing EncodeInParallel() call, and the result for
+  // each stream.
+  const CodecSpecificInfo* parallel_codec_specific_info_;
+  bool parallel_send_key_frame_;
+  std::vector<int> encode_results_;
+
+  // Encoded images may be delivered on any thread while the streams are
+  // encoded in parallel.
+  rtc::CriticalSection deferred_images_crit_;
+  bool defer_encoded_images_ GUARDED_BY(deferred_images_crit_);
+  std::vector<std::vector<DeferredImage>> deferred_images_
+      GUARDED_BY(deferred_images_crit_);
 };
 
 }  // namespace webrtc
@@ -12,9 +12,11 @@
 #include <vector>
 
 #include "testing/gmock/include/gmock/gmock.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/modules/video_coding/include/video_codec_interface.h"
 #include "webrtc/modules/video_coding/codecs/vp8/simulcast_encoder_adapter.h"
 #include "webrtc/modules/video_coding/codecs/vp8/simulcast_unittest.h"
+#include "webrtc/test/field_trial.h"
 
 namespace webrtc {
 namespace testing {
@@ -121,6 +123,11 @@ class MockVideoEncoder : public VideoEncoder {
   int32_t Encode(const VideoFrame& inputImage,
                  const CodecSpecificInfo* codecSpecificInfo,
                  const std::vector<FrameType>* frame_types) /* override */ {
+    last_frame_width_ = inputImage.width();
+    last_frame_height_ = inputImage.height();
+    last_frame_data_y_ = inputImage.video_frame_buffer()->DataY();
+    if (send_image_on_encode_)
+      SendEncodedImage(codec_.width, codec_.height);
     return encode_return_value_;
   }
 
@@ -164,11 +171,27 @@ class MockVideoEncoder : public VideoEncoder {
     encode_return_value_ = value;
   }
 
+  // Makes Encode() deliver an image of the configured resolution before it
+  // returns, like VP8EncoderImpl does.
+  void set_send_image_on_encode(bool enabled) {
+    send_image_on_encode_ = enabled;
+  }
+
   MOCK_CONST_METHOD0(ImplementationName, const char*());
 
+  // The frame passed to the last Encode() call. The frame itself isn't kept,
+  // so that its buffer can go back to the adapter's pool.
+  int last_frame_width() const { return last_frame_width_; }
+  int last_frame_height() const { return last_frame_height_; }
+  const uint8_t* last_frame_data_y() const { return last_frame_data_y_; }
+
  private:
   bool supports_native_handle_ = false;
+  int last_frame_width_ = 0;
+  int last_frame_height_ = 0;
+  const uint8_t* last_frame_data_y_ = nullptr;
   int encode_return_value_ = WEBRTC_VIDEO_CODEC_OK;
+  bool send_image_on_encode_ = false;
   VideoCodec codec_;
   EncodedImageCallback* callback_;
 };
@@ -494,5 +517,117 @@ TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
             adapter_->Encode(input_frame, nullptr, &frame_types));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake, ScalesStreamsIntoPooledBuffers) {
+  TestVp8Simulcast::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile));
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, 1, 1200));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  // Set bitrates so that we send all layers.
+  adapter_->SetRates(1200, 30);
+  const std::vector<MockVideoEncoder*>& encoders =
+      helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  VideoFrame input_frame;
+  int half_width = (kDefaultWidth + 1) / 2;
+  input_frame.CreateEmptyFrame(kDefaultWidth, kDefaultHeight, kDefaultWidth,
+                               half_width, half_width);
+  memset(input_frame.video_frame_buffer()->MutableDataY(), 0,
+         input_frame.allocated_size(kYPlane));
+  memset(input_frame.video_frame_buffer()->MutableDataU(), 0,
+         input_frame.allocated_size(kUPlane));
+  memset(input_frame.video_frame_buffer()->MutableDataV(), 0,
+         input_frame.allocated_size(kVPlane));
+  std::vector<FrameType> frame_types(3, kVideoFrameDelta);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+
+  std::vector<const uint8_t*> data_y;
+  for (size_t i = 0; i < encoders.size(); ++i) {
+    EXPECT_EQ(codec_.simulcastStream[i].width, encoders[i]->last_frame_width());
+    EXPECT_EQ(codec_.simulcastStream[i].height,
+              encoders[i]->last_frame_height());
+    data_y.push_back(encoders[i]->last_frame_data_y());
+  }
+  // The top stream is encoded from the input frame as it is.
+  EXPECT_EQ(input_frame.video_frame_buffer()->DataY(), data_y[2]);
+
+  // The next frame is scaled into the same buffers.
+  EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+  for (size_t i = 0; i < encoders.size(); ++i)
+    EXPECT_EQ(data_y[i], encoders[i]->last_frame_data_y());
+}
+
+// Records the encoded images it gets, and the threads they're delivered on.
+class EncodedImageRecorder : public EncodedImageCallback {
+ public:
+  int32_t Encoded(const EncodedImage& encoded_image,
+                  const CodecSpecificInfo* codec_specific_info,
+                  const RTPFragmentationHeader* fragmentation) override {
+    widths_.push_back(encoded_image._encodedWidth);
+    simulcast_indices_.push_back(
+        codec_specific_info->codecSpecific.VP8.simulcastIdx);
+    if (!rtc::IsThreadRefEqual(rtc::CurrentThreadRef(), thread_))
+      ++images_on_other_threads_;
+    return 0;
+  }
+
+  void Reset() {
+    widths_.clear();
+    simulcast_indices_.clear();
+  }
+
+  std::vector<uint32_t> widths_;
+  std::vector<int> simulcast_indices_;
+  int images_on_other_threads_ = 0;
+
+ private:
+  const rtc::PlatformThreadRef thread_ = rtc::CurrentThreadRef();
+};
+
+TEST_F(TestSimulcastEncoderAdapterFake, ParallelEncodingKeepsStreamOrder) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-ParallelSimulcastEncoding/Enabled/");
+  TestVp8Simulcast::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile));
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, 4, 1200));
+  EncodedImageRecorder recorder;
+  adapter_->RegisterEncodeCompleteCallback(&recorder);
+  // Set bitrates so that we send all layers.
+  adapter_->SetRates(1200, 30);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+  for (MockVideoEncoder* encoder : helper_->factory()->encoders())
+    encoder->set_send_image_on_encode(true);
+
+  VideoFrame input_frame;
+  int half_width = (kDefaultWidth + 1) / 2;
+  input_frame.CreateEmptyFrame(kDefaultWidth, kDefaultHeight, kDefaultWidth,
+                               half_width, half_width);
+  memset(input_frame.video_frame_buffer()->MutableDataY(), 0,
+         input_frame.allocated_size(kYPlane));
+  memset(input_frame.video_frame_buffer()->MutableDataU(), 0,
+         input_frame.allocated_size(kUPlane));
+  memset(input_frame.video_frame_buffer()->MutableDataV(), 0,
+         input_frame.allocated_size(kVPlane));
+  std::vector<FrameType> frame_types(3, kVideoFrameDelta);
+  for (int i = 0; i < 10; ++i) {
+    recorder.Reset();
+    EXPECT_EQ(0, adapter_->Encode(input_frame, nullptr, &frame_types));
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), recorder.simulcast_indices_);
+    EXPECT_EQ(std::vector<uint32_t>({codec_.simulcastStream[0].width,
+                                     codec_.simulcastStream[1].width,
+                                     codec_.simulcastStream[2].width}),
+              recorder.widths_);
+  }
+  EXPECT_EQ(0, recorder.images_on_other_threads_);
+
+  // Only the images of the streams before a failing one are delivered.
+  helper_->factory()->encoders()[1]->set_encode_return_value(
+      WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE);
+  recorder.Reset();
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE,
+            adapter_->Encode(input_frame, nullptr, &frame_types));
+  EXPECT_EQ(std::vector<int>({0}), recorder.simulcast_indices_);
+}
+
 }  // namespace testing
 }  // namespace webrtc
@@ -63,6 +63,7 @@ int Vp8UnitTestEncodeCompleteCallback::Encoded(
   encoded_frame_->_timeStamp = encoded_frame._timeStamp;
   encoded_frame_->_frameType = encoded_frame._frameType;
   encoded_frame_->_completeFrame = encoded_frame._completeFrame;
+  encoded_frame_->encode_time_us_ = encoded_frame.encode_time_us_;
   encode_complete_ = true;
   return 0;
 }
@@ -230,6 +231,7 @@ TEST_F(TestVp8Impl, MAYBE_AlignedStrideEncodeDecode) {
   SetUpEncodeDecode();
   encoder_->Encode(input_frame_, NULL, NULL);
   EXPECT_GT(WaitForEncodedFrame(), 0u);
+  EXPECT_GE(encoded_frame_.encode_time_us_, 0);
   // First frame should be a key frame.
   encoded_frame_._frameType = kVideoFrameKey;
   encoded_frame_.ntp_time_ms_ = kTestNtpTimeMs;
@@ -267,4 +269,42 @@ TEST_F(TestVp8Impl, MAYBE_DecodeWithACompleteKeyFrame) {
   EXPECT_GT(I420PSNR(&input_frame_, &decoded_frame_), 36);
 }
 
+#if defined(WEBRTC_ANDROID)
+#define MAYBE_ScreenshareEncodesChangedMacroblocks \
+  DISABLED_ScreenshareEncodesChangedMacroblocks
+#else
+#define MAYBE_ScreenshareEncodesChangedMacroblocks \
+  ScreenshareEncodesChangedMacroblocks
+#endif
+TEST_F(TestVp8Impl, MAYBE_ScreenshareEncodesChangedMacroblocks) {
+  codec_inst_.mode = kScreensharing;
+  SetUpEncodeDecode();
+  encoder_->Encode(input_frame_, NULL, NULL);
+  EXPECT_GT(WaitForEncodedFrame(), 0u);
+  EXPECT_EQ(kVideoFrameKey, encoded_frame_._frameType);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            decoder_->Decode(encoded_frame_, false, NULL));
+  EXPECT_GT(WaitForDecodedFrame(), 0u);
+
+  // Change a block which spans several macroblocks, and encode the same frame
+  // once more after that.
+  VideoFrame changed_frame;
+  changed_frame.CopyFrame(input_frame_);
+  for (int y = 20; y < 60; ++y) {
+    memset(changed_frame.video_frame_buffer()->MutableDataY() +
+               y * changed_frame.video_frame_buffer()->StrideY() + 40,
+           255, 40);
+  }
+  for (int i = 0; i < 2; ++i) {
+    changed_frame.set_timestamp(kTestTimestamp + 3000 * (i + 1));
+    encoder_->Encode(changed_frame, NULL, NULL);
+    EXPECT_GT(WaitForEncodedFrame(), 0u);
+    EXPECT_EQ(kVideoFrameDelta, encoded_frame_._frameType);
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+              decoder_->Decode(encoded_frame_, false, NULL));
+    EXPECT_GT(WaitForDecodedFrame(), 0u);
+    EXPECT_GT(I420PSNR(&changed_frame, &decoded_frame_), 36);
+  }
+}
+
 }  // namespace webrtc
@@ -59,6 +59,62 @@ int GCD(int a, int b) {
   return b;
 }
 
+// Marks the blocks of |block_width| pixels in which the rows |a| and |b|, of
+// |width| pixels each, differ in |changed|.
+void MarkChangedBlocks(const uint8_t* a,
+                       const uint8_t* b,
+                       int width,
+                       int block_width,
+                       uint8_t* changed) {
+  // Most rows of screen content are unchanged.
+  if (memcmp(a, b, width) == 0)
+    return;
+  for (int x = 0, block = 0; x < width; x += block_width, ++block) {
+    if (!changed[block] &&
+        memcmp(a + x, b + x, std::min(block_width, width - x)) != 0) {
+      changed[block] = 1;
+    }
+  }
+}
+
+// Sets the macroblocks in which |frame| differs from |reference| as active in
+// |active_map|, and the others as inactive. Returns the number of active
+// macroblocks.
+int UpdateActiveMap(const VideoFrameBuffer& frame,
+                    const VideoFrameBuffer& reference,
+                    std::vector<uint8_t>* active_map) {
+  const int kMacroblockSize = 16;
+  const int width = frame.width();
+  const int height = frame.height();
+  const int chroma_width = (width + 1) / 2;
+  const int chroma_height = (height + 1) / 2;
+  const int cols = (width + kMacroblockSize - 1) / kMacroblockSize;
+  const int rows = (height + kMacroblockSize - 1) / kMacroblockSize;
+  active_map->assign(rows * cols, 0);
+  int num_active = 0;
+  for (int row = 0; row < rows; ++row) {
+    uint8_t* map_row = &(*active_map)[row * cols];
+    const int y_end = std::min(height, (row + 1) * kMacroblockSize);
+    for (int y = row * kMacroblockSize; y < y_end; ++y) {
+      MarkChangedBlocks(frame.DataY() + y * frame.StrideY(),
+                        reference.DataY() + y * reference.StrideY(), width,
+                        kMacroblockSize, map_row);
+    }
+    const int chroma_y_end =
+        std::min(chroma_height, (row + 1) * kMacroblockSize / 2);
+    for (int y = row * kMacroblockSize / 2; y < chroma_y_end; ++y) {
+      MarkChangedBlocks(frame.DataU() + y * frame.StrideU(),
+                        reference.DataU() + y * reference.StrideU(),
+                        chroma_width, kMacroblockSize / 2, map_row);
+      MarkChangedBlocks(frame.DataV() + y * frame.StrideV(),
+                        reference.DataV() + y * reference.StrideV(),
+                        chroma_width, kMacroblockSize / 2, map_row);
+    }
+    num_active += std::count(map_row, map_row + cols, 1);
+  }
+  return num_active;
+}
+
 std::vector<int> GetStreamBitratesKbps(const VideoCodec& codec,
                                        int bitrate_to_allocate_kbps) {
   if (codec.numberOfSimulcastStreams <= 1) {
@@ -165,7 +221,8 @@ VP8EncoderImpl::VP8EncoderImpl()
       tl0_frame_dropper_(),
       tl1_frame_dropper_(kTl1MaxTimeToDropFrames),
       key_frame_request_(kMaxSimulcastStreams, false),
-      quality_scaler_enabled_(false) {
+      quality_scaler_enabled_(false),
+      active_map_enabled_(false) {
   uint32_t seed = rtc::Time32();
   srand(seed);
 
@@ -211,6 +268,8 @@ int VP8EncoderImpl::Release() {
     delete temporal_layers_.back();
     temporal_layers_.pop_back();
   }
+  last_reference_buffer_ = nullptr;
+  active_map_enabled_ = false;
   inited_ = false;
   return ret_val;
 }
@@ -729,6 +788,7 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
   if (encoded_complete_callback_ == NULL)
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
 
+  const int64_t encode_start_us = rtc::TimeMicros();
   if (quality_scaler_enabled_)
     quality_scaler_.OnEncodeFrame(frame);
   const VideoFrame& input_image =
@@ -865,6 +925,8 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
       }
     }
   }
+  if (encoders_.size() == 1 && codec_.mode == kScreensharing)
+    SetActiveMap(input_image, flags[0]);
   // Set the encoder frame flags and temporal layer_id for each spatial stream.
   // Note that |temporal_layers_| are defined starting from lowest resolution at
   // position 0 to highest resolution at position |encoders_.size() - 1|,
@@ -895,6 +957,8 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
 
   // Note we must pass 0 for |flags| field in encode call below since they are
   // set above in |vpx_codec_control| function for each encoder/spatial layer.
+  // With more than one encoder this encodes all of them, using the shared
+  // multi-resolution analysis set up by vpx_codec_enc_init_multi().
   int error = vpx_codec_encode(&encoders_[0], &raw_images_[0], timestamp_,
                                duration, 0, VPX_DL_REALTIME);
   // Reset specific intra frame thresholds, following the key frame.
@@ -905,7 +969,47 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
   if (error)
     return WEBRTC_VIDEO_CODEC_ERROR;
   timestamp_ += duration;
-  return GetEncodedPartitions(input_image, only_predict_from_key_frame);
+  const int result =
+      GetEncodedPartitions(input_image, only_predict_from_key_frame,
+                           rtc::TimeMicros() - encode_start_us);
+  // A frame dropped by the rate control doesn't update any reference buffer.
+  if (encoders_.size() == 1 && codec_.mode == kScreensharing &&
+      encoded_images_[0]._length > 0 && !(flags[0] & VP8_EFLAG_NO_UPD_LAST)) {
+    last_reference_buffer_ = input_image.video_frame_buffer();
+  }
+  return result;
+}
+
+void VP8EncoderImpl::SetActiveMap(const VideoFrame& input_image,
+                                  vpx_enc_frame_flags_t flags) {
+  const rtc::scoped_refptr<VideoFrameBuffer>& buffer =
+      input_image.video_frame_buffer();
+  vpx_active_map_t map;
+  map.rows = (buffer->height() + 15) / 16;
+  map.cols = (buffer->width() + 15) / 16;
+  // No map means that all macroblocks are active. Inactive macroblocks are
+  // copied from the last reference buffer, so the map is only usable when the
+  // frame is predicted from it, and the reference is the same resolution.
+  // Key frames ignore the map.
+  map.active_map = nullptr;
+  if (!(flags & (VPX_EFLAG_FORCE_KF | VP8_EFLAG_NO_REF_LAST)) &&
+      last_reference_buffer_ &&
+      last_reference_buffer_->width() == buffer->width() &&
+      last_reference_buffer_->height() == buffer->height()) {
+    int num_active = 0;
+    if (buffer == last_reference_buffer_) {
+      active_map_.assign(map.rows * map.cols, 0);
+    } else {
+      num_active =
+          UpdateActiveMap(*buffer, *last_reference_buffer_, &active_map_);
+    }
+    if (num_active < static_cast<int>(map.rows * map.cols))
+      map.active_map = active_map_.data();
+  }
+  if (!map.active_map && !active_map_enabled_)
+    return;
+  vpx_codec_control(&encoders_[0], VP8E_SET_ACTIVEMAP, &map);
+  active_map_enabled_ = map.active_map != nullptr;
 }
 
 // TODO(pbos): Make sure this works for properly for >1 encoders.
@@ -962,7 +1066,8 @@ void VP8EncoderImpl::PopulateCodecSpecific(
 }
 
 int VP8EncoderImpl::GetEncodedPartitions(const VideoFrame& input_image,
-                                         bool only_predicting_from_key_frame) {
+                                         bool only_predicting_from_key_frame,
+                                         int64_t encode_time_us) {
   int bw_resolutions_disabled =
       (encoders_.size() > 1) ? NumStreamsDisabled(send_stream_) : -1;
 
@@ -1024,6 +1129,7 @@ int VP8EncoderImpl::GetEncodedPartitions(const VideoFrame& input_image,
     encoded_images_[encoder_idx].capture_time_ms_ =
         input_image.render_time_ms();
     encoded_images_[encoder_idx].rotation_ = input_image.rotation();
+    encoded_images_[encoder_idx].encode_time_us_ = encode_time_us;
 
     int qp = -1;
     vpx_codec_control(&encoders_[encoder_idx], VP8E_GET_LAST_QUANTIZER_64, &qp);
@@ -1108,8 +1214,10 @@ int VP8DecoderImpl::InitDecode(const VideoCodec* inst, int number_of_cores) {
     feedback_mode_ = inst->codecSpecific.VP8.feedbackModeOn;
   }
   vpx_codec_dec_cfg_t cfg;
-  // Setting number of threads to a constant value (1)
-  cfg.threads = 1;
+  // |number_of_cores| is how many cores the decoder may use. libvpx decodes
+  // macroblock rows in parallel when the stream has several token partitions.
+  const int kMaxDecoderThreads = 8;
+  cfg.threads = std::max(1, std::min(number_of_cores, kMaxDecoderThreads));
   cfg.h = cfg.w = 0;  // set after decode
 
   vpx_codec_flags_t flags = 0;
@@ -1353,7 +1461,11 @@ int VP8DecoderImpl::ReturnFrame(const vpx_image_t* img,
   }
   last_frame_width_ = img->d_w;
   last_frame_height_ = img->d_h;
-  // Allocate memory for decoded image.
+  // Unlike VP9 (see Vp9FrameBufferPool) and H.264 (see
+  // H264DecoderImpl::AVGetBuffer2), the VP8 decoder can't decode into buffers
+  // we own: libvpx keeps its own reference frames and does not support
+  // external frame buffers for VP8. |img| is overwritten by the next decode, so
+  // it is copied, into a pooled buffer to at least avoid the allocation.
   VideoFrame decoded_image(buffer_pool_.CreateBuffer(img->d_w, img->d_h),
                            timestamp, 0, kVideoRotation_0);
   libyuv::I420Copy(img->planes[VPX_PLANE_Y], img->stride[VPX_PLANE_Y],
@@ -83,14 +83,23 @@ class VP8EncoderImpl : public VP8Encoder {
                              uint32_t timestamp,
                              bool only_predicting_from_key_frame);
 
+  // Delivers the layers produced by the last vpx_codec_encode() call.
+  // |encode_time_us| is the time it took to produce them.
   int GetEncodedPartitions(const VideoFrame& input_image,
-                           bool only_predicting_from_key_frame);
+                           bool only_predicting_from_key_frame,
+                           int64_t encode_time_us);
 
   // Set the stream state for stream |stream_idx|.
   void SetStreamState(bool send_stream, int stream_idx);
 
   uint32_t MaxIntraTarget(uint32_t optimal_buffer_size);
 
+  // When screensharing on a single stream, tells the encoder which
+  // macroblocks of |input_image| differ from the frame in the last reference
+  // buffer, so that the static ones are coded as skipped without any search.
+  void SetActiveMap(const VideoFrame& input_image,
+                    vpx_enc_frame_flags_t flags);
+
   EncodedImageCallback* encoded_complete_callback_;
   VideoCodec codec_;
   bool inited_;
@@ -118,6 +127,11 @@ class VP8EncoderImpl : public VP8Encoder {
   std::vector<vpx_rational_t> downsampling_factors_;
   QualityScaler quality_scaler_;
   bool quality_scaler_enabled_;
+  // The input frame which was encoded into the last reference buffer, and the
+  // active map derived from it. Only used by SetActiveMap().
+  rtc::scoped_refptr<VideoFrameBuffer> last_reference_buffer_;
+  std::vector<uint8_t> active_map_;
+  bool active_map_enabled_;
 };  // end of VP8EncoderImpl class
 
 class VP8DecoderImpl : public VP8Decoder {
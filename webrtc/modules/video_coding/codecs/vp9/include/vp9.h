@@ -28,6 +28,12 @@ class VP9Decoder : public VideoDecoder {
  public:
   static bool IsSupported();
   static VP9Decoder* Create();
+  // Creates a decoder that works on several frames at once, on up to as many
+  // threads as it is given cores in InitDecode(), as far as the dependencies
+  // between the frames allow. Decoded frames are delivered a few frames late,
+  // so this suits recording and transcoding better than playout. Falls back to
+  // a regular decoder if libvpx is built without frame threading.
+  static VP9Decoder* CreateFrameParallel();
 
   virtual ~VP9Decoder() {}
 };
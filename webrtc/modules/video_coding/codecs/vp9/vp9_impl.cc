@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <algorithm>
 #include <vector>
 
 #include "vpx/vpx_encoder.h"
@@ -47,6 +48,19 @@ int GetCpuSpeed(int width, int height) {
 #endif
 }
 
+namespace {
+// Returns the log2 of the number of tile columns to use for a frame |width|
+// pixels wide when encoding with |num_threads| threads. Each tile column must
+// be at least 256 pixels wide, and libvpx encodes tile columns in parallel.
+int TileColumnsLog2(int width, int num_threads) {
+  const int kMinTileWidth = 256;
+  int log2 = 0;
+  while ((2 << log2) <= num_threads && (2 << log2) * kMinTileWidth <= width)
+    ++log2;
+  return log2;
+}
+}  // namespace
+
 bool VP9Encoder::IsSupported() {
   return true;
 }
@@ -375,6 +389,21 @@ int VP9EncoderImpl::InitEncode(const VideoCodec* inst,
 int VP9EncoderImpl::NumberOfThreads(int width,
                                     int height,
                                     int number_of_cores) {
+#if defined(VPX_CTRL_VP9E_SET_ROW_MT)
+  // With row based multithreading, threads also share the work within a tile
+  // column, so more of them can be kept busy than there are tile columns. This
+  // matters most with spatial layers, since the lower layers are too narrow
+  // for more than one or two tile columns.
+  if (width * height >= 1280 * 720 && number_of_cores > 8) {
+    return 8;
+  } else if (width * height >= 640 * 360 && number_of_cores > 4) {
+    return 4;
+  } else if (number_of_cores > 2) {
+    return 2;
+  } else {
+    return 1;
+  }
+#else
   // Keep the number of encoder threads equal to the possible number of column
   // tiles, which is (1, 2, 4, 8). See comments below for VP9E_SET_TILE_COLUMNS.
   if (width * height >= 1280 * 720 && number_of_cores > 4) {
@@ -385,6 +414,7 @@ int VP9EncoderImpl::NumberOfThreads(int width,
     // 1 thread less than VGA.
     return 1;
   }
+#endif
 }
 
 int VP9EncoderImpl::InitAndSetControlSettings(const VideoCodec* inst) {
@@ -442,8 +472,23 @@ int VP9EncoderImpl::InitAndSetControlSettings(const VideoCodec* inst) {
   // Control function to set the number of column tiles in encoding a frame, in
   // log2 unit: e.g., 0 = 1 tile column, 1 = 2 tile columns, 2 = 4 tile columns.
   // The number tile columns will be capped by the encoder based on image size
-  // (minimum width of tile column is 256 pixels, maximum is 4096).
-  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, (config_->g_threads >> 1));
+  // (minimum width of tile column is 256 pixels, maximum is 4096). With spatial
+  // layers the setting applies to all of them, and each layer is capped based
+  // on its own width.
+  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS,
+                    TileColumnsLog2(config_->g_w, config_->g_threads));
+#if defined(VPX_CTRL_VP9E_SET_ROW_MT)
+  vpx_codec_control(encoder_, VP9E_SET_ROW_MT, config_->g_threads > 1 ? 1 : 0);
+#endif
+  for (int i = 0; i < num_spatial_layers_; ++i) {
+    const int layer_width =
+        config_->g_w * svc_internal_.svc_params.scaling_factor_num[i] /
+        svc_internal_.svc_params.scaling_factor_den[i];
+    LOG(LS_INFO) << "VP9 spatial layer " << i << ": width " << layer_width
+                 << ", " << (1 << TileColumnsLog2(layer_width,
+                                                  config_->g_threads))
+                 << " tile columns, " << config_->g_threads << " threads.";
+  }
 #if !defined(WEBRTC_ARCH_ARM) && !defined(WEBRTC_ARCH_ARM64) && \
   !defined(ANDROID)
   // Note denoiser is still off by default until further testing/optimization,
@@ -835,8 +880,15 @@ VP9Decoder* VP9Decoder::Create() {
   return new VP9DecoderImpl();
 }
 
-VP9DecoderImpl::VP9DecoderImpl()
-    : decode_complete_callback_(NULL),
+VP9Decoder* VP9Decoder::CreateFrameParallel() {
+  return new VP9DecoderImpl(true);
+}
+
+VP9DecoderImpl::VP9DecoderImpl() : VP9DecoderImpl(false) {}
+
+VP9DecoderImpl::VP9DecoderImpl(bool frame_parallel)
+    : frame_parallel_(frame_parallel),
+      decode_complete_callback_(NULL),
       inited_(false),
       decoder_(NULL),
       key_frame_required_(true) {
@@ -868,10 +920,16 @@ int VP9DecoderImpl::InitDecode(const VideoCodec* inst, int number_of_cores) {
     decoder_ = new vpx_codec_ctx_t;
   }
   vpx_codec_dec_cfg_t cfg;
-  // Setting number of threads to a constant value (1)
-  cfg.threads = 1;
+  // |number_of_cores| is how many cores the decoder may use. libvpx decodes
+  // tile columns in parallel, and with frame threading also several frames.
+  const int kMaxDecoderThreads = 8;
+  cfg.threads = std::max(1, std::min(number_of_cores, kMaxDecoderThreads));
   cfg.h = cfg.w = 0;  // set after decode
   vpx_codec_flags_t flags = 0;
+#if defined(VPX_CODEC_USE_FRAME_THREADING)
+  if (frame_parallel_ && cfg.threads > 1)
+    flags |= VPX_CODEC_USE_FRAME_THREADING;
+#endif
   if (vpx_codec_dec_init(decoder_, vpx_codec_vp9_dx(), &cfg, flags)) {
     return WEBRTC_VIDEO_CODEC_MEMORY;
   }
@@ -920,18 +978,27 @@ int VP9DecoderImpl::Decode(const EncodedImage& input_image,
   }
   // During decode libvpx may get and release buffers from |frame_buffer_pool_|.
   // In practice libvpx keeps a few (~3-4) buffers alive at a time.
+  // The timestamp goes along with the frame as its user data, since with frame
+  // threading the frames coming out are not the one just passed in.
+  void* user_priv = reinterpret_cast<void*>(
+      static_cast<uintptr_t>(input_image._timeStamp));
   if (vpx_codec_decode(decoder_, buffer,
-                       static_cast<unsigned int>(input_image._length), 0,
-                       VPX_DL_REALTIME)) {
+                       static_cast<unsigned int>(input_image._length),
+                       user_priv, VPX_DL_REALTIME)) {
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
   // |img->fb_priv| contains the image data, a reference counted Vp9FrameBuffer.
   // It may be released by libvpx during future vpx_codec_decode or
   // vpx_codec_destroy calls.
   img = vpx_codec_get_frame(decoder_, &iter);
-  int ret = ReturnFrame(img, input_image._timeStamp);
-  if (ret != 0) {
-    return ret;
+  if (!frame_parallel_ || img == NULL)
+    return ReturnFrame(img, input_image._timeStamp);
+  while (img != NULL) {
+    int ret = ReturnFrame(
+        img, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(img->user_priv)));
+    if (ret != 0)
+      return ret;
+    img = vpx_codec_get_frame(decoder_, &iter);
   }
   return WEBRTC_VIDEO_CODEC_OK;
 }
@@ -135,6 +135,7 @@ class VP9EncoderImpl : public VP9Encoder {
 class VP9DecoderImpl : public VP9Decoder {
  public:
   VP9DecoderImpl();
+  explicit VP9DecoderImpl(bool frame_parallel);
 
   virtual ~VP9DecoderImpl();
 
@@ -155,6 +156,7 @@ class VP9DecoderImpl : public VP9Decoder {
  private:
   int ReturnFrame(const vpx_image_t* img, uint32_t timeStamp);
 
+  const bool frame_parallel_;
   // Memory pool used to share buffers between libvpx and webrtc.
   Vp9FrameBufferPool frame_buffer_pool_;
   DecodedImageCallback* decode_complete_callback_;
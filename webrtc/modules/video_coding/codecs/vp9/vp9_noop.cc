@@ -36,4 +36,9 @@ VP9Decoder* VP9Decoder::Create() {
   return nullptr;
 }
 
+VP9Decoder* VP9Decoder::CreateFrameParallel() {
+  RTC_NOTREACHED();
+  return nullptr;
+}
+
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 #include <algorithm>
 
 #include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
 #include "webrtc/modules/video_coding/frame_object.h"
 #include "webrtc/modules/video_coding/jitter_estimator.h"
 #include "webrtc/modules/video_coding/sequence_number_util.h"
@@ -22,14 +23,7 @@
 namespace webrtc {
 namespace video_coding {
 
-namespace {
-// The maximum age of decoded frames tracked by frame buffer, compared to
-// |newest_picture_id_|.
-constexpr int kMaxFrameAge = 4096;
-
-// The maximum number of decoded frames being tracked by the frame buffer.
-constexpr int kMaxNumHistoryFrames = 256;
-}  // namespace
+constexpr int FrameBuffer::kMaxFrameAge;
 
 bool FrameBuffer::FrameComp::operator()(const FrameKey& f1,
                                         const FrameKey& f2) const {
@@ -40,10 +34,15 @@ bool FrameBuffer::FrameComp::operator()(const FrameKey& f1,
   return AheadOf(f2.first, f1.first);
 }
 
+FrameBuffer::FrameInfo::FrameInfo() : num_missing_decodable(0) {}
+
+FrameBuffer::FrameInfo::~FrameInfo() {}
+
 FrameBuffer::FrameBuffer(Clock* clock,
                          VCMJitterEstimator* jitter_estimator,
                          const VCMTiming* timing)
-    : clock_(clock),
+    : last_decoded_picture_id_(-1),
+      clock_(clock),
       frame_inserted_event_(false, false),
       jitter_estimator_(jitter_estimator),
       timing_(timing),
@@ -57,23 +56,22 @@ std::unique_ptr<FrameObject> FrameBuffer::NextFrame(int64_t max_wait_time_ms) {
 
     crit_.Enter();
     frame_inserted_event_.Reset();
-    auto next_frame = frames_.end();
-    for (auto frame_it = frames_.begin(); frame_it != frames_.end();
-         ++frame_it) {
-      const FrameObject& frame = *frame_it->second;
-      if (IsContinuous(frame)) {
-        next_frame = frame_it;
-        int64_t render_time = timing_->RenderTimeMs(frame.timestamp, now);
-        wait_ms = timing_->MaxWaitingTime(render_time, now);
-
-        // This will cause the frame buffer to prefer high framerate rather
-        // than high resolution in the case of the decoder not decoding fast
-        // enough and the stream has multiple spatial and temporal layers.
-        if (wait_ms == 0)
-          continue;
-
-        break;
-      }
+    bool found_frame = false;
+    FrameKey next_key;
+    for (const FrameKey& key : decodable_frames_) {
+      const FrameObject& frame = *frames_.find(key)->second.frame;
+      found_frame = true;
+      next_key = key;
+      int64_t render_time = timing_->RenderTimeMs(frame.timestamp, now);
+      wait_ms = timing_->MaxWaitingTime(render_time, now);
+
+      // This will cause the frame buffer to prefer high framerate rather
+      // than high resolution in the case of the decoder not decoding fast
+      // enough and the stream has multiple spatial and temporal layers.
+      if (wait_ms == 0)
+        continue;
+
+      break;
     }
     crit_.Leave();
 
@@ -82,72 +80,171 @@ std::unique_ptr<FrameObject> FrameBuffer::NextFrame(int64_t max_wait_time_ms) {
     wait_ms = std::min<int64_t>(wait_ms, latest_return_time - now);
     wait_ms = std::max<int64_t>(wait_ms, 0);
     if (!frame_inserted_event_.Wait(wait_ms)) {
-      crit_.Enter();
-      if (next_frame != frames_.end()) {
-        // TODO(philipel): update jitter estimator with correct values.
-        jitter_estimator_->UpdateEstimate(100, 100);
-
-        decoded_frames_.insert(next_frame->first);
-        std::unique_ptr<FrameObject> frame = std::move(next_frame->second);
-        frames_.erase(frames_.begin(), ++next_frame);
-        crit_.Leave();
-        return frame;
-      } else {
-        crit_.Leave();
+      rtc::CritScope lock(&crit_);
+      if (!found_frame)
         return std::unique_ptr<FrameObject>();
+
+      auto next_frame = frames_.find(next_key);
+      if (next_frame == frames_.end() || !next_frame->second.frame ||
+          next_frame->second.num_missing_decodable > 0) {
+        // The frame was replaced while waiting; select again.
+        continue;
       }
+
+      // TODO(philipel): update jitter estimator with correct values.
+      jitter_estimator_->UpdateEstimate(100, 100);
+
+      PropagateDecodability(next_key, next_frame->second);
+      std::unique_ptr<FrameObject> frame = std::move(next_frame->second.frame);
+
+      // Frames before the decoded frame are dropped.
+      auto next_decodable = std::upper_bound(decodable_frames_.begin(),
+                                             decodable_frames_.end(),
+                                             next_key, FrameComp());
+      decodable_frames_.erase(decodable_frames_.begin(), next_decodable);
+      frames_.erase(frames_.begin(), ++next_frame);
+      return frame;
     }
   }
 }
 
 void FrameBuffer::InsertFrame(std::unique_ptr<FrameObject> frame) {
   rtc::CritScope lock(&crit_);
-  if (newest_picture_id_ == -1)
-    newest_picture_id_ = frame->picture_id;
-
-  if (AheadOf<uint16_t>(frame->picture_id, newest_picture_id_))
-    newest_picture_id_ = frame->picture_id;
-
-  // Remove frames as long as we have too many, |kMaxNumHistoryFrames|.
-  while (decoded_frames_.size() > kMaxNumHistoryFrames)
-    decoded_frames_.erase(decoded_frames_.begin());
+  if (frame->spatial_layer >= kMaxVp9NumberOfSpatialLayers) {
+    LOG(LS_WARNING) << "Dropping frame with unsupported spatial layer "
+                    << static_cast<int>(frame->spatial_layer) << ".";
+    return;
+  }
+  UpdateNewestPictureId(frame->picture_id);
 
-  // Remove frames that are too old, |kMaxNumHistoryFrames|.
-  uint16_t old_picture_id = Subtract<1 << 16>(newest_picture_id_, kMaxFrameAge);
-  auto old_decoded_it =
-      decoded_frames_.lower_bound(FrameKey(old_picture_id, 0));
-  decoded_frames_.erase(decoded_frames_.begin(), old_decoded_it);
+  // If a frame with an earlier picture id was inserted compared to the last
+  // decoded frames picture id then that frame arrived too late.
+  if (last_decoded_picture_id_ != -1 &&
+      AheadOf<uint16_t>(last_decoded_picture_id_, frame->picture_id)) {
+    return;
+  }
 
   FrameKey key(frame->picture_id, frame->spatial_layer);
-  frames_[key] = std::move(frame);
+  FrameInfo* info = &frames_[key];
+  info->frame = std::move(frame);
+  UpdateFrameInfoWithIncomingFrame(key, info);
   frame_inserted_event_.Set();
 }
 
-bool FrameBuffer::IsContinuous(const FrameObject& frame) const {
-  // If a frame with an earlier picture id was inserted compared to the last
-  // decoded frames picture id then that frame arrived too late.
-  if (!decoded_frames_.empty() &&
-      AheadOf(decoded_frames_.rbegin()->first, frame.picture_id)) {
-    return false;
+void FrameBuffer::UpdateFrameInfoWithIncomingFrame(const FrameKey& key,
+                                                   FrameInfo* info) {
+  const FrameObject& frame = *info->frame;
+  // A frame may be inserted again, possibly with other references, so the
+  // count always starts over. Stale registrations with the old references
+  // are ignored by PropagateDecodability().
+  RemoveDecodableFrame(key);
+  info->num_missing_decodable = 0;
+
+  FrameKey ref_keys[FrameObject::kMaxFrameReferences + 1];
+  size_t num_ref_keys = 0;
+  for (size_t r = 0; r < frame.num_references; ++r)
+    ref_keys[num_ref_keys++] = FrameKey(frame.references[r], key.second);
+
+  // If this is a layer frame, it also depends on the lower layer of this
+  // super frame.
+  if (frame.inter_layer_predicted) {
+    RTC_DCHECK_GT(key.second, 0);
+    ref_keys[num_ref_keys++] = FrameKey(key.first, key.second - 1);
   }
 
-  // Have we decoded all frames that this frame depend on?
-  for (size_t r = 0; r < frame.num_references; ++r) {
-    FrameKey ref_key(frame.references[r], frame.spatial_layer);
-    if (decoded_frames_.find(ref_key) == decoded_frames_.end())
-      return false;
+  for (size_t r = 0; r < num_ref_keys; ++r) {
+    const FrameKey& ref_key = ref_keys[r];
+    // Each reference is counted once, as it is decremented once.
+    if (IsDecoded(ref_key) ||
+        std::find(ref_keys, ref_keys + r, ref_key) != ref_keys + r) {
+      continue;
+    }
+    ++info->num_missing_decodable;
+    std::vector<FrameKey>* dependents = &frames_[ref_key].dependent_frames;
+    if (std::find(dependents->begin(), dependents->end(), key) ==
+        dependents->end()) {
+      dependents->push_back(key);
+    }
   }
 
-  // If this is a layer frame, have we decoded the lower layer of this
-  // super frame.
-  if (frame.inter_layer_predicted) {
-    RTC_DCHECK_GT(frame.spatial_layer, 0);
-    FrameKey ref_key(frame.picture_id, frame.spatial_layer - 1);
-    if (decoded_frames_.find(ref_key) == decoded_frames_.end())
-      return false;
+  if (info->num_missing_decodable == 0)
+    AddDecodableFrame(key);
+}
+
+void FrameBuffer::PropagateDecodability(const FrameKey& key,
+                                        const FrameInfo& info) {
+  decoded_frames_[key.second].set(key.first % kMaxFrameAge);
+  last_decoded_picture_id_ = key.first;
+
+  for (const FrameKey& dependent_key : info.dependent_frames) {
+    auto dependent = frames_.find(dependent_key);
+    if (dependent == frames_.end() || !dependent->second.frame ||
+        !DependsOn(*dependent->second.frame, key)) {
+      continue;
+    }
+    RTC_DCHECK_GT(dependent->second.num_missing_decodable, 0u);
+    if (--dependent->second.num_missing_decodable == 0)
+      AddDecodableFrame(dependent_key);
   }
+}
 
-  return true;
+bool FrameBuffer::DependsOn(const FrameObject& frame, const FrameKey& ref_key) {
+  if (frame.spatial_layer == ref_key.second) {
+    for (size_t r = 0; r < frame.num_references; ++r) {
+      if (frame.references[r] == ref_key.first)
+        return true;
+    }
+  }
+  return frame.inter_layer_predicted && frame.picture_id == ref_key.first &&
+         frame.spatial_layer == ref_key.second + 1;
+}
+
+void FrameBuffer::AddDecodableFrame(const FrameKey& key) {
+  auto it = std::lower_bound(decodable_frames_.begin(),
+                             decodable_frames_.end(), key, FrameComp());
+  if (it == decodable_frames_.end() || *it != key)
+    decodable_frames_.insert(it, key);
+}
+
+void FrameBuffer::RemoveDecodableFrame(const FrameKey& key) {
+  auto it = std::lower_bound(decodable_frames_.begin(),
+                             decodable_frames_.end(), key, FrameComp());
+  if (it != decodable_frames_.end() && *it == key)
+    decodable_frames_.erase(it);
+}
+
+bool FrameBuffer::IsDecoded(const FrameKey& key) const {
+  if (newest_picture_id_ == -1 || key.second >= kMaxVp9NumberOfSpatialLayers)
+    return false;
+  // Only frames up to |kMaxFrameAge| older than the newest frame are tracked.
+  if (ForwardDiff<uint16_t>(key.first, newest_picture_id_) >= kMaxFrameAge)
+    return false;
+  return decoded_frames_[key.second].test(key.first % kMaxFrameAge);
+}
+
+void FrameBuffer::UpdateNewestPictureId(uint16_t picture_id) {
+  if (newest_picture_id_ == -1) {
+    newest_picture_id_ = picture_id;
+    return;
+  }
+  if (!AheadOf<uint16_t>(picture_id, newest_picture_id_))
+    return;
+
+  // The bits of the picture ids entering the window were last used by the
+  // picture ids |kMaxFrameAge| older, which are now leaving it.
+  uint16_t diff = ForwardDiff<uint16_t>(newest_picture_id_, picture_id);
+  if (diff >= kMaxFrameAge) {
+    for (auto& layer : decoded_frames_)
+      layer.reset();
+  } else {
+    for (uint16_t i = 1; i <= diff; ++i) {
+      size_t index = static_cast<uint16_t>(newest_picture_id_ + i) %
+                     kMaxFrameAge;
+      for (auto& layer : decoded_frames_)
+        layer.reset(index);
+    }
+  }
+  newest_picture_id_ = picture_id;
 }
 
 }  // namespace video_coding
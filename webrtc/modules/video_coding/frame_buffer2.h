@@ -12,15 +12,17 @@
 #define WEBRTC_MODULES_VIDEO_CODING_FRAME_BUFFER2_H_
 
 #include <array>
+#include <bitset>
 #include <map>
 #include <memory>
-#include <set>
 #include <utility>
+#include <vector>
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/event.h"
 #include "webrtc/base/thread_annotations.h"
+#include "webrtc/modules/include/module_common_types.h"
 
 namespace webrtc {
 
@@ -50,22 +52,71 @@ class FrameBuffer {
   // FrameKey is a pair of (picture id, spatial layer).
   using FrameKey = std::pair<uint16_t, uint8_t>;
 
+  // The maximum age of decoded frames tracked by frame buffer, compared to
+  // |newest_picture_id_|. Must divide 2^16.
+  static constexpr int kMaxFrameAge = 4096;
+
   // Comparator used to sort frames, first on their picture id, and second
   // on their spatial layer.
   struct FrameComp {
     bool operator()(const FrameKey& f1, const FrameKey& f2) const;
   };
 
-  // Determines whether a frame is continuous.
-  bool IsContinuous(const FrameObject& frame) const
+  struct FrameInfo {
+    FrameInfo();
+    ~FrameInfo();
+
+    // Null if the frame hasn't been inserted yet, but other frames depend on
+    // it.
+    std::unique_ptr<FrameObject> frame;
+
+    // The number of frames this frame depends on that have not been decoded.
+    // The frame can be decoded when this reaches zero.
+    size_t num_missing_decodable;
+
+    // The frames that depend on this frame, and are waiting for it to be
+    // decoded.
+    std::vector<FrameKey> dependent_frames;
+  };
+
+  using FrameMap = std::map<FrameKey, FrameInfo, FrameComp>;
+
+  // Counts the references of the frame in |info| that have not been decoded,
+  // and registers the frame as a dependent of each of them.
+  void UpdateFrameInfoWithIncomingFrame(const FrameKey& key, FrameInfo* info)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Marks |key| as decoded and updates the frames depending on it.
+  void PropagateDecodability(const FrameKey& key, const FrameInfo& info)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Returns true if |frame| references the frame |ref_key|.
+  static bool DependsOn(const FrameObject& frame, const FrameKey& ref_key);
+
+  void AddDecodableFrame(const FrameKey& key) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void RemoveDecodableFrame(const FrameKey& key)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
-  // Keep track of decoded frames.
-  std::set<FrameKey, FrameComp> decoded_frames_ GUARDED_BY(crit_);
+  bool IsDecoded(const FrameKey& key) const EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Moves |newest_picture_id_| forward, forgetting the decoded frames which
+  // become too old to be tracked.
+  void UpdateNewestPictureId(uint16_t picture_id)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Decoded frames within |kMaxFrameAge| of |newest_picture_id_|, one bit per
+  // picture id modulo |kMaxFrameAge| for each spatial layer.
+  std::array<std::bitset<kMaxFrameAge>, kMaxVp9NumberOfSpatialLayers>
+      decoded_frames_ GUARDED_BY(crit_);
+  int last_decoded_picture_id_ GUARDED_BY(crit_);
+
+  // The frames that have been inserted but not yet decoded, and placeholders
+  // for the frames they depend on.
+  FrameMap frames_ GUARDED_BY(crit_);
 
-  // The actual buffer that holds the FrameObjects.
-  std::map<FrameKey, std::unique_ptr<FrameObject>, FrameComp> frames_
-      GUARDED_BY(crit_);
+  // The frames in |frames_| whose references have all been decoded, in the
+  // same order as |frames_|.
+  std::vector<FrameKey> decodable_frames_ GUARDED_BY(crit_);
 
   rtc::CriticalSection crit_;
   Clock* const clock_;
@@ -330,5 +330,57 @@ TEST_F(TestFrameBuffer2, InsertLateFrame) {
   CheckNoFrame(2);
 }
 
+TEST_F(TestFrameBuffer2, ReferenceInsertedAfterDependentFrame) {
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  InsertFrame(pid + 1, 0, ts + kFps10, false, pid);
+  ExtractFrame();
+  InsertFrame(pid, 0, ts, false);
+  ExtractFrame();
+  ExtractFrame();
+
+  CheckNoFrame(0);
+  CheckFrame(1, pid, 0);
+  CheckFrame(2, pid + 1, 0);
+}
+
+TEST_F(TestFrameBuffer2, TemporalLayersInsertedInReverse) {
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  // Every frame depends on the frame before it and on the last base layer
+  // frame, which are sometimes the same frame.
+  for (int i = 7; i > 0; --i) {
+    InsertFrame(pid + i, 0, ts + i * kFps20, false, pid + i - 1,
+                pid + (i - 1) / 4 * 4);
+  }
+  ExtractFrame();
+  CheckNoFrame(0);
+
+  InsertFrame(pid, 0, ts, false);
+  for (int i = 0; i < 8; ++i) {
+    ExtractFrame();
+    clock_.AdvanceTimeMilliseconds(kFps20);
+  }
+  for (int i = 0; i < 8; ++i)
+    CheckFrame(i + 1, pid + i, 0);
+}
+
+TEST_F(TestFrameBuffer2, ReinsertedFrameUsesNewReferences) {
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  InsertFrame(pid, 0, ts, false);
+  InsertFrame(pid + 2, 0, ts + kFps10, false, pid + 1);
+  // The same frame again, now only referencing a decodable frame.
+  InsertFrame(pid + 2, 0, ts + kFps10, false, pid);
+  ExtractFrame();
+  ExtractFrame();
+
+  CheckFrame(0, pid, 0);
+  CheckFrame(1, pid + 2, 0);
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
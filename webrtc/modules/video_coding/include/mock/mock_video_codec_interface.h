@@ -46,6 +46,7 @@ class MockVideoEncoder : public VideoEncoder {
   MOCK_METHOD2(SetChannelParameters, int32_t(uint32_t packetLoss, int64_t rtt));
   MOCK_METHOD2(SetRates, int32_t(uint32_t newBitRate, uint32_t frameRate));
   MOCK_METHOD1(SetPeriodicKeyFrames, int32_t(bool enable));
+  MOCK_CONST_METHOD0(SupportsNativeHandle, bool());
 };
 
 class MockDecodedImageCallback : public DecodedImageCallback {
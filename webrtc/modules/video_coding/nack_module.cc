@@ -31,13 +31,18 @@ const int kNumReorderingBuckets = 10;
 }  // namespace
 
 NackModule::NackInfo::NackInfo()
-    : seq_num(0), send_at_seq_num(0), sent_at_time(-1), retries(0) {}
+    : seq_num(0),
+      send_at_seq_num(0),
+      sent_at_time(-1),
+      retries(0),
+      removed(false) {}
 
-NackModule::NackInfo::NackInfo(uint16_t seq_num, uint16_t send_at_seq_num)
+NackModule::NackInfo::NackInfo(int64_t seq_num, int64_t send_at_seq_num)
     : seq_num(seq_num),
       send_at_seq_num(send_at_seq_num),
       sent_at_time(-1),
-      retries(0) {}
+      retries(0),
+      removed(false) {}
 
 NackModule::NackModule(Clock* clock,
                        NackSender* nack_sender,
@@ -45,6 +50,8 @@ NackModule::NackModule(Clock* clock,
     : clock_(clock),
       nack_sender_(nack_sender),
       keyframe_request_sender_(keyframe_request_sender),
+      nack_list_size_(0),
+      first_unsent_seq_num_(0),
       reordering_histogram_(kNumReorderingBuckets, kMaxReorderedPackets),
       running_(true),
       initialized_(false),
@@ -70,40 +77,50 @@ int NackModule::OnReceivedPacket(const VCMPacket& packet) {
 
   if (!initialized_) {
     newest_seq_num_ = seq_num;
+    first_unsent_seq_num_ = newest_seq_num_ + 1;
     if (is_keyframe)
-      keyframe_list_.insert(seq_num);
+      keyframe_list_.push_back(newest_seq_num_);
     initialized_ = true;
     return 0;
   }
 
+  int64_t unwrapped_seq_num = Unwrap(seq_num);
+
   // Since the |newest_seq_num_| is a packet we have actually received we know
   // that packet has never been Nacked.
-  if (seq_num == newest_seq_num_)
+  if (unwrapped_seq_num == newest_seq_num_)
     return 0;
 
-  if (AheadOf(newest_seq_num_, seq_num)) {
+  if (unwrapped_seq_num < newest_seq_num_) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
+    auto nack_list_it = std::lower_bound(
+        nack_list_.begin(), nack_list_.end(), unwrapped_seq_num,
+        [](const NackInfo& nack_info, int64_t seq_num) {
+          return nack_info.seq_num < seq_num;
+        });
     int nacks_sent_for_packet = 0;
-    if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
-      nack_list_.erase(nack_list_it);
+    if (nack_list_it != nack_list_.end() &&
+        nack_list_it->seq_num == unwrapped_seq_num &&
+        !nack_list_it->removed) {
+      nacks_sent_for_packet = nack_list_it->retries;
+      RemovePacket(nack_list_it);
     }
     if (!is_retransmitted)
-      UpdateReorderingStatistics(seq_num);
+      UpdateReorderingStatistics(unwrapped_seq_num);
     return nacks_sent_for_packet;
   }
-  AddPacketsToNack(newest_seq_num_ + 1, seq_num);
-  newest_seq_num_ = seq_num;
+  AddPacketsToNack(newest_seq_num_ + 1, unwrapped_seq_num);
+  newest_seq_num_ = unwrapped_seq_num;
 
   // Keep track of new keyframes.
   if (is_keyframe)
-    keyframe_list_.insert(seq_num);
+    keyframe_list_.push_back(unwrapped_seq_num);
 
   // And remove old ones so we don't accumulate keyframes.
-  auto it = keyframe_list_.lower_bound(seq_num - kMaxPacketAge);
-  if (it != keyframe_list_.begin())
-    keyframe_list_.erase(keyframe_list_.begin(), it);
+  while (!keyframe_list_.empty() &&
+         keyframe_list_.front() < unwrapped_seq_num - kMaxPacketAge) {
+    keyframe_list_.pop_front();
+  }
 
   // Are there any nacks that are waiting for this seq_num.
   std::vector<uint16_t> nack_batch = GetNackBatch(kSeqNumOnly);
@@ -115,9 +132,12 @@ int NackModule::OnReceivedPacket(const VCMPacket& packet) {
 
 void NackModule::ClearUpTo(uint16_t seq_num) {
   rtc::CritScope lock(&crit_);
-  nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
-  keyframe_list_.erase(keyframe_list_.begin(),
-                       keyframe_list_.lower_bound(seq_num));
+  int64_t unwrapped_seq_num = Unwrap(seq_num);
+  RemovePacketsBefore(unwrapped_seq_num);
+  while (!keyframe_list_.empty() &&
+         keyframe_list_.front() < unwrapped_seq_num) {
+    keyframe_list_.pop_front();
+  }
 }
 
 void NackModule::UpdateRtt(int64_t rtt_ms) {
@@ -128,6 +148,7 @@ void NackModule::UpdateRtt(int64_t rtt_ms) {
 void NackModule::Clear() {
   rtc::CritScope lock(&crit_);
   nack_list_.clear();
+  nack_list_size_ = 0;
   keyframe_list_.clear();
 }
 
@@ -165,42 +186,77 @@ void NackModule::Process() {
     nack_sender_->SendNack(nack_batch);
 }
 
+int64_t NackModule::Unwrap(uint16_t seq_num) const {
+  uint16_t newest_seq_num = static_cast<uint16_t>(newest_seq_num_);
+  if (AheadOf(seq_num, newest_seq_num))
+    return newest_seq_num_ + ForwardDiff(newest_seq_num, seq_num);
+  return newest_seq_num_ - ReverseDiff(newest_seq_num, seq_num);
+}
+
+void NackModule::RemovePacketsBefore(int64_t seq_num) {
+  while (!nack_list_.empty() && nack_list_.front().seq_num < seq_num) {
+    if (!nack_list_.front().removed)
+      --nack_list_size_;
+    nack_list_.pop_front();
+  }
+  TrimNackList();
+}
+
+void NackModule::RemovePacket(std::deque<NackInfo>::iterator it) {
+  RTC_DCHECK(!it->removed);
+  it->removed = true;
+  --nack_list_size_;
+  TrimNackList();
+}
+
+void NackModule::TrimNackList() {
+  while (!nack_list_.empty() && nack_list_.front().removed)
+    nack_list_.pop_front();
+
+  if (nack_list_.size() - nack_list_size_ > nack_list_size_) {
+    nack_list_.erase(std::remove_if(nack_list_.begin(), nack_list_.end(),
+                                    [](const NackInfo& nack_info) {
+                                      return nack_info.removed;
+                                    }),
+                     nack_list_.end());
+  }
+  RTC_DCHECK_EQ(nack_list_.empty(), nack_list_size_ == 0);
+}
+
 bool NackModule::RemovePacketsUntilKeyFrame() {
   while (!keyframe_list_.empty()) {
-    auto it = nack_list_.lower_bound(*keyframe_list_.begin());
-
-    if (it != nack_list_.begin()) {
+    if (!nack_list_.empty() &&
+        nack_list_.front().seq_num < keyframe_list_.front()) {
       // We have found a keyframe that actually is newer than at least one
       // packet in the nack list.
-      RTC_DCHECK(it != nack_list_.end());
-      nack_list_.erase(nack_list_.begin(), it);
+      RemovePacketsBefore(keyframe_list_.front());
       return true;
     }
 
     // If this keyframe is so old it does not remove any packets from the list,
     // remove it from the list of keyframes and try the next keyframe.
-    keyframe_list_.erase(keyframe_list_.begin());
+    keyframe_list_.pop_front();
   }
   return false;
 }
 
-void NackModule::AddPacketsToNack(uint16_t seq_num_start,
-                                  uint16_t seq_num_end) {
+void NackModule::AddPacketsToNack(int64_t seq_num_start,
+                                  int64_t seq_num_end) {
   // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  RemovePacketsBefore(seq_num_end - kMaxPacketAge);
 
   // If the nack list is too large, remove packets from the nack list until
   // the latest first packet of a keyframe. If the list is still too large,
   // clear it and request a keyframe.
-  uint16_t num_new_nacks = ForwardDiff(seq_num_start, seq_num_end);
-  if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
+  size_t num_new_nacks = seq_num_end - seq_num_start;
+  if (nack_list_size_ + num_new_nacks > kMaxNackPackets) {
     while (RemovePacketsUntilKeyFrame() &&
-           nack_list_.size() + num_new_nacks > kMaxNackPackets) {
+           nack_list_size_ + num_new_nacks > kMaxNackPackets) {
     }
 
-    if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
+    if (nack_list_size_ + num_new_nacks > kMaxNackPackets) {
       nack_list_.clear();
+      nack_list_size_ = 0;
       LOG(LS_WARNING) << "NACK list full, clearing NACK"
                          " list and requesting keyframe.";
       keyframe_request_sender_->RequestKeyFrame();
@@ -208,11 +264,10 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
     }
   }
 
-  for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5));
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
-  }
+  int wait_packets = WaitNumberOfPackets(0.5);
+  for (int64_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num)
+    nack_list_.emplace_back(seq_num, seq_num + wait_packets);
+  nack_list_size_ += num_new_nacks;
 }
 
 std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
@@ -220,45 +275,52 @@ std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
   bool consider_timestamp = options != kSeqNumOnly;
   int64_t now_ms = clock_->TimeInMilliseconds();
   std::vector<uint16_t> nack_batch;
+
+  // Packets that have not been nacked yet are only found from
+  // |first_unsent_seq_num_| and on, so unless timestamps have to be checked
+  // the already nacked packets at the front of the list are skipped.
   auto it = nack_list_.begin();
-  while (it != nack_list_.end()) {
-    if (consider_seq_num && it->second.sent_at_time == -1 &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num)) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
-                        << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
-      }
+  if (!consider_timestamp) {
+    it = std::lower_bound(nack_list_.begin(), nack_list_.end(),
+                          first_unsent_seq_num_,
+                          [](const NackInfo& nack_info, int64_t seq_num) {
+                            return nack_info.seq_num < seq_num;
+                          });
+  }
+  int64_t first_unsent_seq_num = newest_seq_num_ + 1;
+  for (; it != nack_list_.end(); ++it) {
+    if (it->removed)
       continue;
-    }
 
-    if (consider_timestamp && it->second.sent_at_time + rtt_ms_ <= now_ms) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
-                        << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
-      }
+    bool send_nack = (consider_seq_num && it->sent_at_time == -1 &&
+                      newest_seq_num_ >= it->send_at_seq_num) ||
+                     (consider_timestamp &&
+                      it->sent_at_time + rtt_ms_ <= now_ms);
+    if (!send_nack) {
+      if (it->sent_at_time == -1)
+        first_unsent_seq_num = std::min(first_unsent_seq_num, it->seq_num);
       continue;
     }
-    ++it;
+
+    nack_batch.emplace_back(static_cast<uint16_t>(it->seq_num));
+    ++it->retries;
+    it->sent_at_time = now_ms;
+    if (it->retries >= kMaxNackRetries) {
+      LOG(LS_WARNING) << "Sequence number "
+                      << static_cast<uint16_t>(it->seq_num)
+                      << " removed from NACK list due to max retries.";
+      it->removed = true;
+      --nack_list_size_;
+    }
   }
+  first_unsent_seq_num_ = first_unsent_seq_num;
+  TrimNackList();
   return nack_batch;
 }
 
-void NackModule::UpdateReorderingStatistics(uint16_t seq_num) {
-  RTC_DCHECK(AheadOf(newest_seq_num_, seq_num));
-  uint16_t diff = ReverseDiff(newest_seq_num_, seq_num);
-  reordering_histogram_.Add(diff);
+void NackModule::UpdateReorderingStatistics(int64_t seq_num) {
+  RTC_DCHECK_GT(newest_seq_num_, seq_num);
+  reordering_histogram_.Add(newest_seq_num_ - seq_num);
 }
 
 int NackModule::WaitNumberOfPackets(float probability) const {
@@ -11,9 +11,8 @@
 #ifndef WEBRTC_MODULES_VIDEO_CODING_NACK_MODULE_H_
 #define WEBRTC_MODULES_VIDEO_CODING_NACK_MODULE_H_
 
-#include <map>
+#include <deque>
 #include <vector>
-#include <set>
 
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_annotations.h"
@@ -49,19 +48,38 @@ class NackModule : public Module {
 
   // This class holds the sequence number of the packet that is in the nack list
   // as well as the meta data about when it should be nacked and how many times
-  // we have tried to nack this packet.
+  // we have tried to nack this packet. Sequence numbers are unwrapped.
   struct NackInfo {
     NackInfo();
-    NackInfo(uint16_t seq_num, uint16_t send_at_seq_num);
+    NackInfo(int64_t seq_num, int64_t send_at_seq_num);
 
-    uint16_t seq_num;
-    uint16_t send_at_seq_num;
+    int64_t seq_num;
+    int64_t send_at_seq_num;
     int64_t sent_at_time;
     int retries;
+    // Set when the packet has been received or given up on. Removed entries
+    // are dropped lazily by TrimNackList().
+    bool removed;
   };
-  void AddPacketsToNack(uint16_t seq_num_start, uint16_t seq_num_end)
+
+  // Unwraps |seq_num| relative to |newest_seq_num_|.
+  int64_t Unwrap(uint16_t seq_num) const EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Adds the range [|seq_num_start|, |seq_num_end|) to the nack list.
+  void AddPacketsToNack(int64_t seq_num_start, int64_t seq_num_end)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Removes all packets older than |seq_num| from the nack list.
+  void RemovePacketsBefore(int64_t seq_num) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Marks the packet at |it| as removed from the nack list.
+  void RemovePacket(std::deque<NackInfo>::iterator it)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Drops removed entries from the front of the nack list, and compacts the
+  // list once removed entries outnumber the ones still waiting to be nacked.
+  void TrimNackList() EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Removes packets from the nack list until the next keyframe. Returns true
   // if packets were removed.
   bool RemovePacketsUntilKeyFrame() EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -69,7 +87,7 @@ class NackModule : public Module {
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Update the reordering distribution.
-  void UpdateReorderingStatistics(uint16_t seq_num)
+  void UpdateReorderingStatistics(int64_t seq_num)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Returns how many packets we have to wait in order to receive the packet
@@ -82,15 +100,23 @@ class NackModule : public Module {
   NackSender* const nack_sender_;
   KeyFrameRequestSender* const keyframe_request_sender_;
 
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
-      GUARDED_BY(crit_);
+  // Packets to nack, sorted by ascending sequence number. Since missing
+  // packets are only ever added after the newest one and mostly removed from
+  // the front, the list is kept flat and ranges are inserted and erased at
+  // its ends. The front entry is never removed.
+  std::deque<NackInfo> nack_list_ GUARDED_BY(crit_);
+  // Number of entries in |nack_list_| that are not removed.
+  size_t nack_list_size_ GUARDED_BY(crit_);
+  // All packets older than this have been nacked at least once, so a nack
+  // batch triggered by a new sequence number only has to look from here.
+  int64_t first_unsent_seq_num_ GUARDED_BY(crit_);
+  // Sequence numbers of the first packets of keyframes, in ascending order.
+  std::deque<int64_t> keyframe_list_ GUARDED_BY(crit_);
   video_coding::Histogram reordering_histogram_ GUARDED_BY(crit_);
   bool running_ GUARDED_BY(crit_);
   bool initialized_ GUARDED_BY(crit_);
   int64_t rtt_ms_ GUARDED_BY(crit_);
-  uint16_t newest_seq_num_ GUARDED_BY(crit_);
+  int64_t newest_seq_num_ GUARDED_BY(crit_);
   int64_t next_process_time_ms_ GUARDED_BY(crit_);
 };
 
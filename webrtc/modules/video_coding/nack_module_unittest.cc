@@ -314,4 +314,26 @@ TEST_F(TestNackModule, PacketNackCount) {
   EXPECT_EQ(0, nack_module_.OnReceivedPacket(packet));
 }
 
+TEST_F(TestNackModule, BurstLossPartiallyRecovered) {
+  VCMPacket packet;
+  packet.seqNum = 0xff00;
+  nack_module_.OnReceivedPacket(packet);
+  packet.seqNum = static_cast<uint16_t>(0xff00 + 501);
+  nack_module_.OnReceivedPacket(packet);
+  EXPECT_EQ(500u, sent_nacks_.size());
+
+  // Every other packet of the burst is recovered.
+  for (uint16_t i = 1; i <= 500; i += 2) {
+    packet.seqNum = static_cast<uint16_t>(0xff00 + i);
+    EXPECT_EQ(1, nack_module_.OnReceivedPacket(packet));
+  }
+
+  sent_nacks_.clear();
+  clock_->AdvanceTimeMilliseconds(100);
+  nack_module_.Process();
+  ASSERT_EQ(250u, sent_nacks_.size());
+  for (size_t i = 0; i < sent_nacks_.size(); ++i)
+    EXPECT_EQ(static_cast<uint16_t>(0xff00 + 2 * (i + 1)), sent_nacks_[i]);
+}
+
 }  // namespace webrtc
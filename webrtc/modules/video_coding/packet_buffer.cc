@@ -10,6 +10,8 @@
 
 #include "webrtc/modules/video_coding/packet_buffer.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <limits>
 
@@ -29,6 +31,7 @@ PacketBuffer::PacketBuffer(size_t start_buffer_size,
       last_seq_num_(0),
       first_packet_received_(false),
       data_buffer_(start_buffer_size),
+      payload_arena_(start_buffer_size * kMaxPayloadSize),
       sequence_buffer_(start_buffer_size),
       reference_finder_(frame_callback) {
   RTC_DCHECK_LE(start_buffer_size, max_buffer_size);
@@ -37,8 +40,15 @@ PacketBuffer::PacketBuffer(size_t start_buffer_size,
   RTC_DCHECK((max_buffer_size & (max_buffer_size - 1)) == 0);
 }
 
+const size_t PacketBuffer::kMaxPayloadSize;
+
 bool PacketBuffer::InsertPacket(const VCMPacket& packet) {
   rtc::CritScope lock(&crit_);
+  if (packet.dataPtr && packet.sizeBytes > kMaxPayloadSize) {
+    LOG(LS_WARNING) << "Packet with a payload of " << packet.sizeBytes
+                    << " bytes is too large to buffer.";
+    return false;
+  }
   uint16_t seq_num = packet.seqNum;
   size_t index = seq_num % size_;
 
@@ -72,7 +82,7 @@ bool PacketBuffer::InsertPacket(const VCMPacket& packet) {
   sequence_buffer_[index].continuous = false;
   sequence_buffer_[index].frame_created = false;
   sequence_buffer_[index].used = true;
-  data_buffer_[index] = packet;
+  StorePacket(index, packet);
 
   FindFrames(seq_num);
   return true;
@@ -93,21 +103,35 @@ bool PacketBuffer::ExpandBufferSize() {
     return false;
 
   size_t new_size = std::min(max_size_, 2 * size_);
-  std::vector<VCMPacket> new_data_buffer(new_size);
   std::vector<ContinuityInfo> new_sequence_buffer(new_size);
+  // The payloads are copied from the old arena by StorePacket().
+  std::vector<VCMPacket> old_data_buffer(new_size);
+  std::vector<uint8_t> old_payload_arena(new_size * kMaxPayloadSize);
+  data_buffer_.swap(old_data_buffer);
+  payload_arena_.swap(old_payload_arena);
   for (size_t i = 0; i < size_; ++i) {
     if (sequence_buffer_[i].used) {
       size_t index = sequence_buffer_[i].seq_num % new_size;
       new_sequence_buffer[index] = sequence_buffer_[i];
-      new_data_buffer[index] = data_buffer_[i];
+      StorePacket(index, old_data_buffer[i]);
     }
   }
   size_ = new_size;
   sequence_buffer_ = std::move(new_sequence_buffer);
-  data_buffer_ = std::move(new_data_buffer);
   return true;
 }
 
+void PacketBuffer::StorePacket(size_t index, const VCMPacket& packet) {
+  VCMPacket* stored_packet = &data_buffer_[index];
+  *stored_packet = packet;
+  if (packet.dataPtr) {
+    RTC_DCHECK_LE(packet.sizeBytes, kMaxPayloadSize);
+    uint8_t* payload = &payload_arena_[index * kMaxPayloadSize];
+    memcpy(payload, packet.dataPtr, packet.sizeBytes);
+    stored_packet->dataPtr = payload;
+  }
+}
+
 bool PacketBuffer::IsContinuous(uint16_t seq_num) const {
   size_t index = seq_num % size_;
   int prev_index = index > 0 ? index - 1 : size_ - 1;
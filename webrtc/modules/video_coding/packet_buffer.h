@@ -16,6 +16,7 @@
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/modules/video_coding/packet.h"
 #include "webrtc/modules/video_coding/rtp_frame_reference_finder.h"
 #include "webrtc/modules/video_coding/sequence_number_util.h"
@@ -34,6 +35,9 @@ class OnCompleteFrameCallback {
 
 class PacketBuffer {
  public:
+  // Packets with larger payloads than this are rejected.
+  static const size_t kMaxPayloadSize = IP_PACKET_SIZE;
+
   // Both |start_buffer_size| and |max_buffer_size| must be a power of 2.
   PacketBuffer(size_t start_buffer_size,
                size_t max_buffer_size,
@@ -68,6 +72,11 @@ class PacketBuffer {
     bool frame_created = false;
   };
 
+  // Copies the payload of |packet| into the arena slot at |index|, and stores
+  // the packet there.
+  void StorePacket(size_t index, const VCMPacket& packet)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Tries to expand the buffer.
   bool ExpandBufferSize() EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
@@ -102,9 +111,16 @@ class PacketBuffer {
   // If the packet buffer has received its first packet.
   bool first_packet_received_ GUARDED_BY(crit_);
 
-  // Buffer that holds the inserted packets.
+  // Buffer that holds the inserted packets. The |dataPtr| of each packet
+  // points into |payload_arena_|.
   std::vector<VCMPacket> data_buffer_ GUARDED_BY(crit_);
 
+  // The payloads of the inserted packets, |kMaxPayloadSize| bytes per slot of
+  // |data_buffer_|. Since consecutive packets use consecutive slots, the
+  // payloads of a frame are kept together in one region of the arena, and
+  // inserting a packet never allocates memory.
+  std::vector<uint8_t> payload_arena_ GUARDED_BY(crit_);
+
   // Buffer that holds the information about which slot that is currently in use
   // and information needed to determine the continuity between packets.
   std::vector<ContinuityInfo> sequence_buffer_ GUARDED_BY(crit_);
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/video_coding/encoded_frame.h"
+#include "webrtc/modules/video_coding/frame_object.h"
+#include "webrtc/modules/video_coding/jitter_buffer.h"
+#include "webrtc/modules/video_coding/packet_buffer.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/system_wrappers/include/event_wrapper.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+// A 4K keyframe of 800 kB, sent in 1200 byte packets.
+const size_t kPayloadSize = 1200;
+const size_t kPacketsPerFrame = 667;
+const int kNumFrames = 50;
+
+class FrameCollector : public OnCompleteFrameCallback {
+ public:
+  void OnCompleteFrame(std::unique_ptr<FrameObject> frame) override {
+    frame_ = std::move(frame);
+  }
+  std::unique_ptr<FrameObject> frame_;
+};
+
+// Returns the average time in microseconds spent inserting the packets of a
+// keyframe and extracting its bitstream. If |reordered| is true, every pair
+// of packets arrives in reverse order.
+size_t MeasureUsPerKeyframe(bool reordered) {
+  FrameCollector collector;
+  PacketBuffer packet_buffer(512, 2048, &collector);
+  // Each packet is received into its own buffer.
+  std::vector<uint8_t> payloads(kPayloadSize * kPacketsPerFrame, 0x5a);
+  std::vector<uint8_t> bitstream(kPayloadSize * kPacketsPerFrame);
+  VCMPacket packet;
+  packet.codec = kVideoCodecGeneric;
+  packet.frameType = kVideoFrameKey;
+  packet.sizeBytes = kPayloadSize;
+
+  uint16_t first_seq_num = 0;
+  uint64_t start_ns = rtc::TimeNanos();
+  for (int f = 0; f < kNumFrames; ++f) {
+    for (size_t i = 0; i < kPacketsPerFrame; ++i) {
+      size_t p = i;
+      if (reordered && i + 1 < kPacketsPerFrame)
+        p = i % 2 == 0 ? i + 1 : i - 1;
+      packet.seqNum = first_seq_num + p;
+      packet.dataPtr = &payloads[p * kPayloadSize];
+      packet.isFirstPacket = p == 0;
+      packet.markerBit = p == kPacketsPerFrame - 1;
+      EXPECT_TRUE(packet_buffer.InsertPacket(packet));
+    }
+    first_seq_num += kPacketsPerFrame;
+    EXPECT_TRUE(collector.frame_);
+    EXPECT_TRUE(collector.frame_->GetBitstream(bitstream.data()));
+    collector.frame_.reset();
+  }
+  uint64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  return static_cast<size_t>(elapsed_ns / kNumFrames / 1000);
+}
+
+// Same as MeasureUsPerKeyframe, but for the legacy VCMJitterBuffer, so that
+// the two receive paths can be compared on the same workload.
+size_t MeasureJitterBufferUsPerKeyframe(bool reordered) {
+  VCMJitterBuffer jitter_buffer(
+      Clock::GetRealTimeClock(),
+      std::unique_ptr<EventWrapper>(EventWrapper::Create()));
+  jitter_buffer.Start();
+  std::vector<uint8_t> payloads(kPayloadSize * kPacketsPerFrame, 0x5a);
+  std::vector<uint8_t> bitstream(kPayloadSize * kPacketsPerFrame);
+  VCMPacket packet;
+  packet.codec = kVideoCodecGeneric;
+  packet.frameType = kVideoFrameKey;
+
+  uint16_t first_seq_num = 0;
+  uint32_t timestamp = 0;
+  uint64_t start_ns = rtc::TimeNanos();
+  for (int f = 0; f < kNumFrames; ++f) {
+    for (size_t i = 0; i < kPacketsPerFrame; ++i) {
+      size_t p = i;
+      if (reordered && i + 1 < kPacketsPerFrame)
+        p = i % 2 == 0 ? i + 1 : i - 1;
+      packet.seqNum = first_seq_num + p;
+      packet.timestamp = timestamp;
+      packet.dataPtr = &payloads[p * kPayloadSize];
+      packet.sizeBytes = kPayloadSize;
+      packet.isFirstPacket = p == 0;
+      packet.markerBit = p == kPacketsPerFrame - 1;
+      bool retransmitted = false;
+      EXPECT_GE(jitter_buffer.InsertPacket(packet, &retransmitted), 0);
+    }
+    first_seq_num += kPacketsPerFrame;
+    uint32_t complete_timestamp = 0;
+    EXPECT_TRUE(jitter_buffer.NextCompleteTimestamp(0, &complete_timestamp));
+    VCMEncodedFrame* frame =
+        jitter_buffer.ExtractAndSetDecode(complete_timestamp);
+    EXPECT_TRUE(frame);
+    if (frame) {
+      EXPECT_EQ(bitstream.size(), frame->Length());
+      memcpy(bitstream.data(), frame->Buffer(), frame->Length());
+      jitter_buffer.ReleaseFrame(frame);
+    }
+    timestamp += 3000;
+  }
+  uint64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  jitter_buffer.Stop();
+  return static_cast<size_t>(elapsed_ns / kNumFrames / 1000);
+}
+}  // namespace
+
+TEST(PacketBufferPerformanceTest, Keyframes4k) {
+  test::PrintResult("packet_buffer_keyframe", "", "in_order",
+                    MeasureUsPerKeyframe(false), "us", true);
+  test::PrintResult("packet_buffer_keyframe", "", "reordered",
+                    MeasureUsPerKeyframe(true), "us", true);
+}
+
+TEST(PacketBufferPerformanceTest, Keyframes4kJitterBuffer) {
+  test::PrintResult("jitter_buffer_keyframe", "", "in_order",
+                    MeasureJitterBufferUsPerKeyframe(false), "us", true);
+  test::PrintResult("jitter_buffer_keyframe", "", "reordered",
+                    MeasureJitterBufferUsPerKeyframe(true), "us", true);
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
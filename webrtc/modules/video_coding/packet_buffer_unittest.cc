@@ -13,6 +13,7 @@
 #include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "webrtc/modules/video_coding/frame_object.h"
 #include "webrtc/modules/video_coding/packet_buffer.h"
@@ -477,6 +478,44 @@ TEST_F(TestPacketBuffer, GetBitstreamFromFrame) {
             0);
 }
 
+TEST_F(TestPacketBuffer, GetBitstreamAfterPayloadsAreReused) {
+  uint8_t data[] = {1, 2, 3};
+  uint8_t result[3 * sizeof(data)];
+  uint16_t seq_num = Rand();
+
+  // The packet buffer keeps its own copy of the payloads, so the caller may
+  // reuse its buffer as soon as a packet has been inserted.
+  //            seq_num    , kf, frst, lst, data_size   , data
+  InsertGeneric(seq_num    , kT, kT  , kF , sizeof(data), data);
+  data[0] = 4;
+  InsertGeneric(seq_num + 1, kF, kF  , kF , sizeof(data), data);
+  data[0] = 7;
+
+  // Force the buffer to expand while the frame is incomplete.
+  for (int i = 0; i < kStartSize; ++i) {
+    //            seq_num        , kf, frst, lst
+    InsertGeneric(seq_num + 3 + i, kT, kT  , kF);
+  }
+  InsertGeneric(seq_num + 2, kF, kF  , kT , sizeof(data), data);
+  data[0] = 0;
+
+  ASSERT_EQ(1UL, frames_from_callback_.size());
+  ASSERT_TRUE(frames_from_callback_.begin()->second->GetBitstream(result));
+  const uint8_t kExpected[] = {1, 2, 3, 4, 2, 3, 7, 2, 3};
+  EXPECT_EQ(0, memcmp(kExpected, result, sizeof(kExpected)));
+}
+
+TEST_F(TestPacketBuffer, RejectOversizedPayload) {
+  std::vector<uint8_t> data(PacketBuffer::kMaxPayloadSize + 1);
+  VCMPacket packet;
+  packet.seqNum = Rand();
+  packet.dataPtr = data.data();
+  packet.sizeBytes = data.size();
+  EXPECT_FALSE(packet_buffer_->InsertPacket(packet));
+  packet.sizeBytes = PacketBuffer::kMaxPayloadSize;
+  EXPECT_TRUE(packet_buffer_->InsertPacket(packet));
+}
+
 TEST_F(TestPacketBuffer, FreeSlotsOnFrameDestruction) {
   uint16_t seq_num = Rand();
 
@@ -789,6 +828,39 @@ TEST_F(TestPacketBuffer, Vp8TemporalLayersReordering_0212) {
   CheckReferencesVp8(pid + 11, pid + 8, pid + 9, pid + 10);
 }
 
+TEST_F(TestPacketBuffer, Vp8TemporalLayersReorderingTl0Wrap_0212) {
+  uint16_t pid = Rand();
+  uint16_t seq_num = Rand();
+
+  //        seq_num     , kf, frst, lst, sync, pid     , tid, tl0
+  InsertVp8(seq_num + 1 , kF, kT  , kT , kT  , pid + 1 , 2  , 255);
+  InsertVp8(seq_num     , kT, kT  , kT , kF  , pid     , 0  , 255);
+  InsertVp8(seq_num + 2 , kF, kT  , kT , kT  , pid + 2 , 1  , 255);
+  InsertVp8(seq_num + 4 , kF, kT  , kT , kF  , pid + 4 , 0  , 0);
+  InsertVp8(seq_num + 5 , kF, kT  , kT , kF  , pid + 5 , 2  , 0);
+  InsertVp8(seq_num + 3 , kF, kT  , kT , kF  , pid + 3 , 2  , 255);
+  InsertVp8(seq_num + 7 , kF, kT  , kT , kF  , pid + 7 , 2  , 0);
+  InsertVp8(seq_num + 9 , kF, kT  , kT , kT  , pid + 9 , 2  , 1);
+  InsertVp8(seq_num + 6 , kF, kT  , kT , kF  , pid + 6 , 1  , 0);
+  InsertVp8(seq_num + 8 , kF, kT  , kT , kF  , pid + 8 , 0  , 1);
+  InsertVp8(seq_num + 11, kF, kT  , kT , kF  , pid + 11, 2  , 1);
+  InsertVp8(seq_num + 10, kF, kT  , kT , kT  , pid + 10, 1  , 1);
+
+  ASSERT_EQ(12UL, frames_from_callback_.size());
+  CheckReferencesVp8(pid);
+  CheckReferencesVp8(pid + 1 , pid);
+  CheckReferencesVp8(pid + 2 , pid);
+  CheckReferencesVp8(pid + 3 , pid, pid + 1, pid + 2);
+  CheckReferencesVp8(pid + 4 , pid);
+  CheckReferencesVp8(pid + 5 , pid + 2, pid + 3, pid + 4);
+  CheckReferencesVp8(pid + 6 , pid + 2, pid + 4);
+  CheckReferencesVp8(pid + 7 , pid + 4, pid + 5, pid + 6);
+  CheckReferencesVp8(pid + 8 , pid + 4);
+  CheckReferencesVp8(pid + 9 , pid + 8);
+  CheckReferencesVp8(pid + 10, pid + 8);
+  CheckReferencesVp8(pid + 11, pid + 8, pid + 9, pid + 10);
+}
+
 TEST_F(TestPacketBuffer, Vp8InsertManyFrames_0212) {
   uint16_t pid = Rand();
   uint16_t seq_num = Rand();
@@ -25,8 +25,15 @@ RtpFrameReferenceFinder::RtpFrameReferenceFinder(
     OnCompleteFrameCallback* frame_callback)
     : last_picture_id_(-1),
       last_unwrap_(-1),
+      last_tl0_unwrap_(-1),
+      retrying_stashed_frames_(false),
+      retry_stashed_frames_again_(false),
+      layer_info_oldest_(std::numeric_limits<int64_t>::min()),
       current_ss_idx_(0),
-      frame_callback_(frame_callback) {}
+      gof_info_oldest_(std::numeric_limits<int64_t>::min()),
+      frame_callback_(frame_callback) {
+  up_switch_.fill(kNoTemporalIdx);
+}
 
 void RtpFrameReferenceFinder::ManageFrame(
     std::unique_ptr<RtpFrameObject> frame) {
@@ -52,20 +59,34 @@ void RtpFrameReferenceFinder::ManageFrame(
 }
 
 void RtpFrameReferenceFinder::RetryStashedFrames() {
-  size_t num_stashed_frames = stashed_frames_.size();
-
-  // Clean up stashed frames if there are too many.
-  while (stashed_frames_.size() > kMaxStashedFrames)
-    stashed_frames_.pop();
-
-  // Since frames are stashed if there is not enough data to determine their
-  // frame references we should at most check |stashed_frames_.size()| in
-  // order to not pop and push frames in and endless loop.
-  for (size_t i = 0; i < num_stashed_frames && !stashed_frames_.empty(); ++i) {
-    std::unique_ptr<RtpFrameObject> frame = std::move(stashed_frames_.front());
-    stashed_frames_.pop();
-    ManageFrame(std::move(frame));
+  // Frames completed while retrying only schedule another pass, so that each
+  // completed frame doesn't start a nested pass over all stashed frames.
+  retry_stashed_frames_again_ = true;
+  if (retrying_stashed_frames_)
+    return;
+
+  retrying_stashed_frames_ = true;
+  while (retry_stashed_frames_again_ && !stashed_frames_.empty()) {
+    retry_stashed_frames_again_ = false;
+
+    // Clean up stashed frames if there are too many.
+    while (stashed_frames_.size() > kMaxStashedFrames)
+      stashed_frames_.pop();
+
+    // Since frames are stashed if there is not enough data to determine their
+    // frame references we should at most check |stashed_frames_.size()| in
+    // order to not pop and push frames in and endless loop.
+    size_t num_stashed_frames = stashed_frames_.size();
+    for (size_t i = 0; i < num_stashed_frames && !stashed_frames_.empty();
+         ++i) {
+      std::unique_ptr<RtpFrameObject> frame =
+          std::move(stashed_frames_.front());
+      stashed_frames_.pop();
+      ManageFrame(std::move(frame));
+    }
   }
+  retry_stashed_frames_again_ = false;
+  retrying_stashed_frames_ = false;
 }
 
 void RtpFrameReferenceFinder::ManageFrameGeneric(
@@ -142,36 +163,37 @@ void RtpFrameReferenceFinder::ManageFrameVp8(
   if (AheadOf<uint16_t, kPicIdLength>(frame->picture_id, last_picture_id_)) {
     last_picture_id_ = Add<kPicIdLength>(last_picture_id_, 1);
     while (last_picture_id_ != frame->picture_id) {
-      not_yet_received_frames_.insert(last_picture_id_);
+      not_yet_received_frames_.set(last_picture_id_);
       last_picture_id_ = Add<kPicIdLength>(last_picture_id_, 1);
     }
   }
 
   // Clean up info for base layers that are too old.
-  uint8_t old_tl0_pic_idx = codec_header.tl0PicIdx - kMaxLayerInfo;
-  auto clean_layer_info_to = layer_info_.lower_bound(old_tl0_pic_idx);
-  layer_info_.erase(layer_info_.begin(), clean_layer_info_to);
+  int64_t tl0_pic_idx = UnwrapTl0PicIdx(codec_header.tl0PicIdx);
+  layer_info_oldest_ =
+      std::max(layer_info_oldest_, tl0_pic_idx - kMaxLayerInfo);
 
   // Clean up info about not yet received frames that are too old.
-  uint16_t old_picture_id =
-      Subtract<kPicIdLength>(frame->picture_id, kMaxNotYetReceivedFrames);
-  auto clean_frames_to = not_yet_received_frames_.lower_bound(old_picture_id);
-  not_yet_received_frames_.erase(not_yet_received_frames_.begin(),
-                                 clean_frames_to);
+  for (uint16_t age = kMaxNotYetReceivedFrames + 1; age <= kPicIdLength / 2;
+       ++age) {
+    not_yet_received_frames_.reset(
+        Subtract<kPicIdLength>(frame->picture_id, age));
+  }
 
   if (frame->frame_type() == kVideoFrameKey) {
     frame->num_references = 0;
-    layer_info_[codec_header.tl0PicIdx].fill(-1);
+    LayerInfoVp8* layer_info = InsertLayerInfoVp8(tl0_pic_idx);
+    if (layer_info)
+      layer_info->picture_ids.fill(-1);
     CompletedFrameVp8(std::move(frame));
     return;
   }
 
-  auto layer_info_it = layer_info_.find(codec_header.temporalIdx == 0
-                                            ? codec_header.tl0PicIdx - 1
-                                            : codec_header.tl0PicIdx);
+  LayerInfoVp8* layer_info = FindLayerInfoVp8(
+      codec_header.temporalIdx == 0 ? tl0_pic_idx - 1 : tl0_pic_idx);
 
   // If we don't have the base layer frame yet, stash this frame.
-  if (layer_info_it == layer_info_.end()) {
+  if (!layer_info) {
     stashed_frames_.emplace(std::move(frame));
     return;
   }
@@ -180,12 +202,17 @@ void RtpFrameReferenceFinder::ManageFrameVp8(
   // from the previous base layer frame and set a reference to the previous
   // base layer frame.
   if (codec_header.temporalIdx == 0) {
-    layer_info_it =
-        layer_info_
-            .insert(make_pair(codec_header.tl0PicIdx, layer_info_it->second))
-            .first;
+    LayerInfoVp8* base_layer_info = FindLayerInfoVp8(tl0_pic_idx);
+    if (!base_layer_info) {
+      std::array<int16_t, kMaxTemporalLayers> picture_ids =
+          layer_info->picture_ids;
+      base_layer_info = InsertLayerInfoVp8(tl0_pic_idx);
+      if (base_layer_info)
+        base_layer_info->picture_ids = picture_ids;
+    }
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = base_layer_info ? base_layer_info->picture_ids[0]
+                                           : layer_info->picture_ids[0];
     CompletedFrameVp8(std::move(frame));
     return;
   }
@@ -193,7 +220,7 @@ void RtpFrameReferenceFinder::ManageFrameVp8(
   // Layer sync frame, this frame only references its base layer frame.
   if (codec_header.layerSync) {
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = layer_info->picture_ids[0];
 
     CompletedFrameVp8(std::move(frame));
     return;
@@ -202,21 +229,22 @@ void RtpFrameReferenceFinder::ManageFrameVp8(
   // Find all references for this frame.
   frame->num_references = 0;
   for (uint8_t layer = 0; layer <= codec_header.temporalIdx; ++layer) {
-    RTC_DCHECK_NE(-1, layer_info_it->second[layer]);
+    int16_t ref_picture_id = layer_info->picture_ids[layer];
+    RTC_DCHECK_NE(-1, ref_picture_id);
 
     // If we have not yet received a frame between this frame and the referenced
     // frame then we have to wait for that frame to be completed first.
-    auto not_received_frame_it =
-        not_yet_received_frames_.upper_bound(layer_info_it->second[layer]);
-    if (not_received_frame_it != not_yet_received_frames_.end() &&
-        AheadOf<uint16_t, kPicIdLength>(frame->picture_id,
-                                        *not_received_frame_it)) {
-      stashed_frames_.emplace(std::move(frame));
-      return;
+    for (uint16_t pid = Add<kPicIdLength>(ref_picture_id, 1);
+         AheadOf<uint16_t, kPicIdLength>(frame->picture_id, pid);
+         pid = Add<kPicIdLength>(pid, 1)) {
+      if (not_yet_received_frames_[pid]) {
+        stashed_frames_.emplace(std::move(frame));
+        return;
+      }
     }
 
     ++frame->num_references;
-    frame->references[layer] = layer_info_it->second[layer];
+    frame->references[layer] = ref_picture_id;
   }
 
   CompletedFrameVp8(std::move(frame));
@@ -230,25 +258,25 @@ void RtpFrameReferenceFinder::CompletedFrameVp8(
 
   const RTPVideoHeaderVP8& codec_header = rtp_codec_header->VP8;
 
-  uint8_t tl0_pic_idx = codec_header.tl0PicIdx;
+  int64_t tl0_pic_idx = UnwrapTl0PicIdx(codec_header.tl0PicIdx);
   uint8_t temporal_index = codec_header.temporalIdx;
-  auto layer_info_it = layer_info_.find(tl0_pic_idx);
+  LayerInfoVp8* layer_info = FindLayerInfoVp8(tl0_pic_idx);
 
   // Update this layer info and newer.
-  while (layer_info_it != layer_info_.end()) {
-    if (layer_info_it->second[temporal_index] != -1 &&
-        AheadOf<uint16_t, kPicIdLength>(layer_info_it->second[temporal_index],
+  while (layer_info) {
+    if (layer_info->picture_ids[temporal_index] != -1 &&
+        AheadOf<uint16_t, kPicIdLength>(layer_info->picture_ids[temporal_index],
                                         frame->picture_id)) {
       // The frame was not newer, then no subsequent layer info have to be
       // update.
       break;
     }
 
-    layer_info_it->second[codec_header.temporalIdx] = frame->picture_id;
+    layer_info->picture_ids[temporal_index] = frame->picture_id;
     ++tl0_pic_idx;
-    layer_info_it = layer_info_.find(tl0_pic_idx);
+    layer_info = FindLayerInfoVp8(tl0_pic_idx);
   }
-  not_yet_received_frames_.erase(frame->picture_id);
+  not_yet_received_frames_.reset(frame->picture_id);
 
   for (size_t i = 0; i < frame->num_references; ++i)
     frame->references[i] = UnwrapPictureId(frame->references[i]);
@@ -292,6 +320,7 @@ void RtpFrameReferenceFinder::ManageFrameVp9(
     return;
   }
 
+  int64_t tl0_pic_idx = UnwrapTl0PicIdx(codec_header.tl0_pic_idx);
   if (codec_header.ss_data_available) {
     // Scalability structures can only be sent with tl0 frames.
     if (codec_header.temporal_idx != 0) {
@@ -302,42 +331,44 @@ void RtpFrameReferenceFinder::ManageFrameVp9(
       scalability_structures_[current_ss_idx_] = codec_header.gof;
       scalability_structures_[current_ss_idx_].pid_start = frame->picture_id;
 
-      auto pid_and_gof = std::make_pair(
-          frame->picture_id, &scalability_structures_[current_ss_idx_]);
-      gof_info_.insert(std::make_pair(codec_header.tl0_pic_idx, pid_and_gof));
+      InsertGofInfoVp9(tl0_pic_idx, frame->picture_id,
+                       &scalability_structures_[current_ss_idx_]);
     }
   }
 
   // Clean up info for base layers that are too old.
-  uint8_t old_tl0_pic_idx = codec_header.tl0_pic_idx - kMaxGofSaved;
-  auto clean_gof_info_to = gof_info_.lower_bound(old_tl0_pic_idx);
-  gof_info_.erase(gof_info_.begin(), clean_gof_info_to);
+  gof_info_oldest_ = std::max(gof_info_oldest_, tl0_pic_idx - kMaxGofSaved);
 
   if (frame->frame_type() == kVideoFrameKey) {
     // When using GOF all keyframes must include the scalability structure.
     if (!codec_header.ss_data_available)
       LOG(LS_WARNING) << "Received keyframe without scalability structure";
 
+    GofInfoEntryVp9* gof_info = FindGofInfoVp9(tl0_pic_idx);
+    if (!gof_info) {
+      stashed_frames_.emplace(std::move(frame));
+      return;
+    }
+
     frame->num_references = 0;
-    GofInfoVP9* gof = gof_info_.find(codec_header.tl0_pic_idx)->second.second;
-    FrameReceivedVp9(frame->picture_id, *gof);
+    FrameReceivedVp9(frame->picture_id, *gof_info->gof);
     CompletedFrameVp9(std::move(frame));
     return;
   }
 
-  auto gof_info_it = gof_info_.find(
+  GofInfoEntryVp9* gof_info = FindGofInfoVp9(
       (codec_header.temporal_idx == 0 && !codec_header.ss_data_available)
-          ? codec_header.tl0_pic_idx - 1
-          : codec_header.tl0_pic_idx);
+          ? tl0_pic_idx - 1
+          : tl0_pic_idx);
 
   // Gof info for this frame is not available yet, stash this frame.
-  if (gof_info_it == gof_info_.end()) {
+  if (!gof_info) {
     stashed_frames_.emplace(std::move(frame));
     return;
   }
 
-  GofInfoVP9* gof = gof_info_it->second.second;
-  uint16_t picture_id_tl0 = gof_info_it->second.first;
+  GofInfoVP9* gof = gof_info->gof;
+  uint16_t picture_id_tl0 = gof_info->picture_id;
 
   FrameReceivedVp9(frame->picture_id, *gof);
 
@@ -348,24 +379,20 @@ void RtpFrameReferenceFinder::ManageFrameVp9(
     return;
   }
 
-  if (codec_header.temporal_up_switch) {
-    auto pid_tidx =
-        std::make_pair(frame->picture_id, codec_header.temporal_idx);
-    up_switch_.insert(pid_tidx);
+  if (codec_header.temporal_up_switch &&
+      up_switch_[frame->picture_id] == kNoTemporalIdx) {
+    up_switch_[frame->picture_id] = codec_header.temporal_idx;
   }
 
   // If this is a base layer frame that contains a scalability structure
   // then gof info has already been inserted earlier, so we only want to
   // insert if we haven't done so already.
-  if (codec_header.temporal_idx == 0 && !codec_header.ss_data_available) {
-    auto pid_and_gof = std::make_pair(frame->picture_id, gof);
-    gof_info_.insert(std::make_pair(codec_header.tl0_pic_idx, pid_and_gof));
-  }
+  if (codec_header.temporal_idx == 0 && !codec_header.ss_data_available)
+    InsertGofInfoVp9(tl0_pic_idx, frame->picture_id, gof);
 
   // Clean out old info about up switch frames.
-  uint16_t old_picture_id = Subtract<kPicIdLength>(last_picture_id_, 50);
-  auto up_switch_erase_to = up_switch_.lower_bound(old_picture_id);
-  up_switch_.erase(up_switch_.begin(), up_switch_erase_to);
+  for (uint16_t age = kMaxUpSwitchAge + 1; age < kPicIdLength; ++age)
+    up_switch_[Subtract<kPicIdLength>(last_picture_id_, age)] = kNoTemporalIdx;
 
   RTC_DCHECK(
       (AheadOrAt<uint16_t, kPicIdLength>(frame->picture_id, picture_id_tl0)));
@@ -404,11 +431,12 @@ bool RtpFrameReferenceFinder::MissingRequiredFrameVp9(uint16_t picture_id,
   for (size_t i = 0; i < num_references; ++i) {
     uint16_t ref_pid =
         Subtract<kPicIdLength>(picture_id, gof.pid_diff[gof_idx][i]);
-    for (size_t l = 0; l < temporal_idx; ++l) {
-      auto missing_frame_it = missing_frames_for_layer_[l].lower_bound(ref_pid);
-      if (missing_frame_it != missing_frames_for_layer_[l].end() &&
-          AheadOf<uint16_t, kPicIdLength>(picture_id, *missing_frame_it)) {
-        return true;
+    for (uint16_t pid = ref_pid;
+         AheadOf<uint16_t, kPicIdLength>(picture_id, pid);
+         pid = Add<kPicIdLength>(pid, 1)) {
+      for (size_t l = 0; l < temporal_idx; ++l) {
+        if (missing_frames_for_layer_[l][pid])
+          return true;
       }
     }
   }
@@ -432,7 +460,7 @@ void RtpFrameReferenceFinder::FrameReceivedVp9(uint16_t picture_id,
       ++gof_idx;
       RTC_DCHECK_NE(0ul, gof_idx % gof.num_frames_in_gof);
       size_t temporal_idx = gof.temporal_idx[gof_idx];
-      missing_frames_for_layer_[temporal_idx].insert(last_picture_id_);
+      missing_frames_for_layer_[temporal_idx].set(last_picture_id_);
       last_picture_id_ = Add<kPicIdLength>(last_picture_id_, 1);
     }
   } else {
@@ -440,18 +468,17 @@ void RtpFrameReferenceFinder::FrameReceivedVp9(uint16_t picture_id,
         ForwardDiff<uint16_t, kPicIdLength>(gof.pid_start, picture_id);
     size_t gof_idx = diff % gof.num_frames_in_gof;
     size_t temporal_idx = gof.temporal_idx[gof_idx];
-    missing_frames_for_layer_[temporal_idx].erase(picture_id);
+    missing_frames_for_layer_[temporal_idx].reset(picture_id);
   }
 }
 
 bool RtpFrameReferenceFinder::UpSwitchInIntervalVp9(uint16_t picture_id,
                                                     uint8_t temporal_idx,
                                                     uint16_t pid_ref) {
-  for (auto up_switch_it = up_switch_.upper_bound(pid_ref);
-       up_switch_it != up_switch_.end() &&
-       AheadOf<uint16_t, kPicIdLength>(picture_id, up_switch_it->first);
-       ++up_switch_it) {
-    if (up_switch_it->second < temporal_idx)
+  for (uint16_t pid = Add<kPicIdLength>(pid_ref, 1);
+       AheadOf<uint16_t, kPicIdLength>(picture_id, pid);
+       pid = Add<kPicIdLength>(pid, 1)) {
+    if (up_switch_[pid] != kNoTemporalIdx && up_switch_[pid] < temporal_idx)
       return true;
   }
 
@@ -482,5 +509,66 @@ uint16_t RtpFrameReferenceFinder::UnwrapPictureId(uint16_t picture_id) {
   return last_unwrap_;
 }
 
+int64_t RtpFrameReferenceFinder::UnwrapTl0PicIdx(uint8_t tl0_pic_idx) {
+  // Start far from zero so that the unwrapped indices of reordered frames,
+  // and thereby the ring indices derived from them, stay positive.
+  if (last_tl0_unwrap_ == -1) {
+    last_tl0_unwrap_ = (1 << 16) + tl0_pic_idx;
+    return last_tl0_unwrap_;
+  }
+
+  uint8_t unwrap_truncated = static_cast<uint8_t>(last_tl0_unwrap_);
+  int64_t unwrapped;
+  if (AheadOf(tl0_pic_idx, unwrap_truncated))
+    unwrapped = last_tl0_unwrap_ + ForwardDiff(unwrap_truncated, tl0_pic_idx);
+  else
+    unwrapped = last_tl0_unwrap_ - ReverseDiff(unwrap_truncated, tl0_pic_idx);
+
+  last_tl0_unwrap_ = std::max(last_tl0_unwrap_, unwrapped);
+  return unwrapped;
+}
+
+RtpFrameReferenceFinder::LayerInfoVp8*
+RtpFrameReferenceFinder::FindLayerInfoVp8(int64_t tl0_pic_idx) {
+  LayerInfoVp8* layer_info = &layer_info_[tl0_pic_idx % kLayerInfoRingSize];
+  if (!layer_info->used || layer_info->tl0_pic_idx != tl0_pic_idx ||
+      tl0_pic_idx < layer_info_oldest_) {
+    return nullptr;
+  }
+  return layer_info;
+}
+
+RtpFrameReferenceFinder::LayerInfoVp8*
+RtpFrameReferenceFinder::InsertLayerInfoVp8(int64_t tl0_pic_idx) {
+  if (tl0_pic_idx < layer_info_oldest_)
+    return nullptr;
+  LayerInfoVp8* layer_info = &layer_info_[tl0_pic_idx % kLayerInfoRingSize];
+  layer_info->used = true;
+  layer_info->tl0_pic_idx = tl0_pic_idx;
+  return layer_info;
+}
+
+RtpFrameReferenceFinder::GofInfoEntryVp9*
+RtpFrameReferenceFinder::FindGofInfoVp9(int64_t tl0_pic_idx) {
+  GofInfoEntryVp9* gof_info = &gof_info_[tl0_pic_idx % kGofInfoRingSize];
+  if (!gof_info->used || gof_info->tl0_pic_idx != tl0_pic_idx ||
+      tl0_pic_idx < gof_info_oldest_) {
+    return nullptr;
+  }
+  return gof_info;
+}
+
+void RtpFrameReferenceFinder::InsertGofInfoVp9(int64_t tl0_pic_idx,
+                                               uint16_t picture_id,
+                                               GofInfoVP9* gof) {
+  if (tl0_pic_idx < gof_info_oldest_ || FindGofInfoVp9(tl0_pic_idx))
+    return;
+  GofInfoEntryVp9* gof_info = &gof_info_[tl0_pic_idx % kGofInfoRingSize];
+  gof_info->used = true;
+  gof_info->tl0_pic_idx = tl0_pic_idx;
+  gof_info->picture_id = picture_id;
+  gof_info->gof = gof;
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
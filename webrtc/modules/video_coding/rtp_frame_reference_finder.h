@@ -12,10 +12,10 @@
 #define WEBRTC_MODULES_VIDEO_CODING_RTP_FRAME_REFERENCE_FINDER_H_
 
 #include <array>
+#include <bitset>
 #include <map>
 #include <memory>
 #include <queue>
-#include <set>
 #include <utility>
 
 #include "webrtc/base/criticalsection.h"
@@ -41,11 +41,34 @@ class RtpFrameReferenceFinder {
   static const int kMaxStashedFrames = 10;
   static const int kMaxNotYetReceivedFrames = 20;
   static const int kMaxGofSaved = 15;
+  static const int kMaxUpSwitchAge = 50;
+  // Sizes of the |layer_info_| and |gof_info_| rings. Must be larger than
+  // |kMaxLayerInfo| and at least |kMaxGofSaved| + 1 respectively.
+  static const int kLayerInfoRingSize = 16;
+  static const int kGofInfoRingSize = 16;
+
+  // The last completed frame for every temporal layer given a TL0 picture
+  // index.
+  struct LayerInfoVp8 {
+    bool used = false;
+    int64_t tl0_pic_idx = 0;
+    std::array<int16_t, kMaxTemporalLayers> picture_ids;
+  };
+
+  // The picture id and the Gof information given a TL0 picture index.
+  struct GofInfoEntryVp9 {
+    bool used = false;
+    int64_t tl0_pic_idx = 0;
+    uint16_t picture_id = 0;
+    GofInfoVP9* gof = nullptr;
+  };
 
   rtc::CriticalSection crit_;
 
   // Retry finding references for all frames that previously didn't have
-  // all information needed.
+  // all information needed. Called whenever a frame has been completed, since
+  // that is the only event that can provide the missing information. If
+  // called while already retrying, another pass is scheduled instead.
   void RetryStashedFrames() EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Find references for generic frames.
@@ -56,6 +79,16 @@ class RtpFrameReferenceFinder {
   void ManageFrameVp8(std::unique_ptr<RtpFrameObject> frame)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Returns the layer info for the (unwrapped) |tl0_pic_idx|, or nullptr if
+  // there is none.
+  LayerInfoVp8* FindLayerInfoVp8(int64_t tl0_pic_idx)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Returns the layer info slot for |tl0_pic_idx|, replacing any older info
+  // stored in it. Returns nullptr if |tl0_pic_idx| is too old to be saved.
+  LayerInfoVp8* InsertLayerInfoVp8(int64_t tl0_pic_idx)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Updates all necessary state used to determine frame references
   // for Vp8 and then calls the |frame_callback| callback with the
   // completed frame.
@@ -66,6 +99,17 @@ class RtpFrameReferenceFinder {
   void ManageFrameVp9(std::unique_ptr<RtpFrameObject> frame)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Returns the Gof info for the (unwrapped) |tl0_pic_idx|, or nullptr if
+  // there is none.
+  GofInfoEntryVp9* FindGofInfoVp9(int64_t tl0_pic_idx)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Saves the Gof info for |tl0_pic_idx| unless there already is Gof info
+  // saved for it.
+  void InsertGofInfoVp9(int64_t tl0_pic_idx,
+                        uint16_t picture_id,
+                        GofInfoVP9* gof) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Unwrap the picture id and the frame references  and then call the
   // |frame_callback| callback with the completed frame.
   void CompletedFrameVp9(std::unique_ptr<RtpFrameObject> frame)
@@ -91,6 +135,10 @@ class RtpFrameReferenceFinder {
   // All picture ids are unwrapped to 16 bits.
   uint16_t UnwrapPictureId(uint16_t picture_id) EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // TL0 picture indices are unwrapped to 64 bits, which lets them be used as
+  // keys of the |layer_info_| and |gof_info_| rings.
+  int64_t UnwrapTl0PicIdx(uint8_t tl0_pic_idx) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Holds the last sequence number of the last frame that has been created
   // given the last sequence number of a given keyframe.
   std::map<uint16_t, uint16_t, DescendingSeqNumComp<uint16_t>> last_seq_num_gop_
@@ -104,21 +152,27 @@ class RtpFrameReferenceFinder {
   // of |kPicIdLength| to 16 bits.
   int last_unwrap_ GUARDED_BY(crit_);
 
+  // The last unwrapped TL0 picture index, or -1 before the first one.
+  int64_t last_tl0_unwrap_ GUARDED_BY(crit_);
+
   // Frames earlier than the last received frame that have not yet been
-  // fully received.
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>
-      not_yet_received_frames_ GUARDED_BY(crit_);
+  // fully received, indexed by picture id.
+  std::bitset<kPicIdLength> not_yet_received_frames_ GUARDED_BY(crit_);
 
   // Frames that have been fully received but didn't have all the information
   // needed to determine their references.
   std::queue<std::unique_ptr<RtpFrameObject>> stashed_frames_ GUARDED_BY(crit_);
 
+  // If the stashed frames are currently being retried, and if another pass
+  // over them has been requested since the current pass started.
+  bool retrying_stashed_frames_ GUARDED_BY(crit_);
+  bool retry_stashed_frames_again_ GUARDED_BY(crit_);
+
   // Holds the information about the last completed frame for a given temporal
-  // layer given a Tl0 picture index.
-  std::map<uint8_t,
-           std::array<int16_t, kMaxTemporalLayers>,
-           DescendingSeqNumComp<uint8_t>>
-      layer_info_ GUARDED_BY(crit_);
+  // layer given a Tl0 picture index, at index |tl0_pic_idx| %
+  // |kLayerInfoRingSize|. Info older than |layer_info_oldest_| is stale.
+  std::array<LayerInfoVp8, kLayerInfoRingSize> layer_info_ GUARDED_BY(crit_);
+  int64_t layer_info_oldest_ GUARDED_BY(crit_);
 
   // Where the current scalability structure is in the
   // |scalability_structures_| array.
@@ -128,19 +182,19 @@ class RtpFrameReferenceFinder {
   std::array<GofInfoVP9, kMaxGofSaved> scalability_structures_
       GUARDED_BY(crit_);
 
-  // Holds the picture id and the Gof information for a given TL0 picture index.
-  std::map<uint8_t,
-           std::pair<uint16_t, GofInfoVP9*>,
-           DescendingSeqNumComp<uint8_t>>
-      gof_info_ GUARDED_BY(crit_);
+  // Holds the picture id and the Gof information for a given TL0 picture
+  // index, at index |tl0_pic_idx| % |kGofInfoRingSize|. Info older than
+  // |gof_info_oldest_| is stale.
+  std::array<GofInfoEntryVp9, kGofInfoRingSize> gof_info_ GUARDED_BY(crit_);
+  int64_t gof_info_oldest_ GUARDED_BY(crit_);
 
-  // Keep track of which picture id and which temporal layer that had the
-  // up switch flag set.
-  std::map<uint16_t, uint8_t> up_switch_ GUARDED_BY(crit_);
+  // Keep track of which temporal layer had the up switch flag set, indexed by
+  // picture id. |kNoTemporalIdx| if the flag was not set.
+  std::array<uint8_t, kPicIdLength> up_switch_ GUARDED_BY(crit_);
 
-  // For every temporal layer, keep a set of which frames that are missing.
-  std::array<std::set<uint16_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>,
-             kMaxTemporalLayers>
+  // For every temporal layer, keep track of which frames that are missing,
+  // indexed by picture id.
+  std::array<std::bitset<kPicIdLength>, kMaxTemporalLayers>
       missing_frames_for_layer_ GUARDED_BY(crit_);
 
   OnCompleteFrameCallback* frame_callback_;
@@ -157,12 +157,19 @@ int VCMSessionInfo::NumPackets() const {
 size_t VCMSessionInfo::InsertBuffer(uint8_t* frame_buffer,
                                     PacketIterator packet_it) {
   VCMPacket& packet = *packet_it;
-  PacketIterator it;
 
-  // Calculate the offset into the frame buffer for this packet.
+  // Calculate the offset into the frame buffer for this packet. Packets are
+  // stored back to back in sequence number order, so this packet starts where
+  // the closest preceding packet with data ends.
   size_t offset = 0;
-  for (it = packets_.begin(); it != packet_it; ++it)
-    offset += (*it).sizeBytes;
+  PacketIterator it = packet_it;
+  while (it != packets_.begin()) {
+    --it;
+    if ((*it).sizeBytes > 0) {
+      offset = (*it).dataPtr + (*it).sizeBytes - frame_buffer;
+      break;
+    }
+  }
 
   // Set the data pointer to pointing to the start of this packet in the
   // frame buffer.
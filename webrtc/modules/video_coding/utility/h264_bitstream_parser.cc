@@ -9,11 +9,9 @@
  */
 #include "webrtc/modules/video_coding/utility/h264_bitstream_parser.h"
 
-#include <memory>
 #include <vector>
 
 #include "webrtc/base/bitbuffer.h"
-#include "webrtc/base/bytebuffer.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 
@@ -57,32 +55,38 @@ std::vector<size_t> FindNaluStartSequences(const uint8_t* buffer,
 
   return sequences;
 }
-}  // namespace
 
-// Parses RBSP from source bytes. Removes emulation bytes, but leaves the
-// rbsp_trailing_bits() in the stream, since none of the parsing reads all the
-// way to the end of a parsed RBSP sequence. When writing, that means the
-// rbsp_trailing_bits() should be preserved and don't need to be restored (i.e.
-// the rbsp_stop_one_bit, which is just a 1, then zero padded), and alignment
-// should "just work".
+// Parses RBSP from source bytes into |rbsp|. Removes emulation bytes, but
+// leaves the rbsp_trailing_bits() in the stream, since none of the parsing
+// reads all the way to the end of a parsed RBSP sequence. When writing, that
+// means the rbsp_trailing_bits() should be preserved and don't need to be
+// restored (i.e. the rbsp_stop_one_bit, which is just a 1, then zero padded),
+// and alignment should "just work".
+// The bytes between emulation bytes are copied in runs, and |rbsp| is reused
+// between NALUs, since slices of high resolution frames can be large.
 // TODO(pbos): Make parsing RBSP something that can be integrated into BitBuffer
 // so we don't have to copy the entire frames when only interested in the
 // headers.
-rtc::ByteBufferWriter* ParseRbsp(const uint8_t* bytes, size_t length) {
-  // Copied from webrtc::H264SpsParser::Parse.
-  rtc::ByteBufferWriter* rbsp_buffer = new rtc::ByteBufferWriter();
-  for (size_t i = 0; i < length;) {
-    if (length - i >= 3 && bytes[i] == 0 && bytes[i + 1] == 0 &&
-        bytes[i + 2] == 3) {
-      rbsp_buffer->WriteBytes(reinterpret_cast<const char*>(bytes) + i, 2);
-      i += 3;
-    } else {
-      rbsp_buffer->WriteBytes(reinterpret_cast<const char*>(bytes) + i, 1);
-      i++;
+void ParseRbsp(const uint8_t* bytes,
+               size_t length,
+               std::vector<uint8_t>* rbsp) {
+  rbsp->clear();
+  size_t run_start = 0;
+  for (size_t i = 0; i + 2 < length; ++i) {
+    // Skip ahead like FindNaluStartSequences(): no emulation sequence
+    // (0 0 3) can start at |i|, |i| + 1 or |i| + 2 if the third byte is
+    // larger than 3.
+    if (bytes[i + 2] > 3) {
+      i += 2;
+    } else if (bytes[i] == 0 && bytes[i + 1] == 0 && bytes[i + 2] == 3) {
+      rbsp->insert(rbsp->end(), bytes + run_start, bytes + i + 2);
+      run_start = i + 3;
+      i += 2;
     }
   }
-  return rbsp_buffer;
+  rbsp->insert(rbsp->end(), bytes + run_start, bytes + length);
 }
+}  // namespace
 
 #define RETURN_FALSE_ON_FAIL(x)       \
   if (!(x)) {                         \
@@ -103,10 +107,9 @@ bool H264BitstreamParser::ParseSpsNalu(const uint8_t* sps, size_t length) {
   sps_parsed_ = false;
   // Parse out the SPS RBSP. It should be small, so it's ok that we create a
   // copy. We'll eventually write this back.
-  std::unique_ptr<rtc::ByteBufferWriter> sps_rbsp(
-      ParseRbsp(sps + kNaluHeaderAndTypeSize, length - kNaluHeaderAndTypeSize));
-  rtc::BitBuffer sps_parser(reinterpret_cast<const uint8_t*>(sps_rbsp->Data()),
-                            sps_rbsp->Length());
+  ParseRbsp(sps + kNaluHeaderAndTypeSize, length - kNaluHeaderAndTypeSize,
+            &rbsp_buffer_);
+  rtc::BitBuffer sps_parser(rbsp_buffer_.data(), rbsp_buffer_.size());
 
   uint8_t byte_tmp;
   uint32_t golomb_tmp;
@@ -209,10 +212,9 @@ bool H264BitstreamParser::ParsePpsNalu(const uint8_t* pps, size_t length) {
   // We're starting a new stream, so reset picture type rewriting values.
   pps_ = PpsState();
   pps_parsed_ = false;
-  std::unique_ptr<rtc::ByteBufferWriter> buffer(
-      ParseRbsp(pps + kNaluHeaderAndTypeSize, length - kNaluHeaderAndTypeSize));
-  rtc::BitBuffer parser(reinterpret_cast<const uint8_t*>(buffer->Data()),
-                        buffer->Length());
+  ParseRbsp(pps + kNaluHeaderAndTypeSize, length - kNaluHeaderAndTypeSize,
+            &rbsp_buffer_);
+  rtc::BitBuffer parser(rbsp_buffer_.data(), rbsp_buffer_.size());
 
   uint32_t bits_tmp;
   uint32_t golomb_ignored;
@@ -317,11 +319,9 @@ bool H264BitstreamParser::ParseNonParameterSetNalu(const uint8_t* source,
   RTC_CHECK(sps_parsed_);
   RTC_CHECK(pps_parsed_);
   last_slice_qp_delta_parsed_ = false;
-  std::unique_ptr<rtc::ByteBufferWriter> slice_rbsp(ParseRbsp(
-      source + kNaluHeaderAndTypeSize, source_length - kNaluHeaderAndTypeSize));
-  rtc::BitBuffer slice_reader(
-      reinterpret_cast<const uint8_t*>(slice_rbsp->Data()),
-      slice_rbsp->Length());
+  ParseRbsp(source + kNaluHeaderAndTypeSize,
+            source_length - kNaluHeaderAndTypeSize, &rbsp_buffer_);
+  rtc::BitBuffer slice_reader(rbsp_buffer_.data(), rbsp_buffer_.size());
   // Check to see if this is an IDR slice, which has an extra field to parse
   // out.
   bool is_idr = (source[kNaluHeaderSize] & 0x0F) == kNaluIdr;
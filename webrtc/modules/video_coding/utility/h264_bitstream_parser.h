@@ -14,6 +14,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <vector>
+
 namespace rtc {
 class BitBuffer;
 }
@@ -70,6 +72,9 @@ class H264BitstreamParser {
   bool pps_parsed_ = false;
   PpsState pps_;
 
+  // The RBSP of the NALU being parsed.
+  std::vector<uint8_t> rbsp_buffer_;
+
   // Last parsed slice QP.
   bool last_slice_qp_delta_parsed_ = false;
   int32_t last_slice_qp_delta_ = 0;
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/bitbuffer.h"
+#include "webrtc/modules/video_coding/utility/h264_bitstream_parser.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/test/testsupport/perf_timer.h"
+
+namespace webrtc {
+namespace {
+const int kNumIterations = 2000;
+
+// SPS, PPS and the start of an IDR slice, as in h264_bitstream_parser_unittest.
+const uint8_t kH264KeyFrameStart[] = {
+    0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x80, 0x20, 0xda, 0x01, 0x40, 0x16,
+    0xe8, 0x06, 0xd0, 0xa1, 0x35, 0x00, 0x00, 0x00, 0x01, 0x68, 0xce, 0x06,
+    0xe2, 0x00, 0x00, 0x00, 0x01, 0x65, 0xb8, 0x40, 0xf0, 0x8c, 0x03, 0xf2,
+    0x75, 0x67, 0xad, 0x41, 0x64, 0x24, 0x0e, 0xa0, 0xb2, 0x12, 0x1e, 0xf8,
+};
+
+const int kKeyFrameQp = 35;
+
+// The start of a non-IDR slice referring to the SPS and PPS above.
+const uint8_t kH264DeltaFrameStart[] = {
+    0x00, 0x00, 0x00, 0x01, 0x41, 0xe2, 0x01, 0x16, 0x0e, 0x3e, 0x2b, 0x86,
+};
+const int kDeltaFrameQp = 37;
+
+// Returns |start| followed by slice data up to about |size| bytes, with an
+// emulation prevention byte every 64 bytes.
+std::vector<uint8_t> BuildFrame(const uint8_t* start,
+                                size_t start_size,
+                                size_t size) {
+  std::vector<uint8_t> frame(start, start + start_size);
+  while (frame.size() < size) {
+    if (frame.size() % 64 == 0) {
+      frame.insert(frame.end(), {0x00, 0x00, 0x03, 0x01});
+    } else {
+      frame.push_back(0x5a);
+    }
+  }
+  return frame;
+}
+
+// Returns the number of megabytes of bitstream parsed per second.
+size_t MeasureParsedMBPerSecond(size_t frame_size) {
+  const std::vector<uint8_t> key_frame = BuildFrame(
+      kH264KeyFrameStart, sizeof(kH264KeyFrameStart), frame_size);
+  const std::vector<uint8_t> delta_frame = BuildFrame(
+      kH264DeltaFrameStart, sizeof(kH264DeltaFrameStart), frame_size);
+  H264BitstreamParser parser;
+  int num_frames = 0;
+  int num_expected_qps = 0;
+  uint64_t num_bytes = 0;
+  const double frames_per_second = test::MeasureCallsPerSecond(
+      kNumIterations, [&key_frame, &delta_frame, &parser, &num_frames,
+                       &num_expected_qps, &num_bytes] {
+        const bool is_key_frame = num_frames++ == 0;
+        const std::vector<uint8_t>& frame =
+            is_key_frame ? key_frame : delta_frame;
+        parser.ParseBitstream(frame.data(), frame.size());
+        num_bytes += frame.size();
+        int qp;
+        num_expected_qps += parser.GetLastSliceQp(&qp) &&
+                            qp == (is_key_frame ? kKeyFrameQp : kDeltaFrameQp);
+      });
+  // Every slice header is parsed, and the delta frames find the SPS and PPS
+  // of the key frame.
+  EXPECT_EQ(kNumIterations, num_expected_qps);
+  return static_cast<size_t>(frames_per_second * num_bytes / kNumIterations /
+                             1000000);
+}
+
+// Returns the number of Exp-Golomb codes, the variable length syntax elements
+// that make up SPS, PPS and slice headers, read per microsecond.
+size_t MeasureExpGolombCodesPerUs() {
+  std::vector<uint8_t> data(4096);
+  rtc::BitBufferWriter writer(data.data(), data.size());
+  size_t num_codes = 0;
+  uint64_t expected_sum = 0;
+  while (writer.WriteExponentialGolomb((num_codes * 37) % 300)) {
+    expected_sum += (num_codes * 37) % 300;
+    ++num_codes;
+  }
+  size_t num_read = 0;
+  uint64_t sum = 0;
+  const double passes_per_second = test::MeasureCallsPerSecond(
+      kNumIterations, [&data, num_codes, &num_read, &sum] {
+        rtc::BitBuffer reader(data.data(), data.size());
+        for (size_t j = 0; j < num_codes; ++j) {
+          uint32_t value;
+          if (!reader.ReadExponentialGolomb(&value))
+            break;
+          ++num_read;
+          sum += value;
+        }
+      });
+  // Every pass reads back all the values that were written.
+  EXPECT_EQ(num_codes * kNumIterations, num_read);
+  EXPECT_EQ(expected_sum * kNumIterations, sum);
+  return static_cast<size_t>(passes_per_second * num_codes / 1000000);
+}
+}  // namespace
+
+TEST(H264BitstreamParserPerformanceTest, ParseFrames) {
+  test::PrintResult("h264_bitstream_parse", "", "1kB_frames",
+                    MeasureParsedMBPerSecond(1000), "MB/s", false);
+  test::PrintResult("h264_bitstream_parse", "", "50kB_frames",
+                    MeasureParsedMBPerSecond(50000), "MB/s", true);
+}
+
+TEST(H264BitstreamParserPerformanceTest, ReadExponentialGolomb) {
+  test::PrintResult("h264_exp_golomb_read", "", "codes",
+                    MeasureExpGolombCodesPerUs(), "codes/us", true);
+}
+
+}  // namespace webrtc
@@ -17,6 +17,9 @@ static const int kMinFps = 5;
 static const int kMeasureSecondsFastUpscale = 2;
 static const int kMeasureSecondsUpscale = 5;
 static const int kMeasureSecondsDownscale = 5;
+// Frames dropped by the encoder are a much clearer sign of too little
+// bandwidth than a high average QP, so they are acted on sooner.
+static const int kMeasureSecondsFramedrop = 2;
 static const int kFramedropPercentThreshold = 60;
 // Min width/height to downscale to, set to not go below QVGA, but with some
 // margin to permit "almost-QVGA" resolutions, such as QCIF.
@@ -104,7 +107,7 @@ void QualityScaler::OnEncodeFrame(const VideoFrame& frame) {
   int avg_drop = 0;
   int avg_qp = 0;
 
-  if ((framedrop_percent_.GetAverage(num_samples_downscale_, &avg_drop) &&
+  if ((framedrop_percent_.GetAverage(num_samples_framedrop_, &avg_drop) &&
        avg_drop >= kFramedropPercentThreshold) ||
       (average_qp_downscale_.GetAverage(num_samples_downscale_, &avg_qp) &&
        avg_qp > high_qp_threshold_)) {
@@ -174,6 +177,8 @@ void QualityScaler::ClearSamples() {
 void QualityScaler::UpdateSampleCounts() {
   num_samples_downscale_ = static_cast<size_t>(
       kMeasureSecondsDownscale * (framerate_ < kMinFps ? kMinFps : framerate_));
+  num_samples_framedrop_ = static_cast<size_t>(
+      kMeasureSecondsFramedrop * (framerate_ < kMinFps ? kMinFps : framerate_));
   num_samples_upscale_ = static_cast<size_t>(
       measure_seconds_upscale_ * (framerate_ < kMinFps ? kMinFps : framerate_));
 }
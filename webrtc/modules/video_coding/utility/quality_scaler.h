@@ -56,6 +56,7 @@ class QualityScaler {
   VideoFrame scaled_frame_;
 
   size_t num_samples_downscale_;
+  size_t num_samples_framedrop_;
   size_t num_samples_upscale_;
   int measure_seconds_upscale_;
   MovingAverage<int> average_qp_upscale_;
@@ -30,6 +30,7 @@ static const int kLowInitialBitrateKbps = 300;
 static const int kMeasureSecondsFastUpscale = 2;
 static const int kMeasureSecondsUpscale = 5;
 static const int kMeasureSecondsDownscale = 5;
+static const int kMeasureSecondsFramedrop = 2;
 static const int kMinDownscaleDimension = 140;
 }  // namespace
 
@@ -326,6 +327,42 @@ TEST_F(QualityScalerTest, DownscaleAfterMeasuredSecondsThenSlowerBackUp) {
   EXPECT_EQ(initial_res.height, qs_.GetScaledResolution().height);
 }
 
+TEST_F(QualityScalerTest, DownscaleQuicklyAfterFramedropMeasuredSeconds) {
+  qs_.Init(kLowQpThreshold, kHighQp, 0, kWidth, kHeight, kFramerate);
+  qs_.OnEncodeFrame(input_frame_);
+  QualityScaler::Resolution initial_res = qs_.GetScaledResolution();
+
+  // Should not downscale if less than kMeasureSecondsFramedrop seconds passed.
+  for (int i = 0; i < kFramerate * kMeasureSecondsFramedrop - 1; ++i) {
+    qs_.ReportDroppedFrame();
+    qs_.OnEncodeFrame(input_frame_);
+  }
+  EXPECT_EQ(initial_res.width, qs_.GetScaledResolution().width);
+  EXPECT_EQ(initial_res.height, qs_.GetScaledResolution().height);
+
+  // Should downscale if kMeasureSecondsFramedrop seconds passed (add last
+  // frame).
+  qs_.ReportDroppedFrame();
+  qs_.OnEncodeFrame(input_frame_);
+  EXPECT_GT(initial_res.width, qs_.GetScaledResolution().width);
+  EXPECT_GT(initial_res.height, qs_.GetScaledResolution().height);
+}
+
+TEST_F(QualityScalerTest, DoesNotDownscaleOnShortFramedropBurst) {
+  // Drop frames for half of the framedrop window, e.g. after a large key
+  // frame.
+  for (int i = 0; i < kFramerate * kMeasureSecondsFramedrop / 2; ++i) {
+    qs_.ReportDroppedFrame();
+    qs_.OnEncodeFrame(input_frame_);
+  }
+  for (int i = 0; i < kFramerate * kNumSeconds; ++i) {
+    qs_.ReportQP(kNormalQp);
+    qs_.OnEncodeFrame(input_frame_);
+    ASSERT_EQ(input_frame_.width(), qs_.GetScaledResolution().width)
+        << "Unexpected scale after short framedrop burst.";
+  }
+}
+
 TEST_F(QualityScalerTest, UpscaleQuicklyInitiallyAfterMeasuredSeconds) {
   qs_.Init(kLowQpThreshold, kHighQp, kLowInitialBitrateKbps, kWidth, kHeight,
            kFramerate);
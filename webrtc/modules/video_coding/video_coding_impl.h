@@ -108,6 +108,10 @@ class VideoSender : public Module {
   VCMSendStatisticsCallback* const send_stats_callback_;
   VCMCodecDataBase _codecDataBase GUARDED_BY(encoder_crit_);
   bool frame_dropper_enabled_ GUARDED_BY(encoder_crit_);
+  // Frames with a native handle, and how many of them had to be converted to
+  // I420 because the encoder couldn't take them as they were.
+  int num_native_frames_ GUARDED_BY(encoder_crit_);
+  int num_native_frames_converted_ GUARDED_BY(encoder_crit_);
   VCMProcessTimer _sendStatsTimer;
 
   // Must be accessed on the construction thread of VideoSender.
@@ -169,6 +173,10 @@ class VideoReceiver : public Module {
 
   void SetDecodeErrorMode(VCMDecodeErrorMode decode_error_mode);
   int SetMinReceiverDelay(int desired_delay_ms);
+  // If set, frames are decoded as soon as they are decodable, even if the
+  // decoder prefers to decode them close to their render time. For receivers
+  // that don't render in real time.
+  void SetIgnoreRenderTime(bool ignore_render_time);
 
   int32_t SetReceiveChannelParameters(int64_t rtt);
   int32_t SetVideoProtection(VCMVideoProtection videoProtection, bool enable);
@@ -203,6 +211,7 @@ class VideoReceiver : public Module {
   size_t max_nack_list_size_ GUARDED_BY(process_crit_);
 
   VCMCodecDataBase _codecDataBase GUARDED_BY(receive_crit_);
+  bool ignore_render_time_ GUARDED_BY(receive_crit_);
   EncodedImageCallback* pre_decode_image_callback_;
 
   VCMProcessTimer _receiveStatsTimer;
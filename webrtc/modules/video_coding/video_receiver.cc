@@ -46,6 +46,7 @@ VideoReceiver::VideoReceiver(Clock* clock,
       drop_frames_until_keyframe_(false),
       max_nack_list_size_(0),
       _codecDataBase(nullptr, nullptr),
+      ignore_render_time_(false),
       pre_decode_image_callback_(pre_decode_image_callback),
       _receiveStatsTimer(1000, clock_),
       _retransmissionTimer(10, clock_),
@@ -248,7 +249,8 @@ int32_t VideoReceiver::Decode(uint16_t maxWaitTimeMs) {
   bool prefer_late_decoding = false;
   {
     rtc::CritScope cs(&receive_crit_);
-    prefer_late_decoding = _codecDataBase.PrefersLateDecoding();
+    prefer_late_decoding =
+        !ignore_render_time_ && _codecDataBase.PrefersLateDecoding();
   }
 
   VCMEncodedFrame* frame = _receiver.FrameForDecoding(
@@ -509,5 +511,10 @@ int VideoReceiver::SetMinReceiverDelay(int desired_delay_ms) {
   return _receiver.SetMinReceiverDelay(desired_delay_ms);
 }
 
+void VideoReceiver::SetIgnoreRenderTime(bool ignore_render_time) {
+  rtc::CritScope cs(&receive_crit_);
+  ignore_render_time_ = ignore_render_time;
+}
+
 }  // namespace vcm
 }  // namespace webrtc
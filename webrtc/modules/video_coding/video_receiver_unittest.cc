@@ -197,6 +197,33 @@ TEST_F(TestVideoReceiver, PaddingOnlyAndVideo) {
   }
 }
 
+TEST_F(TestVideoReceiver, DecodesBeforeRenderTimeIfIgnoringRenderTime) {
+  const size_t kFrameSize = 1200;
+  const uint8_t payload[kFrameSize] = {0};
+  WebRtcRTPHeader header;
+  memset(&header, 0, sizeof(header));
+  header.frameType = kVideoFrameKey;
+  header.type.Video.isFirstPacket = true;
+  header.header.markerBit = true;
+  header.header.payloadType = kUnusedPayloadType;
+  header.header.ssrc = 1;
+  header.header.headerLength = 12;
+  header.type.Video.codec = kRtpVideoVp8;
+  header.type.Video.codecHeader.VP8.pictureId = -1;
+  header.type.Video.codecHeader.VP8.tl0PicIdx = -1;
+  // Puts the render time of the frame well into the future.
+  EXPECT_EQ(0, receiver_->SetMinimumPlayoutDelay(500));
+  EXPECT_EQ(0, receiver_->IncomingPacket(payload, kFrameSize, header));
+
+  // The mocked decoder prefers late decoding, so the frame is held back.
+  EXPECT_CALL(decoder_, Decode(_, _, _, _, _)).Times(0);
+  EXPECT_EQ(VCM_FRAME_NOT_READY, receiver_->Decode(0));
+
+  receiver_->SetIgnoreRenderTime(true);
+  EXPECT_CALL(decoder_, Decode(_, _, _, _, _)).Times(1);
+  EXPECT_EQ(0, receiver_->Decode(0));
+}
+
 TEST_F(TestVideoReceiver, ReceiverDelay) {
   EXPECT_EQ(0, receiver_->SetMinReceiverDelay(0));
   EXPECT_EQ(0, receiver_->SetMinReceiverDelay(5000));
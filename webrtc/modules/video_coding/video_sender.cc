@@ -20,6 +20,7 @@
 #include "webrtc/modules/video_coding/utility/quality_scaler.h"
 #include "webrtc/modules/video_coding/video_coding_impl.h"
 #include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/system_wrappers/include/metrics.h"
 
 namespace webrtc {
 namespace vcm {
@@ -35,6 +36,8 @@ VideoSender::VideoSender(Clock* clock,
       send_stats_callback_(send_stats_callback),
       _codecDataBase(encoder_rate_observer, &_encodedFrameCallback),
       frame_dropper_enabled_(true),
+      num_native_frames_(0),
+      num_native_frames_converted_(0),
       _sendStatsTimer(1000, clock_),
       current_codec_(),
       protection_callback_(nullptr),
@@ -48,7 +51,14 @@ VideoSender::VideoSender(Clock* clock,
   main_thread_.DetachFromThread();
 }
 
-VideoSender::~VideoSender() {}
+VideoSender::~VideoSender() {
+  rtc::CritScope lock(&encoder_crit_);
+  if (num_native_frames_ > 0) {
+    RTC_HISTOGRAM_PERCENTAGE(
+        "WebRTC.Video.NativeFramesConvertedToI420InPercent",
+        num_native_frames_converted_ * 100 / num_native_frames_);
+  }
+}
 
 void VideoSender::Process() {
   if (_sendStatsTimer.TimeUntilProcess() == 0) {
@@ -303,13 +313,17 @@ int32_t VideoSender::AddVideoFrame(const VideoFrame& videoFrame,
     return VCM_PARAMETER_ERROR;
   }
   VideoFrame converted_frame = videoFrame;
-  if (converted_frame.video_frame_buffer()->native_handle() &&
-      !_encoder->SupportsNativeHandle()) {
-    // This module only supports software encoding.
-    // TODO(pbos): Offload conversion from the encoder thread.
-    converted_frame = converted_frame.ConvertNativeToI420Frame();
-    RTC_CHECK(!converted_frame.IsZeroSize())
-        << "Frame conversion failed, won't be able to encode frame.";
+  if (converted_frame.video_frame_buffer()->native_handle()) {
+    // Hand native frames, e.g. textures or CVPixelBuffers, to encoders that can
+    // take them as they are, and only download them for the others.
+    ++num_native_frames_;
+    if (!_encoder->SupportsNativeHandle()) {
+      // TODO(pbos): Offload conversion from the encoder thread.
+      ++num_native_frames_converted_;
+      converted_frame = converted_frame.ConvertNativeToI420Frame();
+      RTC_CHECK(!converted_frame.IsZeroSize())
+          << "Frame conversion failed, won't be able to encode frame.";
+    }
   }
   int32_t ret =
       _encoder->Encode(converted_frame, codecSpecificInfo, next_frame_types);
@@ -21,6 +21,7 @@
 #include "webrtc/modules/video_coding/video_coding_impl.h"
 #include "webrtc/modules/video_coding/test/test_util.h"
 #include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/fake_texture_frame.h"
 #include "webrtc/test/frame_generator.h"
 #include "webrtc/test/testsupport/fileutils.h"
 
@@ -30,8 +31,10 @@ using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 using ::testing::Field;
 using ::testing::NiceMock;
+using ::testing::Not;
 using ::testing::Pointee;
 using ::testing::Return;
+using ::testing::Truly;
 using ::testing::FloatEq;
 using std::vector;
 using webrtc::test::FrameGenerator;
@@ -292,6 +295,32 @@ TEST_F(TestVideoSenderWithMockEncoder, TestIntraRequests) {
   AddFrame();
 }
 
+bool HasNativeHandle(const VideoFrame& frame) {
+  return frame.video_frame_buffer()->native_handle() != nullptr;
+}
+
+TEST_F(TestVideoSenderWithMockEncoder, NativeFramesPassedToSupportingEncoder) {
+  EXPECT_CALL(encoder_, SupportsNativeHandle()).WillRepeatedly(Return(true));
+  EXPECT_CALL(encoder_, Encode(Truly(HasNativeHandle), _, _))
+      .WillOnce(Return(0));
+  sender_->AddVideoFrame(
+      test::FakeNativeHandle::CreateFrame(new test::FakeNativeHandle(),
+                                          settings_.width, settings_.height, 0,
+                                          0, kVideoRotation_0),
+      nullptr);
+}
+
+TEST_F(TestVideoSenderWithMockEncoder, NativeFramesConvertedForOtherEncoders) {
+  EXPECT_CALL(encoder_, SupportsNativeHandle()).WillRepeatedly(Return(false));
+  EXPECT_CALL(encoder_, Encode(Not(Truly(HasNativeHandle)), _, _))
+      .WillOnce(Return(0));
+  sender_->AddVideoFrame(
+      test::FakeNativeHandle::CreateFrame(new test::FakeNativeHandle(),
+                                          settings_.width, settings_.height, 0,
+                                          0, kVideoRotation_0),
+      nullptr);
+}
+
 TEST_F(TestVideoSenderWithMockEncoder, TestSetRate) {
   const uint32_t new_bitrate = settings_.startBitrate + 300;
   EXPECT_CALL(encoder_, SetRates(new_bitrate, _)).Times(1).WillOnce(Return(0));
@@ -47,7 +47,8 @@ class VideoProcessing {
   virtual uint32_t GetDecimatedHeight() const = 0;
 
   // Set the spatial resampling settings of the VPM according to
-  // VideoFrameResampling.
+  // VideoFrameResampling. Defaults to kBox. kBiLinear and kFastRescaling use
+  // less CPU, at a lower quality when downscaling by large factors.
   virtual void SetInputFrameResampleMode(
       VideoFrameResampling resampling_mode) = 0;
 
@@ -12,8 +12,23 @@
 
 namespace webrtc {
 
+namespace {
+ScaleMethod ScaleMethodForMode(VideoFrameResampling resampling_mode) {
+  switch (resampling_mode) {
+    case kFastRescaling:
+      return kScalePoint;
+    case kBiLinear:
+      return kScaleBilinear;
+    case kNoRescaling:
+    case kBox:
+      break;
+  }
+  return kScaleBox;
+}
+}  // namespace
+
 VPMSimpleSpatialResampler::VPMSimpleSpatialResampler()
-    : resampling_mode_(kFastRescaling),
+    : resampling_mode_(kBox),
       target_width_(0),
       target_height_(0),
       scaler_() {}
@@ -40,7 +55,7 @@ void VPMSimpleSpatialResampler::SetInputFrameResampleMode(
 }
 
 void VPMSimpleSpatialResampler::Reset() {
-  resampling_mode_ = kFastRescaling;
+  resampling_mode_ = kBox;
   target_width_ = 0;
   target_height_ = 0;
 }
@@ -57,11 +72,10 @@ int32_t VPMSimpleSpatialResampler::ResampleFrame(const VideoFrame& inFrame,
   }
 
   // Setting scaler
-  // TODO(mikhal/marpan): Should we allow for setting the filter mode in
-  // _scale.Set() with |resampling_mode_|?
   int ret_val = 0;
   ret_val = scaler_.Set(inFrame.width(), inFrame.height(), target_width_,
-                        target_height_, kI420, kI420, kScaleBox);
+                        target_height_, kI420, kI420,
+                        ScaleMethodForMode(resampling_mode_));
   if (ret_val < 0)
     return ret_val;
 
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/random.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/video_processing/video_denoiser.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/video_frame.h"
+
+namespace webrtc {
+namespace {
+const int kNumInputFrames = 8;
+const int kNumIterations = 60;
+const int kNoiseAmplitude = 6;
+const int kMovingBlockSize = 128;
+
+// Creates a static textured scene with a moving square and some noise on
+// top, so that both the filtered and the copied block paths are exercised.
+std::vector<VideoFrame> CreateFrames(int width, int height) {
+  Random random(0x5678);
+  std::vector<VideoFrame> frames(kNumInputFrames);
+  const int half_width = (width + 1) / 2;
+  const int half_height = (height + 1) / 2;
+  for (int k = 0; k < kNumInputFrames; ++k) {
+    VideoFrame& frame = frames[k];
+    frame.CreateEmptyFrame(width, height, width, half_width, half_width);
+    uint8_t* y = frame.video_frame_buffer()->MutableDataY();
+    const int block_x = (k * 16) % (width - kMovingBlockSize);
+    const int block_y = height / 2 - kMovingBlockSize / 2;
+    for (int i = 0; i < height; ++i) {
+      for (int j = 0; j < width; ++j) {
+        int value = 64 + ((i / 32 + j / 32) % 2) * 96;
+        if (i >= block_y && i < block_y + kMovingBlockSize && j >= block_x &&
+            j < block_x + kMovingBlockSize) {
+          value = 230;
+        }
+        value += random.Rand(-kNoiseAmplitude, kNoiseAmplitude);
+        y[i * width + j] = static_cast<uint8_t>(
+            std::min(255, std::max(0, value)));
+      }
+    }
+    memset(frame.video_frame_buffer()->MutableDataU(), 128,
+           half_width * half_height);
+    memset(frame.video_frame_buffer()->MutableDataV(), 128,
+           half_width * half_height);
+  }
+  return frames;
+}
+
+// Returns the average time in microseconds to denoise a frame.
+int64_t MeasureDenoiseUs(bool runtime_cpu_detection,
+                         const std::vector<VideoFrame>& frames) {
+  VideoDenoiser denoiser(runtime_cpu_detection);
+  VideoFrame denoised_frames[2];
+  // The first frame only initializes the denoiser.
+  denoiser.DenoiseFrame(frames[0], &denoised_frames[0], &denoised_frames[1],
+                        true);
+
+  const int64_t start_us = rtc::TimeMicros();
+  for (int k = 0; k < kNumIterations; ++k) {
+    // Swap the buffers, as the frame preprocessor does.
+    VideoFrame* denoised = &denoised_frames[(k + 1) % 2];
+    VideoFrame* denoised_prev = &denoised_frames[k % 2];
+    denoiser.DenoiseFrame(frames[(k + 1) % frames.size()], denoised,
+                          denoised_prev, true);
+  }
+  return (rtc::TimeMicros() - start_us) / kNumIterations;
+}
+
+void RunBenchmark(int width, int height) {
+  const std::vector<VideoFrame> frames = CreateFrames(width, height);
+  const std::string modifier = "_" + rtc::ToString(height) + "p";
+  test::PrintResult("denoise_frame", modifier, "c",
+                    MeasureDenoiseUs(false, frames), "us", false);
+  test::PrintResult("denoise_frame", modifier, "selected",
+                    MeasureDenoiseUs(true, frames), "us", true);
+}
+}  // namespace
+
+TEST(DenoiserPerformanceTest, Denoise720p) {
+  RunBenchmark(1280, 720);
+}
+
+TEST(DenoiserPerformanceTest, Denoise1080p) {
+  RunBenchmark(1920, 1080);
+}
+
+}  // namespace webrtc
@@ -64,6 +64,23 @@ TEST_F(VideoProcessingTest, Variance) {
   EXPECT_EQ(var, df_sse_neon->Variance16x8(src, 16, dst, 16, &sse));
 }
 
+TEST_F(VideoProcessingTest, Sum8x8) {
+  std::unique_ptr<DenoiserFilter> df_c(DenoiserFilter::Create(false, nullptr));
+  std::unique_ptr<DenoiserFilter> df_sse_neon(
+      DenoiserFilter::Create(true, nullptr));
+  uint8_t src[16 * 16];
+  uint32_t sum = 0;
+  for (int i = 0; i < 16; ++i) {
+    for (int j = 0; j < 16; ++j) {
+      src[i * 16 + j] = 255 - i * 7 - j;
+      if (i >= 4 && i < 12 && j >= 4 && j < 12)
+        sum += src[i * 16 + j];
+    }
+  }
+  EXPECT_EQ(sum, df_c->Sum8x8(src + 4 * 16 + 4, 16));
+  EXPECT_EQ(sum, df_sse_neon->Sum8x8(src + 4 * 16 + 4, 16));
+}
+
 TEST_F(VideoProcessingTest, MbDenoise) {
   std::unique_ptr<DenoiserFilter> df_c(DenoiserFilter::Create(false, nullptr));
   std::unique_ptr<DenoiserFilter> df_sse_neon(
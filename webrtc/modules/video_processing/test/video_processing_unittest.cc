@@ -17,6 +17,7 @@
 
 #include "webrtc/base/timeutils.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
+#include "webrtc/test/frame_utils.h"
 #include "webrtc/test/testsupport/fileutils.h"
 
 namespace webrtc {
@@ -116,6 +117,33 @@ TEST_F(VideoProcessingTest, PreprocessorLogic) {
   EXPECT_TRUE(vp_->PreprocessFrame(video_frame_) != nullptr);
 }
 
+#if defined(WEBRTC_IOS)
+TEST_F(VideoProcessingTest, DISABLED_ResampleModeSelectsFilter) {
+#else
+TEST_F(VideoProcessingTest, ResampleModeSelectsFilter) {
+#endif
+  vp_->EnableTemporalDecimation(false);
+  std::unique_ptr<uint8_t[]> video_buffer(new uint8_t[frame_length_]);
+  ASSERT_EQ(frame_length_,
+            fread(video_buffer.get(), 1, frame_length_, source_file_));
+  EXPECT_EQ(0, ConvertToI420(kI420, video_buffer.get(), 0, 0, width_, height_,
+                             0, kVideoRotation_0, &video_frame_));
+  ASSERT_EQ(VPM_OK, vp_->SetTargetResolution(width_ / 3, height_ / 3, 30));
+
+  vp_->SetInputFrameResampleMode(kBox);
+  const VideoFrame* out_frame = vp_->PreprocessFrame(video_frame_);
+  ASSERT_TRUE(out_frame != nullptr);
+  VideoFrame box_frame;
+  box_frame.CopyFrame(*out_frame);
+
+  vp_->SetInputFrameResampleMode(kFastRescaling);
+  out_frame = vp_->PreprocessFrame(video_frame_);
+  ASSERT_TRUE(out_frame != nullptr);
+  EXPECT_EQ(box_frame.width(), out_frame->width());
+  EXPECT_EQ(box_frame.height(), out_frame->height());
+  EXPECT_FALSE(test::FramesEqual(box_frame, *out_frame));
+}
+
 #if defined(WEBRTC_IOS)
 TEST_F(VideoProcessingTest, DISABLED_Resampler) {
 #else
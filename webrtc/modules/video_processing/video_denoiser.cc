@@ -218,10 +218,10 @@ void VideoDenoiser::CopyLumaOnMargin(const uint8_t* y_src, uint8_t* y_dst) {
   if ((mb_cols_ << 4) != width_) {
     const uint8_t* margin_y_src = y_src + (mb_cols_ << 4);
     uint8_t* margin_y_dst = y_dst + (mb_cols_ << 4);
+    const int margin_width = width_ - (mb_cols_ << 4);
     for (int i = 0; i < height_; ++i) {
-      for (int j = mb_cols_ << 4; j < width_; ++j) {
-        margin_y_dst[i * stride_y_ + j] = margin_y_src[i * stride_y_ + j];
-      }
+      memcpy(margin_y_dst + i * stride_y_, margin_y_src + i * stride_y_,
+             margin_width);
     }
   }
 }
@@ -270,15 +270,10 @@ void VideoDenoiser::DenoiseFrame(const VideoFrame& frame,
       uint8_t* mb_dst = mb_dst_base + offset_col;
       uint8_t* mb_dst_prev = mb_dst_prev_base + offset_col;
 
-      // TODO(jackychen): Need SSE2/NEON opt.
+      // Sum of the center 8x8 pixels of the block.
       int luma = 0;
-      if (ne_enable) {
-        for (int i = 4; i < 12; ++i) {
-          for (int j = 4; j < 12; ++j) {
-            luma += mb_src[i * stride_y_ + j];
-          }
-        }
-      }
+      if (ne_enable)
+        luma = filter_->Sum8x8(mb_src + 4 * stride_y_ + 4, stride_y_);
 
       // Get the filtered block and filter_decision.
       mb_filter_decision_[mb_index] =
@@ -334,7 +329,6 @@ void VideoDenoiser::DenoiseFrame(const VideoFrame& frame,
   if ((mb_rows_ << 4) != height_ || (mb_cols_ << 4) != width_)
     CopyLumaOnMargin(y_src, y_dst);
 
-  // TODO(jackychen): Need SSE2/NEON opt.
   // Copy u/v planes.
   memcpy(u_dst, u_src, (height_ >> 1) * stride_u_);
   memcpy(v_dst, v_src, (height_ >> 1) * stride_v_);
@@ -16,6 +16,7 @@
 #include "webrtc/modules/video_processing/util/denoiser_filter.h"
 #include "webrtc/modules/video_processing/util/noise_estimation.h"
 #include "webrtc/modules/video_processing/util/skin_detection.h"
+#include "webrtc/video_frame.h"
 
 namespace webrtc {
 
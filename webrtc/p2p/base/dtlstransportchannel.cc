@@ -21,6 +21,7 @@
 #include "webrtc/base/sslstreamadapter.h"
 #include "webrtc/base/stream.h"
 #include "webrtc/base/thread.h"
+#include "webrtc/base/timeutils.h"
 
 namespace cricket {
 
@@ -282,6 +283,8 @@ bool DtlsTransportChannelWrapper::SetupDtls() {
   dtls_->SetIdentity(local_certificate_->identity()->GetReference());
   dtls_->SetMode(rtc::SSL_MODE_DTLS);
   dtls_->SetMaxProtocolVersion(ssl_max_version_);
+  if (session_resumption_enabled_)
+    dtls_->SetSessionResumptionEnabled(true);
   dtls_->SetServerRole(ssl_role_);
   dtls_->SignalEvent.connect(this, &DtlsTransportChannelWrapper::OnDtlsEvent);
   if (!dtls_->SetPeerCertificateDigest(
@@ -549,7 +552,10 @@ void DtlsTransportChannelWrapper::OnDtlsEvent(rtc::StreamInterface* dtls,
   ASSERT(dtls == dtls_.get());
   if (sig & rtc::SE_OPEN) {
     // This is the first time.
-    LOG_J(LS_INFO, this) << "DTLS handshake complete.";
+    dtls_handshake_duration_ms_ = rtc::TimeMillis() - dtls_handshake_start_ms_;
+    LOG_J(LS_INFO, this) << "DTLS handshake complete in "
+                         << dtls_handshake_duration_ms_ << " ms"
+                         << (dtls_->IsResumedSession() ? " (resumed)." : ".");
     if (dtls_->GetState() == rtc::SS_OPEN) {
       // The check for OPEN shouldn't be necessary but let's make
       // sure we don't accidentally frob the state if it's closed.
@@ -586,6 +592,7 @@ bool DtlsTransportChannelWrapper::MaybeStartDtls() {
     }
     LOG_J(LS_INFO, this)
       << "DtlsTransportChannelWrapper: Started DTLS handshake";
+    dtls_handshake_start_ms_ = rtc::TimeMillis();
     set_dtls_state(DTLS_TRANSPORT_CONNECTING);
     // Now that the handshake has started, we can process a cached ClientHello
     // (if one exists).
@@ -122,6 +122,13 @@ class DtlsTransportChannelWrapper : public TransportChannelImpl {
 
   virtual bool SetSslMaxProtocolVersion(rtc::SSLProtocolVersion version);
 
+  // Lets a later handshake between the same certificates resume the session
+  // instead of doing a full key exchange. Off by default. Must be set on both
+  // ends before DTLS is set up.
+  void SetSessionResumptionEnabled(bool enabled) {
+    session_resumption_enabled_ = enabled;
+  }
+
   // Set up the ciphers to use for DTLS-SRTP. If this method is not called
   // before DTLS starts, or |ciphers| is empty, SRTP keys won't be negotiated.
   // This method should be called before SetupDtls.
@@ -198,6 +205,11 @@ class DtlsTransportChannelWrapper : public TransportChannelImpl {
   // Needed by DtlsTransport.
   TransportChannelImpl* channel() { return channel_; }
 
+  // How long the last DTLS handshake took to complete, or -1 if none has.
+  int64_t dtls_handshake_duration_ms() const {
+    return dtls_handshake_duration_ms_;
+  }
+
  private:
   void OnReadableState(TransportChannel* channel);
   void OnWritableState(TransportChannel* channel);
@@ -243,6 +255,10 @@ class DtlsTransportChannelWrapper : public TransportChannelImpl {
   // received.
   rtc::Buffer cached_client_hello_;
 
+  bool session_resumption_enabled_ = false;
+  int64_t dtls_handshake_start_ms_ = -1;
+  int64_t dtls_handshake_duration_ms_ = -1;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(DtlsTransportChannelWrapper);
 };
 
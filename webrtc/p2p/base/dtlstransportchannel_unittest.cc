@@ -223,6 +223,10 @@ class DtlsTestClient : public sigslot::has_slots<> {
     return true;
   }
 
+  int64_t dtls_handshake_duration_ms(size_t channel) const {
+    return channels_[channel]->dtls_handshake_duration_ms();
+  }
+
   int received_dtls_client_hellos() const {
     return received_dtls_client_hellos_;
   }
@@ -629,6 +633,15 @@ TEST_F(DtlsTransportChannelTest, TestTransferDtls) {
   TestTransfer(0, 1000, 100, false);
 }
 
+// Connect with DTLS, and check that both ends timed the handshake.
+TEST_F(DtlsTransportChannelTest, TestDtlsHandshakeDuration) {
+  MAYBE_SKIP_TEST(HaveDtls);
+  PrepareDtls(true, true, rtc::KT_DEFAULT);
+  ASSERT_TRUE(Connect());
+  EXPECT_GE(client1_.dtls_handshake_duration_ms(0), 0);
+  EXPECT_GE(client2_.dtls_handshake_duration_ms(0), 0);
+}
+
 // Create two channels with DTLS, and transfer some data.
 TEST_F(DtlsTransportChannelTest, TestTransferDtlsTwoChannels) {
   MAYBE_SKIP_TEST(HaveDtls);
@@ -168,6 +168,31 @@ class ConnectionCompare {
   }
 };
 
+// Stably sorts |connections| into the same order std::stable_sort would.
+// Between two sorts usually only a handful of connections change state, so the
+// list is still made of a few ascending runs. Those are merged in place, each
+// merge being linear, and only a badly shuffled list is sorted from scratch.
+void SortConnectionsIncrementally(
+    std::vector<cricket::Connection*>* connections) {
+  // Beyond this many runs a full sort is cheaper than repeated merges.
+  static const int kMaxRunsToMerge = 8;
+  ConnectionCompare cmp;
+  auto begin = connections->begin();
+  auto end = connections->end();
+  auto sorted_end = std::is_sorted_until(begin, end, cmp);
+  for (int runs = 1; sorted_end != end; ++runs) {
+    if (runs > kMaxRunsToMerge) {
+      // Merging preserved the order of equal elements, so this still yields
+      // the order a single stable sort of the original list would have.
+      std::stable_sort(begin, end, cmp);
+      return;
+    }
+    auto run_end = std::is_sorted_until(sorted_end, end, cmp);
+    std::inplace_merge(begin, sorted_end, run_end, cmp);
+    sorted_end = run_end;
+  }
+}
+
 // Determines whether we should switch between two connections, based first on
 // connection states, static preferences, and then (if those are equal) on
 // latency estimates.
@@ -473,6 +498,8 @@ void P2PTransportChannel::MaybeStartGathering() {
       gathering_state_ = kIceGatheringGathering;
       SignalGatheringState(this);
     }
+    gathering_start_ms_ = rtc::TimeMillis();
+    connected_delay_ms_ = -1;
     // Time for a new allocator.
     std::unique_ptr<PortAllocatorSession> pooled_session =
         allocator_->TakePooledSession(transport_name(), component(), ice_ufrag_,
@@ -1101,8 +1128,7 @@ void P2PTransportChannel::SortConnections() {
   // that amongst equal preference, writable connections, this will choose the
   // one whose estimated latency is lowest.  So it is the only one that we
   // need to consider switching to.
-  ConnectionCompare cmp;
-  std::stable_sort(connections_.begin(), connections_.end(), cmp);
+  SortConnectionsIncrementally(&connections_);
   LOG(LS_VERBOSE) << "Sorting " << connections_.size()
                   << " available connections:";
   for (size_t i = 0; i < connections_.size(); ++i) {
@@ -1233,6 +1259,11 @@ void P2PTransportChannel::UpdateState() {
 
   bool writable = best_connection_ && best_connection_->writable();
   set_writable(writable);
+  if (writable && connected_delay_ms_ < 0) {
+    connected_delay_ms_ = rtc::TimeMillis() - gathering_start_ms_;
+    LOG_J(LS_INFO, this) << "Became writable " << connected_delay_ms_
+                         << " ms after gathering started.";
+  }
 
   bool receiving = false;
   for (const Connection* connection : connections_) {
@@ -1538,7 +1569,9 @@ void P2PTransportChannel::OnReadPacket(Connection* connection,
   ASSERT(worker_thread_ == rtc::Thread::Current());
 
   // Do not deliver, if packet doesn't belong to the correct transport channel.
-  if (!FindConnection(connection))
+  // Nearly all packets arrive on the best connection, so skip the linear
+  // search over |connections_| for it.
+  if (connection != best_connection_ && !FindConnection(connection))
     return;
 
   // Let the client know of an incoming packet
@@ -1622,8 +1655,11 @@ Connection* P2PTransportChannel::FindConnectionToPing(int64_t now) {
     return conn_to_ping;
   }
 
-  for (Connection* conn : unpinged_connections_) {
-    if (!IsPingable(conn, now)) {
+  // Walk the connections in sorted order so that, among equally pingable ones,
+  // the first is kept without having to look up where each one is ranked.
+  for (Connection* conn : connections_) {
+    if (unpinged_connections_.find(conn) == unpinged_connections_.end() ||
+        !IsPingable(conn, now)) {
       continue;
     }
     if (!conn_to_ping ||
@@ -1647,7 +1683,7 @@ Connection* P2PTransportChannel::MostLikelyToWork(Connection* conn1,
     bool udp2 = IsUdp(conn2);
     if (udp1 && !udp2) {
       return conn1;
-    } else if (udp2 && udp1) {
+    } else if (udp2 && !udp1) {
       return conn2;
     }
   }
@@ -1682,11 +1718,8 @@ Connection* P2PTransportChannel::SelectMostPingableConnection(
   }
 
   // During the initial state when nothing has been pinged yet, return the first
-  // one in the ordered |connections_|.
-  return *(std::find_if(connections_.begin(), connections_.end(),
-                        [conn1, conn2](Connection* conn) {
-                          return conn == conn1 || conn == conn2;
-                        }));
+  // one in the ordered |connections_|, which the caller passes as |conn1|.
+  return conn1;
 }
 
 }  // namespace cricket
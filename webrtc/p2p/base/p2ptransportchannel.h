@@ -96,6 +96,9 @@ class P2PTransportChannel : public TransportChannelImpl,
   IceGatheringState gathering_state() const override {
     return gathering_state_;
   }
+  // Milliseconds from the latest start of gathering until the channel first
+  // became writable, or -1 if it has not become writable since.
+  int64_t connected_delay_ms() const { return connected_delay_ms_; }
   void AddRemoteCandidate(const Candidate& candidate) override;
   void RemoveRemoteCandidate(const Candidate& candidate) override;
   // Sets the parameters in IceConfig. We do not set them blindly. Instead, we
@@ -265,7 +268,7 @@ class P2PTransportChannel : public TransportChannelImpl,
   Connection* FindConnectionToPing(int64_t now);
   Connection* FindOldestConnectionNeedingTriggeredCheck(int64_t now);
   // Between |conn1| and |conn2|, this function returns the one which should
-  // be pinged first.
+  // be pinged first. |conn1| must precede |conn2| in |connections_|.
   Connection* SelectMostPingableConnection(Connection* conn1,
                                            Connection* conn2);
   // Select the connection which is Relay/Relay. If both of them are,
@@ -328,6 +331,8 @@ class P2PTransportChannel : public TransportChannelImpl,
 
   int check_receiving_interval_;
   int64_t last_ping_sent_ms_ = 0;
+  int64_t gathering_start_ms_ = 0;
+  int64_t connected_delay_ms_ = -1;
   int weak_ping_interval_ = WEAK_PING_INTERVAL;
   TransportChannelState state_ = TransportChannelState::STATE_INIT;
   IceConfig config_;
@@ -340,6 +340,12 @@ class Port : public PortInterface, public rtc::MessageHandler,
   // Checks if the address in addr is compatible with the port's ip.
   bool IsCompatibleAddress(const rtc::SocketAddress& addr);
 
+  // Returns the MESSAGE-INTEGRITY key for the current ICE password.
+  const StunMessageIntegrityKey& password_key() {
+    password_key_.SetPassword(password_);
+    return password_key_;
+  }
+
   // Returns default DSCP value.
   rtc::DiffServCodePoint DefaultDscpValue() const {
     // No change from what MediaChannel set.
@@ -382,6 +388,8 @@ class Port : public PortInterface, public rtc::MessageHandler,
   // username_fragment().
   std::string ice_username_fragment_;
   std::string password_;
+  // Derived from |password_| when it is first used after a change.
+  StunMessageIntegrityKey password_key_;
   std::vector<Candidate> candidates_;
   AddressMap connections_;
   int timeout_delay_;
@@ -609,9 +617,17 @@ class Connection : public CandidatePairInterface,
 
   void OnMessage(rtc::Message *pmsg);
 
+  // Returns the MESSAGE-INTEGRITY key for the remote candidate's password,
+  // which signs our pings and validates the responses to them.
+  const StunMessageIntegrityKey& remote_password_key() {
+    remote_password_key_.SetPassword(remote_candidate_.password());
+    return remote_password_key_;
+  }
+
   Port* port_;
   size_t local_candidate_index_;
   Candidate remote_candidate_;
+  StunMessageIntegrityKey remote_password_key_;
   WriteState write_state_;
   bool receiving_;
   bool connected_;
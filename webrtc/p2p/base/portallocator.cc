@@ -56,10 +56,7 @@ void PortAllocator::SetConfiguration(
   // If |size| is greater than the number of allocated sessions, create new
   // sessions.
   while (allocated_pooled_session_count_ < candidate_pool_size) {
-    PortAllocatorSession* pooled_session = CreateSessionInternal("", 0, "", "");
-    pooled_session->StartGettingPorts();
-    pooled_sessions_.push_back(
-        std::unique_ptr<PortAllocatorSession>(pooled_session));
+    AddPooledSession();
     ++allocated_pooled_session_count_;
   }
   target_pooled_session_count_ = candidate_pool_size;
@@ -94,6 +91,11 @@ std::unique_ptr<PortAllocatorSession> PortAllocator::TakePooledSession(
   // it's taken out of the pool.
   ret->SetCandidateFilter(candidate_filter());
   pooled_sessions_.pop_front();
+  // The replacement takes the place of the taken session in the count of
+  // allocated sessions.
+  if (refill_candidate_pool_) {
+    AddPooledSession();
+  }
   return ret;
 }
 
@@ -104,4 +106,11 @@ const PortAllocatorSession* PortAllocator::GetPooledSession() const {
   return pooled_sessions_.front().get();
 }
 
+void PortAllocator::AddPooledSession() {
+  PortAllocatorSession* pooled_session = CreateSessionInternal("", 0, "", "");
+  pooled_session->StartGettingPorts();
+  pooled_sessions_.push_back(
+      std::unique_ptr<PortAllocatorSession>(pooled_session));
+}
+
 }  // namespace cricket
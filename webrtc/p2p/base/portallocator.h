@@ -60,6 +60,10 @@ enum {
   // Disallow use of UDP when connecting to a relay server. Since proxy servers
   // usually don't handle UDP, using UDP will leak the IP address.
   PORTALLOCATOR_DISABLE_UDP_RELAY = 0x1000,
+  // Run the allocation phases back to back instead of one per step delay, so
+  // that UDP, relay and TCP candidates are gathered concurrently on every
+  // network. Higher preference networks start gathering first.
+  PORTALLOCATOR_ENABLE_CONCURRENT_GATHERING = 0x2000,
 };
 
 const uint32_t kDefaultPortAllocatorFlags = 0;
@@ -246,6 +250,14 @@ class PortAllocator : public sigslot::has_slots<> {
 
   int candidate_pool_size() const { return target_pooled_session_count_; }
 
+  // If set, a pooled session is gathered to replace every one that's taken,
+  // so that ICE restarts after the first also find a session with warm
+  // sockets and TURN allocations rather than gathering from scratch.
+  bool refill_candidate_pool() const { return refill_candidate_pool_; }
+  void set_refill_candidate_pool(bool refill) {
+    refill_candidate_pool_ = refill;
+  }
+
   // Sets the network types to ignore.
   // Values are defined by the AdapterType enum.
   // For instance, calling this with
@@ -264,7 +276,8 @@ class PortAllocator : public sigslot::has_slots<> {
   //
   // Caller takes ownership of the returned session.
   //
-  // If no pooled sessions are available, returns null.
+  // If no pooled sessions are available, returns null. If the candidate pool
+  // is refilled, a new pooled session starts gathering in its place.
   std::unique_ptr<PortAllocatorSession> TakePooledSession(
       const std::string& content_name,
       int component,
@@ -332,6 +345,9 @@ class PortAllocator : public sigslot::has_slots<> {
   std::string origin_;
 
  private:
+  // Creates a session that starts gathering and adds it to the pool.
+  void AddPooledSession();
+
   ServerAddresses stun_servers_;
   std::vector<RelayServerConfig> turn_servers_;
   // The last size passed into SetConfiguration.
@@ -339,6 +355,7 @@ class PortAllocator : public sigslot::has_slots<> {
   // This variable represents the total number of pooled sessions
   // both owned by this class and taken by TakePooledSession.
   int allocated_pooled_session_count_ = 0;
+  bool refill_candidate_pool_ = false;
   std::deque<std::unique_ptr<PortAllocatorSession>> pooled_sessions_;
 };
 
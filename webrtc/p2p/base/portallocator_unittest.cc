@@ -176,6 +176,25 @@ TEST_F(PortAllocatorTest, SetConfigurationDoesntCreateExtraSessions) {
   EXPECT_EQ(0, GetAllPooledSessionsReturnCount());
 }
 
+// Test that a refilled pool replaces each session that's taken, and that the
+// replacements don't count towards the pool size.
+TEST_F(PortAllocatorTest, TakePooledSessionRefillsPool) {
+  allocator_->set_refill_candidate_pool(true);
+  SetConfigurationWithPoolSize(1);
+  auto session_1 = TakePooledSession();
+  ASSERT_NE(nullptr, session_1.get());
+  const cricket::FakePortAllocatorSession* refill = GetPooledSession();
+  ASSERT_NE(nullptr, refill);
+  EXPECT_TRUE(refill->pooled());
+  auto session_2 = TakePooledSession();
+  EXPECT_EQ(refill, session_2.get());
+  EXPECT_NE(nullptr, GetPooledSession());
+
+  allocator_->set_refill_candidate_pool(false);
+  SetConfigurationWithPoolSize(0);
+  EXPECT_EQ(0, GetAllPooledSessionsReturnCount());
+}
+
 // According to JSEP, exising pooled sessions should be destroyed and new
 // ones created when the ICE servers change.
 TEST_F(PortAllocatorTest,
@@ -10,6 +10,7 @@
 
 #include "webrtc/p2p/base/pseudotcp.h"
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -72,8 +73,11 @@ const uint32_t UDP_HEADER_SIZE = 8;
 const uint32_t JINGLE_HEADER_SIZE = 64;  // when relay framing is in use
 
 // Default size for receive and send buffer.
-const uint32_t DEFAULT_RCV_BUF_SIZE = 60 * 1024;
-const uint32_t DEFAULT_SND_BUF_SIZE = 90 * 1024;
+const uint32_t DEFAULT_RCV_BUF_SIZE = 256 * 1024;
+const uint32_t DEFAULT_SND_BUF_SIZE = 384 * 1024;
+// Receive buffer size used when the window can't be scaled, so that it fits
+// the 16-bit window field.
+const uint32_t UNSCALED_RCV_BUF_SIZE = 60 * 1024;
 
 //////////////////////////////////////////////////////////////////////
 // Global Constants and Functions
@@ -99,6 +103,9 @@ const uint32_t DEFAULT_SND_BUF_SIZE = 90 * 1024;
 // 24 |                             data                              |
 //    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 //
+// Once SACK is negotiated, the Control byte of a pure ACK holds the number of
+// SACK blocks that follow the header, each a 32-bit left and right edge.
+//
 //////////////////////////////////////////////////////////////////////
 
 #define PSEUDO_KEEPALIVE 0
@@ -123,6 +130,16 @@ const uint8_t TCP_OPT_EOL = 0;        // End of list.
 const uint8_t TCP_OPT_NOOP = 1;       // No-op.
 const uint8_t TCP_OPT_MSS = 2;        // Maximum segment size.
 const uint8_t TCP_OPT_WND_SCALE = 3;  // Window scale factor.
+const uint8_t TCP_OPT_SACK_PERMITTED = 4;  // Selective ACKs are understood.
+
+const uint8_t MAX_SACK_BLOCKS = 4;
+const uint32_t SACK_BLOCK_SIZE = 8;
+
+// CUBIC multiplicative decrease and scaling constant (RFC 8312, Sec 5).
+const double CUBIC_BETA = 0.7;
+const double CUBIC_C = 0.4;
+// Growth of the Reno-equivalent window, in segments per RTT.
+const double CUBIC_RENO_GAIN = 3 * (1 - CUBIC_BETA) / (1 + CUBIC_BETA);
 
 const long DEFAULT_TIMEOUT = 4000; // If there are no pending clocks, wake up every 4 seconds
 const long CLOSED_TIMEOUT = 60 * 1000; // If the connection is closed, once per minute
@@ -224,8 +241,9 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
 
   m_state = TCP_LISTEN;
   m_conv = conv;
-  m_rcv_wnd = m_rbuf_len;
-  m_rwnd_scale = m_swnd_scale = 0;
+  m_swnd_scale = 0;
+  // Picks the window scale factor the default buffer needs.
+  resizeReceiveBuffer(m_rbuf_len);
   m_snd_nxt = 0;
   m_snd_wnd = 1;
   m_snd_una = m_rcv_nxt = 0;
@@ -249,6 +267,13 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
   m_dup_acks = 0;
   m_recover = 0;
 
+  m_support_sack = true;
+  m_sack_enabled = false;
+  m_sack_high = m_rexmit_nxt = 0;
+
+  m_cc = CC_NEWRENO;
+  m_cubic_wmax = m_cubic_epoch = m_cubic_k = m_cubic_west = 0;
+
   m_ts_recent = m_ts_lastack = 0;
 
   m_rx_rto = DEF_RTO;
@@ -307,9 +332,7 @@ void PseudoTcp::NotifyClock(uint32_t now) {
         return;
       }
 
-      uint32_t nInFlight = m_snd_nxt - m_snd_una;
-      m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
-      //LOG(LS_INFO) << "m_ssthresh: " << m_ssthresh << "  nInFlight: " << nInFlight << "  m_mss: " << m_mss;
+      onLoss();
       m_cwnd = m_mss;
 
       // Back off retransmit timer.  Note: the limit is lower when connecting.
@@ -377,6 +400,10 @@ void PseudoTcp::GetOption(Option opt, int* value) {
     *value = m_sbuf_len;
   } else if (opt == OPT_RCVBUF) {
     *value = m_rbuf_len;
+  } else if (opt == OPT_SACK) {
+    *value = m_support_sack ? 1 : 0;
+  } else if (opt == OPT_CONGESTION_CONTROL) {
+    *value = m_cc;
   } else {
     ASSERT(false);
   }
@@ -392,6 +419,12 @@ void PseudoTcp::SetOption(Option opt, int value) {
   } else if (opt == OPT_RCVBUF) {
     ASSERT(m_state == TCP_LISTEN);
     resizeReceiveBuffer(value);
+  } else if (opt == OPT_SACK) {
+    ASSERT(m_state == TCP_LISTEN);
+    m_support_sack = value != 0;
+  } else if (opt == OPT_CONGESTION_CONTROL) {
+    ASSERT(value == CC_NEWRENO || value == CC_CUBIC);
+    m_cc = static_cast<CongestionControl>(value);
   } else {
     ASSERT(false);
   }
@@ -442,7 +475,8 @@ int PseudoTcp::Recv(char* buffer, size_t len) {
   if (uint32_t(available_space) - m_rcv_wnd >=
       std::min<uint32_t>(m_rbuf_len / 2, m_mss)) {
     // TODO(jbeda): !?! Not sure about this was closed business
-    bool bWasClosed = (m_rcv_wnd == 0);
+    // A window smaller than the scale unit was advertised as zero too.
+    bool bWasClosed = ((m_rcv_wnd >> m_rwnd_scale) == 0);
     m_rcv_wnd = static_cast<uint32_t>(available_space);
 
     if (bWasClosed) {
@@ -524,7 +558,12 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
   long_to_bytes(m_conv, buffer.get());
   long_to_bytes(seq, buffer.get() + 4);
   long_to_bytes(m_rcv_nxt, buffer.get() + 8);
-  buffer[12] = 0;
+  // Only pure ACKs carry SACK blocks, so data segments stay within the MSS.
+  uint8_t sack_blocks = 0;
+  if (m_sack_enabled && len == 0) {
+    sack_blocks = writeSackBlocks(buffer.get() + HEADER_SIZE);
+  }
+  buffer[12] = sack_blocks;
   buffer[13] = flags;
   short_to_bytes(static_cast<uint16_t>(m_rcv_wnd >> m_rwnd_scale),
                  buffer.get() + 14);
@@ -555,7 +594,8 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
 #endif // _DEBUGMSG
 
   IPseudoTcpNotify::WriteResult wres = m_notify->TcpWritePacket(
-      this, reinterpret_cast<char *>(buffer.get()), len + HEADER_SIZE);
+      this, reinterpret_cast<char *>(buffer.get()),
+      len + HEADER_SIZE + sack_blocks * SACK_BLOCK_SIZE);
   // Note: When len is 0, this is an ACK packet.  We don't read the return value for those,
   // and thus we won't retry.  So go ahead and treat the packet as a success (basically simulate
   // as if it were dropped), which will prevent our timers from being messed up.
@@ -586,8 +626,15 @@ bool PseudoTcp::parse(const uint8_t* buffer, uint32_t size) {
   seg.tsval = bytes_to_long(buffer + 16);
   seg.tsecr = bytes_to_long(buffer + 20);
 
-  seg.data = reinterpret_cast<const char *>(buffer) + HEADER_SIZE;
-  seg.len = size - HEADER_SIZE;
+  seg.sack = buffer + HEADER_SIZE;
+  seg.sack_blocks = buffer[12];
+  uint32_t sack_size = seg.sack_blocks * SACK_BLOCK_SIZE;
+  if (size < HEADER_SIZE + sack_size) {
+    return false;
+  }
+
+  seg.data = reinterpret_cast<const char *>(buffer) + HEADER_SIZE + sack_size;
+  seg.len = size - HEADER_SIZE - sack_size;
 
 #if _DEBUGMSG >= _DBG_VERBOSE
   LOG(LS_INFO) << "--> <CONV=" << seg.conv
@@ -709,6 +756,10 @@ bool PseudoTcp::process(Segment& seg) {
     m_ts_recent = seg.tsval;
   }
 
+  if (m_sack_enabled && seg.sack_blocks) {
+    applySackBlocks(seg.sack, seg.sack_blocks);
+  }
+
   // Check if this is a valuable ack
   if ((seg.ack > m_snd_una) && (seg.ack <= m_snd_nxt)) {
     // Calculate round-trip time
@@ -774,20 +825,23 @@ bool PseudoTcp::process(Segment& seg) {
 #if _DEBUGMSG >= _DBG_NORMAL
         LOG(LS_INFO) << "recovery retransmit";
 #endif // _DEBUGMSG
-        if (!transmit(m_slist.begin(), now)) {
+        // With SACK the new first hole may already have been resent.
+        bool bResent = m_sack_enabled &&
+                       m_slist.front().seq < m_rexmit_nxt;
+        if (bResent ? !retransmitNextHole(now)
+                    : !transmit(m_slist.begin(), now)) {
           closedown(ECONNABORTED);
           return false;
         }
+        if (!bResent) {
+          m_rexmit_nxt = std::max(
+              m_rexmit_nxt, m_slist.front().seq + m_slist.front().len);
+        }
         m_cwnd += m_mss - std::min(nAcked, m_cwnd);
       }
     } else {
       m_dup_acks = 0;
-      // Slow start, congestion avoidance
-      if (m_cwnd < m_ssthresh) {
-        m_cwnd += m_mss;
-      } else {
-        m_cwnd += std::max<uint32_t>(1, m_mss * m_mss / m_cwnd);
-      }
+      growCongestionWindow(nAcked, now);
     }
   } else if (seg.ack == m_snd_una) {
     // !?! Note, tcp says don't do this... but otherwise how does a closed window become open?
@@ -808,12 +862,17 @@ bool PseudoTcp::process(Segment& seg) {
           return false;
         }
         m_recover = m_snd_nxt;
-        uint32_t nInFlight = m_snd_nxt - m_snd_una;
-        m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
-        //LOG(LS_INFO) << "m_ssthresh: " << m_ssthresh << "  nInFlight: " << nInFlight << "  m_mss: " << m_mss;
+        m_rexmit_nxt = m_slist.front().seq + m_slist.front().len;
+        onLoss();
         m_cwnd = m_ssthresh + 3 * m_mss;
       } else if (m_dup_acks > 3) {
         m_cwnd += m_mss;
+        // Each further duplicate ACK means a segment has left the network,
+        // which makes room to resend the next hole the peer reported.
+        if (m_sack_enabled && !retransmitNextHole(now)) {
+          closedown(ECONNABORTED);
+          return false;
+        }
       }
     } else {
       m_dup_acks = 0;
@@ -1169,6 +1228,114 @@ PseudoTcp::disableWindowScale() {
   m_support_wnd_scale = false;
 }
 
+uint8_t PseudoTcp::writeSackBlocks(uint8_t* buffer) {
+  uint8_t count = 0;
+  RList::const_iterator it = m_rlist.begin();
+  while (it != m_rlist.end() && count < MAX_SACK_BLOCKS) {
+    uint32_t left = it->seq;
+    uint32_t right = it->seq + it->len;
+    // Saved segments that touch or overlap are reported as one block.
+    for (++it; it != m_rlist.end() && it->seq <= right; ++it) {
+      right = std::max(right, it->seq + it->len);
+    }
+    long_to_bytes(left, buffer + count * SACK_BLOCK_SIZE);
+    long_to_bytes(right, buffer + count * SACK_BLOCK_SIZE + 4);
+    ++count;
+  }
+  return count;
+}
+
+void PseudoTcp::applySackBlocks(const uint8_t* data, uint8_t count) {
+  for (uint8_t i = 0; i < count; ++i) {
+    uint32_t left = bytes_to_long(data + i * SACK_BLOCK_SIZE);
+    uint32_t right = bytes_to_long(data + i * SACK_BLOCK_SIZE + 4);
+    if ((left >= right) || (left < m_snd_una) || (right > m_snd_nxt)) {
+      continue;  // Stale or bogus.
+    }
+    m_sack_high = std::max(m_sack_high, right);
+    for (SSegment& sseg : m_slist) {
+      if (sseg.seq >= right) {
+        break;
+      }
+      if ((sseg.seq >= left) && (sseg.seq + sseg.len <= right)) {
+        sseg.bSacked = true;
+      }
+    }
+  }
+}
+
+bool PseudoTcp::retransmitNextHole(uint32_t now) {
+  for (SList::iterator it = m_slist.begin(); it != m_slist.end(); ++it) {
+    if ((it->xmit == 0) || (it->seq >= m_sack_high)) {
+      break;
+    }
+    if (it->bSacked || (it->seq < m_rexmit_nxt)) {
+      continue;
+    }
+#if _DEBUGMSG >= _DBG_NORMAL
+    LOG(LS_INFO) << "sack retransmit " << it->seq;
+#endif // _DEBUGMSG
+    m_rexmit_nxt = it->seq + it->len;
+    return transmit(it, now);
+  }
+  return true;
+}
+
+void PseudoTcp::onLoss() {
+  uint32_t nInFlight = m_snd_nxt - m_snd_una;
+  if (m_cc == CC_CUBIC) {
+    // Fast convergence: if the window never got back to its previous size,
+    // leave more room for other flows.
+    m_cubic_wmax = (m_cwnd < m_cubic_wmax)
+                       ? static_cast<uint32_t>(m_cwnd * (1 + CUBIC_BETA) / 2)
+                       : m_cwnd;
+    m_cubic_epoch = 0;
+    m_ssthresh = std::max(static_cast<uint32_t>(nInFlight * CUBIC_BETA),
+                          2 * m_mss);
+  } else {
+    m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
+  }
+}
+
+void PseudoTcp::growCongestionWindow(uint32_t nAcked, uint32_t now) {
+  // Slow start, congestion avoidance
+  if (m_cwnd < m_ssthresh) {
+    m_cwnd += m_mss;
+    return;
+  }
+  if (m_cc != CC_CUBIC) {
+    m_cwnd += std::max<uint32_t>(1, m_mss * m_mss / m_cwnd);
+    return;
+  }
+
+  if (m_cubic_epoch == 0) {
+    m_cubic_epoch = now;
+    m_cubic_west = m_cwnd;
+    if (m_cwnd < m_cubic_wmax) {
+      m_cubic_k = static_cast<uint32_t>(
+          1000 * cbrt((m_cubic_wmax - m_cwnd) / (CUBIC_C * m_mss)));
+    } else {
+      m_cubic_wmax = m_cwnd;
+      m_cubic_k = 0;
+    }
+  }
+
+  // The cubic window one RTT from now, and what Reno would have reached.
+  double t = (static_cast<double>(rtc::TimeDiff32(now, m_cubic_epoch)) +
+              m_rx_srtt - m_cubic_k) / 1000;
+  double target = m_cubic_wmax + CUBIC_C * m_mss * t * t * t;
+  m_cubic_west += std::max<uint32_t>(
+      1, static_cast<uint32_t>(CUBIC_RENO_GAIN * m_mss * nAcked / m_cwnd));
+  target = std::max(target, static_cast<double>(m_cubic_west));
+
+  if (target > m_cwnd) {
+    m_cwnd += std::min(m_mss, std::max<uint32_t>(1, static_cast<uint32_t>(
+                                  (target - m_cwnd) * m_mss / m_cwnd)));
+  } else {
+    m_cwnd += std::max<uint32_t>(1, m_mss * m_mss / (100 * m_cwnd));
+  }
+}
+
 void
 PseudoTcp::queueConnectMessage() {
   rtc::ByteBufferWriter buf(rtc::ByteBuffer::ORDER_NETWORK);
@@ -1178,6 +1345,13 @@ PseudoTcp::queueConnectMessage() {
     buf.WriteUInt8(TCP_OPT_WND_SCALE);
     buf.WriteUInt8(1);
     buf.WriteUInt8(m_rwnd_scale);
+  } else if (m_rwnd_scale > 0) {
+    // The peer won't know to scale our window, so it has to fit unscaled.
+    resizeReceiveBuffer(UNSCALED_RCV_BUF_SIZE);
+  }
+  if (m_support_sack) {
+    buf.WriteUInt8(TCP_OPT_SACK_PERMITTED);
+    buf.WriteUInt8(0);
   }
   m_snd_wnd = static_cast<uint32_t>(buf.Length());
   queue(buf.Data(), static_cast<uint32_t>(buf.Length()), true);
@@ -1223,11 +1397,15 @@ void PseudoTcp::parseOptions(const char* data, uint32_t len) {
 
     if (m_rwnd_scale > 0) {
       // Peer doesn't support TCP options and window scaling.
-      // Revert receive buffer size to default value.
-      resizeReceiveBuffer(DEFAULT_RCV_BUF_SIZE);
+      // Revert receive buffer size to one that needs no scaling.
+      resizeReceiveBuffer(UNSCALED_RCV_BUF_SIZE);
       m_swnd_scale = 0;
     }
   }
+
+  m_sack_enabled = m_support_sack &&
+                   options_specified.find(TCP_OPT_SACK_PERMITTED) !=
+                       options_specified.end();
 }
 
 void PseudoTcp::applyOption(char kind, const char* data, uint32_t len) {
@@ -89,6 +89,14 @@ class PseudoTcp {
     OPT_ACKDELAY,     // The Delayed ACK timeout (0 == off).
     OPT_RCVBUF,       // Set the receive buffer size, in bytes.
     OPT_SNDBUF,       // Set the send buffer size, in bytes.
+    OPT_SACK,         // Whether to offer selective ACKs (0 == off).
+    OPT_CONGESTION_CONTROL,  // One of the CongestionControl values.
+  };
+  // Setting OPT_SACK after Connect() is called will result in an assertion,
+  // since it is negotiated with the connect message.
+  enum CongestionControl {
+    CC_NEWRENO,  // Reno with NewReno fast recovery (default).
+    CC_CUBIC,    // CUBIC window growth (RFC 8312), for high-BDP paths.
   };
   void GetOption(Option opt, int* value);
   void SetOption(Option opt, int value);
@@ -117,15 +125,18 @@ class PseudoTcp {
     const char * data;
     uint32_t len;
     uint32_t tsval, tsecr;
+    const uint8_t* sack;
+    uint8_t sack_blocks;
   };
 
   struct SSegment {
     SSegment(uint32_t s, uint32_t l, bool c)
-        : seq(s), len(l), /*tstamp(0),*/ xmit(0), bCtrl(c) {}
+        : seq(s), len(l), /*tstamp(0),*/ xmit(0), bCtrl(c), bSacked(false) {}
     uint32_t seq, len;
     // uint32_t tstamp;
     uint8_t xmit;
     bool bCtrl;
+    bool bSacked;  // The peer has reported this segment as received.
   };
   typedef std::list<SSegment> SList;
 
@@ -149,6 +160,19 @@ class PseudoTcp {
                                        uint32_t len);
   bool parse(const uint8_t* buffer, uint32_t size);
 
+  // Writes SACK blocks for the out-of-order data in |m_rlist| to |buffer|,
+  // and returns how many were written.
+  uint8_t writeSackBlocks(uint8_t* buffer);
+  // Marks the segments covered by the SACK blocks in |data| as received.
+  void applySackBlocks(const uint8_t* data, uint8_t count);
+  // Retransmits the next segment the peer is known to be missing, if any has
+  // not been retransmitted yet during this recovery.
+  bool retransmitNextHole(uint32_t now);
+
+  // Reduces the slow start threshold after a loss.
+  void onLoss();
+  // Grows the congestion window when |nAcked| new bytes are acknowledged.
+  void growCongestionWindow(uint32_t nAcked, uint32_t now);
   void attemptSend(SendFlags sflags = sfNone);
 
   void closedown(uint32_t err = 0);
@@ -228,6 +252,18 @@ class PseudoTcp {
   uint32_t m_recover;
   uint32_t m_t_ack;
 
+  // Selective acknowledgement: whether it is offered and was negotiated, the
+  // highest sequence number the peer has reported, and how far holes have
+  // been retransmitted during the current recovery.
+  bool m_support_sack, m_sack_enabled;
+  uint32_t m_sack_high, m_rexmit_nxt;
+
+  // CUBIC state: the window before the last loss, the start of the current
+  // growth epoch, the time from then until the window is back at its old
+  // size, and a Reno-equivalent window estimate.
+  CongestionControl m_cc;
+  uint32_t m_cubic_wmax, m_cubic_epoch, m_cubic_k, m_cubic_west;
+
   // Configuration options
   bool m_use_nagling;
   uint32_t m_ack_delay;
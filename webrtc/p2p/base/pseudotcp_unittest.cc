@@ -91,6 +91,14 @@ class PseudoTcpTestBase : public testing::Test,
   void SetLocalOptRcvBuf(int size) {
     local_.SetOption(PseudoTcp::OPT_RCVBUF, size);
   }
+  void SetOptSack(bool enable) {
+    local_.SetOption(PseudoTcp::OPT_SACK, enable);
+    remote_.SetOption(PseudoTcp::OPT_SACK, enable);
+  }
+  void SetOptCongestionControl(PseudoTcp::CongestionControl cc) {
+    local_.SetOption(PseudoTcp::OPT_CONGESTION_CONTROL, cc);
+    remote_.SetOption(PseudoTcp::OPT_CONGESTION_CONTROL, cc);
+  }
   void DisableRemoteWindowScale() {
     remote_.disableWindowScale();
   }
@@ -623,6 +631,76 @@ TEST_F(PseudoTcpTest, TestSendWithDelayAndLoss) {
   TestTransfer(100000);  // less data so test runs faster
 }
 
+// Test sending data with a 50 ms RTT and 10% packet loss without SACK, so
+// that only one hole is repaired per round trip. Compare the logged throughput
+// with TestSendWithDelayAndLoss.
+// Disabled because it takes too long to run routinely. Use for performance
+// benchmarking when needed.
+TEST_F(PseudoTcpTest, DISABLED_TestSendWithDelayAndLossNoSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(10);
+  SetOptSack(false);
+  TestTransfer(100000);  // less data so test runs faster
+}
+
+// Test sending data with 10% packet loss using CUBIC.
+TEST_F(PseudoTcpTest, TestSendWithLossCubic) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  SetOptCongestionControl(PseudoTcp::CC_CUBIC);
+  TestTransfer(100000);  // less data so test runs faster
+}
+
+// Test sending data with a 50 ms RTT and 10% packet loss using CUBIC. Compare
+// the logged throughput with TestSendWithDelayAndLoss.
+// Disabled because it takes too long to run routinely. Use for performance
+// benchmarking when needed.
+TEST_F(PseudoTcpTest, DISABLED_TestSendWithDelayAndLossCubic) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(10);
+  SetOptCongestionControl(PseudoTcp::CC_CUBIC);
+  TestTransfer(100000);  // less data so test runs faster
+}
+
+// Test a long, lightly lossy link that needs more than the unscaled window to
+// fill. The log shows the throughput each option set reaches.
+// Disabled because it takes too long to run routinely. Use for performance
+// benchmarking when needed.
+TEST_F(PseudoTcpTest, DISABLED_TestSendWithDelayAndLightLoss) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(1);
+  TestTransfer(1000000);
+}
+
+// Disabled because it takes too long to run routinely. Use for performance
+// benchmarking when needed.
+TEST_F(PseudoTcpTest, DISABLED_TestSendWithDelayAndLightLossNoSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(1);
+  SetOptSack(false);
+  TestTransfer(1000000);
+}
+
+// Disabled because it takes too long to run routinely. Use for performance
+// benchmarking when needed.
+TEST_F(PseudoTcpTest, DISABLED_TestSendWithDelayAndLightLossCubic) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(1);
+  SetOptCongestionControl(PseudoTcp::CC_CUBIC);
+  TestTransfer(1000000);
+}
+
 // Test sending data with 10% packet loss and Nagling disabled.  Transmission
 // should take about the same time as with Nagling enabled.
 TEST_F(PseudoTcpTest, TestSendWithLossAndOptNaglingOff) {
@@ -670,6 +748,15 @@ TEST_F(PseudoTcpTest, TestSendRemoteNoWindowScale) {
   TestTransfer(1000000);
 }
 
+// Test SACK with a peer that doesn't offer it.
+TEST_F(PseudoTcpTest, TestSendRemoteNoSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  remote_.SetOption(PseudoTcp::OPT_SACK, 0);
+  TestTransfer(100000);
+}
+
 // Test a large sender-side receive buffer with a receiver that doesn't support
 // scaling.
 TEST_F(PseudoTcpTest, TestSendLocalNoWindowScale) {
@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/p2p/base/shardedturnserver.h"
+
+#include <utility>
+
+#include "webrtc/p2p/base/basicpacketsocketfactory.h"
+#include "webrtc/p2p/base/turnserver.h"
+#include "webrtc/base/asyncudpsocket.h"
+#include "webrtc/base/bind.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/base/thread.h"
+
+namespace cricket {
+
+ShardedTurnServer::ShardedTurnServer(int num_shards)
+    : num_shards_(num_shards) {
+  RTC_DCHECK_GT(num_shards, 0);
+}
+
+ShardedTurnServer::~ShardedTurnServer() {
+  Stop();
+}
+
+bool ShardedTurnServer::Start(const rtc::SocketAddress& int_addr,
+                              const rtc::IPAddress& ext_ip) {
+  RTC_DCHECK(shards_.empty());
+  int_addr_ = int_addr;
+  for (int i = 0; i < num_shards_; ++i) {
+    std::unique_ptr<Shard> shard(new Shard());
+    shard->thread = rtc::Thread::CreateWithSocketServer();
+    shard->thread->SetName("TurnServerShard", shard.get());
+    shard->thread->Start();
+    rtc::SocketAddress bound_addr;
+    bool started = shard->thread->Invoke<bool>(
+        rtc::Bind(&ShardedTurnServer::StartShard_s, this, shard.get(),
+                  int_addr_, ext_ip, &bound_addr));
+    shards_.push_back(std::move(shard));
+    if (!started) {
+      Stop();
+      return false;
+    }
+    // The remaining shards join the port the first one was given.
+    int_addr_ = bound_addr;
+  }
+  LOG(LS_INFO) << "Started " << num_shards_ << " TURN server shards at "
+               << int_addr_.ToString();
+  return true;
+}
+
+void ShardedTurnServer::Stop() {
+  for (auto& shard : shards_) {
+    shard->thread->Invoke<void>(
+        rtc::Bind(&ShardedTurnServer::StopShard_s, this, shard.get()));
+    shard->thread->Stop();
+  }
+  shards_.clear();
+}
+
+size_t ShardedTurnServer::GetAllocationCount() const {
+  size_t count = 0;
+  for (const auto& shard : shards_) {
+    count += shard->thread->Invoke<size_t>(rtc::Bind(
+        &ShardedTurnServer::GetAllocationCount_s, this, shard.get()));
+  }
+  return count;
+}
+
+bool ShardedTurnServer::StartShard_s(Shard* shard,
+                                     const rtc::SocketAddress& int_addr,
+                                     const rtc::IPAddress& ext_ip,
+                                     rtc::SocketAddress* bound_addr) {
+  rtc::Thread* thread = shard->thread.get();
+  RTC_DCHECK(thread->IsCurrent());
+  std::unique_ptr<rtc::AsyncSocket> socket(
+      thread->socketserver()->CreateAsyncSocket(int_addr.family(),
+                                                SOCK_DGRAM));
+  if (!socket) {
+    LOG(LS_ERROR) << "Failed to create a TURN server shard socket.";
+    return false;
+  }
+  // Every shard must opt in before binding, including the first one.
+  if (num_shards_ > 1 &&
+      socket->SetOption(rtc::Socket::OPT_REUSEPORT, 1) != 0) {
+    LOG(LS_ERROR) << "Failed to set SO_REUSEPORT on a TURN server shard.";
+    return false;
+  }
+  if (socket->Bind(int_addr) != 0) {
+    LOG(LS_ERROR) << "Failed to bind a TURN server shard to "
+                  << int_addr.ToString() << ", err=" << socket->GetError();
+    return false;
+  }
+  *bound_addr = socket->GetLocalAddress();
+
+  shard->server.reset(new TurnServer(thread));
+  shard->server->set_realm(realm_);
+  shard->server->set_software(software_);
+  shard->server->set_auth_hook(auth_hook_);
+  shard->server->set_enable_otu_nonce(enable_otu_nonce_);
+  shard->server->set_reject_private_addresses(reject_private_addresses_);
+  shard->server->AddInternalSocket(new rtc::AsyncUDPSocket(socket.release()),
+                                   PROTO_UDP);
+  shard->server->SetExternalSocketFactory(
+      new rtc::BasicPacketSocketFactory(thread), rtc::SocketAddress(ext_ip, 0));
+  return true;
+}
+
+void ShardedTurnServer::StopShard_s(Shard* shard) {
+  RTC_DCHECK(shard->thread->IsCurrent());
+  shard->server.reset();
+}
+
+size_t ShardedTurnServer::GetAllocationCount_s(Shard* shard) const {
+  RTC_DCHECK(shard->thread->IsCurrent());
+  return shard->server ? shard->server->allocations().size() : 0;
+}
+
+}  // namespace cricket
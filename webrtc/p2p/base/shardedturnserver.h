@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_P2P_BASE_SHARDEDTURNSERVER_H_
+#define WEBRTC_P2P_BASE_SHARDEDTURNSERVER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/ipaddress.h"
+#include "webrtc/base/socketaddress.h"
+
+namespace rtc {
+class Thread;
+}
+
+namespace cricket {
+
+class TurnAuthInterface;
+class TurnServer;
+
+// Runs a UDP TurnServer on several threads at once. Every shard owns a thread,
+// a TurnServer and its own UDP socket bound to the shared internal address
+// with Socket::OPT_REUSEPORT, so the kernel hashes each client's 4-tuple to a
+// single shard. The allocations of a client therefore live on, and only ever
+// see packets on, the thread that owns them. Relayed sockets are created on
+// the owning thread too, so peer traffic needs no thread hop either.
+//
+// More than one shard needs OPT_REUSEPORT, which is only available on Linux.
+// The configuration setters must be called before Start().
+class ShardedTurnServer {
+ public:
+  explicit ShardedTurnServer(int num_shards);
+  ~ShardedTurnServer();
+
+  int num_shards() const { return num_shards_; }
+
+  void set_realm(const std::string& realm) { realm_ = realm; }
+  void set_software(const std::string& software) { software_ = software; }
+  // Does not take ownership. The hook is called from every shard thread, so
+  // it must be thread safe.
+  void set_auth_hook(TurnAuthInterface* auth_hook) { auth_hook_ = auth_hook; }
+  void set_enable_otu_nonce(bool enable) { enable_otu_nonce_ = enable; }
+  void set_reject_private_addresses(bool filter) {
+    reject_private_addresses_ = filter;
+  }
+
+  // Starts the shard threads, listening at |int_addr| and relaying from
+  // |ext_ip|. If the port of |int_addr| is 0, all shards share the port the
+  // first one is given. Returns false and stops any started shards on failure.
+  bool Start(const rtc::SocketAddress& int_addr, const rtc::IPAddress& ext_ip);
+  // Destroys every shard's allocations and stops the shard threads.
+  void Stop();
+
+  // The address the shards are listening at, valid once started.
+  const rtc::SocketAddress& internal_address() const { return int_addr_; }
+  // Sums the allocations of all shards. Blocks on each shard thread.
+  size_t GetAllocationCount() const;
+
+ private:
+  struct Shard {
+    std::unique_ptr<rtc::Thread> thread;
+    std::unique_ptr<TurnServer> server;
+  };
+
+  bool StartShard_s(Shard* shard,
+                    const rtc::SocketAddress& int_addr,
+                    const rtc::IPAddress& ext_ip,
+                    rtc::SocketAddress* bound_addr);
+  void StopShard_s(Shard* shard);
+  size_t GetAllocationCount_s(Shard* shard) const;
+
+  const int num_shards_;
+  std::string realm_;
+  std::string software_;
+  TurnAuthInterface* auth_hook_ = nullptr;
+  bool enable_otu_nonce_ = false;
+  bool reject_private_addresses_ = false;
+
+  rtc::SocketAddress int_addr_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ShardedTurnServer);
+};
+
+}  // namespace cricket
+
+#endif  // WEBRTC_P2P_BASE_SHARDEDTURNSERVER_H_
@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/p2p/base/shardedturnserver.h"
+#include "webrtc/p2p/base/stun.h"
+#include "webrtc/base/asyncudpsocket.h"
+#include "webrtc/base/bytebuffer.h"
+#include "webrtc/base/gunit.h"
+#include "webrtc/base/helpers.h"
+#include "webrtc/base/testclient.h"
+#include "webrtc/base/thread.h"
+
+using namespace cricket;
+
+static const rtc::SocketAddress kLocalAddr("127.0.0.1", 0);
+
+class ShardedTurnServerTest : public testing::Test {
+ protected:
+  // Sends a binding request from every client and checks that each gets its
+  // own address back, whichever shard it was hashed to.
+  void TestBindingRequests(ShardedTurnServer* server, int num_clients) {
+    std::vector<std::unique_ptr<rtc::TestClient>> clients;
+    for (int i = 0; i < num_clients; ++i) {
+      rtc::AsyncUDPSocket* socket = rtc::AsyncUDPSocket::Create(
+          rtc::Thread::Current()->socketserver(), kLocalAddr);
+      ASSERT_TRUE(socket != nullptr);
+      clients.emplace_back(new rtc::TestClient(socket));
+    }
+
+    for (auto& client : clients) {
+      StunMessage req;
+      req.SetType(STUN_BINDING_REQUEST);
+      req.SetTransactionID(rtc::CreateRandomString(kStunTransactionIdLength));
+      rtc::ByteBufferWriter buf;
+      req.Write(&buf);
+      client->SendTo(buf.Data(), buf.Length(), server->internal_address());
+    }
+
+    for (auto& client : clients) {
+      std::unique_ptr<rtc::TestClient::Packet> packet(
+          client->NextPacket(rtc::TestClient::kTimeoutMs));
+      ASSERT_TRUE(packet);
+      rtc::ByteBufferReader buf(packet->buf, packet->size);
+      StunMessage resp;
+      ASSERT_TRUE(resp.Read(&buf));
+      EXPECT_EQ(STUN_BINDING_RESPONSE, resp.type());
+      const StunAddressAttribute* mapped_addr =
+          resp.GetAddress(STUN_ATTR_XOR_MAPPED_ADDRESS);
+      ASSERT_TRUE(mapped_addr != nullptr);
+      EXPECT_EQ(client->address(), mapped_addr->GetAddress());
+    }
+  }
+};
+
+TEST_F(ShardedTurnServerTest, TestSingleShard) {
+  ShardedTurnServer server(1);
+  ASSERT_TRUE(server.Start(kLocalAddr, kLocalAddr.ipaddr()));
+  EXPECT_NE(0, server.internal_address().port());
+  TestBindingRequests(&server, 4);
+  EXPECT_EQ(0u, server.GetAllocationCount());
+  server.Stop();
+}
+
+#if defined(WEBRTC_LINUX)
+// All shards listen on the same port, and every client is answered.
+TEST_F(ShardedTurnServerTest, TestMultipleShards) {
+  ShardedTurnServer server(4);
+  ASSERT_TRUE(server.Start(kLocalAddr, kLocalAddr.ipaddr()));
+  EXPECT_NE(0, server.internal_address().port());
+  TestBindingRequests(&server, 32);
+  server.Stop();
+
+  // Once stopped, the port can be taken again without OPT_REUSEPORT.
+  std::unique_ptr<rtc::AsyncUDPSocket> socket(rtc::AsyncUDPSocket::Create(
+      rtc::Thread::Current()->socketserver(), server.internal_address()));
+  EXPECT_TRUE(socket);
+}
+#endif  // WEBRTC_LINUX
@@ -10,11 +10,11 @@
 
 #include "webrtc/p2p/base/stun.h"
 
+#include <openssl/hmac.h>
 #include <string.h>
 
-#include <memory>
-
 #include "webrtc/base/byteorder.h"
+#include "webrtc/base/checks.h"
 #include "webrtc/base/common.h"
 #include "webrtc/base/crc32.h"
 #include "webrtc/base/logging.h"
@@ -42,6 +42,77 @@ const char TURN_MAGIC_COOKIE_VALUE[] = { '\x72', '\xC6', '\x4B', '\xC6' };
 const char EMPTY_TRANSACTION_ID[] = "0000000000000000";
 const uint32_t STUN_FINGERPRINT_XOR_VALUE = 0x5354554E;
 
+// Checks the HMAC-SHA1 of the MESSAGE-INTEGRITY attribute at |mi_pos| against
+// the preceding bytes of the message, with the header length adjusted to end
+// just after the attribute, as in RFC 5389, section 15.4.
+static bool ValidateHmac(const char* data, size_t mi_pos,
+                         const StunMessageIntegrityKey& key) {
+  size_t adjusted_len = mi_pos - kStunHeaderSize + kStunAttributeHeaderSize +
+                        kStunMessageIntegritySize;
+  char hmac[kStunMessageIntegritySize];
+  key.ComputeHmac(data, mi_pos, static_cast<uint16_t>(adjusted_len), hmac);
+
+  // Comparing the calculated HMAC with the one present in the message.
+  return memcmp(data + mi_pos + kStunAttributeHeaderSize, hmac,
+                sizeof(hmac)) == 0;
+}
+
+// StunMessageIntegrityKey
+
+StunMessageIntegrityKey::StunMessageIntegrityKey() : ctx_(new HMAC_CTX) {
+  HMAC_CTX_init(ctx_.get());
+  SetKey(nullptr, 0);
+}
+
+StunMessageIntegrityKey::StunMessageIntegrityKey(const char* key,
+                                                 size_t keylen)
+    : ctx_(new HMAC_CTX) {
+  HMAC_CTX_init(ctx_.get());
+  SetKey(key, keylen);
+}
+
+StunMessageIntegrityKey::~StunMessageIntegrityKey() {
+  HMAC_CTX_cleanup(ctx_.get());
+}
+
+void StunMessageIntegrityKey::SetPassword(const std::string& password) {
+  if (has_password_ && password == password_)
+    return;
+  has_password_ = true;
+  password_ = password;
+  SetKey(password.data(), password.size());
+}
+
+void StunMessageIntegrityKey::ComputeHmac(const char* data,
+                                          size_t size,
+                                          uint16_t message_length,
+                                          char* hmac) const {
+  ASSERT(size >= kStunHeaderSize);
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  uint8_t length[sizeof(message_length)];
+  rtc::SetBE16(length, message_length);
+
+  // Copying |ctx_| copies the digest states after the padded key blocks, so
+  // only the message and the inner digest are hashed here.
+  HMAC_CTX ctx;
+  HMAC_CTX_init(&ctx);
+  RTC_CHECK(HMAC_CTX_copy(&ctx, ctx_.get()));
+  HMAC_Update(&ctx, bytes, 2);
+  HMAC_Update(&ctx, length, sizeof(length));
+  HMAC_Update(&ctx, bytes + 4, size - 4);
+  unsigned int hmac_length = 0;
+  HMAC_Final(&ctx, reinterpret_cast<uint8_t*>(hmac), &hmac_length);
+  HMAC_CTX_cleanup(&ctx);
+  RTC_DCHECK_EQ(kStunMessageIntegritySize, hmac_length);
+}
+
+void StunMessageIntegrityKey::SetKey(const char* key, size_t keylen) {
+  // A null key would make HMAC_Init_ex() keep the previous one.
+  static const char kEmptyKey[] = "";
+  RTC_CHECK(HMAC_Init_ex(ctx_.get(), keylen ? key : kEmptyKey,
+                         static_cast<int>(keylen), EVP_sha1(), nullptr));
+}
+
 // StunMessage
 
 StunMessage::StunMessage()
@@ -131,6 +202,12 @@ const StunUInt16ListAttribute* StunMessage::GetUnknownAttributes() const {
 // procedure outlined in RFC 5389, section 15.4.
 bool StunMessage::ValidateMessageIntegrity(const char* data, size_t size,
                                            const std::string& password) {
+  return ValidateMessageIntegrity(
+      data, size, StunMessageIntegrityKey(password.data(), password.size()));
+}
+
+bool StunMessage::ValidateMessageIntegrity(
+    const char* data, size_t size, const StunMessageIntegrityKey& key) {
   // Verifying the size of the message.
   if ((size % 4) != 0) {
     return false;
@@ -154,7 +231,7 @@ bool StunMessage::ValidateMessageIntegrity(const char* data, size_t size,
     // If M-I, sanity check it, and break out.
     if (attr_type == STUN_ATTR_MESSAGE_INTEGRITY) {
       if (attr_length != kStunMessageIntegritySize ||
-          current_pos + attr_length > size) {
+          current_pos + kStunAttributeHeaderSize + attr_length > size) {
         return false;
       }
       has_message_integrity_attr = true;
@@ -172,39 +249,7 @@ bool StunMessage::ValidateMessageIntegrity(const char* data, size_t size,
     return false;
   }
 
-  // Getting length of the message to calculate Message Integrity.
-  size_t mi_pos = current_pos;
-  std::unique_ptr<char[]> temp_data(new char[current_pos]);
-  memcpy(temp_data.get(), data, current_pos);
-  if (size > mi_pos + kStunAttributeHeaderSize + kStunMessageIntegritySize) {
-    // Stun message has other attributes after message integrity.
-    // Adjust the length parameter in stun message to calculate HMAC.
-    size_t extra_offset = size -
-        (mi_pos + kStunAttributeHeaderSize + kStunMessageIntegritySize);
-    size_t new_adjusted_len = size - extra_offset - kStunHeaderSize;
-
-    // Writing new length of the STUN message @ Message Length in temp buffer.
-    //      0                   1                   2                   3
-    //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    //     |0 0|     STUN Message Type     |         Message Length        |
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    rtc::SetBE16(temp_data.get() + 2, static_cast<uint16_t>(new_adjusted_len));
-  }
-
-  char hmac[kStunMessageIntegritySize];
-  size_t ret = rtc::ComputeHmac(rtc::DIGEST_SHA_1,
-                                      password.c_str(), password.size(),
-                                      temp_data.get(), mi_pos,
-                                      hmac, sizeof(hmac));
-  ASSERT(ret == sizeof(hmac));
-  if (ret != sizeof(hmac))
-    return false;
-
-  // Comparing the calculated HMAC with the one present in the message.
-  return memcmp(data + current_pos + kStunAttributeHeaderSize,
-                hmac,
-                sizeof(hmac)) == 0;
+  return ValidateHmac(data, current_pos, key);
 }
 
 bool StunMessage::AddMessageIntegrity(const std::string& password) {
@@ -213,6 +258,10 @@ bool StunMessage::AddMessageIntegrity(const std::string& password) {
 
 bool StunMessage::AddMessageIntegrity(const char* key,
                                       size_t keylen) {
+  return AddMessageIntegrity(StunMessageIntegrityKey(key, keylen));
+}
+
+bool StunMessage::AddMessageIntegrity(const StunMessageIntegrityKey& key) {
   // Add the attribute with a dummy value. Since this is a known attribute, it
   // can't fail.
   StunByteStringAttribute* msg_integrity_attr =
@@ -220,24 +269,15 @@ bool StunMessage::AddMessageIntegrity(const char* key,
           std::string(kStunMessageIntegritySize, '0'));
   VERIFY(AddAttribute(msg_integrity_attr));
 
-  // Calculate the HMAC for the message.
-  ByteBufferWriter buf;
+  // Calculate the HMAC over the message, serialized at its exact size.
+  ByteBufferWriter buf(nullptr, kStunHeaderSize + length_);
   if (!Write(&buf))
     return false;
 
-  int msg_len_for_hmac = static_cast<int>(
-      buf.Length() - kStunAttributeHeaderSize - msg_integrity_attr->length());
+  size_t msg_len_for_hmac =
+      buf.Length() - kStunAttributeHeaderSize - msg_integrity_attr->length();
   char hmac[kStunMessageIntegritySize];
-  size_t ret = rtc::ComputeHmac(rtc::DIGEST_SHA_1,
-                                      key, keylen,
-                                      buf.Data(), msg_len_for_hmac,
-                                      hmac, sizeof(hmac));
-  ASSERT(ret == sizeof(hmac));
-  if (ret != sizeof(hmac)) {
-    LOG(LS_ERROR) << "HMAC computation failed. Message-Integrity "
-                  << "has dummy value.";
-    return false;
-  }
+  key.ComputeHmac(buf.Data(), msg_len_for_hmac, length_, hmac);
 
   // Insert correct HMAC into the attribute.
   msg_integrity_attr->CopyBytes(hmac, sizeof(hmac));
@@ -281,8 +321,9 @@ bool StunMessage::AddFingerprint() {
      new StunUInt32Attribute(STUN_ATTR_FINGERPRINT, 0);
   VERIFY(AddAttribute(fingerprint_attr));
 
-  // Calculate the CRC-32 for the message and insert it.
-  ByteBufferWriter buf;
+  // Calculate the CRC-32 over the message, serialized at its exact size, and
+  // insert it.
+  ByteBufferWriter buf(nullptr, kStunHeaderSize + length_);
   if (!Write(&buf))
     return false;
 
@@ -413,6 +454,185 @@ bool StunMessage::IsValidTransactionId(const std::string& transaction_id) {
       transaction_id.size() == kStunLegacyTransactionIdLength;
 }
 
+// StunMessageView
+
+StunMessageView::StunMessageView()
+    : data_(nullptr),
+      size_(0),
+      type_(0),
+      length_(0),
+      legacy_(false),
+      num_attrs_(0) {
+}
+
+bool StunMessageView::Parse(const char* data, size_t size) {
+  data_ = data;
+  size_ = size;
+  num_attrs_ = 0;
+  if (size < kStunHeaderSize)
+    return false;
+
+  type_ = rtc::GetBE16(data);
+  if (type_ & 0x8000) {
+    // RTP and RTCP set the MSB of first byte, since first two bits are version,
+    // and version is always 2 (10). If set, this is not a STUN packet.
+    return false;
+  }
+  length_ = rtc::GetBE16(data + 2);
+  if (length_ != size - kStunHeaderSize)
+    return false;
+  legacy_ = rtc::GetBE32(data + kStunTransactionIdOffset -
+                         kStunMagicCookieLength) != kStunMagicCookie;
+
+  size_t pos = kStunHeaderSize;
+  while (pos < size) {
+    if (size - pos < kStunAttributeHeaderSize ||
+        num_attrs_ == kMaxAttributes) {
+      return false;
+    }
+    Attribute* attr = &attrs_[num_attrs_];
+    attr->type = rtc::GetBE16(data + pos);
+    attr->length = rtc::GetBE16(data + pos + 2);
+    attr->offset = static_cast<uint32_t>(pos + kStunAttributeHeaderSize);
+    size_t padded_length = attr->length;
+    if ((padded_length % 4) != 0) {
+      padded_length += (4 - (padded_length % 4));
+    }
+    if (size - attr->offset < padded_length)
+      return false;
+    pos = attr->offset + padded_length;
+    ++num_attrs_;
+  }
+  return true;
+}
+
+const char* StunMessageView::transaction_id() const {
+  return legacy_ ? data_ + kStunTransactionIdOffset - kStunMagicCookieLength
+                 : data_ + kStunTransactionIdOffset;
+}
+
+size_t StunMessageView::transaction_id_length() const {
+  return legacy_ ? kStunLegacyTransactionIdLength : kStunTransactionIdLength;
+}
+
+bool StunMessageView::HasAttribute(int type) const {
+  return FindAttribute(type) != nullptr;
+}
+
+bool StunMessageView::GetByteString(int type,
+                                    const char** value,
+                                    size_t* length) const {
+  const Attribute* attr = FindAttribute(type);
+  if (!attr)
+    return false;
+  *value = data_ + attr->offset;
+  *length = attr->length;
+  return true;
+}
+
+bool StunMessageView::GetUInt32(int type, uint32_t* value) const {
+  const Attribute* attr = FindAttribute(type);
+  if (!attr || attr->length != StunUInt32Attribute::SIZE)
+    return false;
+  *value = rtc::GetBE32(data_ + attr->offset);
+  return true;
+}
+
+bool StunMessageView::GetUInt64(int type, uint64_t* value) const {
+  const Attribute* attr = FindAttribute(type);
+  if (!attr || attr->length != StunUInt64Attribute::SIZE)
+    return false;
+  *value = rtc::GetBE64(data_ + attr->offset);
+  return true;
+}
+
+bool StunMessageView::GetAddress(int type, rtc::SocketAddress* address) const {
+  return ReadAddress(FindAttribute(type), false, address);
+}
+
+bool StunMessageView::GetXorAddress(int type,
+                                    rtc::SocketAddress* address) const {
+  return ReadAddress(FindAttribute(type), true, address);
+}
+
+bool StunMessageView::GetErrorCode(int* code) const {
+  const Attribute* attr = FindAttribute(STUN_ATTR_ERROR_CODE);
+  if (!attr || attr->length < StunErrorCodeAttribute::MIN_SIZE)
+    return false;
+  uint32_t val = rtc::GetBE32(data_ + attr->offset);
+  *code = ((val >> 8) & 0x7) * 100 + (val & 0xff);
+  return true;
+}
+
+bool StunMessageView::ValidateMessageIntegrity(const char* key,
+                                               size_t keylen) const {
+  return ValidateMessageIntegrity(StunMessageIntegrityKey(key, keylen));
+}
+
+bool StunMessageView::ValidateMessageIntegrity(
+    const StunMessageIntegrityKey& key) const {
+  if ((size_ % 4) != 0)
+    return false;
+  const Attribute* attr = FindAttribute(STUN_ATTR_MESSAGE_INTEGRITY);
+  if (!attr || attr->length != kStunMessageIntegritySize)
+    return false;
+  return ValidateHmac(data_, attr->offset - kStunAttributeHeaderSize, key);
+}
+
+bool StunMessageView::ValidateFingerprint() const {
+  return StunMessage::ValidateFingerprint(data_, size_);
+}
+
+const StunMessageView::Attribute* StunMessageView::FindAttribute(
+    int type) const {
+  for (size_t i = 0; i < num_attrs_; ++i) {
+    if (attrs_[i].type == type)
+      return &attrs_[i];
+  }
+  return nullptr;
+}
+
+bool StunMessageView::ReadAddress(const Attribute* attr,
+                                  bool xored,
+                                  rtc::SocketAddress* address) const {
+  if (!attr || attr->length < StunAddressAttribute::SIZE_IP4)
+    return false;
+  const char* value = data_ + attr->offset;
+  uint8_t stun_family = static_cast<uint8_t>(value[1]);
+  uint16_t port = rtc::GetBE16(value + 2);
+  if (xored)
+    port ^= (kStunMagicCookie >> 16);
+
+  if (stun_family == STUN_ADDRESS_IPV4) {
+    if (attr->length != StunAddressAttribute::SIZE_IP4)
+      return false;
+    in_addr v4addr;
+    memcpy(&v4addr, value + 4, sizeof(v4addr));
+    if (xored)
+      v4addr.s_addr ^= rtc::HostToNetwork32(kStunMagicCookie);
+    address->SetIP(rtc::IPAddress(v4addr));
+  } else if (stun_family == STUN_ADDRESS_IPV6) {
+    if (attr->length != StunAddressAttribute::SIZE_IP6)
+      return false;
+    in6_addr v6addr;
+    memcpy(&v6addr, value + 4, sizeof(v6addr));
+    if (xored) {
+      // The IPv6 address is XORed with the magic cookie and the transaction
+      // ID, which both follow the message type and length in the header.
+      if (legacy_)
+        return false;
+      for (size_t i = 0; i < sizeof(v6addr.s6_addr); ++i) {
+        v6addr.s6_addr[i] ^= static_cast<uint8_t>(data_[4 + i]);
+      }
+    }
+    address->SetIP(rtc::IPAddress(v6addr));
+  } else {
+    return false;
+  }
+  address->SetPort(port);
+  return true;
+}
+
 // StunAttribute
 
 StunAttribute::StunAttribute(uint16_t type, uint16_t length)
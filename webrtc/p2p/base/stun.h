@@ -14,13 +14,18 @@
 // This file contains classes for dealing with the STUN protocol, as specified
 // in RFC 5389, and its descendants.
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "webrtc/base/basictypes.h"
 #include "webrtc/base/bytebuffer.h"
+#include "webrtc/base/constructormagic.h"
 #include "webrtc/base/socketaddress.h"
 
+// OpenSSL's HMAC_CTX.
+struct hmac_ctx_st;
+
 namespace cricket {
 
 // These are the types of STUN messages defined in RFC 5389.
@@ -116,6 +121,39 @@ const size_t kStunLegacyTransactionIdLength = 16;
 // STUN Message Integrity HMAC length.
 const size_t kStunMessageIntegritySize = 20;
 
+// The key of the HMAC-SHA1 in MESSAGE-INTEGRITY attributes, as an HMAC_CTX
+// that has already hashed the padded key blocks. Holders of a long-lived
+// password, such as a Port with its ICE password, keep one of these so that
+// signing or validating a message doesn't derive the key again each time.
+class StunMessageIntegrityKey {
+ public:
+  // An empty key.
+  StunMessageIntegrityKey();
+  StunMessageIntegrityKey(const char* key, size_t keylen);
+  ~StunMessageIntegrityKey();
+
+  // Derives the key from |password|, unless it is the password this key was
+  // last derived from.
+  void SetPassword(const std::string& password);
+
+  // Writes the kStunMessageIntegritySize byte HMAC of the first |size| bytes of
+  // a STUN message to |hmac|, with |message_length| in place of the header's
+  // length field.
+  void ComputeHmac(const char* data,
+                   size_t size,
+                   uint16_t message_length,
+                   char* hmac) const;
+
+ private:
+  void SetKey(const char* key, size_t keylen);
+
+  bool has_password_ = false;
+  std::string password_;
+  std::unique_ptr<hmac_ctx_st> ctx_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(StunMessageIntegrityKey);
+};
+
 class StunAttribute;
 class StunAddressAttribute;
 class StunXorAddressAttribute;
@@ -168,9 +206,12 @@ class StunMessage {
   // padding data (which we discard when reading a StunMessage).
   static bool ValidateMessageIntegrity(const char* data, size_t size,
                                        const std::string& password);
+  static bool ValidateMessageIntegrity(const char* data, size_t size,
+                                       const StunMessageIntegrityKey& key);
   // Adds a MESSAGE-INTEGRITY attribute that is valid for the current message.
   bool AddMessageIntegrity(const std::string& password);
   bool AddMessageIntegrity(const char* key, size_t keylen);
+  bool AddMessageIntegrity(const StunMessageIntegrityKey& key);
 
   // Verifies that a given buffer is STUN by checking for a correct FINGERPRINT.
   static bool ValidateFingerprint(const char* data, size_t size);
@@ -204,6 +245,73 @@ class StunMessage {
   std::vector<StunAttribute*>* attrs_;
 };
 
+// A read-only view of a serialized STUN message. Parse() checks the header and
+// indexes the attributes in place, after which attributes can be looked up and
+// MESSAGE-INTEGRITY and FINGERPRINT validated without any heap allocation.
+// Unlike StunMessage, the view doesn't know the value types of attributes, so
+// the caller picks the getter matching the attribute. The view points into the
+// parsed buffer, which must outlive it.
+class StunMessageView {
+ public:
+  // Messages with more attributes than this are rejected by Parse().
+  static const size_t kMaxAttributes = 32;
+
+  StunMessageView();
+
+  // Parses the STUN packet in the given buffer. The return value indicates
+  // whether it is a complete STUN message with well-formed attribute headers.
+  bool Parse(const char* data, size_t size);
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+  int type() const { return type_; }
+  // The length of the message body, excluding the header.
+  size_t length() const { return length_; }
+  // Returns true if the message has no magic cookie, as in RFC3489. The
+  // transaction ID of such a message includes the cookie field.
+  bool IsLegacy() const { return legacy_; }
+  const char* transaction_id() const;
+  size_t transaction_id_length() const;
+
+  size_t num_attributes() const { return num_attrs_; }
+  bool HasAttribute(int type) const;
+
+  // Each getter finds the first attribute of |type|, and returns false if it
+  // is missing or malformed. |value| points into the parsed buffer.
+  bool GetByteString(int type, const char** value, size_t* length) const;
+  bool GetUInt32(int type, uint32_t* value) const;
+  bool GetUInt64(int type, uint64_t* value) const;
+  bool GetAddress(int type, rtc::SocketAddress* address) const;
+  bool GetXorAddress(int type, rtc::SocketAddress* address) const;
+  bool GetErrorCode(int* code) const;
+
+  // Same as the static StunMessage methods, for the parsed message.
+  bool ValidateMessageIntegrity(const char* key, size_t keylen) const;
+  bool ValidateMessageIntegrity(const StunMessageIntegrityKey& key) const;
+  bool ValidateFingerprint() const;
+
+ private:
+  struct Attribute {
+    uint16_t type;
+    uint16_t length;
+    // Offset of the value from the start of the message.
+    uint32_t offset;
+  };
+
+  const Attribute* FindAttribute(int type) const;
+  bool ReadAddress(const Attribute* attr,
+                   bool xored,
+                   rtc::SocketAddress* address) const;
+
+  const char* data_;
+  size_t size_;
+  uint16_t type_;
+  uint16_t length_;
+  bool legacy_;
+  size_t num_attrs_;
+  Attribute attrs_[kMaxAttributes];
+};
+
 // Base class for all STUN/TURN attributes.
 class StunAttribute {
  public:
@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/bytebuffer.h"
+#include "webrtc/p2p/base/stun.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/test/testsupport/perf_timer.h"
+
+namespace cricket {
+namespace {
+const int kNumIterations = 200000;
+const char kTransactionId[] = "0123456789ab";
+const char kUsername[] = "remoteufrag:localufrag";
+const uint32_t kPriority = 1853824767;
+const uint64_t kTieBreaker = 0x0123456789abcdefULL;
+const char kPassword[] = "0123456789abcdefghijklmn";
+
+// Writes an ICE connectivity check, as sent for every candidate pair on every
+// check interval.
+void WriteConnectivityCheck(rtc::ByteBufferWriter* buf) {
+  IceMessage msg;
+  msg.SetType(STUN_BINDING_REQUEST);
+  EXPECT_TRUE(msg.SetTransactionID(kTransactionId));
+  EXPECT_TRUE(msg.AddAttribute(
+      new StunByteStringAttribute(STUN_ATTR_USERNAME, kUsername)));
+  EXPECT_TRUE(
+      msg.AddAttribute(new StunUInt32Attribute(STUN_ATTR_PRIORITY, kPriority)));
+  EXPECT_TRUE(msg.AddAttribute(
+      new StunUInt64Attribute(STUN_ATTR_ICE_CONTROLLING, kTieBreaker)));
+  EXPECT_TRUE(
+      msg.AddAttribute(new StunByteStringAttribute(STUN_ATTR_USE_CANDIDATE)));
+  EXPECT_TRUE(msg.AddMessageIntegrity(kPassword));
+  EXPECT_TRUE(msg.AddFingerprint());
+  EXPECT_TRUE(msg.Write(buf));
+}
+
+// Checks |msg|, read from |packet|, against what WriteConnectivityCheck()
+// wrote.
+void VerifyConnectivityCheck(const rtc::ByteBufferWriter& packet,
+                             const IceMessage& msg) {
+  EXPECT_EQ(STUN_BINDING_REQUEST, msg.type());
+  EXPECT_EQ(kTransactionId, msg.transaction_id());
+  const StunByteStringAttribute* username =
+      msg.GetByteString(STUN_ATTR_USERNAME);
+  ASSERT_TRUE(username);
+  EXPECT_EQ(kUsername, username->GetString());
+  const StunUInt32Attribute* priority = msg.GetUInt32(STUN_ATTR_PRIORITY);
+  ASSERT_TRUE(priority);
+  EXPECT_EQ(kPriority, priority->value());
+  const StunUInt64Attribute* tie_breaker =
+      msg.GetUInt64(STUN_ATTR_ICE_CONTROLLING);
+  ASSERT_TRUE(tie_breaker);
+  EXPECT_EQ(kTieBreaker, tie_breaker->value());
+  EXPECT_TRUE(msg.GetByteString(STUN_ATTR_USE_CANDIDATE));
+  EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(
+      packet.Data(), packet.Length(), kPassword));
+  EXPECT_TRUE(StunMessage::ValidateFingerprint(packet.Data(), packet.Length()));
+}
+
+// Returns the number of megabytes of STUN messages read per second.
+size_t MeasureReadMBPerSecond() {
+  rtc::ByteBufferWriter packet;
+  WriteConnectivityCheck(&packet);
+  int num_expected_priorities = 0;
+  const double messages_per_second = webrtc::test::MeasureCallsPerSecond(
+      kNumIterations, [&packet, &num_expected_priorities] {
+        rtc::ByteBufferReader buf(packet.Data(), packet.Length());
+        IceMessage msg;
+        if (!msg.Read(&buf))
+          return;
+        const StunUInt32Attribute* priority = msg.GetUInt32(STUN_ATTR_PRIORITY);
+        num_expected_priorities += priority && priority->value() == kPriority;
+      });
+  EXPECT_EQ(kNumIterations, num_expected_priorities);
+
+  rtc::ByteBufferReader buf(packet.Data(), packet.Length());
+  IceMessage msg;
+  EXPECT_TRUE(msg.Read(&buf));
+  VerifyConnectivityCheck(packet, msg);
+  return static_cast<size_t>(messages_per_second * packet.Length() / 1000000);
+}
+
+// Returns the number of megabytes of STUN messages whose FINGERPRINT is
+// validated per second.
+size_t MeasureFingerprintMBPerSecond() {
+  rtc::ByteBufferWriter packet;
+  WriteConnectivityCheck(&packet);
+  int num_valid = 0;
+  const double messages_per_second = webrtc::test::MeasureCallsPerSecond(
+      kNumIterations, [&packet, &num_valid] {
+        num_valid +=
+            StunMessage::ValidateFingerprint(packet.Data(), packet.Length());
+      });
+  EXPECT_EQ(kNumIterations, num_valid);
+  return static_cast<size_t>(messages_per_second * packet.Length() / 1000000);
+}
+
+// Returns the number of megabytes of STUN messages whose MESSAGE-INTEGRITY is
+// validated per second, with the key derived once as a Connection does.
+size_t MeasureMessageIntegrityMBPerSecond() {
+  rtc::ByteBufferWriter packet;
+  WriteConnectivityCheck(&packet);
+  StunMessageIntegrityKey key;
+  key.SetPassword(kPassword);
+  int num_valid = 0;
+  const double messages_per_second = webrtc::test::MeasureCallsPerSecond(
+      kNumIterations, [&packet, &key, &num_valid] {
+        num_valid += StunMessage::ValidateMessageIntegrity(
+            packet.Data(), packet.Length(), key);
+      });
+  EXPECT_EQ(kNumIterations, num_valid);
+  return static_cast<size_t>(messages_per_second * packet.Length() / 1000000);
+}
+}  // namespace
+
+TEST(StunPerformanceTest, ReadConnectivityCheck) {
+  webrtc::test::PrintResult("stun_read", "", "connectivity_check",
+                            MeasureReadMBPerSecond(), "MB/s", true);
+}
+
+TEST(StunPerformanceTest, ValidateFingerprint) {
+  webrtc::test::PrintResult("stun_fingerprint", "", "connectivity_check",
+                            MeasureFingerprintMBPerSecond(), "MB/s", true);
+}
+
+TEST(StunPerformanceTest, ValidateMessageIntegrity) {
+  webrtc::test::PrintResult("stun_message_integrity", "", "connectivity_check",
+                            MeasureMessageIntegrityMBPerSecond(), "MB/s",
+                            true);
+}
+
+}  // namespace cricket
@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string.h>
+
 #include <string>
 
 #include "webrtc/p2p/base/stun.h"
@@ -17,6 +19,7 @@
 #include "webrtc/base/logging.h"
 #include "webrtc/base/messagedigest.h"
 #include "webrtc/base/socketaddress.h"
+#include "webrtc/base/timeutils.h"
 
 namespace cricket {
 
@@ -1299,6 +1302,198 @@ TEST_F(StunTest, AddFingerprint) {
       reinterpret_cast<const char*>(buf1.Data()), buf1.Length()));
 }
 
+// A precomputed key must give the same HMAC as computing it from scratch,
+// including for keys longer than a SHA-1 block.
+TEST_F(StunTest, MessageIntegrityKey) {
+  const char* data = reinterpret_cast<const char*>(kRfc5769SampleRequest);
+  const size_t size = sizeof(kRfc5769SampleRequest);
+  const uint16_t length = static_cast<uint16_t>(size - kStunHeaderSize);
+  const std::string keys[] = {"", kRfc5769SampleMsgPassword,
+                              std::string(100, 'k')};
+  for (const std::string& key : keys) {
+    char expected[kStunMessageIntegritySize];
+    ASSERT_EQ(sizeof(expected),
+              rtc::ComputeHmac(rtc::DIGEST_SHA_1, key.data(), key.size(),
+                               data, size, expected, sizeof(expected)));
+    char hmac[kStunMessageIntegritySize];
+    StunMessageIntegrityKey(key.data(), key.size())
+        .ComputeHmac(data, size, length, hmac);
+    EXPECT_EQ(0, memcmp(expected, hmac, sizeof(hmac)));
+  }
+
+  StunMessageIntegrityKey key;
+  key.SetPassword(kRfc5769SampleMsgPassword);
+  EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(data, size, key));
+  EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(
+      reinterpret_cast<const char*>(kRfc5769SampleResponse),
+      sizeof(kRfc5769SampleResponse), key));
+  key.SetPassword("InvalidPassword");
+  EXPECT_FALSE(StunMessage::ValidateMessageIntegrity(data, size, key));
+  key.SetPassword(kRfc5769SampleMsgPassword);
+  EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(data, size, key));
+
+  IceMessage msg;
+  rtc::ByteBufferReader buf(
+      reinterpret_cast<const char*>(kRfc5769SampleRequestWithoutMI),
+      sizeof(kRfc5769SampleRequestWithoutMI));
+  EXPECT_TRUE(msg.Read(&buf));
+  EXPECT_TRUE(msg.AddMessageIntegrity(key));
+  const StunByteStringAttribute* mi_attr =
+      msg.GetByteString(STUN_ATTR_MESSAGE_INTEGRITY);
+  EXPECT_EQ(0, memcmp(
+      mi_attr->bytes(), kCalculatedHmac1, sizeof(kCalculatedHmac1)));
+}
+
+// Read the RFC5769 sample STUN request through a StunMessageView.
+TEST_F(StunTest, ViewRfc5769RequestMessage) {
+  StunMessageView view;
+  ASSERT_TRUE(view.Parse(reinterpret_cast<const char*>(kRfc5769SampleRequest),
+                         sizeof(kRfc5769SampleRequest)));
+  EXPECT_EQ(STUN_BINDING_REQUEST, view.type());
+  EXPECT_EQ(sizeof(kRfc5769SampleRequest) - kStunHeaderSize, view.length());
+  EXPECT_FALSE(view.IsLegacy());
+  ASSERT_EQ(kStunTransactionIdLength, view.transaction_id_length());
+  EXPECT_EQ(0, memcmp(view.transaction_id(), kRfc5769SampleMsgTransactionId,
+                      kStunTransactionIdLength));
+
+  const char* username;
+  size_t username_length;
+  ASSERT_TRUE(view.GetByteString(STUN_ATTR_USERNAME, &username,
+                                 &username_length));
+  EXPECT_EQ(kRfc5769SampleMsgUsername,
+            std::string(username, username_length));
+
+  uint32_t fingerprint;
+  ASSERT_TRUE(view.GetUInt32(STUN_ATTR_FINGERPRINT, &fingerprint));
+  EXPECT_EQ(0xe57a3bcf, fingerprint);
+  uint64_t tie_breaker;
+  EXPECT_TRUE(view.GetUInt64(STUN_ATTR_ICE_CONTROLLED, &tie_breaker));
+  EXPECT_FALSE(view.HasAttribute(STUN_ATTR_ICE_CONTROLLING));
+  EXPECT_FALSE(view.GetUInt32(STUN_ATTR_USERNAME, &fingerprint));
+
+  EXPECT_TRUE(view.ValidateFingerprint());
+  EXPECT_TRUE(view.ValidateMessageIntegrity(
+      kRfc5769SampleMsgPassword, strlen(kRfc5769SampleMsgPassword)));
+  EXPECT_FALSE(view.ValidateMessageIntegrity("InvalidPassword", 15));
+}
+
+// Read the XOR-MAPPED-ADDRESS of the RFC5769 responses through a view.
+TEST_F(StunTest, ViewRfc5769ResponseMessages) {
+  StunMessageView view;
+  rtc::SocketAddress address;
+  ASSERT_TRUE(view.Parse(reinterpret_cast<const char*>(kRfc5769SampleResponse),
+                         sizeof(kRfc5769SampleResponse)));
+  EXPECT_EQ(STUN_BINDING_RESPONSE, view.type());
+  ASSERT_TRUE(view.GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS, &address));
+  EXPECT_EQ(kRfc5769SampleMsgMappedAddress, address);
+  EXPECT_FALSE(view.GetAddress(STUN_ATTR_MAPPED_ADDRESS, &address));
+  EXPECT_TRUE(view.ValidateMessageIntegrity(
+      kRfc5769SampleMsgPassword, strlen(kRfc5769SampleMsgPassword)));
+
+  ASSERT_TRUE(
+      view.Parse(reinterpret_cast<const char*>(kRfc5769SampleResponseIPv6),
+                 sizeof(kRfc5769SampleResponseIPv6)));
+  ASSERT_TRUE(view.GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS, &address));
+  EXPECT_EQ(kRfc5769SampleMsgIPv6MappedAddress, address);
+  EXPECT_TRUE(view.ValidateMessageIntegrity(
+      kRfc5769SampleMsgPassword, strlen(kRfc5769SampleMsgPassword)));
+
+  ASSERT_TRUE(
+      view.Parse(reinterpret_cast<const char*>(kStunMessageWithErrorAttribute),
+                 sizeof(kStunMessageWithErrorAttribute)));
+  int code;
+  ASSERT_TRUE(view.GetErrorCode(&code));
+  EXPECT_EQ(kTestErrorCode, code);
+}
+
+TEST_F(StunTest, ViewFailsOnInvalidMessages) {
+  StunMessageView view;
+  EXPECT_FALSE(view.Parse(reinterpret_cast<const char*>(kRtcpPacket),
+                          sizeof(kRtcpPacket)));
+  EXPECT_FALSE(
+      view.Parse(reinterpret_cast<const char*>(kStunMessageWithZeroLength),
+                 kRealLengthOfInvalidLengthTestCases));
+  EXPECT_FALSE(
+      view.Parse(reinterpret_cast<const char*>(kStunMessageWithExcessLength),
+                 kRealLengthOfInvalidLengthTestCases));
+  EXPECT_FALSE(
+      view.Parse(reinterpret_cast<const char*>(kStunMessageWithSmallLength),
+                 kRealLengthOfInvalidLengthTestCases));
+  EXPECT_FALSE(view.Parse(reinterpret_cast<const char*>(kRfc5769SampleRequest),
+                          kStunHeaderSize - 1));
+
+  // Munging a single bit up to the end of the M-I attribute either fails to
+  // parse or fails the check.
+  char buf[sizeof(kRfc5769SampleRequest)];
+  memcpy(buf, kRfc5769SampleRequest, sizeof(kRfc5769SampleRequest));
+  const size_t mi_end = sizeof(buf) - 8;
+  for (size_t i = 0; i < mi_end; ++i) {
+    buf[i] ^= 0x01;
+    if (i > 0)
+      buf[i - 1] ^= 0x01;
+    EXPECT_FALSE(view.Parse(buf, sizeof(buf)) &&
+                 view.ValidateMessageIntegrity(
+                     kRfc5769SampleMsgPassword,
+                     strlen(kRfc5769SampleMsgPassword)));
+  }
+  buf[mi_end - 1] ^= 0x01;
+  ASSERT_TRUE(view.Parse(buf, sizeof(buf)));
+  EXPECT_TRUE(view.ValidateMessageIntegrity(
+      kRfc5769SampleMsgPassword, strlen(kRfc5769SampleMsgPassword)));
+}
+
+// Compares parsing and validating a connectivity check with StunMessage and
+// with StunMessageView.
+// Disabled because it takes too long to run routinely. Use for performance
+// benchmarking when needed.
+TEST_F(StunTest, DISABLED_ParseAndValidateThroughput) {
+  const int kNumIterations = 20000;
+  const char* data = reinterpret_cast<const char*>(kRfc5769SampleRequest);
+  const size_t size = sizeof(kRfc5769SampleRequest);
+  const std::string password(kRfc5769SampleMsgPassword);
+
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    IceMessage msg;
+    rtc::ByteBufferReader buf(data, size);
+    ASSERT_TRUE(StunMessage::ValidateFingerprint(data, size));
+    ASSERT_TRUE(msg.Read(&buf));
+    ASSERT_TRUE(msg.GetByteString(STUN_ATTR_USERNAME) != NULL);
+    ASSERT_TRUE(StunMessage::ValidateMessageIntegrity(data, size, password));
+  }
+  int64_t message_us = rtc::TimeMicros() - start_us;
+
+  start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    StunMessageView view;
+    const char* username;
+    size_t username_length;
+    ASSERT_TRUE(view.Parse(data, size));
+    ASSERT_TRUE(view.ValidateFingerprint());
+    ASSERT_TRUE(view.GetByteString(STUN_ATTR_USERNAME, &username,
+                                   &username_length));
+    ASSERT_TRUE(view.ValidateMessageIntegrity(password.data(),
+                                              password.size()));
+  }
+  int64_t view_us = rtc::TimeMicros() - start_us;
+
+  StunMessageIntegrityKey key;
+  key.SetPassword(password);
+  start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    StunMessageView view;
+    ASSERT_TRUE(view.Parse(data, size));
+    ASSERT_TRUE(view.ValidateFingerprint());
+    ASSERT_TRUE(view.ValidateMessageIntegrity(key));
+  }
+  int64_t cached_key_us = rtc::TimeMicros() - start_us;
+
+  LOG(LS_INFO) << "Parsed and validated " << kNumIterations << " requests in "
+               << message_us << " us with StunMessage, " << view_us
+               << " us with StunMessageView, " << cached_key_us
+               << " us with a cached key.";
+}
+
 // Sample "GTURN" relay message.
 static const unsigned char kRelayMessage[] = {
   0x00, 0x01, 0x00, 88,    // message header
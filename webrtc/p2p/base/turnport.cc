@@ -918,6 +918,18 @@ int TurnPort::Send(const void* data, size_t len,
   return socket_->SendTo(data, len, server_address_.address, options);
 }
 
+int TurnPort::SendChannelData(int channel_id,
+                              const void* data,
+                              size_t size,
+                              const rtc::PacketOptions& options) {
+  channel_data_buffer_.SetSize(TURN_CHANNEL_HEADER_SIZE + size);
+  uint8_t* frame = channel_data_buffer_.data();
+  rtc::SetBE16(frame, static_cast<uint16_t>(channel_id));
+  rtc::SetBE16(frame + 2, static_cast<uint16_t>(size));
+  memcpy(frame + TURN_CHANNEL_HEADER_SIZE, data, size);
+  return Send(frame, channel_data_buffer_.size(), options);
+}
+
 void TurnPort::UpdateHash() {
   VERIFY(ComputeStunCredentialHash(credentials_.username, realm_,
                                    credentials_.password, &hash_));
@@ -1438,9 +1450,9 @@ void TurnEntry::SendChannelBindRequest(int delay) {
 
 int TurnEntry::Send(const void* data, size_t size, bool payload,
                     const rtc::PacketOptions& options) {
-  rtc::ByteBufferWriter buf;
   if (state_ != STATE_BOUND) {
     // If we haven't bound the channel yet, we have to use a Send Indication.
+    rtc::ByteBufferWriter buf;
     TurnMessage msg;
     msg.SetType(TURN_SEND_INDICATION);
     msg.SetTransactionID(
@@ -1456,13 +1468,10 @@ int TurnEntry::Send(const void* data, size_t size, bool payload,
       SendChannelBindRequest(0);
       state_ = STATE_BINDING;
     }
-  } else {
-    // If the channel is bound, we can send the data as a Channel Message.
-    buf.WriteUInt16(channel_id_);
-    buf.WriteUInt16(static_cast<uint16_t>(size));
-    buf.WriteBytes(reinterpret_cast<const char*>(data), size);
+    return port_->Send(buf.Data(), buf.Length(), options);
   }
-  return port_->Send(buf.Data(), buf.Length(), options);
+  // If the channel is bound, we can send the data as a Channel Message.
+  return port_->SendChannelData(channel_id_, data, size, options);
 }
 
 void TurnEntry::OnCreatePermissionSuccess() {
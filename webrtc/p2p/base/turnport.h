@@ -18,6 +18,7 @@
 
 #include "webrtc/base/asyncinvoker.h"
 #include "webrtc/base/asyncpacketsocket.h"
+#include "webrtc/base/buffer.h"
 #include "webrtc/p2p/base/port.h"
 #include "webrtc/p2p/client/basicportallocator.h"
 
@@ -228,6 +229,11 @@ class TurnPort : public Port {
   void SendRequest(StunRequest* request, int delay);
   int Send(const void* data, size_t size,
            const rtc::PacketOptions& options);
+  // Sends |data| to the peer bound to |channel_id| as a ChannelData message.
+  int SendChannelData(int channel_id,
+                      const void* data,
+                      size_t size,
+                      const rtc::PacketOptions& options);
   void UpdateHash();
   bool UpdateNonce(StunMessage* response);
   void ResetNonce();
@@ -265,6 +271,8 @@ class TurnPort : public Port {
 
   int next_channel_number_;
   EntryList entries_;
+  // Reused to frame the ChannelData messages sent to the server.
+  rtc::Buffer channel_data_buffer_;
 
   PortState state_;
   // By default the value will be set to 0. This value will be used in
@@ -11,6 +11,7 @@
 #include <dirent.h>
 #endif
 
+#include <algorithm>
 #include <memory>
 
 #include "webrtc/p2p/base/basicpacketsocketfactory.h"
@@ -31,6 +32,7 @@
 #include "webrtc/base/socketaddress.h"
 #include "webrtc/base/ssladapter.h"
 #include "webrtc/base/thread.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/base/virtualsocketserver.h"
 
 using rtc::SocketAddress;
@@ -957,6 +959,43 @@ TEST_F(TurnPortTest, TestTurnSendDataTurnTcpToUdp) {
             turn_port_->Candidates()[0].relay_protocol());
 }
 
+// Relays a burst of packets in both directions through a UDP allocation and
+// logs the packet rate the server sustained, as a load test of the relay data
+// path.
+TEST_F(TurnPortTest, TestTurnRelayThroughput) {
+  CreateTurnPort(kTurnUsername, kTurnPassword, kTurnUdpProtoAddr);
+  PrepareTurnAndUdpPorts();
+  Connection* conn1 = turn_port_->CreateConnection(udp_port_->Candidates()[0],
+                                                   Port::ORIGIN_MESSAGE);
+  Connection* conn2 = udp_port_->CreateConnection(turn_port_->Candidates()[0],
+                                                  Port::ORIGIN_MESSAGE);
+  ASSERT_TRUE(conn1 != NULL);
+  ASSERT_TRUE(conn2 != NULL);
+  conn1->SignalReadPacket.connect(static_cast<TurnPortTest*>(this),
+                                  &TurnPortTest::OnTurnReadPacket);
+  conn2->SignalReadPacket.connect(static_cast<TurnPortTest*>(this),
+                                  &TurnPortTest::OnUdpReadPacket);
+  conn1->Ping(0);
+  EXPECT_EQ_WAIT(Connection::STATE_WRITABLE, conn1->write_state(), kTimeout);
+  conn2->Ping(0);
+  EXPECT_EQ_WAIT(Connection::STATE_WRITABLE, conn2->write_state(), kTimeout);
+
+  const size_t kNumPackets = 1000;
+  unsigned char buf[1000] = {0};
+  const int64_t start_ms = rtc::TimeMillis();
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    conn1->Send(buf, sizeof(buf), options);
+    conn2->Send(buf, sizeof(buf), options);
+    main_->ProcessMessages(0);
+  }
+  ASSERT_EQ_WAIT(kNumPackets, turn_packets_.size(), 10 * kTimeout);
+  ASSERT_EQ_WAIT(kNumPackets, udp_packets_.size(), 10 * kTimeout);
+  const int64_t elapsed_ms = std::max<int64_t>(rtc::TimeSince(start_ms), 1);
+  LOG(LS_INFO) << "Relayed " << 2 * kNumPackets << " packets in " << elapsed_ms
+               << " ms, " << 2 * kNumPackets * 1000 / elapsed_ms
+               << " packets/s.";
+}
+
 // Test TURN fails to make a connection from IPv6 address to a server which has
 // IPv4 address.
 TEST_F(TurnPortTest, TestTurnLocalIPv6AddressServerIPv4) {
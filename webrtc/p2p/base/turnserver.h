@@ -11,20 +11,20 @@
 #ifndef WEBRTC_P2P_BASE_TURNSERVER_H_
 #define WEBRTC_P2P_BASE_TURNSERVER_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 #include "webrtc/p2p/base/portinterface.h"
 #include "webrtc/base/asyncpacketsocket.h"
+#include "webrtc/base/buffer.h"
 #include "webrtc/base/messagequeue.h"
 #include "webrtc/base/sigslot.h"
 #include "webrtc/base/socketaddress.h"
 
 namespace rtc {
-class ByteBufferWriter;
 class PacketSocketFactory;
 class Thread;
 }
@@ -51,6 +51,12 @@ class TurnServerConnection {
   bool operator<(const TurnServerConnection& t) const;
   std::string ToString() const;
 
+  // Hashes this connection, so allocations can be kept in a hash table.
+  size_t Hash() const;
+  struct Hasher {
+    size_t operator()(const TurnServerConnection& c) const { return c.Hash(); }
+  };
+
  private:
   rtc::SocketAddress src_;
   rtc::SocketAddress dst_;
@@ -91,8 +97,22 @@ class TurnServerAllocation : public rtc::MessageHandler,
  private:
   class Channel;
   class Permission;
-  typedef std::list<Permission*> PermissionList;
-  typedef std::list<Channel*> ChannelList;
+  struct IPAddressHasher {
+    size_t operator()(const rtc::IPAddress& ip) const { return rtc::HashIP(ip); }
+  };
+  struct SocketAddressHasher {
+    size_t operator()(const rtc::SocketAddress& addr) const {
+      return addr.Hash();
+    }
+  };
+  // Relayed packets are looked up by peer IP (permissions), by channel number
+  // (channel data from the client) and by peer address (packets from the
+  // peer), so all of these are hash indexed.
+  typedef std::unordered_map<rtc::IPAddress, Permission*, IPAddressHasher>
+      PermissionMap;
+  typedef std::unordered_map<int, Channel*> ChannelIdMap;
+  typedef std::unordered_map<rtc::SocketAddress, Channel*, SocketAddressHasher>
+      ChannelAddressMap;
 
   void HandleAllocateRequest(const TurnMessage* msg);
   void HandleRefreshRequest(const TurnMessage* msg);
@@ -132,8 +152,11 @@ class TurnServerAllocation : public rtc::MessageHandler,
   std::string username_;
   std::string origin_;
   std::string last_nonce_;
-  PermissionList perms_;
-  ChannelList channels_;
+  PermissionMap perms_;
+  ChannelIdMap channels_by_id_;
+  ChannelAddressMap channels_by_peer_;
+  // Reused to frame the ChannelData messages relayed to the client.
+  rtc::Buffer channel_data_buffer_;
 };
 
 // An interface through which the MD5 credential hash can be retrieved.
@@ -161,7 +184,9 @@ class TurnRedirectInterface {
 // Not yet wired up: TCP support.
 class TurnServer : public sigslot::has_slots<> {
  public:
-  typedef std::map<TurnServerConnection, TurnServerAllocation*> AllocationMap;
+  typedef std::unordered_map<TurnServerConnection,
+                             TurnServerAllocation*,
+                             TurnServerConnection::Hasher> AllocationMap;
 
   explicit TurnServer(rtc::Thread* thread);
   ~TurnServer();
@@ -248,7 +273,7 @@ class TurnServer : public sigslot::has_slots<> {
                                             const rtc::SocketAddress& addr);
 
   void SendStun(TurnServerConnection* conn, StunMessage* msg);
-  void Send(TurnServerConnection* conn, const rtc::ByteBufferWriter& buf);
+  void Send(TurnServerConnection* conn, const char* data, size_t size);
 
   void OnAllocationDestroyed(TurnServerAllocation* allocation);
   void DestroyInternalSocket(rtc::AsyncPacketSocket* socket);
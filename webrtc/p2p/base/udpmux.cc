@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/p2p/base/udpmux.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "webrtc/p2p/base/stun.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
+
+namespace cricket {
+
+// A socket handed out to one ICE session. Sends go out through the shared
+// socket and reads are whatever the UdpMux routes to it.
+class UdpMux::MuxedSocket : public rtc::AsyncPacketSocket {
+ public:
+  MuxedSocket(UdpMux* mux, const std::string& ufrag)
+      : mux_(mux), ufrag_(ufrag) {}
+  ~MuxedSocket() override { mux_->RemoveSocket(this); }
+
+  const std::string& ufrag() const { return ufrag_; }
+  std::vector<rtc::SocketAddress>* remote_addresses() {
+    return &remote_addresses_;
+  }
+
+  rtc::SocketAddress GetLocalAddress() const override {
+    return mux_->GetLocalAddress();
+  }
+  rtc::SocketAddress GetRemoteAddress() const override {
+    return rtc::SocketAddress();
+  }
+  int Send(const void* pv,
+           size_t cb,
+           const rtc::PacketOptions& options) override {
+    // Only SendTo makes sense on an unconnected UDP socket.
+    error_ = ENOTCONN;
+    return -1;
+  }
+  int SendTo(const void* pv,
+             size_t cb,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options) override {
+    int ret = mux_->SendTo(this, pv, cb, addr, options);
+    if (ret < 0) {
+      error_ = mux_->socket_->GetError();
+    }
+    return ret;
+  }
+  int Close() override { return 0; }
+  State GetState() const override { return mux_->socket_->GetState(); }
+  // Options apply to the shared socket, and so to every session on it.
+  int GetOption(rtc::Socket::Option opt, int* value) override {
+    return mux_->socket_->GetOption(opt, value);
+  }
+  int SetOption(rtc::Socket::Option opt, int value) override {
+    return mux_->socket_->SetOption(opt, value);
+  }
+  int GetError() const override { return error_; }
+  void SetError(int error) override { error_ = error; }
+
+ private:
+  UdpMux* mux_;
+  std::string ufrag_;
+  std::vector<rtc::SocketAddress> remote_addresses_;
+  int error_ = 0;
+};
+
+UdpMux::UdpMux(rtc::AsyncPacketSocket* socket) : socket_(socket) {
+  RTC_DCHECK(socket_);
+  socket_->SignalReadPacket.connect(this, &UdpMux::OnReadPacket);
+  socket_->SignalSentPacket.connect(this, &UdpMux::OnSentPacket);
+  socket_->SignalReadyToSend.connect(this, &UdpMux::OnReadyToSend);
+}
+
+UdpMux::~UdpMux() {
+  RTC_DCHECK(sockets_by_ufrag_.empty());
+}
+
+rtc::SocketAddress UdpMux::GetLocalAddress() const {
+  return socket_->GetLocalAddress();
+}
+
+rtc::AsyncPacketSocket* UdpMux::CreateSocket(const std::string& ufrag) {
+  if (sockets_by_ufrag_.find(ufrag) != sockets_by_ufrag_.end()) {
+    LOG(LS_WARNING) << "UdpMux: ufrag " << ufrag << " is already in use.";
+    return nullptr;
+  }
+  MuxedSocket* socket = new MuxedSocket(this, ufrag);
+  sockets_by_ufrag_[ufrag] = socket;
+  return socket;
+}
+
+int UdpMux::SendTo(MuxedSocket* socket,
+                   const void* data,
+                   size_t size,
+                   const rtc::SocketAddress& addr,
+                   const rtc::PacketOptions& options) {
+  // Let the replies to our own checks find their way back, unless another
+  // session is already talking to this address.
+  if (sockets_by_address_.find(addr) == sockets_by_address_.end()) {
+    AddRemoteAddress(socket, addr);
+  }
+  sending_socket_ = socket;
+  int ret = socket_->SendTo(data, size, addr, options);
+  sending_socket_ = nullptr;
+  return ret;
+}
+
+void UdpMux::AddRemoteAddress(MuxedSocket* socket,
+                              const rtc::SocketAddress& addr) {
+  MuxedSocket*& owner = sockets_by_address_[addr];
+  if (owner == socket) {
+    return;
+  }
+  // A previous owner keeps a stale entry in its list, which RemoveSocket
+  // skips.
+  owner = socket;
+  socket->remote_addresses()->push_back(addr);
+}
+
+void UdpMux::RemoveSocket(MuxedSocket* socket) {
+  sockets_by_ufrag_.erase(socket->ufrag());
+  for (const rtc::SocketAddress& addr : *socket->remote_addresses()) {
+    auto it = sockets_by_address_.find(addr);
+    if (it != sockets_by_address_.end() && it->second == socket) {
+      sockets_by_address_.erase(it);
+    }
+  }
+}
+
+UdpMux::MuxedSocket* UdpMux::FindSocketForIceCheck(const char* data,
+                                                   size_t size) {
+  StunMessageView msg;
+  if (!msg.Parse(data, size) || msg.type() != STUN_BINDING_REQUEST) {
+    return nullptr;
+  }
+  // ICE checks carry "<receiver ufrag>:<sender ufrag>".
+  const char* username;
+  size_t username_length;
+  if (!msg.GetByteString(STUN_ATTR_USERNAME, &username, &username_length)) {
+    return nullptr;
+  }
+  const char* colon =
+      static_cast<const char*>(memchr(username, ':', username_length));
+  if (!colon) {
+    return nullptr;
+  }
+  auto it = sockets_by_ufrag_.find(std::string(username, colon));
+  return it != sockets_by_ufrag_.end() ? it->second : nullptr;
+}
+
+void UdpMux::OnReadPacket(rtc::AsyncPacketSocket* socket,
+                          const char* data,
+                          size_t size,
+                          const rtc::SocketAddress& remote_addr,
+                          const rtc::PacketTime& packet_time) {
+  RTC_DCHECK(socket == socket_.get());
+  // A check names its session outright, even if the address is known to
+  // another one.
+  MuxedSocket* target = FindSocketForIceCheck(data, size);
+  if (target) {
+    AddRemoteAddress(target, remote_addr);
+  } else {
+    auto it = sockets_by_address_.find(remote_addr);
+    if (it == sockets_by_address_.end()) {
+      LOG(LS_VERBOSE) << "UdpMux: dropping packet from unknown address "
+                      << remote_addr.ToSensitiveString();
+      return;
+    }
+    target = it->second;
+  }
+  target->SignalReadPacket(target, data, size, remote_addr, packet_time);
+}
+
+void UdpMux::OnSentPacket(rtc::AsyncPacketSocket* socket,
+                          const rtc::SentPacket& sent_packet) {
+  if (sending_socket_) {
+    sending_socket_->SignalSentPacket(sending_socket_, sent_packet);
+  }
+}
+
+void UdpMux::OnReadyToSend(rtc::AsyncPacketSocket* socket) {
+  // Looked up again by ufrag, since a session may delete its socket from
+  // within the signal.
+  std::vector<std::string> ufrags;
+  for (const auto& kv : sockets_by_ufrag_) {
+    ufrags.push_back(kv.first);
+  }
+  for (const std::string& ufrag : ufrags) {
+    auto it = sockets_by_ufrag_.find(ufrag);
+    if (it != sockets_by_ufrag_.end()) {
+      it->second->SignalReadyToSend(it->second);
+    }
+  }
+}
+
+}  // namespace cricket
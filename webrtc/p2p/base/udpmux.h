@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_P2P_BASE_UDPMUX_H_
+#define WEBRTC_P2P_BASE_UDPMUX_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "webrtc/base/asyncpacketsocket.h"
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/sigslot.h"
+#include "webrtc/base/socketaddress.h"
+
+namespace cricket {
+
+// Shares one UDP socket between the host ports of many ICE sessions, so that a
+// server can terminate any number of PeerConnections on a single port.
+//
+// Each session gets its own AsyncPacketSocket from CreateSocket(). Incoming
+// STUN binding requests are routed by the local ufrag at the front of their
+// USERNAME, and the sender's address is then remembered for that session.
+// Any other packet is routed by the remote address alone, which a session
+// also claims the first time it sends to it. Packets from unknown addresses
+// that are not ICE checks are dropped.
+//
+// Since the ufrag is the only key, each ufrag may only be used by one socket
+// at a time; sessions with several components need rtcp-mux.
+//
+// All methods must be called on the thread that the shared socket uses.
+class UdpMux : public sigslot::has_slots<> {
+ public:
+  // Takes ownership of |socket|, which must be a bound UDP socket.
+  explicit UdpMux(rtc::AsyncPacketSocket* socket);
+  ~UdpMux() override;
+
+  rtc::SocketAddress GetLocalAddress() const;
+
+  // Returns a new socket that sends through the shared one and receives the
+  // packets meant for the ICE session using |ufrag|, or NULL if another socket
+  // already uses |ufrag|. The caller owns the socket and must delete it before
+  // the UdpMux.
+  rtc::AsyncPacketSocket* CreateSocket(const std::string& ufrag);
+
+  size_t num_sockets() const { return sockets_by_ufrag_.size(); }
+
+ private:
+  class MuxedSocket;
+
+  struct SocketAddressHasher {
+    size_t operator()(const rtc::SocketAddress& addr) const {
+      return addr.Hash();
+    }
+  };
+  typedef std::unordered_map<rtc::SocketAddress,
+                             MuxedSocket*,
+                             SocketAddressHasher> SocketAddressMap;
+
+  int SendTo(MuxedSocket* socket,
+             const void* data,
+             size_t size,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options);
+  void AddRemoteAddress(MuxedSocket* socket, const rtc::SocketAddress& addr);
+  void RemoveSocket(MuxedSocket* socket);
+  MuxedSocket* FindSocketForIceCheck(const char* data, size_t size);
+
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const rtc::PacketTime& packet_time);
+  void OnSentPacket(rtc::AsyncPacketSocket* socket,
+                    const rtc::SentPacket& sent_packet);
+  void OnReadyToSend(rtc::AsyncPacketSocket* socket);
+
+  std::unique_ptr<rtc::AsyncPacketSocket> socket_;
+  std::map<std::string, MuxedSocket*> sockets_by_ufrag_;
+  SocketAddressMap sockets_by_address_;
+  // The socket whose packet is being sent, to forward SignalSentPacket to.
+  MuxedSocket* sending_socket_ = nullptr;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(UdpMux);
+};
+
+}  // namespace cricket
+
+#endif  // WEBRTC_P2P_BASE_UDPMUX_H_
@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+
+#include "webrtc/p2p/base/stun.h"
+#include "webrtc/p2p/base/udpmux.h"
+#include "webrtc/base/asyncudpsocket.h"
+#include "webrtc/base/bytebuffer.h"
+#include "webrtc/base/gunit.h"
+#include "webrtc/base/helpers.h"
+#include "webrtc/base/testclient.h"
+#include "webrtc/base/thread.h"
+
+using namespace cricket;
+
+static const rtc::SocketAddress kLocalAddr("127.0.0.1", 0);
+static const char kData[] = "not a stun packet";
+
+class UdpMuxTest : public testing::Test {
+ protected:
+  UdpMuxTest()
+      : mux_(rtc::AsyncUDPSocket::Create(
+            rtc::Thread::Current()->socketserver(), kLocalAddr)) {}
+
+  rtc::TestClient* CreateRemote() {
+    return new rtc::TestClient(rtc::AsyncUDPSocket::Create(
+        rtc::Thread::Current()->socketserver(), kLocalAddr));
+  }
+
+  // Sends an ICE check for |local_ufrag| from |remote| to the mux.
+  void SendIceCheck(rtc::TestClient* remote, const std::string& local_ufrag) {
+    StunMessage req;
+    req.SetType(STUN_BINDING_REQUEST);
+    req.SetTransactionID(rtc::CreateRandomString(kStunTransactionIdLength));
+    req.AddAttribute(new StunByteStringAttribute(STUN_ATTR_USERNAME,
+                                                 local_ufrag + ":remote"));
+    rtc::ByteBufferWriter buf;
+    req.Write(&buf);
+    remote->SendTo(buf.Data(), buf.Length(), mux_.GetLocalAddress());
+  }
+
+  void SendData(rtc::TestClient* remote) {
+    remote->SendTo(kData, sizeof(kData), mux_.GetLocalAddress());
+  }
+
+  UdpMux mux_;
+};
+
+// ICE checks reach the session named by their USERNAME, and so do later
+// packets from the same address.
+TEST_F(UdpMuxTest, RoutesByUfragThenAddress) {
+  std::unique_ptr<rtc::TestClient> session1(
+      new rtc::TestClient(mux_.CreateSocket("ufrag1")));
+  std::unique_ptr<rtc::TestClient> session2(
+      new rtc::TestClient(mux_.CreateSocket("ufrag2")));
+  EXPECT_EQ(2u, mux_.num_sockets());
+  std::unique_ptr<rtc::TestClient> remote(CreateRemote());
+
+  SendIceCheck(remote.get(), "ufrag2");
+  std::unique_ptr<rtc::TestClient::Packet> packet(
+      session2->NextPacket(rtc::TestClient::kTimeoutMs));
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(remote->address(), packet->addr);
+
+  SendData(remote.get());
+  rtc::SocketAddress addr;
+  EXPECT_TRUE(session2->CheckNextPacket(kData, sizeof(kData), &addr));
+  EXPECT_EQ(remote->address(), addr);
+  EXPECT_TRUE(session1->CheckNoPacket());
+}
+
+// Replies to a session's own sends find their way back to it, and packets
+// from addresses no session knows are dropped.
+TEST_F(UdpMuxTest, RoutesRepliesToSender) {
+  std::unique_ptr<rtc::TestClient> session1(
+      new rtc::TestClient(mux_.CreateSocket("ufrag1")));
+  std::unique_ptr<rtc::TestClient> session2(
+      new rtc::TestClient(mux_.CreateSocket("ufrag2")));
+  std::unique_ptr<rtc::TestClient> remote1(CreateRemote());
+  std::unique_ptr<rtc::TestClient> remote2(CreateRemote());
+
+  session1->SendTo(kData, sizeof(kData), remote1->address());
+  rtc::SocketAddress addr;
+  EXPECT_TRUE(remote1->CheckNextPacket(kData, sizeof(kData), &addr));
+  EXPECT_EQ(mux_.GetLocalAddress(), addr);
+
+  SendData(remote1.get());
+  EXPECT_TRUE(session1->CheckNextPacket(kData, sizeof(kData), nullptr));
+
+  SendData(remote2.get());
+  EXPECT_TRUE(session1->CheckNoPacket());
+  EXPECT_TRUE(session2->CheckNoPacket());
+}
+
+// A ufrag can only be used by one socket at a time.
+TEST_F(UdpMuxTest, RejectsDuplicateUfrag) {
+  std::unique_ptr<rtc::AsyncPacketSocket> socket(mux_.CreateSocket("ufrag"));
+  ASSERT_TRUE(socket);
+  EXPECT_TRUE(mux_.CreateSocket("ufrag") == nullptr);
+  socket.reset();
+  EXPECT_EQ(0u, mux_.num_sockets());
+  socket.reset(mux_.CreateSocket("ufrag"));
+  EXPECT_TRUE(socket);
+}
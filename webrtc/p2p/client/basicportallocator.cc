@@ -21,11 +21,13 @@
 #include "webrtc/p2p/base/stunport.h"
 #include "webrtc/p2p/base/tcpport.h"
 #include "webrtc/p2p/base/turnport.h"
+#include "webrtc/p2p/base/udpmux.h"
 #include "webrtc/p2p/base/udpport.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/common.h"
 #include "webrtc/base/helpers.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/timeutils.h"
 
 using rtc::CreateRandomId;
 
@@ -199,6 +201,8 @@ void BasicPortAllocatorSession::StartGettingPorts() {
   }
 
   running_ = true;
+  start_time_ms_ = rtc::TimeMillis();
+  first_candidate_delay_ms_ = -1;
   network_thread_->Post(this, MSG_CONFIG_START);
 }
 
@@ -411,6 +415,14 @@ void BasicPortAllocatorSession::GetNetworks(
   } else {
     network_manager->GetNetworks(networks);
   }
+  if (flags() & PORTALLOCATOR_ENABLE_CONCURRENT_GATHERING) {
+    // Every network gathers at once, so start with the preferred ones to get
+    // their candidates out first.
+    std::stable_sort(networks->begin(), networks->end(),
+                     [](const rtc::Network* a, const rtc::Network* b) {
+                       return a->preference() > b->preference();
+                     });
+  }
   networks->erase(std::remove_if(networks->begin(), networks->end(),
                                  [this](rtc::Network* network) {
                                    return allocator_->network_ignore_mask() &
@@ -566,6 +578,12 @@ void BasicPortAllocatorSession::OnCandidateReady(
       data->sequence()->ProtocolEnabled(pvalue);
 
   if (CheckCandidateFilter(c) && candidate_protocol_enabled) {
+    if (first_candidate_delay_ms_ < 0) {
+      first_candidate_delay_ms_ = rtc::TimeMillis() - start_time_ms_;
+      LOG(LS_INFO) << "First candidate for " << content_name()
+                   << " gathered after " << first_candidate_delay_ms_
+                   << " ms.";
+    }
     std::vector<Candidate> candidates;
     candidates.push_back(SanitizeRelatedAddress(c));
     SignalCandidatesReady(this, candidates);
@@ -877,9 +895,12 @@ void AllocationSequence::OnMessage(rtc::Message* msg) {
 
   if (state() == kRunning) {
     ++phase_;
-    session_->network_thread()->PostDelayed(
-        session_->allocator()->step_delay(),
-        this, MSG_ALLOCATION_PHASE);
+    // When gathering concurrently the next phase runs as soon as the other
+    // sequences have had their turn, rather than after a step delay.
+    uint32_t delay = IsFlagSet(PORTALLOCATOR_ENABLE_CONCURRENT_GATHERING)
+                         ? 0
+                         : session_->allocator()->step_delay();
+    session_->network_thread()->PostDelayed(delay, this, MSG_ALLOCATION_PHASE);
   } else {
     // If all phases in AllocationSequence are completed, no allocation
     // steps needed further. Canceling  pending signal.
@@ -915,7 +936,22 @@ void AllocationSequence::CreateUDPPorts() {
   UDPPort* port = NULL;
   bool emit_local_candidate_for_anyaddress =
       !IsFlagSet(PORTALLOCATOR_DISABLE_DEFAULT_LOCAL_CANDIDATE);
-  if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET) && udp_socket_) {
+  UdpMux* udp_mux = session_->allocator()->udp_mux();
+  if (udp_mux && udp_mux->GetLocalAddress().ipaddr() == ip_ &&
+      !IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET)) {
+    // The port only carries host traffic on the shared socket; STUN and TURN
+    // keep sockets of their own, since their servers tell sessions apart by
+    // address.
+    mux_socket_.reset(udp_mux->CreateSocket(session_->username()));
+  }
+  if (mux_socket_) {
+    mux_socket_->SignalReadPacket.connect(this,
+                                          &AllocationSequence::OnMuxReadPacket);
+    port = UDPPort::Create(
+        session_->network_thread(), session_->socket_factory(), network_,
+        mux_socket_.get(), session_->username(), session_->password(),
+        session_->allocator()->origin(), emit_local_candidate_for_anyaddress);
+  } else if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET) && udp_socket_) {
     port = UDPPort::Create(
         session_->network_thread(), session_->socket_factory(), network_,
         udp_socket_.get(), session_->username(), session_->password(),
@@ -931,7 +967,10 @@ void AllocationSequence::CreateUDPPorts() {
   if (port) {
     // If shared socket is enabled, STUN candidate will be allocated by the
     // UDPPort.
-    if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET)) {
+    if (mux_socket_) {
+      udp_port_ = port;
+      port->SignalDestroyed.connect(this, &AllocationSequence::OnPortDestroyed);
+    } else if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET)) {
       udp_port_ = port;
       port->SignalDestroyed.connect(this, &AllocationSequence::OnPortDestroyed);
 
@@ -1141,6 +1180,17 @@ void AllocationSequence::OnReadPacket(
   }
 }
 
+void AllocationSequence::OnMuxReadPacket(
+    rtc::AsyncPacketSocket* socket, const char* data, size_t size,
+    const rtc::SocketAddress& remote_addr,
+    const rtc::PacketTime& packet_time) {
+  ASSERT(socket == mux_socket_.get());
+  if (udp_port_) {
+    udp_port_->HandleIncomingPacket(socket, data, size, remote_addr,
+                                    packet_time);
+  }
+}
+
 void AllocationSequence::OnPortDestroyed(PortInterface* port) {
   if (udp_port_ == port) {
     udp_port_ = NULL;
@@ -22,6 +22,8 @@
 
 namespace cricket {
 
+class UdpMux;
+
 class BasicPortAllocator : public PortAllocator {
  public:
   BasicPortAllocator(rtc::NetworkManager* network_manager,
@@ -53,6 +55,12 @@ class BasicPortAllocator : public PortAllocator {
   // creates its own socket factory.
   rtc::PacketSocketFactory* socket_factory() { return socket_factory_; }
 
+  // When set, sessions gathering on the network whose IP matches the UdpMux's
+  // local address take their host UDP socket from it instead of binding a new
+  // one. The UdpMux must outlive all sessions of this allocator.
+  void set_udp_mux(UdpMux* udp_mux) { udp_mux_ = udp_mux; }
+  UdpMux* udp_mux() const { return udp_mux_; }
+
   PortAllocatorSession* CreateSessionInternal(
       const std::string& content_name,
       int component,
@@ -69,6 +77,7 @@ class BasicPortAllocator : public PortAllocator {
   rtc::PacketSocketFactory* socket_factory_;
   bool allow_tcp_listen_;
   int network_ignore_mask_ = rtc::kDefaultNetworkIgnoreMask;
+  UdpMux* udp_mux_ = nullptr;
 };
 
 struct PortConfiguration;
@@ -98,6 +107,10 @@ class BasicPortAllocatorSession : public PortAllocatorSession,
   std::vector<Candidate> ReadyCandidates() const override;
   bool CandidatesAllocationDone() const override;
 
+  // Milliseconds from StartGettingPorts to the first candidate being signaled,
+  // or -1 if no candidate has been signaled yet.
+  int64_t first_candidate_delay_ms() const { return first_candidate_delay_ms_; }
+
  protected:
   void UpdateIceParametersInternal() override;
 
@@ -190,6 +203,8 @@ class BasicPortAllocatorSession : public PortAllocatorSession,
   std::vector<AllocationSequence*> sequences_;
   std::vector<PortData> ports_;
   uint32_t candidate_filter_ = CF_ALL;
+  int64_t start_time_ms_ = 0;
+  int64_t first_candidate_delay_ms_ = -1;
 
   friend class AllocationSequence;
 };
@@ -306,6 +321,12 @@ class AllocationSequence : public rtc::MessageHandler,
                     const rtc::SocketAddress& remote_addr,
                     const rtc::PacketTime& packet_time);
 
+  void OnMuxReadPacket(rtc::AsyncPacketSocket* socket,
+                       const char* data,
+                       size_t size,
+                       const rtc::SocketAddress& remote_addr,
+                       const rtc::PacketTime& packet_time);
+
   void OnPortDestroyed(PortInterface* port);
 
   BasicPortAllocatorSession* session_;
@@ -317,6 +338,8 @@ class AllocationSequence : public rtc::MessageHandler,
   uint32_t flags_;
   ProtocolList protocols_;
   std::unique_ptr<rtc::AsyncPacketSocket> udp_socket_;
+  // The host UDP port's socket when it is taken from a UdpMux.
+  std::unique_ptr<rtc::AsyncPacketSocket> mux_socket_;
   // There will be only one udp port per AllocationSequence.
   UDPPort* udp_port_;
   std::vector<TurnPort*> turn_ports_;
@@ -605,6 +605,24 @@ TEST_F(BasicPortAllocatorTest, TestGetAllPortsWithOneSecondStepDelay) {
   session_->StopGettingPorts();
 }
 
+// Verify that with concurrent gathering all candidates arrive without waiting
+// for the default step delay of 1sec between phases.
+TEST_F(BasicPortAllocatorTest, TestGetAllPortsConcurrently) {
+  AddInterface(kClientAddr);
+  allocator_->set_step_delay(kDefaultStepDelay);
+  allocator_->set_flags(allocator_->flags() |
+                        PORTALLOCATOR_ENABLE_CONCURRENT_GATHERING);
+  EXPECT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  session_->StartGettingPorts();
+  ASSERT_EQ_WAIT(7U, candidates_.size(), 500);
+  EXPECT_EQ(4U, ports_.size());
+  EXPECT_TRUE_WAIT(candidate_allocation_done_, 500);
+  BasicPortAllocatorSession* session =
+      static_cast<BasicPortAllocatorSession*>(session_.get());
+  EXPECT_GE(session->first_candidate_delay_ms(), 0);
+  EXPECT_LT(session->first_candidate_delay_ms(), 500);
+}
+
 TEST_F(BasicPortAllocatorTest, TestSetupVideoRtpPortsWithNormalSendBuffers) {
   AddInterface(kClientAddr);
   EXPECT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP, CN_VIDEO));
@@ -46,6 +46,8 @@
         'base/sessiondescription.cc',
         'base/sessiondescription.h',
         'base/sessionid.h',
+        'base/shardedturnserver.cc',
+        'base/shardedturnserver.h',
         'base/stun.cc',
         'base/stun.h',
         'base/stunport.cc',
@@ -72,6 +74,8 @@
         'base/turnport.h',
         'base/turnserver.cc',
         'base/turnserver.h',
+        'base/udpmux.cc',
+        'base/udpmux.h',
         'base/udpport.h',
         'client/basicportallocator.cc',
         'client/basicportallocator.h',
@@ -92,6 +96,15 @@
             'FEATURE_ENABLE_PSTN',
           ],
         }],
+        ['build_ssl==1', {
+          'dependencies': [
+            '<(DEPTH)/third_party/boringssl/boringssl.gyp:boringssl',
+          ],
+        }, {
+          'include_dirs': [
+            '<(ssl_root)',
+          ],
+        }],
         ['use_quic==1', {
       	  'dependencies': [
       	    '<(DEPTH)/third_party/libquic/libquic.gyp:libquic',
@@ -154,6 +167,7 @@
               'base/pseudotcp_unittest.cc',
               'base/relayport_unittest.cc',
               'base/relayserver_unittest.cc',
+              'base/shardedturnserver_unittest.cc',
               'base/stun_unittest.cc',
               'base/stunport_unittest.cc',
               'base/stunrequest_unittest.cc',
@@ -166,6 +180,7 @@
               'base/transportdescriptionfactory_unittest.cc',
               'base/tcpport_unittest.cc',
               'base/turnport_unittest.cc',
+              'base/udpmux_unittest.cc',
               'client/basicportallocator_unittest.cc',
               'stunprober/stunprober_unittest.cc',
             ],
@@ -50,6 +50,43 @@ rtc::StreamResult ReliableQuicStream::Write(const char* data,
   return rtc::StreamResult(rtc::SR_SUCCESS);
 }
 
+rtc::StreamResult ReliableQuicStream::Writev(const struct iovec* iov,
+                                             int iov_count,
+                                             bool fin) {
+  size_t offset = 0;
+  bool fin_consumed = false;
+  // Data that is already queued must be sent first, so only write directly
+  // when nothing is buffered.
+  if (!HasBufferedData()) {
+    net::QuicConsumedData consumed = WritevData(iov, iov_count, fin, nullptr);
+    offset = consumed.bytes_consumed;
+    fin_consumed = consumed.fin_consumed;
+  }
+  // Buffer whatever was not consumed.
+  for (int i = 0; i < iov_count; ++i) {
+    if (offset >= iov[i].iov_len) {
+      offset -= iov[i].iov_len;
+      continue;
+    }
+    bool last = (i == iov_count - 1);
+    WriteOrBufferData(
+        base::StringPiece(static_cast<const char*>(iov[i].iov_base) + offset,
+                          iov[i].iov_len - offset),
+        fin && last, nullptr);
+    offset = 0;
+    if (last) {
+      fin_consumed = fin;
+    }
+  }
+  if (fin && !fin_consumed) {
+    WriteOrBufferData(base::StringPiece(), true, nullptr);
+  }
+  if (HasBufferedData()) {
+    return rtc::StreamResult(rtc::SR_BLOCK);
+  }
+  return rtc::StreamResult(rtc::SR_SUCCESS);
+}
+
 void ReliableQuicStream::Close() {
   net::ReliableQuicStream::session()->CloseStream(id());
 }
@@ -36,6 +36,12 @@ class ReliableQuicStream : public net::ReliableQuicStream,
   // of writing, in which case the data is queued until OnCanWrite() is called.
   // If |fin| == true, then this stream closes after sending data.
   rtc::StreamResult Write(const char* data, size_t len, bool fin = false);
+  // Same as Write(), but for data gathered from |iov_count| buffers. The
+  // buffers are handed to the QuicSession without copying them; only the part
+  // the session could not consume right away is copied into the queue.
+  rtc::StreamResult Writev(const struct iovec* iov,
+                           int iov_count,
+                           bool fin = false);
   // Removes this stream from the QuicSession's stream map.
   void Close();
 
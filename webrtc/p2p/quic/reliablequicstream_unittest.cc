@@ -10,6 +10,8 @@
 
 #include "webrtc/p2p/quic/reliablequicstream.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -70,10 +72,15 @@ class MockQuicSession : public QuicSession {
       return QuicConsumedData(0, false);
     }
 
-    const char* data = reinterpret_cast<const char*>(iovector.iov->iov_base);
-    size_t len = iovector.total_length;
-    write_buffer_->append(data, len);
-    return QuicConsumedData(len, false);
+    size_t len = 0;
+    for (int i = 0; i < iovector.iov_count; ++i) {
+      const struct iovec& iov = iovector.iov[i];
+      size_t iov_len = std::min(iov.iov_len, write_budget_ - len);
+      write_buffer_->append(static_cast<const char*>(iov.iov_base), iov_len);
+      len += iov_len;
+    }
+    write_budget_ -= len;
+    return QuicConsumedData(len, fin && len == iovector.total_length);
   }
 
   net::ReliableQuicStream* CreateIncomingDynamicStream(
@@ -96,6 +103,10 @@ class MockQuicSession : public QuicSession {
   // Sets whether data is written to buffer, or else if this is write blocked.
   void set_writable(bool writable) { writable_ = writable; }
 
+  // Limits how many more bytes are written to buffer before the session acts
+  // as if it was write blocked.
+  void set_write_budget(size_t write_budget) { write_budget_ = write_budget; }
+
   // Tracks whether the stream is write blocked and its priority.
   void register_write_blocked_stream(QuicStreamId stream_id,
                                      SpdyPriority priority) {
@@ -107,6 +118,8 @@ class MockQuicSession : public QuicSession {
   std::string* write_buffer_;
   // Whether data is written to write_buffer_.
   bool writable_ = true;
+  // Number of bytes that can still be written to write_buffer_.
+  size_t write_budget_ = std::numeric_limits<size_t>::max();
 };
 
 // Packet writer that does nothing. This is required for QuicConnection but
@@ -229,6 +242,41 @@ TEST_F(ReliableQuicStreamTest, BufferData) {
   EXPECT_EQ("Foo barxyzzy", write_buffer_);
 }
 
+// Write a string gathered from several buffers.
+TEST_F(ReliableQuicStreamTest, WritevData) {
+  CreateReliableQuicStream();
+  char foo[] = "Foo ";
+  char bar[] = "bar";
+  struct iovec iov[2] = {{foo, 4}, {bar, 3}};
+  EXPECT_EQ(SR_SUCCESS, stream_->Writev(iov, 2));
+  EXPECT_EQ("Foo bar", write_buffer_);
+  EXPECT_FALSE(stream_->HasBufferedData());
+}
+
+// Test that only the data not consumed by the session is buffered, and that it
+// is sent in order.
+TEST_F(ReliableQuicStreamTest, WritevBuffersRemainder) {
+  CreateReliableQuicStream();
+  char foo[] = "Foo ";
+  char bar[] = "bar";
+  struct iovec iov[2] = {{foo, 4}, {bar, 3}};
+
+  session_->set_write_budget(5);
+  EXPECT_EQ(SR_BLOCK, stream_->Writev(iov, 2));
+  EXPECT_EQ("Foo b", write_buffer_);
+  EXPECT_TRUE(stream_->HasBufferedData());
+
+  session_->set_writable(false);
+  EXPECT_EQ(SR_BLOCK, stream_->Writev(iov, 2));
+  EXPECT_EQ("Foo b", write_buffer_);
+
+  session_->set_writable(true);
+  session_->set_write_budget(std::numeric_limits<size_t>::max());
+  stream_->OnCanWrite();
+  EXPECT_FALSE(stream_->HasBufferedData());
+  EXPECT_EQ("Foo barFoo bar", write_buffer_);
+}
+
 // Read an entire string.
 TEST_F(ReliableQuicStreamTest, ReadDataWhole) {
   CreateReliableQuicStream();
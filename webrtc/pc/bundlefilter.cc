@@ -35,15 +35,20 @@ bool BundleFilter::DemuxPacket(const uint8_t* data, size_t len) {
 }
 
 void BundleFilter::AddPayloadType(int payload_type) {
-  payload_types_.insert(payload_type);
+  // Other values can't be the payload type of an RTP packet.
+  if (payload_type >= 0 &&
+      payload_type < static_cast<int>(payload_types_.size())) {
+    payload_types_.set(payload_type);
+  }
 }
 
 bool BundleFilter::FindPayloadType(int pl_type) const {
-  return payload_types_.find(pl_type) != payload_types_.end();
+  return pl_type >= 0 && pl_type < static_cast<int>(payload_types_.size()) &&
+         payload_types_.test(pl_type);
 }
 
 void BundleFilter::ClearAllPayloadTypes() {
-  payload_types_.clear();
+  payload_types_.reset();
 }
 
 }  // namespace cricket
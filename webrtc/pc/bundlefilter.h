@@ -13,7 +13,7 @@
 
 #include <stdint.h>
 
-#include <set>
+#include <bitset>
 #include <vector>
 
 #include "webrtc/base/basictypes.h"
@@ -29,7 +29,8 @@ namespace cricket {
 //
 // This class determines whether a packet is destined for cricket::BaseChannel.
 // This is only to be used for RTP packets as RTCP packets are not filtered.
-// For RTP packets, this is decided based on the payload type.
+// For RTP packets, this is decided based on the payload type, which is looked
+// up in a table of all 128 RTP payload types.
 class BundleFilter {
  public:
   BundleFilter();
@@ -46,7 +47,7 @@ class BundleFilter {
   void ClearAllPayloadTypes();
 
  private:
-  std::set<int> payload_types_;
+  std::bitset<128> payload_types_;
 };
 
 }  // namespace cricket
@@ -70,3 +70,13 @@ TEST(BundleFilterTest, InvalidRtpPacket) {
   cricket::BundleFilter bundle_filter;
   EXPECT_FALSE(bundle_filter.DemuxPacket(kSctpPacket, sizeof(kSctpPacket)));
 }
+
+TEST(BundleFilterTest, IgnoresPayloadTypesOutOfRange) {
+  cricket::BundleFilter bundle_filter;
+  bundle_filter.AddPayloadType(-1);
+  bundle_filter.AddPayloadType(128);
+  EXPECT_FALSE(bundle_filter.FindPayloadType(-1));
+  EXPECT_FALSE(bundle_filter.FindPayloadType(128));
+  bundle_filter.AddPayloadType(127);
+  EXPECT_TRUE(bundle_filter.FindPayloadType(127));
+}
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <set>
 #include <utility>
 
 #include "webrtc/pc/channel.h"
@@ -117,6 +118,16 @@ static const MediaContentDescription* GetContentDescription(
   return static_cast<const MediaContentDescription*>(cinfo->description);
 }
 
+// Returns every SSRC used by |streams|, so that stream lists can be diffed
+// without a linear search per stream.
+static std::set<uint32_t> GetAllSsrcs(const StreamParamsVec& streams) {
+  std::set<uint32_t> ssrcs;
+  for (const StreamParams& stream : streams) {
+    ssrcs.insert(stream.ssrcs.begin(), stream.ssrcs.end());
+  }
+  return ssrcs;
+}
+
 template <class Codec>
 void RtpParametersFromMediaDescription(
     const MediaContentDescriptionImpl<Codec>* desc,
@@ -555,7 +566,8 @@ void BaseChannel::OnChannelRead(TransportChannel* channel,
   // When using RTCP multiplexing we might get RTCP packets on the RTP
   // transport. We feed RTP traffic into the demuxer to determine if it is RTCP.
   bool rtcp = PacketIsRtcp(channel, data, len);
-  rtc::CopyOnWriteBuffer packet(data, len);
+  rtc::CopyOnWriteBuffer packet(data, len,
+                                rtc::CopyOnWriteBuffer::PooledCapacity(len));
   HandlePacket(rtcp, &packet, packet_time);
 }
 
@@ -682,6 +694,16 @@ bool BaseChannel::SendPacket(bool rtcp,
 #else
       updated_options.packet_time_params.rtp_sendtime_extension_id =
           rtp_abs_sendtime_extn_id_;
+      // The RTP header isn't encrypted, so the send time extension can be
+      // located now rather than by the socket layer for every packet.
+      size_t extension_offset;
+      if (rtp_abs_sendtime_extn_id_ != -1 &&
+          ValidateRtpHeader(data, len, nullptr) &&
+          FindRtpAbsSendTimeExtension(data, len, rtp_abs_sendtime_extn_id_,
+                                      &extension_offset)) {
+        updated_options.packet_time_params.rtp_sendtime_extension_offset =
+            static_cast<int>(extension_offset);
+      }
       res = srtp_filter_.ProtectRtp(
           data, len, static_cast<int>(packet->capacity()), &len,
           &updated_options.packet_time_params.srtp_packet_index);
@@ -823,9 +845,36 @@ void BaseChannel::HandlePacket(bool rtcp, rtc::CopyOnWriteBuffer* packet,
     return;
   }
 
-  invoker_.AsyncInvoke<void>(
-      worker_thread_,
-      Bind(&BaseChannel::OnPacketReceived, this, rtcp, *packet, packet_time));
+  if (media_channel_->OnPacketReceivedOnNetworkThread(rtcp, *packet,
+                                                      packet_time)) {
+    return;
+  }
+
+  // Packets that arrive while the worker thread hasn't picked up earlier ones
+  // ride along with them, rather than costing a task each.
+  bool deliver_pending;
+  {
+    rtc::CritScope cs(&received_packets_crit_);
+    deliver_pending = !received_packets_.empty();
+    received_packets_.push_back(ReceivedPacket(rtcp, *packet, packet_time));
+  }
+  if (!deliver_pending) {
+    invoker_.AsyncInvoke<void>(
+        worker_thread_, Bind(&BaseChannel::DeliverReceivedPackets_w, this));
+  }
+}
+
+void BaseChannel::DeliverReceivedPackets_w() {
+  RTC_DCHECK(worker_thread_->IsCurrent());
+  std::vector<ReceivedPacket> packets;
+  {
+    rtc::CritScope cs(&received_packets_crit_);
+    packets.swap(received_packets_);
+  }
+  TRACE_EVENT1("webrtc", "BaseChannel::DeliverReceivedPackets_w", "packets",
+               packets.size());
+  for (const ReceivedPacket& received : packets)
+    OnPacketReceived(received.rtcp, received.packet, received.packet_time);
 }
 
 void BaseChannel::OnPacketReceived(bool rtcp,
@@ -944,7 +993,7 @@ bool BaseChannel::SetDtlsSrtpCryptoSuites_n(TransportChannel* tc, bool rtcp) {
   if (!rtcp) {
     GetSrtpCryptoSuites_n(&crypto_suites);
   } else {
-    GetDefaultSrtpCryptoSuites(&crypto_suites);
+    GetDefaultSrtpCryptoSuites(crypto_options(), &crypto_suites);
   }
   return tc->SetSrtpCryptoSuites(crypto_suites);
 }
@@ -976,9 +1025,16 @@ bool BaseChannel::SetupDtlsSrtp_n(bool rtcp_channel) {
                << content_name() << " "
                << PacketType(rtcp_channel);
 
+  int key_len;
+  int salt_len;
+  if (!rtc::GetSrtpKeyAndSaltLengths(selected_crypto_suite, &key_len,
+      &salt_len)) {
+    LOG(LS_ERROR) << "Unknown DTLS-SRTP crypto suite " << selected_crypto_suite;
+    return false;
+  }
+
   // OK, we're now doing DTLS (RFC 5764)
-  std::vector<unsigned char> dtls_buffer(SRTP_MASTER_KEY_KEY_LEN * 2 +
-                                         SRTP_MASTER_KEY_SALT_LEN * 2);
+  std::vector<unsigned char> dtls_buffer(key_len * 2 + salt_len * 2);
 
   // RFC 5705 exporter using the RFC 5764 parameters
   if (!channel->ExportKeyingMaterial(
@@ -991,22 +1047,16 @@ bool BaseChannel::SetupDtlsSrtp_n(bool rtcp_channel) {
   }
 
   // Sync up the keys with the DTLS-SRTP interface
-  std::vector<unsigned char> client_write_key(SRTP_MASTER_KEY_KEY_LEN +
-    SRTP_MASTER_KEY_SALT_LEN);
-  std::vector<unsigned char> server_write_key(SRTP_MASTER_KEY_KEY_LEN +
-    SRTP_MASTER_KEY_SALT_LEN);
+  std::vector<unsigned char> client_write_key(key_len + salt_len);
+  std::vector<unsigned char> server_write_key(key_len + salt_len);
   size_t offset = 0;
-  memcpy(&client_write_key[0], &dtls_buffer[offset],
-    SRTP_MASTER_KEY_KEY_LEN);
-  offset += SRTP_MASTER_KEY_KEY_LEN;
-  memcpy(&server_write_key[0], &dtls_buffer[offset],
-    SRTP_MASTER_KEY_KEY_LEN);
-  offset += SRTP_MASTER_KEY_KEY_LEN;
-  memcpy(&client_write_key[SRTP_MASTER_KEY_KEY_LEN],
-    &dtls_buffer[offset], SRTP_MASTER_KEY_SALT_LEN);
-  offset += SRTP_MASTER_KEY_SALT_LEN;
-  memcpy(&server_write_key[SRTP_MASTER_KEY_KEY_LEN],
-    &dtls_buffer[offset], SRTP_MASTER_KEY_SALT_LEN);
+  memcpy(&client_write_key[0], &dtls_buffer[offset], key_len);
+  offset += key_len;
+  memcpy(&server_write_key[0], &dtls_buffer[offset], key_len);
+  offset += key_len;
+  memcpy(&client_write_key[key_len], &dtls_buffer[offset], salt_len);
+  offset += salt_len;
+  memcpy(&server_write_key[key_len], &dtls_buffer[offset], salt_len);
 
   std::vector<unsigned char> *send_key, *recv_key;
   rtc::SSLRole role;
@@ -1280,13 +1330,16 @@ bool BaseChannel::UpdateLocalStreams_w(const std::vector<StreamParams>& streams,
     }
     return true;
   }
-  // Else streams are all the streams we want to send.
+  // Else streams are all the streams we want to send. Only the streams that
+  // were added or removed are passed on to the media channel.
+  const std::set<uint32_t> new_ssrcs = GetAllSsrcs(streams);
+  const std::set<uint32_t> old_ssrcs = GetAllSsrcs(local_streams_);
 
   // Check for streams that have been removed.
   bool ret = true;
   for (StreamParamsVec::const_iterator it = local_streams_.begin();
        it != local_streams_.end(); ++it) {
-    if (!GetStreamBySsrc(streams, it->first_ssrc())) {
+    if (!new_ssrcs.count(it->first_ssrc())) {
       if (!media_channel()->RemoveSendStream(it->first_ssrc())) {
         std::ostringstream desc;
         desc << "Failed to remove send stream with ssrc "
@@ -1299,7 +1352,7 @@ bool BaseChannel::UpdateLocalStreams_w(const std::vector<StreamParams>& streams,
   // Check for new streams.
   for (StreamParamsVec::const_iterator it = streams.begin();
        it != streams.end(); ++it) {
-    if (!GetStreamBySsrc(local_streams_, it->first_ssrc())) {
+    if (!old_ssrcs.count(it->first_ssrc())) {
       if (media_channel()->AddSendStream(*it)) {
         LOG(LS_INFO) << "Add send stream ssrc: " << it->ssrcs[0];
       } else {
@@ -1355,13 +1408,16 @@ bool BaseChannel::UpdateRemoteStreams_w(
     }
     return true;
   }
-  // Else streams are all the streams we want to receive.
+  // Else streams are all the streams we want to receive. Only the streams that
+  // were added or removed are passed on to the media channel.
+  const std::set<uint32_t> new_ssrcs = GetAllSsrcs(streams);
+  const std::set<uint32_t> old_ssrcs = GetAllSsrcs(remote_streams_);
 
   // Check for streams that have been removed.
   bool ret = true;
   for (StreamParamsVec::const_iterator it = remote_streams_.begin();
        it != remote_streams_.end(); ++it) {
-    if (!GetStreamBySsrc(streams, it->first_ssrc())) {
+    if (!new_ssrcs.count(it->first_ssrc())) {
       if (!RemoveRecvStream_w(it->first_ssrc())) {
         std::ostringstream desc;
         desc << "Failed to remove remote stream with ssrc "
@@ -1374,7 +1430,7 @@ bool BaseChannel::UpdateRemoteStreams_w(
   // Check for new streams.
   for (StreamParamsVec::const_iterator it = streams.begin();
       it != streams.end(); ++it) {
-    if (!GetStreamBySsrc(remote_streams_, it->first_ssrc())) {
+    if (!old_ssrcs.count(it->first_ssrc())) {
       if (AddRecvStream_w(*it)) {
         LOG(LS_INFO) << "Add remote ssrc: " << it->ssrcs[0];
       } else {
@@ -1691,7 +1747,8 @@ bool VoiceChannel::SetLocalContent_w(const MediaContentDescription* content,
 
   AudioRecvParameters recv_params = last_recv_params_;
   RtpParametersFromMediaDescription(audio, &recv_params);
-  if (!media_channel()->SetRecvParameters(recv_params)) {
+  if ((!recv_params_applied_ || recv_params != last_recv_params_) &&
+      !media_channel()->SetRecvParameters(recv_params)) {
     SafeSetError("Failed to set local audio description recv parameters.",
                  error_desc);
     return false;
@@ -1700,6 +1757,7 @@ bool VoiceChannel::SetLocalContent_w(const MediaContentDescription* content,
     bundle_filter()->AddPayloadType(codec.id);
   }
   last_recv_params_ = recv_params;
+  recv_params_applied_ = true;
 
   // TODO(pthatcher): Move local streams into AudioSendParameters, and
   // only give it to the media channel once we have a remote
@@ -1740,13 +1798,14 @@ bool VoiceChannel::SetRemoteContent_w(const MediaContentDescription* content,
     send_params.options.adjust_agc_delta = rtc::Optional<int>(kAgcMinus10db);
   }
 
-  bool parameters_applied = media_channel()->SetSendParameters(send_params);
-  if (!parameters_applied) {
+  if ((!send_params_applied_ || send_params != last_send_params_) &&
+      !media_channel()->SetSendParameters(send_params)) {
     SafeSetError("Failed to set remote audio description send parameters.",
                  error_desc);
     return false;
   }
   last_send_params_ = send_params;
+  send_params_applied_ = true;
 
   // TODO(pthatcher): Move remote streams into AudioRecvParameters,
   // and only give it to the media channel once we have a local
@@ -1818,7 +1877,7 @@ void VoiceChannel::OnAudioMonitorUpdate(AudioMonitor* monitor,
 
 void VoiceChannel::GetSrtpCryptoSuites_n(
     std::vector<int>* crypto_suites) const {
-  GetSupportedAudioCryptoSuites(crypto_suites);
+  GetSupportedAudioCryptoSuites(crypto_options(), crypto_suites);
 }
 
 VideoChannel::VideoChannel(rtc::Thread* worker_thread,
@@ -1974,7 +2033,8 @@ bool VideoChannel::SetLocalContent_w(const MediaContentDescription* content,
 
   VideoRecvParameters recv_params = last_recv_params_;
   RtpParametersFromMediaDescription(video, &recv_params);
-  if (!media_channel()->SetRecvParameters(recv_params)) {
+  if ((!recv_params_applied_ || recv_params != last_recv_params_) &&
+      !media_channel()->SetRecvParameters(recv_params)) {
     SafeSetError("Failed to set local video description recv parameters.",
                  error_desc);
     return false;
@@ -1983,6 +2043,7 @@ bool VideoChannel::SetLocalContent_w(const MediaContentDescription* content,
     bundle_filter()->AddPayloadType(codec.id);
   }
   last_recv_params_ = recv_params;
+  recv_params_applied_ = true;
 
   // TODO(pthatcher): Move local streams into VideoSendParameters, and
   // only give it to the media channel once we have a remote
@@ -2023,14 +2084,14 @@ bool VideoChannel::SetRemoteContent_w(const MediaContentDescription* content,
     send_params.conference_mode = true;
   }
 
-  bool parameters_applied = media_channel()->SetSendParameters(send_params);
-
-  if (!parameters_applied) {
+  if ((!send_params_applied_ || send_params != last_send_params_) &&
+      !media_channel()->SetSendParameters(send_params)) {
     SafeSetError("Failed to set remote video description send parameters.",
                  error_desc);
     return false;
   }
   last_send_params_ = send_params;
+  send_params_applied_ = true;
 
   // TODO(pthatcher): Move remote streams into VideoRecvParameters,
   // and only give it to the media channel once we have a local
@@ -2079,7 +2140,7 @@ void VideoChannel::OnMediaMonitorUpdate(
 
 void VideoChannel::GetSrtpCryptoSuites_n(
     std::vector<int>* crypto_suites) const {
-  GetSupportedVideoCryptoSuites(crypto_suites);
+  GetSupportedVideoCryptoSuites(crypto_options(), crypto_suites);
 }
 
 DataChannel::DataChannel(rtc::Thread* worker_thread,
@@ -2203,7 +2264,8 @@ bool DataChannel::SetLocalContent_w(const MediaContentDescription* content,
   // data channels need codecs.
   DataRecvParameters recv_params = last_recv_params_;
   RtpParametersFromMediaDescription(data, &recv_params);
-  if (!media_channel()->SetRecvParameters(recv_params)) {
+  if ((!recv_params_applied_ || recv_params != last_recv_params_) &&
+      !media_channel()->SetRecvParameters(recv_params)) {
     SafeSetError("Failed to set remote data description recv parameters.",
                  error_desc);
     return false;
@@ -2214,6 +2276,7 @@ bool DataChannel::SetLocalContent_w(const MediaContentDescription* content,
     }
   }
   last_recv_params_ = recv_params;
+  recv_params_applied_ = true;
 
   // TODO(pthatcher): Move local streams into DataSendParameters, and
   // only give it to the media channel once we have a remote
@@ -2262,12 +2325,14 @@ bool DataChannel::SetRemoteContent_w(const MediaContentDescription* content,
 
   DataSendParameters send_params = last_send_params_;
   RtpSendParametersFromMediaDescription<DataCodec>(data, &send_params);
-  if (!media_channel()->SetSendParameters(send_params)) {
+  if ((!send_params_applied_ || send_params != last_send_params_) &&
+      !media_channel()->SetSendParameters(send_params)) {
     SafeSetError("Failed to set remote data description send parameters.",
                  error_desc);
     return false;
   }
   last_send_params_ = send_params;
+  send_params_applied_ = true;
 
   // TODO(pthatcher): Move remote streams into DataRecvParameters,
   // and only give it to the media channel once we have a local
@@ -2391,7 +2456,7 @@ void DataChannel::OnDataChannelReadyToSend(bool writable) {
 }
 
 void DataChannel::GetSrtpCryptoSuites_n(std::vector<int>* crypto_suites) const {
-  GetSupportedDataCryptoSuites(crypto_suites);
+  GetSupportedDataCryptoSuites(crypto_options(), crypto_suites);
 }
 
 bool DataChannel::ShouldSetupDtlsSrtp_n() const {
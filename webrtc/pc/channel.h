@@ -168,6 +168,12 @@ class BaseChannel
 
   SrtpFilter* srtp_filter() { return &srtp_filter_; }
 
+  // Must be called before Init_w() to take effect for DTLS-SRTP.
+  void SetCryptoOptions(const rtc::CryptoOptions& crypto_options) {
+    crypto_options_ = crypto_options;
+  }
+  const rtc::CryptoOptions& crypto_options() const { return crypto_options_; }
+
  protected:
   virtual MediaChannel* media_channel() const { return media_channel_; }
   // Sets the |transport_channel_| (and |rtcp_transport_channel_|, if |rtcp_| is
@@ -234,6 +240,7 @@ class BaseChannel
   void OnPacketReceived(bool rtcp,
                         const rtc::CopyOnWriteBuffer& packet,
                         const rtc::PacketTime& packet_time);
+  void DeliverReceivedPackets_w();
 
   void EnableMedia_w();
   void DisableMedia_w();
@@ -326,6 +333,22 @@ class BaseChannel
   rtc::Thread* const network_thread_;
   rtc::AsyncInvoker invoker_;
 
+  // Packets handed from the network thread to the worker thread. A delivery
+  // task is only posted when the queue goes from empty to non-empty.
+  struct ReceivedPacket {
+    ReceivedPacket(bool rtcp,
+                   const rtc::CopyOnWriteBuffer& packet,
+                   const rtc::PacketTime& packet_time)
+        : rtcp(rtcp), packet(packet), packet_time(packet_time) {}
+
+    bool rtcp;
+    rtc::CopyOnWriteBuffer packet;
+    rtc::PacketTime packet_time;
+  };
+  rtc::CriticalSection received_packets_crit_;
+  std::vector<ReceivedPacket> received_packets_
+      GUARDED_BY(received_packets_crit_);
+
   const std::string content_name_;
   std::unique_ptr<ConnectionMonitor> connection_monitor_;
 
@@ -338,6 +361,7 @@ class BaseChannel
   TransportChannel* rtcp_transport_channel_;
   std::vector<std::pair<rtc::Socket::Option, int> > rtcp_socket_options_;
   SrtpFilter srtp_filter_;
+  rtc::CryptoOptions crypto_options_;
   RtcpMuxFilter rtcp_mux_filter_;
   BundleFilter bundle_filter_;
   bool rtp_ready_to_send_;
@@ -477,6 +501,10 @@ class VoiceChannel : public BaseChannel {
   // Last AudioRecvParameters sent down to the media_channel() via
   // SetRecvParameters.
   AudioRecvParameters last_recv_params_;
+  // Whether the parameters above have been applied to the media_channel().
+  // Unchanged parameters are not pushed down again once they have.
+  bool send_params_applied_ = false;
+  bool recv_params_applied_ = false;
 };
 
 // VideoChannel is a specialization for video.
@@ -552,6 +580,10 @@ class VideoChannel : public BaseChannel {
   // Last VideoRecvParameters sent down to the media_channel() via
   // SetRecvParameters.
   VideoRecvParameters last_recv_params_;
+  // Whether the parameters above have been applied to the media_channel().
+  // Unchanged parameters are not pushed down again once they have.
+  bool send_params_applied_ = false;
+  bool recv_params_applied_ = false;
 };
 
 // DataChannel is a specialization for data.
@@ -674,6 +706,10 @@ class DataChannel : public BaseChannel {
   // Last DataRecvParameters sent down to the media_channel() via
   // SetRecvParameters.
   DataRecvParameters last_recv_params_;
+  // Whether the parameters above have been applied to the media_channel().
+  // Unchanged parameters are not pushed down again once they have.
+  bool send_params_applied_ = false;
+  bool recv_params_applied_ = false;
 };
 
 }  // namespace cricket
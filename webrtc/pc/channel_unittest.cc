@@ -467,6 +467,24 @@ class ChannelTest : public testing::Test, public sigslot::has_slots<> {
                              media_channel1_->codecs()[0]));
   }
 
+  // Test that renegotiating an unchanged content doesn't push its parameters
+  // down to the media channel again, while a changed content still does.
+  void TestSetUnchangedContentsAgain() {
+    CreateChannels(0, 0);
+    typename T::Content content;
+    CreateContent(0, kPcmuCodec, kH264Codec, &content);
+    EXPECT_TRUE(channel1_->SetLocalContent(&content, CA_OFFER, NULL));
+    EXPECT_TRUE(channel1_->SetRemoteContent(&content, CA_ANSWER, NULL));
+
+    media_channel1_->set_fail_set_recv_codecs(true);
+    media_channel1_->set_fail_set_send_codecs(true);
+    EXPECT_TRUE(channel1_->SetLocalContent(&content, CA_OFFER, NULL));
+    EXPECT_TRUE(channel1_->SetRemoteContent(&content, CA_ANSWER, NULL));
+
+    content.set_bandwidth(100000);
+    EXPECT_FALSE(channel1_->SetRemoteContent(&content, CA_ANSWER, NULL));
+  }
+
   // Test that SetLocalContent and SetRemoteContent properly deals
   // with an empty offer.
   void TestSetContentsNullOffer() {
@@ -2097,6 +2115,10 @@ TEST_F(VoiceChannelSingleThreadTest, TestSetContents) {
   Base::TestSetContents();
 }
 
+TEST_F(VoiceChannelSingleThreadTest, TestSetUnchangedContentsAgain) {
+  Base::TestSetUnchangedContentsAgain();
+}
+
 TEST_F(VoiceChannelSingleThreadTest, TestSetContentsNullOffer) {
   Base::TestSetContentsNullOffer();
 }
@@ -2427,6 +2449,10 @@ TEST_F(VoiceChannelDoubleThreadTest, TestSetContents) {
   Base::TestSetContents();
 }
 
+TEST_F(VoiceChannelDoubleThreadTest, TestSetUnchangedContentsAgain) {
+  Base::TestSetUnchangedContentsAgain();
+}
+
 TEST_F(VoiceChannelDoubleThreadTest, TestSetContentsNullOffer) {
   Base::TestSetContentsNullOffer();
 }
@@ -2755,6 +2781,10 @@ TEST_F(VideoChannelSingleThreadTest, TestSetContents) {
   Base::TestSetContents();
 }
 
+TEST_F(VideoChannelSingleThreadTest, TestSetUnchangedContentsAgain) {
+  Base::TestSetUnchangedContentsAgain();
+}
+
 TEST_F(VideoChannelSingleThreadTest, TestSetContentsNullOffer) {
   Base::TestSetContentsNullOffer();
 }
@@ -2999,6 +3029,10 @@ TEST_F(VideoChannelDoubleThreadTest, TestSetContents) {
   Base::TestSetContents();
 }
 
+TEST_F(VideoChannelDoubleThreadTest, TestSetUnchangedContentsAgain) {
+  Base::TestSetUnchangedContentsAgain();
+}
+
 TEST_F(VideoChannelDoubleThreadTest, TestSetContentsNullOffer) {
   Base::TestSetContentsNullOffer();
 }
@@ -3314,6 +3348,10 @@ TEST_F(DataChannelSingleThreadTest, TestSetContents) {
   Base::TestSetContents();
 }
 
+TEST_F(DataChannelSingleThreadTest, TestSetUnchangedContentsAgain) {
+  Base::TestSetUnchangedContentsAgain();
+}
+
 TEST_F(DataChannelSingleThreadTest, TestSetContentsNullOffer) {
   Base::TestSetContentsNullOffer();
 }
@@ -3458,6 +3496,10 @@ TEST_F(DataChannelDoubleThreadTest, TestSetContents) {
   Base::TestSetContents();
 }
 
+TEST_F(DataChannelDoubleThreadTest, TestSetUnchangedContentsAgain) {
+  Base::TestSetUnchangedContentsAgain();
+}
+
 TEST_F(DataChannelDoubleThreadTest, TestSetContentsNullOffer) {
   Base::TestSetContentsNullOffer();
 }
@@ -141,6 +141,7 @@ void ChannelManager::GetSupportedDataCodecs(
 }
 
 bool ChannelManager::Init() {
+  TRACE_EVENT0("webrtc", "ChannelManager::Init");
   ASSERT(!initialized_);
   if (initialized_) {
     return false;
@@ -232,6 +233,7 @@ VoiceChannel* ChannelManager::CreateVoiceChannel_w(
   VoiceChannel* voice_channel =
       new VoiceChannel(worker_thread_, network_thread_, media_engine_.get(),
                        media_channel, transport_controller, content_name, rtcp);
+  voice_channel->SetCryptoOptions(crypto_options_);
   if (!voice_channel->Init_w(bundle_transport_name)) {
     delete voice_channel;
     return nullptr;
@@ -294,6 +296,7 @@ VideoChannel* ChannelManager::CreateVideoChannel_w(
   VideoChannel* video_channel =
       new VideoChannel(worker_thread_, network_thread_, media_channel,
                        transport_controller, content_name, rtcp);
+  video_channel->SetCryptoOptions(crypto_options_);
   if (!video_channel->Init_w(bundle_transport_name)) {
     delete video_channel;
     return NULL;
@@ -355,6 +358,7 @@ DataChannel* ChannelManager::CreateDataChannel_w(
   DataChannel* data_channel =
       new DataChannel(worker_thread_, network_thread_, media_channel,
                       transport_controller, content_name, rtcp);
+  data_channel->SetCryptoOptions(crypto_options_);
   if (!data_channel->Init_w(bundle_transport_name)) {
     LOG(LS_WARNING) << "Failed to init data channel.";
     delete data_channel;
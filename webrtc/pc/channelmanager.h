@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "webrtc/base/fileutils.h"
+#include "webrtc/base/sslstreamadapter.h"
 #include "webrtc/base/thread.h"
 #include "webrtc/media/base/mediaengine.h"
 #include "webrtc/pc/voicechannel.h"
@@ -126,6 +127,13 @@ class ChannelManager {
   // engines will start offering an RTX codec. Must be called before Init().
   bool SetVideoRtxEnabled(bool enable);
 
+  // Sets the crypto options of the channels created from now on, e.g. whether
+  // they offer the GCM crypto suites for SRTP.
+  void SetCryptoOptions(const rtc::CryptoOptions& crypto_options) {
+    crypto_options_ = crypto_options;
+  }
+  const rtc::CryptoOptions& crypto_options() const { return crypto_options_; }
+
   // Starts/stops the local microphone and enables polling of the input level.
   bool capturing() const { return capturing_; }
 
@@ -193,6 +201,7 @@ class ChannelManager {
 
   int audio_output_volume_;
   bool enable_rtx_;
+  rtc::CryptoOptions crypto_options_;
 
   bool capturing_;
 };
@@ -763,6 +763,38 @@ TEST_F(MediaSessionDescriptionFactoryTest, TestCreateAudioAnswer) {
   EXPECT_EQ(std::string(cricket::kMediaProtocolSavpf), acd->protocol());
 }
 
+// Create an audio answer with GCM enabled on both sides, and ensure a GCM
+// crypto suite with a key of the right length is selected.
+TEST_F(MediaSessionDescriptionFactoryTest, TestCreateAudioAnswerGcm) {
+  MediaSessionOptions opts;
+  opts.crypto_options.enable_gcm_crypto_suites = true;
+  f1_.set_secure(SEC_ENABLED);
+  f2_.set_secure(SEC_ENABLED);
+  std::unique_ptr<SessionDescription> offer(f1_.CreateOffer(opts, NULL));
+  ASSERT_TRUE(offer.get() != NULL);
+  const AudioContentDescription* offer_acd =
+      GetFirstAudioContentDescription(offer.get());
+  ASSERT_EQ(4U, offer_acd->cryptos().size());
+  EXPECT_EQ(std::string(rtc::CS_AEAD_AES_256_GCM),
+            offer_acd->cryptos()[0].cipher_suite);
+  // "inline:" and 44 bytes of key and salt in base64.
+  EXPECT_EQ(7U + 60U, offer_acd->cryptos()[0].key_params.size());
+
+  std::unique_ptr<SessionDescription> answer(
+      f2_.CreateAnswer(offer.get(), opts, NULL));
+  const AudioContentDescription* acd =
+      GetFirstAudioContentDescription(answer.get());
+  ASSERT_TRUE(acd != NULL);
+  ASSERT_CRYPTO(acd, 1U, rtc::CS_AEAD_AES_256_GCM);
+
+  // An answerer without GCM falls back to AES-CM.
+  std::unique_ptr<SessionDescription> cm_answer(
+      f2_.CreateAnswer(offer.get(), MediaSessionOptions(), NULL));
+  acd = GetFirstAudioContentDescription(cm_answer.get());
+  ASSERT_TRUE(acd != NULL);
+  ASSERT_CRYPTO(acd, 1U, CS_AES_CM_128_HMAC_SHA1_32);
+}
+
 // Create a typical video answer, and ensure it matches what we expect.
 TEST_F(MediaSessionDescriptionFactoryTest, TestCreateVideoAnswer) {
   MediaSessionOptions opts;
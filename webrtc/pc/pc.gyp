@@ -62,6 +62,8 @@
         'mediasink.h',
         'rtcpmuxfilter.cc',
         'rtcpmuxfilter.h',
+        'rtpaudiolevelmonitor.cc',
+        'rtpaudiolevelmonitor.h',
         'srtpfilter.cc',
         'srtpfilter.h',
         'voicechannel.h',
@@ -90,6 +92,7 @@
             'currentspeakermonitor_unittest.cc',
             'mediasession_unittest.cc',
             'rtcpmuxfilter_unittest.cc',
+            'rtpaudiolevelmonitor_unittest.cc',
             'srtpfilter_unittest.cc',
           ],
           'conditions': [
@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/pc/rtpaudiolevelmonitor.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "webrtc/media/base/rtputils.h"
+#include "webrtc/pc/audiomonitor.h"
+
+namespace cricket {
+
+namespace {
+const int kMaxLevelDbov = 127;
+// Maps the amplitude in thousands to the 0-9 scale, like the level indicator
+// of the voice engine does for decoded audio.
+const int kAmplitudeToLevel[33] = {
+    0, 1, 2, 3, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 6, 7, 7,
+    7, 7, 8, 8, 8, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9};
+}  // namespace
+
+RtpAudioLevelMonitor::RtpAudioLevelMonitor(int audio_level_extension_id)
+    : audio_level_extension_id_(audio_level_extension_id) {}
+
+RtpAudioLevelMonitor::~RtpAudioLevelMonitor() {}
+
+bool RtpAudioLevelMonitor::OnRtpPacket(const uint8_t* data, size_t length) {
+  uint32_t ssrc;
+  int level_dbov;
+  bool voice_activity;
+  if (!ValidateRtpHeader(data, length, nullptr) ||
+      !GetRtpSsrc(data, length, &ssrc) ||
+      !GetRtpAudioLevel(data, length, audio_level_extension_id_, &level_dbov,
+                        &voice_activity)) {
+    return false;
+  }
+  OnAudioLevel(ssrc, level_dbov, voice_activity);
+  return true;
+}
+
+void RtpAudioLevelMonitor::OnAudioLevel(uint32_t ssrc,
+                                        int level_dbov,
+                                        bool voice_activity) {
+  if (!voice_activity)
+    return;
+  std::map<uint32_t, int>::iterator it = ssrc_to_level_dbov_map_.find(ssrc);
+  if (it == ssrc_to_level_dbov_map_.end()) {
+    ssrc_to_level_dbov_map_[ssrc] = level_dbov;
+  } else {
+    it->second = std::min(it->second, level_dbov);
+  }
+}
+
+void RtpAudioLevelMonitor::Update() {
+  AudioInfo info;
+  info.input_level = 0;
+  info.output_level = 0;
+  for (const auto& ssrc_and_level : ssrc_to_level_dbov_map_) {
+    int level = ToAudioInfoLevel(ssrc_and_level.second);
+    // Like for decoded audio, only streams with a level are active.
+    if (level > 0) {
+      info.active_streams.push_back(std::make_pair(ssrc_and_level.first,
+                                                   level));
+      info.output_level = std::max(info.output_level, level);
+    }
+  }
+  ssrc_to_level_dbov_map_.clear();
+  SignalAudioMonitor(this, info);
+}
+
+int RtpAudioLevelMonitor::ToAudioInfoLevel(int level_dbov) {
+  if (level_dbov >= kMaxLevelDbov)
+    return 0;
+  const int amplitude = static_cast<int>(
+      32767 * pow(10.0, -std::max(level_dbov, 0) / 20.0));
+  int position = amplitude / 1000;
+  // Only quiet amplitudes below 250 get the lowest level.
+  if (position == 0 && amplitude > 250)
+    position = 1;
+  return kAmplitudeToLevel[position];
+}
+
+}  // namespace cricket
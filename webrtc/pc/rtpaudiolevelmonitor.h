@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// RtpAudioLevelMonitor reports the audio levels of received streams from the
+// RFC 6464 audio level header extension, without decoding any audio.
+
+#ifndef WEBRTC_PC_RTPAUDIOLEVELMONITOR_H_
+#define WEBRTC_PC_RTPAUDIOLEVELMONITOR_H_
+
+#include <map>
+
+#include "webrtc/base/basictypes.h"
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/pc/currentspeakermonitor.h"
+
+namespace cricket {
+
+// An AudioSourceContext whose audio levels come from the client-to-mixer audio
+// level that senders put in each RTP packet, so that a CurrentSpeakerMonitor
+// can pick the current speaker on a server which only decodes the streams
+// it needs. Feed it every received audio packet and call Update()
+// periodically, preferably every 100 ms, to report the levels received since
+// the previous call. All methods must be called on the same thread.
+class RtpAudioLevelMonitor : public AudioSourceContext {
+ public:
+  // |audio_level_extension_id| is the negotiated one-byte header extension ID
+  // of the audio level extension.
+  explicit RtpAudioLevelMonitor(int audio_level_extension_id);
+  ~RtpAudioLevelMonitor();
+
+  // Reads the audio level of a received RTP packet. Returns false if the
+  // packet is invalid or doesn't carry the audio level extension.
+  bool OnRtpPacket(const uint8_t* data, size_t length);
+
+  // Records an audio level of |ssrc| which was read by the caller.
+  // |level_dbov| is in -dBov, from 0 (loudest) to 127 (silence). Levels of
+  // packets the sender marked as not containing voice are ignored.
+  void OnAudioLevel(uint32_t ssrc, int level_dbov, bool voice_activity);
+
+  // Signals the loudest level of each stream since the last call through
+  // SignalAudioMonitor and starts over.
+  void Update();
+
+  // Converts a level in -dBov to the 0-9 scale of AudioInfo, in the same way
+  // that the level of decoded audio would be.
+  static int ToAudioInfoLevel(int level_dbov);
+
+ private:
+  const int audio_level_extension_id_;
+  // The loudest level, i.e. smallest -dBov, of each stream with voice since
+  // the last Update().
+  std::map<uint32_t, int> ssrc_to_level_dbov_map_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RtpAudioLevelMonitor);
+};
+
+}  // namespace cricket
+
+#endif  // WEBRTC_PC_RTPAUDIOLEVELMONITOR_H_
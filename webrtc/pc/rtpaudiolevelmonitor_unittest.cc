@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/gunit.h"
+#include "webrtc/pc/audiomonitor.h"
+#include "webrtc/pc/rtpaudiolevelmonitor.h"
+
+namespace cricket {
+
+static const int kAudioLevelExtensionId = 1;
+static const uint32_t kSsrc1 = 1001;
+static const uint32_t kSsrc2 = 1002;
+
+// RTP packet from SSRC 0x11223344 with voice activity and a level of -10 dBov
+// in the audio level extension.
+static const uint8_t kRtpPacketWithAudioLevel[] = {
+    0x90, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x11, 0x22, 0x33, 0x44,
+    0xBE, 0xDE, 0x00, 0x01, 0x10, 0x8A, 0x00, 0x00,
+};
+
+class RtpAudioLevelMonitorTest : public testing::Test,
+                                 public sigslot::has_slots<> {
+ public:
+  RtpAudioLevelMonitorTest()
+      : monitor_(kAudioLevelExtensionId),
+        speaker_monitor_(&monitor_),
+        num_updates_(0),
+        current_speaker_(0) {
+    monitor_.SignalAudioMonitor.connect(
+        this, &RtpAudioLevelMonitorTest::OnAudioMonitor);
+    speaker_monitor_.SignalUpdate.connect(
+        this, &RtpAudioLevelMonitorTest::OnSpeakerUpdate);
+  }
+
+ protected:
+  void OnAudioMonitor(AudioSourceContext* context, const AudioInfo& info) {
+    info_ = info;
+    num_updates_++;
+  }
+
+  void OnSpeakerUpdate(CurrentSpeakerMonitor* monitor, uint32_t ssrc) {
+    current_speaker_ = ssrc;
+  }
+
+  RtpAudioLevelMonitor monitor_;
+  CurrentSpeakerMonitor speaker_monitor_;
+  AudioInfo info_;
+  int num_updates_;
+  uint32_t current_speaker_;
+};
+
+TEST_F(RtpAudioLevelMonitorTest, ConvertsLevels) {
+  EXPECT_EQ(9, RtpAudioLevelMonitor::ToAudioInfoLevel(0));
+  EXPECT_EQ(9, RtpAudioLevelMonitor::ToAudioInfoLevel(3));
+  EXPECT_EQ(4, RtpAudioLevelMonitor::ToAudioInfoLevel(15));
+  EXPECT_EQ(1, RtpAudioLevelMonitor::ToAudioInfoLevel(35));
+  EXPECT_EQ(0, RtpAudioLevelMonitor::ToAudioInfoLevel(45));
+  EXPECT_EQ(0, RtpAudioLevelMonitor::ToAudioInfoLevel(127));
+}
+
+TEST_F(RtpAudioLevelMonitorTest, ReportsLoudestLevelSinceLastUpdate) {
+  monitor_.OnAudioLevel(kSsrc1, 20, true);
+  monitor_.OnAudioLevel(kSsrc1, 3, true);
+  monitor_.OnAudioLevel(kSsrc1, 30, true);
+  // Inaudible and unvoiced levels are left out.
+  monitor_.OnAudioLevel(kSsrc2, 100, true);
+  monitor_.OnAudioLevel(kSsrc2, 0, false);
+  monitor_.Update();
+
+  EXPECT_EQ(1, num_updates_);
+  ASSERT_EQ(1u, info_.active_streams.size());
+  EXPECT_EQ(kSsrc1, info_.active_streams[0].first);
+  EXPECT_EQ(9, info_.active_streams[0].second);
+  EXPECT_EQ(9, info_.output_level);
+
+  monitor_.Update();
+  EXPECT_EQ(2, num_updates_);
+  EXPECT_TRUE(info_.active_streams.empty());
+  EXPECT_EQ(0, info_.output_level);
+}
+
+TEST_F(RtpAudioLevelMonitorTest, ReadsLevelFromRtpPacket) {
+  EXPECT_TRUE(monitor_.OnRtpPacket(kRtpPacketWithAudioLevel,
+                                   sizeof(kRtpPacketWithAudioLevel)));
+  EXPECT_FALSE(monitor_.OnRtpPacket(kRtpPacketWithAudioLevel, 14));
+  monitor_.Update();
+
+  ASSERT_EQ(1u, info_.active_streams.size());
+  EXPECT_EQ(0x11223344u, info_.active_streams[0].first);
+  EXPECT_EQ(RtpAudioLevelMonitor::ToAudioInfoLevel(10),
+            info_.active_streams[0].second);
+}
+
+TEST_F(RtpAudioLevelMonitorTest, SelectsCurrentSpeaker) {
+  speaker_monitor_.Start();
+
+  // A stream is only recognized as speaking after two periods with voice.
+  monitor_.OnAudioLevel(kSsrc1, 30, true);
+  monitor_.OnAudioLevel(kSsrc2, 10, true);
+  monitor_.Update();
+  EXPECT_EQ(0u, current_speaker_);
+
+  monitor_.OnAudioLevel(kSsrc1, 30, true);
+  monitor_.OnAudioLevel(kSsrc2, 10, true);
+  monitor_.Update();
+  EXPECT_EQ(kSsrc2, current_speaker_);
+}
+
+}  // namespace cricket
@@ -15,6 +15,7 @@
 #include <algorithm>
 
 #include "webrtc/base/base64.h"
+#include "webrtc/base/buffer.h"
 #include "webrtc/base/byteorder.h"
 #include "webrtc/base/common.h"
 #include "webrtc/base/logging.h"
@@ -38,6 +39,11 @@ extern "C" {
 #ifdef  ENABLE_EXTERNAL_AUTH
 #include "webrtc/pc/externalhmac.h"
 #endif  // ENABLE_EXTERNAL_AUTH
+// libsrtp only provides the AES-GCM ciphers when it's built against OpenSSL
+// or BoringSSL, which its headers check through the OPENSSL macro as well.
+#if defined(OPENSSL)
+#define HAVE_SRTP_GCM
+#endif
 #if !defined(NDEBUG)
 extern "C" debug_module_t mod_srtp;
 extern "C" debug_module_t mod_auth;
@@ -236,6 +242,28 @@ bool SrtpFilter::UnprotectRtp(void* p, int in_len, int* out_len) {
   return recv_session_->UnprotectRtp(p, in_len, out_len);
 }
 
+size_t SrtpFilter::ProtectRtp(SrtpPacket* packets, size_t num_packets) {
+  if (!IsActive()) {
+    LOG(LS_WARNING) << "Failed to ProtectRtp: SRTP not active";
+    for (size_t i = 0; i < num_packets; ++i)
+      packets[i].length = 0;
+    return 0;
+  }
+  ASSERT(send_session_ != NULL);
+  return send_session_->ProtectRtp(packets, num_packets);
+}
+
+size_t SrtpFilter::UnprotectRtp(SrtpPacket* packets, size_t num_packets) {
+  if (!IsActive()) {
+    LOG(LS_WARNING) << "Failed to UnprotectRtp: SRTP not active";
+    for (size_t i = 0; i < num_packets; ++i)
+      packets[i].length = 0;
+    return 0;
+  }
+  ASSERT(recv_session_ != NULL);
+  return recv_session_->UnprotectRtp(packets, num_packets);
+}
+
 bool SrtpFilter::UnprotectRtcp(void* p, int in_len, int* out_len) {
   if (!IsActive()) {
     LOG(LS_WARNING) << "Failed to UnprotectRtcp: SRTP not active";
@@ -402,19 +430,42 @@ bool SrtpFilter::ApplyParams(const CryptoParams& send_params,
     // We do not want to reset the ROC if the keys are the same. So just return.
     return true;
   }
+  int send_suite = rtc::SrtpCryptoSuiteFromName(send_params.cipher_suite);
+  int recv_suite = rtc::SrtpCryptoSuiteFromName(recv_params.cipher_suite);
+  if (send_suite == rtc::SRTP_INVALID_CRYPTO_SUITE ||
+      recv_suite == rtc::SRTP_INVALID_CRYPTO_SUITE) {
+    LOG(LS_WARNING) << "Unknown crypto suite(s) received:"
+                    << " send cipher_suite " << send_params.cipher_suite
+                    << " recv cipher_suite " << recv_params.cipher_suite;
+    return false;
+  }
+
+  int send_key_len, send_salt_len;
+  int recv_key_len, recv_salt_len;
+  if (!rtc::GetSrtpKeyAndSaltLengths(send_suite, &send_key_len,
+                                     &send_salt_len) ||
+      !rtc::GetSrtpKeyAndSaltLengths(recv_suite, &recv_key_len,
+                                     &recv_salt_len)) {
+    LOG(LS_WARNING) << "Could not get lengths for crypto suite(s):"
+                    << " send cipher_suite " << send_params.cipher_suite
+                    << " recv cipher_suite " << recv_params.cipher_suite;
+    return false;
+  }
+
   // TODO(juberti): Zero these buffers after use.
   bool ret;
-  uint8_t send_key[SRTP_MASTER_KEY_LEN], recv_key[SRTP_MASTER_KEY_LEN];
-  ret = (ParseKeyParams(send_params.key_params, send_key, sizeof(send_key)) &&
-         ParseKeyParams(recv_params.key_params, recv_key, sizeof(recv_key)));
+  rtc::Buffer send_key(send_key_len + send_salt_len);
+  rtc::Buffer recv_key(recv_key_len + recv_salt_len);
+  ret = (ParseKeyParams(send_params.key_params, send_key.data(),
+                        static_cast<int>(send_key.size())) &&
+         ParseKeyParams(recv_params.key_params, recv_key.data(),
+                        static_cast<int>(recv_key.size())));
   if (ret) {
     CreateSrtpSessions();
-    ret = (send_session_->SetSend(
-               rtc::SrtpCryptoSuiteFromName(send_params.cipher_suite), send_key,
-               sizeof(send_key)) &&
-           recv_session_->SetRecv(
-               rtc::SrtpCryptoSuiteFromName(recv_params.cipher_suite), recv_key,
-               sizeof(recv_key)));
+    ret = (send_session_->SetSend(send_suite, send_key.data(),
+                                  static_cast<int>(send_key.size())) &&
+           recv_session_->SetRecv(recv_suite, recv_key.data(),
+                                  static_cast<int>(recv_key.size())));
   }
   if (ret) {
     LOG(LS_INFO) << "SRTP activated with negotiated parameters:"
@@ -468,7 +519,7 @@ bool SrtpFilter::ParseKeyParams(const std::string& key_params,
 
 bool SrtpSession::inited_ = false;
 
-// This lock protects SrtpSession::inited_ and SrtpSession::sessions_.
+// This lock protects SrtpSession::inited_.
 rtc::GlobalLockPod SrtpSession::lock_;
 
 SrtpSession::SrtpSession()
@@ -477,18 +528,10 @@ SrtpSession::SrtpSession()
       rtcp_auth_tag_len_(0),
       srtp_stat_(new SrtpStat()),
       last_send_seq_num_(-1) {
-  {
-    rtc::GlobalLockScope ls(&lock_);
-    sessions()->push_back(this);
-  }
   SignalSrtpError.repeat(srtp_stat_->SignalSrtpError);
 }
 
 SrtpSession::~SrtpSession() {
-  {
-    rtc::GlobalLockScope ls(&lock_);
-    sessions()->erase(std::find(sessions()->begin(), sessions()->end(), this));
-  }
   if (session_) {
     srtp_dealloc(session_);
   }
@@ -515,12 +558,7 @@ bool SrtpSession::ProtectRtp(void* p, int in_len, int max_len, int* out_len) {
     return false;
   }
 
-  *out_len = in_len;
-  int err = srtp_protect(session_, p, out_len);
-  uint32_t ssrc;
-  if (GetRtpSsrc(p, in_len, &ssrc)) {
-    srtp_stat_->AddProtectRtpResult(ssrc, err);
-  }
+  int err = DoProtectRtp(p, in_len, out_len);
   int seq_num;
   GetRtpSeqNum(p, in_len, &seq_num);
   if (err != err_status_ok) {
@@ -573,17 +611,92 @@ bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
     return false;
   }
 
+  int err = DoUnprotectRtp(p, in_len, out_len);
+  if (err != err_status_ok) {
+    LOG(LS_WARNING) << "Failed to unprotect SRTP packet, err=" << err;
+    return false;
+  }
+  return true;
+}
+
+size_t SrtpSession::ProtectRtp(SrtpPacket* packets, size_t num_packets) {
+  if (!session_) {
+    LOG(LS_WARNING) << "Failed to protect SRTP packets: no SRTP Session";
+    for (size_t i = 0; i < num_packets; ++i)
+      packets[i].length = 0;
+    return 0;
+  }
+
+  size_t num_protected = 0;
+  int last_err = err_status_ok;
+  for (size_t i = 0; i < num_packets; ++i) {
+    SrtpPacket* packet = &packets[i];
+    const int in_len = packet->length;
+    int err = err_status_bad_param;
+    if (packet->capacity >= in_len + rtp_auth_tag_len_)
+      err = DoProtectRtp(packet->data, in_len, &packet->length);
+    if (err != err_status_ok) {
+      packet->length = 0;
+      last_err = err;
+      continue;
+    }
+    GetRtpSeqNum(packet->data, in_len, &last_send_seq_num_);
+    ++num_protected;
+  }
+  if (num_protected < num_packets) {
+    LOG(LS_WARNING) << "Failed to protect " << num_packets - num_protected
+                    << " of " << num_packets << " SRTP packets, last err="
+                    << last_err << ", last seqnum=" << last_send_seq_num_;
+  }
+  return num_protected;
+}
+
+size_t SrtpSession::UnprotectRtp(SrtpPacket* packets, size_t num_packets) {
+  if (!session_) {
+    LOG(LS_WARNING) << "Failed to unprotect SRTP packets: no SRTP Session";
+    for (size_t i = 0; i < num_packets; ++i)
+      packets[i].length = 0;
+    return 0;
+  }
+
+  size_t num_unprotected = 0;
+  int last_err = err_status_ok;
+  for (size_t i = 0; i < num_packets; ++i) {
+    SrtpPacket* packet = &packets[i];
+    int err = DoUnprotectRtp(packet->data, packet->length, &packet->length);
+    if (err != err_status_ok) {
+      packet->length = 0;
+      last_err = err;
+      continue;
+    }
+    ++num_unprotected;
+  }
+  if (num_unprotected < num_packets) {
+    LOG(LS_WARNING) << "Failed to unprotect " << num_packets - num_unprotected
+                    << " of " << num_packets << " SRTP packets, last err="
+                    << last_err;
+  }
+  return num_unprotected;
+}
+
+int SrtpSession::DoProtectRtp(void* p, int in_len, int* out_len) {
+  *out_len = in_len;
+  int err = srtp_protect(session_, p, out_len);
+  uint32_t ssrc;
+  if (GetRtpSsrc(p, in_len, &ssrc)) {
+    srtp_stat_->AddProtectRtpResult(ssrc, err);
+  }
+  return err;
+}
+
+int SrtpSession::DoUnprotectRtp(void* p, int in_len, int* out_len) {
   *out_len = in_len;
   int err = srtp_unprotect(session_, p, out_len);
   uint32_t ssrc;
   if (GetRtpSsrc(p, in_len, &ssrc)) {
     srtp_stat_->AddUnprotectRtpResult(ssrc, err);
   }
-  if (err != err_status_ok) {
-    LOG(LS_WARNING) << "Failed to unprotect SRTP packet, err=" << err;
-    return false;
-  }
-  return true;
+  return err;
 }
 
 bool SrtpSession::UnprotectRtcp(void* p, int in_len, int* out_len) {
@@ -665,13 +778,31 @@ bool SrtpSession::SetKey(int type, int cs, const uint8_t* key, int len) {
   } else if (cs == rtc::SRTP_AES128_CM_SHA1_32) {
     crypto_policy_set_aes_cm_128_hmac_sha1_32(&policy.rtp);   // rtp is 32,
     crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);  // rtcp still 80
+#if defined(HAVE_SRTP_GCM)
+  } else if (cs == rtc::SRTP_AEAD_AES_128_GCM) {
+    crypto_policy_set_aes_gcm_128_16_auth(&policy.rtp);
+    crypto_policy_set_aes_gcm_128_16_auth(&policy.rtcp);
+  } else if (cs == rtc::SRTP_AEAD_AES_256_GCM) {
+    crypto_policy_set_aes_gcm_256_16_auth(&policy.rtp);
+    crypto_policy_set_aes_gcm_256_16_auth(&policy.rtcp);
+#endif  // HAVE_SRTP_GCM
   } else {
     LOG(LS_WARNING) << "Failed to create SRTP session: unsupported"
                     << " cipher_suite " << cs;
     return false;
   }
 
-  if (!key || len != SRTP_MASTER_KEY_LEN) {
+  int expected_key_len;
+  int expected_salt_len;
+  if (!rtc::GetSrtpKeyAndSaltLengths(cs, &expected_key_len,
+                                     &expected_salt_len)) {
+    // This should never happen.
+    LOG(LS_WARNING) << "Failed to create SRTP session: unsupported"
+                    << " cipher_suite without length information " << cs;
+    return false;
+  }
+
+  if (!key || len != (expected_key_len + expected_salt_len)) {
     LOG(LS_WARNING) << "Failed to create SRTP session: invalid key";
     return false;
   }
@@ -687,8 +818,9 @@ bool SrtpSession::SetKey(int type, int cs, const uint8_t* key, int len) {
   // We want to set this option only for rtp packets.
   // By default policy structure is initialized to HMAC_SHA1.
 #if defined(ENABLE_EXTERNAL_AUTH)
-  // Enable external HMAC authentication only for outgoing streams.
-  if (type == ssrc_any_outbound) {
+  // Enable external HMAC authentication only for outgoing streams and only
+  // for cipher suites that support it (i.e. only non-GCM cipher suites).
+  if (type == ssrc_any_outbound && !rtc::IsGcmCryptoSuite(cs)) {
     policy.rtp.auth_type = EXTERNAL_HMAC_SHA1;
   }
 #endif
@@ -700,7 +832,9 @@ bool SrtpSession::SetKey(int type, int cs, const uint8_t* key, int len) {
     LOG(LS_ERROR) << "Failed to create SRTP session, err=" << err;
     return false;
   }
-
+  // Events are dispatched back to this session through the context's user
+  // data, so no process-wide lookup is needed while packets are transformed.
+  srtp_set_user_data(session_, this);
 
   rtp_auth_tag_len_ = policy.rtp.auth_tag_len;
   rtcp_auth_tag_len_ = policy.rtcp.auth_tag_len;
@@ -770,22 +904,15 @@ void SrtpSession::HandleEvent(const srtp_event_data_t* ev) {
 }
 
 void SrtpSession::HandleEventThunk(srtp_event_data_t* ev) {
-  rtc::GlobalLockScope ls(&lock_);
-
-  for (std::list<SrtpSession*>::iterator it = sessions()->begin();
-       it != sessions()->end(); ++it) {
-    if ((*it)->session_ == ev->session) {
-      (*it)->HandleEvent(ev);
-      break;
-    }
+  // Called from within srtp_protect/srtp_unprotect on the thread that owns
+  // the session, so it must not take |lock_|.
+  SrtpSession* session =
+      static_cast<SrtpSession*>(srtp_get_user_data(ev->session));
+  if (session) {
+    session->HandleEvent(ev);
   }
 }
 
-std::list<SrtpSession*>* SrtpSession::sessions() {
-  RTC_DEFINE_STATIC_LOCAL(std::list<SrtpSession*>, sessions, ());
-  return &sessions;
-}
-
 #else   // !HAVE_SRTP
 
 // On some systems, SRTP is not (yet) available.
@@ -823,6 +950,16 @@ bool SrtpSession::UnprotectRtcp(void* data, int in_len, int* out_len) {
   return SrtpNotAvailable(__FUNCTION__);
 }
 
+size_t SrtpSession::ProtectRtp(SrtpPacket* packets, size_t num_packets) {
+  SrtpNotAvailable(__FUNCTION__);
+  return 0;
+}
+
+size_t SrtpSession::UnprotectRtp(SrtpPacket* packets, size_t num_packets) {
+  SrtpNotAvailable(__FUNCTION__);
+  return 0;
+}
+
 void SrtpSession::set_signal_silent_time(uint32_t signal_silent_time) {
   // Do nothing.
 }
@@ -11,7 +11,6 @@
 #ifndef WEBRTC_PC_SRTPFILTER_H_
 #define WEBRTC_PC_SRTPFILTER_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <string>
@@ -33,6 +32,8 @@ struct srtp_policy_t;
 namespace cricket {
 
 // Key is 128 bits and salt is 112 bits == 30 bytes. B64 bloat => 40 bytes.
+// These are the lengths for the AES-CM crypto suites, the GCM ones use other
+// lengths; see rtc::GetSrtpKeyAndSaltLengths().
 extern const int SRTP_MASTER_KEY_BASE64_LEN;
 
 // Needed for DTLS-SRTP
@@ -42,6 +43,15 @@ extern const int SRTP_MASTER_KEY_SALT_LEN;
 class SrtpSession;
 class SrtpStat;
 
+// An RTP packet for the batched protect/unprotect calls, transformed in place.
+// |data| holds |length| bytes in a buffer of |capacity| bytes. On success
+// |length| is set to the length of the transformed packet, on failure to 0.
+struct SrtpPacket {
+  void* data;
+  int length;
+  int capacity;
+};
+
 void EnableSrtpDebugging();
 void ShutdownSrtp();
 
@@ -116,6 +126,12 @@ class SrtpFilter {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // Encrypts/decrypts a batch of RTP packets, e.g. the datagrams read from the
+  // socket in one go, as if calling ProtectRtp()/UnprotectRtp() on each of
+  // them in order. Returns the number of packets that were transformed.
+  size_t ProtectRtp(SrtpPacket* packets, size_t num_packets);
+  size_t UnprotectRtp(SrtpPacket* packets, size_t num_packets);
+
   // Returns rtp auth params from srtp context.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -204,6 +220,11 @@ class SrtpSession {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // Encrypts/decrypts a batch of RTP packets, in-place. Failures are logged
+  // once per batch rather than once per packet.
+  size_t ProtectRtp(SrtpPacket* packets, size_t num_packets);
+  size_t UnprotectRtp(SrtpPacket* packets, size_t num_packets);
+
   // Helper method to get authentication params.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -218,6 +239,10 @@ class SrtpSession {
 
  private:
   bool SetKey(int type, int cs, const uint8_t* key, int len);
+  // Transform a single RTP packet and report the result to |srtp_stat_|.
+  // Return the libsrtp error code.
+  int DoProtectRtp(void* data, int in_len, int* out_len);
+  int DoUnprotectRtp(void* data, int in_len, int* out_len);
     // Returns send stream current packet index from srtp db.
   bool GetSendStreamPacketIndex(void* data, int in_len, int64_t* index);
 
@@ -225,8 +250,6 @@ class SrtpSession {
   void HandleEvent(const srtp_event_data_t* ev);
   static void HandleEventThunk(srtp_event_data_t* ev);
 
-  static std::list<SrtpSession*>* sessions();
-
   srtp_ctx_t* session_;
   int rtp_auth_tag_len_;
   int rtcp_auth_tag_len_;
@@ -684,6 +684,64 @@ TEST_F(SrtpSessionTest, TestBuffersTooSmall) {
                                sizeof(rtcp_packet_) - 14, &out_len));
 }
 
+// Test that a batch of RTP packets is encrypted and decrypted in place, and
+// that a packet failing authentication doesn't drop the rest of the batch.
+TEST_F(SrtpSessionTest, TestProtectUnprotectBatch) {
+  static const size_t kNumPackets = 4;
+  char packets[kNumPackets][sizeof(kPcmuFrame) + 10];
+  cricket::SrtpPacket batch[kNumPackets];
+  EXPECT_TRUE(s1_.SetSend(rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen));
+  EXPECT_TRUE(s2_.SetRecv(rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen));
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    memcpy(packets[i], kPcmuFrame, rtp_len_);
+    rtc::SetBE16(reinterpret_cast<uint8_t*>(packets[i]) + 2,
+                 static_cast<uint16_t>(100 + i));
+    batch[i].data = packets[i];
+    batch[i].length = rtp_len_;
+    batch[i].capacity = sizeof(packets[i]);
+  }
+
+  EXPECT_EQ(kNumPackets, s1_.ProtectRtp(batch, kNumPackets));
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    EXPECT_EQ(rtp_len_ + rtp_auth_tag_len(CS_AES_CM_128_HMAC_SHA1_80),
+              batch[i].length);
+  }
+
+  // Tamper with the payload of the second packet.
+  packets[1][rtp_len_ - 1] ^= 0x01;
+  EXPECT_EQ(kNumPackets - 1, s2_.UnprotectRtp(batch, kNumPackets));
+  EXPECT_EQ(0, batch[1].length);
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    if (i == 1)
+      continue;
+    EXPECT_EQ(rtp_len_, batch[i].length);
+    // Everything but the sequence number matches the original packet.
+    EXPECT_EQ(0, memcmp(packets[i], kPcmuFrame, 2));
+    EXPECT_EQ(0, memcmp(packets[i] + 4, kPcmuFrame + 4, rtp_len_ - 4));
+  }
+}
+
+// Test that only the packets with too small buffers fail in a batch.
+TEST_F(SrtpSessionTest, TestProtectBatchBufferTooSmall) {
+  char packets[2][sizeof(kPcmuFrame) + 10];
+  cricket::SrtpPacket batch[2];
+  EXPECT_TRUE(s1_.SetSend(rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen));
+  for (size_t i = 0; i < 2; ++i) {
+    memcpy(packets[i], kPcmuFrame, rtp_len_);
+    rtc::SetBE16(reinterpret_cast<uint8_t*>(packets[i]) + 2,
+                 static_cast<uint16_t>(100 + i));
+    batch[i].data = packets[i];
+    batch[i].length = rtp_len_;
+  }
+  batch[0].capacity = sizeof(packets[0]) - 10;
+  batch[1].capacity = sizeof(packets[1]);
+  EXPECT_EQ(1u, s1_.ProtectRtp(batch, 2));
+  EXPECT_EQ(0, batch[0].length);
+  EXPECT_EQ(0, memcmp(packets[0], kPcmuFrame, 2));
+  EXPECT_EQ(rtp_len_ + rtp_auth_tag_len(CS_AES_CM_128_HMAC_SHA1_80),
+            batch[1].length);
+}
+
 TEST_F(SrtpSessionTest, TestReplay) {
   static const uint16_t kMaxSeqnum = static_cast<uint16_t>(-1);
   static const uint16_t seqnum_big = 62275;
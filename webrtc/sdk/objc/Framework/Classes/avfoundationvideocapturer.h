@@ -53,8 +53,8 @@ class AVFoundationVideoCapturer : public cricket::VideoCapturer,
   void SetUseBackCamera(bool useBackCamera);
   bool GetUseBackCamera() const;
 
-  // Converts the sample buffer into a cricket::CapturedFrame and signals the
-  // frame for capture.
+  // Wraps the sample buffer's pixel buffer in a frame, without copying it, and
+  // signals the frame for capture.
   void CaptureSampleBuffer(CMSampleBufferRef sampleBuffer);
 
   // Handles messages from posts.
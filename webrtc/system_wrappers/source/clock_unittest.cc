@@ -11,6 +11,7 @@
 #include "webrtc/system_wrappers/include/clock.h"
 
 #include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/fakeclock.h"
 
 namespace webrtc {
 
@@ -25,4 +26,14 @@ TEST(ClockTest, NtpTime) {
   EXPECT_NEAR(milliseconds, Clock::NtpToMs(seconds, fractions), 100);
 }
 
+TEST(ClockTest, RealTimeClockFollowsFakeClock) {
+  rtc::ScopedFakeClock fake_clock;
+  Clock* clock = Clock::GetRealTimeClock();
+  const int64_t start_ms = clock->TimeInMilliseconds();
+  // An hour passes instantly.
+  fake_clock.AdvanceTimeMicros(3600 * rtc::kNumMicrosecsPerSec);
+  EXPECT_EQ(start_ms + 3600 * rtc::kNumMillisecsPerSec,
+            clock->TimeInMilliseconds());
+}
+
 }  // namespace webrtc
@@ -9,7 +9,10 @@
 
 #include "webrtc/system_wrappers/include/metrics_default.h"
 
+#include <functional>
+
 #include "webrtc/base/criticalsection.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/system_wrappers/include/metrics.h"
 
@@ -26,6 +29,11 @@ namespace {
 // linearly/exponentially spaced buckets) if samples are logged more frequently.
 const int kMaxSampleMapSize = 300;
 
+// Samples are added to one of several shards, picked by the calling thread,
+// so that streams updating the same histogram from different threads rarely
+// contend for a lock. Readers merge the shards.
+const size_t kNumShards = 8;
+
 class RtcHistogram {
  public:
   RtcHistogram(const std::string& name, int min, int max, int bucket_count)
@@ -39,60 +47,98 @@ class RtcHistogram {
     if (sample > max_)
       sample = max_;
 
-    rtc::CritScope cs(&crit_);
-    if (info_.samples.size() == kMaxSampleMapSize &&
-        info_.samples.find(sample) == info_.samples.end()) {
-      return;
-    }
-    ++info_.samples[sample];
+    Shard* shard = &shards_[ShardIndex()];
+    rtc::CritScope cs(&shard->crit);
+    AddSamples(sample, 1, &shard->samples);
   }
 
   // Returns a copy (or nullptr if there are no samples) and clears samples.
   std::unique_ptr<SampleInfo> GetAndReset() {
-    rtc::CritScope cs(&crit_);
-    if (info_.samples.empty())
+    std::unique_ptr<SampleInfo> copy(
+        new SampleInfo(info_.name, info_.min, info_.max, info_.bucket_count));
+    for (Shard& shard : shards_) {
+      rtc::CritScope cs(&shard.crit);
+      for (const auto& sample : shard.samples)
+        AddSamples(sample.first, sample.second, &copy->samples);
+      shard.samples.clear();
+    }
+    if (copy->samples.empty())
       return nullptr;
-
-    SampleInfo* copy =
-        new SampleInfo(info_.name, info_.min, info_.max, info_.bucket_count);
-    copy->samples = info_.samples;
-    info_.samples.clear();
-    return std::unique_ptr<SampleInfo>(copy);
+    return copy;
   }
 
   const std::string& name() const { return info_.name; }
 
   // Functions only for testing.
   void Reset() {
-    rtc::CritScope cs(&crit_);
-    info_.samples.clear();
+    for (Shard& shard : shards_) {
+      rtc::CritScope cs(&shard.crit);
+      shard.samples.clear();
+    }
   }
 
   int NumEvents(int sample) const {
-    rtc::CritScope cs(&crit_);
-    const auto it = info_.samples.find(sample);
-    return (it == info_.samples.end()) ? 0 : it->second;
+    int num_events = 0;
+    for (const Shard& shard : shards_) {
+      rtc::CritScope cs(&shard.crit);
+      const auto it = shard.samples.find(sample);
+      if (it != shard.samples.end())
+        num_events += it->second;
+    }
+    return num_events;
   }
 
   int NumSamples() const {
     int num_samples = 0;
-    rtc::CritScope cs(&crit_);
-    for (const auto& sample : info_.samples) {
-      num_samples += sample.second;
+    for (const Shard& shard : shards_) {
+      rtc::CritScope cs(&shard.crit);
+      for (const auto& sample : shard.samples)
+        num_samples += sample.second;
     }
     return num_samples;
   }
 
   int MinSample() const {
-    rtc::CritScope cs(&crit_);
-    return (info_.samples.empty()) ? -1 : info_.samples.begin()->first;
+    int min_sample = -1;
+    for (const Shard& shard : shards_) {
+      rtc::CritScope cs(&shard.crit);
+      if (!shard.samples.empty() &&
+          (min_sample == -1 || shard.samples.begin()->first < min_sample)) {
+        min_sample = shard.samples.begin()->first;
+      }
+    }
+    return min_sample;
   }
 
  private:
-  rtc::CriticalSection crit_;
+  struct Shard {
+    rtc::CriticalSection crit;
+    std::map<int, int> samples GUARDED_BY(crit);
+  };
+
+  static size_t ShardIndex() {
+    // Unlike rtc::CurrentThreadId(), this doesn't make a system call. Thread
+    // refs tend to be aligned, so mix the bits before picking the shard.
+    const uint64_t hash =
+        static_cast<uint64_t>(
+            std::hash<rtc::PlatformThreadRef>()(rtc::CurrentThreadRef())) *
+        0x9E3779B97F4A7C15ull;
+    return (hash >> 32) % kNumShards;
+  }
+
+  static void AddSamples(int sample, int count, std::map<int, int>* samples) {
+    if (samples->size() == kMaxSampleMapSize &&
+        samples->find(sample) == samples->end()) {
+      return;
+    }
+    (*samples)[sample] += count;
+  }
+
   const int min_;
   const int max_;
-  SampleInfo info_ GUARDED_BY(crit_);
+  // Only holds the description of the histogram, the samples are in |shards_|.
+  const SampleInfo info_;
+  Shard shards_[kNumShards];
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtcHistogram);
 };
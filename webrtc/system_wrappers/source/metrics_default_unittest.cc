@@ -8,10 +8,18 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "testing/gtest/include/gtest/gtest.h"
 
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/system_wrappers/include/metrics.h"
 #include "webrtc/system_wrappers/include/metrics_default.h"
+#include "webrtc/test/testsupport/perf_test.h"
 
 namespace webrtc {
 
@@ -48,6 +56,31 @@ int NumEvents(const std::string& name,
 
   return it_sample->second;
 }
+
+const char kThreadedName[] = "Threaded";
+const int kSamplesPerThread = 100000;
+
+bool AddSamples(void* obj) {
+  for (int i = 0; i < kSamplesPerThread; ++i)
+    RTC_HISTOGRAM_COUNTS_100(kThreadedName, i % 100 + 1);
+  return false;
+}
+
+// Returns the time it takes |num_threads| threads to add |kSamplesPerThread|
+// samples each to the same histogram.
+int64_t AddSamplesOnThreadsUs(int num_threads) {
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back(
+        new rtc::PlatformThread(&AddSamples, nullptr, "AddSamples"));
+  }
+  const int64_t start_us = rtc::TimeMicros();
+  for (const auto& thread : threads)
+    thread->Start();
+  for (const auto& thread : threads)
+    thread->Stop();
+  return rtc::TimeMicros() - start_us;
+}
 }  // namespace
 
 class MetricsDefaultTest : public ::testing::Test {
@@ -151,4 +184,36 @@ TEST_F(MetricsDefaultTest, TestMinMaxBucket) {
   EXPECT_EQ(1u, histograms.begin()->second->samples.size());
 }
 
+TEST_F(MetricsDefaultTest, AddSamplesFromManyThreads) {
+  const int kNumThreads = 4;
+  AddSamplesOnThreadsUs(kNumThreads);
+  EXPECT_EQ(kNumThreads * kSamplesPerThread,
+            metrics::NumSamples(kThreadedName));
+  EXPECT_EQ(kNumThreads * kSamplesPerThread / 100,
+            metrics::NumEvents(kThreadedName, 1));
+  EXPECT_EQ(1, metrics::MinSample(kThreadedName));
+
+  std::map<std::string, std::unique_ptr<metrics::SampleInfo>> histograms;
+  metrics::GetAndReset(&histograms);
+  EXPECT_EQ(kNumThreads * kSamplesPerThread,
+            NumSamples(kThreadedName, histograms));
+  EXPECT_EQ(100u, histograms[kThreadedName]->samples.size());
+  EXPECT_EQ(0, metrics::NumSamples(kThreadedName));
+}
+
+// Measures how the histogram update throughput scales with the number of
+// threads updating the same histogram. Disabled because it takes too long to
+// run routinely. Use for performance benchmarking when needed.
+TEST_F(MetricsDefaultTest, DISABLED_AddSamplesThroughput) {
+  for (int num_threads : {1, 2, 4, 8}) {
+    const int64_t elapsed_us =
+        std::max<int64_t>(AddSamplesOnThreadsUs(num_threads), 1);
+    const int64_t num_samples = num_threads * kSamplesPerThread;
+    test::PrintResult("histogram_add", "",
+                      "threads_" + rtc::ToString(num_threads),
+                      static_cast<size_t>(num_samples * 1000 / elapsed_us),
+                      "samples/ms", false);
+  }
+}
+
 }  // namespace webrtc
@@ -37,7 +37,7 @@ class FakeNativeHandleBuffer : public NativeHandleBuffer {
   }
 
  private:
-  rtc::scoped_refptr<VideoFrameBuffer> NativeToI420Buffer() override {
+  rtc::scoped_refptr<VideoFrameBuffer> ConvertToI420() override {
     rtc::scoped_refptr<VideoFrameBuffer> buffer(
         new rtc::RefCountedObject<I420Buffer>(width_, height_));
     int half_height = (height_ + 1) / 2;
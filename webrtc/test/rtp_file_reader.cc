@@ -26,6 +26,9 @@ namespace test {
 
 static const size_t kFirstLineLength = 40;
 static uint16_t kPacketHeaderSize = 8;
+// Large enough for the replay tools, which read packets much faster than real
+// time, to need few system calls per dump.
+static const size_t kFileBufferSize = 1 << 20;
 
 #if 1
 # define DEBUG_LOG(text)
@@ -43,27 +46,27 @@ static uint16_t kPacketHeaderSize = 8;
     }                                                  \
   } while (0)
 
+FILE* OpenForReading(const std::string& filename) {
+  FILE* file = fopen(filename.c_str(), "rb");
+  if (file != NULL)
+    setvbuf(file, NULL, _IOFBF, kFileBufferSize);
+  return file;
+}
+
 bool ReadUint32(uint32_t* out, FILE* file) {
-  *out = 0;
-  for (size_t i = 0; i < 4; ++i) {
-    *out <<= 8;
-    uint8_t tmp;
-    if (fread(&tmp, 1, sizeof(uint8_t), file) != sizeof(uint8_t))
-      return false;
-    *out |= tmp;
-  }
+  uint8_t tmp[4];
+  if (fread(tmp, 1, sizeof(tmp), file) != sizeof(tmp))
+    return false;
+  *out = (static_cast<uint32_t>(tmp[0]) << 24) | (tmp[1] << 16) |
+         (tmp[2] << 8) | tmp[3];
   return true;
 }
 
 bool ReadUint16(uint16_t* out, FILE* file) {
-  *out = 0;
-  for (size_t i = 0; i < 2; ++i) {
-    *out <<= 8;
-    uint8_t tmp;
-    if (fread(&tmp, 1, sizeof(uint8_t), file) != sizeof(uint8_t))
-      return false;
-    *out |= tmp;
-  }
+  uint8_t tmp[2];
+  if (fread(tmp, 1, sizeof(tmp), file) != sizeof(tmp))
+    return false;
+  *out = (tmp[0] << 8) | tmp[1];
   return true;
 }
 
@@ -84,7 +87,7 @@ class InterleavedRtpFileReader : public RtpFileReaderImpl {
 
   virtual bool Init(const std::string& filename,
                     const std::set<uint32_t>& ssrc_filter) {
-    file_ = fopen(filename.c_str(), "rb");
+    file_ = OpenForReading(filename);
     if (file_ == NULL) {
       printf("ERROR: Can't open file: %s\n", filename.c_str());
       return false;
@@ -131,7 +134,7 @@ class RtpDumpReader : public RtpFileReaderImpl {
 
   bool Init(const std::string& filename,
             const std::set<uint32_t>& ssrc_filter) override {
-    file_ = fopen(filename.c_str(), "rb");
+    file_ = OpenForReading(filename);
     if (file_ == NULL) {
       printf("ERROR: Can't open file: %s\n", filename.c_str());
       return false;
@@ -275,7 +278,7 @@ class PcapReader : public RtpFileReaderImpl {
 
   int Initialize(const std::string& filename,
                  const std::set<uint32_t>& ssrc_filter) {
-    file_ = fopen(filename.c_str(), "rb");
+    file_ = OpenForReading(filename);
     if (file_ == NULL) {
       printf("ERROR: Can't open file: %s\n", filename.c_str());
       return kResultFail;
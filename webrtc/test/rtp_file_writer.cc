@@ -22,6 +22,8 @@ namespace test {
 
 static const uint16_t kPacketHeaderSize = 8;
 static const char kFirstLine[] = "#!rtpplay1.0 0.0.0.0/0\n";
+// Dumps are written packet by packet; buffer them to need few system calls.
+static const size_t kFileBufferSize = 1 << 20;
 
 // Write RTP packets to file in rtpdump format, as documented at:
 // http://www.cs.columbia.edu/irt/software/rtptools/
@@ -42,9 +44,11 @@ class RtpDumpWriter : public RtpFileWriter {
     uint16_t len = static_cast<uint16_t>(packet->length + kPacketHeaderSize);
     uint16_t plen = static_cast<uint16_t>(packet->original_length);
     uint32_t offset = packet->time_ms;
-    RTC_CHECK(WriteUint16(len));
-    RTC_CHECK(WriteUint16(plen));
-    RTC_CHECK(WriteUint32(offset));
+    uint8_t header[kPacketHeaderSize];
+    PutUint16(len, &header[0]);
+    PutUint16(plen, &header[2]);
+    PutUint32(offset, &header[4]);
+    RTC_CHECK_EQ(sizeof(header), fwrite(header, 1, sizeof(header), file_));
     return fwrite(packet->data, sizeof(uint8_t), packet->length, file_) ==
            packet->length;
   }
@@ -63,25 +67,28 @@ class RtpDumpWriter : public RtpFileWriter {
   }
 
   bool WriteUint32(uint32_t in) {
-    // Loop through shifts = {24, 16, 8, 0}.
-    for (int shifts = 24; shifts >= 0; shifts -= 8) {
-      uint8_t tmp = static_cast<uint8_t>((in >> shifts) & 0xFF);
-      if (fwrite(&tmp, sizeof(uint8_t), 1, file_) != 1)
-        return false;
-    }
-    return true;
+    uint8_t tmp[4];
+    PutUint32(in, tmp);
+    return fwrite(tmp, 1, sizeof(tmp), file_) == sizeof(tmp);
   }
 
   bool WriteUint16(uint16_t in) {
-    // Write 8 MSBs.
-    uint8_t tmp = static_cast<uint8_t>((in >> 8) & 0xFF);
-    if (fwrite(&tmp, sizeof(uint8_t), 1, file_) != 1)
-      return false;
-    // Write 8 LSBs.
-    tmp = static_cast<uint8_t>(in & 0xFF);
-    if (fwrite(&tmp, sizeof(uint8_t), 1, file_) != 1)
-      return false;
-    return true;
+    uint8_t tmp[2];
+    PutUint16(in, tmp);
+    return fwrite(tmp, 1, sizeof(tmp), file_) == sizeof(tmp);
+  }
+
+  // Stores |in| in network byte order.
+  static void PutUint32(uint32_t in, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(in >> 24);
+    out[1] = static_cast<uint8_t>(in >> 16);
+    out[2] = static_cast<uint8_t>(in >> 8);
+    out[3] = static_cast<uint8_t>(in);
+  }
+
+  static void PutUint16(uint16_t in, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(in >> 8);
+    out[1] = static_cast<uint8_t>(in);
   }
 
   FILE* file_;
@@ -96,6 +103,7 @@ RtpFileWriter* RtpFileWriter::Create(FileFormat format,
     printf("ERROR: Can't open file: %s\n", filename.c_str());
     return NULL;
   }
+  setvbuf(file, NULL, _IOFBF, kFileBufferSize);
   switch (format) {
     case kRtpDump:
       return new RtpDumpWriter(file);
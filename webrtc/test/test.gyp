@@ -143,6 +143,7 @@
         'testsupport/packet_reader.h',
         'testsupport/perf_test.cc',
         'testsupport/perf_test.h',
+        'testsupport/perf_timer.h',
         'testsupport/trace_to_stderr.cc',
         'testsupport/trace_to_stderr.h',
       ],
@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_TEST_TESTSUPPORT_PERF_TIMER_H_
+#define WEBRTC_TEST_TESTSUPPORT_PERF_TIMER_H_
+
+#include <algorithm>
+
+#include "webrtc/base/timeutils.h"
+
+namespace webrtc {
+namespace test {
+
+// Calls |function| |num_calls| times and returns the number of calls per
+// second. |function| should leave its results where the caller checks them
+// afterwards, so that the compiler cannot drop the calls and the test verifies
+// what was measured.
+template <typename Function>
+double MeasureCallsPerSecond(int num_calls, Function function) {
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_calls; ++i)
+    function();
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  return static_cast<double>(num_calls) * rtc::kNumNanosecsPerSec /
+         std::max<int64_t>(elapsed_ns, 1);
+}
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // WEBRTC_TEST_TESTSUPPORT_PERF_TIMER_H_
@@ -37,7 +37,7 @@
  * Usage:
  * frame_analyzer --label=<test_label> --reference_file=<name_of_file>
  * --test_file=<name_of_file> --stats_file=<name_of_file> --width=<frame_width>
- * --height=<frame_height>
+ * --height=<frame_height> [--threads=<threads>] [--regions=<grid_size>]
  */
 int main(int argc, char** argv) {
   std::string program_name = argv[0];
@@ -55,7 +55,11 @@ int main(int argc, char** argv) {
       "  - reference_file(string): The reference YUV file to compare against."
       " Default: ref.yuv\n"
       "  - test_file(string): The test YUV file to run the analysis for."
-      " Default: test_file.yuv\n";
+      " Default: test_file.yuv\n"
+      "  - threads(int): The number of threads analyzing frames. Default: the"
+      " number of cores\n"
+      "  - regions(int): Also analyze each region of an N x N grid over the"
+      " frames. Default: 1\n";
 
   webrtc::test::CommandLineParser parser;
 
@@ -69,6 +73,8 @@ int main(int argc, char** argv) {
   parser.SetFlag("stats_file", "stats.txt");
   parser.SetFlag("reference_file", "ref.yuv");
   parser.SetFlag("test_file", "test.yuv");
+  parser.SetFlag("threads", "0");
+  parser.SetFlag("regions", "1");
   parser.SetFlag("help", "false");
 
   parser.ProcessFlags();
@@ -86,12 +92,25 @@ int main(int argc, char** argv) {
     return -1;
   }
 
+  webrtc::test::AnalysisOptions options;
+  int threads = strtol((parser.GetFlag("threads")).c_str(), NULL, 10);
+  if (threads > 0)
+    options.num_threads = threads;
+  int regions = strtol((parser.GetFlag("regions")).c_str(), NULL, 10);
+  if (regions <= 0 || regions > width / 2 || regions > height / 2) {
+    fprintf(stderr, "Error: regions must be > 0 and leave regions of at least "
+            "2 x 2 pixels!\n");
+    return -1;
+  }
+  options.region_columns = regions;
+  options.region_rows = regions;
+
   webrtc::test::ResultsContainer results;
 
   webrtc::test::RunAnalysis(parser.GetFlag("reference_file").c_str(),
                             parser.GetFlag("test_file").c_str(),
                             parser.GetFlag("stats_file").c_str(), width, height,
-                            &results);
+                            options, &results);
 
   std::string label = parser.GetFlag("label");
   webrtc::test::PrintAnalysisResults(label, &results);
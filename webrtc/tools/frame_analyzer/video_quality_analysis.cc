@@ -13,9 +13,22 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#if !defined(WEBRTC_WIN)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
 #include <string>
 
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
+
 #define STATS_LINE_LENGTH 32
 #define Y4M_FILE_HEADER_MAX_SIZE 200
 #define Y4M_FRAME_DELIMITER "FRAME"
@@ -26,9 +39,148 @@ namespace test {
 
 using std::string;
 
+namespace {
+
+// Shared by the threads of AnalyzeFramePairs(), which each take the next frame
+// pair until all have been analyzed.
+struct FrameAnalysis {
+  const std::vector<FramePair>* frame_pairs;
+  int width;
+  int height;
+  const AnalysisOptions* options;
+  std::vector<AnalysisResult>* results;
+  volatile int next_index;
+};
+
+AnalysisResult AnalyzeFramePair(const FramePair& frame_pair,
+                                int width,
+                                int height,
+                                const AnalysisOptions& options) {
+  AnalysisResult result(
+      frame_pair.frame_number,
+      CalculateMetrics(kPSNR, frame_pair.reference_frame,
+                       frame_pair.test_frame, width, height),
+      CalculateMetrics(kSSIM, frame_pair.reference_frame,
+                       frame_pair.test_frame, width, height));
+  if (options.region_columns == 1 && options.region_rows == 1)
+    return result;
+
+  for (int row = 0; row < options.region_rows; ++row) {
+    // Regions start at even pixels, since the chroma planes are subsampled.
+    const int y = (height * row / options.region_rows) & ~1;
+    const int next_y = row + 1 == options.region_rows
+                           ? height
+                           : (height * (row + 1) / options.region_rows) & ~1;
+    for (int column = 0; column < options.region_columns; ++column) {
+      const int x = (width * column / options.region_columns) & ~1;
+      const int next_x =
+          column + 1 == options.region_columns
+              ? width
+              : (width * (column + 1) / options.region_columns) & ~1;
+      result.region_psnr_values.push_back(CalculateRegionMetrics(
+          kPSNR, frame_pair.reference_frame, frame_pair.test_frame, width,
+          height, x, y, next_x - x, next_y - y));
+      result.region_ssim_values.push_back(CalculateRegionMetrics(
+          kSSIM, frame_pair.reference_frame, frame_pair.test_frame, width,
+          height, x, y, next_x - x, next_y - y));
+    }
+  }
+  return result;
+}
+
+bool AnalyzeFramesThread(void* obj) {
+  FrameAnalysis* analysis = static_cast<FrameAnalysis*>(obj);
+  const int num_frame_pairs = static_cast<int>(analysis->frame_pairs->size());
+  int index;
+  while ((index = rtc::AtomicOps::Increment(&analysis->next_index) - 1) <
+         num_frame_pairs) {
+    (*analysis->results)[index] =
+        AnalyzeFramePair((*analysis->frame_pairs)[index], analysis->width,
+                         analysis->height, *analysis->options);
+  }
+  // Run only once.
+  return false;
+}
+
+// Returns the offset of the first frame header in a mapped Y4M file, or -1 if
+// it can't be found.
+int FindFirstY4mFrame(const MappedFile& file) {
+  const size_t header_size = std::min<size_t>(file.size(),
+                                              Y4M_FILE_HEADER_MAX_SIZE);
+  const std::string header(reinterpret_cast<const char*>(file.data()),
+                           header_size);
+  const size_t found = header.find(Y4M_FRAME_DELIMITER);
+  return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+}  // namespace
+
 ResultsContainer::ResultsContainer() {}
 ResultsContainer::~ResultsContainer() {}
 
+AnalysisOptions::AnalysisOptions()
+    : num_threads(static_cast<int>(CpuInfo::DetectNumberOfCores())),
+      region_columns(1),
+      region_rows(1) {}
+
+std::unique_ptr<MappedFile> MappedFile::Open(const char* file_name) {
+  FILE* file = fopen(file_name, "rb");
+  if (file == NULL) {
+    fprintf(stderr, "Couldn't open input file for reading: %s\n", file_name);
+    return nullptr;
+  }
+  if (fseek(file, 0, SEEK_END) != 0) {
+    fclose(file);
+    return nullptr;
+  }
+  const long file_size = ftell(file);
+  if (file_size < 0) {
+    fclose(file);
+    return nullptr;
+  }
+  const size_t size = static_cast<size_t>(file_size);
+  if (size == 0) {
+    fclose(file);
+    return std::unique_ptr<MappedFile>(new MappedFile(nullptr, 0, false));
+  }
+
+#if !defined(WEBRTC_WIN)
+  void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+  if (mapped != MAP_FAILED) {
+    fclose(file);
+    // The files are read from start to end, more or less.
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    return std::unique_ptr<MappedFile>(
+        new MappedFile(static_cast<const uint8_t*>(mapped), size, true));
+  }
+#endif
+
+  // Fall back to reading the whole file.
+  uint8_t* data = new uint8_t[size];
+  rewind(file);
+  const size_t bytes_read = fread(data, 1, size, file);
+  fclose(file);
+  if (bytes_read != size) {
+    fprintf(stderr, "Error while reading file %s\n", file_name);
+    delete[] data;
+    return nullptr;
+  }
+  return std::unique_ptr<MappedFile>(new MappedFile(data, size, false));
+}
+
+MappedFile::MappedFile(const uint8_t* data, size_t size, bool mapped)
+    : data_(data), size_(size), mapped_(mapped) {}
+
+MappedFile::~MappedFile() {
+#if !defined(WEBRTC_WIN)
+  if (mapped_) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+    return;
+  }
+#endif
+  delete[] data_;
+}
+
 int GetI420FrameSize(int width, int height) {
   int half_width = (width + 1) >> 1;
   int half_height = (height + 1) >> 1;
@@ -90,6 +242,32 @@ bool GetNextStatsLine(FILE* stats_file, char* line) {
   return true;
 }
 
+bool IsY4mFile(const std::string& file_name) {
+  return file_name.find("y4m") != std::string::npos;
+}
+
+const uint8_t* GetI420Frame(const MappedFile& file,
+                            bool y4m,
+                            int width,
+                            int height,
+                            int frame_number) {
+  const size_t frame_size = GetI420FrameSize(width, height);
+  size_t offset = frame_number * frame_size;
+  if (y4m) {
+    // Every frame has a frame header, and the first one follows the file
+    // header.
+    const int first_frame = FindFirstY4mFrame(file);
+    if (first_frame < 0)
+      return nullptr;
+    offset = first_frame +
+             frame_number * (frame_size + Y4M_FRAME_HEADER_SIZE) +
+             Y4M_FRAME_HEADER_SIZE;
+  }
+  if (frame_number < 0 || offset + frame_size > file.size())
+    return nullptr;
+  return file.data() + offset;
+}
+
 bool ExtractFrameFromYuvFile(const char* i420_file_name,
                              int width,
                              int height,
@@ -180,31 +358,52 @@ double CalculateMetrics(VideoAnalysisMetricsType video_metrics_type,
                         const uint8_t* test_frame,
                         int width,
                         int height) {
+  return CalculateRegionMetrics(video_metrics_type, ref_frame, test_frame,
+                                width, height, 0, 0, width, height);
+}
+
+double CalculateRegionMetrics(VideoAnalysisMetricsType video_metrics_type,
+                              const uint8_t* ref_frame,
+                              const uint8_t* test_frame,
+                              int width,
+                              int height,
+                              int x,
+                              int y,
+                              int region_width,
+                              int region_height) {
   if (!ref_frame || !test_frame)
     return -1;
   else if (height < 0 || width < 0)
     return -1;
+  else if (x < 0 || y < 0 || (x & 1) || (y & 1) || region_width < 0 ||
+           region_height < 0 || x + region_width > width ||
+           y + region_height > height)
+    return -1;
   int half_width = (width + 1) >> 1;
   int half_height = (height + 1) >> 1;
-  const uint8_t* src_y_a = ref_frame;
-  const uint8_t* src_u_a = src_y_a + width * height;
-  const uint8_t* src_v_a = src_u_a + half_width * half_height;
-  const uint8_t* src_y_b = test_frame;
-  const uint8_t* src_u_b = src_y_b + width * height;
-  const uint8_t* src_v_b = src_u_b + half_width * half_height;
-
   int stride_y = width;
   int stride_uv = half_width;
 
+  int y_offset = y * stride_y + x;
+  int uv_offset = (y >> 1) * stride_uv + (x >> 1);
+  const uint8_t* src_y_a = ref_frame + y_offset;
+  const uint8_t* src_u_a = ref_frame + width * height + uv_offset;
+  const uint8_t* src_v_a =
+      ref_frame + width * height + half_width * half_height + uv_offset;
+  const uint8_t* src_y_b = test_frame + y_offset;
+  const uint8_t* src_u_b = test_frame + width * height + uv_offset;
+  const uint8_t* src_v_b =
+      test_frame + width * height + half_width * half_height + uv_offset;
+
   double result = 0.0;
 
   switch (video_metrics_type) {
     case kPSNR:
       // In the following: stride is determined by width.
-      result = libyuv::I420Psnr(src_y_a, width, src_u_a, half_width,
-                                src_v_a, half_width, src_y_b, width,
-                                src_u_b, half_width, src_v_b, half_width,
-                                width, height);
+      result = libyuv::I420Psnr(src_y_a, stride_y, src_u_a, stride_uv,
+                                src_v_a, stride_uv, src_y_b, stride_y,
+                                src_u_b, stride_uv, src_v_b, stride_uv,
+                                region_width, region_height);
       // LibYuv sets the max psnr value to 128, we restrict it to 48.
       // In case of 0 mse in one frame, 128 can skew the results significantly.
       result = (result > 48.0) ? 48.0 : result;
@@ -213,7 +412,7 @@ double CalculateMetrics(VideoAnalysisMetricsType video_metrics_type,
       result = libyuv::I420Ssim(src_y_a, stride_y, src_u_a, stride_uv,
                                 src_v_a, stride_uv, src_y_b, stride_y,
                                 src_u_b, stride_uv, src_v_b, stride_uv,
-                                width, height);
+                                region_width, region_height);
       break;
     default:
       assert(false);
@@ -222,24 +421,60 @@ double CalculateMetrics(VideoAnalysisMetricsType video_metrics_type,
   return result;
 }
 
+void AnalyzeFramePairs(const std::vector<FramePair>& frame_pairs,
+                       int width,
+                       int height,
+                       const AnalysisOptions& options,
+                       ResultsContainer* results) {
+  std::vector<AnalysisResult> frame_results(frame_pairs.size());
+  FrameAnalysis analysis = {&frame_pairs, width,           height,
+                            &options,     &frame_results, 0};
+  const int num_threads = std::min(std::max(options.num_threads, 1),
+                                   static_cast<int>(frame_pairs.size()));
+  if (num_threads <= 1) {
+    AnalyzeFramesThread(&analysis);
+  } else {
+    std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.emplace_back(new rtc::PlatformThread(
+          &AnalyzeFramesThread, &analysis, "FrameAnalysis"));
+      threads.back()->Start();
+    }
+    for (const auto& thread : threads)
+      thread->Stop();
+  }
+  results->frames.insert(results->frames.end(), frame_results.begin(),
+                         frame_results.end());
+}
+
 void RunAnalysis(const char* reference_file_name, const char* test_file_name,
                  const char* stats_file_name, int width, int height,
                  ResultsContainer* results) {
-  // Check if the reference_file_name ends with "y4m".
-  bool y4m_mode = false;
-  if (std::string(reference_file_name).find("y4m") != std::string::npos) {
-    y4m_mode = true;
-  }
+  RunAnalysis(reference_file_name, test_file_name, stats_file_name, width,
+              height, AnalysisOptions(), results);
+}
 
-  int size = GetI420FrameSize(width, height);
+void RunAnalysis(const char* reference_file_name, const char* test_file_name,
+                 const char* stats_file_name, int width, int height,
+                 const AnalysisOptions& options, ResultsContainer* results) {
+  bool y4m_mode = IsY4mFile(reference_file_name);
+
+  std::unique_ptr<MappedFile> reference_file =
+      MappedFile::Open(reference_file_name);
+  std::unique_ptr<MappedFile> test_file = MappedFile::Open(test_file_name);
+  if (!reference_file || !test_file)
+    return;
   FILE* stats_file = fopen(stats_file_name, "r");
+  if (stats_file == NULL) {
+    fprintf(stderr, "Couldn't open stats file for reading: %s\n",
+            stats_file_name);
+    return;
+  }
 
   // String buffer for the lines in the stats file.
   char line[STATS_LINE_LENGTH];
 
-  // Allocate buffers for test and reference frames.
-  uint8_t* test_frame = new uint8_t[size];
-  uint8_t* reference_frame = new uint8_t[size];
+  std::vector<FramePair> frame_pairs;
   int previous_frame_number = -1;
 
   // While there are entries in the stats file.
@@ -257,37 +492,25 @@ void RunAnalysis(const char* reference_file_name, const char* test_file_name,
     assert(extracted_test_frame != -1);
     assert(decoded_frame_number != -1);
 
-    ExtractFrameFromYuvFile(test_file_name, width, height, extracted_test_frame,
-                            test_frame);
-    if (y4m_mode) {
-      ExtractFrameFromY4mFile(reference_file_name, width, height,
-                              decoded_frame_number, reference_frame);
-    } else {
-      ExtractFrameFromYuvFile(reference_file_name, width, height,
-                              decoded_frame_number, reference_frame);
+    FramePair frame_pair;
+    frame_pair.frame_number = decoded_frame_number;
+    frame_pair.test_frame = GetI420Frame(*test_file, false, width, height,
+                                         extracted_test_frame);
+    frame_pair.reference_frame = GetI420Frame(
+        *reference_file, y4m_mode, width, height, decoded_frame_number);
+    if (!frame_pair.test_frame || !frame_pair.reference_frame) {
+      fprintf(stdout, "Missing frame, test: %d reference: %d\n",
+              extracted_test_frame, decoded_frame_number);
+      continue;
     }
 
-    // Calculate the PSNR and SSIM.
-    double result_psnr = CalculateMetrics(kPSNR, reference_frame, test_frame,
-                                          width, height);
-    double result_ssim = CalculateMetrics(kSSIM, reference_frame, test_frame,
-                                          width, height);
-
     previous_frame_number = decoded_frame_number;
-
-    // Fill in the result struct.
-    AnalysisResult result;
-    result.frame_number = decoded_frame_number;
-    result.psnr_value = result_psnr;
-    result.ssim_value = result_ssim;
-
-    results->frames.push_back(result);
+    frame_pairs.push_back(frame_pair);
   }
-
-  // Cleanup.
   fclose(stats_file);
-  delete[] test_frame;
-  delete[] reference_frame;
+
+  // Calculate the PSNR and SSIM.
+  AnalyzeFramePairs(frame_pairs, width, height, options, results);
 }
 
 void PrintMaxRepeatedAndSkippedFrames(const std::string& label,
@@ -368,6 +591,26 @@ void PrintAnalysisResults(FILE* output, const std::string& label,
       fprintf(output, "%f,", iter->ssim_value);
     }
     fprintf(output, "%f] score\n", iter->ssim_value);
+
+    const size_t num_regions =
+        results->frames.front().region_psnr_values.size();
+    for (size_t region = 0; region < num_regions; ++region) {
+      fprintf(output, "RESULT PSNR_region_%u: %s= [",
+              static_cast<unsigned int>(region), label.c_str());
+      for (iter = results->frames.begin(); iter != results->frames.end() - 1;
+           ++iter) {
+        fprintf(output, "%f,", iter->region_psnr_values[region]);
+      }
+      fprintf(output, "%f] dB\n", iter->region_psnr_values[region]);
+
+      fprintf(output, "RESULT SSIM_region_%u: %s= [",
+              static_cast<unsigned int>(region), label.c_str());
+      for (iter = results->frames.begin(); iter != results->frames.end() - 1;
+           ++iter) {
+        fprintf(output, "%f,", iter->region_ssim_values[region]);
+      }
+      fprintf(output, "%f] score\n", iter->region_ssim_values[region]);
+    }
   }
 }
 
@@ -11,11 +11,13 @@
 #ifndef WEBRTC_TOOLS_FRAME_ANALYZER_VIDEO_QUALITY_ANALYSIS_H_
 #define WEBRTC_TOOLS_FRAME_ANALYZER_VIDEO_QUALITY_ANALYSIS_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "libyuv/compare.h"  // NOLINT
 #include "libyuv/convert.h"  // NOLINT
+#include "webrtc/base/constructormagic.h"
 
 namespace webrtc {
 namespace test {
@@ -29,6 +31,10 @@ struct AnalysisResult {
   int frame_number;
   double psnr_value;
   double ssim_value;
+  // Metrics of each region of the frame, row by row, if regions were asked
+  // for. See AnalysisOptions.
+  std::vector<double> region_psnr_values;
+  std::vector<double> region_ssim_values;
 };
 
 struct ResultsContainer {
@@ -40,6 +46,48 @@ struct ResultsContainer {
 
 enum VideoAnalysisMetricsType {kPSNR, kSSIM};
 
+struct AnalysisOptions {
+  AnalysisOptions();
+
+  // Number of threads computing metrics. Defaults to the number of cores.
+  int num_threads;
+  // Besides the whole frame, compute metrics for each cell of a grid of
+  // |region_columns| x |region_rows| regions. There are no regions if both are
+  // 1, which is the default.
+  int region_columns;
+  int region_rows;
+};
+
+// A read-only view of the contents of a whole file. The file is memory-mapped
+// where that's supported, so that frames can be read from several threads at
+// once without seeking or copying.
+class MappedFile {
+ public:
+  // Returns null if the file can't be opened.
+  static std::unique_ptr<MappedFile> Open(const char* file_name);
+  ~MappedFile();
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  MappedFile(const uint8_t* data, size_t size, bool mapped);
+
+  const uint8_t* const data_;
+  const size_t size_;
+  // Whether |data_| is mapped, or was read into memory.
+  const bool mapped_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MappedFile);
+};
+
+// A reference frame and the test frame to compare it with.
+struct FramePair {
+  int frame_number;
+  const uint8_t* reference_frame;
+  const uint8_t* test_frame;
+};
+
 // A function to run the PSNR and SSIM analysis on the test file. The test file
 // comprises the frames that were captured during the quality measurement test.
 // There may be missing or duplicate frames. Also the frames start at a random
@@ -57,6 +105,20 @@ void RunAnalysis(const char* reference_file_name, const char* test_file_name,
                  const char* stats_file_name, int width, int height,
                  ResultsContainer* results);
 
+// Same as above, but with the threads and regions given by |options|.
+void RunAnalysis(const char* reference_file_name, const char* test_file_name,
+                 const char* stats_file_name, int width, int height,
+                 const AnalysisOptions& options, ResultsContainer* results);
+
+// Runs the PSNR and SSIM analysis on each pair of frames in |frame_pairs|,
+// spread over the threads given by |options|. The results are appended to
+// |results| in the order of |frame_pairs|.
+void AnalyzeFramePairs(const std::vector<FramePair>& frame_pairs,
+                       int width,
+                       int height,
+                       const AnalysisOptions& options,
+                       ResultsContainer* results);
+
 // Compute PSNR or SSIM for an I420 frame (all planes). When we are calculating
 // PSNR values, the max return value (in the case where the test and reference
 // frames are exactly the same) will be 48. In the case of SSIM the max return
@@ -67,9 +129,22 @@ double CalculateMetrics(VideoAnalysisMetricsType video_metrics_type,
                         int width,
                         int height);
 
+// Same as above, but only for the |region_width| x |region_height| region at
+// (|x|, |y|) of the frames. |x| and |y| must be even.
+double CalculateRegionMetrics(VideoAnalysisMetricsType video_metrics_type,
+                              const uint8_t* ref_frame,
+                              const uint8_t* test_frame,
+                              int width,
+                              int height,
+                              int x,
+                              int y,
+                              int region_width,
+                              int region_height);
+
 // Prints the result from the analysis in Chromium performance
 // numbers compatible format to stdout. If the results object contains no frames
-// no output will be written.
+// no output will be written. Region metrics are printed as one result per
+// region.
 void PrintAnalysisResults(const std::string& label, ResultsContainer* results);
 
 // Similar to the above, but will print to the specified file handle.
@@ -102,6 +177,18 @@ bool IsThereBarcodeError(std::string line);
 // frame_0023 0284, we will get 284.
 int ExtractDecodedFrameNumber(std::string line);
 
+// Returns whether |file_name| is a Y4M file, judging by its name.
+bool IsY4mFile(const std::string& file_name);
+
+// Returns the I420 frame at position |frame_number| in a mapped raw YUV file,
+// or in a mapped Y4M file if |y4m| is set. Returns null if the file doesn't
+// contain that frame. The first frame has |frame_number| 0.
+const uint8_t* GetI420Frame(const MappedFile& file,
+                            bool y4m,
+                            int width,
+                            int height,
+                            int frame_number);
+
 // Extracts an I420 frame at position frame_number from the raw YUV file.
 bool ExtractFrameFromYuvFile(const char* i420_file_name,
                              int width,
@@ -11,8 +11,11 @@
 // This test doesn't actually verify the output since it's just printed
 // to stdout by void functions, but it's still useful as it executes the code.
 
+#include <string.h>
+
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "testing/gtest/include/gtest/gtest.h"
 #include "webrtc/test/testsupport/fileutils.h"
@@ -86,6 +89,139 @@ TEST_F(VideoQualityAnalysisTest, PrintMaxRepeatedAndSkippedFramesNormalFile) {
   PrintMaxRepeatedAndSkippedFrames(logfile_, "NormalStatsFile", stats_filename);
 }
 
+namespace {
+const int kWidth = 32;
+const int kHeight = 16;
+
+// Writes |num_frames| I420 frames, where frame n is filled with n plus the
+// pixel's offset in the frame.
+void WriteYuvFile(const std::string& file_name, int num_frames) {
+  const int frame_size = GetI420FrameSize(kWidth, kHeight);
+  FILE* file = fopen(file_name.c_str(), "wb");
+  ASSERT_TRUE(file != NULL);
+  for (int n = 0; n < num_frames; ++n) {
+    std::vector<uint8_t> frame(frame_size);
+    for (int i = 0; i < frame_size; ++i)
+      frame[i] = static_cast<uint8_t>(n + i);
+    fwrite(frame.data(), 1, frame.size(), file);
+  }
+  fclose(file);
+}
+}  // namespace
+
+TEST_F(VideoQualityAnalysisTest, GetI420FrameFromMappedYuvFile) {
+  std::string file_name = OutputPath() + "mapped.yuv";
+  WriteYuvFile(file_name, 3);
+  std::unique_ptr<MappedFile> file = MappedFile::Open(file_name.c_str());
+  ASSERT_TRUE(file);
+  EXPECT_EQ(static_cast<size_t>(3 * GetI420FrameSize(kWidth, kHeight)),
+            file->size());
+
+  std::vector<uint8_t> extracted(GetI420FrameSize(kWidth, kHeight));
+  for (int n = 0; n < 3; ++n) {
+    const uint8_t* frame = GetI420Frame(*file, false, kWidth, kHeight, n);
+    ASSERT_TRUE(frame != NULL);
+    ASSERT_TRUE(ExtractFrameFromYuvFile(file_name.c_str(), kWidth, kHeight, n,
+                                        extracted.data()));
+    EXPECT_EQ(0, memcmp(extracted.data(), frame, extracted.size()));
+  }
+  EXPECT_TRUE(GetI420Frame(*file, false, kWidth, kHeight, 3) == NULL);
+  remove(file_name.c_str());
+}
+
+TEST_F(VideoQualityAnalysisTest, GetI420FrameFromMappedY4mFile) {
+  std::string file_name = OutputPath() + "mapped.y4m";
+  const int frame_size = GetI420FrameSize(kWidth, kHeight);
+  FILE* y4m_file = fopen(file_name.c_str(), "wb");
+  ASSERT_TRUE(y4m_file != NULL);
+  fprintf(y4m_file, "YUV4MPEG2 W%d H%d F30:1 C420\n", kWidth, kHeight);
+  for (int n = 0; n < 2; ++n) {
+    fprintf(y4m_file, "FRAME\n");
+    std::vector<uint8_t> frame(frame_size, static_cast<uint8_t>(n + 1));
+    fwrite(frame.data(), 1, frame.size(), y4m_file);
+  }
+  fclose(y4m_file);
+
+  std::unique_ptr<MappedFile> file = MappedFile::Open(file_name.c_str());
+  ASSERT_TRUE(file);
+  for (int n = 0; n < 2; ++n) {
+    const uint8_t* frame = GetI420Frame(*file, true, kWidth, kHeight, n);
+    ASSERT_TRUE(frame != NULL);
+    EXPECT_EQ(n + 1, frame[0]);
+    EXPECT_EQ(n + 1, frame[frame_size - 1]);
+  }
+  EXPECT_TRUE(GetI420Frame(*file, true, kWidth, kHeight, 2) == NULL);
+  remove(file_name.c_str());
+}
+
+TEST_F(VideoQualityAnalysisTest, ParallelAnalysisMatchesSerialAnalysis) {
+  const int kNumFrames = 10;
+  std::string reference_name = OutputPath() + "reference.yuv";
+  std::string test_name = OutputPath() + "test.yuv";
+  WriteYuvFile(reference_name, kNumFrames);
+  WriteYuvFile(test_name, kNumFrames + 1);
+  std::unique_ptr<MappedFile> reference = MappedFile::Open(
+      reference_name.c_str());
+  std::unique_ptr<MappedFile> test = MappedFile::Open(test_name.c_str());
+  ASSERT_TRUE(reference && test);
+
+  // Compare each reference frame with the next test frame, so that they
+  // differ.
+  std::vector<FramePair> frame_pairs;
+  for (int n = 0; n < kNumFrames; ++n) {
+    FramePair frame_pair;
+    frame_pair.frame_number = n;
+    frame_pair.reference_frame =
+        GetI420Frame(*reference, false, kWidth, kHeight, n);
+    frame_pair.test_frame = GetI420Frame(*test, false, kWidth, kHeight, n + 1);
+    frame_pairs.push_back(frame_pair);
+  }
+
+  AnalysisOptions serial_options;
+  serial_options.num_threads = 1;
+  ResultsContainer serial_results;
+  AnalyzeFramePairs(frame_pairs, kWidth, kHeight, serial_options,
+                    &serial_results);
+
+  AnalysisOptions parallel_options;
+  parallel_options.num_threads = 4;
+  parallel_options.region_columns = 2;
+  parallel_options.region_rows = 2;
+  ResultsContainer parallel_results;
+  AnalyzeFramePairs(frame_pairs, kWidth, kHeight, parallel_options,
+                    &parallel_results);
+
+  ASSERT_EQ(static_cast<size_t>(kNumFrames), serial_results.frames.size());
+  ASSERT_EQ(static_cast<size_t>(kNumFrames), parallel_results.frames.size());
+  for (int n = 0; n < kNumFrames; ++n) {
+    const AnalysisResult& serial = serial_results.frames[n];
+    const AnalysisResult& parallel = parallel_results.frames[n];
+    EXPECT_EQ(n, parallel.frame_number);
+    EXPECT_EQ(serial.psnr_value, parallel.psnr_value);
+    EXPECT_EQ(serial.ssim_value, parallel.ssim_value);
+    EXPECT_TRUE(serial.region_psnr_values.empty());
+    ASSERT_EQ(4u, parallel.region_psnr_values.size());
+    ASSERT_EQ(4u, parallel.region_ssim_values.size());
+    // The top left region is compared on its own.
+    EXPECT_EQ(CalculateRegionMetrics(kPSNR, frame_pairs[n].reference_frame,
+                                     frame_pairs[n].test_frame, kWidth,
+                                     kHeight, 0, 0, kWidth / 2, kHeight / 2),
+              parallel.region_psnr_values[0]);
+  }
+  PrintAnalysisResults(logfile_, "Regions", &parallel_results);
+  remove(reference_name.c_str());
+  remove(test_name.c_str());
+}
+
+TEST_F(VideoQualityAnalysisTest, CalculateRegionMetricsRejectsBadRegions) {
+  std::vector<uint8_t> frame(GetI420FrameSize(kWidth, kHeight), 0);
+  EXPECT_EQ(-1, CalculateRegionMetrics(kPSNR, frame.data(), frame.data(),
+                                       kWidth, kHeight, 1, 0, 2, 2));
+  EXPECT_EQ(-1, CalculateRegionMetrics(kPSNR, frame.data(), frame.data(),
+                                       kWidth, kHeight, 0, 0, kWidth + 2, 2));
+  EXPECT_EQ(48.0, CalculateRegionMetrics(kPSNR, frame.data(), frame.data(),
+                                         kWidth, kHeight, 2, 2, 4, 4));
+}
 
 }  // namespace test
 }  // namespace webrtc
@@ -8,59 +8,59 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "webrtc/tools/frame_analyzer/video_quality_analysis.h"
 #include "webrtc/tools/simple_command_line_parser.h"
 
-#define MAX_NUM_FRAMES_PER_FILE INT_MAX
-
 void CompareFiles(const char* reference_file_name, const char* test_file_name,
-                  const char* results_file_name, int width, int height) {
-  // Check if the reference_file_name ends with "y4m".
-  bool y4m_mode = false;
-  if (std::string(reference_file_name).find("y4m") != std::string::npos) {
-    y4m_mode = true;
+                  const char* results_file_name, int width, int height,
+                  const webrtc::test::AnalysisOptions& options) {
+  bool y4m_mode = webrtc::test::IsY4mFile(reference_file_name);
+
+  std::unique_ptr<webrtc::test::MappedFile> reference_file =
+      webrtc::test::MappedFile::Open(reference_file_name);
+  std::unique_ptr<webrtc::test::MappedFile> test_file =
+      webrtc::test::MappedFile::Open(test_file_name);
+  if (!reference_file || !test_file)
+    return;
+
+  // Compare the frames until either file runs out of them.
+  std::vector<webrtc::test::FramePair> frame_pairs;
+  for (int frame_counter = 0;; ++frame_counter) {
+    webrtc::test::FramePair frame_pair;
+    frame_pair.frame_number = frame_counter;
+    frame_pair.reference_frame = webrtc::test::GetI420Frame(
+        *reference_file, y4m_mode, width, height, frame_counter);
+    frame_pair.test_frame = webrtc::test::GetI420Frame(
+        *test_file, false, width, height, frame_counter);
+    if (!frame_pair.reference_frame || !frame_pair.test_frame)
+      break;
+    frame_pairs.push_back(frame_pair);
   }
 
-  FILE* results_file = fopen(results_file_name, "w");
-
-  int size = webrtc::test::GetI420FrameSize(width, height);
-
-  // Allocate buffers for test and reference frames.
-  uint8_t* test_frame = new uint8_t[size];
-  uint8_t* ref_frame = new uint8_t[size];
-
-  bool read_result = true;
-  for (int frame_counter = 0; frame_counter < MAX_NUM_FRAMES_PER_FILE;
-      ++frame_counter) {
-    read_result &= (y4m_mode) ? webrtc::test::ExtractFrameFromY4mFile(
-        reference_file_name, width, height, frame_counter, ref_frame):
-        webrtc::test::ExtractFrameFromYuvFile(reference_file_name, width,
-                                              height, frame_counter, ref_frame);
-    read_result &=  webrtc::test::ExtractFrameFromYuvFile(test_file_name, width,
-        height, frame_counter, test_frame);
-
-    if (!read_result)
-      break;
+  // Calculate the PSNR and SSIM.
+  webrtc::test::ResultsContainer results;
+  webrtc::test::AnalyzeFramePairs(frame_pairs, width, height, options,
+                                  &results);
 
-    // Calculate the PSNR and SSIM.
-    double result_psnr = webrtc::test::CalculateMetrics(
-        webrtc::test::kPSNR, ref_frame, test_frame, width, height);
-    double result_ssim = webrtc::test::CalculateMetrics(
-        webrtc::test::kSSIM, ref_frame, test_frame, width, height);
-    fprintf(results_file, "Frame: %d, PSNR: %f, SSIM: %f\n", frame_counter,
-            result_psnr, result_ssim);
+  FILE* results_file = fopen(results_file_name, "w");
+  for (const webrtc::test::AnalysisResult& result : results.frames) {
+    fprintf(results_file, "Frame: %d, PSNR: %f, SSIM: %f\n",
+            result.frame_number, result.psnr_value, result.ssim_value);
+    for (size_t region = 0; region < result.region_psnr_values.size();
+         ++region) {
+      fprintf(results_file, "Frame: %d, Region: %u, PSNR: %f, SSIM: %f\n",
+              result.frame_number, static_cast<unsigned int>(region),
+              result.region_psnr_values[region],
+              result.region_ssim_values[region]);
+    }
   }
-  delete[] test_frame;
-  delete[] ref_frame;
-
   fclose(results_file);
 }
 
@@ -74,11 +74,17 @@ void CompareFiles(const char* reference_file_name, const char* test_file_name,
  * Frame: <frame_number>, ........
  *
  * The max value for PSNR is 48.0 (between equal frames), as for SSIM it is 1.0.
+ * With --regions=N, the frames are also split into an N x N grid, and each
+ * frame is followed by the results of its regions, row by row:
+ * Frame: <frame_number>, Region: <region>, PSNR: <psnr_value>, SSIM: <...>
+ *
+ * The input files are memory-mapped, and the frames are analyzed by
+ * --threads threads, one per core by default.
  *
  * Usage:
  * psnr_ssim_analyzer --reference_file=<name_of_file> --test_file=<name_of_file>
  * --results_file=<name_of_file> --width=<width_of_frames>
- * --height=<height_of_frames>
+ * --height=<height_of_frames> [--threads=<threads>] [--regions=<grid_size>]
  */
 int main(int argc, char** argv) {
   std::string program_name = argv[0];
@@ -96,7 +102,11 @@ int main(int argc, char** argv) {
       "  - test_file(string): The test YUV file to run the analysis for."
       " Default: test_file.yuv\n"
       "  - results_file(string): The full name of the file where the results "
-      "will be written. Default: results.txt\n";
+      "will be written. Default: results.txt\n"
+      "  - threads(int): The number of threads analyzing frames. Default: the"
+      " number of cores\n"
+      "  - regions(int): Also analyze each region of an N x N grid over the"
+      " frames. Default: 1\n";
 
   webrtc::test::CommandLineParser parser;
 
@@ -110,6 +120,8 @@ int main(int argc, char** argv) {
   parser.SetFlag("reference_file", "ref.yuv");
   parser.SetFlag("test_file", "test.yuv");
   parser.SetFlag("results_file", "results.txt");
+  parser.SetFlag("threads", "0");
+  parser.SetFlag("regions", "1");
   parser.SetFlag("help", "false");
 
   parser.ProcessFlags();
@@ -127,7 +139,20 @@ int main(int argc, char** argv) {
     return -1;
   }
 
+  webrtc::test::AnalysisOptions options;
+  int threads = strtol((parser.GetFlag("threads")).c_str(), NULL, 10);
+  if (threads > 0)
+    options.num_threads = threads;
+  int regions = strtol((parser.GetFlag("regions")).c_str(), NULL, 10);
+  if (regions <= 0 || regions > width / 2 || regions > height / 2) {
+    fprintf(stderr, "Error: regions must be > 0 and leave regions of at least "
+            "2 x 2 pixels!\n");
+    return -1;
+  }
+  options.region_columns = regions;
+  options.region_rows = regions;
+
   CompareFiles(parser.GetFlag("reference_file").c_str(),
                parser.GetFlag("test_file").c_str(),
-               parser.GetFlag("results_file").c_str(), width, height);
+               parser.GetFlag("results_file").c_str(), width, height, options);
 }
@@ -15,6 +15,7 @@
       'target_name': 'video_quality_analysis',
       'type': 'static_library',
       'dependencies': [
+        '<(webrtc_root)/base/base.gyp:rtc_base_approved',
         '<(webrtc_root)/common_video/common_video.gyp:common_video',
       ],
       'export_dependent_settings': [
@@ -0,0 +1,683 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Load generator for capacity planning. Sets up many independent
+// sender/receiver Call pairs in one process, each with fake encoders and an
+// optional audio stream over its own FakeNetworkPipe, and reports packet
+// rates, end-to-end video latency percentiles and the CPU time spent per
+// thread.
+
+#include <stdio.h>
+
+#if defined(WEBRTC_LINUX)
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/audio_state.h"
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/call.h"
+#include "webrtc/common.h"
+#include "webrtc/config.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/call_test.h"
+#include "webrtc/test/constants.h"
+#include "webrtc/test/direct_transport.h"
+#include "webrtc/test/drifting_clock.h"
+#include "webrtc/test/encoder_settings.h"
+#include "webrtc/test/fake_audio_device.h"
+#include "webrtc/test/fake_encoder.h"
+#include "webrtc/test/field_trial.h"
+#include "webrtc/test/frame_generator_capturer.h"
+#include "webrtc/test/run_test.h"
+#include "webrtc/test/testsupport/fileutils.h"
+#include "webrtc/voice_engine/include/voe_base.h"
+#include "webrtc/voice_engine/include/voe_codec.h"
+
+namespace webrtc {
+namespace flags {
+
+DEFINE_int32(num_calls, 100, "Number of sender/receiver call pairs.");
+int NumCalls() {
+  return static_cast<int>(FLAGS_num_calls);
+}
+
+DEFINE_int32(num_video_streams,
+             1,
+             "Number of simulcast video streams per call, 0-3.");
+size_t NumVideoStreams() {
+  return static_cast<size_t>(FLAGS_num_video_streams);
+}
+
+DEFINE_bool(audio, false, "Add an audio stream to every call.");
+
+DEFINE_int32(width, 320, "Video width.");
+size_t Width() {
+  return static_cast<size_t>(FLAGS_width);
+}
+
+DEFINE_int32(height, 180, "Video height.");
+size_t Height() {
+  return static_cast<size_t>(FLAGS_height);
+}
+
+DEFINE_int32(fps, 30, "Frames per second.");
+int Fps() {
+  return static_cast<int>(FLAGS_fps);
+}
+
+DEFINE_int32(max_bitrate, 300, "Max bitrate per call in kbps.");
+int MaxBitrateKbps() {
+  return static_cast<int>(FLAGS_max_bitrate);
+}
+
+DEFINE_int32(duration, 30, "Duration of the measurement in seconds.");
+int DurationSecs() {
+  return static_cast<int>(FLAGS_duration);
+}
+
+DEFINE_int32(warmup, 5, "Seconds to run before measuring.");
+int WarmupSecs() {
+  return static_cast<int>(FLAGS_warmup);
+}
+
+DEFINE_int32(loss_percent, 0, "Percentage of packets randomly lost.");
+int LossPercent() {
+  return static_cast<int>(FLAGS_loss_percent);
+}
+
+DEFINE_int32(link_capacity,
+             0,
+             "Capacity (kbps) of the fake link. 0 means infinite.");
+int LinkCapacityKbps() {
+  return static_cast<int>(FLAGS_link_capacity);
+}
+
+DEFINE_int32(queue_size, 0, "Size of the bottleneck link queue in packets.");
+int QueueSize() {
+  return static_cast<int>(FLAGS_queue_size);
+}
+
+DEFINE_int32(avg_propagation_delay_ms,
+             0,
+             "Average link propagation delay in ms.");
+int AvgPropagationDelayMs() {
+  return static_cast<int>(FLAGS_avg_propagation_delay_ms);
+}
+
+DEFINE_int32(std_propagation_delay_ms,
+             0,
+             "Link propagation delay standard deviation in ms.");
+int StdPropagationDelayMs() {
+  return static_cast<int>(FLAGS_std_propagation_delay_ms);
+}
+
+DEFINE_bool(count_clock_reads,
+            false,
+            "Count the reads of the rtc time functions, and report them per "
+            "packet.");
+
+DEFINE_string(
+    force_fieldtrials,
+    "",
+    "Field trials control experimental feature code which can be forced. "
+    "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enable/"
+    " will assign the group Enable to field trial WebRTC-FooFeature. Multiple "
+    "trials are separated by \"/\"");
+
+}  // namespace flags
+
+namespace {
+
+// Counts the reads of rtc::TimeNanos() and the functions and clocks built on
+// it, e.g. webrtc::Clock::GetRealTimeClock().
+class ReadCountingClock : public rtc::ClockInterface {
+ public:
+  ReadCountingClock() : num_reads_(0) {}
+
+  uint64_t TimeNanos() const override {
+    rtc::AtomicOps::Increment(&num_reads_);
+    return rtc::SystemTimeNanos();
+  }
+
+  int num_reads() const { return rtc::AtomicOps::AcquireLoad(&num_reads_); }
+
+ private:
+  mutable volatile int num_reads_;
+};
+
+// A DirectTransport that counts the packets it sends.
+class CountingTransport : public test::DirectTransport {
+ public:
+  CountingTransport(const FakeNetworkPipe::Config& config, Call* send_call)
+      : test::DirectTransport(config, send_call),
+        rtp_packets_(0),
+        rtcp_packets_(0) {}
+
+  bool SendRtp(const uint8_t* data,
+               size_t length,
+               const PacketOptions& options) override {
+    rtc::AtomicOps::Increment(&rtp_packets_);
+    return test::DirectTransport::SendRtp(data, length, options);
+  }
+
+  bool SendRtcp(const uint8_t* data, size_t length) override {
+    rtc::AtomicOps::Increment(&rtcp_packets_);
+    return test::DirectTransport::SendRtcp(data, length);
+  }
+
+  int rtp_packets() const {
+    return rtc::AtomicOps::AcquireLoad(&rtp_packets_);
+  }
+  int rtcp_packets() const {
+    return rtc::AtomicOps::AcquireLoad(&rtcp_packets_);
+  }
+
+ private:
+  volatile int rtp_packets_;
+  volatile int rtcp_packets_;
+};
+
+// Collects the end-to-end latency of rendered frames from all calls. The
+// receivers estimate the capture time of every frame in the sender's NTP
+// clock from RTCP sender reports, and all calls share the real-time clock, so
+// the difference to the render time includes encoding, pacing, the network,
+// jitter buffering and decoding.
+class LatencyCollector {
+ public:
+  explicit LatencyCollector(Clock* clock) : clock_(clock), enabled_(false) {}
+
+  void SetEnabled(bool enabled) {
+    rtc::CritScope cs(&crit_);
+    enabled_ = enabled;
+  }
+
+  void OnFrameRendered(const VideoFrame& frame) {
+    // Zero until the first RTCP sender report has been received.
+    if (frame.ntp_time_ms() <= 0)
+      return;
+    const int64_t latency_ms =
+        clock_->CurrentNtpInMilliseconds() - frame.ntp_time_ms();
+    rtc::CritScope cs(&crit_);
+    if (enabled_)
+      latencies_ms_.push_back(latency_ms);
+  }
+
+  std::vector<int64_t> SortedLatencies() {
+    rtc::CritScope cs(&crit_);
+    std::vector<int64_t> latencies_ms = latencies_ms_;
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    return latencies_ms;
+  }
+
+ private:
+  Clock* const clock_;
+  rtc::CriticalSection crit_;
+  bool enabled_ GUARDED_BY(crit_);
+  std::vector<int64_t> latencies_ms_ GUARDED_BY(crit_);
+};
+
+class LatencySink : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  explicit LatencySink(LatencyCollector* collector) : collector_(collector) {}
+
+  void OnFrame(const VideoFrame& frame) override {
+    collector_->OnFrameRendered(frame);
+  }
+
+ private:
+  LatencyCollector* const collector_;
+};
+
+// Returns the CPU time in ms spent by the threads of this process, summed up
+// per thread name. Threads that have exited are not included.
+std::map<std::string, int64_t> ThreadCpuTimesMs() {
+  std::map<std::string, int64_t> cpu_times_ms;
+#if defined(WEBRTC_LINUX)
+  const int64_t ticks_per_second = sysconf(_SC_CLK_TCK);
+  DIR* dir = opendir("/proc/self/task");
+  if (!dir)
+    return cpu_times_ms;
+  while (dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] == '.')
+      continue;
+    const std::string path =
+        std::string("/proc/self/task/") + entry->d_name + "/stat";
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file)
+      continue;
+    char buf[512];
+    const size_t length = fread(buf, 1, sizeof(buf) - 1, file);
+    fclose(file);
+    buf[length] = '\0';
+    // The format is "tid (name) state ...", where utime and stime are the
+    // 14th and 15th fields. The name may contain spaces and parentheses.
+    const std::string stat(buf);
+    const size_t name_begin = stat.find('(');
+    const size_t name_end = stat.rfind(')');
+    if (name_begin == std::string::npos || name_end == std::string::npos ||
+        name_end < name_begin) {
+      continue;
+    }
+    long long utime = 0;
+    long long stime = 0;
+    if (sscanf(stat.c_str() + name_end + 1,
+               " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lld %lld",
+               &utime, &stime) != 2) {
+      continue;
+    }
+    cpu_times_ms[stat.substr(name_begin + 1, name_end - name_begin - 1)] +=
+        (utime + stime) * 1000 / ticks_per_second;
+  }
+  closedir(dir);
+#endif  // defined(WEBRTC_LINUX)
+  return cpu_times_ms;
+}
+
+int64_t Percentile(const std::vector<int64_t>& sorted_values, int percent) {
+  if (sorted_values.empty())
+    return 0;
+  size_t index = sorted_values.size() * percent / 100;
+  return sorted_values[std::min(index, sorted_values.size() - 1)];
+}
+
+// One shared voice engine per side, with a channel per call.
+struct VoiceEngineState {
+  VoiceEngine* voice_engine = nullptr;
+  VoEBase* base = nullptr;
+  VoECodec* codec = nullptr;
+  std::unique_ptr<test::FakeAudioDevice> audio_device;
+  rtc::scoped_refptr<AudioState> audio_state;
+};
+
+struct CallPair {
+  std::unique_ptr<Call> sender_call;
+  std::unique_ptr<Call> receiver_call;
+  std::unique_ptr<CountingTransport> send_transport;
+  std::unique_ptr<CountingTransport> receive_transport;
+
+  std::unique_ptr<test::FakeEncoder> encoder;
+  std::vector<std::unique_ptr<VideoDecoder>> decoders;
+  std::unique_ptr<LatencySink> sink;
+  VideoSendStream* video_send_stream = nullptr;
+  std::vector<VideoReceiveStream*> video_receive_streams;
+  std::unique_ptr<test::FrameGeneratorCapturer> capturer;
+
+  int send_channel_id = -1;
+  int receive_channel_id = -1;
+  AudioSendStream* audio_send_stream = nullptr;
+  AudioReceiveStream* audio_receive_stream = nullptr;
+};
+
+class CallLoadTest {
+ public:
+  explicit CallLoadTest(const ReadCountingClock* read_counting_clock)
+      : clock_(Clock::GetRealTimeClock()),
+        read_counting_clock_(read_counting_clock),
+        latency_collector_(clock_) {}
+
+  void Run() {
+    RTC_CHECK_LE(flags::NumVideoStreams(), test::CallTest::kNumSsrcs);
+    RTC_CHECK(flags::NumVideoStreams() > 0 || flags::FLAGS_audio)
+        << "Configure at least one video or audio stream.";
+    if (flags::FLAGS_audio) {
+      CreateVoiceEngine(&voe_send_, true);
+      CreateVoiceEngine(&voe_recv_, false);
+    }
+
+    printf("Setting up %d calls.\n", flags::NumCalls());
+    for (int i = 0; i < flags::NumCalls(); ++i)
+      call_pairs_.push_back(CreateCallPair());
+    for (const auto& call_pair : call_pairs_)
+      Start(call_pair.get());
+
+    rtc::Event done(false, false);
+    done.Wait(flags::WarmupSecs() * 1000);
+
+    const std::map<std::string, int64_t> start_cpu_ms = ThreadCpuTimesMs();
+    const int start_rtp_packets = TotalRtpPackets();
+    const int start_rtcp_packets = TotalRtcpPackets();
+    const int start_clock_reads = NumClockReads();
+    const int64_t start_ms = rtc::TimeMillis();
+    latency_collector_.SetEnabled(true);
+
+    done.Wait(flags::DurationSecs() * 1000);
+
+    latency_collector_.SetEnabled(false);
+    const int64_t elapsed_ms = std::max<int64_t>(rtc::TimeMillis() - start_ms,
+                                                 1);
+    PrintResults(elapsed_ms, TotalRtpPackets() - start_rtp_packets,
+                 TotalRtcpPackets() - start_rtcp_packets,
+                 NumClockReads() - start_clock_reads, start_cpu_ms,
+                 ThreadCpuTimesMs());
+
+    for (const auto& call_pair : call_pairs_)
+      Stop(call_pair.get());
+    for (const auto& call_pair : call_pairs_)
+      Destroy(call_pair.get());
+    call_pairs_.clear();
+    if (flags::FLAGS_audio) {
+      DestroyVoiceEngine(&voe_send_);
+      DestroyVoiceEngine(&voe_recv_);
+    }
+  }
+
+ private:
+  void CreateVoiceEngine(VoiceEngineState* state, bool send) {
+    state->audio_device.reset(new test::FakeAudioDevice(
+        clock_, test::ResourcePath("voice_engine/audio_long16", "pcm"),
+        test::DriftingClock::kNoDrift));
+    state->voice_engine = VoiceEngine::Create();
+    state->base = VoEBase::GetInterface(state->voice_engine);
+    state->codec = VoECodec::GetInterface(state->voice_engine);
+    RTC_CHECK_EQ(0, state->base->Init(state->audio_device.get(), nullptr));
+    AudioState::Config audio_state_config;
+    audio_state_config.voice_engine = state->voice_engine;
+    state->audio_state = AudioState::Create(audio_state_config);
+    state->audio_device->Start();
+  }
+
+  void DestroyVoiceEngine(VoiceEngineState* state) {
+    state->audio_device->Stop();
+    state->audio_state = nullptr;
+    state->base->Release();
+    state->codec->Release();
+    VoiceEngine::Delete(state->voice_engine);
+    state->audio_device.reset();
+  }
+
+  std::unique_ptr<CallPair> CreateCallPair() {
+    std::unique_ptr<CallPair> call_pair(new CallPair());
+    Call::Config send_config;
+    Call::Config recv_config;
+    send_config.bitrate_config.max_bitrate_bps =
+        flags::MaxBitrateKbps() * 1000;
+    if (flags::FLAGS_audio) {
+      send_config.audio_state = voe_send_.audio_state;
+      recv_config.audio_state = voe_recv_.audio_state;
+    }
+    call_pair->sender_call.reset(Call::Create(send_config));
+    call_pair->receiver_call.reset(Call::Create(recv_config));
+
+    FakeNetworkPipe::Config pipe_config;
+    pipe_config.loss_percent = flags::LossPercent();
+    pipe_config.link_capacity_kbps = flags::LinkCapacityKbps();
+    pipe_config.queue_length_packets = flags::QueueSize();
+    pipe_config.queue_delay_ms = flags::AvgPropagationDelayMs();
+    pipe_config.delay_standard_deviation_ms = flags::StdPropagationDelayMs();
+    call_pair->send_transport.reset(
+        new CountingTransport(pipe_config, call_pair->sender_call.get()));
+    call_pair->receive_transport.reset(
+        new CountingTransport(pipe_config, call_pair->receiver_call.get()));
+    call_pair->send_transport->SetReceiver(
+        call_pair->receiver_call->Receiver());
+    call_pair->receive_transport->SetReceiver(
+        call_pair->sender_call->Receiver());
+
+    if (flags::NumVideoStreams() > 0)
+      CreateVideoStreams(call_pair.get());
+    if (flags::FLAGS_audio)
+      CreateAudioStreams(call_pair.get());
+    return call_pair;
+  }
+
+  void CreateVideoStreams(CallPair* call_pair) {
+    call_pair->encoder.reset(new test::FakeEncoder(clock_));
+    call_pair->encoder->SetMaxBitrate(flags::MaxBitrateKbps());
+
+    VideoSendStream::Config send_config(call_pair->send_transport.get());
+    send_config.encoder_settings.encoder = call_pair->encoder.get();
+    send_config.encoder_settings.payload_name = "FAKE";
+    send_config.encoder_settings.payload_type =
+        test::CallTest::kFakeVideoSendPayloadType;
+    send_config.rtp.extensions.push_back(RtpExtension(
+        RtpExtension::kAbsSendTime, test::kAbsSendTimeExtensionId));
+    VideoEncoderConfig encoder_config;
+    encoder_config.streams =
+        test::CreateVideoStreams(flags::NumVideoStreams());
+    VideoStream* stream = &encoder_config.streams.back();
+    stream->width = flags::Width();
+    stream->height = flags::Height();
+    stream->max_framerate = flags::Fps();
+    stream->max_bitrate_bps = flags::MaxBitrateKbps() * 1000;
+    stream->target_bitrate_bps =
+        std::min(stream->target_bitrate_bps, stream->max_bitrate_bps);
+    stream->min_bitrate_bps =
+        std::min(stream->min_bitrate_bps, stream->target_bitrate_bps);
+    for (size_t i = 0; i < flags::NumVideoStreams(); ++i)
+      send_config.rtp.ssrcs.push_back(test::CallTest::kVideoSendSsrcs[i]);
+
+    call_pair->sink.reset(new LatencySink(&latency_collector_));
+    for (uint32_t ssrc : send_config.rtp.ssrcs) {
+      VideoReceiveStream::Config receive_config(
+          call_pair->receive_transport.get());
+      receive_config.rtp.remb = true;
+      receive_config.rtp.local_ssrc = test::CallTest::kReceiverLocalVideoSsrc;
+      receive_config.rtp.remote_ssrc = ssrc;
+      receive_config.rtp.extensions = send_config.rtp.extensions;
+      VideoReceiveStream::Decoder decoder =
+          test::CreateMatchingDecoder(send_config.encoder_settings);
+      call_pair->decoders.push_back(
+          std::unique_ptr<VideoDecoder>(decoder.decoder));
+      receive_config.decoders.push_back(decoder);
+      receive_config.renderer = call_pair->sink.get();
+      call_pair->video_receive_streams.push_back(
+          call_pair->receiver_call->CreateVideoReceiveStream(receive_config));
+    }
+    call_pair->video_send_stream =
+        call_pair->sender_call->CreateVideoSendStream(send_config,
+                                                      encoder_config);
+    call_pair->capturer.reset(test::FrameGeneratorCapturer::Create(
+        call_pair->video_send_stream->Input(), stream->width, stream->height,
+        stream->max_framerate, clock_));
+  }
+
+  void CreateAudioStreams(CallPair* call_pair) {
+    Config voe_config;
+    voe_config.Set<VoicePacing>(new VoicePacing(true));
+    call_pair->send_channel_id = voe_send_.base->CreateChannel(voe_config);
+    call_pair->receive_channel_id = voe_recv_.base->CreateChannel();
+    RTC_CHECK_GE(call_pair->send_channel_id, 0);
+    RTC_CHECK_GE(call_pair->receive_channel_id, 0);
+
+    AudioSendStream::Config send_config(call_pair->send_transport.get());
+    send_config.voe_channel_id = call_pair->send_channel_id;
+    send_config.rtp.ssrc = test::CallTest::kAudioSendSsrc;
+    call_pair->audio_send_stream =
+        call_pair->sender_call->CreateAudioSendStream(send_config);
+
+    AudioReceiveStream::Config receive_config;
+    receive_config.rtp.local_ssrc = test::CallTest::kReceiverLocalAudioSsrc;
+    receive_config.rtp.remote_ssrc = send_config.rtp.ssrc;
+    receive_config.rtcp_send_transport = call_pair->receive_transport.get();
+    receive_config.voe_channel_id = call_pair->receive_channel_id;
+    call_pair->audio_receive_stream =
+        call_pair->receiver_call->CreateAudioReceiveStream(receive_config);
+
+    CodecInst isac = {test::CallTest::kAudioSendPayloadType, "ISAC", 16000,
+                      480, 1, 32000};
+    RTC_CHECK_EQ(0, voe_send_.codec->SetSendCodec(call_pair->send_channel_id,
+                                                  isac));
+  }
+
+  void Start(CallPair* call_pair) {
+    for (VideoReceiveStream* stream : call_pair->video_receive_streams)
+      stream->Start();
+    if (call_pair->video_send_stream) {
+      call_pair->video_send_stream->Start();
+      call_pair->capturer->Start();
+    }
+    if (call_pair->audio_receive_stream) {
+      call_pair->audio_receive_stream->Start();
+      voe_recv_.base->StartReceive(call_pair->receive_channel_id);
+      voe_recv_.base->StartPlayout(call_pair->receive_channel_id);
+    }
+    if (call_pair->audio_send_stream) {
+      call_pair->audio_send_stream->Start();
+      voe_send_.base->StartSend(call_pair->send_channel_id);
+    }
+  }
+
+  void Stop(CallPair* call_pair) {
+    if (call_pair->audio_send_stream) {
+      voe_send_.base->StopSend(call_pair->send_channel_id);
+      call_pair->audio_send_stream->Stop();
+    }
+    if (call_pair->audio_receive_stream) {
+      voe_recv_.base->StopPlayout(call_pair->receive_channel_id);
+      voe_recv_.base->StopReceive(call_pair->receive_channel_id);
+      call_pair->audio_receive_stream->Stop();
+    }
+    if (call_pair->video_send_stream) {
+      call_pair->capturer->Stop();
+      call_pair->video_send_stream->Stop();
+    }
+    for (VideoReceiveStream* stream : call_pair->video_receive_streams)
+      stream->Stop();
+    call_pair->send_transport->StopSending();
+    call_pair->receive_transport->StopSending();
+  }
+
+  void Destroy(CallPair* call_pair) {
+    call_pair->capturer.reset();
+    if (call_pair->video_send_stream)
+      call_pair->sender_call->DestroyVideoSendStream(
+          call_pair->video_send_stream);
+    for (VideoReceiveStream* stream : call_pair->video_receive_streams)
+      call_pair->receiver_call->DestroyVideoReceiveStream(stream);
+    if (call_pair->audio_send_stream)
+      call_pair->sender_call->DestroyAudioSendStream(
+          call_pair->audio_send_stream);
+    if (call_pair->audio_receive_stream)
+      call_pair->receiver_call->DestroyAudioReceiveStream(
+          call_pair->audio_receive_stream);
+    call_pair->sender_call.reset();
+    call_pair->receiver_call.reset();
+    if (call_pair->send_channel_id >= 0)
+      voe_send_.base->DeleteChannel(call_pair->send_channel_id);
+    if (call_pair->receive_channel_id >= 0)
+      voe_recv_.base->DeleteChannel(call_pair->receive_channel_id);
+  }
+
+  int TotalRtpPackets() const {
+    int packets = 0;
+    for (const auto& call_pair : call_pairs_)
+      packets += call_pair->send_transport->rtp_packets();
+    return packets;
+  }
+
+  // RTCP is sent in both directions.
+  int TotalRtcpPackets() const {
+    int packets = 0;
+    for (const auto& call_pair : call_pairs_) {
+      packets += call_pair->send_transport->rtcp_packets() +
+                 call_pair->receive_transport->rtcp_packets();
+    }
+    return packets;
+  }
+
+  int NumClockReads() const {
+    return read_counting_clock_ ? read_counting_clock_->num_reads() : 0;
+  }
+
+  void PrintResults(int64_t elapsed_ms,
+                    int rtp_packets,
+                    int rtcp_packets,
+                    int clock_reads,
+                    const std::map<std::string, int64_t>& start_cpu_ms,
+                    const std::map<std::string, int64_t>& end_cpu_ms) {
+    printf("RESULT calls: load= %d calls\n", flags::NumCalls());
+    printf("RESULT rtp_packets_per_second: load= %d packets/s\n",
+           static_cast<int>(rtp_packets * 1000 / elapsed_ms));
+    printf("RESULT rtcp_packets_per_second: load= %d packets/s\n",
+           static_cast<int>(rtcp_packets * 1000 / elapsed_ms));
+    if (read_counting_clock_ && rtp_packets + rtcp_packets > 0) {
+      printf("RESULT clock_reads_per_packet: load= %.1f reads\n",
+             static_cast<double>(clock_reads) / (rtp_packets + rtcp_packets));
+    }
+
+    const std::vector<int64_t> latencies_ms =
+        latency_collector_.SortedLatencies();
+    printf("RESULT rendered_frames: load= %d frames\n",
+           static_cast<int>(latencies_ms.size()));
+    for (int percent : {50, 90, 95, 99}) {
+      printf("RESULT end_to_end_latency_p%d: load= %d ms\n", percent,
+             static_cast<int>(Percentile(latencies_ms, percent)));
+    }
+
+    // Percent of one core, per thread name, busiest first.
+    std::vector<std::pair<int64_t, std::string>> cpu_ms;
+    int64_t total_cpu_ms = 0;
+    for (const auto& it : end_cpu_ms) {
+      auto start_it = start_cpu_ms.find(it.first);
+      const int64_t delta_ms =
+          it.second - (start_it == start_cpu_ms.end() ? 0 : start_it->second);
+      cpu_ms.push_back(std::make_pair(delta_ms, it.first));
+      total_cpu_ms += delta_ms;
+    }
+    if (cpu_ms.empty()) {
+      printf("Per-thread CPU usage is only reported on Linux.\n");
+      return;
+    }
+    std::sort(cpu_ms.rbegin(), cpu_ms.rend());
+    for (const auto& it : cpu_ms) {
+      printf("RESULT thread_cpu_usage: %s= %.1f percent\n", it.second.c_str(),
+             100.0 * it.first / elapsed_ms);
+    }
+    printf("RESULT total_cpu_usage: load= %.1f percent\n",
+           100.0 * total_cpu_ms / elapsed_ms);
+  }
+
+  Clock* const clock_;
+  const ReadCountingClock* const read_counting_clock_;
+  LatencyCollector latency_collector_;
+  VoiceEngineState voe_send_;
+  VoiceEngineState voe_recv_;
+  std::vector<std::unique_ptr<CallPair>> call_pairs_;
+};
+
+void RunLoadTest() {
+  // Installed before any thread reads the time.
+  std::unique_ptr<ReadCountingClock> read_counting_clock;
+  if (flags::FLAGS_count_clock_reads) {
+    read_counting_clock.reset(new ReadCountingClock());
+    rtc::SetClockForTesting(read_counting_clock.get());
+  }
+  {
+    CallLoadTest test(read_counting_clock.get());
+    test.Run();
+  }
+  rtc::SetClockForTesting(nullptr);
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  webrtc::test::InitFieldTrialsFromString(
+      webrtc::flags::FLAGS_force_fieldtrials);
+  webrtc::test::RunTest(webrtc::RunLoadTest);
+  return 0;
+}
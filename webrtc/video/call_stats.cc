@@ -24,7 +24,8 @@ const int64_t kUpdateIntervalMs = 1000;
 // Weight factor to apply to the average rtt.
 const float kWeightFactor = 0.3f;
 
-void RemoveOldReports(int64_t now, std::list<CallStats::RttTime>* reports) {
+void RemoveOldReports(int64_t now,
+                      std::deque<CallStats::RttTime>* reports) {
   // A rtt report is considered valid for this long.
   const int64_t kRttTimeoutMs = 1500;
   while (!reports->empty() &&
@@ -33,7 +34,7 @@ void RemoveOldReports(int64_t now, std::list<CallStats::RttTime>* reports) {
   }
 }
 
-int64_t GetMaxRttMs(std::list<CallStats::RttTime>* reports) {
+int64_t GetMaxRttMs(std::deque<CallStats::RttTime>* reports) {
   if (reports->empty())
     return -1;
   int64_t max_rtt_ms = 0;
@@ -42,19 +43,18 @@ int64_t GetMaxRttMs(std::list<CallStats::RttTime>* reports) {
   return max_rtt_ms;
 }
 
-int64_t GetAvgRttMs(std::list<CallStats::RttTime>* reports) {
+int64_t GetAvgRttMs(std::deque<CallStats::RttTime>* reports) {
   if (reports->empty()) {
     return -1;
   }
   int64_t sum = 0;
-  for (std::list<CallStats::RttTime>::const_iterator it = reports->begin();
-       it != reports->end(); ++it) {
-    sum += it->rtt;
-  }
+  for (const CallStats::RttTime& rtt_time : *reports)
+    sum += rtt_time.rtt;
   return sum / reports->size();
 }
 
-void UpdateAvgRttMs(std::list<CallStats::RttTime>* reports, int64_t* avg_rtt) {
+void UpdateAvgRttMs(std::deque<CallStats::RttTime>* reports,
+                    int64_t* avg_rtt) {
   int64_t cur_rtt_ms = GetAvgRttMs(reports);
   if (cur_rtt_ms == -1) {
     // Reset.
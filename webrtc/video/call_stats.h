@@ -11,6 +11,7 @@
 #ifndef WEBRTC_VIDEO_CALL_STATS_H_
 #define WEBRTC_VIDEO_CALL_STATS_H_
 
+#include <deque>
 #include <list>
 #include <memory>
 
@@ -75,7 +76,7 @@ class CallStats : public Module {
   int64_t time_of_first_rtt_ms_ GUARDED_BY(crit_);
 
   // All Rtt reports within valid time interval, oldest first.
-  std::list<RttTime> reports_;
+  std::deque<RttTime> reports_;
 
   // Observers getting stats reports.
   std::list<CallStatsObserver*> observers_;
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/video/decode_thread_pool.h"
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/platform_thread.h"
+
+namespace webrtc {
+namespace {
+// How long an idle thread sleeps before polling the streams again. Frames
+// held back until their decode time are not announced by Wake().
+const int kIdleWaitMs = 5;
+// RemoveStream() rechecks at this interval, in case another thread waiting
+// in RemoveStream() took the signal.
+const int kDecodeDoneWaitMs = 10;
+}  // namespace
+
+class DecodeThreadPool::Worker {
+ public:
+  explicit Worker(DecodeThreadPool* pool)
+      : pool_(pool),
+        quit_(0),
+        thread_(&Worker::Run, this, "DecodingThread") {
+    thread_.Start();
+    thread_.SetPriority(rtc::kHighestPriority);
+  }
+
+  ~Worker() { thread_.Stop(); }
+
+  // Makes the thread exit after its current round.
+  void SignalQuit() { rtc::AtomicOps::ReleaseStore(&quit_, 1); }
+
+ private:
+  static bool Run(void* obj) { return static_cast<Worker*>(obj)->RunOnce(); }
+
+  bool RunOnce() {
+    if (rtc::AtomicOps::AcquireLoad(&quit_))
+      return false;
+    if (!pool_->DecodeRound())
+      pool_->WaitForWork();
+    return true;
+  }
+
+  DecodeThreadPool* const pool_;
+  volatile int quit_;
+  rtc::PlatformThread thread_;
+};
+
+DecodeThreadPool::DecodeThreadPool(size_t num_threads)
+    : next_entry_(0), wake_(false, false), decode_done_(false, false) {
+  RTC_DCHECK_GT(num_threads, 0u);
+  for (size_t i = 0; i < num_threads; ++i)
+    workers_.push_back(std::unique_ptr<Worker>(new Worker(this)));
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+  for (const auto& worker : workers_)
+    worker->SignalQuit();
+  for (size_t i = 0; i < workers_.size(); ++i)
+    wake_.Set();
+  workers_.clear();
+  RTC_DCHECK(entries_.empty());
+}
+
+void DecodeThreadPool::AddStream(Stream* stream) {
+  {
+    rtc::CritScope cs(&crit_);
+    for (const Entry& entry : entries_)
+      RTC_DCHECK(entry.stream != stream);
+    entries_.push_back(Entry{stream, false, false});
+  }
+  wake_.Set();
+}
+
+void DecodeThreadPool::RemoveStream(Stream* stream) {
+  while (true) {
+    {
+      rtc::CritScope cs(&crit_);
+      auto it = entries_.begin();
+      while (it != entries_.end() && it->stream != stream)
+        ++it;
+      if (it == entries_.end())
+        return;
+      it->removed = true;
+      if (!it->running) {
+        entries_.erase(it);
+        if (next_entry_ >= entries_.size())
+          next_entry_ = 0;
+        return;
+      }
+    }
+    decode_done_.Wait(kDecodeDoneWaitMs);
+  }
+}
+
+void DecodeThreadPool::Wake() {
+  wake_.Set();
+}
+
+bool DecodeThreadPool::DecodeRound() {
+  size_t num_entries;
+  {
+    rtc::CritScope cs(&crit_);
+    num_entries = entries_.size();
+  }
+  bool decoded = false;
+  for (size_t i = 0; i < num_entries; ++i) {
+    Stream* stream = nullptr;
+    {
+      rtc::CritScope cs(&crit_);
+      // Take the next stream that no other thread is using.
+      for (size_t j = 0; j < entries_.size() && !stream; ++j) {
+        Entry& entry = entries_[next_entry_];
+        next_entry_ = (next_entry_ + 1) % entries_.size();
+        if (!entry.running && !entry.removed) {
+          entry.running = true;
+          stream = entry.stream;
+        }
+      }
+    }
+    if (!stream)
+      break;
+
+    if (stream->DecodeNextFrame())
+      decoded = true;
+
+    {
+      rtc::CritScope cs(&crit_);
+      for (Entry& entry : entries_) {
+        if (entry.stream == stream)
+          entry.running = false;
+      }
+    }
+    decode_done_.Set();
+  }
+  return decoded;
+}
+
+void DecodeThreadPool::WaitForWork() {
+  wake_.Wait(kIdleWaitMs);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VIDEO_DECODE_THREAD_POOL_H_
+#define WEBRTC_VIDEO_DECODE_THREAD_POOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/thread_annotations.h"
+
+namespace webrtc {
+
+// Decodes frames for a number of receive streams on a fixed set of threads,
+// instead of every stream running a decode thread of its own. The threads take
+// turns polling the streams for frames that are ready to decode, and a stream
+// is only ever decoded on by one thread at a time. When no stream had anything
+// to decode, the threads sleep until Wake() is called or a short timeout
+// expires, so that frames that become due for decoding on a timer are still
+// picked up.
+class DecodeThreadPool {
+ public:
+  class Stream {
+   public:
+    // Decodes the next frame if one is ready, without waiting for one.
+    // Returns false if there was nothing to decode.
+    virtual bool DecodeNextFrame() = 0;
+
+   protected:
+    virtual ~Stream() {}
+  };
+
+  explicit DecodeThreadPool(size_t num_threads);
+  ~DecodeThreadPool();
+
+  void AddStream(Stream* stream);
+  // Waits for any ongoing DecodeNextFrame() call on |stream| to return.
+  // |stream| is not called again once this returns.
+  void RemoveStream(Stream* stream);
+
+  // Tells the threads that there may be new frames to decode, e.g. since a
+  // packet was received.
+  void Wake();
+
+ private:
+  class Worker;
+
+  struct Entry {
+    Stream* stream;
+    bool running;
+    // Set by RemoveStream(), which waits for |running| to be cleared.
+    bool removed;
+  };
+
+  // Calls DecodeNextFrame() once on every stream not currently in use by
+  // another thread. Returns true if any of them decoded a frame.
+  bool DecodeRound();
+  // Waits for Wake() or a timeout, whichever comes first.
+  void WaitForWork();
+
+  rtc::CriticalSection crit_;
+  std::vector<Entry> entries_ GUARDED_BY(crit_);
+  // Where the next round starts, so that the streams get the same chance of
+  // being decoded early in a round.
+  size_t next_entry_ GUARDED_BY(crit_);
+  rtc::Event wake_;
+  // Signaled every time a DecodeNextFrame() call returns.
+  rtc::Event decode_done_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(DecodeThreadPool);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_VIDEO_DECODE_THREAD_POOL_H_
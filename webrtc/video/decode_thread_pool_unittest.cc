@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/video/decode_thread_pool.h"
+
+#include <algorithm>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/system_wrappers/include/sleep.h"
+
+namespace webrtc {
+namespace {
+const int kTimeoutMs = 1000;
+
+class FakeStream : public DecodeThreadPool::Stream {
+ public:
+  explicit FakeStream(int decode_time_ms)
+      : decode_time_ms_(decode_time_ms),
+        frames_ready_(0),
+        frames_decoded_(0),
+        num_running_(0),
+        max_running_(0),
+        all_decoded_(false, false) {}
+
+  void AddFrames(int num_frames) {
+    rtc::CritScope cs(&crit_);
+    frames_ready_ += num_frames;
+  }
+
+  bool DecodeNextFrame() override {
+    {
+      rtc::CritScope cs(&crit_);
+      if (frames_ready_ == 0)
+        return false;
+      --frames_ready_;
+      ++num_running_;
+      max_running_ = std::max(max_running_, num_running_);
+    }
+    if (decode_time_ms_ > 0)
+      SleepMs(decode_time_ms_);
+    rtc::CritScope cs(&crit_);
+    --num_running_;
+    ++frames_decoded_;
+    if (frames_ready_ == 0)
+      all_decoded_.Set();
+    return true;
+  }
+
+  bool WaitForAllDecoded() { return all_decoded_.Wait(kTimeoutMs); }
+
+  int frames_decoded() const {
+    rtc::CritScope cs(&crit_);
+    return frames_decoded_;
+  }
+  int num_running() const {
+    rtc::CritScope cs(&crit_);
+    return num_running_;
+  }
+  int max_running() const {
+    rtc::CritScope cs(&crit_);
+    return max_running_;
+  }
+
+ private:
+  const int decode_time_ms_;
+  rtc::CriticalSection crit_;
+  int frames_ready_ GUARDED_BY(crit_);
+  int frames_decoded_ GUARDED_BY(crit_);
+  int num_running_ GUARDED_BY(crit_);
+  int max_running_ GUARDED_BY(crit_);
+  rtc::Event all_decoded_;
+};
+}  // namespace
+
+TEST(DecodeThreadPoolTest, DecodesFramesOfAllStreams) {
+  DecodeThreadPool pool(2);
+  FakeStream stream1(0);
+  FakeStream stream2(0);
+  pool.AddStream(&stream1);
+  pool.AddStream(&stream2);
+
+  stream1.AddFrames(10);
+  stream2.AddFrames(5);
+  pool.Wake();
+  EXPECT_TRUE(stream1.WaitForAllDecoded());
+  EXPECT_TRUE(stream2.WaitForAllDecoded());
+  EXPECT_EQ(10, stream1.frames_decoded());
+  EXPECT_EQ(5, stream2.frames_decoded());
+
+  pool.RemoveStream(&stream1);
+  pool.RemoveStream(&stream2);
+}
+
+TEST(DecodeThreadPoolTest, PicksUpFramesWithoutWake) {
+  DecodeThreadPool pool(1);
+  FakeStream stream(0);
+  pool.AddStream(&stream);
+
+  // Like a frame that is held back until its decode time.
+  stream.AddFrames(1);
+  EXPECT_TRUE(stream.WaitForAllDecoded());
+
+  pool.RemoveStream(&stream);
+}
+
+TEST(DecodeThreadPoolTest, DecodesOneFrameOfAStreamAtATime) {
+  DecodeThreadPool pool(4);
+  FakeStream stream(2);
+  pool.AddStream(&stream);
+
+  stream.AddFrames(20);
+  pool.Wake();
+  EXPECT_TRUE(stream.WaitForAllDecoded());
+  EXPECT_EQ(1, stream.max_running());
+
+  pool.RemoveStream(&stream);
+}
+
+TEST(DecodeThreadPoolTest, DecodesDifferentStreamsInParallel) {
+  DecodeThreadPool pool(2);
+  FakeStream stream1(10);
+  FakeStream stream2(10);
+  pool.AddStream(&stream1);
+  pool.AddStream(&stream2);
+
+  stream1.AddFrames(20);
+  stream2.AddFrames(20);
+  pool.Wake();
+  // Sequentially, the 40 frames would take 400 ms.
+  const int64_t start_ms = rtc::TimeMillis();
+  EXPECT_TRUE(stream1.WaitForAllDecoded());
+  EXPECT_TRUE(stream2.WaitForAllDecoded());
+  EXPECT_LT(rtc::TimeMillis() - start_ms, 350);
+
+  pool.RemoveStream(&stream1);
+  pool.RemoveStream(&stream2);
+}
+
+TEST(DecodeThreadPoolTest, RemoveStreamWaitsForOngoingDecode) {
+  DecodeThreadPool pool(1);
+  FakeStream stream(50);
+  pool.AddStream(&stream);
+
+  stream.AddFrames(100);
+  pool.Wake();
+  while (stream.num_running() == 0)
+    SleepMs(1);
+  pool.RemoveStream(&stream);
+
+  EXPECT_EQ(0, stream.num_running());
+  const int frames_decoded = stream.frames_decoded();
+  SleepMs(100);
+  EXPECT_EQ(frames_decoded, stream.frames_decoded());
+}
+
+}  // namespace webrtc
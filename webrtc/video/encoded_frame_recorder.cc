@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/video/encoded_frame_recorder.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "webrtc/base/logging.h"
+#include "webrtc/modules/video_coding/utility/ivf_file_writer.h"
+
+namespace webrtc {
+namespace {
+// The writer thread is woken up early once this much has been queued.
+const size_t kBatchBytes = 256 * 1024;
+const int kMaxWriteDelayMs = 100;
+}  // namespace
+
+EncodedFrameRecorder::Task::Task(Type type, int file_id)
+    : type(type), file_id(file_id), codec_type(kVideoCodecUnknown) {}
+
+EncodedFrameRecorder::EncodedFrameRecorder(size_t max_queued_bytes)
+    : max_queued_bytes_(max_queued_bytes),
+      next_file_id_(0),
+      queued_bytes_(0),
+      num_dropped_frames_(0),
+      quit_(false),
+      wake_(false, false),
+      thread_(&EncodedFrameRecorder::WriterThread,
+              this,
+              "EncodedFrameRecorder") {
+  thread_.Start();
+  thread_.SetPriority(rtc::kLowPriority);
+}
+
+EncodedFrameRecorder::~EncodedFrameRecorder() {
+  {
+    rtc::CritScope cs(&crit_);
+    quit_ = true;
+  }
+  wake_.Set();
+  thread_.Stop();
+}
+
+int EncodedFrameRecorder::OpenFile(const std::string& file_name) {
+  rtc::CritScope cs(&crit_);
+  const int file_id = next_file_id_++;
+  files_[file_id] = FileState();
+  std::unique_ptr<Task> task(new Task(Task::Type::kOpen, file_id));
+  task->file_name = file_name;
+  QueueTask(std::move(task));
+  return file_id;
+}
+
+bool EncodedFrameRecorder::WriteFrame(int file_id,
+                                      VideoCodecType codec_type,
+                                      const EncodedImage& encoded_image) {
+  rtc::CritScope cs(&crit_);
+  auto it = files_.find(file_id);
+  if (it == files_.end())
+    return false;
+  FileState& file = it->second;
+  if (file.waiting_for_key_frame) {
+    if (encoded_image._frameType != kVideoFrameKey) {
+      if (file.started)
+        ++num_dropped_frames_;
+      return false;
+    }
+    file.waiting_for_key_frame = false;
+  }
+  if (queued_bytes_ + encoded_image._length > max_queued_bytes_) {
+    LOG(LS_WARNING) << "Recording falls behind, dropping frames until the next "
+                       "key frame.";
+    file.waiting_for_key_frame = true;
+    ++num_dropped_frames_;
+    return false;
+  }
+  file.started = true;
+
+  std::unique_ptr<Task> task(new Task(Task::Type::kWrite, file_id));
+  task->codec_type = codec_type;
+  task->image = encoded_image;
+  task->buffer.reset(new uint8_t[encoded_image._length]);
+  memcpy(task->buffer.get(), encoded_image._buffer, encoded_image._length);
+  task->image._buffer = task->buffer.get();
+  task->image._size = encoded_image._length;
+  queued_bytes_ += encoded_image._length;
+  QueueTask(std::move(task));
+  if (queued_bytes_ >= kBatchBytes)
+    wake_.Set();
+  return true;
+}
+
+void EncodedFrameRecorder::CloseFile(int file_id) {
+  rtc::CritScope cs(&crit_);
+  if (files_.erase(file_id) == 0)
+    return;
+  QueueTask(std::unique_ptr<Task>(new Task(Task::Type::kClose, file_id)));
+}
+
+int EncodedFrameRecorder::num_dropped_frames() const {
+  rtc::CritScope cs(&crit_);
+  return num_dropped_frames_;
+}
+
+void EncodedFrameRecorder::QueueTask(std::unique_ptr<Task> task) {
+  tasks_.push_back(std::move(task));
+}
+
+bool EncodedFrameRecorder::WriterThread(void* obj) {
+  return static_cast<EncodedFrameRecorder*>(obj)->ProcessTasks();
+}
+
+bool EncodedFrameRecorder::ProcessTasks() {
+  wake_.Wait(kMaxWriteDelayMs);
+
+  std::vector<std::unique_ptr<Task>> tasks;
+  bool quit;
+  {
+    rtc::CritScope cs(&crit_);
+    tasks.swap(tasks_);
+    quit = quit_;
+  }
+
+  size_t written_bytes = 0;
+  for (const auto& task : tasks) {
+    switch (task->type) {
+      case Task::Type::kOpen:
+        file_names_[task->file_id] = task->file_name;
+        break;
+      case Task::Type::kWrite: {
+        written_bytes += task->image._length;
+        std::unique_ptr<IvfFileWriter>& writer = writers_[task->file_id];
+        if (!writer) {
+          auto name = file_names_.find(task->file_id);
+          // Not found if opening the file failed before.
+          if (name == file_names_.end())
+            break;
+          // Opened on the first frame, since the header needs the codec.
+          writer = IvfFileWriter::Open(name->second, task->codec_type);
+          if (!writer) {
+            LOG(LS_ERROR) << "Failed to open " << name->second
+                          << " for recording.";
+            file_names_.erase(name);
+            break;
+          }
+        }
+        writer->WriteFrame(task->image);
+        break;
+      }
+      case Task::Type::kClose:
+        writers_.erase(task->file_id);
+        file_names_.erase(task->file_id);
+        break;
+    }
+  }
+
+  {
+    rtc::CritScope cs(&crit_);
+    queued_bytes_ -= written_bytes;
+  }
+
+  if (quit) {
+    // Files that were never closed are closed here, when the writers go away.
+    writers_.clear();
+    file_names_.clear();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace webrtc
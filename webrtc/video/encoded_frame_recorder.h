@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VIDEO_ENCODED_FRAME_RECORDER_H_
+#define WEBRTC_VIDEO_ENCODED_FRAME_RECORDER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/common_types.h"
+#include "webrtc/video_frame.h"
+
+namespace webrtc {
+
+class IvfFileWriter;
+
+// Writes the encoded frames of any number of streams to IVF files on a single
+// background thread, so that recording never blocks the threads receiving the
+// frames on disk I/O. Frames are copied into a queue and written in batches:
+// the writer thread wakes up when enough data has been queued, or at the
+// latest every 100 ms.
+//
+// If writing falls behind and the queue is full, frames are dropped, and the
+// file then skips frames until the next key frame so that it stays decodable.
+// Each file also starts at a key frame.
+class EncodedFrameRecorder {
+ public:
+  // Frames are dropped while |max_queued_bytes| are waiting to be written.
+  explicit EncodedFrameRecorder(size_t max_queued_bytes);
+  // Writes all queued frames and closes all files.
+  ~EncodedFrameRecorder();
+
+  // Starts a new recording to |file_name|, and returns the id to write its
+  // frames with. The file is created when the first frame is written.
+  int OpenFile(const std::string& file_name);
+  // Queues a copy of |encoded_image| to be written to the file. Returns false
+  // if the frame was not queued.
+  bool WriteFrame(int file_id,
+                  VideoCodecType codec_type,
+                  const EncodedImage& encoded_image);
+  // Closes the file once the frames already queued for it have been written.
+  void CloseFile(int file_id);
+
+  // Number of frames missing from the recordings because the queue was full,
+  // including the frames skipped to get to the next key frame.
+  int num_dropped_frames() const;
+
+ private:
+  struct Task {
+    enum class Type { kOpen, kWrite, kClose };
+
+    Task(Type type, int file_id);
+
+    const Type type;
+    const int file_id;
+    // kOpen.
+    std::string file_name;
+    // kWrite. |image| points into |buffer|.
+    VideoCodecType codec_type;
+    EncodedImage image;
+    std::unique_ptr<uint8_t[]> buffer;
+  };
+
+  struct FileState {
+    // Set until the first key frame, and after frames have been dropped.
+    bool waiting_for_key_frame = true;
+    bool started = false;
+  };
+
+  static bool WriterThread(void* obj);
+  bool ProcessTasks();
+  void QueueTask(std::unique_ptr<Task> task) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  const size_t max_queued_bytes_;
+
+  rtc::CriticalSection crit_;
+  int next_file_id_ GUARDED_BY(crit_);
+  std::map<int, FileState> files_ GUARDED_BY(crit_);
+  std::vector<std::unique_ptr<Task>> tasks_ GUARDED_BY(crit_);
+  size_t queued_bytes_ GUARDED_BY(crit_);
+  int num_dropped_frames_ GUARDED_BY(crit_);
+  bool quit_ GUARDED_BY(crit_);
+
+  // Only accessed on the writer thread.
+  std::map<int, std::string> file_names_;
+  std::map<int, std::unique_ptr<IvfFileWriter>> writers_;
+
+  rtc::Event wake_;
+  rtc::PlatformThread thread_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(EncodedFrameRecorder);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_VIDEO_ENCODED_FRAME_RECORDER_H_
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/video/encoded_frame_recorder.h"
+
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/test/testsupport/fileutils.h"
+
+namespace webrtc {
+namespace {
+const size_t kIvfHeaderSize = 32;
+const size_t kMaxQueuedBytes = 10;
+uint8_t payload[20] = {0};
+
+EncodedImage CreateFrame(FrameType frame_type, size_t length, uint32_t rtp_ts) {
+  EncodedImage image(payload, length, sizeof(payload));
+  image._frameType = frame_type;
+  image._timeStamp = rtp_ts;
+  image._encodedWidth = 320;
+  image._encodedHeight = 240;
+  return image;
+}
+
+// Returns the frame count from the IVF header, or -1 if there's no file.
+int ReadNumFrames(const std::string& file_name) {
+  FILE* file = fopen(file_name.c_str(), "rb");
+  if (!file)
+    return -1;
+  uint8_t header[kIvfHeaderSize];
+  size_t read = fread(header, 1, kIvfHeaderSize, file);
+  fclose(file);
+  if (read != kIvfHeaderSize)
+    return -1;
+  return ByteReader<uint32_t>::ReadLittleEndian(&header[24]);
+}
+}  // namespace
+
+class EncodedFrameRecorderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    file_name_ = test::TempFilename(test::OutputPath(), "recorder_test");
+    // Created by the recorder on the first frame.
+    remove(file_name_.c_str());
+  }
+
+  void TearDown() override { remove(file_name_.c_str()); }
+
+  std::string file_name_;
+};
+
+TEST_F(EncodedFrameRecorderTest, WritesFramesFromFirstKeyFrame) {
+  {
+    EncodedFrameRecorder recorder(kMaxQueuedBytes);
+    const int file_id = recorder.OpenFile(file_name_);
+    EXPECT_FALSE(recorder.WriteFrame(file_id, kVideoCodecVP8,
+                                     CreateFrame(kVideoFrameDelta, 4, 0)));
+    EXPECT_TRUE(recorder.WriteFrame(file_id, kVideoCodecVP8,
+                                    CreateFrame(kVideoFrameKey, 4, 3000)));
+    EXPECT_TRUE(recorder.WriteFrame(file_id, kVideoCodecVP8,
+                                    CreateFrame(kVideoFrameDelta, 4, 6000)));
+    recorder.CloseFile(file_id);
+    // Frames before the first key frame are not counted as dropped.
+    EXPECT_EQ(0, recorder.num_dropped_frames());
+  }
+  EXPECT_EQ(2, ReadNumFrames(file_name_));
+}
+
+TEST_F(EncodedFrameRecorderTest, SkipsToNextKeyFrameWhenQueueIsFull) {
+  {
+    EncodedFrameRecorder recorder(kMaxQueuedBytes);
+    const int file_id = recorder.OpenFile(file_name_);
+    EXPECT_TRUE(recorder.WriteFrame(file_id, kVideoCodecVP8,
+                                    CreateFrame(kVideoFrameKey, 4, 0)));
+    // Doesn't fit in the queue.
+    EXPECT_FALSE(recorder.WriteFrame(file_id, kVideoCodecVP8,
+                                     CreateFrame(kVideoFrameDelta, 20, 3000)));
+    // Would fit, but depends on the dropped frame.
+    EXPECT_FALSE(recorder.WriteFrame(file_id, kVideoCodecVP8,
+                                     CreateFrame(kVideoFrameDelta, 4, 6000)));
+    EXPECT_TRUE(recorder.WriteFrame(file_id, kVideoCodecVP8,
+                                    CreateFrame(kVideoFrameKey, 4, 9000)));
+    EXPECT_EQ(2, recorder.num_dropped_frames());
+  }
+  // Closed by the recorder's destructor.
+  EXPECT_EQ(2, ReadNumFrames(file_name_));
+}
+
+TEST_F(EncodedFrameRecorderTest, IgnoresFramesForClosedFile) {
+  EncodedFrameRecorder recorder(kMaxQueuedBytes);
+  const int file_id = recorder.OpenFile(file_name_);
+  recorder.CloseFile(file_id);
+  EXPECT_FALSE(recorder.WriteFrame(file_id, kVideoCodecVP8,
+                                   CreateFrame(kVideoFrameKey, 4, 0)));
+}
+
+}  // namespace webrtc
@@ -20,11 +20,19 @@ namespace webrtc {
 EncoderStateFeedback::EncoderStateFeedback(Clock* clock,
                                            const std::vector<uint32_t>& ssrcs,
                                            ViEEncoder* encoder)
+    : EncoderStateFeedback(clock, ssrcs, ssrcs.size(), encoder) {}
+
+EncoderStateFeedback::EncoderStateFeedback(Clock* clock,
+                                           const std::vector<uint32_t>& ssrcs,
+                                           size_t num_streams,
+                                           ViEEncoder* encoder)
     : clock_(clock),
       ssrcs_(ssrcs),
+      num_streams_(num_streams),
       vie_encoder_(encoder),
-      time_last_intra_request_ms_(ssrcs.size(), -1) {
+      time_last_intra_request_ms_(num_streams, -1) {
   RTC_DCHECK(!ssrcs.empty());
+  RTC_DCHECK_EQ(0u, ssrcs.size() % num_streams);
 }
 
 bool EncoderStateFeedback::HasSsrc(uint32_t ssrc) {
@@ -38,7 +46,7 @@ bool EncoderStateFeedback::HasSsrc(uint32_t ssrc) {
 size_t EncoderStateFeedback::GetStreamIndex(uint32_t ssrc) {
   for (size_t i = 0; i < ssrcs_.size(); ++i) {
     if (ssrcs_[i] == ssrc)
-      return i;
+      return i % num_streams_;
   }
   RTC_NOTREACHED() << "Unknown ssrc " << ssrc;
   return 0;
@@ -26,6 +26,13 @@ class EncoderStateFeedback : public RtcpIntraFrameObserver {
   EncoderStateFeedback(Clock* clock,
                        const std::vector<uint32_t>& ssrcs,
                        ViEEncoder* encoder);
+  // |ssrcs| holds the SSRCs of the |num_streams| simulcast streams for each of
+  // several destinations in turn. Requests for the same stream from different
+  // destinations are rate limited together.
+  EncoderStateFeedback(Clock* clock,
+                       const std::vector<uint32_t>& ssrcs,
+                       size_t num_streams,
+                       ViEEncoder* encoder);
   void OnReceivedIntraFrameRequest(uint32_t ssrc) override;
   void OnReceivedSLI(uint32_t ssrc, uint8_t picture_id) override;
   void OnReceivedRPSI(uint32_t ssrc, uint64_t picture_id) override;
@@ -37,6 +44,7 @@ class EncoderStateFeedback : public RtcpIntraFrameObserver {
 
   Clock* const clock_;
   const std::vector<uint32_t> ssrcs_;
+  const size_t num_streams_;
   ViEEncoder* const vie_encoder_;
 
   rtc::CriticalSection crit_;
@@ -75,4 +75,21 @@ TEST_F(VieKeyRequestTest, TooManyOnReceivedIntraFrameRequest) {
   encoder_state_feedback_.OnReceivedIntraFrameRequest(kSsrc);
 }
 
+TEST(VieKeyRequestFanOutTest, RequestsFromAllDestinationsMapToTheStream) {
+  NiceMock<MockProcessThread> process_thread;
+  MockVieEncoder encoder(&process_thread);
+  SimulatedClock clock(123456789);
+  // Two simulcast streams, sent to two destinations.
+  const std::vector<uint32_t> ssrcs = {1, 2, 11, 12};
+  EncoderStateFeedback encoder_state_feedback(&clock, ssrcs, 2, &encoder);
+
+  EXPECT_CALL(encoder, OnReceivedIntraFrameRequest(1)).Times(1);
+  encoder_state_feedback.OnReceivedIntraFrameRequest(12);
+  // The same stream was just refreshed for the other destination.
+  encoder_state_feedback.OnReceivedIntraFrameRequest(2);
+
+  EXPECT_CALL(encoder, OnReceivedIntraFrameRequest(0)).Times(1);
+  encoder_state_feedback.OnReceivedIntraFrameRequest(11);
+}
+
 }  // namespace webrtc
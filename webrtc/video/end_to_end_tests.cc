@@ -1662,6 +1662,62 @@ TEST_F(EndToEndTest, ObserversEncodedFrames) {
   DestroyStreams();
 }
 
+TEST_F(EndToEndTest, DeliversUndecodedFramesInEncodedOnlyMode) {
+  class PreDecodeObserver : public EncodedFrameObserver {
+   public:
+    PreDecodeObserver() : called_(false, false) {}
+
+    void EncodedFrameCallback(const EncodedFrame& encoded_frame) override {
+      if (encoded_frame.frame_type_ == kVideoFrameKey)
+        called_.Set();
+    }
+
+    bool Wait() { return called_.Wait(kDefaultTimeoutMs); }
+
+   private:
+    rtc::Event called_;
+  };
+
+  PreDecodeObserver pre_decode_observer;
+
+  CreateCalls(Call::Config(), Call::Config());
+
+  test::DirectTransport sender_transport(sender_call_.get());
+  test::DirectTransport receiver_transport(receiver_call_.get());
+  sender_transport.SetReceiver(receiver_call_->Receiver());
+  receiver_transport.SetReceiver(sender_call_->Receiver());
+
+  CreateSendConfig(1, 0, &sender_transport);
+  CreateMatchingReceiveConfigs(&receiver_transport);
+  video_receive_configs_[0].headless_mode =
+      VideoReceiveStream::Config::HeadlessMode::kEncodedOnly;
+  // No decoder is needed, only the payload type.
+  video_receive_configs_[0].decoders[0].decoder = nullptr;
+  video_receive_configs_[0].pre_decode_callback = &pre_decode_observer;
+
+  CreateVideoStreams();
+  Start();
+
+  std::unique_ptr<test::FrameGenerator> frame_generator(
+      test::FrameGenerator::CreateChromaGenerator(
+          video_encoder_config_.streams[0].width,
+          video_encoder_config_.streams[0].height));
+  video_send_stream_->Input()->IncomingCapturedFrame(
+      *frame_generator->NextFrame());
+
+  EXPECT_TRUE(pre_decode_observer.Wait())
+      << "Timed out while waiting for the undecoded frame.";
+  EXPECT_EQ("EncodedOnlyDecoder",
+            video_receive_streams_[0]->GetStats().decoder_implementation_name);
+
+  Stop();
+
+  sender_transport.StopSending();
+  receiver_transport.StopSending();
+
+  DestroyStreams();
+}
+
 TEST_F(EndToEndTest, ReceiveStreamSendsRemb) {
   class RembObserver : public test::EndToEndTest {
    public:
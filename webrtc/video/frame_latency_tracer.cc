@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/video/frame_latency_tracer.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/trace_event.h"
+
+namespace webrtc {
+namespace {
+// A frame is accounted for once this long has passed since it was first
+// stamped, so that stages that are stamped once per packet are complete.
+const int64_t kFrameCompletionMs = 1000;
+// Limits the memory used if stamps stop arriving.
+const size_t kMaxFramesInFlight = 100;
+}  // namespace
+
+FrameLatencyTracer::Frame::Frame(size_t num_stages, int64_t first_stamp_ms)
+    : first_stamp_ms(first_stamp_ms), stamps_ms(num_stages, -1) {}
+
+FrameLatencyTracer::FrameLatencyTracer(
+    const char* trace_name,
+    const std::vector<const char*>& stage_names,
+    int sampling_interval)
+    : trace_name_(trace_name),
+      stage_names_(stage_names),
+      sampling_interval_(sampling_interval),
+      delays_(stage_names.size()) {
+  RTC_DCHECK_GE(stage_names_.size(), 2u);
+  RTC_DCHECK_GE(sampling_interval_, 0);
+}
+
+FrameLatencyTracer::~FrameLatencyTracer() {}
+
+void FrameLatencyTracer::OnStage(int64_t frame_id,
+                                 size_t stage,
+                                 int64_t time_ms) {
+  RTC_DCHECK_LT(stage, stage_names_.size());
+  if (!IsSampled(frame_id))
+    return;
+  CompleteFrames(time_ms);
+
+  auto it = frames_.find(frame_id);
+  if (it == frames_.end()) {
+    it = frames_
+             .insert(std::make_pair(frame_id,
+                                    Frame(stage_names_.size(), time_ms)))
+             .first;
+    TRACE_EVENT_ASYNC_BEGIN1("webrtc", trace_name_, frame_id, "frame_id",
+                             frame_id);
+  }
+  int64_t* stamp_ms = &it->second.stamps_ms[stage];
+  if (*stamp_ms == -1) {
+    TRACE_EVENT_ASYNC_STEP0("webrtc", trace_name_, frame_id,
+                            stage_names_[stage]);
+  }
+  *stamp_ms = time_ms;
+}
+
+std::map<std::string, int> FrameLatencyTracer::AverageDelaysMs() const {
+  std::map<std::string, int> delays_ms;
+  for (size_t i = 1; i < delays_.size(); ++i) {
+    if (delays_[i].num_samples > 0) {
+      delays_ms[stage_names_[i]] =
+          static_cast<int>(delays_[i].sum_ms / delays_[i].num_samples);
+    }
+  }
+  if (total_delay_.num_samples > 0) {
+    delays_ms["total"] =
+        static_cast<int>(total_delay_.sum_ms / total_delay_.num_samples);
+  }
+  return delays_ms;
+}
+
+bool FrameLatencyTracer::IsSampled(int64_t frame_id) const {
+  if (sampling_interval_ == 0)
+    return false;
+  // Frame ids tend to be evenly spaced, so hash them before sampling.
+  const uint64_t hash = static_cast<uint64_t>(frame_id) * 0x9E3779B97F4A7C15ull;
+  return (hash >> 32) % sampling_interval_ == 0;
+}
+
+void FrameLatencyTracer::CompleteFrames(int64_t now_ms) {
+  for (auto it = frames_.begin(); it != frames_.end();) {
+    if (now_ms - it->second.first_stamp_ms >= kFrameCompletionMs ||
+        frames_.size() > kMaxFramesInFlight) {
+      CompleteFrame(it->first, it->second);
+      it = frames_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void FrameLatencyTracer::CompleteFrame(int64_t frame_id, const Frame& frame) {
+  const std::vector<int64_t>& stamps_ms = frame.stamps_ms;
+  for (size_t i = 1; i < stamps_ms.size(); ++i) {
+    if (stamps_ms[i - 1] == -1 || stamps_ms[i] == -1)
+      continue;
+    delays_[i].sum_ms += std::max<int64_t>(stamps_ms[i] - stamps_ms[i - 1], 0);
+    ++delays_[i].num_samples;
+  }
+  // Only frames that made it through the whole pipeline count towards the
+  // total.
+  if (stamps_ms.front() != -1 && stamps_ms.back() != -1) {
+    total_delay_.sum_ms +=
+        std::max<int64_t>(stamps_ms.back() - stamps_ms.front(), 0);
+    ++total_delay_.num_samples;
+  }
+  TRACE_EVENT_ASYNC_END0("webrtc", trace_name_, frame_id);
+}
+
+}  // namespace webrtc
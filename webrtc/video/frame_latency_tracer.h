@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VIDEO_FRAME_LATENCY_TRACER_H_
+#define WEBRTC_VIDEO_FRAME_LATENCY_TRACER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+
+namespace webrtc {
+
+// Breaks down the latency of a sample of frames into the stages of a media
+// pipeline. The pipeline stamps frames, identified by e.g. capture time or RTP
+// timestamp, as they pass each stage. The delay of a stage is the time from
+// the previous stage's stamp to its own. When a stage is stamped more than
+// once for a frame, as when it is sent in several packets, the last stamp
+// counts.
+//
+// Which frames are sampled only depends on their id, so stamps can arrive
+// in any order and from any stage. Sampled frames are also traced as async
+// trace events, with a step per stage.
+//
+// Not thread safe.
+class FrameLatencyTracer {
+ public:
+  // |trace_name| and |stage_names| must be string literals. The first stage
+  // marks the start of a frame and has no delay of its own. Roughly one in
+  // |sampling_interval| frames is sampled, 0 disables sampling.
+  FrameLatencyTracer(const char* trace_name,
+                     const std::vector<const char*>& stage_names,
+                     int sampling_interval);
+  ~FrameLatencyTracer();
+
+  void OnStage(int64_t frame_id, size_t stage, int64_t time_ms);
+
+  // Average delays of the frames that have completed, keyed by stage name,
+  // plus the average time from the first to the last stage as "total".
+  std::map<std::string, int> AverageDelaysMs() const;
+
+ private:
+  struct Frame {
+    Frame(size_t num_stages, int64_t first_stamp_ms);
+
+    int64_t first_stamp_ms;
+    std::vector<int64_t> stamps_ms;  // -1 until stamped.
+  };
+  struct Delay {
+    Delay() : sum_ms(0), num_samples(0) {}
+
+    int64_t sum_ms;
+    int num_samples;
+  };
+
+  bool IsSampled(int64_t frame_id) const;
+  // Accounts for and removes frames that are done or stalled.
+  void CompleteFrames(int64_t now_ms);
+  void CompleteFrame(int64_t frame_id, const Frame& frame);
+
+  const char* const trace_name_;
+  const std::vector<const char*> stage_names_;
+  const int sampling_interval_;
+
+  std::map<int64_t, Frame> frames_;
+  std::vector<Delay> delays_;  // Indexed by stage, the first one is unused.
+  Delay total_delay_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(FrameLatencyTracer);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_VIDEO_FRAME_LATENCY_TRACER_H_
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/video/frame_latency_tracer.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace webrtc {
+namespace {
+const int64_t kCompletionMs = 1000;
+
+std::vector<const char*> StageNames() {
+  return {"start", "first", "second"};
+}
+}  // namespace
+
+TEST(FrameLatencyTracerTest, NoDelaysUntilFramesComplete) {
+  FrameLatencyTracer tracer("Test", StageNames(), 1);
+  tracer.OnStage(1, 0, 100);
+  tracer.OnStage(1, 1, 110);
+  tracer.OnStage(1, 2, 130);
+  EXPECT_TRUE(tracer.AverageDelaysMs().empty());
+}
+
+TEST(FrameLatencyTracerTest, AveragesStageDelays) {
+  FrameLatencyTracer tracer("Test", StageNames(), 1);
+  tracer.OnStage(1, 0, 100);
+  tracer.OnStage(1, 1, 110);
+  tracer.OnStage(1, 2, 130);
+  tracer.OnStage(2, 0, 200);
+  tracer.OnStage(2, 1, 230);
+  tracer.OnStage(2, 2, 240);
+  // Completes both frames.
+  tracer.OnStage(3, 0, 200 + kCompletionMs);
+
+  std::map<std::string, int> delays_ms = tracer.AverageDelaysMs();
+  EXPECT_EQ(3u, delays_ms.size());
+  EXPECT_EQ(20, delays_ms["first"]);
+  EXPECT_EQ(15, delays_ms["second"]);
+  EXPECT_EQ(35, delays_ms["total"]);
+}
+
+TEST(FrameLatencyTracerTest, LastStampOfStageCounts) {
+  FrameLatencyTracer tracer("Test", StageNames(), 1);
+  tracer.OnStage(1, 0, 100);
+  tracer.OnStage(1, 1, 110);
+  tracer.OnStage(1, 2, 120);
+  tracer.OnStage(1, 2, 150);
+  tracer.OnStage(2, 0, 100 + kCompletionMs);
+
+  std::map<std::string, int> delays_ms = tracer.AverageDelaysMs();
+  EXPECT_EQ(40, delays_ms["second"]);
+  EXPECT_EQ(50, delays_ms["total"]);
+}
+
+TEST(FrameLatencyTracerTest, StagesCanBeStampedOutOfOrder) {
+  FrameLatencyTracer tracer("Test", StageNames(), 1);
+  tracer.OnStage(1, 1, 110);
+  tracer.OnStage(1, 0, 100);
+  tracer.OnStage(1, 2, 130);
+  tracer.OnStage(2, 0, 110 + kCompletionMs);
+
+  std::map<std::string, int> delays_ms = tracer.AverageDelaysMs();
+  EXPECT_EQ(10, delays_ms["first"]);
+  EXPECT_EQ(20, delays_ms["second"]);
+}
+
+TEST(FrameLatencyTracerTest, IncompleteFramesOnlyCountStampedStages) {
+  FrameLatencyTracer tracer("Test", StageNames(), 1);
+  // Dropped before reaching the last stage.
+  tracer.OnStage(1, 0, 100);
+  tracer.OnStage(1, 1, 110);
+  tracer.OnStage(2, 0, 100 + kCompletionMs);
+
+  std::map<std::string, int> delays_ms = tracer.AverageDelaysMs();
+  EXPECT_EQ(1u, delays_ms.size());
+  EXPECT_EQ(10, delays_ms["first"]);
+}
+
+TEST(FrameLatencyTracerTest, SamplesSomeFrames) {
+  const int kSamplingInterval = 10;
+  const int kNumFrames = 10000;
+  FrameLatencyTracer tracer("Test", StageNames(), kSamplingInterval);
+  for (int i = 0; i < kNumFrames; ++i) {
+    // Evenly spaced ids, like capture times.
+    int64_t frame_id = i * 33;
+    tracer.OnStage(frame_id, 0, frame_id);
+    tracer.OnStage(frame_id, 1, frame_id + 5);
+  }
+  tracer.OnStage(0, 0, kNumFrames * 33 + kCompletionMs);
+  std::map<std::string, int> delays_ms = tracer.AverageDelaysMs();
+  EXPECT_EQ(5, delays_ms["first"]);
+}
+
+TEST(FrameLatencyTracerTest, DisabledWithoutSamplingInterval) {
+  FrameLatencyTracer tracer("Test", StageNames(), 0);
+  tracer.OnStage(1, 0, 100);
+  tracer.OnStage(1, 1, 110);
+  tracer.OnStage(2, 0, 100 + kCompletionMs);
+  EXPECT_TRUE(tracer.AverageDelaysMs().empty());
+}
+
+}  // namespace webrtc
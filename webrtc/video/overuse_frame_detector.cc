@@ -14,7 +14,6 @@
 #include <math.h>
 
 #include <algorithm>
-#include <list>
 #include <map>
 
 #include "webrtc/base/checks.h"
@@ -48,6 +47,13 @@ const int kMaxOverusesBeforeApplyRampupDelay = 4;
 const float kSampleDiffMs = 33.0f;
 const float kMaxExp = 7.0f;
 
+// Delay before reporting actual encoding time, used to have the ability to
+// detect total encoding time when encoding more than one layer. Encoding is
+// here assumed to finish within a second (or that we get enough long-time
+// samples before one second to trigger an overuse even when this is not the
+// case).
+const int64_t kEncodingTimeMeasureWindowMs = 1000;
+
 }  // namespace
 
 CpuOveruseOptions::CpuOveruseOptions()
@@ -55,7 +61,8 @@ CpuOveruseOptions::CpuOveruseOptions()
       frame_timeout_interval_ms(1500),
       min_frame_samples(120),
       min_process_count(3),
-      high_threshold_consecutive_count(2) {
+      high_threshold_consecutive_count(2),
+      use_encoder_cpu_time(false) {
 #if defined(WEBRTC_MAC) && !defined(WEBRTC_IOS)
   // This is proof-of-concept code for letting the physical core count affect
   // the interval into which we attempt to scale. For now, the code is Mac OS
@@ -192,7 +199,9 @@ OveruseFrameDetector::OveruseFrameDetector(
       last_rampup_time_ms_(-1),
       in_quick_rampup_(false),
       current_rampup_delay_ms_(kStandardRampUpDelayMs),
-      usage_(new SendProcessingUsage(options)) {
+      usage_(new SendProcessingUsage(options)),
+      first_frame_timing_(0),
+      num_frame_timings_(0) {
   RTC_DCHECK(metrics_observer);
   processing_thread_.DetachFromThread();
 }
@@ -229,7 +238,7 @@ bool OveruseFrameDetector::FrameTimeoutDetected(int64_t now) const {
 void OveruseFrameDetector::ResetAll(int num_pixels) {
   num_pixels_ = num_pixels;
   usage_->Reset();
-  frame_timing_.clear();
+  num_frame_timings_ = 0;
   last_capture_time_ms_ = -1;
   last_processed_capture_time_ms_ = -1;
   num_process_times_ = 0;
@@ -250,51 +259,90 @@ void OveruseFrameDetector::FrameCaptured(const VideoFrame& frame) {
 
   last_capture_time_ms_ = now;
 
-  frame_timing_.push_back(
-      FrameTiming(frame.ntp_time_ms(), frame.timestamp(), now));
+  if (num_frame_timings_ == kMaxFrameTimings) {
+    // Measure the oldest frame early rather than losing it.
+    const FrameTiming& oldest = frame_timing_[first_frame_timing_];
+    if (!oldest.dropped)
+      MeasureFrameTiming(oldest);
+    first_frame_timing_ = (first_frame_timing_ + 1) % kMaxFrameTimings;
+    --num_frame_timings_;
+  }
+  frame_timing_[(first_frame_timing_ + num_frame_timings_) %
+                kMaxFrameTimings] =
+      FrameTiming(frame.ntp_time_ms(), frame.timestamp(), now);
+  ++num_frame_timings_;
 }
 
 void OveruseFrameDetector::FrameSent(uint32_t timestamp) {
   rtc::CritScope cs(&crit_);
-  // Delay before reporting actual encoding time, used to have the ability to
-  // detect total encoding time when encoding more than one layer. Encoding is
-  // here assumed to finish within a second (or that we get enough long-time
-  // samples before one second to trigger an overuse even when this is not the
-  // case).
-  static const int64_t kEncodingTimeMeasureWindowMs = 1000;
   int64_t now = clock_->TimeInMilliseconds();
-  for (auto& it : frame_timing_) {
-    if (it.timestamp == timestamp) {
-      it.last_send_ms = now;
-      break;
-    }
-  }
+  FrameTiming* timing = FindFrameTiming(timestamp);
+  if (timing)
+    timing->last_send_ms = now;
   // TODO(pbos): Handle the case/log errors when not finding the corresponding
   // frame (either very slow encoding or incorrect wrong timestamps returned
   // from the encoder).
   // This is currently the case for all frames on ChromeOS, so logging them
   // would be spammy, and triggering overuse would be wrong.
   // https://crbug.com/350106
-  while (!frame_timing_.empty()) {
-    FrameTiming timing = frame_timing_.front();
-    if (now - timing.capture_ms < kEncodingTimeMeasureWindowMs)
+  while (num_frame_timings_ > 0) {
+    const FrameTiming& oldest = frame_timing_[first_frame_timing_];
+    if (now - oldest.capture_ms < kEncodingTimeMeasureWindowMs)
       break;
-    if (timing.last_send_ms != -1) {
-      int encode_duration_ms =
-          static_cast<int>(timing.last_send_ms - timing.capture_ms);
-      if (encoder_timing_) {
-        encoder_timing_->OnEncodeTiming(timing.capture_ntp_ms,
-                                        encode_duration_ms);
-      }
-      if (last_processed_capture_time_ms_ != -1) {
-        int64_t diff_ms = timing.capture_ms - last_processed_capture_time_ms_;
-        usage_->AddSample(encode_duration_ms, diff_ms);
-      }
-      last_processed_capture_time_ms_ = timing.capture_ms;
-      EncodedFrameTimeMeasured(encode_duration_ms);
+    if (!oldest.dropped)
+      MeasureFrameTiming(oldest);
+    first_frame_timing_ = (first_frame_timing_ + 1) % kMaxFrameTimings;
+    --num_frame_timings_;
+  }
+}
+
+void OveruseFrameDetector::FrameDropped(uint32_t timestamp) {
+  rtc::CritScope cs(&crit_);
+  FrameTiming* timing = FindFrameTiming(timestamp);
+  if (timing)
+    timing->dropped = true;
+}
+
+void OveruseFrameDetector::FrameEncodeCpuTimeMeasured(uint32_t timestamp,
+                                                      int64_t cpu_time_us) {
+  rtc::CritScope cs(&crit_);
+  FrameTiming* timing = FindFrameTiming(timestamp);
+  if (timing)
+    timing->encode_cpu_us = cpu_time_us;
+}
+
+OveruseFrameDetector::FrameTiming* OveruseFrameDetector::FindFrameTiming(
+    uint32_t timestamp) {
+  for (size_t i = 0; i < num_frame_timings_; ++i) {
+    FrameTiming& timing =
+        frame_timing_[(first_frame_timing_ + i) % kMaxFrameTimings];
+    if (timing.timestamp == timestamp && !timing.dropped)
+      return &timing;
+  }
+  return nullptr;
+}
+
+void OveruseFrameDetector::MeasureFrameTiming(const FrameTiming& timing) {
+  int encode_duration_ms = -1;
+  if (timing.last_send_ms != -1) {
+    encode_duration_ms =
+        static_cast<int>(timing.last_send_ms - timing.capture_ms);
+    if (encoder_timing_) {
+      encoder_timing_->OnEncodeTiming(timing.capture_ntp_ms,
+                                      encode_duration_ms);
     }
-    frame_timing_.pop_front();
   }
+  if (options_.use_encoder_cpu_time && timing.encode_cpu_us != -1)
+    encode_duration_ms = static_cast<int>((timing.encode_cpu_us + 500) / 1000);
+  if (encode_duration_ms == -1)
+    return;
+
+  if (last_processed_capture_time_ms_ != -1) {
+    int64_t diff_ms = timing.capture_ms - last_processed_capture_time_ms_;
+    usage_->AddSample(encode_duration_ms, diff_ms);
+  }
+  last_processed_capture_time_ms_ = timing.capture_ms;
+  EncodedFrameTimeMeasured(encode_duration_ms);
 }
 
 void OveruseFrameDetector::Process() {
@@ -341,12 +389,18 @@ void OveruseFrameDetector::Process() {
     checks_above_threshold_ = 0;
     ++num_overuse_detections_;
 
+    LOG(LS_INFO) << "CPU overuse detected, encode usage "
+                 << current_metrics.encode_usage_percent << "%.";
+    metrics_observer_->OnCpuAdaptation(true, current_metrics);
     if (observer_)
       observer_->OveruseDetected();
   } else if (IsUnderusing(current_metrics, now)) {
     last_rampup_time_ms_ = now;
     in_quick_rampup_ = true;
 
+    LOG(LS_INFO) << "CPU usage back to normal, encode usage "
+                 << current_metrics.encode_usage_percent << "%.";
+    metrics_observer_->OnCpuAdaptation(false, current_metrics);
     if (observer_)
       observer_->NormalUsage();
   }
@@ -11,7 +11,6 @@
 #ifndef WEBRTC_VIDEO_OVERUSE_FRAME_DETECTOR_H_
 #define WEBRTC_VIDEO_OVERUSE_FRAME_DETECTOR_H_
 
-#include <list>
 #include <memory>
 
 #include "webrtc/base/constructormagic.h"
@@ -55,6 +54,13 @@ struct CpuOveruseOptions {
   int high_threshold_consecutive_count;  // The number of consecutive checks
                                          // above the high threshold before
                                          // triggering an overuse.
+  bool use_encoder_cpu_time;  // Measure the CPU time the encoder thread spent
+                              // on each frame instead of the time from capture
+                              // to send. The latter also counts time spent
+                              // waiting for a core, which on a loaded machine
+                              // says little about the encoder itself. Frames
+                              // without a CPU time are still measured from
+                              // capture to send.
 };
 
 struct CpuOveruseMetrics {
@@ -69,6 +75,11 @@ class CpuOveruseMetricsObserver {
   virtual ~CpuOveruseMetricsObserver() {}
   virtual void OnEncodedFrameTimeMeasured(int encode_duration_ms,
                                           const CpuOveruseMetrics& metrics) = 0;
+  // Called when the detector reports an overuse (|overuse| is true) or normal
+  // usage to its CpuOveruseObserver, with the metrics the decision was based
+  // on.
+  virtual void OnCpuAdaptation(bool overuse,
+                               const CpuOveruseMetrics& metrics) = 0;
 };
 
 // Use to detect system overuse based on the send-side processing time of
@@ -88,6 +99,14 @@ class OveruseFrameDetector : public Module {
   // Called for each sent frame.
   void FrameSent(uint32_t timestamp);
 
+  // Called for captured frames that are dropped before being encoded. The
+  // time they spent queued is not an encode time, so they are not measured.
+  void FrameDropped(uint32_t timestamp);
+
+  // Called with the CPU time the encoder thread spent on the frame with
+  // |timestamp|. Only used with |CpuOveruseOptions::use_encoder_cpu_time|.
+  void FrameEncodeCpuTimeMeasured(uint32_t timestamp, int64_t cpu_time_us);
+
   // Implements Module.
   int64_t TimeUntilNextProcess() override;
   void Process() override;
@@ -95,16 +114,32 @@ class OveruseFrameDetector : public Module {
  private:
   class SendProcessingUsage;
   struct FrameTiming {
+    FrameTiming() : FrameTiming(0, 0, -1) {}
     FrameTiming(int64_t capture_ntp_ms, uint32_t timestamp, int64_t now)
         : capture_ntp_ms(capture_ntp_ms),
           timestamp(timestamp),
           capture_ms(now),
-          last_send_ms(-1) {}
+          last_send_ms(-1),
+          encode_cpu_us(-1),
+          dropped(false) {}
     int64_t capture_ntp_ms;
     uint32_t timestamp;
     int64_t capture_ms;
     int64_t last_send_ms;
+    int64_t encode_cpu_us;
+    bool dropped;
   };
+  // Enough for a second of frames at 120 fps, with some headroom. If frames
+  // come in faster than that, the oldest ones are measured before the end of
+  // the measurement window, to make room.
+  static const size_t kMaxFrameTimings = 128;
+
+  // Returns the timing of the not yet measured frame with |timestamp|, or
+  // nullptr.
+  FrameTiming* FindFrameTiming(uint32_t timestamp)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void MeasureFrameTiming(const FrameTiming& timing)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   void EncodedFrameTimeMeasured(int encode_duration_ms)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -155,7 +190,11 @@ class OveruseFrameDetector : public Module {
   // TODO(asapersson): Can these be regular members (avoid separate heap
   // allocs)?
   const std::unique_ptr<SendProcessingUsage> usage_ GUARDED_BY(crit_);
-  std::list<FrameTiming> frame_timing_ GUARDED_BY(crit_);
+  // Timings of recently captured frames, oldest first, in a ring buffer
+  // starting at |first_frame_timing_|.
+  FrameTiming frame_timing_[kMaxFrameTimings] GUARDED_BY(crit_);
+  size_t first_frame_timing_ GUARDED_BY(crit_);
+  size_t num_frame_timings_ GUARDED_BY(crit_);
 
   rtc::ThreadChecker processing_thread_;
 
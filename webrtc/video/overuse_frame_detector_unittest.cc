@@ -70,6 +70,15 @@ class OveruseFrameDetectorTest : public ::testing::Test,
     metrics_ = metrics;
   }
 
+  void OnCpuAdaptation(bool overuse,
+                       const CpuOveruseMetrics& metrics) override {
+    if (overuse) {
+      ++num_overuse_adaptations_;
+    } else {
+      ++num_normal_usage_adaptations_;
+    }
+  }
+
   int InitialUsage() {
     return ((options_.low_encode_usage_threshold_percent +
              options_.high_encode_usage_threshold_percent) / 2.0f) + 0.5;
@@ -126,6 +135,8 @@ class OveruseFrameDetectorTest : public ::testing::Test,
   std::unique_ptr<MockCpuOveruseObserver> observer_;
   std::unique_ptr<OveruseFrameDetector> overuse_detector_;
   CpuOveruseMetrics metrics_;
+  int num_overuse_adaptations_ = 0;
+  int num_normal_usage_adaptations_ = 0;
 };
 
 
@@ -300,4 +311,50 @@ TEST_F(OveruseFrameDetectorTest, UpdatesExistingSamples) {
   }
 }
 
+TEST_F(OveruseFrameDetectorTest, ReportsAdaptationsToMetricsObserver) {
+  EXPECT_CALL(*(observer_.get()), OveruseDetected()).Times(1);
+  TriggerOveruse(options_.high_threshold_consecutive_count);
+  EXPECT_EQ(1, num_overuse_adaptations_);
+  EXPECT_EQ(0, num_normal_usage_adaptations_);
+
+  EXPECT_CALL(*(observer_.get()), NormalUsage()).Times(testing::AtLeast(1));
+  TriggerUnderuse();
+  EXPECT_EQ(1, num_overuse_adaptations_);
+  EXPECT_LE(1, num_normal_usage_adaptations_);
+}
+
+TEST_F(OveruseFrameDetectorTest, UsesEncoderCpuTimeWhenEnabled) {
+  options_.use_encoder_cpu_time = true;
+  ReinitializeOveruseDetector();
+  // Frames take almost the whole frame interval from capture to send, but
+  // only a few milliseconds of CPU time on the encoder thread.
+  EXPECT_CALL(*(observer_.get()), OveruseDetected()).Times(0);
+  const int kDelayMs = 32;
+  const int64_t kCpuTimeUs = 3000;
+  VideoFrame frame;
+  frame.CreateEmptyFrame(kWidth, kHeight, kWidth, kWidth / 2, kWidth / 2);
+  uint32_t timestamp = 0;
+  for (int i = 0; i < 1000; ++i) {
+    frame.set_timestamp(timestamp);
+    overuse_detector_->FrameCaptured(frame);
+    clock_->AdvanceTimeMilliseconds(kDelayMs);
+    overuse_detector_->FrameSent(timestamp);
+    overuse_detector_->FrameEncodeCpuTimeMeasured(timestamp, kCpuTimeUs);
+    clock_->AdvanceTimeMilliseconds(kFrameInterval33ms - kDelayMs);
+    timestamp += kFrameInterval33ms * 90;
+  }
+  overuse_detector_->Process();
+  EXPECT_LT(UsagePercent(), options_.low_encode_usage_threshold_percent);
+}
+
+TEST_F(OveruseFrameDetectorTest, MeasuresFramesCapturedFasterThanTheWindow) {
+  // More frames are captured within the measurement window than there is
+  // room for. The oldest ones are measured early to make room, rather than
+  // never being measured at all.
+  const int kIntervalMs = 2;
+  const int kDelayMs = 1;
+  InsertAndSendFramesWithInterval(400, kIntervalMs, kWidth, kHeight, kDelayMs);
+  EXPECT_GT(UsagePercent(), 0);
+}
+
 }  // namespace webrtc
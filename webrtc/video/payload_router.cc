@@ -89,10 +89,19 @@ void CopyCodecSpecific(const CodecSpecificInfo* info, RTPVideoHeader* rtp) {
 
 PayloadRouter::PayloadRouter(const std::vector<RtpRtcp*>& rtp_modules,
                              int payload_type)
+    : PayloadRouter(rtp_modules, payload_type, 1) {}
+
+PayloadRouter::PayloadRouter(const std::vector<RtpRtcp*>& rtp_modules,
+                             int payload_type,
+                             size_t num_destinations)
     : active_(false),
       num_sending_modules_(1),
       rtp_modules_(rtp_modules),
+      num_destinations_(num_destinations),
+      num_layers_(rtp_modules.size() / num_destinations),
       payload_type_(payload_type) {
+  RTC_DCHECK_GT(num_destinations_, 0u);
+  RTC_DCHECK_EQ(rtp_modules_.size(), num_layers_ * num_destinations_);
   UpdateModuleSendingState();
 }
 
@@ -117,7 +126,7 @@ bool PayloadRouter::active() {
 }
 
 void PayloadRouter::SetSendStreams(const std::vector<VideoStream>& streams) {
-  RTC_DCHECK_LE(streams.size(), rtp_modules_.size());
+  RTC_DCHECK_LE(streams.size(), num_layers_);
   rtc::CritScope lock(&crit_);
   num_sending_modules_ = streams.size();
   streams_ = streams;
@@ -126,14 +135,11 @@ void PayloadRouter::SetSendStreams(const std::vector<VideoStream>& streams) {
 }
 
 void PayloadRouter::UpdateModuleSendingState() {
-  for (size_t i = 0; i < num_sending_modules_; ++i) {
-    rtp_modules_[i]->SetSendingStatus(active_);
-    rtp_modules_[i]->SetSendingMediaStatus(active_);
-  }
-  // Disable inactive modules.
-  for (size_t i = num_sending_modules_; i < rtp_modules_.size(); ++i) {
-    rtp_modules_[i]->SetSendingStatus(false);
-    rtp_modules_[i]->SetSendingMediaStatus(false);
+  for (size_t i = 0; i < rtp_modules_.size(); ++i) {
+    // Disable inactive modules.
+    const bool sending = active_ && i % num_layers_ < num_sending_modules_;
+    rtp_modules_[i]->SetSendingStatus(sending);
+    rtp_modules_[i]->SetSendingMediaStatus(sending);
   }
 }
 
@@ -153,22 +159,28 @@ int32_t PayloadRouter::Encoded(const EncodedImage& encoded_image,
     CopyCodecSpecific(codec_specific_info, &rtp_video_header);
   rtp_video_header.rotation = encoded_image.rotation_;
 
-  RTC_DCHECK_LT(rtp_video_header.simulcastIdx, rtp_modules_.size());
+  RTC_DCHECK_LT(rtp_video_header.simulcastIdx, num_layers_);
   // The simulcast index might actually be larger than the number of modules
   // in case the encoder was processing a frame during a codec reconfig.
   if (rtp_video_header.simulcastIdx >= num_sending_modules_)
     return -1;
   stream_idx = rtp_video_header.simulcastIdx;
 
-  return rtp_modules_[stream_idx]->SendOutgoingData(
-      encoded_image._frameType, payload_type_, encoded_image._timeStamp,
-      encoded_image.capture_time_ms_, encoded_image._buffer,
-      encoded_image._length, fragmentation, &rtp_video_header);
+  int32_t result = 0;
+  for (size_t i = stream_idx; i < rtp_modules_.size(); i += num_layers_) {
+    if (rtp_modules_[i]->SendOutgoingData(
+            encoded_image._frameType, payload_type_, encoded_image._timeStamp,
+            encoded_image.capture_time_ms_, encoded_image._buffer,
+            encoded_image._length, fragmentation, &rtp_video_header) != 0) {
+      result = -1;
+    }
+  }
+  return result;
 }
 
 void PayloadRouter::SetTargetSendBitrate(uint32_t bitrate_bps) {
   rtc::CritScope lock(&crit_);
-  RTC_DCHECK_LE(streams_.size(), rtp_modules_.size());
+  RTC_DCHECK_LE(streams_.size(), num_layers_);
 
   // TODO(sprang): Rebase https://codereview.webrtc.org/1913073002/ on top of
   // this.
@@ -181,14 +193,17 @@ void PayloadRouter::SetTargetSendBitrate(uint32_t bitrate_bps) {
       stream_bitrate = streams_[i].max_bitrate_bps;
     }
     bitrate_remainder -= stream_bitrate;
-    rtp_modules_[i]->SetTargetSendBitrate(stream_bitrate);
+    for (size_t j = i; j < rtp_modules_.size(); j += num_layers_)
+      rtp_modules_[j]->SetTargetSendBitrate(stream_bitrate);
   }
 }
 
 size_t PayloadRouter::MaxPayloadLength() const {
   size_t min_payload_length = DefaultMaxPayloadLength();
   rtc::CritScope lock(&crit_);
-  for (size_t i = 0; i < num_sending_modules_; ++i) {
+  for (size_t i = 0; i < rtp_modules_.size(); ++i) {
+    if (i % num_layers_ >= num_sending_modules_)
+      continue;
     size_t module_payload_length = rtp_modules_[i]->MaxDataPayloadLength();
     if (module_payload_length < min_payload_length)
       min_payload_length = module_payload_length;
@@ -28,12 +28,18 @@ class RtpRtcp;
 struct RTPVideoHeader;
 
 // PayloadRouter routes outgoing data to the correct sending RTP module, based
-// on the simulcast layer in RTPVideoHeader.
+// on the simulcast layer in RTPVideoHeader. Each layer can be sent to several
+// destinations, with one RTP module per layer and destination.
 class PayloadRouter : public EncodedImageCallback {
  public:
   // Rtp modules are assumed to be sorted in simulcast index order.
   explicit PayloadRouter(const std::vector<RtpRtcp*>& rtp_modules,
                          int payload_type);
+  // |rtp_modules| holds the modules of each of the |num_destinations|
+  // destinations in turn, each set sorted in simulcast index order.
+  PayloadRouter(const std::vector<RtpRtcp*>& rtp_modules,
+                int payload_type,
+                size_t num_destinations);
   ~PayloadRouter();
 
   static size_t DefaultMaxPayloadLength();
@@ -45,7 +51,8 @@ class PayloadRouter : public EncodedImageCallback {
   bool active();
 
   // Implements EncodedImageCallback.
-  // Returns 0 if the packet was routed / sent, -1 otherwise.
+  // Returns 0 if the packet was routed / sent to all destinations, -1
+  // otherwise.
   int32_t Encoded(const EncodedImage& encoded_image,
                   const CodecSpecificInfo* codec_specific_info,
                   const RTPFragmentationHeader* fragmentation) override;
@@ -65,8 +72,12 @@ class PayloadRouter : public EncodedImageCallback {
   std::vector<VideoStream> streams_ GUARDED_BY(crit_);
   size_t num_sending_modules_ GUARDED_BY(crit_);
 
-  // Rtp modules are assumed to be sorted in simulcast index order. Not owned.
+  // Rtp modules are assumed to be sorted in simulcast index order, per
+  // destination. Not owned.
   const std::vector<RtpRtcp*> rtp_modules_;
+  const size_t num_destinations_;
+  // Number of simulcast layers, i.e. modules per destination.
+  const size_t num_layers_;
   const int payload_type_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(PayloadRouter);
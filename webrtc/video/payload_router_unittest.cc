@@ -152,6 +152,72 @@ TEST(PayloadRouterTest, SendSimulcast) {
   EXPECT_EQ(-1, payload_router.Encoded(encoded_image, &codec_info_2, nullptr));
 }
 
+TEST(PayloadRouterTest, SendSimulcastToSeveralDestinations) {
+  NiceMock<MockRtpRtcp> rtp_1;
+  NiceMock<MockRtpRtcp> rtp_2;
+  NiceMock<MockRtpRtcp> fan_out_rtp_1;
+  NiceMock<MockRtpRtcp> fan_out_rtp_2;
+  std::vector<RtpRtcp*> modules;
+  modules.push_back(&rtp_1);
+  modules.push_back(&rtp_2);
+  modules.push_back(&fan_out_rtp_1);
+  modules.push_back(&fan_out_rtp_2);
+  std::vector<VideoStream> streams(2);
+
+  int8_t payload_type = 96;
+  uint8_t payload = 'a';
+  EncodedImage encoded_image;
+  encoded_image._timeStamp = 1;
+  encoded_image.capture_time_ms_ = 2;
+  encoded_image._frameType = kVideoFrameKey;
+  encoded_image._buffer = &payload;
+  encoded_image._length = 1;
+
+  PayloadRouter payload_router(modules, payload_type, 2);
+  payload_router.SetSendStreams(streams);
+  payload_router.set_active(true);
+
+  CodecSpecificInfo codec_info;
+  memset(&codec_info, 0, sizeof(CodecSpecificInfo));
+  codec_info.codecType = kVideoCodecVP8;
+  codec_info.codecSpecific.VP8.simulcastIdx = 1;
+
+  // The layer is sent to both destinations.
+  EXPECT_CALL(rtp_2, SendOutgoingData(encoded_image._frameType, payload_type,
+                                      encoded_image._timeStamp,
+                                      encoded_image.capture_time_ms_, &payload,
+                                      encoded_image._length, nullptr, _))
+      .Times(1);
+  EXPECT_CALL(fan_out_rtp_2,
+              SendOutgoingData(encoded_image._frameType, payload_type,
+                               encoded_image._timeStamp,
+                               encoded_image.capture_time_ms_, &payload,
+                               encoded_image._length, nullptr, _))
+      .Times(1);
+  EXPECT_CALL(rtp_1, SendOutgoingData(_, _, _, _, _, _, _, _)).Times(0);
+  EXPECT_CALL(fan_out_rtp_1, SendOutgoingData(_, _, _, _, _, _, _, _))
+      .Times(0);
+  EXPECT_EQ(0, payload_router.Encoded(encoded_image, &codec_info, nullptr));
+
+  // A failure on one destination doesn't keep the packet from the other.
+  EXPECT_CALL(rtp_2, SendOutgoingData(_, _, _, _, _, _, _, _))
+      .Times(1)
+      .WillOnce(Return(-1));
+  EXPECT_CALL(fan_out_rtp_2, SendOutgoingData(_, _, _, _, _, _, _, _))
+      .Times(1);
+  EXPECT_EQ(-1, payload_router.Encoded(encoded_image, &codec_info, nullptr));
+
+  // Disabling a layer disables it for all destinations.
+  streams.pop_back();
+  EXPECT_CALL(rtp_2, SetSendingStatus(false)).Times(1);
+  EXPECT_CALL(fan_out_rtp_2, SetSendingStatus(false)).Times(1);
+  payload_router.SetSendStreams(streams);
+  EXPECT_CALL(rtp_2, SendOutgoingData(_, _, _, _, _, _, _, _)).Times(0);
+  EXPECT_CALL(fan_out_rtp_2, SendOutgoingData(_, _, _, _, _, _, _, _))
+      .Times(0);
+  EXPECT_EQ(-1, payload_router.Encoded(encoded_image, &codec_info, nullptr));
+}
+
 TEST(PayloadRouterTest, MaxPayloadLength) {
   // Without any limitations from the modules, verify we get the max payload
   // length for IP/UDP/SRTP with a MTU of 150 bytes.
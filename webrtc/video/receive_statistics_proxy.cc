@@ -11,6 +11,7 @@
 #include "webrtc/video/receive_statistics_proxy.h"
 
 #include <cmath>
+#include <vector>
 
 #include "webrtc/base/checks.h"
 #include "webrtc/modules/video_coding/include/video_codec_interface.h"
@@ -18,12 +19,29 @@
 #include "webrtc/system_wrappers/include/metrics.h"
 
 namespace webrtc {
+namespace {
+// Stages of the receive pipeline that frames are stamped at, in order.
+enum ReceiveStage {
+  kStageCaptured,
+  kStageReceived,
+  kStagePreDecode,
+  kStageDecoded,
+  kStageRendered,
+};
+
+std::vector<const char*> ReceiveStageNames() {
+  return {"capture", "send_and_network", "jitter_buffer", "decode", "render"};
+}
+}  // namespace
 
 ReceiveStatisticsProxy::ReceiveStatisticsProxy(
     const VideoReceiveStream::Config& config,
     Clock* clock)
     : clock_(clock),
       config_(config),
+      latency_tracer_("VideoReceiveLatency",
+                      ReceiveStageNames(),
+                      config.latency_sampling_interval),
       // 1000ms window, scale 1000 for ms to s.
       decode_fps_estimator_(1000, 1000),
       renders_fps_estimator_(1000, 1000),
@@ -151,7 +169,9 @@ void ReceiveStatisticsProxy::UpdateHistograms() {
 
 VideoReceiveStream::Stats ReceiveStatisticsProxy::GetStats() const {
   rtc::CritScope lock(&crit_);
-  return stats_;
+  VideoReceiveStream::Stats stats = stats_;
+  stats.stage_delays_ms = latency_tracer_.AverageDelaysMs();
+  return stats;
 }
 
 void ReceiveStatisticsProxy::OnIncomingPayloadType(int payload_type) {
@@ -242,20 +262,39 @@ void ReceiveStatisticsProxy::DataCountersUpdated(
   }
 }
 
-void ReceiveStatisticsProxy::OnDecodedFrame() {
+void ReceiveStatisticsProxy::OnFramePacketReceived(
+    uint32_t rtp_timestamp,
+    int64_t capture_ntp_time_ms) {
+  int64_t now_ms = clock_->TimeInMilliseconds();
+
+  rtc::CritScope lock(&crit_);
+  // Zero until the first RTCP sender report has been received.
+  if (capture_ntp_time_ms > 0) {
+    int64_t capture_time_ms = capture_ntp_time_ms -
+                              (clock_->CurrentNtpInMilliseconds() - now_ms);
+    latency_tracer_.OnStage(rtp_timestamp, kStageCaptured, capture_time_ms);
+  }
+  latency_tracer_.OnStage(rtp_timestamp, kStageReceived, now_ms);
+}
+
+void ReceiveStatisticsProxy::OnDecodedFrame(uint32_t rtp_timestamp) {
   uint64_t now = clock_->TimeInMilliseconds();
 
   rtc::CritScope lock(&crit_);
   decode_fps_estimator_.Update(1, now);
   stats_.decode_frame_rate = decode_fps_estimator_.Rate(now);
+  latency_tracer_.OnStage(rtp_timestamp, kStageDecoded, now);
 }
 
-void ReceiveStatisticsProxy::OnRenderedFrame(int width, int height) {
+void ReceiveStatisticsProxy::OnRenderedFrame(const VideoFrame& frame) {
+  int width = frame.width();
+  int height = frame.height();
   RTC_DCHECK_GT(width, 0);
   RTC_DCHECK_GT(height, 0);
   uint64_t now = clock_->TimeInMilliseconds();
 
   rtc::CritScope lock(&crit_);
+  latency_tracer_.OnStage(frame.timestamp(), kStageRendered, now);
   renders_fps_estimator_.Update(1, now);
   stats_.render_frame_rate = renders_fps_estimator_.Rate(now);
   render_width_counter_.Add(width);
@@ -288,6 +327,11 @@ void ReceiveStatisticsProxy::OnDiscardedPacketsUpdated(int discarded_packets) {
 void ReceiveStatisticsProxy::OnPreDecode(
     const EncodedImage& encoded_image,
     const CodecSpecificInfo* codec_specific_info) {
+  {
+    rtc::CritScope lock(&crit_);
+    latency_tracer_.OnStage(encoded_image._timeStamp, kStagePreDecode,
+                            clock_->TimeInMilliseconds());
+  }
   if (!codec_specific_info || encoded_image.qp_ == -1) {
     return;
   }
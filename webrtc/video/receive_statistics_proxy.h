@@ -21,8 +21,10 @@
 #include "webrtc/common_types.h"
 #include "webrtc/common_video/include/frame_callback.h"
 #include "webrtc/modules/video_coding/include/video_coding_defines.h"
+#include "webrtc/video/frame_latency_tracer.h"
 #include "webrtc/video/report_block_stats.h"
 #include "webrtc/video/video_stream_decoder.h"
+#include "webrtc/video_frame.h"
 #include "webrtc/video_receive_stream.h"
 
 namespace webrtc {
@@ -43,9 +45,14 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
 
   VideoReceiveStream::Stats GetStats() const;
 
-  void OnDecodedFrame();
+  // Called for each packet of the frame with |rtp_timestamp|.
+  // |capture_ntp_time_ms| is the estimated capture time in the sender's NTP
+  // clock, or 0 if unknown.
+  void OnFramePacketReceived(uint32_t rtp_timestamp,
+                             int64_t capture_ntp_time_ms);
+  void OnDecodedFrame(uint32_t rtp_timestamp);
   void OnSyncOffsetUpdated(int64_t sync_offset_ms);
-  void OnRenderedFrame(int width, int height);
+  void OnRenderedFrame(const VideoFrame& frame);
   void OnIncomingPayloadType(int payload_type);
   void OnDecoderImplementationName(const char* implementation_name);
   void OnIncomingRate(unsigned int framerate, unsigned int bitrate_bps);
@@ -100,6 +107,7 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
 
   rtc::CriticalSection crit_;
   VideoReceiveStream::Stats stats_ GUARDED_BY(crit_);
+  FrameLatencyTracer latency_tracer_ GUARDED_BY(crit_);
   RateStatistics decode_fps_estimator_ GUARDED_BY(crit_);
   RateStatistics renders_fps_estimator_ GUARDED_BY(crit_);
   rtc::RateTracker render_fps_tracker_ GUARDED_BY(crit_);
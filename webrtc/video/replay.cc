@@ -10,14 +10,19 @@
 
 #include <stdio.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include "gflags/gflags.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 #include "webrtc/base/checks.h"
+#include "webrtc/base/format_macros.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/call.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_header_parser.h"
@@ -132,6 +137,25 @@ static std::string DecoderBitstreamFilename() {
 DEFINE_string(codec, "VP8", "Video codec");
 static std::string Codec() { return static_cast<std::string>(FLAGS_codec); }
 
+// Flags for benchmarking the receive pipeline.
+static bool ValidateNumStreams(const char* flagname, int32_t num_streams) {
+  return num_streams > 0;
+}
+DEFINE_int32(num_streams,
+             1,
+             "Number of receive streams replaying the input file "
+             "concurrently, each in its own call. Only the first one is "
+             "rendered and written to file.");
+static int NumStreams() { return static_cast<int>(FLAGS_num_streams); }
+static const bool num_streams_dummy =
+    google::RegisterFlagValidator(&FLAGS_num_streams, &ValidateNumStreams);
+
+DEFINE_bool(realtime,
+            true,
+            "Deliver packets at the pace they were recorded. If false, "
+            "packets are delivered as fast as possible.");
+static bool Realtime() { return FLAGS_realtime; }
+
 }  // namespace flags
 
 static const uint32_t kReceiverLocalSsrc = 0x123456;
@@ -145,15 +169,20 @@ class FileRenderPassthrough : public rtc::VideoSinkInterface<VideoFrame> {
         file_(nullptr),
         count_(0),
         last_width_(0),
-        last_height_(0) {}
+        last_height_(0),
+        num_frames_(0) {}
 
   ~FileRenderPassthrough() {
     if (file_)
       fclose(file_);
   }
 
+  // Only valid once the receive stream delivering frames has been destroyed.
+  size_t num_frames() const { return num_frames_; }
+
  private:
   void OnFrame(const VideoFrame& video_frame) override {
+    ++num_frames_;
     if (renderer_)
       renderer_->OnFrame(video_frame);
     if (basename_.empty())
@@ -188,6 +217,7 @@ class FileRenderPassthrough : public rtc::VideoSinkInterface<VideoFrame> {
   size_t count_;
   int last_width_;
   int last_height_;
+  size_t num_frames_;
 };
 
 class DecoderBitstreamFileWriter : public EncodedFrameObserver {
@@ -206,10 +236,16 @@ class DecoderBitstreamFileWriter : public EncodedFrameObserver {
   FILE* file_;
 };
 
-void RtpReplay() {
-  std::unique_ptr<test::VideoRenderer> playback_video(
-      test::VideoRenderer::Create("Playback Video", 640, 480));
-  FileRenderPassthrough file_passthrough(flags::OutBase(),
+// Replays the input file into a receive stream of its own call. Frames are
+// rendered and written to file only for the |primary| stream. Returns the
+// number of frames that were decoded.
+size_t ReplayStream(bool primary) {
+  std::unique_ptr<test::VideoRenderer> playback_video;
+  if (primary) {
+    playback_video.reset(
+        test::VideoRenderer::Create("Playback Video", 640, 480));
+  }
+  FileRenderPassthrough file_passthrough(primary ? flags::OutBase() : "",
                                          playback_video.get());
 
   std::unique_ptr<Call> call(Call::Create(Call::Config()));
@@ -236,13 +272,14 @@ void RtpReplay() {
   encoder_settings.payload_type = flags::PayloadType();
   VideoReceiveStream::Decoder decoder;
   std::unique_ptr<DecoderBitstreamFileWriter> bitstream_writer;
-  if (!flags::DecoderBitstreamFilename().empty()) {
+  bool write_bitstream = primary && !flags::DecoderBitstreamFilename().empty();
+  if (write_bitstream) {
     bitstream_writer.reset(new DecoderBitstreamFileWriter(
         flags::DecoderBitstreamFilename().c_str()));
     receive_config.pre_decode_callback = bitstream_writer.get();
   }
   decoder = test::CreateMatchingDecoder(encoder_settings);
-  if (!flags::DecoderBitstreamFilename().empty()) {
+  if (write_bitstream) {
     // Replace with a null decoder if we're writing the bitstream to a file
     // instead.
     delete decoder.decoder;
@@ -268,7 +305,9 @@ void RtpReplay() {
       if (!rtp_reader) {
         fprintf(stderr,
                 "Unable to open input file with any supported format\n");
-        return;
+        call->DestroyVideoReceiveStream(receive_stream);
+        delete decoder.decoder;
+        return 0;
       }
     }
   }
@@ -299,7 +338,8 @@ void RtpReplay() {
         fprintf(stderr, "Packet error, corrupt packets or incorrect setup?\n");
         break;
     }
-    if (last_time_ms != 0 && last_time_ms != packet.time_ms) {
+    if (flags::Realtime() && last_time_ms != 0 &&
+        last_time_ms != packet.time_ms) {
       SleepMs(packet.time_ms - last_time_ms);
     }
     last_time_ms = packet.time_ms;
@@ -316,6 +356,35 @@ void RtpReplay() {
   call->DestroyVideoReceiveStream(receive_stream);
 
   delete decoder.decoder;
+  return file_passthrough.num_frames();
+}
+
+bool ReplaySecondaryStream(void* num_frames) {
+  *static_cast<size_t*>(num_frames) = ReplayStream(false);
+  return false;
+}
+
+void RtpReplay() {
+  const int num_streams = flags::NumStreams();
+  std::vector<size_t> num_frames(num_streams, 0);
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  int64_t start_ms = rtc::TimeMillis();
+  for (int i = 1; i < num_streams; ++i) {
+    threads.emplace_back(new rtc::PlatformThread(
+        &ReplaySecondaryStream, &num_frames[i], "ReplayStream"));
+    threads.back()->Start();
+  }
+  num_frames[0] = ReplayStream(true);
+  size_t total_frames = num_frames[0];
+  for (int i = 1; i < num_streams; ++i) {
+    threads[i - 1]->Stop();
+    total_frames += num_frames[i];
+  }
+  int64_t elapsed_ms = std::max<int64_t>(rtc::TimeMillis() - start_ms, 1);
+  fprintf(stderr,
+          "Decoded %" PRIuS " frames in %d streams in %d ms: %.1f fps\n",
+          total_frames, num_streams, static_cast<int>(elapsed_ms),
+          1000.0 * total_frames / elapsed_ms);
 }
 }  // namespace webrtc
 
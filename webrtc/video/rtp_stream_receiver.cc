@@ -86,6 +86,7 @@ RtpStreamReceiver::RtpStreamReceiver(
       remote_bitrate_estimator_(remote_bitrate_estimator),
       packet_router_(packet_router),
       remb_(remb),
+      receive_stats_proxy_(receive_stats_proxy),
       process_thread_(process_thread),
       ntp_estimator_(clock_),
       rtp_payload_registry_(RTPPayloadStrategy::CreateStrategy(false)),
@@ -231,6 +232,8 @@ int32_t RtpStreamReceiver::OnReceivedPayloadData(
   WebRtcRTPHeader rtp_header_with_ntp = *rtp_header;
   rtp_header_with_ntp.ntp_time_ms =
       ntp_estimator_.Estimate(rtp_header->header.timestamp);
+  receive_stats_proxy_->OnFramePacketReceived(
+      rtp_header->header.timestamp, rtp_header_with_ntp.ntp_time_ms);
   if (video_receiver_->IncomingPacket(payload_data, payload_size,
                                       rtp_header_with_ntp) != 0) {
     // Check this...
@@ -283,17 +286,18 @@ bool RtpStreamReceiver::DeliverRtp(const uint8_t* rtp_packet,
     return false;
   }
   size_t payload_length = rtp_packet_length - header.headerLength;
+  // Use the time the socket received the packet when there is one, rather
+  // than reading the clock again for every packet.
   int64_t arrival_time_ms;
-  int64_t now_ms = clock_->TimeInMilliseconds();
   if (packet_time.timestamp != -1)
     arrival_time_ms = (packet_time.timestamp + 500) / 1000;
   else
-    arrival_time_ms = now_ms;
+    arrival_time_ms = clock_->TimeInMilliseconds();
 
   {
     // Periodically log the RTP header of incoming packets.
     rtc::CritScope lock(&receive_cs_);
-    if (now_ms - last_packet_log_ms_ > kPacketLogIntervalMs) {
+    if (arrival_time_ms - last_packet_log_ms_ > kPacketLogIntervalMs) {
       std::stringstream ss;
       ss << "Packet received on SSRC: " << header.ssrc << " with payload type: "
          << static_cast<int>(header.payloadType) << ", timestamp: "
@@ -304,7 +308,7 @@ bool RtpStreamReceiver::DeliverRtp(const uint8_t* rtp_packet,
       if (header.extension.hasAbsoluteSendTime)
         ss << ", abs send time: " << header.extension.absoluteSendTime;
       LOG(LS_INFO) << ss.str();
-      last_packet_log_ms_ = now_ms;
+      last_packet_log_ms_ = arrival_time_ms;
     }
   }
 
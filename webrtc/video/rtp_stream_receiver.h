@@ -133,6 +133,7 @@ class RtpStreamReceiver : public RtpData, public RtpFeedback,
   RemoteBitrateEstimator* const remote_bitrate_estimator_;
   PacketRouter* const packet_router_;
   VieRemb* const remb_;
+  ReceiveStatisticsProxy* const receive_stats_proxy_;
   ProcessThread* const process_thread_;
 
   RemoteNtpTimeEstimator ntp_estimator_;
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <cmath>
 #include <map>
+#include <utility>
 #include <vector>
 
 #include "webrtc/base/checks.h"
@@ -65,6 +66,18 @@ void UpdateCodecTypeHistogram(const std::string& payload_name) {
                             PayloadNameToHistogramCodecType(payload_name),
                             kVideoMax);
 }
+
+// Stages of the send pipeline that frames are stamped at, in order.
+enum SendStage {
+  kStageCaptured,
+  kStageDequeued,
+  kStageEncoded,
+  kStageSentToTransport,
+};
+
+std::vector<const char*> SendStageNames() {
+  return {"capture", "capture_queue", "encode", "packetize_and_pace"};
+}
 }  // namespace
 
 
@@ -79,6 +92,9 @@ SendStatisticsProxy::SendStatisticsProxy(
       content_type_(content_type),
       last_sent_frame_timestamp_(0),
       encode_time_(kEncodeTimeWeigthFactor),
+      latency_tracer_("VideoSendLatency",
+                      SendStageNames(),
+                      config.latency_sampling_interval),
       uma_container_(
           new UmaSamplesContainer(GetUmaPrefix(content_type_), stats_, clock)) {
   UpdateCodecTypeHistogram(config_.encoder_settings.payload_name);
@@ -95,6 +111,7 @@ SendStatisticsProxy::UmaSamplesContainer::UmaSamplesContainer(
     Clock* const clock)
     : uma_prefix_(prefix),
       clock_(clock),
+      start_ms_(clock->TimeInMilliseconds()),
       max_sent_width_per_timestamp_(0),
       max_sent_height_per_timestamp_(0),
       input_frame_rate_tracker_(100, 10u),
@@ -153,6 +170,31 @@ void SendStatisticsProxy::UmaSamplesContainer::UpdateHistograms(
     RTC_LOGGED_HISTOGRAMS_COUNTS_1000(kIndex, uma_prefix_ + "EncodeTimeInMs",
                                       encode_ms);
   }
+  int queue_ms = queue_time_counter_.Avg(kMinRequiredSamples);
+  if (queue_ms != -1) {
+    RTC_LOGGED_HISTOGRAMS_COUNTS_1000(
+        kIndex, uma_prefix_ + "CaptureQueueTimeInMs", queue_ms);
+  }
+  int queue_dropped =
+      queue_dropped_frame_counter_.Percent(kMinRequiredSamples);
+  if (queue_dropped != -1) {
+    RTC_LOGGED_HISTOGRAMS_PERCENTAGE(
+        kIndex, uma_prefix_ + "CaptureQueueDroppedFramesInPercent",
+        queue_dropped);
+  }
+  int64_t elapsed_sec = (clock_->TimeInMilliseconds() - start_ms_) / 1000;
+  if (elapsed_sec >= metrics::kMinRunTimeInSeconds) {
+    RTC_LOGGED_HISTOGRAMS_COUNTS_100(
+        kIndex, uma_prefix_ + "CpuOveruseDetectionsPerMinute",
+        static_cast<int>((current_stats.cpu_overuse_detections -
+                          start_stats_.cpu_overuse_detections) *
+                         60 / elapsed_sec));
+    RTC_LOGGED_HISTOGRAMS_COUNTS_100(
+        kIndex, uma_prefix_ + "CpuNormalUsageDetectionsPerMinute",
+        static_cast<int>((current_stats.cpu_normal_usage_detections -
+                          start_stats_.cpu_normal_usage_detections) *
+                         60 / elapsed_sec));
+  }
   int key_frames_permille = key_frame_counter_.Permille(kMinRequiredSamples);
   if (key_frames_permille != -1) {
     RTC_LOGGED_HISTOGRAMS_COUNTS_1000(
@@ -362,6 +404,17 @@ void SendStatisticsProxy::OnEncodedFrameTimeMeasured(
   stats_.encode_usage_percent = metrics.encode_usage_percent;
 }
 
+void SendStatisticsProxy::OnCpuAdaptation(bool overuse,
+                                          const CpuOveruseMetrics& metrics) {
+  rtc::CritScope lock(&crit_);
+  if (overuse) {
+    ++stats_.cpu_overuse_detections;
+  } else {
+    ++stats_.cpu_normal_usage_detections;
+  }
+  stats_.encode_usage_percent = metrics.encode_usage_percent;
+}
+
 void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
   rtc::CritScope lock(&crit_);
   stats_.suspended = is_suspended;
@@ -372,6 +425,7 @@ VideoSendStream::Stats SendStatisticsProxy::GetStats() {
   PurgeOldStats();
   stats_.input_frame_rate =
       round(uma_container_->input_frame_rate_tracker_.ComputeRate());
+  stats_.stage_delays_ms = latency_tracer_.AverageDelaysMs();
   return stats_;
 }
 
@@ -448,10 +502,25 @@ void SendStatisticsProxy::OnSendEncodedImage(
   if (!stats)
     return;
 
+  latency_tracer_.OnStage(encoded_image.capture_time_ms_, kStageEncoded,
+                          clock_->TimeInMilliseconds());
+
   stats->width = encoded_image._encodedWidth;
   stats->height = encoded_image._encodedHeight;
   update_times_[ssrc].resolution_update_ms = clock_->TimeInMilliseconds();
 
+  if (encoded_image.encode_time_us_ >= 0) {
+    auto it = stream_encode_times_.find(ssrc);
+    if (it == stream_encode_times_.end()) {
+      it = stream_encode_times_
+               .insert(std::make_pair(
+                   ssrc, rtc::ExpFilter(kEncodeTimeWeigthFactor)))
+               .first;
+    }
+    it->second.Apply(1.0f, encoded_image.encode_time_us_ / 1000.0f);
+    stats->avg_encode_time_ms = round(it->second.filtered());
+  }
+
   uma_container_->key_frame_counter_.Add(encoded_image._frameType ==
                                          kVideoFrameKey);
 
@@ -520,6 +589,27 @@ void SendStatisticsProxy::OnIncomingFrame(int width, int height) {
   uma_container_->input_height_counter_.Add(height);
 }
 
+void SendStatisticsProxy::OnFrameDequeued(int64_t capture_time_ms,
+                                          int queue_time_ms) {
+  rtc::CritScope lock(&crit_);
+  uma_container_->queue_time_counter_.Add(queue_time_ms);
+  uma_container_->queue_dropped_frame_counter_.Add(false);
+  latency_tracer_.OnStage(capture_time_ms, kStageCaptured, capture_time_ms);
+  latency_tracer_.OnStage(capture_time_ms, kStageDequeued,
+                          capture_time_ms + queue_time_ms);
+}
+
+void SendStatisticsProxy::OnFramePacketSent(int64_t capture_time_ms) {
+  rtc::CritScope lock(&crit_);
+  latency_tracer_.OnStage(capture_time_ms, kStageSentToTransport,
+                          clock_->TimeInMilliseconds());
+}
+
+void SendStatisticsProxy::OnFrameDroppedFromQueue() {
+  rtc::CritScope lock(&crit_);
+  uma_container_->queue_dropped_frame_counter_.Add(true);
+}
+
 void SendStatisticsProxy::RtcpPacketTypesCounterUpdated(
     uint32_t ssrc,
     const RtcpPacketTypeCounter& packet_counter) {
@@ -23,6 +23,7 @@
 #include "webrtc/modules/video_coding/include/video_codec_interface.h"
 #include "webrtc/modules/video_coding/include/video_coding_defines.h"
 #include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/video/frame_latency_tracer.h"
 #include "webrtc/video/overuse_frame_detector.h"
 #include "webrtc/video/report_block_stats.h"
 #include "webrtc/video/vie_encoder.h"
@@ -52,10 +53,18 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
                                   const CodecSpecificInfo* codec_info);
   // Used to update incoming frame rate.
   void OnIncomingFrame(int width, int height);
+  // Called when a frame captured at |capture_time_ms| is handed to the
+  // encoder, after waiting |queue_time_ms| in the capture queue.
+  void OnFrameDequeued(int64_t capture_time_ms, int queue_time_ms);
+  // Called when a captured frame is dropped from the capture queue.
+  void OnFrameDroppedFromQueue();
 
   void OnEncoderStatsUpdate(uint32_t framerate,
                             uint32_t bitrate,
                             const std::string& encoder_name);
+  // Called when a packet of the frame captured at |capture_time_ms| leaves
+  // the pacer.
+  void OnFramePacketSent(int64_t capture_time_ms);
   void OnSuspendChange(bool is_suspended);
   void OnInactiveSsrc(uint32_t ssrc);
 
@@ -69,6 +78,7 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
   // Implements CpuOveruseMetricsObserver.
   void OnEncodedFrameTimeMeasured(int encode_time_ms,
                                   const CpuOveruseMetrics& metrics) override;
+  void OnCpuAdaptation(bool overuse, const CpuOveruseMetrics& metrics) override;
 
  protected:
   // From RtcpStatisticsCallback.
@@ -142,6 +152,9 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
   uint32_t last_sent_frame_timestamp_ GUARDED_BY(crit_);
   std::map<uint32_t, StatsUpdateTimes> update_times_ GUARDED_BY(crit_);
   rtc::ExpFilter encode_time_ GUARDED_BY(crit_);
+  // Encode time of each substream, for the encoders that report it.
+  std::map<uint32_t, rtc::ExpFilter> stream_encode_times_ GUARDED_BY(crit_);
+  FrameLatencyTracer latency_tracer_ GUARDED_BY(crit_);
 
   // Contains stats used for UMA histograms. These stats will be reset if
   // content type changes between real-time video and screenshare, since these
@@ -157,6 +170,7 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
 
     const std::string uma_prefix_;
     Clock* const clock_;
+    const int64_t start_ms_;
     int max_sent_width_per_timestamp_;
     int max_sent_height_per_timestamp_;
     SampleCounter input_width_counter_;
@@ -164,6 +178,8 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
     SampleCounter sent_width_counter_;
     SampleCounter sent_height_counter_;
     SampleCounter encode_time_counter_;
+    SampleCounter queue_time_counter_;
+    BoolSampleCounter queue_dropped_frame_counter_;
     BoolSampleCounter key_frame_counter_;
     BoolSampleCounter quality_limited_frame_counter_;
     SampleCounter quality_downscales_counter_;
@@ -78,6 +78,7 @@ class SendStatisticsProxyTest : public ::testing::Test {
       EXPECT_EQ(a.total_bitrate_bps, b.total_bitrate_bps);
       EXPECT_EQ(a.avg_delay_ms, b.avg_delay_ms);
       EXPECT_EQ(a.max_delay_ms, b.max_delay_ms);
+      EXPECT_EQ(a.avg_encode_time_ms, b.avg_encode_time_ms);
 
       EXPECT_EQ(a.rtp_stats.transmitted.payload_bytes,
                 b.rtp_stats.transmitted.payload_bytes);
@@ -285,6 +286,20 @@ TEST_F(SendStatisticsProxyTest, OnEncodedFrameTimeMeasured) {
   EXPECT_EQ(metrics.encode_usage_percent, stats.encode_usage_percent);
 }
 
+TEST_F(SendStatisticsProxyTest, OnCpuAdaptation) {
+  CpuOveruseMetrics metrics;
+  metrics.encode_usage_percent = 90;
+  statistics_proxy_->OnCpuAdaptation(true, metrics);
+  metrics.encode_usage_percent = 30;
+  statistics_proxy_->OnCpuAdaptation(false, metrics);
+  statistics_proxy_->OnCpuAdaptation(false, metrics);
+
+  VideoSendStream::Stats stats = statistics_proxy_->GetStats();
+  EXPECT_EQ(1, stats.cpu_overuse_detections);
+  EXPECT_EQ(2, stats.cpu_normal_usage_detections);
+  EXPECT_EQ(metrics.encode_usage_percent, stats.encode_usage_percent);
+}
+
 TEST_F(SendStatisticsProxyTest, SwitchContentTypeUpdatesHistograms) {
   const int kWidth = 640;
   const int kHeight = 480;
@@ -322,6 +337,26 @@ TEST_F(SendStatisticsProxyTest, VerifyQpHistogramStats_Vp8) {
   EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.Encoded.Qp.Vp8.S1", kQpIdx1));
 }
 
+TEST_F(SendStatisticsProxyTest, ReportsEncodeTimePerSubstream) {
+  EncodedImage encoded_image;
+  CodecSpecificInfo codec_info;
+  codec_info.codecType = kVideoCodecVP8;
+
+  codec_info.codecSpecific.VP8.simulcastIdx = 0;
+  encoded_image.encode_time_us_ = 2000;
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+  codec_info.codecSpecific.VP8.simulcastIdx = 1;
+  encoded_image.encode_time_us_ = 8000;
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+  // Images without an encode time don't affect the average.
+  encoded_image.encode_time_us_ = -1;
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+
+  VideoSendStream::Stats stats = statistics_proxy_->GetStats();
+  EXPECT_EQ(2, stats.substreams[config_.rtp.ssrcs[0]].avg_encode_time_ms);
+  EXPECT_EQ(8, stats.substreams[config_.rtp.ssrcs[1]].avg_encode_time_ms);
+}
+
 TEST_F(SendStatisticsProxyTest, VerifyQpHistogramStats_Vp8OneSsrc) {
   VideoSendStream::Config config(nullptr);
   config.rtp.ssrcs.push_back(kFirstSsrc);
@@ -27,10 +27,12 @@ VideoCaptureInput::VideoCaptureInput(
     rtc::Event* capture_event,
     rtc::VideoSinkInterface<VideoFrame>* local_renderer,
     SendStatisticsProxy* stats_proxy,
-    OveruseFrameDetector* overuse_detector)
+    OveruseFrameDetector* overuse_detector,
+    const VideoSendStream::Config::CaptureQueue& queue_config)
     : local_renderer_(local_renderer),
       stats_proxy_(stats_proxy),
       capture_event_(capture_event),
+      queue_config_(queue_config),
       // TODO(danilchap): Pass clock from outside to ensure it is same clock
       // rtcp module use to calculate offset since last frame captured
       // to estimate rtp timestamp for SenderReport.
@@ -38,7 +40,10 @@ VideoCaptureInput::VideoCaptureInput(
       last_captured_timestamp_(0),
       delta_ntp_internal_ms_(clock_->CurrentNtpInMilliseconds() -
                              clock_->TimeInMilliseconds()),
-      overuse_detector_(overuse_detector) {}
+      overuse_detector_(overuse_detector) {
+  RTC_DCHECK_GT(queue_config_.max_frames, 0u);
+  RTC_DCHECK_GE(queue_config_.max_delay_ms, 0);
+}
 
 VideoCaptureInput::~VideoCaptureInput() {
 }
@@ -83,11 +88,12 @@ void VideoCaptureInput::IncomingCapturedFrame(const VideoFrame& video_frame) {
     return;
   }
 
-  captured_frame_.reset(new VideoFrame);
-  captured_frame_->ShallowCopy(incoming_frame);
+  if (captured_frames_.size() >= queue_config_.max_frames)
+    DropOldestFrame();
+  captured_frames_.push_back(incoming_frame);
   last_captured_timestamp_ = incoming_frame.ntp_time_ms();
 
-  overuse_detector_->FrameCaptured(*captured_frame_);
+  overuse_detector_->FrameCaptured(incoming_frame);
 
   TRACE_EVENT_ASYNC_BEGIN1("webrtc", "Video", video_frame.render_time_ms(),
                            "render_time", video_frame.render_time_ms());
@@ -97,13 +103,41 @@ void VideoCaptureInput::IncomingCapturedFrame(const VideoFrame& video_frame) {
 
 bool VideoCaptureInput::GetVideoFrame(VideoFrame* video_frame) {
   rtc::CritScope lock(&crit_);
-  if (!captured_frame_)
+  if (captured_frames_.empty())
     return false;
 
-  *video_frame = *captured_frame_;
-  captured_frame_.reset();
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  if (queue_config_.max_delay_ms > 0) {
+    // The newest frame is always kept, so that a slow encoder still gets
+    // something to encode.
+    while (captured_frames_.size() > 1 &&
+           now_ms - captured_frames_.front().render_time_ms() >
+               queue_config_.max_delay_ms) {
+      DropOldestFrame();
+    }
+  }
+
+  *video_frame = captured_frames_.front();
+  captured_frames_.pop_front();
+  stats_proxy_->OnFrameDequeued(
+      video_frame->render_time_ms(),
+      static_cast<int>(now_ms - video_frame->render_time_ms()));
+
+  // The event only wakes the encoder thread once no matter how many frames
+  // were added, so keep it going until the queue is empty.
+  if (!captured_frames_.empty())
+    capture_event_->Set();
   return true;
 }
 
+void VideoCaptureInput::DropOldestFrame() {
+  const VideoFrame& frame = captured_frames_.front();
+  overuse_detector_->FrameDropped(frame.timestamp());
+  stats_proxy_->OnFrameDroppedFromQueue();
+  TRACE_EVENT_INSTANT1("webrtc", "VideoCaptureInput::DropOldestFrame",
+                       "render_time", frame.render_time_ms());
+  captured_frames_.pop_front();
+}
+
 }  // namespace internal
 }  // namespace webrtc
@@ -11,6 +11,7 @@
 #ifndef WEBRTC_VIDEO_VIDEO_CAPTURE_INPUT_H_
 #define WEBRTC_VIDEO_VIDEO_CAPTURE_INPUT_H_
 
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -40,21 +41,29 @@ class VideoCaptureInput : public webrtc::VideoCaptureInput {
   VideoCaptureInput(rtc::Event* capture_event,
                     rtc::VideoSinkInterface<VideoFrame>* local_renderer,
                     SendStatisticsProxy* send_stats_proxy,
-                    OveruseFrameDetector* overuse_detector);
+                    OveruseFrameDetector* overuse_detector,
+                    const VideoSendStream::Config::CaptureQueue& queue_config);
   ~VideoCaptureInput();
 
   void IncomingCapturedFrame(const VideoFrame& video_frame) override;
 
+  // Takes the oldest queued frame that has not waited too long. Frames that
+  // have are dropped. |capture_event| is set again if more frames are left.
   bool GetVideoFrame(VideoFrame* frame);
 
  private:
+  void DropOldestFrame() EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   rtc::CriticalSection crit_;
 
   rtc::VideoSinkInterface<VideoFrame>* const local_renderer_;
   SendStatisticsProxy* const stats_proxy_;
   rtc::Event* const capture_event_;
+  const VideoSendStream::Config::CaptureQueue queue_config_;
 
-  std::unique_ptr<VideoFrame> captured_frame_ GUARDED_BY(crit_);
+  // Frames waiting for the encoder, oldest first. The render time of a queued
+  // frame is the local time it was captured at.
+  std::deque<VideoFrame> captured_frames_ GUARDED_BY(crit_);
   Clock* const clock_;
   // Used to make sure incoming time stamp is increasing for every frame.
   int64_t last_captured_timestamp_;
@@ -15,6 +15,7 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "webrtc/base/event.h"
 #include "webrtc/base/refcount.h"
+#include "webrtc/system_wrappers/include/sleep.h"
 #include "webrtc/test/fake_texture_frame.h"
 #include "webrtc/test/frame_utils.h"
 #include "webrtc/video/send_statistics_proxy.h"
@@ -40,8 +41,13 @@ class VideoCaptureInputTest : public ::testing::Test {
     overuse_detector_.reset(
         new OveruseFrameDetector(Clock::GetRealTimeClock(), CpuOveruseOptions(),
                                  nullptr, nullptr, &stats_proxy_));
+    CreateInput(VideoSendStream::Config::CaptureQueue());
+  }
+
+  void CreateInput(const VideoSendStream::Config::CaptureQueue& queue_config) {
     input_.reset(new internal::VideoCaptureInput(
-        &capture_event_, nullptr, &stats_proxy_, overuse_detector_.get()));
+        &capture_event_, nullptr, &stats_proxy_, overuse_detector_.get(),
+        queue_config));
   }
 
   void AddInputFrame(VideoFrame* frame) {
@@ -157,6 +163,72 @@ TEST_F(VideoCaptureInputTest, DropsFramesWithSameOrOldNtpTimestamp) {
             input_frames_[0]->ntp_time_ms() * 90);
 }
 
+TEST_F(VideoCaptureInputTest, DropsOldestFrameWhenQueueIsFull) {
+  VideoSendStream::Config::CaptureQueue queue_config;
+  queue_config.max_frames = 2;
+  CreateInput(queue_config);
+
+  for (int i = 0; i < 3; ++i) {
+    input_frames_.push_back(CreateVideoFrame(i));
+    input_frames_[i]->set_ntp_time_ms(i + 1);
+    AddInputFrame(input_frames_[i].get());
+  }
+
+  // The first frame was pushed out by the third, the other two come out in
+  // capture order.
+  WaitOutputFrame();
+  WaitOutputFrame();
+  EXPECT_EQ(input_frames_[1]->ntp_time_ms() * 90,
+            output_frames_[0]->timestamp());
+  EXPECT_EQ(input_frames_[2]->ntp_time_ms() * 90,
+            output_frames_[1]->timestamp());
+
+  EXPECT_FALSE(capture_event_.Wait(0));
+  VideoFrame frame;
+  EXPECT_FALSE(input_->GetVideoFrame(&frame));
+}
+
+TEST_F(VideoCaptureInputTest, DropsFramesThatWaitedTooLong) {
+  VideoSendStream::Config::CaptureQueue queue_config;
+  queue_config.max_frames = 3;
+  queue_config.max_delay_ms = 10;
+  CreateInput(queue_config);
+
+  for (int i = 0; i < 2; ++i) {
+    input_frames_.push_back(CreateVideoFrame(i));
+    input_frames_[i]->set_ntp_time_ms(i + 1);
+    AddInputFrame(input_frames_[i].get());
+  }
+  SleepMs(queue_config.max_delay_ms + 20);
+  input_frames_.push_back(CreateVideoFrame(2));
+  input_frames_[2]->set_ntp_time_ms(3);
+  AddInputFrame(input_frames_[2].get());
+
+  WaitOutputFrame();
+  EXPECT_EQ(input_frames_[2]->ntp_time_ms() * 90,
+            output_frames_[0]->timestamp());
+  VideoFrame frame;
+  EXPECT_FALSE(input_->GetVideoFrame(&frame));
+}
+
+TEST_F(VideoCaptureInputTest, KeepsNewestFrameEvenIfItWaitedTooLong) {
+  VideoSendStream::Config::CaptureQueue queue_config;
+  queue_config.max_frames = 3;
+  queue_config.max_delay_ms = 10;
+  CreateInput(queue_config);
+
+  for (int i = 0; i < 2; ++i) {
+    input_frames_.push_back(CreateVideoFrame(i));
+    input_frames_[i]->set_ntp_time_ms(i + 1);
+    AddInputFrame(input_frames_[i].get());
+  }
+  SleepMs(queue_config.max_delay_ms + 20);
+
+  WaitOutputFrame();
+  EXPECT_EQ(input_frames_[1]->ntp_time_ms() * 90,
+            output_frames_[0]->timestamp());
+}
+
 TEST_F(VideoCaptureInputTest, TestTextureFrames) {
   const int kNumFrame = 3;
   for (int i = 0 ; i < kNumFrame; ++i) {
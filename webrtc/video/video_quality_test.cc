@@ -408,13 +408,11 @@ class VideoAnalyzer : public PacketReceiver,
     if (it != encoded_frame_sizes_.end())
       encoded_frame_sizes_.erase(it);
 
-    VideoFrame reference_copy;
-    VideoFrame render_copy;
-    reference_copy.CopyFrame(reference);
-    render_copy.CopyFrame(render);
-
+    // The comparison shares the frame buffers rather than copying them. The
+    // capturer and decoders only write to buffers nobody else references, so
+    // holding a reference keeps the pixels intact until the comparison is done.
     rtc::CritScope crit(&comparison_lock_);
-    comparisons_.push_back(FrameComparison(reference_copy, render_copy, dropped,
+    comparisons_.push_back(FrameComparison(reference, render, dropped,
                                            send_time_ms, recv_time_ms,
                                            render_time_ms, encoded_size));
     comparison_available_event_.Set();
@@ -453,8 +451,6 @@ class VideoAnalyzer : public PacketReceiver,
     if (AllFramesRecorded())
       return false;
 
-    VideoFrame reference;
-    VideoFrame render;
     FrameComparison comparison;
 
     if (!PopComparison(&comparison)) {
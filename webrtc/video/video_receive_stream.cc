@@ -12,6 +12,7 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <set>
 #include <string>
 
@@ -21,6 +22,7 @@
 #include "webrtc/modules/congestion_controller/include/congestion_controller.h"
 #include "webrtc/modules/utility/include/process_thread.h"
 #include "webrtc/modules/video_coding/include/video_coding.h"
+#include "webrtc/modules/video_coding/include/video_error_codes.h"
 #include "webrtc/modules/video_coding/utility/ivf_file_writer.h"
 #include "webrtc/system_wrappers/include/clock.h"
 #include "webrtc/video/call_stats.h"
@@ -31,6 +33,40 @@ namespace webrtc {
 
 static const bool kEnableFrameRecording = false;
 
+namespace {
+// Stands in for the decoders of a stream in HeadlessMode::kEncodedOnly, so that
+// the VCM still assembles and orders the frames, and passes them to the
+// pre-decode callback, without decoding them.
+class EncodedOnlyDecoder : public VideoDecoder {
+ public:
+  int32_t InitDecode(const VideoCodec* codec_settings,
+                     int32_t number_of_cores) override {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  int32_t Decode(const EncodedImage& input_image,
+                 bool missing_frames,
+                 const RTPFragmentationHeader* fragmentation,
+                 const CodecSpecificInfo* codec_specific_info,
+                 int64_t render_time_ms) override {
+    return WEBRTC_VIDEO_CODEC_NO_OUTPUT;
+  }
+
+  int32_t RegisterDecodeCompleteCallback(
+      DecodedImageCallback* callback) override {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  int32_t Release() override { return WEBRTC_VIDEO_CODEC_OK; }
+
+  bool PrefersLateDecoding() const override { return false; }
+
+  const char* ImplementationName() const override {
+    return "EncodedOnlyDecoder";
+  }
+};
+}  // namespace
+
 static bool UseSendSideBwe(const VideoReceiveStream::Config& config) {
   if (!config.rtp.transport_cc)
     return false;
@@ -60,6 +96,18 @@ std::string VideoReceiveStream::Config::ToString() const {
       ss << ", ";
   }
   ss << ']';
+  ss << ", headless_mode: ";
+  switch (headless_mode) {
+    case HeadlessMode::kOff:
+      ss << "off";
+      break;
+    case HeadlessMode::kDecodeOnly:
+      ss << "decode_only";
+      break;
+    case HeadlessMode::kEncodedOnly:
+      ss << "encoded_only";
+      break;
+  }
   ss << ", rtp: " << rtp.ToString();
   ss << ", renderer: " << (renderer ? "(renderer)" : "nullptr");
   ss << ", render_delay_ms: " << render_delay_ms;
@@ -67,9 +115,13 @@ std::string VideoReceiveStream::Config::ToString() const {
     ss << ", sync_group: " << sync_group;
   ss << ", pre_decode_callback: "
      << (pre_decode_callback ? "(EncodedFrameObserver)" : "nullptr");
+  if (!recording_file_name.empty())
+    ss << ", recording_file_name: " << recording_file_name;
   ss << ", pre_render_callback: "
      << (pre_render_callback ? "(I420FrameCallback)" : "nullptr");
   ss << ", target_delay_ms: " << target_delay_ms;
+  ss << ", decoder_threads: " << decoder_threads;
+  ss << ", latency_sampling_interval: " << latency_sampling_interval;
   ss << '}';
 
   return ss.str();
@@ -151,17 +203,25 @@ VideoReceiveStream::VideoReceiveStream(
     webrtc::VoiceEngine* voice_engine,
     ProcessThread* process_thread,
     CallStats* call_stats,
-    VieRemb* remb)
+    VieRemb* remb,
+    DecodeThreadPool* decode_thread_pool,
+    EncodedFrameRecorder* frame_recorder)
     : transport_adapter_(config.rtcp_send_transport),
       encoded_frame_proxy_(config.pre_decode_callback),
       config_(config),
       process_thread_(process_thread),
       clock_(Clock::GetRealTimeClock()),
       decode_thread_(DecodeThreadFunction, this, "DecodingThread"),
+      decode_thread_pool_(decode_thread_pool),
+      decoding_on_pool_(false),
+      frame_recorder_(frame_recorder),
+      recording_file_id_(-1),
       congestion_controller_(congestion_controller),
       call_stats_(call_stats),
       video_receiver_(clock_, nullptr, this, this, this),
-      incoming_video_stream_(config.disable_prerenderer_smoothing),
+      incoming_video_stream_(
+          config.disable_prerenderer_smoothing ||
+          config.headless_mode != Config::HeadlessMode::kOff),
       stats_proxy_(config_, clock_),
       rtp_stream_receiver_(&video_receiver_,
                            congestion_controller_->GetRemoteBitrateEstimator(
@@ -189,27 +249,43 @@ VideoReceiveStream::VideoReceiveStream(
   RTC_DCHECK(congestion_controller_);
   RTC_DCHECK(call_stats_);
 
+  if (!config_.recording_file_name.empty()) {
+    RTC_DCHECK(frame_recorder_);
+    recording_file_id_ = frame_recorder_->OpenFile(config_.recording_file_name);
+  }
+
   // Register the channel to receive stats updates.
   call_stats_->RegisterStatsObserver(&video_stream_decoder_);
 
   RTC_DCHECK(!config_.decoders.empty());
+  const int decoder_cores =
+      std::max(1, std::min(num_cpu_cores, config_.decoder_threads));
+  const bool encoded_only =
+      config_.headless_mode == Config::HeadlessMode::kEncodedOnly;
+  if (encoded_only)
+    encoded_only_decoder_.reset(new EncodedOnlyDecoder());
   std::set<int> decoder_payload_types;
   for (const Decoder& decoder : config_.decoders) {
-    RTC_CHECK(decoder.decoder);
+    RTC_CHECK(decoder.decoder || encoded_only);
     RTC_CHECK(decoder_payload_types.find(decoder.payload_type) ==
               decoder_payload_types.end())
         << "Duplicate payload type (" << decoder.payload_type
         << ") for different decoders.";
     decoder_payload_types.insert(decoder.payload_type);
-    video_receiver_.RegisterExternalDecoder(decoder.decoder,
-                                            decoder.payload_type);
+    video_receiver_.RegisterExternalDecoder(
+        encoded_only ? encoded_only_decoder_.get() : decoder.decoder,
+        decoder.payload_type);
 
     VideoCodec codec = CreateDecoderVideoCodec(decoder);
     RTC_CHECK(rtp_stream_receiver_.SetReceiveCodec(codec));
     RTC_CHECK_EQ(VCM_OK, video_receiver_.RegisterReceiveCodec(
-                             &codec, num_cpu_cores, false));
+                             &codec, decoder_cores, false));
   }
 
+  // Without playout there is nothing to wait for; frames are handed on as
+  // soon as they are decodable.
+  if (config_.headless_mode != Config::HeadlessMode::kOff)
+    video_receiver_.SetIgnoreRenderTime(true);
   video_receiver_.SetRenderDelay(config.render_delay_ms);
   incoming_video_stream_.SetExpectedRenderDelay(config.render_delay_ms);
   incoming_video_stream_.SetExternalCallback(this);
@@ -234,6 +310,9 @@ VideoReceiveStream::~VideoReceiveStream() {
 
   call_stats_->DeregisterStatsObserver(&video_stream_decoder_);
 
+  if (recording_file_id_ != -1)
+    frame_recorder_->CloseFile(recording_file_id_);
+
   congestion_controller_->GetRemoteBitrateEstimator(UseSendSideBwe(config_))
       ->RemoveStream(rtp_stream_receiver_.GetRemoteSsrc());
 }
@@ -250,17 +329,26 @@ bool VideoReceiveStream::DeliverRtcp(const uint8_t* packet, size_t length) {
 bool VideoReceiveStream::DeliverRtp(const uint8_t* packet,
                                     size_t length,
                                     const PacketTime& packet_time) {
-  return rtp_stream_receiver_.DeliverRtp(packet, length, packet_time);
+  if (!rtp_stream_receiver_.DeliverRtp(packet, length, packet_time))
+    return false;
+  if (decode_thread_pool_)
+    decode_thread_pool_->Wake();
+  return true;
 }
 
 void VideoReceiveStream::Start() {
-  if (decode_thread_.IsRunning())
+  if (decode_thread_.IsRunning() || decoding_on_pool_)
     return;
   transport_adapter_.Enable();
   incoming_video_stream_.Start();
-  // Start the decode thread
-  decode_thread_.Start();
-  decode_thread_.SetPriority(rtc::kHighestPriority);
+  if (decode_thread_pool_) {
+    decode_thread_pool_->AddStream(this);
+    decoding_on_pool_ = true;
+  } else {
+    // Start the decode thread
+    decode_thread_.Start();
+    decode_thread_.SetPriority(rtc::kHighestPriority);
+  }
   rtp_stream_receiver_.StartReceive();
 }
 
@@ -268,6 +356,10 @@ void VideoReceiveStream::Stop() {
   incoming_video_stream_.Stop();
   rtp_stream_receiver_.StopReceive();
   video_receiver_.TriggerDecoderShutdown();
+  if (decoding_on_pool_) {
+    decode_thread_pool_->RemoveStream(this);
+    decoding_on_pool_ = false;
+  }
   decode_thread_.Stop();
   transport_adapter_.Disable();
 }
@@ -291,7 +383,7 @@ VideoReceiveStream::Stats VideoReceiveStream::GetStats() const {
 }
 
 void VideoReceiveStream::FrameCallback(VideoFrame* video_frame) {
-  stats_proxy_.OnDecodedFrame();
+  stats_proxy_.OnDecodedFrame(video_frame->timestamp());
 
   // Post processing is not supported if the frame is backed by a texture.
   if (!video_frame->video_frame_buffer()->native_handle()) {
@@ -308,7 +400,7 @@ void VideoReceiveStream::OnFrame(const VideoFrame& video_frame) {
   if (config_.renderer)
     config_.renderer->OnFrame(video_frame);
 
-  stats_proxy_.OnRenderedFrame(video_frame.width(), video_frame.height());
+  stats_proxy_.OnRenderedFrame(video_frame);
 }
 
 // TODO(asapersson): Consider moving callback from video_encoder.h or
@@ -323,6 +415,10 @@ int32_t VideoReceiveStream::Encoded(
     encoded_frame_proxy_.Encoded(
         encoded_image, codec_specific_info, fragmentation);
   }
+  if (recording_file_id_ != -1 && codec_specific_info) {
+    frame_recorder_->WriteFrame(recording_file_id_,
+                                codec_specific_info->codecType, encoded_image);
+  }
   if (kEnableFrameRecording) {
     if (!ivf_writer_.get()) {
       RTC_DCHECK(codec_specific_info);
@@ -350,6 +446,11 @@ void VideoReceiveStream::Decode() {
   video_receiver_.Decode(kMaxDecodeWaitTimeMs);
 }
 
+bool VideoReceiveStream::DecodeNextFrame() {
+  // The pool threads are shared with other streams, so never wait here.
+  return video_receiver_.Decode(0) != VCM_FRAME_NOT_READY;
+}
+
 void VideoReceiveStream::SendNack(
     const std::vector<uint16_t>& sequence_numbers) {
   rtp_stream_receiver_.RequestPacketRetransmit(sequence_numbers);
@@ -20,7 +20,9 @@
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/modules/video_coding/video_coding_impl.h"
 #include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/video/decode_thread_pool.h"
 #include "webrtc/video/encoded_frame_callback_adapter.h"
+#include "webrtc/video/encoded_frame_recorder.h"
 #include "webrtc/video/receive_statistics_proxy.h"
 #include "webrtc/video/rtp_stream_receiver.h"
 #include "webrtc/video/video_stream_decoder.h"
@@ -42,15 +44,20 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
                            public rtc::VideoSinkInterface<VideoFrame>,
                            public EncodedImageCallback,
                            public NackSender,
-                           public KeyFrameRequestSender {
+                           public KeyFrameRequestSender,
+                           public DecodeThreadPool::Stream {
  public:
+  // If |decode_thread_pool| is set, frames are decoded on its threads instead
+  // of on a decode thread of the stream's own.
   VideoReceiveStream(int num_cpu_cores,
                      CongestionController* congestion_controller,
                      const VideoReceiveStream::Config& config,
                      webrtc::VoiceEngine* voice_engine,
                      ProcessThread* process_thread,
                      CallStats* call_stats,
-                     VieRemb* remb);
+                     VieRemb* remb,
+                     DecodeThreadPool* decode_thread_pool,
+                     EncodedFrameRecorder* frame_recorder);
   ~VideoReceiveStream() override;
 
   void SignalNetworkState(NetworkState state);
@@ -86,6 +93,9 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   // Implements KeyFrameRequestSender.
   void RequestKeyFrame() override;
 
+  // Implements DecodeThreadPool::Stream.
+  bool DecodeNextFrame() override;
+
  private:
   static bool DecodeThreadFunction(void* ptr);
   void Decode();
@@ -97,10 +107,18 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   Clock* const clock_;
 
   rtc::PlatformThread decode_thread_;
+  DecodeThreadPool* const decode_thread_pool_;
+  bool decoding_on_pool_;
+  EncodedFrameRecorder* const frame_recorder_;
+  int recording_file_id_;
 
   CongestionController* const congestion_controller_;
   CallStats* const call_stats_;
 
+  // Registered instead of the configured decoders in
+  // HeadlessMode::kEncodedOnly. Outlives |video_receiver_|.
+  std::unique_ptr<VideoDecoder> encoded_only_decoder_;
+
   vcm::VideoReceiver video_receiver_;
   IncomingVideoStream incoming_video_stream_;
   ReceiveStatisticsProxy stats_proxy_;
@@ -48,7 +48,7 @@ std::vector<RtpRtcp*> CreateRtpRtcpModules(
     RtpPacketSender* paced_sender,
     TransportSequenceNumberAllocator* transport_sequence_number_allocator,
     SendStatisticsProxy* stats_proxy,
-    SendDelayStats* send_delay_stats,
+    SendPacketObserver* send_packet_observer,
     size_t num_modules) {
   RTC_DCHECK_GT(num_modules, 0u);
   RtpRtcp::Configuration configuration;
@@ -66,7 +66,7 @@ std::vector<RtpRtcp*> CreateRtpRtcpModules(
   configuration.send_bitrate_observer = stats_proxy;
   configuration.send_frame_count_observer = stats_proxy;
   configuration.send_side_delay_observer = stats_proxy;
-  configuration.send_packet_observer = send_delay_stats;
+  configuration.send_packet_observer = send_packet_observer;
   configuration.bandwidth_callback = bandwidth_callback;
   configuration.transport_feedback_callback = transport_feedback_callback;
 
@@ -81,6 +81,15 @@ std::vector<RtpRtcp*> CreateRtpRtcpModules(
   return modules;
 }
 
+// The SSRCs of the primary destination followed by those of each fan-out
+// destination.
+std::vector<uint32_t> AllSendSsrcs(const VideoSendStream::Config& config) {
+  std::vector<uint32_t> ssrcs = config.rtp.ssrcs;
+  for (const VideoSendStream::Config::FanOut& fan_out : config.fan_out)
+    ssrcs.insert(ssrcs.end(), fan_out.ssrcs.begin(), fan_out.ssrcs.end());
+  return ssrcs;
+}
+
 }  // namespace
 
 std::string
@@ -138,10 +147,40 @@ std::string VideoSendStream::Config::Rtp::ToString() const {
   return ss.str();
 }
 
+std::string VideoSendStream::Config::FanOut::ToString() const {
+  std::stringstream ss;
+  ss << "{ssrcs: [";
+  for (size_t i = 0; i < ssrcs.size(); ++i) {
+    ss << ssrcs[i];
+    if (i != ssrcs.size() - 1)
+      ss << ", ";
+  }
+  ss << ']';
+  ss << ", send_transport: " << (send_transport ? "(Transport)" : "nullptr");
+  ss << '}';
+  return ss.str();
+}
+
+std::string VideoSendStream::Config::CaptureQueue::ToString() const {
+  std::stringstream ss;
+  ss << "{max_frames: " << max_frames;
+  ss << ", max_delay_ms: " << max_delay_ms;
+  ss << '}';
+  return ss.str();
+}
+
 std::string VideoSendStream::Config::ToString() const {
   std::stringstream ss;
   ss << "{encoder_settings: " << encoder_settings.ToString();
   ss << ", rtp: " << rtp.ToString();
+  ss << ", fan_out: [";
+  for (size_t i = 0; i < fan_out.size(); ++i) {
+    ss << fan_out[i].ToString();
+    if (i != fan_out.size() - 1)
+      ss << ", ";
+  }
+  ss << ']';
+  ss << ", capture_queue: " << capture_queue.ToString();
   ss << ", pre_encode_callback: "
      << (pre_encode_callback ? "(I420FrameCallback)" : "nullptr");
   ss << ", post_encode_callback: "
@@ -152,6 +191,7 @@ std::string VideoSendStream::Config::ToString() const {
   ss << ", target_delay_ms: " << target_delay_ms;
   ss << ", suspend_below_min_bitrate: " << (suspend_below_min_bitrate ? "on"
                                                                       : "off");
+  ss << ", latency_sampling_interval: " << latency_sampling_interval;
   ss << '}';
   return ss.str();
 }
@@ -382,27 +422,22 @@ VideoSendStream::VideoSendStream(
                    &overuse_detector_,
                    this),
       encoder_feedback_(Clock::GetRealTimeClock(),
-                        config.rtp.ssrcs,
+                        AllSendSsrcs(config),
+                        config.rtp.ssrcs.size(),
                         &vie_encoder_),
       video_sender_(vie_encoder_.video_sender()),
       bandwidth_observer_(congestion_controller_->GetBitrateController()
                               ->CreateRtcpBandwidthObserver()),
-      rtp_rtcp_modules_(CreateRtpRtcpModules(
-          config.send_transport,
-          &encoder_feedback_,
-          bandwidth_observer_.get(),
-          congestion_controller_->GetTransportFeedbackObserver(),
-          call_stats_->rtcp_rtt_stats(),
-          congestion_controller_->pacer(),
-          congestion_controller_->packet_router(),
-          &stats_proxy_,
-          send_delay_stats,
-          config_.rtp.ssrcs.size())),
-      payload_router_(rtp_rtcp_modules_, config.encoder_settings.payload_type),
+      send_delay_stats_(send_delay_stats),
+      rtp_rtcp_modules_(CreateRtpRtcpModules()),
+      payload_router_(rtp_rtcp_modules_,
+                      config.encoder_settings.payload_type,
+                      1 + config.fan_out.size()),
       input_(&encoder_wakeup_event_,
              config_.local_renderer,
              &stats_proxy_,
-             &overuse_detector_) {
+             &overuse_detector_,
+             config_.capture_queue) {
   LOG(LS_INFO) << "VideoSendStream: " << config_.ToString();
 
   RTC_DCHECK(!config_.rtp.ssrcs.empty());
@@ -413,10 +448,12 @@ VideoSendStream::VideoSendStream(
 
 
   // RTP/RTCP initialization.
-  for (RtpRtcp* rtp_rtcp : rtp_rtcp_modules_) {
-    module_process_thread_->RegisterModule(rtp_rtcp);
-    congestion_controller_->packet_router()->AddRtpModule(rtp_rtcp);
+  for (size_t i = 0; i < rtp_rtcp_modules_.size(); ++i) {
+    module_process_thread_->RegisterModule(rtp_rtcp_modules_[i]);
+    GetPacketRouter(i)->AddRtpModule(rtp_rtcp_modules_[i]);
   }
+  for (const auto& fan_out_pacer : fan_out_pacers_)
+    module_process_thread_->RegisterModule(&fan_out_pacer->pacer);
 
   video_sender_->RegisterProtectionCallback(this);
 
@@ -440,7 +477,10 @@ VideoSendStream::VideoSendStream(
   ConfigureSsrcs();
 
   // TODO(pbos): Should we set CNAME on all RTP modules?
-  rtp_rtcp_modules_.front()->SetCNAME(config_.rtp.c_name.c_str());
+  for (size_t i = 0; i < rtp_rtcp_modules_.size();
+       i += config_.rtp.ssrcs.size()) {
+    rtp_rtcp_modules_[i]->SetCNAME(config_.rtp.c_name.c_str());
+  }
   // 28 to match packet overhead in ModuleRtpRtcpImpl.
   static const size_t kRtpPacketSizeOverhead = 28;
   RTC_DCHECK_LE(config_.rtp.max_packet_size, 0xFFFFu + kRtpPacketSizeOverhead);
@@ -485,13 +525,53 @@ VideoSendStream::~VideoSendStream() {
   rtp_rtcp_modules_[0]->SetREMBStatus(false);
   remb_->RemoveRembSender(rtp_rtcp_modules_[0]);
 
-  for (RtpRtcp* rtp_rtcp : rtp_rtcp_modules_) {
-    congestion_controller_->packet_router()->RemoveRtpModule(rtp_rtcp);
-    module_process_thread_->DeRegisterModule(rtp_rtcp);
-    delete rtp_rtcp;
+  for (const auto& fan_out_pacer : fan_out_pacers_)
+    module_process_thread_->DeRegisterModule(&fan_out_pacer->pacer);
+  for (size_t i = 0; i < rtp_rtcp_modules_.size(); ++i) {
+    GetPacketRouter(i)->RemoveRtpModule(rtp_rtcp_modules_[i]);
+    module_process_thread_->DeRegisterModule(rtp_rtcp_modules_[i]);
+    delete rtp_rtcp_modules_[i];
   }
 }
 
+VideoSendStream::FanOutPacer::FanOutPacer(Clock* clock)
+    : pacer(clock, &packet_router) {
+  // There is no bandwidth estimate of its own to probe for.
+  pacer.SetProbingEnabled(false);
+}
+
+std::vector<RtpRtcp*> VideoSendStream::CreateRtpRtcpModules() {
+  std::vector<RtpRtcp*> modules = webrtc::CreateRtpRtcpModules(
+      config_.send_transport, &encoder_feedback_, bandwidth_observer_.get(),
+      congestion_controller_->GetTransportFeedbackObserver(),
+      call_stats_->rtcp_rtt_stats(), congestion_controller_->pacer(),
+      congestion_controller_->packet_router(), &stats_proxy_, this,
+      config_.rtp.ssrcs.size());
+  for (const Config::FanOut& fan_out : config_.fan_out) {
+    RTC_DCHECK(fan_out.send_transport);
+    RTC_DCHECK_EQ(config_.rtp.ssrcs.size(), fan_out.ssrcs.size());
+    fan_out_pacers_.emplace_back(new FanOutPacer(Clock::GetRealTimeClock()));
+    FanOutPacer* fan_out_pacer = fan_out_pacers_.back().get();
+    // Transport wide sequence numbers belong to the primary transport, so the
+    // destination gets its own, and its transport feedback isn't used.
+    std::vector<RtpRtcp*> fan_out_modules = webrtc::CreateRtpRtcpModules(
+        fan_out.send_transport, &encoder_feedback_, bandwidth_observer_.get(),
+        nullptr, call_stats_->rtcp_rtt_stats(), &fan_out_pacer->pacer,
+        &fan_out_pacer->packet_router, &stats_proxy_, this,
+        fan_out.ssrcs.size());
+    modules.insert(modules.end(), fan_out_modules.begin(),
+                   fan_out_modules.end());
+  }
+  return modules;
+}
+
+PacketRouter* VideoSendStream::GetPacketRouter(size_t index) const {
+  const size_t destination = index / config_.rtp.ssrcs.size();
+  if (destination == 0)
+    return congestion_controller_->packet_router();
+  return &fan_out_pacers_[destination - 1]->packet_router;
+}
+
 bool VideoSendStream::DeliverRtcp(const uint8_t* packet, size_t length) {
   for (RtpRtcp* rtp_rtcp : rtp_rtcp_modules_)
     rtp_rtcp->IncomingRtcpPacket(packet, length);
@@ -608,15 +688,24 @@ VideoSendStream::Stats VideoSendStream::GetStats() {
 }
 
 void VideoSendStream::OveruseDetected() {
+  vie_encoder_.SetCpuOveruse(true);
   if (config_.overuse_callback)
     config_.overuse_callback->OnLoadUpdate(LoadObserver::kOveruse);
 }
 
 void VideoSendStream::NormalUsage() {
+  vie_encoder_.SetCpuOveruse(false);
   if (config_.overuse_callback)
     config_.overuse_callback->OnLoadUpdate(LoadObserver::kUnderuse);
 }
 
+void VideoSendStream::OnSendPacket(uint16_t packet_id,
+                                   int64_t capture_time_ms,
+                                   uint32_t ssrc) {
+  send_delay_stats_->OnSendPacket(packet_id, capture_time_ms, ssrc);
+  stats_proxy_.OnFramePacketSent(capture_time_ms);
+}
+
 int32_t VideoSendStream::Encoded(const EncodedImage& encoded_image,
                                  const CodecSpecificInfo* codec_specific_info,
                                  const RTPFragmentationHeader* fragmentation) {
@@ -707,9 +796,10 @@ void VideoSendStream::ConfigureProtection() {
 }
 
 void VideoSendStream::ConfigureSsrcs() {
-  // Configure regular SSRCs.
-  for (size_t i = 0; i < config_.rtp.ssrcs.size(); ++i) {
-    uint32_t ssrc = config_.rtp.ssrcs[i];
+  // Configure regular SSRCs, including those of the fan-out destinations.
+  const std::vector<uint32_t> ssrcs = AllSendSsrcs(config_);
+  for (size_t i = 0; i < ssrcs.size(); ++i) {
+    uint32_t ssrc = ssrcs[i];
     RtpRtcp* const rtp_rtcp = rtp_rtcp_modules_[i];
     rtp_rtcp->SetSSRC(ssrc);
 
@@ -734,26 +824,29 @@ void VideoSendStream::ConfigureSsrcs() {
       rtp_rtcp->SetRtxState(it->second);
   }
 
-  // Configure RTX payload types.
+  // Configure RTX payload types. The fan-out destinations don't use RTX.
   RTC_DCHECK_GE(config_.rtp.rtx.payload_type, 0);
-  for (RtpRtcp* rtp_rtcp : rtp_rtcp_modules_) {
+  for (size_t i = 0; i < config_.rtp.ssrcs.size(); ++i) {
+    RtpRtcp* const rtp_rtcp = rtp_rtcp_modules_[i];
     rtp_rtcp->SetRtxSendPayloadType(config_.rtp.rtx.payload_type,
                                     config_.encoder_settings.payload_type);
     rtp_rtcp->SetRtxSendStatus(kRtxRetransmitted | kRtxRedundantPayloads);
   }
   if (config_.rtp.fec.red_payload_type != -1 &&
       config_.rtp.fec.red_rtx_payload_type != -1) {
-    for (RtpRtcp* rtp_rtcp : rtp_rtcp_modules_) {
-      rtp_rtcp->SetRtxSendPayloadType(config_.rtp.fec.red_rtx_payload_type,
-                                      config_.rtp.fec.red_payload_type);
+    for (size_t i = 0; i < config_.rtp.ssrcs.size(); ++i) {
+      rtp_rtcp_modules_[i]->SetRtxSendPayloadType(
+          config_.rtp.fec.red_rtx_payload_type,
+          config_.rtp.fec.red_payload_type);
     }
   }
 }
 
 std::map<uint32_t, RtpState> VideoSendStream::GetRtpStates() const {
   std::map<uint32_t, RtpState> rtp_states;
-  for (size_t i = 0; i < config_.rtp.ssrcs.size(); ++i) {
-    uint32_t ssrc = config_.rtp.ssrcs[i];
+  const std::vector<uint32_t> ssrcs = AllSendSsrcs(config_);
+  for (size_t i = 0; i < ssrcs.size(); ++i) {
+    uint32_t ssrc = ssrcs[i];
     RTC_DCHECK_EQ(ssrc, rtp_rtcp_modules_[i]->SSRC());
     rtp_states[ssrc] = rtp_rtcp_modules_[i]->GetRtpState();
   }
@@ -771,6 +864,12 @@ void VideoSendStream::SignalNetworkState(NetworkState state) {
     rtp_rtcp->SetRTCPStatus(state == kNetworkUp ? config_.rtp.rtcp_mode
                                                 : RtcpMode::kOff);
   }
+  for (const auto& fan_out_pacer : fan_out_pacers_) {
+    if (state == kNetworkUp)
+      fan_out_pacer->pacer.Resume();
+    else
+      fan_out_pacer->pacer.Pause();
+  }
 }
 
 int VideoSendStream::GetPaddingNeededBps() const {
@@ -781,6 +880,9 @@ void VideoSendStream::OnBitrateUpdated(uint32_t bitrate_bps,
                                        uint8_t fraction_loss,
                                        int64_t rtt) {
   payload_router_.SetTargetSendBitrate(bitrate_bps);
+  // Each fan-out destination carries a copy of the stream, at the same rate.
+  for (const auto& fan_out_pacer : fan_out_pacers_)
+    fan_out_pacer->pacer.SetEstimatedBitrate(bitrate_bps);
   vie_encoder_.OnBitrateUpdated(bitrate_bps, fraction_loss, rtt);
 }
 
@@ -792,12 +894,17 @@ int VideoSendStream::ProtectionRequest(const FecProtectionParams* delta_params,
   *sent_video_rate_bps = 0;
   *sent_nack_rate_bps = 0;
   *sent_fec_rate_bps = 0;
-  for (RtpRtcp* rtp_rtcp : rtp_rtcp_modules_) {
+  for (size_t i = 0; i < rtp_rtcp_modules_.size(); ++i) {
+    RtpRtcp* const rtp_rtcp = rtp_rtcp_modules_[i];
+    rtp_rtcp->SetFecParameters(delta_params, key_params);
+    // The protection overhead is relative to the encoder output, which the
+    // fan-out destinations only repeat.
+    if (i >= config_.rtp.ssrcs.size())
+      continue;
     uint32_t not_used = 0;
     uint32_t module_video_rate = 0;
     uint32_t module_fec_rate = 0;
     uint32_t module_nack_rate = 0;
-    rtp_rtcp->SetFecParameters(delta_params, key_params);
     rtp_rtcp->BitrateSent(&not_used, &module_video_rate, &module_fec_rate,
                           &module_nack_rate);
     *sent_video_rate_bps += module_video_rate;
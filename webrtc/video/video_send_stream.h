@@ -19,6 +19,8 @@
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/call.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
+#include "webrtc/modules/pacing/paced_sender.h"
+#include "webrtc/modules/pacing/packet_router.h"
 #include "webrtc/video/encoded_frame_callback_adapter.h"
 #include "webrtc/video/encoder_state_feedback.h"
 #include "webrtc/video/payload_router.h"
@@ -50,7 +52,8 @@ class VideoSendStream : public webrtc::VideoSendStream,
                         public webrtc::CpuOveruseObserver,
                         public webrtc::BitrateAllocatorObserver,
                         public webrtc::VCMProtectionCallback,
-                        protected webrtc::EncodedImageCallback {
+                        protected webrtc::EncodedImageCallback,
+                        protected webrtc::SendPacketObserver {
  public:
   VideoSendStream(int num_cpu_cores,
                   ProcessThread* module_process_thread,
@@ -103,6 +106,20 @@ class VideoSendStream : public webrtc::VideoSendStream,
     std::vector<VideoStream> streams;
   };
 
+  // Paces the packets of one of |config_.fan_out|.
+  struct FanOutPacer {
+    explicit FanOutPacer(Clock* clock);
+
+    PacketRouter packet_router;
+    PacedSender pacer;
+  };
+
+  // Creates the RTP modules for the primary destination, followed by those of
+  // each fan-out destination.
+  std::vector<RtpRtcp*> CreateRtpRtcpModules();
+  // Returns the packet router that paces |rtp_rtcp_modules_[index]|.
+  PacketRouter* GetPacketRouter(size_t index) const;
+
   // Implements EncodedImageCallback. The implementation routes encoded frames
   // to the |payload_router_| and |config.pre_encode_callback| if set.
   // Called on an arbitrary encoder callback thread.
@@ -110,6 +127,12 @@ class VideoSendStream : public webrtc::VideoSendStream,
                   const CodecSpecificInfo* codec_specific_info,
                   const RTPFragmentationHeader* fragmentation) override;
 
+  // Implements SendPacketObserver. Forwards to |send_delay_stats_| and
+  // stamps the frame for latency tracing.
+  void OnSendPacket(uint16_t packet_id,
+                    int64_t capture_time_ms,
+                    uint32_t ssrc) override;
+
   static bool EncoderThreadFunction(void* obj);
   void EncoderProcess();
 
@@ -144,7 +167,11 @@ class VideoSendStream : public webrtc::VideoSendStream,
   vcm::VideoSender* const video_sender_;
 
   const std::unique_ptr<RtcpBandwidthObserver> bandwidth_observer_;
+  std::vector<std::unique_ptr<FanOutPacer>> fan_out_pacers_;
+  SendPacketObserver* const send_delay_stats_;
   // RtpRtcp modules, declared here as they use other members on construction.
+  // The first |config_.rtp.ssrcs.size()| are for the primary destination, the
+  // rest for the fan-out destinations, in the same order.
   const std::vector<RtpRtcp*> rtp_rtcp_modules_;
   PayloadRouter payload_router_;
   VideoCaptureInput input_;
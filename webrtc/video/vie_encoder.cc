@@ -26,10 +26,61 @@
 #include "webrtc/video/send_statistics_proxy.h"
 #include "webrtc/video_frame.h"
 
+#if defined(WEBRTC_WIN)
+#include <windows.h>
+#elif defined(WEBRTC_MAC)
+#include <mach/mach.h>
+#elif defined(WEBRTC_POSIX)
+#include <time.h>
+#endif
+
 namespace webrtc {
 
 static const float kStopPaddingThresholdMs = 2000;
 
+namespace {
+// Returns the CPU time used so far by the calling thread, or -1 if that is not
+// available on the platform.
+int64_t ThreadCpuTimeUs() {
+#if defined(WEBRTC_WIN)
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time,
+                      &kernel_time, &user_time)) {
+    return -1;
+  }
+  ULARGE_INTEGER kernel_100ns;
+  kernel_100ns.LowPart = kernel_time.dwLowDateTime;
+  kernel_100ns.HighPart = kernel_time.dwHighDateTime;
+  ULARGE_INTEGER user_100ns;
+  user_100ns.LowPart = user_time.dwLowDateTime;
+  user_100ns.HighPart = user_time.dwHighDateTime;
+  return static_cast<int64_t>(kernel_100ns.QuadPart + user_100ns.QuadPart) /
+         10;
+#elif defined(WEBRTC_MAC)
+  mach_port_t thread = mach_thread_self();
+  thread_basic_info_data_t info;
+  mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+  kern_return_t kr =
+      thread_info(thread, THREAD_BASIC_INFO,
+                  reinterpret_cast<thread_info_t>(&info), &count);
+  mach_port_deallocate(mach_task_self(), thread);
+  if (kr != KERN_SUCCESS)
+    return -1;
+  return (static_cast<int64_t>(info.user_time.seconds) +
+          info.system_time.seconds) * rtc::kNumMicrosecsPerSec +
+         info.user_time.microseconds + info.system_time.microseconds;
+#elif defined(WEBRTC_POSIX)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+    return -1;
+  return static_cast<int64_t>(ts.tv_sec) * rtc::kNumMicrosecsPerSec +
+         ts.tv_nsec / rtc::kNumNanosecsPerMicrosec;
+#else
+  return -1;
+#endif
+}
+}  // namespace
+
 ViEEncoder::ViEEncoder(uint32_t number_of_cores,
                        ProcessThread* module_process_thread,
                        SendStatisticsProxy* stats_proxy,
@@ -226,6 +277,9 @@ void ViEEncoder::EncodeVideoFrame(const VideoFrame& video_frame) {
 
   TRACE_EVENT_ASYNC_STEP0("webrtc", "Video", video_frame.render_time_ms(),
                           "Encode");
+  // Both the preprocessing and a software encoder run on this thread, so its
+  // CPU time is what the frame cost to encode.
+  const int64_t cpu_start_us = ThreadCpuTimeUs();
   const VideoFrame* frame_to_send = &video_frame;
   // TODO(wuchengli): support texture frames.
   if (!video_frame.video_frame_buffer()->native_handle()) {
@@ -237,8 +291,9 @@ void ViEEncoder::EncodeVideoFrame(const VideoFrame& video_frame) {
     }
   }
 
+  webrtc::CodecSpecificInfo codec_specific_info;
+  webrtc::CodecSpecificInfo* codec_info = nullptr;
   if (codec_type == webrtc::kVideoCodecVP8) {
-    webrtc::CodecSpecificInfo codec_specific_info;
     codec_specific_info.codecType = webrtc::kVideoCodecVP8;
     {
       rtc::CritScope lock(&data_cs_);
@@ -253,17 +308,26 @@ void ViEEncoder::EncodeVideoFrame(const VideoFrame& video_frame) {
       has_received_sli_ = false;
       has_received_rpsi_ = false;
     }
+    codec_info = &codec_specific_info;
+  }
+  video_sender_.AddVideoFrame(*frame_to_send, codec_info);
 
-    video_sender_.AddVideoFrame(*frame_to_send, &codec_specific_info);
-    return;
+  if (cpu_start_us != -1) {
+    overuse_detector_->FrameEncodeCpuTimeMeasured(
+        video_frame.timestamp(), ThreadCpuTimeUs() - cpu_start_us);
   }
-  video_sender_.AddVideoFrame(*frame_to_send, nullptr);
 }
 
 void ViEEncoder::SendKeyFrame() {
   video_sender_.IntraFrameRequest(0);
 }
 
+void ViEEncoder::SetCpuOveruse(bool overuse) {
+  // Box filtering reads every source pixel, bilinear only the ones around
+  // each output pixel.
+  vp_->SetInputFrameResampleMode(overuse ? kBiLinear : kBox);
+}
+
 void ViEEncoder::SetProtectionMethod(bool nack, bool fec) {
   // Set Video Protection for VCM.
   VCMVideoProtection protection_mode;
@@ -84,6 +84,9 @@ class ViEEncoder : public VideoEncoderRateObserver,
   void EncodeVideoFrame(const VideoFrame& video_frame);
   void SendKeyFrame();
 
+  // Switches preprocessing to cheaper scaling while the CPU is overused.
+  void SetCpuOveruse(bool overuse);
+
   uint32_t LastObservedBitrateBps() const;
   // Loss protection. Must be called before SetEncoder() to have max packet size
   // updated according to protection.
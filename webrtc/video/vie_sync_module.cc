@@ -93,24 +93,12 @@ void ViESyncModule::Process() {
   rtc::CritScope lock(&data_cs_);
   last_sync_time_ = rtc::TimeNanos();
 
-  const int current_video_delay_ms = video_receiver_->Delay();
-
   if (voe_channel_id_ == -1) {
     return;
   }
   assert(video_rtp_rtcp_ && voe_sync_interface_);
   assert(sync_.get());
 
-  int audio_jitter_buffer_delay_ms = 0;
-  int playout_buffer_delay_ms = 0;
-  if (voe_sync_interface_->GetDelayEstimate(voe_channel_id_,
-                                            &audio_jitter_buffer_delay_ms,
-                                            &playout_buffer_delay_ms) != 0) {
-    return;
-  }
-  const int current_audio_delay_ms = audio_jitter_buffer_delay_ms +
-      playout_buffer_delay_ms;
-
   RtpRtcp* voice_rtp_rtcp = nullptr;
   RtpReceiver* voice_receiver = nullptr;
   if (voe_sync_interface_->GetRtpRtcp(voe_channel_id_, &voice_rtp_rtcp,
@@ -137,6 +125,19 @@ void ViESyncModule::Process() {
     return;
   }
 
+  // Only query the current playout delays once there is a relative delay to
+  // act on, e.g. not until both streams have received sender reports.
+  int audio_jitter_buffer_delay_ms = 0;
+  int playout_buffer_delay_ms = 0;
+  if (voe_sync_interface_->GetDelayEstimate(voe_channel_id_,
+                                            &audio_jitter_buffer_delay_ms,
+                                            &playout_buffer_delay_ms) != 0) {
+    return;
+  }
+  const int current_audio_delay_ms = audio_jitter_buffer_delay_ms +
+      playout_buffer_delay_ms;
+  const int current_video_delay_ms = video_receiver_->Delay();
+
   TRACE_COUNTER1("webrtc", "SyncCurrentVideoDelay", current_video_delay_ms);
   TRACE_COUNTER1("webrtc", "SyncCurrentAudioDelay", current_audio_delay_ms);
   TRACE_COUNTER1("webrtc", "SyncRelativeDelay", relative_delay_ms);
@@ -179,6 +179,10 @@ class EncodedImage {
   bool _completeFrame = false;
   AdaptReason adapt_reason_;
   int qp_ = -1;  // Quantizer value.
+  // Time the encoder spent producing this image in microseconds, or -1 if
+  // unknown. Encoders that produce all simulcast layers in one call report
+  // the duration of that call for every layer.
+  int64_t encode_time_us_ = -1;
 };
 
 }  // namespace webrtc
@@ -73,6 +73,13 @@ class VideoReceiveStream {
     StreamDataCounters rtp_stats;
     RtcpPacketTypeCounter rtcp_packet_type_counts;
     RtcpStatistics rtcp_stats;
+
+    // Average time sampled frames spent in each stage of the receive
+    // pipeline, keyed by stage: "send_and_network" (from the capture time
+    // estimated from RTCP sender reports), "jitter_buffer", "decode",
+    // "render" and "total". Empty unless |Config::latency_sampling_interval|
+    // is set.
+    std::map<std::string, int> stage_delays_ms;
   };
 
   struct Config {
@@ -85,6 +92,21 @@ class VideoReceiveStream {
     // Decoders for every payload that we can receive.
     std::vector<Decoder> decoders;
 
+    // Receive modes for recorders and other consumers that don't play the
+    // stream out in real time.
+    enum class HeadlessMode {
+      // Frames are decoded and handed to |renderer| at their render time.
+      kOff,
+      // Frames are decoded as soon as they are decodable, and handed to
+      // |renderer| straight from the decode thread.
+      kDecodeOnly,
+      // Frames are not decoded at all. |pre_decode_callback| gets them as soon
+      // as they are decodable. |decoders| only tell the payload types and
+      // codecs, and their |decoder| may be null.
+      kEncodedOnly,
+    };
+    HeadlessMode headless_mode = HeadlessMode::kOff;
+
     // Receive-stream specific RTP settings.
     struct Rtp {
       std::string ToString() const;
@@ -165,6 +187,11 @@ class VideoReceiveStream {
     // saving the stream to a file. 'nullptr' disables the callback.
     EncodedFrameObserver* pre_decode_callback = nullptr;
 
+    // If set, the received frames are written to this IVF file as they are,
+    // without decoding, on a background thread shared by the call. The
+    // recording starts at the first key frame.
+    std::string recording_file_name;
+
     // Called for each decoded frame. E.g. used when adding effects to the
     // decoded
     // stream. 'nullptr' disables the callback.
@@ -173,6 +200,16 @@ class VideoReceiveStream {
     // Target delay in milliseconds. A positive value indicates this stream is
     // used for streaming instead of a real-time call.
     int target_delay_ms = 0;
+
+    // Maximum number of threads each decoder may use, if it supports decoding
+    // on several threads. Also limited by the number of cores.
+    int decoder_threads = 1;
+
+    // If positive, roughly one in |latency_sampling_interval| frames is
+    // stamped at each stage of the receive pipeline, see
+    // Stats::stage_delays_ms. Sampled frames are also traced as
+    // "VideoReceiveLatency" trace events.
+    int latency_sampling_interval = 0;
   };
 
   // Starts stream activity.
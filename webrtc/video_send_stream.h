@@ -49,6 +49,8 @@ class VideoSendStream {
     int retransmit_bitrate_bps = 0;
     int avg_delay_ms = 0;
     int max_delay_ms = 0;
+    // Average time spent encoding this stream, if reported by the encoder.
+    int avg_encode_time_ms = 0;
     StreamDataCounters rtp_stats;
     RtcpPacketTypeCounter rtcp_packet_type_counts;
     RtcpStatistics rtcp_stats;
@@ -60,11 +62,19 @@ class VideoSendStream {
     int encode_frame_rate = 0;
     int avg_encode_time_ms = 0;
     int encode_usage_percent = 0;
+    // Number of times CPU overuse or normal usage has been reported to
+    // |Config::overuse_callback|.
+    int cpu_overuse_detections = 0;
+    int cpu_normal_usage_detections = 0;
     int target_media_bitrate_bps = 0;
     int media_bitrate_bps = 0;
     bool suspended = false;
     bool bw_limited_resolution = false;
     std::map<uint32_t, StreamStats> substreams;
+    // Average time sampled frames spent in each stage of the send pipeline,
+    // keyed by stage: "capture_queue", "encode", "packetize_and_pace" and
+    // "total". Empty unless |Config::latency_sampling_interval| is set.
+    std::map<std::string, int> stage_delays_ms;
   };
 
   struct Config {
@@ -133,6 +143,38 @@ class VideoSendStream {
     // Transport for outgoing packets.
     Transport* send_transport = nullptr;
 
+    // Additional destinations for the encoded stream. Every packet is also
+    // sent to each of them through RTP modules, a pacer and a transport of its
+    // own, so that receivers that want the same quality share one encoder.
+    // RTCP from the destinations feeds the same bandwidth estimate and key
+    // frame requests as for the primary destination.
+    struct FanOut {
+      std::string ToString() const;
+
+      // SSRCs to use for the destination, one per entry in |rtp.ssrcs|.
+      std::vector<uint32_t> ssrcs;
+
+      // Transport for the destination's outgoing packets.
+      Transport* send_transport = nullptr;
+    };
+    std::vector<FanOut> fan_out;
+
+    // Captured frames waiting for the encoder thread. By default only the
+    // latest frame is kept, so a frame that arrives while the encoder is busy
+    // replaces the one waiting.
+    struct CaptureQueue {
+      std::string ToString() const;
+
+      // Maximum number of frames waiting. When the queue is full, the oldest
+      // frame is dropped to make room.
+      size_t max_frames = 1;
+
+      // Frames that have waited longer than this by the time the encoder gets
+      // to them are dropped, unless they are the newest frame in the queue.
+      // 0 disables the limit.
+      int max_delay_ms = 0;
+    } capture_queue;
+
     // Callback for overuse and normal usage based on the jitter of incoming
     // captured frames. 'nullptr' disables the callback.
     LoadObserver* overuse_callback = nullptr;
@@ -164,6 +206,11 @@ class VideoSendStream {
     // below the minimum configured bitrate. If this variable is false, the
     // stream may send at a rate higher than the estimated available bitrate.
     bool suspend_below_min_bitrate = false;
+
+    // If positive, roughly one in |latency_sampling_interval| frames is
+    // stamped at each stage of the send pipeline, see Stats::stage_delays_ms.
+    // Sampled frames are also traced as "VideoSendLatency" trace events.
+    int latency_sampling_interval = 0;
   };
 
   // Starts stream activity.
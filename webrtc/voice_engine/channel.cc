@@ -11,6 +11,7 @@
 #include "webrtc/voice_engine/channel.h"
 
 #include <algorithm>
+#include <sstream>
 #include <utility>
 
 #include "webrtc/base/checks.h"
@@ -264,6 +265,38 @@ int32_t Channel::SendData(FrameType frameType,
                " payloadSize=%" PRIuS ", fragmentation=0x%x)",
                frameType, payloadType, timeStamp, payloadSize, fragmentation);
 
+  int32_t result = SendEncodedData(_channelId, frameType, payloadType,
+                                   timeStamp, payloadData, payloadSize,
+                                   fragmentation);
+  if (encoded_frame_followers_) {
+    for (Channel* follower : *encoded_frame_followers_) {
+      follower->SendEncodedData(_channelId, frameType, payloadType, timeStamp,
+                                payloadData, payloadSize, fragmentation);
+    }
+  }
+  return result;
+}
+
+int32_t Channel::SendEncodedData(int source,
+                                 FrameType frameType,
+                                 uint8_t payloadType,
+                                 uint32_t timeStamp,
+                                 const uint8_t* payloadData,
+                                 size_t payloadSize,
+                                 const RTPFragmentationHeader* fragmentation) {
+  if (source != timestamp_source_) {
+    // Continue from the last packet sent, as if it was one packet earlier in
+    // the new source's timeline.
+    if (timestamp_source_ != -1) {
+      timestamp_offset_ =
+          _lastLocalTimeStamp + last_timestamp_delta_ - timeStamp;
+    }
+    timestamp_source_ = source;
+  } else {
+    last_timestamp_delta_ = timeStamp + timestamp_offset_ - _lastLocalTimeStamp;
+  }
+  timeStamp += timestamp_offset_;
+
   if (_includeAudioLevelIndication) {
     // Store current audio level in the RTP/RTCP module.
     // The level will be used in combination with voice-activity state
@@ -796,6 +829,10 @@ Channel::Channel(int32_t channelId,
       _panRight(1.0f),
       _outputGain(1.0f),
       _lastLocalTimeStamp(0),
+      encoded_frame_followers_(nullptr),
+      timestamp_source_(-1),
+      timestamp_offset_(0),
+      last_timestamp_delta_(0),
       _lastPayloadType(0),
       _includeAudioLevelIndication(false),
       _outputSpeechType(AudioFrame::kNormalSpeech),
@@ -810,6 +847,10 @@ Channel::Channel(int32_t channelId,
       network_predictor_(new NetworkPredictor(Clock::GetRealTimeClock())),
       associate_send_channel_(ChannelOwner(nullptr)),
       pacing_enabled_(config.Get<VoicePacing>().enabled),
+      shared_encoding_enabled_(config.Get<SharedSendEncoding>().enabled),
+      bitrate_adapted_(false),
+      opus_max_playback_rate_hz_(0),
+      opus_dtx_enabled_(false),
       feedback_observer_proxy_(new TransportFeedbackProxy()),
       seq_num_allocator_proxy_(new TransportSequenceNumberProxy()),
       rtp_packet_sender_proxy_(new RtpPacketSenderProxy()) {
@@ -1003,8 +1044,7 @@ int32_t Channel::Init() {
     }
 
     if (!STR_CASE_CMP(codec.plname, "CN")) {
-      if (!codec_manager_.RegisterEncoder(codec) ||
-          !codec_manager_.MakeEncoder(&rent_a_codec_, audio_coding_.get()) ||
+      if (!codec_manager_.RegisterEncoder(codec) || !MakeEncoder() ||
           !RegisterReceiveCodec(&audio_coding_, &rent_a_codec_, codec) ||
           _rtpRtcpModule->RegisterSendPayload(codec) == -1) {
         WEBRTC_TRACE(kTraceWarning, kTraceVoice, VoEId(_instanceId, _channelId),
@@ -1239,8 +1279,7 @@ int32_t Channel::SetSendCodec(const CodecInst& codec) {
   WEBRTC_TRACE(kTraceInfo, kTraceVoice, VoEId(_instanceId, _channelId),
                "Channel::SetSendCodec()");
 
-  if (!codec_manager_.RegisterEncoder(codec) ||
-      !codec_manager_.MakeEncoder(&rent_a_codec_, audio_coding_.get())) {
+  if (!codec_manager_.RegisterEncoder(codec) || !MakeEncoder()) {
     WEBRTC_TRACE(kTraceError, kTraceVoice, VoEId(_instanceId, _channelId),
                  "SetSendCodec() failed to register codec to ACM");
     return -1;
@@ -1269,6 +1308,8 @@ void Channel::SetBitRate(int bitrate_bps) {
   WEBRTC_TRACE(kTraceInfo, kTraceVoice, VoEId(_instanceId, _channelId),
                "Channel::SetBitRate(bitrate_bps=%d)", bitrate_bps);
   audio_coding_->SetBitRate(bitrate_bps);
+  rtc::CritScope lock(&encoder_key_lock_);
+  bitrate_adapted_ = true;
 }
 
 void Channel::OnIncomingFractionLoss(int fraction_lost) {
@@ -1288,8 +1329,7 @@ int32_t Channel::SetVADStatus(bool enableVAD,
   WEBRTC_TRACE(kTraceInfo, kTraceVoice, VoEId(_instanceId, _channelId),
                "Channel::SetVADStatus(mode=%d)", mode);
   RTC_DCHECK(!(disableDTX && enableVAD));  // disableDTX mode is deprecated.
-  if (!codec_manager_.SetVAD(enableVAD, mode) ||
-      !codec_manager_.MakeEncoder(&rent_a_codec_, audio_coding_.get())) {
+  if (!codec_manager_.SetVAD(enableVAD, mode) || !MakeEncoder()) {
     _engineStatisticsPtr->SetLastError(VE_AUDIO_CODING_MODULE_ERROR,
                                        kTraceError,
                                        "SetVADStatus() failed to set VAD");
@@ -1418,8 +1458,7 @@ int32_t Channel::SetSendCNPayloadType(int type, PayloadFrequencies frequency) {
   // Modify the payload type (must be set to dynamic range)
   codec.pltype = type;
 
-  if (!codec_manager_.RegisterEncoder(codec) ||
-      !codec_manager_.MakeEncoder(&rent_a_codec_, audio_coding_.get())) {
+  if (!codec_manager_.RegisterEncoder(codec) || !MakeEncoder()) {
     _engineStatisticsPtr->SetLastError(
         VE_AUDIO_CODING_MODULE_ERROR, kTraceError,
         "SetSendCNPayloadType() failed to register CN to ACM");
@@ -1449,6 +1488,8 @@ int Channel::SetOpusMaxPlaybackRate(int frequency_hz) {
         "SetOpusMaxPlaybackRate() failed to set maximum playback rate");
     return -1;
   }
+  opus_max_playback_rate_hz_ = frequency_hz;
+  UpdateEncoderKey();
   return 0;
 }
 
@@ -1462,6 +1503,8 @@ int Channel::SetOpusDtx(bool enable_dtx) {
                                        kTraceError, "SetOpusDtx() failed");
     return -1;
   }
+  opus_dtx_enabled_ = enable_dtx;
+  UpdateEncoderKey();
   return 0;
 }
 
@@ -2879,8 +2922,7 @@ int Channel::SetREDStatus(bool enable, int redPayloadtype) {
     }
   }
 
-  if (!codec_manager_.SetCopyRed(enable) ||
-      !codec_manager_.MakeEncoder(&rent_a_codec_, audio_coding_.get())) {
+  if (!codec_manager_.SetCopyRed(enable) || !MakeEncoder()) {
     _engineStatisticsPtr->SetLastError(
         VE_AUDIO_CODING_MODULE_ERROR, kTraceError,
         "SetREDStatus() failed to set RED state in the ACM");
@@ -2910,8 +2952,7 @@ int Channel::SetCodecFECStatus(bool enable) {
   WEBRTC_TRACE(kTraceInfo, kTraceVoice, VoEId(_instanceId, _channelId),
                "Channel::SetCodecFECStatus()");
 
-  if (!codec_manager_.SetCodecFEC(enable) ||
-      !codec_manager_.MakeEncoder(&rent_a_codec_, audio_coding_.get())) {
+  if (!codec_manager_.SetCodecFEC(enable) || !MakeEncoder()) {
     _engineStatisticsPtr->SetLastError(
         VE_AUDIO_CODING_MODULE_ERROR, kTraceError,
         "SetCodecFECStatus() failed to set FEC state");
@@ -3036,6 +3077,65 @@ uint32_t Channel::EncodeAndSend() {
   return 0;
 }
 
+uint32_t Channel::EncodeAndSend(const std::vector<Channel*>& followers) {
+  encoded_frame_followers_ = &followers;
+  uint32_t result = EncodeAndSend();
+  encoded_frame_followers_ = nullptr;
+  return result;
+}
+
+bool Channel::IsEncoderShareable() {
+  if (!shared_encoding_enabled_)
+    return false;
+  {
+    rtc::CritScope lock(&encoder_key_lock_);
+    if (encoder_key_.empty() || bitrate_adapted_)
+      return false;
+  }
+  ChannelState::State state = channel_state_.Get();
+  return !state.input_file_playing && !state.input_external_media &&
+         !InputMute();
+}
+
+bool Channel::HasSameEncoderAs(Channel* other) {
+  const std::string key = encoder_key();
+  return !key.empty() && key == other->encoder_key();
+}
+
+bool Channel::MakeEncoder() {
+  bool success =
+      codec_manager_.MakeEncoder(&rent_a_codec_, audio_coding_.get());
+  UpdateEncoderKey();
+  return success;
+}
+
+void Channel::UpdateEncoderKey() {
+  std::string key;
+  const CodecInst* codec = codec_manager_.GetCodecInst();
+  const auto* params = codec_manager_.GetStackParams();
+  // Codec FEC adapts to the packet loss reported for this channel alone.
+  if (codec && !params->use_codec_fec) {
+    std::ostringstream os;
+    os << codec->plname << " " << codec->pltype << " " << codec->plfreq << " "
+       << codec->pacsize << " " << codec->channels << " " << codec->rate;
+    os << " cng " << params->use_cng << " " << params->vad_mode;
+    for (const auto& pt : params->cng_payload_types)
+      os << " " << pt.first << ":" << pt.second;
+    os << " red " << params->use_red;
+    for (const auto& pt : params->red_payload_types)
+      os << " " << pt.first << ":" << pt.second;
+    os << " opus " << opus_max_playback_rate_hz_ << " " << opus_dtx_enabled_;
+    key = os.str();
+  }
+  rtc::CritScope lock(&encoder_key_lock_);
+  encoder_key_ = key;
+}
+
+std::string Channel::encoder_key() const {
+  rtc::CritScope lock(&encoder_key_lock_);
+  return encoder_key_;
+}
+
 void Channel::DisassociateSendChannel(int channel_id) {
   rtc::CritScope lock(&assoc_send_channel_lock_);
   Channel* channel = associate_send_channel_.channel();
@@ -3468,8 +3568,7 @@ int Channel::SetRedPayloadType(int red_payload_type) {
   }
 
   codec.pltype = red_payload_type;
-  if (!codec_manager_.RegisterEncoder(codec) ||
-      !codec_manager_.MakeEncoder(&rent_a_codec_, audio_coding_.get())) {
+  if (!codec_manager_.RegisterEncoder(codec) || !MakeEncoder()) {
     _engineStatisticsPtr->SetLastError(
         VE_AUDIO_CODING_MODULE_ERROR, kTraceError,
         "SetRedPayloadType() RED registration in ACM module failed");
@@ -12,6 +12,8 @@
 #define WEBRTC_VOICE_ENGINE_CHANNEL_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "webrtc/audio_sink.h"
 #include "webrtc/base/criticalsection.h"
@@ -427,6 +429,19 @@ class Channel
                    size_t number_of_channels);
   uint32_t PrepareEncodeAndSend(int mixingFrequency);
   uint32_t EncodeAndSend();
+  // Like EncodeAndSend(), but also sends every packet produced on each of
+  // |followers|, instead of them encoding the frame themselves. All must have
+  // IsEncoderShareable() and HasSameEncoderAs() this channel.
+  uint32_t EncodeAndSend(const std::vector<Channel*>& followers);
+
+  // True if the channel opted in with SharedSendEncoding, and doesn't alter
+  // the capture signal per channel, so that its encoder input is the same as
+  // for the other channels fed by the TransmitMixer. Channels whose encoder
+  // adapts to their own network, through codec FEC or a bitrate set by
+  // bandwidth estimation, encode on their own.
+  bool IsEncoderShareable();
+  // True if |other| would produce the same packets from the same input.
+  bool HasSameEncoderAs(Channel* other);
 
   // Associate to a send channel.
   // Used for obtaining RTT for a receive-only channel.
@@ -460,6 +475,11 @@ class Channel
   void RegisterReceiveCodecsToRTPModule();
 
   int SetRedPayloadType(int red_payload_type);
+  // Rebuilds the encoder stack from |codec_manager_|, and updates
+  // |encoder_key_| to match.
+  bool MakeEncoder();
+  void UpdateEncoderKey();
+  std::string encoder_key() const;
   int SetSendRtpHeaderExtension(bool enable,
                                 RTPExtensionType type,
                                 unsigned char id);
@@ -467,6 +487,16 @@ class Channel
   int32_t GetPlayoutFrequency();
   int64_t GetRTT(bool allow_associate_channel) const;
 
+  // Sends a packet encoded by the channel with ID |source|, which is this
+  // channel for packets from its own encoder.
+  int32_t SendEncodedData(int source,
+                          FrameType frameType,
+                          uint8_t payloadType,
+                          uint32_t timeStamp,
+                          const uint8_t* payloadData,
+                          size_t payloadSize,
+                          const RTPFragmentationHeader* fragmentation);
+
   rtc::CriticalSection _fileCritSect;
   rtc::CriticalSection _callbackCritSect;
   rtc::CriticalSection volume_settings_critsect_;
@@ -550,6 +580,14 @@ class Channel
   float _outputGain GUARDED_BY(volume_settings_critsect_);
   // VoeRTP_RTCP
   uint32_t _lastLocalTimeStamp;
+  // Channels sending what this one encodes. Only set during EncodeAndSend().
+  const std::vector<Channel*>* encoded_frame_followers_;
+  // Packets can come from this channel's encoder or from another channel's.
+  // Timestamps are offset so that the stream stays continuous when switching
+  // between them. Only accessed on the encoding thread.
+  int timestamp_source_;
+  uint32_t timestamp_offset_;
+  uint32_t last_timestamp_delta_;
   int8_t _lastPayloadType;
   bool _includeAudioLevelIndication;
   // VoENetwork
@@ -572,6 +610,18 @@ class Channel
   ChannelOwner associate_send_channel_ GUARDED_BY(assoc_send_channel_lock_);
 
   bool pacing_enabled_;
+  const bool shared_encoding_enabled_;
+  // Describes everything that determines the encoder output, so that channels
+  // can be grouped by SharedSendEncoding without reading their codec settings
+  // while they change. Empty if the channel can't share its encoder. Updated
+  // whenever the encoder is reconfigured.
+  rtc::CriticalSection encoder_key_lock_;
+  std::string encoder_key_ GUARDED_BY(encoder_key_lock_);
+  // Set once the bitrate is controlled by bandwidth estimation.
+  bool bitrate_adapted_ GUARDED_BY(encoder_key_lock_);
+  // Opus settings applied directly to the encoder, for |encoder_key_|.
+  int opus_max_playback_rate_hz_;
+  bool opus_dtx_enabled_;
   PacketRouter* packet_router_ = nullptr;
   std::unique_ptr<TransportFeedbackProxy> feedback_observer_proxy_;
   std::unique_ptr<TransportSequenceNumberProxy> seq_num_allocator_proxy_;
@@ -9,7 +9,99 @@
  */
 
 #include "testing/gtest/include/gtest/gtest.h"
+#include "webrtc/common.h"
+#include "webrtc/config.h"
 #include "webrtc/voice_engine/channel.h"
+#include "webrtc/voice_engine/channel_manager.h"
+#include "webrtc/voice_engine/shared_data.h"
+#include "webrtc/voice_engine/voice_engine_fixture.h"
+#include "webrtc/voice_engine/voice_engine_impl.h"
 
 // Empty test just to get coverage metrics.
 TEST(ChannelTest, EmptyTestToGetCodeCoverage) {}
+
+namespace webrtc {
+
+class ChannelSharedEncodingTest : public VoiceEngineFixture {
+ protected:
+  void SetUp() override {
+    EXPECT_EQ(0, base_->Init(&adm_, nullptr));
+    Config config;
+    config.Set<SharedSendEncoding>(new SharedSendEncoding(true));
+    channel_id_1_ = base_->CreateChannel(config);
+    channel_id_2_ = base_->CreateChannel(config);
+    voe::SharedData* shared_data = static_cast<voe::SharedData*>(
+        static_cast<VoiceEngineImpl*>(voe_));
+    owner_1_ = shared_data->channel_manager().GetChannel(channel_id_1_);
+    owner_2_ = shared_data->channel_manager().GetChannel(channel_id_2_);
+    channel_1_ = owner_1_.channel();
+    channel_2_ = owner_2_.channel();
+    ASSERT_TRUE(channel_1_);
+    ASSERT_TRUE(channel_2_);
+  }
+
+  void TearDown() override {
+    EXPECT_EQ(0, base_->DeleteChannel(channel_id_1_));
+    EXPECT_EQ(0, base_->DeleteChannel(channel_id_2_));
+  }
+
+  int channel_id_1_ = -1;
+  int channel_id_2_ = -1;
+  voe::ChannelOwner owner_1_ = voe::ChannelOwner(nullptr);
+  voe::ChannelOwner owner_2_ = voe::ChannelOwner(nullptr);
+  voe::Channel* channel_1_ = nullptr;
+  voe::Channel* channel_2_ = nullptr;
+};
+
+TEST_F(ChannelSharedEncodingTest, GroupsChannelsWithSameEncoder) {
+  EXPECT_TRUE(channel_1_->IsEncoderShareable());
+  EXPECT_TRUE(channel_2_->IsEncoderShareable());
+  EXPECT_TRUE(channel_1_->HasSameEncoderAs(channel_2_));
+  EXPECT_TRUE(channel_2_->HasSameEncoderAs(channel_1_));
+}
+
+TEST_F(ChannelSharedEncodingTest, UngroupsOnSendCodecChange) {
+  CodecInst codec;
+  ASSERT_EQ(0, channel_1_->GetSendCodec(codec));
+  codec.pacsize *= 2;
+  ASSERT_EQ(0, channel_2_->SetSendCodec(codec));
+  EXPECT_FALSE(channel_1_->HasSameEncoderAs(channel_2_));
+
+  ASSERT_EQ(0, channel_1_->SetSendCodec(codec));
+  EXPECT_TRUE(channel_1_->HasSameEncoderAs(channel_2_));
+}
+
+TEST_F(ChannelSharedEncodingTest, UngroupsOnVadChange) {
+  ASSERT_EQ(0, channel_2_->SetVADStatus(true, VADNormal, false));
+  EXPECT_FALSE(channel_1_->HasSameEncoderAs(channel_2_));
+
+  ASSERT_EQ(0, channel_2_->SetVADStatus(false, VADNormal, false));
+  EXPECT_TRUE(channel_1_->HasSameEncoderAs(channel_2_));
+}
+
+TEST_F(ChannelSharedEncodingTest, ChannelWithEstimatedBitrateEncodesAlone) {
+  channel_2_->SetBitRate(32000);
+  EXPECT_TRUE(channel_1_->IsEncoderShareable());
+  EXPECT_FALSE(channel_2_->IsEncoderShareable());
+}
+
+TEST_F(ChannelSharedEncodingTest, MutedChannelEncodesAlone) {
+  channel_2_->SetInputMute(true);
+  EXPECT_FALSE(channel_2_->IsEncoderShareable());
+  channel_2_->SetInputMute(false);
+  EXPECT_TRUE(channel_2_->IsEncoderShareable());
+}
+
+TEST_F(ChannelSharedEncodingTest, ChannelWithoutOptionEncodesAlone) {
+  const int channel_id = base_->CreateChannel();
+  voe::SharedData* shared_data = static_cast<voe::SharedData*>(
+      static_cast<VoiceEngineImpl*>(voe_));
+  voe::ChannelOwner owner =
+      shared_data->channel_manager().GetChannel(channel_id);
+  ASSERT_TRUE(owner.channel());
+  EXPECT_FALSE(owner.channel()->IsEncoderShareable());
+  EXPECT_TRUE(channel_1_->HasSameEncoderAs(owner.channel()));
+  EXPECT_EQ(0, base_->DeleteChannel(channel_id));
+}
+
+}  // namespace webrtc
@@ -11,6 +11,7 @@
 #include "webrtc/voice_engine/output_mixer.h"
 
 #include "webrtc/base/format_macros.h"
+#include "webrtc/config.h"
 #include "webrtc/modules/audio_processing/include/audio_processing.h"
 #include "webrtc/modules/utility/include/audio_frame_operations.h"
 #include "webrtc/system_wrappers/include/file_wrapper.h"
@@ -75,11 +76,12 @@ void OutputMixer::RecordFileEnded(int32_t id)
 }
 
 int32_t
-OutputMixer::Create(OutputMixer*& mixer, uint32_t instanceId)
+OutputMixer::Create(OutputMixer*& mixer, uint32_t instanceId,
+                    const Config& config)
 {
     WEBRTC_TRACE(kTraceMemory, kTraceVoice, instanceId,
                  "OutputMixer::Create(instanceId=%d)", instanceId);
-    mixer = new OutputMixer(instanceId);
+    mixer = new OutputMixer(instanceId, config);
     if (mixer == NULL)
     {
         WEBRTC_TRACE(kTraceMemory, kTraceVoice, instanceId,
@@ -90,8 +92,10 @@ OutputMixer::Create(OutputMixer*& mixer, uint32_t instanceId)
     return 0;
 }
 
-OutputMixer::OutputMixer(uint32_t instanceId) :
-    _mixerModule(*AudioConferenceMixer::Create(instanceId)),
+OutputMixer::OutputMixer(uint32_t instanceId, const Config& config) :
+    _mixerModule(*AudioConferenceMixer::Create(
+        instanceId, config.Get<ParallelPlayoutMixing>().num_threads,
+        config.Get<ParallelPlayoutMixing>().deadline_ms)),
     _audioLevel(),
     _instanceId(instanceId),
     _externalMediaCallbackPtr(NULL),
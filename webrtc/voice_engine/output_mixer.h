@@ -23,6 +23,7 @@
 namespace webrtc {
 
 class AudioProcessing;
+class Config;
 class FileWrapper;
 class VoEMediaProcess;
 
@@ -34,7 +35,8 @@ class OutputMixer : public AudioMixerOutputReceiver,
                     public FileCallback
 {
 public:
-    static int32_t Create(OutputMixer*& mixer, uint32_t instanceId);
+    static int32_t Create(OutputMixer*& mixer, uint32_t instanceId,
+                          const Config& config);
 
     static void Destroy(OutputMixer*& mixer);
 
@@ -97,7 +99,7 @@ public:
     void RecordFileEnded(int32_t id);
 
 private:
-    OutputMixer(uint32_t instanceId);
+    OutputMixer(uint32_t instanceId, const Config& config);
 
     // uses
     Statistics* _engineStatisticsPtr;
@@ -30,7 +30,7 @@ SharedData::SharedData(const Config& config)
       _moduleProcessThreadPtr(
           ProcessThread::Create("VoiceProcessThread")) {
     Trace::CreateTrace();
-    if (OutputMixer::Create(_outputMixerPtr, _gInstanceCounter) == 0)
+    if (OutputMixer::Create(_outputMixerPtr, _gInstanceCounter, config) == 0)
     {
         _outputMixerPtr->SetEngineInformation(_engineStatistics);
     }
@@ -11,6 +11,7 @@
 #include "webrtc/voice_engine/transmit_mixer.h"
 
 #include <memory>
+#include <vector>
 
 #include "webrtc/base/format_macros.h"
 #include "webrtc/base/logging.h"
@@ -435,25 +436,61 @@ TransmitMixer::EncodeAndSend()
     WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId, -1),
                  "TransmitMixer::EncodeAndSend()");
 
-    for (ChannelManager::Iterator it(_channelManagerPtr); it.IsValid();
-         it.Increment())
+    // The iterator keeps the channels alive until we are done.
+    ChannelManager::Iterator it(_channelManagerPtr);
+    std::vector<Channel*> sharing_channels;
+    for (; it.IsValid(); it.Increment())
     {
         Channel* channelPtr = it.GetChannel();
         if (channelPtr->Sending())
         {
-            channelPtr->EncodeAndSend();
+            if (channelPtr->IsEncoderShareable())
+                sharing_channels.push_back(channelPtr);
+            else
+                channelPtr->EncodeAndSend();
         }
     }
+    EncodeAndSendShared(&sharing_channels);
     return 0;
 }
 
 void TransmitMixer::EncodeAndSend(const int voe_channels[],
                                   size_t number_of_voe_channels) {
+  std::vector<voe::ChannelOwner> owners;
+  std::vector<Channel*> sharing_channels;
   for (size_t i = 0; i < number_of_voe_channels; ++i) {
     voe::ChannelOwner ch = _channelManagerPtr->GetChannel(voe_channels[i]);
     voe::Channel* channel_ptr = ch.channel();
-    if (channel_ptr && channel_ptr->Sending())
-      channel_ptr->EncodeAndSend();
+    if (channel_ptr && channel_ptr->Sending()) {
+      if (channel_ptr->IsEncoderShareable()) {
+        owners.push_back(ch);
+        sharing_channels.push_back(channel_ptr);
+      } else {
+        channel_ptr->EncodeAndSend();
+      }
+    }
+  }
+  EncodeAndSendShared(&sharing_channels);
+}
+
+void TransmitMixer::EncodeAndSendShared(std::vector<Channel*>* channels) {
+  // The first channel encodes for all the others with the same encoder
+  // configuration, and the rest are grouped in the same way.
+  std::vector<Channel*> followers;
+  std::vector<Channel*> others;
+  while (!channels->empty()) {
+    Channel* encoder = channels->front();
+    followers.clear();
+    others.clear();
+    for (size_t i = 1; i < channels->size(); ++i) {
+      Channel* channel = (*channels)[i];
+      if (channel->HasSameEncoderAs(encoder))
+        followers.push_back(channel);
+      else
+        others.push_back(channel);
+    }
+    encoder->EncodeAndSend(followers);
+    channels->swap(others);
   }
 }
 
@@ -11,6 +11,8 @@
 #ifndef WEBRTC_VOICE_ENGINE_TRANSMIT_MIXER_H
 #define WEBRTC_VOICE_ENGINE_TRANSMIT_MIXER_H
 
+#include <vector>
+
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/common_audio/resampler/include/push_resampler.h"
 #include "webrtc/common_types.h"
@@ -32,6 +34,7 @@ class VoEMediaProcess;
 
 namespace voe {
 
+class Channel;
 class ChannelManager;
 class MixedAudio;
 class Statistics;
@@ -169,6 +172,11 @@ private:
     // sending codecs.
     void GetSendCodecInfo(int* max_sample_rate, size_t* max_channels);
 
+    // Encodes for each group of |channels| with the same encoder
+    // configuration once, and sends the packets on all channels in the group.
+    // Empties |channels|.
+    void EncodeAndSendShared(std::vector<Channel*>* channels);
+
     void GenerateAudioFrame(const int16_t audioSamples[],
                             size_t nSamples,
                             size_t nChannels,
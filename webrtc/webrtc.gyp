@@ -173,6 +173,7 @@
       'target_name': 'rtc_event_log',
       'type': 'static_library',
       'sources': [
+        'call/lockfree_queue.h',
         'call/rtc_event_log.cc',
         'call/rtc_event_log.h',
         'call/rtc_event_log_helper_thread.cc',